@@ -0,0 +1,14 @@
+# Neither jemalloc nor mimalloc is a package of hunter, so the one chosen is
+# looked up in the system. The statistics of jemalloc are exported with the
+# metrics of the node once it is linked
+if(ALLOCATOR STREQUAL "")
+  set(ALLOCATOR_LIBRARY "")
+elseif(ALLOCATOR MATCHES "^(jemalloc|mimalloc)$")
+  find_library(ALLOCATOR_LIBRARY NAMES ${ALLOCATOR})
+  if(NOT ALLOCATOR_LIBRARY)
+    message(FATAL_ERROR "Allocator ${ALLOCATOR} is not found")
+  endif()
+  print("Allocator ${ALLOCATOR} is linked: ${ALLOCATOR_LIBRARY}")
+else()
+  message(FATAL_ERROR "Unknown allocator ${ALLOCATOR}, jemalloc or mimalloc is expected")
+endif()
@@ -6,6 +6,10 @@ hunter_add_package(GTest)
 find_package(GTest CONFIG REQUIRED)
 find_package(GMock CONFIG REQUIRED)
 
+# https://docs.hunter.sh/en/latest/packages/pkg/benchmark.html
+hunter_add_package(benchmark)
+find_package(benchmark CONFIG REQUIRED)
+
 # https://docs.hunter.sh/en/latest/packages/pkg/Boost.html
 hunter_add_package(Boost COMPONENTS random filesystem program_options)
 find_package(Boost CONFIG REQUIRED random filesystem program_options)
@@ -19,10 +23,20 @@ find_package(Boost CONFIG REQUIRED random filesystem program_options)
 hunter_add_package(leveldb)
 find_package(leveldb CONFIG REQUIRED)
 
+if (ROCKSDB)
+  # https://docs.hunter.sh/en/latest/packages/pkg/rocksdb.html
+  hunter_add_package(rocksdb)
+  find_package(RocksDB CONFIG REQUIRED)
+endif ()
+
 # https://docs.hunter.sh/en/latest/packages/pkg/xxhash.html
 hunter_add_package(xxhash)
 find_package(xxhash CONFIG REQUIRED)
 
+# https://docs.hunter.sh/en/latest/packages/pkg/zstd.html
+hunter_add_package(zstd)
+find_package(zstd CONFIG REQUIRED)
+
 # https://docs.hunter.sh/en/latest/packages/pkg/iroha-ed25519.html
 hunter_add_package(iroha-ed25519)
 find_package(ed25519 CONFIG REQUIRED)
@@ -26,6 +26,21 @@ function(addtest test_name)
   disable_clang_tidy(${test_name})
 endfunction()
 
+# benchmarks are run by hand, ctest only makes sure that they work with a
+# short run, given by the arguments after SMOKE_ARGS
+function(addbenchmark benchmark_name)
+  cmake_parse_arguments(BENCHMARK "" "" "SMOKE_ARGS" ${ARGN})
+  add_executable(${benchmark_name} ${BENCHMARK_UNPARSED_ARGUMENTS})
+  add_test(
+      NAME ${benchmark_name}
+      COMMAND $<TARGET_FILE:${benchmark_name}> ${BENCHMARK_SMOKE_ARGS}
+  )
+  set_target_properties(${benchmark_name} PROPERTIES
+      RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/benchmark_bin
+      )
+  disable_clang_tidy(${benchmark_name})
+endfunction()
+
 function(addtest_part test_name)
   if (POLICY CMP0076)
     cmake_policy(SET CMP0076 NEW)
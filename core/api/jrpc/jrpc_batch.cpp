@@ -0,0 +1,214 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/jrpc/jrpc_batch.hpp"
+
+namespace kagome::api {
+
+  namespace {
+    bool isSpace(char c) {
+      return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+    }
+
+    std::string_view trim(std::string_view str) {
+      while (not str.empty() and isSpace(str.front())) {
+        str.remove_prefix(1);
+      }
+      while (not str.empty() and isSpace(str.back())) {
+        str.remove_suffix(1);
+      }
+      return str;
+    }
+  }  // namespace
+
+  boost::optional<std::vector<std::string_view>> splitBatch(
+      std::string_view request) {
+    request = trim(request);
+    if (request.size() < 2 or request.front() != '['
+        or request.back() != ']') {
+      return boost::none;
+    }
+    auto body = request.substr(1, request.size() - 2);
+
+    std::vector<std::string_view> requests;
+    // only the brackets and the quotes are tracked, the requests themselves
+    // are checked once they are processed
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    size_t begin = 0;
+    for (size_t i = 0; i < body.size(); ++i) {
+      auto c = body[i];
+      if (in_string) {
+        if (escaped) {
+          escaped = false;
+        } else if (c == '\\') {
+          escaped = true;
+        } else if (c == '"') {
+          in_string = false;
+        }
+        continue;
+      }
+      switch (c) {
+        case '"':
+          in_string = true;
+          break;
+        case '{':
+        case '[':
+          ++depth;
+          break;
+        case '}':
+        case ']':
+          if (depth == 0) {
+            return boost::none;
+          }
+          --depth;
+          break;
+        case ',':
+          if (depth == 0) {
+            auto item = trim(body.substr(begin, i - begin));
+            if (item.empty()) {
+              return boost::none;
+            }
+            requests.push_back(item);
+            begin = i + 1;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    if (in_string or depth != 0) {
+      return boost::none;
+    }
+    auto last = trim(body.substr(begin));
+    if (last.empty()) {
+      // a trailing comma
+      if (not requests.empty()) {
+        return boost::none;
+      }
+    } else {
+      requests.push_back(last);
+    }
+    return requests;
+  }
+
+  boost::optional<CallHeader> peekCall(std::string_view request) {
+    request = trim(request);
+    if (request.size() < 2 or request.front() != '{'
+        or request.back() != '}') {
+      return boost::none;
+    }
+
+    CallHeader call;
+    // only the members of the request object are looked at
+    size_t depth = 0;
+    bool in_string = false;
+    bool escaped = false;
+    size_t string_begin = 0;
+    std::string_view key;
+    boost::optional<size_t> value_begin;
+    auto end_value = [&](size_t end) {
+      auto value = trim(request.substr(*value_begin, end - *value_begin));
+      if (key == "method") {
+        if (value.size() >= 2 and value.front() == '"'
+            and value.back() == '"') {
+          call.method = value.substr(1, value.size() - 2);
+        }
+      } else if (key == "id") {
+        call.id = value;
+      }
+      value_begin.reset();
+    };
+    for (size_t i = 0; i < request.size(); ++i) {
+      auto c = request[i];
+      if (in_string) {
+        if (escaped) {
+          escaped = false;
+        } else if (c == '\\') {
+          escaped = true;
+        } else if (c == '"') {
+          in_string = false;
+          if (depth == 1 and not value_begin) {
+            key = request.substr(string_begin, i - string_begin);
+          }
+        }
+        continue;
+      }
+      switch (c) {
+        case '"':
+          in_string = true;
+          string_begin = i + 1;
+          break;
+        case '{':
+        case '[':
+          ++depth;
+          break;
+        case '}':
+        case ']':
+          // the object closes before its end
+          if (depth == 0 or (depth == 1 and i + 1 != request.size())) {
+            return boost::none;
+          }
+          if (depth == 1 and value_begin) {
+            end_value(i);
+          }
+          --depth;
+          break;
+        case ':':
+          if (depth == 1 and not value_begin) {
+            value_begin = i + 1;
+          }
+          break;
+        case ',':
+          if (depth == 1 and value_begin) {
+            end_value(i);
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    if (in_string or depth != 0) {
+      return boost::none;
+    }
+    return call;
+  }
+
+  std::string busyResponse(std::string_view id) {
+    if (id.empty()) {
+      return {};
+    }
+    return R"({"jsonrpc":"2.0","error":{"code":-32000,)"
+           R"("message":"Server is busy"},"id":)"
+           + std::string{id} + "}";
+  }
+
+  bool isErrorResponse(std::string_view response) {
+    constexpr std::string_view kErrorHead = R"({"jsonrpc":"2.0","error":)";
+    return response.substr(0, kErrorHead.size()) == kErrorHead;
+  }
+
+  std::string joinBatch(const std::vector<std::string> &responses) {
+    size_t size = 2;
+    for (auto &response : responses) {
+      size += response.size() + 1;
+    }
+    std::string batch;
+    batch.reserve(size);
+    for (auto &response : responses) {
+      if (response.empty()) {
+        continue;
+      }
+      batch += batch.empty() ? '[' : ',';
+      batch += response;
+    }
+    if (not batch.empty()) {
+      batch += ']';
+    }
+    return batch;
+  }
+
+}  // namespace kagome::api
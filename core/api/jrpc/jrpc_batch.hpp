@@ -0,0 +1,74 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_JRPC_JRPC_BATCH_HPP
+#define KAGOME_CORE_API_JRPC_JRPC_BATCH_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+namespace kagome::api {
+
+  /// response to an empty batch, which is an invalid request
+  constexpr std::string_view kEmptyBatchResponse =
+      R"({"jsonrpc":"2.0","error":{"code":-32600,"message":"Invalid Request"},)"
+      R"("id":null})";
+
+  /**
+   * Splits a batch of json rpc requests into the requests, without parsing
+   * them, so that they are processed apart
+   * @param request json rpc request, which is a batch if it is an array
+   * @return the requests of the batch in their order, none if \arg request is
+   * not a batch or its brackets and quotes do not match, so that it is
+   * processed as a single request, which is refused then
+   */
+  boost::optional<std::vector<std::string_view>> splitBatch(
+      std::string_view request);
+
+  /**
+   * Method and id of a json rpc request, as they are in the request
+   */
+  struct CallHeader {
+    /// name of the method, unquoted
+    std::string_view method;
+    /// id in json, empty for a notification
+    std::string_view id;
+  };
+
+  /**
+   * Finds the method and the id of a request, without parsing it, so that it
+   * is scheduled before it is processed
+   * @return none if \arg request is not an object or its brackets and
+   * quotes do not match
+   */
+  boost::optional<CallHeader> peekCall(std::string_view request);
+
+  /**
+   * @return response to the request \arg id, which is refused as the server
+   * is overloaded, empty for a notification
+   */
+  std::string busyResponse(std::string_view id);
+
+  /**
+   * Tells an error response from a result, looking only at the head of
+   * \arg response, which must be formatted by the server, that writes the
+   * error or the result right after the version
+   */
+  bool isErrorResponse(std::string_view response);
+
+  /**
+   * Joins the responses to the requests of a batch, the empty ones, which are
+   * the responses to the notifications, are skipped
+   * @return the response to the batch, empty if all the requests are
+   * notifications
+   */
+  std::string joinBatch(const std::vector<std::string> &responses);
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_JRPC_JRPC_BATCH_HPP
@@ -12,6 +12,7 @@
 #include <memory>
 #include <type_traits>
 
+#include "api/jrpc/response_cache.hpp"
 #include "api/jrpc/value_converter.hpp"
 
 namespace kagome::api {
@@ -39,7 +40,8 @@ namespace kagome::api {
           return {};
           // NOLINTNEXTLINE
         } else {
-          return makeValue(result.value());
+          // the result is not used anymore, so it may be moved out
+          return makeValue(std::move(result.value()));
         }
 
       } else {
@@ -48,6 +50,54 @@ namespace kagome::api {
     }
   };
 
+  /**
+   * Method, which responses are kept in a cache once they never change.
+   * Besides the members used by Method, RequestType has:
+   * - cacheKey(), key of the response after init(), none if the response is
+   *   not cached at all;
+   * - isImmutable(), true after execute() if the response never changes
+   */
+  template <typename RequestType, typename Api>
+  class CachedMethod {
+   private:
+    std::weak_ptr<Api> api_;
+    std::shared_ptr<ResponseCache> cache_;
+
+   public:
+    CachedMethod(const std::shared_ptr<Api> &api,
+                 std::shared_ptr<ResponseCache> cache)
+        : api_(api), cache_(std::move(cache)) {}
+
+    jsonrpc::Value operator()(const jsonrpc::Request::Parameters &params) {
+      auto api = api_.lock();
+      if (not api) {
+        throw jsonrpc::Fault("API not available");
+      }
+      RequestType request(api);
+
+      if (auto &&res = request.init(params); not res) {
+        throw jsonrpc::Fault(res.error().message());
+      }
+
+      auto key = request.cacheKey();
+      if (key) {
+        if (auto cached = cache_->get(*key)) {
+          return std::move(*cached);
+        }
+      }
+
+      auto &&result = request.execute();
+      if (not result) {
+        throw jsonrpc::Fault(result.error().message());
+      }
+      auto value = makeValue(std::move(result.value()));
+      if (key and request.isImmutable()) {
+        cache_->put(*key, value);
+      }
+      return value;
+    }
+  };
+
 }  // namespace kagome::api
 
 #endif  // KAGOME_CORE_API_JRPC_JRPC_METHOD_HPP
@@ -9,6 +9,7 @@
 #include <jsonrpc-lean/dispatcher.h>
 
 #include <functional>
+#include <string_view>
 
 namespace kagome::api {
 
@@ -30,9 +31,9 @@ namespace kagome::api {
     virtual void registerHandler(const std::string &name, Method method) = 0;
 
     /**
-     * Response callback type
+     * Response callback type, the response is valid during the call only
      */
-    using ResponseHandler = std::function<void(const std::string &)>;
+    using ResponseHandler = std::function<void(std::string_view)>;
 
     /**
      * @brief handles decoded network message
@@ -41,6 +42,14 @@ namespace kagome::api {
      */
     virtual void processData(std::string_view request,
                              const ResponseHandler &cb) = 0;
+
+    /**
+     * @brief formats a value the way the responses are formatted, so that a
+     * message may be composed of values formatted once
+     * @param value value to format
+     * @return formatted value
+     */
+    virtual std::string encode(const jsonrpc::Value &value) = 0;
   };
 
 }  // namespace kagome::api
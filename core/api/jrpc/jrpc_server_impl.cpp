@@ -21,9 +21,18 @@ namespace kagome::api {
                                const ResponseHandler &cb) {
     auto &&formatted_response =
         jsonrpc_handler_.HandleRequest(std::string(request));
-    std::string response(formatted_response->GetData(),
-                         formatted_response->GetSize());
-    cb(response);
+    // the response is copied once, by the session, which owns it then
+    cb(std::string_view(formatted_response->GetData(),
+                        formatted_response->GetSize()));
+  }
+
+  std::string JRpcServerImpl::encode(const jsonrpc::Value &value) {
+    auto writer = format_handler_.CreateWriter();
+    writer->StartDocument();
+    value.Write(*writer);
+    writer->EndDocument();
+    auto &&data = writer->GetData();
+    return std::string(data->GetData(), data->GetSize());
   }
 
 }  // namespace kagome::api
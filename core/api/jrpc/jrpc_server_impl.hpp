@@ -32,6 +32,8 @@ namespace kagome::api {
      */
     void processData(std::string_view request, const ResponseHandler &cb) override;
 
+    std::string encode(const jsonrpc::Value &value) override;
+
    private:
     /// json rpc server instance
     jsonrpc::Server jsonrpc_handler_ {};
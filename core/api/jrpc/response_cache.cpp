@@ -0,0 +1,76 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/jrpc/response_cache.hpp"
+
+namespace kagome::api {
+
+  namespace {
+    // quotes, separators and numbers, which are short next to the hex
+    // strings of the blocks
+    constexpr size_t kValueOverhead = 8;
+  }  // namespace
+
+  ResponseCache::ResponseCache(size_t max_bytes) : max_bytes_{max_bytes} {}
+
+  boost::optional<jsonrpc::Value> ResponseCache::get(const Key &key) {
+    std::shared_ptr<const jsonrpc::Value> value;
+    {
+      std::lock_guard lock{mutex_};
+      auto it = index_.find(key);
+      if (it == index_.end()) {
+        return boost::none;
+      }
+      entries_.splice(entries_.begin(), entries_, it->second);
+      value = it->second->value;
+    }
+    // copied without the lock, as a response of a block may be large
+    return *value;
+  }
+
+  void ResponseCache::put(const Key &key, jsonrpc::Value value) {
+    auto bytes = sizeOf(value);
+    if (bytes > max_bytes_) {
+      return;
+    }
+    auto shared = std::make_shared<const jsonrpc::Value>(std::move(value));
+    std::lock_guard lock{mutex_};
+    if (index_.count(key) != 0) {
+      return;
+    }
+    while (bytes_ + bytes > max_bytes_) {
+      auto &last = entries_.back();
+      bytes_ -= last.bytes;
+      index_.erase(last.key);
+      entries_.pop_back();
+    }
+    entries_.push_front(Entry{key, std::move(shared), bytes});
+    index_.emplace(key, entries_.begin());
+    bytes_ += bytes;
+  }
+
+  size_t ResponseCache::bytes() const {
+    std::lock_guard lock{mutex_};
+    return bytes_;
+  }
+
+  size_t ResponseCache::sizeOf(const jsonrpc::Value &value) {
+    if (value.IsString()) {
+      return value.AsString().size() + kValueOverhead;
+    }
+    size_t bytes = kValueOverhead;
+    if (value.IsArray()) {
+      for (auto &item : value.AsArray()) {
+        bytes += sizeOf(item);
+      }
+    } else if (value.IsStruct()) {
+      for (auto &[name, item] : value.AsStruct()) {
+        bytes += name.size() + sizeOf(item);
+      }
+    }
+    return bytes;
+  }
+
+}  // namespace kagome::api
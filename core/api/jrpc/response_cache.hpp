@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_JRPC_RESPONSE_CACHE_HPP
+#define KAGOME_CORE_API_JRPC_RESPONSE_CACHE_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <boost/optional.hpp>
+#include <jsonrpc-lean/value.h>
+
+#include "common/blob.hpp"
+#include "common/flat_hash_map.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Responses of an RPC method, which never change once they are made, such
+   * as the ones of the finalized blocks, kept converted to the values, so
+   * that a repeated request is served without reading the storage and
+   * converting the data again. Keeps the responses up to a total size, which
+   * is close to the size of their formatted JSON, evicting the least
+   * recently used ones. Thread-safe
+   */
+  class ResponseCache {
+   public:
+    using Key = common::Hash256;
+
+    /**
+     * @param max_bytes max total size of the responses kept
+     */
+    explicit ResponseCache(size_t max_bytes);
+
+    /**
+     * @return response kept for \arg key, none if there is no such
+     */
+    boost::optional<jsonrpc::Value> get(const Key &key);
+
+    /**
+     * Keeps \arg value as the response for \arg key, unless it is larger
+     * than the whole cache
+     */
+    void put(const Key &key, jsonrpc::Value value);
+
+    /// @return total size of the responses kept
+    size_t bytes() const;
+
+    /// @return approximate size of \arg value formatted as JSON
+    static size_t sizeOf(const jsonrpc::Value &value);
+
+   private:
+    struct Entry {
+      Key key;
+      std::shared_ptr<const jsonrpc::Value> value;
+      size_t bytes;
+    };
+
+    const size_t max_bytes_;
+    mutable std::mutex mutex_;
+    // the most recently used entries first
+    std::list<Entry> entries_;
+    common::FlatHashMap<Key, std::list<Entry>::iterator> index_;
+    size_t bytes_ = 0;
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_JRPC_RESPONSE_CACHE_HPP
@@ -9,18 +9,36 @@
 #include <vector>
 
 #include <jsonrpc-lean/value.h>
+#include "api/transport/rpc_metrics.hpp"
 #include "common/blob.hpp"
 #include "common/visitor.hpp"
+#include "consensus/consensus_metrics.hpp"
+#include "network/network_metrics.hpp"
+#include "primitives/block.hpp"
+#include "primitives/block_header.hpp"
 #include "primitives/extrinsic.hpp"
+#include "primitives/read_proof.hpp"
+#include "primitives/storage_change_set.hpp"
 #include "primitives/version.hpp"
+#include "runtime/runtime_profiler.hpp"
+#include "scale/scale.hpp"
 
 namespace kagome::api {
   inline jsonrpc::Value makeValue(common::Hash256 const &);
   inline jsonrpc::Value makeValue(common::Buffer const &);
+  inline jsonrpc::Value makeValue(common::Buffer &&);
   inline jsonrpc::Value makeValue(primitives::Extrinsic const &);
   inline jsonrpc::Value makeValue(primitives::Version const &);
   inline jsonrpc::Value makeValue(uint32_t const &);
   inline jsonrpc::Value makeValue(primitives::Api const &);
+  inline jsonrpc::Value makeValue(primitives::StorageChangeSet const &);
+  inline jsonrpc::Value makeValue(primitives::ReadProof const &);
+  inline jsonrpc::Value makeValue(primitives::BlockHeader const &);
+  inline jsonrpc::Value makeValue(primitives::Block const &);
+  inline jsonrpc::Value makeValue(runtime::RuntimeProfiler::Report const &);
+  inline jsonrpc::Value makeValue(network::NetworkMetrics::Report const &);
+  inline jsonrpc::Value makeValue(consensus::ConsensusMetrics::Report const &);
+  inline jsonrpc::Value makeValue(RpcMetrics::Report const &);
 
   template <size_t S>
   inline jsonrpc::Value makeValue(const common::Blob<S> &);
@@ -29,6 +47,8 @@ namespace kagome::api {
   template <class T>
   inline jsonrpc::Value makeValue(const std::vector<T> &);
   template <class T1, class T2>
+  inline jsonrpc::Value makeValue(const std::pair<T1, T2> &);
+  template <class T1, class T2>
   inline jsonrpc::Value makeValue(const boost::variant<T1, T2> &);
 
   template <typename T>
@@ -53,6 +73,12 @@ namespace kagome::api {
     return v.toVector();
   }
 
+  // the bytes of a buffer, which is a result, are moved into the value
+  // instead of being copied, as the storage values may be megabytes large
+  inline jsonrpc::Value makeValue(common::Buffer &&v) {
+    return std::move(v.toVector());
+  }
+
   inline jsonrpc::Value makeValue(const primitives::Extrinsic &v) {
     return v.data.toHex();
   }
@@ -67,6 +93,15 @@ namespace kagome::api {
     return value;
   }
 
+  template <class T1, class T2>
+  inline jsonrpc::Value makeValue(const std::pair<T1, T2> &val) {
+    jsonrpc::Value::Array data;
+    data.reserve(2);
+    data.emplace_back(makeValue(val.first));
+    data.emplace_back(makeValue(val.second));
+    return data;
+  }
+
   inline jsonrpc::Value makeValue(const primitives::Api &val) {
     using VectorType = jsonrpc::Value::Array;
     VectorType data;
@@ -93,6 +128,232 @@ namespace kagome::api {
     return std::move(data);
   }
 
+  inline jsonrpc::Value makeValue(const primitives::StorageChangeSet &val) {
+    jsonrpc::Value::Array changes;
+    changes.reserve(val.changes.size());
+    for (auto &change : val.changes) {
+      jsonrpc::Value::Array pair;
+      pair.reserve(2);
+      pair.emplace_back(makeValue(change.key));
+      // absent entries are denoted with null
+      pair.emplace_back(change.data ? makeValue(change.data.value())
+                                    : jsonrpc::Value{});
+      changes.emplace_back(std::move(pair));
+    }
+
+    jsonrpc::Value::Struct data;
+    data["block"] = makeValue(val.block);
+    data["changes"] = std::move(changes);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(const primitives::ReadProof &val) {
+    jsonrpc::Value::Struct data;
+    data["at"] = makeValue(val.at);
+    data["proof"] = makeValue(val.proof);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(const primitives::BlockHeader &val) {
+    // digest items are given scale encoded
+    jsonrpc::Value::Array logs;
+    logs.reserve(val.digest.size());
+    for (auto &item : val.digest) {
+      logs.emplace_back(makeValue(common::Buffer{scale::encode(item).value()}));
+    }
+    jsonrpc::Value::Struct digest;
+    digest["logs"] = std::move(logs);
+
+    jsonrpc::Value::Struct data;
+    data["parentHash"] = makeValue(val.parent_hash);
+    data["number"] = makeValue(static_cast<int64_t>(val.number));
+    data["stateRoot"] = makeValue(val.state_root);
+    data["extrinsicsRoot"] = makeValue(val.extrinsics_root);
+    data["digest"] = std::move(digest);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(const primitives::Block &val) {
+    jsonrpc::Value::Struct block;
+    block["header"] = makeValue(val.header);
+    block["extrinsics"] = makeValue(val.body);
+
+    // the justifications are not given with the blocks
+    jsonrpc::Value::Struct data;
+    data["block"] = std::move(block);
+    data["justification"] = jsonrpc::Value{};
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(
+      const runtime::RuntimeProfiler::Report &val) {
+    // durations are in nanoseconds
+    auto calls = [](const auto &stats_by_name) {
+      jsonrpc::Value::Struct data;
+      for (auto &[name, stats] : stats_by_name) {
+        jsonrpc::Value::Struct entry;
+        entry["calls"] = static_cast<int64_t>(stats.calls);
+        entry["total"] = static_cast<int64_t>(stats.total.count());
+        entry["p99"] = static_cast<int64_t>(stats.p99.count());
+        entry["max"] = static_cast<int64_t>(stats.max.count());
+        data[name] = std::move(entry);
+      }
+      return data;
+    };
+
+    jsonrpc::Value::Struct data;
+    data["exports"] = calls(val.exports);
+    data["hostFunctions"] = calls(val.host_functions);
+    jsonrpc::Value::Struct heaps;
+    for (auto &[name, stats] : val.heaps) {
+      jsonrpc::Value::Struct entry;
+      entry["calls"] = static_cast<int64_t>(stats.calls);
+      entry["allocations"] = static_cast<int64_t>(stats.allocations);
+      entry["bytesAllocated"] = static_cast<int64_t>(stats.bytes_allocated);
+      entry["bytesFreed"] = static_cast<int64_t>(stats.bytes_freed);
+      entry["peakHeap"] = static_cast<int64_t>(stats.peak_heap);
+      entry["grows"] = static_cast<int64_t>(stats.grows);
+      entry["fragmentation"] = stats.fragmentation;
+      heaps[name] = std::move(entry);
+    }
+    data["heaps"] = std::move(heaps);
+    data["bytesLoaded"] = static_cast<int64_t>(val.bytes_loaded);
+    data["bytesStored"] = static_cast<int64_t>(val.bytes_stored);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(
+      const network::NetworkMetrics::Report &val) {
+    // durations are in nanoseconds
+    auto durations = [](const network::NetworkMetrics::DurationStats &stats) {
+      jsonrpc::Value::Struct data;
+      data["calls"] = static_cast<int64_t>(stats.calls);
+      data["total"] = static_cast<int64_t>(stats.total.count());
+      data["p99"] = static_cast<int64_t>(stats.p99.count());
+      data["max"] = static_cast<int64_t>(stats.max.count());
+      return data;
+    };
+    auto traffic = [](const network::NetworkMetrics::Traffic &traffic) {
+      jsonrpc::Value::Struct data;
+      data["messages"] = static_cast<int64_t>(traffic.messages);
+      data["bytes"] = static_cast<int64_t>(traffic.bytes);
+      return data;
+    };
+
+    jsonrpc::Value::Struct protocols;
+    for (auto &[protocol, types] : val.messages) {
+      jsonrpc::Value::Struct messages;
+      for (auto &[type, stats] : types) {
+        jsonrpc::Value::Struct entry;
+        entry["received"] = traffic(stats.received);
+        entry["sent"] = traffic(stats.sent);
+        entry["decoding"] = durations(stats.decoding);
+        entry["encoding"] = durations(stats.encoding);
+        messages[type] = std::move(entry);
+      }
+      protocols[protocol] = std::move(messages);
+    }
+    jsonrpc::Value::Struct queues;
+    for (auto &[peer, queue] : val.queues) {
+      jsonrpc::Value::Struct entry;
+      entry["messages"] = static_cast<int64_t>(queue.messages);
+      entry["bytes"] = static_cast<int64_t>(queue.bytes);
+      queues[peer] = std::move(entry);
+    }
+    jsonrpc::Value::Struct round_trips;
+    for (auto &[name, stats] : val.round_trips) {
+      round_trips[name] = durations(stats);
+    }
+
+    jsonrpc::Value::Struct data;
+    data["messages"] = std::move(protocols);
+    data["queues"] = std::move(queues);
+    data["roundTrips"] = std::move(round_trips);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(
+      const consensus::ConsensusMetrics::Report &val) {
+    // durations are in nanoseconds
+    auto durations =
+        [](const consensus::ConsensusMetrics::DurationStats &stats) {
+          jsonrpc::Value::Struct data;
+          data["calls"] = static_cast<int64_t>(stats.calls);
+          data["total"] = static_cast<int64_t>(stats.total.count());
+          data["p99"] = static_cast<int64_t>(stats.p99.count());
+          data["max"] = static_cast<int64_t>(stats.max.count());
+          return data;
+        };
+
+    jsonrpc::Value::Struct slots;
+    slots["slots"] = static_cast<int64_t>(val.slots.slots);
+    slots["skipped"] = static_cast<int64_t>(val.slots.skipped);
+    slots["drift"] = durations(val.slots.drift);
+    slots["timer"] = durations(val.slots.timer);
+    slots["proposal"] = durations(val.slots.proposal);
+    slots["announce"] = durations(val.slots.announce);
+
+    jsonrpc::Value::Struct rounds;
+    rounds["completed"] = static_cast<int64_t>(val.rounds.completed);
+    rounds["failed"] = static_cast<int64_t>(val.rounds.failed);
+    rounds["prevotes"] = static_cast<int64_t>(val.rounds.prevotes);
+    rounds["precommits"] = static_cast<int64_t>(val.rounds.precommits);
+    rounds["equivocations"] = static_cast<int64_t>(val.rounds.equivocations);
+    rounds["duration"] = durations(val.rounds.duration);
+    rounds["prevote"] = durations(val.rounds.prevote);
+    rounds["precommit"] = durations(val.rounds.precommit);
+    rounds["finalize"] = durations(val.rounds.finalize);
+
+    jsonrpc::Value::Struct data;
+    data["slots"] = std::move(slots);
+    data["rounds"] = std::move(rounds);
+    data["importedBlocks"] = static_cast<int64_t>(val.imported_blocks);
+    data["finalityLag"] = durations(val.finality_lag);
+    return std::move(data);
+  }
+
+  inline jsonrpc::Value makeValue(const RpcMetrics::Report &val) {
+    // durations are in nanoseconds
+    auto durations = [](const RpcMetrics::DurationStats &stats) {
+      jsonrpc::Value::Struct data;
+      data["calls"] = static_cast<int64_t>(stats.calls);
+      data["total"] = static_cast<int64_t>(stats.total.count());
+      data["p99"] = static_cast<int64_t>(stats.p99.count());
+      data["max"] = static_cast<int64_t>(stats.max.count());
+      return data;
+    };
+    auto bytes = [](const RpcMetrics::Bytes &bytes) {
+      jsonrpc::Value::Struct data;
+      data["total"] = static_cast<int64_t>(bytes.total);
+      data["max"] = static_cast<int64_t>(bytes.max);
+      return data;
+    };
+
+    jsonrpc::Value::Struct methods;
+    for (auto &[name, stats] : val.methods) {
+      jsonrpc::Value::Struct entry;
+      entry["calls"] = static_cast<int64_t>(stats.calls);
+      entry["errors"] = static_cast<int64_t>(stats.errors);
+      entry["refused"] = static_cast<int64_t>(stats.refused);
+      entry["slow"] = static_cast<int64_t>(stats.slow);
+      entry["latency"] = durations(stats.latency);
+      entry["requests"] = bytes(stats.requests);
+      entry["responses"] = bytes(stats.responses);
+      methods[name] = std::move(entry);
+    }
+    jsonrpc::Value::Struct sessions;
+    sessions["http"] = static_cast<int64_t>(val.http_sessions);
+    sessions["ws"] = static_cast<int64_t>(val.ws_sessions);
+    sessions["unix"] = static_cast<int64_t>(val.unix_sessions);
+
+    jsonrpc::Value::Struct data;
+    data["methods"] = std::move(methods);
+    data["inFlight"] = static_cast<int64_t>(val.in_flight);
+    data["maxInFlight"] = static_cast<int64_t>(val.max_in_flight);
+    data["sessions"] = std::move(sessions);
+    return std::move(data);
+  }
+
   template <class T1, class T2>
   inline jsonrpc::Value makeValue(const boost::variant<T1, T2> &v) {
     return kagome::visit_in_place(
@@ -0,0 +1,169 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/scale/scale_rpc_server.hpp"
+
+#include <tuple>
+
+#include "scale/scale.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::api, ScaleRpcError, e) {
+  using E = kagome::api::ScaleRpcError;
+  switch (e) {
+    case E::INVALID_REQUEST:
+      return "request is shorter than its header";
+    case E::UNKNOWN_METHOD:
+      return "method is not known";
+    case E::INVALID_PARAMS:
+      return "params do not match the ones of the method";
+    case E::BUSY:
+      return "too many expensive calls are processed, try again later";
+  }
+  return "unknown error";
+}
+
+namespace kagome::api {
+
+  namespace {
+    using RequestId = ScaleRpcServer::RequestId;
+    using Header = std::tuple<RequestId, uint16_t>;
+    constexpr auto kHeaderSize = ScaleRpcServer::kHeaderSize;
+
+    outcome::result<Header> decodeHeader(gsl::span<const uint8_t> request) {
+      if (request.size() < static_cast<ptrdiff_t>(kHeaderSize)) {
+        return ScaleRpcError::INVALID_REQUEST;
+      }
+      return scale::decode<Header>(request.first(kHeaderSize));
+    }
+  }  // namespace
+
+  ScaleRpcServer::ScaleRpcServer(std::shared_ptr<ChainApi> chain_api,
+                                 std::shared_ptr<StateApi> state_api,
+                                 std::shared_ptr<AuthorApi> author_api)
+      : chain_api_{std::move(chain_api)},
+        state_api_{std::move(state_api)},
+        author_api_{std::move(author_api)} {
+    BOOST_ASSERT(chain_api_ != nullptr);
+    BOOST_ASSERT(state_api_ != nullptr);
+    BOOST_ASSERT(author_api_ != nullptr);
+  }
+
+  std::string ScaleRpcServer::process(gsl::span<const uint8_t> request) const {
+    auto header = decodeHeader(request);
+    if (not header) {
+      return failure(request, header.error());
+    }
+    auto [id, method] = header.value();
+    auto params = request.subspan(kHeaderSize);
+    using primitives::BlockHash;
+    using Buffer = common::Buffer;
+    switch (static_cast<ScaleRpcMethod>(method)) {
+      case ScaleRpcMethod::CHAIN_GET_BLOCK_HASH:
+        return call<boost::optional<primitives::BlockNumber>>(
+            id, params, [this](const auto &number) {
+              return number ? chain_api_->getBlockHash(*number)
+                            : chain_api_->getBlockHash();
+            });
+      case ScaleRpcMethod::CHAIN_GET_HEADER:
+        return call<BlockHash>(id, params, [this](const auto &hash) {
+          return chain_api_->getHeader(hash);
+        });
+      case ScaleRpcMethod::CHAIN_GET_BLOCK:
+        return call<BlockHash>(id, params, [this](const auto &hash) {
+          return chain_api_->getBlock(hash);
+        });
+      case ScaleRpcMethod::STATE_GET_STORAGE:
+        return call<Buffer, boost::optional<BlockHash>>(
+            id, params, [this](const auto &key, const auto &at) {
+              return at ? state_api_->getStorage(key, *at)
+                        : state_api_->getStorage(key);
+            });
+      case ScaleRpcMethod::STATE_GET_KEYS_PAGED:
+        return call<boost::optional<Buffer>,
+                    uint32_t,
+                    boost::optional<Buffer>,
+                    boost::optional<BlockHash>>(
+            id,
+            params,
+            [this](const auto &prefix,
+                   auto count,
+                   const auto &prev_key,
+                   const auto &at) {
+              return state_api_->getKeysPaged(prefix, count, prev_key, at);
+            });
+      case ScaleRpcMethod::STATE_GET_PAIRS:
+        return call<Buffer, boost::optional<BlockHash>>(
+            id, params, [this](const auto &prefix, const auto &at) {
+              return state_api_->getPairs(prefix, at);
+            });
+      case ScaleRpcMethod::AUTHOR_SUBMIT_EXTRINSIC:
+        return call<primitives::Extrinsic>(
+            id, params, [this](const auto &extrinsic) {
+              return author_api_->submitExtrinsic(extrinsic);
+            });
+      case ScaleRpcMethod::AUTHOR_PENDING_EXTRINSICS:
+        return call<>(
+            id, params, [this] { return author_api_->pendingExtrinsics(); });
+    }
+    return respond(id,
+                   kFailure,
+                   make_error_code(ScaleRpcError::UNKNOWN_METHOD).message());
+  }
+
+  bool ScaleRpcServer::isExpensive(gsl::span<const uint8_t> request) {
+    auto header = decodeHeader(request);
+    if (not header) {
+      return false;
+    }
+    switch (static_cast<ScaleRpcMethod>(std::get<1>(header.value()))) {
+      case ScaleRpcMethod::STATE_GET_KEYS_PAGED:
+      case ScaleRpcMethod::STATE_GET_PAIRS:
+      case ScaleRpcMethod::AUTHOR_SUBMIT_EXTRINSIC:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  std::string ScaleRpcServer::failure(gsl::span<const uint8_t> request,
+                                      const std::error_code &error) {
+    // the id of a request too short to have one is unknown
+    auto header = decodeHeader(request);
+    RequestId id = header ? std::get<0>(header.value()) : 0;
+    return respond(id, kFailure, error.message());
+  }
+
+  template <typename... Params, typename Method>
+  std::string ScaleRpcServer::call(RequestId id,
+                                   gsl::span<const uint8_t> params,
+                                   const Method &method) const {
+    auto decoded = scale::decode<std::tuple<Params...>>(params);
+    if (not decoded) {
+      return respond(
+          id,
+          kFailure,
+          make_error_code(ScaleRpcError::INVALID_PARAMS).message());
+    }
+    auto result = std::apply(method, decoded.value());
+    if (not result) {
+      return respond(id, kFailure, result.error().message());
+    }
+    return respond(id, kSuccess, result.value());
+  }
+
+  template <typename... Values>
+  std::string ScaleRpcServer::respond(RequestId id, const Values &... values) {
+    // the result is encoded right into the response, which the session takes
+    auto size = scale::encodedSize(id, values...).value();
+    std::string response(size, '\0');
+    scale::encodeInto(
+        gsl::span<uint8_t>(reinterpret_cast<uint8_t *>(response.data()), size),
+        id,
+        values...)
+        .value();
+    return response;
+  }
+
+}  // namespace kagome::api
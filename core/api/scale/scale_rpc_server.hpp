@@ -0,0 +1,108 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_SCALE_SCALE_RPC_SERVER_HPP
+#define KAGOME_CORE_API_SCALE_SCALE_RPC_SERVER_HPP
+
+#include <memory>
+#include <string>
+
+#include <gsl/span>
+
+#include "api/service/author/author_api.hpp"
+#include "api/service/chain/chain_api.hpp"
+#include "api/service/state/state_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api {
+
+  /// methods of the SCALE RPC, their ids are never reused
+  enum class ScaleRpcMethod : uint16_t {
+    /// (Option<BlockNumber>) -> BlockHash, of the last finalized block if none
+    CHAIN_GET_BLOCK_HASH = 1,
+    /// (BlockHash) -> BlockHeader
+    CHAIN_GET_HEADER = 2,
+    /// (BlockHash) -> Block
+    CHAIN_GET_BLOCK = 3,
+    /// (Buffer key, Option<BlockHash> at) -> Buffer
+    STATE_GET_STORAGE = 4,
+    /// (Option<Buffer> prefix, u32 count, Option<Buffer> prev_key,
+    /// Option<BlockHash> at) -> Vec<Buffer>
+    STATE_GET_KEYS_PAGED = 5,
+    /// (Buffer prefix, Option<BlockHash> at) -> Vec<(Buffer, Buffer)>
+    STATE_GET_PAIRS = 6,
+    /// (Extrinsic) -> Hash256
+    AUTHOR_SUBMIT_EXTRINSIC = 7,
+    /// () -> Vec<Extrinsic>
+    AUTHOR_PENDING_EXTRINSICS = 8,
+  };
+
+  enum class ScaleRpcError {
+    INVALID_REQUEST = 1,  // the request is shorter than its header
+    UNKNOWN_METHOD,       // the method id is not known
+    INVALID_PARAMS,       // the params do not decode as the ones of the method
+    BUSY,                 // too many expensive calls are processed already
+  };
+
+  /**
+   * Serves the chain, state and author APIs, the ones serving the JSON RPC,
+   * in binary SCALE messages, so that the internal consumers reading a lot
+   * of blocks and storage skip hex-encoding them into JSON and parsing them
+   * back.
+   * A request is the id given to it by the client (u32), the method (u16)
+   * and the SCALE-encoded params of the method one after another. A
+   * response is the id of the request (u32), the status (u8), which is 0 on
+   * success, and the SCALE-encoded result of the method, or the message of
+   * the error (String) otherwise. The messages of the transport tell the
+   * sizes of the requests and the responses
+   */
+  class ScaleRpcServer {
+   public:
+    using RequestId = uint32_t;
+
+    /// size of the id and of the method of a request
+    static constexpr size_t kHeaderSize = sizeof(RequestId) + sizeof(uint16_t);
+
+    static constexpr uint8_t kSuccess = 0;
+    static constexpr uint8_t kFailure = 1;
+
+    ScaleRpcServer(std::shared_ptr<ChainApi> chain_api,
+                   std::shared_ptr<StateApi> state_api,
+                   std::shared_ptr<AuthorApi> author_api);
+
+    /// @return response to \arg request
+    std::string process(gsl::span<const uint8_t> request) const;
+
+    /**
+     * @return true if \arg request calls a method, which calls the runtime
+     * or reads a lot of the storage
+     */
+    static bool isExpensive(gsl::span<const uint8_t> request);
+
+    /// @return error response to \arg request, only its header is read
+    static std::string failure(gsl::span<const uint8_t> request,
+                               const std::error_code &error);
+
+   private:
+    /// Decodes \arg params as Params and calls \arg method with them
+    template <typename... Params, typename Method>
+    std::string call(RequestId id,
+                     gsl::span<const uint8_t> params,
+                     const Method &method) const;
+
+    /// @return response to request \arg id with SCALE-encoded \arg values
+    template <typename... Values>
+    static std::string respond(RequestId id, const Values &... values);
+
+    std::shared_ptr<ChainApi> chain_api_;
+    std::shared_ptr<StateApi> state_api_;
+    std::shared_ptr<AuthorApi> author_api_;
+  };
+
+}  // namespace kagome::api
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::api, ScaleRpcError)
+
+#endif  // KAGOME_CORE_API_SCALE_SCALE_RPC_SERVER_HPP
@@ -0,0 +1,76 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/scale/scale_rpc_service.hpp"
+
+#include <algorithm>
+
+namespace kagome::api {
+
+  namespace {
+    gsl::span<const uint8_t> bytes(std::string_view data) {
+      return {reinterpret_cast<const uint8_t *>(data.data()),
+              static_cast<ptrdiff_t>(data.size())};
+    }
+  }  // namespace
+
+  ScaleRpcService::ScaleRpcService(
+      const std::shared_ptr<application::AppStateManager> &app_state_manager,
+      std::shared_ptr<RpcThreadPool> thread_pool,
+      std::vector<std::shared_ptr<Listener>> listeners,
+      std::shared_ptr<ScaleRpcServer> server)
+      : thread_pool_{std::move(thread_pool)},
+        listeners_{std::move(listeners)},
+        server_{std::move(server)} {
+    BOOST_ASSERT(thread_pool_ != nullptr);
+    BOOST_ASSERT(std::all_of(listeners_.cbegin(),
+                             listeners_.cend(),
+                             [](auto &listener) { return listener != nullptr; }));
+    BOOST_ASSERT(server_ != nullptr);
+    BOOST_ASSERT(app_state_manager != nullptr);
+    app_state_manager->takeControl(*this);
+  }
+
+  void ScaleRpcService::prepare() {
+    for (auto &listener : listeners_) {
+      listener->setHandlerForNewSession(
+          [wp = weak_from_this()](const std::shared_ptr<Session> &session) {
+            session->connectOnRequest([wp](std::string_view request,
+                                           std::shared_ptr<Session> session) {
+              if (auto self = wp.lock()) {
+                self->submitRequest(std::string{request}, session);
+              }
+            });
+          });
+    }
+  }
+
+  void ScaleRpcService::start() {
+    logger_->debug("Service started");
+  }
+
+  void ScaleRpcService::stop() {
+    logger_->debug("Service stopped");
+  }
+
+  void ScaleRpcService::submitRequest(std::string request,
+                                      const std::shared_ptr<Session> &session) {
+    auto lane = ScaleRpcServer::isExpensive(bytes(request))
+                    ? RpcThreadPool::Lane::EXPENSIVE
+                    : RpcThreadPool::Lane::CHEAP;
+    // the header tells the refused request, as the request is moved to the
+    // task
+    auto header = request.substr(0, ScaleRpcServer::kHeaderSize);
+    auto submitted = thread_pool_->submit(
+        lane, [server = server_, request = std::move(request), session] {
+          session->respond(server->process(bytes(request)));
+        });
+    if (not submitted) {
+      session->respond(ScaleRpcServer::failure(
+          bytes(header), make_error_code(ScaleRpcError::BUSY)));
+    }
+  }
+
+}  // namespace kagome::api
@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_SCALE_SCALE_RPC_SERVICE_HPP
+#define KAGOME_CORE_API_SCALE_SCALE_RPC_SERVICE_HPP
+
+#include <vector>
+
+#include "api/scale/scale_rpc_server.hpp"
+#include "api/transport/listener.hpp"
+#include "api/transport/rpc_thread_pool.hpp"
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Service processing the SCALE RPC requests coming from the sessions of
+   * its listeners in the thread pool of the JSON RPC, which the JSON RPC
+   * service starts and stops
+   */
+  class ScaleRpcService final
+      : public std::enable_shared_from_this<ScaleRpcService> {
+   public:
+    ScaleRpcService(
+        const std::shared_ptr<application::AppStateManager> &app_state_manager,
+        std::shared_ptr<RpcThreadPool> thread_pool,
+        std::vector<std::shared_ptr<Listener>> listeners,
+        std::shared_ptr<ScaleRpcServer> server);
+
+    void prepare();
+    void start();
+    void stop();
+
+   private:
+    /**
+     * @brief processes \arg request of \arg session in the thread pool, in
+     * the lane of the cost of its method, and responds to the session, or
+     * refuses it if there are too many expensive calls already
+     */
+    void submitRequest(std::string request,
+                       const std::shared_ptr<Session> &session);
+
+    std::shared_ptr<RpcThreadPool> thread_pool_;
+    std::vector<std::shared_ptr<Listener>> listeners_;
+    std::shared_ptr<ScaleRpcServer> server_;
+    common::Logger logger_ = common::createLogger("Scale RPC service");
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_SCALE_SCALE_RPC_SERVICE_HPP
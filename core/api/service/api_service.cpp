@@ -5,19 +5,42 @@
 
 #include "api/service/api_service.hpp"
 
+#include <atomic>
+#include <set>
+
+#include <boost/optional.hpp>
+
+#include "api/jrpc/jrpc_batch.hpp"
 #include "api/jrpc/jrpc_processor.hpp"
 
 namespace kagome::api {
 
+  namespace {
+    /// the methods calling the runtime or reading a lot of the storage
+    const std::set<std::string_view> kExpensiveMethods{
+        "author_submitExtrinsic",
+        "state_getKeysPaged",
+        "state_getPairs",
+        "state_getReadProof",
+        "state_getRuntimeVersion",
+        "state_queryStorage",
+        "state_queryStorageAt",
+    };
+  }  // namespace
+
   ApiService::ApiService(
       const std::shared_ptr<application::AppStateManager> &app_state_manager,
       std::shared_ptr<api::RpcThreadPool> thread_pool,
       std::vector<std::shared_ptr<Listener>> listeners,
       std::shared_ptr<JRpcServer> server,
-      gsl::span<std::shared_ptr<JRpcProcessor>> processors)
+      gsl::span<std::shared_ptr<JRpcProcessor>> processors,
+      std::shared_ptr<SubscriptionEngine> subscription_engine,
+      std::shared_ptr<RpcMetrics> metrics)
       : thread_pool_(std::move(thread_pool)),
         listeners_(std::move(listeners)),
         server_(std::move(server)),
+        subscription_engine_(std::move(subscription_engine)),
+        metrics_(std::move(metrics)),
         logger_{common::createLogger("Api service")} {
     BOOST_ASSERT(thread_pool_);
     for ([[maybe_unused]] const auto &listener : listeners_) {
@@ -36,9 +59,27 @@ namespace kagome::api {
     for (const auto &listener : listeners_) {
       auto on_new_session =
           [wp = weak_from_this()](const sptr<Session> &session) mutable {
-            if (auto self = wp.lock(); not self) {
+            auto self = wp.lock();
+            if (not self) {
               return;
             }
+            if (self->metrics_) {
+              self->metrics_->recordSessionOpened(session->type());
+            }
+            if (self->subscription_engine_ or self->metrics_) {
+              session->connectOnClose(
+                  [engine = std::weak_ptr<SubscriptionEngine>(
+                       self->subscription_engine_),
+                   metrics = std::weak_ptr<RpcMetrics>(self->metrics_),
+                   type = session->type()](Session::SessionId id) {
+                    if (auto engine_ptr = engine.lock()) {
+                      engine_ptr->removeSession(id);
+                    }
+                    if (auto metrics_ptr = metrics.lock()) {
+                      metrics_ptr->recordSessionClosed(type);
+                    }
+                  });
+            }
             session->connectOnRequest(
                 [wp](std::string_view request,
                      std::shared_ptr<Session> session) mutable {
@@ -46,13 +87,17 @@ namespace kagome::api {
                   if (not self) {
                     return;
                   }
+                  if (auto batch = splitBatch(request)) {
+                    return self->processBatch(
+                        {batch->begin(), batch->end()}, session);
+                  }
                   // process new request
-                  self->server_->processData(
-                      std::string(request),
-                      [session = std::move(session)](
-                          const std::string &response) mutable {
+                  self->submitRequest(
+                      std::string{request},
+                      session,
+                      [session](std::string_view response) {
                         // process response
-                        session->respond(response);
+                        session->respond(std::string{response});
                       });
                 });
           };
@@ -61,6 +106,104 @@ namespace kagome::api {
     }
   }
 
+  void ApiService::processRequest(std::string_view request,
+                                  const sptr<Session> &session,
+                                  const JRpcServer::ResponseHandler &cb) {
+    // the subscriptions made by the request are the session's
+    boost::optional<SubscriptionEngine::SessionScope> scope;
+    if (subscription_engine_) {
+      scope.emplace(session);
+    }
+    server_->processData(request, cb);
+  }
+
+  void ApiService::submitRequest(std::string request,
+                                 sptr<Session> session,
+                                 JRpcServer::ResponseHandler cb) {
+    auto call = peekCall(request);
+    auto lane = call and kExpensiveMethods.count(call->method) != 0
+                    ? RpcThreadPool::Lane::EXPENSIVE
+                    : RpcThreadPool::Lane::CHEAP;
+    // the id and the method are kept apart, as the request is moved to the
+    // task
+    std::string id{call ? call->id : std::string_view{}};
+    std::string method{call ? call->method : std::string_view{}};
+    auto request_size = request.size();
+    if (metrics_) {
+      metrics_->recordStarted();
+    }
+    auto submitted = thread_pool_->submit(
+        lane,
+        [wp = weak_from_this(),
+         request = std::move(request),
+         session = std::move(session),
+         cb = metrics_ ? measured(method, request_size, cb) : cb]() {
+          if (auto self = wp.lock()) {
+            self->processRequest(request, session, cb);
+          }
+        });
+    if (not submitted) {
+      // the refusal is recorded apart from the calls
+      if (metrics_) {
+        metrics_->recordRefused(method, request_size);
+      }
+      cb(busyResponse(id));
+    }
+  }
+
+  JRpcServer::ResponseHandler ApiService::measured(
+      std::string method, size_t request_size, JRpcServer::ResponseHandler cb) {
+    return [this,
+            method = std::move(method),
+            request_size,
+            started = RpcMetrics::Clock::now(),
+            cb = std::move(cb)](std::string_view response) {
+      // the handler is called while the service is alive, as the request is
+      // processed by it
+      auto duration = RpcMetrics::Clock::now() - started;
+      if (metrics_->recordFinished(method,
+                                   duration,
+                                   request_size,
+                                   response.size(),
+                                   isErrorResponse(response))) {
+        logger_->warn(
+            "Slow RPC call of {}: {} ms, {} bytes of request",
+            method.empty() ? RpcMetrics::kOtherMethods : method,
+            std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                .count(),
+            request_size);
+      }
+      cb(response);
+    };
+  }
+
+  void ApiService::processBatch(std::vector<std::string> requests,
+                                const sptr<Session> &session) {
+    if (requests.empty()) {
+      return session->respond(std::string{kEmptyBatchResponse});
+    }
+
+    struct Batch {
+      std::vector<std::string> responses;
+      std::atomic_size_t left;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->responses.resize(requests.size());
+    batch->left = requests.size();
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+      submitRequest(std::move(requests[i]),
+                    session,
+                    [batch, i, session](std::string_view response) {
+                      batch->responses[i] = response;
+                      // the one processing the last request responds
+                      if (--batch->left == 0) {
+                        session->respond(joinBatch(batch->responses));
+                      }
+                    });
+    }
+  }
+
   void ApiService::start() {
     thread_pool_->start();
     logger_->debug("Service started");
@@ -10,7 +10,9 @@
 #include <gsl/span>
 
 #include "api/jrpc/jrpc_server_impl.hpp"
+#include "api/service/subscription/subscription_engine.hpp"
 #include "api/transport/listener.hpp"
+#include "api/transport/rpc_metrics.hpp"
 #include "api/transport/rpc_thread_pool.hpp"
 #include "application/app_state_manager.hpp"
 #include "common/logger.hpp"
@@ -32,13 +34,20 @@ namespace kagome::api {
      * @param context - reference to the io context
      * @param listener - a shared ptr to the endpoint listener instance
      * @param processors - shared ptrs to JSON processor instances
+     * @param subscription_engine - keeps the subscriptions of the sessions,
+     * which are told the session the requests come from and are cancelled
+     * once it is closed, if any
+     * @param metrics - records the calls and the sessions, and tells the slow
+     * calls, which are logged, if any
      */
     ApiService(
         const std::shared_ptr<application::AppStateManager> &app_state_manager,
         std::shared_ptr<api::RpcThreadPool> thread_pool,
         std::vector<std::shared_ptr<Listener>> listeners,
         std::shared_ptr<JRpcServer> server,
-        gsl::span<std::shared_ptr<JRpcProcessor>> processors);
+        gsl::span<std::shared_ptr<JRpcProcessor>> processors,
+        std::shared_ptr<SubscriptionEngine> subscription_engine = nullptr,
+        std::shared_ptr<RpcMetrics> metrics = nullptr);
 
     virtual ~ApiService() = default;
 
@@ -47,9 +56,47 @@ namespace kagome::api {
     void stop();
 
    private:
+    /**
+     * @brief processes \arg request of \arg session, telling the
+     * subscription engine the session it comes from
+     * @param cb is given the response
+     */
+    void processRequest(std::string_view request,
+                        const sptr<Session> &session,
+                        const JRpcServer::ResponseHandler &cb);
+
+    /**
+     * @brief processes \arg request of \arg session in the thread pool, in
+     * the lane of the cost of its method
+     * @param cb is given the response, or the refusal if there are too many
+     * expensive calls already
+     */
+    void submitRequest(std::string request,
+                       sptr<Session> session,
+                       JRpcServer::ResponseHandler cb);
+
+    /**
+     * @return \arg cb, which also records the call of \arg method with
+     * \arg request_size long request, started now, once it is given the
+     * response, logging it if it is slow
+     */
+    JRpcServer::ResponseHandler measured(std::string method,
+                                         size_t request_size,
+                                         JRpcServer::ResponseHandler cb);
+
+    /**
+     * @brief processes the requests of a batch concurrently in the thread
+     * pool and responds to \arg session with their responses in the order
+     * of the requests, once all of them are processed
+     */
+    void processBatch(std::vector<std::string> requests,
+                      const sptr<Session> &session);
+
     std::shared_ptr<api::RpcThreadPool> thread_pool_;
     std::vector<sptr<Listener>> listeners_;
     std::shared_ptr<JRpcServer> server_;
+    std::shared_ptr<SubscriptionEngine> subscription_engine_;
+    std::shared_ptr<RpcMetrics> metrics_;
     common::Logger logger_;
   };
 }  // namespace kagome::api
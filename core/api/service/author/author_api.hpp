@@ -32,6 +32,17 @@ namespace kagome::api {
     virtual outcome::result<Hash256> submitExtrinsic(
         const Extrinsic &extrinsic) = 0;
 
+    /**
+     * @brief validates several extrinsics at once, in parallel, and sends
+     * the valid ones to transaction pool. Repeated extrinsics are validated
+     * only once
+     * @param extrinsics extrinsics to submit
+     * @return for each of \arg extrinsics, in the same order, its hash or the
+     * reason it is rejected for
+     */
+    virtual std::vector<outcome::result<Hash256>> submitExtrinsics(
+        const std::vector<Extrinsic> &extrinsics) = 0;
+
     /**
      * @return collection of pending extrinsics
      */
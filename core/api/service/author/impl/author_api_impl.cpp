@@ -5,24 +5,30 @@
 
 #include "api/service/author/impl/author_api_impl.hpp"
 
+#include <unordered_map>
+
 #include <boost/system/error_code.hpp>
 
 #include "common/visitor.hpp"
 #include "network/types/transaction_announce.hpp"
 #include "primitives/transaction.hpp"
+#include "runtime/common/validate_transactions.hpp"
 #include "runtime/tagged_transaction_queue.hpp"
 #include "transaction_pool/transaction_pool.hpp"
+#include "transaction_pool/transaction_pool_error.hpp"
 
 namespace kagome::api {
   AuthorApiImpl::AuthorApiImpl(
       sptr<runtime::TaggedTransactionQueue> api,
       sptr<transaction_pool::TransactionPool> pool,
       sptr<crypto::Hasher> hasher,
-      std::shared_ptr<network::ExtrinsicGossiper> gossiper)
+      std::shared_ptr<network::ExtrinsicGossiper> gossiper,
+      std::shared_ptr<common::WorkerPool> workers)
       : api_{std::move(api)},
         pool_{std::move(pool)},
         hasher_{std::move(hasher)},
         gossiper_{std::move(gossiper)},
+        workers_{std::move(workers)},
         logger_{common::createLogger("AuthorApi")} {
     BOOST_ASSERT_MSG(api_ != nullptr, "author api is nullptr");
     BOOST_ASSERT_MSG(pool_ != nullptr, "transaction pool is nullptr");
@@ -33,6 +39,12 @@ namespace kagome::api {
 
   outcome::result<common::Hash256> AuthorApiImpl::submitExtrinsic(
       const primitives::Extrinsic &extrinsic) {
+    common::Hash256 hash = hasher_->blake2b_256(extrinsic.data);
+    // the runtime is not called for the duplicates, which are the most of
+    // the gossiped extrinsics
+    if (pool_->contains(hash)) {
+      return transaction_pool::TransactionPoolError::TX_ALREADY_IMPORTED;
+    }
     OUTCOME_TRY(res, api_->validate_transaction(extrinsic));
 
     return visit_in_place(
@@ -48,21 +60,7 @@ namespace kagome::api {
         },
         [&](const primitives::ValidTransaction &v)
             -> outcome::result<common::Hash256> {
-          // compose Transaction object
-          common::Hash256 hash = hasher_->blake2b_256(extrinsic.data);
-          size_t length = extrinsic.data.size();
-
-          primitives::Transaction transaction{extrinsic,
-                                              length,
-                                              hash,
-                                              v.priority,
-                                              v.longevity,
-                                              v.requires,
-                                              v.provides,
-                                              v.propagate};
-
-          // send to pool
-          OUTCOME_TRY(pool_->submitOne(std::move(transaction)));
+          OUTCOME_TRY(submitValid(extrinsic, hash, v));
 
           if (v.propagate) {
             network::TransactionAnnounce announce;
@@ -74,6 +72,126 @@ namespace kagome::api {
         });
   }
 
+  std::vector<outcome::result<common::Hash256>>
+  AuthorApiImpl::submitExtrinsics(
+      const std::vector<primitives::Extrinsic> &extrinsics) {
+    std::vector<gsl::span<const uint8_t>> extrinsics_data;
+    extrinsics_data.reserve(extrinsics.size());
+    for (const auto &extrinsic : extrinsics) {
+      extrinsics_data.emplace_back(extrinsic.data);
+    }
+    std::vector<common::Hash256> hashes(extrinsics.size());
+    hasher_->blake2b_256_many(extrinsics_data, hashes);
+    std::vector<outcome::result<common::Hash256>> results(
+        extrinsics.size(), outcome::success(common::Hash256{}));
+    // index of the first occurrence of every extrinsic, which is the only one
+    // checked against the pool and validated
+    std::unordered_map<common::Hash256, size_t> first_of;
+    std::vector<size_t> firsts;
+    std::vector<common::Hash256> first_hashes;
+    for (size_t i = 0; i < extrinsics.size(); i++) {
+      if (first_of.emplace(hashes[i], i).second) {
+        firsts.push_back(i);
+        first_hashes.push_back(hashes[i]);
+      }
+    }
+
+    // the imported and the banned ones are dropped before the runtime is
+    // called, which are the most of the gossiped extrinsics
+    auto checks = pool_->checkUnknown(first_hashes);
+    std::vector<size_t> unique;
+    std::vector<std::reference_wrapper<const primitives::Extrinsic>>
+        unique_extrinsics;
+    for (size_t i = 0; i < firsts.size(); i++) {
+      if (checks[i]) {
+        unique.push_back(firsts[i]);
+        unique_extrinsics.emplace_back(extrinsics[firsts[i]]);
+      } else {
+        results[firsts[i]] = checks[i].error();
+      }
+    }
+    auto validities =
+        runtime::validateTransactions(*api_, unique_extrinsics, workers_);
+
+    // the valid ones are imported to the pool at once, in the order of
+    // arrival, the pool is fed from this thread only
+    std::vector<primitives::Transaction> transactions;
+    std::vector<size_t> submitted;
+    for (size_t i = 0; i < unique.size(); i++) {
+      results[unique[i]] = [&]() -> outcome::result<common::Hash256> {
+        OUTCOME_TRY(validity, std::move(validities[i]));
+        return visit_in_place(
+            validity,
+            [](const primitives::TransactionValidityError &e)
+                -> outcome::result<common::Hash256> {
+              return visit_in_place(
+                  e,
+                  [](const auto &validity_error)
+                      -> outcome::result<common::Hash256> {
+                    return validity_error;
+                  });
+            },
+            [&](const primitives::ValidTransaction &v)
+                -> outcome::result<common::Hash256> {
+              auto &hash = hashes[unique[i]];
+              transactions.push_back(
+                  makeTransaction(extrinsics[unique[i]], hash, v));
+              submitted.push_back(unique[i]);
+              return hash;
+            });
+      }();
+    }
+
+    std::vector<bool> propagate;
+    propagate.reserve(transactions.size());
+    for (auto &transaction : transactions) {
+      propagate.push_back(transaction.should_propagate);
+    }
+    network::TransactionAnnounce announce;
+    auto imports = transactions.empty()
+                       ? std::vector<outcome::result<void>>{}
+                       : pool_->submitEach(std::move(transactions));
+    for (size_t i = 0; i < imports.size(); i++) {
+      if (not imports[i]) {
+        results[submitted[i]] = imports[i].error();
+      } else if (propagate[i]) {
+        announce.extrinsics.push_back(extrinsics[submitted[i]]);
+      }
+    }
+
+    for (size_t i = 0; i < extrinsics.size(); i++) {
+      if (auto first = first_of.at(hashes[i]); first != i) {
+        results[i] = results[first];
+      }
+    }
+
+    if (not announce.extrinsics.empty()) {
+      gossiper_->transactionAnnounce(announce);
+    }
+    return results;
+  }
+
+  primitives::Transaction AuthorApiImpl::makeTransaction(
+      const primitives::Extrinsic &extrinsic,
+      const common::Hash256 &hash,
+      const primitives::ValidTransaction &v) {
+    return primitives::Transaction{extrinsic,
+                                   extrinsic.data.size(),
+                                   hash,
+                                   v.priority,
+                                   v.longevity,
+                                   v.requires,
+                                   v.provides,
+                                   v.propagate};
+  }
+
+  outcome::result<void> AuthorApiImpl::submitValid(
+      const primitives::Extrinsic &extrinsic,
+      const common::Hash256 &hash,
+      const primitives::ValidTransaction &v) {
+    return pool_->submitOne(makeTransaction(extrinsic, hash, v));
+  }
+
   outcome::result<std::vector<primitives::Extrinsic>>
   AuthorApiImpl::pendingExtrinsics() {
     BOOST_ASSERT_MSG(false, "not implemented");  // NOLINT
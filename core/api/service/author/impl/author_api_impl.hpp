@@ -14,6 +14,7 @@
 #include "api/service/author/author_api.hpp"
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
+#include "common/worker_pool.hpp"
 #include "crypto/hasher.hpp"
 #include "network/extrinsic_gossiper.hpp"
 #include "outcome/outcome.hpp"
@@ -39,17 +40,22 @@ namespace kagome::api {
      * @param pool transaction pool instance shared ptr
      * @param hasher hasher instance shared ptr
      * @param block_tree block tree instance shared ptr
+     * @param workers validate the submitted batches in parallel, if any
      */
     AuthorApiImpl(std::shared_ptr<runtime::TaggedTransactionQueue> api,
                   std::shared_ptr<transaction_pool::TransactionPool> pool,
                   std::shared_ptr<crypto::Hasher> hasher,
-                  std::shared_ptr<network::ExtrinsicGossiper> gossiper);
+                  std::shared_ptr<network::ExtrinsicGossiper> gossiper,
+                  std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     ~AuthorApiImpl() override = default;
 
     outcome::result<common::Hash256> submitExtrinsic(
         const primitives::Extrinsic &extrinsic) override;
 
+    std::vector<outcome::result<common::Hash256>> submitExtrinsics(
+        const std::vector<primitives::Extrinsic> &extrinsics) override;
+
     outcome::result<std::vector<primitives::Extrinsic>> pendingExtrinsics()
         override;
 
@@ -58,11 +64,27 @@ namespace kagome::api {
         const std::vector<primitives::ExtrinsicKey> &keys) override;
 
    private:
+    /**
+     * @return transaction of \arg extrinsic validated as \arg v
+     */
+    static primitives::Transaction makeTransaction(
+        const primitives::Extrinsic &extrinsic,
+        const common::Hash256 &hash,
+        const primitives::ValidTransaction &v);
+
+    /**
+     * Sends \arg extrinsic validated as \arg v to transaction pool
+     */
+    outcome::result<void> submitValid(const primitives::Extrinsic &extrinsic,
+                                      const common::Hash256 &hash,
+                                      const primitives::ValidTransaction &v);
+
     sptr<runtime::TaggedTransactionQueue> api_;
     sptr<transaction_pool::TransactionPool> pool_;
     sptr<crypto::Hasher> hasher_;
     sptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<network::ExtrinsicGossiper> gossiper_;
+    std::shared_ptr<common::WorkerPool> workers_;
     common::Logger logger_;
   };
 }  // namespace kagome::api
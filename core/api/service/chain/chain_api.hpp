@@ -9,6 +9,7 @@
 #include <boost/variant.hpp>
 #include "common/buffer.hpp"
 #include "outcome/outcome.hpp"
+#include "primitives/block.hpp"
 #include "primitives/common.hpp"
 
 namespace kagome::api {
@@ -48,6 +49,31 @@ namespace kagome::api {
      */
     virtual outcome::result<std::vector<BlockHash>> getBlockHash(
         gsl::span<const ValueType> values) const = 0;
+
+    /**
+     * @param block_hash hash of the block
+     * @return header of the block
+     */
+    virtual outcome::result<primitives::BlockHeader> getHeader(
+        const BlockHash &block_hash) const = 0;
+
+    /**
+     * @param block_hash hash of the block
+     * @return header and body of the block, error if the body is pruned
+     */
+    virtual outcome::result<primitives::Block> getBlock(
+        const BlockHash &block_hash) const = 0;
+
+    /**
+     * @return hash of the best block
+     */
+    virtual BlockHash getBestBlockHash() const = 0;
+
+    /**
+     * @return true if \arg block is finalized, so that its data never
+     * changes
+     */
+    virtual bool isFinalized(const primitives::BlockInfo &block) const = 0;
   };
 
 }  // namespace kagome::api
@@ -7,13 +7,18 @@
 
 #include "api/jrpc/jrpc_method.hpp"
 #include "api/jrpc/value_converter.hpp"
+#include "api/service/chain/requests/get_block.hpp"
 #include "api/service/chain/requests/get_block_hash.hpp"
+#include "api/service/chain/requests/get_header.hpp"
 
 namespace kagome::api::chain {
 
   ChainJrpcProcessor::ChainJrpcProcessor(std::shared_ptr<JRpcServer> server,
                                          std::shared_ptr<ChainApi> api)
-      : api_{std::move(api)}, server_{std::move(server)} {
+      : api_{std::move(api)},
+        server_{std::move(server)},
+        header_cache_{std::make_shared<ResponseCache>(kHeaderCacheBytes)},
+        block_cache_{std::make_shared<ResponseCache>(kBlockCacheBytes)} {
     BOOST_ASSERT(api_ != nullptr);
     BOOST_ASSERT(server_ != nullptr);
   }
@@ -21,9 +26,18 @@ namespace kagome::api::chain {
   template <typename Request>
   using Handler = Method<Request, ChainApi>;
 
+  template <typename Request>
+  using CachedHandler = CachedMethod<Request, ChainApi>;
+
   void ChainJrpcProcessor::registerHandlers() {
     server_->registerHandler("chain_getBlockHash",
                              Handler<request::GetBlockhash>(api_));
+    // the explorers request the same recent blocks over and over
+    server_->registerHandler(
+        "chain_getHeader",
+        CachedHandler<request::GetHeader>(api_, header_cache_));
+    server_->registerHandler(
+        "chain_getBlock", CachedHandler<request::GetBlock>(api_, block_cache_));
   }
 
 }  // namespace kagome::api::chain
@@ -8,6 +8,7 @@
 
 #include "api/jrpc/jrpc_processor.hpp"
 #include "api/jrpc/jrpc_server_impl.hpp"
+#include "api/jrpc/response_cache.hpp"
 #include "api/service/chain/chain_api.hpp"
 
 namespace kagome::api::chain {
@@ -16,6 +17,13 @@ namespace kagome::api::chain {
    */
   class ChainJrpcProcessor : public JRpcProcessor {
    public:
+    /// max total size of the kept responses with the headers of the
+    /// finalized blocks
+    static constexpr size_t kHeaderCacheBytes = 4 * 1024 * 1024;
+
+    /// max total size of the kept responses with the finalized blocks
+    static constexpr size_t kBlockCacheBytes = 64 * 1024 * 1024;
+
     ChainJrpcProcessor(std::shared_ptr<JRpcServer> server,
                        std::shared_ptr<ChainApi> api);
     void registerHandlers() override;
@@ -23,6 +31,8 @@ namespace kagome::api::chain {
    private:
     std::shared_ptr<ChainApi> api_;
     std::shared_ptr<JRpcServer> server_;
+    std::shared_ptr<ResponseCache> header_cache_;
+    std::shared_ptr<ResponseCache> block_cache_;
   };
 }  // namespace kagome::api::chain
 
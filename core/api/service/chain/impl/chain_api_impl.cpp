@@ -58,4 +58,27 @@ namespace kagome::api {
     return results;
   }
 
+  outcome::result<primitives::BlockHeader> ChainApiImpl::getHeader(
+      const BlockHash &block_hash) const {
+    return block_tree_->getBlockHeader(block_hash);
+  }
+
+  outcome::result<primitives::Block> ChainApiImpl::getBlock(
+      const BlockHash &block_hash) const {
+    OUTCOME_TRY(header, block_tree_->getBlockHeader(block_hash));
+    OUTCOME_TRY(body, block_tree_->getBlockBody(block_hash));
+    return primitives::Block{std::move(header), std::move(body)};
+  }
+
+  BlockHash ChainApiImpl::getBestBlockHash() const {
+    return block_tree_->deepestLeaf().block_hash;
+  }
+
+  bool ChainApiImpl::isFinalized(const primitives::BlockInfo &block) const {
+    auto finalized = block_tree_->getLastFinalized();
+    return block.block_number <= finalized.block_number
+           and block_tree_->hasDirectChain(block.block_hash,
+                                           finalized.block_hash);
+  }
+
 }  // namespace kagome::api
@@ -31,6 +31,16 @@ namespace kagome::api {
     outcome::result<std::vector<BlockHash>> getBlockHash(
         gsl::span<const ValueType> values) const override;
 
+    outcome::result<primitives::BlockHeader> getHeader(
+        const BlockHash &block_hash) const override;
+
+    outcome::result<primitives::Block> getBlock(
+        const BlockHash &block_hash) const override;
+
+    BlockHash getBestBlockHash() const override;
+
+    bool isFinalized(const primitives::BlockInfo &block) const override;
+
    private:
     std::shared_ptr<blockchain::BlockHeaderRepository> block_repo_;
     std::shared_ptr<blockchain::BlockTree> block_tree_;
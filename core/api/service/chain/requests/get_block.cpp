@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/chain/requests/get_block.hpp"
+
+#include "common/hexutil.hpp"
+
+namespace kagome::api::chain::request {
+
+  outcome::result<void> GetBlock::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 1) {
+      throw jsonrpc::InvalidParametersFault("incorrect number of arguments");
+    }
+    if (params.empty() or params[0].IsNil()) {
+      block_hash_.reset();
+      return outcome::success();
+    }
+    if (not params[0].IsString()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'hash' must be a hex string");
+    }
+    OUTCOME_TRY(hash_span, common::unhexWith0x(params[0].AsString()));
+    OUTCOME_TRY(hash, primitives::BlockHash::fromSpan(hash_span));
+    block_hash_ = hash;
+    return outcome::success();
+  }
+
+  outcome::result<primitives::Block> GetBlock::execute() {
+    if (not block_hash_) {
+      return api_->getBlock(api_->getBestBlockHash());
+    }
+    OUTCOME_TRY(block, api_->getBlock(*block_hash_));
+    immutable_ = api_->isFinalized({block.header.number, *block_hash_});
+    return std::move(block);
+  }
+
+  boost::optional<ResponseCache::Key> GetBlock::cacheKey() const {
+    return block_hash_;
+  }
+
+  bool GetBlock::isImmutable() const {
+    return immutable_;
+  }
+
+}  // namespace kagome::api::chain::request
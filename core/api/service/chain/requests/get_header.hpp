@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_CHAIN_REQUEST_GET_HEADER_HPP
+#define KAGOME_API_CHAIN_REQUEST_GET_HEADER_HPP
+
+#include <boost/optional.hpp>
+#include <jsonrpc-lean/request.h>
+
+#include "api/jrpc/response_cache.hpp"
+#include "api/service/chain/chain_api.hpp"
+
+namespace kagome::api::chain::request {
+
+  /**
+   * Header of the block of the given hash, or of the best block if there is
+   * no hash. The ones of the finalized blocks are cached
+   */
+  class GetHeader final {
+   public:
+    explicit GetHeader(std::shared_ptr<ChainApi> api) : api_(std::move(api)) {}
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    using ResultType = primitives::BlockHeader;
+    outcome::result<ResultType> execute();
+
+    /// @return hash of the requested block, none for the best one
+    boost::optional<ResponseCache::Key> cacheKey() const;
+
+    /// @return true if the executed request is of a finalized block
+    bool isImmutable() const;
+
+   private:
+    std::shared_ptr<ChainApi> api_;
+    boost::optional<primitives::BlockHash> block_hash_;
+    bool immutable_ = false;
+  };
+
+}  // namespace kagome::api::chain::request
+
+#endif  // KAGOME_API_CHAIN_REQUEST_GET_HEADER_HPP
@@ -0,0 +1,93 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/impl/profile_api_impl.hpp"
+
+namespace kagome::api {
+
+  ProfileApiImpl::ProfileApiImpl(
+      std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler,
+      std::shared_ptr<network::NetworkMetrics> network_metrics,
+      std::shared_ptr<consensus::ConsensusMetrics> consensus_metrics,
+      std::shared_ptr<RpcMetrics> rpc_metrics,
+      std::shared_ptr<common::Tracer> tracer,
+      std::shared_ptr<common::ProcessProfiler> process_profiler)
+      : runtime_profiler_{std::move(runtime_profiler)},
+        network_metrics_{std::move(network_metrics)},
+        consensus_metrics_{std::move(consensus_metrics)},
+        rpc_metrics_{std::move(rpc_metrics)},
+        tracer_{std::move(tracer)},
+        process_profiler_{std::move(process_profiler)} {
+    BOOST_ASSERT(runtime_profiler_ != nullptr);
+    BOOST_ASSERT(network_metrics_ != nullptr);
+    BOOST_ASSERT(consensus_metrics_ != nullptr);
+    BOOST_ASSERT(rpc_metrics_ != nullptr);
+    BOOST_ASSERT(tracer_ != nullptr);
+    BOOST_ASSERT(process_profiler_ != nullptr);
+  }
+
+  outcome::result<runtime::RuntimeProfiler::Report>
+  ProfileApiImpl::getRuntimeProfile() const {
+    return runtime_profiler_->report();
+  }
+
+  outcome::result<void> ProfileApiImpl::setRuntimeProfiling(bool enabled) {
+    runtime_profiler_->setEnabled(enabled);
+    return outcome::success();
+  }
+
+  outcome::result<void> ProfileApiImpl::resetRuntimeProfile() {
+    runtime_profiler_->reset();
+    return outcome::success();
+  }
+
+  outcome::result<network::NetworkMetrics::Report>
+  ProfileApiImpl::getNetworkMetrics() const {
+    return network_metrics_->report();
+  }
+
+  outcome::result<void> ProfileApiImpl::resetNetworkMetrics() {
+    network_metrics_->reset();
+    return outcome::success();
+  }
+
+  outcome::result<consensus::ConsensusMetrics::Report>
+  ProfileApiImpl::getConsensusMetrics() const {
+    return consensus_metrics_->report();
+  }
+
+  outcome::result<void> ProfileApiImpl::resetConsensusMetrics() {
+    consensus_metrics_->reset();
+    return outcome::success();
+  }
+
+  outcome::result<RpcMetrics::Report> ProfileApiImpl::getRpcMetrics() const {
+    return rpc_metrics_->report();
+  }
+
+  outcome::result<void> ProfileApiImpl::resetRpcMetrics() {
+    rpc_metrics_->reset();
+    return outcome::success();
+  }
+
+  outcome::result<std::string> ProfileApiImpl::getTrace() const {
+    return tracer_->chromeTrace();
+  }
+
+  outcome::result<void> ProfileApiImpl::setTracing(bool enabled) {
+    tracer_->setEnabled(enabled);
+    return outcome::success();
+  }
+
+  outcome::result<std::string> ProfileApiImpl::startProcessProfile(
+      common::ProcessProfiler::Kind kind, std::chrono::seconds duration) {
+    return process_profiler_->start(kind, duration);
+  }
+
+  outcome::result<void> ProfileApiImpl::stopProcessProfile() {
+    return process_profiler_->stop();
+  }
+
+}  // namespace kagome::api
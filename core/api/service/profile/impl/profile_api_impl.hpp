@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_PROFILE_API_IMPL_HPP
+#define KAGOME_API_PROFILE_API_IMPL_HPP
+
+#include <memory>
+
+#include "api/service/profile/profile_api.hpp"
+
+namespace kagome::api {
+
+  class ProfileApiImpl : public ProfileApi {
+   public:
+    ProfileApiImpl(std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler,
+                   std::shared_ptr<network::NetworkMetrics> network_metrics,
+                   std::shared_ptr<consensus::ConsensusMetrics>
+                       consensus_metrics,
+                   std::shared_ptr<RpcMetrics> rpc_metrics,
+                   std::shared_ptr<common::Tracer> tracer,
+                   std::shared_ptr<common::ProcessProfiler> process_profiler);
+
+    ~ProfileApiImpl() override = default;
+
+    outcome::result<runtime::RuntimeProfiler::Report> getRuntimeProfile()
+        const override;
+
+    outcome::result<void> setRuntimeProfiling(bool enabled) override;
+
+    outcome::result<void> resetRuntimeProfile() override;
+
+    outcome::result<network::NetworkMetrics::Report> getNetworkMetrics()
+        const override;
+
+    outcome::result<void> resetNetworkMetrics() override;
+
+    outcome::result<consensus::ConsensusMetrics::Report> getConsensusMetrics()
+        const override;
+
+    outcome::result<void> resetConsensusMetrics() override;
+
+    outcome::result<RpcMetrics::Report> getRpcMetrics() const override;
+
+    outcome::result<void> resetRpcMetrics() override;
+
+    outcome::result<std::string> getTrace() const override;
+
+    outcome::result<void> setTracing(bool enabled) override;
+
+    outcome::result<std::string> startProcessProfile(
+        common::ProcessProfiler::Kind kind,
+        std::chrono::seconds duration) override;
+
+    outcome::result<void> stopProcessProfile() override;
+
+   private:
+    std::shared_ptr<runtime::RuntimeProfiler> runtime_profiler_;
+    std::shared_ptr<network::NetworkMetrics> network_metrics_;
+    std::shared_ptr<consensus::ConsensusMetrics> consensus_metrics_;
+    std::shared_ptr<RpcMetrics> rpc_metrics_;
+    std::shared_ptr<common::Tracer> tracer_;
+    std::shared_ptr<common::ProcessProfiler> process_profiler_;
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_API_PROFILE_API_IMPL_HPP
@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_PROFILE_API_HPP
+#define KAGOME_API_PROFILE_API_HPP
+
+#include <string>
+
+#include "api/transport/rpc_metrics.hpp"
+#include "common/process_profiler.hpp"
+#include "common/tracer.hpp"
+#include "consensus/consensus_metrics.hpp"
+#include "network/network_metrics.hpp"
+#include "outcome/outcome.hpp"
+#include "runtime/runtime_profiler.hpp"
+
+namespace kagome::api {
+
+  /**
+   * @class ProfileApi provides the performance statistics of the node
+   */
+  class ProfileApi {
+   public:
+    virtual ~ProfileApi() = default;
+
+    /**
+     * @return timings of the runtime exports and host functions, and the
+     * heap usage of the exports, collected while the profiling of the
+     * runtime was enabled
+     */
+    virtual outcome::result<runtime::RuntimeProfiler::Report>
+    getRuntimeProfile() const = 0;
+
+    /**
+     * Enables or disables the profiling of the runtime, the collected
+     * timings are kept in either case
+     */
+    virtual outcome::result<void> setRuntimeProfiling(bool enabled) = 0;
+
+    /**
+     * Forgets the timings of the runtime collected so far
+     */
+    virtual outcome::result<void> resetRuntimeProfile() = 0;
+
+    /**
+     * @return traffic of the node by the protocols and the types of the
+     * messages, the depths of the outbound queues of the peers and the round
+     * trips of the requests to them
+     */
+    virtual outcome::result<network::NetworkMetrics::Report>
+    getNetworkMetrics() const = 0;
+
+    /**
+     * Forgets the traffic and the round trips collected so far
+     */
+    virtual outcome::result<void> resetNetworkMetrics() = 0;
+
+    /**
+     * @return timings of the BABE slots and the GRANDPA rounds, the lag of
+     * the finality of the imported blocks, and the votes received in the
+     * rounds
+     */
+    virtual outcome::result<consensus::ConsensusMetrics::Report>
+    getConsensusMetrics() const = 0;
+
+    /**
+     * Forgets the timings and the votes collected so far
+     */
+    virtual outcome::result<void> resetConsensusMetrics() = 0;
+
+    /**
+     * @return calls of the RPC methods, their errors, latencies and sizes,
+     * along with the calls in flight and the open sessions
+     */
+    virtual outcome::result<RpcMetrics::Report> getRpcMetrics() const = 0;
+
+    /**
+     * Forgets the calls collected so far
+     */
+    virtual outcome::result<void> resetRpcMetrics() = 0;
+
+    /**
+     * @return the latest spans of the import of the blocks, the runtime
+     * calls, the stores of the tries and the writes of the blocks, in the
+     * JSON format of the Chrome trace events
+     */
+    virtual outcome::result<std::string> getTrace() const = 0;
+
+    /**
+     * Enables or disables the recording of the spans, the recorded ones are
+     * kept in either case
+     */
+    virtual outcome::result<void> setTracing(bool enabled) = 0;
+
+    /**
+     * Starts the CPU or the heap profile of the node, which is written to
+     * the directory of the profiles once \arg duration passes or it is
+     * stopped
+     * @return path of the file of the CPU profile, or the prefix of the
+     * files of the heap profile
+     */
+    virtual outcome::result<std::string> startProcessProfile(
+        common::ProcessProfiler::Kind kind, std::chrono::seconds duration) = 0;
+
+    /**
+     * Stops the running profile of the node and writes it out
+     */
+    virtual outcome::result<void> stopProcessProfile() = 0;
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_API_PROFILE_API_HPP
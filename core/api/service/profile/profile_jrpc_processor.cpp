@@ -0,0 +1,76 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/profile_jrpc_processor.hpp"
+
+#include "api/jrpc/jrpc_method.hpp"
+#include "api/service/profile/requests/get_consensus_metrics.hpp"
+#include "api/service/profile/requests/get_network_metrics.hpp"
+#include "api/service/profile/requests/get_rpc_metrics.hpp"
+#include "api/service/profile/requests/get_runtime_profile.hpp"
+#include "api/service/profile/requests/get_trace.hpp"
+#include "api/service/profile/requests/reset_consensus_metrics.hpp"
+#include "api/service/profile/requests/reset_network_metrics.hpp"
+#include "api/service/profile/requests/reset_rpc_metrics.hpp"
+#include "api/service/profile/requests/reset_runtime_profile.hpp"
+#include "api/service/profile/requests/set_runtime_profiling.hpp"
+#include "api/service/profile/requests/set_tracing.hpp"
+#include "api/service/profile/requests/start_process_profile.hpp"
+#include "api/service/profile/requests/stop_process_profile.hpp"
+
+namespace kagome::api::profile {
+
+  ProfileJrpcProcessor::ProfileJrpcProcessor(
+      std::shared_ptr<JRpcServer> server, std::shared_ptr<ProfileApi> api)
+      : api_{std::move(api)}, server_{std::move(server)} {
+    BOOST_ASSERT(api_ != nullptr);
+    BOOST_ASSERT(server_ != nullptr);
+  }
+
+  template <typename Request>
+  using Handler = kagome::api::Method<Request, ProfileApi>;
+
+  void ProfileJrpcProcessor::registerHandlers() {
+    server_->registerHandler("profile_getRuntimeProfile",
+                             Handler<request::GetRuntimeProfile>(api_));
+
+    server_->registerHandler("profile_setRuntimeProfiling",
+                             Handler<request::SetRuntimeProfiling>(api_));
+
+    server_->registerHandler("profile_resetRuntimeProfile",
+                             Handler<request::ResetRuntimeProfile>(api_));
+
+    server_->registerHandler("profile_getNetworkMetrics",
+                             Handler<request::GetNetworkMetrics>(api_));
+
+    server_->registerHandler("profile_resetNetworkMetrics",
+                             Handler<request::ResetNetworkMetrics>(api_));
+
+    server_->registerHandler("profile_getConsensusMetrics",
+                             Handler<request::GetConsensusMetrics>(api_));
+
+    server_->registerHandler("profile_resetConsensusMetrics",
+                             Handler<request::ResetConsensusMetrics>(api_));
+
+    server_->registerHandler("profile_getRpcMetrics",
+                             Handler<request::GetRpcMetrics>(api_));
+
+    server_->registerHandler("profile_resetRpcMetrics",
+                             Handler<request::ResetRpcMetrics>(api_));
+
+    server_->registerHandler("profile_getTrace",
+                             Handler<request::GetTrace>(api_));
+
+    server_->registerHandler("profile_setTracing",
+                             Handler<request::SetTracing>(api_));
+
+    server_->registerHandler("profile_startProcessProfile",
+                             Handler<request::StartProcessProfile>(api_));
+
+    server_->registerHandler("profile_stopProcessProfile",
+                             Handler<request::StopProcessProfile>(api_));
+  }
+
+}  // namespace kagome::api::profile
@@ -0,0 +1,31 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_PROFILE_JRPC_PROCESSOR_HPP
+#define KAGOME_PROFILE_JRPC_PROCESSOR_HPP
+
+#include "api/jrpc/jrpc_processor.hpp"
+#include "api/jrpc/jrpc_server_impl.hpp"
+#include "api/service/profile/profile_api.hpp"
+
+namespace kagome::api::profile {
+
+  /**
+   * @brief performance statistics service implementation
+   */
+  class ProfileJrpcProcessor : public JRpcProcessor {
+   public:
+    ProfileJrpcProcessor(std::shared_ptr<JRpcServer> server,
+                         std::shared_ptr<ProfileApi> api);
+    void registerHandlers() override;
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+    std::shared_ptr<JRpcServer> server_;
+  };
+
+}  // namespace kagome::api::profile
+
+#endif  // KAGOME_PROFILE_JRPC_PROCESSOR_HPP
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_CONSENSUS_METRICS
+#define KAGOME_API_REQUEST_GET_CONSENSUS_METRICS
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class GetConsensusMetrics final {
+   public:
+    GetConsensusMetrics(GetConsensusMetrics const &) = delete;
+    GetConsensusMetrics &operator=(GetConsensusMetrics const &) = delete;
+
+    GetConsensusMetrics(GetConsensusMetrics &&) = default;
+    GetConsensusMetrics &operator=(GetConsensusMetrics &&) = default;
+
+    explicit GetConsensusMetrics(std::shared_ptr<ProfileApi> api);
+    ~GetConsensusMetrics() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<consensus::ConsensusMetrics::Report> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_GET_CONSENSUS_METRICS
@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/get_network_metrics.hpp"
+
+namespace kagome::api::profile::request {
+
+  GetNetworkMetrics::GetNetworkMetrics(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> GetNetworkMetrics::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<network::NetworkMetrics::Report>
+  GetNetworkMetrics::execute() {
+    return api_->getNetworkMetrics();
+  }
+
+}  // namespace kagome::api::profile::request
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_NETWORK_METRICS
+#define KAGOME_API_REQUEST_GET_NETWORK_METRICS
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class GetNetworkMetrics final {
+   public:
+    GetNetworkMetrics(GetNetworkMetrics const &) = delete;
+    GetNetworkMetrics &operator=(GetNetworkMetrics const &) = delete;
+
+    GetNetworkMetrics(GetNetworkMetrics &&) = default;
+    GetNetworkMetrics &operator=(GetNetworkMetrics &&) = default;
+
+    explicit GetNetworkMetrics(std::shared_ptr<ProfileApi> api);
+    ~GetNetworkMetrics() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<network::NetworkMetrics::Report> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_GET_NETWORK_METRICS
@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/get_rpc_metrics.hpp"
+
+namespace kagome::api::profile::request {
+
+  GetRpcMetrics::GetRpcMetrics(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> GetRpcMetrics::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<RpcMetrics::Report> GetRpcMetrics::execute() {
+    return api_->getRpcMetrics();
+  }
+
+}  // namespace kagome::api::profile::request
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_RPC_METRICS
+#define KAGOME_API_REQUEST_GET_RPC_METRICS
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class GetRpcMetrics final {
+   public:
+    GetRpcMetrics(GetRpcMetrics const &) = delete;
+    GetRpcMetrics &operator=(GetRpcMetrics const &) = delete;
+
+    GetRpcMetrics(GetRpcMetrics &&) = default;
+    GetRpcMetrics &operator=(GetRpcMetrics &&) = default;
+
+    explicit GetRpcMetrics(std::shared_ptr<ProfileApi> api);
+    ~GetRpcMetrics() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<RpcMetrics::Report> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_GET_RPC_METRICS
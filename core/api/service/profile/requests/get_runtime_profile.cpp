@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/get_runtime_profile.hpp"
+
+namespace kagome::api::profile::request {
+
+  GetRuntimeProfile::GetRuntimeProfile(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> GetRuntimeProfile::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<runtime::RuntimeProfiler::Report>
+  GetRuntimeProfile::execute() {
+    return api_->getRuntimeProfile();
+  }
+
+}  // namespace kagome::api::profile::request
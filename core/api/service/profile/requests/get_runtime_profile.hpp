@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_RUNTIME_PROFILE
+#define KAGOME_API_REQUEST_GET_RUNTIME_PROFILE
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class GetRuntimeProfile final {
+   public:
+    GetRuntimeProfile(GetRuntimeProfile const &) = delete;
+    GetRuntimeProfile &operator=(GetRuntimeProfile const &) = delete;
+
+    GetRuntimeProfile(GetRuntimeProfile &&) = default;
+    GetRuntimeProfile &operator=(GetRuntimeProfile &&) = default;
+
+    explicit GetRuntimeProfile(std::shared_ptr<ProfileApi> api);
+    ~GetRuntimeProfile() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<runtime::RuntimeProfiler::Report> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_GET_RUNTIME_PROFILE
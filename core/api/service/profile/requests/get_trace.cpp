@@ -0,0 +1,26 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/get_trace.hpp"
+
+namespace kagome::api::profile::request {
+
+  GetTrace::GetTrace(std::shared_ptr<ProfileApi> api) : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> GetTrace::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::string> GetTrace::execute() {
+    return api_->getTrace();
+  }
+
+}  // namespace kagome::api::profile::request
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_TRACE
+#define KAGOME_API_REQUEST_GET_TRACE
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class GetTrace final {
+   public:
+    GetTrace(GetTrace const &) = delete;
+    GetTrace &operator=(GetTrace const &) = delete;
+
+    GetTrace(GetTrace &&) = default;
+    GetTrace &operator=(GetTrace &&) = default;
+
+    explicit GetTrace(std::shared_ptr<ProfileApi> api);
+    ~GetTrace() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<std::string> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_GET_TRACE
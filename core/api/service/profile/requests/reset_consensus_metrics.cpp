@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/reset_consensus_metrics.hpp"
+
+namespace kagome::api::profile::request {
+
+  ResetConsensusMetrics::ResetConsensusMetrics(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> ResetConsensusMetrics::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> ResetConsensusMetrics::execute() {
+    return api_->resetConsensusMetrics();
+  }
+
+}  // namespace kagome::api::profile::request
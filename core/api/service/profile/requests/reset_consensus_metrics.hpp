@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_RESET_CONSENSUS_METRICS
+#define KAGOME_API_REQUEST_RESET_CONSENSUS_METRICS
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class ResetConsensusMetrics final {
+   public:
+    ResetConsensusMetrics(ResetConsensusMetrics const &) = delete;
+    ResetConsensusMetrics &operator=(ResetConsensusMetrics const &) = delete;
+
+    ResetConsensusMetrics(ResetConsensusMetrics &&) = default;
+    ResetConsensusMetrics &operator=(ResetConsensusMetrics &&) = default;
+
+    explicit ResetConsensusMetrics(std::shared_ptr<ProfileApi> api);
+    ~ResetConsensusMetrics() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_RESET_CONSENSUS_METRICS
@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/reset_rpc_metrics.hpp"
+
+namespace kagome::api::profile::request {
+
+  ResetRpcMetrics::ResetRpcMetrics(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> ResetRpcMetrics::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> ResetRpcMetrics::execute() {
+    return api_->resetRpcMetrics();
+  }
+
+}  // namespace kagome::api::profile::request
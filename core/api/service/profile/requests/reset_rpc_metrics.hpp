@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_RESET_RPC_METRICS
+#define KAGOME_API_REQUEST_RESET_RPC_METRICS
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class ResetRpcMetrics final {
+   public:
+    ResetRpcMetrics(ResetRpcMetrics const &) = delete;
+    ResetRpcMetrics &operator=(ResetRpcMetrics const &) = delete;
+
+    ResetRpcMetrics(ResetRpcMetrics &&) = default;
+    ResetRpcMetrics &operator=(ResetRpcMetrics &&) = default;
+
+    explicit ResetRpcMetrics(std::shared_ptr<ProfileApi> api);
+    ~ResetRpcMetrics() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_RESET_RPC_METRICS
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_RESET_RUNTIME_PROFILE
+#define KAGOME_API_REQUEST_RESET_RUNTIME_PROFILE
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class ResetRuntimeProfile final {
+   public:
+    ResetRuntimeProfile(ResetRuntimeProfile const &) = delete;
+    ResetRuntimeProfile &operator=(ResetRuntimeProfile const &) = delete;
+
+    ResetRuntimeProfile(ResetRuntimeProfile &&) = default;
+    ResetRuntimeProfile &operator=(ResetRuntimeProfile &&) = default;
+
+    explicit ResetRuntimeProfile(std::shared_ptr<ProfileApi> api);
+    ~ResetRuntimeProfile() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_RESET_RUNTIME_PROFILE
@@ -0,0 +1,32 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/set_runtime_profiling.hpp"
+
+namespace kagome::api::profile::request {
+
+  SetRuntimeProfiling::SetRuntimeProfiling(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> SetRuntimeProfiling::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() != 1) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    if (not params[0].IsBoolean()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'enabled' must be a boolean");
+    }
+    enabled_ = params[0].AsBoolean();
+    return outcome::success();
+  }
+
+  outcome::result<void> SetRuntimeProfiling::execute() {
+    return api_->setRuntimeProfiling(enabled_);
+  }
+
+}  // namespace kagome::api::profile::request
@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_SET_RUNTIME_PROFILING
+#define KAGOME_API_REQUEST_SET_RUNTIME_PROFILING
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class SetRuntimeProfiling final {
+   public:
+    SetRuntimeProfiling(SetRuntimeProfiling const &) = delete;
+    SetRuntimeProfiling &operator=(SetRuntimeProfiling const &) = delete;
+
+    SetRuntimeProfiling(SetRuntimeProfiling &&) = default;
+    SetRuntimeProfiling &operator=(SetRuntimeProfiling &&) = default;
+
+    explicit SetRuntimeProfiling(std::shared_ptr<ProfileApi> api);
+    ~SetRuntimeProfiling() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+    bool enabled_ = false;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_SET_RUNTIME_PROFILING
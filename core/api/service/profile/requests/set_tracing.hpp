@@ -0,0 +1,37 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_SET_TRACING
+#define KAGOME_API_REQUEST_SET_TRACING
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class SetTracing final {
+   public:
+    SetTracing(SetTracing const &) = delete;
+    SetTracing &operator=(SetTracing const &) = delete;
+
+    SetTracing(SetTracing &&) = default;
+    SetTracing &operator=(SetTracing &&) = default;
+
+    explicit SetTracing(std::shared_ptr<ProfileApi> api);
+    ~SetTracing() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+    bool enabled_ = false;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_SET_TRACING
@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/start_process_profile.hpp"
+
+namespace kagome::api::profile::request {
+
+  StartProcessProfile::StartProcessProfile(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> StartProcessProfile::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() != 2) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    if (not params[0].IsString()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'kind' must be a string");
+    }
+    auto &kind = params[0].AsString();
+    if (kind == "cpu") {
+      kind_ = common::ProcessProfiler::Kind::CPU;
+    } else if (kind == "heap") {
+      kind_ = common::ProcessProfiler::Kind::HEAP;
+    } else {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'kind' must be either 'cpu' or 'heap'");
+    }
+    if (not params[1].IsInteger32()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'seconds' must be an integer");
+    }
+    duration_ = std::chrono::seconds{params[1].AsInteger32()};
+    return outcome::success();
+  }
+
+  outcome::result<std::string> StartProcessProfile::execute() {
+    return api_->startProcessProfile(kind_, duration_);
+  }
+
+}  // namespace kagome::api::profile::request
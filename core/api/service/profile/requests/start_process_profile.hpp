@@ -0,0 +1,38 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_START_PROCESS_PROFILE
+#define KAGOME_API_REQUEST_START_PROCESS_PROFILE
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class StartProcessProfile final {
+   public:
+    StartProcessProfile(StartProcessProfile const &) = delete;
+    StartProcessProfile &operator=(StartProcessProfile const &) = delete;
+
+    StartProcessProfile(StartProcessProfile &&) = default;
+    StartProcessProfile &operator=(StartProcessProfile &&) = default;
+
+    explicit StartProcessProfile(std::shared_ptr<ProfileApi> api);
+    ~StartProcessProfile() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<std::string> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+    common::ProcessProfiler::Kind kind_ = common::ProcessProfiler::Kind::CPU;
+    std::chrono::seconds duration_{};
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_START_PROCESS_PROFILE
@@ -0,0 +1,27 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/profile/requests/stop_process_profile.hpp"
+
+namespace kagome::api::profile::request {
+
+  StopProcessProfile::StopProcessProfile(std::shared_ptr<ProfileApi> api)
+      : api_(std::move(api)) {
+    BOOST_ASSERT(api_ != nullptr);
+  }
+
+  outcome::result<void> StopProcessProfile::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (not params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Method takes no params");
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> StopProcessProfile::execute() {
+    return api_->stopProcessProfile();
+  }
+
+}  // namespace kagome::api::profile::request
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_STOP_PROCESS_PROFILE
+#define KAGOME_API_REQUEST_STOP_PROCESS_PROFILE
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/profile/profile_api.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::api::profile::request {
+
+  class StopProcessProfile final {
+   public:
+    StopProcessProfile(StopProcessProfile const &) = delete;
+    StopProcessProfile &operator=(StopProcessProfile const &) = delete;
+
+    StopProcessProfile(StopProcessProfile &&) = default;
+    StopProcessProfile &operator=(StopProcessProfile &&) = default;
+
+    explicit StopProcessProfile(std::shared_ptr<ProfileApi> api);
+    ~StopProcessProfile() = default;
+
+    outcome::result<void> init(jsonrpc::Request::Parameters const &params);
+    outcome::result<void> execute();
+
+   private:
+    std::shared_ptr<ProfileApi> api_;
+  };
+
+}  // namespace kagome::api::profile::request
+
+#endif  // KAGOME_API_REQUEST_STOP_PROCESS_PROFILE
@@ -5,19 +5,86 @@
 
 #include "api/service/state/impl/state_api_impl.hpp"
 
+#include <algorithm>
+#include <map>
 #include <utility>
 
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::api, StateApiImpl::Error, e) {
+  using E = kagome::api::StateApiImpl::Error;
+  switch (e) {
+    case E::TOO_MANY_PAIRS:
+      return "Too many keys start with the prefix, get them page by page "
+             "with state_getKeysPaged";
+  }
+  return "Unknown error";
+}
+
+namespace {
+  using kagome::common::Buffer;
+  using kagome::storage::BufferMapCursor;
+
+  bool startsWith(const Buffer &key, const Buffer &prefix) {
+    return key.size() >= prefix.size()
+           and std::equal(prefix.begin(), prefix.end(), key.begin());
+  }
+
+  /**
+   * Moves \arg cursor to the first key which starts with \arg prefix and
+   * follows \arg prev_key, if present
+   */
+  outcome::result<void> seekPrefix(BufferMapCursor &cursor,
+                                   const Buffer &prefix,
+                                   const boost::optional<Buffer> &prev_key) {
+    if (prev_key.has_value() and not(prev_key.value() < prefix)) {
+      return cursor.seekUpperBound(prev_key.value());
+    }
+    // a trie cursor seeks only an existing key, so the prefix key itself is
+    // looked for first
+    if (cursor.seek(prefix) and cursor.isValid()) {
+      return outcome::success();
+    }
+    return cursor.seekUpperBound(prefix);
+  }
+
+  /**
+   * Calls \arg visitor with a key and the cursor pointing to it for every key
+   * which starts with \arg prefix, beginning from the current position of
+   * \arg cursor, until the visitor returns false. Entries are read one by one
+   * as the cursor moves, so the subtree of the prefix is never loaded as a
+   * whole
+   */
+  template <typename Visitor>
+  outcome::result<void> walkPrefix(BufferMapCursor &cursor,
+                                   const Buffer &prefix,
+                                   const Visitor &visitor) {
+    while (cursor.isValid()) {
+      OUTCOME_TRY(key, cursor.key());
+      if (not startsWith(key, prefix)) {
+        break;
+      }
+      OUTCOME_TRY(proceed, visitor(std::move(key), cursor));
+      if (not proceed) {
+        break;
+      }
+      OUTCOME_TRY(cursor.next());
+    }
+    return outcome::success();
+  }
+}  // namespace
+
 namespace kagome::api {
 
   StateApiImpl::StateApiImpl(
       std::shared_ptr<blockchain::BlockHeaderRepository> block_repo,
       std::shared_ptr<const storage::trie::TrieStorage> trie_storage,
       std::shared_ptr<blockchain::BlockTree> block_tree,
-      std::shared_ptr<runtime::Core> r_core)
+      std::shared_ptr<runtime::Core> r_core,
+      std::shared_ptr<storage::changes_trie::ChangesIndex> changes_index)
       : block_repo_{std::move(block_repo)},
         storage_{std::move(trie_storage)},
         block_tree_{std::move(block_tree)},
-        r_core_{std::move(r_core)} {
+        r_core_{std::move(r_core)},
+        changes_index_{std::move(changes_index)} {
     BOOST_ASSERT(nullptr != block_repo_);
     BOOST_ASSERT(nullptr != storage_);
     BOOST_ASSERT(nullptr != block_tree_);
@@ -32,13 +99,216 @@ namespace kagome::api {
 
   outcome::result<common::Buffer> StateApiImpl::getStorage(
       const common::Buffer &key, const primitives::BlockHash &at) const {
-    OUTCOME_TRY(header, block_repo_->getBlockHeader(at));
-    OUTCOME_TRY(trie_reader, storage_->getEphemeralBatchAt(header.state_root));
-    return trie_reader->get(key);
+    OUTCOME_TRY(snapshot, getSnapshotAt(at));
+    return snapshot->get(key);
+  }
+
+  outcome::result<std::vector<primitives::StorageChangeSet>>
+  StateApiImpl::queryStorageAt(
+      const std::vector<common::Buffer> &keys,
+      const boost::optional<primitives::BlockHash> &at) const {
+    auto block = at ? at.value() : block_tree_->getLastFinalized().block_hash;
+    OUTCOME_TRY(snapshot, getSnapshotAt(block));
+    OUTCOME_TRY(values, snapshot->getMany(keys));
+
+    primitives::StorageChangeSet change_set{.block = block};
+    change_set.changes.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      change_set.changes.push_back({keys[i], std::move(values[i])});
+    }
+    return std::vector<primitives::StorageChangeSet>{std::move(change_set)};
+  }
+
+  outcome::result<std::vector<primitives::StorageChangeSet>>
+  StateApiImpl::queryStorage(
+      const std::vector<common::Buffer> &keys,
+      const primitives::BlockHash &from,
+      const boost::optional<primitives::BlockHash> &to) const {
+    auto to_hash = to ? to.value() : block_tree_->getLastFinalized().block_hash;
+    OUTCOME_TRY(from_number, block_repo_->getNumberByHash(from));
+    OUTCOME_TRY(to_number, block_repo_->getNumberByHash(to_hash));
+    std::vector<primitives::BlockInfo> blocks{{from_number, from}};
+    if (to_number > from_number) {
+      OUTCOME_TRY(changing,
+                  changingBlocks(keys,
+                                 {from_number, from},
+                                 {to_number, to_hash}));
+      blocks.insert(blocks.end(), changing.begin(), changing.end());
+    }
+
+    // the states of a range are read once, so they are not cached
+    std::vector<primitives::StorageChangeSet> change_sets;
+    std::vector<boost::optional<common::Buffer>> last_values;
+    for (auto &block : blocks) {
+      OUTCOME_TRY(header, block_repo_->getBlockHeader(block.block_hash));
+      OUTCOME_TRY(snapshot, storage_->getSnapshotAt(header.state_root));
+      OUTCOME_TRY(values, snapshot->getMany(keys));
+      primitives::StorageChangeSet change_set{.block = block.block_hash};
+      for (size_t i = 0; i < keys.size(); i++) {
+        if (last_values.empty() or last_values[i] != values[i]) {
+          change_set.changes.push_back({keys[i], values[i]});
+        }
+      }
+      if (last_values.empty() or not change_set.changes.empty()) {
+        change_sets.push_back(std::move(change_set));
+      }
+      last_values = std::move(values);
+    }
+    return change_sets;
+  }
+
+  outcome::result<std::vector<common::Buffer>> StateApiImpl::getKeysPaged(
+      const boost::optional<common::Buffer> &prefix_opt,
+      uint32_t keys_amount,
+      const boost::optional<common::Buffer> &prev_key,
+      const boost::optional<primitives::BlockHash> &at) const {
+    std::vector<common::Buffer> keys;
+    if (keys_amount == 0) {
+      return keys;
+    }
+    const auto &prefix = prefix_opt ? prefix_opt.value() : common::Buffer{};
+    OUTCOME_TRY(snapshot, getSnapshotAt(at));
+    auto cursor = snapshot->cursor();
+    OUTCOME_TRY(seekPrefix(*cursor, prefix, prev_key));
+
+    OUTCOME_TRY(walkPrefix(
+        *cursor,
+        prefix,
+        [&keys, keys_amount](common::Buffer &&key,
+                             const storage::BufferMapCursor &)
+            -> outcome::result<bool> {
+          keys.emplace_back(std::move(key));
+          return keys.size() < keys_amount;
+        }));
+    return keys;
+  }
+
+  outcome::result<std::vector<std::pair<common::Buffer, common::Buffer>>>
+  StateApiImpl::getPairs(
+      const common::Buffer &prefix,
+      const boost::optional<primitives::BlockHash> &at) const {
+    OUTCOME_TRY(snapshot, getSnapshotAt(at));
+    auto cursor = snapshot->cursor();
+    OUTCOME_TRY(seekPrefix(*cursor, prefix, boost::none));
+
+    std::vector<std::pair<common::Buffer, common::Buffer>> pairs;
+    auto too_many = false;
+    OUTCOME_TRY(walkPrefix(
+        *cursor,
+        prefix,
+        [&pairs, &too_many](common::Buffer &&key,
+                            const storage::BufferMapCursor &cursor)
+            -> outcome::result<bool> {
+          if (pairs.size() == kMaxPairsNum) {
+            too_many = true;
+            return false;
+          }
+          OUTCOME_TRY(value, cursor.value());
+          pairs.emplace_back(std::move(key), std::move(value));
+          return true;
+        }));
+    if (too_many) {
+      return Error::TOO_MANY_PAIRS;
+    }
+    return pairs;
   }
 
   outcome::result<primitives::Version> StateApiImpl::getRuntimeVersion(
       const boost::optional<primitives::BlockHash> &at) const {
     return r_core_->version(at);
   }
+
+  outcome::result<primitives::ReadProof> StateApiImpl::getReadProof(
+      const std::vector<common::Buffer> &keys,
+      const boost::optional<primitives::BlockHash> &at) const {
+    auto block = at ? at.value() : block_tree_->getLastFinalized().block_hash;
+    // the proof is made of the stored nodes, so the trie is loaded afresh
+    // rather than taken from a snapshot, which nodes are loaded already
+    OUTCOME_TRY(header, block_repo_->getBlockHeader(block));
+    OUTCOME_TRY(proof, storage_->getProofAt(header.state_root, keys));
+    return primitives::ReadProof{block, std::move(proof)};
+  }
+
+  outcome::result<std::vector<primitives::BlockInfo>>
+  StateApiImpl::changingBlocks(const std::vector<common::Buffer> &keys,
+                               const primitives::BlockInfo &from,
+                               const primitives::BlockInfo &to) const {
+    if (changes_index_ != nullptr) {
+      std::map<primitives::BlockNumber, primitives::BlockHash> changing;
+      auto indexed = true;
+      for (auto &key : keys) {
+        auto blocks =
+            changes_index_->keyChanges(key, from.block_number + 1, to);
+        if (not blocks) {
+          indexed = false;
+          break;
+        }
+        for (auto &block : blocks.value()) {
+          changing.emplace(block.block_number, block.block_hash);
+        }
+      }
+      if (indexed) {
+        std::vector<primitives::BlockInfo> blocks;
+        blocks.reserve(changing.size());
+        for (auto &[number, hash] : changing) {
+          blocks.emplace_back(number, hash);
+        }
+        return blocks;
+      }
+    }
+
+    // every block of the range is read, from the last one to its ancestors
+    std::vector<primitives::BlockInfo> blocks;
+    auto block = to;
+    while (block.block_number > from.block_number) {
+      blocks.push_back(block);
+      OUTCOME_TRY(header, block_repo_->getBlockHeader(block.block_hash));
+      block = {block.block_number - 1, header.parent_hash};
+    }
+    std::reverse(blocks.begin(), blocks.end());
+    return blocks;
+  }
+
+  outcome::result<StateApiImpl::Snapshot> StateApiImpl::getSnapshotAt(
+      const boost::optional<primitives::BlockHash> &at) const {
+    return getSnapshotAt(at ? at.value()
+                            : block_tree_->getLastFinalized().block_hash);
+  }
+
+  outcome::result<StateApiImpl::Snapshot> StateApiImpl::getSnapshotAt(
+      const primitives::BlockHash &block) const {
+    auto find_cached = [this, &block]() -> boost::optional<Snapshot> {
+      auto it = std::find_if(
+          snapshots_.begin(), snapshots_.end(), [&block](auto &entry) {
+            return entry.first == block;
+          });
+      if (it == snapshots_.end()) {
+        return boost::none;
+      }
+      snapshots_.splice(snapshots_.begin(), snapshots_, it);
+      return snapshots_.front().second;
+    };
+    {
+      std::lock_guard lock{snapshots_mutex_};
+      if (auto cached = find_cached()) {
+        return cached.value();
+      }
+    }
+    // the state of a block never changes, so its snapshot is valid as long
+    // as it is kept; it is made without the lock, so that a slow read of the
+    // header doesn't stall the other readers
+    OUTCOME_TRY(header, block_repo_->getBlockHeader(block));
+    OUTCOME_TRY(snapshot, storage_->getSnapshotAt(header.state_root));
+
+    std::lock_guard lock{snapshots_mutex_};
+    // another thread may have made it meanwhile
+    if (auto cached = find_cached()) {
+      return cached.value();
+    }
+    snapshots_.emplace_front(block, snapshot);
+    if (snapshots_.size() > kSnapshotCacheSize) {
+      snapshots_.pop_back();
+    }
+    return snapshot;
+  }
 }  // namespace kagome::api
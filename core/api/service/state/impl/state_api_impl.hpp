@@ -6,21 +6,42 @@
 #ifndef KAGOME_STATE_API_IMPL_HPP
 #define KAGOME_STATE_API_IMPL_HPP
 
+#include <list>
+#include <mutex>
+
 #include "api/service/state/readonly_trie_builder.hpp"
 #include "api/service/state/state_api.hpp"
 #include "blockchain/block_header_repository.hpp"
 #include "blockchain/block_tree.hpp"
 #include "runtime/core.hpp"
+#include "storage/changes_trie/impl/changes_index.hpp"
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::api {
 
+  /**
+   * The snapshots of the states of the recent blocks the clients read are
+   * kept, so that a read of a key at a block is a walk of its trie, without
+   * reading the header of the block and the root of its trie every time
+   */
   class StateApiImpl final : public StateApi {
    public:
+    /// number of the blocks the snapshots of which are kept
+    static constexpr size_t kSnapshotCacheSize = 16;
+
+    /// most key-value pairs returned at once, as many as the keys of a page
+    static constexpr size_t kMaxPairsNum = 1000;
+
+    enum class Error {
+      TOO_MANY_PAIRS = 1,
+    };
+
     StateApiImpl(std::shared_ptr<blockchain::BlockHeaderRepository> block_repo,
                  std::shared_ptr<const storage::trie::TrieStorage> trie_storage,
                  std::shared_ptr<blockchain::BlockTree> block_tree,
-                 std::shared_ptr<runtime::Core> r_core);
+                 std::shared_ptr<runtime::Core> r_core,
+                 std::shared_ptr<storage::changes_trie::ChangesIndex>
+                     changes_index = nullptr);
 
     outcome::result<common::Buffer> getStorage(
         const common::Buffer &key) const override;
@@ -28,16 +49,75 @@ namespace kagome::api {
         const common::Buffer &key,
         const primitives::BlockHash &at) const override;
 
+    outcome::result<std::vector<primitives::StorageChangeSet>> queryStorageAt(
+        const std::vector<common::Buffer> &keys,
+        const boost::optional<primitives::BlockHash> &at) const override;
+
+    outcome::result<std::vector<primitives::StorageChangeSet>> queryStorage(
+        const std::vector<common::Buffer> &keys,
+        const primitives::BlockHash &from,
+        const boost::optional<primitives::BlockHash> &to) const override;
+
+    outcome::result<std::vector<common::Buffer>> getKeysPaged(
+        const boost::optional<common::Buffer> &prefix,
+        uint32_t keys_amount,
+        const boost::optional<common::Buffer> &prev_key,
+        const boost::optional<primitives::BlockHash> &at) const override;
+
+    /**
+     * Fails, if more than kMaxPairsNum keys start with \arg prefix, before
+     * the values past the limit are read
+     */
+    outcome::result<std::vector<std::pair<common::Buffer, common::Buffer>>>
+    getPairs(const common::Buffer &prefix,
+             const boost::optional<primitives::BlockHash> &at) const override;
+
     outcome::result<primitives::Version> getRuntimeVersion(
         const boost::optional<primitives::BlockHash> &at) const override;
 
+    outcome::result<primitives::ReadProof> getReadProof(
+        const std::vector<common::Buffer> &keys,
+        const boost::optional<primitives::BlockHash> &at) const override;
+
    private:
+    using Snapshot = std::shared_ptr<const storage::trie::TrieSnapshot>;
+
+    /**
+     * @return the snapshot of the state of block \arg at, or of the last
+     * finalized block if it is none
+     */
+    outcome::result<Snapshot> getSnapshotAt(
+        const boost::optional<primitives::BlockHash> &at) const;
+
+    /**
+     * @return the snapshot of the state of \arg block
+     */
+    outcome::result<Snapshot> getSnapshotAt(
+        const primitives::BlockHash &block) const;
+
+    /**
+     * @return the blocks after \arg from up to \arg to, which may change
+     * \arg keys, in the order of their numbers: the ones the index finds,
+     * or all of them if it doesn't cover the range
+     */
+    outcome::result<std::vector<primitives::BlockInfo>> changingBlocks(
+        const std::vector<common::Buffer> &keys,
+        const primitives::BlockInfo &from,
+        const primitives::BlockInfo &to) const;
+
     std::shared_ptr<blockchain::BlockHeaderRepository> block_repo_;
     std::shared_ptr<const storage::trie::TrieStorage> storage_;
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<runtime::Core> r_core_;
+    std::shared_ptr<storage::changes_trie::ChangesIndex> changes_index_;
+
+    /// the snapshots of the blocks, the most recently read first
+    mutable std::list<std::pair<primitives::BlockHash, Snapshot>> snapshots_;
+    mutable std::mutex snapshots_mutex_;
   };
 
 }  // namespace kagome::api
 
+OUTCOME_HPP_DECLARE_ERROR(kagome::api, StateApiImpl::Error);
+
 #endif  // KAGOME_STATE_API_IMPL_HPP
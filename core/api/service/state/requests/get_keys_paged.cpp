@@ -0,0 +1,70 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/state/requests/get_keys_paged.hpp"
+
+namespace kagome::api::state::request {
+
+  outcome::result<void> GetKeysPaged::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 4 or params.size() < 2) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    auto &param0 = params[0];
+    if (param0.IsNil()) {
+      prefix_.reset();
+    } else if (param0.IsString()) {
+      OUTCOME_TRY(prefix, common::unhexWith0x(param0.AsString()));
+      prefix_.emplace(std::move(prefix));
+    } else {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'prefix' must be a hex string");
+    }
+
+    auto &param1 = params[1];
+    if (not param1.IsInteger32() or param1.AsInteger32() < 0) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'count' must be a non-negative integer");
+    }
+    keys_amount_ = param1.AsInteger32();
+    if (keys_amount_ > kMaxKeysAmount) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'count' must not exceed "
+          + std::to_string(kMaxKeysAmount));
+    }
+
+    if (params.size() > 2 and not params[2].IsNil()) {
+      auto &param2 = params[2];
+      if (not param2.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'prev_key' must be a hex string");
+      }
+      OUTCOME_TRY(prev_key, common::unhexWith0x(param2.AsString()));
+      prev_key_.emplace(std::move(prev_key));
+    } else {
+      prev_key_.reset();
+    }
+
+    if (params.size() > 3 and not params[3].IsNil()) {
+      auto &param3 = params[3];
+      if (not param3.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'at' must be a hex string");
+      }
+      auto &&at_str = param3.AsString();
+      OUTCOME_TRY(at_span, common::unhexWith0x(at_str));
+      OUTCOME_TRY(at, primitives::BlockHash::fromSpan(at_span));
+      at_.reset(at);
+    } else {
+      at_.reset();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<common::Buffer>> GetKeysPaged::execute() {
+    return api_->getKeysPaged(prefix_, keys_amount_, prev_key_, at_);
+  }
+
+}  // namespace kagome::api::state::request
@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_KEYS_PAGED
+#define KAGOME_API_REQUEST_GET_KEYS_PAGED
+
+#include <jsonrpc-lean/request.h>
+
+#include <boost/optional.hpp>
+
+#include "api/service/state/state_api.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/block_id.hpp"
+
+namespace kagome::api::state::request {
+
+  class GetKeysPaged final {
+   public:
+    /// max number of keys in one page, keeps a response reasonably small
+    static constexpr uint32_t kMaxKeysAmount = 1000;
+
+    GetKeysPaged(GetKeysPaged const &) = delete;
+    GetKeysPaged &operator=(GetKeysPaged const &) = delete;
+
+    GetKeysPaged(GetKeysPaged &&) = default;
+    GetKeysPaged &operator=(GetKeysPaged &&) = default;
+
+    explicit GetKeysPaged(std::shared_ptr<StateApi> api)
+        : api_(std::move(api)){};
+    ~GetKeysPaged() = default;
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    outcome::result<std::vector<common::Buffer>> execute();
+
+   private:
+    std::shared_ptr<StateApi> api_;
+    boost::optional<common::Buffer> prefix_;
+    uint32_t keys_amount_ = 0;
+    boost::optional<common::Buffer> prev_key_;
+    boost::optional<kagome::primitives::BlockHash> at_;
+  };
+
+}  // namespace kagome::api::state::request
+
+#endif  // KAGOME_API_REQUEST_GET_KEYS_PAGED
@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/state/requests/get_pairs.hpp"
+
+namespace kagome::api::state::request {
+
+  outcome::result<void> GetPairs::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 2 or params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    auto &param0 = params[0];
+    if (not param0.IsString()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'prefix' must be a hex string");
+    }
+    OUTCOME_TRY(prefix, common::unhexWith0x(param0.AsString()));
+    prefix_ = common::Buffer(std::move(prefix));
+
+    if (params.size() > 1 and not params[1].IsNil()) {
+      auto &param1 = params[1];
+      if (not param1.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'at' must be a hex string");
+      }
+      auto &&at_str = param1.AsString();
+      OUTCOME_TRY(at_span, common::unhexWith0x(at_str));
+      OUTCOME_TRY(at, primitives::BlockHash::fromSpan(at_span));
+      at_.reset(at);
+    } else {
+      at_.reset();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<std::pair<common::Buffer, common::Buffer>>>
+  GetPairs::execute() {
+    return api_->getPairs(prefix_, at_);
+  }
+
+}  // namespace kagome::api::state::request
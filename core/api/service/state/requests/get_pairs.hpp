@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_PAIRS
+#define KAGOME_API_REQUEST_GET_PAIRS
+
+#include <jsonrpc-lean/request.h>
+
+#include <boost/optional.hpp>
+
+#include "api/service/state/state_api.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/block_id.hpp"
+
+namespace kagome::api::state::request {
+
+  class GetPairs final {
+   public:
+    GetPairs(GetPairs const &) = delete;
+    GetPairs &operator=(GetPairs const &) = delete;
+
+    GetPairs(GetPairs &&) = default;
+    GetPairs &operator=(GetPairs &&) = default;
+
+    explicit GetPairs(std::shared_ptr<StateApi> api) : api_(std::move(api)){};
+    ~GetPairs() = default;
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    outcome::result<std::vector<std::pair<common::Buffer, common::Buffer>>>
+    execute();
+
+   private:
+    std::shared_ptr<StateApi> api_;
+    common::Buffer prefix_;
+    boost::optional<kagome::primitives::BlockHash> at_;
+  };
+
+}  // namespace kagome::api::state::request
+
+#endif  // KAGOME_API_REQUEST_GET_PAIRS
@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/state/requests/get_read_proof.hpp"
+
+namespace kagome::api::state::request {
+
+  outcome::result<void> GetReadProof::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 2 or params.empty()) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    auto &param0 = params[0];
+    if (not param0.IsArray()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'keys' must be an array of hex strings");
+    }
+    keys_.clear();
+    keys_.reserve(param0.AsArray().size());
+    for (auto &key_value : param0.AsArray()) {
+      if (not key_value.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'keys' must be an array of hex strings");
+      }
+      OUTCOME_TRY(key, common::unhexWith0x(key_value.AsString()));
+      keys_.emplace_back(std::move(key));
+    }
+
+    if (params.size() > 1 and not params[1].IsNil()) {
+      auto &param1 = params[1];
+      if (not param1.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'at' must be a hex string");
+      }
+      auto &&at_str = param1.AsString();
+      OUTCOME_TRY(at_span, common::unhexWith0x(at_str));
+      OUTCOME_TRY(at, primitives::BlockHash::fromSpan(at_span));
+      at_.reset(at);
+    } else {
+      at_.reset();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<primitives::ReadProof> GetReadProof::execute() {
+    return api_->getReadProof(keys_, at_);
+  }
+
+}  // namespace kagome::api::state::request
@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_GET_READ_PROOF
+#define KAGOME_API_REQUEST_GET_READ_PROOF
+
+#include <jsonrpc-lean/request.h>
+
+#include <boost/optional.hpp>
+
+#include "api/service/state/state_api.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/block_id.hpp"
+
+namespace kagome::api::state::request {
+
+  class GetReadProof final {
+   public:
+    GetReadProof(GetReadProof const &) = delete;
+    GetReadProof &operator=(GetReadProof const &) = delete;
+
+    GetReadProof(GetReadProof &&) = default;
+    GetReadProof &operator=(GetReadProof &&) = default;
+
+    explicit GetReadProof(std::shared_ptr<StateApi> api)
+        : api_(std::move(api)){};
+    ~GetReadProof() = default;
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    outcome::result<primitives::ReadProof> execute();
+
+   private:
+    std::shared_ptr<StateApi> api_;
+    std::vector<common::Buffer> keys_;
+    boost::optional<kagome::primitives::BlockHash> at_;
+  };
+
+}  // namespace kagome::api::state::request
+
+#endif  // KAGOME_API_REQUEST_GET_READ_PROOF
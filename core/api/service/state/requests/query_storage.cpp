@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/state/requests/query_storage.hpp"
+
+namespace kagome::api::state::request {
+
+  outcome::result<void> QueryStorage::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 3 or params.size() < 2) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    auto &param0 = params[0];
+    if (not param0.IsArray()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'keys' must be an array of hex strings");
+    }
+    keys_.clear();
+    keys_.reserve(param0.AsArray().size());
+    for (auto &key_value : param0.AsArray()) {
+      if (not key_value.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'keys' must be an array of hex strings");
+      }
+      OUTCOME_TRY(key, common::unhexWith0x(key_value.AsString()));
+      keys_.emplace_back(std::move(key));
+    }
+
+    auto &param1 = params[1];
+    if (not param1.IsString()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'from' must be a hex string");
+    }
+    OUTCOME_TRY(from_span, common::unhexWith0x(param1.AsString()));
+    OUTCOME_TRY(from, primitives::BlockHash::fromSpan(from_span));
+    from_ = from;
+
+    if (params.size() > 2 and not params[2].IsNil()) {
+      auto &param2 = params[2];
+      if (not param2.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'to' must be a hex string");
+      }
+      OUTCOME_TRY(to_span, common::unhexWith0x(param2.AsString()));
+      OUTCOME_TRY(to, primitives::BlockHash::fromSpan(to_span));
+      to_.reset(to);
+    } else {
+      to_.reset();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<primitives::StorageChangeSet>>
+  QueryStorage::execute() {
+    return api_->queryStorage(keys_, from_, to_);
+  }
+
+}  // namespace kagome::api::state::request
@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_REQUEST_QUERY_STORAGE
+#define KAGOME_API_REQUEST_QUERY_STORAGE
+
+#include <jsonrpc-lean/request.h>
+
+#include <boost/optional.hpp>
+
+#include "api/service/state/state_api.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/block_id.hpp"
+
+namespace kagome::api::state::request {
+
+  class QueryStorage final {
+   public:
+    QueryStorage(QueryStorage const &) = delete;
+    QueryStorage &operator=(QueryStorage const &) = delete;
+
+    QueryStorage(QueryStorage &&) = default;
+    QueryStorage &operator=(QueryStorage &&) = default;
+
+    explicit QueryStorage(std::shared_ptr<StateApi> api)
+        : api_(std::move(api)){};
+    ~QueryStorage() = default;
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    outcome::result<std::vector<primitives::StorageChangeSet>> execute();
+
+   private:
+    std::shared_ptr<StateApi> api_;
+    std::vector<common::Buffer> keys_;
+    primitives::BlockHash from_;
+    boost::optional<kagome::primitives::BlockHash> to_;
+  };
+
+}  // namespace kagome::api::state::request
+
+#endif  // KAGOME_API_REQUEST_QUERY_STORAGE
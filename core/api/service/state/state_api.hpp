@@ -11,6 +11,8 @@
 #include "common/buffer.hpp"
 #include "outcome/outcome.hpp"
 #include "primitives/common.hpp"
+#include "primitives/read_proof.hpp"
+#include "primitives/storage_change_set.hpp"
 #include "primitives/version.hpp"
 
 namespace kagome::api {
@@ -22,8 +24,55 @@ namespace kagome::api {
         const common::Buffer &key) const = 0;
     virtual outcome::result<common::Buffer> getStorage(
         const common::Buffer &key, const primitives::BlockHash &at) const = 0;
+    /**
+     * @return values of \arg keys at block \arg at, or at the last finalized
+     * block if it is none. All values are read in one pass over the state
+     */
+    virtual outcome::result<std::vector<primitives::StorageChangeSet>>
+    queryStorageAt(const std::vector<common::Buffer> &keys,
+                   const boost::optional<primitives::BlockHash> &at) const = 0;
+    /**
+     * @return values of \arg keys at block \arg from, followed by the
+     * values changed by each block after it up to \arg to, or up to the last
+     * finalized block if it is none. The blocks changing the keys are found
+     * in the index of the changes tries, when it covers the range, so that
+     * only their states are read
+     */
+    virtual outcome::result<std::vector<primitives::StorageChangeSet>>
+    queryStorage(const std::vector<common::Buffer> &keys,
+                 const primitives::BlockHash &from,
+                 const boost::optional<primitives::BlockHash> &to) const = 0;
+    /**
+     * @return at most \arg keys_amount keys which start with \arg prefix (all
+     * keys if it is none) and follow \arg prev_key (if any) in lexicographical
+     * order, at block \arg at or at the last finalized block if it is none.
+     * Only the returned keys are read from the state
+     */
+    virtual outcome::result<std::vector<common::Buffer>> getKeysPaged(
+        const boost::optional<common::Buffer> &prefix,
+        uint32_t keys_amount,
+        const boost::optional<common::Buffer> &prev_key,
+        const boost::optional<primitives::BlockHash> &at) const = 0;
+    /**
+     * @return all key-value pairs which keys start with \arg prefix at block
+     * \arg at, or at the last finalized block if it is none; an error, if
+     * there are too many of them to be returned at once
+     */
+    virtual outcome::result<
+        std::vector<std::pair<common::Buffer, common::Buffer>>>
+    getPairs(const common::Buffer &prefix,
+             const boost::optional<primitives::BlockHash> &at) const = 0;
     virtual outcome::result<primitives::Version> getRuntimeVersion(
         const boost::optional<primitives::BlockHash> &at) const = 0;
+    /**
+     * @return merkle proof of the values of \arg keys, present or absent,
+     * at block \arg at, or at the last finalized block if it is none. The
+     * keys are looked up in one pass over the state, and the nodes shared by
+     * their paths are included once
+     */
+    virtual outcome::result<primitives::ReadProof> getReadProof(
+        const std::vector<common::Buffer> &keys,
+        const boost::optional<primitives::BlockHash> &at) const = 0;
   };
 
 }  // namespace kagome::api
@@ -6,8 +6,13 @@
 #include "api/service/state/state_jrpc_processor.hpp"
 
 #include "api/jrpc/jrpc_method.hpp"
+#include "api/service/state/requests/get_keys_paged.hpp"
+#include "api/service/state/requests/get_pairs.hpp"
+#include "api/service/state/requests/get_read_proof.hpp"
 #include "api/service/state/requests/get_runtime_version.hpp"
 #include "api/service/state/requests/get_storage.hpp"
+#include "api/service/state/requests/query_storage.hpp"
+#include "api/service/state/requests/query_storage_at.hpp"
 
 namespace kagome::api::state {
 
@@ -25,8 +30,23 @@ namespace kagome::api::state {
     server_->registerHandler("state_getStorage",
                              Handler<request::GetStorage>(api_));
 
+    server_->registerHandler("state_getKeysPaged",
+                             Handler<request::GetKeysPaged>(api_));
+
+    server_->registerHandler("state_getPairs",
+                             Handler<request::GetPairs>(api_));
+
     server_->registerHandler("state_getRuntimeVersion",
                              Handler<request::GetRuntimeVersion>(api_));
+
+    server_->registerHandler("state_queryStorageAt",
+                             Handler<request::QueryStorageAt>(api_));
+
+    server_->registerHandler("state_queryStorage",
+                             Handler<request::QueryStorage>(api_));
+
+    server_->registerHandler("state_getReadProof",
+                             Handler<request::GetReadProof>(api_));
   }
 
 }  // namespace kagome::api::state
@@ -0,0 +1,41 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_HEADS_HPP
+#define KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_HEADS_HPP
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/subscription/subscription_engine.hpp"
+
+namespace kagome::api::subscription::request {
+
+  /**
+   * Subscribes the session to the heads of \tparam kTopic
+   */
+  template <SubscriptionEngine::Topic kTopic>
+  class SubscribeHeads final {
+   public:
+    explicit SubscribeHeads(std::shared_ptr<SubscriptionEngine> engine)
+        : engine_(std::move(engine)) {}
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params) {
+      if (not params.empty()) {
+        throw jsonrpc::InvalidParametersFault("Method takes no params");
+      }
+      return outcome::success();
+    }
+
+    outcome::result<SubscriptionEngine::SubscriptionId> execute() {
+      return engine_->subscribeHeads(kTopic);
+    }
+
+   private:
+    std::shared_ptr<SubscriptionEngine> engine_;
+  };
+
+}  // namespace kagome::api::subscription::request
+
+#endif  // KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_HEADS_HPP
@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/subscription/requests/subscribe_storage.hpp"
+
+#include "common/hexutil.hpp"
+
+namespace kagome::api::subscription::request {
+
+  outcome::result<void> SubscribeStorage::init(
+      const jsonrpc::Request::Parameters &params) {
+    if (params.size() > 1) {
+      throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+    }
+    keys_.clear();
+    if (params.empty() or params[0].IsNil()) {
+      return outcome::success();
+    }
+    auto &param0 = params[0];
+    if (not param0.IsArray()) {
+      throw jsonrpc::InvalidParametersFault(
+          "Parameter 'keys' must be an array of hex strings");
+    }
+    keys_.reserve(param0.AsArray().size());
+    for (auto &key_value : param0.AsArray()) {
+      if (not key_value.IsString()) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'keys' must be an array of hex strings");
+      }
+      OUTCOME_TRY(key, common::unhexWith0x(key_value.AsString()));
+      keys_.emplace_back(std::move(key));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<SubscriptionEngine::SubscriptionId>
+  SubscribeStorage::execute() {
+    return engine_->subscribeStorage(keys_);
+  }
+
+}  // namespace kagome::api::subscription::request
@@ -0,0 +1,35 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_STORAGE_HPP
+#define KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_STORAGE_HPP
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/subscription/subscription_engine.hpp"
+
+namespace kagome::api::subscription::request {
+
+  /**
+   * Subscribes the session to the changes of the given keys, of all the keys
+   * if none are given
+   */
+  class SubscribeStorage final {
+   public:
+    explicit SubscribeStorage(std::shared_ptr<SubscriptionEngine> engine)
+        : engine_(std::move(engine)) {}
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params);
+
+    outcome::result<SubscriptionEngine::SubscriptionId> execute();
+
+   private:
+    std::shared_ptr<SubscriptionEngine> engine_;
+    std::vector<common::Buffer> keys_;
+  };
+
+}  // namespace kagome::api::subscription::request
+
+#endif  // KAGOME_API_SUBSCRIPTION_REQUEST_SUBSCRIBE_STORAGE_HPP
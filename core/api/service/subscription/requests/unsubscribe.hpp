@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_API_SUBSCRIPTION_REQUEST_UNSUBSCRIBE_HPP
+#define KAGOME_API_SUBSCRIPTION_REQUEST_UNSUBSCRIBE_HPP
+
+#include <jsonrpc-lean/request.h>
+
+#include "api/service/subscription/subscription_engine.hpp"
+
+namespace kagome::api::subscription::request {
+
+  /**
+   * Cancels a subscription of the session to \tparam kTopic
+   */
+  template <SubscriptionEngine::Topic kTopic>
+  class Unsubscribe final {
+   public:
+    explicit Unsubscribe(std::shared_ptr<SubscriptionEngine> engine)
+        : engine_(std::move(engine)) {}
+
+    outcome::result<void> init(const jsonrpc::Request::Parameters &params) {
+      if (params.size() != 1) {
+        throw jsonrpc::InvalidParametersFault("Incorrect number of params");
+      }
+      if (not params[0].IsInteger32() or params[0].AsInteger32() < 0) {
+        throw jsonrpc::InvalidParametersFault(
+            "Parameter 'subscription' must be a subscription id");
+      }
+      id_ = static_cast<SubscriptionEngine::SubscriptionId>(
+          params[0].AsInteger32());
+      return outcome::success();
+    }
+
+    outcome::result<bool> execute() {
+      return engine_->unsubscribe(kTopic, id_);
+    }
+
+   private:
+    std::shared_ptr<SubscriptionEngine> engine_;
+    SubscriptionEngine::SubscriptionId id_ = 0;
+  };
+
+}  // namespace kagome::api::subscription::request
+
+#endif  // KAGOME_API_SUBSCRIPTION_REQUEST_UNSUBSCRIBE_HPP
@@ -0,0 +1,292 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/subscription/subscription_engine.hpp"
+
+#include <algorithm>
+
+#include "api/jrpc/value_converter.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::api, SubscriptionEngine::Error, e) {
+  using E = kagome::api::SubscriptionEngine::Error;
+  switch (e) {
+    case E::NO_SESSION:
+      return "Subscriptions are only available in a session";
+    case E::NOT_WEBSOCKET:
+      return "Subscriptions are only available over websocket or unix socket";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::api {
+
+  namespace {
+    // the session the requests processed on the thread come from
+    thread_local std::shared_ptr<Session> current_session;
+
+    constexpr auto kNewHeadMethod = "chain_newHead";
+    constexpr auto kFinalizedHeadMethod = "chain_finalizedHead";
+    constexpr auto kStorageMethod = "state_storage";
+  }  // namespace
+
+  SubscriptionEngine::SessionScope::SessionScope(
+      std::shared_ptr<Session> session)
+      : previous_{std::move(current_session)} {
+    current_session = std::move(session);
+  }
+
+  SubscriptionEngine::SessionScope::~SessionScope() {
+    current_session = std::move(previous_);
+  }
+
+  SubscriptionEngine::SubscriptionEngine(
+      std::shared_ptr<JRpcServer> server,
+      std::shared_ptr<kagome::subscription::ChainEvents> chain_events,
+      std::shared_ptr<StateApi> state_api)
+      : server_{std::move(server)}, state_api_{std::move(state_api)} {
+    BOOST_ASSERT(server_ != nullptr);
+    BOOST_ASSERT(chain_events != nullptr);
+    BOOST_ASSERT(state_api_ != nullptr);
+
+    new_head_connection_ = chain_events->new_head.connect(
+        [this](const primitives::BlockHash &,
+               const primitives::BlockHeader &header) {
+          onHead(Topic::NEW_HEADS, kNewHeadMethod, header);
+        });
+    finalized_head_connection_ = chain_events->finalized_head.connect(
+        [this](const primitives::BlockHash &,
+               const primitives::BlockHeader &header) {
+          onHead(Topic::FINALIZED_HEADS, kFinalizedHeadMethod, header);
+        });
+    storage_connection_ = chain_events->storage_changes.connect(
+        [this](const primitives::BlockHash &block,
+               const std::vector<common::Buffer> &keys) {
+          onStorageChanges(block, keys);
+        });
+  }
+
+  outcome::result<std::shared_ptr<Session>>
+  SubscriptionEngine::currentSession() {
+    if (current_session == nullptr) {
+      return Error::NO_SESSION;
+    }
+    // the other sessions are not kept open to be notified
+    if (current_session->type() == Session::Type::HTTP) {
+      return Error::NOT_WEBSOCKET;
+    }
+    return current_session;
+  }
+
+  outcome::result<SubscriptionEngine::SubscriptionId>
+  SubscriptionEngine::subscribeHeads(Topic topic) {
+    BOOST_ASSERT(topic != Topic::STORAGE);
+    OUTCOME_TRY(session, currentSession());
+    return addSubscription(session, topic, {});
+  }
+
+  outcome::result<SubscriptionEngine::SubscriptionId>
+  SubscriptionEngine::subscribeStorage(
+      const std::vector<common::Buffer> &keys) {
+    OUTCOME_TRY(session, currentSession());
+    // each key is indexed once
+    std::set<common::Buffer> unique_keys{keys.begin(), keys.end()};
+    return addSubscription(
+        session, Topic::STORAGE, {unique_keys.begin(), unique_keys.end()});
+  }
+
+  outcome::result<bool> SubscriptionEngine::unsubscribe(Topic topic,
+                                                        SubscriptionId id) {
+    OUTCOME_TRY(session, currentSession());
+    std::lock_guard lock{mutex_};
+    auto it = subscriptions_.find(id);
+    // a session may not cancel the subscriptions of the others
+    if (it == subscriptions_.end() or it->second.topic != topic
+        or it->second.session_id != session->id()) {
+      return false;
+    }
+    eraseSubscription(it);
+    return true;
+  }
+
+  void SubscriptionEngine::removeSession(SessionId session_id) {
+    std::lock_guard lock{mutex_};
+    auto session_it = by_session_.find(session_id);
+    if (session_it == by_session_.end()) {
+      return;
+    }
+    auto ids = std::move(session_it->second);
+    for (auto id : ids) {
+      if (auto it = subscriptions_.find(id); it != subscriptions_.end()) {
+        eraseSubscription(it);
+      }
+    }
+    by_session_.erase(session_id);
+  }
+
+  SubscriptionEngine::SubscriptionId SubscriptionEngine::addSubscription(
+      const std::shared_ptr<Session> &session,
+      Topic topic,
+      std::vector<common::Buffer> keys) {
+    std::lock_guard lock{mutex_};
+    auto id = ++last_id_;
+    if (topic != Topic::STORAGE) {
+      headsOf(topic).insert(id);
+    } else if (keys.empty()) {
+      all_keys_.insert(id);
+    } else {
+      for (auto &key : keys) {
+        by_key_[key].insert(id);
+      }
+    }
+    by_session_[session->id()].insert(id);
+    subscriptions_.emplace(
+        id, Subscription{topic, session->id(), session, std::move(keys)});
+    return id;
+  }
+
+  void SubscriptionEngine::eraseSubscription(
+      std::unordered_map<SubscriptionId, Subscription>::iterator it) {
+    auto id = it->first;
+    auto &subscription = it->second;
+    if (subscription.topic != Topic::STORAGE) {
+      headsOf(subscription.topic).erase(id);
+    } else if (subscription.keys.empty()) {
+      all_keys_.erase(id);
+    } else {
+      for (auto &key : subscription.keys) {
+        auto key_it = by_key_.find(key);
+        key_it->second.erase(id);
+        if (key_it->second.empty()) {
+          by_key_.erase(key_it);
+        }
+      }
+    }
+    if (auto session_it = by_session_.find(subscription.session_id);
+        session_it != by_session_.end()) {
+      session_it->second.erase(id);
+      if (session_it->second.empty()) {
+        by_session_.erase(session_it);
+      }
+    }
+    subscriptions_.erase(it);
+  }
+
+  std::set<SubscriptionEngine::SubscriptionId> &SubscriptionEngine::headsOf(
+      Topic topic) {
+    return topic == Topic::NEW_HEADS ? new_heads_ : finalized_heads_;
+  }
+
+  void SubscriptionEngine::onHead(Topic topic,
+                                  const char *method,
+                                  const primitives::BlockHeader &header) {
+    std::vector<Target> targets;
+    {
+      std::lock_guard lock{mutex_};
+      for (auto id : headsOf(topic)) {
+        targets.emplace_back(id, subscriptions_.at(id).session);
+      }
+    }
+    if (targets.empty()) {
+      return;
+    }
+
+    auto result = server_->encode(makeValue(header));
+    for (auto &target : targets) {
+      notify(target, method, result);
+    }
+  }
+
+  void SubscriptionEngine::onStorageChanges(
+      const primitives::BlockHash &block,
+      const std::vector<common::Buffer> &keys) {
+    // indices of the changed keys each subscription is notified of
+    std::map<SubscriptionId, std::vector<size_t>> subscribed;
+    std::map<SubscriptionId, std::weak_ptr<Session>> sessions;
+    {
+      std::lock_guard lock{mutex_};
+      if (all_keys_.empty() and by_key_.empty()) {
+        return;
+      }
+      for (size_t i = 0; i < keys.size(); ++i) {
+        if (auto it = by_key_.find(keys[i]); it != by_key_.end()) {
+          for (auto id : it->second) {
+            subscribed[id].push_back(i);
+          }
+        }
+        for (auto id : all_keys_) {
+          subscribed[id].push_back(i);
+        }
+      }
+      for (auto &[id, indices] : subscribed) {
+        sessions.emplace(id, subscriptions_.at(id).session);
+      }
+    }
+    if (subscribed.empty()) {
+      return;
+    }
+
+    // the values of the keys anybody is subscribed to are read at once
+    std::vector<size_t> needed;
+    for (auto &[id, indices] : subscribed) {
+      needed.insert(needed.end(), indices.begin(), indices.end());
+    }
+    std::sort(needed.begin(), needed.end());
+    needed.erase(std::unique(needed.begin(), needed.end()), needed.end());
+    std::vector<common::Buffer> needed_keys;
+    needed_keys.reserve(needed.size());
+    for (auto i : needed) {
+      needed_keys.push_back(keys[i]);
+    }
+    auto values = state_api_->queryStorageAt(needed_keys, block);
+    if (not values or values.value().size() != 1
+        or values.value()[0].changes.size() != needed.size()) {
+      logger_->warn("Could not read the storage changed in block {}: {}",
+                    block.toHex(),
+                    values ? "unexpected result" : values.error().message());
+      return;
+    }
+
+    // every changed key is formatted once, along with its value
+    std::vector<std::string> changes(keys.size());
+    auto &&read = values.value()[0].changes;
+    for (size_t i = 0; i < needed.size(); ++i) {
+      jsonrpc::Value::Array pair;
+      pair.reserve(2);
+      pair.emplace_back(makeValue(read[i].key));
+      // absent entries are denoted with null
+      pair.emplace_back(read[i].data ? makeValue(read[i].data.value())
+                                     : jsonrpc::Value{});
+      changes[needed[i]] = server_->encode(pair);
+    }
+    auto result_prefix =
+        R"({"block":)" + server_->encode(makeValue(block)) + R"(,"changes":[)";
+
+    for (auto &[id, indices] : subscribed) {
+      auto result = result_prefix;
+      for (size_t i = 0; i < indices.size(); ++i) {
+        if (i != 0) {
+          result += ',';
+        }
+        result += changes[indices[i]];
+      }
+      result += "]}";
+      notify(Target{id, sessions[id]}, kStorageMethod, result);
+    }
+  }
+
+  void SubscriptionEngine::notify(const Target &target,
+                                  const char *method,
+                                  const std::string &result) {
+    auto session = target.second.lock();
+    if (session == nullptr) {
+      return;
+    }
+    session->respond(R"({"jsonrpc":"2.0","method":")" + std::string{method}
+                     + R"(","params":{"result":)" + result
+                     + R"(,"subscription":)" + std::to_string(target.first)
+                     + "}}");
+  }
+
+}  // namespace kagome::api
@@ -0,0 +1,156 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_SERVICE_SUBSCRIPTION_SUBSCRIPTION_ENGINE_HPP
+#define KAGOME_CORE_API_SERVICE_SUBSCRIPTION_SUBSCRIPTION_ENGINE_HPP
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include <boost/signals2/connection.hpp>
+
+#include "api/jrpc/jrpc_server.hpp"
+#include "api/service/state/state_api.hpp"
+#include "api/transport/session.hpp"
+#include "common/logger.hpp"
+#include "subscription/chain_events.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Keeps the subscriptions of the websocket sessions to the new heads, to
+   * the finalized heads and to the changes of the storage, and notifies them
+   * of the chain events. An event is formatted once for all the sessions
+   * subscribed to it: the values of the changed keys are read once and each
+   * of them is formatted once, so that a notification is just a join of the
+   * formatted parts. Thread-safe
+   */
+  class SubscriptionEngine {
+   public:
+    using SessionId = Session::SessionId;
+    using SubscriptionId = uint32_t;
+
+    enum class Topic { NEW_HEADS, FINALIZED_HEADS, STORAGE };
+
+    enum class Error {
+      NO_SESSION = 1,
+      NOT_WEBSOCKET,
+    };
+
+    /**
+     * Makes \arg session the one the requests processed on the current thread
+     * come from, until the scope ends
+     */
+    class SessionScope {
+     public:
+      explicit SessionScope(std::shared_ptr<Session> session);
+      SessionScope(const SessionScope &) = delete;
+      SessionScope &operator=(const SessionScope &) = delete;
+      ~SessionScope();
+
+     private:
+      std::shared_ptr<Session> previous_;
+    };
+
+    SubscriptionEngine(
+        std::shared_ptr<JRpcServer> server,
+        std::shared_ptr<kagome::subscription::ChainEvents> chain_events,
+        std::shared_ptr<StateApi> state_api);
+
+    /**
+     * Subscribes the current session to the heads of \arg topic
+     * @return id of the subscription
+     */
+    outcome::result<SubscriptionId> subscribeHeads(Topic topic);
+
+    /**
+     * Subscribes the current session to the changes of \arg keys, of all the
+     * keys if there are none
+     * @return id of the subscription
+     */
+    outcome::result<SubscriptionId> subscribeStorage(
+        const std::vector<common::Buffer> &keys);
+
+    /**
+     * Cancels the subscription \arg id to \arg topic of the current session
+     * @return false if there is no such subscription
+     */
+    outcome::result<bool> unsubscribe(Topic topic, SubscriptionId id);
+
+    /**
+     * Cancels all the subscriptions of the session \arg session_id, which is
+     * closed
+     */
+    void removeSession(SessionId session_id);
+
+   private:
+    struct Subscription {
+      Topic topic;
+      SessionId session_id;
+      std::weak_ptr<Session> session;
+      // keys of a storage subscription, none for all the keys
+      std::vector<common::Buffer> keys;
+    };
+
+    using Target = std::pair<SubscriptionId, std::weak_ptr<Session>>;
+
+    /**
+     * @return the current session, which must be a websocket one
+     */
+    static outcome::result<std::shared_ptr<Session>> currentSession();
+
+    SubscriptionId addSubscription(const std::shared_ptr<Session> &session,
+                                   Topic topic,
+                                   std::vector<common::Buffer> keys);
+
+    /**
+     * Removes the subscription pointed by \arg it from the indices
+     */
+    void eraseSubscription(
+        std::unordered_map<SubscriptionId, Subscription>::iterator it);
+
+    std::set<SubscriptionId> &headsOf(Topic topic);
+
+    void onHead(Topic topic,
+                const char *method,
+                const primitives::BlockHeader &header);
+
+    void onStorageChanges(const primitives::BlockHash &block,
+                          const std::vector<common::Buffer> &keys);
+
+    /**
+     * Sends \arg result, which is formatted already, to \arg target as the
+     * notification \arg method
+     */
+    static void notify(const Target &target,
+                       const char *method,
+                       const std::string &result);
+
+    std::shared_ptr<JRpcServer> server_;
+    std::shared_ptr<StateApi> state_api_;
+
+    std::mutex mutex_;
+    SubscriptionId last_id_ = 0;
+    std::unordered_map<SubscriptionId, Subscription> subscriptions_;
+    std::unordered_map<SessionId, std::set<SubscriptionId>> by_session_;
+    std::set<SubscriptionId> new_heads_;
+    std::set<SubscriptionId> finalized_heads_;
+    std::map<common::Buffer, std::set<SubscriptionId>> by_key_;
+    // storage subscriptions to all the keys
+    std::set<SubscriptionId> all_keys_;
+
+    boost::signals2::scoped_connection new_head_connection_;
+    boost::signals2::scoped_connection finalized_head_connection_;
+    boost::signals2::scoped_connection storage_connection_;
+    common::Logger logger_ = common::createLogger("SubscriptionEngine");
+  };
+
+}  // namespace kagome::api
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::api, SubscriptionEngine::Error);
+
+#endif  // KAGOME_CORE_API_SERVICE_SUBSCRIPTION_SUBSCRIPTION_ENGINE_HPP
@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/subscription/subscription_jrpc_processor.hpp"
+
+#include "api/jrpc/jrpc_method.hpp"
+#include "api/service/subscription/requests/subscribe_heads.hpp"
+#include "api/service/subscription/requests/subscribe_storage.hpp"
+#include "api/service/subscription/requests/unsubscribe.hpp"
+
+namespace kagome::api::subscription {
+
+  SubscriptionJrpcProcessor::SubscriptionJrpcProcessor(
+      std::shared_ptr<JRpcServer> server,
+      std::shared_ptr<SubscriptionEngine> engine)
+      : engine_{std::move(engine)}, server_{std::move(server)} {
+    BOOST_ASSERT(engine_ != nullptr);
+    BOOST_ASSERT(server_ != nullptr);
+  }
+
+  template <typename Request>
+  using Handler = Method<Request, SubscriptionEngine>;
+
+  using Topic = SubscriptionEngine::Topic;
+
+  void SubscriptionJrpcProcessor::registerHandlers() {
+    server_->registerHandler(
+        "chain_subscribeNewHeads",
+        Handler<request::SubscribeHeads<Topic::NEW_HEADS>>(engine_));
+    server_->registerHandler(
+        "chain_unsubscribeNewHeads",
+        Handler<request::Unsubscribe<Topic::NEW_HEADS>>(engine_));
+    server_->registerHandler(
+        "chain_subscribeFinalizedHeads",
+        Handler<request::SubscribeHeads<Topic::FINALIZED_HEADS>>(engine_));
+    server_->registerHandler(
+        "chain_unsubscribeFinalizedHeads",
+        Handler<request::Unsubscribe<Topic::FINALIZED_HEADS>>(engine_));
+    server_->registerHandler("state_subscribeStorage",
+                             Handler<request::SubscribeStorage>(engine_));
+    server_->registerHandler(
+        "state_unsubscribeStorage",
+        Handler<request::Unsubscribe<Topic::STORAGE>>(engine_));
+  }
+
+}  // namespace kagome::api::subscription
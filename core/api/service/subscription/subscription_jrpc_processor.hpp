@@ -0,0 +1,32 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_SUBSCRIPTION_JRPC_PROCESSOR_HPP
+#define KAGOME_SUBSCRIPTION_JRPC_PROCESSOR_HPP
+
+#include "api/jrpc/jrpc_processor.hpp"
+#include "api/jrpc/jrpc_server_impl.hpp"
+#include "api/service/subscription/subscription_engine.hpp"
+
+namespace kagome::api::subscription {
+
+  /**
+   * @brief processor of the requests to subscribe to the chain events and to
+   * cancel the subscriptions
+   */
+  class SubscriptionJrpcProcessor : public JRpcProcessor {
+   public:
+    SubscriptionJrpcProcessor(std::shared_ptr<JRpcServer> server,
+                              std::shared_ptr<SubscriptionEngine> engine);
+    void registerHandlers() override;
+
+   private:
+    std::shared_ptr<SubscriptionEngine> engine_;
+    std::shared_ptr<JRpcServer> server_;
+  };
+
+}  // namespace kagome::api::subscription
+
+#endif  // KAGOME_SUBSCRIPTION_JRPC_PROCESSOR_HPP
@@ -5,6 +5,7 @@
 
 #include "api/transport/impl/http/http_session.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/config.hpp>
 
 #include "outcome/outcome.hpp"
@@ -21,9 +22,14 @@ namespace kagome::api {
   }
 
   void HttpSession::stop() {
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
     boost::system::error_code ec;
     stream_.socket().shutdown(Socket::shutdown_both, ec);
     boost::ignore_unused(ec);
+    notifyOnClose();
   }
 
   auto HttpSession::makeBadResponse(std::string_view message,
@@ -38,90 +44,164 @@ namespace kagome::api {
     return res;
   }
 
-  template <class Body>
-  void HttpSession::handleRequest(boost::beast::http::request<Body> &&req) {
+  void HttpSession::handleRequest(Request<StringBody> &req) {
+    version_ = req.version();
+    keep_alive_ = req.keep_alive();
+
     // allow only POST method
     if (req.method() != boost::beast::http::verb::post) {
-      return asyncWrite(makeBadResponse(
-          "Unsupported HTTP-method", req.version(), req.keep_alive()));
+      enqueue(
+          makeBadResponse("Unsupported HTTP-method", version_, keep_alive_));
+      return readNext();
     }
 
+    // the next request is read once this one is responded to, so that the
+    // responses are written in the order of the requests
+    processing_ = true;
     processRequest(req.body(), shared_from_this());
   }
 
   void HttpSession::asyncRead() {
-    parser_ = std::make_unique<Parser>();
+    reading_ = true;
+    // the parser is emplaced with the body storage of the previous request
+    request_body_.clear();
+    parser_.emplace(std::piecewise_construct,
+                    std::make_tuple(std::move(request_body_)));
     parser_->body_limit(config_.max_request_size);
     stream_.expires_after(config_.operation_timeout);
 
     boost::beast::http::async_read(
         stream_,
         buffer_,
-        parser_->get(),
+        *parser_,
         [self = shared_from_this()](auto ec, auto count) {
-          auto *s = dynamic_cast<HttpSession *>(self.get());
-          BOOST_ASSERT_MSG(s != nullptr, "cannot cast to HttpSession");
-          s->onRead(ec, count);
+          self->onRead(ec, count);
         });
   }
 
-  template <class Message>
-  void HttpSession::asyncWrite(Message &&message) {
-    // we need to put message into a shared ptr for async operations
-    using message_type = decltype(message);
-    auto m = std::make_shared<std::decay_t<message_type>>(
-        std::forward<message_type>(message));
-
-    // write response
-    boost::beast::http::async_write(
-        stream_, *m, [self = shared_from_this(), m](auto ec, auto size) {
-          self->onWrite(ec, size, m->need_eof());
-        });
+  void HttpSession::readNext() {
+    if (stopped_ or reading_ or processing_ or read_closed_
+        or not keep_alive_) {
+      return;
+    }
+    // the client not reading the responses is not read either
+    if (wqueue_.size() >= config_.max_queued_responses) {
+      return;
+    }
+    asyncRead();
   }
 
-  void HttpSession::respond(std::string_view response) {
-    StringBody::value_type body;
-    body.assign(response);
+  void HttpSession::respond(std::string response) {
+    // posted rather than dispatched, so that the response given while the
+    // request is processed is handled after it
+    boost::asio::post(strand_,
+                      [self = shared_from_this(),
+                       response = std::move(response)]() mutable {
+                        self->onResponse(std::move(response));
+                      });
+  }
 
-    const auto size = body.size();
+  void HttpSession::onResponse(std::string response) {
+    if (stopped_) {
+      return;
+    }
+    processing_ = false;
+
+    Response<StringBody> res;
+    if (spare_response_) {
+      res = std::move(spare_response_.value());
+      spare_response_.reset();
+    } else {
+      res.set(HttpField::server, kServerName);
+      res.set(HttpField::content_type, "text/html");
+    }
+    res.result(boost::beast::http::status::ok);
+    res.version(version_);
+    res.keep_alive(keep_alive_);
+    res.body() = std::move(response);
+    res.content_length(res.body().size());
+
+    enqueue(std::move(res));
+    readNext();
+  }
 
-    // send response
-    Response<StringBody> res(std::piecewise_construct,
-                             std::make_tuple(std::move(body)));
-    res.set(HttpField::server, kServerName);
-    res.set(HttpField::content_type, "text/html");
-    res.content_length(size);
-    res.keep_alive(true);
+  void HttpSession::enqueue(Response<StringBody> &&message) {
+    wqueue_.push_back(std::move(message));
+    if (wqueue_.size() == 1) {
+      asyncWrite();
+    }
+  }
 
-    return asyncWrite(std::move(res));
+  void HttpSession::asyncWrite() {
+    stream_.expires_after(config_.operation_timeout);
+    // the queued messages are not moved until they are written
+    boost::beast::http::async_write(
+        stream_,
+        wqueue_.front(),
+        [self = shared_from_this()](auto ec, auto size) {
+          self->onWrite(ec, size);
+        });
   }
 
   void HttpSession::onRead(boost::system::error_code ec, std::size_t) {
+    reading_ = false;
+    if (stopped_) {
+      return;
+    }
+
     if (ec) {
-      if (HttpError::end_of_stream != ec) {
-        reportError(ec, "unknown error occurred");
+      if (HttpError::end_of_stream == ec) {
+        // the queued responses are written before the session is stopped
+        read_closed_ = true;
+        if (wqueue_.empty()) {
+          stop();
+        }
+        return;
+      }
+      if (HttpError::body_limit == ec) {
+        keep_alive_ = false;
+        return enqueue(makeBadResponse(
+            "Request is too large", parser_->get().version(), false));
       }
 
-      stop();
+      reportError(ec, "unknown error occurred");
+      return stop();
     }
 
-    handleRequest(parser_->release());
+    auto request = parser_->release();
+    parser_.reset();
+    handleRequest(request);
+    // the request is processed synchronously, its storage is not used anymore
+    request_body_ = std::move(request.body());
   }
 
-  void HttpSession::onWrite(boost::system::error_code ec,
-                            std::size_t,
-                            bool should_stop) {
+  void HttpSession::onWrite(boost::system::error_code ec, std::size_t) {
+    if (stopped_) {
+      return;
+    }
+
     if (ec) {
       reportError(ec, "failed to write message");
       return stop();
     }
 
-    if (should_stop) {
+    auto &written = wqueue_.front();
+    if (written.need_eof()) {
       return stop();
     }
+    if (written.result() == boost::beast::http::status::ok) {
+      spare_response_ = std::move(written);
+    }
+    wqueue_.pop_front();
 
-    // read next request
-    asyncRead();
+    if (not wqueue_.empty()) {
+      asyncWrite();
+    } else if (read_closed_) {
+      return stop();
+    }
+
+    // the reading may have waited for the queue to shrink
+    readNext();
   }
 
   void HttpSession::reportError(boost::system::error_code ec,
@@ -8,8 +8,10 @@
 
 #include <boost/asio/strand.hpp>
 #include <boost/beast.hpp>
+#include <boost/optional.hpp>
 #include <chrono>
 #include <cstdlib>
+#include <deque>
 #include <memory>
 
 #include "api/transport/session.hpp"
@@ -17,7 +19,11 @@
 
 namespace kagome::api {
   /**
-   * @brief HTTP session for api service
+   * @brief HTTP session for api service. The connection is kept alive as
+   * long as the client asks for it, the requests pipelined by the client are
+   * processed one by one, and the next one is read while the response to the
+   * previous one is written. The parser and the responses are reused across
+   * the requests
    */
   class HttpSession : public Session,
                       public std::enable_shared_from_this<HttpSession> {
@@ -38,11 +44,14 @@ namespace kagome::api {
 
    public:
     struct Configuration {
-      static constexpr size_t kDefaultRequestSize = 10000u;
+      static constexpr size_t kDefaultRequestSize = 15ull << 20;
       static constexpr Duration kDefaultTimeout = std::chrono::seconds(30);
+      static constexpr size_t kDefaultMaxQueuedResponses = 16;
 
       size_t max_request_size{kDefaultRequestSize};
       Duration operation_timeout{kDefaultTimeout};
+      /// the next request is not read while more responses are not written
+      size_t max_queued_responses{kDefaultMaxQueuedResponses};
     };
 
     ~HttpSession() override = default;
@@ -54,20 +63,25 @@ namespace kagome::api {
      */
     HttpSession(Context &context, Configuration config);
 
-    Socket &socket() override {
+    Socket &socket() {
       return stream_.socket();
     }
 
+    Type type() const override {
+      return Type::HTTP;
+    }
+
     /**
      * @brief starts session
      */
     void start() override;
 
     /**
-     * @brief sends response wrapped by http message
+     * @brief sends response wrapped by http message, may be called from any
+     * thread
      * @param response message to send
      */
-    void respond(std::string_view response) override;
+    void respond(std::string response) override;
 
    private:
     /**
@@ -76,12 +90,10 @@ namespace kagome::api {
     void stop();
 
     /**
-     * @brief process http request, compose and execute response
-     * @tparam Body request body type
+     * @brief process http request, its response is given to `respond`
      * @param request request
      */
-    template <class Body>
-    void handleRequest(Request<Body> &&request);
+    void handleRequest(Request<StringBody> &request);
 
     /**
      * @brief asynchronously read http message
@@ -89,12 +101,27 @@ namespace kagome::api {
     void asyncRead();
 
     /**
-     * @brief sends http message
-     * @tparam Message http message type
+     * @brief reads the next request, unless the client asked to close the
+     * connection or too many responses are not written yet
+     */
+    void readNext();
+
+    /**
+     * @brief composes the response to the current request, runs on strand
+     * @param response message to send
+     */
+    void onResponse(std::string response);
+
+    /**
+     * @brief queues http message, it is written after the queued ones
      * @param message http message
      */
-    template <class Message>
-    void asyncWrite(Message &&message);
+    void enqueue(Response<StringBody> &&message);
+
+    /**
+     * @brief writes the first of the queued messages
+     */
+    void asyncWrite();
 
     /**
      * @brief read completion callback
@@ -104,7 +131,7 @@ namespace kagome::api {
     /**
      * @brief write completion callback
      */
-    void onWrite(boost::system::error_code ec, std::size_t, bool close);
+    void onWrite(boost::system::error_code ec, std::size_t);
 
     /**
      * @brief composes `bad request` message
@@ -139,7 +166,23 @@ namespace kagome::api {
      */
     using Parser = RequestParser<StringBody>;
 
-    std::unique_ptr<Parser> parser_;  ///< http parser
+    boost::optional<Parser> parser_;  ///< http parser, emplaced per request
+    /// body of the last request, its storage is reused by the next one
+    StringBody::value_type request_body_;
+
+    /// version and keep-alive of the request being processed
+    unsigned version_ = 11;
+    bool keep_alive_ = true;
+
+    /// responses to write in the order of the requests, the first is written
+    std::deque<Response<StringBody>> wqueue_;
+    /// written response, the fields of which are reused by the next one
+    boost::optional<Response<StringBody>> spare_response_;
+    bool reading_ = false;
+    bool processing_ = false;
+    bool read_closed_ = false;
+    bool stopped_ = false;
+
     common::Logger logger_ = common::createLogger("http session");
   };
 
@@ -0,0 +1,160 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/impl/http/metrics_listener.hpp"
+
+#include <boost/asio/strand.hpp>
+#include <boost/beast.hpp>
+
+namespace kagome::api {
+
+  namespace {
+    namespace http = boost::beast::http;
+
+    constexpr auto kContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+    /**
+     * Connection of a scraper, which is kept alive as long as it asks for it
+     */
+    class MetricsSession : public std::enable_shared_from_this<MetricsSession> {
+     public:
+      MetricsSession(boost::asio::ip::tcp::socket socket,
+                     std::shared_ptr<common::MetricsRegistry> registry,
+                     std::chrono::seconds timeout)
+          : stream_{std::move(socket)},
+            registry_{std::move(registry)},
+            timeout_{timeout} {}
+
+      void read() {
+        request_ = {};
+        stream_.expires_after(timeout_);
+        http::async_read(stream_,
+                         buffer_,
+                         request_,
+                         [self = shared_from_this()](auto ec, auto) {
+                           if (ec) {
+                             return self->close();
+                           }
+                           self->respond();
+                         });
+      }
+
+     private:
+      void respond() {
+        // the query of the target is ignored
+        auto target = request_.target();
+        target = target.substr(0, target.find('?'));
+        bool found = target == MetricsListener::kPath.data()
+                     and (request_.method() == http::verb::get
+                          or request_.method() == http::verb::head);
+
+        response_ = {};
+        response_.version(request_.version());
+        response_.keep_alive(request_.keep_alive());
+        response_.result(found ? http::status::ok : http::status::not_found);
+        response_.set(http::field::content_type,
+                      found ? kContentType : "text/plain");
+        response_.body() = found ? registry_->exposition() : "Not found";
+        response_.prepare_payload();
+        if (request_.method() == http::verb::head) {
+          response_.body().clear();
+        }
+
+        stream_.expires_after(timeout_);
+        http::async_write(stream_,
+                          response_,
+                          [self = shared_from_this()](auto ec, auto) {
+                            if (ec or not self->response_.keep_alive()) {
+                              return self->close();
+                            }
+                            self->read();
+                          });
+      }
+
+      void close() {
+        boost::system::error_code ec;
+        stream_.socket().shutdown(boost::asio::socket_base::shutdown_both,
+                                  ec);
+      }
+
+      boost::beast::tcp_stream stream_;
+      std::shared_ptr<common::MetricsRegistry> registry_;
+      const std::chrono::seconds timeout_;
+      boost::beast::flat_buffer buffer_;
+      http::request<http::empty_body> request_;
+      http::response<http::string_body> response_;
+    };
+  }  // namespace
+
+  MetricsListener::MetricsListener(
+      const std::shared_ptr<application::AppStateManager> &app_state_manager,
+      std::shared_ptr<Context> context,
+      Configuration config,
+      std::shared_ptr<common::MetricsRegistry> registry)
+      : context_{std::move(context)},
+        config_{config},
+        registry_{std::move(registry)} {
+    BOOST_ASSERT(app_state_manager);
+    BOOST_ASSERT(context_ != nullptr);
+    BOOST_ASSERT(registry_ != nullptr);
+    app_state_manager->takeControl(*this);
+  }
+
+  void MetricsListener::prepare() {
+    try {
+      acceptor_ = std::make_unique<Acceptor>(*context_, config_.endpoint);
+    } catch (const std::exception &exception) {
+      logger_->critical("Failed to listen for the scrapes at {}: {}",
+                        config_.endpoint.address().to_string(),
+                        exception.what());
+      return;
+    }
+
+    boost::system::error_code ec;
+    acceptor_->set_option(boost::asio::socket_base::reuse_address(true), ec);
+    if (ec) {
+      logger_->error("Failed to set `reuse address` option to acceptor");
+    }
+  }
+
+  void MetricsListener::start() {
+    if (acceptor_ == nullptr or not acceptor_->is_open()) {
+      logger_->error("Metrics are not served, as the acceptor is not open");
+      return;
+    }
+    logger_->info("Serving the metrics at {}:{}{}",
+                  config_.endpoint.address().to_string(),
+                  config_.endpoint.port(),
+                  kPath);
+    acceptOnce();
+  }
+
+  void MetricsListener::stop() {
+    if (acceptor_ != nullptr) {
+      acceptor_->cancel();
+    }
+  }
+
+  void MetricsListener::acceptOnce() {
+    acceptor_->async_accept(
+        boost::asio::make_strand(*context_),
+        [wp = weak_from_this()](boost::system::error_code ec,
+                                boost::asio::ip::tcp::socket socket) {
+          auto self = wp.lock();
+          if (not self or ec == boost::asio::error::operation_aborted) {
+            return;
+          }
+          if (not ec) {
+            std::make_shared<MetricsSession>(
+                std::move(socket), self->registry_, self->config_.timeout)
+                ->read();
+          }
+          if (self->acceptor_->is_open()) {
+            self->acceptOnce();
+          }
+        });
+  }
+
+}  // namespace kagome::api
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_TRANSPORT_IMPL_HTTP_METRICS_LISTENER_HPP
+#define KAGOME_CORE_API_TRANSPORT_IMPL_HTTP_METRICS_LISTENER_HPP
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include "api/transport/rpc_io_context.hpp"
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+#include "common/metrics_registry.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Serves the metrics of the registry to the scrapes of Prometheus, which
+   * are the GET requests of /metrics over HTTP, on the RPC threads
+   */
+  class MetricsListener
+      : public std::enable_shared_from_this<MetricsListener> {
+   public:
+    using Context = RpcContext;
+    using Acceptor = boost::asio::ip::tcp::acceptor;
+    using Endpoint = boost::asio::ip::tcp::endpoint;
+
+    /// the path the metrics are served at
+    static constexpr std::string_view kPath = "/metrics";
+
+    struct Configuration {
+      Endpoint endpoint{};  ///< listening endpoint
+      /// time a connection is kept for a request
+      std::chrono::seconds timeout{30};
+    };
+
+    MetricsListener(
+        const std::shared_ptr<application::AppStateManager> &app_state_manager,
+        std::shared_ptr<Context> context,
+        Configuration config,
+        std::shared_ptr<common::MetricsRegistry> registry);
+
+    void prepare();
+    void start();
+    void stop();
+
+   private:
+    void acceptOnce();
+
+    std::shared_ptr<Context> context_;
+    const Configuration config_;
+    std::shared_ptr<common::MetricsRegistry> registry_;
+
+    std::unique_ptr<Acceptor> acceptor_;
+
+    common::Logger logger_ = common::createLogger("MetricsListener");
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_TRANSPORT_IMPL_HTTP_METRICS_LISTENER_HPP
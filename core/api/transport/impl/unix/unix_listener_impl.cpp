@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/impl/unix/unix_listener_impl.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+
+namespace kagome::api {
+
+  namespace {
+    /// removes the socket file at \arg path, but not a file of another kind
+    void removeSocketFile(const std::string &path) {
+      boost::system::error_code ec;
+      if (boost::filesystem::status(path, ec).type()
+          == boost::filesystem::socket_file) {
+        boost::filesystem::remove(path, ec);
+      }
+    }
+  }  // namespace
+
+  UnixListenerImpl::UnixListenerImpl(
+      const std::shared_ptr<application::AppStateManager> &app_state_manager,
+      std::shared_ptr<Context> context,
+      Configuration listener_config,
+      SessionImpl::Configuration session_config)
+      : context_{std::move(context)},
+        config_{std::move(listener_config)},
+        session_config_{session_config} {
+    BOOST_ASSERT(app_state_manager);
+    app_state_manager->takeControl(*this);
+  }
+
+  void UnixListenerImpl::prepare() {
+    // the socket file of a node, which was not stopped cleanly, stays and
+    // would not let it be bound again
+    removeSocketFile(config_.path);
+    try {
+      acceptor_ =
+          std::make_unique<Acceptor>(*context_, Endpoint{config_.path});
+    } catch (const boost::wrapexcept<boost::system::system_error> &exception) {
+      logger_->critical("Failed to prepare of listener at {}: can't {}",
+                        config_.path,
+                        exception.what());
+      return;
+    } catch (const std::exception &exception) {
+      logger_->critical("Exception at preparing of listener: {}",
+                        exception.what());
+      return;
+    }
+  }
+
+  void UnixListenerImpl::start() {
+    if (not acceptor_ or not acceptor_->is_open()) {
+      logger_->error("error: trying to start on non opened acceptor");
+      return;
+    }
+
+    acceptOnce();
+  }
+
+  void UnixListenerImpl::stop() {
+    if (not acceptor_) {
+      return;
+    }
+    boost::system::error_code ec;
+    acceptor_->close(ec);
+    removeSocketFile(config_.path);
+  }
+
+  void UnixListenerImpl::setHandlerForNewSession(
+      NewSessionHandler &&on_new_session) {
+    on_new_session_ =
+        std::make_unique<NewSessionHandler>(std::move(on_new_session));
+  }
+
+  void UnixListenerImpl::acceptOnce() {
+    new_session_ = std::make_shared<SessionImpl>(*context_, session_config_);
+
+    auto on_accept = [wp = weak_from_this()](boost::system::error_code ec) {
+      if (auto self = wp.lock()) {
+        if (not ec) {
+          if (self->on_new_session_) {
+            (*self->on_new_session_)(self->new_session_);
+          }
+          self->new_session_->start();
+        }
+
+        if (self->acceptor_->is_open()) {
+          // continue to accept until acceptor is ready
+          self->acceptOnce();
+        }
+      }
+    };
+
+    acceptor_->async_accept(new_session_->socket(), std::move(on_accept));
+  }
+}  // namespace kagome::api
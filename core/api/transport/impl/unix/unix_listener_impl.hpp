@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_LISTENER_IMPL_HPP
+#define KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_LISTENER_IMPL_HPP
+
+#include "api/transport/listener.hpp"
+
+#include "api/transport/impl/unix/unix_session.hpp"
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::api {
+
+  /**
+   * @brief server which listens for the connections of the clients on the
+   * same host at a unix domain socket, so they don't go through the TCP
+   * stack and the RPC is not exposed at a network port
+   */
+  class UnixListenerImpl
+      : public Listener,
+        public std::enable_shared_from_this<UnixListenerImpl> {
+   public:
+    using SessionImpl = UnixSession;
+
+    struct Configuration {
+      std::string path;  ///< path of the socket file
+    };
+
+    UnixListenerImpl(
+        const std::shared_ptr<application::AppStateManager> &app_state_manager,
+        std::shared_ptr<Context> context,
+        Configuration listener_config,
+        SessionImpl::Configuration session_config);
+
+    ~UnixListenerImpl() override = default;
+
+    /// Binds the socket file, the one left by a previous run is replaced
+    void prepare() override;
+    void start() override;
+    /// Stops accepting the connections and removes the socket file
+    void stop() override;
+
+    void setHandlerForNewSession(NewSessionHandler &&on_new_session) override;
+
+   private:
+    using Acceptor = boost::asio::local::stream_protocol::acceptor;
+    using Endpoint = boost::asio::local::stream_protocol::endpoint;
+
+    void acceptOnce() override;
+
+    std::shared_ptr<Context> context_;
+    const Configuration config_;
+    const SessionImpl::Configuration session_config_;
+
+    std::unique_ptr<Acceptor> acceptor_;
+    std::unique_ptr<NewSessionHandler> on_new_session_;
+
+    std::shared_ptr<SessionImpl> new_session_;
+
+    common::Logger logger_ = common::createLogger("RPC_Unix_Listener");
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_LISTENER_IMPL_HPP
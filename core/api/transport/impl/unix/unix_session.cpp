@@ -0,0 +1,165 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/impl/unix/unix_session.hpp"
+
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+
+namespace kagome::api {
+
+  UnixSession::UnixSession(Context &context, Configuration config)
+      : strand_(boost::asio::make_strand(context)),
+        socket_(strand_),
+        config_{config} {}
+
+  void UnixSession::start() {
+    boost::asio::dispatch(strand_,
+                          [self = shared_from_this()] { self->asyncRead(); });
+  }
+
+  void UnixSession::stop() {
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    boost::system::error_code ec;
+    socket_.shutdown(Socket::shutdown_both, ec);
+    socket_.close(ec);
+    notifyOnClose();
+  }
+
+  void UnixSession::asyncRead() {
+    if (config_.binary) {
+      boost::asio::async_read(
+          socket_,
+          boost::asio::buffer(length_),
+          [self = shared_from_this()](boost::system::error_code ec,
+                                      size_t size) {
+            self->onReadLength(ec, size);
+          });
+      return;
+    }
+    // the line is read with its end, so the limit is one byte longer
+    boost::asio::async_read_until(
+        socket_,
+        boost::asio::dynamic_buffer(rbuffer_, config_.max_request_size + 1),
+        '\n',
+        [self = shared_from_this()](boost::system::error_code ec,
+                                    size_t size) {
+          self->onReadLine(ec, size);
+        });
+  }
+
+  void UnixSession::onReadLine(boost::system::error_code ec, size_t size) {
+    if (ec) {
+      return onError(ec, "failed to read request");
+    }
+    std::string_view line{rbuffer_.data(), size - 1};
+    if (not line.empty() and line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (not line.empty()) {
+      processRequest(line, shared_from_this());
+    }
+    // the bytes after the line belong to the next requests
+    rbuffer_.erase(0, size);
+    asyncRead();
+  }
+
+  void UnixSession::onReadLength(boost::system::error_code ec, size_t) {
+    if (ec) {
+      return onError(ec, "failed to read request length");
+    }
+    size_t length = length_[0] | (length_[1] << 8) | (length_[2] << 16)
+                    | (static_cast<size_t>(length_[3]) << 24);
+    if (length > config_.max_request_size) {
+      logger_->warn("request of {} bytes is too large, closing the session",
+                    length);
+      return stop();
+    }
+    rbuffer_.resize(length);
+    boost::asio::async_read(
+        socket_,
+        boost::asio::buffer(rbuffer_),
+        [self = shared_from_this()](boost::system::error_code ec,
+                                    size_t size) {
+          self->onReadMessage(ec, size);
+        });
+  }
+
+  void UnixSession::onReadMessage(boost::system::error_code ec, size_t size) {
+    if (ec) {
+      return onError(ec, "failed to read request");
+    }
+    processRequest({rbuffer_.data(), size}, shared_from_this());
+    asyncRead();
+  }
+
+  void UnixSession::respond(std::string message) {
+    if (config_.binary) {
+      auto length = static_cast<uint32_t>(message.size());
+      char prefix[] = {static_cast<char>(length),
+                       static_cast<char>(length >> 8),
+                       static_cast<char>(length >> 16),
+                       static_cast<char>(length >> 24)};
+      message.insert(0, prefix, sizeof(prefix));
+    } else {
+      message.push_back('\n');
+    }
+    boost::asio::post(
+        strand_,
+        [self = shared_from_this(), message = std::move(message)]() mutable {
+          if (self->stopped_) {
+            return;
+          }
+          if (self->wqueue_.size() >= self->config_.max_queued_messages) {
+            self->logger_->warn(
+                "{} messages are not read by the client, closing the session",
+                self->wqueue_.size());
+            return self->stop();
+          }
+          self->wqueue_.emplace_back(std::move(message));
+          // the other messages are written once the current one is
+          if (self->wqueue_.size() == 1) {
+            self->asyncWrite();
+          }
+        });
+  }
+
+  void UnixSession::asyncWrite() {
+    boost::asio::async_write(
+        socket_,
+        boost::asio::buffer(wqueue_.front()),
+        [self = shared_from_this()](boost::system::error_code ec,
+                                    size_t size) { self->onWrite(ec, size); });
+  }
+
+  void UnixSession::onWrite(boost::system::error_code ec, size_t) {
+    if (ec) {
+      return onError(ec, "failed to write message");
+    }
+    wqueue_.pop_front();
+    if (not stopped_ and not wqueue_.empty()) {
+      asyncWrite();
+    }
+  }
+
+  void UnixSession::onError(boost::system::error_code ec,
+                            std::string_view message) {
+    if (ec == boost::asio::error::eof
+        or ec == boost::asio::error::operation_aborted) {
+      logger_->debug("connection was closed");
+    } else {
+      logger_->error("error occured: {}, code: {}", message, ec.message());
+    }
+    stop();
+  }
+
+}  // namespace kagome::api
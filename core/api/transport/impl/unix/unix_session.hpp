@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_SESSION_HPP
+#define KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_SESSION_HPP
+
+#include <array>
+#include <deque>
+#include <memory>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/strand.hpp>
+
+#include "api/transport/session.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Session over a unix domain socket, for the clients on the same host,
+   * which don't need the HTTP or the websocket framing: the JSON RPC
+   * messages are sent as lines, and the binary SCALE ones are prefixed with
+   * their length, as a 4 byte little endian number. Like a websocket
+   * session, it is kept open, so the responses and the notifications are
+   * sent in any order
+   */
+  class UnixSession : public Session,
+                      public std::enable_shared_from_this<UnixSession> {
+   public:
+    using Socket = boost::asio::local::stream_protocol::socket;
+
+    struct Configuration {
+      static constexpr size_t kDefaultRequestSize = 15ull << 20;
+      static constexpr size_t kDefaultMaxQueuedMessages = 1024;
+
+      size_t max_request_size{kDefaultRequestSize};
+      /// the session is closed once the client does not read more messages
+      size_t max_queued_messages{kDefaultMaxQueuedMessages};
+      /// the messages are binary ones prefixed with their length rather than
+      /// lines
+      bool binary{false};
+    };
+
+    UnixSession(Context &context, Configuration config);
+
+    ~UnixSession() override = default;
+
+    Socket &socket() {
+      return socket_;
+    }
+
+    Type type() const override {
+      return Type::UNIX;
+    }
+
+    void start() override;
+
+    /**
+     * @brief sends \arg message framed as a line or prefixed with its
+     * length, the messages are queued and sent one by one in the order they
+     * are given, so that it may be called from any thread, and the client,
+     * which does not read them, is disconnected once too many are queued
+     */
+    void respond(std::string message) override;
+
+   private:
+    using LengthPrefix = std::array<uint8_t, 4>;
+
+    void stop();
+
+    void asyncRead();
+    void onReadLine(boost::system::error_code ec, size_t size);
+    void onReadLength(boost::system::error_code ec, size_t size);
+    void onReadMessage(boost::system::error_code ec, size_t size);
+
+    void asyncWrite();
+    void onWrite(boost::system::error_code ec, size_t size);
+
+    /// closes the session on \arg ec, the client disconnecting is not an
+    /// error
+    void onError(boost::system::error_code ec, std::string_view message);
+
+    /// Strand to ensure the connection's handlers are not called concurrently.
+    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+
+    Socket socket_;
+    Configuration config_;
+    std::string rbuffer_;             ///< read buffer
+    LengthPrefix length_{};           ///< length of the binary message read
+    std::deque<std::string> wqueue_;  ///< framed messages to write
+    bool stopped_ = false;
+
+    common::Logger logger_ = common::createLogger("unix socket session");
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_TRANSPORT_IMPL_UNIX_SESSION_HPP
@@ -6,6 +6,7 @@
 #include "api/transport/impl/ws/ws_session.hpp"
 
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/config.hpp>
 #include <cstring>
 
@@ -26,9 +27,14 @@ namespace kagome::api {
   }
 
   void WsSession::stop() {
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
     boost::system::error_code ec;
     stream_.close(boost::beast::websocket::close_reason(), ec);
     boost::ignore_unused(ec);
+    notifyOnClose();
   }
 
   void WsSession::handleRequest(std::string_view data) {
@@ -42,18 +48,38 @@ namespace kagome::api {
   }
 
   void WsSession::asyncWrite() {
-    stream_.async_write(wbuffer_.data(),
+    stream_.async_write(boost::asio::buffer(wqueue_.front()),
                         boost::beast::bind_front_handler(&WsSession::onWrite,
                                                          shared_from_this()));
   }
 
-  void WsSession::respond(std::string_view response) {
-    boost::asio::buffer_copy(
-        wbuffer_.prepare(response.size()),
-        boost::asio::const_buffer(response.data(), response.size()));
-    wbuffer_.commit(response.size());
-    stream_.text(true);
-    asyncWrite();
+  void WsSession::respond(std::string response) {
+    boost::asio::post(
+        strand_,
+        [self = shared_from_this(), message = std::move(response)]() mutable {
+          if (self->stopped_) {
+            return;
+          }
+          if (self->wqueue_.size() >= self->config_.max_queued_messages) {
+            boost::system::error_code ec;
+            auto endpoint = self->socket_.remote_endpoint(ec);
+            self->logger_->warn(
+                "{} messages are not read by the client {}:{}, closing the "
+                "session",
+                self->wqueue_.size(),
+                endpoint.address().to_string(),
+                endpoint.port());
+            // the close frame would wait behind the queue, the socket is
+            // closed at once instead
+            self->socket_.close(ec);
+            return self->stop();
+          }
+          self->wqueue_.emplace_back(std::move(message));
+          // the other messages are written once the current one is
+          if (self->wqueue_.size() == 1) {
+            self->asyncWrite();
+          }
+        });
   }
 
   void WsSession::onRun() {
@@ -82,6 +108,8 @@ namespace kagome::api {
       return;
     }
 
+    stream_.text(not config_.binary);
+    stream_.read_message_max(config_.max_request_size);
     asyncRead();
   };
 
@@ -99,6 +127,9 @@ namespace kagome::api {
         {static_cast<char *>(rbuffer_.data().data()), bytes_transferred});
 
     rbuffer_.consume(bytes_transferred);
+
+    // the responses are written independently of the reads
+    asyncRead();
   }
 
   void WsSession::onWrite(boost::system::error_code ec,
@@ -108,9 +139,10 @@ namespace kagome::api {
       return stop();
     }
 
-    wbuffer_.consume(bytes_transferred);
-
-    asyncRead();
+    wqueue_.pop_front();
+    if (not stopped_ and not wqueue_.empty()) {
+      asyncWrite();
+    }
   }
 
   void WsSession::reportError(boost::system::error_code ec,
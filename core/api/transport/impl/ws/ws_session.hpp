@@ -11,6 +11,7 @@
 #include <boost/beast/websocket.hpp>
 #include <chrono>
 #include <cstdlib>
+#include <deque>
 #include <memory>
 
 #include "api/transport/session.hpp"
@@ -24,11 +25,16 @@ namespace kagome::api {
 
    public:
     struct Configuration {
-      static constexpr size_t kDefaultRequestSize = 10000u;
+      static constexpr size_t kDefaultRequestSize = 15ull << 20;
       static constexpr Duration kDefaultTimeout = std::chrono::seconds(30);
+      static constexpr size_t kDefaultMaxQueuedMessages = 1024;
 
       size_t max_request_size{kDefaultRequestSize};
       Duration operation_timeout{kDefaultTimeout};
+      /// the session is closed once the client does not read more messages
+      size_t max_queued_messages{kDefaultMaxQueuedMessages};
+      /// the messages are binary rather than text ones
+      bool binary{false};
     };
 
     ~WsSession() override = default;
@@ -40,20 +46,29 @@ namespace kagome::api {
      */
     WsSession(Context &context, Configuration config);
 
-    Socket &socket() override {
+    Socket &socket() {
       return socket_;
     }
 
+    Type type() const override {
+      return Type::WEBSOCKET;
+    }
+
     /**
      * @brief starts session
      */
     void start() override;
 
     /**
-     * @brief sends response wrapped by websocket frame
+     * @brief sends response wrapped by websocket frame, the messages are
+     * queued and sent one by one in the order they are given, so that it may
+     * be called from any thread, even while the session is reading. A client,
+     * which does not read the messages as fast as they are given, is
+     * disconnected once too many of them are queued, rather than dropping
+     * some of the responses and the notifications silently
      * @param response message to send
      */
-    void respond(std::string_view response) override;
+    void respond(std::string response) override;
 
    private:
     /**
@@ -74,7 +89,7 @@ namespace kagome::api {
     void asyncRead();
 
     /**
-     * @brief asynchronously write
+     * @brief asynchronously write the first of the queued messages
      */
     void asyncWrite();
 
@@ -115,7 +130,8 @@ namespace kagome::api {
     boost::beast::websocket::stream<boost::asio::ip::tcp::socket &>
         stream_;                         ///< stream
     boost::beast::flat_buffer rbuffer_;  ///< read buffer
-    boost::beast::flat_buffer wbuffer_;  ///< write buffer
+    std::deque<std::string> wqueue_;     ///< messages to write
+    bool stopped_ = false;
 
     common::Logger logger_ =
         common::createLogger("websocket session");  ///< logger instance
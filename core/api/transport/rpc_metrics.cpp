@@ -0,0 +1,175 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/rpc_metrics.hpp"
+
+#include <algorithm>
+
+namespace kagome::api {
+
+  RpcMetrics::RpcMetrics(const Configuration &configuration)
+      : slow_call_threshold_{configuration.slow_call_threshold} {}
+
+  void RpcMetrics::recordStarted() {
+    std::lock_guard lock{mutex_};
+    in_flight_++;
+    max_in_flight_ = std::max(max_in_flight_, in_flight_);
+  }
+
+  bool RpcMetrics::recordFinished(std::string_view method_name,
+                                  Clock::duration duration,
+                                  size_t request_bytes,
+                                  size_t response_bytes,
+                                  bool error) {
+    auto slow = slow_call_threshold_ != Clock::duration::zero()
+                and duration > slow_call_threshold_;
+    std::lock_guard lock{mutex_};
+    in_flight_ -= std::min<uint64_t>(in_flight_, 1);
+    auto &stats = method(method_name);
+    stats.calls++;
+    if (error) {
+      stats.errors++;
+    }
+    if (slow) {
+      stats.slow++;
+    }
+    stats.latency.add(duration);
+    add(stats.requests, request_bytes);
+    add(stats.responses, response_bytes);
+    return slow;
+  }
+
+  void RpcMetrics::recordRefused(std::string_view method_name,
+                                 size_t request_bytes) {
+    std::lock_guard lock{mutex_};
+    in_flight_ -= std::min<uint64_t>(in_flight_, 1);
+    auto &stats = method(method_name);
+    stats.refused++;
+    add(stats.requests, request_bytes);
+  }
+
+  void RpcMetrics::recordSessionOpened(Session::Type type) {
+    std::lock_guard lock{mutex_};
+    sessions(type)++;
+  }
+
+  void RpcMetrics::recordSessionClosed(Session::Type type) {
+    std::lock_guard lock{mutex_};
+    auto &open = sessions(type);
+    open -= std::min<uint64_t>(open, 1);
+  }
+
+  RpcMetrics::Report RpcMetrics::report() const {
+    Report report;
+    std::lock_guard lock{mutex_};
+    for (auto &[name, stats] : methods_) {
+      report.methods.emplace(name,
+                             MethodStats{stats.calls,
+                                         stats.errors,
+                                         stats.refused,
+                                         stats.slow,
+                                         stats.latency.stats(),
+                                         stats.requests,
+                                         stats.responses});
+    }
+    report.in_flight = in_flight_;
+    report.max_in_flight = max_in_flight_;
+    report.http_sessions = http_sessions_;
+    report.ws_sessions = ws_sessions_;
+    report.unix_sessions = unix_sessions_;
+    return report;
+  }
+
+  void RpcMetrics::collect(common::MetricsRegistry::Writer &writer) const {
+    using Type = common::MetricsRegistry::Type;
+    auto report = this->report();
+    // the samples of a family are written together, after its description
+    auto by_method = [&](const char *name, const char *help, auto &&value) {
+      writer.family(name, Type::COUNTER, help);
+      for (auto &[method, stats] : report.methods) {
+        writer.sample(name, {{"method", method}}, value(stats));
+      }
+    };
+    by_method("kagome_rpc_calls_total", "RPC calls", [](auto &stats) {
+      return stats.calls;
+    });
+    by_method("kagome_rpc_errors_total",
+              "RPC calls answered with an error",
+              [](auto &stats) { return stats.errors; });
+    by_method("kagome_rpc_refused_total",
+              "RPC calls refused as the server is busy",
+              [](auto &stats) { return stats.refused; });
+    by_method("kagome_rpc_slow_calls_total",
+              "RPC calls taking longer than the threshold",
+              [](auto &stats) { return stats.slow; });
+    by_method("kagome_rpc_request_bytes_total",
+              "Bytes of the RPC requests",
+              [](auto &stats) { return stats.requests.total; });
+    by_method("kagome_rpc_response_bytes_total",
+              "Bytes of the RPC responses",
+              [](auto &stats) { return stats.responses.total; });
+
+    writer.family("kagome_rpc_call_seconds",
+                  Type::SUMMARY,
+                  "Time from the arrival of an RPC request to its response");
+    for (auto &[method, stats] : report.methods) {
+      writer.durations(
+          "kagome_rpc_call_seconds", {{"method", method}}, stats.latency);
+    }
+
+    writer.family(
+        "kagome_rpc_calls_in_flight", Type::GAUGE, "RPC calls in flight");
+    writer.sample("kagome_rpc_calls_in_flight", {}, report.in_flight);
+    writer.family("kagome_rpc_sessions", Type::GAUGE, "Open RPC sessions");
+    writer.sample(
+        "kagome_rpc_sessions", {{"transport", "http"}}, report.http_sessions);
+    writer.sample(
+        "kagome_rpc_sessions", {{"transport", "ws"}}, report.ws_sessions);
+    writer.sample("kagome_rpc_sessions",
+                  {{"transport", "unix"}},
+                  report.unix_sessions);
+  }
+
+  void RpcMetrics::reset() {
+    std::lock_guard lock{mutex_};
+    methods_.clear();
+    max_in_flight_ = in_flight_;
+  }
+
+  RpcMetrics::Method &RpcMetrics::method(std::string_view name) {
+    if (name.empty()) {
+      name = kOtherMethods;
+    }
+    auto it = methods_.find(name);
+    if (it != methods_.end()) {
+      return it->second;
+    }
+    if (methods_.size() >= kMaxMethods) {
+      name = kOtherMethods;
+      if (it = methods_.find(name); it != methods_.end()) {
+        return it->second;
+      }
+    }
+    return methods_.emplace(std::string(name), Method{}).first->second;
+  }
+
+  uint64_t &RpcMetrics::sessions(Session::Type type) {
+    switch (type) {
+      case Session::Type::HTTP:
+        return http_sessions_;
+      case Session::Type::WEBSOCKET:
+        return ws_sessions_;
+      case Session::Type::UNIX:
+        break;
+    }
+    return unix_sessions_;
+  }
+
+  void RpcMetrics::add(Bytes &bytes, size_t size) {
+    bytes.total += size;
+    bytes.max = std::max<uint64_t>(bytes.max, size);
+  }
+
+}  // namespace kagome::api
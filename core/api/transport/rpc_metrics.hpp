@@ -0,0 +1,148 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_API_TRANSPORT_RPC_METRICS_HPP
+#define KAGOME_CORE_API_TRANSPORT_RPC_METRICS_HPP
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "api/transport/session.hpp"
+#include "common/duration_histogram.hpp"
+#include "common/metrics_registry.hpp"
+
+namespace kagome::api {
+
+  /**
+   * Collects the calls of the RPC methods: their number, the errors, the
+   * calls refused as the server is busy, the time from the arrival of a
+   * request to its response, which includes the wait in the thread pool, and
+   * the sizes of the requests and the responses. Also keeps the number of
+   * the calls in flight and of the open sessions. Thread-safe
+   */
+  class RpcMetrics {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using DurationStats = common::DurationHistogram::Stats;
+
+    /// number of the methods recorded by their names, so that the requests
+    /// of the clients don't make the report grow without a bound
+    static constexpr size_t kMaxMethods = 256;
+
+    /// name the calls of the other methods, and the requests which method
+    /// is not known, are recorded under
+    static constexpr std::string_view kOtherMethods = "other";
+
+    struct Configuration {
+      /// calls taking longer are counted and logged as slow ones, zero
+      /// disables that
+      std::chrono::milliseconds slow_call_threshold{1000};
+    };
+
+    struct Bytes {
+      uint64_t total = 0;
+      uint64_t max = 0;
+    };
+
+    struct MethodStats {
+      uint64_t calls = 0;
+      uint64_t errors = 0;
+      // not run, as too many expensive calls were waiting
+      uint64_t refused = 0;
+      uint64_t slow = 0;
+      DurationStats latency;
+      Bytes requests;
+      Bytes responses;
+    };
+
+    struct Report {
+      // by the names of the methods
+      std::map<std::string, MethodStats> methods;
+      uint64_t in_flight = 0;
+      // the most calls in flight at once
+      uint64_t max_in_flight = 0;
+      uint64_t http_sessions = 0;
+      uint64_t ws_sessions = 0;
+      uint64_t unix_sessions = 0;
+    };
+
+    RpcMetrics() = default;
+    explicit RpcMetrics(const Configuration &configuration);
+
+    /**
+     * Records a call, which request has arrived and is in flight until it is
+     * finished or refused
+     */
+    void recordStarted();
+
+    /**
+     * Records a call of \arg method, which took \arg duration to be
+     * answered with \arg response_bytes long response, \arg error or not,
+     * to \arg request_bytes long request
+     * @return true if the call is a slow one
+     */
+    bool recordFinished(std::string_view method,
+                        Clock::duration duration,
+                        size_t request_bytes,
+                        size_t response_bytes,
+                        bool error);
+
+    /**
+     * Records a call of \arg method refused as the server is busy
+     */
+    void recordRefused(std::string_view method, size_t request_bytes);
+
+    void recordSessionOpened(Session::Type type);
+
+    void recordSessionClosed(Session::Type type);
+
+    Report report() const;
+
+    /**
+     * Writes the report to \arg writer, on the scrapes of Prometheus
+     */
+    void collect(common::MetricsRegistry::Writer &writer) const;
+
+    /**
+     * Forgets everything collected so far, but the calls in flight and the
+     * open sessions
+     */
+    void reset();
+
+   private:
+    struct Method {
+      uint64_t calls = 0;
+      uint64_t errors = 0;
+      uint64_t refused = 0;
+      uint64_t slow = 0;
+      common::DurationHistogram latency;
+      Bytes requests;
+      Bytes responses;
+    };
+
+    Method &method(std::string_view name);
+
+    /// number of the open sessions of \arg type
+    uint64_t &sessions(Session::Type type);
+
+    static void add(Bytes &bytes, size_t size);
+
+    Clock::duration slow_call_threshold_ =
+        Configuration{}.slow_call_threshold;
+    mutable std::mutex mutex_;
+    std::map<std::string, Method, std::less<>> methods_;
+    uint64_t in_flight_ = 0;
+    uint64_t max_in_flight_ = 0;
+    uint64_t http_sessions_ = 0;
+    uint64_t ws_sessions_ = 0;
+    uint64_t unix_sessions_ = 0;
+  };
+
+}  // namespace kagome::api
+
+#endif  // KAGOME_CORE_API_TRANSPORT_RPC_METRICS_HPP
@@ -5,6 +5,8 @@
 
 #include "api/transport/rpc_thread_pool.hpp"
 
+#include <boost/asio/post.hpp>
+
 namespace kagome::api {
 
   RpcThreadPool::RpcThreadPool(std::shared_ptr<Context> context,
@@ -14,13 +16,12 @@ namespace kagome::api {
   }
 
   void RpcThreadPool::start() {
+    std::lock_guard lock{mutex_};
+    started_ = true;
     threads_.reserve(config_.max_thread_number);
     // Create a pool of threads to run all of the io_contexts.
     for (std::size_t i = 0; i < config_.min_thread_number; ++i) {
-      auto thread = std::make_shared<std::thread>(
-          [context = context_] { context->run(); });
-      thread->detach();
-      threads_.emplace_back(std::move(thread));
+      startThread();
     }
     logger_->debug("Thread pool started");
   }
@@ -30,4 +31,76 @@ namespace kagome::api {
     logger_->debug("Thread pool stopped");
   }
 
+  bool RpcThreadPool::submit(Lane lane, Task task) {
+    std::lock_guard lock{mutex_};
+    if (lane == Lane::CHEAP) {
+      ++cheap_calls_;
+      post(lane, std::move(task));
+      return true;
+    }
+    if (canRunExpensive()) {
+      ++expensive_running_;
+      post(lane, std::move(task));
+      return true;
+    }
+    // the overload is reported at once rather than timing out later
+    if (expensive_queue_.size() >= config_.max_queued_expensive_calls) {
+      return false;
+    }
+    expensive_queue_.emplace_back(std::move(task));
+    return true;
+  }
+
+  bool RpcThreadPool::canRunExpensive() const {
+    if (expensive_running_ < config_.max_expensive_calls) {
+      return true;
+    }
+    // the idle capacity of the cheap lane is taken, but for a thread
+    return cheap_calls_ == 0
+           and expensive_running_ + 1 < config_.max_thread_number;
+  }
+
+  void RpcThreadPool::post(Lane lane, Task task) {
+    grow();
+    boost::asio::post(
+        *context_,
+        [weak = weak_from_this(), lane, task = std::move(task)] {
+          task();
+          if (auto self = weak.lock()) {
+            self->onDone(lane);
+          }
+        });
+  }
+
+  void RpcThreadPool::grow() {
+    auto busy = cheap_calls_ + expensive_running_;
+    if (started_ and busy > threads_.size()
+        and threads_.size() < config_.max_thread_number) {
+      startThread();
+      logger_->debug("Thread pool grew to {} threads", threads_.size());
+    }
+  }
+
+  void RpcThreadPool::onDone(Lane lane) {
+    std::lock_guard lock{mutex_};
+    if (lane == Lane::CHEAP) {
+      --cheap_calls_;
+    } else {
+      --expensive_running_;
+    }
+    while (not expensive_queue_.empty() and canRunExpensive()) {
+      ++expensive_running_;
+      auto task = std::move(expensive_queue_.front());
+      expensive_queue_.pop_front();
+      post(Lane::EXPENSIVE, std::move(task));
+    }
+  }
+
+  void RpcThreadPool::startThread() {
+    auto thread =
+        std::make_shared<std::thread>([context = context_] { context->run(); });
+    thread->detach();
+    threads_.emplace_back(std::move(thread));
+  }
+
 }  // namespace kagome::api
@@ -8,6 +8,9 @@
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <set>
 #include <thread>
 
@@ -20,15 +23,28 @@ using kagome::application::AppStateManager;
 namespace kagome::api {
 
   /**
-   * @brief thread pool for serve RPC calls
+   * @brief thread pool for serve RPC calls. The calls are run in two lanes:
+   * the cheap ones are run at once, while only a few of the expensive ones,
+   * which call the runtime or read a lot of the storage, are run at a time,
+   * so that they do not hold all the threads. The expensive lane takes the
+   * capacity of the cheap one, while it is idle. The pool starts more
+   * threads, up to the max number, while all of them are busy with the calls
    */
   class RpcThreadPool : public std::enable_shared_from_this<RpcThreadPool> {
    public:
     using Context = RpcContext;
+    using Task = std::function<void()>;
+
+    enum class Lane { CHEAP, EXPENSIVE };
 
     struct Configuration {
       size_t min_thread_number = 1;
       size_t max_thread_number = 10;
+      /// expensive calls run at once, more of them are run only while there
+      /// are no cheap calls, keeping a thread for them
+      size_t max_expensive_calls = 2;
+      /// expensive calls waiting to be run, more of them are rejected
+      size_t max_queued_expensive_calls = 64;
     };
 
     RpcThreadPool(std::shared_ptr<Context> context,
@@ -46,12 +62,47 @@ namespace kagome::api {
      */
     void stop();
 
+    /**
+     * @return context, which the pool runs
+     */
+    Context &context() {
+      return *context_;
+    }
+
+    /**
+     * @brief runs \arg task in the pool, in \arg lane, may be called from
+     * any thread
+     * @return false if the task is rejected, as too many expensive calls
+     * wait already
+     */
+    bool submit(Lane lane, Task task);
+
    private:
+    /// the expensive call may be run now
+    bool canRunExpensive() const;
+
+    /// posts \arg task of \arg lane to the context, under the mutex
+    void post(Lane lane, Task task);
+
+    /// starts a thread if all of them are busy, under the mutex
+    void grow();
+
+    void onDone(Lane lane);
+
+    void startThread();
+
     std::shared_ptr<Context> context_;
     const Configuration config_;
 
     std::vector<std::shared_ptr<std::thread>> threads_;
 
+    std::mutex mutex_;
+    bool started_ = false;
+    /// cheap calls posted and not done yet
+    size_t cheap_calls_ = 0;
+    size_t expensive_running_ = 0;
+    std::deque<Task> expensive_queue_;
+
     common::Logger logger_ = common::createLogger("RPC thread pool");
   };
 
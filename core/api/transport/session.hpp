@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_API_TRANSPORT_SESSION_HPP
 #define KAGOME_CORE_API_TRANSPORT_SESSION_HPP
 
+#include <atomic>
+
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/read_until.hpp>
@@ -35,16 +37,30 @@ namespace kagome::api {
     using Timer = boost::asio::steady_timer;
     using Connection = boost::signals2::connection;
     using Duration = Timer::duration;
+    using SessionId = uint64_t;
+
+    enum class Type { HTTP, WEBSOCKET, UNIX };
 
     virtual ~Session() = default;
 
+    /**
+     * @return id of the session, unique within the process
+     */
+    SessionId id() const {
+      return id_;
+    }
+
+    /**
+     * @return transport of the session, only the websocket and the unix
+     * socket sessions are kept open to be sent the notifications
+     */
+    virtual Type type() const = 0;
+
     /**
      * @brief starts listening on socket
      */
     virtual void start() = 0;
 
-    virtual Socket &socket() = 0;
-
     /**
      * @brief connects `on request` callback
      * @param callback `on request` callback
@@ -64,12 +80,36 @@ namespace kagome::api {
 
     /**
      * @brief send response message
-     * @param message response message
+     * @param message response message, which the session takes, so that it
+     * is not copied once more when it is moved in
      */
-    virtual void respond(std::string_view message) = 0;
+    virtual void respond(std::string message) = 0;
+
+    /**
+     * @brief connects `on close` callback, which is called once, with the id
+     * of the session
+     * @param callback `on close` callback
+     */
+    void connectOnClose(std::function<void(SessionId)> callback) {
+      on_close_ = std::move(callback);
+    }
+
+   protected:
+    void notifyOnClose() {
+      if (on_close_) {
+        on_close_(id_);
+      }
+    }
 
    private:
+    static SessionId nextId() {
+      static std::atomic<SessionId> last_id{0};
+      return ++last_id;
+    }
+
     std::function<OnRequestSignature> on_request_;  ///< `on request` callback
+    std::function<void(SessionId)> on_close_;       ///< `on close` callback
+    const SessionId id_ = nextId();
   };
 
 }  // namespace kagome::api
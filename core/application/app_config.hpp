@@ -8,8 +8,10 @@
 
 #include <spdlog/spdlog.h>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/optional.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace kagome::application {
 
@@ -24,6 +26,13 @@ namespace kagome::application {
       kFullSyncing,
     };
 
+    enum struct StorageBackend {
+      kLevelDB,
+      kRocksDB,
+      // nothing is written to the disk, for dev and bench nodes
+      kMemory,
+    };
+
    public:
     virtual ~AppConfiguration() = default;
 
@@ -32,6 +41,36 @@ namespace kagome::application {
      */
     virtual const std::string &genesis_path() const = 0;
 
+    /**
+     * @return level of the optimizations applied to the runtime code before
+     * it is interpreted, 0 means the code is interpreted as is.
+     */
+    virtual uint32_t runtime_optimization_level() const = 0;
+
+    /**
+     * @return directory, which the optimized runtime code is cached in, empty
+     * if it is not cached.
+     */
+    virtual const std::string &runtime_cache_path() const = 0;
+
+    /**
+     * @return max number of the runtime instances serving calls, which don't
+     * change the state, in parallel, 0 means one per RPC thread.
+     */
+    virtual size_t runtime_instances_num() const = 0;
+
+    /**
+     * @return true if the timings of the runtime calls are collected from the
+     * start, otherwise they are collected once enabled over RPC.
+     */
+    virtual bool runtime_profiling() const = 0;
+
+    /**
+     * @return number of the offchain workers of the runtime run at once, on
+     * threads and runtime instances of their own, 0 disables them.
+     */
+    virtual size_t offchain_workers_num() const = 0;
+
     /**
      * @return keystore directory path.
      */
@@ -42,11 +81,177 @@ namespace kagome::application {
      */
     virtual const std::string &leveldb_path() const = 0;
 
+    /**
+     * @return leveldb directory path of the trie nodes, empty if they are
+     * kept in leveldb_path().
+     */
+    virtual const std::string &leveldb_trie_path() const = 0;
+
+    /**
+     * @return leveldb directory path of the headers, bodies and
+     * justifications of the blocks, empty if they are kept in leveldb_path().
+     */
+    virtual const std::string &leveldb_blocks_path() const = 0;
+
+    /**
+     * @return database used as the storage, which is kept in leveldb_path()
+     * directory in any case.
+     */
+    virtual StorageBackend storage_backend() const = 0;
+
+    /**
+     * @return max size of the data kept by the in-memory storage in bytes, 0
+     * means no limit.
+     */
+    virtual size_t memory_storage_budget() const = 0;
+
+    /**
+     * @return capacity of the leveldb cache of uncompressed blocks in bytes.
+     */
+    virtual size_t leveldb_block_cache_size() const = 0;
+
+    /**
+     * @return bits per key of the leveldb bloom filter, 0 disables the
+     * filter.
+     */
+    virtual uint32_t leveldb_bloom_filter_bits() const = 0;
+
+    /**
+     * @return size of the leveldb memtable in bytes, which is written to the
+     * disk when it is full.
+     */
+    virtual size_t leveldb_write_buffer_size() const = 0;
+
+    /**
+     * @return max number of files kept open by leveldb.
+     */
+    virtual uint32_t leveldb_max_open_files() const = 0;
+
+    /**
+     * @return true if the writes to leveldb are synced and are made by a
+     * thread of their own, which merges the writes of several callers into
+     * one, false if each write is made by its caller.
+     */
+    virtual bool leveldb_group_commit() const = 0;
+
+    /**
+     * @return max number of decoded trie nodes kept in the shared node cache.
+     */
+    virtual size_t trie_node_cache_size() const = 0;
+
+    /**
+     * @return min size in bytes of the values of the trie nodes, which are
+     * stored apart from their nodes and are read only when looked up, 0 if
+     * the values are stored in the nodes. The values stored either way are
+     * read regardless of it
+     */
+    virtual size_t trie_large_value_threshold() const = 0;
+
+    /**
+     * @return max number of decoded block headers kept in the shared header
+     * cache.
+     */
+    virtual size_t block_header_cache_size() const = 0;
+
+    /**
+     * @return total size in bytes of the trie node and the block header
+     * caches, which is shared between them by their hit rates, overriding
+     * their sizes, 0 if each cache keeps its own size.
+     */
+    virtual size_t cache_budget() const = 0;
+
+    /**
+     * @return number of finalized blocks, which states are kept in the
+     * storage, 0 means that no state is ever pruned.
+     */
+    virtual uint32_t state_pruning_depth() const = 0;
+
+    /**
+     * @return number of finalized blocks, which bodies are kept in the
+     * storage, 0 means that no body is ever pruned.
+     */
+    virtual uint32_t blocks_pruning_depth() const = 0;
+
+    /**
+     * @return number of finalized blocks between the ones, which
+     * justifications are kept in the storage along with the ones of the
+     * authority set changes and of the last finalized block, 0 means that
+     * every justification is kept.
+     */
+    virtual uint32_t justification_period() const = 0;
+
+    /**
+     * @return path of a state snapshot file, which trie nodes are read from
+     * before the database, empty if there is no snapshot.
+     */
+    virtual const std::string &state_snapshot_path() const = 0;
+
+    /**
+     * @return path of the directory keeping the data of the finalized blocks
+     * out of the database, empty if it is kept in the database.
+     */
+    virtual const std::string &block_freezer_path() const = 0;
+
+    /**
+     * @return zstd level the data of the blocks is compressed with when it is
+     * moved to the block freezer, 0 if it is not compressed.
+     */
+    virtual uint32_t block_freezer_compression() const = 0;
+
+    /**
+     * @return size in bytes of the filter of the storage keys, which answers
+     * lookups of absent keys without reading the trie, 0 disables the filter.
+     */
+    virtual size_t trie_key_filter_size() const = 0;
+
+    /**
+     * @return true if the values of the storage of the finalized and the
+     * later states are kept apart from the trie as well, so that the runtime
+     * reads them with a single lookup.
+     */
+    virtual bool flat_state() const = 0;
+
+    /**
+     * @return number of the threads reading the nodes of the state a block
+     * is expected to access ahead of its execution, 0 disables the reading
+     * ahead.
+     */
+    virtual size_t state_prefetch_threads() const = 0;
+
+    /**
+     * @return path of the file the transaction pool is written to at the
+     * shutdown and is filled from at the launch, empty if the pool is not
+     * kept between the runs.
+     */
+    virtual const std::string &transaction_pool_dump_path() const = 0;
+
     /**
      * @return port for peer to peer interactions.
      */
     virtual uint16_t p2p_port() const = 0;
 
+    /**
+     * @return number of the blocks the bodies of which are requested from
+     * one peer at once in a sync, after their headers are received and
+     * checked, 0 means that the headers and the bodies are requested
+     * together.
+     */
+    virtual size_t sync_bodies_batch_size() const = 0;
+
+    /**
+     * @return true if a node having only the genesis block syncs to the
+     * latest finalized state instead of importing the blocks from the
+     * genesis.
+     */
+    virtual bool warp_sync() const = 0;
+
+    /**
+     * @return number of the threads reading the storage to answer the
+     * requests of the peers, apart from the thread of the network and the
+     * consensus.
+     */
+    virtual size_t storage_read_threads_num() const = 0;
+
     /**
      * @return endpoint for RPC over HTTP.
      */
@@ -57,6 +262,56 @@ namespace kagome::application {
      */
     virtual const boost::asio::ip::tcp::endpoint &rpc_ws_endpoint() const = 0;
 
+    /**
+     * @return endpoint for RPC in binary SCALE messages over Websocket
+     * protocol, none if it is disabled.
+     */
+    virtual const boost::optional<boost::asio::ip::tcp::endpoint>
+        &rpc_scale_endpoint() const = 0;
+
+    /**
+     * @return path of the unix domain socket for RPC, for the clients on the
+     * same host, empty if it is disabled.
+     */
+    virtual const std::string &rpc_unix_socket_path() const = 0;
+
+    /**
+     * @return path of the unix domain socket for RPC in binary SCALE
+     * messages, empty if it is disabled.
+     */
+    virtual const std::string &rpc_scale_unix_socket_path() const = 0;
+
+    /**
+     * @return max size in bytes of an RPC request, of an HTTP body or of a
+     * websocket message.
+     */
+    virtual size_t rpc_max_request_size() const = 0;
+
+    /**
+     * @return time in milliseconds, RPC calls taking longer than which are
+     * logged as slow ones, 0 if they are not.
+     */
+    virtual uint32_t rpc_slow_call_threshold() const = 0;
+
+    /**
+     * @return directory the CPU and the heap profiles taken on demand over
+     * RPC are written to, empty if they are not taken.
+     */
+    virtual const std::string &process_profiles_path() const = 0;
+
+    /**
+     * @return endpoint the metrics are served at to the scrapes of
+     * Prometheus, none if they are not.
+     */
+    virtual const boost::optional<boost::asio::ip::tcp::endpoint>
+        &prometheus_endpoint() const = 0;
+
+    /**
+     * @return websocket urls of the aggregators the telemetry of the node is
+     * sent to, none if it is not.
+     */
+    virtual const std::vector<std::string> &telemetry_urls() const = 0;
+
     /**
      * @return log level (0-trace, 5-only critical, 6-no logs).
      */
@@ -6,6 +6,8 @@
 #ifndef KAGOME_APPLICATION_DISPATCHER
 #define KAGOME_APPLICATION_DISPATCHER
 
+#include <vector>
+
 #include "common/logger.hpp"
 
 namespace kagome::application {
@@ -14,6 +16,10 @@ namespace kagome::application {
    public:
     using Callback = std::function<void()>;
 
+    /// identifies a callback of the stage 'prepare' for the ones depending
+    /// on it
+    using PrepareId = size_t;
+
     enum class State {
       Init,
       Prepare,
@@ -26,7 +32,21 @@ namespace kagome::application {
 
     virtual ~AppStateManager() = default;
 
+    /**
+     * Adds \arg cb to the stage 'prepare', it is run after the callbacks
+     * added this way before it, one after another
+     */
     virtual void atPrepare(Callback &&cb) = 0;
+
+    /**
+     * Adds \arg cb to the stage 'prepare', it is run once the callbacks of
+     * \arg dependencies are done. The callbacks, which do not depend on each
+     * other, are run concurrently, so \arg cb must not touch the state the
+     * others change without the synchronization of its own
+     * @return id of the callback, which the ones added later may depend on
+     */
+    virtual PrepareId atPrepare(Callback &&cb,
+                                std::vector<PrepareId> dependencies) = 0;
     virtual void atLaunch(Callback &&cb) = 0;
     virtual void atShutdown(Callback &&cb) = 0;
 
@@ -6,11 +6,15 @@
 #ifndef KAGOME_CONFIGURATION_STORAGE_HPP
 #define KAGOME_CONFIGURATION_STORAGE_HPP
 
+#include <functional>
+
+#include <gsl/span>
 #include <libp2p/peer/peer_info.hpp>
 #include "application/genesis_raw_config.hpp"
 #include "crypto/ed25519_types.hpp"
 #include "crypto/sr25519_types.hpp"
 #include "network/types/peer_list.hpp"
+#include "outcome/outcome.hpp"
 #include "primitives/block.hpp"
 
 namespace kagome::application {
@@ -21,12 +25,28 @@ namespace kagome::application {
    */
   class ConfigurationStorage {
    public:
+    /**
+     * Is called with the unhexed key and value of each entry of the genesis
+     * state, which are only valid during the call
+     */
+    using GenesisVisitor = std::function<outcome::result<void>(
+        gsl::span<const uint8_t> key, gsl::span<const uint8_t> value)>;
+
     virtual ~ConfigurationStorage() = default;
 
     /**
      * @return genesis block of the chain
      */
-    virtual GenesisRawConfig getGenesis() const = 0;
+    virtual outcome::result<GenesisRawConfig> getGenesis() const = 0;
+
+    /**
+     * Reads the entries of the genesis state one by one in the order they are
+     * in the config, without keeping them in the memory
+     * @param visitor is called for each of the entries, the reading stops at
+     * the first error it returns
+     */
+    virtual outcome::result<void> visitGenesis(
+        const GenesisVisitor &visitor) const = 0;
 
     /**
      * Return ids of peer nodes of the current node
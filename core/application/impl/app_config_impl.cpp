@@ -9,6 +9,7 @@
 #include <rapidjson/filereadstream.h>
 #include <boost/program_options.hpp>
 #include <iostream>
+#include <limits>
 
 namespace {
   template <typename T, typename Func>
@@ -24,9 +25,43 @@ namespace {
   const std::string def_rpc_ws_host = "0.0.0.0";
   const uint16_t def_rpc_http_port = 40363;
   const uint16_t def_rpc_ws_port = 40364;
+  const uint16_t def_rpc_scale_port = 0;
+  const std::string def_prometheus_host = "127.0.0.1";
+  const uint16_t def_prometheus_port = 9615;
   const uint16_t def_p2p_port = 30363;
+  const size_t def_sync_bodies_batch_size = 0;
+  const size_t def_rpc_max_request_size = 15ull << 20;
+  const uint32_t def_rpc_slow_call_threshold = 1000;
+  const bool def_warp_sync = false;
+  const size_t def_storage_read_threads_num = 2;
   const int def_verbosity = 2;
   const bool def_is_only_finalizing = false;
+  // random reads of trie nodes miss leveldb's default 8MB cache and, having
+  // no filter, read a block of each level for absent keys
+  const uint32_t def_runtime_optimization_level = 0;
+  const size_t def_runtime_instances_num = 0;
+  const bool def_runtime_profiling = false;
+  const size_t def_offchain_workers_num = 1;
+  const size_t def_memory_storage_budget = 0;
+  const size_t def_leveldb_block_cache_size = 64ull << 20;
+  const uint32_t def_leveldb_bloom_filter_bits = 10;
+  const size_t def_leveldb_write_buffer_size = 16ull << 20;
+  const uint32_t def_leveldb_max_open_files = 1000;
+  const bool def_leveldb_group_commit = false;
+  const size_t def_trie_node_cache_size = 65536;
+  const size_t def_trie_large_value_threshold = 0;
+  const size_t def_block_header_cache_size = 4096;
+  const uint32_t def_state_pruning_depth = 0;
+  const uint32_t def_blocks_pruning_depth = 0;
+  const uint32_t def_justification_period = 0;
+  const uint32_t def_block_freezer_compression = 0;
+  const size_t def_trie_key_filter_size = 0;
+  const size_t def_cache_budget = 0;
+  const bool def_flat_state = false;
+  const size_t def_state_prefetch_threads = 0;
+  const kagome::application::AppConfiguration::StorageBackend
+      def_storage_backend =
+          kagome::application::AppConfiguration::StorageBackend::kLevelDB;
 }  // namespace
 
 namespace kagome::application {
@@ -37,7 +72,37 @@ namespace kagome::application {
         rpc_ws_host_(def_rpc_ws_host),
         rpc_http_port_(def_rpc_http_port),
         rpc_ws_port_(def_rpc_ws_port),
+        rpc_scale_port_(def_rpc_scale_port),
+        prometheus_host_(def_prometheus_host),
+        prometheus_port_(def_prometheus_port),
+        runtime_optimization_level_(def_runtime_optimization_level),
+        runtime_instances_num_(def_runtime_instances_num),
+        runtime_profiling_(def_runtime_profiling),
+        offchain_workers_num_(def_offchain_workers_num),
+        storage_backend_(def_storage_backend),
+        memory_storage_budget_(def_memory_storage_budget),
+        leveldb_block_cache_size_(def_leveldb_block_cache_size),
+        leveldb_bloom_filter_bits_(def_leveldb_bloom_filter_bits),
+        leveldb_write_buffer_size_(def_leveldb_write_buffer_size),
+        leveldb_max_open_files_(def_leveldb_max_open_files),
+        leveldb_group_commit_(def_leveldb_group_commit),
+        trie_node_cache_size_(def_trie_node_cache_size),
+        trie_large_value_threshold_(def_trie_large_value_threshold),
+        block_header_cache_size_(def_block_header_cache_size),
+        state_pruning_depth_(def_state_pruning_depth),
+        blocks_pruning_depth_(def_blocks_pruning_depth),
+        justification_period_(def_justification_period),
+        block_freezer_compression_(def_block_freezer_compression),
+        trie_key_filter_size_(def_trie_key_filter_size),
+        cache_budget_(def_cache_budget),
+        flat_state_(def_flat_state),
+        state_prefetch_threads_(def_state_prefetch_threads),
         p2p_port_(def_p2p_port),
+        sync_bodies_batch_size_(def_sync_bodies_batch_size),
+        rpc_max_request_size_(def_rpc_max_request_size),
+        rpc_slow_call_threshold_(def_rpc_slow_call_threshold),
+        warp_sync_(def_warp_sync),
+        storage_read_threads_num_(def_storage_read_threads_num),
         verbosity_(static_cast<spdlog::level::level_enum>(def_verbosity)),
         is_only_finalizing_(def_is_only_finalizing) {}
 
@@ -86,6 +151,17 @@ namespace kagome::application {
     return false;
   }
 
+  bool AppConfigurationImpl::load_u64(const rapidjson::Value &val,
+                                      char const *name,
+                                      uint64_t &target) {
+    auto m = val.FindMember(name);
+    if (val.MemberEnd() != m && m->value.IsUint64()) {
+      target = m->value.GetUint64();
+      return true;
+    }
+    return false;
+  }
+
   void AppConfigurationImpl::parse_general_segment(rapidjson::Value &val) {
     uint16_t v{};
     if (load_u16(val, "verbosity", v) && v <= SPDLOG_LEVEL_OFF)
@@ -94,10 +170,102 @@ namespace kagome::application {
 
   void AppConfigurationImpl::parse_blockchain_segment(rapidjson::Value &val) {
     load_str(val, "genesis", genesis_path_);
+    uint64_t v{};
+    if (load_u64(val, "runtime_optimization_level", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      runtime_optimization_level_ = v;
+    }
+    load_str(val, "runtime_cache", runtime_cache_path_);
+    if (load_u64(val, "runtime_instances_num", v)) {
+      runtime_instances_num_ = v;
+    }
+    load_bool(val, "runtime_profiling", runtime_profiling_);
+    if (load_u64(val, "offchain_workers_num", v)) {
+      offchain_workers_num_ = v;
+    }
   }
 
   void AppConfigurationImpl::parse_storage_segment(rapidjson::Value &val) {
     load_str(val, "leveldb", leveldb_path_);
+    load_str(val, "leveldb_trie", leveldb_trie_path_);
+    load_str(val, "leveldb_blocks", leveldb_blocks_path_);
+    std::string backend;
+    if (load_str(val, "storage_backend", backend)) {
+      set_storage_backend(backend);
+    }
+    uint64_t v{};
+    if (load_u64(val, "memory_storage_budget", v)) {
+      memory_storage_budget_ = v;
+    }
+    if (load_u64(val, "leveldb_block_cache_size", v)) {
+      leveldb_block_cache_size_ = v;
+    }
+    if (load_u64(val, "leveldb_bloom_filter_bits", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      leveldb_bloom_filter_bits_ = v;
+    }
+    if (load_u64(val, "leveldb_write_buffer_size", v)) {
+      leveldb_write_buffer_size_ = v;
+    }
+    if (load_u64(val, "leveldb_max_open_files", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      leveldb_max_open_files_ = v;
+    }
+    load_bool(val, "leveldb_group_commit", leveldb_group_commit_);
+    if (load_u64(val, "trie_node_cache_size", v)) {
+      trie_node_cache_size_ = v;
+    }
+    if (load_u64(val, "trie_large_value_threshold", v)) {
+      trie_large_value_threshold_ = v;
+    }
+    if (load_u64(val, "block_header_cache_size", v)) {
+      block_header_cache_size_ = v;
+    }
+    if (load_u64(val, "state_pruning_depth", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      state_pruning_depth_ = v;
+    }
+    if (load_u64(val, "blocks_pruning_depth", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      blocks_pruning_depth_ = v;
+    }
+    if (load_u64(val, "justification_period", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      justification_period_ = v;
+    }
+    load_str(val, "state_snapshot", state_snapshot_path_);
+    load_str(val, "block_freezer", block_freezer_path_);
+    if (load_u64(val, "block_freezer_compression", v)
+        && v <= std::numeric_limits<uint32_t>::max()) {
+      block_freezer_compression_ = v;
+    }
+    if (load_u64(val, "trie_key_filter_size", v)) {
+      trie_key_filter_size_ = v;
+    }
+    if (load_u64(val, "cache_budget", v)) {
+      cache_budget_ = v;
+    }
+    load_bool(val, "flat_state", flat_state_);
+    if (load_u64(val, "state_prefetch_threads", v)) {
+      state_prefetch_threads_ = v;
+    }
+    load_str(val, "transaction_pool_dump", transaction_pool_dump_path_);
+  }
+
+  void AppConfigurationImpl::set_storage_backend(const std::string &name) {
+    if (name == "leveldb") {
+      storage_backend_ = StorageBackend::kLevelDB;
+    } else if (name == "rocksdb") {
+#ifdef KAGOME_WITH_ROCKSDB
+      storage_backend_ = StorageBackend::kRocksDB;
+#else
+      logger_->error("The node is built without RocksDB, LevelDB is used");
+#endif
+    } else if (name == "memory") {
+      storage_backend_ = StorageBackend::kMemory;
+    } else {
+      logger_->error("Unknown storage backend: {}", name);
+    }
   }
 
   void AppConfigurationImpl::parse_authority_segment(rapidjson::Value &val) {
@@ -110,6 +278,26 @@ namespace kagome::application {
     load_u16(val, "rpc_http_port", rpc_http_port_);
     load_str(val, "rpc_ws_host", rpc_ws_host_);
     load_u16(val, "rpc_ws_port", rpc_ws_port_);
+    load_u16(val, "rpc_scale_port", rpc_scale_port_);
+    load_str(val, "rpc_unix_socket", rpc_unix_socket_path_);
+    load_str(val, "rpc_scale_unix_socket", rpc_scale_unix_socket_path_);
+    load_str(val, "prometheus_host", prometheus_host_);
+    load_u16(val, "prometheus_port", prometheus_port_);
+    uint64_t v{};
+    if (load_u64(val, "rpc_max_request_size", v)) {
+      rpc_max_request_size_ = v;
+    }
+    if (load_u64(val, "rpc_slow_call_threshold", v)) {
+      rpc_slow_call_threshold_ = v;
+    }
+    load_str(val, "process_profiles", process_profiles_path_);
+    if (load_u64(val, "sync_bodies_batch_size", v)) {
+      sync_bodies_batch_size_ = v;
+    }
+    load_bool(val, "warp_sync", warp_sync_);
+    if (load_u64(val, "storage_read_threads_num", v)) {
+      storage_read_threads_num_ = v;
+    }
   }
 
   void AppConfigurationImpl::parse_additional_segment(rapidjson::Value &val) {
@@ -217,11 +405,39 @@ namespace kagome::application {
     po::options_description blockhain_desc("Blockchain options");
     blockhain_desc.add_options()
         ("genesis,g", po::value<std::string>(), "required, configuration file path")
+        ("runtime_optimization_level", po::value<uint32_t>(), "level (1-4) of the Binaryen optimizations applied to the runtime code once before it is interpreted, 0 (default) interprets the code as is")
+        ("runtime_cache", po::value<std::string>(), "directory to keep the optimized runtime code in, so that it is not optimized again after a restart")
+        ("runtime_instances_num", po::value<size_t>(), "max number of the runtime instances serving the calls, which don't change the state, in parallel, 0 (default) means one per RPC thread")
+        ("runtime_profiling", "collect the timings of the runtime exports and host functions from the start, available over RPC")
+        ("offchain_workers_num", po::value<size_t>(), "number of the offchain workers run at once after the best block changes, 0 disables them, 1 by default")
         ;
 
     po::options_description storage_desc("Storage options");
     storage_desc.add_options()
         ("leveldb,l", po::value<std::string>(), "required, leveldb directory path")
+        ("leveldb_trie", po::value<std::string>(), "leveldb directory path of the trie nodes, which are read randomly, e.g. on a faster disk, if it differs from the main one")
+        ("leveldb_blocks", po::value<std::string>(), "leveldb directory path of the headers, bodies and justifications of the blocks, which are mostly appended, e.g. on a cheaper disk, if it differs from the main one")
+        ("storage_backend", po::value<std::string>(), "database to store data in: leveldb (default) or rocksdb, if the node is built with it, which keeps trie nodes and blocks in separately tuned column families, or memory, which keeps nothing on the disk")
+        ("memory_storage_budget", po::value<size_t>(), "max size in bytes of the data kept by the memory storage backend, 0 means no limit")
+        ("leveldb_block_cache_size", po::value<size_t>(), "capacity of the leveldb cache of uncompressed blocks in bytes")
+        ("leveldb_bloom_filter_bits", po::value<uint32_t>(), "bits per key of the leveldb bloom filter, 0 disables the filter")
+        ("leveldb_write_buffer_size", po::value<size_t>(), "size of the leveldb memtable in bytes")
+        ("leveldb_max_open_files", po::value<uint32_t>(), "max number of files kept open by leveldb")
+        ("leveldb_group_commit", "sync the writes to leveldb, and make them on a thread of their own, which merges the writes queued by several callers into one, so that the callers neither wait for the disk nor sync it each")
+        ("trie_node_cache_size", po::value<size_t>(), "max number of decoded trie nodes kept in memory, 0 disables the cache")
+        ("trie_large_value_threshold", po::value<size_t>(), "min size in bytes of the values of the trie nodes stored apart from the nodes and read only when looked up, 0 keeps all the values in the nodes")
+        ("block_header_cache_size", po::value<size_t>(), "max number of decoded block headers kept in memory, 0 disables the cache")
+        ("state_pruning_depth", po::value<uint32_t>(), "number of finalized blocks to keep the state of, 0 keeps all states (archive node), must be set on a fresh database")
+        ("blocks_pruning_depth", po::value<uint32_t>(), "number of finalized blocks to keep the bodies of, 0 keeps all bodies, the headers and the justified authority set changes are always kept")
+        ("justification_period", po::value<uint32_t>(), "number of finalized blocks between the ones, which justifications are kept, besides the justified authority set changes and the last finalized block, 0 keeps all justifications")
+        ("state_snapshot", po::value<std::string>(), "state snapshot file, which trie nodes are read from before the database")
+        ("block_freezer", po::value<std::string>(), "directory of the append-only files the data of the finalized blocks is moved to from the database")
+        ("block_freezer_compression", po::value<uint32_t>(), "zstd level (1-22) the data of the blocks is compressed with in the block freezer, with dictionaries trained on the blocks frozen first, 0 (default) keeps the data uncompressed")
+        ("trie_key_filter_size", po::value<size_t>(), "size in bytes of the in-memory filter answering lookups of absent storage keys, 0 disables the filter")
+        ("cache_budget", po::value<size_t>(), "total size in bytes of the trie node and the block header caches, shared between them by their hit rates instead of their own sizes, 0 (default) keeps the sizes of the caches")
+        ("flat_state", "keep the values of the storage apart from the trie, so that the runtime reads them without walking the trie, at the cost of the disk space of one more copy of the state")
+        ("state_prefetch_threads", po::value<size_t>(), "number of threads reading ahead the trie nodes of the keys a block is expected to access, known from the validation of its transactions and from the previous block, 0 disables the reading ahead")
+        ("transaction_pool_dump", po::value<std::string>(), "file the transaction pool is written to at the shutdown and is filled from, after the transactions are validated again, at the launch")
         ;
 
     po::options_description authority_desc("Authority options");
@@ -236,6 +452,18 @@ namespace kagome::application {
         ("rpc_http_port", po::value<uint16_t>(), "port for RPC over HTTP")
         ("rpc_ws_host", po::value<std::string>(), "address for RPC over Websocket protocol")
         ("rpc_ws_port", po::value<uint16_t>(), "port for RPC over Websocket protocol")
+        ("rpc_scale_port", po::value<uint16_t>(), "port for RPC in binary SCALE messages over Websocket protocol, at the address of RPC over Websocket, 0 by default, which disables it")
+        ("rpc_unix_socket", po::value<std::string>(), "path of the unix domain socket for RPC, which takes the requests and gives the responses as lines, for the clients on the same host, disabled by default")
+        ("rpc_scale_unix_socket", po::value<std::string>(), "path of the unix domain socket for RPC in binary SCALE messages, each prefixed with its length as 4 byte little endian number, disabled by default")
+        ("prometheus_host", po::value<std::string>(), "address the metrics are served at to Prometheus, 127.0.0.1 by default")
+        ("prometheus_port", po::value<uint16_t>(), "port the metrics are served at to Prometheus, 9615 by default, 0 disables them")
+        ("telemetry_url", po::value<std::vector<std::string>>()->composing(), "websocket url (ws://host:port/path) of an aggregator the stats of the node are sent to every 5 seconds, may be given several times, none by default")
+        ("rpc_max_request_size", po::value<size_t>(), "max size in bytes of an RPC request, of an HTTP body or of a websocket message, 15 MiB by default")
+        ("rpc_slow_call_threshold", po::value<uint32_t>(), "time in milliseconds, RPC calls taking longer than which are logged as slow ones, 1000 by default, 0 disables the logging")
+        ("process_profiles", po::value<std::string>(), "directory the CPU and the heap profiles of the node, started over RPC, are written to, the RPC is disabled if it is not set")
+        ("sync_bodies_batch_size", po::value<size_t>(), "number of the blocks the bodies of which are requested from one peer at once in a sync, once their headers are received and checked, 0 (default) requests the headers and the bodies together")
+        ("warp_sync", "sync a fresh node to the state of the latest block finalized by GRANDPA, verifying its justification, instead of importing the blocks from the genesis")
+        ("storage_read_threads_num", po::value<size_t>(), "number of the threads reading the storage to answer the sync and state requests of the peers, 2 by default")
         ;
 
     po::options_description additional_desc("Additional options");
@@ -286,9 +514,131 @@ namespace kagome::application {
     find_argument<std::string>(
         vm, "genesis", [&](std::string const &val) { genesis_path_ = val; });
 
+    find_argument<uint32_t>(
+        vm, "runtime_optimization_level", [&](uint32_t val) {
+          runtime_optimization_level_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "runtime_cache", [&](std::string const &val) {
+          runtime_cache_path_ = val;
+        });
+
+    find_argument<size_t>(vm, "runtime_instances_num", [&](size_t val) {
+      runtime_instances_num_ = val;
+    });
+
+    if (vm.end() != vm.find("runtime_profiling")) {
+      runtime_profiling_ = true;
+    }
+
+    find_argument<size_t>(vm, "offchain_workers_num", [&](size_t val) {
+      offchain_workers_num_ = val;
+    });
+
     find_argument<std::string>(
         vm, "leveldb", [&](std::string const &val) { leveldb_path_ = val; });
 
+    find_argument<std::string>(
+        vm, "leveldb_trie", [&](std::string const &val) {
+          leveldb_trie_path_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "leveldb_blocks", [&](std::string const &val) {
+          leveldb_blocks_path_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "storage_backend", [&](std::string const &val) {
+          set_storage_backend(val);
+        });
+
+    find_argument<size_t>(vm, "memory_storage_budget", [&](size_t val) {
+      memory_storage_budget_ = val;
+    });
+
+    find_argument<size_t>(vm, "leveldb_block_cache_size", [&](size_t val) {
+      leveldb_block_cache_size_ = val;
+    });
+
+    find_argument<uint32_t>(
+        vm, "leveldb_bloom_filter_bits", [&](uint32_t val) {
+          leveldb_bloom_filter_bits_ = val;
+        });
+
+    find_argument<size_t>(vm, "leveldb_write_buffer_size", [&](size_t val) {
+      leveldb_write_buffer_size_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "leveldb_max_open_files", [&](uint32_t val) {
+      leveldb_max_open_files_ = val;
+    });
+
+    if (vm.end() != vm.find("leveldb_group_commit")) {
+      leveldb_group_commit_ = true;
+    }
+
+    find_argument<size_t>(vm, "trie_node_cache_size", [&](size_t val) {
+      trie_node_cache_size_ = val;
+    });
+
+    find_argument<size_t>(vm, "trie_large_value_threshold", [&](size_t val) {
+      trie_large_value_threshold_ = val;
+    });
+
+    find_argument<size_t>(vm, "block_header_cache_size", [&](size_t val) {
+      block_header_cache_size_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "state_pruning_depth", [&](uint32_t val) {
+      state_pruning_depth_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "blocks_pruning_depth", [&](uint32_t val) {
+      blocks_pruning_depth_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "justification_period", [&](uint32_t val) {
+      justification_period_ = val;
+    });
+
+    find_argument<std::string>(
+        vm, "state_snapshot", [&](std::string const &val) {
+          state_snapshot_path_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "block_freezer", [&](std::string const &val) {
+          block_freezer_path_ = val;
+        });
+
+    find_argument<uint32_t>(
+        vm, "block_freezer_compression", [&](uint32_t val) {
+          block_freezer_compression_ = val;
+        });
+
+    find_argument<size_t>(vm, "trie_key_filter_size", [&](size_t val) {
+      trie_key_filter_size_ = val;
+    });
+
+    find_argument<size_t>(vm, "cache_budget", [&](size_t val) {
+      cache_budget_ = val;
+    });
+
+    if (vm.end() != vm.find("flat_state")) {
+      flat_state_ = true;
+    }
+
+    find_argument<size_t>(vm, "state_prefetch_threads", [&](size_t val) {
+      state_prefetch_threads_ = val;
+    });
+
+    find_argument<std::string>(
+        vm, "transaction_pool_dump", [&](std::string const &val) {
+          transaction_pool_dump_path_ = val;
+        });
+
     find_argument<std::string>(
         vm, "keystore", [&](std::string const &val) { keystore_path_ = val; });
 
@@ -314,8 +664,68 @@ namespace kagome::application {
     find_argument<uint16_t>(
         vm, "rpc_ws_port", [&](uint16_t val) { rpc_ws_port_ = val; });
 
+    find_argument<uint16_t>(
+        vm, "rpc_scale_port", [&](uint16_t val) { rpc_scale_port_ = val; });
+
+    find_argument<std::string>(
+        vm, "rpc_unix_socket", [&](std::string const &val) {
+          rpc_unix_socket_path_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "rpc_scale_unix_socket", [&](std::string const &val) {
+          rpc_scale_unix_socket_path_ = val;
+        });
+
+    find_argument<std::string>(
+        vm, "prometheus_host", [&](std::string const &val) {
+          prometheus_host_ = val;
+        });
+
+    find_argument<uint16_t>(
+        vm, "prometheus_port", [&](uint16_t val) { prometheus_port_ = val; });
+
+    find_argument<std::vector<std::string>>(
+        vm, "telemetry_url", [&](std::vector<std::string> const &val) {
+          telemetry_urls_ = val;
+        });
+
+    find_argument<size_t>(vm, "rpc_max_request_size", [&](size_t val) {
+      rpc_max_request_size_ = val;
+    });
+
+    find_argument<uint32_t>(vm, "rpc_slow_call_threshold", [&](uint32_t val) {
+      rpc_slow_call_threshold_ = val;
+    });
+
+    find_argument<std::string>(
+        vm, "process_profiles", [&](std::string const &val) {
+          process_profiles_path_ = val;
+        });
+
+    find_argument<size_t>(vm, "sync_bodies_batch_size", [&](size_t val) {
+      sync_bodies_batch_size_ = val;
+    });
+
+    if (vm.end() != vm.find("warp_sync")) {
+      warp_sync_ = true;
+    }
+
+    find_argument<size_t>(vm, "storage_read_threads_num", [&](size_t val) {
+      storage_read_threads_num_ = val;
+    });
+
     rpc_http_endpoint_ = get_endpoint_from(rpc_http_host_, rpc_http_port_);
     rpc_ws_endpoint_ = get_endpoint_from(rpc_ws_host_, rpc_ws_port_);
+    rpc_scale_endpoint_.reset();
+    if (rpc_scale_port_ != 0) {
+      rpc_scale_endpoint_ = get_endpoint_from(rpc_ws_host_, rpc_scale_port_);
+    }
+    prometheus_endpoint_.reset();
+    if (prometheus_port_ != 0) {
+      prometheus_endpoint_ =
+          get_endpoint_from(prometheus_host_, prometheus_port_);
+    }
     validate_config(scheme);
     return true;
   }
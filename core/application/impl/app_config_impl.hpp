@@ -75,6 +75,9 @@ namespace kagome::application {
     std::string rpc_ws_host_;
     uint16_t rpc_http_port_;
     uint16_t rpc_ws_port_;
+    uint16_t rpc_scale_port_;
+    std::string prometheus_host_;
+    uint16_t prometheus_port_;
 
     // clang-format off
     /*
@@ -96,8 +99,14 @@ namespace kagome::application {
     bool load_u16(const rapidjson::Value &val,
                   char const *name,
                   uint16_t &target);
+    bool load_u64(const rapidjson::Value &val,
+                  char const *name,
+                  uint64_t &target);
     bool load_bool(const rapidjson::Value &val, char const *name, bool &target);
 
+    /// sets storage backend by its name, unknown names are only reported
+    void set_storage_backend(const std::string &name);
+
     boost::asio::ip::tcp::endpoint get_endpoint_from(const std::string &host,
                                                      uint16_t port);
     FilePtr open_file(const std::string &filepath);
@@ -117,11 +126,52 @@ namespace kagome::application {
                               char **argv);
 
     DECLARE_PROPERTY(std::string, genesis_path);
+    DECLARE_PROPERTY(uint32_t, runtime_optimization_level);
+    DECLARE_PROPERTY(std::string, runtime_cache_path);
+    DECLARE_PROPERTY(size_t, runtime_instances_num);
+    DECLARE_PROPERTY(bool, runtime_profiling);
+    DECLARE_PROPERTY(size_t, offchain_workers_num);
     DECLARE_PROPERTY(std::string, keystore_path);
     DECLARE_PROPERTY(std::string, leveldb_path);
+    DECLARE_PROPERTY(std::string, leveldb_trie_path);
+    DECLARE_PROPERTY(std::string, leveldb_blocks_path);
+    DECLARE_PROPERTY(StorageBackend, storage_backend);
+    DECLARE_PROPERTY(size_t, memory_storage_budget);
+    DECLARE_PROPERTY(size_t, leveldb_block_cache_size);
+    DECLARE_PROPERTY(uint32_t, leveldb_bloom_filter_bits);
+    DECLARE_PROPERTY(size_t, leveldb_write_buffer_size);
+    DECLARE_PROPERTY(uint32_t, leveldb_max_open_files);
+    DECLARE_PROPERTY(bool, leveldb_group_commit);
+    DECLARE_PROPERTY(size_t, trie_node_cache_size);
+    DECLARE_PROPERTY(size_t, trie_large_value_threshold);
+    DECLARE_PROPERTY(size_t, block_header_cache_size);
+    DECLARE_PROPERTY(uint32_t, state_pruning_depth);
+    DECLARE_PROPERTY(uint32_t, blocks_pruning_depth);
+    DECLARE_PROPERTY(uint32_t, justification_period);
+    DECLARE_PROPERTY(std::string, state_snapshot_path);
+    DECLARE_PROPERTY(std::string, block_freezer_path);
+    DECLARE_PROPERTY(uint32_t, block_freezer_compression);
+    DECLARE_PROPERTY(size_t, trie_key_filter_size);
+    DECLARE_PROPERTY(size_t, cache_budget);
+    DECLARE_PROPERTY(bool, flat_state);
+    DECLARE_PROPERTY(size_t, state_prefetch_threads);
+    DECLARE_PROPERTY(std::string, transaction_pool_dump_path);
     DECLARE_PROPERTY(uint16_t, p2p_port);
+    DECLARE_PROPERTY(size_t, sync_bodies_batch_size);
+    DECLARE_PROPERTY(size_t, rpc_max_request_size);
+    DECLARE_PROPERTY(uint32_t, rpc_slow_call_threshold);
+    DECLARE_PROPERTY(std::string, process_profiles_path);
+    DECLARE_PROPERTY(bool, warp_sync);
+    DECLARE_PROPERTY(size_t, storage_read_threads_num);
     DECLARE_PROPERTY(boost::asio::ip::tcp::endpoint, rpc_http_endpoint);
     DECLARE_PROPERTY(boost::asio::ip::tcp::endpoint, rpc_ws_endpoint);
+    DECLARE_PROPERTY(boost::optional<boost::asio::ip::tcp::endpoint>,
+                     rpc_scale_endpoint);
+    DECLARE_PROPERTY(std::string, rpc_unix_socket_path);
+    DECLARE_PROPERTY(std::string, rpc_scale_unix_socket_path);
+    DECLARE_PROPERTY(boost::optional<boost::asio::ip::tcp::endpoint>,
+                     prometheus_endpoint);
+    DECLARE_PROPERTY(std::vector<std::string>, telemetry_urls);
     DECLARE_PROPERTY(spdlog::level::level_enum, verbosity);
     DECLARE_PROPERTY(bool, is_only_finalizing);
   };
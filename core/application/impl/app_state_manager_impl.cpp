@@ -6,7 +6,9 @@
 #include "application/impl/app_state_manager_impl.hpp"
 
 #include <csignal>
+#include <deque>
 #include <functional>
+#include <thread>
 
 namespace kagome::application {
 
@@ -52,7 +54,8 @@ namespace kagome::application {
 
   void AppStateManagerImpl::reset() {
     std::lock_guard lg(mutex_);
-    while (!prepare_.empty()) prepare_.pop();
+    prepare_.clear();
+    last_sequential_prepare_.reset();
     while (!launch_.empty()) launch_.pop();
     while (!shutdown_.empty()) shutdown_.pop();
     state_ = State::Init;
@@ -61,10 +64,29 @@ namespace kagome::application {
 
   void AppStateManagerImpl::atPrepare(Callback &&cb) {
     std::lock_guard lg(mutex_);
+    std::vector<PrepareId> dependencies;
+    if (last_sequential_prepare_) {
+      dependencies.push_back(*last_sequential_prepare_);
+    }
+    last_sequential_prepare_ =
+        atPrepare(std::move(cb), std::move(dependencies));
+  }
+
+  AppStateManager::PrepareId AppStateManagerImpl::atPrepare(
+      Callback &&cb, std::vector<PrepareId> dependencies) {
+    std::lock_guard lg(mutex_);
     if (state_ > State::Init) {
       throw AppStateException("adding callback for stage 'prepare'");
     }
-    prepare_.emplace(std::move(cb));
+    PrepareId id = prepare_.size();
+    // the dependencies are added before, so there are no cycles
+    for (auto dependency : dependencies) {
+      if (dependency >= id) {
+        throw AppStateException("depending on unknown callback of 'prepare'");
+      }
+    }
+    prepare_.push_back(PrepareCallback{std::move(cb), std::move(dependencies)});
+    return id;
   }
 
   void AppStateManagerImpl::atLaunch(Callback &&cb) {
@@ -83,19 +105,90 @@ namespace kagome::application {
     shutdown_.emplace(std::move(cb));
   }
 
+  std::exception_ptr AppStateManagerImpl::runPrepare(
+      std::vector<PrepareCallback> &callbacks, size_t threads_num) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    // numbers of the dependencies not done yet, and the dependents
+    std::vector<size_t> pending(callbacks.size());
+    std::vector<std::vector<PrepareId>> dependents(callbacks.size());
+    std::deque<PrepareId> ready;
+    for (PrepareId id = 0; id < callbacks.size(); ++id) {
+      pending[id] = callbacks[id].dependencies.size();
+      for (auto dependency : callbacks[id].dependencies) {
+        dependents[dependency].push_back(id);
+      }
+      if (pending[id] == 0) {
+        ready.push_back(id);
+      }
+    }
+    size_t done = 0;
+    std::exception_ptr error;
+
+    auto work = [&] {
+      std::unique_lock lock(mutex);
+      while (true) {
+        cv.wait(lock, [&] {
+          return not ready.empty() or done == callbacks.size() or error;
+        });
+        if (done == callbacks.size() or error) {
+          return;
+        }
+        auto id = ready.front();
+        ready.pop_front();
+        lock.unlock();
+        try {
+          callbacks[id].cb();
+        } catch (...) {
+          lock.lock();
+          error = std::current_exception();
+          cv.notify_all();
+          return;
+        }
+        lock.lock();
+        ++done;
+        for (auto dependent : dependents[id]) {
+          if (--pending[dependent] == 0) {
+            ready.push_back(dependent);
+          }
+        }
+        cv.notify_all();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_num; ++i) {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return error;
+  }
+
   void AppStateManagerImpl::doPrepare() {
-    std::lock_guard lg(mutex_);
+    std::unique_lock lock(mutex_);
     if (state_ != State::Init) {
       throw AppStateException("running stage 'prepare'");
     }
     state_ = State::Prepare;
 
-    while (!prepare_.empty()) {
-      auto &cb = prepare_.front();
-      if (state_ == State::Prepare) {
-        cb();
-      }
-      prepare_.pop();
+    auto callbacks = std::move(prepare_);
+    prepare_.clear();
+    last_sequential_prepare_.reset();
+    // the callbacks run on the other threads may add the ones of the other
+    // stages
+    lock.unlock();
+    auto threads_num = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u), callbacks.size());
+    logger_->debug("Preparing with {} callbacks on {} threads",
+                   callbacks.size(),
+                   threads_num);
+    auto error = runPrepare(callbacks, threads_num);
+    lock.lock();
+    if (error) {
+      std::rethrow_exception(error);
     }
 
     if (state_ == State::Prepare) {
@@ -133,7 +226,8 @@ namespace kagome::application {
       return;
     }
 
-    while (!prepare_.empty()) prepare_.pop();
+    prepare_.clear();
+    last_sequential_prepare_.reset();
 
     while (!launch_.empty()) launch_.pop();
 
@@ -12,6 +12,9 @@
 #include <csignal>
 #include <mutex>
 #include <queue>
+#include <vector>
+
+#include <boost/optional.hpp>
 
 #include "common/logger.hpp"
 
@@ -29,6 +32,8 @@ namespace kagome::application {
     AppStateManagerImpl &operator=(AppStateManagerImpl &&) noexcept = delete;
 
     void atPrepare(Callback &&cb) override;
+    PrepareId atPrepare(Callback &&cb,
+                        std::vector<PrepareId> dependencies) override;
     void atLaunch(Callback &&cb) override;
     void atShutdown(Callback &&cb) override;
 
@@ -47,6 +52,20 @@ namespace kagome::application {
     void doShutdown() override;
 
    private:
+    struct PrepareCallback {
+      Callback cb;
+      std::vector<PrepareId> dependencies;
+    };
+
+    /**
+     * Runs \arg callbacks of the stage 'prepare', each once its dependencies
+     * are done, on up to \arg threads_num threads, the calling one included
+     * @return the exception of the first callback, which failed, the
+     * callbacks not started by then are skipped
+     */
+    static std::exception_ptr runPrepare(
+        std::vector<PrepareCallback> &callbacks, size_t threads_num);
+
     static std::weak_ptr<AppStateManager> wp_to_myself;
     static void shuttingDownSignalsHandler(int);
 
@@ -59,7 +78,10 @@ namespace kagome::application {
     std::mutex cv_mutex_;
     std::condition_variable cv_;
 
-    std::queue<std::function<void()>> prepare_;
+    // indexed by the ids of the callbacks
+    std::vector<PrepareCallback> prepare_;
+    // the last one of the callbacks run one after another
+    boost::optional<PrepareId> last_sequential_prepare_;
     std::queue<std::function<void()>> launch_;
     std::queue<std::function<void()>> shutdown_;
 
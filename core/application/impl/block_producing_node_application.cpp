@@ -25,6 +25,9 @@ namespace kagome::application {
     router_ = injector_.create<sptr<network::Router>>();
 
     jrpc_api_service_ = injector_.create<sptr<api::ApiService>>();
+    metrics_listener_ = injector_.create<sptr<api::MetricsListener>>();
+    telemetry_client_ = injector_.create<sptr<telemetry::TelemetryClient>>();
+    scale_rpc_service_ = injector_.create<sptr<api::ScaleRpcService>>();
   }
 
   void BlockProducingNodeApplication::run() {
@@ -5,17 +5,167 @@
 
 #include "application/impl/configuration_storage_impl.hpp"
 
-#include <boost/property_tree/json_parser.hpp>
+#include <cstdio>
+
 #include <libp2p/multi/multiaddress.hpp>
+#include <rapidjson/error/en.h>
+#include <rapidjson/filereadstream.h>
+#include <rapidjson/reader.h>
 
 #include "application/impl/config_reader/error.hpp"
 #include "application/impl/config_reader/pt_util.hpp"
 #include "common/hexutil.hpp"
 
+namespace {
+  using kagome::application::ConfigurationStorage;
+
+  /// size of the chunks the config is read in
+  constexpr size_t kReadBufferSize = 64 * 1024;
+
+  /// unhexes \arg hex, which starts with 0x, into \arg out
+  outcome::result<void> unhexWith0x(std::string_view hex,
+                                    std::vector<uint8_t> &out) {
+    if (hex.substr(0, 2) != "0x") {
+      return kagome::common::UnhexError::MISSING_0X_PREFIX;
+    }
+    hex.remove_prefix(2);
+    out.resize(hex.size() / 2);
+    return kagome::common::unhex(hex, out);
+  }
+
+  /**
+   * Handler of the reader of the config, which follows the path to the value
+   * being read, so as to tell the entries of the genesis state, which are at
+   * genesis.raw.top (v0.7) or at genesis.raw[0] (v0.6), and the boot nodes
+   * from the rest of it
+   */
+  class ConfigHandler
+      : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ConfigHandler> {
+   public:
+    ConfigHandler(const ConfigurationStorage::GenesisVisitor *visitor,
+                  std::vector<std::string> *boot_nodes)
+        : visitor_{visitor}, boot_nodes_{boot_nodes} {}
+
+    bool StartObject() {
+      if (levels_.size() == 3 and isTopPath()) {
+        found_top_ = true;
+      }
+      levels_.push_back(Level{false, 0, {}});
+      return true;
+    }
+
+    bool Key(const char *str, rapidjson::SizeType length, bool) {
+      levels_.back().key.assign(str, length);
+      return true;
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+      levels_.pop_back();
+      return endValue();
+    }
+
+    bool StartArray() {
+      if (levels_.size() == 1 and levels_[0].key == "bootNodes") {
+        found_boot_nodes_ = true;
+      }
+      levels_.push_back(Level{true, 0, {}});
+      return true;
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+      levels_.pop_back();
+      return endValue();
+    }
+
+    bool String(const char *str, rapidjson::SizeType length, bool) {
+      std::string_view value{str, length};
+      if (visitor_ != nullptr and levels_.size() == 4 and isTopPath()
+          and not levels_[3].is_array) {
+        if (auto res = visit(value); not res) {
+          error_ = res.error();
+          return false;
+        }
+      } else if (boot_nodes_ != nullptr and levels_.size() == 2
+                 and levels_[0].key == "bootNodes" and levels_[1].is_array) {
+        boot_nodes_->emplace_back(value);
+      }
+      return endValue();
+    }
+
+    // the numbers, the booleans and the nulls
+    bool Default() {
+      return endValue();
+    }
+
+    /// the error of the visitor, which stopped the reading
+    const std::error_code &error() const {
+      return error_;
+    }
+
+    bool foundTop() const {
+      return found_top_;
+    }
+
+    bool foundBootNodes() const {
+      return found_boot_nodes_;
+    }
+
+   private:
+    // an object, which key is the one of its member being read, or an array,
+    // which index is the one of its element being read
+    struct Level {
+      bool is_array;
+      size_t index;
+      std::string key;
+    };
+
+    bool isTopPath() const {
+      return levels_[0].key == "genesis" and not levels_[1].is_array
+             and levels_[1].key == "raw"
+             and (levels_[2].is_array ? levels_[2].index == 0
+                                      : levels_[2].key == "top");
+    }
+
+    bool endValue() {
+      if (not levels_.empty() and levels_.back().is_array) {
+        ++levels_.back().index;
+      }
+      return true;
+    }
+
+    outcome::result<void> visit(std::string_view value) {
+      OUTCOME_TRY(unhexWith0x(levels_[3].key, key_));
+      OUTCOME_TRY(unhexWith0x(value, value_));
+      return (*visitor_)(key_, value_);
+    }
+
+    const ConfigurationStorage::GenesisVisitor *visitor_;
+    std::vector<std::string> *boot_nodes_;
+    std::vector<Level> levels_;
+    // the unhexed entry, the buffers are reused for all of them
+    std::vector<uint8_t> key_;
+    std::vector<uint8_t> value_;
+    std::error_code error_;
+    bool found_top_ = false;
+    bool found_boot_nodes_ = false;
+  };
+}  // namespace
+
 namespace kagome::application {
 
-  GenesisRawConfig ConfigurationStorageImpl::getGenesis() const {
-    return genesis_;
+  outcome::result<GenesisRawConfig> ConfigurationStorageImpl::getGenesis()
+      const {
+    GenesisRawConfig genesis;
+    OUTCOME_TRY(visitGenesis([&](auto key, auto value) {
+      genesis.emplace_back(common::Buffer{key}, common::Buffer{value});
+      return outcome::success();
+    }));
+    return genesis;
+  }
+
+  outcome::result<void> ConfigurationStorageImpl::visitGenesis(
+      const GenesisVisitor &visitor) const {
+    return readJson(&visitor, nullptr);
   }
 
   network::PeerList ConfigurationStorageImpl::getBootNodes() const {
@@ -26,59 +176,50 @@ namespace kagome::application {
   ConfigurationStorageImpl::create(const std::string &path) {
     auto config_storage =
         std::make_shared<ConfigurationStorageImpl>(ConfigurationStorageImpl());
-    OUTCOME_TRY(config_storage->loadFromJson(path));
+    config_storage->config_path_ = path;
+    // the genesis state is read when it is needed, which is once
+    std::vector<std::string> boot_nodes;
+    OUTCOME_TRY(config_storage->readJson(nullptr, &boot_nodes));
+    OUTCOME_TRY(config_storage->loadBootNodes(boot_nodes));
 
     return config_storage;
   }
 
-  namespace pt = boost::property_tree;
-
-  outcome::result<void> ConfigurationStorageImpl::loadFromJson(
-      const std::string &file_path) {
-    pt::ptree tree;
-    try {
-      pt::read_json(file_path, tree);
-    } catch (pt::json_parser_error &e) {
-      spdlog::error("Parser error: {}, line {}: {}", e.filename(), e.line(), e.message());
+  outcome::result<void> ConfigurationStorageImpl::readJson(
+      const GenesisVisitor *visitor,
+      std::vector<std::string> *boot_nodes) const {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
+        std::fopen(config_path_.c_str(), "r"), &std::fclose};
+    if (file == nullptr) {
+      spdlog::error("Config file {} could not be opened", config_path_);
       return ConfigReaderError::PARSER_ERROR;
     }
-
-    OUTCOME_TRY(loadGenesis(tree));
-    OUTCOME_TRY(loadBootNodes(tree));
-    return outcome::success();
-  }
-
-  outcome::result<void> ConfigurationStorageImpl::loadGenesis(
-      const boost::property_tree::ptree &tree) {
-    OUTCOME_TRY(genesis_tree, ensure(tree.get_child_optional("genesis")));
-    OUTCOME_TRY(genesis_raw_tree,
-                ensure(genesis_tree.get_child_optional("raw")));
-    boost::property_tree::ptree top_tree;
-    // v0.7 format
-    if(auto top_tree_opt = genesis_raw_tree.get_child_optional("top"); top_tree_opt.has_value()) {
-      top_tree = top_tree_opt.value();
-    } else {
-      // Try to fall back to v0.6
-      top_tree = genesis_raw_tree.begin()->second;
-    }
-
-    for (const auto &[key, value] : top_tree) {
-      // get rid of leading 0x for key and value and unhex
-      OUTCOME_TRY(key_processed, common::unhexWith0x(key));
-      OUTCOME_TRY(value_processed, common::unhexWith0x(value.data()));
-      genesis_.emplace_back(key_processed, value_processed);
+    std::vector<char> buffer(kReadBufferSize);
+    rapidjson::FileReadStream stream{file.get(), buffer.data(), buffer.size()};
+    ConfigHandler handler{visitor, boot_nodes};
+    rapidjson::Reader reader;
+    if (auto res = reader.Parse(stream, handler); res.IsError()) {
+      if (handler.error()) {
+        return outcome::failure(handler.error());
+      }
+      spdlog::error("Parser error: {}, offset {}: {}",
+                    config_path_,
+                    res.Offset(),
+                    rapidjson::GetParseError_En(res.Code()));
+      return ConfigReaderError::PARSER_ERROR;
+    }
+    if (not handler.foundTop()
+        or (boot_nodes != nullptr and not handler.foundBootNodes())) {
+      return ConfigReaderError::MISSING_ENTRY;
     }
     // ignore child storages as they are not yet implemented
-
     return outcome::success();
   }
 
   outcome::result<void> ConfigurationStorageImpl::loadBootNodes(
-      const boost::property_tree::ptree &tree) {
-    OUTCOME_TRY(boot_nodes, ensure(tree.get_child_optional("bootNodes")));
-    for (auto &v : boot_nodes) {
-      OUTCOME_TRY(multiaddr,
-                  libp2p::multi::Multiaddress::create(v.second.data()));
+      const std::vector<std::string> &boot_nodes) {
+    for (auto &address : boot_nodes) {
+      OUTCOME_TRY(multiaddr, libp2p::multi::Multiaddress::create(address));
       OUTCOME_TRY(peer_id_base58, ensure(multiaddr.getPeerId()));
 
       OUTCOME_TRY(peer_id, libp2p::peer::PeerId::fromBase58(peer_id_base58));
@@ -8,8 +8,6 @@
 
 #include "application/configuration_storage.hpp"
 
-#include <boost/property_tree/ptree.hpp>
-
 namespace kagome::application {
 
   class ConfigurationStorageImpl : public ConfigurationStorage {
@@ -19,20 +17,27 @@ namespace kagome::application {
 
     ~ConfigurationStorageImpl() override = default;
 
-    GenesisRawConfig getGenesis() const override;
+    outcome::result<GenesisRawConfig> getGenesis() const override;
+    outcome::result<void> visitGenesis(
+        const GenesisVisitor &visitor) const override;
     network::PeerList getBootNodes() const override;
 
    private:
-    outcome::result<void> loadFromJson(const std::string &file_path);
-    outcome::result<void> loadGenesis(const boost::property_tree::ptree &tree);
+    /**
+     * Reads the config, which is streamed rather than loaded whole, as the
+     * genesis state in it takes tens of megabytes
+     * @param visitor if set, is called for the entries of the genesis state
+     * @param boot_nodes if set, the boot nodes are added to it
+     */
+    outcome::result<void> readJson(
+        const GenesisVisitor *visitor,
+        std::vector<std::string> *boot_nodes) const;
     outcome::result<void> loadBootNodes(
-        const boost::property_tree::ptree &tree);
-    outcome::result<void> loadSessionKeys(
-        const boost::property_tree::ptree &tree);
+        const std::vector<std::string> &boot_nodes);
 
     ConfigurationStorageImpl() = default;
 
-    GenesisRawConfig genesis_;
+    std::string config_path_;
     network::PeerList boot_nodes_;
     std::vector<crypto::SR25519PublicKey> session_keys_;
   };
@@ -63,6 +63,12 @@ namespace kagome::application {
     sptr<network::Router> router_;
 
     sptr<api::ApiService> jrpc_api_service_;
+    // none if the metrics are not served
+    sptr<api::MetricsListener> metrics_listener_;
+    // none if the telemetry is not sent
+    sptr<telemetry::TelemetryClient> telemetry_client_;
+    // none if the SCALE RPC is disabled
+    sptr<api::ScaleRpcService> scale_rpc_service_;
 
     Babe::ExecutionStrategy is_genesis_;
 
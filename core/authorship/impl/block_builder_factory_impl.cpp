@@ -12,14 +12,17 @@ namespace kagome::authorship {
   BlockBuilderFactoryImpl::BlockBuilderFactoryImpl(
       std::shared_ptr<runtime::Core> r_core,
       std::shared_ptr<runtime::BlockBuilder> r_block_builder,
-      std::shared_ptr<blockchain::BlockHeaderRepository> header_backend)
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_backend,
+      std::shared_ptr<runtime::TrieStorageProvider> storage_provider)
       : r_core_(std::move(r_core)),
         r_block_builder_(std::move(r_block_builder)),
         header_backend_(std::move(header_backend)),
+        storage_provider_(std::move(storage_provider)),
         logger_{common::createLogger("BlockBuilderFactory")} {
     BOOST_ASSERT(r_core_ != nullptr);
     BOOST_ASSERT(r_block_builder_ != nullptr);
     BOOST_ASSERT(header_backend_ != nullptr);
+    BOOST_ASSERT(storage_provider_ != nullptr);
   }
 
   outcome::result<std::unique_ptr<BlockBuilder>>
@@ -42,7 +45,8 @@ namespace kagome::authorship {
                      res.error().message());
       return res.error();
     }
-    return std::make_unique<BlockBuilderImpl>(header, r_block_builder_);
+    return std::make_unique<BlockBuilderImpl>(
+        header, r_block_builder_, storage_provider_);
   }
 
 }  // namespace kagome::authorship
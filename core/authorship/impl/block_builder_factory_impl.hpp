@@ -10,6 +10,7 @@
 
 #include "blockchain/block_header_repository.hpp"
 #include "common/logger.hpp"
+#include "runtime/trie_storage_provider.hpp"
 
 namespace kagome::authorship {
 
@@ -20,7 +21,8 @@ namespace kagome::authorship {
     BlockBuilderFactoryImpl(
         std::shared_ptr<runtime::Core> r_core,
         std::shared_ptr<runtime::BlockBuilder> r_block_builder,
-        std::shared_ptr<blockchain::BlockHeaderRepository> header_backend);
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_backend,
+        std::shared_ptr<runtime::TrieStorageProvider> storage_provider);
 
     outcome::result<std::unique_ptr<BlockBuilder>> create(
         const kagome::primitives::BlockId &parent_id,
@@ -30,6 +32,7 @@ namespace kagome::authorship {
     std::shared_ptr<runtime::Core> r_core_;
     std::shared_ptr<runtime::BlockBuilder> r_block_builder_;
     std::shared_ptr<blockchain::BlockHeaderRepository> header_backend_;
+    std::shared_ptr<runtime::TrieStorageProvider> storage_provider_;
     common::Logger logger_;
   };
 
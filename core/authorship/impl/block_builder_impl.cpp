@@ -11,21 +11,45 @@ namespace kagome::authorship {
 
   BlockBuilderImpl::BlockBuilderImpl(
       primitives::BlockHeader block_header,
-      std::shared_ptr<runtime::BlockBuilder> r_block_builder)
+      std::shared_ptr<runtime::BlockBuilder> r_block_builder,
+      std::shared_ptr<runtime::TrieStorageProvider> storage_provider)
       : block_header_(std::move(block_header)),
         r_block_builder_(std::move(r_block_builder)),
+        storage_provider_(std::move(storage_provider)),
         logger_{common::createLogger("BlockBuilder")} {
     BOOST_ASSERT(r_block_builder_ != nullptr);
+    BOOST_ASSERT(storage_provider_ != nullptr);
+  }
+
+  BlockBuilderImpl::~BlockBuilderImpl() {
+    releaseEnvironment();
   }
 
   outcome::result<void> BlockBuilderImpl::pushExtrinsic(
       const primitives::Extrinsic &extrinsic) {
+    if (not environment_held_) {
+      OUTCOME_TRY(r_block_builder_->holdEnvironment());
+      environment_held_ = true;
+    }
+    OUTCOME_TRY(storage_provider_->startTransaction());
+    auto res = applyExtrinsic(extrinsic);
+    if (not res) {
+      OUTCOME_TRY(storage_provider_->rollbackTransaction());
+      return res;
+    }
+    OUTCOME_TRY(storage_provider_->commitTransaction());
+    extrinsics_.push_back(extrinsic);
+    return outcome::success();
+  }
+
+  outcome::result<void> BlockBuilderImpl::applyExtrinsic(
+      const primitives::Extrinsic &extrinsic) {
     auto apply_res = r_block_builder_->apply_extrinsic(extrinsic);
     if (not apply_res) {
       logger_->warn(
           "Extrinsic {} was not pushed to block. Error during xt application: "
           "{}",
-          extrinsic.data.toHex(),
+          extrinsic.data,
           apply_res.error().message());
       return apply_res.error();
     }
@@ -39,22 +63,33 @@ namespace kagome::authorship {
             primitives::ApplyOutcome apply_outcome) -> outcome::result<void> {
           switch (apply_outcome) {
             case primitives::ApplyOutcome::SUCCESS:
-              extrinsics_.push_back(extrinsic);
               return outcome::success();
             case primitives::ApplyOutcome::FAIL:
-              logger_->warn(logger_error_template, extrinsic.data.toHex());
+              logger_->warn(logger_error_template, extrinsic.data);
               return BlockBuilderError::EXTRINSIC_APPLICATION_FAILED;
           }
         },
         [this, &extrinsic](primitives::ApplyError) -> outcome::result<void> {
-          logger_->warn(logger_error_template, extrinsic.data.toHex());
+          logger_->warn(logger_error_template, extrinsic.data);
           return BlockBuilderError::EXTRINSIC_APPLICATION_FAILED;
         });
   }
 
   outcome::result<primitives::Block> BlockBuilderImpl::bake() const {
-    OUTCOME_TRY(finalised_header, r_block_builder_->finalise_block());
-    return primitives::Block{finalised_header, extrinsics_};
+    auto finalised_header = r_block_builder_->finalise_block();
+    releaseEnvironment();
+    if (not finalised_header) {
+      return finalised_header.error();
+    }
+    return primitives::Block{std::move(finalised_header.value()),
+                             extrinsics_};
+  }
+
+  void BlockBuilderImpl::releaseEnvironment() const {
+    if (environment_held_) {
+      r_block_builder_->releaseEnvironment();
+      environment_held_ = false;
+    }
   }
 
 }  // namespace kagome::authorship
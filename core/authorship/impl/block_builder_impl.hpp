@@ -12,27 +12,47 @@
 #include "primitives/block_id.hpp"
 #include "runtime/block_builder.hpp"
 #include "runtime/core.hpp"
+#include "runtime/trie_storage_provider.hpp"
 
 namespace kagome::authorship {
 
   class BlockBuilderImpl : public BlockBuilder {
    public:
-    ~BlockBuilderImpl() override = default;
-
-    BlockBuilderImpl(primitives::BlockHeader block_header,
-                     std::shared_ptr<runtime::BlockBuilder> r_block_builder);
-
+    /**
+     * Releases the runtime environment, if the block is not baked
+     */
+    ~BlockBuilderImpl() override;
+
+    BlockBuilderImpl(
+        primitives::BlockHeader block_header,
+        std::shared_ptr<runtime::BlockBuilder> r_block_builder,
+        std::shared_ptr<runtime::TrieStorageProvider> storage_provider);
+
+    /**
+     * Applies the extrinsic in a storage transaction, so that the changes of
+     * an extrinsic, which fails, are discarded without affecting the changes
+     * of the extrinsics pushed before. The runtime environment is held from
+     * the first extrinsic until the block is baked
+     */
     outcome::result<void> pushExtrinsic(
         const primitives::Extrinsic &extrinsic) override;
 
     outcome::result<primitives::Block> bake() const override;
 
    private:
+    outcome::result<void> applyExtrinsic(
+        const primitives::Extrinsic &extrinsic);
+
+    void releaseEnvironment() const;
+
     primitives::BlockHeader block_header_;
     std::shared_ptr<runtime::BlockBuilder> r_block_builder_;
+    std::shared_ptr<runtime::TrieStorageProvider> storage_provider_;
     common::Logger logger_;
 
     std::vector<primitives::Extrinsic> extrinsics_{};
+    // the runtime environment is released by bake(), which is const
+    mutable bool environment_held_ = false;
   };
 
 }  // namespace kagome::authorship
@@ -10,19 +10,23 @@ namespace kagome::authorship {
   ProposerImpl::ProposerImpl(
       std::shared_ptr<BlockBuilderFactory> block_builder_factory,
       std::shared_ptr<transaction_pool::TransactionPool> transaction_pool,
-      std::shared_ptr<runtime::BlockBuilder> r_block_builder)
+      std::shared_ptr<runtime::BlockBuilder> r_block_builder,
+      std::shared_ptr<clock::SystemClock> clock)
       : block_builder_factory_{std::move(block_builder_factory)},
         transaction_pool_{std::move(transaction_pool)},
-        r_block_builder_{std::move(r_block_builder)} {
+        r_block_builder_{std::move(r_block_builder)},
+        clock_{std::move(clock)} {
     BOOST_ASSERT(block_builder_factory_);
     BOOST_ASSERT(transaction_pool_);
     BOOST_ASSERT(r_block_builder_);
+    BOOST_ASSERT(clock_);
   }
 
   outcome::result<primitives::Block> ProposerImpl::propose(
       const primitives::BlockId &parent_block_id,
       const primitives::InherentData &inherent_data,
-      const primitives::Digest &inherent_digest) {
+      const primitives::Digest &inherent_digest,
+      clock::SystemClock::TimePoint deadline) {
     OUTCOME_TRY(
         block_builder,
         block_builder_factory_->create(parent_block_id, inherent_digest));
@@ -39,39 +43,74 @@ namespace kagome::authorship {
     auto log_push_error = [this](const primitives::Extrinsic &xt,
                                  std::string_view message) {
       logger_->warn("Extrinsic {} was not added to the block. Reason: {}",
-                    xt.data.toHex(),
+                    xt.data,
                     message);
     };
 
+    // the length prefix of an extrinsic takes up to 5 bytes
+    auto encoded_size = [](const primitives::Extrinsic &xt) {
+      return xt.data.size() + 5;
+    };
+    size_t block_size = 0;
+
     for (const auto &xt : inherent_xts) {
-      logger_->debug("Adding inherent extrinsic: {}", xt.data.toHex());
+      logger_->debug("Adding inherent extrinsic: {}", xt.data);
       auto inserted_res = block_builder->pushExtrinsic(xt);
       if (not inserted_res) {
         log_push_error(xt, inserted_res.error().message());
         return inserted_res.error();
       }
+      block_size += encoded_size(xt);
     }
 
-    const auto &ready_txs = transaction_pool_->getReadyTransactions();
+    // the transactions are taken from the pool by their priority, so the
+    // most valuable ones get into the block first
+    std::vector<primitives::Transaction::Hash> included_txs;
+    size_t skipped = 0;
+    size_t skipped_in_row = 0;
+    auto ready_txs = transaction_pool_->getReadyTransactions();
+    while (auto tx = ready_txs->next()) {
+      if (clock_->now() >= deadline) {
+        logger_->debug("Deadline of the block proposal is reached");
+        break;
+      }
+      if (block_size + encoded_size(tx->ext) > kBlockSizeLimit) {
+        ++skipped;
+        // a smaller one may still fit
+        if (++skipped_in_row == kMaxSkippedInRow) {
+          logger_->debug("Size limit of the block is reached");
+          break;
+        }
+        continue;
+      }
+      skipped_in_row = 0;
 
-    for (const auto &[hash, tx] : ready_txs) {
-      logger_->debug("Adding extrinsic: {}", tx->ext.data.toHex());
+      logger_->debug("Adding extrinsic: {}", tx->ext.data);
       auto inserted_res = block_builder->pushExtrinsic(tx->ext);
       if (not inserted_res) {
         log_push_error(tx->ext, inserted_res.error().message());
-        return inserted_res.error();
+        ++skipped;
+        continue;
       }
+      block_size += encoded_size(tx->ext);
+      included_txs.push_back(tx->hash);
     }
+    // the iteration is over the pool, which is changed below
+    ready_txs.reset();
+
+    logger_->info("Proposed block includes {} extrinsics, {} skipped",
+                  included_txs.size(),
+                  skipped);
 
     auto block = block_builder->bake();
 
-    for (const auto &[hash, tx] : ready_txs) {
+    for (const auto &hash : included_txs) {
       auto removed_res = transaction_pool_->removeOne(hash);
       if (not removed_res) {
         logger_->error(
             "Can't remove extrinsic (hash={}) after adding to the block. "
             "Reason: {}",
-            hash.toHex(),
+            hash,
             removed_res.error().message());
       }
     }
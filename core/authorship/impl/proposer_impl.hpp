@@ -15,24 +15,39 @@
 
 namespace kagome::authorship {
 
+  /**
+   * Adds the ready transactions to the block until the deadline or the size
+   * limit of the block is reached. The ones which fail to be applied are
+   * skipped and left in the pool
+   */
   class ProposerImpl : public Proposer {
    public:
+    /// max size of the extrinsics of a block, in bytes
+    static constexpr size_t kBlockSizeLimit = 4 * 1024 * 1024;
+
+    /// number of the transactions in a row, which are skipped as not fitting
+    /// into the block, after which the block is considered full
+    static constexpr size_t kMaxSkippedInRow = 8;
+
     ~ProposerImpl() override = default;
 
     ProposerImpl(
         std::shared_ptr<BlockBuilderFactory> block_builder_factory,
         std::shared_ptr<transaction_pool::TransactionPool> transaction_pool,
-        std::shared_ptr<runtime::BlockBuilder> r_block_builder);
+        std::shared_ptr<runtime::BlockBuilder> r_block_builder,
+        std::shared_ptr<clock::SystemClock> clock);
 
     outcome::result<primitives::Block> propose(
         const primitives::BlockId &parent_block_id,
         const primitives::InherentData &inherent_data,
-        const primitives::Digest &inherent_digest) override;
+        const primitives::Digest &inherent_digest,
+        clock::SystemClock::TimePoint deadline) override;
 
    private:
     std::shared_ptr<BlockBuilderFactory> block_builder_factory_;
     std::shared_ptr<transaction_pool::TransactionPool> transaction_pool_;
     std::shared_ptr<runtime::BlockBuilder> r_block_builder_;
+    std::shared_ptr<clock::SystemClock> clock_;
     common::Logger logger_ = common::createLogger("Proposer");
   };
 
@@ -6,9 +6,13 @@
 #ifndef KAGOME_BLOCK_STORAGE_HPP
 #define KAGOME_BLOCK_STORAGE_HPP
 
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
 #include "primitives/block.hpp"
 #include "primitives/block_data.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
 #include "primitives/justification.hpp"
 
 namespace kagome::blockchain {
@@ -26,6 +30,20 @@ namespace kagome::blockchain {
     virtual outcome::result<void> setLastFinalizedBlockHash(
         const primitives::BlockHash &) = 0;
 
+    /**
+     * @return the snapshot of the unfinalized part of the block tree, which
+     * was stored last, none if there is none
+     */
+    virtual outcome::result<boost::optional<common::Buffer>>
+    getBlockTreeSnapshot() const = 0;
+
+    /**
+     * Stores \arg snapshot of the unfinalized part of the block tree in place
+     * of the previous one
+     */
+    virtual outcome::result<void> setBlockTreeSnapshot(
+        const common::Buffer &snapshot) = 0;
+
     virtual outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &id) const = 0;
     virtual outcome::result<primitives::BlockBody> getBlockBody(
@@ -35,6 +53,18 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const = 0;
 
+    /**
+     * Reads the data of several blocks at once, which is a sequential read
+     * for the blocks ordered by their numbers ascending
+     * @param blocks numbers and hashes of the blocks, a block with a wrong
+     * number is still found, though not with the others
+     * @return data of \arg blocks in the same order, the data of an unknown
+     * block keeps its hash only
+     */
+    virtual outcome::result<std::vector<primitives::BlockData>>
+    getBlockDataRange(
+        const std::vector<primitives::BlockInfo> &blocks) const = 0;
+
     virtual outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) = 0;
 
@@ -52,6 +82,32 @@ namespace kagome::blockchain {
     virtual outcome::result<void> removeBlock(
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) = 0;
+
+    /**
+     * Removes several blocks with a single write, so that either all or none
+     * of them are removed
+     * @param blocks numbers and hashes of the blocks
+     */
+    virtual outcome::result<void> removeBlocks(
+        const std::vector<primitives::BlockInfo> &blocks) = 0;
+
+    /**
+     * Removes the bodies of the blocks with the numbers below \arg number,
+     * keeping their headers, as well as the whole data of the blocks which
+     * change the authority set and are justified
+     */
+    virtual outcome::result<void> pruneBodies(
+        primitives::BlockNumber number) = 0;
+
+    /**
+     * Removes the justifications of the blocks with the numbers below \arg
+     * number, keeping the ones of the blocks which change the authority set
+     * and of the blocks with the numbers divisible by \arg period, so that
+     * the finality of any block is proven by one of the kept ones. Nothing is
+     * removed if \arg period is 0
+     */
+    virtual outcome::result<void> pruneJustifications(
+        primitives::BlockNumber number, primitives::BlockNumber period) = 0;
   };
 
 }  // namespace kagome::blockchain
@@ -56,6 +56,17 @@ namespace kagome::blockchain {
     virtual outcome::result<primitives::Justification> getBlockJustification(
         const primitives::BlockId &block) const = 0;
 
+    /**
+     * Get a proof of the finality of the block, which is the justification of
+     * the block itself or of its closest finalized descendant, if the one of
+     * the block is pruned
+     * @param block - id of the finalized block
+     * @return the justified block and its justification
+     */
+    virtual outcome::result<
+        std::pair<primitives::BlockInfo, primitives::Justification>>
+    getFinalityProof(const primitives::BlockId &block) const = 0;
+
     /**
      * Adds header to the storage
      * @param header that we are adding
@@ -134,6 +145,15 @@ namespace kagome::blockchain {
         const primitives::BlockHash &top_block,
         const primitives::BlockHash &bottom_block) = 0;
 
+    /**
+     * Check if \param ancestor is \param descendant or one of its ancestors
+     * @return true if it is, false if it is not or any of the blocks is
+     * unknown
+     */
+    virtual bool hasDirectChain(
+        const primitives::BlockHash &ancestor,
+        const primitives::BlockHash &descendant) const = 0;
+
     /**
      * Get a longest path (chain of blocks) from the last finalized block down
      * to the deepest leaf
@@ -182,6 +202,14 @@ namespace kagome::blockchain {
      * @return hash of the block
      */
     virtual primitives::BlockInfo getLastFinalized() const = 0;
+
+    /**
+     * Drops all blocks of the tree, which is rooted at the last finalized
+     * block of the block storage again. Used when the finality of the
+     * storage is moved past the tree by a sync without the import of blocks
+     * @return nothing or error
+     */
+    virtual outcome::result<void> resetToLastFinalized() = 0;
   };
 }  // namespace kagome::blockchain
 
@@ -20,7 +20,8 @@ namespace kagome::blockchain {
     HASH_FAILED,
     NO_SUCH_BLOCK,
     INCORRECT_ARGS,
-    INTERNAL_ERROR
+    INTERNAL_ERROR,
+    NO_FINALITY_PROOF
   };
 }  // namespace kagome::blockchain
 
@@ -0,0 +1,574 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_freezer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <zdict.h>
+#include <zstd.h>
+#include <boost/assert.hpp>
+#include <boost/endian/arithmetic.hpp>
+#include <boost/filesystem.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::blockchain, BlockFreezerError, e) {
+  using E = kagome::blockchain::BlockFreezerError;
+  switch (e) {
+    case E::CANNOT_OPEN_FILE:
+      return "Cannot open a file of the block freezer";
+    case E::CANNOT_WRITE_FILE:
+      return "Cannot write a file of the block freezer";
+    case E::CANNOT_READ_FILE:
+      return "Cannot read a file of the block freezer";
+    case E::INVALID_FORMAT:
+      return "The files of the block freezer are malformed";
+    case E::NOT_NEXT_BLOCK:
+      return "Only the next block may be appended to the block freezer";
+    case E::COMPRESSION_FAILED:
+      return "Cannot compress or decompress the data of a frozen block";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::blockchain {
+
+  namespace {
+    using boost::endian::little_uint32_buf_t;
+    using boost::endian::little_uint64_buf_t;
+
+    constexpr const char *kDataExtension = ".data";
+    constexpr const char *kIndexExtension = ".index";
+    constexpr const char *kDictionaryExtension = ".dict";
+
+    // set in the size of an index entry of the compressed data
+    constexpr uint32_t kCompressedFlag = 1u << 31;
+
+    /**
+     * @return number of the block encoded in the name of \arg path, none if
+     * it is not a number
+     */
+    boost::optional<primitives::BlockNumber> numberOf(
+        const boost::filesystem::path &path) {
+      auto name = path.stem().string();
+      primitives::BlockNumber number{};
+      auto [end, err] =
+          std::from_chars(name.data(), name.data() + name.size(), number);
+      if (err != std::errc{} or end != name.data() + name.size()) {
+        return boost::none;
+      }
+      return number;
+    }
+
+    bool readAll(int fd, void *data, size_t size, uint64_t offset) {
+      auto *ptr = static_cast<uint8_t *>(data);
+      while (size != 0) {
+        auto n = pread(fd, ptr, size, static_cast<off_t>(offset));
+        if (n <= 0) {
+          return false;
+        }
+        ptr += n;
+        size -= n;
+        offset += n;
+      }
+      return true;
+    }
+
+    /// Syncs the file or the directory at \arg path to the disk
+    bool syncPath(const std::string &path) {
+      auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        return false;
+      }
+      auto synced = fsync(fd) == 0;
+      close(fd);
+      return synced;
+    }
+
+    bool writeAll(int fd, const void *data, size_t size, uint64_t offset) {
+      const auto *ptr = static_cast<const uint8_t *>(data);
+      while (size != 0) {
+        auto n = pwrite(fd, ptr, size, static_cast<off_t>(offset));
+        if (n <= 0) {
+          return false;
+        }
+        ptr += n;
+        size -= n;
+        offset += n;
+      }
+      return true;
+    }
+  }  // namespace
+
+  // fields are unaligned little endian integers, so the files are the same
+  // on any platform
+  struct BlockFreezer::IndexEntry {
+    std::array<uint8_t, primitives::BlockHash::size()> hash;
+    // offset of the data from the start of the data file
+    little_uint64_buf_t offset;
+    // kCompressedFlag is set if the data is compressed
+    little_uint32_buf_t size;
+  };
+
+  struct BlockFreezer::Compression {
+    int level = 0;
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx{
+        ZSTD_createCCtx(), ZSTD_freeCCtx};
+    // the latest dictionary, the appended data is compressed with
+    std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> cdict{
+        nullptr, ZSTD_freeCDict};
+    // all the dictionaries by their ids, the data is decompressed with the
+    // one it was compressed with
+    std::map<uint32_t,
+             std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>>
+        ddicts;
+    // data of the blocks frozen until the first dictionary is trained
+    common::Buffer samples;
+    std::vector<size_t> sample_sizes;
+  };
+
+  BlockFreezer::BlockFreezer(std::string directory,
+                             size_t segment_size,
+                             int compression_level)
+      : directory_{std::move(directory)},
+        segment_size_{segment_size},
+        compression_{std::make_unique<Compression>()} {
+    BOOST_ASSERT(segment_size_ > 0);
+    compression_->level = compression_level;
+  }
+
+  BlockFreezer::~BlockFreezer() {
+    // the blocks not synced are dropped at the next open otherwise
+    std::ignore = syncSegments();
+    for (auto &segment : segments_) {
+      close(segment.data_fd);
+      close(segment.index_fd);
+    }
+  }
+
+  outcome::result<std::shared_ptr<BlockFreezer>> BlockFreezer::open(
+      const std::string &directory,
+      size_t segment_size,
+      int compression_level) {
+    static_assert(sizeof(IndexEntry) == 44);
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(directory, ec);
+    if (ec) {
+      return BlockFreezerError::CANNOT_OPEN_FILE;
+    }
+
+    // a segment is named after the number of its first block
+    std::vector<primitives::BlockNumber> firsts;
+    for (auto &entry : boost::filesystem::directory_iterator(directory, ec)) {
+      const auto &path = entry.path();
+      if (path.extension() != kIndexExtension) {
+        continue;
+      }
+      auto first = numberOf(path);
+      if (not first) {
+        return BlockFreezerError::INVALID_FORMAT;
+      }
+      firsts.push_back(first.value());
+    }
+    if (ec) {
+      return BlockFreezerError::CANNOT_OPEN_FILE;
+    }
+    std::sort(firsts.begin(), firsts.end());
+
+    // constructor is private
+    std::shared_ptr<BlockFreezer> freezer{
+        new BlockFreezer{directory, segment_size, compression_level}};
+    OUTCOME_TRY(freezer->loadDictionaries());
+    for (auto first : firsts) {
+      OUTCOME_TRY(segment, freezer->openSegment(first, false));
+      freezer->segments_.push_back(segment);
+      auto &segments = freezer->segments_;
+      if (segments.size() > 1) {
+        const auto &prev = segments[segments.size() - 2];
+        if (prev.first + prev.size != first) {
+          return BlockFreezerError::INVALID_FORMAT;
+        }
+      }
+    }
+    return freezer;
+  }
+
+  outcome::result<BlockFreezer::Segment> BlockFreezer::openSegment(
+      primitives::BlockNumber first, bool create) const {
+    int flags = O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_TRUNC : 0);
+    Segment segment{first, 0, -1, -1, 0, 0, {}};
+    segment.data_fd =
+        ::open(segmentPath(first, kDataExtension).c_str(), flags, 0644);
+    if (segment.data_fd < 0) {
+      return BlockFreezerError::CANNOT_OPEN_FILE;
+    }
+    segment.index_fd =
+        ::open(segmentPath(first, kIndexExtension).c_str(), flags, 0644);
+    if (segment.index_fd < 0) {
+      close(segment.data_fd);
+      return BlockFreezerError::CANNOT_OPEN_FILE;
+    }
+    auto fail = [&segment](BlockFreezerError error) {
+      close(segment.data_fd);
+      close(segment.index_fd);
+      return error;
+    };
+
+    auto index_size = lseek(segment.index_fd, 0, SEEK_END);
+    auto data_size = lseek(segment.data_fd, 0, SEEK_END);
+    if (index_size < 0 or data_size < 0) {
+      return fail(BlockFreezerError::CANNOT_READ_FILE);
+    }
+    segment.size = static_cast<size_t>(index_size) / sizeof(IndexEntry);
+    // the index is synced after the data, still the entries of the data,
+    // which is not on the disk, e.g. if the files were copied partially, are
+    // dropped rather than read as garbage
+    while (segment.size != 0) {
+      IndexEntry last{};
+      if (not readAll(segment.index_fd,
+                      &last,
+                      sizeof(last),
+                      (segment.size - 1) * sizeof(IndexEntry))) {
+        return fail(BlockFreezerError::CANNOT_READ_FILE);
+      }
+      auto end = last.offset.value() + (last.size.value() & ~kCompressedFlag);
+      if (end <= static_cast<uint64_t>(data_size)) {
+        segment.data_size = end;
+        break;
+      }
+      segment.size--;
+    }
+    segment.indexed = segment.size;
+    // the data beyond the last complete entry is not indexed and is dropped
+    if (ftruncate(segment.index_fd, segment.size * sizeof(IndexEntry)) != 0
+        or ftruncate(segment.data_fd, segment.data_size) != 0) {
+      return fail(BlockFreezerError::CANNOT_WRITE_FILE);
+    }
+    // blocks are read mostly in ranges by the peers syncing with the node
+    posix_fadvise(segment.data_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    return segment;
+  }
+
+  std::string BlockFreezer::segmentPath(primitives::BlockNumber first,
+                                        const char *extension) const {
+    // padded with zeros, so that the files are listed in the order of blocks
+    auto name = std::to_string(first);
+    name.insert(0, 20 - name.size(), '0');
+    return (boost::filesystem::path{directory_} / (name + extension))
+        .string();
+  }
+
+  boost::optional<primitives::BlockNumber> BlockFreezer::nextNumber() const {
+    std::shared_lock lock{mutex_};
+    if (segments_.empty()) {
+      return boost::none;
+    }
+    return segments_.back().first + segments_.back().size;
+  }
+
+  outcome::result<void> BlockFreezer::append(
+      primitives::BlockNumber number,
+      const primitives::BlockHash &hash,
+      gsl::span<const uint8_t> data) {
+    std::unique_lock lock{mutex_};
+    if (not segments_.empty()
+        and number != segments_.back().first + segments_.back().size) {
+      return BlockFreezerError::NOT_NEXT_BLOCK;
+    }
+    if (segments_.empty() or segments_.back().size >= segment_size_) {
+      OUTCOME_TRY(segment, openSegment(number, true));
+      segments_.push_back(std::move(segment));
+      directory_changed_ = true;
+    }
+    auto &segment = segments_.back();
+
+    boost::optional<common::Buffer> compressed;
+    if (compression_->level != 0 and not data.empty()) {
+      OUTCOME_TRY(compressed_res, compress(data));
+      compressed = std::move(compressed_res);
+    }
+    gsl::span<const uint8_t> written =
+        compressed ? gsl::span<const uint8_t>(compressed.value()) : data;
+
+    IndexEntry entry{};
+    std::copy(hash.begin(), hash.end(), entry.hash.begin());
+    entry.offset = segment.data_size;
+    entry.size = static_cast<uint32_t>(written.size())
+                 | (compressed ? kCompressedFlag : 0);
+    if (not writeAll(segment.data_fd,
+                     written.data(),
+                     written.size(),
+                     segment.data_size)) {
+      return BlockFreezerError::CANNOT_WRITE_FILE;
+    }
+    // indexed on sync, once the data is on the disk
+    segment.pending_index.put(gsl::make_span(
+        reinterpret_cast<const uint8_t *>(&entry), sizeof(entry)));
+    segment.data_size += written.size();
+    segment.size++;
+
+    if (compression_->level != 0 and compression_->cdict == nullptr
+        and not data.empty()) {
+      OUTCOME_TRY(sample(number, data));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> BlockFreezer::sync() {
+    std::unique_lock lock{mutex_};
+    return syncSegments();
+  }
+
+  outcome::result<void> BlockFreezer::syncSegments() {
+    // only the last segments are appended to since the last sync
+    auto first = segments_.end();
+    while (first != segments_.begin()
+           and not std::prev(first)->pending_index.empty()) {
+      --first;
+    }
+    for (auto it = first; it != segments_.end(); ++it) {
+      if (fdatasync(it->data_fd) != 0) {
+        return BlockFreezerError::CANNOT_WRITE_FILE;
+      }
+    }
+    if (directory_changed_) {
+      if (not syncPath(directory_)) {
+        return BlockFreezerError::CANNOT_WRITE_FILE;
+      }
+      directory_changed_ = false;
+    }
+    for (auto it = first; it != segments_.end(); ++it) {
+      auto &segment = *it;
+      if (not writeAll(segment.index_fd,
+                       segment.pending_index.data(),
+                       segment.pending_index.size(),
+                       segment.indexed * sizeof(IndexEntry))
+          or fdatasync(segment.index_fd) != 0) {
+        return BlockFreezerError::CANNOT_WRITE_FILE;
+      }
+      segment.indexed += segment.pending_index.size() / sizeof(IndexEntry);
+      segment.pending_index.clear();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<common::Buffer>> BlockFreezer::get(
+      primitives::BlockNumber number,
+      const primitives::BlockHash &hash) const {
+    std::shared_lock lock{mutex_};
+    auto it = std::upper_bound(
+        segments_.begin(),
+        segments_.end(),
+        number,
+        [](auto number, const Segment &segment) {
+          return number < segment.first;
+        });
+    if (it == segments_.begin()) {
+      return boost::none;
+    }
+    const auto &segment = *std::prev(it);
+    if (number >= segment.first + segment.size) {
+      return boost::none;
+    }
+
+    IndexEntry entry{};
+    auto position = number - segment.first;
+    if (position >= segment.indexed) {
+      std::copy_n(segment.pending_index.data()
+                      + (position - segment.indexed) * sizeof(IndexEntry),
+                  sizeof(IndexEntry),
+                  reinterpret_cast<uint8_t *>(&entry));
+    } else if (not readAll(segment.index_fd,
+                           &entry,
+                           sizeof(entry),
+                           position * sizeof(IndexEntry))) {
+      return BlockFreezerError::CANNOT_READ_FILE;
+    }
+    // blocks of the same number are frozen only from the finalized chain
+    auto size = entry.size.value() & ~kCompressedFlag;
+    if (not std::equal(hash.begin(), hash.end(), entry.hash.begin())
+        or size == 0) {
+      return boost::none;
+    }
+    common::Buffer data(size, 0);
+    if (not readAll(
+            segment.data_fd, data.data(), data.size(), entry.offset.value())) {
+      return BlockFreezerError::CANNOT_READ_FILE;
+    }
+    if ((entry.size.value() & kCompressedFlag) != 0) {
+      return decompress(data);
+    }
+    return data;
+  }
+
+  outcome::result<void> BlockFreezer::loadDictionaries() {
+    std::map<primitives::BlockNumber, common::Buffer> dictionaries;
+    boost::system::error_code ec;
+    for (auto &entry : boost::filesystem::directory_iterator(directory_, ec)) {
+      const auto &path = entry.path();
+      if (path.extension() != kDictionaryExtension) {
+        continue;
+      }
+      auto first = numberOf(path);
+      if (not first) {
+        return BlockFreezerError::INVALID_FORMAT;
+      }
+      std::ifstream file{path.string(), std::ios::binary};
+      common::Buffer dictionary{
+          std::vector<uint8_t>(std::istreambuf_iterator<char>{file},
+                               std::istreambuf_iterator<char>{})};
+      if (file.bad()) {
+        return BlockFreezerError::CANNOT_READ_FILE;
+      }
+      dictionaries.emplace(first.value(), std::move(dictionary));
+    }
+    if (ec) {
+      return BlockFreezerError::CANNOT_OPEN_FILE;
+    }
+    // named after the blocks they are trained by, so the latest one, which
+    // compresses the appended data, is made last
+    for (const auto &entry : dictionaries) {
+      OUTCOME_TRY(useDictionary(entry.second));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<common::Buffer>> BlockFreezer::compress(
+      gsl::span<const uint8_t> data) {
+    common::Buffer compressed(ZSTD_compressBound(data.size()), 0);
+    auto size = compression_->cdict != nullptr
+                    ? ZSTD_compress_usingCDict(compression_->cctx.get(),
+                                               compressed.data(),
+                                               compressed.size(),
+                                               data.data(),
+                                               data.size(),
+                                               compression_->cdict.get())
+                    : ZSTD_compressCCtx(compression_->cctx.get(),
+                                        compressed.data(),
+                                        compressed.size(),
+                                        data.data(),
+                                        data.size(),
+                                        compression_->level);
+    if (ZSTD_isError(size) != 0) {
+      return BlockFreezerError::COMPRESSION_FAILED;
+    }
+    if (size >= static_cast<size_t>(data.size())) {
+      return boost::none;
+    }
+    compressed.resize(size);
+    return compressed;
+  }
+
+  outcome::result<common::Buffer> BlockFreezer::decompress(
+      gsl::span<const uint8_t> data) const {
+    auto size = ZSTD_getFrameContentSize(data.data(), data.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR or size == ZSTD_CONTENTSIZE_UNKNOWN) {
+      return BlockFreezerError::COMPRESSION_FAILED;
+    }
+    const ZSTD_DDict *ddict = nullptr;
+    if (auto id = ZSTD_getDictID_fromFrame(data.data(), data.size());
+        id != 0) {
+      auto it = compression_->ddicts.find(id);
+      if (it == compression_->ddicts.end()) {
+        return BlockFreezerError::COMPRESSION_FAILED;
+      }
+      ddict = it->second.get();
+    }
+    // the readers share the lock, so each has a context of its own
+    std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx{
+        ZSTD_createDCtx(), ZSTD_freeDCtx};
+    common::Buffer decompressed(size, 0);
+    auto res = ZSTD_decompress_usingDDict(dctx.get(),
+                                          decompressed.data(),
+                                          decompressed.size(),
+                                          data.data(),
+                                          data.size(),
+                                          ddict);
+    if (ZSTD_isError(res) != 0 or res != size) {
+      return BlockFreezerError::COMPRESSION_FAILED;
+    }
+    return decompressed;
+  }
+
+  outcome::result<void> BlockFreezer::sample(primitives::BlockNumber number,
+                                             gsl::span<const uint8_t> data) {
+    auto &samples = compression_->samples;
+    auto &sample_sizes = compression_->sample_sizes;
+    samples.put(data);
+    sample_sizes.push_back(data.size());
+    if (sample_sizes.size() < kTrainingBlocks
+        and samples.size() < kMaxTrainingSize) {
+      return outcome::success();
+    }
+
+    // trained once, while the blocks are appended, which takes a while
+    common::Buffer dictionary(kMaxDictionarySize, 0);
+    auto size =
+        ZDICT_trainFromBuffer(dictionary.data(),
+                              dictionary.size(),
+                              samples.data(),
+                              sample_sizes.data(),
+                              static_cast<unsigned>(sample_sizes.size()));
+    samples = {};
+    sample_sizes = {};
+    if (ZDICT_isError(size) != 0) {
+      // too few data to train on, the next blocks are sampled then
+      return outcome::success();
+    }
+    dictionary.resize(size);
+
+    // written to a temporary file first, so that no dictionary is partial
+    auto path = segmentPath(number + 1, kDictionaryExtension);
+    auto temp_path = path + ".tmp";
+    {
+      std::ofstream file{temp_path, std::ios::binary | std::ios::trunc};
+      file.write(reinterpret_cast<const char *>(dictionary.data()),
+                 static_cast<std::streamsize>(dictionary.size()));
+      if (not file) {
+        return BlockFreezerError::CANNOT_WRITE_FILE;
+      }
+    }
+    // the data compressed with it can't be read without it, so it is on the
+    // disk before any of that data
+    if (not syncPath(temp_path)) {
+      return BlockFreezerError::CANNOT_WRITE_FILE;
+    }
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+      return BlockFreezerError::CANNOT_WRITE_FILE;
+    }
+    directory_changed_ = true;
+    return useDictionary(dictionary);
+  }
+
+  outcome::result<void> BlockFreezer::useDictionary(
+      gsl::span<const uint8_t> dictionary) {
+    auto id = ZDICT_getDictID(dictionary.data(), dictionary.size());
+    std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> ddict{
+        ZSTD_createDDict(dictionary.data(), dictionary.size()),
+        ZSTD_freeDDict};
+    if (id == 0 or ddict == nullptr) {
+      return BlockFreezerError::INVALID_FORMAT;
+    }
+    compression_->ddicts.insert_or_assign(id, std::move(ddict));
+    if (compression_->level != 0) {
+      compression_->cdict.reset(ZSTD_createCDict(
+          dictionary.data(), dictionary.size(), compression_->level));
+      if (compression_->cdict == nullptr) {
+        return BlockFreezerError::COMPRESSION_FAILED;
+      }
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::blockchain
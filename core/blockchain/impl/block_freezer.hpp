@@ -0,0 +1,184 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_FREEZER_HPP
+#define KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_FREEZER_HPP
+
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gsl/span>
+
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::blockchain {
+
+  enum class BlockFreezerError {
+    CANNOT_OPEN_FILE = 1,
+    CANNOT_WRITE_FILE,
+    CANNOT_READ_FILE,
+    INVALID_FORMAT,
+    NOT_NEXT_BLOCK,
+    COMPRESSION_FAILED
+  };
+
+  /**
+   * Append-only store of the data of the finalized blocks. The data is never
+   * changed once a block is finalized, so it is kept in flat files instead
+   * of the key-value storage, which would compact it over and over again.
+   * Blocks are appended in the order of their numbers and are kept in
+   * segments of a limited number of blocks. A segment is a data file with
+   * the encoded data of the blocks one after another, and an index file
+   * with an entry of a fixed size for each block, so the data of the
+   * consecutive blocks is read sequentially.
+   * The data of a block is written to the data file at once, while its
+   * index entry is kept in memory until \see sync, which makes the data
+   * durable first and only then writes and syncs the index. Whatever is not
+   * indexed, or is indexed beyond the end of the data, is dropped when the
+   * freezer is opened, so the files stay consistent if the node stops or
+   * loses power in the middle of a write.
+   * The data may be compressed with zstd. The dictionaries are trained on
+   * the data of the first blocks frozen with the compression and are kept
+   * next to the segments, while the data frozen before a dictionary is
+   * trained is compressed without one
+   */
+  class BlockFreezer {
+   public:
+    static constexpr size_t kDefaultSegmentSize = 8192;
+
+    /// number of the blocks the dictionary is trained on
+    static constexpr size_t kTrainingBlocks = 1024;
+
+    /// max size of the data of the blocks the dictionary is trained on
+    static constexpr size_t kMaxTrainingSize = 16 << 20;
+
+    /// max size of a dictionary
+    static constexpr size_t kMaxDictionarySize = 110 << 10;
+
+    ~BlockFreezer();
+
+    BlockFreezer(const BlockFreezer &) = delete;
+    BlockFreezer &operator=(const BlockFreezer &) = delete;
+
+    /**
+     * Opens the freezer in \arg directory, which is created if there is none
+     * @param segment_size max number of the blocks in a segment
+     * @param compression_level zstd level the appended data is compressed
+     * with, 0 leaves it uncompressed. The compressed data is read anyway
+     */
+    static outcome::result<std::shared_ptr<BlockFreezer>> open(
+        const std::string &directory,
+        size_t segment_size = kDefaultSegmentSize,
+        int compression_level = 0);
+
+    /**
+     * @return number of the block to be appended next, none if no block is
+     * frozen yet
+     */
+    boost::optional<primitives::BlockNumber> nextNumber() const;
+
+    /**
+     * Appends \arg data of the block with \arg number and \arg hash, which
+     * must be the next one unless the freezer is empty. Empty data is kept
+     * for a block without any data, so that the numbers have no gaps
+     */
+    outcome::result<void> append(primitives::BlockNumber number,
+                                 const primitives::BlockHash &hash,
+                                 gsl::span<const uint8_t> data);
+
+    /**
+     * Makes the blocks appended so far durable: syncs their data to the disk,
+     * then writes their index entries and syncs them too. The blocks may be
+     * removed from elsewhere only after it succeeds
+     */
+    outcome::result<void> sync();
+
+    /**
+     * @return data of the block with \arg number and \arg hash, none if the
+     * block is not frozen or has no data
+     */
+    outcome::result<boost::optional<common::Buffer>> get(
+        primitives::BlockNumber number,
+        const primitives::BlockHash &hash) const;
+
+   private:
+    struct IndexEntry;
+    struct Compression;
+
+    struct Segment {
+      primitives::BlockNumber first;
+      // number of the blocks in the segment, including the ones not indexed
+      size_t size;
+      int data_fd;
+      int index_fd;
+      uint64_t data_size;
+      // number of the entries written to the index file
+      size_t indexed;
+      // entries of the blocks appended since the last sync
+      common::Buffer pending_index;
+    };
+
+    BlockFreezer(std::string directory,
+                 size_t segment_size,
+                 int compression_level);
+
+    /**
+     * Loads the dictionaries kept in the directory
+     */
+    outcome::result<void> loadDictionaries();
+
+    /**
+     * @return \arg data compressed, none if it is not smaller compressed
+     */
+    outcome::result<boost::optional<common::Buffer>> compress(
+        gsl::span<const uint8_t> data);
+
+    outcome::result<common::Buffer> decompress(
+        gsl::span<const uint8_t> data) const;
+
+    /**
+     * Keeps \arg data to train the dictionary on, which is trained once
+     * there is enough of it
+     */
+    outcome::result<void> sample(primitives::BlockNumber number,
+                                 gsl::span<const uint8_t> data);
+
+    /**
+     * Makes \arg dictionary the one the appended data is compressed with
+     */
+    outcome::result<void> useDictionary(gsl::span<const uint8_t> dictionary);
+
+    /**
+     * Opens the segment starting from block \arg first, which is created if
+     * there is none, and drops its entries not written completely
+     */
+    outcome::result<Segment> openSegment(primitives::BlockNumber first,
+                                         bool create) const;
+
+    std::string segmentPath(primitives::BlockNumber first,
+                            const char *extension) const;
+
+    /// \see sync, is called with the mutex locked
+    outcome::result<void> syncSegments();
+
+    const std::string directory_;
+    const size_t segment_size_;
+    mutable std::shared_mutex mutex_;
+    // ordered by the numbers of the blocks, without gaps between them
+    std::vector<Segment> segments_;
+    // files were created or renamed in the directory since the last sync
+    bool directory_changed_ = false;
+    std::unique_ptr<Compression> compression_;
+  };
+
+}  // namespace kagome::blockchain
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::blockchain, BlockFreezerError);
+
+#endif  // KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_FREEZER_HPP
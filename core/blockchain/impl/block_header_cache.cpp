@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+namespace kagome::blockchain {
+
+  BlockHeaderCache::BlockHeaderCache(size_t capacity) : capacity_{capacity} {}
+
+  boost::optional<primitives::BlockHeader> BlockHeaderCache::get(
+      const primitives::BlockHash &hash) const {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(hash);
+    if (it == index_.end()) {
+      ++misses_;
+      return boost::none;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void BlockHeaderCache::put(const primitives::BlockHash &hash,
+                             const primitives::BlockHeader &header) {
+    std::lock_guard lock{mutex_};
+    if (capacity_ == 0) {
+      return;
+    }
+    if (auto it = index_.find(hash); it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(hash, header);
+    index_.emplace(hash, entries_.begin());
+    evict();
+  }
+
+  void BlockHeaderCache::evict() {
+    while (index_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  void BlockHeaderCache::remove(const primitives::BlockHash &hash) {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(hash);
+    if (it == index_.end()) {
+      return;
+    }
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+
+  size_t BlockHeaderCache::size() const {
+    std::lock_guard lock{mutex_};
+    return index_.size();
+  }
+
+  size_t BlockHeaderCache::capacity() const {
+    std::lock_guard lock{mutex_};
+    return capacity_;
+  }
+
+  common::BudgetedCache::Usage BlockHeaderCache::usage() const {
+    std::lock_guard lock{mutex_};
+    return {index_.size() * kEntryBytes, hits_, misses_};
+  }
+
+  void BlockHeaderCache::setBudget(size_t bytes) {
+    std::lock_guard lock{mutex_};
+    capacity_ = bytes / kEntryBytes;
+    evict();
+  }
+
+}  // namespace kagome::blockchain
@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+#define KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
+
+#include <list>
+#include <mutex>
+
+#include <boost/optional.hpp>
+
+#include "common/budgeted_cache.hpp"
+#include "common/flat_hash_map.hpp"
+#include "primitives/block_header.hpp"
+
+namespace kagome::blockchain {
+
+  /**
+   * Bounded LRU cache of decoded block headers, shared by the block storage,
+   * which fills it when a header is put and drops a header when its block
+   * is removed, and the header repository, which fills it on reads.
+   * Keyed by the block hash, so the number of a block is known from its
+   * cached header too. The hash of a block by its number is not cached, as
+   * it is changed by the storage whenever a block of that number is put.
+   */
+  class BlockHeaderCache : public common::BudgetedCache {
+   public:
+    /// estimated memory taken by a cached header with its digest and its
+    /// hash, as the sizes of the digests are not tracked
+    static constexpr size_t kEntryBytes = 384;
+
+    /**
+     * @param capacity max number of headers kept in the cache, zero disables
+     * caching
+     */
+    explicit BlockHeaderCache(size_t capacity);
+
+    /**
+     * @return copy of the header of the block with \arg hash, none if it is
+     * not cached
+     */
+    boost::optional<primitives::BlockHeader> get(
+        const primitives::BlockHash &hash) const;
+
+    /**
+     * Stores \arg header of the block with \arg hash, evicting the least
+     * recently used header if the cache is full
+     */
+    void put(const primitives::BlockHash &hash,
+             const primitives::BlockHeader &header);
+
+    /**
+     * Drops the header of the block with \arg hash, if it is cached
+     */
+    void remove(const primitives::BlockHash &hash);
+
+    size_t size() const;
+    size_t capacity() const;
+
+    Usage usage() const override;
+
+    /// sets the capacity to the number of headers estimated to fit \arg bytes
+    void setBudget(size_t bytes) override;
+
+   private:
+    using Entry = std::pair<primitives::BlockHash, primitives::BlockHeader>;
+    using EntryList = std::list<Entry>;
+
+    /// evicts the least recently used entries over the capacity
+    void evict();
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    mutable uint64_t hits_ = 0;
+    mutable uint64_t misses_ = 0;
+    // the most recently used entry is at the front
+    mutable EntryList entries_;
+    common::FlatHashMap<primitives::BlockHash, EntryList::iterator> index_;
+  };
+
+}  // namespace kagome::blockchain
+
+#endif  // KAGOME_CORE_BLOCKCHAIN_IMPL_BLOCK_HEADER_CACHE_HPP
@@ -24,6 +24,9 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::blockchain, BlockTreeError, e) {
       return "arguments, which were provided, are incorrect";
     case E::INTERNAL_ERROR:
       return "internal error happened";
+    case E::NO_FINALITY_PROOF:
+      return "block is not finalized, or the justifications proving its "
+             "finality are pruned";
   }
   return "unknown error";
 }
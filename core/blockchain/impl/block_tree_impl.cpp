@@ -7,6 +7,8 @@
 
 #include <algorithm>
 
+#include <boost/assert.hpp>
+
 #include "blockchain/block_tree_error.hpp"
 #include "blockchain/impl/common.hpp"
 #include "blockchain/impl/storage_util.hpp"
@@ -25,6 +27,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::blockchain, BlockTreeImpl::Error, e) {
     case E::BLOCK_NOT_FOUND:
       return "block exists in chain but not found when following all leaves "
              "backwards.";
+    case E::INVALID_SNAPSHOT:
+      return "snapshot of the block tree refers to an unknown parent";
   }
   return "unknown error";
 }
@@ -34,37 +38,61 @@ namespace kagome::blockchain {
   using Prefix = prefix::Prefix;
   using DatabaseError = kagome::storage::DatabaseError;
 
+  namespace {
+    /// a descendant of the root in the snapshot of the tree
+    struct SnapshotNode {
+      primitives::BlockHash hash;
+      primitives::BlockNumber number;
+      // 0 for the root, i + 1 for the i-th node of the snapshot
+      uint32_t parent;
+    };
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_encoder_stream>>
+    Stream &operator<<(Stream &s, const SnapshotNode &node) {
+      return s << node.hash << node.number << node.parent;
+    }
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_decoder_stream>>
+    Stream &operator>>(Stream &s, SnapshotNode &node) {
+      return s >> node.hash >> node.number >> node.parent;
+    }
+
+    /// the unfinalized blocks of the tree, the leaves are the nodes, which
+    /// are no one's parents
+    struct Snapshot {
+      // the last finalized block
+      primitives::BlockHash root;
+      // each after its parent
+      std::vector<SnapshotNode> nodes;
+    };
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_encoder_stream>>
+    Stream &operator<<(Stream &s, const Snapshot &snapshot) {
+      return s << snapshot.root << snapshot.nodes;
+    }
+
+    template <class Stream,
+              typename = std::enable_if_t<Stream::is_decoder_stream>>
+    Stream &operator>>(Stream &s, Snapshot &snapshot) {
+      return s >> snapshot.root >> snapshot.nodes;
+    }
+  }  // namespace
+
   BlockTreeImpl::TreeNode::TreeNode(primitives::BlockHash hash,
                                     primitives::BlockNumber depth,
-                                    const std::shared_ptr<TreeNode> &parent,
+                                    TreeNode *parent,
                                     bool finalized)
-      : block_hash{hash}, depth{depth}, parent{parent}, finalized{finalized} {}
-
-  std::shared_ptr<BlockTreeImpl::TreeNode> BlockTreeImpl::TreeNode::getByHash(
-      const primitives::BlockHash &hash) {
-    // standard BFS
-    std::queue<std::shared_ptr<TreeNode>> nodes_to_scan;
-    nodes_to_scan.push(shared_from_this());
-    while (!nodes_to_scan.empty()) {
-      const auto &node = nodes_to_scan.front();
-      if (node->block_hash == hash) {
-        return node;
-      }
-      for (const auto &child : node->children) {
-        nodes_to_scan.push(child);
-      }
-      nodes_to_scan.pop();
-    }
-    return nullptr;
-  }
+      : block_hash{hash},
+        depth{depth},
+        height{parent != nullptr ? parent->height + 1 : depth},
+        parent{parent},
+        finalized{finalized} {}
 
   bool BlockTreeImpl::TreeNode::operator==(const TreeNode &other) const {
-    const auto &other_parent = other.parent;
-    auto parents_equal = (parent.expired() && other_parent.expired())
-                         || (!parent.expired() && !other_parent.expired()
-                             && parent.lock() == other_parent.lock());
-
-    return parents_equal && block_hash == other.block_hash
+    return parent == other.parent && block_hash == other.block_hash
            && depth == other.depth;
   }
 
@@ -74,94 +102,272 @@ namespace kagome::blockchain {
 
   BlockTreeImpl::TreeMeta::TreeMeta(TreeNode &subtree_root_node)
       : deepest_leaf{subtree_root_node}, last_finalized{subtree_root_node} {
-    std::function<void(std::shared_ptr<TreeNode>)> handle =
-        [&](std::shared_ptr<TreeNode> node) {
-          // avoid of deep recurse
-          while (node->children.size() == 1) {
-            node = node->children.front();
-          }
-
-          // is leaf
-          if (node->children.empty()) {
-            leaves.emplace(node->block_hash);
-
-            if (node->depth > deepest_leaf.get().depth) {
-              deepest_leaf = *node;
-            }
-          } else {
-            // follow descendants recursively
-            for (const auto &child : node->children) {
-              handle(child);
-            }
-          }
-        };
-
-    handle(subtree_root_node.shared_from_this());
-  }
-
-  BlockTreeImpl::TreeMeta::TreeMeta(
-      std::unordered_set<primitives::BlockHash> leaves,
-      TreeNode &deepest_leaf,
-      TreeNode &last_finalized)
-      : leaves{std::move(leaves)},
-        deepest_leaf{deepest_leaf},
-        last_finalized{last_finalized} {}
+    std::function<void(TreeNode *)> handle = [&](TreeNode *node) {
+      // avoid of deep recurse
+      while (node->children.size() == 1) {
+        node = node->children.front();
+      }
+
+      // is leaf
+      if (node->children.empty()) {
+        leaves.emplace(node->block_hash);
+        leaves_by_depth.emplace(node->depth, node);
+
+        if (node->depth > deepest_leaf.get().depth) {
+          deepest_leaf = *node;
+        }
+      } else {
+        // follow descendants recursively
+        for (const auto &child : node->children) {
+          handle(child);
+        }
+      }
+    };
+
+    handle(&subtree_root_node);
+  }
+
+  void BlockTreeImpl::TreeMeta::addLeaf(TreeNode &node) {
+    if (auto parent = node.parent;
+        parent != nullptr and leaves.erase(parent->block_hash) != 0) {
+      leaves_by_depth.erase({parent->depth, parent});
+    }
+    leaves.insert(node.block_hash);
+    leaves_by_depth.emplace(node.depth, &node);
+    if (node.depth > deepest_leaf.get().depth) {
+      deepest_leaf = node;
+    }
+  }
+
+  void BlockTreeImpl::TreeMeta::removeLeaf(TreeNode &node) {
+    if (leaves.erase(node.block_hash) == 0) {
+      return;
+    }
+    leaves_by_depth.erase({node.depth, &node});
+    if (&deepest_leaf.get() == &node) {
+      deepest_leaf = leaves_by_depth.empty()
+                         ? last_finalized.get()
+                         : *leaves_by_depth.rbegin()->second;
+    }
+  }
 
   outcome::result<std::shared_ptr<BlockTreeImpl>> BlockTreeImpl::create(
       std::shared_ptr<BlockHeaderRepository> header_repo,
       std::shared_ptr<BlockStorage> storage,
       const primitives::BlockId &last_finalized_block,
       std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
-      std::shared_ptr<crypto::Hasher> hasher) {
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      primitives::BlockNumber state_pruning_depth,
+      std::shared_ptr<subscription::ChainEvents> chain_events,
+      primitives::BlockNumber blocks_pruning_depth,
+      primitives::BlockNumber justification_period) {
     // retrieve the block's header: we need data from it
     OUTCOME_TRY(header, storage->getBlockHeader(last_finalized_block));
     // create meta structures from the retrieved header
     OUTCOME_TRY(hash_res, header_repo->getHashById(last_finalized_block));
 
-    auto tree =
-        std::make_shared<TreeNode>(hash_res, header.number, nullptr, true);
-    auto meta = std::make_shared<TreeMeta>(*tree);
-
     BlockTreeImpl block_tree{std::move(header_repo),
                              std::move(storage),
-                             std::move(tree),
-                             std::move(meta),
+                             primitives::BlockInfo{header.number, hash_res},
                              std::move(extrinsic_observer),
-                             std::move(hasher)};
+                             std::move(hasher),
+                             std::move(state_pruner),
+                             state_pruning_depth,
+                             std::move(chain_events),
+                             blocks_pruning_depth,
+                             justification_period};
+    // the tree without the unfinalized blocks is still valid, they are
+    // received again
+    if (auto res = block_tree.loadSnapshot(); not res) {
+      block_tree.log_->warn("Unfinalized blocks are not restored: {}",
+                            res.error().message());
+    }
     return std::make_shared<BlockTreeImpl>(std::move(block_tree));
   }
 
+  outcome::result<void> BlockTreeImpl::loadSnapshot() {
+    OUTCOME_TRY(encoded, storage_->getBlockTreeSnapshot());
+    if (not encoded) {
+      return outcome::success();
+    }
+    OUTCOME_TRY(snapshot, scale::decode<Snapshot>(*encoded));
+    if (snapshot.root != tree_->block_hash) {
+      log_->info("Snapshot of the block tree is skipped, as it is taken "
+                 "before the finalization of block {}",
+                 tree_->block_hash.toHex());
+      return outcome::success();
+    }
+    std::vector<TreeNode *> nodes{tree_};
+    nodes.reserve(snapshot.nodes.size() + 1);
+    for (const auto &node : snapshot.nodes) {
+      if (node.parent >= nodes.size()) {
+        return Error::INVALID_SNAPSHOT;
+      }
+      insertNode(*nodes[node.parent], node.hash, node.number);
+      nodes.push_back(getNode(node.hash));
+    }
+    log_->info("Restored {} unfinalized blocks in {} leaves",
+               snapshot.nodes.size(),
+               tree_meta_->leaves.size());
+    return outcome::success();
+  }
+
+  outcome::result<void> BlockTreeImpl::storeSnapshot() const {
+    Snapshot snapshot{tree_->block_hash, {}};
+    // the root and then the nodes in the order of the snapshot, so that the
+    // index of a node in it is the one the children refer to
+    std::vector<const TreeNode *> queue{tree_};
+    for (size_t index = 0; index < queue.size(); ++index) {
+      for (auto child : queue[index]->children) {
+        snapshot.nodes.push_back(SnapshotNode{
+            child->block_hash, child->depth, static_cast<uint32_t>(index)});
+        queue.push_back(child);
+      }
+    }
+    OUTCOME_TRY(encoded, scale::encode(snapshot));
+    return storage_->setBlockTreeSnapshot(Buffer{std::move(encoded)});
+  }
+
   BlockTreeImpl::BlockTreeImpl(
       std::shared_ptr<BlockHeaderRepository> header_repo,
       std::shared_ptr<BlockStorage> storage,
-      std::shared_ptr<TreeNode> tree,
-      std::shared_ptr<TreeMeta> meta,
+      const primitives::BlockInfo &last_finalized,
       std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner,
+      primitives::BlockNumber state_pruning_depth,
+      std::shared_ptr<subscription::ChainEvents> chain_events,
+      primitives::BlockNumber blocks_pruning_depth,
+      primitives::BlockNumber justification_period)
       : header_repo_{std::move(header_repo)},
         storage_{std::move(storage)},
-        tree_{std::move(tree)},
-        tree_meta_{std::move(meta)},
         extrinsic_observer_{std::move(extrinsic_observer)},
-        hasher_{std::move(hasher)} {}
+        hasher_{std::move(hasher)},
+        state_pruner_{std::move(state_pruner)},
+        state_pruning_depth_{state_pruning_depth},
+        chain_events_{std::move(chain_events)},
+        blocks_pruning_depth_{blocks_pruning_depth},
+        justification_period_{justification_period} {
+    tree_ = &nodes_
+                 .emplace(last_finalized.block_hash,
+                          TreeNode{last_finalized.block_hash,
+                                   last_finalized.block_number,
+                                   nullptr,
+                                   true})
+                 .first->second;
+    tree_meta_ = std::make_shared<TreeMeta>(*tree_);
+  }
+
+  BlockTreeImpl::TreeNode *BlockTreeImpl::getNode(
+      const primitives::BlockHash &hash) {
+    auto it = nodes_.find(hash);
+    return it == nodes_.end() ? nullptr : &it->second;
+  }
+
+  const BlockTreeImpl::TreeNode *BlockTreeImpl::getNode(
+      const primitives::BlockHash &hash) const {
+    auto it = nodes_.find(hash);
+    return it == nodes_.end() ? nullptr : &it->second;
+  }
+
+  primitives::BlockNumber BlockTreeImpl::skipHeight(
+      primitives::BlockNumber height) {
+    auto clear_lowest_bit = [](primitives::BlockNumber n) {
+      return n & (n - 1);
+    };
+    if (height < 2) {
+      return 0;
+    }
+    // odd heights skip further than the even ones, so that walks combine
+    // long and short skips
+    return (height & 1) != 0
+               ? clear_lowest_bit(clear_lowest_bit(height - 1)) + 1
+               : clear_lowest_bit(height);
+  }
+
+  const BlockTreeImpl::TreeNode *BlockTreeImpl::getAncestor(
+      const TreeNode *node, primitives::BlockNumber height) {
+    BOOST_ASSERT(node->height >= height);
+    while (node->height > height) {
+      auto skip_height = skipHeight(node->height);
+      auto parent_skip_height = skipHeight(node->height - 1);
+      // the skip is not taken if it overshoots, or if the skip of the parent
+      // is much longer and does not overshoot. The ancestors at or above the
+      // height are in the tree, so the skip is not dangling when taken
+      if (node->skip != nullptr
+          and (skip_height == height
+               or (skip_height > height
+                   and not(parent_skip_height + 2 < skip_height
+                           and parent_skip_height >= height)))) {
+        node = node->skip;
+      } else {
+        node = node->parent;
+      }
+    }
+    return node;
+  }
+
+  const BlockTreeImpl::TreeNode *BlockTreeImpl::getDeepestAncestor(
+      const TreeNode *node, primitives::BlockNumber max_depth) const {
+    if (tree_->depth > max_depth) {
+      return nullptr;
+    }
+    while (node->depth > max_depth) {
+      // the skips, which are not below the root, are in the tree
+      if (node->skip != nullptr and skipHeight(node->height) >= tree_->height
+          and node->skip->depth > max_depth) {
+        node = node->skip;
+      } else {
+        node = node->parent;
+      }
+    }
+    return node;
+  }
+
+  void BlockTreeImpl::insertNode(TreeNode &parent,
+                                 const primitives::BlockHash &hash,
+                                 primitives::BlockNumber number) {
+    auto [it, inserted] = nodes_.emplace(hash, TreeNode{hash, number, &parent});
+    if (not inserted) {
+      // the block is in the tree already
+      return;
+    }
+    auto &new_node = it->second;
+    parent.children.push_back(&new_node);
+    if (auto skip_height = skipHeight(new_node.height);
+        skip_height >= tree_->height) {
+      new_node.skip = getAncestor(&parent, skip_height);
+    }
+
+    tree_meta_->addLeaf(new_node);
+  }
+
+  void BlockTreeImpl::eraseSubtree(TreeNode *node,
+                                   std::vector<primitives::BlockInfo> &erased) {
+    std::vector<TreeNode *> to_erase{node};
+    while (not to_erase.empty()) {
+      auto current = to_erase.back();
+      to_erase.pop_back();
+      to_erase.insert(
+          to_erase.end(), current->children.begin(), current->children.end());
+      if (current->children.empty()) {
+        tree_meta_->removeLeaf(*current);
+      }
+      erased.emplace_back(current->depth, current->block_hash);
+      nodes_.erase(current->block_hash);
+    }
+  }
 
   outcome::result<void> BlockTreeImpl::addBlockHeader(
       const primitives::BlockHeader &header) {
-    auto parent = tree_->getByHash(header.parent_hash);
+    auto parent = getNode(header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
     OUTCOME_TRY(block_hash, storage_->putBlockHeader(header));
     // update local meta with the new block
-    auto new_node =
-        std::make_shared<TreeNode>(block_hash, header.number, parent);
-    parent->children.push_back(new_node);
-
-    tree_meta_->leaves.insert(new_node->block_hash);
-    tree_meta_->leaves.erase(parent->block_hash);
-    if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
-      tree_meta_->deepest_leaf = *new_node;
-    }
+    insertNode(*parent, block_hash, header.number);
 
     return outcome::success();
   }
@@ -170,22 +376,18 @@ namespace kagome::blockchain {
       const primitives::Block &block) {
     // first of all, check if we know parent of this block; if not, we cannot
     // insert it
-    auto parent = tree_->getByHash(block.header.parent_hash);
+    auto parent = getNode(block.header.parent_hash);
     if (!parent) {
       return BlockTreeError::NO_PARENT;
     }
     OUTCOME_TRY(block_hash, storage_->putBlock(block));
     // update local meta with the new block
-    auto new_node =
-        std::make_shared<TreeNode>(block_hash, block.header.number, parent);
-    parent->children.push_back(new_node);
+    insertNode(*parent, block_hash, block.header.number);
 
-    tree_meta_->leaves.insert(new_node->block_hash);
-    tree_meta_->leaves.erase(parent->block_hash);
-    if (new_node->depth > tree_meta_->deepest_leaf.get().depth) {
-      tree_meta_->deepest_leaf = *new_node;
+    if (chain_events_
+        and tree_meta_->deepest_leaf.get().block_hash == block_hash) {
+      chain_events_->new_head(block_hash, block.header);
     }
-
     return outcome::success();
   }
 
@@ -200,7 +402,7 @@ namespace kagome::blockchain {
   outcome::result<void> BlockTreeImpl::finalize(
       const primitives::BlockHash &block,
       const primitives::Justification &justification) {
-    auto node = tree_->getByHash(block);
+    auto node = getNode(block);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -214,19 +416,31 @@ namespace kagome::blockchain {
 
     // update our local meta
     node->finalized = true;
+    tree_meta_->last_finalized = *node;
+    auto prev_finalized = tree_->depth;
 
     OUTCOME_TRY(prune(node));
-
     tree_ = node;
 
-    tree_meta_ = std::make_shared<TreeMeta>(*tree_);
-
-    tree_->parent.reset();
+    pruneFinalizedStates(prev_finalized, node->depth);
+    pruneFinalizedBodies(node->depth);
+    pruneFinalizedJustifications(node->depth);
 
     OUTCOME_TRY(storage_->setLastFinalizedBlockHash(node->block_hash));
+    // the snapshot of the previous finalized block is skipped on the restart
+    // if this one is not stored
+    if (auto res = storeSnapshot(); not res) {
+      log_->warn("Unfinalized blocks are not stored: {}",
+                 res.error().message());
+    }
 
     log_->info(
         "Finalized block number {} with hash {}", node->depth, block.toHex());
+
+    if (chain_events_ and not chain_events_->finalized_head.empty()) {
+      OUTCOME_TRY(header, storage_->getBlockHeader(block));
+      chain_events_->finalized_head(block, header);
+    }
     return outcome::success();
   }
 
@@ -245,6 +459,28 @@ namespace kagome::blockchain {
     return storage_->getJustification(block);
   }
 
+  outcome::result<std::pair<primitives::BlockInfo, primitives::Justification>>
+  BlockTreeImpl::getFinalityProof(const primitives::BlockId &block) const {
+    OUTCOME_TRY(header, storage_->getBlockHeader(block));
+    OUTCOME_TRY(hash, header_repo_->getHashById(block));
+    auto last_finalized = getLastFinalized();
+    // the finalized blocks are the ones on the chain of the last finalized
+    // block, so the justified ones above the block on it are its descendants
+    for (auto number = header.number; number <= last_finalized.block_number;
+         number++) {
+      OUTCOME_TRY(justified_hash, header_repo_->getHashByNumber(number));
+      if (number == header.number and justified_hash != hash) {
+        return BlockTreeError::NO_FINALITY_PROOF;
+      }
+      if (auto justification = storage_->getJustification(justified_hash);
+          justification) {
+        return std::make_pair(primitives::BlockInfo{number, justified_hash},
+                              std::move(justification.value()));
+      }
+    }
+    return BlockTreeError::NO_FINALITY_PROOF;
+  }
+
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::getChainByBlock(
       const primitives::BlockHash &block) {
     return getChainByBlocks(tree_meta_->last_finalized.get().block_hash, block);
@@ -307,20 +543,23 @@ namespace kagome::blockchain {
         "not an ancestor of {}";
     std::vector<primitives::BlockHash> result;
 
-    auto top_block_node_ptr = tree_->getByHash(top_block);
-    auto bottom_block_node_ptr = tree_->getByHash(bottom_block);
+    auto top_block_node_ptr = getNode(top_block);
+    auto bottom_block_node_ptr = getNode(bottom_block);
 
     // if both nodes are in our light tree, we can use this representation only
     if (top_block_node_ptr && bottom_block_node_ptr) {
-      auto current_node = bottom_block_node_ptr;
-      while (current_node != top_block_node_ptr) {
+      if (bottom_block_node_ptr->height < top_block_node_ptr->height
+          or getAncestor(bottom_block_node_ptr, top_block_node_ptr->height)
+                 != top_block_node_ptr) {
+        log_->warn(kNotAncestorError.data(), top_block, bottom_block);
+        return BlockTreeError::INCORRECT_ARGS;
+      }
+      result.reserve(bottom_block_node_ptr->height
+                     - top_block_node_ptr->height + 1);
+      for (auto current_node = bottom_block_node_ptr;
+           current_node != top_block_node_ptr;
+           current_node = current_node->parent) {
         result.push_back(current_node->block_hash);
-        if (auto parent = current_node->parent; !parent.expired()) {
-          current_node = parent.lock();
-        } else {
-          log_->warn(kNotAncestorError.data(), top_block, bottom_block);
-          return BlockTreeError::INCORRECT_ARGS;
-        }
       }
       result.push_back(top_block_node_ptr->block_hash);
       std::reverse(result.begin(), result.end());
@@ -343,6 +582,34 @@ namespace kagome::blockchain {
     return result;
   }
 
+  bool BlockTreeImpl::hasDirectChain(
+      const primitives::BlockHash &ancestor,
+      const primitives::BlockHash &descendant) const {
+    if (ancestor == descendant) {
+      return true;
+    }
+    auto ancestor_node = getNode(ancestor);
+    auto descendant_node = getNode(descendant);
+    if (ancestor_node != nullptr) {
+      // the descendants of the blocks in the tree are in the tree too
+      return descendant_node != nullptr
+             and descendant_node->height > ancestor_node->height
+             and getAncestor(descendant_node, ancestor_node->height)
+                     == ancestor_node;
+    }
+
+    // the ancestor is either a finalized block below the root, or not an
+    // ancestor of any block in the tree
+    auto ancestor_number = header_repo_->getNumberByHash(ancestor);
+    if (not ancestor_number
+        or (descendant_node != nullptr
+            and ancestor_number.value() >= tree_->depth)) {
+      return false;
+    }
+    auto hash = walkBackUntilLess(descendant, ancestor_number.value());
+    return hash and hash.value() == ancestor;
+  }
+
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::longestPath() {
     auto &&[_, block_hash] = deepestLeaf();
     return getChainByBlock(block_hash);
@@ -381,7 +648,21 @@ namespace kagome::blockchain {
         return Error::BLOCK_ON_DEAD_END;
       }
     }
+    auto target_node = getNode(target_hash);
     for (auto &leaf_hash : getLeavesSorted()) {
+      if (target_node != nullptr) {
+        // the leaves are in the tree, as well as their ancestors down to the
+        // target
+        const TreeNode *best_node = &nodes_.at(leaf_hash);
+        if (max_number.has_value()) {
+          best_node = getDeepestAncestor(best_node, max_number.value());
+        }
+        if (best_node->height >= target_node->height
+            and getAncestor(best_node, target_node->height) == target_node) {
+          return primitives::BlockInfo{best_node->depth, best_node->block_hash};
+        }
+        continue;
+      }
       auto current_hash = leaf_hash;
       auto best_hash = current_hash;
       if (max_number.has_value()) {
@@ -422,7 +703,7 @@ namespace kagome::blockchain {
 
   BlockTreeImpl::BlockHashVecRes BlockTreeImpl::getChildren(
       const primitives::BlockHash &block) {
-    auto node = tree_->getByHash(block);
+    auto node = getNode(block);
     if (!node) {
       return BlockTreeError::NO_SUCH_BLOCK;
     }
@@ -441,26 +722,25 @@ namespace kagome::blockchain {
     return primitives::BlockInfo{last.depth, last.block_hash};
   }
 
+  outcome::result<void> BlockTreeImpl::resetToLastFinalized() {
+    OUTCOME_TRY(hash, storage_->getLastFinalizedBlockHash());
+    OUTCOME_TRY(header, storage_->getBlockHeader(hash));
+    nodes_.clear();
+    tree_ = &nodes_.emplace(hash, TreeNode{hash, header.number, nullptr, true})
+                 .first->second;
+    tree_meta_ = std::make_shared<TreeMeta>(*tree_);
+    return outcome::success();
+  }
+
   std::vector<primitives::BlockHash> BlockTreeImpl::getLeavesSorted() const {
-    std::vector<primitives::BlockInfo> leaf_depths;
-    auto leaves = getLeaves();
-    leaf_depths.reserve(leaves.size());
-    for (auto &leaf : leaves) {
-      auto leaf_node = tree_->getByHash(leaf);
-      leaf_depths.emplace_back(
-          primitives::BlockInfo{leaf_node->depth, leaf_node->block_hash});
-    }
-    std::sort(leaf_depths.begin(),
-              leaf_depths.end(),
-              [](auto const &p1, auto const &p2) {
-                return p1.block_number > p2.block_number;
-              });
+    // the meta keeps the leaves ordered by their depth already
+    const auto &leaves = tree_meta_->leaves_by_depth;
     std::vector<primitives::BlockHash> leaf_hashes;
-    leaf_hashes.reserve(leaf_depths.size());
-    std::transform(leaf_depths.begin(),
-                   leaf_depths.end(),
+    leaf_hashes.reserve(leaves.size());
+    std::transform(leaves.rbegin(),
+                   leaves.rend(),
                    std::back_inserter(leaf_hashes),
-                   [](auto &p) { return p.block_hash; });
+                   [](const auto &leaf) { return leaf.second->block_hash; });
     return leaf_hashes;
   }
 
@@ -468,6 +748,14 @@ namespace kagome::blockchain {
       const primitives::BlockHash &start,
       const primitives::BlockNumber &limit) const {
     auto current_hash = start;
+    if (auto node = getNode(start); node != nullptr) {
+      if (auto ancestor = getDeepestAncestor(node, limit);
+          ancestor != nullptr) {
+        return ancestor->block_hash;
+      }
+      // the rest of the chain is below the root
+      current_hash = tree_->block_hash;
+    }
     while (true) {
       OUTCOME_TRY(current_header, header_repo_->getBlockHeader(current_hash));
       if (current_header.number <= limit) {
@@ -477,52 +765,69 @@ namespace kagome::blockchain {
     }
   }
 
-  outcome::result<void> BlockTreeImpl::prune(
-      const std::shared_ptr<TreeNode> &lastFinalizedNode) {
-    std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
-        to_remove;
-
-    auto current_node = lastFinalizedNode;
-
-    for (;;) {
-      auto parent_node = current_node->parent.lock();
-      if (!parent_node || parent_node->finalized) {
-        break;
-      }
-
-      auto main_chain_node = current_node;
-      current_node = parent_node;
-
-      // collect hashes for removing (except main chain block)
-      for (const auto &child : current_node->children) {
-        if (child->block_hash != main_chain_node->block_hash) {
-          collectDescendants(child, to_remove);
-          to_remove.emplace_back(child->block_hash, child->depth);
+  outcome::result<void> BlockTreeImpl::prune(TreeNode *lastFinalizedNode) {
+    std::vector<primitives::BlockInfo> to_remove;
+
+    // the finalized ancestors leave the tree, and so do the forks from them,
+    // which won't ever be finalized
+    auto ancestor = lastFinalizedNode->parent;
+    auto chain_hash = lastFinalizedNode->block_hash;
+    lastFinalizedNode->parent = nullptr;
+    while (ancestor != nullptr) {
+      for (auto child : ancestor->children) {
+        if (child->block_hash != chain_hash) {
+          eraseSubtree(child, to_remove);
         }
       }
+      chain_hash = ancestor->block_hash;
+      ancestor = ancestor->parent;
+      nodes_.erase(chain_hash);
+    }
+    if (to_remove.empty()) {
+      return outcome::success();
+    }
 
-      // remove (in memory) all child, except main chain block
-      current_node->children = {main_chain_node};
+    // the data of the blocks is read in a single pass when they are ordered
+    // by their numbers
+    std::sort(to_remove.begin(),
+              to_remove.end(),
+              [](const auto &lhs, const auto &rhs) {
+                return lhs.block_number < rhs.block_number;
+              });
+    auto blocks_data_res = storage_->getBlockDataRange(to_remove);
+    if (not blocks_data_res) {
+      log_->warn("Can't read the data of {} pruned blocks: {}",
+                 to_remove.size(),
+                 blocks_data_res.error().message());
     }
 
     std::vector<primitives::Extrinsic> extrinsics;
-
-    // remove from storage
-    for (const auto &[hash, number] : to_remove) {
-      auto block_body_res = storage_->getBlockBody(hash);
-      if (block_body_res.has_value()) {
-        extrinsics.reserve(extrinsics.size() + block_body_res.value().size());
-        for (auto &&extrinsic : block_body_res.value()) {
-          extrinsics.emplace_back(std::move(extrinsic));
+    if (blocks_data_res) {
+      for (auto &block_data : blocks_data_res.value()) {
+        if (block_data.body) {
+          auto &body = block_data.body.value();
+          extrinsics.insert(extrinsics.end(),
+                            std::make_move_iterator(body.begin()),
+                            std::make_move_iterator(body.end()));
+        }
+        if (state_pruner_ == nullptr) {
+          continue;
+        }
+        // a discarded fork won't ever be built on, so its state is useless
+        if (block_data.header) {
+          pruneState(block_data.header.value());
+        } else if (auto header = storage_->getBlockHeader(block_data.hash);
+                   header) {
+          pruneState(header.value());
         }
       }
-
-      OUTCOME_TRY(storage_->removeBlock(hash, number));
     }
 
+    // removed from storage with a single write
+    OUTCOME_TRY(storage_->removeBlocks(to_remove));
+
     // trying to return back extrinsics to transaction pool
-    for (auto &&extrinsic : extrinsics) {
-      auto result = extrinsic_observer_->onTxMessage(extrinsic);
+    for (auto &result : extrinsic_observer_->onTxMessages(extrinsics)) {
       if (result) {
         log_->debug("Reapplied tx {}", result.value());
       } else {
@@ -533,20 +838,66 @@ namespace kagome::blockchain {
     return outcome::success();
   }
 
-  void BlockTreeImpl::collectDescendants(
-      std::shared_ptr<TreeNode> node,
-      std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
-          &container) {
-    // avoid deep recursion
-    while (node->children.size() == 1) {
-      container.emplace_back(node->block_hash, node->depth);
-      node = node->children.front();
+  void BlockTreeImpl::pruneFinalizedBodies(
+      primitives::BlockNumber new_finalized) {
+    if (blocks_pruning_depth_ == 0 or new_finalized < blocks_pruning_depth_) {
+      return;
+    }
+    auto first_kept = new_finalized - blocks_pruning_depth_ + 1;
+    if (auto res = storage_->pruneBodies(first_kept); not res) {
+      log_->warn("Bodies of the blocks below {} are not pruned: {}",
+                 first_kept,
+                 res.error().message());
     }
+  }
 
-    // collect descendants' hashes recursively
-    for (const auto &child : node->children) {
-      collectDescendants(child, container);
-      container.emplace_back(child->block_hash, child->depth);
+  void BlockTreeImpl::pruneFinalizedJustifications(
+      primitives::BlockNumber new_finalized) {
+    if (justification_period_ == 0) {
+      return;
+    }
+    // the justification of the last finalized block proves the finality of
+    // the blocks above the last kept one, so it is never pruned
+    if (auto res =
+            storage_->pruneJustifications(new_finalized, justification_period_);
+        not res) {
+      log_->warn("Justifications of the blocks below {} are not pruned: {}",
+                 new_finalized,
+                 res.error().message());
+    }
+  }
+
+  void BlockTreeImpl::pruneFinalizedStates(
+      primitives::BlockNumber prev_finalized,
+      primitives::BlockNumber new_finalized) {
+    if (state_pruner_ == nullptr or new_finalized < state_pruning_depth_) {
+      return;
+    }
+    // the states of blocks up to prev_finalized - depth are already pruned
+    primitives::BlockNumber first = 0;
+    if (prev_finalized >= state_pruning_depth_) {
+      first = prev_finalized - state_pruning_depth_ + 1;
+    }
+    primitives::BlockNumber last = new_finalized - state_pruning_depth_;
+    for (auto number = first; number <= last; number++) {
+      auto header = header_repo_->getBlockHeader(number);
+      if (not header) {
+        log_->warn("Can't prune the state of block #{}: {}",
+                   number,
+                   header.error().message());
+        continue;
+      }
+      pruneState(header.value());
+    }
+  }
+
+  void BlockTreeImpl::pruneState(const primitives::BlockHeader &header) {
+    auto res = state_pruner_->pruneState(common::Buffer{header.state_root});
+    if (not res) {
+      log_->warn("Can't prune the state of block #{} with root {}: {}",
+                 header.number,
+                 header.state_root.toHex(),
+                 res.error().message());
     }
   }
 
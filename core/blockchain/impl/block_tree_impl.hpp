@@ -11,15 +11,18 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <memory>
-#include <queue>
-#include <unordered_set>
+#include <set>
+#include <unordered_map>
 
 #include "blockchain/block_header_repository.hpp"
 #include "blockchain/block_storage.hpp"
 #include "blockchain/impl/common.hpp"
+#include "common/flat_hash_map.hpp"
 #include "common/logger.hpp"
 #include "crypto/hasher.hpp"
 #include "network/extrinsic_observer.hpp"
+#include "storage/trie/trie_pruner.hpp"
+#include "subscription/chain_events.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
 namespace kagome::blockchain {
@@ -30,28 +33,33 @@ namespace kagome::blockchain {
     /**
      * In-memory light representation of the tree, used for efficiency and usage
      * convenience - we would only ask the database for some info, when directly
-     * requested
+     * requested. The nodes are owned by the index of the tree, which keeps
+     * their addresses stable, so they refer to each other by raw pointers.
+     * Besides the parent, each node refers to an ancestor at skipHeight() of
+     * its height, so that ancestors are found in logarithmic time
      */
-    struct TreeNode : public std::enable_shared_from_this<TreeNode> {
+    struct TreeNode {
       TreeNode(primitives::BlockHash hash,
                primitives::BlockNumber depth,
-               const std::shared_ptr<TreeNode> &parent,
+               TreeNode *parent,
                bool finalized = false);
 
       primitives::BlockHash block_hash;
       primitives::BlockNumber depth;
+      // depth of the root plus the number of the parents up to it, which is
+      // the depth for a valid chain, but is counted apart for the skips to
+      // rely on
+      primitives::BlockNumber height;
 
-      std::weak_ptr<TreeNode> parent;
+      // nullptr for the root of the tree
+      TreeNode *parent;
+      // ancestor at skipHeight(height), nullptr if it was below the root when
+      // the node was added
+      const TreeNode *skip = nullptr;
 
       bool finalized;
 
-      std::vector<std::shared_ptr<TreeNode>> children{};
-
-      /**
-       * Get a node of the tree, containing block with the specified hash, if it
-       * can be found
-       */
-      std::shared_ptr<TreeNode> getByHash(const primitives::BlockHash &hash);
+      std::vector<TreeNode *> children{};
 
       bool operator==(const TreeNode &other) const;
       bool operator!=(const TreeNode &other) const;
@@ -59,16 +67,26 @@ namespace kagome::blockchain {
 
     /**
      * Useful information about the tree & blocks it contains to make some of
-     * the operations faster
+     * the operations faster. It is kept up to date as the nodes are added and
+     * removed, so that it is never rebuilt from the whole tree
      */
     struct TreeMeta {
       explicit TreeMeta(TreeNode &subtree_root_node);
 
-      TreeMeta(std::unordered_set<primitives::BlockHash> leaves,
-               TreeNode &deepest_leaf,
-               TreeNode &last_finalized);
+      /**
+       * Makes \param node a leaf in place of its parent
+       */
+      void addLeaf(TreeNode &node);
+
+      /**
+       * Drops \param node from the leaves, the deepest of the rest becomes
+       * the deepest leaf if it was the one
+       */
+      void removeLeaf(TreeNode &node);
 
-      std::unordered_set<primitives::BlockHash> leaves;
+      common::FlatHashSet<primitives::BlockHash> leaves;
+      // the same leaves ordered by their depth
+      std::set<std::pair<primitives::BlockNumber, TreeNode *>> leaves_by_depth;
       std::reference_wrapper<TreeNode> deepest_leaf;
 
       std::reference_wrapper<TreeNode> last_finalized;
@@ -82,7 +100,9 @@ namespace kagome::blockchain {
       BLOCK_ON_DEAD_END,
       // block exists in chain but not found when following all
       // leaves backwards.
-      BLOCK_NOT_FOUND
+      BLOCK_NOT_FOUND,
+      // stored snapshot of the tree refers to a parent not before the block
+      INVALID_SNAPSHOT
     };
 
     /**
@@ -92,6 +112,17 @@ namespace kagome::blockchain {
      * @param last_finalized_block - last finalized block, from which the tree
      * is going to grow
      * @param hasher - pointer to the hasher
+     * @param state_pruner - pruner of the block states, nullptr if states are
+     * never pruned
+     * @param state_pruning_depth - number of the latest finalized blocks, which
+     * states are kept, the states of discarded forks are pruned right away
+     * @param chain_events - events the new best and the finalized blocks are
+     * raised on, nullptr if nobody listens to them
+     * @param blocks_pruning_depth - number of the latest finalized blocks,
+     * which bodies are kept, 0 if bodies are never pruned
+     * @param justification_period - justifications of the finalized blocks
+     * with the numbers divisible by it are kept along with the ones of the
+     * authority set changes, the rest are pruned, 0 if all are kept
      * @return ptr to the created instance or error
      */
     static outcome::result<std::shared_ptr<BlockTreeImpl>> create(
@@ -99,7 +130,19 @@ namespace kagome::blockchain {
         std::shared_ptr<BlockStorage> storage,
         const primitives::BlockId &last_finalized_block,
         std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner = nullptr,
+        primitives::BlockNumber state_pruning_depth = 0,
+        std::shared_ptr<subscription::ChainEvents> chain_events = nullptr,
+        primitives::BlockNumber blocks_pruning_depth = 0,
+        primitives::BlockNumber justification_period = 0);
+
+    // the nodes refer to each other by their addresses, which a move keeps,
+    // but a copy does not
+    BlockTreeImpl(BlockTreeImpl &&) = default;
+    BlockTreeImpl(const BlockTreeImpl &) = delete;
+    BlockTreeImpl &operator=(BlockTreeImpl &&) = delete;
+    BlockTreeImpl &operator=(const BlockTreeImpl &) = delete;
 
     ~BlockTreeImpl() override = default;
 
@@ -112,6 +155,9 @@ namespace kagome::blockchain {
     outcome::result<primitives::Justification> getBlockJustification(
         const primitives::BlockId &block) const override;
 
+    outcome::result<std::pair<primitives::BlockInfo, primitives::Justification>>
+    getFinalityProof(const primitives::BlockId &block) const override;
+
     outcome::result<void> addBlockHeader(
         const primitives::BlockHeader &header) override;
 
@@ -136,6 +182,9 @@ namespace kagome::blockchain {
         const primitives::BlockHash &top_block,
         const primitives::BlockHash &bottom_block) override;
 
+    bool hasDirectChain(const primitives::BlockHash &ancestor,
+                        const primitives::BlockHash &descendant) const override;
+
     BlockHashVecRes longestPath() override;
 
     primitives::BlockInfo deepestLeaf() const override;
@@ -151,6 +200,17 @@ namespace kagome::blockchain {
 
     primitives::BlockInfo getLastFinalized() const override;
 
+    outcome::result<void> resetToLastFinalized() override;
+
+    /**
+     * Stores the snapshot of the unfinalized blocks of the tree, which are
+     * the descendants of the last finalized one, so that the tree is created
+     * with all of them on the restart, rather than with the last finalized
+     * block alone. The snapshot is taken on each finalization, and should be
+     * taken at the shutdown
+     */
+    outcome::result<void> storeSnapshot() const;
+
    private:
     /**
      * Private constructor, so that instances are created only through the
@@ -159,10 +219,21 @@ namespace kagome::blockchain {
     BlockTreeImpl(
         std::shared_ptr<BlockHeaderRepository> header_repo,
         std::shared_ptr<BlockStorage> storage,
-        std::shared_ptr<TreeNode> tree,
-        std::shared_ptr<TreeMeta> meta,
+        const primitives::BlockInfo &last_finalized,
         std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<storage::trie::TriePruner> state_pruner,
+        primitives::BlockNumber state_pruning_depth,
+        std::shared_ptr<subscription::ChainEvents> chain_events,
+        primitives::BlockNumber blocks_pruning_depth,
+        primitives::BlockNumber justification_period);
+
+    /**
+     * Adds the blocks of the stored snapshot to the tree, if the snapshot was
+     * taken of the tree grown from the same last finalized block, it is
+     * skipped otherwise
+     */
+    outcome::result<void> loadSnapshot();
 
     /**
      * Walks the chain backwards starting from \param start until the current
@@ -177,23 +248,103 @@ namespace kagome::blockchain {
      */
     std::vector<primitives::BlockHash> getLeavesSorted() const;
 
-    static void collectDescendants(
-        std::shared_ptr<TreeNode> node,
-        std::vector<std::pair<primitives::BlockHash, primitives::BlockNumber>>
-            &container);
+    /**
+     * @return node of the block with \param hash, nullptr if the block is
+     * not in the tree
+     */
+    TreeNode *getNode(const primitives::BlockHash &hash);
+    const TreeNode *getNode(const primitives::BlockHash &hash) const;
+
+    /**
+     * @return height of the ancestor the node at \param height skips to,
+     * which is chosen so that any ancestor is reached in O(log(height)) skips
+     */
+    static primitives::BlockNumber skipHeight(primitives::BlockNumber height);
+
+    /**
+     * @return ancestor of \param node at \param height, which is not above
+     * the node and not below the root of the tree
+     */
+    static const TreeNode *getAncestor(const TreeNode *node,
+                                       primitives::BlockNumber height);
+
+    /**
+     * @return the deepest of \param node and its ancestors, which is not
+     * deeper than \param max_depth, nullptr if there is none in the tree
+     */
+    const TreeNode *getDeepestAncestor(const TreeNode *node,
+                                       primitives::BlockNumber max_depth) const;
+
+    /**
+     * Adds a node of block \param hash with \param number as a child of
+     * \param parent, updating the meta of the tree, unless the block is in
+     * the tree already
+     */
+    void insertNode(TreeNode &parent,
+                    const primitives::BlockHash &hash,
+                    primitives::BlockNumber number);
+
+    /**
+     * Removes \param node and its descendants from the index of the tree and
+     * from its meta
+     * @param erased the erased blocks are appended to
+     */
+    void eraseSubtree(TreeNode *node,
+                      std::vector<primitives::BlockInfo> &erased);
+
+    /**
+     * Removes the ancestors of \param lastFinalizedNode from the tree, as
+     * well as the forks from them, which are also removed from the storage
+     * with a single write. Costs the number of the removed blocks, not the
+     * size of the tree
+     */
+    outcome::result<void> prune(TreeNode *lastFinalizedNode);
+
+    /**
+     * Prunes the states of the finalized blocks, which got deeper than the
+     * pruning depth, when finality moves from \param prev_finalized to
+     * \param new_finalized
+     */
+    void pruneFinalizedStates(primitives::BlockNumber prev_finalized,
+                              primitives::BlockNumber new_finalized);
+
+    /**
+     * Prunes the bodies of the finalized blocks, which got deeper than the
+     * pruning depth, when finality moves to \param new_finalized, failures
+     * are only logged, as the bodies are pruned on the next finalization
+     */
+    void pruneFinalizedBodies(primitives::BlockNumber new_finalized);
+
+    /**
+     * Prunes the justifications of the blocks finalized before \param
+     * new_finalized, which are not needed as finality proofs, failures are
+     * only logged, as the justifications are pruned on the next finalization
+     */
+    void pruneFinalizedJustifications(primitives::BlockNumber new_finalized);
 
-    outcome::result<void> prune(
-        const std::shared_ptr<TreeNode> &lastFinalizedNode);
+    /**
+     * Prunes the state of the block with \param header, failures are only
+     * logged, as they leave some unreachable nodes in the storage at worst
+     */
+    void pruneState(const primitives::BlockHeader &header);
 
     std::shared_ptr<BlockHeaderRepository> header_repo_;
     std::shared_ptr<BlockStorage> storage_;
 
-    std::shared_ptr<TreeNode> tree_;
+    // all nodes of the tree by the hashes of their blocks
+    std::unordered_map<primitives::BlockHash, TreeNode> nodes_;
+    // the root of the tree, which is the last finalized block
+    TreeNode *tree_;
     std::shared_ptr<TreeMeta> tree_meta_;
 
     std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer_;
 
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<storage::trie::TriePruner> state_pruner_;
+    primitives::BlockNumber state_pruning_depth_;
+    std::shared_ptr<subscription::ChainEvents> chain_events_;
+    primitives::BlockNumber blocks_pruning_depth_;
+    primitives::BlockNumber justification_period_;
     common::Logger log_ = common::createLogger("BlockTreeImpl");
   };
 }  // namespace kagome::blockchain
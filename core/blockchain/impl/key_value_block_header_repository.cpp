@@ -22,13 +22,21 @@ namespace kagome::blockchain {
 
   KeyValueBlockHeaderRepository::KeyValueBlockHeaderRepository(
       std::shared_ptr<storage::BufferStorage> map,
-      std::shared_ptr<crypto::Hasher> hasher)
-      : map_{std::move(map)}, hasher_{std::move(hasher)} {
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache)
+      : map_{std::move(map)},
+        hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)} {
     BOOST_ASSERT(hasher_);
   }
 
   outcome::result<BlockNumber> KeyValueBlockHeaderRepository::getNumberByHash(
       const Hash256 &hash) const {
+    if (header_cache_) {
+      if (auto header = header_cache_->get(hash)) {
+        return header->number;
+      }
+    }
     OUTCOME_TRY(key, idToLookupKey(*map_, hash));
 
     auto maybe_number = lookupKeyToNumber(key);
@@ -39,20 +47,47 @@ namespace kagome::blockchain {
   outcome::result<common::Hash256>
   KeyValueBlockHeaderRepository::getHashByNumber(
       const primitives::BlockNumber &number) const {
-    OUTCOME_TRY(header, getBlockHeader(number));
-    OUTCOME_TRY(enc_header, scale::encode(header));
-    return hasher_->blake2b_256(enc_header);
+    // the lookup key contains the hash, so the header is not encoded and
+    // hashed again, it is only read to make sure the block is stored
+    OUTCOME_TRY(key, idToLookupKey(*map_, number));
+    OUTCOME_TRY(hash, lookupKeyToHash(key));
+    OUTCOME_TRY(getHeaderByLookupKey(hash, key));
+    return hash;
   }
 
   outcome::result<primitives::BlockHeader>
   KeyValueBlockHeaderRepository::getBlockHeader(const BlockId &id) const {
-    auto header_res = getWithPrefix(*map_, Prefix::HEADER, id);
+    if (header_cache_) {
+      if (auto hash = boost::get<Hash256>(&id)) {
+        if (auto header = header_cache_->get(*hash)) {
+          return std::move(header.value());
+        }
+      }
+    }
+    OUTCOME_TRY(key, idToLookupKey(*map_, id));
+    OUTCOME_TRY(hash, lookupKeyToHash(key));
+    return getHeaderByLookupKey(hash, key);
+  }
+
+  outcome::result<primitives::BlockHeader>
+  KeyValueBlockHeaderRepository::getHeaderByLookupKey(
+      const Hash256 &hash, const common::Buffer &lookup_key) const {
+    if (header_cache_) {
+      if (auto header = header_cache_->get(hash)) {
+        return std::move(header.value());
+      }
+    }
+    auto header_res = map_->get(prependPrefix(lookup_key, Prefix::HEADER));
     if (!header_res) {
       return (isNotFoundError(header_res.error())) ? Error::BLOCK_NOT_FOUND
                                                    : header_res.error();
     }
-
-    return scale::decode<primitives::BlockHeader>(header_res.value());
+    OUTCOME_TRY(header,
+                scale::decode<primitives::BlockHeader>(header_res.value()));
+    if (header_cache_) {
+      header_cache_->put(hash, header);
+    }
+    return std::move(header);
   }
 
   outcome::result<BlockStatus> KeyValueBlockHeaderRepository::getBlockStatus(
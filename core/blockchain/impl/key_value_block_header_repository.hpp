@@ -8,6 +8,7 @@
 
 #include "blockchain/block_header_repository.hpp"
 
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "crypto/hasher.hpp"
 
@@ -15,8 +16,13 @@ namespace kagome::blockchain {
 
   class KeyValueBlockHeaderRepository : public BlockHeaderRepository {
    public:
-    KeyValueBlockHeaderRepository(std::shared_ptr<storage::BufferStorage> map,
-                                  std::shared_ptr<crypto::Hasher> hasher);
+    /**
+     * @param header_cache keeps the recently used decoded headers, if any
+     */
+    KeyValueBlockHeaderRepository(
+        std::shared_ptr<storage::BufferStorage> map,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr);
 
     ~KeyValueBlockHeaderRepository() override = default;
 
@@ -33,8 +39,16 @@ namespace kagome::blockchain {
         -> outcome::result<blockchain::BlockStatus> override;
 
    private:
+    /**
+     * @return header of the block with \arg hash stored by \arg lookup_key,
+     * taken from the header cache if it is there
+     */
+    outcome::result<primitives::BlockHeader> getHeaderByLookupKey(
+        const common::Hash256 &hash, const common::Buffer &lookup_key) const;
+
     std::shared_ptr<storage::BufferStorage> map_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
   };
 
 }  // namespace kagome::blockchain
@@ -5,7 +5,10 @@
 
 #include "blockchain/impl/key_value_block_storage.hpp"
 
+#include <algorithm>
+
 #include "blockchain/impl/storage_util.hpp"
+#include "primitives/block_header_view.hpp"
 #include "scale/scale.hpp"
 #include "storage/database_error.hpp"
 
@@ -38,9 +41,15 @@ namespace kagome::blockchain {
 
   KeyValueBlockStorage::KeyValueBlockStorage(
       std::shared_ptr<storage::BufferStorage> storage,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<BlockHeaderCache> header_cache,
+      std::shared_ptr<BlockFreezer> freezer,
+      std::shared_ptr<common::Tracer> tracer)
       : storage_{std::move(storage)},
         hasher_{std::move(hasher)},
+        header_cache_{std::move(header_cache)},
+        freezer_{std::move(freezer)},
+        tracer_{std::move(tracer)},
         logger_{common::createLogger("Block Storage:")} {}
 
   outcome::result<std::shared_ptr<KeyValueBlockStorage>>
@@ -48,21 +57,34 @@ namespace kagome::blockchain {
       common::Buffer state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       const std::shared_ptr<crypto::Hasher> &hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      const std::shared_ptr<BlockHeaderCache> &header_cache,
+      const std::shared_ptr<BlockFreezer> &freezer,
+      const std::shared_ptr<common::Tracer> &tracer) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, hasher));
+        KeyValueBlockStorage(storage, hasher, header_cache, freezer, tracer));
 
     auto last_finalized_block_hash_res =
         block_storage->getLastFinalizedBlockHash();
 
     if (last_finalized_block_hash_res.has_value()) {
-      return loadExisting(storage, hasher, on_finalized_block_found);
+      return loadExisting(storage,
+                          hasher,
+                          on_finalized_block_found,
+                          header_cache,
+                          freezer,
+                          tracer);
     }
 
     if (last_finalized_block_hash_res
         == outcome::failure(Error::FINALIZED_BLOCK_NOT_FOUND)) {
-      return createWithGenesis(
-          std::move(state_root), storage, hasher, on_finalized_block_found);
+      return createWithGenesis(std::move(state_root),
+                               storage,
+                               hasher,
+                               on_finalized_block_found,
+                               header_cache,
+                               freezer,
+                               tracer);
     }
 
     return last_finalized_block_hash_res.error();
@@ -72,9 +94,16 @@ namespace kagome::blockchain {
   KeyValueBlockStorage::loadExisting(
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_finalized_block_found) {
+      const BlockHandler &on_finalized_block_found,
+      std::shared_ptr<BlockHeaderCache> header_cache,
+      std::shared_ptr<BlockFreezer> freezer,
+      std::shared_ptr<common::Tracer> tracer) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(storage,
+                             std::move(hasher),
+                             std::move(header_cache),
+                             std::move(freezer),
+                             std::move(tracer)));
 
     OUTCOME_TRY(last_finalized_block_hash,
                 block_storage->getLastFinalizedBlockHash());
@@ -95,9 +124,16 @@ namespace kagome::blockchain {
       common::Buffer state_root,
       const std::shared_ptr<storage::BufferStorage> &storage,
       std::shared_ptr<crypto::Hasher> hasher,
-      const BlockHandler &on_genesis_created) {
+      const BlockHandler &on_genesis_created,
+      std::shared_ptr<BlockHeaderCache> header_cache,
+      std::shared_ptr<BlockFreezer> freezer,
+      std::shared_ptr<common::Tracer> tracer) {
     auto block_storage = std::make_shared<KeyValueBlockStorage>(
-        KeyValueBlockStorage(storage, std::move(hasher)));
+        KeyValueBlockStorage(storage,
+                             std::move(hasher),
+                             std::move(header_cache),
+                             std::move(freezer),
+                             std::move(tracer)));
 
     OUTCOME_TRY(block_storage->ensureGenesisNotExists());
 
@@ -127,6 +163,13 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockHeader> KeyValueBlockStorage::getBlockHeader(
       const primitives::BlockId &id) const {
+    if (header_cache_) {
+      if (auto hash = boost::get<primitives::BlockHash>(&id)) {
+        if (auto header = header_cache_->get(*hash)) {
+          return std::move(header.value());
+        }
+      }
+    }
     OUTCOME_TRY(encoded_header, getWithPrefix(*storage_, Prefix::HEADER, id));
     OUTCOME_TRY(header, scale::decode<primitives::BlockHeader>(encoded_header));
     return std::move(header);
@@ -143,13 +186,29 @@ namespace kagome::blockchain {
 
   outcome::result<primitives::BlockData> KeyValueBlockStorage::getBlockData(
       const primitives::BlockId &id) const {
-    OUTCOME_TRY(encoded_block_data,
-                getWithPrefix(*storage_, Prefix::BLOCK_DATA, id));
+    auto encoded_res = getWithPrefix(*storage_, Prefix::BLOCK_DATA, id);
+    if (not encoded_res and freezer_
+        and isNotFoundError(encoded_res.error())) {
+      OUTCOME_TRY(frozen, getFrozenBlockData(id));
+      if (frozen) {
+        encoded_res = std::move(frozen.value());
+      }
+    }
+    OUTCOME_TRY(encoded_block_data, encoded_res);
     OUTCOME_TRY(block_data,
                 scale::decode<primitives::BlockData>(encoded_block_data));
     return std::move(block_data);
   }
 
+  outcome::result<boost::optional<common::Buffer>>
+  KeyValueBlockStorage::getFrozenBlockData(
+      const primitives::BlockId &id) const {
+    OUTCOME_TRY(lookup_key, idToLookupKey(*storage_, id));
+    OUTCOME_TRY(number, lookupKeyToNumber(lookup_key));
+    OUTCOME_TRY(hash, lookupKeyToHash(lookup_key));
+    return freezer_->get(number, hash);
+  }
+
   outcome::result<primitives::Justification>
   KeyValueBlockStorage::getJustification(
       const primitives::BlockId &block) const {
@@ -160,19 +219,93 @@ namespace kagome::blockchain {
     return Error::JUSTIFICATION_DOES_NOT_EXIST;
   }
 
+  outcome::result<std::vector<primitives::BlockData>>
+  KeyValueBlockStorage::getBlockDataRange(
+      const std::vector<primitives::BlockInfo> &blocks) const {
+    std::vector<primitives::BlockData> range;
+    range.reserve(blocks.size());
+    // keys of the data start with the numbers of the blocks, so the data of
+    // consecutive blocks is next to each other, and the cursor mostly steps
+    // to the next entry instead of looking the key up; the blocks are read
+    // one by one if the storage has no cursors
+    auto cursor = storage_->cursor();
+    auto at_key = [&cursor](const Buffer &key) -> outcome::result<bool> {
+      if (not cursor->isValid()) {
+        return false;
+      }
+      OUTCOME_TRY(cursor_key, cursor->key());
+      return cursor_key == key;
+    };
+    for (const auto &block : blocks) {
+      auto key = prependPrefix(
+          numberAndHashToLookupKey(block.block_number, block.block_hash),
+          Prefix::BLOCK_DATA);
+      bool found = false;
+      if (cursor != nullptr) {
+        OUTCOME_TRY(at_next, at_key(key));
+        found = at_next;
+        if (not found) {
+          OUTCOME_TRY(cursor->seek(key));
+          OUTCOME_TRY(at_seeked, at_key(key));
+          found = at_seeked;
+        }
+      }
+      if (found) {
+        OUTCOME_TRY(encoded_block_data, cursor->value());
+        OUTCOME_TRY(block_data,
+                    scale::decode<primitives::BlockData>(encoded_block_data));
+        range.emplace_back(std::move(block_data));
+        OUTCOME_TRY(cursor->next());
+        continue;
+      }
+      // the number is wrong or the data is frozen
+      auto block_data_res = getBlockData(block.block_hash);
+      if (block_data_res) {
+        range.emplace_back(std::move(block_data_res.value()));
+      } else if (block_data_res
+                     == outcome::failure(blockchain::Error::BLOCK_NOT_FOUND)
+                 or isNotFoundError(block_data_res.error())) {
+        range.emplace_back(primitives::BlockData{block.block_hash});
+      } else {
+        return block_data_res.error();
+      }
+    }
+    return range;
+  }
+
   outcome::result<primitives::BlockHash> KeyValueBlockStorage::putBlockHeader(
       const primitives::BlockHeader &header) {
     OUTCOME_TRY(encoded_header, scale::encode(header));
     auto block_hash = hasher_->blake2b_256(encoded_header);
-    OUTCOME_TRY(putWithPrefix(*storage_,
-                              Prefix::HEADER,
-                              header.number,
-                              block_hash,
-                              Buffer{std::move(encoded_header)}));
+    auto batch = storage_->batch();
+    OUTCOME_TRY(putEncodedBlockHeader(
+        *batch, header.number, block_hash, Buffer{std::move(encoded_header)}));
+    OUTCOME_TRY(batch->commit());
+    if (header_cache_) {
+      header_cache_->put(block_hash, header);
+    }
     return block_hash;
   }
 
+  outcome::result<void> KeyValueBlockStorage::putEncodedBlockHeader(
+      storage::BufferBatch &batch,
+      primitives::BlockNumber block_number,
+      const primitives::BlockHash &block_hash,
+      const common::Buffer &encoded_header) {
+    return putWithPrefix(
+        batch, Prefix::HEADER, block_number, block_hash, encoded_header);
+  }
+
+  outcome::result<void> KeyValueBlockStorage::putBlockData(
+      primitives::BlockNumber block_number,
+      const primitives::BlockData &block_data) {
+    auto batch = storage_->batch();
+    OUTCOME_TRY(putBlockData(*batch, block_number, block_data));
+    return batch->commit();
+  }
+
   outcome::result<void> KeyValueBlockStorage::putBlockData(
+      storage::BufferBatch &batch,
       primitives::BlockNumber block_number,
       const primitives::BlockData &block_data) {
     primitives::BlockData to_insert;
@@ -201,7 +334,7 @@ namespace kagome::blockchain {
     }
 
     OUTCOME_TRY(encoded_block_data, scale::encode(to_insert));
-    OUTCOME_TRY(putWithPrefix(*storage_,
+    OUTCOME_TRY(putWithPrefix(batch,
                               Prefix::BLOCK_DATA,
                               block_number,
                               block_data.hash,
@@ -214,7 +347,10 @@ namespace kagome::blockchain {
     // TODO(xDimon): Need to implement mechanism for wipe out orphan blocks
     //  (in side-chains whom rejected by finalization)
     //  for avoid leaks of storage space
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+    common::Tracer::Scope span{tracer_.get(), "storage", "put_block"};
+    // the header is encoded and hashed once, both are needed to store it
+    OUTCOME_TRY(encoded_header, scale::encode(block.header));
+    auto block_hash = hasher_->blake2b_256(encoded_header);
     auto block_in_storage_res =
         getWithPrefix(*storage_, Prefix::HEADER, block_hash);
     if (block_in_storage_res.has_value()) {
@@ -225,15 +361,24 @@ namespace kagome::blockchain {
       return block_in_storage_res.error();
     }
 
-    // insert our block's parts into the database-
-    OUTCOME_TRY(putBlockHeader(block.header));
+    // insert our block's parts into the database with a single write, so
+    // that a header is never stored without its body
+    auto batch = storage_->batch();
+    OUTCOME_TRY(putEncodedBlockHeader(*batch,
+                                      block.header.number,
+                                      block_hash,
+                                      Buffer{std::move(encoded_header)}));
 
     primitives::BlockData block_data;
     block_data.hash = block_hash;
     block_data.header = block.header;
     block_data.body = block.body;
 
-    OUTCOME_TRY(putBlockData(block.header.number, block_data));
+    OUTCOME_TRY(putBlockData(*batch, block.header.number, block_data));
+    OUTCOME_TRY(batch->commit());
+    if (header_cache_) {
+      header_cache_->put(block_hash, block.header);
+    }
     logger_->info("Added block. Number: {}. Hash: {}. State root: {}",
                   block.header.number,
                   block_hash.toHex(),
@@ -254,23 +399,183 @@ namespace kagome::blockchain {
   outcome::result<void> KeyValueBlockStorage::removeBlock(
       const primitives::BlockHash &hash,
       const primitives::BlockNumber &number) {
-    auto block_lookup_key = numberAndHashToLookupKey(number, hash);
-    auto header_lookup_key = prependPrefix(block_lookup_key, Prefix::HEADER);
-    if (auto rm_res = storage_->remove(header_lookup_key); !rm_res) {
-      logger_->error("could not remove header from the storage: {}",
+    return removeBlocks({{number, hash}});
+  }
+
+  outcome::result<void> KeyValueBlockStorage::removeBlocks(
+      const std::vector<primitives::BlockInfo> &blocks) {
+    auto batch = storage_->batch();
+    for (const auto &block : blocks) {
+      // dropped even if the removal fails, then the header is just read from
+      // the storage again
+      if (header_cache_) {
+        header_cache_->remove(block.block_hash);
+      }
+      auto block_lookup_key =
+          numberAndHashToLookupKey(block.block_number, block.block_hash);
+      auto header_lookup_key = prependPrefix(block_lookup_key, Prefix::HEADER);
+      OUTCOME_TRY(batch->remove(header_lookup_key));
+      auto body_lookup_key =
+          prependPrefix(block_lookup_key, Prefix::BLOCK_DATA);
+      OUTCOME_TRY(batch->remove(body_lookup_key));
+    }
+    if (auto rm_res = batch->commit(); !rm_res) {
+      logger_->error("could not remove {} blocks from the storage: {}",
+                     blocks.size(),
                      rm_res.error().message());
       return rm_res;
     }
+    return outcome::success();
+  }
 
-    auto body_lookup_key = prependPrefix(block_lookup_key, Prefix::BLOCK_DATA);
-    if (auto rm_res = storage_->remove(body_lookup_key); !rm_res) {
-      logger_->error("could not remove body from the storage: {}",
-                     rm_res.error().message());
-      return rm_res;
+  outcome::result<void> KeyValueBlockStorage::pruneBodies(
+      primitives::BlockNumber number) {
+    OUTCOME_TRY(pruned,
+                pruneBlockData(
+                    FIRST_BODY_NUMBER_LOOKUP_KEY,
+                    number,
+                    [](primitives::BlockData &block_data) {
+                      // the data without a body is pruned already; the data
+                      // of the blocks which change the authority set is kept
+                      // with the justification, as it proves the set to the
+                      // syncing nodes
+                      if (not block_data.body) {
+                        return PruneAction::KEEP;
+                      }
+                      if (block_data.justification
+                          and changesAuthorities(block_data)) {
+                        block_data.body = boost::none;
+                        return PruneAction::UPDATE;
+                      }
+                      return PruneAction::REMOVE;
+                    }));
+    logger_->debug("Pruned {} bodies of the blocks below {}", pruned, number);
+    return outcome::success();
+  }
+
+  outcome::result<void> KeyValueBlockStorage::pruneJustifications(
+      primitives::BlockNumber number, primitives::BlockNumber period) {
+    if (period == 0) {
+      return outcome::success();
     }
+    OUTCOME_TRY(pruned,
+                pruneBlockData(
+                    FIRST_JUSTIFICATION_NUMBER_LOOKUP_KEY,
+                    number,
+                    [period](primitives::BlockData &block_data) {
+                      if (not block_data.justification or not block_data.header
+                          or block_data.header->number % period == 0
+                          or changesAuthorities(block_data)) {
+                        return PruneAction::KEEP;
+                      }
+                      block_data.justification = boost::none;
+                      return PruneAction::UPDATE;
+                    }));
+    logger_->debug(
+        "Pruned {} justifications of the blocks below {}", pruned, number);
     return outcome::success();
   }
 
+  outcome::result<size_t> KeyValueBlockStorage::pruneBlockData(
+      const common::Buffer &marker_key,
+      primitives::BlockNumber number,
+      const std::function<PruneAction(primitives::BlockData &)> &prune) {
+    OUTCOME_TRY(first, firstNumber(marker_key));
+    if (number <= first) {
+      return 0;
+    }
+    // keys of the data start with the numbers of the blocks, so the pruned
+    // range is walked by a cursor and changed in batches of a bounded size;
+    // nothing is pruned if the storage has no cursors
+    auto cursor =
+        storage_->scanCursor(prependPrefix(Buffer{}, Prefix::BLOCK_DATA));
+    if (cursor == nullptr) {
+      return 0;
+    }
+    auto batch = storage_->batch();
+    size_t batch_size = 0;
+    size_t pruned = 0;
+    OUTCOME_TRY(cursor->seek(
+        prependPrefix(numberToIndexKey(first), Prefix::BLOCK_DATA)));
+    while (cursor->isValid()) {
+      OUTCOME_TRY(key, cursor->key());
+      if (key.empty() or key[0] != Prefix::BLOCK_DATA) {
+        break;
+      }
+      OUTCOME_TRY(block_number, lookupKeyToNumber(key.subbuffer(1)));
+      if (block_number >= number) {
+        break;
+      }
+      OUTCOME_TRY(encoded_block_data, cursor->value());
+      OUTCOME_TRY(block_data,
+                  scale::decode<primitives::BlockData>(encoded_block_data));
+      switch (prune(block_data)) {
+        case PruneAction::KEEP:
+          break;
+        case PruneAction::UPDATE: {
+          OUTCOME_TRY(encoded, scale::encode(block_data));
+          OUTCOME_TRY(batch->put(key, Buffer{std::move(encoded)}));
+          batch_size++;
+          break;
+        }
+        case PruneAction::REMOVE:
+          OUTCOME_TRY(batch->remove(key));
+          batch_size++;
+          break;
+      }
+      if (batch_size == kPruneBatchSize) {
+        // the marker is moved with each batch, so that an interrupted
+        // pruning is resumed where it stopped
+        OUTCOME_TRY(batch->put(marker_key,
+                               Buffer{scale::encode(block_number).value()}));
+        OUTCOME_TRY(batch->commit());
+        batch = storage_->batch();
+        pruned += batch_size;
+        batch_size = 0;
+      }
+      OUTCOME_TRY(cursor->next());
+    }
+    OUTCOME_TRY(batch->put(marker_key, Buffer{scale::encode(number).value()}));
+    OUTCOME_TRY(batch->commit());
+    return pruned + batch_size;
+  }
+
+  outcome::result<primitives::BlockNumber>
+  KeyValueBlockStorage::firstBodyNumber() const {
+    return firstNumber(FIRST_BODY_NUMBER_LOOKUP_KEY);
+  }
+
+  outcome::result<primitives::BlockNumber>
+  KeyValueBlockStorage::firstJustificationNumber() const {
+    return firstNumber(FIRST_JUSTIFICATION_NUMBER_LOOKUP_KEY);
+  }
+
+  outcome::result<primitives::BlockNumber> KeyValueBlockStorage::firstNumber(
+      const common::Buffer &marker_key) const {
+    auto encoded = storage_->get(marker_key);
+    if (encoded.has_value()) {
+      return scale::decode<primitives::BlockNumber>(encoded.value());
+    }
+    if (encoded == outcome::failure(storage::DatabaseError::NOT_FOUND)) {
+      return 0;
+    }
+    return encoded.as_failure();
+  }
+
+  bool KeyValueBlockStorage::changesAuthorities(
+      const primitives::BlockData &block_data) {
+    return block_data.header
+           and std::any_of(block_data.header->digest.begin(),
+                           block_data.header->digest.end(),
+                           [](const primitives::DigestItem &item) {
+                             auto consensus =
+                                 boost::get<primitives::Consensus>(&item);
+                             return consensus != nullptr
+                                    and consensus->consensus_engine_id
+                                            == primitives::kGrandpaEngineId;
+                           });
+  }
+
   outcome::result<primitives::BlockHash>
   KeyValueBlockStorage::getLastFinalizedBlockHash() const {
     auto hash_res = storage_->get(LAST_FINALIZED_BLOCK_HASH_LOOKUP_KEY);
@@ -291,9 +596,83 @@ namespace kagome::blockchain {
       const primitives::BlockHash &hash) {
     OUTCOME_TRY(storage_->put(LAST_FINALIZED_BLOCK_HASH_LOOKUP_KEY, Buffer{hash}));
 
+    if (freezer_) {
+      // the block is finalized anyway, the data is frozen on the next call
+      if (auto res = freezeFinalized(hash); not res) {
+        logger_->error("could not freeze the finalized blocks: {}",
+                       res.error().message());
+      }
+    }
     return outcome::success();
   }
 
+  outcome::result<boost::optional<common::Buffer>>
+  KeyValueBlockStorage::getBlockTreeSnapshot() const {
+    auto snapshot = storage_->get(BLOCK_TREE_SNAPSHOT_LOOKUP_KEY);
+    if (snapshot.has_value()) {
+      return std::move(snapshot.value());
+    }
+
+    if (snapshot == outcome::failure(storage::DatabaseError::NOT_FOUND)) {
+      return boost::none;
+    }
+
+    return snapshot.as_failure();
+  }
+
+  outcome::result<void> KeyValueBlockStorage::setBlockTreeSnapshot(
+      const common::Buffer &snapshot) {
+    return storage_->put(BLOCK_TREE_SNAPSHOT_LOOKUP_KEY, snapshot);
+  }
+
+  outcome::result<void> KeyValueBlockStorage::freezeFinalized(
+      const primitives::BlockHash &hash) {
+    OUTCOME_TRY(finalized_header, getBlockHeader(hash));
+    // if nothing is frozen yet, the finalized block is the first one, and
+    // the data of the older blocks stays in the storage
+    auto first = freezer_->nextNumber().value_or(finalized_header.number);
+    if (finalized_header.number < first) {
+      return outcome::success();
+    }
+
+    // the finalized chain is collected backwards by the parent hashes, as the
+    // number index keeps the last put block of a number, not the finalized
+    std::vector<primitives::BlockInfo> chain{{finalized_header.number, hash}};
+    auto parent_hash = finalized_header.parent_hash;
+    while (chain.back().block_number > first) {
+      // only the number and the parent are read, the digest is not copied
+      OUTCOME_TRY(encoded_header,
+                  getWithPrefix(*storage_, Prefix::HEADER, parent_hash));
+      OUTCOME_TRY(header,
+                  scale::decode<primitives::BlockHeaderView>(encoded_header));
+      chain.emplace_back(header.number, parent_hash);
+      parent_hash = header.parent_hash;
+    }
+
+    auto batch = storage_->batch();
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      auto data_key = prependPrefix(
+          numberAndHashToLookupKey(it->block_number, it->block_hash),
+          Prefix::BLOCK_DATA);
+      auto data_res = storage_->get(data_key);
+      if (not data_res and not isNotFoundError(data_res.error())) {
+        return data_res.error();
+      }
+      // a block without any data is frozen too, so that the numbers of the
+      // frozen blocks have no gaps
+      common::Buffer data;
+      if (data_res) {
+        data = std::move(data_res.value());
+        OUTCOME_TRY(batch->remove(data_key));
+      }
+      OUTCOME_TRY(freezer_->append(it->block_number, it->block_hash, data));
+    }
+    // the data is removed from the storage only when it is on the disk in
+    // the freezer, which survives a crash or a power loss
+    OUTCOME_TRY(freezer_->sync());
+    return batch->commit();
+  }
+
   outcome::result<void> KeyValueBlockStorage::ensureGenesisNotExists() const {
     auto res = getLastFinalizedBlockHash();
     if (res.has_value()) {
@@ -6,10 +6,15 @@
 #ifndef KAGOME_KEY_VALUE_BLOCK_STORAGE_HPP
 #define KAGOME_KEY_VALUE_BLOCK_STORAGE_HPP
 
+#include <functional>
+
 #include "blockchain/block_storage.hpp"
 
+#include "blockchain/impl/block_freezer.hpp"
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/common.hpp"
 #include "common/logger.hpp"
+#include "common/tracer.hpp"
 #include "crypto/hasher.hpp"
 
 namespace kagome::blockchain {
@@ -18,6 +23,15 @@ namespace kagome::blockchain {
    public:
     inline static const common::Buffer LAST_FINALIZED_BLOCK_HASH_LOOKUP_KEY =
         common::Buffer{}.put(":kagome:last_finalized_block_hash");
+    inline static const common::Buffer BLOCK_TREE_SNAPSHOT_LOOKUP_KEY =
+        common::Buffer{}.put(":kagome:block_tree_snapshot");
+    inline static const common::Buffer FIRST_BODY_NUMBER_LOOKUP_KEY =
+        common::Buffer{}.put(":kagome:first_body_number");
+    inline static const common::Buffer FIRST_JUSTIFICATION_NUMBER_LOOKUP_KEY =
+        common::Buffer{}.put(":kagome:first_justification_number");
+
+    /// max number of the entries changed by a single write of the pruning
+    static constexpr size_t kPruneBatchSize = 1024;
 
     using BlockHandler = std::function<void(const primitives::Block &)>;
 
@@ -35,35 +49,55 @@ namespace kagome::blockchain {
         common::Buffer state_root,
         const std::shared_ptr<storage::BufferStorage> &storage,
         const std::shared_ptr<crypto::Hasher> &hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        const std::shared_ptr<BlockHeaderCache> &header_cache = nullptr,
+        const std::shared_ptr<BlockFreezer> &freezer = nullptr,
+        const std::shared_ptr<common::Tracer> &tracer = nullptr);
 
     /**
      * Initialise block storage with existing data
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache keeps the headers put to the storage, if any
+     * @param freezer keeps the data of the finalized blocks, if any
+     * @param tracer records the spans of the writes of the blocks, if any
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>> loadExisting(
         const std::shared_ptr<storage::BufferStorage> &storage,
         std::shared_ptr<crypto::Hasher> hasher,
-        const BlockHandler &on_finalized_block_found);
+        const BlockHandler &on_finalized_block_found,
+        std::shared_ptr<BlockHeaderCache> header_cache = nullptr,
+        std::shared_ptr<BlockFreezer> freezer = nullptr,
+        std::shared_ptr<common::Tracer> tracer = nullptr);
 
     /**
      * Initialise block storage with a genesis block which is created inside
      * from merkle trie root
      * @param storage underlying storage (must be empty)
      * @param hasher a hasher instance
+     * @param header_cache keeps the headers put to the storage, if any
+     * @param freezer keeps the data of the finalized blocks, if any
+     * @param tracer records the spans of the writes of the blocks, if any
      */
     static outcome::result<std::shared_ptr<KeyValueBlockStorage>>
     createWithGenesis(common::Buffer state_root,
                       const std::shared_ptr<storage::BufferStorage> &storage,
                       std::shared_ptr<crypto::Hasher> hasher,
-                      const BlockHandler &on_genesis_created);
+                      const BlockHandler &on_genesis_created,
+                      std::shared_ptr<BlockHeaderCache> header_cache = nullptr,
+                      std::shared_ptr<BlockFreezer> freezer = nullptr,
+                      std::shared_ptr<common::Tracer> tracer = nullptr);
 
     outcome::result<primitives::BlockHash> getLastFinalizedBlockHash()
         const override;
     outcome::result<void> setLastFinalizedBlockHash(
         const primitives::BlockHash &) override;
 
+    outcome::result<boost::optional<common::Buffer>> getBlockTreeSnapshot()
+        const override;
+    outcome::result<void> setBlockTreeSnapshot(
+        const common::Buffer &snapshot) override;
+
     outcome::result<primitives::BlockHeader> getBlockHeader(
         const primitives::BlockId &id) const override;
     outcome::result<primitives::BlockBody> getBlockBody(
@@ -72,6 +106,8 @@ namespace kagome::blockchain {
         const primitives::BlockId &id) const override;
     outcome::result<primitives::Justification> getJustification(
         const primitives::BlockId &block) const override;
+    outcome::result<std::vector<primitives::BlockData>> getBlockDataRange(
+        const std::vector<primitives::BlockInfo> &blocks) const override;
 
     outcome::result<primitives::BlockHash> putBlockHeader(
         const primitives::BlockHeader &header) override;
@@ -90,14 +126,91 @@ namespace kagome::blockchain {
         const primitives::BlockHash &hash,
         const primitives::BlockNumber &number) override;
 
+    outcome::result<void> removeBlocks(
+        const std::vector<primitives::BlockInfo> &blocks) override;
+
+    outcome::result<void> pruneBodies(primitives::BlockNumber number) override;
+
+    outcome::result<void> pruneJustifications(
+        primitives::BlockNumber number,
+        primitives::BlockNumber period) override;
+
+    /**
+     * @return number of the first block whose body is not pruned, 0 if no
+     * body is pruned
+     */
+    outcome::result<primitives::BlockNumber> firstBodyNumber() const;
+
+    /**
+     * @return number of the first block whose justification is not pruned,
+     * 0 if no justification is pruned
+     */
+    outcome::result<primitives::BlockNumber> firstJustificationNumber() const;
+
    private:
+    /// what the pruning does with the data of a block
+    enum class PruneAction { KEEP, UPDATE, REMOVE };
+
+    /**
+     * Walks the data of the blocks from the number stored under \arg
+     * marker_key up to \arg number, exclusive, and applies \arg prune to
+     * it, writing the changes in batches of a bounded size along with the
+     * marker, so that an interrupted pruning is resumed where it stopped
+     * @return number of the changed data
+     */
+    outcome::result<size_t> pruneBlockData(
+        const common::Buffer &marker_key,
+        primitives::BlockNumber number,
+        const std::function<PruneAction(primitives::BlockData &)> &prune);
+
+    /// @return number stored under \arg marker_key, 0 if there is none
+    outcome::result<primitives::BlockNumber> firstNumber(
+        const common::Buffer &marker_key) const;
+
+    /// @return true if the header in \arg block_data changes the authority
+    /// set
+    static bool changesAuthorities(const primitives::BlockData &block_data);
+
     KeyValueBlockStorage(std::shared_ptr<storage::BufferStorage> storage,
-                         std::shared_ptr<crypto::Hasher> hasher);
+                         std::shared_ptr<crypto::Hasher> hasher,
+                         std::shared_ptr<BlockHeaderCache> header_cache,
+                         std::shared_ptr<BlockFreezer> freezer,
+                         std::shared_ptr<common::Tracer> tracer);
 
     outcome::result<void> ensureGenesisNotExists() const;
 
+    /**
+     * @return encoded data of the block with \arg id kept by the freezer,
+     * none if it is not there
+     */
+    outcome::result<boost::optional<common::Buffer>> getFrozenBlockData(
+        const primitives::BlockId &id) const;
+
+    /**
+     * Moves the data of the blocks finalized since the last call, up to the
+     * block with \arg hash, from the storage to the freezer
+     */
+    outcome::result<void> freezeFinalized(const primitives::BlockHash &hash);
+
+    /**
+     * Puts the entries of a block part to \arg batch, so that all the parts
+     * written at once reach the storage with a single write
+     */
+    outcome::result<void> putEncodedBlockHeader(
+        storage::BufferBatch &batch,
+        primitives::BlockNumber block_number,
+        const primitives::BlockHash &block_hash,
+        const common::Buffer &encoded_header);
+    outcome::result<void> putBlockData(
+        storage::BufferBatch &batch,
+        primitives::BlockNumber block_number,
+        const primitives::BlockData &block_data);
+
     std::shared_ptr<storage::BufferStorage> storage_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<BlockHeaderCache> header_cache_;
+    std::shared_ptr<BlockFreezer> freezer_;
+    std::shared_ptr<common::Tracer> tracer_;
     common::Logger logger_;
   };
 }  // namespace kagome::blockchain
@@ -25,11 +25,12 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::blockchain, KeyValueRepositoryError, e) {
 
 namespace kagome::blockchain {
 
-  outcome::result<void> putWithPrefix(storage::BufferStorage &map,
-                                      prefix::Prefix prefix,
-                                      BlockNumber num,
-                                      Hash256 block_hash,
-                                      const common::Buffer &value) {
+  outcome::result<void> putWithPrefix(
+      storage::face::Writeable<common::Buffer, common::Buffer> &map,
+      prefix::Prefix prefix,
+      BlockNumber num,
+      Hash256 block_hash,
+      const common::Buffer &value) {
     auto block_lookup_key = numberAndHashToLookupKey(num, block_hash);
     auto value_lookup_key = prependPrefix(block_lookup_key, prefix);
     auto num_to_idx_key =
@@ -75,6 +76,15 @@ namespace kagome::blockchain {
            | (uint64_t(key[2]) << 8u) | uint64_t(key[3]);
   }
 
+  outcome::result<common::Hash256> lookupKeyToHash(const common::Buffer &key) {
+    if (key.size() != 4 + common::Hash256::size()) {
+      return outcome::failure(KeyValueRepositoryError::INVALID_KEY);
+    }
+    common::Hash256 hash;
+    std::copy(key.begin() + 4, key.end(), hash.begin());
+    return hash;
+  }
+
   common::Buffer prependPrefix(const common::Buffer &key,
                                prefix::Prefix key_column) {
     return common::Buffer{}
@@ -36,7 +36,16 @@ namespace kagome::blockchain {
       JUSTIFICATION = 6,
 
       // node of a trie db
-      TRIE_NODE = 7
+      TRIE_NODE = 7,
+
+      // number of references to a trie node, kept only if state is pruned
+      TRIE_NODE_REFS = 8,
+
+      // values of the storage keys and diffs of the unfinalized states
+      FLAT_STATE = 9,
+
+      // keys changed by the blocks and their digests
+      CHANGES_INDEX = 10
     };
   }
 
@@ -55,18 +64,19 @@ namespace kagome::blockchain {
   /**
    * Put an entry to key space \param prefix and corresponding lookup keys to
    * ID_TO_LOOKUP_KEY space
-   * @param map to put the entry to
+   * @param map to put the entry to, either a storage or a batch of it
    * @param prefix keyspace for the entry value
    * @param num block number that could be used to retrieve the value
    * @param block_hash block hash that could be used to retrieve the value
    * @param value data to be put to the storage
    * @return storage error if any
    */
-  outcome::result<void> putWithPrefix(storage::BufferStorage &map,
-                                      prefix::Prefix prefix,
-                                      primitives::BlockNumber num,
-                                      common::Hash256 block_hash,
-                                      const common::Buffer &value);
+  outcome::result<void> putWithPrefix(
+      storage::face::Writeable<common::Buffer, common::Buffer> &map,
+      prefix::Prefix prefix,
+      primitives::BlockNumber num,
+      common::Hash256 block_hash,
+      const common::Buffer &value);
 
   /**
    * Get an entry from the database
@@ -102,6 +112,11 @@ namespace kagome::blockchain {
   outcome::result<primitives::BlockNumber> lookupKeyToNumber(
       const common::Buffer &key);
 
+  /**
+   * Convert lookup key to a block hash
+   */
+  outcome::result<common::Hash256> lookupKeyToHash(const common::Buffer &key);
+
   /**
    * For a persistant map based storage checks
    * whether result should be considered as `NOT FOUND` error
@@ -6,7 +6,9 @@
 #ifndef KAGOME_BLOB_HPP
 #define KAGOME_BLOB_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 #include <boost/functional/hash.hpp>
 #include "common/hexutil.hpp"
@@ -90,8 +92,14 @@ namespace kagome::common {
      * is in hex format
      */
     static outcome::result<Blob<size_>> fromHex(std::string_view hex) {
-      OUTCOME_TRY(res, unhex(hex));
-      return fromSpan(res);
+      if (hex.size() != size_ * 2) {
+        OUTCOME_TRY(res, unhex(hex));
+        return fromSpan(res);
+      }
+      // decoded right into the blob
+      Blob<size_> blob;
+      OUTCOME_TRY(unhex(hex, blob));
+      return blob;
     }
 
     /**
@@ -102,8 +110,11 @@ namespace kagome::common {
      */
     static outcome::result<Blob<size_>> fromHexWithPrefix(
         std::string_view hex) {
-      OUTCOME_TRY(res, unhexWith0x(hex));
-      return fromSpan(res);
+      constexpr std::string_view kPrefix = "0x";
+      if (hex.substr(0, kPrefix.size()) != kPrefix) {
+        return UnhexError::MISSING_0X_PREFIX;
+      }
+      return fromHex(hex.substr(kPrefix.size()));
     }
 
     /**
@@ -112,7 +123,7 @@ namespace kagome::common {
      * @return
      */
     static outcome::result<Blob<size_>> fromSpan(
-        const gsl::span<uint8_t> &span) {
+        const gsl::span<const uint8_t> &span) {
       if (span.size() != size_) {
         return BlobError::INCORRECT_LENGTH;
       }
@@ -148,10 +159,8 @@ namespace kagome::common {
             size_t size,
             typename = std::enable_if_t<Stream::is_encoder_stream>>
   Stream &operator<<(Stream &s, const Blob<size> &blob) {
-    for (auto &&it = blob.begin(), end = blob.end(); it != end; ++it) {
-      s << *it;
-    }
-    return s;
+    // the bytes are appended at once
+    return s.putBytes(blob);
   }
 
   /**
@@ -166,9 +175,8 @@ namespace kagome::common {
             size_t size,
             typename = std::enable_if_t<Stream::is_decoder_stream>>
   Stream &operator>>(Stream &s, Blob<size> &blob) {
-    for (auto &&it = blob.begin(), end = blob.end(); it != end; ++it) {
-      s >> *it;
-    }
+    auto bytes = s.nextBytes(size);
+    std::copy(bytes.begin(), bytes.end(), blob.begin());
     return s;
   }
 
@@ -182,7 +190,23 @@ namespace kagome::common {
 template <size_t N>
 struct std::hash<kagome::common::Blob<N>> {
   auto operator()(const kagome::common::Blob<N> &blob) const {
-    return boost::hash_range(blob.data(), blob.data() + N);  // NOLINT
+    if constexpr (N < sizeof(size_t)) {
+      return boost::hash_range(blob.data(), blob.data() + N);  // NOLINT
+    } else {
+      // the blobs keep hashes and keys, which are uniformly random, so their
+      // words are just folded rather than mixed byte by byte; all of them
+      // are taken, as some keys share a prefix. The last word may overlap
+      // the previous one
+      size_t hash = 0;
+      for (size_t offset = 0; offset < N; offset += sizeof(size_t)) {
+        size_t word;  // NOLINT
+        std::memcpy(&word,
+                    blob.data() + std::min(offset, N - sizeof(size_t)),
+                    sizeof(word));
+        hash ^= word;
+      }
+      return hash;
+    }
   }
 };
 
@@ -0,0 +1,39 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_BUDGETED_CACHE_HPP
+#define KAGOME_CORE_COMMON_BUDGETED_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kagome::common {
+
+  /**
+   * Cache, which memory limit is set by CacheBudget
+   */
+  class BudgetedCache {
+   public:
+    struct Usage {
+      // taken by the entries kept
+      size_t bytes = 0;
+      // lookups since the start
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+    };
+
+    virtual ~BudgetedCache() = default;
+
+    virtual Usage usage() const = 0;
+
+    /**
+     * Limits the entries kept to \arg bytes, evicting the ones over it
+     */
+    virtual void setBudget(size_t bytes) = 0;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_BUDGETED_CACHE_HPP
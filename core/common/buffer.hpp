@@ -245,10 +245,8 @@ namespace kagome::common {
   template <class Stream,
             typename = std::enable_if_t<Stream::is_decoder_stream>>
   Stream &operator>>(Stream &s, Buffer &buffer) {
-    std::vector<uint8_t> data;
-    s >> data;
-    buffer.put(data);
-    return s;
+    // decoded in place, the bytes are copied once
+    return s >> buffer.toVector();
   }
 
   std::ostream &operator<<(std::ostream &os, const Buffer &buffer);
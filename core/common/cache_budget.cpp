@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/cache_budget.hpp"
+
+#include <algorithm>
+
+namespace kagome::common {
+
+  CacheBudget::CacheBudget(size_t total_bytes,
+                           std::shared_ptr<boost::asio::io_context> io_context)
+      : total_bytes_{total_bytes}, timer_{*io_context} {}
+
+  void CacheBudget::add(std::string name,
+                        std::shared_ptr<BudgetedCache> cache,
+                        size_t initial_bytes) {
+    std::lock_guard lock{mutex_};
+    auto usage = cache->usage();
+    entries_.push_back(Entry{std::move(name),
+                             std::move(cache),
+                             initial_bytes,
+                             0,
+                             usage.hits,
+                             usage.misses});
+    size_t initial_total = 0;
+    for (auto &entry : entries_) {
+      initial_total += entry.initial_bytes;
+    }
+    for (auto &entry : entries_) {
+      entry.budget = initial_total == 0
+                         ? total_bytes_ / entries_.size()
+                         : static_cast<size_t>(
+                             static_cast<double>(total_bytes_)
+                             * entry.initial_bytes / initial_total);
+      entry.cache->setBudget(entry.budget);
+    }
+  }
+
+  void CacheBudget::start() {
+    scheduleRebalance();
+  }
+
+  void CacheBudget::stop() {
+    timer_.cancel();
+  }
+
+  void CacheBudget::scheduleRebalance() {
+    timer_.expires_after(kRebalancePeriod);
+    timer_.async_wait(
+        [weak = weak_from_this()](const boost::system::error_code &ec) {
+          auto self = weak.lock();
+          if (ec or self == nullptr) {
+            return;
+          }
+          self->rebalance();
+          self->scheduleRebalance();
+        });
+  }
+
+  void CacheBudget::rebalance() {
+    std::lock_guard lock{mutex_};
+    if (entries_.empty()) {
+      return;
+    }
+    auto floor = total_bytes_ / (entries_.size() * kFloorDivisor);
+    std::vector<size_t> targets(entries_.size(), floor);
+    std::vector<double> benefits(entries_.size(), 0);
+    double total_benefit = 0;
+    size_t taken = 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      auto &entry = entries_[i];
+      auto usage = entry.cache->usage();
+      auto hits = usage.hits - entry.hits;
+      auto misses = usage.misses - entry.misses;
+      entry.hits = usage.hits;
+      entry.misses = usage.misses;
+      // a cache keeping less than 7/8 of its budget has room to grow still
+      if (usage.bytes * 8 < entry.budget * 7) {
+        // the used part is kept with a margin to grow
+        targets[i] = std::max(
+            floor, std::min(entry.budget, usage.bytes + usage.bytes / 4));
+      } else if (hits != 0 and misses != 0) {
+        benefits[i] = static_cast<double>(misses) * hits / (hits + misses)
+                      / std::max<size_t>(entry.budget, 1);
+        total_benefit += benefits[i];
+      } else if (hits != 0) {
+        // all the lookups are hits, so the budget is used well as it is
+        targets[i] = std::max(floor, entry.budget);
+      }
+      // a full cache without hits gains nothing from its budget, and is
+      // left with the floor
+      taken += targets[i];
+    }
+    // nothing is gained by moving the budget
+    if (total_benefit == 0) {
+      return;
+    }
+    auto rest = total_bytes_ > taken ? total_bytes_ - taken : 0;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      auto &entry = entries_[i];
+      targets[i] += static_cast<size_t>(rest * (benefits[i] / total_benefit));
+      auto budget = entry.budget / 2 + targets[i] / 2;
+      if (budget != entry.budget) {
+        entry.budget = budget;
+        entry.cache->setBudget(budget);
+      }
+    }
+  }
+
+  std::vector<CacheBudget::CacheReport> CacheBudget::report() const {
+    std::lock_guard lock{mutex_};
+    std::vector<CacheReport> report;
+    report.reserve(entries_.size());
+    for (auto &entry : entries_) {
+      report.push_back(
+          CacheReport{entry.name, entry.budget, entry.cache->usage()});
+    }
+    return report;
+  }
+
+  void CacheBudget::collect(MetricsRegistry::Writer &writer) const {
+    using Type = MetricsRegistry::Type;
+    auto caches = report();
+    writer.family("kagome_cache_budget_bytes",
+                  Type::GAUGE,
+                  "Bytes of the cache budget given to a cache");
+    writer.family("kagome_cache_used_bytes",
+                  Type::GAUGE,
+                  "Bytes taken by the entries of a cache");
+    writer.family("kagome_cache_hits_total",
+                  Type::COUNTER,
+                  "Lookups found in a cache");
+    writer.family("kagome_cache_misses_total",
+                  Type::COUNTER,
+                  "Lookups not found in a cache");
+    for (auto &cache : caches) {
+      MetricsRegistry::Labels labels{{"cache", cache.name}};
+      writer.sample("kagome_cache_budget_bytes",
+                    labels,
+                    static_cast<uint64_t>(cache.budget));
+      writer.sample("kagome_cache_used_bytes",
+                    labels,
+                    static_cast<uint64_t>(cache.usage.bytes));
+      writer.sample("kagome_cache_hits_total", labels, cache.usage.hits);
+      writer.sample("kagome_cache_misses_total", labels, cache.usage.misses);
+    }
+  }
+
+}  // namespace kagome::common
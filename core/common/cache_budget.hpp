@@ -0,0 +1,100 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_CACHE_BUDGET_HPP
+#define KAGOME_CORE_COMMON_CACHE_BUDGET_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "common/budgeted_cache.hpp"
+#include "common/metrics_registry.hpp"
+
+namespace kagome::common {
+
+  /**
+   * Shares a total memory budget between the caches of the node, instead of
+   * a size of each of them, which is hard to tune. Every period the budget
+   * is moved from the caches, which do not fill theirs, to the full ones by
+   * their marginal benefit: the misses of a period, which a larger cache
+   * would turn into hits as often as its hit rate tells, per byte of its
+   * budget. The budgets move half way to the new shares, so that a burst of
+   * lookups does not flush a cache, and each cache keeps a floor of an even
+   * share. Thread-safe
+   */
+  class CacheBudget : public std::enable_shared_from_this<CacheBudget> {
+   public:
+    struct CacheReport {
+      std::string name;
+      size_t budget = 0;
+      BudgetedCache::Usage usage;
+    };
+
+    static constexpr std::chrono::seconds kRebalancePeriod{60};
+    /// the floor of a cache is this part of an even share of the total
+    static constexpr size_t kFloorDivisor = 4;
+
+    /**
+     * @param total_bytes shared by the caches
+     * @param io_context runs the timer of the rebalancing
+     */
+    CacheBudget(size_t total_bytes,
+                std::shared_ptr<boost::asio::io_context> io_context);
+
+    /**
+     * Shares the budget with \arg cache, which budgets are set in proportion
+     * to \arg initial_bytes they are configured with, until they are
+     * rebalanced by their usage
+     */
+    void add(std::string name,
+             std::shared_ptr<BudgetedCache> cache,
+             size_t initial_bytes);
+
+    /// starts the rebalancing every kRebalancePeriod
+    void start();
+
+    void stop();
+
+    /// moves the budget to the caches, which benefit from it the most
+    void rebalance();
+
+    size_t total() const {
+      return total_bytes_;
+    }
+
+    std::vector<CacheReport> report() const;
+
+    /// writes the budgets, the usage and the lookups of the caches
+    void collect(MetricsRegistry::Writer &writer) const;
+
+   private:
+    struct Entry {
+      std::string name;
+      std::shared_ptr<BudgetedCache> cache;
+      size_t initial_bytes = 0;
+      size_t budget = 0;
+      // lookups till the previous rebalancing
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+    };
+
+    void scheduleRebalance();
+
+    const size_t total_bytes_;
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    boost::asio::steady_timer timer_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_CACHE_BUDGET_HPP
@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/duration_histogram.hpp"
+
+#include <algorithm>
+
+namespace kagome::common {
+
+  void DurationHistogram::add(uint64_t ns) {
+    calls_++;
+    total_ns_ += ns;
+    max_ns_ = std::max(max_ns_, ns);
+    size_t bucket = 0;
+    while (bucket + 1 < kBucketsNum and (ns >> (bucket + 1)) != 0) {
+      bucket++;
+    }
+    buckets_[bucket]++;
+  }
+
+  void DurationHistogram::add(std::chrono::steady_clock::duration duration) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+                  .count();
+    add(static_cast<uint64_t>(ns > 0 ? ns : 0));
+  }
+
+  DurationHistogram::Stats DurationHistogram::stats() const {
+    Stats stats;
+    stats.calls = calls_;
+    stats.total = std::chrono::nanoseconds(total_ns_);
+    stats.max = std::chrono::nanoseconds(max_ns_);
+    // the calls, which may take longer than the 99th percentile
+    auto slowest = calls_ / 100;
+    uint64_t seen = 0;
+    for (size_t bucket = kBucketsNum; bucket-- > 0;) {
+      seen += buckets_[bucket];
+      if (seen > slowest) {
+        // the upper bound of the bucket, which is never above the max
+        auto bound = bucket + 1 < kBucketsNum
+                         ? (uint64_t{1} << (bucket + 1)) - 1
+                         : max_ns_;
+        stats.p99 = std::chrono::nanoseconds(std::min(bound, max_ns_));
+        break;
+      }
+    }
+    return stats;
+  }
+
+}  // namespace kagome::common
@@ -0,0 +1,48 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_DURATION_HISTOGRAM_HPP
+#define KAGOME_CORE_COMMON_DURATION_HISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace kagome::common {
+
+  /**
+   * Histogram of the durations, which fall into the buckets by the highest
+   * set bit of their nanoseconds, so that it is of a fixed small size. Not
+   * thread-safe
+   */
+  class DurationHistogram {
+   public:
+    struct Stats {
+      uint64_t calls = 0;
+      std::chrono::nanoseconds total{};
+      // upper bound of the duration 99% of the calls take at most, exact to
+      // a power of two
+      std::chrono::nanoseconds p99{};
+      std::chrono::nanoseconds max{};
+    };
+
+    void add(uint64_t ns);
+
+    void add(std::chrono::steady_clock::duration duration);
+
+    Stats stats() const;
+
+   private:
+    static constexpr size_t kBucketsNum = 64;
+
+    uint64_t calls_ = 0;
+    uint64_t total_ns_ = 0;
+    uint64_t max_ns_ = 0;
+    std::array<uint64_t, kBucketsNum> buckets_{};
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_DURATION_HISTOGRAM_HPP
@@ -0,0 +1,368 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_FLAT_HASH_MAP_HPP
+#define KAGOME_CORE_COMMON_FLAT_HASH_MAP_HPP
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace kagome::common {
+
+  namespace detail {
+
+    /**
+     * Open addressing hash table in the manner of the Swiss tables: the
+     * values are kept right in an array of slots, so there is no allocation
+     * per entry, and a control byte per slot keeps 7 bits of the hash of its
+     * key, so the probing compares the keys only when these bits match.
+     * The removed entries leave tombstones, so the erasures do not move the
+     * other entries, and the tombstones are dropped by the next rehash.
+     * Unlike the node based containers, the insertions invalidate the
+     * iterators and the references to the entries
+     */
+    template <typename Key,
+              typename Value,
+              typename KeyOf,
+              typename Hash,
+              typename KeyEqual>
+    class FlatHashTable {
+      static constexpr uint8_t kEmpty = 0x80;
+      static constexpr uint8_t kDeleted = 0xfe;
+      static constexpr size_t kMinCapacity = 16;
+
+      template <bool Const>
+      class Iterator {
+        using Table =
+            std::conditional_t<Const, const FlatHashTable, FlatHashTable>;
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Value *, Value *>;
+        using reference = std::conditional_t<Const, const Value &, Value &>;
+
+        Iterator() = default;
+
+        Iterator(Table *table, size_t index) : table_{table}, index_{index} {}
+
+        // an iterator is converted to a const one
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        Iterator(const Iterator<false> &it)  // NOLINT
+            : table_{it.table_}, index_{it.index_} {}
+
+        reference operator*() const {
+          return *table_->slots_[index_];
+        }
+
+        pointer operator->() const {
+          return &*table_->slots_[index_];
+        }
+
+        Iterator &operator++() {
+          index_ = table_->nextFull(index_ + 1);
+          return *this;
+        }
+
+        Iterator operator++(int) {
+          auto it = *this;
+          ++*this;
+          return it;
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) {
+          return a.index_ == b.index_;
+        }
+
+        friend bool operator!=(const Iterator &a, const Iterator &b) {
+          return a.index_ != b.index_;
+        }
+
+       private:
+        friend class FlatHashTable;
+        friend class Iterator<true>;
+
+        Table *table_ = nullptr;
+        size_t index_ = 0;
+      };
+
+     public:
+      using key_type = Key;
+      using value_type = Value;
+      using size_type = size_t;
+      using hasher = Hash;
+      using key_equal = KeyEqual;
+      using iterator = Iterator<false>;
+      using const_iterator = Iterator<true>;
+
+      iterator begin() {
+        return {this, nextFull(0)};
+      }
+      iterator end() {
+        return {this, ctrl_.size()};
+      }
+      const_iterator begin() const {
+        return {this, nextFull(0)};
+      }
+      const_iterator end() const {
+        return {this, ctrl_.size()};
+      }
+
+      size_t size() const {
+        return size_;
+      }
+
+      bool empty() const {
+        return size_ == 0;
+      }
+
+      void clear() {
+        ctrl_.clear();
+        slots_.clear();
+        size_ = 0;
+        deleted_ = 0;
+      }
+
+      /**
+       * Makes room for \arg count entries, so they are inserted without a
+       * rehash
+       */
+      void reserve(size_t count) {
+        auto capacity = kMinCapacity;
+        while (not fits(count, capacity)) {
+          capacity *= 2;
+        }
+        if (capacity > ctrl_.size()) {
+          rehash(capacity);
+        }
+      }
+
+      iterator find(const Key &key) {
+        return {this, findIndex(key)};
+      }
+
+      const_iterator find(const Key &key) const {
+        return {this, findIndex(key)};
+      }
+
+      size_t count(const Key &key) const {
+        return findIndex(key) != ctrl_.size() ? 1 : 0;
+      }
+
+      bool contains(const Key &key) const {
+        return count(key) != 0;
+      }
+
+      std::pair<iterator, bool> insert(const Value &value) {
+        return emplaceKey(KeyOf{}(value), value);
+      }
+
+      std::pair<iterator, bool> insert(Value &&value) {
+        const auto &key = KeyOf{}(value);
+        return emplaceKey(key, std::move(value));
+      }
+
+      template <typename... Args>
+      std::pair<iterator, bool> emplace(Args &&...args) {
+        return insert(Value(std::forward<Args>(args)...));
+      }
+
+      /**
+       * Removes the entry at \arg pos
+       * @return iterator to the entry following it
+       */
+      iterator erase(const_iterator pos) {
+        auto index = pos.index_;
+        slots_[index].reset();
+        // the probing of the other keys does not go past an empty slot
+        // followed by an empty one, so no tombstone is needed there
+        if (ctrl_[(index + 1) & mask()] == kEmpty) {
+          ctrl_[index] = kEmpty;
+        } else {
+          ctrl_[index] = kDeleted;
+          ++deleted_;
+        }
+        --size_;
+        return {this, nextFull(index + 1)};
+      }
+
+      size_t erase(const Key &key) {
+        auto index = findIndex(key);
+        if (index == ctrl_.size()) {
+          return 0;
+        }
+        erase(const_iterator{this, index});
+        return 1;
+      }
+
+     protected:
+      /**
+       * Constructs the entry with \arg key from \arg args, unless there is
+       * one with the key already
+       */
+      template <typename... Args>
+      std::pair<iterator, bool> emplaceKey(const Key &key, Args &&...args) {
+        if (not fits(size_ + deleted_ + 1, ctrl_.size())) {
+          // a table full of tombstones is cleaned without growing
+          rehash(fits(size_ + 1, ctrl_.size() / 2) ? ctrl_.size()
+                                                   : growCapacity());
+        }
+        auto hash = Hash{}(key);
+        auto h2 = static_cast<uint8_t>(hash & 0x7f);
+        auto index = (hash >> 7) & mask();
+        auto target = ctrl_.size();
+        while (ctrl_[index] != kEmpty) {
+          if (ctrl_[index] == kDeleted) {
+            if (target == ctrl_.size()) {
+              target = index;
+            }
+          } else if (ctrl_[index] == h2
+                     and KeyEqual{}(KeyOf{}(*slots_[index]), key)) {
+            return {iterator{this, index}, false};
+          }
+          index = (index + 1) & mask();
+        }
+        if (target == ctrl_.size()) {
+          target = index;
+        } else {
+          --deleted_;
+        }
+        slots_[target].emplace(std::forward<Args>(args)...);
+        ctrl_[target] = h2;
+        ++size_;
+        return {iterator{this, target}, true};
+      }
+
+     private:
+      // at most 7/8 of the slots are taken, counting the tombstones, so
+      // there is always an empty slot to end the probing
+      static bool fits(size_t count, size_t capacity) {
+        return count * 8 <= capacity * 7;
+      }
+
+      size_t mask() const {
+        return ctrl_.size() - 1;
+      }
+
+      size_t growCapacity() const {
+        return ctrl_.empty() ? kMinCapacity : ctrl_.size() * 2;
+      }
+
+      size_t nextFull(size_t index) const {
+        while (index < ctrl_.size()
+               and (ctrl_[index] == kEmpty or ctrl_[index] == kDeleted)) {
+          ++index;
+        }
+        return index;
+      }
+
+      size_t findIndex(const Key &key) const {
+        if (size_ == 0) {
+          return ctrl_.size();
+        }
+        auto hash = Hash{}(key);
+        auto h2 = static_cast<uint8_t>(hash & 0x7f);
+        for (auto index = (hash >> 7) & mask(); ctrl_[index] != kEmpty;
+             index = (index + 1) & mask()) {
+          if (ctrl_[index] == h2
+              and KeyEqual{}(KeyOf{}(*slots_[index]), key)) {
+            return index;
+          }
+        }
+        return ctrl_.size();
+      }
+
+      void rehash(size_t capacity) {
+        auto old_slots = std::move(slots_);
+        auto old_ctrl = std::move(ctrl_);
+        ctrl_.assign(capacity, kEmpty);
+        slots_.clear();
+        slots_.resize(capacity);
+        deleted_ = 0;
+        for (size_t i = 0; i < old_ctrl.size(); ++i) {
+          if (old_ctrl[i] == kEmpty or old_ctrl[i] == kDeleted) {
+            continue;
+          }
+          auto hash = Hash{}(KeyOf{}(*old_slots[i]));
+          auto index = (hash >> 7) & mask();
+          while (ctrl_[index] != kEmpty) {
+            index = (index + 1) & mask();
+          }
+          slots_[index].emplace(std::move(*old_slots[i]));
+          ctrl_[index] = old_ctrl[i];
+        }
+      }
+
+      std::vector<uint8_t> ctrl_;
+      std::vector<std::optional<Value>> slots_;
+      size_t size_ = 0;
+      size_t deleted_ = 0;
+    };
+
+    template <typename K, typename V>
+    struct MapKeyOf {
+      const K &operator()(const std::pair<const K, V> &value) const {
+        return value.first;
+      }
+    };
+
+    template <typename K>
+    struct SetKeyOf {
+      const K &operator()(const K &value) const {
+        return value;
+      }
+    };
+
+  }  // namespace detail
+
+  /**
+   * Hash map keeping its entries in a flat array, @see detail::FlatHashTable.
+   * Suits the keys, which are hashes themselves, and the small values, which
+   * are not referenced across the insertions
+   */
+  template <typename K,
+            typename V,
+            typename Hash = std::hash<K>,
+            typename KeyEqual = std::equal_to<K>>
+  class FlatHashMap : public detail::FlatHashTable<K,
+                                                   std::pair<const K, V>,
+                                                   detail::MapKeyOf<K, V>,
+                                                   Hash,
+                                                   KeyEqual> {
+   public:
+    using mapped_type = V;
+
+    template <typename... Args>
+    auto try_emplace(const K &key, Args &&...args) {
+      return this->emplaceKey(
+          key,
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    V &operator[](const K &key) {
+      return try_emplace(key).first->second;
+    }
+  };
+
+  /**
+   * Hash set keeping its keys in a flat array, @see detail::FlatHashTable
+   */
+  template <typename K,
+            typename Hash = std::hash<K>,
+            typename KeyEqual = std::equal_to<K>>
+  using FlatHashSet = detail::
+      FlatHashTable<K, K, detail::SetKeyOf<K>, Hash, KeyEqual>;
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_FLAT_HASH_MAP_HPP
@@ -5,9 +5,16 @@
 
 #include "common/hexutil.hpp"
 
-#include <boost/algorithm/hex.hpp>
+#include <array>
+#include <sstream>
+
+#include <boost/assert.hpp>
 #include <gsl/span>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::common, UnhexError, e) {
   using kagome::common::UnhexError;
   switch (e) {
@@ -27,6 +34,59 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::common, UnhexError, e) {
 
 namespace kagome::common {
 
+  namespace {
+    constexpr char kLowerDigits[] = "0123456789abcdef";
+    constexpr char kUpperDigits[] = "0123456789ABCDEF";
+
+    // the value of a hex digit of either case, kNonHex for the other chars
+    constexpr uint8_t kNonHex = 0xff;
+    constexpr std::array<uint8_t, 256> kDigitValues = [] {
+      std::array<uint8_t, 256> values{};
+      for (auto &value : values) {
+        value = kNonHex;
+      }
+      for (uint8_t i = 0; i < 16; ++i) {
+        values[static_cast<uint8_t>(kLowerDigits[i])] = i;
+        values[static_cast<uint8_t>(kUpperDigits[i])] = i;
+      }
+      return values;
+    }();
+
+    void encode(gsl::span<const uint8_t> bytes,
+                char *out,
+                const char *digits) noexcept {
+      auto size = static_cast<size_t>(bytes.size());
+      size_t i = 0;
+#ifdef __SSE2__
+      // 16 bytes at once: the nibbles are split and interleaved, and the
+      // ones above 9 are moved to the letters with a comparison
+      const auto nibble = _mm_set1_epi8(0x0f);
+      const auto nine = _mm_set1_epi8(9);
+      const auto zero = _mm_set1_epi8('0');
+      const auto letters = _mm_set1_epi8(digits[10] - '0' - 10);
+      auto to_digits = [&](__m128i nibbles) {
+        auto above_nine = _mm_cmpgt_epi8(nibbles, nine);
+        return _mm_add_epi8(_mm_add_epi8(nibbles, zero),
+                            _mm_and_si128(above_nine, letters));
+      };
+      for (; i + 16 <= size; i += 16) {
+        auto v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(bytes.data() + i));
+        auto high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+        auto low = _mm_and_si128(v, nibble);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i),
+                         to_digits(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16),
+                         to_digits(_mm_unpackhi_epi8(high, low)));
+      }
+#endif
+      for (; i < size; ++i) {
+        out[2 * i] = digits[bytes[i] >> 4u];
+        out[2 * i + 1] = digits[bytes[i] & 0xfu];
+      }
+    }
+  }  // namespace
+
   std::string int_to_hex(uint64_t n, size_t fixed_width) noexcept {
     std::stringstream result;
     result.width(fixed_width);
@@ -45,33 +105,86 @@ namespace kagome::common {
 
   std::string hex_upper(const gsl::span<const uint8_t> bytes) noexcept {
     std::string res(bytes.size() * 2, '\x00');
-    boost::algorithm::hex(bytes.begin(), bytes.end(), res.begin());
+    encode(bytes, res.data(), kUpperDigits);
     return res;
   }
 
   std::string hex_lower(const gsl::span<const uint8_t> bytes) noexcept {
     std::string res(bytes.size() * 2, '\x00');
-    boost::algorithm::hex_lower(bytes.begin(), bytes.end(), res.begin());
+    encode(bytes, res.data(), kLowerDigits);
     return res;
   }
 
-  outcome::result<std::vector<uint8_t>> unhex(std::string_view hex) {
-    std::vector<uint8_t> blob;
-    blob.reserve((hex.size() + 1) / 2);
-
-    try {
-      boost::algorithm::unhex(hex.begin(), hex.end(), std::back_inserter(blob));
-      return blob;
+  void hex_lower(gsl::span<const uint8_t> bytes,
+                 gsl::span<char> out) noexcept {
+    BOOST_ASSERT(out.size() == bytes.size() * 2);
+    encode(bytes, out.data(), kLowerDigits);
+  }
 
-    } catch (const boost::algorithm::not_enough_input &e) {
+  outcome::result<std::vector<uint8_t>> unhex(std::string_view hex) {
+    std::vector<uint8_t> blob(hex.size() / 2);
+    OUTCOME_TRY(unhex(hex.substr(0, blob.size() * 2), blob));
+    if (hex.size() % 2 != 0) {
+      // the last char is checked as the pairs of chars are
+      if (kDigitValues[static_cast<uint8_t>(hex.back())] == kNonHex) {
+        return UnhexError::NON_HEX_INPUT;
+      }
       return UnhexError::NOT_ENOUGH_INPUT;
+    }
+    return blob;
+  }
 
-    } catch (const boost::algorithm::non_hex_input &e) {
-      return UnhexError::NON_HEX_INPUT;
-
-    } catch (const std::exception &e) {
-      return UnhexError::UNKNOWN;
+  outcome::result<void> unhex(std::string_view hex, gsl::span<uint8_t> out) {
+    if (hex.size() % 2 != 0) {
+      return UnhexError::NOT_ENOUGH_INPUT;
+    }
+    BOOST_ASSERT(static_cast<size_t>(out.size()) == hex.size() / 2);
+    auto size = static_cast<size_t>(out.size());
+    size_t i = 0;
+#ifdef __SSE2__
+    // 8 bytes of 16 chars at once: the digits and the letters of either case
+    // are told by the ranges they are in, and the pairs of their values are
+    // joined in the 16-bit lanes. The chars above 0x7f are negative, so they
+    // are in neither of the ranges. A block with the other chars is left to
+    // the loop below, which tells the error
+    const auto case_bit = _mm_set1_epi8(0x20);
+    const auto before_zero = _mm_set1_epi8('0' - 1);
+    const auto after_nine = _mm_set1_epi8('9' + 1);
+    const auto before_a = _mm_set1_epi8('a' - 1);
+    const auto after_f = _mm_set1_epi8('f' + 1);
+    const auto zero = _mm_set1_epi8('0');
+    const auto letters = _mm_set1_epi8('a' - 10);
+    const auto low_byte = _mm_set1_epi16(0xff);
+    for (; i + 8 <= size; i += 8) {
+      auto chars = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(hex.data() + 2 * i));
+      auto lower = _mm_or_si128(chars, case_bit);
+      auto is_digit = _mm_and_si128(_mm_cmpgt_epi8(chars, before_zero),
+                                    _mm_cmpgt_epi8(after_nine, chars));
+      auto is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, before_a),
+                                     _mm_cmpgt_epi8(after_f, lower));
+      if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) {
+        break;
+      }
+      auto values = _mm_or_si128(
+          _mm_and_si128(is_digit, _mm_sub_epi8(chars, zero)),
+          _mm_and_si128(is_letter, _mm_sub_epi8(lower, letters)));
+      // the first char of a pair is the low byte of its lane
+      auto high = _mm_slli_epi16(_mm_and_si128(values, low_byte), 4);
+      auto bytes = _mm_or_si128(high, _mm_srli_epi16(values, 8));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(out.data() + i),
+                       _mm_packus_epi16(bytes, bytes));
+    }
+#endif
+    for (; i < size; ++i) {
+      auto high = kDigitValues[static_cast<uint8_t>(hex[2 * i])];
+      auto low = kDigitValues[static_cast<uint8_t>(hex[2 * i + 1])];
+      if (high == kNonHex or low == kNonHex) {
+        return UnhexError::NON_HEX_INPUT;
+      }
+      out[i] = (high << 4u) | low;
     }
+    return outcome::success();
   }
 
   outcome::result<std::vector<uint8_t>> unhexWith0x(
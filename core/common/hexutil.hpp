@@ -46,6 +46,14 @@ namespace kagome::common {
    */
   std::string hex_lower(gsl::span<const uint8_t> bytes) noexcept;
 
+  /**
+   * @brief Writes hex representation of bytes to a buffer, so that it may be
+   * formatted in place
+   * @param bytes bytes
+   * @param out buffer of twice as many chars as there are bytes
+   */
+  void hex_lower(gsl::span<const uint8_t> bytes, gsl::span<char> out) noexcept;
+
   /**
    * @brief Converts hex representation to bytes
    * @param array individual chars
@@ -60,6 +68,14 @@ namespace kagome::common {
    */
   outcome::result<std::vector<uint8_t>> unhex(std::string_view hex);
 
+  /**
+   * @brief Converts hex representation to bytes in a buffer
+   * @param hex hexstring of an even length
+   * @param out buffer of half as many bytes as there are chars in hex
+   * @return error if the string is not hex encoded
+   */
+  outcome::result<void> unhex(std::string_view hex, gsl::span<uint8_t> out);
+
   /**
    * @brief Unhex hex-string with 0x in the begining
    * @param hex hex string with 0x in the beginning
@@ -6,9 +6,37 @@
 #ifndef KAGOME_LOGGER_HPP
 #define KAGOME_LOGGER_HPP
 
+#include <algorithm>
+
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/spdlog.h>
 
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "common/hexutil.hpp"
+
+/**
+ * Log a message with the logger at the level, the arguments are evaluated
+ * only if the level is enabled. For the arguments costly to compute, as the
+ * hashes and the encodings made just to be logged; the buffers and the blobs
+ * are formatted lazily anyway
+ */
+#define KAGOME_LOG(logger, level, ...) \
+  do {                                 \
+    if ((logger)->should_log(level)) { \
+      (logger)->log(level, __VA_ARGS__); \
+    }                                  \
+  } while (false)
+
+#define KAGOME_LOG_TRACE(logger, ...) \
+  KAGOME_LOG(logger, spdlog::level::trace, __VA_ARGS__)
+#define KAGOME_LOG_DEBUG(logger, ...) \
+  KAGOME_LOG(logger, spdlog::level::debug, __VA_ARGS__)
+#define KAGOME_LOG_INFO(logger, ...) \
+  KAGOME_LOG(logger, spdlog::level::info, __VA_ARGS__)
+#define KAGOME_LOG_WARN(logger, ...) \
+  KAGOME_LOG(logger, spdlog::level::warn, __VA_ARGS__)
+
 namespace kagome::common {
   using Logger = std::shared_ptr<spdlog::logger>;
 
@@ -18,6 +46,40 @@ namespace kagome::common {
    * @return logger object
    */
   Logger createLogger(const std::string &tag);
+
+  /**
+   * Formatter of bytes as lowercase hex, which is written to the message
+   * only when it is logged, piece by piece without allocations
+   */
+  struct HexFormatter {
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext &ctx) {
+      return ctx.begin();
+    }
+
+    template <typename FormatContext>
+    auto format(gsl::span<const uint8_t> bytes, FormatContext &ctx) const {
+      constexpr size_t kChunk = 64;
+      char hex[kChunk * 2];
+      auto out = ctx.out();
+      while (not bytes.empty()) {
+        auto chunk = bytes.first(std::min<size_t>(bytes.size(), kChunk));
+        gsl::span<char> chunk_hex(hex, chunk.size() * 2);
+        hex_lower(chunk, chunk_hex);
+        out = std::copy(chunk_hex.begin(), chunk_hex.end(), out);
+        bytes = bytes.subspan(chunk.size());
+      }
+      return out;
+    }
+  };
 }  // namespace kagome::common
 
+template <>
+struct fmt::formatter<kagome::common::Buffer>
+    : kagome::common::HexFormatter {};
+
+template <size_t N>
+struct fmt::formatter<kagome::common::Blob<N>>
+    : kagome::common::HexFormatter {};
+
 #endif  // KAGOME_LOGGER_HPP
@@ -0,0 +1,154 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/memory_arena.hpp"
+
+#include <array>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+namespace kagome::common {
+
+  namespace {
+    // granularity of the sizes of the cached blocks
+    constexpr size_t kSizeStep = 16;
+    constexpr size_t kSizeClassesNum =
+        MemoryArenas::kMaxCachedSize / kSizeStep;
+
+    struct alignas(64) Counters {
+      std::atomic<uint64_t> bytes{0};
+      std::atomic<uint64_t> allocations{0};
+    };
+
+    std::array<Counters, MemoryArenas::kArenasNum> counters;
+
+    Counters &countersOf(MemoryArena arena) {
+      auto index = static_cast<size_t>(arena);
+      BOOST_ASSERT(index < counters.size());
+      return counters[index];
+    }
+
+    // free blocks of each size class, which are returned to the global
+    // allocator when the thread exits
+    struct ThreadCache {
+      std::array<std::vector<void *>, kSizeClassesNum> blocks;
+
+      ~ThreadCache();
+    };
+
+    // the cache is not used once it is destroyed, by the destructors of the
+    // other thread locals
+    thread_local bool thread_cache_destroyed = false;
+    thread_local ThreadCache thread_cache;
+
+    ThreadCache::~ThreadCache() {
+      for (auto &size_blocks : blocks) {
+        for (auto block : size_blocks) {
+          ::operator delete(block);
+        }
+      }
+      thread_cache_destroyed = true;
+    }
+
+    size_t sizeClass(size_t bytes) {
+      return (bytes + kSizeStep - 1) / kSizeStep - 1;
+    }
+  }  // namespace
+
+  std::string_view MemoryArenas::name(MemoryArena arena) {
+    switch (arena) {
+      case MemoryArena::TRIE_NODES:
+        return "trie_nodes";
+      case MemoryArena::RUNTIME_MEMORY:
+        return "runtime_memory";
+      case MemoryArena::NETWORK_BUFFERS:
+        return "network_buffers";
+    }
+    return "unknown";
+  }
+
+  MemoryArenas::Stats MemoryArenas::stats(MemoryArena arena) {
+    auto &arena_counters = countersOf(arena);
+    return {arena_counters.bytes.load(std::memory_order_relaxed),
+            arena_counters.allocations.load(std::memory_order_relaxed)};
+  }
+
+  void MemoryArenas::charge(MemoryArena arena, size_t bytes) {
+    auto &arena_counters = countersOf(arena);
+    arena_counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    arena_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void MemoryArenas::discharge(MemoryArena arena, size_t bytes) {
+    auto &arena_counters = countersOf(arena);
+    arena_counters.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    arena_counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void *MemoryArenas::allocate(MemoryArena arena, size_t bytes) {
+    if (bytes == 0 or bytes > kMaxCachedSize) {
+      auto block = ::operator new(bytes);
+      charge(arena, bytes);
+      return block;
+    }
+    auto size_class = sizeClass(bytes);
+    charge(arena, (size_class + 1) * kSizeStep);
+    if (not thread_cache_destroyed) {
+      auto &blocks = thread_cache.blocks[size_class];
+      if (not blocks.empty()) {
+        auto block = blocks.back();
+        blocks.pop_back();
+        return block;
+      }
+    }
+    return ::operator new((size_class + 1) * kSizeStep);
+  }
+
+  void MemoryArenas::deallocate(MemoryArena arena, void *block, size_t bytes) {
+    if (bytes == 0 or bytes > kMaxCachedSize) {
+      discharge(arena, bytes);
+      ::operator delete(block);
+      return;
+    }
+    auto size_class = sizeClass(bytes);
+    discharge(arena, (size_class + 1) * kSizeStep);
+    if (not thread_cache_destroyed) {
+      auto &blocks = thread_cache.blocks[size_class];
+      if (blocks.size() < kMaxCachedBlocks) {
+        if (blocks.capacity() == 0) {
+          blocks.reserve(kMaxCachedBlocks);
+        }
+        blocks.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+  void MemoryArenas::collect(MetricsRegistry::Writer &writer) {
+    using Type = MetricsRegistry::Type;
+    auto samples = [&](std::string_view family, auto value) {
+      for (size_t i = 0; i < kArenasNum; ++i) {
+        auto arena = static_cast<MemoryArena>(i);
+        MetricsRegistry::Labels labels{{"arena", std::string{name(arena)}}};
+        writer.sample(family, labels, value(stats(arena)));
+      }
+    };
+    writer.family("kagome_memory_arena_bytes",
+                  Type::GAUGE,
+                  "Bytes held by the subsystems");
+    samples("kagome_memory_arena_bytes",
+            [](const Stats &stats) { return stats.bytes; });
+    writer.family("kagome_memory_arena_allocations",
+                  Type::GAUGE,
+                  "Live allocations of the subsystems");
+    samples("kagome_memory_arena_allocations",
+            [](const Stats &stats) { return stats.allocations; });
+  }
+
+}  // namespace kagome::common
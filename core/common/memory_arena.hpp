@@ -0,0 +1,148 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_MEMORY_ARENA_HPP
+#define KAGOME_CORE_COMMON_MEMORY_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "common/metrics_registry.hpp"
+
+namespace kagome::common {
+
+  /**
+   * Subsystems holding most of the memory of the node, the bytes of which
+   * are counted apart, so that it is seen which one owns the RSS
+   */
+  enum class MemoryArena : uint8_t {
+    // nodes of the tries, with the control blocks of their pointers
+    TRIE_NODES,
+    // linear memories of the runtime instances and their snapshots
+    RUNTIME_MEMORY,
+    // messages received from the peers while they are decoded, and the
+    // ones sent while they are written to the streams
+    NETWORK_BUFFERS,
+  };
+
+  /**
+   * Counters of the bytes held by the arenas, and the allocation of their
+   * memory: the small blocks freed by a thread are cached by it and reused
+   * by its next allocations of the same size, of any arena, instead of
+   * going to the global allocator each time. Thread-safe
+   */
+  class MemoryArenas {
+   public:
+    static constexpr size_t kArenasNum = 3;
+
+    /// largest block cached by the threads
+    static constexpr size_t kMaxCachedSize = 512;
+
+    /// number of the free blocks of each size a thread caches at most
+    static constexpr size_t kMaxCachedBlocks = 256;
+
+    struct Stats {
+      // held by the live allocations and the charges
+      uint64_t bytes = 0;
+      uint64_t allocations = 0;
+    };
+
+    static std::string_view name(MemoryArena arena);
+
+    static Stats stats(MemoryArena arena);
+
+    /**
+     * Counts \arg bytes as held by \arg arena, which are allocated by
+     * someone else
+     */
+    static void charge(MemoryArena arena, size_t bytes);
+
+    static void discharge(MemoryArena arena, size_t bytes);
+
+    /**
+     * @return a block of \arg bytes counted as held by \arg arena, aligned
+     * as std::max_align_t
+     */
+    static void *allocate(MemoryArena arena, size_t bytes);
+
+    /**
+     * Frees \arg block of \arg bytes allocated for \arg arena
+     */
+    static void deallocate(MemoryArena arena, void *block, size_t bytes);
+
+    /**
+     * Writes the bytes and the allocations of the arenas as the gauges
+     */
+    static void collect(MetricsRegistry::Writer &writer);
+  };
+
+  /**
+   * Counts the bytes of a buffer allocated by someone else as held by the
+   * arena while it lives
+   */
+  class MemoryCharge {
+   public:
+    MemoryCharge(MemoryArena arena, size_t bytes)
+        : arena_{arena}, bytes_{bytes} {
+      MemoryArenas::charge(arena_, bytes_);
+    }
+
+    MemoryCharge(MemoryCharge &&) = delete;
+    MemoryCharge(const MemoryCharge &) = delete;
+    MemoryCharge &operator=(MemoryCharge &&) = delete;
+    MemoryCharge &operator=(const MemoryCharge &) = delete;
+
+    ~MemoryCharge() {
+      MemoryArenas::discharge(arena_, bytes_);
+    }
+
+   private:
+    const MemoryArena arena_;
+    const size_t bytes_;
+  };
+
+  /**
+   * Allocator of the containers and std::allocate_shared, the memory of
+   * which is held by \tparam arena
+   */
+  template <typename T, MemoryArena arena>
+  class ArenaAllocator {
+   public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+      using other = ArenaAllocator<U, arena>;
+    };
+
+    ArenaAllocator() noexcept = default;
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, arena> &) noexcept {}  // NOLINT
+
+    T *allocate(size_t n) {
+      static_assert(alignof(T) <= alignof(std::max_align_t));
+      return static_cast<T *>(MemoryArenas::allocate(arena, n * sizeof(T)));
+    }
+
+    void deallocate(T *block, size_t n) noexcept {
+      MemoryArenas::deallocate(arena, block, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U, arena> &) const noexcept {
+      return true;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U, arena> &) const noexcept {
+      return false;
+    }
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_MEMORY_ARENA_HPP
@@ -0,0 +1,248 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/metrics_registry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include <boost/assert.hpp>
+
+namespace kagome::common {
+
+  namespace {
+    const char *typeName(MetricsRegistry::Type type) {
+      switch (type) {
+        case MetricsRegistry::Type::COUNTER:
+          return "counter";
+        case MetricsRegistry::Type::GAUGE:
+          return "gauge";
+        case MetricsRegistry::Type::HISTOGRAM:
+          return "histogram";
+        case MetricsRegistry::Type::SUMMARY:
+          return "summary";
+      }
+      return "untyped";
+    }
+
+    std::string formatValue(double value) {
+      if (std::isnan(value)) {
+        return "NaN";
+      }
+      if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+      }
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+      return buffer;
+    }
+
+    double seconds(std::chrono::nanoseconds duration) {
+      return std::chrono::duration<double>(duration).count();
+    }
+
+    // the help texts are escaped as the label values are, but the quotes
+    std::string escape(std::string_view text, bool quotes) {
+      std::string result;
+      result.reserve(text.size());
+      for (auto c : text) {
+        if (c == '\\') {
+          result += "\\\\";
+        } else if (c == '\n') {
+          result += "\\n";
+        } else if (c == '"' and quotes) {
+          result += "\\\"";
+        } else {
+          result += c;
+        }
+      }
+      return result;
+    }
+  }  // namespace
+
+  const std::vector<double> MetricsRegistry::kDefaultBuckets = {
+      0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+
+  MetricsRegistry::Histogram::Histogram(std::vector<double> bounds)
+      : bounds_{std::move(bounds)}, counts_(bounds_.size() + 1) {
+    BOOST_ASSERT(std::is_sorted(bounds_.begin(), bounds_.end()));
+  }
+
+  void MetricsRegistry::Histogram::observe(double value) {
+    auto it = std::lower_bound(bounds_.begin(), bounds_.end(), value);
+    auto bucket = it - bounds_.begin();
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    auto sum = sum_.load(std::memory_order_relaxed);
+    while (not sum_.compare_exchange_weak(
+        sum, sum + value, std::memory_order_relaxed)) {
+    }
+  }
+
+  void MetricsRegistry::Histogram::observe(
+      std::chrono::steady_clock::duration duration) {
+    observe(seconds(duration));
+  }
+
+  MetricsRegistry::Histogram::Snapshot MetricsRegistry::Histogram::snapshot()
+      const {
+    Snapshot snapshot;
+    snapshot.buckets.reserve(counts_.size());
+    uint64_t total = 0;
+    for (auto &count : counts_) {
+      total += count.load(std::memory_order_relaxed);
+      snapshot.buckets.push_back(total);
+    }
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  void MetricsRegistry::Writer::family(std::string_view name,
+                                       Type type,
+                                       std::string_view help) {
+    if (not families_.emplace(name).second) {
+      return;
+    }
+    text_.append("# HELP ").append(name).append(" ");
+    text_.append(escape(help, false)).append("\n");
+    text_.append("# TYPE ").append(name).append(" ");
+    text_.append(typeName(type)).append("\n");
+  }
+
+  void MetricsRegistry::Writer::sample(std::string_view name,
+                                       const Labels &labels,
+                                       double value) {
+    text_.append(name);
+    this->labels(labels);
+    text_.append(" ").append(formatValue(value)).append("\n");
+  }
+
+  void MetricsRegistry::Writer::sample(std::string_view name,
+                                       const Labels &labels,
+                                       uint64_t value) {
+    text_.append(name);
+    this->labels(labels);
+    text_.append(" ").append(std::to_string(value)).append("\n");
+  }
+
+  void MetricsRegistry::Writer::durations(
+      std::string_view name,
+      const Labels &labels,
+      const DurationHistogram::Stats &stats) {
+    auto quantile = labels;
+    quantile["quantile"] = "0.99";
+    sample(name, quantile, seconds(stats.p99));
+    quantile["quantile"] = "1";
+    sample(name, quantile, seconds(stats.max));
+    std::string sum{name};
+    sample(sum + "_sum", labels, seconds(stats.total));
+    sample(sum + "_count", labels, stats.calls);
+  }
+
+  void MetricsRegistry::Writer::labels(const Labels &labels) {
+    if (labels.empty()) {
+      return;
+    }
+    text_ += '{';
+    bool first = true;
+    for (auto &[label, value] : labels) {
+      if (not first) {
+        text_ += ',';
+      }
+      first = false;
+      text_.append(label).append("=\"");
+      text_.append(escape(value, true)).append("\"");
+    }
+    text_ += '}';
+  }
+
+  MetricsRegistry::Family &MetricsRegistry::family(const std::string &name,
+                                                   Type type,
+                                                   const std::string &help) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+      it = families_.emplace(name, Family{type, help, {}, {}, {}}).first;
+    }
+    // the names of the metrics are fixed in the code
+    BOOST_ASSERT(it->second.type == type);
+    return it->second;
+  }
+
+  MetricsRegistry::Counter &MetricsRegistry::counter(const std::string &name,
+                                                     const std::string &help,
+                                                     const Labels &labels) {
+    std::lock_guard lock{mutex_};
+    auto &metric = family(name, Type::COUNTER, help).counters[labels];
+    if (metric == nullptr) {
+      metric = std::make_unique<Counter>();
+    }
+    return *metric;
+  }
+
+  MetricsRegistry::Gauge &MetricsRegistry::gauge(const std::string &name,
+                                                 const std::string &help,
+                                                 const Labels &labels) {
+    std::lock_guard lock{mutex_};
+    auto &metric = family(name, Type::GAUGE, help).gauges[labels];
+    if (metric == nullptr) {
+      metric = std::make_unique<Gauge>();
+    }
+    return *metric;
+  }
+
+  MetricsRegistry::Histogram &MetricsRegistry::histogram(
+      const std::string &name,
+      const std::string &help,
+      const Labels &labels,
+      const std::vector<double> &bounds) {
+    std::lock_guard lock{mutex_};
+    auto &metric = family(name, Type::HISTOGRAM, help).histograms[labels];
+    if (metric == nullptr) {
+      metric = std::make_unique<Histogram>(bounds);
+    }
+    return *metric;
+  }
+
+  void MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard lock{mutex_};
+    collectors_.emplace_back(std::move(collector));
+  }
+
+  std::string MetricsRegistry::exposition() const {
+    Writer writer;
+    std::vector<Collector> collectors;
+    {
+      std::lock_guard lock{mutex_};
+      for (auto &[name, family] : families_) {
+        writer.family(name, family.type, family.help);
+        for (auto &[labels, counter] : family.counters) {
+          writer.sample(name, labels, counter->value());
+        }
+        for (auto &[labels, gauge] : family.gauges) {
+          writer.sample(name, labels, static_cast<double>(gauge->value()));
+        }
+        for (auto &[labels, histogram] : family.histograms) {
+          auto snapshot = histogram->snapshot();
+          auto &bounds = histogram->bounds();
+          auto bucket = labels;
+          for (size_t i = 0; i < snapshot.buckets.size(); ++i) {
+            bucket["le"] =
+                i < bounds.size() ? formatValue(bounds[i]) : "+Inf";
+            writer.sample(name + "_bucket", bucket, snapshot.buckets[i]);
+          }
+          writer.sample(name + "_sum", labels, snapshot.sum);
+          writer.sample(name + "_count", labels, snapshot.buckets.back());
+        }
+      }
+      collectors = collectors_;
+    }
+    // the collectors take the locks of their own, and may register metrics
+    for (auto &collector : collectors) {
+      collector(writer);
+    }
+    return writer.text();
+  }
+
+}  // namespace kagome::common
@@ -0,0 +1,194 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_METRICS_REGISTRY_HPP
+#define KAGOME_CORE_COMMON_METRICS_REGISTRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/duration_histogram.hpp"
+
+namespace kagome::common {
+
+  /**
+   * Registry of the metrics of the node, which are exported in the text
+   * format of Prometheus. A metric is registered once by its name and its
+   * labels, and is then updated without locks, as its values are atomic.
+   * The subsystems which keep statistics of their own add collectors
+   * instead, which write them out on every scrape. Thread-safe
+   */
+  class MetricsRegistry {
+   public:
+    using Labels = std::map<std::string, std::string>;
+
+    enum class Type { COUNTER, GAUGE, HISTOGRAM, SUMMARY };
+
+    /// upper bounds of the buckets of the histograms by default, in seconds
+    static const std::vector<double> kDefaultBuckets;
+
+    class Counter {
+     public:
+      void inc(uint64_t delta = 1) {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+      }
+
+      uint64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+      }
+
+     private:
+      std::atomic<uint64_t> value_{0};
+    };
+
+    class Gauge {
+     public:
+      void set(int64_t value) {
+        value_.store(value, std::memory_order_relaxed);
+      }
+
+      void inc(int64_t delta = 1) {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+      }
+
+      void dec(int64_t delta = 1) {
+        value_.fetch_sub(delta, std::memory_order_relaxed);
+      }
+
+      int64_t value() const {
+        return value_.load(std::memory_order_relaxed);
+      }
+
+     private:
+      std::atomic<int64_t> value_{0};
+    };
+
+    class Histogram {
+     public:
+      struct Snapshot {
+        // cumulative, one for each bound and the last one for +Inf
+        std::vector<uint64_t> buckets;
+        double sum = 0;
+      };
+
+      /**
+       * @param bounds - ascending upper bounds of the buckets, the one of
+       * +Inf is implied
+       */
+      explicit Histogram(std::vector<double> bounds);
+
+      void observe(double value);
+
+      /// observes \arg duration in seconds
+      void observe(std::chrono::steady_clock::duration duration);
+
+      const std::vector<double> &bounds() const {
+        return bounds_;
+      }
+
+      Snapshot snapshot() const;
+
+     private:
+      const std::vector<double> bounds_;
+      std::vector<std::atomic<uint64_t>> counts_;
+      std::atomic<double> sum_{0};
+    };
+
+    /**
+     * Writes the samples of the families of the metrics in the text format
+     */
+    class Writer {
+     public:
+      /**
+       * Starts the family \arg name of \arg type, which is described by
+       * \arg help, unless it is started already
+       */
+      void family(std::string_view name, Type type, std::string_view help);
+
+      void sample(std::string_view name, const Labels &labels, double value);
+
+      void sample(std::string_view name, const Labels &labels, uint64_t value);
+
+      /**
+       * Writes \arg stats as a summary \arg name, in seconds, with the
+       * quantiles 0.99 and 1, which is the max
+       */
+      void durations(std::string_view name,
+                     const Labels &labels,
+                     const DurationHistogram::Stats &stats);
+
+      const std::string &text() const {
+        return text_;
+      }
+
+     private:
+      void labels(const Labels &labels);
+
+      std::string text_;
+      std::set<std::string, std::less<>> families_;
+    };
+
+    using Collector = std::function<void(Writer &)>;
+
+    /**
+     * @return the counter \arg name with \arg labels, registered if it is
+     * not yet, which is described by \arg help
+     */
+    Counter &counter(const std::string &name,
+                     const std::string &help,
+                     const Labels &labels = {});
+
+    Gauge &gauge(const std::string &name,
+                 const std::string &help,
+                 const Labels &labels = {});
+
+    /**
+     * @return the histogram \arg name with \arg labels, registered with the
+     * buckets of \arg bounds if it is not yet
+     */
+    Histogram &histogram(const std::string &name,
+                         const std::string &help,
+                         const Labels &labels = {},
+                         const std::vector<double> &bounds = kDefaultBuckets);
+
+    /**
+     * Adds \arg collector, which is called on every scrape
+     */
+    void addCollector(Collector collector);
+
+    /**
+     * @return all the metrics in the text format of Prometheus
+     */
+    std::string exposition() const;
+
+   private:
+    struct Family {
+      Type type;
+      std::string help;
+      std::map<Labels, std::unique_ptr<Counter>> counters;
+      std::map<Labels, std::unique_ptr<Gauge>> gauges;
+      std::map<Labels, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Family &family(const std::string &name,
+                   Type type,
+                   const std::string &help);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    std::vector<Collector> collectors_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_METRICS_REGISTRY_HPP
@@ -0,0 +1,225 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/process_profiler.hpp"
+
+#include <dlfcn.h>
+
+#include <boost/filesystem.hpp>
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::common, ProcessProfiler::Error, e) {
+  using E = kagome::common::ProcessProfiler::Error;
+  switch (e) {
+    case E::DISABLED:
+      return "The profiles are disabled, as there is no directory for them";
+    case E::NOT_SUPPORTED:
+      return "The profiles of the kind need gperftools, which is not linked";
+    case E::INVALID_DURATION:
+      return "The duration of the profile is out of range";
+    case E::ALREADY_RUNNING:
+      return "Another profile is running";
+    case E::NOT_RUNNING:
+      return "No profile is running";
+    case E::START_FAILED:
+      return "The profile could not be started";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::common {
+
+  namespace {
+    // the functions of gperftools, jemalloc and tcmalloc
+    struct Hooks {
+      int (*profiler_start)(const char *);
+      void (*profiler_stop)();
+      void (*heap_profiler_start)(const char *);
+      void (*heap_profiler_dump)(const char *);
+      void (*heap_profiler_stop)();
+      int (*mallctl)(const char *, void *, size_t *, void *, size_t);
+      int (*get_numeric_property)(const char *, size_t *);
+    };
+
+    template <typename F>
+    void lookup(F &function, const char *name) {
+      function = reinterpret_cast<F>(dlsym(RTLD_DEFAULT, name));
+    }
+
+    const Hooks &hooks() {
+      static const Hooks hooks = [] {
+        Hooks hooks{};
+        lookup(hooks.profiler_start, "ProfilerStart");
+        lookup(hooks.profiler_stop, "ProfilerStop");
+        lookup(hooks.heap_profiler_start, "HeapProfilerStart");
+        lookup(hooks.heap_profiler_dump, "HeapProfilerDump");
+        lookup(hooks.heap_profiler_stop, "HeapProfilerStop");
+        lookup(hooks.mallctl, "mallctl");
+        if (hooks.mallctl == nullptr) {
+          // jemalloc is prefixed on macOS
+          lookup(hooks.mallctl, "je_mallctl");
+        }
+        lookup(hooks.get_numeric_property,
+               "MallocExtension_GetNumericProperty");
+        return hooks;
+      }();
+      return hooks;
+    }
+
+    boost::optional<uint64_t> jemallocStat(const char *name) {
+      size_t value = 0;
+      size_t size = sizeof(value);
+      if (hooks().mallctl(name, &value, &size, nullptr, 0) != 0) {
+        return boost::none;
+      }
+      return value;
+    }
+
+    boost::optional<uint64_t> tcmallocStat(const char *name) {
+      size_t value = 0;
+      if (hooks().get_numeric_property(name, &value) == 0) {
+        return boost::none;
+      }
+      return value;
+    }
+  }  // namespace
+
+  ProcessProfiler::ProcessProfiler(
+      std::string directory,
+      std::shared_ptr<boost::asio::io_context> io_context)
+      : directory_{std::move(directory)}, timer_{*io_context} {}
+
+  ProcessProfiler::~ProcessProfiler() {
+    std::lock_guard lock{mutex_};
+    if (running_) {
+      stopRunning();
+    }
+  }
+
+  bool ProcessProfiler::isSupported(Kind kind) {
+    auto &hooks = common::hooks();
+    switch (kind) {
+      case Kind::CPU:
+        return hooks.profiler_start != nullptr
+               and hooks.profiler_stop != nullptr;
+      case Kind::HEAP:
+        return hooks.heap_profiler_start != nullptr
+               and hooks.heap_profiler_dump != nullptr
+               and hooks.heap_profiler_stop != nullptr;
+    }
+    return false;
+  }
+
+  outcome::result<std::string> ProcessProfiler::start(
+      Kind kind, std::chrono::seconds duration) {
+    if (not isEnabled()) {
+      return Error::DISABLED;
+    }
+    if (duration.count() <= 0 or duration > kMaxDuration) {
+      return Error::INVALID_DURATION;
+    }
+    if (not isSupported(kind)) {
+      return Error::NOT_SUPPORTED;
+    }
+    std::lock_guard lock{mutex_};
+    if (running_) {
+      return Error::ALREADY_RUNNING;
+    }
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(directory_, ec);
+    if (ec) {
+      return Error::START_FAILED;
+    }
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+    auto name = (kind == Kind::CPU ? "cpu-" : "heap-") + std::to_string(now);
+    auto path = (boost::filesystem::path{directory_} / name).string();
+    if (kind == Kind::CPU) {
+      path += ".prof";
+      if (hooks().profiler_start(path.c_str()) == 0) {
+        return Error::START_FAILED;
+      }
+    } else {
+      // gperftools appends the numbers of the dumps and .heap to the prefix
+      hooks().heap_profiler_start(path.c_str());
+    }
+    running_ = kind;
+    timer_.expires_after(duration);
+    timer_.async_wait([weak = weak_from_this(), generation = ++generation_](
+                          const boost::system::error_code &ec) {
+      auto self = weak.lock();
+      if (ec or self == nullptr) {
+        return;
+      }
+      std::lock_guard lock{self->mutex_};
+      if (self->generation_ == generation and self->running_) {
+        self->stopRunning();
+      }
+    });
+    return path;
+  }
+
+  outcome::result<void> ProcessProfiler::stop() {
+    std::lock_guard lock{mutex_};
+    if (not running_) {
+      return Error::NOT_RUNNING;
+    }
+    timer_.cancel();
+    stopRunning();
+    return outcome::success();
+  }
+
+  void ProcessProfiler::stopRunning() {
+    if (running_ == Kind::CPU) {
+      hooks().profiler_stop();
+    } else {
+      hooks().heap_profiler_dump("rpc");
+      hooks().heap_profiler_stop();
+    }
+    running_.reset();
+  }
+
+  boost::optional<ProcessProfiler::AllocatorStats>
+  ProcessProfiler::allocatorStats() {
+    if (hooks().mallctl != nullptr) {
+      // the statistics of jemalloc are cached until the epoch is advanced
+      uint64_t epoch = 1;
+      size_t size = sizeof(epoch);
+      hooks().mallctl("epoch", &epoch, &size, &epoch, size);
+      auto allocated = jemallocStat("stats.allocated");
+      auto heap = jemallocStat("stats.mapped");
+      if (allocated and heap) {
+        return AllocatorStats{"jemalloc", *allocated, *heap};
+      }
+    }
+    if (hooks().get_numeric_property != nullptr) {
+      auto allocated = tcmallocStat("generic.current_allocated_bytes");
+      auto heap = tcmallocStat("generic.heap_size");
+      if (allocated and heap) {
+        return AllocatorStats{"tcmalloc", *allocated, *heap};
+      }
+    }
+    return boost::none;
+  }
+
+  void ProcessProfiler::collect(MetricsRegistry::Writer &writer) {
+    using Type = MetricsRegistry::Type;
+    auto stats = allocatorStats();
+    if (not stats) {
+      return;
+    }
+    MetricsRegistry::Labels labels{{"allocator", stats->allocator}};
+    writer.family("kagome_allocator_allocated_bytes",
+                  Type::GAUGE,
+                  "Bytes of the live allocations");
+    writer.sample(
+        "kagome_allocator_allocated_bytes", labels, stats->allocated);
+    writer.family("kagome_allocator_heap_bytes",
+                  Type::GAUGE,
+                  "Bytes taken from the system by the allocator");
+    writer.sample("kagome_allocator_heap_bytes", labels, stats->heap);
+  }
+
+}  // namespace kagome::common
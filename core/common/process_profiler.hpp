@@ -0,0 +1,119 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_PROCESS_PROFILER_HPP
+#define KAGOME_CORE_COMMON_PROCESS_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/optional.hpp>
+
+#include "common/metrics_registry.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::common {
+
+  /**
+   * Takes the CPU and the heap profiles of the whole process for a while,
+   * on demand, with gperftools, and reads the statistics of jemalloc or
+   * tcmalloc. Neither is a dependency of the node: their functions are
+   * looked up in the process, so they are there only if the library is
+   * linked or preloaded, otherwise the profiles are not supported and there
+   * are no statistics. Thread-safe
+   */
+  class ProcessProfiler
+      : public std::enable_shared_from_this<ProcessProfiler> {
+   public:
+    enum class Kind { CPU, HEAP };
+
+    enum class Error {
+      DISABLED = 1,
+      NOT_SUPPORTED,
+      INVALID_DURATION,
+      ALREADY_RUNNING,
+      NOT_RUNNING,
+      START_FAILED
+    };
+
+    struct AllocatorStats {
+      // jemalloc or tcmalloc
+      std::string allocator;
+      // by the live allocations
+      uint64_t allocated = 0;
+      // taken from the system by the allocator, including its free memory
+      uint64_t heap = 0;
+    };
+
+    /// longest profile taken
+    static constexpr std::chrono::seconds kMaxDuration{600};
+
+    /**
+     * @param directory the profiles are written to, empty disables them
+     * @param io_context runs the timers stopping the profiles
+     */
+    ProcessProfiler(std::string directory,
+                    std::shared_ptr<boost::asio::io_context> io_context);
+
+    /// the running profile is stopped and written out
+    ~ProcessProfiler();
+
+    bool isEnabled() const {
+      return not directory_.empty();
+    }
+
+    /**
+     * @return whether the library taking the profiles of \arg kind is there
+     */
+    static bool isSupported(Kind kind);
+
+    /**
+     * Starts the profile of \arg kind, which is stopped after \arg duration
+     * unless it is stopped earlier. One profile is taken at a time
+     * @return path of the file of the CPU profile, or the prefix of the
+     * files of the heap profile
+     */
+    outcome::result<std::string> start(Kind kind,
+                                       std::chrono::seconds duration);
+
+    /**
+     * Stops the running profile and writes it out
+     */
+    outcome::result<void> stop();
+
+    /**
+     * @return statistics of the allocator, none if it is neither jemalloc
+     * nor tcmalloc
+     */
+    static boost::optional<AllocatorStats> allocatorStats();
+
+    /**
+     * Writes the statistics of the allocator as the gauges, if there are
+     * any
+     */
+    static void collect(MetricsRegistry::Writer &writer);
+
+   private:
+    /// stops the running profile, under the mutex
+    void stopRunning();
+
+    const std::string directory_;
+    std::mutex mutex_;
+    boost::asio::steady_timer timer_;
+    boost::optional<Kind> running_;
+    // tells a stale timer from the one of the running profile
+    uint64_t generation_ = 0;
+  };
+
+}  // namespace kagome::common
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::common, ProcessProfiler::Error);
+
+#endif  // KAGOME_CORE_COMMON_PROCESS_PROFILER_HPP
@@ -0,0 +1,272 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_SMALL_BUFFER_HPP
+#define KAGOME_CORE_COMMON_SMALL_BUFFER_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <gsl/span>
+
+#include "common/buffer.hpp"
+#include "common/hexutil.hpp"
+
+namespace kagome::common {
+
+  /**
+   * @brief Byte buffer with the API of Buffer, which keeps up to \arg N bytes
+   * inline and allocates only for the longer contents. Suits the short keys,
+   * hashes and nibble paths, which are created and dropped by the million
+   */
+  template <size_t N>
+  class SmallBuffer {
+    using Storage = boost::container::small_vector<uint8_t, N>;
+
+   public:
+    using iterator = typename Storage::iterator;
+    using const_iterator = typename Storage::const_iterator;
+    using value_type = uint8_t;
+    // with this gsl::span can be built from SmallBuffer
+    using pointer = typename Storage::pointer;
+    using const_pointer = typename Storage::const_pointer;
+
+    /// number of bytes kept without an allocation
+    static constexpr size_t kInlineCapacity = N;
+
+    SmallBuffer() = default;
+
+    /**
+     * @brief allocates buffer of size={@param size}, filled with {@param byte}
+     */
+    SmallBuffer(size_t size, uint8_t byte) : data_(size, byte) {}
+
+    explicit SmallBuffer(gsl::span<const uint8_t> s)
+        : data_(s.begin(), s.end()) {}
+
+    SmallBuffer(const uint8_t *begin, const uint8_t *end)
+        : data_(begin, end) {}
+
+    SmallBuffer(std::initializer_list<uint8_t> b) : data_(b) {}
+
+    SmallBuffer &reserve(size_t size) {
+      data_.reserve(size);
+      return *this;
+    }
+
+    SmallBuffer &resize(size_t size) {
+      data_.resize(size);
+      return *this;
+    }
+
+    SmallBuffer &operator+=(const SmallBuffer &other) noexcept {
+      return putBuffer(other);
+    }
+
+    /**
+     * @brief Accessor of byte elements given {@param index} in bytearray
+     */
+    uint8_t operator[](size_t index) const {
+      return data_[index];
+    }
+
+    /**
+     * @brief Accessor of byte elements given {@param index} in bytearray
+     */
+    uint8_t &operator[](size_t index) {
+      return data_[index];
+    }
+
+    /**
+     * @brief Lexicographical comparison of two buffers
+     */
+    bool operator==(const SmallBuffer &b) const noexcept {
+      return compare(*this, b) == 0;
+    }
+
+    bool operator!=(const SmallBuffer &b) const noexcept {
+      return not operator==(b);
+    }
+
+    /**
+     * @brief Lexicographical comparison of buffer and span of bytes
+     */
+    bool operator==(gsl::span<const uint8_t> s) const noexcept {
+      return compare(*this, s) == 0;
+    }
+
+    /**
+     * @brief Lexicographical comparison of two buffers
+     */
+    bool operator<(const SmallBuffer &b) const noexcept {
+      return compare(*this, b) < 0;
+    }
+
+    // the heterogeneous comparisons with Buffer, which allow the containers
+    // of small buffers to be looked up with the buffers
+    friend bool operator==(const SmallBuffer &a, const Buffer &b) noexcept {
+      return compare(a, b) == 0;
+    }
+
+    friend bool operator==(const Buffer &a, const SmallBuffer &b) noexcept {
+      return compare(a, b) == 0;
+    }
+
+    friend bool operator!=(const SmallBuffer &a, const Buffer &b) noexcept {
+      return compare(a, b) != 0;
+    }
+
+    friend bool operator!=(const Buffer &a, const SmallBuffer &b) noexcept {
+      return compare(a, b) != 0;
+    }
+
+    friend bool operator<(const SmallBuffer &a, const Buffer &b) noexcept {
+      return compare(a, b) < 0;
+    }
+
+    friend bool operator<(const Buffer &a, const SmallBuffer &b) noexcept {
+      return compare(a, b) < 0;
+    }
+
+    iterator begin() {
+      return data_.begin();
+    }
+
+    iterator end() {
+      return data_.end();
+    }
+
+    const_iterator begin() const {
+      return data_.begin();
+    }
+
+    const_iterator end() const {
+      return data_.end();
+    }
+
+    size_t size() const {
+      return data_.size();
+    }
+
+    bool empty() const {
+      return data_.empty();
+    }
+
+    /**
+     * @brief Put a 8-bit {@param n} in this buffer.
+     * @return this buffer, suitable for chaining.
+     */
+    SmallBuffer &putUint8(uint8_t n) {
+      data_.push_back(n);
+      return *this;
+    }
+
+    /**
+     * @brief Put a string into byte buffer
+     * @return this buffer, suitable for chaining.
+     */
+    SmallBuffer &put(std::string_view str) {
+      data_.insert(data_.end(), str.begin(), str.end());
+      return *this;
+    }
+
+    /**
+     * @brief Put a sequence of bytes into byte buffer
+     * @return this buffer, suitable for chaining.
+     */
+    SmallBuffer &put(gsl::span<const uint8_t> s) {
+      data_.insert(data_.end(), s.begin(), s.end());
+      return *this;
+    }
+
+    /**
+     * @brief Put a array of bytes bounded by pointers into byte buffer
+     * @return this buffer, suitable for chaining.
+     */
+    SmallBuffer &putBytes(const uint8_t *begin, const uint8_t *end) {
+      data_.insert(data_.end(), begin, end);
+      return *this;
+    }
+
+    /**
+     * @brief Put another buffer content at the end of current one
+     * @return this buffer suitable for chaining.
+     */
+    SmallBuffer &putBuffer(const SmallBuffer &buf) {
+      data_.insert(data_.end(), buf.begin(), buf.end());
+      return *this;
+    }
+
+    /**
+     * Clear the contents of the buffer, the allocated memory is kept
+     */
+    void clear() {
+      data_.clear();
+    }
+
+    /**
+     * @brief getter for raw array of bytes
+     */
+    const uint8_t *data() const {
+      return data_.data();
+    }
+
+    uint8_t *data() {
+      return data_.data();
+    }
+
+    /**
+     * Returns a copy of a part of the buffer
+     * Works alike subspan() of gsl::span
+     */
+    SmallBuffer subbuffer(size_t offset = 0, size_t length = -1) const {
+      offset = std::min(offset, size());
+      length = std::min(length, size() - offset);
+      return SmallBuffer{data() + offset, data() + offset + length};
+    }
+
+    /**
+     * @brief encode bytearray as hex
+     * @return hex-encoded string
+     */
+    std::string toHex() const {
+      return hex_lower(*this);
+    }
+
+   private:
+    /// three-way lexicographical comparison of the bytes of \arg a and \arg b
+    static int compare(gsl::span<const uint8_t> a,
+                       gsl::span<const uint8_t> b) noexcept {
+      auto common = static_cast<size_t>(std::min(a.size(), b.size()));
+      if (common != 0) {
+        if (auto r = std::memcmp(a.data(), b.data(), common); r != 0) {
+          return r;
+        }
+      }
+      return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+    }
+
+    Storage data_;
+  };
+
+  template <size_t N>
+  std::ostream &operator<<(std::ostream &os, const SmallBuffer<N> &buffer) {
+    return os << buffer.toHex();
+  }
+
+}  // namespace kagome::common
+
+template <size_t N>
+struct std::hash<kagome::common::SmallBuffer<N>> {
+  size_t operator()(const kagome::common::SmallBuffer<N> &x) const {
+    return boost::hash_range(x.begin(), x.end());
+  }
+};
+
+#endif  // KAGOME_CORE_COMMON_SMALL_BUFFER_HPP
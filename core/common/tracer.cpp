@@ -0,0 +1,160 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/tracer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include <boost/assert.hpp>
+
+namespace kagome::common {
+
+  namespace {
+    std::atomic<uint64_t> next_tracer_id{0};
+
+    // the rings of the calling thread by the ids of their tracers
+    thread_local std::vector<std::pair<uint64_t, std::shared_ptr<void>>>
+        thread_rings;
+
+    double microseconds(Tracer::Clock::duration duration) {
+      return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    void appendEscaped(std::string &out, std::string_view text) {
+      for (auto c : text) {
+        if (c == '"' or c == '\\') {
+          out += '\\';
+          out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          out += buffer;
+        } else {
+          out += c;
+        }
+      }
+    }
+
+    void appendNumber(std::string &out, double value) {
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "%.3f", value);
+      out += buffer;
+    }
+  }  // namespace
+
+  Tracer::Scope::Scope(Tracer *tracer,
+                       std::string_view category,
+                       std::string_view name)
+      : tracer_{tracer != nullptr and tracer->isEnabled() ? tracer : nullptr},
+        category_{category},
+        name_{name} {
+    if (tracer_ != nullptr) {
+      start_ = Clock::now();
+    }
+  }
+
+  Tracer::Scope::~Scope() {
+    if (tracer_ != nullptr) {
+      tracer_->record(category_, name_, start_, Clock::now() - start_);
+    }
+  }
+
+  Tracer::Tracer(bool enabled, size_t spans_per_thread)
+      : id_{next_tracer_id.fetch_add(1, std::memory_order_relaxed)},
+        spans_per_thread_{spans_per_thread},
+        epoch_{Clock::now()},
+        enabled_{enabled} {
+    BOOST_ASSERT(spans_per_thread_ > 0);
+  }
+
+  void Tracer::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  void Tracer::record(std::string_view category,
+                      std::string_view name,
+                      Clock::time_point start,
+                      Clock::duration duration) {
+    auto &ring = threadRing();
+    std::lock_guard lock{ring.mutex};
+    Span span{category, name, start, duration, ring.thread};
+    if (ring.spans.size() < spans_per_thread_) {
+      ring.spans.push_back(span);
+    } else {
+      ring.spans[ring.next] = span;
+    }
+    ring.next = (ring.next + 1) % spans_per_thread_;
+  }
+
+  std::vector<Tracer::Span> Tracer::spans() const {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+      std::lock_guard lock{mutex_};
+      rings = rings_;
+    }
+    std::vector<Span> spans;
+    for (auto &ring : rings) {
+      std::lock_guard lock{ring->mutex};
+      spans.insert(spans.end(), ring->spans.begin(), ring->spans.end());
+    }
+    std::sort(spans.begin(), spans.end(), [](auto &lhs, auto &rhs) {
+      return lhs.start < rhs.start;
+    });
+    return spans;
+  }
+
+  std::string Tracer::chromeTrace() const {
+    auto spans = this->spans();
+    std::string trace = "{\"traceEvents\":[";
+    bool first = true;
+    for (auto &span : spans) {
+      if (not first) {
+        trace += ',';
+      }
+      first = false;
+      trace += "{\"name\":\"";
+      appendEscaped(trace, span.name);
+      trace += "\",\"cat\":\"";
+      appendEscaped(trace, span.category);
+      trace += "\",\"ph\":\"X\",\"ts\":";
+      appendNumber(trace, microseconds(span.start - epoch_));
+      trace += ",\"dur\":";
+      appendNumber(trace, microseconds(span.duration));
+      trace += ",\"pid\":1,\"tid\":";
+      trace += std::to_string(span.thread);
+      trace += '}';
+    }
+    trace += "],\"displayTimeUnit\":\"ms\"}";
+    return trace;
+  }
+
+  void Tracer::reset() {
+    std::lock_guard lock{mutex_};
+    for (auto &ring : rings_) {
+      std::lock_guard ring_lock{ring->mutex};
+      ring->spans.clear();
+      ring->next = 0;
+    }
+  }
+
+  Tracer::Ring &Tracer::threadRing() {
+    for (auto &[id, ring] : thread_rings) {
+      if (id == id_) {
+        return *static_cast<Ring *>(ring.get());
+      }
+    }
+    auto ring = std::make_shared<Ring>();
+    {
+      std::lock_guard lock{mutex_};
+      ring->thread = static_cast<uint32_t>(rings_.size());
+      rings_.push_back(ring);
+    }
+    thread_rings.emplace_back(id_, ring);
+    return *ring;
+  }
+
+}  // namespace kagome::common
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_TRACER_HPP
+#define KAGOME_CORE_COMMON_TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kagome::common {
+
+  /**
+   * Records the spans of the work of the subsystems, like the stages of the
+   * import of a block, so that the time of a slow one is broken down by
+   * them. Each thread records into a ring buffer of its own, which keeps
+   * the latest spans of it, so the threads do not contend. Does nothing but
+   * checking a flag while it is disabled. Thread-safe
+   */
+  class Tracer {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /// number of the latest spans kept for each thread by default, which
+    /// are enough for the host calls of a block
+    static constexpr size_t kDefaultSpansPerThread = 65536;
+
+    struct Span {
+      // both have to stay valid as long as the tracer, so they are literals
+      // or the like
+      std::string_view category;
+      std::string_view name;
+      Clock::time_point start;
+      Clock::duration duration;
+      // number of the thread in the order they recorded their first spans
+      uint32_t thread;
+    };
+
+    /**
+     * Records the span from its construction to its destruction, if there
+     * is a tracer and it is enabled at the construction
+     */
+    class Scope {
+     public:
+      /**
+       * @param tracer may be nullptr
+       * @param category and \arg name have to stay valid as long as the
+       * tracer
+       */
+      Scope(Tracer *tracer, std::string_view category, std::string_view name);
+
+      Scope(Scope &&) = delete;
+      Scope(const Scope &) = delete;
+      Scope &operator=(Scope &&) = delete;
+      Scope &operator=(const Scope &) = delete;
+      ~Scope();
+
+     private:
+      Tracer *tracer_;
+      std::string_view category_;
+      std::string_view name_;
+      Clock::time_point start_;
+    };
+
+    explicit Tracer(bool enabled = false,
+                    size_t spans_per_thread = kDefaultSpansPerThread);
+
+    bool isEnabled() const {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled);
+
+    void record(std::string_view category,
+                std::string_view name,
+                Clock::time_point start,
+                Clock::duration duration);
+
+    /**
+     * @return the spans kept for all the threads, in the order of their
+     * starts
+     */
+    std::vector<Span> spans() const;
+
+    /**
+     * @return the spans in the JSON format of the Chrome trace events, which
+     * chrome://tracing and Perfetto open, the times are in microseconds
+     * since the construction of the tracer
+     */
+    std::string chromeTrace() const;
+
+    /**
+     * Forgets the spans recorded so far
+     */
+    void reset();
+
+   private:
+    struct Ring {
+      uint32_t thread = 0;
+      std::mutex mutex;
+      std::vector<Span> spans;
+      // where the next span is written, the oldest one once it is full
+      size_t next = 0;
+    };
+
+    /// ring of the calling thread, which is added on its first span
+    Ring &threadRing();
+
+    // tells the tracers apart in the cache of the rings of a thread, as an
+    // address may be reused by another tracer
+    const uint64_t id_;
+    const size_t spans_per_thread_;
+    const Clock::time_point epoch_;
+    std::atomic_bool enabled_;
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_TRACER_HPP
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/worker_pool.hpp"
+
+#include <algorithm>
+
+namespace kagome::common {
+
+  namespace {
+    // pool the current thread belongs to, if any
+    thread_local const WorkerPool *current_pool = nullptr;
+  }  // namespace
+
+  WorkerPool::WorkerPool(size_t threads_num) {
+    threads_num = std::max<size_t>(threads_num, 1);
+    threads_.reserve(threads_num);
+    for (size_t i = 0; i < threads_num; ++i) {
+      threads_.emplace_back([this] { work(); });
+    }
+  }
+
+  WorkerPool::~WorkerPool() {
+    {
+      std::lock_guard lock{mutex_};
+      stopped_ = true;
+    }
+    queue_cv_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  size_t WorkerPool::defaultThreadsNum() {
+    return std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                            kMaxDefaultThreads);
+  }
+
+  void WorkerPool::post(Task task) {
+    {
+      std::lock_guard lock{mutex_};
+      queue_.push_back(std::move(task));
+    }
+    queue_cv_.notify_one();
+  }
+
+  bool WorkerPool::isOwnThread() const {
+    return current_pool == this;
+  }
+
+  void WorkerPool::work() {
+    current_pool = this;
+    while (true) {
+      Task task;
+      {
+        std::unique_lock lock{mutex_};
+        queue_cv_.wait(lock, [this] { return stopped_ or not queue_.empty(); });
+        // the queued tasks are run still, as their futures may be waited for
+        if (queue_.empty()) {
+          return;
+        }
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+}  // namespace kagome::common
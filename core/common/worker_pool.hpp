@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_COMMON_WORKER_POOL_HPP
+#define KAGOME_CORE_COMMON_WORKER_POOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kagome::common {
+
+  /**
+   * Fixed set of threads running the CPU-bound parts of the work of the
+   * node, such as the encoding of the subtrees of a stored trie, so that no
+   * thread is started for a task. The threads are long-living, so their
+   * thread-local caches are reused by the tasks. A task must not wait for
+   * another task of the pool, which may be queued behind it
+   */
+  class WorkerPool {
+   public:
+    using Task = std::function<void()>;
+
+    /// most threads a pool is given by default
+    static constexpr size_t kMaxDefaultThreads = 16;
+
+    /**
+     * @param threads_num number of the threads, one at least; by default as
+     * many as the cores, but not more than kMaxDefaultThreads
+     */
+    explicit WorkerPool(size_t threads_num = defaultThreadsNum());
+
+    WorkerPool(WorkerPool &&) = delete;
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// Runs the queued tasks and joins the threads
+    ~WorkerPool();
+
+    static size_t defaultThreadsNum();
+
+    size_t threadsNum() const {
+      return threads_.size();
+    }
+
+    /**
+     * Schedules \arg f to be run on one of the threads
+     * @return future of the result of \arg f
+     */
+    template <typename F>
+    auto async(F &&f) {
+      using Result = std::invoke_result_t<F>;
+      // std::function needs a copyable callable
+      auto task =
+          std::make_shared<std::packaged_task<Result()>>(std::forward<F>(f));
+      auto future = task->get_future();
+      post([task] { (*task)(); });
+      return future;
+    }
+
+    void post(Task task);
+
+    /**
+     * Calls \arg f with each index below \arg n, split into contiguous
+     * chunks, one per thread of the pool and one more, which is run on the
+     * calling thread, and waits for all of them. All of the indices are run
+     * on the calling thread, if it is one of the pool, as it must not wait
+     * for the tasks queued behind it
+     */
+    template <typename F>
+    void parallelFor(size_t n, const F &f) {
+      auto chunks_num =
+          isOwnThread() ? size_t{1} : std::min(n, threads_.size() + 1);
+      auto run_chunk = [n, chunks_num, &f](size_t chunk) {
+        for (auto i = n * chunk / chunks_num;
+             i < n * (chunk + 1) / chunks_num;
+             ++i) {
+          f(i);
+        }
+      };
+      std::vector<std::future<void>> chunks;
+      chunks.reserve(chunks_num);
+      for (size_t chunk = 1; chunk < chunks_num; ++chunk) {
+        chunks.emplace_back(async([&run_chunk, chunk] { run_chunk(chunk); }));
+      }
+      // the other chunks refer to the ones of this frame, so they are
+      // waited for even if this one throws
+      std::exception_ptr error;
+      try {
+        run_chunk(0);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      for (auto &chunk : chunks) {
+        chunk.wait();
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+      for (auto &chunk : chunks) {
+        chunk.get();
+      }
+    }
+
+    /**
+     * @return true if it is called by a task of the pool
+     */
+    bool isOwnThread() const;
+
+   private:
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<Task> queue_;
+    bool stopped_ = false;
+    std::vector<std::thread> threads_;
+  };
+
+}  // namespace kagome::common
+
+#endif  // KAGOME_CORE_COMMON_WORKER_POOL_HPP
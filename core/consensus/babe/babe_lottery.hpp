@@ -43,6 +43,19 @@ namespace kagome::consensus {
         const Threshold &threshold,
         const crypto::SR25519Keypair &keypair) const = 0;
 
+    /**
+     * Compute leadership for \arg count slots of the given epoch, starting
+     * from the one at \arg offset from the beginning of the epoch, so that the
+     * leadership is computed only shortly before the slots
+     * @return vector of outputs for those slots, as the one of the whole epoch
+     */
+    virtual SlotsLeadership slotsLeadership(
+        const Epoch &epoch,
+        const Threshold &threshold,
+        const crypto::SR25519Keypair &keypair,
+        EpochLength offset,
+        EpochLength count) const = 0;
+
     /**
      * Compute randomness for the next epoch
      * @param last_epoch_randomness - randomness of the last epoch
@@ -9,6 +9,7 @@
 #include "primitives/authority.hpp"
 #include "primitives/block.hpp"
 #include "primitives/block_id.hpp"
+#include "primitives/common.hpp"
 
 namespace kagome::consensus {
 
@@ -20,12 +21,17 @@ namespace kagome::consensus {
    public:
     using BlocksHandler =
         std::function<void(const std::vector<primitives::Block> &)>;
+    using AncestorHandler = std::function<void(const primitives::BlockInfo &)>;
+    using IsKnown = std::function<bool(const primitives::BlockHash &)>;
 
     virtual ~BabeSynchronizer() = default;
 
     /**
-     * Request blocks between provided ones
-     * @param from block id of the first requested block
+     * Request blocks between provided ones. A request of the blocks, which a
+     * request in flight is known to cover, is attached to it instead, and its
+     * handler receives no blocks once they are passed to the handler of that
+     * request
+     * @param from block id of the first requested block, which is known
      * @param to block hash of the last requested block
      * @param block_list_handler handles received blocks
      */
@@ -33,6 +39,30 @@ namespace kagome::consensus {
                          const primitives::BlockHash &to,
                          primitives::AuthorityIndex authority_index,
                          const BlocksHandler &block_list_handler) = 0;
+
+    /**
+     * Searches for the highest block of the best chain of the peer announcing
+     * the blocks with \arg authority_index, which is known to this node, by
+     * the binary search of its number, requesting a header per step
+     * @param lower block known to be on the chain of the peer, e.g. the last
+     * finalized one
+     * @param upper number of the highest block looked at
+     * @param is_known tells if a block is known to this node
+     * @param handler receives the found block, or the highest known block
+     * found before the peer failed to return a header
+     */
+    virtual void findCommonAncestor(const primitives::BlockInfo &lower,
+                                    primitives::BlockNumber upper,
+                                    primitives::AuthorityIndex authority_index,
+                                    IsKnown is_known,
+                                    const AncestorHandler &handler) = 0;
+
+    /**
+     * Reports that the headers of the blocks requested with \arg
+     * authority_index, which the peer announcing them returned, are invalid
+     */
+    virtual void reportInvalidBlock(
+        primitives::AuthorityIndex authority_index) = 0;
   };
 
 }  // namespace kagome::consensus
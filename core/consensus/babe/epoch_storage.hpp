@@ -6,12 +6,30 @@
 #ifndef KAGOME_EPOCH_STORAGE_HPP
 #define KAGOME_EPOCH_STORAGE_HPP
 
+#include <memory>
+
 #include <boost/optional.hpp>
 
 #include "consensus/babe/common.hpp"
 #include "consensus/babe/types/next_epoch_descriptor.hpp"
+#include "primitives/common.hpp"
 
 namespace kagome::consensus {
+
+  enum class EpochStorageError {
+    EPOCH_DOES_NOT_EXIST = 1,
+    EPOCH_NOT_ON_CHAIN
+  };
+
+  /**
+   * Epoch descriptor along with the precomputed primary thresholds of its
+   * authorities, in the same order
+   */
+  struct EpochInfo {
+    NextEpochDescriptor descriptor;
+    std::vector<Threshold> thresholds;
+  };
+
   /**
    * Allows to store epochs
    */
@@ -28,6 +46,19 @@ namespace kagome::consensus {
         EpochIndex epoch_number,
         const NextEpochDescriptor &epoch_descriptor) = 0;
 
+    /**
+     * Stores epoch's information announced by a block, the ones announced by
+     * the blocks of the competing forks are kept apart
+     * @param epoch_number number of stored epoch
+     * @param announced_by hash of the block with the next epoch digest
+     * @param epoch_descriptor epochs information
+     * @return result with success if epoch was added, error otherwise
+     */
+    virtual outcome::result<void> addEpochDescriptor(
+        EpochIndex epoch_number,
+        const primitives::BlockHash &announced_by,
+        const NextEpochDescriptor &epoch_descriptor) = 0;
+
     /**
      * Get an epoch by a (\param block_id)
      * @return epoch or nothing, if epoch, in which that block was produced, is
@@ -35,7 +66,23 @@ namespace kagome::consensus {
      */
     virtual outcome::result<NextEpochDescriptor> getEpochDescriptor(
         EpochIndex epoch_number) const = 0;
+
+    /**
+     * Get an epoch with the thresholds of its authorities by its number, as
+     * announced on the chain of \arg block_hash, which is kept in memory for
+     * the next calls. The epoch added without the announcing block is taken if
+     * it is not announced by any block
+     * @param block_hash the block, which announcing ancestor is looked for,
+     * the parent of the validated one
+     * @return epoch info or error, if the epoch is unknown to this peer or is
+     * announced on the other forks only
+     */
+    virtual outcome::result<std::shared_ptr<const EpochInfo>> getEpochInfo(
+        EpochIndex epoch_number,
+        const primitives::BlockHash &block_hash) const = 0;
   };
 }  // namespace kagome::consensus
 
+OUTCOME_HPP_DECLARE_ERROR(kagome::consensus, EpochStorageError);
+
 #endif  // KAGOME_EPOCH_STORAGE_HPP
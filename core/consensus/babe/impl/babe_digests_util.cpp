@@ -54,6 +54,36 @@ namespace kagome::consensus {
     return DigestError::INVALID_DIGESTS;
   }
 
+  outcome::result<std::pair<Seal, BabeBlockHeader>> getBabeDigests(
+      const primitives::BlockHeaderView &block_header) {
+    using primitives::DigestItemView;
+    // valid BABE block has at least two digests: BabeHeader and a seal
+    if (block_header.digest.size() < 2) {
+      return DigestError::INVALID_DIGESTS;
+    }
+    const auto &digests = block_header.digest;
+
+    // last digest of the block must be a seal - signature
+    if (digests.back().type != DigestItemView::SEAL) {
+      return DigestError::INVALID_DIGESTS;
+    }
+
+    OUTCOME_TRY(babe_seal_res, scale::decode<Seal>(digests.back().data));
+
+    for (const auto &digest :
+         gsl::make_span(digests).subspan(0, digests.size() - 1)) {
+      if (digest.type != DigestItemView::PRE_RUNTIME) {
+        continue;
+      }
+      if (auto header = scale::decode<BabeBlockHeader>(digest.data); header) {
+        // found the BabeBlockHeader digest; return
+        return {babe_seal_res, header.value()};
+      }
+    }
+
+    return DigestError::INVALID_DIGESTS;
+  }
+
   outcome::result<NextEpochDescriptor> getNextEpochDigest(
       const primitives::BlockHeader &header) {
     // https://github.com/paritytech/substrate/blob/d8df977d024ebeb5330bacac64cf7193a7c242ed/core/consensus/babe/src/lib.rs#L497
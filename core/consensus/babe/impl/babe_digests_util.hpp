@@ -14,6 +14,7 @@
 #include "consensus/babe/types/seal.hpp"
 #include "outcome/outcome.hpp"
 #include "primitives/block.hpp"
+#include "primitives/block_header_view.hpp"
 
 namespace kagome::consensus {
 
@@ -36,6 +37,13 @@ namespace kagome::consensus {
   outcome::result<std::pair<Seal, BabeBlockHeader>> getBabeDigests(
       const primitives::BlockHeader &header);
 
+  /**
+   * Reads the digests as the owning header does, without copying the digest
+   * of \arg header
+   */
+  outcome::result<std::pair<Seal, BabeBlockHeader>> getBabeDigests(
+      const primitives::BlockHeaderView &header);
+
   outcome::result<NextEpochDescriptor> getNextEpochDigest(
       const primitives::BlockHeader &header);
 
@@ -32,7 +32,13 @@ namespace kagome::consensus {
       crypto::SR25519Keypair keypair,
       std::shared_ptr<clock::SystemClock> clock,
       std::shared_ptr<crypto::Hasher> hasher,
-      std::unique_ptr<clock::Timer> timer)
+      std::unique_ptr<clock::Timer> timer,
+      std::shared_ptr<runtime::OffchainWorkerScheduler>
+          offchain_worker_scheduler,
+      std::shared_ptr<transaction_pool::PoolRevalidator> pool_revalidator,
+      std::shared_ptr<ConsensusMetrics> metrics,
+      std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
+      std::shared_ptr<storage::trie::TriePruner> state_pruner)
       : lottery_{std::move(lottery)},
         block_executor_{std::move(block_executor)},
         trie_storage_{std::move(trie_storage)},
@@ -45,6 +51,11 @@ namespace kagome::consensus {
         clock_{std::move(clock)},
         hasher_{std::move(hasher)},
         timer_{std::move(timer)},
+        offchain_worker_scheduler_{std::move(offchain_worker_scheduler)},
+        pool_revalidator_{std::move(pool_revalidator)},
+        metrics_{std::move(metrics)},
+        changes_tracker_{std::move(changes_tracker)},
+        state_pruner_{std::move(state_pruner)},
         log_{common::createLogger("BABE")} {
     BOOST_ASSERT(lottery_);
     BOOST_ASSERT(epoch_storage_);
@@ -144,8 +155,10 @@ namespace kagome::consensus {
     current_epoch_ = std::move(epoch);
     current_slot_ = current_epoch_.start_slot;
 
-    slots_leadership_ = getEpochLeadership(current_epoch_);
-    next_slot_finish_time_ = starting_slot_finish_time;
+    startEpochLeadership();
+    anchor_slot_ = current_slot_;
+    anchor_slot_finish_time_ = starting_slot_finish_time;
+    next_slot_finish_time_ = slotFinishTime(current_slot_);
 
     runSlot();
   }
@@ -175,12 +188,12 @@ namespace kagome::consensus {
         // if block is new add it to the storage and sync missing blocks. Then
         // calculate slot time and execute babe
         block_executor_->processNextBlock(
-            announce.header,
+            announce,
             [this](const auto &header) { synchronizeSlots(header); });
         break;
       case BabeState::CATCHING_UP:
       case BabeState::SYNCHRONIZED:
-        block_executor_->processNextBlock(announce.header, [](auto &) {});
+        block_executor_->processNextBlock(announce, [](auto &) {});
         break;
     }
   }
@@ -218,10 +231,22 @@ namespace kagome::consensus {
         // control will be returned to this method
 
         current_slot_++;
-        next_slot_finish_time_ += genesis_configuration_->slot_duration;
+        next_slot_finish_time_ = slotFinishTime(current_slot_);
+        if (metrics_ != nullptr) {
+          metrics_->recordSkippedSlot();
+        }
       }
     } while (rewind_slots);
 
+    if (metrics_ != nullptr) {
+      // the slot is due to start once the previous one finishes
+      metrics_->recordSlot(clock_->now()
+                           - (next_slot_finish_time_
+                              - genesis_configuration_->slot_duration));
+    }
+
+    prebuildBlock();
+
     // everything is OK: wait for the end of the slot
     timer_->expiresAt(next_slot_finish_time_);
     timer_->asyncWait([this](auto &&ec) {
@@ -230,13 +255,19 @@ namespace kagome::consensus {
                     ec.message());
         return;
       }
+      if (metrics_ != nullptr) {
+        metrics_->recordSlotTimer(clock_->now() - next_slot_finish_time_);
+      }
       finishSlot();
     });
+
+    // the slot is idle until its end, so the leadership of the next slots is
+    // computed now rather than at their start
+    prepareLeadership();
   }
 
   void BabeImpl::finishSlot() {
-    auto slot_leadership =
-        slots_leadership_[current_slot_ % current_epoch_.epoch_duration];
+    const auto &slot_leadership = slotLeadership();
     if (slot_leadership) {
       log_->debug("Peer {} is leader (vrfOutput: {}, proof: {})",
                   keypair_.public_key.toHex(),
@@ -247,7 +278,7 @@ namespace kagome::consensus {
     }
 
     ++current_slot_;
-    next_slot_finish_time_ += genesis_configuration_->slot_duration;
+    next_slot_finish_time_ = slotFinishTime(current_slot_);
     log_->debug("Slot {} in epoch {} has finished",
                 current_slot_,
                 current_epoch_.epoch_index);
@@ -285,10 +316,10 @@ namespace kagome::consensus {
     return primitives::Seal{{primitives::kBabeEngineId, encoded_seal}};
   }
 
-  void BabeImpl::processSlotLeadership(const crypto::VRFOutput &output) {
-    // build a block to be announced
-    log_->info("Obtained slot leadership");
-
+  outcome::result<primitives::Block> BabeImpl::proposeBlock(
+      const crypto::VRFOutput &output,
+      const primitives::BlockInfo &parent,
+      clock::SystemClock::TimePoint deadline) {
     primitives::InherentData inherent_data;
     auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
                    clock_->now().time_since_epoch())
@@ -296,52 +327,119 @@ namespace kagome::consensus {
     // identifiers are guaranteed to be correct, so use .value() directly
     auto put_res = inherent_data.putData<uint64_t>(kTimestampId, now);
     if (!put_res) {
-      return log_->error("cannot put an inherent data: {}",
-                         put_res.error().message());
+      log_->error("cannot put an inherent data: {}",
+                  put_res.error().message());
+      return put_res.error();
     }
     put_res = inherent_data.putData(kBabeSlotId, current_slot_);
     if (!put_res) {
-      return log_->error("cannot put an inherent data: {}",
-                         put_res.error().message());
+      log_->error("cannot put an inherent data: {}",
+                  put_res.error().message());
+      return put_res.error();
     }
 
-    auto &&[best_block_number, best_block_hash] = block_tree_->deepestLeaf();
     log_->info("Babe builds block on top of block with number {} and hash {}",
-               best_block_number,
-               best_block_hash);
+               parent.block_number,
+               parent.block_hash);
 
     auto authority_index_res =
         getAuthorityIndex(current_epoch_.authorities, keypair_.public_key);
     BOOST_ASSERT_MSG(authority_index_res.has_value(), "Authority is not known");
     // calculate babe_pre_digest
-    auto babe_pre_digest_res =
-        babePreDigest(output, authority_index_res.value());
-    if (not babe_pre_digest_res) {
-      return log_->error("cannot propose a block: {}",
-                         babe_pre_digest_res.error().message());
-    }
-    auto babe_pre_digest = babe_pre_digest_res.value();
+    OUTCOME_TRY(babe_pre_digest,
+                babePreDigest(output, authority_index_res.value()));
 
     // create new block
-    auto pre_seal_block_res =
-        proposer_->propose(best_block_hash, inherent_data, {babe_pre_digest});
-    if (!pre_seal_block_res) {
-      return log_->error("cannot propose a block: {}",
-                         pre_seal_block_res.error().message());
+    auto start = ConsensusMetrics::Clock::now();
+    auto block_res = proposer_->propose(
+        parent.block_hash, inherent_data, {babe_pre_digest}, deadline);
+    if (metrics_ != nullptr) {
+      metrics_->recordProposal(ConsensusMetrics::Clock::now() - start);
     }
+    return block_res;
+  }
 
-    auto block = pre_seal_block_res.value();
+  void BabeImpl::prebuildBlock() {
+    discardPrebuiltBlock();
+    const auto &slot_leadership = slotLeadership();
+    // the revalidator gets the extrinsics of a discarded block back to the
+    // pool, so a block is not pre-built without it
+    if (not slot_leadership or not pool_revalidator_) {
+      return;
+    }
 
-    if (auto next_epoch_digest_res = getNextEpochDigest(block.header);
-        next_epoch_digest_res) {
-      log_->info("Obtained next epoch digest");
-      if (not epoch_storage_->addEpochDescriptor(
-              current_epoch_.epoch_index + 2, next_epoch_digest_res.value())) {
-        log_->error("Could not add nex epoch digest to epoch storage");
+    // the block is sealed and announced at the end of the slot, the last
+    // third of the slot is left for the blocks of the other authors, which
+    // would make it discarded
+    auto deadline =
+        next_slot_finish_time_ - genesis_configuration_->slot_duration / 3;
+    auto block_res =
+        proposeBlock(*slot_leadership, block_tree_->deepestLeaf(), deadline);
+    if (not block_res) {
+      return log_->warn("cannot pre-build a block: {}",
+                        block_res.error().message());
+    }
+    prebuilt_block_ = std::move(block_res.value());
+    prebuilt_slot_ = current_slot_;
+    log_->debug("Pre-built block number {} for slot {}",
+                prebuilt_block_->header.number,
+                prebuilt_slot_);
+  }
+
+  void BabeImpl::discardPrebuiltBlock() {
+    if (not prebuilt_block_) {
+      return;
+    }
+    log_->info("Block pre-built for slot {} is discarded", prebuilt_slot_);
+    // the inherents are rejected by the pool, the rest get back to it
+    pool_revalidator_->resubmit(std::move(prebuilt_block_->body));
+    // the state was committed when the block was built, so its nodes are
+    // kept by the pruner until the reference it took then is dropped
+    if (state_pruner_ != nullptr) {
+      auto res = state_pruner_->pruneState(
+          common::Buffer{prebuilt_block_->header.state_root});
+      if (not res) {
+        log_->warn("Can't prune the state of the discarded block: {}",
+                   res.error().message());
       }
     }
+    prebuilt_block_.reset();
+  }
+
+  void BabeImpl::processSlotLeadership(const crypto::VRFOutput &output) {
+    // build a block to be announced
+    log_->info("Obtained slot leadership");
+
+    auto best_block = block_tree_->deepestLeaf();
+    primitives::Block block;
+    if (prebuilt_block_ and prebuilt_slot_ == current_slot_
+        and prebuilt_block_->header.parent_hash == best_block.block_hash) {
+      log_->info("Babe uses the block pre-built on top of block with number "
+                 "{} and hash {}",
+                 best_block.block_number,
+                 best_block.block_hash);
+      block = std::move(*prebuilt_block_);
+      prebuilt_block_.reset();
+    } else {
+      // no block was pre-built, or the best block has changed since
+      discardPrebuiltBlock();
+
+      // the block is to be built in the slot following the one it is for,
+      // two thirds of that slot are given to add the extrinsics, and the rest
+      // is left to seal, import and announce the block
+      auto deadline = next_slot_finish_time_
+                      + genesis_configuration_->slot_duration * 2 / 3;
+
+      auto pre_seal_block_res = proposeBlock(output, best_block, deadline);
+      if (!pre_seal_block_res) {
+        return log_->error("cannot propose a block: {}",
+                           pre_seal_block_res.error().message());
+      }
+      block = std::move(pre_seal_block_res.value());
+    }
 
     // seal the block
+    auto sealed_at = ConsensusMetrics::Clock::now();
     auto seal = sealBlock(block);
 
     // add seal digest item
@@ -360,36 +458,112 @@ namespace kagome::consensus {
       log_->error("Could not add block: {}", add_res.error().message());
       return;
     }
+    if (metrics_ != nullptr) {
+      metrics_->recordImported(block.header.number);
+    }
+    // the state of the block was committed when it was built, so it is not
+    // executed once again, and only the changes tracked meanwhile are
+    // reported as the ones of an imported block
+    if (changes_tracker_ != nullptr) {
+      changes_tracker_->onBlockImported(
+          hasher_->blake2b_256(scale::encode(block.header).value()),
+          block.header.parent_hash);
+    }
+
+    // the block is built on top of the best one, so it is the best now
+    if (offchain_worker_scheduler_) {
+      offchain_worker_scheduler_->schedule(block.header.number);
+    }
+    if (pool_revalidator_) {
+      pool_revalidator_->onNewBestBlock(block_tree_->deepestLeaf());
+    }
 
     auto next_epoch_digest_res = getNextEpochDigest(block.header);
     if (next_epoch_digest_res) {
       log_->info("Got next epoch digest for epoch: {}",
                  current_epoch_.epoch_index + 2);
-      if (auto add_epoch_res = epoch_storage_->addEpochDescriptor(
-              current_epoch_.epoch_index + 2, next_epoch_digest_res.value());
+      // the epoch is announced on the chain of the block only
+      auto block_hash =
+          hasher_->blake2b_256(scale::encode(block.header).value());
+      if (auto add_epoch_res =
+              epoch_storage_->addEpochDescriptor(current_epoch_.epoch_index + 2,
+                                                 block_hash,
+                                                 next_epoch_digest_res.value());
           not add_epoch_res) {
         log_->error("Could not add next epoch digest. Reason: {}",
                     add_epoch_res.error().message());
       }
     }
 
-    // finally, broadcast the sealed block
-    gossiper_->blockAnnounce(network::BlockAnnounce{block.header});
-    log_->debug("Announced block number {} in slot {} with timestamp {}",
+    // finally, broadcast the sealed block. The announce is compact: the
+    // receivers build the body from their transaction pools by the hashes of
+    // the extrinsics instead of requesting it
+    std::vector<gsl::span<const uint8_t>> extrinsics;
+    extrinsics.reserve(block.body.size());
+    for (const auto &extrinsic : block.body) {
+      extrinsics.emplace_back(extrinsic.data);
+    }
+    std::vector<primitives::Transaction::Hash> extrinsic_hashes(
+        extrinsics.size());
+    hasher_->blake2b_256_many(extrinsics, extrinsic_hashes);
+    gossiper_->blockAnnounce(
+        network::BlockAnnounce{block.header, std::move(extrinsic_hashes)});
+    if (metrics_ != nullptr) {
+      metrics_->recordAnnounce(ConsensusMetrics::Clock::now() - sealed_at);
+    }
+    log_->debug("Announced block number {} in slot {}",
                 block.header.number,
-                current_slot_,
-                now);
+                current_slot_);
   }
 
-  BabeLottery::SlotsLeadership BabeImpl::getEpochLeadership(
-      const Epoch &epoch) const {
+  void BabeImpl::startEpochLeadership() {
     auto authority_index_res =
-        getAuthorityIndex(epoch.authorities, keypair_.public_key);
+        getAuthorityIndex(current_epoch_.authorities, keypair_.public_key);
     BOOST_ASSERT_MSG(authority_index_res.has_value(), "Authority is not known");
-    auto threshold = calculateThreshold(genesis_configuration_->leadership_rate,
-                                        epoch.authorities,
-                                        authority_index_res.value());
-    return lottery_->slotsLeadership(epoch, threshold, keypair_);
+    leadership_threshold_ =
+        calculateThreshold(genesis_configuration_->leadership_rate,
+                           current_epoch_.authorities,
+                           authority_index_res.value());
+    if (current_epoch_.epoch_duration <= kLeadershipWindow) {
+      slots_leadership_ = lottery_->slotsLeadership(
+          current_epoch_, leadership_threshold_, keypair_);
+      leadership_computed_ = current_epoch_.epoch_duration;
+      return;
+    }
+    // computing the whole long epoch at its start could miss its first slots
+    slots_leadership_.assign(current_epoch_.epoch_duration, boost::none);
+    leadership_computed_ = 0;
+  }
+
+  const boost::optional<crypto::VRFOutput> &BabeImpl::slotLeadership() {
+    auto offset = current_slot_ % current_epoch_.epoch_duration;
+    computeLeadership(offset);
+    return slots_leadership_[offset];
+  }
+
+  void BabeImpl::prepareLeadership() {
+    auto offset = (current_slot_ + 1) % current_epoch_.epoch_duration;
+    // the leadership of the next epoch is unknown until it starts
+    if (offset != 0) {
+      computeLeadership(offset);
+    }
+  }
+
+  void BabeImpl::computeLeadership(EpochLength offset) {
+    if (offset < leadership_computed_) {
+      return;
+    }
+    auto count =
+        std::min(kLeadershipWindow, current_epoch_.epoch_duration - offset);
+    auto window = lottery_->slotsLeadership(
+        current_epoch_, leadership_threshold_, keypair_, offset, count);
+    std::move(window.begin(), window.end(), slots_leadership_.begin() + offset);
+    leadership_computed_ = offset + count;
+  }
+
+  BabeTimePoint BabeImpl::slotFinishTime(BabeSlotNumber slot) const {
+    return anchor_slot_finish_time_
+           + (slot - anchor_slot_) * genesis_configuration_->slot_duration;
   }
 
   void BabeImpl::finishEpoch() {
@@ -411,7 +585,7 @@ namespace kagome::consensus {
     current_epoch_.start_slot = current_slot_;
     current_epoch_.authorities = next_epoch_digest_res.value().authorities;
     current_epoch_.randomness = next_epoch_digest_res.value().randomness;
-    slots_leadership_ = getEpochLeadership(current_epoch_);
+    startEpochLeadership();
 
     log_->debug("Epoch {} has finished", current_epoch_.epoch_index);
   }
@@ -11,6 +11,7 @@
 #include <memory>
 
 #include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/optional.hpp>
 #include <outcome/outcome.hpp>
 #include "authorship/proposer.hpp"
 #include "blockchain/block_tree.hpp"
@@ -20,10 +21,13 @@
 #include "consensus/babe/babe_lottery.hpp"
 #include "consensus/babe/epoch_storage.hpp"
 #include "consensus/babe/impl/block_executor.hpp"
+#include "consensus/consensus_metrics.hpp"
 #include "crypto/hasher.hpp"
 #include "crypto/sr25519_types.hpp"
 #include "primitives/babe_configuration.hpp"
 #include "primitives/common.hpp"
+#include "storage/changes_trie/changes_tracker.hpp"
+#include "storage/trie/trie_pruner.hpp"
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::consensus {
@@ -59,6 +63,15 @@ namespace kagome::consensus {
      * @param timer to be used by the implementation; the recommended one is
      * kagome::clock::BasicWaitableTimer
      * @param event_bus to deliver events over
+     * @param offchain_worker_scheduler runs the offchain workers for the
+     * produced blocks, if any
+     * @param pool_revalidator revalidates the transaction pool for the
+     * produced blocks, if any. The blocks are pre-built at the start of the
+     * slots only with it, as it gets the extrinsics of the discarded ones
+     * back to the pool
+     * @param metrics records the timings of the slots, if any
+     * @param state_pruner prunes the states of the discarded pre-built
+     * blocks, if any
      */
     BabeImpl(std::shared_ptr<BabeLottery> lottery,
              std::shared_ptr<BlockExecutor> block_executor,
@@ -71,7 +84,16 @@ namespace kagome::consensus {
              crypto::SR25519Keypair keypair,
              std::shared_ptr<clock::SystemClock> clock,
              std::shared_ptr<crypto::Hasher> hasher,
-             std::unique_ptr<clock::Timer> timer);
+             std::unique_ptr<clock::Timer> timer,
+             std::shared_ptr<runtime::OffchainWorkerScheduler>
+                 offchain_worker_scheduler = nullptr,
+             std::shared_ptr<transaction_pool::PoolRevalidator>
+                 pool_revalidator = nullptr,
+             std::shared_ptr<ConsensusMetrics> metrics = nullptr,
+             std::shared_ptr<storage::changes_trie::ChangesTracker>
+                 changes_tracker = nullptr,
+             std::shared_ptr<storage::trie::TriePruner> state_pruner =
+                 nullptr);
 
     ~BabeImpl() override = default;
 
@@ -96,17 +118,72 @@ namespace kagome::consensus {
     void finishSlot();
 
     /**
-     * Gather the block and broadcast it
+     * Gather the block and broadcast it. The block pre-built for the slot is
+     * used if the best block is still its parent
      * @param output that we are the leader of this slot
      */
     void processSlotLeadership(const crypto::VRFOutput &output);
 
+    /**
+     * Builds the unsealed block of the current slot
+     * @param output that we are the leader of this slot
+     * @param parent block to build on top of
+     * @param deadline to stop adding the extrinsics at
+     */
+    outcome::result<primitives::Block> proposeBlock(
+        const crypto::VRFOutput &output,
+        const primitives::BlockInfo &parent,
+        clock::SystemClock::TimePoint deadline);
+
+    /**
+     * Builds the block of the current slot at its start on top of the best
+     * block, if we lead the slot, so that the block is only sealed and
+     * announced at the end of the slot
+     */
+    void prebuildBlock();
+
+    /**
+     * Drops the pre-built block, its extrinsics are submitted to the pool
+     * again, and its state, committed when it was built, is pruned
+     */
+    void discardPrebuiltBlock();
+
     /**
      * Finish the Babe epoch
      */
     void finishEpoch();
 
-    BabeLottery::SlotsLeadership getEpochLeadership(const Epoch &epoch) const;
+    /**
+     * Starts the leadership of the current epoch: the one of a short epoch is
+     * computed at once, while the slots of a longer one are computed
+     * kLeadershipWindow at a time, shortly before them
+     */
+    void startEpochLeadership();
+
+    /**
+     * @return leadership of the current slot, which is computed along with the
+     * next ones if it is not yet
+     */
+    const boost::optional<crypto::VRFOutput> &slotLeadership();
+
+    /**
+     * Computes the leadership of the next slot ahead of its start, if it is
+     * in the current epoch
+     */
+    void prepareLeadership();
+
+    /**
+     * Computes the leadership of kLeadershipWindow slots from \arg offset in
+     * the current epoch, unless it is computed already
+     */
+    void computeLeadership(EpochLength offset);
+
+    /**
+     * @return time \arg slot finishes at, which is counted from the slot the
+     * slots are run from rather than from the end of the previous slot, so
+     * that the slots late to start do not shift the next ones
+     */
+    BabeTimePoint slotFinishTime(BabeSlotNumber slot) const;
 
     outcome::result<primitives::PreRuntime> babePreDigest(
         const crypto::VRFOutput &output,
@@ -121,6 +198,9 @@ namespace kagome::consensus {
     void synchronizeSlots(const primitives::BlockHeader &new_header);
 
    private:
+    /// number of the slots, leadership of which is computed at a time
+    static constexpr EpochLength kLeadershipWindow = 128;
+
     std::shared_ptr<BabeLottery> lottery_;
     std::shared_ptr<BlockExecutor> block_executor_;
     std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
@@ -133,6 +213,12 @@ namespace kagome::consensus {
     std::shared_ptr<clock::SystemClock> clock_;
     std::shared_ptr<crypto::Hasher> hasher_;
     std::unique_ptr<clock::Timer> timer_;
+    std::shared_ptr<runtime::OffchainWorkerScheduler>
+        offchain_worker_scheduler_;
+    std::shared_ptr<transaction_pool::PoolRevalidator> pool_revalidator_;
+    std::shared_ptr<ConsensusMetrics> metrics_;
+    std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
+    std::shared_ptr<storage::trie::TriePruner> state_pruner_;
 
     BabeState current_state_{BabeState::WAIT_BLOCK};
 
@@ -146,8 +232,20 @@ namespace kagome::consensus {
     const uint32_t kSlotTail = 30;
 
     BabeSlotNumber current_slot_{};
+    /// leadership of the slots of the current epoch, the ones from
+    /// leadership_computed_ on are not computed yet
     BabeLottery::SlotsLeadership slots_leadership_;
+    EpochLength leadership_computed_{};
+    Threshold leadership_threshold_{};
     BabeTimePoint next_slot_finish_time_;
+    /// slot the slots are run from and its finish time, every slot deadline
+    /// is counted from them
+    BabeSlotNumber anchor_slot_{};
+    BabeTimePoint anchor_slot_finish_time_;
+
+    /// unsealed block built at the start of the slot we lead
+    boost::optional<primitives::Block> prebuilt_block_;
+    BabeSlotNumber prebuilt_slot_{};
 
     common::Logger log_;
   };
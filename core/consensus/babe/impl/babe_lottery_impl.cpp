@@ -17,9 +17,11 @@ namespace kagome::consensus {
 
   BabeLotteryImpl::BabeLotteryImpl(
       std::shared_ptr<crypto::VRFProvider> vrf_provider,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<common::WorkerPool> workers)
       : vrf_provider_{std::move(vrf_provider)},
         hasher_{std::move(hasher)},
+        workers_{std::move(workers)},
         logger_{common::createLogger("BabeLottery")} {
     BOOST_ASSERT(vrf_provider_);
     BOOST_ASSERT(hasher_);
@@ -30,25 +32,42 @@ namespace kagome::consensus {
       const Epoch &epoch,
       const Threshold &threshold,
       const crypto::SR25519Keypair &keypair) const {
-    BabeLottery::SlotsLeadership result;
-    result.reserve(epoch.epoch_duration);
-
-    // randomness || slot number
-    Buffer vrf_input(vrf_constants::OUTPUT_SIZE + 8, 0);
-
-    // the first part - randomness - is always the same, while the slot number
-    // obviously changes depending on the slot we are computing for
-    std::copy(
-        epoch.randomness.begin(), epoch.randomness.end(), vrf_input.begin());
-
-    auto slot_number_begin = vrf_input.begin() + vrf_constants::OUTPUT_SIZE;
-    for (BabeSlotNumber i = epoch.epoch_index * epoch.epoch_duration;
-         i < (epoch.epoch_index + 1) * epoch.epoch_duration;
-         ++i) {
-      auto slot_bytes = common::uint64_t_to_bytes(i);
-      std::copy(slot_bytes.begin(), slot_bytes.end(), slot_number_begin);
-      auto sign_opt = vrf_provider_->sign(vrf_input, keypair, threshold);
-      result.push_back(sign_opt);
+    return slotsLeadership(epoch, threshold, keypair, 0, epoch.epoch_duration);
+  }
+
+  BabeLottery::SlotsLeadership BabeLotteryImpl::slotsLeadership(
+      const Epoch &epoch,
+      const Threshold &threshold,
+      const crypto::SR25519Keypair &keypair,
+      EpochLength offset,
+      EpochLength count) const {
+    BOOST_ASSERT(offset + count <= epoch.epoch_duration);
+    BabeLottery::SlotsLeadership result(count);
+    auto first_slot = epoch.epoch_index * epoch.epoch_duration + offset;
+
+    // the slots are independent, so they are computed by the workers, each
+    // slot with the input of its own
+    auto compute = [&](size_t i) {
+      // randomness || slot number
+      Buffer vrf_input(vrf_constants::OUTPUT_SIZE + 8, 0);
+
+      // the first part - randomness - is always the same, while the slot
+      // number obviously changes depending on the slot we are computing for
+      std::copy(
+          epoch.randomness.begin(), epoch.randomness.end(), vrf_input.begin());
+
+      auto slot_bytes = common::uint64_t_to_bytes(first_slot + i);
+      std::copy(slot_bytes.begin(),
+                slot_bytes.end(),
+                vrf_input.begin() + vrf_constants::OUTPUT_SIZE);
+      result[i] = vrf_provider_->sign(vrf_input, keypair, threshold);
+    };
+    if (workers_ != nullptr) {
+      workers_->parallelFor(count, compute);
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        compute(i);
+      }
     }
 
     return result;
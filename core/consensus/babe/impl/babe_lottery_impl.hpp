@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "common/logger.hpp"
+#include "common/worker_pool.hpp"
 #include "consensus/babe/babe_lottery.hpp"
 #include "crypto/hasher.hpp"
 #include "crypto/vrf_provider.hpp"
@@ -17,14 +18,25 @@
 namespace kagome::consensus {
   class BabeLotteryImpl : public BabeLottery {
    public:
+    /**
+     * @param workers compute the leadership of the slots in parallel, if
+     * any; it is computed on the calling thread otherwise
+     */
     BabeLotteryImpl(std::shared_ptr<crypto::VRFProvider> vrf_provider,
-                    std::shared_ptr<crypto::Hasher> hasher);
+                    std::shared_ptr<crypto::Hasher> hasher,
+                    std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     SlotsLeadership slotsLeadership(
         const Epoch &epoch,
         const Threshold &threshold,
         const crypto::SR25519Keypair &keypair) const override;
 
+    SlotsLeadership slotsLeadership(const Epoch &epoch,
+                                    const Threshold &threshold,
+                                    const crypto::SR25519Keypair &keypair,
+                                    EpochLength offset,
+                                    EpochLength count) const override;
+
     Randomness computeRandomness(const Randomness &last_epoch_randomness,
                                  EpochIndex last_epoch_index) override;
 
@@ -33,6 +45,7 @@ namespace kagome::consensus {
    private:
     std::shared_ptr<crypto::VRFProvider> vrf_provider_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<common::WorkerPool> workers_;
 
     /// also known as "rho" (greek letter) in the spec
     std::vector<crypto::VRFPreOutput> last_epoch_vrf_values_;
@@ -5,19 +5,67 @@
 
 #include "consensus/babe/impl/babe_synchronizer_impl.hpp"
 
+#include <deque>
+#include <limits>
 #include <random>
 
 #include <boost/assert.hpp>
 #include "blockchain/block_tree_error.hpp"
 #include "common/visitor.hpp"
 #include "primitives/block.hpp"
+#include "scale/scale.hpp"
 
 namespace kagome::consensus {
+  namespace {
+    primitives::BlocksRequestId nextRequestId() {
+      static std::random_device rd{};
+      static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
+      return dis(rd);
+    }
+  }  // namespace
+
+  struct BabeSynchronizerImpl::BodiesDownload {
+    struct Batch {
+      bool done = false;
+      // requests of the batch waiting for the responses
+      size_t requests = 0;
+      std::chrono::steady_clock::time_point requested_at{};
+    };
+
+    // blocks with the chained headers, the bodies are filled as they arrive
+    std::vector<primitives::Block> blocks;
+    std::vector<primitives::BlockHash> hashes;
+    BlocksHandler handler;
+
+    std::mutex mutex;
+    std::vector<Batch> batches;
+    // batches not requested yet or failed, in the order of the blocks
+    std::deque<size_t> queue;
+    // peers with nothing to request, which are given the failed batches
+    std::vector<std::shared_ptr<network::SyncProtocolClient>> idle_peers;
+    // peers which failed a request and are not asked anymore
+    std::unordered_set<std::shared_ptr<network::SyncProtocolClient>>
+        failed_peers;
+    // number of the peers the bodies are requested from
+    size_t peers_num;
+    size_t batches_left;
+    // the first batch the bodies of which could not be received, the blocks
+    // from it on are not passed to the handler
+    size_t failed_batch;
+  };
+
   BabeSynchronizerImpl::BabeSynchronizerImpl(
-      std::shared_ptr<network::SyncClientsSet> sync_clients)
+      std::shared_ptr<network::SyncClientsSet> sync_clients,
+      std::shared_ptr<crypto::Hasher> hasher,
+      size_t bodies_batch_size,
+      std::shared_ptr<network::PeerManager> peer_manager)
       : sync_clients_{std::move(sync_clients)},
+        hasher_{std::move(hasher)},
+        bodies_batch_size_{bodies_batch_size},
+        peer_manager_{std::move(peer_manager)},
         logger_{common::createLogger("BabeSynchronizer")} {
     BOOST_ASSERT(sync_clients_);
+    BOOST_ASSERT(bodies_batch_size_ == 0 or hasher_ != nullptr);
     BOOST_ASSERT(std::all_of(sync_clients_->clients.begin(),
                              sync_clients_->clients.end(),
                              [](const auto &client) { return client; }));
@@ -31,18 +79,160 @@ namespace kagome::consensus {
         from,
         [](const primitives::BlockHash &hash) { return hash.toHex(); },
         [](primitives::BlockNumber number) { return std::to_string(number); });
+    if (isBanned(sync_clients_->clients[authority_index])) {
+      logger_->warn("Blocks up to {} are not requested from a banned peer",
+                    to.toHex());
+      return;
+    }
+    if (attach(to, block_list_handler)) {
+      logger_->info("Blocks up to {} are requested already", to.toHex());
+      return;
+    }
     logger_->info("Requesting blocks from {} to {}", from_str, to.toHex());
+    auto in_flight = track(to);
+    BlocksHandler handler = [self_wp{weak_from_this()},
+                             in_flight,
+                             block_list_handler](const auto &blocks) {
+      block_list_handler(blocks);
+      if (auto self = self_wp.lock()) {
+        self->finish(in_flight);
+      }
+    };
 
-    static std::random_device rd{};
-    static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
-    network::BlocksRequest request{dis(rd),
+    network::BlocksRequest request{nextRequestId(),
                                    network::BlocksRequest::kBasicAttributes,
                                    from,
                                    to,
                                    network::Direction::DESCENDING,
                                    boost::none};
 
-    return pollClients(request, authority_index, block_list_handler);
+    // the bodies are downloaded only for the headers known to be chained,
+    // and from all peers at once
+    if (bodies_batch_size_ != 0) {
+      request.fields = network::BlockAttributes{
+          static_cast<uint8_t>(network::BlockAttributesBits::HEADER)};
+      return requestHeadersFirst(
+          std::move(request), authority_index, handler);
+    }
+    return pollClients(request, authority_index, handler);
+  }
+
+  bool BabeSynchronizerImpl::attach(const primitives::BlockHash &hash,
+                                    const BlocksHandler &handler) {
+    std::lock_guard lock{in_flight_mutex_};
+    auto it = in_flight_.find(hash);
+    if (it == in_flight_.end()
+        or std::chrono::steady_clock::now() - it->second->requested_at
+               >= kInFlightTimeout) {
+      return false;
+    }
+    it->second->attached.push_back(handler);
+    return true;
+  }
+
+  std::shared_ptr<BabeSynchronizerImpl::InFlight> BabeSynchronizerImpl::track(
+      const primitives::BlockHash &hash) {
+    auto now = std::chrono::steady_clock::now();
+    auto in_flight = std::make_shared<InFlight>(InFlight{now, {hash}, {}});
+    std::lock_guard lock{in_flight_mutex_};
+    // the requests, which have failed silently, are forgotten
+    for (auto it = in_flight_.begin(); it != in_flight_.end();) {
+      if (now - it->second->requested_at >= kInFlightTimeout) {
+        it = in_flight_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    in_flight_[hash] = in_flight;
+    return in_flight;
+  }
+
+  void BabeSynchronizerImpl::cover(
+      const primitives::BlockHash &to,
+      const std::vector<primitives::BlockHash> &hashes) {
+    std::lock_guard lock{in_flight_mutex_};
+    auto it = in_flight_.find(to);
+    if (it == in_flight_.end()) {
+      return;
+    }
+    auto in_flight = it->second;
+    for (const auto &hash : hashes) {
+      if (in_flight_.emplace(hash, in_flight).second) {
+        in_flight->hashes.push_back(hash);
+      }
+    }
+  }
+
+  void BabeSynchronizerImpl::finish(
+      const std::shared_ptr<InFlight> &in_flight) {
+    std::vector<BlocksHandler> attached;
+    {
+      std::lock_guard lock{in_flight_mutex_};
+      for (const auto &hash : in_flight->hashes) {
+        auto it = in_flight_.find(hash);
+        if (it != in_flight_.end() and it->second == in_flight) {
+          in_flight_.erase(it);
+        }
+      }
+      attached.swap(in_flight->attached);
+    }
+    for (const auto &handler : attached) {
+      handler({});
+    }
+  }
+
+  void BabeSynchronizerImpl::findCommonAncestor(
+      const primitives::BlockInfo &lower,
+      primitives::BlockNumber upper,
+      primitives::AuthorityIndex authority_index,
+      IsKnown is_known,
+      const AncestorHandler &handler) {
+    auto peer = sync_clients_->clients[authority_index];
+    if (lower.block_number >= upper or isBanned(peer)) {
+      return handler(lower);
+    }
+    // the upper middle is taken, so that the range shrinks either way
+    auto middle = lower.block_number + (upper - lower.block_number + 1) / 2;
+    network::BlocksRequest request{
+        nextRequestId(),
+        network::BlockAttributes{
+            static_cast<uint8_t>(network::BlockAttributesBits::HEADER)},
+        middle,
+        boost::none,
+        network::Direction::ASCENDING,
+        1};
+    peer->requestBlocks(
+        request,
+        [self_wp{weak_from_this()},
+         peer,
+         lower,
+         upper,
+         middle,
+         authority_index,
+         is_known{std::move(is_known)},
+         handler](auto &&response_res) mutable {
+          auto self = self_wp.lock();
+          if (not self) return;
+          if (not response_res or response_res.value().blocks.empty()) {
+            self->reportResponse(peer, false, 0, {});
+            self->logger_->warn(
+                "Common ancestor search stopped at block {}, no header of "
+                "block {} is returned",
+                lower.block_number,
+                middle);
+            return handler(lower);
+          }
+          const auto &hash = response_res.value().blocks.front().hash;
+          if (is_known(hash)) {
+            return self->findCommonAncestor({middle, hash},
+                                            upper,
+                                            authority_index,
+                                            std::move(is_known),
+                                            handler);
+          }
+          self->findCommonAncestor(
+              lower, middle - 1, authority_index, std::move(is_known), handler);
+        });
   }
 
   std::shared_ptr<network::SyncProtocolClient>
@@ -76,25 +266,27 @@ namespace kagome::consensus {
    * @return blocks from block data
    */
   boost::optional<std::vector<primitives::Block>> getBlocks(
-      const network::BlocksResponse &response) {
+      network::BlocksResponse &&response) {
     // now we need to check if every block data from response contains header;
     // if any of them does not contain block header, we should proceed to the
     // next client
     std::vector<primitives::Block> blocks;
-    for (const auto &block_data : response.blocks) {
+    blocks.reserve(response.blocks.size());
+    for (auto &block_data : response.blocks) {
       primitives::Block block;
       if (!block_data.header) {
         // that's bad, we can't insert a block, which does not have at
         // least a header
         return boost::none;
       }
-      block.header = *block_data.header;
+      // the bodies may take megabytes, so they are not copied
+      block.header = std::move(*block_data.header);
 
       if (block_data.body) {
-        block.body = *block_data.body;
+        block.body = std::move(*block_data.body);
       }
 
-      blocks.push_back(block);
+      blocks.push_back(std::move(block));
     }
     return blocks;
   }
@@ -108,13 +300,17 @@ namespace kagome::consensus {
     next_client->requestBlocks(
         request,
         [self_wp{weak_from_this()},
+         next_client,
          request{std::move(request)},
          requested_blocks_handler{requested_blocks_handler}](
             auto &&response_res) mutable {
           if (auto self = self_wp.lock()) {
+            if (not response_res) {
+              self->reportResponse(next_client, false, 0, {});
+            }
             // if response exists then get blocks and send them to handle
             if (response_res and not response_res.value().blocks.empty()) {
-              auto blocks_opt = getBlocks(response_res.value());
+              auto blocks_opt = getBlocks(std::move(response_res.value()));
               if (blocks_opt) {
                 return requested_blocks_handler(blocks_opt.value());
               }
@@ -127,4 +323,278 @@ namespace kagome::consensus {
           }
         });
   }
+
+  void BabeSynchronizerImpl::requestHeadersFirst(
+      network::BlocksRequest request,
+      primitives::AuthorityIndex authority_index,
+      const BlocksHandler &requested_blocks_handler) {
+    auto next_client = sync_clients_->clients[authority_index];
+
+    next_client->requestBlocks(
+        request,
+        [self_wp{weak_from_this()},
+         next_client,
+         to{*request.to},
+         requested_blocks_handler{requested_blocks_handler}](
+            auto &&response_res) mutable {
+          auto self = self_wp.lock();
+          if (not self) {
+            return;
+          }
+          if (not response_res) {
+            self->reportResponse(next_client, false, 0, {});
+            self->logger_->error("Could not sync. Error: {}",
+                                 response_res.error().message());
+            return;
+          }
+          const auto &response = response_res.value();
+          auto download = std::make_shared<BodiesDownload>();
+          download->blocks = self->chainedHeaders(response, download->hashes);
+          if (download->blocks.empty()) {
+            self->reportResponse(next_client, false, 0, {});
+            self->logger_->error("Could not sync. Empty response");
+            return;
+          }
+          if (download->blocks.size() < response.blocks.size()) {
+            self->logger_->warn(
+                "Dropped {} received headers, which are not chained",
+                response.blocks.size() - download->blocks.size());
+          }
+          download->handler = std::move(requested_blocks_handler);
+          // the requests of the blocks of the received headers wait for them
+          self->cover(to, download->hashes);
+          const auto batch_size = self->bodies_batch_size_;
+          auto batches =
+              (download->blocks.size() + batch_size - 1) / batch_size;
+          download->batches.resize(batches);
+          for (size_t batch = 0; batch < batches; ++batch) {
+            download->queue.push_back(batch);
+          }
+          download->batches_left = batches;
+          download->failed_batch = batches;
+          // the peer which announced the blocks surely has them
+          auto peers = self->rankPeers(next_client);
+          download->peers_num = peers.size();
+          for (auto &peer : peers) {
+            self->requestBodies(download, peer, false);
+          }
+        });
+  }
+
+  std::vector<primitives::Block> BabeSynchronizerImpl::chainedHeaders(
+      const network::BlocksResponse &response,
+      std::vector<primitives::BlockHash> &hashes) const {
+    std::vector<primitives::Block> blocks;
+    hashes.clear();
+    for (const auto &block_data : response.blocks) {
+      if (not block_data.header) {
+        break;
+      }
+      const auto &header = *block_data.header;
+      auto hash = hasher_->blake2b_256(scale::encode(header).value());
+      if (hash != block_data.hash
+          or (not hashes.empty() and header.parent_hash != hashes.back())) {
+        break;
+      }
+      blocks.push_back(primitives::Block{header, {}});
+      hashes.push_back(hash);
+    }
+    return blocks;
+  }
+
+  void BabeSynchronizerImpl::requestBodies(
+      std::shared_ptr<BodiesDownload> download,
+      std::shared_ptr<network::SyncProtocolClient> peer,
+      bool take_over) const {
+    std::unique_lock lock{download->mutex};
+    if (download->failed_peers.count(peer) != 0) {
+      return;
+    }
+    boost::optional<size_t> batch;
+    if (not download->queue.empty()) {
+      batch = download->queue.front();
+      download->queue.pop_front();
+    } else if (take_over) {
+      auto &batches = download->batches;
+      for (size_t i = 0; i < batches.size(); ++i) {
+        if (not batches[i].done and batches[i].requests == 1
+            and (not batch
+                 or batches[i].requested_at < batches[*batch].requested_at)) {
+          batch = i;
+        }
+      }
+    }
+    if (not batch) {
+      download->idle_peers.push_back(std::move(peer));
+      return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    auto &state = download->batches[*batch];
+    if (state.requests++ == 0) {
+      state.requested_at = now;
+    }
+    auto first = *batch * bodies_batch_size_;
+    auto size =
+        std::min(bodies_batch_size_, download->hashes.size() - first);
+    network::BlocksRequest request{
+        nextRequestId(),
+        network::BlockAttributes{
+            static_cast<uint8_t>(network::BlockAttributesBits::BODY)},
+        download->hashes[first],
+        download->hashes[first + size - 1],
+        network::Direction::DESCENDING,
+        static_cast<uint32_t>(size)};
+    lock.unlock();
+
+    peer->requestBlocks(
+        request,
+        [self_wp{weak_from_this()}, download, peer, batch{*batch}, now](
+            auto &&response_res) {
+          if (auto self = self_wp.lock()) {
+            self->onBodies(download,
+                           peer,
+                           batch,
+                           std::move(response_res),
+                           std::chrono::steady_clock::now() - now);
+          }
+        });
+  }
+
+  void BabeSynchronizerImpl::onBodies(
+      std::shared_ptr<BodiesDownload> download,
+      std::shared_ptr<network::SyncProtocolClient> peer,
+      size_t batch,
+      outcome::result<network::BlocksResponse> response_res,
+      std::chrono::steady_clock::duration elapsed) const {
+    auto first = batch * bodies_batch_size_;
+    auto size =
+        std::min(bodies_batch_size_, download->hashes.size() - first);
+    bool ok = false;
+    if (response_res) {
+      const auto &blocks = response_res.value().blocks;
+      ok = blocks.size() == size;
+      for (size_t i = 0; ok and i < size; ++i) {
+        ok = blocks[i].hash == download->hashes[first + i]
+             and blocks[i].body.has_value();
+      }
+    }
+    reportResponse(peer, ok, size, elapsed);
+
+    std::unique_lock lock{download->mutex};
+    auto &state = download->batches[batch];
+    --state.requests;
+    auto batches_left = download->batches_left;
+    if (state.done) {
+      // another peer has returned the batch first
+    } else if (ok) {
+      auto &blocks = response_res.value().blocks;
+      for (size_t i = 0; i < size; ++i) {
+        download->blocks[first + i].body = std::move(*blocks[i].body);
+      }
+      state.done = true;
+      --download->batches_left;
+    } else {
+      logger_->warn("Could not receive the bodies of the blocks from {}",
+                    download->hashes[first].toHex());
+      download->failed_peers.insert(peer);
+      if (state.requests == 0) {
+        download->queue.push_front(batch);
+      }
+    }
+    // the batches, which no peer is left to be requested from, are failed
+    if (download->failed_peers.size() == download->peers_num) {
+      for (auto queued : download->queue) {
+        download->batches[queued].done = true;
+        download->failed_batch = std::min(download->failed_batch, queued);
+        --download->batches_left;
+      }
+      download->queue.clear();
+    }
+    bool finished = batches_left != 0 and download->batches_left == 0;
+    std::vector<std::shared_ptr<network::SyncProtocolClient>> idle_peers;
+    if (not download->queue.empty()) {
+      idle_peers.swap(download->idle_peers);
+    }
+    lock.unlock();
+
+    if (finished) {
+      auto &blocks = download->blocks;
+      blocks.resize(std::min(blocks.size(),
+                             download->failed_batch * bodies_batch_size_));
+      if (not blocks.empty()) {
+        download->handler(blocks);
+      }
+    }
+    for (auto &idle_peer : idle_peers) {
+      requestBodies(download, std::move(idle_peer), false);
+    }
+    if (ok) {
+      requestBodies(download, std::move(peer), true);
+    }
+  }
+
+  std::vector<std::shared_ptr<network::SyncProtocolClient>>
+  BabeSynchronizerImpl::rankPeers(
+      const std::shared_ptr<network::SyncProtocolClient> &first) const {
+    auto peers = sync_clients_->clients;
+    if (peer_manager_ != nullptr) {
+      peers.erase(std::remove_if(peers.begin(),
+                                 peers.end(),
+                                 [this](const auto &peer) {
+                                   return isBanned(peer);
+                                 }),
+                  peers.end());
+      // the peers not asked yet are tried first, so that they are measured
+      auto score = [this](const auto &peer) {
+        auto id = peer->peerId();
+        return id ? peer_manager_->score(*id)
+                  : std::numeric_limits<double>::infinity();
+      };
+      std::stable_sort(
+          peers.begin(), peers.end(), [&](const auto &lhs, const auto &rhs) {
+            return score(lhs) > score(rhs);
+          });
+    }
+    auto it = std::find(peers.begin(), peers.end(), first);
+    if (it != peers.end()) {
+      std::rotate(peers.begin(), it, std::next(it));
+    }
+    return peers;
+  }
+
+  void BabeSynchronizerImpl::reportResponse(
+      const std::shared_ptr<network::SyncProtocolClient> &peer,
+      bool ok,
+      size_t blocks,
+      std::chrono::steady_clock::duration elapsed) const {
+    if (peer_manager_ == nullptr) {
+      return;
+    }
+    if (auto id = peer->peerId()) {
+      if (ok) {
+        peer_manager_->reportResponse(*id, blocks, elapsed);
+      } else {
+        peer_manager_->reportFailure(*id);
+      }
+    }
+  }
+
+  bool BabeSynchronizerImpl::isBanned(
+      const std::shared_ptr<network::SyncProtocolClient> &peer) const {
+    if (peer_manager_ == nullptr) {
+      return false;
+    }
+    auto id = peer->peerId();
+    return id and peer_manager_->isBanned(*id);
+  }
+
+  void BabeSynchronizerImpl::reportInvalidBlock(
+      primitives::AuthorityIndex authority_index) {
+    if (peer_manager_ == nullptr) {
+      return;
+    }
+    if (auto id = sync_clients_->clients[authority_index]->peerId()) {
+      peer_manager_->reportInvalidBlock(*id);
+    }
+  }
 }  // namespace kagome::consensus
@@ -8,7 +8,13 @@
 
 #include "consensus/babe/babe_synchronizer.hpp"
 
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
 #include "common/logger.hpp"
+#include "crypto/hasher.hpp"
+#include "network/peer_manager.hpp"
 #include "network/types/sync_clients_set.hpp"
 
 namespace kagome::consensus {
@@ -23,15 +29,71 @@ namespace kagome::consensus {
    public:
     ~BabeSynchronizerImpl() override = default;
 
+    /**
+     * @param hasher hashes the headers received in a header-first sync
+     * @param bodies_batch_size number of the blocks the bodies of which are
+     * requested from one peer at once, once the headers are received from
+     * the peer which announced the blocks; 0 requests the headers and the
+     * bodies together from that peer
+     * @param peer_manager ranks the peers the bodies are requested from, and
+     * bans the ones sending the invalid blocks, if any
+     */
     explicit BabeSynchronizerImpl(
-        std::shared_ptr<network::SyncClientsSet> sync_clients);
+        std::shared_ptr<network::SyncClientsSet> sync_clients,
+        std::shared_ptr<crypto::Hasher> hasher = nullptr,
+        size_t bodies_batch_size = 0,
+        std::shared_ptr<network::PeerManager> peer_manager = nullptr);
 
     void request(const primitives::BlockId &from,
                  const primitives::BlockHash &to,
                  primitives::AuthorityIndex authority_index,
                  const BlocksHandler &block_list_handler) override;
 
+    void findCommonAncestor(const primitives::BlockInfo &lower,
+                            primitives::BlockNumber upper,
+                            primitives::AuthorityIndex authority_index,
+                            IsKnown is_known,
+                            const AncestorHandler &handler) override;
+
+    void reportInvalidBlock(
+        primitives::AuthorityIndex authority_index) override;
+
+    /// time, after which a request in flight is not waited for anymore, as
+    /// a failed request is not reported
+    static constexpr std::chrono::steady_clock::duration kInFlightTimeout =
+        std::chrono::seconds(60);
+
    private:
+    struct BodiesDownload;
+
+    // request in flight along with the ones attached to it
+    struct InFlight {
+      std::chrono::steady_clock::time_point requested_at;
+      // hashes of the blocks it is known to cover
+      std::vector<primitives::BlockHash> hashes;
+      std::vector<BlocksHandler> attached;
+    };
+
+    /**
+     * Attaches \arg handler to the request in flight covering the block of
+     * \arg hash, if any
+     * @return false if there is none
+     */
+    bool attach(const primitives::BlockHash &hash,
+                const BlocksHandler &handler);
+
+    /// @return request in flight up to the block of \arg hash
+    std::shared_ptr<InFlight> track(const primitives::BlockHash &hash);
+
+    /// Marks the blocks of \arg hashes as covered by the request in flight
+    /// up to the block of \arg to
+    void cover(const primitives::BlockHash &to,
+               const std::vector<primitives::BlockHash> &hashes);
+
+    /// Calls the handlers attached to \arg in_flight with no blocks, once
+    /// its blocks are handled
+    void finish(const std::shared_ptr<InFlight> &in_flight);
+
     /**
      * Select next client to be polled
      * @param polled_clients clients that we already polled
@@ -51,7 +113,77 @@ namespace kagome::consensus {
         primitives::AuthorityIndex authority_index,
         const BlocksHandler &requested_blocks_handler) const;
 
+    /**
+     * Requests the headers only by \arg request and then the bodies of the
+     * blocks, the headers of which are chained, from all peers at once
+     */
+    void requestHeadersFirst(network::BlocksRequest request,
+                             primitives::AuthorityIndex authority_index,
+                             const BlocksHandler &requested_blocks_handler);
+
+    /**
+     * @return the longest prefix of \arg blocks, in which the hash of each
+     * header is the one in the response and the parent of the next header
+     * @param hashes are filled with the hashes of the returned blocks
+     */
+    std::vector<primitives::Block> chainedHeaders(
+        const network::BlocksResponse &response,
+        std::vector<primitives::BlockHash> &hashes) const;
+
+    /**
+     * Requests the bodies of the next batch of \arg download from \arg peer.
+     * Once no batch is left to be requested, the one requested the longest
+     * time ago from another peer only is requested from \arg peer too, so that
+     * the batches of the slow peers are taken over by the fast ones, if
+     * \arg take_over
+     */
+    void requestBodies(std::shared_ptr<BodiesDownload> download,
+                       std::shared_ptr<network::SyncProtocolClient> peer,
+                       bool take_over) const;
+
+    /**
+     * Handles \arg response_res to the request of \arg batch of \arg download
+     * from \arg peer, and requests the next batch from the peer if it
+     * returned the bodies
+     */
+    void onBodies(std::shared_ptr<BodiesDownload> download,
+                  std::shared_ptr<network::SyncProtocolClient> peer,
+                  size_t batch,
+                  outcome::result<network::BlocksResponse> response_res,
+                  std::chrono::steady_clock::duration elapsed) const;
+
+    /**
+     * @return sync peers, which are not banned, \arg first first and the rest
+     * of them by their scores, from the best to the worst
+     */
+    std::vector<std::shared_ptr<network::SyncProtocolClient>> rankPeers(
+        const std::shared_ptr<network::SyncProtocolClient> &first) const;
+
+    /**
+     * Reports to the peer manager, if any, a request of \arg blocks to
+     * \arg peer, which took \arg elapsed time, and has failed unless \arg ok
+     */
+    void reportResponse(
+        const std::shared_ptr<network::SyncProtocolClient> &peer,
+        bool ok,
+        size_t blocks,
+        std::chrono::steady_clock::duration elapsed) const;
+
+    /**
+     * @return true if \arg peer is banned by the peer manager, if any
+     */
+    bool isBanned(
+        const std::shared_ptr<network::SyncProtocolClient> &peer) const;
+
     std::shared_ptr<network::SyncClientsSet> sync_clients_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    const size_t bodies_batch_size_;
+    std::shared_ptr<network::PeerManager> peer_manager_;
+    std::mutex in_flight_mutex_;
+    // requests in flight by the hashes of the blocks they cover: the last
+    // requested ones and the ones of the received headers
+    std::unordered_map<primitives::BlockHash, std::shared_ptr<InFlight>>
+        in_flight_;
     common::Logger logger_;
   };
 }  // namespace kagome::consensus
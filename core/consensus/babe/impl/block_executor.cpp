@@ -5,11 +5,17 @@
 
 #include "consensus/babe/impl/block_executor.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
+#include <boost/asio/post.hpp>
+#include <gsl/gsl_util>
+
 #include "blockchain/block_tree_error.hpp"
 #include "consensus/babe/impl/babe_digests_util.hpp"
 #include "consensus/babe/impl/threshold_util.hpp"
 #include "scale/scale.hpp"
-#include "transaction_pool/transaction_pool_error.hpp"
+#include "storage/trie/serialization/ordered_trie_hash.hpp"
 
 namespace kagome::consensus {
 
@@ -21,7 +27,16 @@ namespace kagome::consensus {
       std::shared_ptr<consensus::BlockValidator> block_validator,
       std::shared_ptr<consensus::EpochStorage> epoch_storage,
       std::shared_ptr<transaction_pool::TransactionPool> tx_pool,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<storage::DeferredWriteStorage> storage,
+      std::shared_ptr<runtime::OffchainWorkerScheduler>
+          offchain_worker_scheduler,
+      std::shared_ptr<WarpSync> warp_sync,
+      std::shared_ptr<transaction_pool::PoolRevalidator> pool_revalidator,
+      std::shared_ptr<ConsensusMetrics> metrics,
+      std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
+      std::shared_ptr<boost::asio::io_context> io_context,
+      std::shared_ptr<common::Tracer> tracer)
       : block_tree_{std::move(block_tree)},
         core_{std::move(core)},
         genesis_configuration_{std::move(configuration)},
@@ -30,6 +45,19 @@ namespace kagome::consensus {
         epoch_storage_{std::move(epoch_storage)},
         tx_pool_{std::move(tx_pool)},
         hasher_{std::move(hasher)},
+        storage_{std::move(storage)},
+        offchain_worker_scheduler_{std::move(offchain_worker_scheduler)},
+        warp_sync_{std::move(warp_sync)},
+        pool_revalidator_{std::move(pool_revalidator)},
+        metrics_{std::move(metrics)},
+        changes_tracker_{std::move(changes_tracker)},
+        io_context_{std::move(io_context)},
+        tracer_{std::move(tracer)},
+        genesis_epoch_{std::make_shared<const EpochInfo>(EpochInfo{
+            {genesis_configuration_->genesis_authorities,
+             genesis_configuration_->randomness},
+            calculateThresholds(genesis_configuration_->leadership_rate,
+                                genesis_configuration_->genesis_authorities)})},
         logger_{common::createLogger("BlockExecutor")} {
     BOOST_ASSERT(block_tree_ != nullptr);
     BOOST_ASSERT(core_ != nullptr);
@@ -39,48 +67,122 @@ namespace kagome::consensus {
     BOOST_ASSERT(epoch_storage_ != nullptr);
     BOOST_ASSERT(tx_pool_ != nullptr);
     BOOST_ASSERT(hasher_ != nullptr);
+    BOOST_ASSERT(storage_ != nullptr);
     BOOST_ASSERT(logger_ != nullptr);
   }
 
   void BlockExecutor::processNextBlock(
-      const primitives::BlockHeader &header,
+      const network::BlockAnnounce &announce,
       const std::function<void(const primitives::BlockHeader &)>
           &new_block_handler) {
+    const auto &header = announce.header;
     auto block_hash = hasher_->blake2b_256(scale::encode(header).value());
 
     // insert block_header if it is missing
-    if (not block_tree_->getBlockHeader(block_hash)) {
+    if (not block_tree_->getBlockHeader(block_hash)
+        and not orphans_.contains(block_hash)) {
       new_block_handler(header);
       logger_->info("Received block header. Number: {}, Hash: {}",
                     header.number,
-                    block_hash.toHex());
+                    block_hash);
 
       auto [_, babe_header] = getBabeDigests(header).value();
 
       if (not block_tree_->getBlockHeader(header.parent_hash)) {
-        const auto &[last_number, last_hash] = block_tree_->getLastFinalized();
-        // we should request blocks between last finalized one and received
-        // block
-        requestBlocks(
-            last_hash, block_hash, babe_header.authority_index, [] {});
+        boost::optional<primitives::BlockBody> body;
+        if (announce.extrinsic_hashes) {
+          if (auto block = buildFromPool(header, *announce.extrinsic_hashes)) {
+            body = std::move(block->body);
+          }
+        }
+        orphans_.add({block_hash, header, std::move(body)});
+        // the orphans above the missing block are imported after it, so
+        // the blocks between the last finalized one and it are requested,
+        // once for all of them
+        auto missing = orphans_.missingAncestor(block_hash);
+        if (block_tree_->getBlockHeader(missing)) {
+          return applyOrphans(missing);
+        }
+        if (orphans_.shouldRequest(missing)) {
+          const auto &[last_number, last_hash] =
+              block_tree_->getLastFinalized();
+          requestBlocks(last_hash, missing, babe_header.authority_index, [] {});
+        }
       } else {
+        if (announce.extrinsic_hashes) {
+          if (auto block = buildFromPool(header, *announce.extrinsic_hashes)) {
+            auto apply_res = applyBlock(*block, block_hash);
+            if (not apply_res) {
+              logger_->warn("Could not apply the block built from the pool: {}",
+                            apply_res.error().message());
+            }
+            return;
+          }
+        }
         requestBlocks(
             header.parent_hash, block_hash, babe_header.authority_index, [] {});
       }
     }
   }
 
+  outcome::result<void> BlockExecutor::importBlock(
+      const primitives::Block &block) {
+    OUTCOME_TRY(encoded_header, scale::encode(block.header));
+    return applyBlock(block, hasher_->blake2b_256(encoded_header));
+  }
+
   void BlockExecutor::requestBlocks(const primitives::BlockHeader &new_header,
                                     std::function<void()> &&next) {
     const auto &[last_number, last_hash] = block_tree_->getLastFinalized();
     auto new_block_hash =
         hasher_->blake2b_256(scale::encode(new_header).value());
     BOOST_ASSERT(new_header.number >= last_number);
+    if (warp_sync_ != nullptr and not warp_sync_started_ and last_number == 0) {
+      warp_sync_started_ = true;
+      return warp_sync_->sync(
+          new_block_hash,
+          [self_wp{weak_from_this()}, new_header, next(std::move(next))](
+              auto &&synced_res) mutable {
+            auto self = self_wp.lock();
+            if (not self) return;
+            if (not synced_res) {
+              self->logger_->warn(
+                  "Warp sync failed, importing the blocks from the genesis: {}",
+                  synced_res.error().message());
+            }
+            // the rest of the blocks are imported after the synced one
+            self->requestBlocks(new_header, std::move(next));
+          });
+    }
     auto [_, babe_header] = getBabeDigests(new_header).value();
-    return requestBlocks(last_hash,
-                         new_block_hash,
-                         babe_header.authority_index,
-                         std::move(next));
+    // the blocks below the new one, which are known already on a chain not
+    // finalized yet, are not requested again
+    auto upper = std::min(block_tree_->deepestLeaf().block_number,
+                          new_header.number - 1);
+    if (new_header.number == 0 or upper <= last_number) {
+      return requestBlocks(last_hash,
+                           new_block_hash,
+                           babe_header.authority_index,
+                           std::move(next));
+    }
+    babe_synchronizer_->findCommonAncestor(
+        {last_number, last_hash},
+        upper,
+        babe_header.authority_index,
+        [block_tree{block_tree_}](const primitives::BlockHash &hash) {
+          return block_tree->getBlockHeader(hash).has_value();
+        },
+        [self_wp{weak_from_this()},
+         new_block_hash,
+         authority_index{babe_header.authority_index},
+         next(std::move(next))](const primitives::BlockInfo &ancestor) mutable {
+          if (auto self = self_wp.lock()) {
+            self->requestBlocks(ancestor.block_hash,
+                                new_block_hash,
+                                authority_index,
+                                std::move(next));
+          }
+        });
   }
 
   void BlockExecutor::requestBlocks(const primitives::BlockId &from,
@@ -91,55 +193,226 @@ namespace kagome::consensus {
         from,
         to,
         authority_index,
-        [self_wp{weak_from_this()},
-         next(std::move(next))](const std::vector<primitives::Block> &blocks) {
+        [self_wp{weak_from_this()}, authority_index, next(std::move(next))](
+            const std::vector<primitives::Block> &blocks) {
           auto self = self_wp.lock();
           if (not self) return;
 
+          // the blocks of a request attached to another one are imported
+          // by the handler of that one
           if (blocks.empty()) {
-            self->logger_->warn("Received empty list of blocks");
-          } else {
-            auto front_block_hex =
-                self->hasher_
-                    ->blake2b_256(scale::encode(blocks.front().header).value())
-                    .toHex();
-            auto back_block_hex =
-                self->hasher_
-                    ->blake2b_256(scale::encode(blocks.back().header).value())
-                    .toHex();
-            self->logger_->info("Received blocks from: {}, to {}",
-                                front_block_hex,
-                                back_block_hex);
+            return next();
           }
-          for (const auto &block : blocks) {
-            if (auto apply_res = self->applyBlock(block); not apply_res) {
-              if (apply_res
-                  == outcome::failure(
-                      blockchain::BlockTreeError::BLOCK_EXISTS)) {
-                continue;
-              }
-              self->logger_->warn(
-                  "Could not apply block during synchronizing slots.Error: {}",
-                  apply_res.error().message());
-              break;
-            }
-          }
-          next();
+          // each header is hashed once, for both the logs and the import
+          auto block_hashes = self->hashHeaders(blocks);
+          self->logger_->info("Received blocks from: {}, to {}",
+                              block_hashes.front(),
+                              block_hashes.back());
+          // the seals are validated on all cores before the blocks, which
+          // depend on their parents, are executed one by one
+          auto seals = self->validateSeals(blocks, block_hashes);
+          auto synced = std::make_shared<SyncedBlocks>(
+              SyncedBlocks{blocks,
+                           std::move(block_hashes),
+                           std::move(seals),
+                           authority_index,
+                           next});
+          self->applySynced(std::move(synced), 0);
         });
   }
 
-  outcome::result<void> BlockExecutor::applyBlock(
-      const primitives::Block &block) {
-    auto block_hash = hasher_->blake2b_256(scale::encode(block.header).value());
+  void BlockExecutor::applySynced(std::shared_ptr<SyncedBlocks> synced,
+                                  size_t index) {
+    while (index < synced->blocks.size()) {
+      if (const auto &seal = synced->seals[index]; not seal) {
+        logger_->warn(
+            "Could not apply block during synchronizing slots.Error: {}",
+            seal.error().message());
+        // the headers are returned by the peer announcing the blocks
+        babe_synchronizer_->reportInvalidBlock(synced->authority_index);
+        break;
+      }
+      auto apply_res = applyBlock(
+          synced->blocks[index], synced->block_hashes[index], true);
+      if (not apply_res
+          and apply_res.error() != blockchain::BlockTreeError::BLOCK_EXISTS) {
+        logger_->warn(
+            "Could not apply block during synchronizing slots.Error: {}",
+            apply_res.error().message());
+        break;
+      }
+      ++index;
+      // a batch of blocks takes long to import, so the votes and the gossip
+      // waiting in the io_context are processed before the next block
+      if (io_context_ != nullptr and index < synced->blocks.size()) {
+        boost::asio::post(
+            *io_context_,
+            [self_wp{weak_from_this()}, synced{std::move(synced)}, index] {
+              if (auto self = self_wp.lock()) {
+                self->applySynced(synced, index);
+              }
+            });
+        return;
+      }
+    }
+    synced->next();
+  }
+
+  void BlockExecutor::applyOrphans(const primitives::BlockHash &parent_hash) {
+    for (auto &orphan : orphans_.takeChildren(parent_hash)) {
+      if (orphan.body) {
+        // the orphans waiting for it are imported after it
+        primitives::Block block{std::move(orphan.header),
+                                std::move(*orphan.body)};
+        auto apply_res = applyBlock(block, orphan.hash);
+        if (not apply_res) {
+          logger_->warn("Could not apply the orphan block {}: {}",
+                        orphan.hash,
+                        apply_res.error().message());
+        }
+        continue;
+      }
+      auto last = orphans_.takeBranch(orphan.hash);
+      const auto &to = last ? *last : orphan;
+      auto [_, babe_header] = getBabeDigests(to.header).value();
+      requestBlocks(parent_hash, to.hash, babe_header.authority_index, [] {});
+    }
+  }
+
+  boost::optional<primitives::Block> BlockExecutor::buildFromPool(
+      const primitives::BlockHeader &header,
+      const std::vector<primitives::Transaction::Hash> &extrinsic_hashes)
+      const {
+    primitives::Block block{header, {}};
+    block.body.reserve(extrinsic_hashes.size());
+    std::vector<common::Buffer> encoded;
+    encoded.reserve(extrinsic_hashes.size());
+    for (auto &tx : tx_pool_->getTransactions(extrinsic_hashes)) {
+      if (tx == nullptr) {
+        // there is no protocol to request single extrinsics, so the whole
+        // body is requested then
+        return boost::none;
+      }
+      block.body.push_back(tx->ext);
+      encoded.emplace_back(scale::encode(tx->ext).value());
+    }
+    auto root = storage::trie::calculateOrderedTrieHash(encoded.begin(),
+                                                        encoded.end());
+    auto root_matches =
+        root and root.value() == gsl::make_span(header.extrinsics_root);
+    if (not root_matches) {
+      logger_->warn("Extrinsics of the compact announce of block {} do not "
+                    "match its extrinsics root",
+                    header.number);
+      return boost::none;
+    }
+    return block;
+  }
+
+  std::vector<primitives::BlockHash> BlockExecutor::hashHeaders(
+      const std::vector<primitives::Block> &blocks) const {
+    std::vector<common::Buffer> encoded_headers;
+    encoded_headers.reserve(blocks.size());
+    for (const auto &block : blocks) {
+      encoded_headers.emplace_back(scale::encode(block.header).value());
+    }
+    std::vector<gsl::span<const uint8_t>> headers_data(encoded_headers.begin(),
+                                                       encoded_headers.end());
+    std::vector<primitives::BlockHash> block_hashes(blocks.size());
+    hasher_->blake2b_256_many(headers_data, block_hashes);
+    return block_hashes;
+  }
+
+  std::vector<outcome::result<void>> BlockExecutor::validateSeals(
+      const std::vector<primitives::Block> &blocks,
+      const std::vector<primitives::BlockHash> &block_hashes) const {
+    std::vector<outcome::result<void>> results(blocks.size(),
+                                               outcome::success());
+    // indices of the validated blocks in the list
+    std::vector<size_t> indices;
+    std::vector<SealValidation> validations;
+    // epochs announced by the blocks of the list, which are not in the epoch
+    // storage until the blocks are imported
+    std::unordered_map<EpochIndex, std::shared_ptr<const EpochInfo>> announced;
+    // the blocks of the list are the descendants of the parent of the first
+    // one, which is in the block tree, so the epochs are looked up on its
+    // chain
+    const auto &chain_hash = blocks.front().header.parent_hash;
+    for (size_t i = 0; i < blocks.size(); i++) {
+      const auto &header = blocks[i].header;
+      if (block_tree_->getBlockBody(block_hashes[i])) {
+        continue;
+      }
+      auto babe_digests = getBabeDigests(header);
+      if (not babe_digests) {
+        results[i] = babe_digests.error();
+        continue;
+      }
+      const auto &babe_header = babe_digests.value().second;
+      auto epoch_index =
+          babe_header.slot_number / genesis_configuration_->epoch_length;
+
+      auto it = announced.find(epoch_index);
+      auto epoch = it != announced.end()
+                       ? it->second
+                       : getEpochInfo(epoch_index, chain_hash);
+      if (auto next_epoch_digest = getNextEpochDigest(header)) {
+        auto thresholds =
+            calculateThresholds(genesis_configuration_->leadership_rate,
+                                next_epoch_digest.value().authorities);
+        announced[epoch_index + 2] = std::make_shared<const EpochInfo>(
+            EpochInfo{std::move(next_epoch_digest.value()),
+                      std::move(thresholds)});
+      }
+
+      if (not epoch) {
+        results[i] = epoch.error();
+        continue;
+      }
+      const auto &epoch_descriptor = epoch.value()->descriptor;
+      indices.push_back(i);
+      validations.push_back(
+          {header,
+           epoch_descriptor.authorities[babe_header.authority_index].id,
+           epoch.value()->thresholds[babe_header.authority_index],
+           epoch_descriptor.randomness});
+    }
+
+    auto validated = block_validator_->validateSeals(validations);
+    for (size_t j = 0; j < indices.size(); j++) {
+      results[indices[j]] = std::move(validated[j]);
+    }
+    return results;
+  }
+
+  outcome::result<std::shared_ptr<const EpochInfo>>
+  BlockExecutor::getEpochInfo(EpochIndex epoch_index,
+                              const primitives::BlockHash &chain_hash) const {
+    // TODO (kamilsa): PRE-364 uncomment outcome try and remove dirty workaround
+    // below
+    //    OUTCOME_TRY(this_block_epoch_info,
+    //                epoch_storage_->getEpochInfo(epoch_index, chain_hash));
+    auto epoch_info_res = epoch_storage_->getEpochInfo(epoch_index, chain_hash);
+    if (not epoch_info_res
+        and epoch_info_res.error() == EpochStorageError::EPOCH_DOES_NOT_EXIST) {
+      // take authorities and randomness from config
+      return genesis_epoch_;
+    }
+    return epoch_info_res;
+  }
 
+  outcome::result<void> BlockExecutor::applyBlock(
+      const primitives::Block &block,
+      const primitives::BlockHash &block_hash,
+      bool seal_validated) {
+    common::Tracer::Scope span{tracer_.get(), "block", "apply_block"};
     // check if block body already exists. If so, do not apply
     if (block_tree_->getBlockBody(block_hash)) {
       return blockchain::BlockTreeError::BLOCK_EXISTS;
     }
-    logger_->info(
-        "Applying block number: {}, hash: {}",
-        block.header.number,
-        hasher_->blake2b_256(scale::encode(block.header).value()).toHex());
+    logger_->info("Applying block number: {}, hash: {}",
+                  block.header.number,
+                  block_hash);
 
     OUTCOME_TRY(babe_digests, getBabeDigests(block.header));
 
@@ -148,64 +421,108 @@ namespace kagome::consensus {
     auto epoch_index =
         babe_header.slot_number / genesis_configuration_->epoch_length;
 
-    // TODO (kamilsa): PRE-364 uncomment outcome try and remove dirty workaround
-    // below
-    //    OUTCOME_TRY(this_block_epoch_descriptor,
-    //                epoch_storage_->getEpochDescriptor(epoch_index));
-    auto this_block_epoch_descriptor_res =
-        epoch_storage_->getEpochDescriptor(epoch_index);
-    if (not this_block_epoch_descriptor_res) {  // take authorities and
-                                                // randomness
-                                                // from config
-      this_block_epoch_descriptor_res = NextEpochDescriptor{
-          .authorities = genesis_configuration_->genesis_authorities,
-          .randomness = genesis_configuration_->randomness};
-    }
-    auto this_block_epoch_descriptor = this_block_epoch_descriptor_res.value();
-
-    auto threshold = calculateThreshold(genesis_configuration_->leadership_rate,
-                                        this_block_epoch_descriptor.authorities,
-                                        babe_header.authority_index);
+    // the epoch descriptor, the trie nodes of the new state and the block
+    // itself are written at once, and are discarded if the import fails; the
+    // unit collects the writes of this thread only, so the ones of RPC and
+    // the other threads meanwhile are neither delayed nor discarded with it
+    storage_->begin();
+    auto discard_writes = gsl::finally([this] { storage_->rollback(); });
 
     // update authorities and randomnesss
     auto next_epoch_digest_res = getNextEpochDigest(block.header);
     if (next_epoch_digest_res) {
       logger_->info("Got next epoch digest for epoch: {}", epoch_index);
       epoch_storage_
-          ->addEpochDescriptor(epoch_index + 2, next_epoch_digest_res.value())
+          ->addEpochDescriptor(
+              epoch_index + 2, block_hash, next_epoch_digest_res.value())
           .value();
     }
 
-    OUTCOME_TRY(block_validator_->validateHeader(
-        block.header,
-        this_block_epoch_descriptor.authorities[babe_header.authority_index].id,
-        threshold,
-        this_block_epoch_descriptor.randomness));
+    if (seal_validated) {
+      common::Tracer::Scope validate_span{
+          tracer_.get(), "block", "validate_producer"};
+      OUTCOME_TRY(block_validator_->validateProducer(block.header));
+    } else {
+      common::Tracer::Scope validate_span{
+          tracer_.get(), "block", "validate_header"};
+      OUTCOME_TRY(this_block_epoch,
+                  getEpochInfo(epoch_index, block.header.parent_hash));
+      const auto &epoch_descriptor = this_block_epoch->descriptor;
+      OUTCOME_TRY(block_validator_->validateHeader(
+          block.header,
+          epoch_descriptor.authorities[babe_header.authority_index].id,
+          this_block_epoch->thresholds[babe_header.authority_index],
+          epoch_descriptor.randomness));
+    }
 
     auto block_without_seal_digest = block;
 
     // block should be applied without last digest which contains the seal
     block_without_seal_digest.header.digest.pop_back();
     // apply block
-    OUTCOME_TRY(core_->execute_block(block_without_seal_digest));
+    {
+      common::Tracer::Scope execute_span{
+          tracer_.get(), "block", "execute_block"};
+      OUTCOME_TRY(core_->execute_block(block_without_seal_digest));
+    }
 
     // add block header if it does not exist
-    OUTCOME_TRY(block_tree_->addBlock(block));
+    {
+      common::Tracer::Scope add_span{tracer_.get(), "block", "add_block"};
+      OUTCOME_TRY(block_tree_->addBlock(block));
+    }
+    {
+      common::Tracer::Scope commit_span{
+          tracer_.get(), "block", "commit_writes"};
+      OUTCOME_TRY(storage_->commit());
+    }
+    if (metrics_ != nullptr) {
+      metrics_->recordImported(block.header.number);
+    }
+    if (changes_tracker_ != nullptr) {
+      changes_tracker_->onBlockImported(block_hash, block.header.parent_hash);
+    }
 
-    // remove block's extrinsics from tx pool
+    // remove block's extrinsics from tx pool, the ones not in the pool are
+    // skipped
+    std::vector<gsl::span<const uint8_t>> extrinsics_data;
+    extrinsics_data.reserve(block.body.size());
     for (const auto &extrinsic : block.body) {
-      auto res = tx_pool_->removeOne(hasher_->blake2b_256(extrinsic.data));
-      if (res.has_error()
-          && res
-                 != outcome::failure(
-                     transaction_pool::TransactionPoolError::TX_NOT_FOUND)) {
-        return res;
-      }
+      extrinsics_data.emplace_back(extrinsic.data);
     }
+    std::vector<common::Hash256> extrinsics_hashes(extrinsics_data.size());
+    hasher_->blake2b_256_many(extrinsics_data, extrinsics_hashes);
+    OUTCOME_TRY(tx_pool_->remove(extrinsics_hashes));
 
     logger_->info("Imported block with number: {}, hash: {}",
                   block.header.number,
-                  block_hash.toHex());
+                  block_hash);
+
+    // the orphans waiting for the block are imported in a handler of their
+    // own, if any
+    if (orphans_.hasChildren(block_hash)) {
+      if (io_context_ != nullptr) {
+        boost::asio::post(*io_context_,
+                          [self_wp{weak_from_this()}, block_hash] {
+                            if (auto self = self_wp.lock()) {
+                              self->applyOrphans(block_hash);
+                            }
+                          });
+      } else {
+        applyOrphans(block_hash);
+      }
+    }
+
+    // the workers and the revalidation run on threads of their own, not
+    // delaying the import
+    if (block_tree_->deepestLeaf().block_hash == block_hash) {
+      if (offchain_worker_scheduler_) {
+        offchain_worker_scheduler_->schedule(block.header.number);
+      }
+      if (pool_revalidator_) {
+        pool_revalidator_->onNewBestBlock({block.header.number, block_hash});
+      }
+    }
     return outcome::success();
   }
 
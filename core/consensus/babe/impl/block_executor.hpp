@@ -6,21 +6,48 @@
 #ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 #define KAGOME_CORE_CONSENSUS_BABE_IMPL_BLOCK_EXECUTOR_HPP
 
+#include <boost/asio/io_context.hpp>
+
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
+#include "common/tracer.hpp"
 #include "consensus/babe/babe_synchronizer.hpp"
 #include "consensus/babe/epoch_storage.hpp"
+#include "consensus/babe/impl/orphan_pool.hpp"
+#include "consensus/babe/impl/warp_sync.hpp"
+#include "consensus/consensus_metrics.hpp"
 #include "consensus/validation/block_validator.hpp"
 #include "crypto/hasher.hpp"
+#include "network/types/block_announce.hpp"
 #include "primitives/babe_configuration.hpp"
 #include "primitives/block_header.hpp"
+#include "runtime/common/offchain_worker_scheduler.hpp"
 #include "runtime/core.hpp"
+#include "storage/changes_trie/changes_tracker.hpp"
+#include "storage/deferred_write/deferred_write_storage.hpp"
+#include "transaction_pool/pool_revalidator.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
 namespace kagome::consensus {
 
   class BlockExecutor : public std::enable_shared_from_this<BlockExecutor> {
    public:
+    /**
+     * @param offchain_worker_scheduler runs the offchain workers for the
+     * imported blocks which become the best ones, if any
+     * @param warp_sync syncs a fresh node to the latest finalized state
+     * before the blocks are requested, if any
+     * @param pool_revalidator revalidates the transaction pool for the
+     * imported blocks which become the best ones, if any
+     * @param metrics records the times the blocks are imported at, if any
+     * @param changes_tracker is told that the changes of the executed blocks
+     * are committed, so that they are reported, if any
+     * @param io_context the blocks of a sync are imported in the handlers of
+     * it one by one, so that the messages of the network and the consensus
+     * are processed between them, if any
+     * @param tracer records the spans of the stages of the import of a
+     * block, if any
+     */
     BlockExecutor(std::shared_ptr<blockchain::BlockTree> block_tree,
                   std::shared_ptr<runtime::Core> core,
                   std::shared_ptr<primitives::BabeConfiguration> configuration,
@@ -28,23 +55,44 @@ namespace kagome::consensus {
                   std::shared_ptr<BlockValidator> block_validator,
                   std::shared_ptr<EpochStorage> epoch_storage,
                   std::shared_ptr<transaction_pool::TransactionPool> tx_pool,
-                  std::shared_ptr<crypto::Hasher> hasher);
+                  std::shared_ptr<crypto::Hasher> hasher,
+                  std::shared_ptr<storage::DeferredWriteStorage> storage,
+                  std::shared_ptr<runtime::OffchainWorkerScheduler>
+                      offchain_worker_scheduler = nullptr,
+                  std::shared_ptr<WarpSync> warp_sync = nullptr,
+                  std::shared_ptr<transaction_pool::PoolRevalidator>
+                      pool_revalidator = nullptr,
+                  std::shared_ptr<ConsensusMetrics> metrics = nullptr,
+                  std::shared_ptr<storage::changes_trie::ChangesTracker>
+                      changes_tracker = nullptr,
+                  std::shared_ptr<boost::asio::io_context> io_context =
+                      nullptr,
+                  std::shared_ptr<common::Tracer> tracer = nullptr);
 
     /**
      * Processes next header: if header is observed first it is added to the
      * storage, handler is invoked. Synchronization of blocks between new one
-     * and the current best one is launched if required
-     * @param header new header that we received and trying to process
+     * and the current best one is launched if required. The block of a
+     * compact announce is built from the transaction pool and imported
+     * instead, if all of its extrinsics are there. A block, the parent of
+     * which is not known, waits for it in the orphan pool, and only the
+     * blocks missing below the orphans are requested
+     * @param announce of the new header that we received and trying to
+     * process
      * @param new_block_handler invoked on new header if it is observed first
      * time
      */
     void processNextBlock(
-        const primitives::BlockHeader &header,
+        const network::BlockAnnounce &announce,
         const std::function<void(const primitives::BlockHeader &)>
             &new_block_handler);
 
     /**
      * Synchronize all missing blocks between the last finalized and the new one
+     * (a node having only the genesis block is warp synced first, if enabled).
+     * The blocks up to the highest one of the chain of the announcing peer,
+     * which is known already, are skipped, it is searched for with the peer
+     * first
      * @param new_header header defining new block
      * @param next action after the sync is done
      */
@@ -62,9 +110,82 @@ namespace kagome::consensus {
                        primitives::AuthorityIndex authority_index,
                        std::function<void()> &&next);
 
+    /**
+     * Validates and applies \arg block, which is got not from a peer but,
+     * for example, from a recording of a chain, right away
+     */
+    outcome::result<void> importBlock(const primitives::Block &block);
+
    private:
-    // should only be invoked when parent of block exists
-    outcome::result<void> applyBlock(const primitives::Block &block);
+    // blocks received in a sync, along with the results of the validation of
+    // their seals
+    struct SyncedBlocks {
+      std::vector<primitives::Block> blocks;
+      std::vector<primitives::BlockHash> block_hashes;
+      std::vector<outcome::result<void>> seals;
+      primitives::AuthorityIndex authority_index;
+      std::function<void()> next;
+    };
+
+    /**
+     * Imports the block of \arg synced at \arg index and the ones after it.
+     * Each of the later ones is imported in a handler of the io_context of
+     * its own, if any. Calls the next action of the sync after the last of
+     * them, or after the first one failed
+     */
+    void applySynced(std::shared_ptr<SyncedBlocks> synced, size_t index);
+
+    /**
+     * Imports the orphans, which are the children of the imported block of
+     * \arg parent_hash, the ones without bodies are requested along with
+     * their descendants without bodies
+     */
+    void applyOrphans(const primitives::BlockHash &parent_hash);
+
+    // should only be invoked when parent of block exists. Everything the
+    // block import writes to the storage reaches it with a single write.
+    // \arg block_hash is the hash of the header of \arg block; the seal is
+    // not validated again if \arg seal_validated
+    outcome::result<void> applyBlock(const primitives::Block &block,
+                                     const primitives::BlockHash &block_hash,
+                                     bool seal_validated = false);
+
+    /**
+     * Validates the seals of the headers of \arg blocks as a batch, using
+     * the epochs announced by the blocks before them in the list. The seals
+     * of the blocks which are imported already are not validated
+     * @param block_hashes hashes of the headers of the blocks
+     * @return results of the validations, in the same order
+     */
+    std::vector<outcome::result<void>> validateSeals(
+        const std::vector<primitives::Block> &blocks,
+        const std::vector<primitives::BlockHash> &block_hashes) const;
+
+    /**
+     * @return descriptor of the epoch with \arg epoch_index announced on the
+     * chain of \arg chain_hash along with the thresholds of its authorities,
+     * or the genesis one if the epoch is not announced on any chain, or error
+     * if it is announced on the other ones only
+     */
+    outcome::result<std::shared_ptr<const EpochInfo>> getEpochInfo(
+        EpochIndex epoch_index, const primitives::BlockHash &chain_hash) const;
+
+    /**
+     * @return the block of \arg header with the body built from the
+     * extrinsics with \arg extrinsic_hashes from the transaction pool, none
+     * if some of them are not there or they do not match the extrinsics root
+     * of the header
+     */
+    boost::optional<primitives::Block> buildFromPool(
+        const primitives::BlockHeader &header,
+        const std::vector<primitives::Transaction::Hash> &extrinsic_hashes)
+        const;
+
+    /**
+     * @return hashes of the headers of \arg blocks, in the same order
+     */
+    std::vector<primitives::BlockHash> hashHeaders(
+        const std::vector<primitives::Block> &blocks) const;
 
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<runtime::Core> core_;
@@ -74,6 +195,21 @@ namespace kagome::consensus {
     std::shared_ptr<EpochStorage> epoch_storage_;
     std::shared_ptr<transaction_pool::TransactionPool> tx_pool_;
     std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<storage::DeferredWriteStorage> storage_;
+    std::shared_ptr<runtime::OffchainWorkerScheduler>
+        offchain_worker_scheduler_;
+    std::shared_ptr<WarpSync> warp_sync_;
+    std::shared_ptr<transaction_pool::PoolRevalidator> pool_revalidator_;
+    std::shared_ptr<ConsensusMetrics> metrics_;
+    std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::shared_ptr<common::Tracer> tracer_;
+    // warp sync is tried once, the blocks are imported one by one after it
+    // even if it fails
+    bool warp_sync_started_ = false;
+    OrphanPool orphans_;
+    // epoch taken when the epoch of a block is not in the epoch storage
+    std::shared_ptr<const EpochInfo> genesis_epoch_;
 
     common::Logger logger_;
   };
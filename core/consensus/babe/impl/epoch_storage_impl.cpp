@@ -5,6 +5,9 @@
 
 #include "consensus/babe/impl/epoch_storage_impl.hpp"
 
+#include <algorithm>
+
+#include "consensus/babe/impl/threshold_util.hpp"
 #include "scale/scale.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus, EpochStorageError, e) {
@@ -13,6 +16,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus, EpochStorageError, e) {
   switch (e) {
     case E::EPOCH_DOES_NOT_EXIST:
       return "Requested epoch does not exist";
+    case E::EPOCH_NOT_ON_CHAIN:
+      return "Requested epoch is announced on the other chains only";
   }
   return "Unknown error";
 }
@@ -20,18 +25,62 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus, EpochStorageError, e) {
 namespace kagome::consensus {
 
   const auto EPOCH_PREFIX = common::Blob<8>::fromString("epchdcr0").value();
+  const auto ANNOUNCERS_PREFIX =
+      common::Blob<8>::fromString("epchann0").value();
 
   EpochStorageImpl::EpochStorageImpl(
-      std::shared_ptr<kagome::storage::BufferStorage> storage)
-      : storage_{std::move(storage)} {
+      std::shared_ptr<kagome::storage::BufferStorage> storage,
+      std::shared_ptr<primitives::BabeConfiguration> configuration,
+      std::shared_ptr<blockchain::BlockTree> block_tree)
+      : storage_{std::move(storage)},
+        configuration_{std::move(configuration)},
+        block_tree_{std::move(block_tree)} {
     BOOST_ASSERT(storage_);
+    BOOST_ASSERT(configuration_);
+    BOOST_ASSERT(block_tree_);
   }
 
   outcome::result<void> EpochStorageImpl::addEpochDescriptor(
       EpochIndex epoch_number, const NextEpochDescriptor &epoch_descriptor) {
     auto key = common::Buffer{EPOCH_PREFIX}.putUint64(epoch_number);
     auto val = common::Buffer{scale::encode(epoch_descriptor).value()};
-    return storage_->put(key, val);
+    OUTCOME_TRY(storage_->put(key, val));
+    // the descriptor is read again, so that the one of a discarded write is
+    // not kept
+    std::lock_guard lock{cache_mutex_};
+    cache_.erase(epoch_number);
+    return outcome::success();
+  }
+
+  outcome::result<void> EpochStorageImpl::addEpochDescriptor(
+      EpochIndex epoch_number,
+      const primitives::BlockHash &announced_by,
+      const NextEpochDescriptor &epoch_descriptor) {
+    auto announcers_key =
+        common::Buffer{ANNOUNCERS_PREFIX}.putUint64(epoch_number);
+    std::vector<primitives::BlockHash> announcers;
+    if (storage_->contains(announcers_key)) {
+      OUTCOME_TRY(encoded_announcers, storage_->get(announcers_key));
+      OUTCOME_TRY(decoded_announcers,
+                  scale::decode<std::vector<primitives::BlockHash>>(
+                      encoded_announcers));
+      announcers = std::move(decoded_announcers);
+    }
+    if (std::find(announcers.begin(), announcers.end(), announced_by)
+        == announcers.end()) {
+      announcers.push_back(announced_by);
+      OUTCOME_TRY(storage_->put(
+          announcers_key, common::Buffer{scale::encode(announcers).value()}));
+    }
+
+    auto key = common::Buffer{EPOCH_PREFIX}
+                   .putUint64(epoch_number)
+                   .put(announced_by);
+    auto val = common::Buffer{scale::encode(epoch_descriptor).value()};
+    OUTCOME_TRY(storage_->put(key, val));
+    // the last announced one is also the one of the epoch number, which does
+    // not depend on the chain
+    return addEpochDescriptor(epoch_number, epoch_descriptor);
   }
 
   outcome::result<NextEpochDescriptor> EpochStorageImpl::getEpochDescriptor(
@@ -40,4 +89,74 @@ namespace kagome::consensus {
     OUTCOME_TRY(encoded_ed, storage_->get(key));
     return scale::decode<NextEpochDescriptor>(encoded_ed);
   }
+
+  outcome::result<std::shared_ptr<const EpochInfo>>
+  EpochStorageImpl::getEpochInfo(
+      EpochIndex epoch_number, const primitives::BlockHash &block_hash) const {
+    std::lock_guard lock{cache_mutex_};
+    OUTCOME_TRY(announced_ref, getAnnounced(epoch_number));
+    const Announced &announced = announced_ref;
+
+    static const primitives::BlockHash kNotAnnounced{};
+    for (const auto &[announced_by, info] : announced) {
+      if (announced_by != kNotAnnounced
+          and block_tree_->hasDirectChain(announced_by, block_hash)) {
+        return info;
+      }
+    }
+    if (auto it = announced.find(kNotAnnounced); it != announced.end()) {
+      return it->second;
+    }
+    if (announced.empty()) {
+      return EpochStorageError::EPOCH_DOES_NOT_EXIST;
+    }
+    return EpochStorageError::EPOCH_NOT_ON_CHAIN;
+  }
+
+  outcome::result<std::reference_wrapper<const EpochStorageImpl::Announced>>
+  EpochStorageImpl::getAnnounced(EpochIndex epoch_number) const {
+    if (auto it = cache_.find(epoch_number); it != cache_.end()) {
+      return std::cref(it->second);
+    }
+
+    Announced announced;
+    auto announcers_key =
+        common::Buffer{ANNOUNCERS_PREFIX}.putUint64(epoch_number);
+    if (storage_->contains(announcers_key)) {
+      OUTCOME_TRY(encoded_announcers, storage_->get(announcers_key));
+      OUTCOME_TRY(announcers,
+                  scale::decode<std::vector<primitives::BlockHash>>(
+                      encoded_announcers));
+      for (const auto &announced_by : announcers) {
+        OUTCOME_TRY(info,
+                    readEpochInfo(common::Buffer{EPOCH_PREFIX}
+                                      .putUint64(epoch_number)
+                                      .put(announced_by)));
+        announced.emplace(announced_by, std::move(info));
+      }
+    } else {
+      // the epochs not announced by any block, such as the genesis ones
+      auto key = common::Buffer{EPOCH_PREFIX}.putUint64(epoch_number);
+      if (storage_->contains(key)) {
+        OUTCOME_TRY(info, readEpochInfo(key));
+        announced.emplace(primitives::BlockHash{}, std::move(info));
+      }
+    }
+
+    if (cache_.size() >= kCachedEpochs) {
+      cache_.erase(cache_.begin());
+    }
+    return std::cref(
+        cache_.emplace(epoch_number, std::move(announced)).first->second);
+  }
+
+  outcome::result<std::shared_ptr<const EpochInfo>>
+  EpochStorageImpl::readEpochInfo(const common::Buffer &key) const {
+    OUTCOME_TRY(encoded_ed, storage_->get(key));
+    OUTCOME_TRY(descriptor, scale::decode<NextEpochDescriptor>(encoded_ed));
+    auto thresholds = calculateThresholds(configuration_->leadership_rate,
+                                          descriptor.authorities);
+    return std::make_shared<const EpochInfo>(
+        EpochInfo{std::move(descriptor), std::move(thresholds)});
+  }
 }  // namespace kagome::consensus
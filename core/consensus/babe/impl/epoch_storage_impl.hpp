@@ -8,35 +8,72 @@
 
 #include "consensus/babe/epoch_storage.hpp"
 
+#include <map>
+#include <mutex>
 #include <unordered_map>
+#include "blockchain/block_tree.hpp"
+#include "primitives/babe_configuration.hpp"
 #include "storage/buffer_map_types.hpp"
 
 namespace kagome::consensus {
 
-  enum class EpochStorageError { EPOCH_DOES_NOT_EXIST = 1 };
-
   /**
    * Implementation of epoch storage, which stores and returns epoch descriptors
-   * based on their numbers. Epoch descriptors are stored on the disk
+   * based on their numbers. Epoch descriptors are stored on the disk, each of
+   * the announced ones along with the hash of the block announcing it, and
+   * the one of the chain of a block is found in the block tree. The last
+   * kCachedEpochs of the read ones are kept decoded in memory along with the
+   * thresholds of their authorities until a descriptor for them is added
    */
   class EpochStorageImpl : public EpochStorage {
    public:
+    /// number of the epochs kept in memory
+    static constexpr size_t kCachedEpochs = 4;
+
     ~EpochStorageImpl() override = default;
 
-    explicit EpochStorageImpl(std::shared_ptr<storage::BufferStorage> storage);
+    EpochStorageImpl(
+        std::shared_ptr<storage::BufferStorage> storage,
+        std::shared_ptr<primitives::BabeConfiguration> configuration,
+        std::shared_ptr<blockchain::BlockTree> block_tree);
 
     outcome::result<void> addEpochDescriptor(
         EpochIndex epoch_number,
         const NextEpochDescriptor &epoch_descriptor) override;
 
+    outcome::result<void> addEpochDescriptor(
+        EpochIndex epoch_number,
+        const primitives::BlockHash &announced_by,
+        const NextEpochDescriptor &epoch_descriptor) override;
+
     outcome::result<NextEpochDescriptor> getEpochDescriptor(
         EpochIndex epoch_number) const override;
 
+    outcome::result<std::shared_ptr<const EpochInfo>> getEpochInfo(
+        EpochIndex epoch_number,
+        const primitives::BlockHash &block_hash) const override;
+
    private:
+    /// the epochs of an epoch number, by the hashes of the blocks announcing
+    /// them, zero hash for the one added without the announcing block
+    using Announced =
+        std::map<primitives::BlockHash, std::shared_ptr<const EpochInfo>>;
+
+    /// @return the announced epochs of \arg epoch_number, read from the
+    /// storage unless they are cached, called with cache_mutex_ locked
+    outcome::result<std::reference_wrapper<const Announced>> getAnnounced(
+        EpochIndex epoch_number) const;
+
+    outcome::result<std::shared_ptr<const EpochInfo>> readEpochInfo(
+        const common::Buffer &key) const;
+
     std::shared_ptr<storage::BufferStorage> storage_;
+    std::shared_ptr<primitives::BabeConfiguration> configuration_;
+    std::shared_ptr<blockchain::BlockTree> block_tree_;
+
+    mutable std::mutex cache_mutex_;
+    mutable std::map<EpochIndex, Announced> cache_;
   };
 }  // namespace kagome::consensus
 
-OUTCOME_HPP_DECLARE_ERROR(kagome::consensus, EpochStorageError);
-
 #endif  // KAGOME_EPOCH_STORAGE_DUMB_HPP
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/orphan_pool.hpp"
+
+#include <algorithm>
+
+namespace kagome::consensus {
+
+  OrphanPool::OrphanPool(size_t max_orphans) : max_orphans_{max_orphans} {}
+
+  bool OrphanPool::add(Orphan orphan) {
+    if (orphans_.count(orphan.hash) != 0) {
+      return false;
+    }
+    if (orphans_.size() >= max_orphans_) {
+      orphans_.clear();
+      children_.clear();
+      requested_.clear();
+    }
+    children_.emplace(orphan.header.parent_hash, orphan.hash);
+    auto hash = orphan.hash;
+    orphans_.emplace(hash, std::move(orphan));
+    return true;
+  }
+
+  bool OrphanPool::contains(const primitives::BlockHash &hash) const {
+    return orphans_.count(hash) != 0;
+  }
+
+  bool OrphanPool::hasChildren(const primitives::BlockHash &parent_hash) const {
+    return children_.count(parent_hash) != 0;
+  }
+
+  primitives::BlockHash OrphanPool::missingAncestor(
+      const primitives::BlockHash &hash) const {
+    auto ancestor = hash;
+    // the hashes of the headers make no cycle, so the walk ends
+    for (auto it = orphans_.find(ancestor); it != orphans_.end();
+         it = orphans_.find(ancestor)) {
+      ancestor = it->second.header.parent_hash;
+    }
+    return ancestor;
+  }
+
+  bool OrphanPool::shouldRequest(const primitives::BlockHash &missing) {
+    auto now = Clock::now();
+    auto [it, inserted] = requested_.emplace(missing, now);
+    if (not inserted and now - it->second < kRetryInterval) {
+      return false;
+    }
+    it->second = now;
+    return true;
+  }
+
+  std::vector<OrphanPool::Orphan> OrphanPool::takeChildren(
+      const primitives::BlockHash &parent_hash) {
+    requested_.erase(parent_hash);
+    std::vector<Orphan> children;
+    auto [begin, end] = children_.equal_range(parent_hash);
+    for (auto it = begin; it != end; ++it) {
+      auto node = orphans_.extract(it->second);
+      children.push_back(std::move(node.mapped()));
+    }
+    children_.erase(parent_hash);
+    return children;
+  }
+
+  boost::optional<OrphanPool::Orphan> OrphanPool::takeBranch(
+      const primitives::BlockHash &hash) {
+    boost::optional<Orphan> last;
+    auto parent_hash = hash;
+    while (true) {
+      auto [begin, end] = children_.equal_range(parent_hash);
+      auto child = std::find_if(begin, end, [&](const auto &entry) {
+        return not orphans_.at(entry.second).body;
+      });
+      if (child == end) {
+        return last;
+      }
+      auto node = orphans_.extract(child->second);
+      children_.erase(child);
+      last = std::move(node.mapped());
+      parent_hash = last->hash;
+    }
+  }
+
+  size_t OrphanPool::size() const {
+    return orphans_.size();
+  }
+
+}  // namespace kagome::consensus
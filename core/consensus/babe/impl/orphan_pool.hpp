@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_ORPHAN_POOL_HPP
+#define KAGOME_CORE_CONSENSUS_BABE_IMPL_ORPHAN_POOL_HPP
+
+#include <chrono>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "primitives/block.hpp"
+
+namespace kagome::consensus {
+
+  /**
+   * Announced blocks, the parents of which are not imported yet, keyed by
+   * the hashes of their parents, so that they wait for the parents and are
+   * imported after them, and only the blocks missing below them are
+   * requested. A block waits with its body, if it is built from the
+   * transaction pool, or with its header only otherwise. Not thread-safe
+   */
+  class OrphanPool {
+   public:
+    struct Orphan {
+      primitives::BlockHash hash;
+      primitives::BlockHeader header;
+      boost::optional<primitives::BlockBody> body;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    /// number of the orphans, over which all of them are forgotten, as some
+    /// of them may never get their parents
+    static constexpr size_t kMaxOrphans = 512;
+
+    /// time, after which a missing block is requested again, as a failed
+    /// request is not reported
+    static constexpr Clock::duration kRetryInterval = std::chrono::seconds(10);
+
+    explicit OrphanPool(size_t max_orphans = kMaxOrphans);
+
+    /// Adds \arg orphan, @return false if it is in the pool already
+    bool add(Orphan orphan);
+
+    bool contains(const primitives::BlockHash &hash) const;
+
+    bool hasChildren(const primitives::BlockHash &parent_hash) const;
+
+    /**
+     * @return hash of the block missing below the orphan of \arg hash, i.e.
+     * the parent of its earliest ancestor in the pool, or of itself
+     */
+    primitives::BlockHash missingAncestor(
+        const primitives::BlockHash &hash) const;
+
+    /**
+     * @return true if \arg missing block is not requested in the last
+     * kRetryInterval, it is counted as requested then
+     */
+    bool shouldRequest(const primitives::BlockHash &missing);
+
+    /// Removes and @return the orphans, which are the children of \arg
+    /// parent_hash
+    std::vector<Orphan> takeChildren(const primitives::BlockHash &parent_hash);
+
+    /**
+     * Removes the descendants of the orphan of \arg hash having no bodies,
+     * which are on one branch, so that they are requested at once
+     * @return the last of them, none if there is none
+     */
+    boost::optional<Orphan> takeBranch(const primitives::BlockHash &hash);
+
+    size_t size() const;
+
+   private:
+    size_t max_orphans_;
+    std::unordered_map<primitives::BlockHash, Orphan> orphans_;
+    // hashes of the orphans by the hashes of their parents
+    std::unordered_multimap<primitives::BlockHash, primitives::BlockHash>
+        children_;
+    // times the missing blocks were requested at
+    std::unordered_map<primitives::BlockHash, Clock::time_point> requested_;
+  };
+
+}  // namespace kagome::consensus
+
+#endif  // KAGOME_CORE_CONSENSUS_BABE_IMPL_ORPHAN_POOL_HPP
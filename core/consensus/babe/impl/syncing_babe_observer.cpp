@@ -13,7 +13,7 @@ namespace kagome::consensus {
 
   void SyncingBabeObserver::onBlockAnnounce(
       const network::BlockAnnounce &announce) {
-    block_executor_->processNextBlock(announce.header, [](auto &) {});
+    block_executor_->processNextBlock(announce, [](auto &) {});
   }
 
 }  // namespace kagome::consensus
@@ -10,24 +10,48 @@
 
 namespace kagome::consensus {
 
+  namespace {
+    double totalWeight(const std::vector<primitives::Authority> &authorities) {
+      using boost::adaptors::transformed;
+      return boost::accumulate(authorities | transformed([](auto &authority) {
+                                 return authority.weight;
+                               }),
+                               0.);
+    }
+
+    /// @param theta share of the weight of the authority in the total one
+    Threshold thresholdOfShare(double c, double theta) {
+      using namespace boost::multiprecision;  // NOLINT
+      cpp_rational p_rat(1. - pow(1. - c, theta));
+      static const auto a = (uint256_t{1} << 128);
+      return Threshold{a * numerator(p_rat) / denominator(p_rat)};
+    }
+  }  // namespace
+
   Threshold calculateThreshold(
       const std::pair<uint64_t, uint64_t> &c_pair,
       const std::vector<primitives::Authority> &authorities,
       primitives::AuthorityIndex authority_index) {
     double c = double(c_pair.first) / c_pair.second;
 
-    using boost::adaptors::transformed;
-    double theta =
-        double(authorities[authority_index].weight)
-        / boost::accumulate(authorities | transformed([](auto &authority) {
-                              return authority.weight;
-                            }),
-                            0.);
-
-    using namespace boost::multiprecision;  // NOLINT
-    cpp_rational p_rat(1. - pow(1. - c, theta));
-    static const auto a = (uint256_t{1} << 128);
-    return Threshold{a * numerator(p_rat) / denominator(p_rat)};
+    return thresholdOfShare(c,
+                            double(authorities[authority_index].weight)
+                                / totalWeight(authorities));
+  }
+
+  std::vector<Threshold> calculateThresholds(
+      const std::pair<uint64_t, uint64_t> &c_pair,
+      const std::vector<primitives::Authority> &authorities) {
+    double c = double(c_pair.first) / c_pair.second;
+    auto total_weight = totalWeight(authorities);
+
+    std::vector<Threshold> thresholds;
+    thresholds.reserve(authorities.size());
+    for (const auto &authority : authorities) {
+      thresholds.push_back(
+          thresholdOfShare(c, double(authority.weight) / total_weight));
+    }
+    return thresholds;
   }
 
 }  // namespace kagome::consensus
@@ -20,6 +20,12 @@ namespace kagome::consensus {
       const std::vector<primitives::Authority> &authorities,
       primitives::AuthorityIndex authority_index);
 
+  /// Calculates the thresholds of all of \arg authorities at once, the same
+  /// as calculateThreshold does for each of them
+  std::vector<Threshold> calculateThresholds(
+      const std::pair<uint64_t, uint64_t> &c_pair,
+      const std::vector<primitives::Authority> &authorities);
+
 }  // namespace kagome::consensus
 
 #endif  // KAGOME_CORE_CONSENSUS_BABE_IMPL_THRESHOLD_UTIL_HPP
@@ -0,0 +1,446 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/warp_sync.hpp"
+
+#include <random>
+#include <unordered_map>
+
+#include <boost/assert.hpp>
+
+#include "consensus/grandpa/completed_round.hpp"
+#include "consensus/grandpa/impl/justification_verifier.hpp"
+#include "scale/scale.hpp"
+#include "storage/predefined_keys.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus, WarpSyncError, e) {
+  using E = kagome::consensus::WarpSyncError;
+  switch (e) {
+    case E::NO_PEERS:
+      return "There are no peers to warp sync with";
+    case E::UNCHAINED_HEADERS:
+      return "Received headers are not chained to the previous ones";
+    case E::NO_JUSTIFIED_BLOCK:
+      return "No block with a valid justification is received";
+    case E::MISSING_STATE_NODE:
+      return "Peer has none of the requested state nodes";
+    case E::INVALID_STATE_NODE:
+      return "Received state node does not match its hash";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::consensus {
+  namespace {
+    primitives::BlocksRequestId nextRequestId() {
+      static std::random_device rd{};
+      static std::uniform_int_distribution<primitives::BlocksRequestId> dis{};
+      return dis(rd);
+    }
+  }  // namespace
+
+  struct WarpSync::Download {
+    struct Justified {
+      primitives::BlockHeader header;
+      primitives::BlockHash hash;
+      primitives::Justification justification;
+      grandpa::GrandpaJustification grandpa_justification;
+    };
+
+    primitives::BlockHash head;
+    SyncResultHandler handler;
+    std::shared_ptr<grandpa::JustificationVerifier> verifier;
+
+    // index of the peer the download goes on with
+    size_t peer = 0;
+    // number of the peers failed one after another
+    size_t failures = 0;
+
+    // the last finalized block of the node before the sync
+    primitives::BlockInfo start;
+    // the last received header, the next ones are requested after it
+    primitives::BlockInfo last;
+    // the latest block with a verified justification
+    boost::optional<Justified> synced;
+    // the blocks with justifications received after the synced one
+    std::vector<Justified> candidates;
+    // numbers of the blocks received after the synced one, to tell whether
+    // the precommits of a justification are for the descendants of its block
+    std::unordered_map<primitives::BlockHash, primitives::BlockNumber> chain;
+
+    // keys of the state nodes to be downloaded; it is a stack, so that the
+    // state is walked depth first and the keys of a few levels are kept only
+    std::vector<common::Buffer> nodes;
+    size_t nodes_stored = 0;
+  };
+
+  WarpSync::WarpSync(
+      std::shared_ptr<blockchain::BlockTree> block_tree,
+      std::shared_ptr<blockchain::BlockStorage> block_storage,
+      std::shared_ptr<storage::BufferStorage> storage,
+      std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes,
+      std::shared_ptr<storage::trie::Codec> codec,
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<crypto::ED25519Provider> ed_provider,
+      std::shared_ptr<network::SyncClientsSet> sync_clients)
+      : block_tree_{std::move(block_tree)},
+        block_storage_{std::move(block_storage)},
+        storage_{std::move(storage)},
+        trie_nodes_{std::move(trie_nodes)},
+        codec_{std::move(codec)},
+        hasher_{std::move(hasher)},
+        ed_provider_{std::move(ed_provider)},
+        sync_clients_{std::move(sync_clients)},
+        logger_{common::createLogger("WarpSync")} {
+    BOOST_ASSERT(block_tree_ != nullptr);
+    BOOST_ASSERT(block_storage_ != nullptr);
+    BOOST_ASSERT(storage_ != nullptr);
+    BOOST_ASSERT(trie_nodes_ != nullptr);
+    BOOST_ASSERT(codec_ != nullptr);
+    BOOST_ASSERT(hasher_ != nullptr);
+    BOOST_ASSERT(ed_provider_ != nullptr);
+    BOOST_ASSERT(sync_clients_ != nullptr);
+  }
+
+  void WarpSync::sync(const primitives::BlockHash &head,
+                      SyncResultHandler handler) {
+    if (sync_clients_->clients.empty()) {
+      return handler(WarpSyncError::NO_PEERS);
+    }
+    auto voters_res = getVoters();
+    if (not voters_res) {
+      return handler(voters_res.error());
+    }
+    auto finalized_hash_res = block_storage_->getLastFinalizedBlockHash();
+    if (not finalized_hash_res) {
+      return handler(finalized_hash_res.error());
+    }
+    const auto &finalized_hash = finalized_hash_res.value();
+    auto finalized_header_res = block_storage_->getBlockHeader(finalized_hash);
+    if (not finalized_header_res) {
+      return handler(finalized_header_res.error());
+    }
+
+    auto download = std::make_shared<Download>();
+    download->head = head;
+    download->handler = std::move(handler);
+    download->verifier = std::make_shared<grandpa::JustificationVerifier>(
+        std::move(voters_res.value()), ed_provider_);
+    download->start = {finalized_header_res.value().number, finalized_hash};
+    download->last = download->start;
+    logger_->info("Warp sync from block #{} to block {}",
+                  download->start.block_number,
+                  head.toHex());
+    requestHeaders(download);
+  }
+
+  outcome::result<std::shared_ptr<grandpa::VoterSet>> WarpSync::getVoters()
+      const {
+    // the voters are the same as the ones of the GRANDPA launcher
+    OUTCOME_TRY(voters_encoded, storage_->get(storage::kAuthoritySetKey));
+    OUTCOME_TRY(voters, scale::decode<grandpa::VoterSet>(voters_encoded));
+    return std::make_shared<grandpa::VoterSet>(std::move(voters));
+  }
+
+  void WarpSync::requestHeaders(const std::shared_ptr<Download> &download) {
+    network::BlocksRequest request{
+        nextRequestId(),
+        network::BlockAttributes{network::BlockAttributesBits::HEADER
+                                 | network::BlockAttributesBits::JUSTIFICATION},
+        download->last.block_hash,
+        download->head,
+        network::Direction::DESCENDING,
+        boost::none};
+    sync_clients_->clients[download->peer]->requestBlocks(
+        request,
+        [self_wp{weak_from_this()}, download](auto &&response_res) {
+          if (auto self = self_wp.lock()) {
+            self->onHeaders(download,
+                            std::forward<decltype(response_res)>(response_res));
+          }
+        });
+  }
+
+  void WarpSync::onHeaders(
+      const std::shared_ptr<Download> &download,
+      outcome::result<network::BlocksResponse> response_res) {
+    if (not response_res) {
+      if (switchPeer(*download, response_res.error())) {
+        requestHeaders(download);
+      }
+      return;
+    }
+    auto appended_res = appendHeaders(*download, response_res.value());
+    if (not appended_res) {
+      if (switchPeer(*download, appended_res.error())) {
+        requestHeaders(download);
+      }
+      return;
+    }
+    if (auto res = verifyJustifications(*download); not res) {
+      if (switchPeer(*download, res.error())) {
+        requestHeaders(download);
+      }
+      return;
+    }
+    download->failures = 0;
+    if (appended_res.value() != 0
+        and download->last.block_hash != download->head) {
+      requestHeaders(download);
+      return;
+    }
+
+    // the peer has no headers after the last one
+    if (not download->synced) {
+      return download->handler(WarpSyncError::NO_JUSTIFIED_BLOCK);
+    }
+    const auto &synced = download->synced.value();
+    logger_->info(
+        "Warp sync verified the finality of block #{}, downloading its state",
+        synced.header.number);
+    download->nodes.emplace_back(synced.header.state_root);
+    requestNodes(download);
+  }
+
+  outcome::result<size_t> WarpSync::appendHeaders(
+      Download &download, const network::BlocksResponse &response) const {
+    size_t appended = 0;
+    for (const auto &block_data : response.blocks) {
+      // the block the headers are requested from comes first
+      if (block_data.hash == download.last.block_hash) {
+        continue;
+      }
+      if (not block_data.header) {
+        return WarpSyncError::UNCHAINED_HEADERS;
+      }
+      const auto &header = block_data.header.value();
+      auto hash = hasher_->blake2b_256(scale::encode(header).value());
+      if (hash != block_data.hash
+          or header.parent_hash != download.last.block_hash
+          or header.number != download.last.block_number + 1) {
+        return WarpSyncError::UNCHAINED_HEADERS;
+      }
+      OUTCOME_TRY(block_storage_->putBlockHeader(header));
+      download.chain.emplace(hash, header.number);
+      download.last = {header.number, hash};
+      appended++;
+
+      if (block_data.justification) {
+        const auto &justification = block_data.justification.value();
+        OUTCOME_TRY(stored,
+                    scale::decode<grandpa::StoredJustification>(
+                        justification.data));
+        // the precommits can not be verified without their round, which the
+        // justifications stored by the older nodes lack
+        if (not stored.has_round) {
+          continue;
+        }
+        download.candidates.push_back(
+            {header, hash, justification, std::move(stored.justification)});
+      }
+    }
+    return appended;
+  }
+
+  outcome::result<void> WarpSync::verifyJustifications(
+      Download &download) const {
+    auto &candidates = download.candidates;
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+      const primitives::BlockInfo block{it->header.number, it->hash};
+      auto res = download.verifier->verify(
+          it->grandpa_justification,
+          block,
+          [&download, &block](const primitives::BlockInfo &target) {
+            auto found = download.chain.find(target.block_hash);
+            return found != download.chain.end()
+                   and found->second == target.block_number
+                   and target.block_number > block.block_number;
+          });
+      if (res == outcome::failure(
+              grandpa::JustificationError::NOT_ENOUGH_WEIGHT)) {
+        continue;
+      }
+      OUTCOME_TRY(res);
+
+      // the older justifications are not needed anymore, as well as the
+      // blocks before the synced one
+      download.synced = std::move(*it);
+      candidates.erase(candidates.begin(), it.base());
+      for (auto b = download.chain.begin(); b != download.chain.end();) {
+        if (b->second <= block.block_number) {
+          b = download.chain.erase(b);
+        } else {
+          ++b;
+        }
+      }
+      logger_->debug("Warp sync verified the justification of block #{}",
+                     block.block_number);
+      break;
+    }
+    return outcome::success();
+  }
+
+  void WarpSync::requestNodes(const std::shared_ptr<Download> &download) {
+    network::StateRequest request;
+    while (not download->nodes.empty()
+           and request.keys.size() < kNodesPerRequest) {
+      auto key = std::move(download->nodes.back());
+      download->nodes.pop_back();
+      // the nodes in the storage already are not downloaded again, but their
+      // descendants are checked, as a download could stop in the middle of a
+      // subtree. A node shorter than a hash is its own key
+      outcome::result<void> res = outcome::success();
+      if (key.size() < common::Hash256::size()) {
+        res = trie_nodes_->put(key, key);
+        if (res) {
+          res = queueChildren(*download, key);
+        }
+      } else if (auto node_res = trie_nodes_->get(key); node_res) {
+        res = queueChildren(*download, node_res.value());
+      } else {
+        request.keys.push_back(std::move(key));
+      }
+      if (not res) {
+        return download->handler(res.error());
+      }
+    }
+
+    if (request.keys.empty()) {
+      if (auto res = finish(*download); not res) {
+        return download->handler(res.error());
+      }
+      const auto &synced = download->synced.value();
+      logger_->info("Warp synced to block #{} with {} state nodes downloaded",
+                    synced.header.number,
+                    download->nodes_stored);
+      return download->handler(
+          primitives::BlockInfo{synced.header.number, synced.hash});
+    }
+
+    auto keys = request.keys;
+    sync_clients_->clients[download->peer]->requestState(
+        request,
+        [self_wp{weak_from_this()}, download, keys{std::move(keys)}](
+            auto &&response_res) mutable {
+          if (auto self = self_wp.lock()) {
+            self->onNodes(download,
+                          std::move(keys),
+                          std::forward<decltype(response_res)>(response_res));
+          }
+        });
+  }
+
+  void WarpSync::onNodes(
+      const std::shared_ptr<Download> &download,
+      std::vector<common::Buffer> keys,
+      outcome::result<network::StateResponse> response_res) {
+    std::error_code error;
+    size_t stored = 0;
+    if (not response_res) {
+      error = response_res.error();
+    } else if (response_res.value().nodes.empty()) {
+      error = WarpSyncError::MISSING_STATE_NODE;
+    } else {
+      const auto &nodes = response_res.value().nodes;
+      auto batch = trie_nodes_->batch();
+      for (; stored < nodes.size() and stored < keys.size(); stored++) {
+        const auto &node = nodes[stored];
+        // only the nodes of at least a hash size are requested, which are
+        // stored by their hashes
+        if (common::Buffer{codec_->hash256(node)} != keys[stored]) {
+          error = WarpSyncError::INVALID_STATE_NODE;
+          break;
+        }
+        if (auto res = queueChildren(*download, node); not res) {
+          error = res.error();
+          break;
+        }
+        if (auto res = batch->put(keys[stored], node); not res) {
+          return download->handler(res.error());
+        }
+      }
+      if (auto res = batch->commit(); not res) {
+        return download->handler(res.error());
+      }
+      download->nodes_stored += stored;
+    }
+
+    // the keys not answered are requested again
+    for (auto i = keys.size(); i > stored; i--) {
+      download->nodes.push_back(std::move(keys[i - 1]));
+    }
+    if (error) {
+      if (not switchPeer(*download, error)) {
+        return;
+      }
+    } else {
+      download->failures = 0;
+      logger_->debug("Warp sync stored {} state nodes, {} are queued",
+                     download->nodes_stored,
+                     download->nodes.size());
+    }
+    requestNodes(download);
+  }
+
+  outcome::result<void> WarpSync::queueChildren(
+      Download &download, const common::Buffer &encoding) const {
+    OUTCOME_TRY(node, codec_->decodeNode(encoding));
+    auto branch = std::dynamic_pointer_cast<storage::trie::BranchNode>(node);
+    if (branch == nullptr) {
+      return outcome::success();
+    }
+    // stored children of a decoded branch are dummy nodes keeping their
+    // merkle values, which are the storage keys of the children, the short
+    // ones are embedded in the branch and need no download
+    for (auto &child : branch->children) {
+      if (child->isDummy()) {
+        download.nodes.push_back(
+            static_cast<const storage::trie::DummyNode &>(*child).db_key);
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> WarpSync::finish(const Download &download) {
+    const auto &synced = download.synced.value();
+    OUTCOME_TRY(block_storage_->putJustification(
+        synced.justification, synced.hash, synced.header.number));
+    OUTCOME_TRY(block_storage_->setLastFinalizedBlockHash(synced.hash));
+
+    // GRANDPA goes on from the round the synced block is finalized in
+    const primitives::BlockInfo block{synced.header.number, synced.hash};
+    grandpa::CompletedRound round;
+    round.round_number = synced.grandpa_justification.round_number;
+    round.state.prevote_ghost = grandpa::Prevote{block.block_number,
+                                                 block.block_hash};
+    round.state.estimate = block;
+    round.state.finalized = block;
+    OUTCOME_TRY(storage_->put(storage::kSetStateKey,
+                              common::Buffer{scale::encode(round).value()}));
+
+    return block_tree_->resetToLastFinalized();
+  }
+
+  bool WarpSync::switchPeer(Download &download, std::error_code error) const {
+    logger_->warn("Warp sync with a peer failed: {}", error.message());
+    const auto &clients = sync_clients_->clients;
+    if (++download.failures >= clients.size()) {
+      download.handler(error);
+      return false;
+    }
+    download.peer = (download.peer + 1) % clients.size();
+    // the headers after the synced block are requested again, as the failed
+    // peer might send a fake chain
+    download.last = download.start;
+    if (download.synced) {
+      download.last = {download.synced->header.number, download.synced->hash};
+    }
+    download.candidates.clear();
+    download.chain.clear();
+    return true;
+  }
+
+}  // namespace kagome::consensus
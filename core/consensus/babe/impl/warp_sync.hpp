@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_BABE_IMPL_WARP_SYNC_HPP
+#define KAGOME_CORE_CONSENSUS_BABE_IMPL_WARP_SYNC_HPP
+
+#include <functional>
+
+#include "blockchain/block_storage.hpp"
+#include "blockchain/block_tree.hpp"
+#include "common/logger.hpp"
+#include "consensus/grandpa/voter_set.hpp"
+#include "crypto/ed25519_provider.hpp"
+#include "crypto/hasher.hpp"
+#include "network/types/sync_clients_set.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::consensus {
+
+  enum class WarpSyncError {
+    NO_PEERS = 1,
+    UNCHAINED_HEADERS,
+    NO_JUSTIFIED_BLOCK,
+    MISSING_STATE_NODE,
+    INVALID_STATE_NODE
+  };
+
+  /**
+   * Syncs a fresh node without executing the blocks from the genesis: the
+   * headers are downloaded along with their justifications, the finality of
+   * the latest block with a valid justification is verified, and the state
+   * of that block is downloaded node by node and verified against its state
+   * root. The block then becomes the last finalized one, and the blocks after
+   * it are imported as usual
+   */
+  class WarpSync : public std::enable_shared_from_this<WarpSync> {
+   public:
+    /// how much state nodes are requested at once
+    static constexpr size_t kNodesPerRequest = 1024;
+
+    using SyncResultHandler =
+        std::function<void(outcome::result<primitives::BlockInfo>)>;
+
+    /**
+     * @param storage keeps the voters and the last completed round of
+     * GRANDPA
+     * @param trie_nodes storage the nodes of the downloaded state are written
+     * to
+     */
+    WarpSync(std::shared_ptr<blockchain::BlockTree> block_tree,
+             std::shared_ptr<blockchain::BlockStorage> block_storage,
+             std::shared_ptr<storage::BufferStorage> storage,
+             std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes,
+             std::shared_ptr<storage::trie::Codec> codec,
+             std::shared_ptr<crypto::Hasher> hasher,
+             std::shared_ptr<crypto::ED25519Provider> ed_provider,
+             std::shared_ptr<network::SyncClientsSet> sync_clients);
+
+    /**
+     * Syncs to the latest block finalized before \arg head
+     * @param handler is called with the block the node is synced to
+     */
+    void sync(const primitives::BlockHash &head, SyncResultHandler handler);
+
+   private:
+    struct Download;
+
+    outcome::result<std::shared_ptr<grandpa::VoterSet>> getVoters() const;
+
+    void requestHeaders(const std::shared_ptr<Download> &download);
+
+    void onHeaders(const std::shared_ptr<Download> &download,
+                   outcome::result<network::BlocksResponse> response_res);
+
+    /**
+     * Stores the headers of \arg response chained to the last received one
+     * @return number of the stored headers
+     */
+    outcome::result<size_t> appendHeaders(
+        Download &download, const network::BlocksResponse &response) const;
+
+    /**
+     * Verifies the justifications received since the last verified one,
+     * starting from the latest one. The ones without enough precommits are
+     * kept, as the precommits may be for the blocks not received yet
+     */
+    outcome::result<void> verifyJustifications(Download &download) const;
+
+    void requestNodes(const std::shared_ptr<Download> &download);
+
+    void onNodes(const std::shared_ptr<Download> &download,
+                 std::vector<common::Buffer> keys,
+                 outcome::result<network::StateResponse> response_res);
+
+    /**
+     * Queues the keys of the children of the state node \arg encoding
+     */
+    outcome::result<void> queueChildren(Download &download,
+                                        const common::Buffer &encoding) const;
+
+    /**
+     * Moves the finality to the synced block, so that the blocks after it
+     * are imported as usual
+     */
+    outcome::result<void> finish(const Download &download);
+
+    /**
+     * Switches to the next peer after \arg error of the current one, the
+     * download fails if all of the peers failed one after another
+     * @return true if there is a peer to continue with
+     */
+    bool switchPeer(Download &download, std::error_code error) const;
+
+    std::shared_ptr<blockchain::BlockTree> block_tree_;
+    std::shared_ptr<blockchain::BlockStorage> block_storage_;
+    std::shared_ptr<storage::BufferStorage> storage_;
+    std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes_;
+    std::shared_ptr<storage::trie::Codec> codec_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<crypto::ED25519Provider> ed_provider_;
+    std::shared_ptr<network::SyncClientsSet> sync_clients_;
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::consensus
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::consensus, WarpSyncError);
+
+#endif  // KAGOME_CORE_CONSENSUS_BABE_IMPL_WARP_SYNC_HPP
@@ -0,0 +1,191 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/consensus_metrics.hpp"
+
+namespace kagome::consensus {
+
+  void ConsensusMetrics::recordSlot(Clock::duration drift) {
+    std::lock_guard lock{mutex_};
+    slots_.slots++;
+    slots_.drift.add(drift);
+  }
+
+  void ConsensusMetrics::recordSkippedSlot() {
+    std::lock_guard lock{mutex_};
+    slots_.skipped++;
+  }
+
+  void ConsensusMetrics::recordSlotTimer(Clock::duration lateness) {
+    std::lock_guard lock{mutex_};
+    slots_.timer.add(lateness);
+  }
+
+  void ConsensusMetrics::recordProposal(Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    slots_.proposal.add(duration);
+  }
+
+  void ConsensusMetrics::recordAnnounce(Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    slots_.announce.add(duration);
+  }
+
+  void ConsensusMetrics::recordImported(primitives::BlockNumber number,
+                                        Clock::time_point at) {
+    std::lock_guard lock{mutex_};
+    ++imported_blocks_;
+    imported_.emplace(number, at);
+    if (imported_.size() > kMaxUnfinalized) {
+      imported_.erase(imported_.begin());
+    }
+  }
+
+  void ConsensusMetrics::recordFinalized(primitives::BlockNumber number,
+                                         Clock::time_point at) {
+    std::lock_guard lock{mutex_};
+    auto end = imported_.upper_bound(number);
+    for (auto it = imported_.begin(); it != end; ++it) {
+      finality_lag_.add(at - it->second);
+    }
+    imported_.erase(imported_.begin(), end);
+  }
+
+  void ConsensusMetrics::recordRound(Clock::duration duration,
+                                     bool completed) {
+    std::lock_guard lock{mutex_};
+    (completed ? rounds_.completed : rounds_.failed)++;
+    rounds_.duration.add(duration);
+  }
+
+  void ConsensusMetrics::recordPrevoted(Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    rounds_.prevote.add(duration);
+  }
+
+  void ConsensusMetrics::recordPrecommitted(Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    rounds_.precommit.add(duration);
+  }
+
+  void ConsensusMetrics::recordRoundFinalized(Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    rounds_.finalize.add(duration);
+  }
+
+  void ConsensusMetrics::recordPrevote() {
+    std::lock_guard lock{mutex_};
+    rounds_.prevotes++;
+  }
+
+  void ConsensusMetrics::recordPrecommit() {
+    std::lock_guard lock{mutex_};
+    rounds_.precommits++;
+  }
+
+  void ConsensusMetrics::recordEquivocation() {
+    std::lock_guard lock{mutex_};
+    rounds_.equivocations++;
+  }
+
+  ConsensusMetrics::Report ConsensusMetrics::report() const {
+    Report report;
+    std::lock_guard lock{mutex_};
+    report.slots = SlotStats{slots_.slots,
+                             slots_.skipped,
+                             slots_.drift.stats(),
+                             slots_.timer.stats(),
+                             slots_.proposal.stats(),
+                             slots_.announce.stats()};
+    report.rounds = RoundStats{rounds_.completed,
+                               rounds_.failed,
+                               rounds_.prevotes,
+                               rounds_.precommits,
+                               rounds_.equivocations,
+                               rounds_.duration.stats(),
+                               rounds_.prevote.stats(),
+                               rounds_.precommit.stats(),
+                               rounds_.finalize.stats()};
+    report.imported_blocks = imported_blocks_;
+    report.finality_lag = finality_lag_.stats();
+    return report;
+  }
+
+  void ConsensusMetrics::collect(
+      common::MetricsRegistry::Writer &writer) const {
+    using Type = common::MetricsRegistry::Type;
+    auto report = this->report();
+    auto counter = [&](const char *name, const char *help, uint64_t value) {
+      writer.family(name, Type::COUNTER, help);
+      writer.sample(name, {}, value);
+    };
+    auto durations = [&](const char *name,
+                         const char *help,
+                         const DurationStats &stats) {
+      writer.family(name, Type::SUMMARY, help);
+      writer.durations(name, {}, stats);
+    };
+    auto &slots = report.slots;
+    counter("kagome_babe_slots_total", "BABE slots", slots.slots);
+    counter("kagome_babe_skipped_slots_total",
+            "BABE slots skipped as the node was too late for them",
+            slots.skipped);
+    durations("kagome_babe_slot_drift_seconds",
+              "How late the BABE slots start",
+              slots.drift);
+    durations("kagome_babe_slot_timer_lateness_seconds",
+              "How late the BABE slot timer fires past the end of the slot",
+              slots.timer);
+    durations("kagome_babe_proposal_seconds",
+              "Time the blocks take to be proposed",
+              slots.proposal);
+    durations("kagome_babe_announce_seconds",
+              "Time from the seal of a block to its broadcast",
+              slots.announce);
+    auto &rounds = report.rounds;
+    counter("kagome_grandpa_completed_rounds_total",
+            "GRANDPA rounds completed",
+            rounds.completed);
+    counter("kagome_grandpa_failed_rounds_total",
+            "GRANDPA rounds failed",
+            rounds.failed);
+    counter("kagome_grandpa_prevotes_total",
+            "GRANDPA prevotes received",
+            rounds.prevotes);
+    counter("kagome_grandpa_precommits_total",
+            "GRANDPA precommits received",
+            rounds.precommits);
+    counter("kagome_grandpa_equivocations_total",
+            "GRANDPA equivocations",
+            rounds.equivocations);
+    durations("kagome_grandpa_round_seconds",
+              "Time the GRANDPA rounds take",
+              rounds.duration);
+    durations("kagome_grandpa_prevote_seconds",
+              "Time from the start of a round to our prevote",
+              rounds.prevote);
+    durations("kagome_grandpa_precommit_seconds",
+              "Time from our prevote to our precommit",
+              rounds.precommit);
+    durations("kagome_grandpa_finalize_seconds",
+              "Time from our precommit to the finalization of the round",
+              rounds.finalize);
+    counter("kagome_imported_blocks_total",
+            "Blocks imported",
+            report.imported_blocks);
+    durations("kagome_finality_lag_seconds",
+              "Time from the import of a block to its finalization",
+              report.finality_lag);
+  }
+
+  void ConsensusMetrics::reset() {
+    std::lock_guard lock{mutex_};
+    slots_ = Slots{};
+    rounds_ = Rounds{};
+    imported_blocks_ = 0;
+    finality_lag_ = common::DurationHistogram{};
+  }
+
+}  // namespace kagome::consensus
@@ -0,0 +1,180 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_CONSENSUS_METRICS_HPP
+#define KAGOME_CORE_CONSENSUS_CONSENSUS_METRICS_HPP
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+#include "common/duration_histogram.hpp"
+#include "common/metrics_registry.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::consensus {
+
+  /**
+   * Collects the timings of the BABE slots and the GRANDPA rounds: how late
+   * the slots start, how long the blocks take to be proposed and then to be
+   * announced once sealed, how long the imported blocks wait for the
+   * finality, and how long the rounds and their stages take, along with the
+   * votes received and the equivocations. Thread-safe
+   */
+  class ConsensusMetrics {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using DurationStats = common::DurationHistogram::Stats;
+
+    /// number of the imported blocks waiting for the finality, over which
+    /// the lowest ones are forgotten
+    static constexpr size_t kMaxUnfinalized = 4096;
+
+    struct SlotStats {
+      uint64_t slots = 0;
+      // slots skipped as the node was too late for them
+      uint64_t skipped = 0;
+      // how late the slots start against the wall clock
+      DurationStats drift;
+      // how late the slot timer fires past the end of the slot
+      DurationStats timer;
+      DurationStats proposal;
+      // from the seal of a block to its broadcast
+      DurationStats announce;
+    };
+
+    struct RoundStats {
+      uint64_t completed = 0;
+      uint64_t failed = 0;
+      uint64_t prevotes = 0;
+      uint64_t precommits = 0;
+      uint64_t equivocations = 0;
+      DurationStats duration;
+      // from the start of a round to our prevote
+      DurationStats prevote;
+      // from our prevote to our precommit
+      DurationStats precommit;
+      // from our precommit to the finalization of the round
+      DurationStats finalize;
+    };
+
+    struct Report {
+      SlotStats slots;
+      RoundStats rounds;
+      uint64_t imported_blocks = 0;
+      // from the import of a block to its finalization
+      DurationStats finality_lag;
+    };
+
+    /**
+     * Records a slot started \arg drift later than its time
+     */
+    void recordSlot(Clock::duration drift);
+
+    /**
+     * Records a slot skipped as it was over by the time it would start
+     */
+    void recordSkippedSlot();
+
+    /**
+     * Records the slot timer fired \arg lateness past the end of the slot
+     */
+    void recordSlotTimer(Clock::duration lateness);
+
+    /**
+     * Records the time a block took to be built by the proposer
+     */
+    void recordProposal(Clock::duration duration);
+
+    /**
+     * Records the time a block took from being sealed to being broadcast
+     */
+    void recordAnnounce(Clock::duration duration);
+
+    /**
+     * Records that a block of \arg number is imported at \arg at, only the
+     * first block of a number is kept until it is finalized
+     */
+    void recordImported(primitives::BlockNumber number,
+                        Clock::time_point at = Clock::now());
+
+    /**
+     * Records that the blocks up to \arg number are finalized at \arg at
+     */
+    void recordFinalized(primitives::BlockNumber number,
+                         Clock::time_point at = Clock::now());
+
+    /**
+     * Records a round, which took \arg duration, \arg completed or not
+     */
+    void recordRound(Clock::duration duration, bool completed);
+
+    /**
+     * Records the time from the start of a round to our prevote
+     */
+    void recordPrevoted(Clock::duration duration);
+
+    /**
+     * Records the time from our prevote to our precommit
+     */
+    void recordPrecommitted(Clock::duration duration);
+
+    /**
+     * Records the time from our precommit to the finalization of the round
+     */
+    void recordRoundFinalized(Clock::duration duration);
+
+    void recordPrevote();
+
+    void recordPrecommit();
+
+    void recordEquivocation();
+
+    Report report() const;
+
+    /**
+     * Writes the report to \arg writer, on the scrapes of Prometheus
+     */
+    void collect(common::MetricsRegistry::Writer &writer) const;
+
+    /**
+     * Forgets everything collected so far, but the imported blocks waiting
+     * for the finality
+     */
+    void reset();
+
+   private:
+    struct Slots {
+      uint64_t slots = 0;
+      uint64_t skipped = 0;
+      common::DurationHistogram drift;
+      common::DurationHistogram timer;
+      common::DurationHistogram proposal;
+      common::DurationHistogram announce;
+    };
+
+    struct Rounds {
+      uint64_t completed = 0;
+      uint64_t failed = 0;
+      uint64_t prevotes = 0;
+      uint64_t precommits = 0;
+      uint64_t equivocations = 0;
+      common::DurationHistogram duration;
+      common::DurationHistogram prevote;
+      common::DurationHistogram precommit;
+      common::DurationHistogram finalize;
+    };
+
+    mutable std::mutex mutex_;
+    Slots slots_;
+    Rounds rounds_;
+    uint64_t imported_blocks_ = 0;
+    common::DurationHistogram finality_lag_;
+    std::map<primitives::BlockNumber, Clock::time_point> imported_;
+  };
+
+}  // namespace kagome::consensus
+
+#endif  // KAGOME_CORE_CONSENSUS_CONSENSUS_METRICS_HPP
@@ -0,0 +1,52 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_GRANDPA_CATCH_UP_HPP
+#define KAGOME_CORE_CONSENSUS_GRANDPA_CATCH_UP_HPP
+
+#include <boost/variant.hpp>
+
+#include "consensus/grandpa/round_state.hpp"
+#include "consensus/grandpa/structs.hpp"
+
+namespace kagome::consensus::grandpa {
+
+  /// announces the round a peer votes in, so that the lagging peers catch up
+  struct NeighborPacket {
+    RoundNumber round_number{0};
+    MembershipCounter set_id{0};
+    BlockNumber last_finalized{0};
+
+    SCALE_FIELDS(round_number, set_id, last_finalized)
+  };
+
+  /// asks for the proof of a round completed after \a round_number
+  struct CatchUpRequest {
+    RoundNumber round_number{0};
+    MembershipCounter set_id{0};
+
+    SCALE_FIELDS(round_number, set_id)
+  };
+
+  /**
+   * Prevotes and precommits of a completed round, which prove its state, so
+   * that a lagging peer starts the next round right away
+   */
+  struct CatchUp {
+    RoundNumber round_number{0};
+    MembershipCounter set_id{0};
+    std::vector<SignedMessage> prevotes;
+    std::vector<SignedMessage> precommits;
+    RoundState state;
+
+    SCALE_FIELDS(round_number, set_id, prevotes, precommits, state)
+  };
+
+  using CatchUpMessage =
+      boost::variant<NeighborPacket, CatchUpRequest, CatchUp>;
+
+}  // namespace kagome::consensus::grandpa
+
+#endif  // KAGOME_CORE_CONSENSUS_GRANDPA_CATCH_UP_HPP
@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_CONSENSUS_GRANDPA_ENVIRONMENT_HPP
 #define KAGOME_CORE_CONSENSUS_GRANDPA_ENVIRONMENT_HPP
 
+#include "consensus/grandpa/catch_up.hpp"
 #include "consensus/grandpa/chain.hpp"
 #include "consensus/grandpa/common.hpp"
 #include "consensus/grandpa/completed_round.hpp"
@@ -65,6 +66,13 @@ namespace kagome::consensus::grandpa {
         const BlockInfo &vote,
         const GrandpaJustification &justification) = 0;
 
+    /**
+     * Triggered when current peer announces the round it votes in, or asks
+     * for or answers with a proof of a completed round, so that \param
+     * message is ready to be gossiped
+     */
+    virtual void onCatchUpMessage(const CatchUpMessage &message) = 0;
+
     /**
      * Provides a handler for completed round
      */
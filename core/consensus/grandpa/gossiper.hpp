@@ -9,6 +9,7 @@
 #include <functional>
 
 #include <outcome/outcome.hpp>
+#include "consensus/grandpa/catch_up.hpp"
 #include "consensus/grandpa/structs.hpp"
 
 namespace kagome::consensus::grandpa {
@@ -29,6 +30,11 @@ namespace kagome::consensus::grandpa {
      * Broadcast grandpa's \param fin_message
      */
     virtual void finalize(const Fin &fin_message) = 0;
+
+    /**
+     * Broadcast grandpa's \param message of the catch-up protocol
+     */
+    virtual void catchUp(const CatchUpMessage &message) = 0;
   };
 
 }  // namespace kagome::consensus::grandpa
@@ -40,6 +40,12 @@ namespace kagome::consensus::grandpa {
     return result_chain;
   }
 
+  bool EnvironmentImpl::isEqualOrDescendOf(const BlockHash &base,
+                                           const BlockHash &block) const {
+    // answered by the block tree without making the chain
+    return block_tree_->hasDirectChain(base, block);
+  }
+
   outcome::result<BlockInfo> EnvironmentImpl::bestChainContaining(
       const BlockHash &base) const {
     logger_->debug("Finding best chain containing block {}", base.toHex());
@@ -120,6 +126,10 @@ namespace kagome::consensus::grandpa {
     return outcome::success();
   }
 
+  void EnvironmentImpl::onCatchUpMessage(const CatchUpMessage &message) {
+    gossiper_->catchUp(message);
+  }
+
   void EnvironmentImpl::doOnCompleted(
       const CompleteHandler &on_completed_slot) {
     on_completed_.disconnect_all_slots();
@@ -137,7 +147,9 @@ namespace kagome::consensus::grandpa {
       const primitives::BlockHash &block_hash,
       const GrandpaJustification &grandpa_jusitification) {
     primitives::Justification justification;
-    justification.data.put(scale::encode(grandpa_jusitification).value());
+    justification.data.put(
+        scale::encode(StoredJustification{grandpa_jusitification, true})
+            .value());
     return block_tree_->finalize(block_hash, justification);
   }
 
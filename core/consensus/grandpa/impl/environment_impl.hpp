@@ -36,6 +36,9 @@ namespace kagome::consensus::grandpa {
         const primitives::BlockHash &base,
         const primitives::BlockHash &block) const override;
 
+    bool isEqualOrDescendOf(const primitives::BlockHash &base,
+                            const primitives::BlockHash &block) const override;
+
     outcome::result<BlockInfo> bestChainContaining(
         const primitives::BlockHash &base) const override;
 
@@ -59,6 +62,8 @@ namespace kagome::consensus::grandpa {
         const BlockInfo &vote,
         const GrandpaJustification &justification) override;
 
+    void onCatchUpMessage(const CatchUpMessage &message) override;
+
     void doOnCompleted(const CompleteHandler &) override;
 
     void onCompleted(outcome::result<CompletedRound> round) override;
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/indexed_vote_tracker_impl.hpp"
+
+#include <boost/assert.hpp>
+
+namespace kagome::consensus::grandpa {
+
+  IndexedVoteTrackerImpl::IndexedVoteTrackerImpl(
+      std::shared_ptr<const VoterSet> voters)
+      : voters_{std::move(voters)} {
+    BOOST_ASSERT(voters_ != nullptr);
+    positions_.resize(voters_->size(), kNotVoted);
+  }
+
+  VoteTracker::PushResult IndexedVoteTrackerImpl::push(
+      const VotingMessage &vote, size_t weight) {
+    auto index = voters_->voterIndex(vote.id);
+    if (not index) {
+      return PushResult::DUPLICATED;
+    }
+    auto &position = positions_[index.value()];
+    if (position == kNotVoted) {
+      position = messages_.size();
+      messages_.emplace_back(vote);
+      total_weight_ += weight;
+      return PushResult::SUCCESS;
+    }
+    auto &message = messages_[position];
+    auto *first = boost::get<VotingMessage>(&message);
+    if (first == nullptr) {
+      // already equivocated, any further vote is not accepted
+      return PushResult::DUPLICATED;
+    }
+    if (first->block_hash() == vote.block_hash()) {
+      return PushResult::DUPLICATED;
+    }
+    message = EquivocatoryVotingMessage{*first, vote};
+    total_weight_ += weight;
+    return PushResult::EQUIVOCATED;
+  }
+
+  std::vector<VoteTracker::VoteVariant> IndexedVoteTrackerImpl::getMessages()
+      const {
+    return messages_;
+  }
+
+  void IndexedVoteTrackerImpl::forEachMessage(
+      const std::function<void(const VoteVariant &)> &callback) const {
+    for (const auto &message : messages_) {
+      callback(message);
+    }
+  }
+
+  size_t IndexedVoteTrackerImpl::getTotalWeight() const {
+    return total_weight_;
+  }
+
+}  // namespace kagome::consensus::grandpa
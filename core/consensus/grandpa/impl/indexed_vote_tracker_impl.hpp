@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_INDEXED_VOTE_TRACKER_IMPL_HPP
+#define KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_INDEXED_VOTE_TRACKER_IMPL_HPP
+
+#include "consensus/grandpa/vote_tracker.hpp"
+
+#include <limits>
+#include <memory>
+
+#include "consensus/grandpa/voter_set.hpp"
+
+namespace kagome::consensus::grandpa {
+
+  /**
+   * Vote tracker of a round with the known voter set: a vote is resolved to
+   * the index of its voter once, and the messages are kept in a flat vector
+   * in the order they are accepted, so that neither pushing nor iterating
+   * compares the ids. The votes of the voters not in the set are not accepted
+   */
+  class IndexedVoteTrackerImpl : public VoteTracker {
+   public:
+    using PushResult = typename VoteTracker::PushResult;
+    using VotingMessage = typename VoteTracker::VotingMessage;
+    using EquivocatoryVotingMessage =
+        typename VoteTracker::EquivocatoryVotingMessage;
+    using VoteVariant = typename VoteTracker::VoteVariant;
+
+    explicit IndexedVoteTrackerImpl(std::shared_ptr<const VoterSet> voters);
+
+    ~IndexedVoteTrackerImpl() override = default;
+
+    /**
+     * @copydoc VoteTracker::push
+     * The vote of a voter not in the set is reported as DUPLICATED, as it is
+     * not accepted either
+     */
+    PushResult push(const VotingMessage &vote, size_t weight) override;
+
+    std::vector<VoteVariant> getMessages() const override;
+
+    void forEachMessage(const std::function<void(const VoteVariant &)>
+                            &callback) const override;
+
+    size_t getTotalWeight() const override;
+
+   private:
+    static constexpr size_t kNotVoted = std::numeric_limits<size_t>::max();
+
+    std::shared_ptr<const VoterSet> voters_;
+    // position in messages_ of the vote of each voter by its index
+    std::vector<size_t> positions_;
+    std::vector<VoteVariant> messages_;
+    size_t total_weight_ = 0;
+  };
+
+}  // namespace kagome::consensus::grandpa
+
+#endif  // KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_INDEXED_VOTE_TRACKER_IMPL_HPP
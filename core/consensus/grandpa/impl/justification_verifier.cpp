@@ -0,0 +1,81 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/justification_verifier.hpp"
+
+#include <unordered_set>
+
+#include "consensus/grandpa/impl/vote_crypto_provider_impl.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::consensus::grandpa,
+                            JustificationError,
+                            e) {
+  using E = kagome::consensus::grandpa::JustificationError;
+  switch (e) {
+    case E::UNKNOWN_VOTER:
+      return "Justification has a precommit of an unknown voter";
+    case E::INVALID_SIGNATURE:
+      return "Justification has a precommit with an invalid signature";
+    case E::NOT_ENOUGH_WEIGHT:
+      return "Precommits of justification are not of the supermajority";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::consensus::grandpa {
+
+  JustificationVerifier::JustificationVerifier(
+      std::shared_ptr<VoterSet> voters,
+      std::shared_ptr<crypto::ED25519Provider> ed_provider)
+      : voters_{std::move(voters)}, ed_provider_{std::move(ed_provider)} {
+    BOOST_ASSERT(voters_ != nullptr);
+    BOOST_ASSERT(voters_->totalWeight() != 0);
+    BOOST_ASSERT(ed_provider_ != nullptr);
+  }
+
+  outcome::result<void> JustificationVerifier::verify(
+      const GrandpaJustification &justification,
+      const BlockInfo &block,
+      const IsDescendant &is_descendant) const {
+    // only verifies, so the keypair is never used
+    VoteCryptoProviderImpl crypto_provider{
+        {}, ed_provider_, justification.round_number, voters_};
+
+    for (const auto &precommit : justification.items) {
+      if (not voters_->voterWeight(precommit.id)) {
+        return JustificationError::UNKNOWN_VOTER;
+      }
+      if (not precommit.is<Precommit>()) {
+        return JustificationError::INVALID_SIGNATURE;
+      }
+    }
+    // a justification has a precommit of most of the voters, so they are
+    // verified in a batch
+    auto valid = crypto_provider.verifyVotes(justification.items);
+
+    // an equivocating voter has two precommits, but is counted once
+    std::unordered_set<Id> counted;
+    size_t weight = 0;
+    for (size_t i = 0; i < justification.items.size(); ++i) {
+      const auto &precommit = justification.items[i];
+      if (not valid[i]) {
+        return JustificationError::INVALID_SIGNATURE;
+      }
+      auto target = precommit.block_info();
+      if ((target == block or is_descendant(target))
+          and counted.insert(precommit.id).second) {
+        weight += voters_->voterWeight(precommit.id).value();
+      }
+    }
+
+    // the same supermajority as the one of a voting round
+    auto faulty = (voters_->totalWeight() - 1) / 3;
+    if (weight < voters_->totalWeight() - faulty) {
+      return JustificationError::NOT_ENOUGH_WEIGHT;
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::consensus::grandpa
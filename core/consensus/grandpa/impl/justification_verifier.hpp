@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_JUSTIFICATION_VERIFIER_HPP
+#define KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_JUSTIFICATION_VERIFIER_HPP
+
+#include <functional>
+
+#include <outcome/outcome.hpp>
+
+#include "consensus/grandpa/structs.hpp"
+#include "consensus/grandpa/voter_set.hpp"
+#include "crypto/ed25519_provider.hpp"
+
+namespace kagome::consensus::grandpa {
+
+  enum class JustificationError {
+    UNKNOWN_VOTER = 1,
+    INVALID_SIGNATURE,
+    NOT_ENOUGH_WEIGHT
+  };
+
+  /**
+   * Verifies the justifications of the finalized blocks, which are received
+   * from other nodes, so that the finality is not executed again to be known
+   */
+  class JustificationVerifier {
+   public:
+    /// tells whether the block is a descendant of the justified one
+    using IsDescendant = std::function<bool(const BlockInfo &)>;
+
+    JustificationVerifier(std::shared_ptr<VoterSet> voters,
+                          std::shared_ptr<crypto::ED25519Provider> ed_provider);
+
+    /**
+     * Verifies that \arg justification finalizes \arg block: all of its
+     * precommits are signed by the voters in the round of the justification,
+     * and the voters precommitted for the block or its descendants have the
+     * supermajority of the weight
+     */
+    outcome::result<void> verify(const GrandpaJustification &justification,
+                                 const BlockInfo &block,
+                                 const IsDescendant &is_descendant) const;
+
+   private:
+    std::shared_ptr<VoterSet> voters_;
+    std::shared_ptr<crypto::ED25519Provider> ed_provider_;
+  };
+
+}  // namespace kagome::consensus::grandpa
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::consensus::grandpa, JustificationError);
+
+#endif  // KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_JUSTIFICATION_VERIFIER_HPP
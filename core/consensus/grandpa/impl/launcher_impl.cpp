@@ -5,10 +5,13 @@
 
 #include "consensus/grandpa/impl/launcher_impl.hpp"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <boost/asio/post.hpp>
 #include "consensus/grandpa/impl/environment_impl.hpp"
 #include "consensus/grandpa/impl/vote_crypto_provider_impl.hpp"
-#include "consensus/grandpa/impl/vote_tracker_impl.hpp"
+#include "consensus/grandpa/impl/indexed_vote_tracker_impl.hpp"
 #include "consensus/grandpa/impl/voting_round_impl.hpp"
 #include "consensus/grandpa/vote_graph/vote_graph_impl.hpp"
 #include "scale/scale.hpp"
@@ -18,26 +21,59 @@ namespace kagome::consensus::grandpa {
 
   static size_t round_id = 0;
 
+  namespace {
+    /**
+     * @return true if \arg votes, which are all of type \a T and of \arg
+     * voters, have a supermajority for \arg block, i.e. are for it or its
+     * descendants. An equivocator is counted for any block, as it is in the
+     * round
+     */
+    template <typename T>
+    bool hasSupermajority(const std::vector<SignedMessage> &votes,
+                          const BlockHash &block,
+                          const VoterSet &voters,
+                          const Chain &chain) {
+      std::unordered_map<Id, bool> supports;
+      for (const auto &vote : votes) {
+        if (not vote.is<T>() or not voters.voterIndex(vote.id)) {
+          return false;
+        }
+        auto [it, first] = supports.emplace(vote.id, false);
+        it->second = it->second or not first
+                     or chain.isEqualOrDescendOf(block, vote.block_hash());
+      }
+      size_t weight = 0;
+      for (const auto &[id, support] : supports) {
+        if (support) {
+          weight += voters.voterWeight(id).value();
+        }
+      }
+      auto faulty = (voters.totalWeight() - 1) / 3;
+      return voters.totalWeight() != 0
+             and weight >= voters.totalWeight() - faulty;
+    }
+  }  // namespace
+
   LauncherImpl::LauncherImpl(
       std::shared_ptr<Environment> environment,
       std::shared_ptr<storage::BufferStorage> storage,
       std::shared_ptr<crypto::ED25519Provider> crypto_provider,
-      std::shared_ptr<runtime::Grandpa> grandpa_api,
       const crypto::ED25519Keypair &keypair,
       std::shared_ptr<Clock> clock,
-      std::shared_ptr<boost::asio::io_context> io_context)
+      std::shared_ptr<boost::asio::io_context> io_context,
+      std::shared_ptr<ConsensusMetrics> metrics)
       : environment_{std::move(environment)},
         storage_{std::move(storage)},
         crypto_provider_{std::move(crypto_provider)},
-        grandpa_api_{std::move(grandpa_api)},
         keypair_{keypair},
         clock_{std::move(clock)},
         io_context_{std::move(io_context)},
-        liveness_checker_{*io_context_} {
+        liveness_checker_{*io_context_},
+        vote_verifier_{std::make_shared<VoteVerifier>(io_context_)},
+        metrics_{std::move(metrics)} {
     BOOST_ASSERT(environment_ != nullptr);
     BOOST_ASSERT(storage_ != nullptr);
     BOOST_ASSERT(crypto_provider_ != nullptr);
-    BOOST_ASSERT(grandpa_api_ != nullptr);
     BOOST_ASSERT(clock_ != nullptr);
     BOOST_ASSERT(io_context_ != nullptr);
     // lambda which is executed when voting round is completed. This lambda
@@ -45,6 +81,10 @@ namespace kagome::consensus::grandpa {
     auto handle_completed_round =
         [this](outcome::result<CompletedRound> completed_round_res) {
           round_id++;
+          if (metrics_ != nullptr) {
+            metrics_->recordRound(clock_->now() - round_started_,
+                                  completed_round_res.has_value());
+          }
 
           if (not completed_round_res) {
             current_round_.reset();
@@ -52,6 +92,12 @@ namespace kagome::consensus::grandpa {
                            completed_round_res.error().message());
           } else {
             const auto &completed_round = completed_round_res.value();
+            // the votes of the round are kept to prove it to the lagging peers
+            if (current_round_ != nullptr
+                and current_round_->roundNumber()
+                        == completed_round.round_number) {
+              last_catch_up_ = current_round_->catchUp();
+            }
             // update last completed round if it is greater than previous last
             // completed round
             const auto &last_completed_round_res = getLastCompletedRound();
@@ -118,8 +164,8 @@ namespace kagome::consensus::grandpa {
     using std::chrono_literals::operator""ms;
     auto duration = Duration(3333ms);
 
-    auto prevote_tracker = std::make_shared<VoteTrackerImpl>();
-    auto precommit_tracker = std::make_shared<VoteTrackerImpl>();
+    auto prevote_tracker = std::make_shared<IndexedVoteTrackerImpl>(voters);
+    auto precommit_tracker = std::make_shared<IndexedVoteTrackerImpl>(voters);
 
     auto vote_graph = std::make_shared<VoteGraphImpl>(
         last_round_state.finalized.value(), environment_);
@@ -130,6 +176,7 @@ namespace kagome::consensus::grandpa {
                          .peer_id = keypair_.public_key};
     auto &&vote_crypto_provider = std::make_shared<VoteCryptoProviderImpl>(
         keypair_, crypto_provider_, round_number, voters);
+    vote_verifier_->startRound(round_number, voters, vote_crypto_provider);
 
     current_round_ =
         std::make_shared<VotingRoundImpl>(std::move(config),
@@ -139,12 +186,22 @@ namespace kagome::consensus::grandpa {
                                           std::move(precommit_tracker),
                                           std::move(vote_graph),
                                           clock_,
-                                          io_context_);
+                                          io_context_,
+                                          metrics_);
+    round_started_ = clock_->now();
     logger_->debug("Starting grandpa round: {}", round_number);
 
     current_round_->primaryPropose(last_round_state);
     current_round_->prevote(last_round_state);
     current_round_->precommit(last_round_state);
+
+    // the peers lagging behind ask for a catch-up, once they know the round
+    if (last_round_state.finalized) {
+      environment_->onCatchUpMessage(NeighborPacket{
+          .round_number = round_number,
+          .set_id = voters->id(),
+          .last_finalized = last_round_state.finalized->block_number});
+    }
   }
 
   void LauncherImpl::start() {
@@ -186,46 +243,39 @@ namespace kagome::consensus::grandpa {
       return;
     }
 
-    // get block info
-    auto blockInfo = visit_in_place(msg.vote.message, [](const auto &vote) {
-      return BlockInfo(vote.block_number, vote.block_hash);
-    });
-
-    // get authorities
-    const auto &weighted_authorities_res =
-        grandpa_api_->authorities(primitives::BlockId(blockInfo.block_number));
-    if (!weighted_authorities_res.has_value()) {
-      logger_->error("Can't get authorities");
+    if (msg.vote.is<PrimaryPropose>()) {
+      current_round->onPrimaryPropose(msg.vote);
       return;
-    };
-    auto &weighted_authorities = weighted_authorities_res.value();
-
-    // find signer in authorities
-    auto weighted_authority_it =
-        std::find_if(weighted_authorities.begin(),
-                     weighted_authorities.end(),
-                     [&id = msg.vote.id](const auto &weighted_authority) {
-                       return weighted_authority.id.id == id;
-                     });
-
-    if (weighted_authority_it == weighted_authorities.end()) {
-      logger_->warn("Vote signed by unknown validator");
-      return;
-    };
+    }
 
-    visit_in_place(
-        msg.vote.message,
-        [&current_round, &msg](const PrimaryPropose &primary_propose) {
-          current_round->onPrimaryPropose(msg.vote);
-        },
-        [&current_round, &msg](const Prevote &prevote) {
-          current_round->onPrevote(msg.vote);
-        },
-        [&current_round, &msg](const Precommit &precommit) {
-          current_round->onPrecommit(msg.vote);
+    // the voter and the duplicates are checked at once, while the signature
+    // is verified off the io context
+    vote_verifier_->verify(
+        msg.round_number,
+        msg.vote,
+        [current_round = std::move(current_round)](const SignedMessage &vote) {
+          if (vote.is<Prevote>()) {
+            current_round->onVerifiedPrevote(vote);
+          } else {
+            current_round->onVerifiedPrecommit(vote);
+          }
         });
   }
 
+  void LauncherImpl::onOwnVoteMessage(const VoteMessage &msg) {
+    auto current_round = current_round_;
+    if (msg.round_number != current_round->roundNumber()) {
+      return;
+    }
+    if (msg.vote.is<PrimaryPropose>()) {
+      current_round->onPrimaryPropose(msg.vote);
+    } else if (msg.vote.is<Prevote>()) {
+      current_round->onVerifiedPrevote(msg.vote);
+    } else {
+      current_round->onVerifiedPrecommit(msg.vote);
+    }
+  }
+
   void LauncherImpl::onFinalize(const Fin &f) {
     logger_->debug("Received fin message for round: {}", f.round_number);
     if (f.round_number == current_round_->roundNumber()) {
@@ -233,4 +283,114 @@ namespace kagome::consensus::grandpa {
     }
   }
 
+  void LauncherImpl::onCatchUpMessage(const CatchUpMessage &msg) {
+    visit_in_place(
+        msg,
+        [this](const NeighborPacket &packet) { onNeighborPacket(packet); },
+        [this](const CatchUpRequest &request) { onCatchUpRequest(request); },
+        [this](const CatchUp &catch_up) { onCatchUp(catch_up); });
+  }
+
+  void LauncherImpl::onNeighborPacket(const NeighborPacket &packet) {
+    auto current_round = current_round_;
+    if (current_round == nullptr) {
+      return;
+    }
+    auto round_number = current_round->roundNumber();
+    // the peers are a round apart while switching the rounds, so only the
+    // ones further ahead are caught up with
+    if (packet.round_number <= round_number + 1
+        or catch_up_requested_ == round_number) {
+      return;
+    }
+    auto voters_res = getVoters();
+    if (not voters_res or voters_res.value()->id() != packet.set_id) {
+      return;
+    }
+    catch_up_requested_ = round_number;
+    logger_->debug("Peer is in grandpa round {}, asking for a catch-up to it",
+                   packet.round_number);
+    environment_->onCatchUpMessage(CatchUpRequest{
+        .round_number = round_number, .set_id = packet.set_id});
+  }
+
+  void LauncherImpl::onCatchUpRequest(const CatchUpRequest &request) {
+    if (not last_catch_up_ or last_catch_up_->set_id != request.set_id
+        or last_catch_up_->round_number < request.round_number) {
+      return;
+    }
+    logger_->debug("Answering catch-up request from grandpa round {}",
+                   request.round_number);
+    environment_->onCatchUpMessage(last_catch_up_.value());
+  }
+
+  void LauncherImpl::onCatchUp(const CatchUp &catch_up) {
+    auto current_round = current_round_;
+    if (current_round != nullptr
+        and catch_up.round_number < current_round->roundNumber()) {
+      return;
+    }
+    auto voters_res = getVoters();
+    if (not voters_res or voters_res.value()->id() != catch_up.set_id) {
+      return;
+    }
+    if (not verifyCatchUp(catch_up, voters_res.value())) {
+      logger_->warn("Catch-up to grandpa round {} is not valid",
+                    catch_up.round_number);
+      return;
+    }
+
+    auto last_round_res = getLastCompletedRound();
+    if (not last_round_res) {
+      logger_->warn(last_round_res.error().message());
+      return;
+    }
+    if (catch_up.round_number <= last_round_res.value().round_number) {
+      return;
+    }
+    CompletedRound completed_round{.round_number = catch_up.round_number,
+                                   .state = catch_up.state};
+    if (auto put_res = storage_->put(
+            storage::kSetStateKey,
+            common::Buffer(scale::encode(completed_round).value()));
+        not put_res) {
+      logger_->error("Caught up round state was not added to the storage");
+      return;
+    }
+    last_catch_up_ = catch_up;
+    logger_->info("Caught up to grandpa round {}", catch_up.round_number);
+
+    round_id++;
+    boost::asio::post(*io_context_, [self{shared_from_this()}] {
+      self->executeNextRound();
+    });
+  }
+
+  bool LauncherImpl::verifyCatchUp(
+      const CatchUp &catch_up, const std::shared_ptr<VoterSet> &voters) const {
+    if (not catch_up.state.prevote_ghost or not catch_up.state.finalized) {
+      return false;
+    }
+    std::vector<SignedMessage> votes;
+    votes.reserve(catch_up.prevotes.size() + catch_up.precommits.size());
+    votes.insert(
+        votes.end(), catch_up.prevotes.begin(), catch_up.prevotes.end());
+    votes.insert(
+        votes.end(), catch_up.precommits.begin(), catch_up.precommits.end());
+    VoteCryptoProviderImpl vote_crypto_provider{
+        keypair_, crypto_provider_, catch_up.round_number, voters};
+    auto valid = vote_crypto_provider.verifyVotes(votes);
+    if (std::find(valid.begin(), valid.end(), false) != valid.end()) {
+      return false;
+    }
+    const auto &ghost = catch_up.state.prevote_ghost.value();
+    const auto &finalized = catch_up.state.finalized.value();
+    return hasSupermajority<Prevote>(
+               catch_up.prevotes, ghost.block_hash, *voters, *environment_)
+           and hasSupermajority<Precommit>(catch_up.precommits,
+                                           finalized.block_hash,
+                                           *voters,
+                                           *environment_);
+  }
+
 }  // namespace kagome::consensus::grandpa
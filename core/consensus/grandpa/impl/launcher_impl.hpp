@@ -8,14 +8,15 @@
 
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
+#include "consensus/consensus_metrics.hpp"
 #include "consensus/grandpa/completed_round.hpp"
 #include "consensus/grandpa/environment.hpp"
+#include "consensus/grandpa/impl/vote_verifier.hpp"
 #include "consensus/grandpa/launcher.hpp"
 #include "consensus/grandpa/voter_set.hpp"
 #include "consensus/grandpa/voting_round.hpp"
 #include "crypto/ed25519_provider.hpp"
 #include "network/gossiper.hpp"
-#include "runtime/grandpa.hpp"
 #include "storage/buffer_map_types.hpp"
 
 namespace kagome::consensus::grandpa {
@@ -25,13 +26,17 @@ namespace kagome::consensus::grandpa {
    public:
     ~LauncherImpl() override = default;
 
+    /**
+     * @param metrics records the durations of the rounds and their stages,
+     * if any
+     */
     LauncherImpl(std::shared_ptr<Environment> environment,
                  std::shared_ptr<storage::BufferStorage> storage,
                  std::shared_ptr<crypto::ED25519Provider> crypto_provider,
-                 std::shared_ptr<runtime::Grandpa> grandpa_api,
                  const crypto::ED25519Keypair &keypair,
                  std::shared_ptr<Clock> clock,
-                 std::shared_ptr<boost::asio::io_context> io_context);
+                 std::shared_ptr<boost::asio::io_context> io_context,
+                 std::shared_ptr<ConsensusMetrics> metrics = nullptr);
 
     void start() override;
 
@@ -45,24 +50,55 @@ namespace kagome::consensus::grandpa {
 
     void onVoteMessage(const VoteMessage &msg) override;
 
+    void onOwnVoteMessage(const VoteMessage &msg) override;
+
     void onFinalize(const Fin &f) override;
 
+    /**
+     * Asks for the proof of the latest round completed by the peers, which
+     * are at least two rounds ahead, answers such requests with the proof of
+     * the last round completed by this peer, and starts the round after the
+     * one proven by a catch-up, if it is ahead
+     */
+    void onCatchUpMessage(const CatchUpMessage &msg) override;
+
     void executeNextRound();
 
    private:
     outcome::result<std::shared_ptr<VoterSet>> getVoters() const;
     outcome::result<CompletedRound> getLastCompletedRound() const;
 
+    void onNeighborPacket(const NeighborPacket &packet);
+    void onCatchUpRequest(const CatchUpRequest &request);
+    void onCatchUp(const CatchUp &catch_up);
+
+    /**
+     * Check if \param catch_up is signed by \param voters, and its prevotes
+     * and precommits have a supermajority for its prevote ghost and its
+     * finalized block respectively. The signatures are verified in a single
+     * batch
+     */
+    bool verifyCatchUp(const CatchUp &catch_up,
+                       const std::shared_ptr<VoterSet> &voters) const;
+
     std::shared_ptr<VotingRound> current_round_;
+    // proof of the last completed round, given to the lagging peers
+    boost::optional<CatchUp> last_catch_up_;
+    // the round, in which a catch-up was requested, it is requested once in
+    // a round
+    boost::optional<RoundNumber> catch_up_requested_;
 
     std::shared_ptr<Environment> environment_;
     std::shared_ptr<storage::BufferStorage> storage_;
     std::shared_ptr<crypto::ED25519Provider> crypto_provider_;
-    std::shared_ptr<runtime::Grandpa> grandpa_api_;
     crypto::ED25519Keypair keypair_;
     std::shared_ptr<Clock> clock_;
     std::shared_ptr<boost::asio::io_context> io_context_;
     Timer liveness_checker_;
+    std::shared_ptr<VoteVerifier> vote_verifier_;
+    std::shared_ptr<ConsensusMetrics> metrics_;
+    // start of the current round, for the metrics
+    TimePoint round_started_;
 
     common::Logger logger_ = common::createLogger("Grandpa launcher");
   };
@@ -16,6 +16,14 @@ namespace kagome::consensus::grandpa {
     // do nothing as syncing node does not care about vote messages
   }
 
+  void SyncingRoundObserver::onOwnVoteMessage(const VoteMessage &msg) {
+    // do nothing as syncing node does not vote
+  }
+
+  void SyncingRoundObserver::onCatchUpMessage(const CatchUpMessage &msg) {
+    // do nothing as syncing node does not vote in the rounds
+  }
+
   void SyncingRoundObserver::onFinalize(const Fin &f) {
     if (auto fin_res =
             environment_->finalize(f.vote.block_hash, f.justification);
@@ -25,6 +25,10 @@ namespace kagome::consensus::grandpa {
 
     void onVoteMessage(const VoteMessage &msg) override;
 
+    void onOwnVoteMessage(const VoteMessage &msg) override;
+
+    void onCatchUpMessage(const CatchUpMessage &msg) override;
+
    private:
     std::shared_ptr<Environment> environment_;
     common::Logger logger_;
@@ -5,7 +5,7 @@
 
 #include "consensus/grandpa/impl/vote_crypto_provider_impl.hpp"
 
-#include "scale/scale.hpp"
+#include <boost/endian/buffers.hpp>
 
 namespace kagome::consensus::grandpa {
 
@@ -24,11 +24,9 @@ namespace kagome::consensus::grandpa {
     if (!primary_propose.is<PrimaryPropose>()) {
       return false;
     }
-    auto payload =
-        scale::encode(primary_propose.message, round_number_, voter_set_->id())
-            .value();
+    auto bytes = payload(primary_propose.message);
     auto verified = ed_provider_->verify(
-        primary_propose.signature, payload, primary_propose.id);
+        primary_propose.signature, bytes, primary_propose.id);
     return verified.has_value() and verified.value();
   }
 
@@ -37,10 +35,8 @@ namespace kagome::consensus::grandpa {
     if (!prevote.is<Prevote>()) {
       return false;
     }
-    auto payload =
-        scale::encode(prevote.message, round_number_, voter_set_->id()).value();
-    auto verified =
-        ed_provider_->verify(prevote.signature, payload, prevote.id);
+    auto bytes = payload(prevote.message);
+    auto verified = ed_provider_->verify(prevote.signature, bytes, prevote.id);
     return verified.has_value() and verified.value();
   }
 
@@ -49,18 +45,49 @@ namespace kagome::consensus::grandpa {
     if (!precommit.is<Precommit>()) {
       return false;
     }
-    auto payload =
-        scale::encode(precommit.message, round_number_, voter_set_->id())
-            .value();
+    auto bytes = payload(precommit.message);
     auto verified =
-        ed_provider_->verify(precommit.signature, payload, precommit.id);
+        ed_provider_->verify(precommit.signature, bytes, precommit.id);
     return verified.has_value() and verified.value();
   }
 
+  std::vector<bool> VoteCryptoProviderImpl::verifyVotes(
+      gsl::span<const SignedMessage> votes) const {
+    // the payloads are referenced by the batch until it is verified
+    std::vector<Payload> payloads;
+    payloads.reserve(votes.size());
+    std::vector<crypto::ED25519Verification> batch;
+    batch.reserve(votes.size());
+    for (const auto &vote : votes) {
+      payloads.push_back(payload(vote.message));
+      batch.push_back({vote.signature, payloads.back(), vote.id});
+    }
+    return ed_provider_->verifyBatch(batch);
+  }
+
+  VoteCryptoProviderImpl::Payload VoteCryptoProviderImpl::payload(
+      const Vote &vote) const {
+    Payload bytes;
+    auto it = bytes.begin();
+    auto put_number = [&it](uint64_t number) {
+      boost::endian::little_uint64_buf_t buf{number};
+      it = std::copy_n(buf.data(), sizeof(number), it);
+    };
+    *it++ = static_cast<uint8_t>(vote.which());
+    visit_in_place(vote, [&](const auto &v) {
+      it = std::copy(v.block_hash.begin(), v.block_hash.end(), it);
+      put_number(v.block_number);
+    });
+    put_number(round_number_);
+    put_number(voter_set_->id());
+    BOOST_ASSERT(it == bytes.end());
+    return bytes;
+  }
+
   crypto::ED25519Signature VoteCryptoProviderImpl::voteSignature(
       const Vote &vote) const {
-    auto payload = scale::encode(vote, round_number_, voter_set_->id()).value();
-    return ed_provider_->sign(keypair_, payload).value();
+    auto bytes = payload(vote);
+    return ed_provider_->sign(keypair_, bytes).value();
   }
 
   SignedMessage VoteCryptoProviderImpl::signPrimaryPropose(
@@ -7,6 +7,9 @@
 #define KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_VOTE_CRYPTO_PROVIDER_IMPL_HPP
 
 #include "consensus/grandpa/vote_crypto_provider.hpp"
+
+#include <array>
+
 #include "consensus/grandpa/voter_set.hpp"
 #include "crypto/ed25519_provider.hpp"
 
@@ -14,6 +17,12 @@ namespace kagome::consensus::grandpa {
 
   class VoteCryptoProviderImpl : public VoteCryptoProvider {
    public:
+    /// size of the SCALE encoded (vote, round number, set id), which is
+    /// signed: the vote type, block hash and number, round number and set id
+    static constexpr size_t kPayloadSize =
+        1 + BlockHash::size() + 3 * sizeof(uint64_t);
+    using Payload = std::array<uint8_t, kPayloadSize>;
+
     ~VoteCryptoProviderImpl() override = default;
 
     VoteCryptoProviderImpl(crypto::ED25519Keypair keypair,
@@ -25,12 +34,20 @@ namespace kagome::consensus::grandpa {
         const SignedMessage &primary_propose) const override;
     bool verifyPrevote(const SignedMessage &prevote) const override;
     bool verifyPrecommit(const SignedMessage &precommit) const override;
+    std::vector<bool> verifyVotes(
+        gsl::span<const SignedMessage> votes) const override;
 
     SignedMessage signPrimaryPropose(
         const PrimaryPropose &primary_propose) const override;
     SignedMessage signPrevote(const Prevote &prevote) const override;
     SignedMessage signPrecommit(const Precommit &precommit) const override;
 
+    /**
+     * @return the signed payload of \arg vote in the round, encoded in place
+     * the same way as scale::encode(vote, round number, set id) does
+     */
+    Payload payload(const Vote &vote) const;
+
    private:
     crypto::ED25519Signature voteSignature(const Vote &vote) const;
 
@@ -62,6 +62,13 @@ namespace kagome::consensus::grandpa {
     return prevotes;
   }
 
+  void VoteTrackerImpl::forEachMessage(
+      const std::function<void(const VoteVariant &)> &callback) const {
+    for (const auto &[key, value] : messages_) {
+      callback(value);
+    }
+  }
+
   size_t VoteTrackerImpl::getTotalWeight() const {
     return total_weight_;
   }
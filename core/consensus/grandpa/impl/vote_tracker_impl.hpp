@@ -24,6 +24,9 @@ namespace kagome::consensus::grandpa {
 
     std::vector<VoteVariant> getMessages() const override;
 
+    void forEachMessage(const std::function<void(const VoteVariant &)>
+                            &callback) const override;
+
     size_t getTotalWeight() const override;
 
    private:
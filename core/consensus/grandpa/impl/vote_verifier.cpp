@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/vote_verifier.hpp"
+
+#include <boost/asio/post.hpp>
+
+#include "common/visitor.hpp"
+
+namespace kagome::consensus::grandpa {
+
+  VoteVerifier::VoteVerifier(
+      std::shared_ptr<boost::asio::io_context> io_context)
+      : io_context_{std::move(io_context)}, pool_{kThreads} {
+    BOOST_ASSERT(io_context_ != nullptr);
+  }
+
+  VoteVerifier::~VoteVerifier() {
+    pool_.stop();
+    pool_.join();
+  }
+
+  void VoteVerifier::startRound(
+      RoundNumber round_number,
+      std::shared_ptr<const VoterSet> voters,
+      std::shared_ptr<const VoteCryptoProvider> crypto_provider) {
+    BOOST_ASSERT(voters != nullptr);
+    BOOST_ASSERT(crypto_provider != nullptr);
+    round_number_ = round_number;
+    voters_ = std::move(voters);
+    crypto_provider_ = std::move(crypto_provider);
+    seen_.clear();
+  }
+
+  bool VoteVerifier::verify(RoundNumber round_number,
+                            const SignedMessage &vote,
+                            Callback on_verified) {
+    if (voters_ == nullptr or round_number != round_number_) {
+      return false;
+    }
+    auto index = voters_->voterIndex(vote.id);
+    if (not index or pending_ >= kMaxPendingVotes) {
+      return false;
+    }
+    VoteKey key{
+        index.value(), vote.message.which(), vote.block_hash(), vote.signature};
+    if (not seen_.insert(key).second) {
+      return false;
+    }
+
+    ++pending_;
+    // the threads of the pool do not own the verifier, so that it is never
+    // destroyed on them
+    boost::asio::post(
+        pool_,
+        [crypto_provider = crypto_provider_,
+         io_context = io_context_,
+         wp = weak_from_this(),
+         round_number,
+         key = std::move(key),
+         vote,
+         on_verified = std::move(on_verified)]() mutable {
+          bool valid = verifySignature(*crypto_provider, vote);
+          auto report = [wp = std::move(wp),
+                         round_number,
+                         key = std::move(key),
+                         valid,
+                         vote = std::move(vote),
+                         on_verified = std::move(on_verified)] {
+            if (auto self = wp.lock()) {
+              self->onVerified(round_number, key, valid, vote, on_verified);
+            }
+          };
+          boost::asio::post(*io_context, std::move(report));
+        });
+    return true;
+  }
+
+  bool VoteVerifier::verifySignature(const VoteCryptoProvider &crypto_provider,
+                                     const SignedMessage &vote) {
+    return visit_in_place(
+        vote.message,
+        [&](const PrimaryPropose &) {
+          return crypto_provider.verifyPrimaryPropose(vote);
+        },
+        [&](const Prevote &) { return crypto_provider.verifyPrevote(vote); },
+        [&](const Precommit &) {
+          return crypto_provider.verifyPrecommit(vote);
+        });
+  }
+
+  void VoteVerifier::onVerified(RoundNumber round_number,
+                                const VoteKey &key,
+                                bool valid,
+                                const SignedMessage &vote,
+                                const Callback &on_verified) {
+    --pending_;
+    if (round_number != round_number_) {
+      return;
+    }
+    if (not valid) {
+      // the forged votes are not kept
+      seen_.erase(key);
+      return;
+    }
+    on_verified(vote);
+  }
+
+}  // namespace kagome::consensus::grandpa
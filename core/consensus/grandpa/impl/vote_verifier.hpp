@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_VOTE_VERIFIER_HPP
+#define KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_VOTE_VERIFIER_HPP
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <tuple>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include "consensus/grandpa/structs.hpp"
+#include "consensus/grandpa/vote_crypto_provider.hpp"
+#include "consensus/grandpa/voter_set.hpp"
+
+namespace kagome::consensus::grandpa {
+
+  /**
+   * Checks the votes received from the network before they reach the voting
+   * round: the votes of another round, of the voters not in the set and the
+   * ones seen already are dropped at once, while the signatures of the rest
+   * are verified on the threads of its own, so that a burst of votes does not
+   * occupy the io context shared with the timers and BABE. Only the votes
+   * with the valid signatures are posted back to the io context. The methods
+   * are called on the io context
+   */
+  class VoteVerifier : public std::enable_shared_from_this<VoteVerifier> {
+   public:
+    using Callback = std::function<void(const SignedMessage &)>;
+
+    /// number of the threads the signatures are verified on
+    static constexpr size_t kThreads = 2;
+
+    /// number of the votes being verified, over which the new ones are dropped
+    static constexpr size_t kMaxPendingVotes = 1024;
+
+    explicit VoteVerifier(std::shared_ptr<boost::asio::io_context> io_context);
+
+    ~VoteVerifier();
+
+    /**
+     * Starts accepting the votes of round \arg round_number cast by \arg
+     * voters, forgetting the ones of the previous round
+     * @param crypto_provider verifies the signatures of the votes of the round
+     */
+    void startRound(RoundNumber round_number,
+                    std::shared_ptr<const VoterSet> voters,
+                    std::shared_ptr<const VoteCryptoProvider> crypto_provider);
+
+    /**
+     * Schedules the verification of the signature of \arg vote of round \arg
+     * round_number, \arg on_verified is called with it on the io context if
+     * the signature is valid and the round is not changed meanwhile
+     * @return false if the vote is dropped without the verification
+     */
+    bool verify(RoundNumber round_number,
+                const SignedMessage &vote,
+                Callback on_verified);
+
+   private:
+    // voter index, vote type, block hash and signature
+    using VoteKey = std::tuple<size_t, int, BlockHash, Signature>;
+
+    static bool verifySignature(const VoteCryptoProvider &crypto_provider,
+                                const SignedMessage &vote);
+
+    void onVerified(RoundNumber round_number,
+                    const VoteKey &key,
+                    bool valid,
+                    const SignedMessage &vote,
+                    const Callback &on_verified);
+
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    boost::asio::thread_pool pool_;
+
+    RoundNumber round_number_{};
+    std::shared_ptr<const VoterSet> voters_;
+    std::shared_ptr<const VoteCryptoProvider> crypto_provider_;
+    // votes of the round being verified or verified already
+    std::set<VoteKey> seen_;
+    size_t pending_ = 0;
+  };
+
+}  // namespace kagome::consensus::grandpa
+
+#endif  // KAGOME_CORE_CONSENSUS_GRANDPA_IMPL_VOTE_VERIFIER_HPP
@@ -39,7 +39,8 @@ namespace kagome::consensus::grandpa {
       std::shared_ptr<VoteTracker> precommits,
       std::shared_ptr<VoteGraph> graph,
       std::shared_ptr<Clock> clock,
-      std::shared_ptr<boost::asio::io_context> io_context)
+      std::shared_ptr<boost::asio::io_context> io_context,
+      std::shared_ptr<ConsensusMetrics> metrics)
       : voter_set_{config.voters},
         round_number_{config.round_number},
         duration_{config.duration},
@@ -52,6 +53,7 @@ namespace kagome::consensus::grandpa {
         graph_{std::move(graph)},
         clock_{std::move(clock)},
         io_context_{std::move(io_context)},
+        metrics_{std::move(metrics)},
         prevote_timer_{*io_context_},
         precommit_timer_{*io_context_},
         logger_{common::createLogger("Grandpa")},
@@ -100,6 +102,12 @@ namespace kagome::consensus::grandpa {
             finalized.error().message());
         return;
       }
+      if (metrics_ != nullptr) {
+        if (precommitted_at_) {
+          metrics_->recordRoundFinalized(clock_->now() - *precommitted_at_);
+        }
+        metrics_->recordFinalized(f.vote.block_number);
+      }
       env_->onCompleted(CompletedRound{.round_number = round_number_,
                                        .state = cur_round_state_});
     } else {
@@ -115,17 +123,33 @@ namespace kagome::consensus::grandpa {
     std::unordered_map<Id, BlockHash> validators;
     std::unordered_set<Id> equivocators;
 
+    // the precommits of the known equivocators are skipped, the rest are
+    // verified in a batch, as they are of most of the voters
+    std::vector<SignedMessage> precommits;
+    precommits.reserve(justification.items.size());
     for (const auto &signed_precommit : justification.items) {
-      // Skip known equivocators
       if (auto index = voter_set_->voterIndex(signed_precommit.id);
           index.has_value()) {
         if (precommit_equivocators_.at(index.value())) {
           continue;
         }
       }
+      if (not signed_precommit.is<Precommit>()) {
+        logger_->error(
+            "Received a vote, which is not a precommit, in the justification "
+            "of the round {} from the peer {}",
+            round_number_,
+            signed_precommit.id.toHex());
+        return false;
+      }
+      precommits.push_back(signed_precommit);
+    }
+    auto valid = vote_crypto_provider_->verifyVotes(precommits);
 
+    for (size_t i = 0; i < precommits.size(); ++i) {
+      const auto &signed_precommit = precommits[i];
       // Verify signatures
-      if (not vote_crypto_provider_->verifyPrecommit(signed_precommit)) {
+      if (not valid[i]) {
         logger_->error(
             "Received invalid signed precommit during the round {} from the "
             "peer {}",
@@ -142,13 +166,14 @@ namespace kagome::consensus::grandpa {
               signed_precommit.id, signed_precommit.block_hash());
           success) {
         // New vote
-        if (env_->getAncestry(vote.block_hash, signed_precommit.block_hash())) {
+        if (env_->isEqualOrDescendOf(vote.block_hash,
+                                     signed_precommit.block_hash())) {
           total_weight += voter_set_->voterWeight(signed_precommit.id).value();
         }
 
       } else if (equivocators.emplace(signed_precommit.id).second) {
         // Detected equivocation
-        if (env_->getAncestry(vote.block_hash, it->second)) {
+        if (env_->isEqualOrDescendOf(vote.block_hash, it->second)) {
           total_weight -= voter_set_->voterWeight(signed_precommit.id).value();
         }
 
@@ -208,6 +233,30 @@ namespace kagome::consensus::grandpa {
     return round_number_;
   }
 
+  CatchUp VotingRoundImpl::catchUp() const {
+    // both votes of an equivocator are given, as they are counted for it
+    auto collect = [](const VoteTracker &tracker) {
+      std::vector<SignedMessage> votes;
+      tracker.forEachMessage([&](const VoteTracker::VoteVariant &vote) {
+        visit_in_place(
+            vote,
+            [&](const SignedMessage &voting_message) {
+              votes.push_back(voting_message);
+            },
+            [&](const VoteTracker::EquivocatoryVotingMessage &equivocation) {
+              votes.push_back(equivocation.first);
+              votes.push_back(equivocation.second);
+            });
+      });
+      return votes;
+    };
+    return CatchUp{.round_number = round_number_,
+                   .set_id = voter_set_->id(),
+                   .prevotes = collect(*prevotes_),
+                   .precommits = collect(*precommits_),
+                   .state = cur_round_state_};
+  }
+
   void VotingRoundImpl::onPrimaryPropose(const SignedMessage &primary_propose) {
     bool isValid = vote_crypto_provider_->verifyPrimaryPropose(primary_propose);
     if (not isValid) {
@@ -227,7 +276,14 @@ namespace kagome::consensus::grandpa {
       logger_->warn("Prevote of {} has invalid signature", prevote.id.toHex());
       return;
     }
-    onSignedPrevote(prevote);
+    onVerifiedPrevote(prevote);
+  }
+
+  void VotingRoundImpl::onVerifiedPrevote(const SignedMessage &prevote) {
+    if (not onSignedPrevote(prevote)) {
+      // a duplicate does not change the graph, so there is nothing to update
+      return;
+    }
     updatePrevoteGhost();
     update();
 
@@ -245,6 +301,10 @@ namespace kagome::consensus::grandpa {
                     precommit.id.toHex());
       return;
     }
+    onVerifiedPrecommit(precommit);
+  }
+
+  void VotingRoundImpl::onVerifiedPrecommit(const SignedMessage &precommit) {
     if (not onSignedPrecommit(precommit)) {
       env_->onCompleted(VotingRoundError::LAST_ESTIMATE_BETTER_THAN_PREVOTE);
       return;
@@ -258,27 +318,23 @@ namespace kagome::consensus::grandpa {
     tryFinalize();
   }
 
-  void VotingRoundImpl::onSignedPrevote(const SignedMessage &vote) {
+  bool VotingRoundImpl::onSignedPrevote(const SignedMessage &vote) {
     BOOST_ASSERT(vote.is<Prevote>());
-    auto weight = voter_set_->voterWeight(vote.id);
-    if (not weight) {
-      return;
+    auto index = voter_set_->voterIndex(vote.id);
+    if (not index) {
+      return false;
     }
-    switch (prevotes_->push(vote, weight.value())) {
+    auto weight = voter_set_->voterWeight(index.value()).value();
+    switch (prevotes_->push(vote, weight)) {
       case VoteTracker::PushResult::SUCCESS: {
-        const auto &voters = voter_set_->voters();
-
         // prepare VoteWeight which contains index of who has voted and what
         // kind of vote it was
-        VoteWeight v{voters.size()};
-        auto index = voter_set_->voterIndex(vote.id);
-        if (not index) {
-          logger_->warn("Voter {} is not known: {}", vote.id.toHex());
-          return;
+        VoteWeight v{voter_set_->size()};
+        v.prevotes[index.value()] = weight;
+        if (metrics_ != nullptr) {
+          metrics_->recordPrevote();
         }
 
-        v.prevotes[index.value()] = voter_set_->voterWeight(vote.id).value();
-
         if (auto inserted = graph_->insert(vote.message, v); not inserted) {
           logger_->warn("Vote {} was not inserted with error: {}",
                         vote.block_hash().toHex(),
@@ -287,41 +343,37 @@ namespace kagome::consensus::grandpa {
         break;
       }
       case VoteTracker::PushResult::DUPLICATED: {
-        break;
+        return false;
       }
       case VoteTracker::PushResult::EQUIVOCATED: {
-        auto index = voter_set_->voterIndex(vote.id);
-        if (not index) {
-          logger_->warn("Voter {} is not known: {}", vote.id.toHex());
-          return;
-        }
         prevote_equivocators_[index.value()] = true;
+        if (metrics_ != nullptr) {
+          metrics_->recordPrevote();
+          metrics_->recordEquivocation();
+        }
         break;
       }
     }
+    return true;
   }
 
   bool VotingRoundImpl::onSignedPrecommit(const SignedMessage &vote) {
     BOOST_ASSERT(vote.is<Precommit>());
-    auto weight = voter_set_->voterWeight(vote.id);
-    if (not weight) {
+    auto index = voter_set_->voterIndex(vote.id);
+    if (not index) {
       return false;
     }
-    switch (precommits_->push(vote, weight.value())) {
+    auto weight = voter_set_->voterWeight(index.value()).value();
+    switch (precommits_->push(vote, weight)) {
       case VoteTracker::PushResult::SUCCESS: {
-        const auto &voters = voter_set_->voters();
-
         // prepare VoteWeight which contains index of who has voted and what
         // kind of vote it was
-        VoteWeight v{voters.size()};
-        auto index = voter_set_->voterIndex(vote.id);
-        if (not index) {
-          logger_->warn("Voter {} is not known: {}", vote.id.toHex());
-          return false;
+        VoteWeight v{voter_set_->size()};
+        v.precommits[index.value()] = weight;
+        if (metrics_ != nullptr) {
+          metrics_->recordPrecommit();
         }
 
-        v.precommits[index.value()] = voter_set_->voterWeight(vote.id).value();
-
         if (auto inserted = graph_->insert(vote.message, v); not inserted) {
           logger_->warn("Vote {} was not inserted with error: {}",
                         vote.block_hash().toHex(),
@@ -334,12 +386,11 @@ namespace kagome::consensus::grandpa {
         return false;
       }
       case VoteTracker::PushResult::EQUIVOCATED: {
-        auto index = voter_set_->voterIndex(vote.id);
-        if (not index) {
-          logger_->warn("Voter {} is not known: {}", vote.id.toHex());
-          return false;
-        }
         precommit_equivocators_[index.value()] = true;
+        if (metrics_ != nullptr) {
+          metrics_->recordPrecommit();
+          metrics_->recordEquivocation();
+        }
         break;
       }
     }
@@ -451,6 +502,9 @@ namespace kagome::consensus::grandpa {
             if (not prevoted) {
               logger_->error("Prevote was not sent: {}",
                              prevoted.error().message());
+            } else if (metrics_ != nullptr) {
+              prevoted_at_ = clock_->now();
+              metrics_->recordPrevoted(*prevoted_at_ - start_time_);
             }
           }
           state_ = State::PREVOTED;
@@ -512,6 +566,13 @@ namespace kagome::consensus::grandpa {
                                precommitted.error().message());
                 break;
               }
+              if (metrics_ != nullptr) {
+                precommitted_at_ = clock_->now();
+                if (prevoted_at_) {
+                  metrics_->recordPrecommitted(*precommitted_at_
+                                               - *prevoted_at_);
+                }
+              }
               state_ = State::PRECOMMITTED;
               break;
             }
@@ -727,29 +788,28 @@ namespace kagome::consensus::grandpa {
 
   boost::optional<GrandpaJustification> VotingRoundImpl::finalizingPrecommits(
       const BlockInfo &estimate) const {
-    const auto &precommits = precommits_->getMessages();
-    GrandpaJustification justification = std::accumulate(
-        precommits.begin(),
-        precommits.end(),
-        GrandpaJustification{},
-        [this](GrandpaJustification &j, const auto &precommit_variant) {
+    GrandpaJustification justification;
+    precommits_->forEachMessage(
+        [&](const VoteTracker::VoteVariant &precommit_variant) {
           visit_in_place(
               precommit_variant,
-              [&j, this](const SignedMessage &voting_message) {
+              [&](const SignedMessage &voting_message) {
                 if (voting_message.is<Precommit>()
                     and env_->isEqualOrDescendOf(
                         cur_round_state_.finalized->block_hash,
                         voting_message.block_hash())) {
-                  j.items.push_back(voting_message);
+                  justification.items.push_back(voting_message);
                 }
               },
               [&](const VoteTracker::EquivocatoryVotingMessage
                       &equivocatory_voting_message) {
-                j.items.push_back(equivocatory_voting_message.first);
-                j.items.push_back(equivocatory_voting_message.second);
+                justification.items.push_back(
+                    equivocatory_voting_message.first);
+                justification.items.push_back(
+                    equivocatory_voting_message.second);
               });
-          return j;
         });
+    justification.round_number = round_number_;
     return justification;
   }
 
@@ -12,6 +12,7 @@
 #include <boost/signals2.hpp>
 
 #include "common/logger.hpp"
+#include "consensus/consensus_metrics.hpp"
 #include "consensus/grandpa/environment.hpp"
 #include "consensus/grandpa/grandpa_config.hpp"
 #include "consensus/grandpa/vote_crypto_provider.hpp"
@@ -27,6 +28,10 @@ namespace kagome::consensus::grandpa {
    public:
     ~VotingRoundImpl() override = default;
 
+    /**
+     * @param metrics records the stages of the round and the votes received,
+     * if any
+     */
     VotingRoundImpl(const GrandpaConfig &config,
                     std::shared_ptr<Environment> env,
                     std::shared_ptr<VoteCryptoProvider> vote_crypto_provider,
@@ -34,7 +39,8 @@ namespace kagome::consensus::grandpa {
                     std::shared_ptr<VoteTracker> precommits,
                     std::shared_ptr<VoteGraph> graph,
                     std::shared_ptr<Clock> clock,
-                    std::shared_ptr<boost::asio::io_context> io_context);
+                    std::shared_ptr<boost::asio::io_context> io_context,
+                    std::shared_ptr<ConsensusMetrics> metrics = nullptr);
 
     /**
      * Triggered when we receive finalization message
@@ -63,6 +69,10 @@ namespace kagome::consensus::grandpa {
      */
     void onPrecommit(const SignedMessage &precommit) override;
 
+    void onVerifiedPrevote(const SignedMessage &prevote) override;
+
+    void onVerifiedPrecommit(const SignedMessage &precommit) override;
+
     /**
      * Checks if current round is completable and finalized block differs from
      * the last round's finalized block. If so fin message is broadcasted to the
@@ -73,6 +83,8 @@ namespace kagome::consensus::grandpa {
 
     RoundNumber roundNumber() const override;
 
+    CatchUp catchUp() const override;
+
     /**
      * During the primary propose we :
      * 1. Check if we are the primary for the current round. If not execution of
@@ -119,8 +131,12 @@ namespace kagome::consensus::grandpa {
     /// Calculate threshold from the total weights of voters
     size_t getThreshold(const std::shared_ptr<VoterSet> &voters);
 
-    /// Triggered when we receive \param signed_prevote for the current peer
-    void onSignedPrevote(const SignedMessage &signed_prevote);
+    /**
+     * Triggered when we receive \param signed_prevote for the current peer
+     * @return false if the prevote is not accepted, so the state of the round
+     * is not changed by it
+     */
+    bool onSignedPrevote(const SignedMessage &signed_prevote);
 
     /// Triggered when we receive \param signed_precommit for the current peer
     bool onSignedPrecommit(const SignedMessage &signed_precommit);
@@ -192,6 +208,10 @@ namespace kagome::consensus::grandpa {
     std::shared_ptr<Clock> clock_;
 
     std::shared_ptr<boost::asio::io_context> io_context_;
+    std::shared_ptr<ConsensusMetrics> metrics_;
+    // when we prevoted and precommitted in the round, for the metrics
+    boost::optional<TimePoint> prevoted_at_;
+    boost::optional<TimePoint> precommitted_at_;
     Timer prevote_timer_;
     Timer precommit_timer_;
 
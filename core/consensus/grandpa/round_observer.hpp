@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_CONSENSUS_GRANDPA_ROUND_OBSERVER_HPP
 #define KAGOME_CORE_CONSENSUS_GRANDPA_ROUND_OBSERVER_HPP
 
+#include "consensus/grandpa/catch_up.hpp"
 #include "consensus/grandpa/structs.hpp"
 
 namespace kagome::consensus::grandpa {
@@ -28,6 +29,20 @@ namespace kagome::consensus::grandpa {
      * @param msg vote message
      */
     virtual void onVoteMessage(const VoteMessage &msg) = 0;
+
+    /**
+     * Handler of the vote messages of this peer, which it signed itself, so
+     * their signatures are not verified
+     * @param msg vote message
+     */
+    virtual void onOwnVoteMessage(const VoteMessage &msg) = 0;
+
+    /**
+     * Handler of grandpa catch-up messages: the neighbor packets, the
+     * catch-up requests and the catch-ups
+     * @param msg catch-up message
+     */
+    virtual void onCatchUpMessage(const CatchUpMessage &msg) = 0;
   };
 
 }  // namespace kagome::consensus::grandpa
@@ -115,6 +115,10 @@ namespace kagome::consensus::grandpa {
   // justification that contains a list of signed precommits justifying the
   // validity of the block
   struct GrandpaJustification {
+    // the round the precommits are signed in, which is a part of the signed
+    // payload; it is not encoded with the precommits, but taken from the
+    // message carrying them or stored next to them
+    RoundNumber round_number{0};
     std::vector<SignedMessage> items;
   };
 
@@ -130,6 +134,34 @@ namespace kagome::consensus::grandpa {
     return s >> v.items;
   }
 
+  /**
+   * Justification as it is stored with the finalized block and sent to the
+   * syncing peers: the encoded justification followed by its round, which
+   * the nodes unaware of it do not read. The justifications stored before
+   * have no round
+   */
+  struct StoredJustification {
+    GrandpaJustification justification;
+    bool has_round = false;
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const StoredJustification &v) {
+    return s << v.justification << v.justification.round_number;
+  }
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, StoredJustification &v) {
+    s >> v.justification;
+    v.has_round = s.hasMore(sizeof(RoundNumber));
+    if (v.has_round) {
+      s >> v.justification.round_number;
+    }
+    return s;
+  }
+
   /// A commit message which is an aggregate of precommits.
   struct Commit {
     BlockInfo vote;
@@ -145,19 +177,9 @@ namespace kagome::consensus::grandpa {
     Id id() const {
       return vote.id;
     }
-  };
 
-  template <class Stream,
-            typename = std::enable_if_t<Stream::is_encoder_stream>>
-  Stream &operator<<(Stream &s, const VoteMessage &v) {
-    return s << v.round_number << v.counter << v.vote;
-  }
-
-  template <class Stream,
-            typename = std::enable_if_t<Stream::is_decoder_stream>>
-  Stream &operator>>(Stream &s, VoteMessage &v) {
-    return s >> v.round_number >> v.counter >> v.vote;
-  }
+    SCALE_FIELDS(round_number, counter, vote)
+  };
 
   // finalizing message
   struct Fin {
@@ -175,7 +197,9 @@ namespace kagome::consensus::grandpa {
   template <class Stream,
             typename = std::enable_if_t<Stream::is_decoder_stream>>
   Stream &operator>>(Stream &s, Fin &f) {
-    return s >> f.round_number >> f.vote >> f.justification;
+    s >> f.round_number >> f.vote >> f.justification;
+    f.justification.round_number = f.round_number;
+    return s;
   }
 
   using PrevoteEquivocation = detail::Equivocation<Prevote>;
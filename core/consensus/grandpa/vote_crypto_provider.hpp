@@ -6,6 +6,10 @@
 #ifndef KAGOME_CORE_CONSENSUS_GRANDPA_VOTE_CRYPTO_PROVIDER_HPP
 #define KAGOME_CORE_CONSENSUS_GRANDPA_VOTE_CRYPTO_PROVIDER_HPP
 
+#include <vector>
+
+#include <gsl/span>
+
 #include "consensus/grandpa/structs.hpp"
 
 namespace kagome::consensus::grandpa {
@@ -22,6 +26,14 @@ namespace kagome::consensus::grandpa {
     virtual bool verifyPrevote(const SignedMessage &prevote) const = 0;
     virtual bool verifyPrecommit(const SignedMessage &precommit) const = 0;
 
+    /**
+     * Verifies the signatures of \arg votes of any kinds at once, which is
+     * faster than one by one for the many votes of a justification
+     * @return whether each of them is valid, in the order of the votes
+     */
+    virtual std::vector<bool> verifyVotes(
+        gsl::span<const SignedMessage> votes) const = 0;
+
     virtual SignedMessage signPrimaryPropose(
         const PrimaryPropose &primary_propose) const = 0;
     virtual SignedMessage signPrevote(const Prevote &prevote) const = 0;
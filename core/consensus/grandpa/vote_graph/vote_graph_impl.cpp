@@ -233,21 +233,19 @@ namespace kagome::consensus::grandpa {
       }
     }
 
-    Entry active_node = entries_.at(node_key);
-    if (!condition(active_node.cumulative_vote)) {
+    // the entries are visited in place, without copying their ancestry
+    const Entry *active_node = &entries_.at(node_key);
+    if (!condition(active_node->cumulative_vote)) {
       return boost::none;
     }
 
-    std::deque<std::reference_wrapper<const Entry>> observing_entries;
-
-    auto start_node = active_node;
-    observing_entries.emplace_back(start_node);
+    std::deque<const Entry *> observing_entries{active_node};
 
     while (not observing_entries.empty()) {
-      auto &entry = observing_entries.front().get();
+      const Entry *entry = observing_entries.front();
       observing_entries.pop_front();
 
-      for (auto &descendent_hash : entry.descendents) {
+      for (auto &descendent_hash : entry->descendents) {
         auto &descendent = entries_.at(descendent_hash);
 
         if (force_constrain && current_best) {
@@ -261,13 +259,14 @@ namespace kagome::consensus::grandpa {
           continue;
         }
 
-        if (descendent.number > active_node.number
-            or (descendent.number == active_node.number
-                and descendent.cumulative_vote > active_node.cumulative_vote)) {
+        if (descendent.number > active_node->number
+            or (descendent.number == active_node->number
+                and descendent.cumulative_vote
+                        > active_node->cumulative_vote)) {
           node_key = descendent_hash;
-          active_node = descendent;
+          active_node = &descendent;
 
-          observing_entries.emplace_back(descendent);
+          observing_entries.push_back(&descendent);
         }
       }
 
@@ -278,7 +277,7 @@ namespace kagome::consensus::grandpa {
         force_constrain ? current_best : boost::none;
 
     Subchain subchain =
-        ghostFindMergePoint(node_key, active_node, info, condition);
+        ghostFindMergePoint(node_key, *active_node, info, condition);
     auto &h = subchain.hashes;
 
     if (h.empty()) {
@@ -313,7 +312,9 @@ namespace kagome::consensus::grandpa {
     size_t offset = 0;
     while (true) {
       boost::optional<BlockHash> new_best;
-      boost::optional<VoteWeight> new_best_vote_weight;
+      // points to the weight in descendent_blocks, which keeps the references
+      // valid on insertion
+      const VoteWeight *new_best_vote_weight = nullptr;
 
       ++offset;
       for (const auto &d_node : descendents) {
@@ -324,20 +325,19 @@ namespace kagome::consensus::grandpa {
         }
 
         BlockHash &d_block = *ancestorOpt;
-        auto it = descendent_blocks.find(d_block);
-        if (it == descendent_blocks.end()) {
-          // if not found, insert then
-          descendent_blocks[d_block] = entry.cumulative_vote;
-        } else {
+        auto [it, inserted] =
+            descendent_blocks.emplace(d_block, entry.cumulative_vote);
+        if (not inserted) {
           // if found, update weight
-          descendent_blocks[d_block] += entry.cumulative_vote;
+          auto &weight = it->second;
+          weight += entry.cumulative_vote;
           // check if block fullfills condition
-          if (condition(descendent_blocks[d_block])) {
-            if (not new_best_vote_weight
-                or new_best_vote_weight < descendent_blocks[d_block]) {
+          if (condition(weight)) {
+            if (new_best_vote_weight == nullptr
+                or *new_best_vote_weight < weight) {
               // we found our best block
               new_best = d_block;
-              new_best_vote_weight = descendent_blocks[d_block];
+              new_best_vote_weight = &weight;
             }
           }
         }
@@ -393,7 +393,7 @@ namespace kagome::consensus::grandpa {
     // chain.
     // the `node_key` always points to the ancestor node, and the
     // `canonical_node` points to the higher node.
-    boost::optional<Entry> canonical_node = boost::none;
+    const Entry *canonical_node = nullptr;
     BlockHash node_key;
 
     auto nodesOpt = findContainingNodes(block);
@@ -408,7 +408,7 @@ namespace kagome::consensus::grandpa {
         return boost::none;
       }
 
-      canonical_node = entry;
+      canonical_node = &entry;
       node_key = *ancestorIt;
     } else {
       auto &nodes = *nodesOpt;
@@ -416,38 +416,37 @@ namespace kagome::consensus::grandpa {
         return boost::none;
       }
 
-      const Entry entry = entries_.at(nodes[0]);
+      const Entry &entry = entries_.at(nodes[0]);
       auto ancIt = std::rbegin(entry.ancestors);
       BOOST_ASSERT_MSG(
           ancIt != std::rend(entry.ancestors),
           "node containing block in ancestry has ancestor node; qed");
 
-      canonical_node = entry;
+      canonical_node = &entry;
       node_key = *ancIt;
     }
 
-    BOOST_ASSERT(canonical_node != boost::none);
+    BOOST_ASSERT(canonical_node != nullptr);
 
     // search backwards until we find the first vote-node that
     // meets the condition.
-    Entry active_node = entries_.at(node_key);
-    while (!condition(active_node.cumulative_vote)) {
-      auto ancestorIt = active_node.ancestors.rbegin();
-      if (ancestorIt == active_node.ancestors.rend()) {
+    const Entry *active_node = &entries_.at(node_key);
+    while (!condition(active_node->cumulative_vote)) {
+      auto ancestorIt = active_node->ancestors.rbegin();
+      if (ancestorIt == active_node->ancestors.rend()) {
         return boost::none;
       }
 
       node_key = *ancestorIt;
       canonical_node = active_node;
-      active_node = entries_.at(node_key);
+      active_node = &entries_.at(node_key);
     }
 
     // find the GHOST merge-point after the active_node.
     // constrain it to be within the canonical chain.
     auto good_subchain =
-        ghostFindMergePoint(node_key, active_node, boost::none, condition);
+        ghostFindMergePoint(node_key, *active_node, boost::none, condition);
 
-    BOOST_ASSERT(canonical_node);
     // search in reverse order
     auto &hashes = good_subchain.hashes;
     auto bestHashIt =
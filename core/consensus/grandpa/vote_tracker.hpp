@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_CONSENSUS_GRANDPA_VOTE_TRACKER_HPP
 #define KAGOME_CORE_CONSENSUS_GRANDPA_VOTE_TRACKER_HPP
 
+#include <functional>
+
 #include "consensus/grandpa/structs.hpp"
 
 namespace kagome::consensus::grandpa {
@@ -41,6 +43,13 @@ namespace kagome::consensus::grandpa {
      */
     virtual std::vector<VoteVariant> getMessages() const = 0;
 
+    /**
+     * Calls \arg callback with each of accepted (non-duplicate) messages,
+     * without copying them
+     */
+    virtual void forEachMessage(
+        const std::function<void(const VoteVariant &)> &callback) const = 0;
+
     /**
      * @returns total weight of all accepted (non-duplicate) messages
      */
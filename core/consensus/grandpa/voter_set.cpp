@@ -10,17 +10,18 @@ namespace kagome::consensus::grandpa {
   VoterSet::VoterSet(MembershipCounter id_of_set) : id_{id_of_set} {}
 
   void VoterSet::insert(Id voter, size_t weight) {
-    voters_.push_back(voter);
-    weight_map_.insert({voter, weight});
+    index_map_.emplace(voter, voters_.size());
+    weights_.push_back(weight_map_.emplace(voter, weight).first->second);
+    voters_.push_back(std::move(voter));
     total_weight_ += weight;
   }
 
   boost::optional<size_t> VoterSet::voterIndex(const Id &voter) const {
-    auto it = std::find(voters_.begin(), voters_.end(), voter);
-    if (it == voters_.end()) {
+    auto it = index_map_.find(voter);
+    if (it == index_map_.end()) {
       return boost::none;
     }
-    return std::distance(voters_.begin(), it);
+    return it->second;
   }
 
   boost::optional<size_t> VoterSet::voterWeight(const Id &voter) const {
@@ -35,7 +36,7 @@ namespace kagome::consensus::grandpa {
     if (voter_index >= voters_.size()) {
       return boost::none;
     }
-    return weight_map_.at(voters_[voter_index]);
+    return weights_[voter_index];
   }
 
 }  // namespace kagome::consensus::grandpa
@@ -77,6 +77,10 @@ namespace kagome::consensus::grandpa {
     std::vector<Id> voters_;
     MembershipCounter id_{};
     std::unordered_map<Id, size_t> weight_map_;
+    // index of the first occurrence of each voter in voters_
+    std::unordered_map<Id, size_t> index_map_;
+    // weights of voters_ by index
+    std::vector<size_t> weights_;
     size_t total_weight_{0};
   };
 
@@ -26,6 +26,13 @@ namespace kagome::consensus::grandpa {
 
     virtual void onPrecommit(const SignedMessage &precommit) = 0;
 
+    /// Same as onPrevote for \arg prevote, which signature is verified already
+    virtual void onVerifiedPrevote(const SignedMessage &prevote) = 0;
+
+    /// Same as onPrecommit for \arg precommit, which signature is verified
+    /// already
+    virtual void onVerifiedPrecommit(const SignedMessage &precommit) = 0;
+
     virtual void primaryPropose(const RoundState &last_round_state) = 0;
 
     virtual void prevote(const RoundState &last_round_state) = 0;
@@ -36,6 +43,12 @@ namespace kagome::consensus::grandpa {
     virtual bool tryFinalize() = 0;
 
     virtual RoundNumber roundNumber() const = 0;
+
+    /**
+     * @return the votes accepted in the round along with its state, which
+     * prove the state to the lagging peers
+     */
+    virtual CatchUp catchUp() const = 0;
   };
 
 }  // namespace kagome::consensus::grandpa
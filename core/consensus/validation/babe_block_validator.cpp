@@ -6,6 +6,7 @@
 #include "consensus/validation/babe_block_validator.hpp"
 
 #include <algorithm>
+
 #include <boost/assert.hpp>
 
 #include "common/mp_utils.hpp"
@@ -40,12 +41,14 @@ namespace kagome::consensus {
       std::shared_ptr<runtime::TaggedTransactionQueue> tx_queue,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::VRFProvider> vrf_provider,
-      std::shared_ptr<crypto::SR25519Provider> sr25519_provider)
+      std::shared_ptr<crypto::SR25519Provider> sr25519_provider,
+      std::shared_ptr<common::WorkerPool> workers)
       : block_tree_{std::move(block_tree)},
         tx_queue_{std::move(tx_queue)},
         hasher_{std::move(hasher)},
         vrf_provider_{std::move(vrf_provider)},
         sr25519_provider_{std::move(sr25519_provider)},
+        workers_{std::move(workers)},
         log_{common::createLogger("BabeBlockValidator")} {
     BOOST_ASSERT(block_tree_);
     BOOST_ASSERT(tx_queue_);
@@ -77,6 +80,15 @@ namespace kagome::consensus {
       const primitives::AuthorityId &authority_id,
       const Threshold &threshold,
       const Randomness &randomness) const {
+    OUTCOME_TRY(validateSeal(header, authority_id, threshold, randomness));
+    return validateProducer(header);
+  }
+
+  outcome::result<void> BabeBlockValidator::validateSeal(
+      const primitives::BlockHeader &header,
+      const primitives::AuthorityId &authority_id,
+      const Threshold &threshold,
+      const Randomness &randomness) const {
     log_->debug("Validates block signed by authority: {}",
                 authority_id.id.toHex());
 
@@ -93,6 +105,69 @@ namespace kagome::consensus {
     if (!verifyVRF(babe_header, authority_id.id, threshold, randomness)) {
       return ValidationError::INVALID_VRF;
     }
+    return outcome::success();
+  }
+
+  std::vector<outcome::result<void>> BabeBlockValidator::validateSeals(
+      gsl::span<const SealValidation> batch) const {
+    auto size = static_cast<size_t>(batch.size());
+    std::vector<outcome::result<void>> results(size, outcome::success());
+    struct Signed {
+      Seal seal;
+      primitives::BlockHash unsealed_hash;
+      bool vrf_valid = false;
+    };
+    std::vector<Signed> signed_headers(size);
+
+    // the headers are independent, so they are validated by the workers
+    auto validate = [&](size_t i) {
+      const auto &item = batch[i];
+      auto babe_digests = getBabeDigests(item.header.get());
+      if (not babe_digests) {
+        results[i] = babe_digests.error();
+        return;
+      }
+      const auto &[seal, babe_header] = babe_digests.value();
+      auto &signed_header = signed_headers[i];
+      signed_header.seal = seal;
+      signed_header.unsealed_hash = unsealedHash(item.header.get());
+      signed_header.vrf_valid = verifyVRF(
+          babe_header, item.authority_id.id, item.threshold, item.randomness);
+    };
+    if (workers_ != nullptr) {
+      workers_->parallelFor(size, validate);
+    } else {
+      for (size_t i = 0; i < size; ++i) {
+        validate(i);
+      }
+    }
+
+    std::vector<size_t> indices;
+    std::vector<crypto::SR25519Verification> signatures;
+    for (size_t i = 0; i < size; ++i) {
+      if (results[i]) {
+        indices.push_back(i);
+        signatures.push_back({signed_headers[i].seal.signature,
+                              signed_headers[i].unsealed_hash,
+                              batch[i].authority_id.id});
+      }
+    }
+    auto signatures_valid = sr25519_provider_->verifyBatch(signatures);
+    for (size_t j = 0; j < indices.size(); ++j) {
+      auto i = indices[j];
+      if (not signatures_valid[j]) {
+        results[i] = ValidationError::INVALID_SIGNATURE;
+      } else if (not signed_headers[i].vrf_valid) {
+        results[i] = ValidationError::INVALID_VRF;
+      }
+    }
+    return results;
+  }
+
+  outcome::result<void> BabeBlockValidator::validateProducer(
+      const primitives::BlockHeader &header) const {
+    OUTCOME_TRY(babe_digests, getBabeDigests(header));
+    auto [seal, babe_header] = babe_digests;
 
     // peer must not send two blocks in one slot
     if (!verifyProducer(babe_header)) {
@@ -108,12 +183,7 @@ namespace kagome::consensus {
       const primitives::SessionKey &public_key) const {
     // firstly, take hash of the block's header without Seal, which is the last
     // digest
-    auto unsealed_header = header;
-    unsealed_header.digest.pop_back();
-
-    auto unsealed_header_encoded = scale::encode(unsealed_header).value();
-
-    auto block_hash = hasher_->blake2b_256(unsealed_header_encoded);
+    auto block_hash = unsealedHash(header);
 
     // secondly, use verify function to check the signature
     auto res =
@@ -121,6 +191,16 @@ namespace kagome::consensus {
     return res && res.value();
   }
 
+  primitives::BlockHash BabeBlockValidator::unsealedHash(
+      const primitives::BlockHeader &header) const {
+    auto unsealed_header = header;
+    unsealed_header.digest.pop_back();
+
+    auto unsealed_header_encoded = scale::encode(unsealed_header).value();
+
+    return hasher_->blake2b_256(unsealed_header_encoded);
+  }
+
   bool BabeBlockValidator::verifyVRF(const BabeBlockHeader &babe_header,
                                      const primitives::SessionKey &public_key,
                                      const Threshold &threshold,
@@ -13,6 +13,7 @@
 
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
+#include "common/worker_pool.hpp"
 #include "consensus/babe/types/babe_block_header.hpp"
 #include "consensus/babe/types/seal.hpp"
 #include "consensus/validation/block_validator.hpp"
@@ -40,13 +41,16 @@ namespace kagome::consensus {
      * @param tx_queue to validate the extrinsics
      * @param hasher to take hashes
      * @param vrf_provider for VRF-specific operations
+     * @param sr25519_provider to verify the seals
+     * @param workers to validate the batches of seals in parallel, if any
      */
     BabeBlockValidator(
         std::shared_ptr<blockchain::BlockTree> block_tree,
         std::shared_ptr<runtime::TaggedTransactionQueue> tx_queue,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::VRFProvider> vrf_provider,
-        std::shared_ptr<crypto::SR25519Provider> sr25519_provider);
+        std::shared_ptr<crypto::SR25519Provider> sr25519_provider,
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     enum class ValidationError {
       NO_AUTHORITIES = 1,
@@ -68,7 +72,30 @@ namespace kagome::consensus {
         const Threshold &threshold,
         const Randomness &randomness) const override;
 
+    outcome::result<void> validateSeal(
+        const primitives::BlockHeader &header,
+        const primitives::AuthorityId &authority_id,
+        const Threshold &threshold,
+        const Randomness &randomness) const override;
+
+    /**
+     * Extracts the digests and verifies the VRFs of the headers on the
+     * workers, then verifies their signatures as a batch
+     */
+    std::vector<outcome::result<void>> validateSeals(
+        gsl::span<const SealValidation> batch) const override;
+
+    outcome::result<void> validateProducer(
+        const primitives::BlockHeader &header) const override;
+
    private:
+    /**
+     * @return hash of \arg header without the seal, which is the last digest,
+     * the one the seal signs
+     */
+    primitives::BlockHash unsealedHash(
+        const primitives::BlockHeader &header) const;
+
     /**
      * Verify that block is signed by valid signature
      * @param header Header to be checked
@@ -124,6 +151,7 @@ namespace kagome::consensus {
 
     std::shared_ptr<crypto::VRFProvider> vrf_provider_;
     std::shared_ptr<crypto::SR25519Provider> sr25519_provider_;
+    std::shared_ptr<common::WorkerPool> workers_;
 
     common::Logger log_;
   };
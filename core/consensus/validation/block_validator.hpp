@@ -6,11 +6,26 @@
 #ifndef KAGOME_BLOCK_VALIDATOR_HPP
 #define KAGOME_BLOCK_VALIDATOR_HPP
 
+#include <functional>
+#include <vector>
+
+#include <gsl/span>
 #include <outcome/outcome.hpp>
 #include "consensus/babe/types/epoch.hpp"
 #include "primitives/block.hpp"
 
 namespace kagome::consensus {
+  /**
+   * Seal of a block header to be validated along with the data of the epoch
+   * of the block, the header has to stay valid until the seal is validated
+   */
+  struct SealValidation {
+    std::reference_wrapper<const primitives::BlockHeader> header;
+    primitives::AuthorityId authority_id;
+    Threshold threshold;
+    Randomness randomness;
+  };
+
   /**
    * Validator of the blocks
    */
@@ -45,6 +60,50 @@ namespace kagome::consensus {
         const primitives::AuthorityId &authority_id,
         const Threshold &threshold,
         const Randomness &randomness) const = 0;
+
+    /**
+     * Validate the signature and the VRF of the block header, which is the
+     * part of validateHeader that keeps no state, so that the headers may be
+     * validated concurrently
+     * @param block_header to be validated
+     * @param authority_id authority that sent this block
+     * @param threshold is vrf threshold for this epoch
+     * @param randomness is randomness used in this epoch
+     * @return nothing or validation error
+     */
+    virtual outcome::result<void> validateSeal(
+        const primitives::BlockHeader &block_header,
+        const primitives::AuthorityId &authority_id,
+        const Threshold &threshold,
+        const Randomness &randomness) const = 0;
+
+    /**
+     * Validate the seals of \arg batch, the same as validateSeal does for
+     * each of them
+     * @return results of the validations, in the order of the batch
+     */
+    virtual std::vector<outcome::result<void>> validateSeals(
+        gsl::span<const SealValidation> batch) const {
+      std::vector<outcome::result<void>> results;
+      results.reserve(batch.size());
+      for (const auto &item : batch) {
+        results.emplace_back(validateSeal(item.header.get(),
+                                          item.authority_id,
+                                          item.threshold,
+                                          item.randomness));
+      }
+      return results;
+    }
+
+    /**
+     * Validate that the producer of the block header has produced no other
+     * block in its slot, and memorize the block. Together with validateSeal
+     * is the same as validateHeader
+     * @param block_header to be validated
+     * @return nothing or validation error
+     */
+    virtual outcome::result<void> validateProducer(
+        const primitives::BlockHeader &block_header) const = 0;
   };
 }  // namespace kagome::consensus
 
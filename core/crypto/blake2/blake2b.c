@@ -8,6 +8,8 @@
 
 #include "blake2b.h"
 
+#include <string.h>
+
 // Cyclic right rotation.
 
 #ifndef ROTR64
@@ -46,54 +48,243 @@ static const uint64_t blake2b_iv[8] = {0x6A09E667F3BCC908, 0xBB67AE8584CAA73B,
                                        0x510E527FADE682D1, 0x9B05688C2B3E6C1F,
                                        0x1F83D9ABFB41BD6B, 0x5BE0CD19137E2179};
 
-// Compression function. "last" flag indicates last block.
-
-static void blake2b_compress(blake2b_ctx *ctx, int last) {
-  const uint8_t sigma[12][16] = {
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
-      {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
-      {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
-      {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
-      {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
-      {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
-      {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
-      {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
-      {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+// Message schedule.
+
+static const uint8_t blake2b_sigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+// Compression of a 128-byte "block" into the state "h" with the byte
+// counter "t". "last" flag indicates last block.
+
+typedef void (*blake2b_compress_fn)(uint64_t h[8], const uint8_t *block,
+                                    const uint64_t t[2], int last);
+
+static void blake2b_compress_portable(uint64_t h[8], const uint8_t *block,
+                                      const uint64_t t[2], int last) {
   int i;
   uint64_t v[16];
   uint64_t m[16];
 
   for (i = 0; i < 8; i++) {  // init work variables
-    v[i] = ctx->h[i];
+    v[i] = h[i];
     v[i + 8] = blake2b_iv[i];
   }
 
-  v[12] ^= ctx->t[0];  // low 64 bits of offset
-  v[13] ^= ctx->t[1];  // high 64 bits
-  if (last) {          // last block flag set ?
+  v[12] ^= t[0];  // low 64 bits of offset
+  v[13] ^= t[1];  // high 64 bits
+  if (last) {     // last block flag set ?
     v[14] = ~v[14];
   }
 
   for (i = 0; i < 16; i++) {  // get little-endian words
-    m[i] = B2B_GET64(&ctx->b[8 * i]);
+    m[i] = B2B_GET64(&block[8 * i]);
   }
 
   for (i = 0; i < 12; i++) {  // twelve rounds
-    B2B_G(0, 4, 8, 12, m[sigma[i][0]], m[sigma[i][1]]);
-    B2B_G(1, 5, 9, 13, m[sigma[i][2]], m[sigma[i][3]]);
-    B2B_G(2, 6, 10, 14, m[sigma[i][4]], m[sigma[i][5]]);
-    B2B_G(3, 7, 11, 15, m[sigma[i][6]], m[sigma[i][7]]);
-    B2B_G(0, 5, 10, 15, m[sigma[i][8]], m[sigma[i][9]]);
-    B2B_G(1, 6, 11, 12, m[sigma[i][10]], m[sigma[i][11]]);
-    B2B_G(2, 7, 8, 13, m[sigma[i][12]], m[sigma[i][13]]);
-    B2B_G(3, 4, 9, 14, m[sigma[i][14]], m[sigma[i][15]]);
+    const uint8_t *sigma = blake2b_sigma[i];
+    B2B_G(0, 4, 8, 12, m[sigma[0]], m[sigma[1]]);
+    B2B_G(1, 5, 9, 13, m[sigma[2]], m[sigma[3]]);
+    B2B_G(2, 6, 10, 14, m[sigma[4]], m[sigma[5]]);
+    B2B_G(3, 7, 11, 15, m[sigma[6]], m[sigma[7]]);
+    B2B_G(0, 5, 10, 15, m[sigma[8]], m[sigma[9]]);
+    B2B_G(1, 6, 11, 12, m[sigma[10]], m[sigma[11]]);
+    B2B_G(2, 7, 8, 13, m[sigma[12]], m[sigma[13]]);
+    B2B_G(3, 4, 9, 14, m[sigma[14]], m[sigma[15]]);
   }
 
   for (i = 0; i < 8; ++i) {
-    ctx->h[i] ^= v[i] ^ v[i + 8];
+    h[i] ^= v[i] ^ v[i + 8];
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define B2B_X86_KERNELS
+
+#include <immintrin.h>
+
+// The four rows of the work variables are kept in 256-bit registers, so
+// that the four G functions of a column or a diagonal step run at once.
+// The kernels are compiled for their instruction sets with the target
+// attribute and selected by the CPU the code runs on, so the library is
+// built for the baseline x86-64.
+
+#define B2B_SIMD_MSG(m, s, i0, i1, i2, i3) \
+  _mm256_set_epi64x((int64_t)(m)[(s)[i3]], \
+                    (int64_t)(m)[(s)[i2]], \
+                    (int64_t)(m)[(s)[i1]], \
+                    (int64_t)(m)[(s)[i0]])
+
+#define B2B_SIMD_G(row1, row2, row3, row4, x, y, ROTR)                  \
+  {                                                                     \
+    row1 = _mm256_add_epi64(_mm256_add_epi64(row1, row2), x);           \
+    row4 = ROTR(_mm256_xor_si256(row4, row1), 32);                      \
+    row3 = _mm256_add_epi64(row3, row4);                                \
+    row2 = ROTR(_mm256_xor_si256(row2, row3), 24);                      \
+    row1 = _mm256_add_epi64(_mm256_add_epi64(row1, row2), y);           \
+    row4 = ROTR(_mm256_xor_si256(row4, row1), 16);                      \
+    row3 = _mm256_add_epi64(row3, row4);                                \
+    row2 = ROTR(_mm256_xor_si256(row2, row3), 63);                      \
+  }
+
+// lane i of row2, row3 and row4 is moved to lane i - 1, i - 2 and i - 3,
+// so that the diagonals become the columns, and back
+#define B2B_SIMD_DIAGONALIZE(row2, row3, row4)                         \
+  {                                                                    \
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0, 3, 2, 1));    \
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2));    \
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2, 1, 0, 3));    \
+  }
+#define B2B_SIMD_UNDIAGONALIZE(row2, row3, row4)                       \
+  {                                                                    \
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2, 1, 0, 3));    \
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1, 0, 3, 2));    \
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0, 3, 2, 1));    \
+  }
+
+#define B2B_SIMD_COMPRESS(h, block, t, last, ROTR)                          \
+  {                                                                         \
+    int i;                                                                  \
+    uint64_t m[16];                                                         \
+    __m256i row1, row2, row3, row4;                                         \
+    const __m256i h_lo = _mm256_loadu_si256((const __m256i *)&(h)[0]);     \
+    const __m256i h_hi = _mm256_loadu_si256((const __m256i *)&(h)[4]);     \
+                                                                            \
+    memcpy(m, block, sizeof(m));                                            \
+    row1 = h_lo;                                                            \
+    row2 = h_hi;                                                            \
+    row3 = _mm256_loadu_si256((const __m256i *)&blake2b_iv[0]);            \
+    row4 = _mm256_xor_si256(                                                \
+        _mm256_loadu_si256((const __m256i *)&blake2b_iv[4]),               \
+        _mm256_set_epi64x(0, (last) ? -1 : 0, (int64_t)(t)[1],              \
+                          (int64_t)(t)[0]));                                \
+                                                                            \
+    for (i = 0; i < 12; i++) {                                              \
+      const uint8_t *s = blake2b_sigma[i];                                  \
+      B2B_SIMD_G(row1, row2, row3, row4,                                    \
+                 B2B_SIMD_MSG(m, s, 0, 2, 4, 6),                            \
+                 B2B_SIMD_MSG(m, s, 1, 3, 5, 7), ROTR);                     \
+      B2B_SIMD_DIAGONALIZE(row2, row3, row4);                               \
+      B2B_SIMD_G(row1, row2, row3, row4,                                    \
+                 B2B_SIMD_MSG(m, s, 8, 10, 12, 14),                         \
+                 B2B_SIMD_MSG(m, s, 9, 11, 13, 15), ROTR);                  \
+      B2B_SIMD_UNDIAGONALIZE(row2, row3, row4);                             \
+    }                                                                       \
+                                                                            \
+    _mm256_storeu_si256((__m256i *)&(h)[0],                                 \
+                        _mm256_xor_si256(h_lo, _mm256_xor_si256(row1, row3))); \
+    _mm256_storeu_si256((__m256i *)&(h)[4],                                 \
+                        _mm256_xor_si256(h_hi, _mm256_xor_si256(row2, row4))); \
+  }
+
+// AVX2 has no 64-bit rotations, which are made of byte shuffles where
+// possible
+__attribute__((target("avx2"))) static inline __m256i b2b_rotr_avx2(
+    __m256i x, int n) {
+  switch (n) {
+    case 32:
+      return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    case 24:
+      return _mm256_shuffle_epi8(
+          x,
+          _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9,
+                           10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8,
+                           9, 10));
+    case 16:
+      return _mm256_shuffle_epi8(
+          x,
+          _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8,
+                           9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15,
+                           8, 9));
+    default:  // 63
+      return _mm256_or_si256(_mm256_srli_epi64(x, 63),
+                             _mm256_add_epi64(x, x));
+  }
+}
+
+__attribute__((target("avx2"))) static void blake2b_compress_avx2(
+    uint64_t h[8], const uint8_t *block, const uint64_t t[2], int last) {
+  B2B_SIMD_COMPRESS(h, block, t, last, b2b_rotr_avx2);
+}
+
+// AVX-512VL rotates 64-bit lanes of 256-bit registers in one instruction
+#define B2B_ROTR_AVX512(x, n) _mm256_ror_epi64(x, n)
+
+__attribute__((target("avx2,avx512f,avx512vl"))) static void
+blake2b_compress_avx512(uint64_t h[8], const uint8_t *block,
+                        const uint64_t t[2], int last) {
+  B2B_SIMD_COMPRESS(h, block, t, last, B2B_ROTR_AVX512);
+}
+
+#endif  // B2B_X86_KERNELS
+
+// the kernel used, chosen on the first compression
+static blake2b_compress_fn blake2b_compress_impl = NULL;
+
+static blake2b_compress_fn blake2b_kernel(blake2b_impl impl) {
+  switch (impl) {
+    case BLAKE2B_IMPL_PORTABLE:
+      return blake2b_compress_portable;
+#ifdef B2B_X86_KERNELS
+    case BLAKE2B_IMPL_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? blake2b_compress_avx2 : NULL;
+    case BLAKE2B_IMPL_AVX512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f")
+                     && __builtin_cpu_supports("avx512vl")
+                 ? blake2b_compress_avx512
+                 : NULL;
+#endif
+    case BLAKE2B_IMPL_AUTO: {
+      blake2b_compress_fn fn = blake2b_kernel(BLAKE2B_IMPL_AVX512);
+      if (fn == NULL) {
+        fn = blake2b_kernel(BLAKE2B_IMPL_AVX2);
+      }
+      return fn != NULL ? fn : blake2b_compress_portable;
+    }
+    default:
+      return NULL;
+  }
+}
+
+int blake2b_use_impl(blake2b_impl impl) {
+  blake2b_compress_fn fn = blake2b_kernel(impl);
+  if (fn == NULL) {
+    return -1;
+  }
+  __atomic_store_n(&blake2b_compress_impl, fn, __ATOMIC_RELAXED);
+  return 0;
+}
+
+static void blake2b_compress(blake2b_ctx *ctx, const uint8_t *block,
+                             int last) {
+  // the selection is idempotent, so racing threads agree on the kernel
+  blake2b_compress_fn fn =
+      __atomic_load_n(&blake2b_compress_impl, __ATOMIC_RELAXED);
+  if (fn == NULL) {
+    fn = blake2b_kernel(BLAKE2B_IMPL_AUTO);
+    __atomic_store_n(&blake2b_compress_impl, fn, __ATOMIC_RELAXED);
+  }
+  fn(ctx->h, block, ctx->t, last);
+}
+
+// Add "len" to the counter of the bytes hashed.
+
+static void blake2b_increment(blake2b_ctx *ctx, size_t len) {
+  ctx->t[0] += len;
+  if (ctx->t[0] < len) {  // carry overflow ?
+    ctx->t[1]++;          // high word
   }
 }
 
@@ -136,19 +327,31 @@ int blake2b_init(blake2b_ctx *ctx, size_t outlen, const void *key,
 void blake2b_update(blake2b_ctx *ctx, const void *in,
                     size_t inlen)  // data bytes
 {
-  size_t i;
+  const uint8_t *bytes = (const uint8_t *)in;
+  size_t fill;
 
-  for (i = 0; i < inlen; i++) {
-    if (ctx->c == 128) {         // buffer full ?
-      ctx->t[0] += ctx->c;       // add counters
-      if (ctx->t[0] < ctx->c) {  // carry overflow ?
-        ctx->t[1]++;             // high word
-      }
-      blake2b_compress(ctx, 0);  // compress (not last)
-      ctx->c = 0;                // counter to zero
+  if (inlen == 0) {
+    return;
+  }
+  // the last block is kept in the buffer until the final one, as it is
+  // compressed with the flag
+  fill = 128 - ctx->c;
+  if (inlen > fill) {
+    memcpy(ctx->b + ctx->c, bytes, fill);  // complete the buffer
+    blake2b_increment(ctx, 128);
+    blake2b_compress(ctx, ctx->b, 0);  // compress (not last)
+    ctx->c = 0;
+    bytes += fill;
+    inlen -= fill;
+    while (inlen > 128) {  // whole blocks are compressed in place
+      blake2b_increment(ctx, 128);
+      blake2b_compress(ctx, bytes, 0);
+      bytes += 128;
+      inlen -= 128;
     }
-    ctx->b[ctx->c++] = ((const uint8_t *)in)[i];
   }
+  memcpy(ctx->b + ctx->c, bytes, inlen);
+  ctx->c += inlen;
 }
 
 // Generate the message digest (size given in init).
@@ -157,15 +360,12 @@ void blake2b_update(blake2b_ctx *ctx, const void *in,
 void blake2b_final(blake2b_ctx *ctx, void *out) {
   size_t i;
 
-  ctx->t[0] += ctx->c;       // mark last block offset
-  if (ctx->t[0] < ctx->c) {  // carry overflow
-    ctx->t[1]++;             // high word
-  }
+  blake2b_increment(ctx, ctx->c);  // mark last block offset
 
   while (ctx->c < 128) {  // fill up with zeros
     ctx->b[ctx->c++] = 0;
   }
-  blake2b_compress(ctx, 1);  // final block flag = 1
+  blake2b_compress(ctx, ctx->b, 1);  // final block flag = 1
 
   // little endian convert and store
   for (i = 0; i < ctx->outlen; i++) {
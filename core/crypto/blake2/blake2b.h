@@ -36,6 +36,19 @@ void blake2b_update(blake2b_ctx *ctx,               // context
 //      Result placed in "out".
 void blake2b_final(blake2b_ctx *ctx, void *out);
 
+// Compression kernels. The fastest one supported by the CPU is used,
+// unless another one is chosen with blake2b_use_impl, e.g. to compare them.
+typedef enum {
+  BLAKE2B_IMPL_AUTO,
+  BLAKE2B_IMPL_PORTABLE,
+  BLAKE2B_IMPL_AVX2,
+  BLAKE2B_IMPL_AVX512,
+} blake2b_impl;
+
+// Use "impl" for all the following hashing.
+//      Returns -1 if the CPU or the build doesn't support it.
+int blake2b_use_impl(blake2b_impl impl);
+
 // All-in-one convenience function.
 int blake2b(void *out, size_t outlen,        // return buffer for digest
             const void *key, size_t keylen,  // optional secret key
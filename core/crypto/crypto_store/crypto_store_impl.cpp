@@ -6,6 +6,7 @@
 #include "crypto/crypto_store/crypto_store_impl.hpp"
 
 #include <fstream>
+#include <set>
 
 #include <gsl/span>
 #include "common/visitor.hpp"
@@ -114,6 +115,10 @@ namespace kagome::crypto {
     BOOST_ASSERT(random_generator_ != nullptr);
   }
 
+  CryptoStoreImpl::~CryptoStoreImpl() {
+    stopWatching();
+  }
+
   outcome::result<void> CryptoStoreImpl::initialize(Path keys_directory) {
     if (boost::filesystem::exists(keys_directory)) {
       // check whether specified path is a directory
@@ -128,9 +133,154 @@ namespace kagome::crypto {
     }
     keys_directory_ = std::move(keys_directory);
 
+    OUTCOME_TRY(reloadKeyFiles());
     return outcome::success();
   }
 
+  outcome::result<bool> CryptoStoreImpl::reloadKeyFiles() {
+    std::lock_guard files_lock(key_files_mutex_);
+    std::map<std::string, std::pair<KeyTypeId, store::PublicKey>> names;
+    boost::system::error_code ec;
+    for (DirectoryIterator it(keys_directory_, ec), end{}; not ec and it != end;
+         it.increment(ec)) {
+      boost::system::error_code file_ec;
+      if (!boost::filesystem::is_regular_file(it->path(), file_ec)) {
+        continue;
+      }
+      auto name = it->path().filename().string();
+      if (auto info = parseKeyFileName(name)) {
+        names.emplace(std::move(name), info.value());
+      }
+    }
+    if (ec) {
+      logger_->error("failed to read keys directory {} : {}",
+                     keys_directory_.string(),
+                     ec.message());
+      return CryptoStoreError::FAILED_READ_KEYS_DIRECTORY;
+    }
+    if (names.size() == key_files_.size()
+        and std::equal(names.begin(),
+                       names.end(),
+                       key_files_.begin(),
+                       [](auto &name, auto &file) {
+                         return name.first == file.first;
+                       })) {
+      return false;
+    }
+
+    // the files loaded before are not read again
+    std::map<std::string, boost::optional<KeyFile>> key_files;
+    for (auto &[name, info] : names) {
+      if (auto it = key_files_.find(name); it != key_files_.end()) {
+        key_files.emplace(name, std::move(it->second));
+      } else {
+        key_files.emplace(
+            name, loadKeyFile(keys_directory_ / name, info.first, info.second));
+      }
+    }
+    Keys file_keys;
+    for (auto &[name, key_file] : key_files) {
+      if (not key_file) {
+        continue;
+      }
+      visit_in_place(
+          key_file->keypair,
+          [&, type = key_file->key_type](const ED25519Keypair &pair) {
+            file_keys.ed[type].emplace(pair.public_key, pair);
+          },
+          [&, type = key_file->key_type](const SR25519Keypair &pair) {
+            file_keys.sr[type].emplace(pair.public_key, pair);
+          });
+    }
+    key_files_ = std::move(key_files);
+    std::unique_lock keys_lock(keys_mutex_);
+    file_keys_ = std::move(file_keys);
+    return true;
+  }
+
+  boost::optional<CryptoStoreImpl::KeyFile> CryptoStoreImpl::loadKeyFile(
+      const Path &path,
+      KeyTypeId key_type,
+      const store::PublicKey &public_key) {
+    auto content = loadFileContent(path);
+    if (!content) {
+      logger_->error("failed to load keyfile {} : {}",
+                     path.string(),
+                     content.error().message());
+      return boost::none;
+    }
+    auto seed = ED25519Seed::fromHex(content.value());
+    if (!seed) {
+      logger_->error("failed to load seed from keyfile {} : {}",
+                     path.string(),
+                     seed.error().message());
+      return boost::none;
+    }
+    // the name tells the public key but not the kind of it, which is the one
+    // the seed derives it for
+    if (auto ed = ed25519_provider_->generateKeypair(seed.value());
+        ed.public_key == public_key) {
+      return KeyFile{key_type, ed};
+    }
+    if (auto sr = sr25519_provider_->generateKeypair(seed.value());
+        sr.public_key == public_key) {
+      return KeyFile{key_type, sr};
+    }
+    logger_->error("failed to load keyfile {} : {}",
+                   path.string(),
+                   make_error_code(CryptoStoreError::INCONSISTENT_KEYFILE)
+                       .message());
+    return boost::none;
+  }
+
+  void CryptoStoreImpl::indexKeyFile(const KeyFile &key_file) {
+    key_files_[decodeKeyTypeId(key_file.key_type)
+               + visit_in_place(key_file.keypair,
+                                [](const auto &pair) {
+                                  return pair.public_key.toHex();
+                                })] = key_file;
+    std::unique_lock lock(keys_mutex_);
+    visit_in_place(
+        key_file.keypair,
+        [&](const ED25519Keypair &pair) {
+          file_keys_.ed[key_file.key_type].emplace(pair.public_key, pair);
+        },
+        [&](const SR25519Keypair &pair) {
+          file_keys_.sr[key_file.key_type].emplace(pair.public_key, pair);
+        });
+  }
+
+  void CryptoStoreImpl::watchKeysDirectory(std::chrono::milliseconds period) {
+    std::lock_guard lock(watcher_mutex_);
+    if (watching_) {
+      return;
+    }
+    watching_ = true;
+    watcher_ = std::thread{[this, period] {
+      std::unique_lock lock(watcher_mutex_);
+      while (not watcher_cv_.wait_for(
+          lock, period, [this] { return not watching_; })) {
+        lock.unlock();
+        if (auto changed = reloadKeyFiles(); changed and changed.value()) {
+          logger_->info("Reloaded the key files of {}",
+                        keys_directory_.string());
+        }
+        lock.lock();
+      }
+    }};
+  }
+
+  void CryptoStoreImpl::stopWatching() {
+    {
+      std::lock_guard lock(watcher_mutex_);
+      watching_ = false;
+      watcher_cv_.notify_all();
+    }
+    if (watcher_.joinable()) {
+      watcher_.join();
+    }
+  }
+
   outcome::result<ED25519Keypair> CryptoStoreImpl::generateEd25519Keypair(
       KeyTypeId key_type, std::string_view mnemonic_phrase) {
     OUTCOME_TRY(mnemonic, bip39::Mnemonic::parse(mnemonic_phrase));
@@ -143,11 +293,7 @@ namespace kagome::crypto {
     OUTCOME_TRY(ed_seed,
                 ED25519Seed::fromSpan(
                     gsl::make_span(seed).subspan(0, ED25519Seed::size())));
-    auto &&pair = ed25519_provider_->generateKeypair(ed_seed);
-
-    ed_keys_[key_type].emplace(pair.public_key, pair.private_key);
-
-    return pair;
+    return generateEd25519Keypair(key_type, ed_seed);
   }
 
   outcome::result<SR25519Keypair> CryptoStoreImpl::generateSr25519Keypair(
@@ -160,26 +306,24 @@ namespace kagome::crypto {
     }
 
     OUTCOME_TRY(sr_seed,
-                ED25519Seed::fromSpan(
-                    gsl::make_span(seed).subspan(0, ED25519Seed::size())));
-    auto &&pair = sr25519_provider_->generateKeypair(sr_seed);
-
-    sr_keys_[key_type].emplace(pair.public_key, pair.secret_key);
-
-    return pair;
+                SR25519Seed::fromSpan(
+                    gsl::make_span(seed).subspan(0, SR25519Seed::size())));
+    return generateSr25519Keypair(key_type, sr_seed);
   }
 
   ED25519Keypair CryptoStoreImpl::generateEd25519Keypair(
       KeyTypeId key_type, const ED25519Seed &seed) {
     auto &&pair = ed25519_provider_->generateKeypair(seed);
-    ed_keys_[key_type].emplace(pair.public_key, pair.private_key);
+    std::unique_lock lock(keys_mutex_);
+    memory_keys_.ed[key_type].emplace(pair.public_key, pair);
     return pair;
   }
 
   SR25519Keypair CryptoStoreImpl::generateSr25519Keypair(
       KeyTypeId key_type, const SR25519Seed &seed) {
     auto &&pair = sr25519_provider_->generateKeypair(seed);
-    sr_keys_[key_type].emplace(pair.public_key, pair.secret_key);
+    std::unique_lock lock(keys_mutex_);
+    memory_keys_.sr[key_type].emplace(pair.public_key, pair);
     return pair;
   }
 
@@ -190,7 +334,9 @@ namespace kagome::crypto {
     std::copy_n(bytes.begin(), ED25519Seed::size(), seed.begin());
 
     auto &&pair = ed25519_provider_->generateKeypair(seed);
+    std::lock_guard lock(key_files_mutex_);
     OUTCOME_TRY(storeKeyfile(key_type, pair.public_key, seed));
+    indexKeyFile(KeyFile{key_type, pair});
 
     return pair;
   }
@@ -202,142 +348,80 @@ namespace kagome::crypto {
     std::copy_n(bytes.begin(), SR25519Seed::size(), seed.begin());
 
     auto &&pair = sr25519_provider_->generateKeypair(seed);
+    std::lock_guard lock(key_files_mutex_);
     OUTCOME_TRY(storeKeyfile(key_type, pair.public_key, seed));
+    indexKeyFile(KeyFile{key_type, pair});
 
     return pair;
   }
 
-  outcome::result<ED25519Keypair> CryptoStoreImpl::findEd25519Keypair(
-      KeyTypeId key_type, const ED25519PublicKey &pk) const {
-    // try find in memory
-    if (ed_keys_.count(key_type) > 0) {
-      const auto &map = ed_keys_.at(key_type);
-      if (auto it = map.find(pk); it != map.end()) {
-        return ED25519Keypair{it->second, it->first};
+  namespace {
+    /// the keypair of \arg key_type and \arg pk in \arg index, if any
+    template <typename Index, typename PublicKey>
+    auto findKeypair(const Index &index,
+                     KeyTypeId key_type,
+                     const PublicKey &pk)
+        -> boost::optional<typename Index::mapped_type::mapped_type> {
+      if (auto keys = index.find(key_type); keys != index.end()) {
+        if (auto it = keys->second.find(pk); it != keys->second.end()) {
+          return it->second;
+        }
       }
+      return boost::none;
     }
-    // try find in filesystem
-    auto path = composeKeyPath(key_type, pk);
-    if (!boost::filesystem::exists(path)) {
-      return CryptoStoreError::KEY_NOT_FOUND;
+
+    /// adds the public keys of \arg key_type in \arg index to \arg keys
+    template <typename Index, typename PublicKey>
+    void collectPublicKeys(const Index &index,
+                           KeyTypeId key_type,
+                           std::set<PublicKey> &keys) {
+      if (auto it = index.find(key_type); it != index.end()) {
+        for (auto &[pk, pair] : it->second) {
+          keys.emplace(pk);
+        }
+      }
     }
-    OUTCOME_TRY(content, loadFileContent(path));
-    OUTCOME_TRY(seed, ED25519Seed::fromHex(content));
+  }  // namespace
 
-    return ed25519_provider_->generateKeypair(seed);
+  outcome::result<ED25519Keypair> CryptoStoreImpl::findEd25519Keypair(
+      KeyTypeId key_type, const ED25519PublicKey &pk) const {
+    std::shared_lock lock(keys_mutex_);
+    if (auto pair = findKeypair(memory_keys_.ed, key_type, pk)) {
+      return *pair;
+    }
+    if (auto pair = findKeypair(file_keys_.ed, key_type, pk)) {
+      return *pair;
+    }
+    return CryptoStoreError::KEY_NOT_FOUND;
   }
 
   outcome::result<SR25519Keypair> CryptoStoreImpl::findSr25519Keypair(
       KeyTypeId key_type, const SR25519PublicKey &pk) const {
-    // try find in memory
-    if (sr_keys_.count(key_type) > 0) {
-      const auto &map = sr_keys_.at(key_type);
-      if (auto it = map.find(pk); it != map.end()) {
-        return SR25519Keypair{it->second, it->first};
-      }
+    std::shared_lock lock(keys_mutex_);
+    if (auto pair = findKeypair(memory_keys_.sr, key_type, pk)) {
+      return *pair;
     }
-    // try find in filesystem
-    auto path = composeKeyPath(key_type, pk);
-    if (!boost::filesystem::exists(path)) {
-      return CryptoStoreError::KEY_NOT_FOUND;
+    if (auto pair = findKeypair(file_keys_.sr, key_type, pk)) {
+      return *pair;
     }
-    OUTCOME_TRY(content, loadFileContent(path));
-    OUTCOME_TRY(seed, ED25519Seed::fromHex(content));
-
-    return sr25519_provider_->generateKeypair(seed);
+    return CryptoStoreError::KEY_NOT_FOUND;
   }
 
   CryptoStore::ED25519Keys CryptoStoreImpl::getEd25519PublicKeys(
       KeyTypeId key_type) const {
     std::set<ED25519PublicKey> keys;
-    // iterate over in-memory map
-    if (ed_keys_.find(key_type) != ed_keys_.end()) {
-      const auto &map = ed_keys_.at(key_type);
-      for (const auto &k : map) {
-        keys.emplace(k.first);
-      }
-    }
-
-    // iterate over fs
-    for (DirectoryIterator it(keys_directory_), end{}; it != end; ++it) {
-      if (!boost::filesystem::is_regular_file(*it)) {
-        continue;
-      }
-      auto info = parseKeyFileName(it->path().filename().string());
-      if (!info) {
-        continue;
-      }
-      auto &[id, pk] = info.value();
-      if (id == key_type && keys.count(pk) == 0) {
-        auto &&content = loadFileContent(it->path());
-        if (!content) {
-          logger_->error("failed to load keyfile {} : {}",
-                         it->path().string(),
-                         content.error().message());
-          continue;
-        }
-
-        auto &&seed = ED25519Seed::fromHex(content.value());
-        if (!seed) {
-          logger_->error("failed to load seed from keyfile {} : {}",
-                         it->path().string(),
-                         seed.error().message());
-          continue;
-        }
-        auto &&pair = ed25519_provider_->generateKeypair(seed.value());
-        if (pair.public_key == pk) {
-          keys.emplace(pk);
-        }
-      }
-    }
-
+    std::shared_lock lock(keys_mutex_);
+    collectPublicKeys(memory_keys_.ed, key_type, keys);
+    collectPublicKeys(file_keys_.ed, key_type, keys);
     return ED25519Keys(keys.begin(), keys.end());
   }
 
   CryptoStore::SR25519Keys CryptoStoreImpl::getSr25519PublicKeys(
       KeyTypeId key_type) const {
     std::set<SR25519PublicKey> keys;
-    // iterate over in-memory map
-    if (sr_keys_.find(key_type) != sr_keys_.end()) {
-      const auto &map = ed_keys_.at(key_type);
-      for (const auto &k : map) {
-        keys.emplace(k.first);
-      }
-    }
-
-    // iterate over fs
-    for (DirectoryIterator it(keys_directory_), end{}; it != end; ++it) {
-      if (!boost::filesystem::is_regular_file(*it)) {
-        continue;
-      }
-      auto info = parseKeyFileName(it->path().filename().string());
-      if (!info) {
-        continue;
-      }
-      auto &[id, pk] = info.value();
-      if (id == key_type && keys.count(pk) == 0) {
-        auto &&content = loadFileContent(it->path());
-        if (!content) {
-          logger_->error("failed to load keyfile {} : {}",
-                         it->path().string(),
-                         content.error().message());
-          continue;
-        }
-
-        auto &&seed = SR25519Seed::fromHex(content.value());
-        if (!seed) {
-          logger_->error("failed to load seed from keyfile {} : {}",
-                         it->path().string(),
-                         seed.error().message());
-          continue;
-        }
-        auto &&pair = sr25519_provider_->generateKeypair(seed.value());
-        if (pair.public_key == pk) {
-          keys.emplace(pk);
-        }
-      }
-    }
-
+    std::shared_lock lock(keys_mutex_);
+    collectPublicKeys(memory_keys_.sr, key_type, keys);
+    collectPublicKeys(file_keys_.sr, key_type, keys);
     return SR25519Keys(keys.begin(), keys.end());
   }
 }  // namespace kagome::crypto
@@ -369,6 +453,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::crypto, CryptoStoreError, e) {
       return "specified path is not a directory";
     case E::FAILED_CREATE_KEYS_DIRECTORY:
       return "failed to create directory";
+    case E::FAILED_READ_KEYS_DIRECTORY:
+      return "failed to read directory";
   }
   return "Unknown CryptoStoreError code";
 }
@@ -6,7 +6,16 @@
 #ifndef KAGOME_CRYPTO_STORE_IMPL_HPP
 #define KAGOME_CRYPTO_STORE_IMPL_HPP
 
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <boost/variant.hpp>
 #include "common/blob.hpp"
 #include "common/logger.hpp"
@@ -39,14 +48,22 @@ namespace kagome::crypto {
     WRONG_SEED_SIZE,
     KEY_NOT_FOUND,
     KEYS_PATH_IS_NOT_DIRECTORY,
-    FAILED_CREATE_KEYS_DIRECTORY
+    FAILED_CREATE_KEYS_DIRECTORY,
+    FAILED_READ_KEYS_DIRECTORY
   };
 
+  /**
+   * Keeps the keypairs, both the generated ones and the ones of the key files
+   * of the keys directory, in memory, indexed by their types and public keys,
+   * so that the lookups of the signing never touch the filesystem nor derive
+   * the keys. The key files are loaded at the initialization, and reloaded
+   * when the files of the directory change
+   */
   class CryptoStoreImpl : public CryptoStore {
    public:
     // currently std::filesystem::path is missing required methods in macos SDK
 
-    ~CryptoStoreImpl() override = default;
+    ~CryptoStoreImpl() override;
 
     CryptoStoreImpl(std::shared_ptr<ED25519Provider> ed25519_provider,
                     std::shared_ptr<SR25519Provider> sr25519_provider,
@@ -55,12 +72,31 @@ namespace kagome::crypto {
                     std::shared_ptr<CSPRNG> random_generator);
 
     /**
-     * @brief ensures that keys directory exists
+     * @brief ensures that keys directory exists and loads its key files
      * @param keys_directory keys directory
      * @return success if exists or managed to create, failure otherwise
      */
     outcome::result<void> initialize(Path keys_directory);
 
+    /**
+     * Loads the key files added to the keys directory since they were loaded
+     * last time, and forgets the keys of the removed ones
+     * @return whether the key files changed
+     */
+    outcome::result<bool> reloadKeyFiles();
+
+    /**
+     * Reloads the key files every \arg period on a thread of its own, so that
+     * the files put to the keys directory or removed from it are picked up
+     * without a restart
+     */
+    void watchKeysDirectory(std::chrono::milliseconds period);
+
+    /**
+     * Stops watching the keys directory, waits for the reload in progress
+     */
+    void stopWatching();
+
     outcome::result<ED25519Keypair> generateEd25519Keypair(
         KeyTypeId key_type, std::string_view mnemonic_phrase) override;
 
@@ -90,6 +126,34 @@ namespace kagome::crypto {
     SR25519Keys getSr25519PublicKeys(KeyTypeId key_type) const override;
 
    private:
+    template <typename Keypair>
+    using Index = std::unordered_map<
+        KeyTypeId,
+        std::unordered_map<decltype(Keypair::public_key), Keypair>>;
+
+    struct Keys {
+      Index<ED25519Keypair> ed;
+      Index<SR25519Keypair> sr;
+    };
+
+    // the keypair of a key file
+    struct KeyFile {
+      KeyTypeId key_type;
+      store::KeyPair keypair;
+    };
+
+    /**
+     * Reads the key file of \arg key_type and \arg public_key at \arg path
+     * @return its keypair, none if the file holds no keypair of the public
+     * key
+     */
+    boost::optional<KeyFile> loadKeyFile(const Path &path,
+                                         KeyTypeId key_type,
+                                         const store::PublicKey &public_key);
+
+    /// adds \arg key_file to the keys of the key files
+    void indexKeyFile(const KeyFile &key_file);
+
     outcome::result<std::pair<KeyTypeId, store::PublicKey>> parseKeyFileName(
         std::string_view file_name) const;
 
@@ -107,8 +171,23 @@ namespace kagome::crypto {
     std::shared_ptr<Bip39Provider> bip39_provider_;
     std::shared_ptr<CSPRNG> random_generator_;
 
-    std::map<KeyTypeId, std::map<ED25519PublicKey, ED25519PrivateKey>> ed_keys_;
-    std::map<KeyTypeId, std::map<SR25519PublicKey, SR25519SecretKey>> sr_keys_;
+    mutable std::shared_mutex keys_mutex_;
+    // the keys generated from the mnemonics and the seeds
+    Keys memory_keys_;
+    // the keys of the key files
+    Keys file_keys_;
+
+    // serializes the changes of the key files
+    std::mutex key_files_mutex_;
+    // by the names of the loaded key files, none for the ones holding no
+    // keypair of the public key in the name, so that they are not read again
+    std::map<std::string, boost::optional<KeyFile>> key_files_;
+
+    std::thread watcher_;
+    std::mutex watcher_mutex_;
+    std::condition_variable watcher_cv_;
+    bool watching_ = false;
+
     common::Logger logger_;
   };
 }  // namespace kagome::crypto
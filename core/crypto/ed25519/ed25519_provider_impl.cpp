@@ -7,6 +7,10 @@
 
 namespace kagome::crypto {
 
+  ED25519ProviderImpl::ED25519ProviderImpl(
+      std::shared_ptr<common::WorkerPool> workers)
+      : workers_{std::move(workers)} {}
+
   outcome::result<ED25519Keypair> ED25519ProviderImpl::generateKeypair() const {
     private_key_t private_key_low{};
     public_key_t public_key_low{};
@@ -92,7 +96,7 @@ namespace kagome::crypto {
 
   outcome::result<bool> ED25519ProviderImpl::verify(
       const ED25519Signature &signature,
-      gsl::span<uint8_t> message,
+      gsl::span<const uint8_t> message,
       const ED25519PublicKey &public_key) const {
     public_key_t public_key_low{};
     signature_t signature_low{};
@@ -117,6 +121,24 @@ namespace kagome::crypto {
       return ED25519ProviderError::VERIFY_UNKNOWN_ERROR;
     }
   }
+
+  std::vector<bool> ED25519ProviderImpl::verifyBatch(
+      gsl::span<const ED25519Verification> batch) const {
+    auto size = static_cast<size_t>(batch.size());
+    if (workers_ == nullptr or size < kMinParallelBatch) {
+      return ED25519Provider::verifyBatch(batch);
+    }
+
+    // the signatures are independent; the results are written to the
+    // distinct bytes, not to the packed bits
+    std::vector<uint8_t> valid(size, 0);
+    workers_->parallelFor(size, [&](size_t i) {
+      const auto &item = batch[i];
+      auto res = verify(item.signature, item.message, item.public_key);
+      valid[i] = res and res.value() ? 1 : 0;
+    });
+    return {valid.begin(), valid.end()};
+  }
 }  // namespace kagome::crypto
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::crypto, ED25519ProviderError, e) {
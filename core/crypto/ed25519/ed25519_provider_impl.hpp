@@ -6,12 +6,23 @@
 #ifndef KAGOME_CORE_CRYPTO_ED25519_ED25519_PROVIDER_IMPL_HPP
 #define KAGOME_CORE_CRYPTO_ED25519_ED25519_PROVIDER_IMPL_HPP
 
+#include "common/worker_pool.hpp"
 #include "crypto/ed25519_provider.hpp"
 
 namespace kagome::crypto {
 
   class ED25519ProviderImpl : public ED25519Provider {
    public:
+    /// batches of fewer signatures are verified on the calling thread only
+    static constexpr size_t kMinParallelBatch = 16;
+
+    /**
+     * @param workers verify the signatures of the large batches in
+     * parallel, if any
+     */
+    explicit ED25519ProviderImpl(
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
+
     ~ED25519ProviderImpl() override = default;
 
     outcome::result<ED25519Keypair> generateKeypair() const override;
@@ -24,8 +35,18 @@ namespace kagome::crypto {
 
     outcome::result<bool> verify(
         const ED25519Signature &signature,
-        gsl::span<uint8_t> message,
+        gsl::span<const uint8_t> message,
         const ED25519PublicKey &public_key) const override;
+
+    /**
+     * The bindings have no multi-scalar batch verification, so the
+     * signatures of a large batch are verified one by one by the workers
+     */
+    std::vector<bool> verifyBatch(
+        gsl::span<const ED25519Verification> batch) const override;
+
+   private:
+    std::shared_ptr<common::WorkerPool> workers_;
   };
 
 }  // namespace kagome::crypto
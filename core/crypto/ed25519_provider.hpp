@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_CRYPTO_ED25519_PROVIDER_HPP
 #define KAGOME_CORE_CRYPTO_ED25519_PROVIDER_HPP
 
+#include <vector>
+
 #include <gsl/span>
 #include <outcome/outcome.hpp>
 #include "crypto/ed25519_types.hpp"
@@ -20,6 +22,16 @@ namespace kagome::crypto {
                           // method of bound function
   };
 
+  /**
+   * Signature of a batch to be verified, the message has to stay valid until
+   * the batch is verified
+   */
+  struct ED25519Verification {
+    ED25519Signature signature;
+    gsl::span<const uint8_t> message;
+    ED25519PublicKey public_key;
+  };
+
   class ED25519Provider {
    public:
     virtual ~ED25519Provider() = default;
@@ -54,8 +66,24 @@ namespace kagome::crypto {
      */
     virtual outcome::result<bool> verify(
         const ED25519Signature &signature,
-        gsl::span<uint8_t> message,
+        gsl::span<const uint8_t> message,
         const ED25519PublicKey &public_key) const = 0;
+
+    /**
+     * Verifies the signatures of \arg batch
+     * @return whether each of them is valid, in the order of the batch; the
+     * one failing to be verified is invalid
+     */
+    virtual std::vector<bool> verifyBatch(
+        gsl::span<const ED25519Verification> batch) const {
+      std::vector<bool> valid;
+      valid.reserve(batch.size());
+      for (const auto &item : batch) {
+        auto res = verify(item.signature, item.message, item.public_key);
+        valid.push_back(res and res.value());
+      }
+      return valid;
+    }
   };
 }  // namespace kagome::crypto
 
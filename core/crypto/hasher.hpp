@@ -6,6 +6,10 @@
 #ifndef KAGOME_CORE_HASHER_HASHER_HPP_
 #define KAGOME_CORE_HASHER_HASHER_HPP_
 
+#include <algorithm>
+
+#include <boost/assert.hpp>
+
 #include "common/blob.hpp"
 #include "common/buffer.hpp"
 
@@ -74,6 +78,47 @@ namespace kagome::crypto {
      * @return 256-bit hash value
      */
     virtual Hash256 sha2_256(gsl::span<const uint8_t> buffer) const = 0;
+
+    /**
+     * @brief twox_128_many calculates twox_128 of each of the given buffers
+     * @param inputs source buffers
+     * @param out hashes of the inputs in the same order, of the same size
+     */
+    virtual void twox_128_many(gsl::span<const gsl::span<const uint8_t>> inputs,
+                               gsl::span<Hash128> out) const {
+      hashMany(inputs, out, [this](auto input) { return twox_128(input); });
+    }
+
+    /**
+     * @brief twox_256_many calculates twox_256 of each of the given buffers
+     * @param inputs source buffers
+     * @param out hashes of the inputs in the same order, of the same size
+     */
+    virtual void twox_256_many(gsl::span<const gsl::span<const uint8_t>> inputs,
+                               gsl::span<Hash256> out) const {
+      hashMany(inputs, out, [this](auto input) { return twox_256(input); });
+    }
+
+    /**
+     * @brief blake2b_256_many calculates blake2b_256 of each of the given
+     * buffers
+     * @param inputs source values
+     * @param out hashes of the inputs in the same order, of the same size
+     */
+    virtual void blake2b_256_many(
+        gsl::span<const gsl::span<const uint8_t>> inputs,
+        gsl::span<Hash256> out) const {
+      hashMany(inputs, out, [this](auto input) { return blake2b_256(input); });
+    }
+
+   private:
+    template <typename Hash, typename F>
+    static void hashMany(gsl::span<const gsl::span<const uint8_t>> inputs,
+                         gsl::span<Hash> out,
+                         const F &hash) {
+      BOOST_ASSERT(inputs.size() == out.size());
+      std::transform(inputs.begin(), inputs.end(), out.begin(), hash);
+    }
   };
 }  // namespace kagome::crypto
 
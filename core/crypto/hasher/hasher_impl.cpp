@@ -5,6 +5,9 @@
 
 #include "crypto/hasher/hasher_impl.hpp"
 
+#include <numeric>
+
+#include <boost/assert.hpp>
 #include <gsl/span>
 
 #include "crypto/blake2/blake2b.h"
@@ -18,6 +21,28 @@ namespace kagome::crypto {
   using common::Hash256;
   using common::Hash64;
 
+  HasherImpl::HasherImpl(std::shared_ptr<common::WorkerPool> workers)
+      : workers_{std::move(workers)} {}
+
+  template <typename Hash, typename F>
+  void HasherImpl::hashMany(gsl::span<const gsl::span<const uint8_t>> inputs,
+                            gsl::span<Hash> out,
+                            const F &hash) const {
+    BOOST_ASSERT(inputs.size() == out.size());
+    auto hash_one = [&](size_t i) { out.data()[i] = hash(inputs.data()[i]); };
+    auto total_size = std::accumulate(
+        inputs.begin(), inputs.end(), size_t{0}, [](auto sum, auto input) {
+          return sum + input.size();
+        });
+    if (workers_ != nullptr and total_size > kParallelHashingThreshold) {
+      workers_->parallelFor(inputs.size(), hash_one);
+      return;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      hash_one(i);
+    }
+  }
+
   Hash64 HasherImpl::twox_64(gsl::span<const uint8_t> buffer) const {
     return make_twox64(buffer);
   }
@@ -62,4 +87,25 @@ namespace kagome::crypto {
   Hash256 HasherImpl::sha2_256(gsl::span<const uint8_t> buffer) const {
     return crypto::sha256(buffer);
   }
+
+  void HasherImpl::twox_128_many(
+      gsl::span<const gsl::span<const uint8_t>> inputs,
+      gsl::span<Hash128> out) const {
+    hashMany(
+        inputs, out, [this](auto input) { return twox_128(input); });
+  }
+
+  void HasherImpl::twox_256_many(
+      gsl::span<const gsl::span<const uint8_t>> inputs,
+      gsl::span<Hash256> out) const {
+    hashMany(
+        inputs, out, [this](auto input) { return twox_256(input); });
+  }
+
+  void HasherImpl::blake2b_256_many(
+      gsl::span<const gsl::span<const uint8_t>> inputs,
+      gsl::span<Hash256> out) const {
+    hashMany(
+        inputs, out, [this](auto input) { return blake2b_256(input); });
+  }
 }  // namespace kagome::crypto
@@ -6,12 +6,19 @@
 #ifndef KAGOME_CORE_CRYPTO_HASHER_HASHER_IMPL_HPP_
 #define KAGOME_CORE_CRYPTO_HASHER_HASHER_IMPL_HPP_
 
+#include "common/worker_pool.hpp"
 #include "crypto/hasher.hpp"
 
 namespace kagome::crypto {
 
   class HasherImpl : public Hasher {
    public:
+    /**
+     * @param workers hash the large batches in parallel, if any; they are
+     * hashed on the calling thread otherwise
+     */
+    explicit HasherImpl(std::shared_ptr<common::WorkerPool> workers = nullptr);
+
     ~HasherImpl() override = default;
 
     Hash64 twox_64(gsl::span<const uint8_t> buffer) const override;
@@ -29,6 +36,33 @@ namespace kagome::crypto {
     Hash256 blake2s_256(gsl::span<const uint8_t> buffer) const override;
 
     Hash256 sha2_256(gsl::span<const uint8_t> buffer) const override;
+
+    /**
+     * Batches of more than this number of bytes in total are hashed on
+     * the threads of the workers
+     */
+    static constexpr size_t kParallelHashingThreshold = 64 * 1024;
+
+    void twox_128_many(gsl::span<const gsl::span<const uint8_t>> inputs,
+                       gsl::span<Hash128> out) const override;
+
+    void twox_256_many(gsl::span<const gsl::span<const uint8_t>> inputs,
+                       gsl::span<Hash256> out) const override;
+
+    void blake2b_256_many(gsl::span<const gsl::span<const uint8_t>> inputs,
+                          gsl::span<Hash256> out) const override;
+
+   private:
+    /**
+     * Writes \arg hash of each of \arg inputs to \arg out, splitting the
+     * inputs between the workers if they are large enough in total
+     */
+    template <typename Hash, typename F>
+    void hashMany(gsl::span<const gsl::span<const uint8_t>> inputs,
+                  gsl::span<Hash> out,
+                  const F &hash) const;
+
+    std::shared_ptr<common::WorkerPool> workers_;
   };
 
 }  // namespace kagome::hash
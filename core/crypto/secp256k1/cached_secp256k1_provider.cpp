@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto/secp256k1/cached_secp256k1_provider.hpp"
+
+#include <boost/assert.hpp>
+
+#include "crypto/blake2/blake2b.h"
+
+namespace kagome::crypto {
+
+  CachedSecp256k1Provider::CachedSecp256k1Provider(
+      std::shared_ptr<Secp256k1Provider> provider, size_t capacity)
+      : provider_{std::move(provider)}, capacity_{capacity} {
+    BOOST_ASSERT(provider_ != nullptr);
+    BOOST_ASSERT(capacity_ > 0);
+  }
+
+  outcome::result<secp256k1::UncompressedPublicKey>
+  CachedSecp256k1Provider::recoverPublickeyUncompressed(
+      const secp256k1::RSVSignature &signature,
+      const secp256k1::MessageHash &message_hash) const {
+    auto key = makeKey(signature, message_hash);
+    {
+      std::lock_guard lock{mutex_};
+      if (auto it = index_.find(key); it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+      }
+    }
+    // recovered without the lock, so that the runtime instances validating
+    // the transactions at once do not wait for each other
+    OUTCOME_TRY(public_key,
+                provider_->recoverPublickeyUncompressed(signature,
+                                                        message_hash));
+    std::lock_guard lock{mutex_};
+    if (index_.count(key) == 0) {
+      if (entries_.size() == capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+      }
+      entries_.emplace_front(key, public_key);
+      index_.emplace(key, entries_.begin());
+    }
+    return public_key;
+  }
+
+  outcome::result<secp256k1::CompressedPublicKey>
+  CachedSecp256k1Provider::recoverPublickeyCompressed(
+      const secp256k1::RSVSignature &signature,
+      const secp256k1::MessageHash &message_hash) const {
+    OUTCOME_TRY(uncompressed,
+                recoverPublickeyUncompressed(signature, message_hash));
+    // the uncompressed key is 0x04 followed by the coordinates x and y, the
+    // compressed one is the parity of y followed by x
+    secp256k1::CompressedPublicKey compressed;
+    compressed[0] = (uncompressed.back() & 1) != 0 ? 0x03 : 0x02;
+    std::copy(uncompressed.begin() + 1,
+              uncompressed.begin() + compressed.size(),
+              compressed.begin() + 1);
+    return compressed;
+  }
+
+  size_t CachedSecp256k1Provider::size() const {
+    std::lock_guard lock{mutex_};
+    return entries_.size();
+  }
+
+  common::Hash256 CachedSecp256k1Provider::makeKey(
+      const secp256k1::RSVSignature &signature,
+      const secp256k1::MessageHash &message_hash) {
+    common::Hash256 key;
+    blake2b_ctx ctx;
+    blake2b_init(&ctx, key.size(), nullptr, 0);
+    blake2b_update(&ctx, signature.data(), signature.size());
+    blake2b_update(&ctx, message_hash.data(), message_hash.size());
+    blake2b_final(&ctx, key.data());
+    return key;
+  }
+
+}  // namespace kagome::crypto
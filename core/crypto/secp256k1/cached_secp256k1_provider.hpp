@@ -0,0 +1,69 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CRYPTO_SECP256K1_CACHED_SECP256K1_PROVIDER_HPP
+#define KAGOME_CORE_CRYPTO_SECP256K1_CACHED_SECP256K1_PROVIDER_HPP
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "common/flat_hash_map.hpp"
+#include "crypto/secp256k1_provider.hpp"
+
+namespace kagome::crypto {
+
+  /**
+   * Recovers the public keys by another provider, keeping the keys it
+   * recovered, so that the signatures recovered when an extrinsic is
+   * validated for the transaction pool are not recovered again when the
+   * block including it is imported. The compressed keys are made of the
+   * uncompressed ones, so a signature is recovered once for both forms.
+   * Keeps up to a number of keys, evicting the least recently used ones.
+   * The failed recoveries are not kept, for the same reason as the invalid
+   * signatures are not kept by SignatureCache. Thread-safe
+   */
+  class CachedSecp256k1Provider : public Secp256k1Provider {
+   public:
+    /**
+     * @param provider recovers the keys missing in the cache
+     * @param capacity max number of the keys kept, at least 1
+     */
+    CachedSecp256k1Provider(std::shared_ptr<Secp256k1Provider> provider,
+                            size_t capacity);
+
+    outcome::result<secp256k1::UncompressedPublicKey>
+    recoverPublickeyUncompressed(
+        const secp256k1::RSVSignature &signature,
+        const secp256k1::MessageHash &message_hash) const override;
+
+    outcome::result<secp256k1::CompressedPublicKey> recoverPublickeyCompressed(
+        const secp256k1::RSVSignature &signature,
+        const secp256k1::MessageHash &message_hash) const override;
+
+    size_t size() const;
+
+   private:
+    using Entry = std::pair<common::Hash256, secp256k1::UncompressedPublicKey>;
+
+    /**
+     * @return hash identifying the recovery of \arg signature of \arg
+     * message_hash
+     */
+    static common::Hash256 makeKey(const secp256k1::RSVSignature &signature,
+                                   const secp256k1::MessageHash &message_hash);
+
+    std::shared_ptr<Secp256k1Provider> provider_;
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    // the most recently used entries first
+    mutable std::list<Entry> entries_;
+    mutable common::FlatHashMap<common::Hash256, std::list<Entry>::iterator>
+        index_;
+  };
+
+}  // namespace kagome::crypto
+
+#endif  // KAGOME_CORE_CRYPTO_SECP256K1_CACHED_SECP256K1_PROVIDER_HPP
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto/signature_cache.hpp"
+
+#include <boost/assert.hpp>
+
+#include "crypto/blake2/blake2b.h"
+
+namespace kagome::crypto {
+
+  SignatureCache::SignatureCache(size_t capacity) : capacity_{capacity} {
+    BOOST_ASSERT(capacity_ > 0);
+  }
+
+  bool SignatureCache::verify(Scheme scheme,
+                              gsl::span<const uint8_t> signature,
+                              gsl::span<const uint8_t> message,
+                              gsl::span<const uint8_t> public_key,
+                              const std::function<bool()> &verify) {
+    auto key = makeKey(scheme, signature, message, public_key);
+    if (contains(key)) {
+      return true;
+    }
+    // verified without the lock, so that several signatures are checked at
+    // once by the batch verification
+    if (not verify()) {
+      return false;
+    }
+    insert(key);
+    return true;
+  }
+
+  size_t SignatureCache::size() const {
+    std::lock_guard lock{mutex_};
+    return keys_.size();
+  }
+
+  common::Hash256 SignatureCache::makeKey(Scheme scheme,
+                                          gsl::span<const uint8_t> signature,
+                                          gsl::span<const uint8_t> message,
+                                          gsl::span<const uint8_t> public_key) {
+    // signatures and public keys are of fixed sizes for a scheme, so the
+    // concatenation is unambiguous
+    common::Hash256 key;
+    blake2b_ctx ctx;
+    blake2b_init(&ctx, key.size(), nullptr, 0);
+    auto scheme_byte = static_cast<uint8_t>(scheme);
+    blake2b_update(&ctx, &scheme_byte, 1);
+    blake2b_update(&ctx, signature.data(), signature.size());
+    blake2b_update(&ctx, public_key.data(), public_key.size());
+    blake2b_update(&ctx, message.data(), message.size());
+    blake2b_final(&ctx, key.data());
+    return key;
+  }
+
+  bool SignatureCache::contains(const common::Hash256 &key) {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return false;
+    }
+    keys_.splice(keys_.begin(), keys_, it->second);
+    return true;
+  }
+
+  void SignatureCache::insert(const common::Hash256 &key) {
+    std::lock_guard lock{mutex_};
+    if (index_.count(key) != 0) {
+      return;
+    }
+    if (keys_.size() == capacity_) {
+      index_.erase(keys_.back());
+      keys_.pop_back();
+    }
+    keys_.push_front(key);
+    index_.emplace(key, keys_.begin());
+  }
+
+}  // namespace kagome::crypto
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_CRYPTO_SIGNATURE_CACHE_HPP
+#define KAGOME_CORE_CRYPTO_SIGNATURE_CACHE_HPP
+
+#include <functional>
+#include <list>
+#include <mutex>
+
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/flat_hash_map.hpp"
+
+namespace kagome::crypto {
+
+  /**
+   * Signatures, which were verified to be valid, so that the ones checked
+   * when an extrinsic is validated for the transaction pool are not checked
+   * again when the block including it is imported.
+   * Keeps up to a number of signatures, evicting the least recently used
+   * ones. Invalid signatures are not kept, as they are rare in the blocks,
+   * and anyone may send many of them to evict the valid ones
+   */
+  class SignatureCache {
+   public:
+    enum class Scheme : uint8_t {
+      kEd25519,
+      kSr25519,
+    };
+
+    /**
+     * @param capacity max number of the signatures kept, at least 1
+     */
+    explicit SignatureCache(size_t capacity);
+
+    /**
+     * Verifies the \arg signature of \arg message by \arg public_key of
+     * \arg scheme with \arg verify, unless it is already known to be valid
+     * @return true if the signature is valid
+     */
+    bool verify(Scheme scheme,
+                gsl::span<const uint8_t> signature,
+                gsl::span<const uint8_t> message,
+                gsl::span<const uint8_t> public_key,
+                const std::function<bool()> &verify);
+
+    size_t size() const;
+
+   private:
+    /**
+     * @return hash identifying the signature with the given arguments, the
+     * message is hashed too, so that the long ones are not kept
+     */
+    static common::Hash256 makeKey(Scheme scheme,
+                                   gsl::span<const uint8_t> signature,
+                                   gsl::span<const uint8_t> message,
+                                   gsl::span<const uint8_t> public_key);
+
+    bool contains(const common::Hash256 &key);
+
+    void insert(const common::Hash256 &key);
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    // the most recently used keys first
+    std::list<common::Hash256> keys_;
+    common::FlatHashMap<common::Hash256, std::list<common::Hash256>::iterator>
+        index_;
+  };
+
+}  // namespace kagome::crypto
+
+#endif  // KAGOME_CORE_CRYPTO_SIGNATURE_CACHE_HPP
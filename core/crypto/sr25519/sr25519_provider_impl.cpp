@@ -9,8 +9,10 @@
 #include "libp2p/crypto/random_generator.hpp"
 
 namespace kagome::crypto {
-  SR25519ProviderImpl::SR25519ProviderImpl(std::shared_ptr<CSPRNG> generator)
-      : generator_(std::move(generator)) {
+  SR25519ProviderImpl::SR25519ProviderImpl(
+      std::shared_ptr<CSPRNG> generator,
+      std::shared_ptr<common::WorkerPool> workers)
+      : generator_(std::move(generator)), workers_(std::move(workers)) {
     BOOST_ASSERT(generator_ != nullptr);
   }
 
@@ -65,6 +67,24 @@ namespace kagome::crypto {
     }
     return outcome::success(result);
   }
+
+  std::vector<bool> SR25519ProviderImpl::verifyBatch(
+      gsl::span<const SR25519Verification> batch) const {
+    auto size = static_cast<size_t>(batch.size());
+    if (workers_ == nullptr or size < kMinParallelBatch) {
+      return SR25519Provider::verifyBatch(batch);
+    }
+
+    // the signatures are independent; the results are written to the
+    // distinct bytes, not to the packed bits
+    std::vector<uint8_t> valid(size, 0);
+    workers_->parallelFor(size, [&](size_t i) {
+      const auto &item = batch[i];
+      auto res = verify(item.signature, item.message, item.public_key);
+      valid[i] = res and res.value() ? 1 : 0;
+    });
+    return {valid.begin(), valid.end()};
+  }
 }  // namespace kagome::crypto
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::crypto, SR25519ProviderError, e) {
@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_CRYPTO_SR25519_SR25519_PROVIDER_IMPL_HPP
 #define KAGOME_CORE_CRYPTO_SR25519_SR25519_PROVIDER_IMPL_HPP
 
+#include "common/worker_pool.hpp"
 #include "crypto/random_generator.hpp"
 #include "crypto/sr25519_provider.hpp"
 
@@ -19,7 +20,17 @@ namespace kagome::crypto {
     using CSPRNG = libp2p::crypto::random::CSPRNG;
 
    public:
-    explicit SR25519ProviderImpl(std::shared_ptr<CSPRNG> generator);
+    /// batches of fewer signatures are verified on the calling thread only
+    static constexpr size_t kMinParallelBatch = 16;
+
+    /**
+     * @param generator to generate the keypairs
+     * @param workers verify the signatures of the large batches in
+     * parallel, if any
+     */
+    explicit SR25519ProviderImpl(
+        std::shared_ptr<CSPRNG> generator,
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     ~SR25519ProviderImpl() override = default;
 
@@ -36,8 +47,12 @@ namespace kagome::crypto {
         gsl::span<const uint8_t> message,
         const SR25519PublicKey &public_key) const override;
 
+    std::vector<bool> verifyBatch(
+        gsl::span<const SR25519Verification> batch) const override;
+
    private:
     std::shared_ptr<CSPRNG> generator_;
+    std::shared_ptr<common::WorkerPool> workers_;
   };
 
 }  // namespace kagome::crypto
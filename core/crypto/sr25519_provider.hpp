@@ -6,6 +6,8 @@
 #ifndef KAGOME_CORE_CRYPTO_SR25519_PROVIDER_HPP
 #define KAGOME_CORE_CRYPTO_SR25519_PROVIDER_HPP
 
+#include <vector>
+
 #include <gsl/span>
 #include <outcome/outcome.hpp>
 #include "crypto/sr25519_types.hpp"
@@ -22,6 +24,16 @@ namespace kagome::crypto {
                              // method of bound function
   };
 
+  /**
+   * Signature of a batch to be verified, the message has to stay valid until
+   * the batch is verified
+   */
+  struct SR25519Verification {
+    SR25519Signature signature;
+    gsl::span<const uint8_t> message;
+    SR25519PublicKey public_key;
+  };
+
   class SR25519Provider {
    public:
     virtual ~SR25519Provider() = default;
@@ -55,6 +67,22 @@ namespace kagome::crypto {
         const SR25519Signature &signature,
         gsl::span<const uint8_t> message,
         const SR25519PublicKey &public_key) const = 0;
+
+    /**
+     * Verifies the signatures of \arg batch
+     * @return whether each of them is valid, in the order of the batch; the
+     * one failing to be verified is invalid
+     */
+    virtual std::vector<bool> verifyBatch(
+        gsl::span<const SR25519Verification> batch) const {
+      std::vector<bool> valid;
+      valid.reserve(batch.size());
+      for (const auto &item : batch) {
+        auto res = verify(item.signature, item.message, item.public_key);
+        valid.push_back(res and res.value());
+      }
+      return valid;
+    }
   };
 }  // namespace kagome::crypto
 
@@ -5,15 +5,131 @@
 
 #include "crypto/twox/twox.hpp"
 
-#include <xxhash/xxhash.h>
+#include <cstring>
 
 namespace kagome::crypto {
 
+  namespace {
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t rotl(uint64_t x, int r) {
+      return (x << r) | (x >> (64 - r));
+    }
+
+    // the hashes are defined over little-endian words, as are the supported
+    // platforms
+    inline uint64_t read64(const uint8_t *p) {
+      uint64_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline uint32_t read32(const uint8_t *p) {
+      uint32_t v;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    inline uint64_t round(uint64_t acc, uint64_t input) {
+      acc += input * kPrime2;
+      acc = rotl(acc, 31);
+      return acc * kPrime1;
+    }
+
+    inline uint64_t mergeRound(uint64_t acc, uint64_t val) {
+      acc ^= round(0, val);
+      return acc * kPrime1 + kPrime4;
+    }
+
+    /**
+     * Computes XXH64 of \arg in with seeds 0..N-1 into the N words of
+     * \arg out in a single pass over the input.
+     * twox_128 and twox_256 used to hash the input once per seed; the lanes
+     * of all the seeds are now advanced together, so the input is read once
+     * and the independent multiplication chains of the seeds overlap, which
+     * matters most for the short storage keys
+     */
+    template <size_t N>
+    void xxh64Seeds(const uint8_t *in, size_t len, uint8_t *out) {
+      const uint8_t *p = in;
+      const uint8_t *const end = in + len;
+      uint64_t h[N];
+
+      if (len >= 32) {
+        uint64_t v[N][4];
+        for (size_t s = 0; s < N; ++s) {
+          v[s][0] = s + kPrime1 + kPrime2;
+          v[s][1] = s + kPrime2;
+          v[s][2] = s;
+          v[s][3] = s - kPrime1;
+        }
+        const uint8_t *const limit = end - 32;
+        do {
+          const uint64_t words[4] = {
+              read64(p), read64(p + 8), read64(p + 16), read64(p + 24)};
+          for (size_t s = 0; s < N; ++s) {
+            for (size_t i = 0; i < 4; ++i) {
+              v[s][i] = round(v[s][i], words[i]);
+            }
+          }
+          p += 32;
+        } while (p <= limit);
+
+        for (size_t s = 0; s < N; ++s) {
+          h[s] = rotl(v[s][0], 1) + rotl(v[s][1], 7) + rotl(v[s][2], 12)
+                 + rotl(v[s][3], 18);
+          for (size_t i = 0; i < 4; ++i) {
+            h[s] = mergeRound(h[s], v[s][i]);
+          }
+        }
+      } else {
+        for (size_t s = 0; s < N; ++s) {
+          h[s] = s + kPrime5;
+        }
+      }
+
+      for (size_t s = 0; s < N; ++s) {
+        h[s] += static_cast<uint64_t>(len);
+      }
+
+      for (; p + 8 <= end; p += 8) {
+        const auto k = round(0, read64(p));
+        for (size_t s = 0; s < N; ++s) {
+          h[s] = rotl(h[s] ^ k, 27) * kPrime1 + kPrime4;
+        }
+      }
+      if (p + 4 <= end) {
+        const auto k = static_cast<uint64_t>(read32(p)) * kPrime1;
+        for (size_t s = 0; s < N; ++s) {
+          h[s] = rotl(h[s] ^ k, 23) * kPrime2 + kPrime3;
+        }
+        p += 4;
+      }
+      for (; p < end; ++p) {
+        const auto k = *p * kPrime5;
+        for (size_t s = 0; s < N; ++s) {
+          h[s] = rotl(h[s] ^ k, 11) * kPrime1;
+        }
+      }
+
+      for (size_t s = 0; s < N; ++s) {
+        auto x = h[s];
+        x ^= x >> 33;
+        x *= kPrime2;
+        x ^= x >> 29;
+        x *= kPrime3;
+        x ^= x >> 32;
+        std::memcpy(out + s * sizeof(x), &x, sizeof(x));
+      }
+    }
+  }  // namespace
+
   void make_twox64(const uint8_t *in, uint32_t len, uint8_t *out) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    auto *ptr = reinterpret_cast<uint64_t *>(out);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[0] = XXH64(in, len, 0);
+    xxh64Seeds<1>(in, len, out);
   }
 
   common::Hash64 make_twox64(gsl::span<const uint8_t> buf) {
@@ -23,12 +139,7 @@ namespace kagome::crypto {
   }
 
   void make_twox128(const uint8_t *in, uint32_t len, uint8_t *out) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    auto *ptr = reinterpret_cast<uint64_t *>(out);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[0] = XXH64(in, len, 0);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[1] = XXH64(in, len, 1);
+    xxh64Seeds<2>(in, len, out);
   }
 
   common::Hash128 make_twox128(gsl::span<const uint8_t> buf) {
@@ -38,16 +149,7 @@ namespace kagome::crypto {
   }
 
   void make_twox256(const uint8_t *in, uint32_t len, uint8_t *out) {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-    auto *ptr = reinterpret_cast<uint64_t *>(out);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[0] = XXH64(in, len, 0);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[1] = XXH64(in, len, 1);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[2] = XXH64(in, len, 2);
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    ptr[3] = XXH64(in, len, 3);
+    xxh64Seeds<4>(in, len, out);
   }
 
   common::Hash256 make_twox256(gsl::span<const uint8_t> buf) {
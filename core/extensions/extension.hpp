@@ -31,6 +31,19 @@ namespace kagome::extensions {
     virtual void ext_clear_prefix(runtime::WasmPointer prefix_data,
                                   runtime::WasmSize prefix_length) = 0;
 
+    /**
+     * @brief Deletes at most the given number of values by keys containing
+     * given prefix, the next call deletes the ones left
+     * @param prefix pointer-size to the prefix
+     * @param limit pointer-size to the SCALE-encoded Option<u32> max number
+     * of the deleted values, none for no limit
+     * @return pointer-size to the SCALE-encoded KillStorageResult: the
+     * number of the deleted values, AllRemoved (0) if none is left or
+     * SomeRemaining (1) otherwise
+     */
+    virtual runtime::WasmSpan ext_storage_clear_prefix_version_2(
+        runtime::WasmSpan prefix, runtime::WasmSpan limit) = 0;
+
     /**
      * @brief Deletes value by given key
      * @param key_data pointer to the key
@@ -362,6 +375,39 @@ namespace kagome::extensions {
         runtime::WasmSpan msg,
         runtime::WasmPointer pubkey_data) = 0;
 
+    /**
+     * Starts a batch of the signature verifications, until it is finished
+     * the signatures passed to the batch verify functions are queued and
+     * verified all at once by ext_finish_batch_verify_v1
+     */
+    virtual void ext_start_batch_verify_v1() = 0;
+
+    /**
+     * Verifies the signatures queued since the batch was started
+     * @return 1 if all of them are valid, 0 otherwise
+     */
+    virtual runtime::WasmSize ext_finish_batch_verify_v1() = 0;
+
+    /**
+     * Verify the signature over the ed25519 message, or queue it if a batch
+     * is started
+     * @return 1 if the signature is valid or queued, 0 otherwise
+     */
+    virtual runtime::WasmSize ext_ed25519_batch_verify_v1(
+        runtime::WasmPointer sig_data,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data) = 0;
+
+    /**
+     * Verify the signature over the sr25519 message, or queue it if a batch
+     * is started
+     * @return 1 if the signature is valid or queued, 0 otherwise
+     */
+    virtual runtime::WasmSize ext_sr25519_batch_verify_v1(
+        runtime::WasmPointer sig_data,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data) = 0;
+
     // -------------------------Misc extensions--------------------------
     virtual uint64_t ext_chain_id() const = 0;
   };
@@ -6,10 +6,12 @@
 #include "extensions/impl/crypto_extension.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <gsl/span>
 
 #include <boost/assert.hpp>
+#include "common/hexutil.hpp"
 #include "crypto/bip39/bip39_provider.hpp"
 #include "crypto/bip39/mnemonic.hpp"
 #include "crypto/crypto_store.hpp"
@@ -18,6 +20,7 @@
 #include "crypto/hasher.hpp"
 #include "crypto/secp256k1/secp256k1_provider_impl.hpp"
 #include "crypto/sr25519_provider.hpp"
+#include "extensions/impl/memory_view.hpp"
 #include "runtime/wasm_result.hpp"
 #include "scale/scale.hpp"
 
@@ -41,7 +44,9 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<crypto::SignatureCache> signature_cache,
+      std::shared_ptr<common::WorkerPool> workers)
       : memory_(std::move(memory)),
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
@@ -49,6 +54,8 @@ namespace kagome::extensions {
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
         bip39_provider_(std::move(bip39_provider)),
+        signature_cache_(std::move(signature_cache)),
+        workers_(std::move(workers)),
         logger_{common::createLogger("CryptoExtension")} {
     BOOST_ASSERT(memory_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
@@ -63,7 +70,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_blake2_128(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->blake2b_128(buf);
 
@@ -73,7 +80,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_blake2_256(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->blake2b_256(buf);
 
@@ -83,7 +90,7 @@ namespace kagome::extensions {
   void CryptoExtension::ext_keccak_256(runtime::WasmPointer data,
                                        runtime::WasmSize len,
                                        runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->keccak_256(buf);
 
@@ -100,9 +107,9 @@ namespace kagome::extensions {
     static constexpr uint32_t kVerifySuccess = 0;
     static constexpr uint32_t kVerifyFail = 5;
 
-    auto msg = memory_->loadN(msg_data, msg_len);
+    auto msg = viewArgument(*memory_, msg_data, msg_len);
     auto sig_bytes =
-        memory_->loadN(sig_data, ed25519_constants::SIGNATURE_SIZE).toVector();
+        viewArgument(*memory_, sig_data, ed25519_constants::SIGNATURE_SIZE);
 
     auto signature_res = crypto::ED25519Signature::fromSpan(sig_bytes);
     if (!signature_res) {
@@ -111,15 +118,23 @@ namespace kagome::extensions {
     auto &&signature = signature_res.value();
 
     auto pubkey_bytes =
-        memory_->loadN(pubkey_data, ed25519_constants::PUBKEY_SIZE).toVector();
+        viewArgument(*memory_, pubkey_data, ed25519_constants::PUBKEY_SIZE);
     auto pubkey_res = crypto::ED25519PublicKey::fromSpan(pubkey_bytes);
     if (!pubkey_res) {
       BOOST_UNREACHABLE_RETURN(kVerifyFail);
     }
     auto pubkey = pubkey_res.value();
 
-    auto result = ed25519_provider_->verify(signature, msg, pubkey);
-    auto is_succeeded = result && result.value();
+    auto is_succeeded = verifyCached(
+        signature_cache_,
+        crypto::SignatureCache::Scheme::kEd25519,
+        signature,
+        msg,
+        pubkey,
+        [&] {
+          auto result = ed25519_provider_->verify(signature, msg, pubkey);
+          return result && result.value();
+        });
 
     return is_succeeded ? kVerifySuccess : kVerifyFail;
   }
@@ -134,12 +149,12 @@ namespace kagome::extensions {
     static constexpr uint32_t kVerifySuccess = 0;
     static constexpr uint32_t kVerifyFail = 5;
 
-    auto msg = memory_->loadN(msg_data, msg_len);
+    auto msg = viewArgument(*memory_, msg_data, msg_len);
     auto signature_buffer =
-        memory_->loadN(sig_data, sr25519_constants::SIGNATURE_SIZE);
+        viewArgument(*memory_, sig_data, sr25519_constants::SIGNATURE_SIZE);
 
     auto pubkey_buffer =
-        memory_->loadN(pubkey_data, sr25519_constants::PUBLIC_SIZE);
+        viewArgument(*memory_, pubkey_data, sr25519_constants::PUBLIC_SIZE);
     auto key_res = crypto::SR25519PublicKey::fromSpan(pubkey_buffer);
     if (!key_res) {
       BOOST_UNREACHABLE_RETURN(kVerifyFail);
@@ -151,8 +166,16 @@ namespace kagome::extensions {
                 sr25519_constants::SIGNATURE_SIZE,
                 signature.begin());
 
-    auto res = sr25519_provider_->verify(signature, msg, key);
-    bool is_succeeded = res && res.value();
+    bool is_succeeded = verifyCached(
+        signature_cache_,
+        crypto::SignatureCache::Scheme::kSr25519,
+        signature,
+        msg,
+        key,
+        [&] {
+          auto res = sr25519_provider_->verify(signature, msg, key);
+          return res && res.value();
+        });
 
     return is_succeeded ? kVerifySuccess : kVerifyFail;
   }
@@ -160,13 +183,13 @@ namespace kagome::extensions {
   void CryptoExtension::ext_twox_64(runtime::WasmPointer data,
                                     runtime::WasmSize len,
                                     runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->twox_64(buf);
-    logger_->trace("twox64. Data: {}, Data hex: {}, hash: {}",
-                   buf.data(),
-                   buf.toHex(),
-                   hash.toHex());
+    KAGOME_LOG_TRACE(logger_,
+                     "twox64. Data hex: {}, hash: {}",
+                     common::hex_lower(buf),
+                     hash);
 
     memory_->storeBuffer(out_ptr, hash);
   }
@@ -174,21 +197,21 @@ namespace kagome::extensions {
   void CryptoExtension::ext_twox_128(runtime::WasmPointer data,
                                      runtime::WasmSize len,
                                      runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->twox_128(buf);
-    logger_->trace("twox128. Data: {}, Data hex: {}, hash: {}",
-                   buf.data(),
-                   buf.toHex(),
-                   hash.toHex());
+    KAGOME_LOG_TRACE(logger_,
+                     "twox128. Data hex: {}, hash: {}",
+                     common::hex_lower(buf),
+                     hash);
 
-    memory_->storeBuffer(out_ptr, common::Buffer(hash));
+    memory_->storeBuffer(out_ptr, hash);
   }
 
   void CryptoExtension::ext_twox_256(runtime::WasmPointer data,
                                      runtime::WasmSize len,
                                      runtime::WasmPointer out_ptr) {
-    const auto &buf = memory_->loadN(data, len);
+    auto buf = viewArgument(*memory_, data, len);
 
     auto hash = hasher_->twox_256(buf);
 
@@ -308,7 +331,8 @@ namespace kagome::extensions {
                     decodeKeyTypeId(key_type_id));
     }
 
-    auto public_buffer = memory_->loadN(key, crypto::ED25519PublicKey::size());
+    auto public_buffer =
+        viewArgument(*memory_, key, crypto::ED25519PublicKey::size());
     auto [msg_data, msg_len] = runtime::WasmResult(msg);
     auto msg_buffer = memory_->loadN(msg_data, msg_len);
     auto pk = crypto::ED25519PublicKey::fromSpan(public_buffer);
@@ -414,7 +438,8 @@ namespace kagome::extensions {
       logger_->warn("key type '{}' is not officially supported", kt);
     }
 
-    auto public_buffer = memory_->loadN(key, crypto::SR25519PublicKey::size());
+    auto public_buffer =
+        viewArgument(*memory_, key, crypto::SR25519PublicKey::size());
     auto [msg_data, msg_len] = runtime::WasmResult(msg);
     auto msg_buffer = memory_->loadN(msg_data, msg_len);
     auto pk = crypto::SR25519PublicKey::fromSpan(public_buffer);
@@ -450,6 +475,136 @@ namespace kagome::extensions {
     return ext_sr25519_verify(msg_data, msg_len, sig, pubkey_data);
   }
 
+  void CryptoExtension::ext_start_batch_verify_v1() {
+    if (batch_) {
+      // a call which started it was aborted before finishing it
+      logger_->warn("batch of {} signature verifications is dropped",
+                    batch_->size());
+    }
+    batch_.emplace();
+  }
+
+  runtime::WasmSize CryptoExtension::ext_finish_batch_verify_v1() {
+    if (not batch_) {
+      logger_->error("finishing a batch verification, which is not started");
+      std::terminate();
+    }
+    auto verifications = std::move(batch_.value());
+    batch_.reset();
+    if (verifications.empty()) {
+      return 1;
+    }
+
+    // block imports queue a signature per extrinsic, which are independent,
+    // so they are checked by the workers; the first invalid one stops the
+    // rest
+    std::atomic_bool valid{true};
+    auto verify = [&](size_t i) {
+      if (valid and not verifications[i]()) {
+        valid = false;
+      }
+    };
+    if (workers_ != nullptr) {
+      workers_->parallelFor(verifications.size(), verify);
+    } else {
+      for (size_t i = 0; i < verifications.size() and valid; ++i) {
+        verify(i);
+      }
+    }
+    return valid ? 1 : 0;
+  }
+
+  runtime::WasmSize CryptoExtension::ext_ed25519_batch_verify_v1(
+      runtime::WasmPointer sig,
+      runtime::WasmSpan msg,
+      runtime::WasmPointer pubkey_data) {
+    auto [msg_data, msg_len] = runtime::WasmResult(msg);
+    auto signature = crypto::ED25519Signature::fromSpan(
+                         viewArgument(*memory_,
+                                      sig,
+                                      ed25519_constants::SIGNATURE_SIZE))
+                         .value();
+    auto pubkey = crypto::ED25519PublicKey::fromSpan(
+                      viewArgument(*memory_,
+                                   pubkey_data,
+                                   ed25519_constants::PUBKEY_SIZE))
+                      .value();
+    common::Buffer message(viewArgument(*memory_, msg_data, msg_len));
+    return batchVerify([provider = ed25519_provider_,
+                        cache = signature_cache_,
+                        signature,
+                        pubkey,
+                        message = std::move(message)] {
+      return verifyCached(cache,
+                          crypto::SignatureCache::Scheme::kEd25519,
+                          signature,
+                          message,
+                          pubkey,
+                          [&] {
+                            auto res =
+                                provider->verify(signature, message, pubkey);
+                            return res and res.value();
+                          });
+    });
+  }
+
+  runtime::WasmSize CryptoExtension::ext_sr25519_batch_verify_v1(
+      runtime::WasmPointer sig,
+      runtime::WasmSpan msg,
+      runtime::WasmPointer pubkey_data) {
+    auto [msg_data, msg_len] = runtime::WasmResult(msg);
+    crypto::SR25519Signature signature{};
+    auto signature_buffer =
+        viewArgument(*memory_, sig, sr25519_constants::SIGNATURE_SIZE);
+    std::copy_n(signature_buffer.begin(),
+                sr25519_constants::SIGNATURE_SIZE,
+                signature.begin());
+    auto pubkey = crypto::SR25519PublicKey::fromSpan(
+                      viewArgument(*memory_,
+                                   pubkey_data,
+                                   sr25519_constants::PUBLIC_SIZE))
+                      .value();
+    common::Buffer message(viewArgument(*memory_, msg_data, msg_len));
+    return batchVerify([provider = sr25519_provider_,
+                        cache = signature_cache_,
+                        signature,
+                        pubkey,
+                        message = std::move(message)] {
+      return verifyCached(cache,
+                          crypto::SignatureCache::Scheme::kSr25519,
+                          signature,
+                          message,
+                          pubkey,
+                          [&] {
+                            auto res =
+                                provider->verify(signature, message, pubkey);
+                            return res and res.value();
+                          });
+    });
+  }
+
+  runtime::WasmSize CryptoExtension::batchVerify(
+      std::function<bool()> verification) {
+    if (batch_) {
+      batch_->emplace_back(std::move(verification));
+      return 1;
+    }
+    return verification() ? 1 : 0;
+  }
+
+  bool CryptoExtension::verifyCached(
+      const std::shared_ptr<crypto::SignatureCache> &cache,
+      crypto::SignatureCache::Scheme scheme,
+      gsl::span<const uint8_t> signature,
+      gsl::span<const uint8_t> message,
+      gsl::span<const uint8_t> public_key,
+      const std::function<bool()> &verify) {
+    if (cache == nullptr) {
+      return verify();
+    }
+    return cache->verify(scheme, signature, message, public_key, verify);
+  }
+
   namespace {
     template <typename T>
     using failure_type =
@@ -481,8 +636,8 @@ namespace kagome::extensions {
     constexpr auto signature_size = RSVSignature::size();
     constexpr auto message_size = MessageHash::size();
 
-    auto sig_buffer = memory_->loadN(sig, signature_size);
-    auto msg_buffer = memory_->loadN(msg, message_size);
+    auto sig_buffer = viewArgument(*memory_, sig, signature_size);
+    auto msg_buffer = viewArgument(*memory_, msg, message_size);
 
     auto signature = RSVSignature::fromSpan(sig_buffer).value();
     auto message = MessageHash::fromSpan(msg_buffer).value();
@@ -520,8 +675,8 @@ namespace kagome::extensions {
     constexpr auto signature_size = RSVSignature::size();
     constexpr auto message_size = MessageHash::size();
 
-    auto sig_buffer = memory_->loadN(sig, signature_size);
-    auto msg_buffer = memory_->loadN(msg, message_size);
+    auto sig_buffer = viewArgument(*memory_, sig, signature_size);
+    auto msg_buffer = viewArgument(*memory_, msg, message_size);
 
     auto signature = RSVSignature::fromSpan(sig_buffer).value();
     auto message = MessageHash::fromSpan(msg_buffer).value();
@@ -6,9 +6,15 @@
 #ifndef KAGOME_CRYPTO_EXTENSION_HPP
 #define KAGOME_CRYPTO_EXTENSION_HPP
 
+#include <functional>
+
+#include <boost/optional.hpp>
+
 #include "common/logger.hpp"
+#include "common/worker_pool.hpp"
 #include "crypto/bip39/bip39_types.hpp"
 #include "crypto/crypto_store.hpp"
+#include "crypto/signature_cache.hpp"
 #include "runtime/wasm_memory.hpp"
 
 namespace kagome::crypto {
@@ -26,6 +32,12 @@ namespace kagome::extensions {
    */
   class CryptoExtension {
    public:
+    /**
+     * @param signature_cache keeps the signatures known to be valid, which
+     * are then not verified again, if any
+     * @param workers verify the signatures of a batch in parallel, if any;
+     * they are verified on the calling thread otherwise
+     */
     CryptoExtension(
         std::shared_ptr<runtime::WasmMemory> memory,
         std::shared_ptr<crypto::SR25519Provider> sr25519_provider,
@@ -33,7 +45,9 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<crypto::SignatureCache> signature_cache = nullptr,
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     /**
      * @see Extension::ext_blake2_128
@@ -144,6 +158,32 @@ namespace kagome::extensions {
                                             runtime::WasmSpan msg,
                                             runtime::WasmPointer pubkey_data);
 
+    /**
+     * @see Extension::ext_start_batch_verify_v1
+     */
+    void ext_start_batch_verify_v1();
+
+    /**
+     * @see Extension::ext_finish_batch_verify_v1
+     */
+    runtime::WasmSize ext_finish_batch_verify_v1();
+
+    /**
+     * @see Extension::ext_ed25519_batch_verify_v1
+     */
+    runtime::WasmSize ext_ed25519_batch_verify_v1(
+        runtime::WasmPointer sig,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data);
+
+    /**
+     * @see Extension::ext_sr25519_batch_verify_v1
+     */
+    runtime::WasmSize ext_sr25519_batch_verify_v1(
+        runtime::WasmPointer sig,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data);
+
     /**
      * @see Extension::ext_crypto_secp256k1_ecdsa_recover_v1
      */
@@ -159,6 +199,24 @@ namespace kagome::extensions {
    private:
     common::Blob<32> deriveSeed(std::string_view content);
 
+    /**
+     * Queues \arg verification if a batch is started, otherwise calls it
+     * @return 1 if the signature is valid or queued, 0 otherwise
+     */
+    runtime::WasmSize batchVerify(std::function<bool()> verification);
+
+    /**
+     * @return result of \arg verify for the arguments of a verify function,
+     * skipping it if the signature is in the signature cache
+     */
+    static bool verifyCached(
+        const std::shared_ptr<crypto::SignatureCache> &cache,
+        crypto::SignatureCache::Scheme scheme,
+        gsl::span<const uint8_t> signature,
+        gsl::span<const uint8_t> message,
+        gsl::span<const uint8_t> public_key,
+        const std::function<bool()> &verify);
+
     std::shared_ptr<runtime::WasmMemory> memory_;
     std::shared_ptr<crypto::SR25519Provider> sr25519_provider_;
     std::shared_ptr<crypto::ED25519Provider> ed25519_provider_;
@@ -166,7 +224,14 @@ namespace kagome::extensions {
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    std::shared_ptr<crypto::SignatureCache> signature_cache_;
+    std::shared_ptr<common::WorkerPool> workers_;
     common::Logger logger_;
+
+    // verifications of the signatures queued since a batch was started, none
+    // if there is no batch; each one owns copies of its arguments, as the
+    // wasm memory is changed before the batch is finished
+    boost::optional<std::vector<std::function<bool()>>> batch_;
   };
 }  // namespace kagome::extensions
 
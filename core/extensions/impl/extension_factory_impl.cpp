@@ -5,6 +5,7 @@
 
 #include "extensions/impl/extension_factory_impl.hpp"
 
+#include "crypto/secp256k1/cached_secp256k1_provider.hpp"
 #include "extensions/impl/extension_impl.hpp"
 
 namespace kagome::extensions {
@@ -16,14 +17,19 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<common::WorkerPool> workers)
       : changes_tracker_{std::move(tracker)},
         sr25519_provider_(std::move(sr25519_provider)),
         ed25519_provider_(std::move(ed25519_provider)),
-        secp256k1_provider_(std::move(secp256k1_provider)),
+        secp256k1_provider_(std::make_shared<crypto::CachedSecp256k1Provider>(
+            std::move(secp256k1_provider), kRecoveryCacheSize)),
         hasher_(std::move(hasher)),
         crypto_store_(std::move(crypto_store)),
-        bip39_provider_(std::move(bip39_provider)) {
+        bip39_provider_(std::move(bip39_provider)),
+        signature_cache_{
+            std::make_shared<crypto::SignatureCache>(kSignatureCacheSize)},
+        workers_{std::move(workers)} {
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(sr25519_provider_ != nullptr);
     BOOST_ASSERT(ed25519_provider_ != nullptr);
@@ -44,6 +50,8 @@ namespace kagome::extensions {
                                            secp256k1_provider_,
                                            hasher_,
                                            crypto_store_,
-                                           bip39_provider_);
+                                           bip39_provider_,
+                                           signature_cache_,
+                                           workers_);
   }
 }  // namespace kagome::extensions
@@ -8,11 +8,13 @@
 
 #include "extensions/extension_factory.hpp"
 
+#include "common/worker_pool.hpp"
 #include "crypto/bip39/bip39_provider.hpp"
 #include "crypto/crypto_store.hpp"
 #include "crypto/ed25519_provider.hpp"
 #include "crypto/hasher.hpp"
 #include "crypto/secp256k1_provider.hpp"
+#include "crypto/signature_cache.hpp"
 #include "crypto/sr25519_provider.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 
@@ -20,8 +22,20 @@ namespace kagome::extensions {
 
   class ExtensionFactoryImpl : public ExtensionFactory {
    public:
+    // max number of the valid signatures kept, about the number of the
+    // extrinsics in a full transaction pool
+    static constexpr size_t kSignatureCacheSize = 8192;
+
+    // max number of the secp256k1 public keys kept, the same as the number
+    // of the signatures
+    static constexpr size_t kRecoveryCacheSize = 8192;
+
     ~ExtensionFactoryImpl() override = default;
 
+    /**
+     * @param workers verify the batches of signatures of the extensions in
+     * parallel, if any
+     */
     ExtensionFactoryImpl(
         std::shared_ptr<storage::changes_trie::ChangesTracker> tracker,
         std::shared_ptr<crypto::SR25519Provider> sr25519_provider,
@@ -29,7 +43,8 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     std::shared_ptr<Extension> createExtension(
         std::shared_ptr<runtime::WasmMemory> memory,
@@ -40,10 +55,15 @@ namespace kagome::extensions {
     std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
     std::shared_ptr<crypto::SR25519Provider> sr25519_provider_;
     std::shared_ptr<crypto::ED25519Provider> ed25519_provider_;
+    // keeps the recovered keys for all the extensions created
     std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider_;
     std::shared_ptr<crypto::Hasher> hasher_;
     std::shared_ptr<crypto::CryptoStore> crypto_store_;
     std::shared_ptr<crypto::Bip39Provider> bip39_provider_;
+    // shared by the extensions of all the runtime instances, so that the
+    // signatures checked by the transaction pool are known to block imports
+    std::shared_ptr<crypto::SignatureCache> signature_cache_;
+    std::shared_ptr<common::WorkerPool> workers_;
   };
 
 }  // namespace kagome::extensions
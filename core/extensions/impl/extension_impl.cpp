@@ -25,7 +25,9 @@ namespace kagome::extensions {
       std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
       std::shared_ptr<crypto::Hasher> hasher,
       std::shared_ptr<crypto::CryptoStore> crypto_store,
-      std::shared_ptr<crypto::Bip39Provider> bip39_provider)
+      std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+      std::shared_ptr<crypto::SignatureCache> signature_cache,
+      std::shared_ptr<common::WorkerPool> workers)
       : memory_(memory),
         storage_provider_(std::move(storage_provider)),
         crypto_ext_(memory,
@@ -34,7 +36,9 @@ namespace kagome::extensions {
                     std::move(secp256k1_provider),
                     std::move(hasher),
                     std::move(crypto_store),
-                    std::move(bip39_provider)),
+                    std::move(bip39_provider),
+                    std::move(signature_cache),
+                    std::move(workers)),
         io_ext_(memory),
         memory_ext_(memory),
         storage_ext_(storage_provider_, memory_, std::move(tracker)) {
@@ -53,6 +57,11 @@ namespace kagome::extensions {
     return storage_ext_.ext_clear_prefix(prefix_data, prefix_length);
   }
 
+  runtime::WasmSpan ExtensionImpl::ext_storage_clear_prefix_version_2(
+      runtime::WasmSpan prefix, runtime::WasmSpan limit) {
+    return storage_ext_.ext_storage_clear_prefix_version_2(prefix, limit);
+  }
+
   void ExtensionImpl::ext_clear_storage(runtime::WasmPointer key_data,
                                         runtime::WasmSize key_length) {
     return storage_ext_.ext_clear_storage(key_data, key_length);
@@ -250,6 +259,28 @@ namespace kagome::extensions {
     return crypto_ext_.ext_sr25519_verify_v1(sig_data, msg, pubkey_data);
   }
 
+  void ExtensionImpl::ext_start_batch_verify_v1() {
+    crypto_ext_.ext_start_batch_verify_v1();
+  }
+
+  runtime::WasmSize ExtensionImpl::ext_finish_batch_verify_v1() {
+    return crypto_ext_.ext_finish_batch_verify_v1();
+  }
+
+  runtime::WasmSize ExtensionImpl::ext_ed25519_batch_verify_v1(
+      runtime::WasmPointer sig_data,
+      runtime::WasmSpan msg,
+      runtime::WasmPointer pubkey_data) {
+    return crypto_ext_.ext_ed25519_batch_verify_v1(sig_data, msg, pubkey_data);
+  }
+
+  runtime::WasmSize ExtensionImpl::ext_sr25519_batch_verify_v1(
+      runtime::WasmPointer sig_data,
+      runtime::WasmSpan msg,
+      runtime::WasmPointer pubkey_data) {
+    return crypto_ext_.ext_sr25519_batch_verify_v1(sig_data, msg, pubkey_data);
+  }
+
   /// misc extensions
   uint64_t ExtensionImpl::ext_chain_id() const {
     return misc_ext_.ext_chain_id();
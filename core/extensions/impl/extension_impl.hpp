@@ -29,7 +29,9 @@ namespace kagome::extensions {
         std::shared_ptr<crypto::Secp256k1Provider> secp256k1_provider,
         std::shared_ptr<crypto::Hasher> hasher,
         std::shared_ptr<crypto::CryptoStore> crypto_store,
-        std::shared_ptr<crypto::Bip39Provider> bip39_provider);
+        std::shared_ptr<crypto::Bip39Provider> bip39_provider,
+        std::shared_ptr<crypto::SignatureCache> signature_cache = nullptr,
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
 
     ~ExtensionImpl() override = default;
 
@@ -40,6 +42,9 @@ namespace kagome::extensions {
     void ext_clear_prefix(runtime::WasmPointer prefix_data,
                           runtime::WasmSize prefix_length) override;
 
+    runtime::WasmSpan ext_storage_clear_prefix_version_2(
+        runtime::WasmSpan prefix, runtime::WasmSpan limit) override;
+
     void ext_clear_storage(runtime::WasmPointer key_data,
                            runtime::WasmSize key_length) override;
 
@@ -167,6 +172,21 @@ namespace kagome::extensions {
         runtime::WasmPointer sig_data,
         runtime::WasmSpan msg,
         runtime::WasmPointer pubkey_data) override;
+
+    void ext_start_batch_verify_v1() override;
+
+    runtime::WasmSize ext_finish_batch_verify_v1() override;
+
+    runtime::WasmSize ext_ed25519_batch_verify_v1(
+        runtime::WasmPointer sig_data,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data) override;
+
+    runtime::WasmSize ext_sr25519_batch_verify_v1(
+        runtime::WasmPointer sig_data,
+        runtime::WasmSpan msg,
+        runtime::WasmPointer pubkey_data) override;
+
     // -------------------------Misc extensions--------------------------
 
     uint64_t ext_chain_id() const override;
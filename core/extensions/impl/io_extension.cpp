@@ -5,6 +5,8 @@
 
 #include "extensions/impl/io_extension.hpp"
 #include <runtime/wasm_result.hpp>
+#include "common/hexutil.hpp"
+#include "extensions/impl/memory_view.hpp"
 
 namespace kagome::extensions {
   IOExtension::IOExtension(std::shared_ptr<runtime::WasmMemory> memory)
@@ -15,8 +17,8 @@ namespace kagome::extensions {
 
   void IOExtension::ext_print_hex(runtime::WasmPointer data,
                                   runtime::WasmSize length) {
-    const auto &buf = memory_->loadN(data, length);
-    logger_->info("hex value: {}", buf.toHex());
+    auto buf = viewArgument(*memory_, data, length);
+    logger_->info("hex value: {}", common::hex_lower(buf));
   }
 
   void IOExtension::ext_logging_log_version_1(
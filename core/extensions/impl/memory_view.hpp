@@ -0,0 +1,42 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_EXTENSIONS_IMPL_MEMORY_VIEW_HPP
+#define KAGOME_EXTENSIONS_IMPL_MEMORY_VIEW_HPP
+
+#include <exception>
+
+#include <gsl/span>
+
+#include "common/logger.hpp"
+#include "runtime/wasm_memory.hpp"
+
+namespace kagome::extensions {
+
+  /**
+   * Refers to an argument of a host function in the wasm memory instead of
+   * copying it. The view must not be used after the memory is resized, i.e.
+   * after anything is allocated in it
+   * @return view of \arg n bytes at \arg addr, the program is terminated if
+   * they are out of the memory, as when the wasm code accesses them
+   */
+  inline gsl::span<const uint8_t> viewArgument(
+      const runtime::WasmMemory &memory,
+      runtime::WasmPointer addr,
+      runtime::WasmSize n) {
+    auto view = memory.view(addr, n);
+    if (not view) {
+      common::createLogger("Extensions")
+          ->error("argument of {} bytes at {} is out of the wasm memory",
+                  n,
+                  addr);
+      std::terminate();
+    }
+    return view.value();
+  }
+
+}  // namespace kagome::extensions
+
+#endif  // KAGOME_EXTENSIONS_IMPL_MEMORY_VIEW_HPP
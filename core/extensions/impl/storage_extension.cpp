@@ -5,10 +5,13 @@
 
 #include "extensions/impl/storage_extension.hpp"
 
-#include <forward_list>
+#include <limits>
+#include <vector>
 
+#include "extensions/impl/memory_view.hpp"
 #include "primitives/block_id.hpp"
 #include "runtime/wasm_result.hpp"
+#include "scale/scale.hpp"
 #include "storage/changes_trie/impl/changes_trie.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 #include "storage/trie/serialization/ordered_trie_hash.hpp"
@@ -37,6 +40,7 @@ namespace kagome::extensions {
 
   void StorageExtension::ext_clear_prefix(runtime::WasmPointer prefix_data,
                                           runtime::WasmSize prefix_length) {
+    resetNextKeyCursor();
     auto batch = storage_provider_->getCurrentBatch();
     auto prefix = memory_->loadN(prefix_data, prefix_length);
     auto res = batch->clearPrefix(prefix);
@@ -45,10 +49,48 @@ namespace kagome::extensions {
     }
   }
 
+  runtime::WasmSpan StorageExtension::ext_storage_clear_prefix_version_2(
+      runtime::WasmSpan prefix_span, runtime::WasmSpan limit_span) {
+    // KillStorageResult variants
+    static constexpr uint8_t kAllRemoved = 0;
+    static constexpr uint8_t kSomeRemaining = 1;
+
+    resetNextKeyCursor();
+    auto [prefix_ptr, prefix_size] = runtime::WasmResult(prefix_span);
+    auto prefix = memory_->loadN(prefix_ptr, prefix_size);
+    auto [limit_ptr, limit_size] = runtime::WasmResult(limit_span);
+    auto limit_res = scale::decode<boost::optional<uint32_t>>(
+        memory_->loadN(limit_ptr, limit_size));
+    if (not limit_res) {
+      logger_->error("ext_storage_clear_prefix_version_2 failed to decode "
+                     "the limit: {}",
+                     limit_res.error().message());
+      std::terminate();
+    }
+    auto limit = limit_res.value().value_or(
+        std::numeric_limits<uint32_t>::max());
+
+    auto batch = storage_provider_->getCurrentBatch();
+    storage::trie::ClearPrefixResult result;
+    if (auto res = batch->clearPrefix(prefix, limit); res) {
+      result = res.value();
+    } else {
+      logger_->error("ext_storage_clear_prefix_version_2 failed: {}",
+                     res.error().message());
+    }
+    auto encoded =
+        scale::encode(result.all_removed ? kAllRemoved : kSomeRemaining,
+                      result.removed)
+            .value();
+    return memory_->storeBuffer(encoded);
+  }
+
   void StorageExtension::ext_clear_storage(runtime::WasmPointer key_data,
                                            runtime::WasmSize key_length) {
+    resetNextKeyCursor();
     auto batch = storage_provider_->getCurrentBatch();
     auto key = memory_->loadN(key_data, key_length);
+    storage_provider_->recordAccess(key);
     auto del_result = batch->remove(key);
     if (not del_result) {
       logger_->warn(
@@ -63,6 +105,7 @@ namespace kagome::extensions {
       runtime::WasmPointer key_data, runtime::WasmSize key_length) const {
     auto batch = storage_provider_->getCurrentBatch();
     auto key = memory_->loadN(key_data, key_length);
+    storage_provider_->recordAccess(key);
     return batch->contains(key) ? 1 : 0;
   }
 
@@ -72,6 +115,7 @@ namespace kagome::extensions {
       runtime::WasmPointer len_ptr) {
     auto batch = storage_provider_->getCurrentBatch();
     auto key = memory_->loadN(key_data, key_length);
+    storage_provider_->recordAccess(key);
     auto data = batch->get(key);
     const auto length = data.has_value() ? data.value().size()
                                          : runtime::WasmMemory::kMaxMemorySize;
@@ -82,8 +126,8 @@ namespace kagome::extensions {
     }
     if (not data.value().empty())
       logger_->trace("ext_get_allocated_storage. Key hex: {} Value hex {}",
-                     key.toHex(),
-                     data.value().toHex());
+                     key,
+                     data.value());
 
     auto data_ptr = memory_->allocate(length);
 
@@ -106,17 +150,15 @@ namespace kagome::extensions {
     auto key = memory_->loadN(key_data, key_length);
     auto data = get(key, value_offset, value_length);
     if (not data) {
-      logger_->trace("ext_get_storage_into. Val by key {} not found",
-                     key.toHex());
+      logger_->trace("ext_get_storage_into. Val by key {} not found", key);
       return runtime::WasmMemory::kMaxMemorySize;
     }
     if (not data.value().empty()) {
       logger_->trace("ext_get_storage_into. Key hex: {} , Value hex {}",
-                     key.toHex(),
-                     data.value().toHex());
+                     key,
+                     data.value());
     } else {
-      logger_->trace("ext_get_storage_into. Key hex: {} Value: empty",
-                     key.toHex());
+      logger_->trace("ext_get_storage_into. Key hex: {} Value: empty", key);
     }
     memory_->storeBuffer(value_data, data.value());
     return data.value().size();
@@ -146,20 +188,25 @@ namespace kagome::extensions {
     auto key = memory_->loadN(key_data, key_length);
     auto value = memory_->loadN(value_data, value_length);
 
-    if (value.toHex().size() < 500) {
-      logger_->trace(
-          "Set storage. Key: {}, Key hex: {} Value: {}, Value hex {}",
-          key.data(),
-          key.toHex(),
-          value.data(),
-          value.toHex());
-    } else {
-      logger_->trace(
-          "Set storage. Key: {}, Key hex: {} Value is too big to display",
-          key.data(),
-          key.toHex());
+    // big values are costly to hex encode, which is done for the trace only
+    if (logger_->should_log(spdlog::level::trace)) {
+      if (value.size() < 250) {
+        logger_->trace(
+            "Set storage. Key: {}, Key hex: {} Value: {}, Value hex {}",
+            key.data(),
+            key,
+            value.data(),
+            value);
+      } else {
+        logger_->trace(
+            "Set storage. Key: {}, Key hex: {} Value is too big to display",
+            key.data(),
+            key);
+      }
     }
 
+    resetNextKeyCursor();
+    storage_provider_->recordAccess(key);
     auto batch = storage_provider_->getCurrentBatch();
     auto put_result = batch->put(key, value);
     if (not put_result) {
@@ -180,15 +227,15 @@ namespace kagome::extensions {
     for (size_t i = 0; i < values_num; i++) {
       lengths.at(i) = memory_->load32u(lengths_data + i * 4);
     }
-    std::forward_list<Buffer> values(values_num);
+    std::vector<gsl::span<const uint8_t>> values;
+    values.reserve(values_num);
     uint32_t offset = 0;
-    auto curr_value = values.begin();
-    for (size_t i = 0; i < values_num; i++, curr_value++) {
-      *curr_value = memory_->loadN(values_data + offset, lengths.at(i));
+    for (size_t i = 0; i < values_num; i++) {
+      values.push_back(
+          viewArgument(*memory_, values_data + offset, lengths.at(i)));
       offset += lengths.at(i);
     }
-    auto ordered_hash =
-        storage::trie::calculateOrderedTrieHash(values.begin(), values.end());
+    auto ordered_hash = storage::trie::calculateOrderedTrieHash(values);
     if (ordered_hash.has_value()) {
       memory_->storeBuffer(result, ordered_hash.value());
     } else {
@@ -229,7 +276,7 @@ namespace kagome::extensions {
     }
 
     auto parent_hash_bytes =
-        memory_->loadN(parent_hash_data, common::Hash256::size());
+        viewArgument(*memory_, parent_hash_data, common::Hash256::size());
     common::Hash256 parent_hash;
     std::copy_n(parent_hash_bytes.begin(),
                 common::Hash256::size(),
@@ -244,7 +291,7 @@ namespace kagome::extensions {
     logger_->debug(
         "ext_storage_changes_root constructing changes trie with parent_hash: "
         "{}",
-        parent_hash.toHex());
+        parent_hash);
     auto trie_hash_res = changes_tracker_->constructChangesTrie(
         parent_hash, trie_config.value());
     if (trie_hash_res.has_error()) {
@@ -254,32 +301,25 @@ namespace kagome::extensions {
     }
     common::Buffer result_buf(trie_hash_res.value());
     logger_->debug("ext_storage_changes_root with parent_hash {} result is: {}",
-                   parent_hash.toHex(),
-                   result_buf.toHex());
+                   parent_hash,
+                   result_buf);
     memory_->storeBuffer(result, result_buf);
     return result_buf.size();
   }
 
   void StorageExtension::ext_storage_root(runtime::WasmPointer result) const {
-    if (auto opt_batch = storage_provider_->tryGetPersistentBatch();
-        opt_batch.has_value() and opt_batch.value() != nullptr) {
-      auto res = opt_batch.value()->commit();
-      if (res.has_error()) {
-        logger_->error("ext_storage_root resulted with an error: {}",
-                       res.error().message());
-      }
-      const auto &root = res.value();
-      memory_->storeBuffer(result, root);
-    } else {
+    // the root is calculated in the memory, the state is written to the
+    // storage once, when its block is imported
+    if (not storage_provider_->isCurrentlyPersistent()) {
       logger_->warn("ext_storage_root called in an ephemeral extension");
-      auto res = storage_provider_->forceCommit();
-      if (res.has_error()) {
-        logger_->error("ext_storage_root resulted with an error: {}",
-                       res.error().message());
-      }
-      const auto &root = res.value();
-      memory_->storeBuffer(result, root);
     }
+    auto res = storage_provider_->calculateRoot();
+    if (res.has_error()) {
+      logger_->error("ext_storage_root resulted with an error: {}",
+                     res.error().message());
+      return;
+    }
+    memory_->storeBuffer(result, res.value());
   }
 
   runtime::WasmSpan StorageExtension::ext_storage_next_key_version_1(
@@ -309,6 +349,7 @@ namespace kagome::extensions {
       const common::Buffer &key,
       runtime::WasmSize offset,
       runtime::WasmSize max_length) const {
+    storage_provider_->recordAccess(key);
     auto batch = storage_provider_->getCurrentBatch();
     OUTCOME_TRY(data, batch->get(key));
 
@@ -322,13 +363,37 @@ namespace kagome::extensions {
   outcome::result<boost::optional<Buffer>> StorageExtension::getStorageNextKey(
       const common::Buffer &key) const {
     auto batch = storage_provider_->getCurrentBatch();
-    auto cursor = batch->cursor();
-    OUTCOME_TRY(cursor->seek(key));
-    OUTCOME_TRY(cursor->next());
-    if (cursor->isValid()) {
-      OUTCOME_TRY(next_key, cursor->key());
-      return boost::make_optional(next_key);
+    auto &cache = next_key_cursor_;
+    if (cache.cursor != nullptr and cache.key == key
+        and cache.batch.lock() == batch) {
+      if (auto res = cache.cursor->next(); not res) {
+        resetNextKeyCursor();
+        return res.error();
+      }
+    } else {
+      cache.batch = batch;
+      cache.cursor = batch->cursor();
+      if (auto res = cache.cursor->seekUpperBound(key); not res) {
+        resetNextKeyCursor();
+        return res.error();
+      }
+    }
+    if (not cache.cursor->isValid()) {
+      resetNextKeyCursor();
+      return boost::none;
     }
-    return boost::none;
+    auto next_key = cache.cursor->key();
+    if (not next_key) {
+      resetNextKeyCursor();
+      return next_key.error();
+    }
+    cache.key = next_key.value();
+    return boost::make_optional(std::move(next_key.value()));
+  }
+
+  void StorageExtension::resetNextKeyCursor() const {
+    next_key_cursor_.cursor.reset();
+    next_key_cursor_.batch.reset();
+    next_key_cursor_.key.clear();
   }
 }  // namespace kagome::extensions
@@ -32,6 +32,12 @@ namespace kagome::extensions {
     void ext_clear_prefix(runtime::WasmPointer prefix_data,
                           runtime::WasmSize prefix_length);
 
+    /**
+     * @see Extension::ext_storage_clear_prefix_version_2
+     */
+    runtime::WasmSpan ext_storage_clear_prefix_version_2(
+        runtime::WasmSpan prefix, runtime::WasmSpan limit);
+
     /**
      * @see Extension::ext_clear_storage
      */
@@ -122,6 +128,28 @@ namespace kagome::extensions {
     outcome::result<boost::optional<common::Buffer>> getStorageNextKey(
         const common::Buffer &key) const;
 
+    /**
+     * Drops the cursor of the previous ext_storage_next_key call, must be
+     * called on every storage modification
+     */
+    void resetNextKeyCursor() const;
+
+    /**
+     * Runtime iterates over the storage by a sequence of next key calls, each
+     * starting from the key returned by the previous one. The cursor which
+     * found that key is kept to continue from its position instead of
+     * seeking from the root again.
+     * @note the extension is the only one to modify the batches of the
+     * storage provider, that's why it's enough to reset the cursor in its
+     * modifying methods
+     */
+    struct NextKeyCursor {
+      std::weak_ptr<runtime::TrieStorageProvider::Batch> batch;
+      std::unique_ptr<storage::BufferMapCursor> cursor;
+      common::Buffer key;
+    };
+    mutable NextKeyCursor next_key_cursor_;
+
     std::shared_ptr<runtime::TrieStorageProvider> storage_provider_;
     std::shared_ptr<runtime::WasmMemory> memory_;
     std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
@@ -6,6 +6,9 @@
 #ifndef KAGOME_CORE_INJECTOR_APPLICATION_INJECTOR_HPP
 #define KAGOME_CORE_INJECTOR_APPLICATION_INJECTOR_HPP
 
+#include <map>
+#include <unordered_set>
+
 #include <boost/di.hpp>
 #include <boost/di/extension/scopes/shared.hpp>
 #include <crypto/bip39/impl/bip39_provider_impl.hpp>
@@ -16,24 +19,33 @@
 #include <libp2p/peer/peer_info.hpp>
 #include <outcome/outcome.hpp>
 
+#include "api/scale/scale_rpc_service.hpp"
 #include "api/service/api_service.hpp"
 #include "api/service/author/author_jrpc_processor.hpp"
 #include "api/service/author/impl/author_api_impl.hpp"
 #include "api/service/chain/chain_jrpc_processor.hpp"
 #include "api/service/chain/impl/chain_api_impl.hpp"
+#include "api/service/profile/impl/profile_api_impl.hpp"
+#include "api/service/profile/profile_jrpc_processor.hpp"
 #include "api/service/state/impl/readonly_trie_builder_impl.hpp"
 #include "api/service/state/impl/state_api_impl.hpp"
 #include "api/service/state/state_jrpc_processor.hpp"
+#include "api/service/subscription/subscription_jrpc_processor.hpp"
 #include "api/transport/impl/http/http_listener_impl.hpp"
 #include "api/transport/impl/http/http_session.hpp"
+#include "api/transport/impl/http/metrics_listener.hpp"
+#include "api/transport/impl/unix/unix_listener_impl.hpp"
+#include "api/transport/impl/unix/unix_session.hpp"
 #include "api/transport/impl/ws/ws_listener_impl.hpp"
 #include "api/transport/impl/ws/ws_session.hpp"
 #include "api/transport/rpc_thread_pool.hpp"
+#include "application/app_config.hpp"
 #include "application/impl/app_state_manager_impl.hpp"
 #include "application/impl/configuration_storage_impl.hpp"
 #include "authorship/impl/block_builder_factory_impl.hpp"
 #include "authorship/impl/block_builder_impl.hpp"
 #include "authorship/impl/proposer_impl.hpp"
+#include "blockchain/impl/block_header_cache.hpp"
 #include "blockchain/impl/block_tree_impl.hpp"
 #include "blockchain/impl/key_value_block_header_repository.hpp"
 #include "blockchain/impl/key_value_block_storage.hpp"
@@ -41,12 +53,19 @@
 #include "boost/di/extension/injections/extensible_injector.hpp"
 #include "clock/impl/basic_waitable_timer.hpp"
 #include "clock/impl/clock_impl.hpp"
+#include "common/memory_arena.hpp"
 #include "common/outcome_throw.hpp"
+#include "common/cache_budget.hpp"
+#include "common/process_profiler.hpp"
+#include "common/tracer.hpp"
+#include "common/worker_pool.hpp"
 #include "consensus/babe/babe_lottery.hpp"
 #include "consensus/babe/common.hpp"
 #include "consensus/babe/impl/babe_lottery_impl.hpp"
 #include "consensus/babe/impl/babe_synchronizer_impl.hpp"
 #include "consensus/babe/impl/epoch_storage_impl.hpp"
+#include "consensus/babe/impl/warp_sync.hpp"
+#include "consensus/consensus_metrics.hpp"
 #include "consensus/grandpa/impl/environment_impl.hpp"
 #include "consensus/grandpa/impl/vote_crypto_provider_impl.hpp"
 #include "consensus/grandpa/structs.hpp"
@@ -62,9 +81,13 @@
 #include "network/impl/dummy_sync_protocol_client.hpp"
 #include "network/impl/extrinsic_observer_impl.hpp"
 #include "network/impl/gossiper_broadcast.hpp"
+#include "network/impl/light_protocol_observer_impl.hpp"
+#include "network/impl/peer_manager_impl.hpp"
 #include "network/impl/remote_sync_protocol_client.hpp"
 #include "network/impl/router_libp2p.hpp"
+#include "network/impl/storage_read_executor.hpp"
 #include "network/impl/sync_protocol_observer_impl.hpp"
+#include "network/network_metrics.hpp"
 #include "network/sync_protocol_client.hpp"
 #include "network/sync_protocol_observer.hpp"
 #include "network/types/sync_clients_set.hpp"
@@ -77,19 +100,37 @@
 #include "runtime/binaryen/runtime_api/metadata_impl.hpp"
 #include "runtime/binaryen/runtime_api/offchain_worker_impl.hpp"
 #include "runtime/binaryen/runtime_api/parachain_host_impl.hpp"
+#include "runtime/binaryen/runtime_api/raw_call_impl.hpp"
 #include "runtime/binaryen/runtime_api/tagged_transaction_queue_impl.hpp"
+#include "runtime/binaryen/runtime_upgrade_preparer.hpp"
+#include "runtime/common/offchain_worker_scheduler.hpp"
 #include "runtime/common/storage_wasm_provider.hpp"
 #include "runtime/common/trie_storage_provider_impl.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
+#include "storage/deferred_write/deferred_write_storage.hpp"
+#include "storage/group_commit/group_commit_storage.hpp"
+#include "storage/in_memory/arena_storage.hpp"
 #include "storage/leveldb/leveldb.hpp"
+#ifdef KAGOME_WITH_ROCKSDB
+#include "storage/rocksdb/rocksdb.hpp"
+#endif
 #include "storage/predefined_keys.hpp"
+#include "storage/space.hpp"
+#include "storage/trie/impl/large_value_trie_storage_backend.hpp"
+#include "storage/trie/impl/snapshot_trie_storage_backend.hpp"
+#include "storage/trie/impl/state_prefetcher.hpp"
+#include "storage/trie/impl/trie_pruner_impl.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/sorted_trie_builder.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "telemetry/telemetry_client.hpp"
 #include "transaction_pool/impl/pool_moderator_impl.hpp"
+#include "transaction_pool/impl/pool_revalidator_impl.hpp"
 #include "transaction_pool/impl/transaction_pool_impl.hpp"
 
 namespace kagome::injector {
@@ -144,6 +185,10 @@ namespace kagome::injector {
         injector.template create<std::shared_ptr<api::HttpListenerImpl>>(),
         injector.template create<std::shared_ptr<api::WsListenerImpl>>(),
     };
+    if (auto unix_listener =
+            injector.template create<std::shared_ptr<api::UnixListenerImpl>>()) {
+      listeners.emplace_back(std::move(unix_listener));
+    }
     auto server = injector.template create<std::shared_ptr<api::JRpcServer>>();
     std::vector<std::shared_ptr<api::JRpcProcessor>> processors{
         injector
@@ -151,13 +196,23 @@ namespace kagome::injector {
         injector.template create<
             std::shared_ptr<api::author::AuthorJRpcProcessor>>(),
         injector.template create<
-            std::shared_ptr<api::chain::ChainJrpcProcessor>>()};
+            std::shared_ptr<api::chain::ChainJrpcProcessor>>(),
+        injector.template create<
+            std::shared_ptr<api::profile::ProfileJrpcProcessor>>(),
+        injector.template create<
+            std::shared_ptr<api::subscription::SubscriptionJrpcProcessor>>()};
+    auto subscription_engine =
+        injector.template create<std::shared_ptr<api::SubscriptionEngine>>();
+    auto rpc_metrics =
+        injector.template create<std::shared_ptr<api::RpcMetrics>>();
     initialized =
         std::make_shared<api::ApiService>(std::move(app_state_manager),
                                           std::move(rpc_thread_pool),
                                           std::move(listeners),
                                           std::move(server),
-                                          processors);
+                                          processors,
+                                          std::move(subscription_engine),
+                                          std::move(rpc_metrics));
     return initialized.value();
   }
 
@@ -188,6 +243,200 @@ namespace kagome::injector {
     return initialized.value();
   }
 
+  // registry of the metrics, the subsystems keeping the statistics of their
+  // own are collected into on the scrapes
+  template <typename Injector>
+  sptr<common::MetricsRegistry> get_metrics_registry(
+      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<common::MetricsRegistry>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    auto registry = std::make_shared<common::MetricsRegistry>();
+    auto rpc_metrics = injector.template create<sptr<api::RpcMetrics>>();
+    registry->addCollector(
+        [rpc_metrics](auto &writer) { rpc_metrics->collect(writer); });
+    auto network_metrics =
+        injector.template create<sptr<network::NetworkMetrics>>();
+    registry->addCollector(
+        [network_metrics](auto &writer) { network_metrics->collect(writer); });
+    auto consensus_metrics =
+        injector.template create<sptr<consensus::ConsensusMetrics>>();
+    registry->addCollector([consensus_metrics](auto &writer) {
+      consensus_metrics->collect(writer);
+    });
+    registry->addCollector(
+        [](auto &writer) { common::ProcessProfiler::collect(writer); });
+    registry->addCollector(
+        [](auto &writer) { common::MemoryArenas::collect(writer); });
+    if (auto budget = injector.template create<sptr<common::CacheBudget>>()) {
+      registry->addCollector(
+          [budget](auto &writer) { budget->collect(writer); });
+    }
+    // the state of the chain, of the pool and of the peers, which the
+    // telemetry reports
+    auto block_tree = injector.template create<sptr<blockchain::BlockTree>>();
+    auto pool =
+        injector.template create<sptr<transaction_pool::TransactionPool>>();
+    auto host = injector.template create<sptr<libp2p::Host>>();
+    registry->addCollector([block_tree, pool, host](auto &writer) {
+      using Type = common::MetricsRegistry::Type;
+      writer.family("kagome_block_height",
+                    Type::GAUGE,
+                    "Number of the best and of the last finalized block");
+      writer.sample(
+          "kagome_block_height",
+          {{"status", "best"}},
+          static_cast<uint64_t>(block_tree->deepestLeaf().block_number));
+      writer.sample(
+          "kagome_block_height",
+          {{"status", "finalized"}},
+          static_cast<uint64_t>(block_tree->getLastFinalized().block_number));
+      auto status = pool->getStatus();
+      writer.family("kagome_transaction_pool_transactions",
+                    Type::GAUGE,
+                    "Transactions in the pool");
+      writer.sample("kagome_transaction_pool_transactions",
+                    {{"state", "ready"}},
+                    static_cast<uint64_t>(status.ready_num));
+      writer.sample("kagome_transaction_pool_transactions",
+                    {{"state", "waiting"}},
+                    static_cast<uint64_t>(status.waiting_num));
+      writer.family("kagome_transaction_pool_bytes",
+                    Type::GAUGE,
+                    "Size of the transactions in the pool");
+      writer.sample("kagome_transaction_pool_bytes",
+                    {},
+                    static_cast<uint64_t>(status.bytes));
+      // a peer may be connected several times
+      std::unordered_set<libp2p::peer::PeerId> peers;
+      for (auto &connection :
+           host->getNetwork().getConnectionManager().getConnections()) {
+        if (auto peer = connection->remotePeer()) {
+          peers.insert(peer.value());
+        }
+      }
+      writer.family("kagome_peers", Type::GAUGE, "Connected peers");
+      writer.sample("kagome_peers", {}, static_cast<uint64_t>(peers.size()));
+    });
+    initialized = registry;
+    return registry;
+  }
+
+  // listener of the scrapes of the metrics getter, none if they are disabled
+  template <typename Injector>
+  sptr<api::MetricsListener> get_metrics_listener(
+      const Injector &injector,
+      const boost::optional<boost::asio::ip::tcp::endpoint> &endpoint) {
+    static auto initialized =
+        boost::optional<sptr<api::MetricsListener>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (not endpoint) {
+      initialized = nullptr;
+      return nullptr;
+    }
+
+    auto app_state_manager =
+        injector.template create<sptr<application::AppStateManager>>();
+    auto context = injector.template create<sptr<api::RpcContext>>();
+
+    api::MetricsListener::Configuration listener_config;
+    listener_config.endpoint = endpoint.value();
+
+    initialized = std::make_shared<api::MetricsListener>(
+        app_state_manager,
+        context,
+        listener_config,
+        injector.template create<sptr<common::MetricsRegistry>>());
+    return initialized.value();
+  }
+
+  // telemetry client getter, none if no aggregator is configured
+  template <typename Injector>
+  sptr<telemetry::TelemetryClient> get_telemetry_client(
+      const Injector &injector, const std::vector<std::string> &urls) {
+    static auto initialized =
+        boost::optional<sptr<telemetry::TelemetryClient>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (urls.empty()) {
+      initialized = nullptr;
+      return nullptr;
+    }
+
+    auto app_state_manager =
+        injector.template create<sptr<application::AppStateManager>>();
+
+    telemetry::TelemetryClient::Configuration config;
+    config.urls = urls;
+
+    initialized = std::make_shared<telemetry::TelemetryClient>(
+        app_state_manager,
+        std::move(config),
+        injector.template create<sptr<common::MetricsRegistry>>());
+    return initialized.value();
+  }
+
+  // SCALE rpc service getter, its listeners speak binary websocket messages
+  // and length prefixed ones over a unix socket, none if both are disabled
+  template <typename Injector>
+  sptr<api::ScaleRpcService> get_scale_rpc_service(
+      const Injector &injector,
+      const boost::optional<boost::asio::ip::tcp::endpoint> &endpoint,
+      const std::string &unix_socket_path) {
+    static auto initialized =
+        boost::optional<sptr<api::ScaleRpcService>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (not endpoint and unix_socket_path.empty()) {
+      initialized = nullptr;
+      return nullptr;
+    }
+
+    auto app_state_manager =
+        injector.template create<sptr<application::AppStateManager>>();
+    auto context = injector.template create<sptr<api::RpcContext>>();
+
+    std::vector<std::shared_ptr<api::Listener>> listeners;
+    if (endpoint) {
+      api::WsListenerImpl::Configuration listener_config;
+      listener_config.endpoint = endpoint.value();
+
+      auto ws_session_config =
+          injector.template create<api::WsSession::Configuration>();
+      ws_session_config.binary = true;
+
+      listeners.emplace_back(std::make_shared<api::WsListenerImpl>(
+          app_state_manager, context, listener_config, ws_session_config));
+    }
+    if (not unix_socket_path.empty()) {
+      auto unix_session_config =
+          injector.template create<api::UnixSession::Configuration>();
+      unix_session_config.binary = true;
+
+      listeners.emplace_back(std::make_shared<api::UnixListenerImpl>(
+          app_state_manager,
+          context,
+          api::UnixListenerImpl::Configuration{unix_socket_path},
+          unix_session_config));
+    }
+    auto server = std::make_shared<api::ScaleRpcServer>(
+        injector.template create<sptr<api::ChainApi>>(),
+        injector.template create<sptr<api::StateApi>>(),
+        injector.template create<sptr<api::AuthorApi>>());
+    initialized = std::make_shared<api::ScaleRpcService>(
+        app_state_manager,
+        injector.template create<sptr<api::RpcThreadPool>>(),
+        std::move(listeners),
+        std::move(server));
+    return initialized.value();
+  }
+
   // jrpc api listener (over Websockets) getter
   template <typename Injector>
   sptr<api::WsListenerImpl> get_jrpc_api_ws_listener(
@@ -215,9 +464,208 @@ namespace kagome::injector {
     return initialized.value();
   }
 
+  // jrpc api listener (over a unix socket) getter, none if it is disabled
+  template <typename Injector>
+  sptr<api::UnixListenerImpl> get_jrpc_api_unix_listener(
+      const Injector &injector, const std::string &path) {
+    static auto initialized =
+        boost::optional<sptr<api::UnixListenerImpl>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (path.empty()) {
+      initialized = nullptr;
+      return nullptr;
+    }
+
+    auto app_state_manager =
+        injector.template create<sptr<application::AppStateManager>>();
+
+    auto context = injector.template create<sptr<api::RpcContext>>();
+
+    auto &&unix_session_config =
+        injector.template create<api::UnixSession::Configuration>();
+
+    initialized = std::make_shared<api::UnixListenerImpl>(
+        app_state_manager,
+        context,
+        api::UnixListenerImpl::Configuration{path},
+        unix_session_config);
+    return initialized.value();
+  }
+
+  // level db getter, an instance is opened once for each of the paths
+  template <typename Injector>
+  sptr<storage::BufferStorage> get_level_db(
+      const std::string &path,
+      const application::AppConfigPtr &app_config,
+      const Injector &injector) {
+    static std::map<std::string, sptr<storage::BufferStorage>> initialized;
+    if (auto it = initialized.find(path); it != initialized.end()) {
+      return it->second;
+    }
+    auto options = leveldb::Options{};
+    options.create_if_missing = true;
+    options.block_cache =
+        leveldb::NewLRUCache(app_config->leveldb_block_cache_size());
+    if (app_config->leveldb_bloom_filter_bits() > 0) {
+      options.filter_policy = leveldb::NewBloomFilterPolicy(
+          app_config->leveldb_bloom_filter_bits());
+    }
+    options.write_buffer_size = app_config->leveldb_write_buffer_size();
+    options.max_open_files = app_config->leveldb_max_open_files();
+    auto db = storage::LevelDB::create(path, options);
+    if (!db) {
+      common::raise(db.error());
+    }
+    if (app_config->leveldb_group_commit()) {
+      // the writes are synced, and the callers share the syncs instead of
+      // waiting for them
+      leveldb::WriteOptions write_options;
+      write_options.sync = true;
+      db.value()->setWriteOptions(write_options);
+      return initialized[path] =
+                 std::make_shared<storage::GroupCommitStorage>(db.value());
+    }
+    return initialized[path] = db.value();
+  };
+
+#ifdef KAGOME_WITH_ROCKSDB
+  // rocks db getter
+  template <typename Injector>
+  sptr<storage::RocksDB> get_rocks_db(std::string_view path,
+                                      const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::RocksDB>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    auto db = storage::RocksDB::create(path);
+    if (!db) {
+      common::raise(db.error());
+    }
+    initialized = db.value();
+    return initialized.value();
+  }
+#endif
+
+  // getter of the storage, which collects the writes of a block import into
+  // a single one. It is the whole database with LevelDB and the in-memory
+  // storage, and the default column family with RocksDB, as column families
+  // are written separately
+  template <typename Injector>
+  sptr<storage::DeferredWriteStorage> get_deferred_write_storage(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::DeferredWriteStorage>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    using StorageBackend = application::AppConfiguration::StorageBackend;
+    sptr<storage::BufferStorage> db;
+    switch (app_config->storage_backend()) {
+      case StorageBackend::kRocksDB:
+#ifdef KAGOME_WITH_ROCKSDB
+        db = get_rocks_db(app_config->leveldb_path(), injector)
+                 ->getSpace(storage::Space::kDefault);
+        break;
+#else
+        // refused by the configuration of the nodes built without it
+        [[fallthrough]];
+#endif
+      case StorageBackend::kLevelDB:
+        db = get_level_db(app_config->leveldb_path(), app_config, injector);
+        break;
+      case StorageBackend::kMemory:
+        db = std::make_shared<storage::ArenaStorage>(
+            app_config->memory_storage_budget());
+        break;
+    }
+    initialized = std::make_shared<storage::DeferredWriteStorage>(db);
+    return initialized.value();
+  }
+
+  // getter of the storage for a kind of data, which is a separate column
+  // family with RocksDB, while LevelDB keeps all of them in one keyspace,
+  // unless the trie nodes or the blocks are given directories of their own
+  template <typename Injector>
+  sptr<storage::BufferStorage> get_storage_space(
+      storage::Space space,
+      const application::AppConfigPtr &app_config,
+      const Injector &injector) {
+    using StorageBackend = application::AppConfiguration::StorageBackend;
+#ifdef KAGOME_WITH_ROCKSDB
+    if (app_config->storage_backend() == StorageBackend::kRocksDB
+        and space != storage::Space::kDefault) {
+      return get_rocks_db(app_config->leveldb_path(), injector)
+          ->getSpace(space);
+    }
+#endif
+    if (app_config->storage_backend() == StorageBackend::kLevelDB) {
+      const auto &path = space == storage::Space::kTrieNode
+                             ? app_config->leveldb_trie_path()
+                         : space == storage::Space::kBlockData
+                             ? app_config->leveldb_blocks_path()
+                             : app_config->leveldb_path();
+      // the writes to the separate instances are not deferred, as they
+      // can't be written together with the main one anyway
+      if (path != app_config->leveldb_path() and not path.empty()) {
+        return get_level_db(path, app_config, injector);
+      }
+    }
+    return get_deferred_write_storage(app_config, injector);
+  }
+
+  // memory shared by the caches, none if each of them keeps its own size
+  template <typename Injector>
+  sptr<common::CacheBudget> get_cache_budget(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<common::CacheBudget>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (app_config->cache_budget() == 0) {
+      initialized = nullptr;
+      return nullptr;
+    }
+    auto budget = std::make_shared<common::CacheBudget>(
+        app_config->cache_budget(),
+        injector.template create<sptr<boost::asio::io_context>>());
+    auto app_state_manager =
+        injector.template create<sptr<application::AppStateManager>>();
+    app_state_manager->atLaunch([budget] { budget->start(); });
+    app_state_manager->atShutdown([budget] { budget->stop(); });
+    initialized = budget;
+    return budget;
+  }
+
+  // cache of the headers shared by the block storage and header repository
+  template <typename Injector>
+  sptr<blockchain::BlockHeaderCache> get_block_header_cache(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<blockchain::BlockHeaderCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    auto cache = std::make_shared<blockchain::BlockHeaderCache>(
+        app_config->block_header_cache_size());
+    if (auto budget = get_cache_budget(app_config, injector)) {
+      budget->add("block_headers",
+                  cache,
+                  app_config->block_header_cache_size()
+                      * blockchain::BlockHeaderCache::kEntryBytes);
+    }
+    initialized = cache;
+    return cache;
+  }
+
   // block storage getter
   template <typename Injector>
-  sptr<blockchain::BlockStorage> get_block_storage(const Injector &injector) {
+  sptr<blockchain::BlockStorage> get_block_storage(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
     static auto initialized =
         boost::optional<sptr<blockchain::BlockStorage>>(boost::none);
 
@@ -227,13 +675,29 @@ namespace kagome::injector {
     auto &&hasher = injector.template create<sptr<crypto::Hasher>>();
 
     const auto &db = injector.template create<sptr<storage::BufferStorage>>();
+    auto block_db = get_storage_space(
+        storage::Space::kBlockData, app_config, injector);
 
     const auto &trie_storage =
         injector.template create<sptr<storage::trie::TrieStorage>>();
 
+    // data of the finalized blocks is moved to the freezer, if there is one
+    sptr<blockchain::BlockFreezer> freezer;
+    if (const auto &path = app_config->block_freezer_path();
+        not path.empty()) {
+      auto freezer_res = blockchain::BlockFreezer::open(
+          path,
+          blockchain::BlockFreezer::kDefaultSegmentSize,
+          static_cast<int>(app_config->block_freezer_compression()));
+      if (not freezer_res) {
+        common::raise(freezer_res.error());
+      }
+      freezer = std::move(freezer_res.value());
+    }
+
     auto storage = blockchain::KeyValueBlockStorage::create(
         trie_storage->getRootHash(),
-        db,
+        block_db,
         hasher,
         [&db, &injector](const primitives::Block &genesis_block) {
           // handle genesis initialization, which happens when there is not
@@ -288,7 +752,10 @@ namespace kagome::injector {
               std::exit(1);
             }
           }
-        });
+        },
+        get_block_header_cache(app_config, injector),
+        freezer,
+        injector.template create<sptr<common::Tracer>>());
     if (storage.has_error()) {
       common::raise(storage.error());
     }
@@ -298,7 +765,32 @@ namespace kagome::injector {
 
   // block tree getter
   template <typename Injector>
-  sptr<blockchain::BlockTree> get_block_tree(const Injector &injector) {
+  sptr<blockchain::BlockHeaderRepository> get_block_header_repository(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<blockchain::BlockHeaderRepository>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    // headers are read from the same storage block storage puts them to
+    auto block_db = get_storage_space(
+        storage::Space::kBlockData, app_config, injector);
+    auto hasher = injector.template create<sptr<crypto::Hasher>>();
+    auto header_repo =
+        std::make_shared<blockchain::KeyValueBlockHeaderRepository>(
+            std::move(block_db),
+            std::move(hasher),
+            get_block_header_cache(app_config, injector));
+    initialized = header_repo;
+    return header_repo;
+  }
+
+  template <typename Injector>
+  sptr<blockchain::BlockTree> get_block_tree(uint32_t state_pruning_depth,
+                                             uint32_t blocks_pruning_depth,
+                                             uint32_t justification_period,
+                                             const Injector &injector) {
     static auto initialized =
         boost::optional<sptr<blockchain::BlockTree>>(boost::none);
 
@@ -322,40 +814,339 @@ namespace kagome::injector {
 
     auto &&hasher = injector.template create<sptr<crypto::Hasher>>();
 
+    auto &&state_pruner =
+        injector.template create<sptr<storage::trie::TriePruner>>();
+
+    auto &&chain_events =
+        injector.template create<sptr<subscription::ChainEvents>>();
+
     auto &&tree =
         blockchain::BlockTreeImpl::create(std::move(header_repo),
                                           storage,
                                           block_id,
                                           std::move(extrinsic_observer),
-                                          std::move(hasher));
+                                          std::move(hasher),
+                                          std::move(state_pruner),
+                                          state_pruning_depth,
+                                          std::move(chain_events),
+                                          blocks_pruning_depth,
+                                          justification_period);
     if (!tree) {
       common::raise(tree.error());
     }
+    // the forks imported since the last finalization are kept for the
+    // restart
+    injector.template create<sptr<application::AppStateManager>>()
+        ->atShutdown([tree = tree.value()] {
+          if (auto res = tree->storeSnapshot(); not res) {
+            spdlog::error("Unfinalized blocks are not stored: {}",
+                          res.error().message());
+          }
+        });
     initialized = tree.value();
     return initialized.value();
   }
 
   template <typename Injector>
-  sptr<storage::trie::TrieStorageBackendImpl> get_trie_storage_backend(
-      const Injector &injector) {
+  sptr<storage::trie::TrieStorageBackend> get_trie_storage_backend(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
     static auto initialized =
-        boost::optional<sptr<storage::trie::TrieStorageBackendImpl>>(
-            boost::none);
+        boost::optional<sptr<storage::trie::TrieStorageBackend>>(boost::none);
 
     if (initialized) {
       return initialized.value();
     }
-    auto storage = injector.template create<sptr<storage::BufferStorage>>();
+    auto storage = get_storage_space(
+        storage::Space::kTrieNode, app_config, injector);
     using blockchain::prefix::TRIE_NODE;
-    auto backend = std::make_shared<storage::trie::TrieStorageBackendImpl>(
-        storage, common::Buffer{TRIE_NODE});
+    sptr<storage::trie::TrieStorageBackend> backend =
+        std::make_shared<storage::trie::TrieStorageBackendImpl>(
+            storage, common::Buffer{TRIE_NODE});
+    if (auto threshold = app_config->trie_large_value_threshold();
+        threshold != 0) {
+      backend = std::make_shared<storage::trie::LargeValueTrieStorageBackend>(
+          std::move(backend), threshold);
+    }
+    // nodes of a mapped snapshot are read in place of the ones which would
+    // be imported from it
+    if (const auto &path = app_config->state_snapshot_path();
+        not path.empty()) {
+      auto snapshot = storage::trie::StateSnapshotFile::open(path);
+      if (not snapshot) {
+        common::raise(snapshot.error());
+      }
+      spdlog::info("Mapped state snapshot {} with {} nodes, root {}",
+                   path,
+                   snapshot.value()->size(),
+                   snapshot.value()->getRootHash().toHex());
+      backend = std::make_shared<storage::trie::SnapshotTrieStorageBackend>(
+          std::move(snapshot.value()), std::move(backend));
+    }
     initialized = backend;
     return backend;
   }
 
   template <typename Injector>
-  sptr<storage::trie::TrieStorageImpl> get_trie_storage_impl(
+  sptr<network::StorageReadExecutor> get_storage_read_executor(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<network::StorageReadExecutor>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    // the storage is read for the peers on threads of its own, while the
+    // network and the consensus share the thread of the io_context
+    auto executor = std::make_shared<network::StorageReadExecutor>(
+        injector.template create<sptr<application::AppStateManager>>(),
+        app_config->storage_read_threads_num());
+    initialized = executor;
+    return executor;
+  }
+
+  template <typename Injector>
+  sptr<transaction_pool::PoolRevalidator> get_pool_revalidator(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<transaction_pool::PoolRevalidator>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<transaction_pool::PoolRevalidatorImpl>(
+        injector.template create<sptr<application::AppStateManager>>(),
+        injector.template create<sptr<blockchain::BlockTree>>(),
+        injector.template create<sptr<transaction_pool::TransactionPool>>(),
+        injector.template create<sptr<runtime::TaggedTransactionQueue>>(),
+        injector.template create<sptr<network::ExtrinsicObserver>>(),
+        app_config->transaction_pool_dump_path(),
+        get_worker_pool());
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TriePruner> get_trie_pruner(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TriePruner>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    // an archive node keeps all the states, so there is nothing to track
+    if (app_config->state_pruning_depth() == 0) {
+      initialized = nullptr;
+      return nullptr;
+    }
+    auto node_storage =
+        injector.template create<sptr<storage::trie::TrieStorageBackend>>();
+    // counters are looked up along with the nodes they count
+    auto storage = get_storage_space(
+        storage::Space::kTrieNode, app_config, injector);
+    using blockchain::prefix::TRIE_NODE_REFS;
+    auto ref_counts = std::make_shared<storage::trie::TrieStorageBackendImpl>(
+        storage, common::Buffer{TRIE_NODE_REFS});
+    auto codec = injector.template create<sptr<storage::trie::Codec>>();
+    auto pruner = std::make_shared<storage::trie::TriePrunerImpl>(
+        std::move(node_storage), std::move(ref_counts), std::move(codec));
+    initialized = pruner;
+    return pruner;
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::StatePrefetcher> get_state_prefetcher(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::StatePrefetcher>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    // the apis executing blocks and validating transactions take no
+    // prefetcher, if the reading ahead is disabled
+    sptr<storage::trie::StatePrefetcher> prefetcher;
+    if (auto threads = app_config->state_prefetch_threads(); threads != 0) {
+      prefetcher = std::make_shared<storage::trie::StatePrefetcher>(
+          injector.template create<sptr<storage::trie::TrieSerializer>>(),
+          threads);
+    }
+    initialized = prefetcher;
+    return prefetcher;
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieNodeCache> get_trie_node_cache(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<storage::trie::TrieNodeCache>>(boost::none);
+
+    if (initialized) {
+      return initialized.value();
+    }
+    auto cache_size = app_config->trie_node_cache_size();
+    auto cache = std::make_shared<storage::trie::TrieNodeCache>(cache_size);
+    if (auto budget = get_cache_budget(app_config, injector)) {
+      budget->add("trie_nodes",
+                  cache,
+                  cache_size * storage::trie::TrieNodeCache::kEntryBytes);
+    }
+    initialized = cache;
+    return cache;
+  }
+
+  template <typename Injector>
+  sptr<runtime::binaryen::WasmModuleFactory> get_wasm_module_factory(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<runtime::binaryen::WasmModuleFactory>>(
+            boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    sptr<runtime::binaryen::WasmModuleFactory> factory;
+    if (const auto &path = app_config->runtime_cache_path(); path.empty()) {
+      factory = std::make_shared<runtime::binaryen::WasmModuleFactoryImpl>(
+          app_config->runtime_optimization_level());
+    } else {
+      factory = std::make_shared<runtime::binaryen::WasmModuleFactoryImpl>(
+          app_config->runtime_optimization_level(),
+          path,
+          injector.template create<sptr<crypto::Hasher>>());
+    }
+    initialized = factory;
+    return factory;
+  }
+
+  inline sptr<runtime::RuntimeProfiler> get_runtime_profiler(
+      const application::AppConfigPtr &app_config) {
+    static auto initialized =
+        boost::optional<sptr<runtime::RuntimeProfiler>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<runtime::RuntimeProfiler>(
+        app_config->runtime_profiling());
+    return initialized.value();
+  }
+
+  // spans are recorded once enabled over RPC
+  inline sptr<common::Tracer> get_tracer() {
+    static auto initialized =
+        boost::optional<sptr<common::Tracer>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<common::Tracer>();
+    return initialized.value();
+  }
+
+  // the CPU-bound work, such as the encoding of large tries, is shared out
+  // among these threads instead of ones started for it
+  inline sptr<common::WorkerPool> get_worker_pool() {
+    static auto initialized =
+        boost::optional<sptr<common::WorkerPool>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<common::WorkerPool>();
+    return initialized.value();
+  }
+
+  // profiles are taken over RPC if their directory is configured, the
+  // timers stopping them run on the threads of RPC
+  template <typename Injector>
+  sptr<common::ProcessProfiler> get_process_profiler(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<common::ProcessProfiler>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    auto context = injector.template create<sptr<api::RpcContext>>();
+    initialized = std::make_shared<common::ProcessProfiler>(
+        app_config->process_profiles_path(), context);
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<runtime::binaryen::RuntimeManager> get_runtime_manager(
+      const application::AppConfigPtr &app_config,
+      size_t rpc_threads_num,
       const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<runtime::binaryen::RuntimeManager>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    // ephemeral calls come mostly from the RPC threads
+    auto instances_num = app_config->runtime_instances_num();
+    if (instances_num == 0) {
+      instances_num = rpc_threads_num;
+    }
+    auto runtime_manager = std::make_shared<runtime::binaryen::RuntimeManager>(
+        injector.template create<sptr<runtime::WasmProvider>>(),
+        injector.template create<sptr<extensions::ExtensionFactory>>(),
+        injector.template create<sptr<runtime::binaryen::WasmModuleFactory>>(),
+        injector.template create<sptr<runtime::TrieStorageProvider>>(),
+        injector.template create<sptr<storage::trie::TrieStorage>>(),
+        instances_num,
+        injector.template create<sptr<runtime::RuntimeProfiler>>(),
+        injector.template create<sptr<common::Tracer>>());
+    // the code is compiled for the ephemeral calls at the stage 'prepare',
+    // alongside the rest of it, rather than by the first of these calls
+    injector.template create<sptr<application::AppStateManager>>()->atPrepare(
+        [runtime_manager] {
+          if (auto env =
+                  runtime_manager->createEphemeralRuntimeEnvironment();
+              not env) {
+            spdlog::warn("Runtime instance was not prepared: {}",
+                         env.error().message());
+          }
+        },
+        {});
+    initialized = runtime_manager;
+    // the code set by a runtime upgrade is compiled once the block setting
+    // it is imported, rather than by the first block executed on top of it
+    static auto upgrade_preparer =
+        std::make_shared<runtime::binaryen::RuntimeUpgradePreparer>(
+            runtime_manager,
+            injector.template create<sptr<blockchain::BlockHeaderRepository>>(),
+            injector.template create<sptr<storage::trie::TrieStorage>>(),
+            injector.template create<sptr<subscription::ChainEvents>>());
+    return runtime_manager;
+  }
+
+  template <typename Injector>
+  sptr<runtime::OffchainWorkerScheduler> get_offchain_worker_scheduler(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<runtime::OffchainWorkerScheduler>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    // the workers get a runtime manager of their own, so that they never
+    // wait for the instances serving the block import and the RPC calls
+    auto workers_num = app_config->offchain_workers_num();
+    auto runtime_manager = std::make_shared<runtime::binaryen::RuntimeManager>(
+        injector.template create<sptr<runtime::WasmProvider>>(),
+        injector.template create<sptr<extensions::ExtensionFactory>>(),
+        injector.template create<sptr<runtime::binaryen::WasmModuleFactory>>(),
+        injector.template create<sptr<runtime::TrieStorageProvider>>(),
+        injector.template create<sptr<storage::trie::TrieStorage>>(),
+        std::max<size_t>(workers_num, 1),
+        injector.template create<sptr<runtime::RuntimeProfiler>>(),
+        injector.template create<sptr<common::Tracer>>());
+    initialized = std::make_shared<runtime::OffchainWorkerScheduler>(
+        injector.template create<sptr<application::AppStateManager>>(),
+        std::make_shared<runtime::binaryen::OffchainWorkerImpl>(
+            runtime_manager),
+        workers_num);
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<storage::trie::TrieStorageImpl> get_trie_storage_impl(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
     static auto initialized =
         boost::optional<sptr<storage::trie::TrieStorageImpl>>(boost::none);
 
@@ -377,6 +1168,35 @@ namespace kagome::injector {
 
     sptr<storage::trie::TrieStorageImpl> trie_storage =
         std::move(trie_storage_res.value());
+    if (auto size = app_config->trie_key_filter_size(); size != 0) {
+      trie_storage->setKeyFilter(
+          std::make_shared<storage::trie::KeyFilter>(size));
+    }
+    if (app_config->flat_state()) {
+      using blockchain::prefix::FLAT_STATE;
+      auto flat_state = storage::trie::FlatState::create(
+          get_storage_space(
+              storage::Space::kDefault, app_config, injector),
+          common::Buffer{FLAT_STATE},
+          serializer);
+      if (not flat_state) {
+        common::raise(flat_state.error());
+      }
+      trie_storage->setFlatState(flat_state.value());
+      // the entries follow the finalized state, the later states are kept
+      // as the differences from it
+      injector.template create<sptr<subscription::ChainEvents>>()
+          ->finalized_head.connect(
+              [flat_state = flat_state.value()](auto &, auto &header) {
+                if (auto res = flat_state->finalize(
+                        common::Buffer{header.state_root});
+                    not res) {
+                  spdlog::warn("Flat state is not moved to block #{}: {}",
+                               header.number,
+                               res.error().message());
+                }
+              });
+    }
     initialized = trie_storage;
     return trie_storage;
   }
@@ -390,48 +1210,59 @@ namespace kagome::injector {
     }
     auto configuration_storage =
         injector.template create<sptr<application::ConfigurationStorage>>();
-    const auto &genesis_raw_configs = configuration_storage->getGenesis();
-
     auto trie_storage =
         injector.template create<sptr<storage::trie::TrieStorageImpl>>();
-    auto batch = trie_storage->getPersistentBatch();
-    if (not batch) {
-      common::raise(batch.error());
-    }
-    for (const auto &[key, val] : genesis_raw_configs) {
-      spdlog::debug(
-          "Key: {}, Val: {}", key.toHex(), val.toHex().substr(0, 200));
-      if (auto res = batch.value()->put(key, val); not res) {
-        common::raise(res.error());
+
+    // the genesis state is streamed from the config to the storage, the
+    // nodes are written as soon as the sorted keys go past them
+    auto make_builder = [&] {
+      return storage::trie::SortedTrieBuilder{
+          injector.template create<sptr<storage::trie::Codec>>(),
+          injector.template create<sptr<storage::trie::TrieStorageBackend>>(),
+          injector.template create<sptr<storage::trie::TriePruner>>()};
+    };
+    auto builder = make_builder();
+    auto res = configuration_storage->visitGenesis(
+        [&](auto key, auto value) { return builder.add(key, value); });
+    if (not res
+        and res.error()
+                == storage::trie::SortedTrieBuilderError::UNSORTED_KEYS) {
+      // the chain specs made by substrate have the keys sorted, the others
+      // are sorted in the memory
+      spdlog::warn("Keys of the genesis state are not sorted in the config");
+      auto genesis = configuration_storage->getGenesis();
+      if (not genesis) {
+        common::raise(genesis.error());
+      }
+      auto &entries = genesis.value();
+      // the last of the entries of the same key is the one put
+      std::stable_sort(
+          entries.begin(), entries.end(), [](auto &lhs, auto &rhs) {
+            return lhs.first < rhs.first;
+          });
+      builder = make_builder();
+      res = outcome::success();
+      for (auto it = entries.begin(); res and it != entries.end(); ++it) {
+        if (std::next(it) == entries.end()
+            or std::next(it)->first != it->first) {
+          res = builder.add(it->first, it->second);
+        }
       }
     }
-    if (auto res = batch.value()->commit(); not res) {
+    if (not res) {
       common::raise(res.error());
     }
+    auto root = builder.finish();
+    if (not root) {
+      common::raise(root.error());
+    }
+    spdlog::debug("Genesis state root: {}", root.value().toHex());
+    trie_storage->setRootHash(root.value());
 
     initialized = trie_storage;
     return trie_storage;
   }
 
-  // level db getter
-  template <typename Injector>
-  sptr<storage::BufferStorage> get_level_db(std::string_view leveldb_path,
-                                            const Injector &injector) {
-    static auto initialized =
-        boost::optional<sptr<storage::BufferStorage>>(boost::none);
-    if (initialized) {
-      return initialized.value();
-    }
-    auto options = leveldb::Options{};
-    options.create_if_missing = true;
-    auto db = storage::LevelDB::create(leveldb_path, options);
-    if (!db) {
-      common::raise(db.error());
-    }
-    initialized = db.value();
-    return initialized.value();
-  };
-
   // configuration storage getter
   template <typename Injector>
   std::shared_ptr<application::ConfigurationStorage> get_configuration_storage(
@@ -466,6 +1297,7 @@ namespace kagome::injector {
     auto block_header_repository =
         injector.template create<sptr<blockchain::BlockHeaderRepository>>();
 
+    auto metrics = injector.template create<sptr<network::NetworkMetrics>>();
     auto res = std::make_shared<network::SyncClientsSet>();
 
     auto &current_peer_info =
@@ -475,7 +1307,7 @@ namespace kagome::injector {
       if (peer_info.id != current_peer_info.id) {
         res->clients.emplace_back(
             std::make_shared<network::RemoteSyncProtocolClient>(
-                *host, std::move(peer_info)));
+                *host, std::move(peer_info), metrics));
       } else {
         res->clients.emplace_back(
             std::make_shared<network::DummySyncProtocolClient>());
@@ -486,6 +1318,46 @@ namespace kagome::injector {
     return res;
   }
 
+  template <typename Injector>
+  sptr<consensus::BabeSynchronizer> get_babe_synchronizer(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<consensus::BabeSynchronizer>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    initialized = std::make_shared<consensus::BabeSynchronizerImpl>(
+        injector.template create<sptr<network::SyncClientsSet>>(),
+        injector.template create<sptr<crypto::Hasher>>(),
+        app_config->sync_bodies_batch_size(),
+        injector.template create<sptr<network::PeerManager>>());
+    return initialized.value();
+  }
+
+  template <typename Injector>
+  sptr<consensus::WarpSync> get_warp_sync(
+      const application::AppConfigPtr &app_config, const Injector &injector) {
+    static auto initialized =
+        boost::optional<sptr<consensus::WarpSync>>(boost::none);
+    if (initialized) {
+      return initialized.value();
+    }
+    if (not app_config->warp_sync()) {
+      initialized = nullptr;
+      return nullptr;
+    }
+    initialized = std::make_shared<consensus::WarpSync>(
+        injector.template create<sptr<blockchain::BlockTree>>(),
+        injector.template create<sptr<blockchain::BlockStorage>>(),
+        injector.template create<sptr<storage::BufferStorage>>(),
+        injector.template create<sptr<storage::trie::TrieStorageBackend>>(),
+        injector.template create<sptr<storage::trie::Codec>>(),
+        injector.template create<sptr<crypto::Hasher>>(),
+        injector.template create<sptr<crypto::ED25519Provider>>(),
+        injector.template create<sptr<network::SyncClientsSet>>());
+    return initialized.value();
+  }
+
   template <typename Injector>
   sptr<primitives::BabeConfiguration> get_babe_configuration(
       const Injector &injector) {
@@ -536,27 +1408,44 @@ namespace kagome::injector {
                                                   std::move(random_generator));
 
     boost::filesystem::path path = std::string(keystore_path);
-    if (auto &&res = crypto_store->initialize(path); res) {
+    if (auto &&res = crypto_store->initialize(path); not res) {
       common::raise(res.error());
     }
+    // the key files put to the keystore are picked up without a restart
+    crypto_store->watchKeysDirectory(std::chrono::seconds(1));
+    injector.template create<sptr<application::AppStateManager>>()
+        ->atShutdown([crypto_store] { crypto_store->stopWatching(); });
     initialized = crypto_store;
 
     return *initialized;
   }
 
   template <typename... Ts>
-  auto makeApplicationInjector(
-      const std::string &genesis_path,
-      const std::string &leveldb_path,
-      const boost::asio::ip::tcp::endpoint &rpc_http_endpoint,
-      const boost::asio::ip::tcp::endpoint &rpc_ws_endpoint,
-      Ts &&... args) {
+  auto makeApplicationInjector(const application::AppConfigPtr &app_config,
+                               Ts &&... args) {
     using namespace boost;  // NOLINT;
 
+    const auto &genesis_path = app_config->genesis_path();
+    const auto &rpc_http_endpoint = app_config->rpc_http_endpoint();
+    const auto &rpc_ws_endpoint = app_config->rpc_ws_endpoint();
+    const auto &prometheus_endpoint = app_config->prometheus_endpoint();
+    const auto &telemetry_urls = app_config->telemetry_urls();
+    const auto &rpc_scale_endpoint = app_config->rpc_scale_endpoint();
+    const auto &rpc_unix_socket_path = app_config->rpc_unix_socket_path();
+    const auto &rpc_scale_unix_socket_path =
+        app_config->rpc_scale_unix_socket_path();
+
     // default values for configurations
     api::RpcThreadPool::Configuration rpc_thread_pool_config{};
     api::HttpSession::Configuration http_config{};
+    http_config.max_request_size = app_config->rpc_max_request_size();
     api::WsSession::Configuration ws_config{};
+    ws_config.max_request_size = app_config->rpc_max_request_size();
+    api::UnixSession::Configuration unix_config{};
+    unix_config.max_request_size = app_config->rpc_max_request_size();
+    api::RpcMetrics::Configuration rpc_metrics_config{};
+    rpc_metrics_config.slow_call_threshold =
+        std::chrono::milliseconds{app_config->rpc_slow_call_threshold()};
     transaction_pool::PoolModeratorImpl::Params pool_moderator_config{};
     transaction_pool::TransactionPool::Limits tp_pool_limits{};
     return di::make_injector(
@@ -564,6 +1453,8 @@ namespace kagome::injector {
         injector::useConfig(rpc_thread_pool_config),
         injector::useConfig(http_config),
         injector::useConfig(ws_config),
+        injector::useConfig(unix_config),
+        injector::useConfig(rpc_metrics_config),
         injector::useConfig(pool_moderator_config),
         injector::useConfig(tp_pool_limits),
 
@@ -590,9 +1481,44 @@ namespace kagome::injector {
             [rpc_ws_endpoint](const auto &injector) {
               return get_jrpc_api_ws_listener(injector, rpc_ws_endpoint);
             }),
+        di::bind<api::UnixListenerImpl>.to(
+            [rpc_unix_socket_path](const auto &injector) {
+              return get_jrpc_api_unix_listener(injector, rpc_unix_socket_path);
+            }),
+        di::bind<api::MetricsListener>.to(
+            [prometheus_endpoint](const auto &injector) {
+              return get_metrics_listener(injector, prometheus_endpoint);
+            }),
+        di::bind<api::ScaleRpcService>.to(
+            [rpc_scale_endpoint, rpc_scale_unix_socket_path](
+                const auto &injector) {
+              return get_scale_rpc_service(
+                  injector, rpc_scale_endpoint, rpc_scale_unix_socket_path);
+            }),
+        di::bind<common::MetricsRegistry>.to([](const auto &injector) {
+          return get_metrics_registry(injector);
+        }),
+        di::bind<telemetry::TelemetryClient>.to(
+            [telemetry_urls](const auto &injector) {
+              return get_telemetry_client(injector, telemetry_urls);
+            }),
         di::bind<api::AuthorApi>.template to<api::AuthorApiImpl>(),
         di::bind<api::ChainApi>.template to<api::ChainApiImpl>(),
         di::bind<api::StateApi>.template to<api::StateApiImpl>(),
+        di::bind<api::ProfileApi>.template to<api::ProfileApiImpl>(),
+        di::bind<runtime::RuntimeProfiler>.to([app_config](const auto &) {
+          return get_runtime_profiler(app_config);
+        }),
+        di::bind<common::Tracer>.to([](const auto &) { return get_tracer(); }),
+        di::bind<common::WorkerPool>.to(
+            [](const auto &) { return get_worker_pool(); }),
+        di::bind<common::ProcessProfiler>.to(
+            [app_config](const auto &injector) {
+              return get_process_profiler(app_config, injector);
+            }),
+        di::bind<common::CacheBudget>.to([app_config](const auto &injector) {
+          return get_cache_budget(app_config, injector);
+        }),
         di::bind<api::ApiService>.to([](const auto &injector) {
           return get_jrpc_api_service(injector);
         }),
@@ -601,21 +1527,39 @@ namespace kagome::injector {
         di::bind<authorship::BlockBuilder>.template to<authorship::BlockBuilderImpl>(),
         di::bind<authorship::BlockBuilderFactory>.template to<authorship::BlockBuilderFactoryImpl>(),
         di::bind<storage::BufferStorage>.to(
-            [leveldb_path](const auto &injector) {
-              return get_level_db(leveldb_path, injector);
+            [app_config](const auto &injector) {
+              return get_storage_space(
+                  storage::Space::kDefault, app_config, injector);
+            }),
+        di::bind<storage::DeferredWriteStorage>.to(
+            [app_config](const auto &injector) {
+              return get_deferred_write_storage(app_config, injector);
             }),
         di::bind<blockchain::BlockStorage>.to(
-            [](const auto &injector) { return get_block_storage(injector); }),
+            [app_config](const auto &injector) {
+              return get_block_storage(app_config, injector);
+            }),
         di::bind<blockchain::BlockTree>.to(
-            [](auto const &inj) { return get_block_tree(inj); }),
-        di::bind<blockchain::BlockHeaderRepository>.template to<blockchain::KeyValueBlockHeaderRepository>(),
+            [app_config](auto const &inj) {
+              return get_block_tree(app_config->state_pruning_depth(),
+                                    app_config->blocks_pruning_depth(),
+                                    app_config->justification_period(),
+                                    inj);
+            }),
+        di::bind<blockchain::BlockHeaderRepository>.to(
+            [app_config](const auto &injector) {
+              return get_block_header_repository(app_config, injector);
+            }),
         di::bind<clock::SystemClock>.template to<clock::SystemClockImpl>(),
         di::bind<clock::SteadyClock>.template to<clock::SteadyClockImpl>(),
         di::bind<clock::Timer>.template to<clock::BasicWaitableTimer>(),
         di::bind<primitives::BabeConfiguration>.to([](auto const &injector) {
           return get_babe_configuration(injector);
         }),
-        di::bind<consensus::BabeSynchronizer>.template to<consensus::BabeSynchronizerImpl>(),
+        di::bind<consensus::BabeSynchronizer>.to(
+            [app_config](const auto &injector) {
+              return get_babe_synchronizer(app_config, injector);
+            }),
         di::bind<consensus::grandpa::Environment>.template to<consensus::grandpa::EnvironmentImpl>(),
         di::bind<consensus::grandpa::VoteCryptoProvider>.template to<consensus::grandpa::VoteCryptoProviderImpl>(),
         di::bind<consensus::EpochStorage>.template to<consensus::EpochStorageImpl>(),
@@ -633,15 +1577,36 @@ namespace kagome::injector {
         di::bind<consensus::BabeGossiper>.template to<network::GossiperBroadcast>(),
         di::bind<consensus::grandpa::Gossiper>.template to<network::GossiperBroadcast>(),
         di::bind<network::Gossiper>.template to<network::GossiperBroadcast>(),
+        di::bind<network::PeerManager>.template to<network::PeerManagerImpl>(),
         di::bind<network::SyncClientsSet>.to([](auto const &injector) {
           return get_sync_clients_set(injector);
         }),
         di::bind<network::SyncProtocolObserver>.template to<network::SyncProtocolObserverImpl>(),
+        di::bind<network::LightProtocolObserver>.template to<network::LightProtocolObserverImpl>(),
+        di::bind<network::StorageReadExecutor>.to([app_config](auto const &inj) {
+          return get_storage_read_executor(app_config, inj);
+        }),
+        di::bind<consensus::WarpSync>.to([app_config](auto const &inj) {
+          return get_warp_sync(app_config, inj);
+        }),
         di::bind<runtime::binaryen::WasmModule>.template to<runtime::binaryen::WasmModuleImpl>(),
-        di::bind<runtime::binaryen::WasmModuleFactory>.template to<runtime::binaryen::WasmModuleFactoryImpl>(),
+        di::bind<runtime::binaryen::WasmModuleFactory>.to(
+            [app_config](auto const &inj) {
+              return get_wasm_module_factory(app_config, inj);
+            }),
+        di::bind<runtime::binaryen::RuntimeManager>.to(
+            [app_config,
+             rpc_threads_num{rpc_thread_pool_config.max_thread_number}](
+                auto const &inj) {
+              return get_runtime_manager(app_config, rpc_threads_num, inj);
+            }),
         di::bind<runtime::TaggedTransactionQueue>.template to<runtime::binaryen::TaggedTransactionQueueImpl>(),
         di::bind<runtime::ParachainHost>.template to<runtime::binaryen::ParachainHostImpl>(),
         di::bind<runtime::OffchainWorker>.template to<runtime::binaryen::OffchainWorkerImpl>(),
+        di::bind<runtime::RawCall>.template to<runtime::binaryen::RawCallImpl>(),
+        di::bind<runtime::OffchainWorkerScheduler>.to([app_config](auto const &inj) {
+          return get_offchain_worker_scheduler(app_config, inj);
+        }),
         di::bind<runtime::Metadata>.template to<runtime::binaryen::MetadataImpl>(),
         di::bind<runtime::Grandpa>.template to<runtime::binaryen::GrandpaImpl>(),
         di::bind<runtime::Core>.template to<runtime::binaryen::CoreImpl>(),
@@ -650,16 +1615,43 @@ namespace kagome::injector {
         di::bind<runtime::TrieStorageProvider>.template to<runtime::TrieStorageProviderImpl>(),
         di::bind<transaction_pool::TransactionPool>.template to<transaction_pool::TransactionPoolImpl>(),
         di::bind<transaction_pool::PoolModerator>.template to<transaction_pool::PoolModeratorImpl>(),
+        di::bind<transaction_pool::PoolRevalidator>.to([app_config](auto const &inj) {
+          return get_pool_revalidator(app_config, inj);
+        }),
         di::bind<storage::changes_trie::ChangesTracker>.template to<storage::changes_trie::StorageChangesTrackerImpl>(),
+        di::bind<storage::changes_trie::ChangesIndex>.to(
+            [app_config](auto const &inj) {
+              using blockchain::prefix::CHANGES_INDEX;
+              return std::make_shared<storage::changes_trie::ChangesIndex>(
+                  get_storage_space(
+                      storage::Space::kDefault, app_config, inj),
+                  common::Buffer{CHANGES_INDEX});
+            }),
         di::bind<storage::trie::TrieStorageBackend>.to(
-            [](auto const &inj) { return get_trie_storage_backend(inj); }),
+            [app_config](auto const &inj) {
+              return get_trie_storage_backend(app_config, inj);
+            }),
         di::bind<storage::trie::TrieStorageImpl>.to(
-            [](auto const &inj) { return get_trie_storage_impl(inj); }),
+            [app_config](auto const &inj) {
+              return get_trie_storage_impl(app_config, inj);
+            }),
         di::bind<storage::trie::TrieStorage>.to(
             [](auto const &inj) { return get_trie_storage(inj); }),
         di::bind<storage::trie::PolkadotTrieFactory>.template to<storage::trie::PolkadotTrieFactoryImpl>(),
         di::bind<storage::trie::Codec>.template to<storage::trie::PolkadotCodec>(),
+        di::bind<storage::trie::TrieNodeCache>.to(
+            [app_config](auto const &inj) {
+              return get_trie_node_cache(app_config, inj);
+            }),
+        di::bind<storage::trie::TriePruner>.to(
+            [app_config](auto const &inj) {
+              return get_trie_pruner(app_config, inj);
+            }),
         di::bind<storage::trie::TrieSerializer>.template to<storage::trie::TrieSerializerImpl>(),
+        di::bind<storage::trie::StatePrefetcher>.to(
+            [app_config](auto const &inj) {
+              return get_state_prefetcher(app_config, inj);
+            }),
         di::bind<runtime::WasmProvider>.template to<runtime::StorageWasmProvider>(),
         di::bind<application::ConfigurationStorage>.to(
             [genesis_path](const auto &injector) {
@@ -28,10 +28,7 @@ namespace kagome::injector {
     return di::make_injector(
 
         // inherit application injector
-        makeApplicationInjector(app_config->genesis_path(),
-                                app_config->leveldb_path(),
-                                app_config->rpc_http_endpoint(),
-                                app_config->rpc_ws_endpoint()),
+        makeApplicationInjector(app_config),
         // bind sr25519 keypair
         di::bind<crypto::SR25519Keypair>.to(
             [](auto const &inj) { return get_sr25519_keypair(inj); }),
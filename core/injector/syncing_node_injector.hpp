@@ -56,10 +56,7 @@ namespace kagome::injector {
     return di::make_injector(
 
         // inherit application injector
-        makeApplicationInjector(app_config->genesis_path(),
-                                app_config->leveldb_path(),
-                                app_config->rpc_http_endpoint(),
-                                app_config->rpc_ws_endpoint()),
+        makeApplicationInjector(app_config),
 
         // peer info
         di::bind<network::OwnPeerInfo>.to(
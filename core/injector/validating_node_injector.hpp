@@ -138,7 +138,13 @@ namespace kagome::injector {
         injector.template create<crypto::SR25519Keypair>(),
         injector.template create<sptr<clock::SystemClock>>(),
         injector.template create<sptr<crypto::Hasher>>(),
-        injector.template create<uptr<clock::Timer>>());
+        injector.template create<uptr<clock::Timer>>(),
+        injector.template create<sptr<runtime::OffchainWorkerScheduler>>(),
+        injector.template create<sptr<transaction_pool::PoolRevalidator>>(),
+        injector.template create<sptr<consensus::ConsensusMetrics>>(),
+        injector
+            .template create<sptr<storage::changes_trie::ChangesTracker>>(),
+        injector.template create<sptr<storage::trie::TriePruner>>());
     return *initialized;
   }
 
@@ -148,10 +154,7 @@ namespace kagome::injector {
     using namespace boost;  // NOLINT;
 
     return di::make_injector(
-        makeApplicationInjector(app_config->genesis_path(),
-                                app_config->leveldb_path(),
-                                app_config->rpc_http_endpoint(),
-                                app_config->rpc_ws_endpoint()),
+        makeApplicationInjector(app_config),
         // bind sr25519 keypair
         di::bind<crypto::SR25519Keypair>.to(
             [](auto const &inj) { return get_sr25519_keypair(inj); }),
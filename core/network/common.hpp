@@ -10,7 +10,14 @@
 
 namespace kagome::network {
   const libp2p::peer::Protocol kSyncProtocol = "/polkadot-sync/1.0.0";
+  /// version of the sync protocol, which messages are compressed with zstd
+  const libp2p::peer::Protocol kCompressedSyncProtocol =
+      "/polkadot-sync/1.0.0/zstd";
   const libp2p::peer::Protocol kGossipProtocol = "/polkadot-gossip/1.0.0";
+  const libp2p::peer::Protocol kStateProtocol = "/polkadot-state/1.0.0";
+  /// serves the headers, the values of the state and the runtime calls with
+  /// their proofs to the light clients
+  const libp2p::peer::Protocol kLightProtocol = "/polkadot-light/1.0.0";
 }  // namespace kagome::network
 
 #endif  // KAGOME_NETWORK_COMMON_HPP
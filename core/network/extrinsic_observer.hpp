@@ -19,6 +19,14 @@ namespace kagome::network {
 
     virtual outcome::result<common::Hash256> onTxMessage(
         const primitives::Extrinsic &extrinsic) = 0;
+
+    /**
+     * Handles several extrinsics received together
+     * @return hash or rejection reason of each of \arg extrinsics, in the
+     * same order
+     */
+    virtual std::vector<outcome::result<common::Hash256>> onTxMessages(
+        const std::vector<primitives::Extrinsic> &extrinsics) = 0;
   };
 
 }  // namespace kagome::network
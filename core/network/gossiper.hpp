@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_NETWORK_GOSSIPER_HPP
 #define KAGOME_CORE_NETWORK_GOSSIPER_HPP
 
+#include "common/blob.hpp"
 #include "consensus/babe/babe_gossiper.hpp"
 #include "consensus/grandpa/gossiper.hpp"
 #include "network/extrinsic_gossiper.hpp"
@@ -27,6 +28,14 @@ namespace kagome::network {
     // Add new stream to gossip
     virtual void addStream(
         std::shared_ptr<libp2p::connection::Stream> stream) = 0;
+
+    /**
+     * Records that \arg peer knows the extrinsics with \arg hashes, as it
+     * has sent them, so they are not sent back to it
+     */
+    virtual void transactionsReceived(
+        const libp2p::peer::PeerId &peer,
+        const std::vector<common::Hash256> &hashes) = 0;
   };
 }  // namespace kagome::network
 
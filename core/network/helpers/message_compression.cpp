@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/helpers/message_compression.hpp"
+
+#include <zstd.h>
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::network, MessageCompressionError, e) {
+  using E = kagome::network::MessageCompressionError;
+  switch (e) {
+    case E::INVALID_FRAME:
+      return "Invalid compressed message frame";
+    case E::TOO_LARGE:
+      return "Compressed message is too large";
+    case E::DECOMPRESSION_FAILED:
+      return "Failed to decompress message";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::network {
+
+  std::vector<uint8_t> MessageCompression::compress(
+      gsl::span<const uint8_t> message, int level) {
+    std::vector<uint8_t> frame;
+    if (static_cast<size_t>(message.size()) >= kMinCompressedSize) {
+      frame.resize(1 + ZSTD_compressBound(message.size()));
+      auto size = ZSTD_compress(frame.data() + 1,
+                                frame.size() - 1,
+                                message.data(),
+                                message.size(),
+                                level);
+      if (ZSTD_isError(size) == 0
+          and size < static_cast<size_t>(message.size())) {
+        frame[0] = kZstd;
+        frame.resize(1 + size);
+        return frame;
+      }
+    }
+    frame.resize(1 + message.size());
+    frame[0] = kRaw;
+    std::copy(message.begin(), message.end(), frame.begin() + 1);
+    return frame;
+  }
+
+  outcome::result<std::vector<uint8_t>> MessageCompression::decompress(
+      gsl::span<const uint8_t> frame) {
+    if (frame.empty()) {
+      return MessageCompressionError::INVALID_FRAME;
+    }
+    auto payload = frame.subspan(1);
+    if (frame[0] == kRaw) {
+      return std::vector<uint8_t>(payload.begin(), payload.end());
+    }
+    if (frame[0] != kZstd) {
+      return MessageCompressionError::INVALID_FRAME;
+    }
+    auto size = ZSTD_getFrameContentSize(payload.data(), payload.size());
+    if (size == ZSTD_CONTENTSIZE_ERROR or size == ZSTD_CONTENTSIZE_UNKNOWN) {
+      return MessageCompressionError::INVALID_FRAME;
+    }
+    // the size is told by the peer, so it is checked before the allocation
+    if (size > kMaxMessageSize) {
+      return MessageCompressionError::TOO_LARGE;
+    }
+    std::vector<uint8_t> message(size);
+    auto res = ZSTD_decompress(
+        message.data(), message.size(), payload.data(), payload.size());
+    if (ZSTD_isError(res) != 0 or res != size) {
+      return MessageCompressionError::DECOMPRESSION_FAILED;
+    }
+    return message;
+  }
+
+}  // namespace kagome::network
@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_HELPERS_MESSAGE_COMPRESSION_HPP
+#define KAGOME_CORE_NETWORK_HELPERS_MESSAGE_COMPRESSION_HPP
+
+#include <vector>
+
+#include <gsl/span>
+
+#include "outcome/outcome.hpp"
+
+namespace kagome::network {
+
+  enum class MessageCompressionError {
+    INVALID_FRAME = 1,
+    TOO_LARGE,
+    DECOMPRESSION_FAILED,
+  };
+
+  /**
+   * Frames of the messages of the compressed protocols: a byte telling if
+   * the rest is a zstd frame or the message as it is. The messages, which
+   * are small or which don't get smaller, like the ones of already
+   * compressed data, are sent as they are, so they are not decompressed
+   */
+  struct MessageCompression {
+    static constexpr uint8_t kRaw = 0;
+    static constexpr uint8_t kZstd = 1;
+
+    /// messages shorter than that are not worth compressing
+    static constexpr size_t kMinCompressedSize = 256;
+
+    /// messages are not decompressed into more bytes than that
+    static constexpr size_t kMaxMessageSize = 64ull << 20;
+
+    static constexpr int kDefaultLevel = 3;
+
+    /// @return frame of \arg message compressed with zstd \arg level
+    static std::vector<uint8_t> compress(gsl::span<const uint8_t> message,
+                                         int level = kDefaultLevel);
+
+    /// @return message of \arg frame
+    static outcome::result<std::vector<uint8_t>> decompress(
+        gsl::span<const uint8_t> frame);
+  };
+
+}  // namespace kagome::network
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::network, MessageCompressionError);
+
+#endif  // KAGOME_CORE_NETWORK_HELPERS_MESSAGE_COMPRESSION_HPP
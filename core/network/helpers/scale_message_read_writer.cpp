@@ -14,4 +14,17 @@ namespace kagome::network {
       const std::shared_ptr<libp2p::basic::ReadWriter> &read_writer)
       : read_writer_{std::make_shared<libp2p::basic::MessageReadWriterUvarint>(
           read_writer)} {}
+
+  CompressedScaleMessageReadWriter::CompressedScaleMessageReadWriter(
+      const std::shared_ptr<libp2p::basic::ReadWriter> &read_writer)
+      : ScaleMessageReadWriter{read_writer} {
+    compressed_ = true;
+  }
+
+  void ScaleMessageReadWriter::setMetrics(
+      std::shared_ptr<NetworkMetrics> metrics,
+      libp2p::peer::Protocol protocol) {
+    metrics_ = std::move(metrics);
+    protocol_ = std::move(protocol);
+  }
 }  // namespace kagome::network
@@ -12,6 +12,10 @@
 #include <libp2p/basic/message_read_writer_uvarint.hpp>
 #include <outcome/outcome.hpp>
 
+#include "common/memory_arena.hpp"
+#include "libp2p/peer/protocol.hpp"
+#include "network/helpers/message_compression.hpp"
+#include "network/network_metrics.hpp"
 #include "scale/scale.hpp"
 
 namespace kagome::network {
@@ -29,6 +33,13 @@ namespace kagome::network {
     explicit ScaleMessageReadWriter(
         const std::shared_ptr<libp2p::basic::ReadWriter> &read_writer);
 
+    /**
+     * Records the messages read and written to \arg metrics, as the ones of
+     * \arg protocol
+     */
+    void setMetrics(std::shared_ptr<NetworkMetrics> metrics,
+                    libp2p::peer::Protocol protocol);
+
     /**
      * Read a SCALE-encoded message from the channel
      * @tparam MsgType - type of the message
@@ -42,7 +53,30 @@ namespace kagome::network {
               return cb(read_res.error());
             }
 
-            auto msg_res = scale::decode<MsgType>(*read_res.value());
+            // the received bytes are not kept while the message is handled
+            auto msg_res = [&] {
+              auto bytes = std::move(read_res.value());
+              common::MemoryCharge charge{common::MemoryArena::NETWORK_BUFFERS,
+                                          bytes->size()};
+              auto start = NetworkMetrics::Clock::now();
+              auto res = [&]() -> outcome::result<MsgType> {
+                if (not self->compressed_) {
+                  return scale::decode<MsgType>(*bytes);
+                }
+                OUTCOME_TRY(message, MessageCompression::decompress(*bytes));
+                return scale::decode<MsgType>(message);
+              }();
+              if (self->metrics_ != nullptr and res) {
+                const auto &type = messageTypeName<MsgType>();
+                self->metrics_->recordDecoding(
+                    self->protocol_,
+                    type,
+                    NetworkMetrics::Clock::now() - start);
+                self->metrics_->recordReceived(
+                    self->protocol_, type, bytes->size());
+              }
+              return res;
+            }();
             if (!msg_res) {
               return cb(msg_res.error());
             }
@@ -60,26 +94,61 @@ namespace kagome::network {
     template <typename MsgType>
     void write(const MsgType &msg,
                libp2p::basic::Writer::WriteCallbackFunc cb) const {
+      auto start = NetworkMetrics::Clock::now();
       auto encoded_msg_res = scale::encode(msg);
       if (!encoded_msg_res) {
         return cb(encoded_msg_res.error());
       }
+      if (compressed_) {
+        encoded_msg_res = MessageCompression::compress(encoded_msg_res.value());
+      }
+      if (metrics_ != nullptr) {
+        metrics_->recordEncoding(protocol_,
+                                 messageTypeName<MsgType>(),
+                                 NetworkMetrics::Clock::now() - start);
+      }
       auto msg_ptr = std::make_shared<std::vector<uint8_t>>(
           std::move(encoded_msg_res.value()));
+      // the message is held until it is written to the stream
+      auto charge = std::make_shared<common::MemoryCharge>(
+          common::MemoryArena::NETWORK_BUFFERS, msg_ptr->size());
 
       read_writer_->write(*msg_ptr,
                           [self{shared_from_this()},
                            msg_ptr,
+                           charge,
                            cb = std::move(cb)](auto &&write_res) {
                             if (!write_res) {
                               return cb(write_res.error());
                             }
+                            if (self->metrics_ != nullptr) {
+                              self->metrics_->recordSent(
+                                  self->protocol_,
+                                  messageTypeName<MsgType>(),
+                                  msg_ptr->size());
+                            }
                             cb(outcome::success());
                           });
     }
 
+   protected:
+    /// the messages are framed by MessageCompression
+    bool compressed_ = false;
+
    private:
     std::shared_ptr<libp2p::basic::MessageReadWriter> read_writer_;
+    std::shared_ptr<NetworkMetrics> metrics_;
+    libp2p::peer::Protocol protocol_;
+  };
+
+  /**
+   * Read and write SCALE-encoded messages compressed with zstd, for the
+   * protocols which move a lot of data, @see MessageCompression
+   */
+  class CompressedScaleMessageReadWriter : public ScaleMessageReadWriter {
+   public:
+    explicit CompressedScaleMessageReadWriter(
+        const std::shared_ptr<libp2p::basic::ReadWriter> &read_writer);
   };
 }  // namespace kagome::network
 
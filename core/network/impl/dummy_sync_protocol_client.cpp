@@ -31,4 +31,10 @@ namespace kagome::network {
         });
   }
 
+  void DummySyncProtocolClient::requestState(
+      const StateRequest &request,
+      std::function<void(outcome::result<StateResponse>)> cb) {
+    log_->debug("Skipped self-requesting {} state nodes", request.keys.size());
+  }
+
 }  // namespace kagome::network
@@ -17,6 +17,8 @@ namespace kagome::network {
         public std::enable_shared_from_this<DummySyncProtocolClient> {
     using BlocksResponse = network::BlocksResponse;
     using BlocksRequest = network::BlocksRequest;
+    using StateResponse = network::StateResponse;
+    using StateRequest = network::StateRequest;
 
    public:
     DummySyncProtocolClient();
@@ -25,6 +27,10 @@ namespace kagome::network {
         const BlocksRequest &request,
         std::function<void(outcome::result<BlocksResponse>)> cb) override;
 
+    void requestState(
+        const StateRequest &request,
+        std::function<void(outcome::result<StateResponse>)> cb) override;
+
    private:
     common::Logger log_;
   };
@@ -18,4 +18,10 @@ namespace kagome::network {
     return api_->submitExtrinsic(extrinsic);
   }
 
+  std::vector<outcome::result<common::Hash256>>
+  ExtrinsicObserverImpl::onTxMessages(
+      const std::vector<primitives::Extrinsic> &extrinsics) {
+    return api_->submitExtrinsics(extrinsics);
+  }
+
 }  // namespace kagome::network
@@ -21,6 +21,9 @@ namespace kagome::network {
     outcome::result<common::Hash256> onTxMessage(
         const primitives::Extrinsic &extrinsic) override;
 
+    std::vector<outcome::result<common::Hash256>> onTxMessages(
+        const std::vector<primitives::Extrinsic> &extrinsics) override;
+
    private:
     std::shared_ptr<api::AuthorApi> api_;
     common::Logger logger_;
@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/gossip_cache.hpp"
+
+namespace kagome::network {
+
+  GossipCache::GossipCache(std::shared_ptr<clock::SteadyClock> clock,
+                           size_t capacity,
+                           clock::SteadyClock::Duration ttl)
+      : clock_{std::move(clock)}, capacity_{capacity}, ttl_{ttl} {
+    BOOST_ASSERT(clock_ != nullptr);
+    BOOST_ASSERT(capacity_ != 0);
+  }
+
+  bool GossipCache::isKnown(const common::Hash256 &hash) {
+    eraseOutdated();
+    return index_.count(hash) != 0;
+  }
+
+  void GossipCache::insert(const common::Hash256 &hash) {
+    insert(hash, boost::none);
+  }
+
+  void GossipCache::insert(const common::Hash256 &hash,
+                           Topic topic,
+                           uint64_t number) {
+    if (number < expired_below_[static_cast<size_t>(topic)]) {
+      return insert(hash, boost::none);
+    }
+    insert(hash, std::make_pair(topic, number));
+  }
+
+  void GossipCache::insert(const common::Hash256 &hash,
+                           boost::optional<std::pair<Topic, uint64_t>> topic) {
+    eraseOutdated();
+    if (auto it = index_.find(hash); it != index_.end()) {
+      erase(it->second);
+    }
+    if (entries_.size() == capacity_) {
+      erase(entries_.begin());
+    }
+
+    Entry entry{hash, clock_->now() + ttl_, boost::none};
+    if (topic) {
+      auto &topic_index = topics_[static_cast<size_t>(topic->first)];
+      entry.topic.emplace(topic->first,
+                          topic_index.emplace(topic->second, hash));
+    }
+    index_.emplace(hash, entries_.insert(entries_.end(), std::move(entry)));
+  }
+
+  void GossipCache::expireBelow(Topic topic, uint64_t number) {
+    auto &expired_below = expired_below_[static_cast<size_t>(topic)];
+    if (number <= expired_below) {
+      return;
+    }
+    expired_below = number;
+
+    auto &topic_index = topics_[static_cast<size_t>(topic)];
+    auto end = topic_index.lower_bound(number);
+    for (auto it = topic_index.begin(); it != end;) {
+      // erase() invalidates the iterator of the topic index
+      auto entry = index_.at((it++)->second);
+      erase(entry);
+    }
+  }
+
+  size_t GossipCache::size() const {
+    return entries_.size();
+  }
+
+  void GossipCache::erase(std::list<Entry>::iterator it) {
+    if (it->topic) {
+      topics_[static_cast<size_t>(it->topic->first)].erase(it->topic->second);
+    }
+    index_.erase(it->hash);
+    entries_.erase(it);
+  }
+
+  void GossipCache::eraseOutdated() {
+    // the entries expire in the order of insertion
+    auto now = clock_->now();
+    while (not entries_.empty() and entries_.front().expires_at <= now) {
+      erase(entries_.begin());
+    }
+  }
+
+}  // namespace kagome::network
@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_GOSSIP_CACHE_HPP
+#define KAGOME_CORE_NETWORK_IMPL_GOSSIP_CACHE_HPP
+
+#include <array>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "clock/clock.hpp"
+#include "common/blob.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Bounded set of the hashes of the recently received gossip messages, so
+   * that a message coming from several peers is processed once.
+   * A hash is forgotten after a period of time, when the set is over its
+   * capacity, the oldest first, or when the topic it is tied to, such as a
+   * GRANDPA round, is expired. Not thread-safe
+   */
+  class GossipCache {
+   public:
+    /// sequence the messages are tied to, each expiring as it goes on
+    enum class Topic { GRANDPA_ROUND = 0, BLOCK_NUMBER };
+    static constexpr size_t kTopicsNum = 2;
+
+    GossipCache(std::shared_ptr<clock::SteadyClock> clock,
+                size_t capacity,
+                clock::SteadyClock::Duration ttl);
+
+    /// @return true if the message of \arg hash was seen
+    bool isKnown(const common::Hash256 &hash);
+
+    /// Remembers the message of \arg hash, not tied to any topic
+    void insert(const common::Hash256 &hash);
+
+    /**
+     * Remembers the message of \arg hash until \arg number of \arg topic
+     * is expired. If it is expired already, as the numbers of a topic may
+     * start over, the message is not tied to the topic
+     */
+    void insert(const common::Hash256 &hash, Topic topic, uint64_t number);
+
+    /// Forgets the messages of \arg topic tied to the numbers below \arg
+    /// number, which are expired from now on
+    void expireBelow(Topic topic, uint64_t number);
+
+    size_t size() const;
+
+   private:
+    using TopicIndex = std::multimap<uint64_t, common::Hash256>;
+
+    struct Entry {
+      common::Hash256 hash;
+      clock::SteadyClock::TimePoint expires_at;
+      boost::optional<std::pair<Topic, TopicIndex::iterator>> topic;
+    };
+
+    void insert(const common::Hash256 &hash,
+                boost::optional<std::pair<Topic, uint64_t>> topic);
+
+    void erase(std::list<Entry>::iterator it);
+
+    /// Forgets the messages seen earlier than the period of time ago
+    void eraseOutdated();
+
+    std::shared_ptr<clock::SteadyClock> clock_;
+    size_t capacity_;
+    clock::SteadyClock::Duration ttl_;
+    // the most recently inserted entry is at the back
+    std::list<Entry> entries_;
+    std::unordered_map<common::Hash256, std::list<Entry>::iterator> index_;
+    std::array<TopicIndex, kTopicsNum> topics_;
+    std::array<uint64_t, kTopicsNum> expired_below_{};
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_GOSSIP_CACHE_HPP
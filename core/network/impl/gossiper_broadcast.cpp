@@ -5,29 +5,170 @@
 
 #include "network/impl/gossiper_broadcast.hpp"
 
+#include <unordered_set>
+
+#include <libp2p/multi/uvarint.hpp>
+
 #include "network/common.hpp"
-#include "network/helpers/scale_message_read_writer.hpp"
 #include "network/impl/loopback_stream.hpp"
 
 namespace kagome::network {
 
-  GossiperBroadcast::GossiperBroadcast(libp2p::Host &host)
-      : host_{host}, logger_{common::createLogger("GossiperBroadcast")} {}
+  bool GossiperBroadcast::KnownTransactions::insert(
+      const common::Hash256 &hash) {
+    auto [it, inserted] = index_.emplace(hash, order_.end());
+    if (not inserted) {
+      order_.splice(order_.end(), order_, it->second);
+      return false;
+    }
+    it->second = order_.insert(order_.end(), hash);
+    if (order_.size() > kMaxKnownTransactions) {
+      index_.erase(order_.front());
+      order_.pop_front();
+    }
+    return true;
+  }
+
+  GossiperBroadcast::GossiperBroadcast(
+      libp2p::Host &host,
+      std::unique_ptr<clock::Timer> timer,
+      std::shared_ptr<clock::SystemClock> clock,
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<PeerManager> peer_manager,
+      std::shared_ptr<NetworkMetrics> metrics,
+      std::shared_ptr<GrandpaNeighbors> neighbors,
+      std::shared_ptr<LoopbackChannel> loopback)
+      : host_{host},
+        timer_{std::move(timer)},
+        clock_{std::move(clock)},
+        hasher_{std::move(hasher)},
+        peer_manager_{std::move(peer_manager)},
+        metrics_{std::move(metrics)},
+        neighbors_{std::move(neighbors)},
+        loopback_{std::move(loopback)},
+        logger_{common::createLogger("GossiperBroadcast")} {
+    BOOST_ASSERT(timer_ != nullptr);
+    BOOST_ASSERT(clock_ != nullptr);
+    BOOST_ASSERT(hasher_ != nullptr);
+  }
 
   void GossiperBroadcast::reserveStream(
       const libp2p::peer::PeerInfo &peer_info,
       std::shared_ptr<libp2p::connection::Stream> stream) {
-    streams_.emplace(peer_info, std::move(stream));
+    PeerStream peer;
+    peer.stream = std::move(stream);
+    streams_.emplace(peer_info, std::move(peer));
   }
 
   void GossiperBroadcast::transactionAnnounce(
       const TransactionAnnounce &announce) {
-    logger_->debug("Gossip tx announce: {} extrinsics",
+    logger_->debug("Queue tx announce: {} extrinsics",
                    announce.extrinsics.size());
-    GossipMessage message;
-    message.type = GossipMessage::Type::TRANSACTIONS;
-    message.data.put(scale::encode(announce).value());
-    broadcast(std::move(message));
+    std::lock_guard lock{txs_mutex_};
+    for (auto &extrinsic : announce.extrinsics) {
+      pending_txs_.emplace_back(hasher_->blake2b_256(extrinsic.data),
+                                extrinsic);
+    }
+    if (flush_scheduled_ or pending_txs_.empty()) {
+      return;
+    }
+    flush_scheduled_ = true;
+    timer_->expiresAt(clock_->now() + kTransactionsBatchPeriod);
+    timer_->asyncWait([weak{weak_from_this()}](auto &&ec) {
+      auto self = weak.lock();
+      if (not self) {
+        return;
+      }
+      if (ec) {
+        self->logger_->error("error happened while waiting on the timer: {}",
+                             ec.message());
+      }
+      // sent anyway, as nothing else would send them
+      self->flushTransactions();
+    });
+  }
+
+  void GossiperBroadcast::transactionsReceived(
+      const libp2p::peer::PeerId &peer,
+      const std::vector<common::Hash256> &hashes) {
+    std::lock_guard lock{txs_mutex_};
+    auto &known = known_txs_[peer];
+    for (auto &hash : hashes) {
+      known.insert(hash);
+    }
+  }
+
+  void GossiperBroadcast::flushTransactions() {
+    std::vector<std::pair<common::Hash256, primitives::Extrinsic>> txs;
+    {
+      std::lock_guard lock{txs_mutex_};
+      txs.swap(pending_txs_);
+      flush_scheduled_ = false;
+    }
+    if (txs.empty()) {
+      return;
+    }
+    logger_->debug("Gossip tx announce: {} extrinsics", txs.size());
+
+    auto encode_announce = [this](TransactionAnnounce announce) {
+      GossipMessage message;
+      message.type = GossipMessage::Type::TRANSACTIONS;
+      message.data.put(scale::encode(announce).value());
+      auto encoded = encode(message);
+      if (not encoded) {
+        logger_->error("Could not encode tx announce: {}",
+                       encoded.error().message());
+        return EncodedMessage{};
+      }
+      return std::move(encoded.value());
+    };
+    // the peers, which know none of the extrinsics, all get the same message
+    EncodedMessage all_txs_msg;
+
+    auto own_id = host_.getId();
+    std::unordered_set<libp2p::peer::PeerId> peers;
+    auto make_announce = [&](const boost::optional<libp2p::peer::PeerId> &peer)
+        -> EncodedMessage {
+      // the own node has the extrinsics it announces
+      if (peer == own_id) {
+        return nullptr;
+      }
+      TransactionAnnounce announce;
+      {
+        std::lock_guard lock{txs_mutex_};
+        KnownTransactions *known = nullptr;
+        if (peer) {
+          peers.insert(*peer);
+          known = &known_txs_[*peer];
+        }
+        for (auto &[hash, extrinsic] : txs) {
+          if (known == nullptr or known->insert(hash)) {
+            announce.extrinsics.push_back(extrinsic);
+          }
+        }
+      }
+      if (announce.extrinsics.empty()) {
+        return nullptr;
+      }
+      if (announce.extrinsics.size() < txs.size()) {
+        return encode_announce(std::move(announce));
+      }
+      if (all_txs_msg == nullptr) {
+        all_txs_msg = encode_announce(std::move(announce));
+      }
+      return all_txs_msg;
+    };
+    broadcast(make_announce, Priority::TRANSACTIONS);
+
+    // the known extrinsics of the peers without a stream are forgotten
+    std::lock_guard lock{txs_mutex_};
+    for (auto it = known_txs_.begin(); it != known_txs_.end();) {
+      if (peers.count(it->first) == 0) {
+        it = known_txs_.erase(it);
+      } else {
+        ++it;
+      }
+    }
   }
 
   void GossiperBroadcast::blockAnnounce(const BlockAnnounce &announce) {
@@ -36,7 +177,8 @@ namespace kagome::network {
     GossipMessage message;
     message.type = GossipMessage::Type::BLOCK_ANNOUNCE;
     message.data.put(scale::encode(announce).value());
-    broadcast(std::move(message));
+    broadcast(message, Priority::BLOCK_ANNOUNCE);
+    sendToSelf(announce);
   }
 
   void GossiperBroadcast::vote(
@@ -47,7 +189,12 @@ namespace kagome::network {
     message.type = GossipMessage::Type::CONSENSUS;
     message.data.put(scale::encode(vote_message).value());
 
-    broadcast(std::move(message));
+    broadcast(message, Priority::CONSENSUS, [&](const auto &peer) {
+      return neighbors_ == nullptr
+             or neighbors_->isVoteUseful(
+                 peer, vote_message.round_number, vote_message.counter);
+    });
+    sendToSelf(vote_message);
   }
 
   void GossiperBroadcast::finalize(const consensus::grandpa::Fin &fin) {
@@ -57,7 +204,27 @@ namespace kagome::network {
     message.type = GossipMessage::Type::CONSENSUS;
     message.data.put(scale::encode(fin).value());
 
-    broadcast(std::move(message));
+    broadcast(message, Priority::CONSENSUS, [&](const auto &peer) {
+      return neighbors_ == nullptr
+             or neighbors_->isFinUseful(peer, fin.vote.block_number);
+    });
+    sendToSelf(fin);
+  }
+
+  void GossiperBroadcast::catchUp(
+      const consensus::grandpa::CatchUpMessage &message) {
+    logger_->debug("Gossip catch-up message of type {}", message.which());
+    if (auto packet = boost::get<consensus::grandpa::NeighborPacket>(&message);
+        packet != nullptr and neighbors_ != nullptr) {
+      neighbors_->updateOwn(*packet);
+    }
+    GossipMessage gossip_message;
+    gossip_message.type = GossipMessage::Type::CATCH_UP;
+    gossip_message.data.put(scale::encode(message).value());
+
+    // the own catch-up messages are of no use to this node, so they are not
+    // sent to it
+    broadcast(gossip_message, Priority::CONSENSUS);
   }
 
   void GossiperBroadcast::addStream(
@@ -65,56 +232,359 @@ namespace kagome::network {
     syncing_streams_.push_back(stream);
   }
 
-  void GossiperBroadcast::broadcast(GossipMessage &&msg) {
-    auto msg_send_lambda = [msg, this](auto stream) {
-      auto read_writer =
-          std::make_shared<ScaleMessageReadWriter>(std::move(stream));
-      read_writer->write(msg, [this](auto &&res) {
-        if (not res) {
-          logger_->error("Could not broadcast, reason: {}",
-                         res.error().message());
-        }
-      });
-    };
+  GossipMessage::Type GossiperBroadcast::messageType(Priority priority) {
+    switch (priority) {
+      case Priority::CONSENSUS:
+        return GossipMessage::Type::CONSENSUS;
+      case Priority::BLOCK_ANNOUNCE:
+        return GossipMessage::Type::BLOCK_ANNOUNCE;
+      case Priority::TRANSACTIONS:
+        return GossipMessage::Type::TRANSACTIONS;
+    }
+    return GossipMessage::Type::UNKNOWN;
+  }
 
+  outcome::result<GossiperBroadcast::EncodedMessage> GossiperBroadcast::encode(
+      const GossipMessage &msg) const {
+    auto start = NetworkMetrics::Clock::now();
+    OUTCOME_TRY(encoded, scale::encode(msg));
+    // framed the way the readers of the streams expect
+    libp2p::multi::UVarint length{encoded.size()};
+    auto length_bytes = length.toBytes();
+    auto framed = std::make_shared<std::vector<uint8_t>>();
+    framed->reserve(length_bytes.size() + encoded.size());
+    framed->insert(framed->end(), length_bytes.begin(), length_bytes.end());
+    framed->insert(framed->end(), encoded.begin(), encoded.end());
+    if (metrics_ != nullptr) {
+      metrics_->recordEncoding(kGossipProtocol,
+                               toString(msg.type),
+                               NetworkMetrics::Clock::now() - start);
+    }
+    return framed;
+  }
+
+  void GossiperBroadcast::broadcast(const GossipMessage &msg,
+                                    Priority priority) {
+    broadcast(msg, priority, [](const auto &) { return true; });
+  }
+
+  void GossiperBroadcast::broadcast(
+      const GossipMessage &msg,
+      Priority priority,
+      const std::function<bool(const boost::optional<libp2p::peer::PeerId> &)>
+          &is_useful) {
+    auto encoded = encode(msg);
+    if (not encoded) {
+      return logger_->error("Could not encode gossip message: {}",
+                            encoded.error().message());
+    }
+    broadcast(
+        [&](const auto &peer) {
+          return is_useful(peer) ? encoded.value() : nullptr;
+        },
+        priority);
+  }
+
+  void GossiperBroadcast::broadcast(const MessageMaker &make,
+                                    Priority priority) {
     // iterate over the existing streams and send them the msg. If stream is
     // closed it is removed
     auto stream_it = syncing_streams_.begin();
     while (stream_it != syncing_streams_.end()) {
       auto stream = *stream_it;
       if (stream && !stream->isClosed()) {
-        msg_send_lambda(stream);
+        boost::optional<libp2p::peer::PeerId> peer;
+        if (auto peer_res = stream->remotePeerId(); peer_res) {
+          peer = peer_res.value();
+        }
+        if (peer and isBanned(*peer)) {
+          stream_it++;
+          continue;
+        }
+        if (auto msg = make(peer);
+            msg and not enqueue(stream, std::move(msg), priority)) {
+          stream_it = syncing_streams_.erase(stream_it);
+          continue;
+        }
         stream_it++;
       } else {
         // remove this stream
+        queues_.erase(stream);
+        recordQueue(stream);
         stream_it = syncing_streams_.erase(stream_it);
       }
     }
-    for (const auto &[info, stream] : streams_) {
-      if (stream && !stream->isClosed()) {
-        msg_send_lambda(stream);
+    for (auto &[info, peer] : streams_) {
+      if (isBanned(info.id) or isLoopback(info.id)) {
         continue;
       }
-      // if stream does not exist or expired, open a new one
-      host_.newStream(info,
-                      kGossipProtocol,
-                      [self{shared_from_this()}, info = info, msg_send_lambda](
-                          auto &&stream_res) mutable {
-                        if (!stream_res) {
-                          // we will try to open the stream again, when
-                          // another gossip message arrives later
-                          self->logger_->error(
-                              "Could not send message to {} Error: {}",
-                              info.id.toBase58(),
-                              stream_res.error().message());
-                          return;
-                        }
-
-                        // save the stream and send the message
-                        self->streams_[info] = stream_res.value();
-                        msg_send_lambda(std::move(stream_res.value()));
-                      });
+      if (auto msg = make(info.id)) {
+        sendToPeer(info, peer, std::move(msg), priority);
+      }
+    }
+  }
+
+  void GossiperBroadcast::sendToPeer(const libp2p::peer::PeerInfo &info,
+                                     PeerStream &peer,
+                                     EncodedMessage msg,
+                                     Priority priority) {
+    if (peer.stream != nullptr and not peer.stream->isClosed()) {
+      if (not enqueue(peer.stream, std::move(msg), priority)) {
+        // it was reset as stalled
+        peer.stream.reset();
+        backOff(info, peer);
+      }
+      return;
+    }
+    if (peer.stream != nullptr) {
+      queues_.erase(peer.stream);
+      recordQueue(peer.stream);
+      peer.stream.reset();
+    }
+
+    if (peer.connecting) {
+      pushMessage(peer.pending, std::move(msg), priority);
+      return;
+    }
+    // the peer is not reachable for now
+    if (clock_->now() < peer.next_attempt) {
+      return;
+    }
+    pushMessage(peer.pending, std::move(msg), priority);
+    peer.connecting = true;
+    host_.newStream(
+        info,
+        kGossipProtocol,
+        [self{shared_from_this()}, info](auto &&stream_res) {
+          self->onConnected(info,
+                            std::forward<decltype(stream_res)>(stream_res));
+        });
+  }
+
+  void GossiperBroadcast::onConnected(
+      const libp2p::peer::PeerInfo &info,
+      outcome::result<std::shared_ptr<libp2p::connection::Stream>> res) {
+    auto it = streams_.find(info);
+    if (it == streams_.end()) {
+      return;
+    }
+    auto &peer = it->second;
+    peer.connecting = false;
+    auto pending = std::move(peer.pending);
+    peer.pending = {};
+    if (not res) {
+      backOff(info, peer);
+      logger_->error("Could not open gossip stream to {}, {} bytes of "
+                     "messages are dropped. Error: {}",
+                     info.id.toBase58(),
+                     pending.bytes,
+                     res.error().message());
+      return;
+    }
+
+    peer.stream = std::move(res.value());
+    peer.backoff = {};
+    for (size_t i = 0; i < kPrioritiesNum; ++i) {
+      auto priority = static_cast<Priority>(i);
+      for (auto &msg : pending.messages[i]) {
+        if (not enqueue(peer.stream, std::move(msg), priority)) {
+          return;
+        }
+      }
+    }
+  }
+
+  void GossiperBroadcast::backOff(const libp2p::peer::PeerInfo &info,
+                                  PeerStream &peer) {
+    peer.backoff =
+        peer.backoff == clock::SystemClock::Duration::zero()
+            ? std::chrono::duration_cast<clock::SystemClock::Duration>(
+                kMinReconnectBackoff)
+            : std::min<clock::SystemClock::Duration>(peer.backoff * 2,
+                                                     kMaxReconnectBackoff);
+    peer.next_attempt = clock_->now() + peer.backoff;
+    logger_->debug(
+        "Gossip stream to {} is reopened in {} ms",
+        info.id.toBase58(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(peer.backoff)
+            .count());
+  }
+
+  bool GossiperBroadcast::pushMessage(OutboundQueue &queue,
+                                      EncodedMessage msg,
+                                      Priority priority) {
+    // the oldest messages of the same or the lower priority make room for the
+    // new one, starting from the lowest priority; a message exceeding the
+    // limit on its own is still sent to an idle stream
+    auto size = msg->size();
+    auto over_limit = [&] {
+      return queue.bytes != 0 and queue.bytes + size > kMaxQueuedBytes;
+    };
+    auto lowest = static_cast<size_t>(Priority::TRANSACTIONS);
+    auto highest = std::max(static_cast<size_t>(priority),
+                            static_cast<size_t>(Priority::BLOCK_ANNOUNCE));
+    for (auto i = lowest; i >= highest and over_limit(); --i) {
+      auto &messages = queue.messages[i];
+      while (not messages.empty() and over_limit()) {
+        queue.bytes -= messages.front()->size();
+        messages.pop_front();
+      }
+    }
+    if (over_limit()) {
+      if (priority != Priority::CONSENSUS) {
+        logger_->debug("Gossip message of {} bytes is dropped, the queue is "
+                       "full",
+                       size);
+        return true;
+      }
+      // the message being written may take the room, but the consensus
+      // messages, which are not taken, make the peer useless
+      if (not queue.messages[static_cast<size_t>(Priority::CONSENSUS)]
+                  .empty()) {
+        return false;
+      }
+    }
+
+    queue.bytes += size;
+    queue.messages[static_cast<size_t>(priority)].push_back(std::move(msg));
+    return true;
+  }
+
+  bool GossiperBroadcast::enqueue(
+      const std::shared_ptr<libp2p::connection::Stream> &stream,
+      EncodedMessage msg,
+      Priority priority) {
+    auto &queue = queues_[stream];
+    if (queue.writing
+        and clock_->now() - queue.write_started > kStalledWriteTimeout) {
+      logger_->warn("Gossip stream is stalled, {} bytes queued, resetting it",
+                    queue.bytes);
+      queues_.erase(stream);
+      recordQueue(stream);
+      stream->reset();
+      return false;
+    }
+
+    if (not pushMessage(queue, std::move(msg), priority)) {
+      logger_->warn("Gossip stream does not take the consensus messages, "
+                    "resetting it");
+      queues_.erase(stream);
+      recordQueue(stream);
+      stream->reset();
+      return false;
+    }
+
+    if (not queue.writing) {
+      writeNext(stream);
+    } else {
+      recordQueue(stream);
+    }
+    return true;
+  }
+
+  void GossiperBroadcast::writeNext(
+      const std::shared_ptr<libp2p::connection::Stream> &stream) {
+    auto it = queues_.find(stream);
+    if (it == queues_.end()) {
+      return;
+    }
+    auto &queue = it->second;
+    EncodedMessage msg;
+    auto priority = Priority::CONSENSUS;
+    for (size_t i = 0; i < kPrioritiesNum; ++i) {
+      auto &messages = queue.messages[i];
+      if (not messages.empty()) {
+        msg = std::move(messages.front());
+        messages.pop_front();
+        priority = static_cast<Priority>(i);
+        break;
+      }
+    }
+    if (msg == nullptr) {
+      queues_.erase(it);
+      recordQueue(stream);
+      return;
+    }
+
+    queue.writing = true;
+    queue.write_started = clock_->now();
+    recordQueue(stream);
+    // the message is kept alive by the callback until it is written
+    const auto &bytes = *msg;
+    stream->write(
+        bytes,
+        bytes.size(),
+        [weak{weak_from_this()}, stream, msg, priority](auto &&res) {
+          if (auto self = weak.lock()) {
+            self->onWritten(stream, msg->size(), priority, res);
+          }
+        });
+  }
+
+  void GossiperBroadcast::onWritten(
+      const std::shared_ptr<libp2p::connection::Stream> &stream,
+      size_t bytes,
+      Priority priority,
+      outcome::result<size_t> res) {
+    auto it = queues_.find(stream);
+    if (it == queues_.end()) {
+      // the stream was reset
+      return;
+    }
+    if (not res) {
+      logger_->error("Could not broadcast, reason: {}", res.error().message());
+      // the queued messages would fail the same
+      queues_.erase(it);
+      recordQueue(stream);
+      return;
+    }
+    if (metrics_ != nullptr) {
+      metrics_->recordSent(
+          kGossipProtocol, toString(messageType(priority)), bytes);
+    }
+    it->second.bytes -= bytes;
+    it->second.writing = false;
+    writeNext(stream);
+  }
+
+  void GossiperBroadcast::recordQueue(
+      const std::shared_ptr<libp2p::connection::Stream> &stream) const {
+    if (metrics_ == nullptr) {
+      return;
+    }
+    auto peer_res = stream->remotePeerId();
+    if (not peer_res) {
+      return;
+    }
+    auto peer = peer_res.value().toBase58();
+    auto it = queues_.find(stream);
+    if (it == queues_.end()) {
+      return metrics_->recordQueue(peer, 0, 0);
+    }
+    auto &queue = it->second;
+    // including the one being written
+    size_t messages = queue.writing ? 1 : 0;
+    for (auto &queued : queue.messages) {
+      messages += queued.size();
+    }
+    metrics_->recordQueue(peer, messages, queue.bytes);
+  }
+
+  bool GossiperBroadcast::isBanned(const libp2p::peer::PeerId &peer) const {
+    return peer_manager_ != nullptr and peer_manager_->isBanned(peer);
+  }
+
+  bool GossiperBroadcast::isLoopback(const libp2p::peer::PeerId &peer) const {
+    return loopback_ != nullptr and loopback_->isBound()
+           and peer == host_.getId();
+  }
+
+  void GossiperBroadcast::sendToSelf(LoopbackChannel::Message message) const {
+    if (loopback_ == nullptr or not loopback_->isBound()) {
+      return;
     }
+    loopback_->send(
+        std::make_shared<const LoopbackChannel::Message>(std::move(message)));
   }
 
 }  // namespace kagome::network
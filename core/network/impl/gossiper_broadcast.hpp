@@ -6,20 +6,55 @@
 #ifndef KAGOME_GOSSIPER_BROADCAST_HPP
 #define KAGOME_GOSSIPER_BROADCAST_HPP
 
-#include <gsl/span>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <mutex>
 #include <unordered_map>
 
+#include <boost/optional.hpp>
+#include <gsl/span>
+
+#include "clock/clock.hpp"
+#include "clock/timer.hpp"
 #include "common/logger.hpp"
+#include "crypto/hasher.hpp"
 #include "libp2p/connection/stream.hpp"
 #include "libp2p/host/host.hpp"
 #include "libp2p/peer/peer_info.hpp"
 #include "network/gossiper.hpp"
+#include "network/impl/grandpa_neighbors.hpp"
+#include "network/impl/loopback_channel.hpp"
+#include "network/network_metrics.hpp"
+#include "network/peer_manager.hpp"
 #include "network/types/gossip_message.hpp"
 #include "network/types/peer_list.hpp"
 
 namespace kagome::network {
   /**
-   * Sends gossip messages using broadcast strategy
+   * Sends gossip messages using broadcast strategy. The announced extrinsics
+   * are collected for a short period and sent in one message per peer,
+   * without the ones the peer is known to have: sent to it or received from
+   * it.
+   * The messages for a stream are queued and written one at a time, the
+   * consensus ones first, then the block announces and the extrinsics, so
+   * that a flood of extrinsics does not delay the consensus. A queue is
+   * limited in bytes by dropping its oldest messages of the same or the lower
+   * priority, the consensus ones are never dropped, and the stream, which
+   * does not take them or any write for a while, is reset.
+   * One stream is kept open to each reserved peer. Once it is closed, the
+   * next broadcast reopens it, and the messages are queued until it is
+   * opened; if it fails to be opened, the messages to the peer are dropped
+   * for a backoff period.
+   * Nothing is sent to the peers banned by the peer manager, and the GRANDPA
+   * votes and fins are sent only to the peers they are useful to, as told by
+   * the neighbor packets, if any.
+   * The block announces, the GRANDPA votes and the fins of this node reach
+   * its own observers through the loopback channel, if it is bound, instead of the
+   * loopback stream.
+   * The sent messages and the depths of the queues of the peers are recorded
+   * to the network metrics, if any
    */
   class GossiperBroadcast
       : public Gossiper,
@@ -29,7 +64,39 @@ namespace kagome::network {
     using PrimaryPropose = consensus::grandpa::PrimaryPropose;
 
    public:
-    GossiperBroadcast(libp2p::Host &host);
+    /// how long the announced extrinsics are collected before being sent
+    static constexpr std::chrono::milliseconds kTransactionsBatchPeriod{200};
+
+    /// number of the extrinsics remembered as known for each peer
+    static constexpr size_t kMaxKnownTransactions = 10240;
+
+    /// limit of the bytes queued for a stream, including the ones written
+    static constexpr size_t kMaxQueuedBytes = 4 * 1024 * 1024;
+
+    /// how long a write may take before the stream is considered stalled
+    static constexpr std::chrono::seconds kStalledWriteTimeout{30};
+
+    /// bounds of the delay before a gossip stream to a peer is reopened,
+    /// doubled on every failure to open it
+    static constexpr std::chrono::seconds kMinReconnectBackoff{1};
+    static constexpr std::chrono::seconds kMaxReconnectBackoff{60};
+
+    /**
+     * @param peer_manager tells the banned peers, if any
+     * @param metrics records the sent messages and the queues, if any
+     * @param neighbors tells the peers the GRANDPA messages are useful to,
+     * if any, and is told the neighbor packets of this node
+     * @param loopback passes the messages to the own observers as they are,
+     * if any
+     */
+    GossiperBroadcast(libp2p::Host &host,
+                      std::unique_ptr<clock::Timer> timer,
+                      std::shared_ptr<clock::SystemClock> clock,
+                      std::shared_ptr<crypto::Hasher> hasher,
+                      std::shared_ptr<PeerManager> peer_manager = nullptr,
+                      std::shared_ptr<NetworkMetrics> metrics = nullptr,
+                      std::shared_ptr<GrandpaNeighbors> neighbors = nullptr,
+                      std::shared_ptr<LoopbackChannel> loopback = nullptr);
 
     ~GossiperBroadcast() override = default;
 
@@ -39,22 +106,171 @@ namespace kagome::network {
 
     void transactionAnnounce(const TransactionAnnounce &announce) override;
 
+    void transactionsReceived(
+        const libp2p::peer::PeerId &peer,
+        const std::vector<common::Hash256> &hashes) override;
+
     void blockAnnounce(const BlockAnnounce &announce) override;
 
     void vote(const consensus::grandpa::VoteMessage &msg) override;
 
     void finalize(const consensus::grandpa::Fin &fin) override;
 
+    void catchUp(const consensus::grandpa::CatchUpMessage &message) override;
+
     void addStream(std::shared_ptr<libp2p::connection::Stream> stream) override;
 
    private:
-    void broadcast(GossipMessage &&msg);
+    /**
+     * Message encoded along with its length prefix, as it is written to the
+     * streams, so that it is encoded once and shared by the writes to all of
+     * them
+     */
+    using EncodedMessage = std::shared_ptr<const std::vector<uint8_t>>;
+
+    /**
+     * Makes the message for the peer, nullptr if there is nothing to be sent
+     * to it. The peer is unknown for an incoming stream, which does not tell
+     * it
+     */
+    using MessageMaker = std::function<EncodedMessage(
+        const boost::optional<libp2p::peer::PeerId> &)>;
+
+    /// the messages of the lower values are sent first
+    enum class Priority { CONSENSUS = 0, BLOCK_ANNOUNCE, TRANSACTIONS };
+    static constexpr size_t kPrioritiesNum = 3;
+
+    /// messages waiting to be written to a stream
+    struct OutboundQueue {
+      std::array<std::deque<EncodedMessage>, kPrioritiesNum> messages;
+      /// of the queued messages and the one being written
+      size_t bytes = 0;
+      bool writing = false;
+      clock::SystemClock::TimePoint write_started;
+    };
+
+    /// stream to a reserved peer
+    struct PeerStream {
+      /// nullptr if not opened
+      std::shared_ptr<libp2p::connection::Stream> stream;
+      bool connecting = false;
+      /// messages waiting for the stream to be opened
+      OutboundQueue pending;
+      /// the stream is not reopened before
+      clock::SystemClock::TimePoint next_attempt;
+      clock::SystemClock::Duration backoff{};
+    };
+
+    /// LRU set of the hashes of the extrinsics known by a peer
+    class KnownTransactions {
+     public:
+      /// @return false if \arg hash was known already
+      bool insert(const common::Hash256 &hash);
+
+     private:
+      // the most recently inserted hash is at the back
+      std::list<common::Hash256> order_;
+      std::unordered_map<common::Hash256,
+                         std::list<common::Hash256>::iterator>
+          index_;
+    };
+
+    /// @return type of the gossip messages sent with \arg priority
+    static GossipMessage::Type messageType(Priority priority);
+
+    outcome::result<EncodedMessage> encode(const GossipMessage &msg) const;
+
+    void broadcast(const GossipMessage &msg, Priority priority);
+
+    void broadcast(const MessageMaker &make, Priority priority);
+
+    /// Sends \arg msg to the peers, for which \arg is_useful is true
+    void broadcast(
+        const GossipMessage &msg,
+        Priority priority,
+        const std::function<bool(const boost::optional<libp2p::peer::PeerId> &)>
+            &is_useful);
+
+    /**
+     * Queues \arg msg to be written to \arg stream
+     * @return false if the stream is reset, as it is stalled
+     */
+    bool enqueue(const std::shared_ptr<libp2p::connection::Stream> &stream,
+                 EncodedMessage msg,
+                 Priority priority);
+
+    /**
+     * Sends \arg msg to the reserved peer, opening the stream to it if
+     * needed
+     */
+    void sendToPeer(const libp2p::peer::PeerInfo &info,
+                    PeerStream &peer,
+                    EncodedMessage msg,
+                    Priority priority);
+
+    void onConnected(
+        const libp2p::peer::PeerInfo &info,
+        outcome::result<std::shared_ptr<libp2p::connection::Stream>> res);
+
+    /// Postpones reopening of the stream to the peer
+    void backOff(const libp2p::peer::PeerInfo &info, PeerStream &peer);
+
+    /**
+     * Puts \arg msg into \arg queue, dropping the messages over its limit
+     * @return false if the consensus messages are not taken
+     */
+    bool pushMessage(OutboundQueue &queue,
+                     EncodedMessage msg,
+                     Priority priority);
+
+    /// Writes the next queued message of \arg stream, if any
+    void writeNext(const std::shared_ptr<libp2p::connection::Stream> &stream);
+
+    void onWritten(const std::shared_ptr<libp2p::connection::Stream> &stream,
+                   size_t bytes,
+                   Priority priority,
+                   outcome::result<size_t> res);
+
+    /// Records the depth of the queue of \arg stream to the metrics
+    void recordQueue(
+        const std::shared_ptr<libp2p::connection::Stream> &stream) const;
+
+    /// Sends the collected extrinsics
+    void flushTransactions();
+
+    bool isBanned(const libp2p::peer::PeerId &peer) const;
+
+    /// @return true if the messages to \arg peer are passed by the loopback
+    /// channel, so they are not written to the loopback stream
+    bool isLoopback(const libp2p::peer::PeerId &peer) const;
+
+    /// Passes \arg message to the own observers by the loopback channel
+    void sendToSelf(LoopbackChannel::Message message) const;
 
     libp2p::Host &host_;
-    std::unordered_map<libp2p::peer::PeerInfo,
-                       std::shared_ptr<libp2p::connection::Stream>>
-        streams_;
+    std::unique_ptr<clock::Timer> timer_;
+    std::shared_ptr<clock::SystemClock> clock_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<PeerManager> peer_manager_;
+    std::shared_ptr<NetworkMetrics> metrics_;
+    std::shared_ptr<GrandpaNeighbors> neighbors_;
+    std::shared_ptr<LoopbackChannel> loopback_;
+    std::unordered_map<libp2p::peer::PeerInfo, PeerStream> streams_;
     std::vector<std::shared_ptr<libp2p::connection::Stream>> syncing_streams_{};
+    /// only of the streams with messages being written
+    std::unordered_map<std::shared_ptr<libp2p::connection::Stream>,
+                       OutboundQueue>
+        queues_;
+
+    /// guards the members below, as the extrinsics are announced from the
+    /// threads of the RPC too
+    std::mutex txs_mutex_;
+    /// announced extrinsics with their hashes, waiting to be sent
+    std::vector<std::pair<common::Hash256, primitives::Extrinsic>>
+        pending_txs_;
+    bool flush_scheduled_ = false;
+    std::unordered_map<libp2p::peer::PeerId, KnownTransactions> known_txs_;
+
     common::Logger logger_;
   };
 }  // namespace kagome::network
@@ -0,0 +1,66 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/grandpa_neighbors.hpp"
+
+namespace kagome::network {
+
+  void GrandpaNeighbors::update(const libp2p::peer::PeerId &peer,
+                                const NeighborPacket &packet) {
+    std::lock_guard lock{mutex_};
+    if (peers_.size() >= kMaxPeers and peers_.count(peer) == 0) {
+      peers_.clear();
+    }
+    auto [it, inserted] = peers_.emplace(peer, packet);
+    // the round starts over with a new set
+    if (not inserted
+        and (packet.set_id != it->second.set_id
+             or packet.round_number >= it->second.round_number)) {
+      it->second = packet;
+    }
+  }
+
+  void GrandpaNeighbors::updateOwn(const NeighborPacket &packet) {
+    std::lock_guard lock{mutex_};
+    own_ = packet;
+  }
+
+  bool GrandpaNeighbors::isVoteUseful(
+      const boost::optional<libp2p::peer::PeerId> &peer,
+      RoundNumber round,
+      MembershipCounter set_id) const {
+    if (not peer) {
+      return true;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = peers_.find(*peer);
+    if (it == peers_.end()) {
+      return true;
+    }
+    return it->second.set_id == set_id
+           and isRoundNear(round, it->second.round_number);
+  }
+
+  bool GrandpaNeighbors::isFinUseful(
+      const boost::optional<libp2p::peer::PeerId> &peer,
+      BlockNumber block_number) const {
+    if (not peer) {
+      return true;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = peers_.find(*peer);
+    return it == peers_.end() or it->second.last_finalized < block_number;
+  }
+
+  bool GrandpaNeighbors::isRoundUseful(RoundNumber round) const {
+    std::lock_guard lock{mutex_};
+    return not own_ or isRoundNear(round, own_->round_number);
+  }
+
+  bool GrandpaNeighbors::isRoundNear(RoundNumber round, RoundNumber other) {
+    return round + 1 >= other and round <= other + 1;
+  }
+
+}  // namespace kagome::network
@@ -0,0 +1,81 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_GRANDPA_NEIGHBORS_HPP
+#define KAGOME_CORE_NETWORK_IMPL_GRANDPA_NEIGHBORS_HPP
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "consensus/grandpa/catch_up.hpp"
+#include "libp2p/peer/peer_id.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Rounds, set ids and last finalized blocks announced by the GRANDPA
+   * neighbor packets of the peers and of this node, which tell the GRANDPA
+   * messages useful to them: the votes of the rounds next to their own ones
+   * and the fins of the blocks they have not finalized. Nothing is known of
+   * the peers, which have not sent a packet yet, so every message is useful
+   * to them. Thread-safe
+   */
+  class GrandpaNeighbors {
+   public:
+    using NeighborPacket = consensus::grandpa::NeighborPacket;
+    using RoundNumber = consensus::grandpa::RoundNumber;
+    using MembershipCounter = consensus::grandpa::MembershipCounter;
+    using BlockNumber = consensus::grandpa::BlockNumber;
+
+    /// number of the peers, over which the packets of all of them are
+    /// forgotten, as the peers are not told to be gone
+    static constexpr size_t kMaxPeers = 1024;
+
+    /**
+     * Records the latest neighbor \arg packet of \arg peer, the packets of
+     * the earlier rounds are ignored
+     */
+    void update(const libp2p::peer::PeerId &peer,
+                const NeighborPacket &packet);
+
+    /// Records the neighbor \arg packet of this node
+    void updateOwn(const NeighborPacket &packet);
+
+    /**
+     * @return true if a vote of \arg round in \arg set_id may be useful to
+     * \arg peer, which is unknown for an incoming stream, i.e. the peer is
+     * on the same set and at most a round apart from it
+     */
+    bool isVoteUseful(const boost::optional<libp2p::peer::PeerId> &peer,
+                      RoundNumber round,
+                      MembershipCounter set_id) const;
+
+    /**
+     * @return true if a fin of the block of \arg block_number may be useful
+     * to \arg peer, i.e. the peer has not finalized the block yet
+     */
+    bool isFinUseful(const boost::optional<libp2p::peer::PeerId> &peer,
+                     BlockNumber block_number) const;
+
+    /**
+     * @return true if a vote or a fin of \arg round received from a peer may
+     * be useful to this node, i.e. it is at most a round apart from the one
+     * of this node
+     */
+    bool isRoundUseful(RoundNumber round) const;
+
+   private:
+    static bool isRoundNear(RoundNumber round, RoundNumber other);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<libp2p::peer::PeerId, NeighborPacket> peers_;
+    boost::optional<NeighborPacket> own_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_GRANDPA_NEIGHBORS_HPP
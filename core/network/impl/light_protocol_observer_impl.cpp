@@ -0,0 +1,230 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/light_protocol_observer_impl.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/assert.hpp>
+
+#include "common/visitor.hpp"
+#include "runtime/common/storage_wasm_provider.hpp"
+#include "scale/scale.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
+                            LightProtocolObserverImpl::Error,
+                            e) {
+  using E = kagome::network::LightProtocolObserverImpl::Error;
+  switch (e) {
+    case E::TOO_MANY_KEYS:
+      return "Too many keys are requested to be proved at once";
+    case E::TOO_MANY_REQUESTS:
+      return "Too many requests are being served, the request is dropped";
+  }
+  return "unknown error";
+}
+
+namespace kagome::network {
+  namespace {
+    size_t proofSize(const std::vector<common::Buffer> &proof) {
+      size_t size = 0;
+      for (const auto &node : proof) {
+        size += node.size();
+      }
+      return size;
+    }
+  }  // namespace
+
+  LightProtocolObserverImpl::LightProtocolObserverImpl(
+      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+      std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+      std::shared_ptr<runtime::RawCall> raw_call,
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<StorageReadExecutor> executor,
+      std::shared_ptr<boost::asio::io_context> io_context)
+      : blocks_headers_{std::move(blocks_headers)},
+        trie_storage_{std::move(trie_storage)},
+        raw_call_{std::move(raw_call)},
+        hasher_{std::move(hasher)},
+        executor_{std::move(executor)},
+        io_context_{std::move(io_context)},
+        log_{common::createLogger("LightProtocolObserver")} {
+    BOOST_ASSERT(blocks_headers_ != nullptr);
+    BOOST_ASSERT(trie_storage_ != nullptr);
+    BOOST_ASSERT(raw_call_ != nullptr);
+    BOOST_ASSERT(hasher_ != nullptr);
+    BOOST_ASSERT(executor_ == nullptr or io_context_ != nullptr);
+  }
+
+  outcome::result<LightResponse> LightProtocolObserverImpl::onLightRequest(
+      const LightRequest &request) const {
+    auto key = cacheKey(request);
+    if (auto response = cached(request, key)) {
+      return std::move(*response);
+    }
+    OUTCOME_TRY(response, respond(request));
+    if (key) {
+      keep(*key, response);
+    }
+    return LightResponse{request.id, std::move(response)};
+  }
+
+  void LightProtocolObserverImpl::onLightRequest(
+      const LightRequest &request, ResponseHandler handler) const {
+    if (executor_ == nullptr) {
+      return handler(onLightRequest(request));
+    }
+    // a kept proof is answered right away, without taking a thread of the
+    // executor
+    auto key = cacheKey(request);
+    if (auto response = cached(request, key)) {
+      return handler(std::move(*response));
+    }
+    auto posted = executor_->post(
+        [self{shared_from_this()}, request, key, handler]() mutable {
+          auto response_res = self->respond(request);
+          if (response_res and key) {
+            self->keep(*key, response_res.value());
+          }
+          boost::asio::post(*self->io_context_,
+                            [handler{std::move(handler)},
+                             id{request.id},
+                             response_res{std::move(response_res)}]() mutable {
+                              if (not response_res) {
+                                return handler(response_res.error());
+                              }
+                              handler(LightResponse{
+                                  id, std::move(response_res.value())});
+                            });
+        });
+    if (not posted) {
+      handler(Error::TOO_MANY_REQUESTS);
+    }
+  }
+
+  size_t LightProtocolObserverImpl::cachedBytes() const {
+    std::lock_guard lock{cache_mutex_};
+    return bytes_;
+  }
+
+  boost::optional<LightProtocolObserverImpl::Key>
+  LightProtocolObserverImpl::cacheKey(const LightRequest &request) const {
+    // the headers are read at once and are not worth keeping
+    if (boost::get<RemoteHeaderRequest>(&request.request) != nullptr) {
+      return boost::none;
+    }
+    auto encoded = scale::encode(request.request);
+    if (not encoded) {
+      return boost::none;
+    }
+    return hasher_->blake2b_256(encoded.value());
+  }
+
+  boost::optional<LightResponse> LightProtocolObserverImpl::cached(
+      const LightRequest &request, const boost::optional<Key> &key) const {
+    if (not key) {
+      return boost::none;
+    }
+    std::shared_ptr<const Response> response;
+    {
+      std::lock_guard lock{cache_mutex_};
+      auto it = index_.find(*key);
+      if (it == index_.end()) {
+        return boost::none;
+      }
+      entries_.splice(entries_.begin(), entries_, it->second);
+      response = it->second->response;
+    }
+    log_->trace("Light request {} is answered with a kept proof", request.id);
+    // copied without the lock, as a proof may be large
+    return LightResponse{request.id, *response};
+  }
+
+  void LightProtocolObserverImpl::keep(const Key &key,
+                                       const Response &response) const {
+    auto bytes = visit_in_place(
+        response,
+        [](const RemoteReadResponse &read) { return proofSize(read.proof); },
+        [](const RemoteHeaderResponse &) -> size_t { return 0; },
+        [](const RemoteCallResponse &call) {
+          return call.result.size() + proofSize(call.proof);
+        });
+    if (bytes > kCacheBytes) {
+      return;
+    }
+    auto shared = std::make_shared<const Response>(response);
+    std::lock_guard lock{cache_mutex_};
+    if (index_.count(key) != 0) {
+      return;
+    }
+    while (bytes_ + bytes > kCacheBytes) {
+      auto &last = entries_.back();
+      bytes_ -= last.bytes;
+      index_.erase(last.key);
+      entries_.pop_back();
+    }
+    entries_.push_front(Entry{key, std::move(shared), bytes});
+    index_.emplace(key, entries_.begin());
+    bytes_ += bytes;
+  }
+
+  outcome::result<LightProtocolObserverImpl::Response>
+  LightProtocolObserverImpl::respond(const LightRequest &request) const {
+    return visit_in_place(
+        request.request,
+        [this](const RemoteReadRequest &read) { return respondRead(read); },
+        [this](const RemoteHeaderRequest &header) {
+          return respondHeader(header);
+        },
+        [this](const RemoteCallRequest &call) { return respondCall(call); });
+  }
+
+  outcome::result<LightProtocolObserverImpl::Response>
+  LightProtocolObserverImpl::respondRead(
+      const RemoteReadRequest &request) const {
+    if (request.keys.size() > kMaxRequestKeys) {
+      return Error::TOO_MANY_KEYS;
+    }
+    OUTCOME_TRY(header, blocks_headers_->getBlockHeader(request.block));
+    OUTCOME_TRY(proof,
+                trie_storage_->getProofAt(header.state_root, request.keys));
+    return RemoteReadResponse{std::move(proof)};
+  }
+
+  outcome::result<LightProtocolObserverImpl::Response>
+  LightProtocolObserverImpl::respondHeader(
+      const RemoteHeaderRequest &request) const {
+    auto header_res = blocks_headers_->getBlockHeader(request.block);
+    if (not header_res) {
+      log_->debug("Light client requested unknown block #{}: {}",
+                  request.block,
+                  header_res.error().message());
+      return RemoteHeaderResponse{boost::none};
+    }
+    return RemoteHeaderResponse{std::move(header_res.value())};
+  }
+
+  outcome::result<LightProtocolObserverImpl::Response>
+  LightProtocolObserverImpl::respondCall(
+      const RemoteCallRequest &request) const {
+    OUTCOME_TRY(header, blocks_headers_->getBlockHeader(request.block));
+    std::vector<common::Buffer> accessed_keys;
+    OUTCOME_TRY(result,
+                raw_call_->callAt(header.state_root,
+                                  request.method,
+                                  request.data,
+                                  accessed_keys));
+    // the client executes the same code, which is proved along with the
+    // values the call reads
+    if (std::find(
+            accessed_keys.begin(), accessed_keys.end(), runtime::kRuntimeKey)
+        == accessed_keys.end()) {
+      accessed_keys.push_back(runtime::kRuntimeKey);
+    }
+    OUTCOME_TRY(proof,
+                trie_storage_->getProofAt(header.state_root, accessed_keys));
+    return RemoteCallResponse{std::move(result), std::move(proof)};
+  }
+
+}  // namespace kagome::network
@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_LIGHT_PROTOCOL_OBSERVER_IMPL_HPP
+#define KAGOME_CORE_NETWORK_IMPL_LIGHT_PROTOCOL_OBSERVER_IMPL_HPP
+
+#include "network/light_protocol_observer.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/optional.hpp>
+
+#include "blockchain/block_header_repository.hpp"
+#include "common/flat_hash_map.hpp"
+#include "common/logger.hpp"
+#include "crypto/hasher.hpp"
+#include "network/impl/storage_read_executor.hpp"
+#include "runtime/raw_call.hpp"
+#include "storage/trie/trie_storage.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Serves the light client requests. The proofs of the reads and of the
+   * calls are recorded by the trie storage, which reads the nodes on the
+   * paths to the keys, so they are kept by the requests in a cache of the
+   * recent ones, as the light clients ask for the same values of the recent
+   * blocks, such as the balances and the validator sets. The states of the
+   * blocks never change, so a kept proof is never stale
+   */
+  class LightProtocolObserverImpl
+      : public LightProtocolObserver,
+        public std::enable_shared_from_this<LightProtocolObserverImpl> {
+   public:
+    /// how much keys are proved at once
+    static constexpr size_t kMaxRequestKeys = 1024u;
+    /// max total size of the responses kept
+    static constexpr size_t kCacheBytes = 16u * 1024 * 1024;
+
+    enum class Error { TOO_MANY_KEYS = 1, TOO_MANY_REQUESTS };
+
+    /**
+     * @param executor reads the storage and calls the runtime for the
+     * requests handled asynchronously, which are answered on \arg
+     * io_context; if none, they are handled on the thread of the call
+     */
+    LightProtocolObserverImpl(
+        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+        std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+        std::shared_ptr<runtime::RawCall> raw_call,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<StorageReadExecutor> executor = nullptr,
+        std::shared_ptr<boost::asio::io_context> io_context = nullptr);
+
+    ~LightProtocolObserverImpl() override = default;
+
+    outcome::result<LightResponse> onLightRequest(
+        const LightRequest &request) const override;
+
+    void onLightRequest(const LightRequest &request,
+                        ResponseHandler handler) const override;
+
+    /// @return total size of the responses kept
+    size_t cachedBytes() const;
+
+   private:
+    using Response = decltype(LightResponse::response);
+    using Key = common::Hash256;
+
+    struct Entry {
+      Key key;
+      std::shared_ptr<const Response> response;
+      size_t bytes;
+    };
+
+    /// @return key of the response of \arg request, none if not kept
+    boost::optional<Key> cacheKey(const LightRequest &request) const;
+
+    boost::optional<LightResponse> cached(const LightRequest &request,
+                                          const boost::optional<Key> &key) const;
+
+    void keep(const Key &key, const Response &response) const;
+
+    /// @return response made from the storage and the runtime
+    outcome::result<Response> respond(const LightRequest &request) const;
+
+    outcome::result<Response> respondRead(
+        const RemoteReadRequest &request) const;
+
+    outcome::result<Response> respondHeader(
+        const RemoteHeaderRequest &request) const;
+
+    outcome::result<Response> respondCall(
+        const RemoteCallRequest &request) const;
+
+    std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers_;
+    std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
+    std::shared_ptr<runtime::RawCall> raw_call_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<StorageReadExecutor> executor_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    /// the responses are made on the threads of the executor
+    mutable std::mutex cache_mutex_;
+    // the most recently used entries first
+    mutable std::list<Entry> entries_;
+    mutable common::FlatHashMap<Key, std::list<Entry>::iterator> index_;
+    mutable size_t bytes_ = 0;
+    common::Logger log_;
+  };
+
+}  // namespace kagome::network
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::network, LightProtocolObserverImpl::Error);
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_LIGHT_PROTOCOL_OBSERVER_IMPL_HPP
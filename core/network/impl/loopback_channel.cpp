@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/loopback_channel.hpp"
+
+#include <boost/asio/post.hpp>
+
+namespace kagome::network {
+
+  LoopbackChannel::LoopbackChannel(
+      std::shared_ptr<boost::asio::io_context> io_context)
+      : io_context_{std::move(io_context)} {
+    BOOST_ASSERT(io_context_ != nullptr);
+  }
+
+  void LoopbackChannel::setHandler(Handler handler) {
+    handler_ = std::make_shared<const Handler>(std::move(handler));
+  }
+
+  bool LoopbackChannel::isBound() const {
+    return handler_ != nullptr;
+  }
+
+  void LoopbackChannel::send(std::shared_ptr<const Message> message) const {
+    if (handler_ == nullptr) {
+      return;
+    }
+    boost::asio::post(*io_context_,
+                      [handler = handler_, message = std::move(message)] {
+                        (*handler)(message);
+                      });
+  }
+
+}  // namespace kagome::network
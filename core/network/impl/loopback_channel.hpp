@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_LOOPBACK_CHANNEL_HPP
+#define KAGOME_CORE_NETWORK_IMPL_LOOPBACK_CHANNEL_HPP
+
+#include <functional>
+#include <memory>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/variant.hpp>
+
+#include "consensus/grandpa/structs.hpp"
+#include "network/types/block_announce.hpp"
+
+namespace kagome::network {
+
+  /**
+   * In-process channel of the gossip messages of this node to its own
+   * observers, which takes the place of the loopback stream: a message is
+   * passed as it is, shared and immutable, instead of being encoded, copied
+   * through the stream and decoded again. The messages are delivered on the
+   * io context, so that the observers are not reentered by their own
+   * messages
+   */
+  class LoopbackChannel {
+   public:
+    using Message = boost::variant<BlockAnnounce,
+                                   consensus::grandpa::VoteMessage,
+                                   consensus::grandpa::Fin>;
+    using Handler = std::function<void(const std::shared_ptr<const Message> &)>;
+
+    explicit LoopbackChannel(
+        std::shared_ptr<boost::asio::io_context> io_context);
+
+    /// Makes \arg handler receive the messages, it is set once by the router
+    void setHandler(Handler handler);
+
+    /// @return true if the messages are received by a handler
+    bool isBound() const;
+
+    /// Delivers \arg message to the handler, if any
+    void send(std::shared_ptr<const Message> message) const;
+
+   private:
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    std::shared_ptr<const Handler> handler_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_LOOPBACK_CHANNEL_HPP
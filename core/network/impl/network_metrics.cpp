@@ -0,0 +1,179 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/network_metrics.hpp"
+
+namespace kagome::network {
+
+  void NetworkMetrics::recordReceived(std::string_view protocol,
+                                      std::string_view type,
+                                      size_t bytes) {
+    std::lock_guard lock{mutex_};
+    auto &traffic = codec(protocol, type).received;
+    traffic.messages++;
+    traffic.bytes += bytes;
+  }
+
+  void NetworkMetrics::recordSent(std::string_view protocol,
+                                  std::string_view type,
+                                  size_t bytes) {
+    std::lock_guard lock{mutex_};
+    auto &traffic = codec(protocol, type).sent;
+    traffic.messages++;
+    traffic.bytes += bytes;
+  }
+
+  void NetworkMetrics::recordDecoding(std::string_view protocol,
+                                      std::string_view type,
+                                      Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    codec(protocol, type).decoding.add(duration);
+  }
+
+  void NetworkMetrics::recordEncoding(std::string_view protocol,
+                                      std::string_view type,
+                                      Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    codec(protocol, type).encoding.add(duration);
+  }
+
+  void NetworkMetrics::recordQueue(std::string_view peer,
+                                   size_t messages,
+                                   size_t bytes) {
+    std::lock_guard lock{mutex_};
+    auto it = queues_.find(peer);
+    if (messages == 0) {
+      if (it != queues_.end()) {
+        queues_.erase(it);
+      }
+      return;
+    }
+    if (it == queues_.end()) {
+      it = queues_.emplace(std::string(peer), QueueStats{}).first;
+    }
+    it->second.messages = messages;
+    it->second.bytes = bytes;
+  }
+
+  void NetworkMetrics::recordRoundTrip(std::string_view name,
+                                       Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    auto it = round_trips_.find(name);
+    if (it == round_trips_.end()) {
+      it = round_trips_.emplace(std::string(name), common::DurationHistogram{})
+               .first;
+    }
+    it->second.add(duration);
+  }
+
+  NetworkMetrics::Report NetworkMetrics::report() const {
+    Report report;
+    std::lock_guard lock{mutex_};
+    for (auto &[protocol, types] : codecs_) {
+      auto &messages = report.messages[protocol];
+      for (auto &[type, stats] : types) {
+        messages.emplace(type,
+                         MessageStats{stats.received,
+                                      stats.sent,
+                                      stats.decoding.stats(),
+                                      stats.encoding.stats()});
+      }
+    }
+    report.queues.insert(queues_.begin(), queues_.end());
+    for (auto &[name, histogram] : round_trips_) {
+      report.round_trips.emplace(name, histogram.stats());
+    }
+    return report;
+  }
+
+  void NetworkMetrics::collect(
+      common::MetricsRegistry::Writer &writer) const {
+    using Type = common::MetricsRegistry::Type;
+    using Labels = common::MetricsRegistry::Labels;
+    auto report = this->report();
+    auto each_message = [&](auto &&write) {
+      for (auto &[protocol, types] : report.messages) {
+        for (auto &[message, stats] : types) {
+          write(Labels{{"protocol", protocol}, {"type", message}}, stats);
+        }
+      }
+    };
+    // the samples of a family are written together, after its description
+    auto counter = [&](const char *name, const char *help, auto &&value) {
+      writer.family(name, Type::COUNTER, help);
+      each_message([&](const Labels &labels, const MessageStats &stats) {
+        writer.sample(name, labels, value(stats));
+      });
+    };
+    auto durations = [&](const char *name, const char *help, auto &&value) {
+      writer.family(name, Type::SUMMARY, help);
+      each_message([&](const Labels &labels, const MessageStats &stats) {
+        writer.durations(name, labels, value(stats));
+      });
+    };
+    counter("kagome_network_received_messages_total",
+            "Messages received",
+            [](auto &stats) { return stats.received.messages; });
+    counter("kagome_network_received_bytes_total",
+            "Bytes of the messages received",
+            [](auto &stats) { return stats.received.bytes; });
+    counter("kagome_network_sent_messages_total",
+            "Messages sent",
+            [](auto &stats) { return stats.sent.messages; });
+    counter("kagome_network_sent_bytes_total",
+            "Bytes of the messages sent",
+            [](auto &stats) { return stats.sent.bytes; });
+    durations("kagome_network_decoding_seconds",
+              "Time the messages take to be decoded",
+              [](auto &stats) { return stats.decoding; });
+    durations("kagome_network_encoding_seconds",
+              "Time the messages take to be encoded",
+              [](auto &stats) { return stats.encoding; });
+
+    // the queues are summed up, so that the peers don't make the labels
+    QueueStats queued;
+    for (auto &[peer, queue] : report.queues) {
+      queued.messages += queue.messages;
+      queued.bytes += queue.bytes;
+    }
+    writer.family("kagome_network_queued_messages",
+                  Type::GAUGE,
+                  "Messages waiting to be sent to the peers");
+    writer.sample("kagome_network_queued_messages", {}, queued.messages);
+    writer.family("kagome_network_queued_bytes",
+                  Type::GAUGE,
+                  "Bytes of the messages waiting to be sent to the peers");
+    writer.sample("kagome_network_queued_bytes", {}, queued.bytes);
+
+    writer.family("kagome_network_round_trip_seconds",
+                  Type::SUMMARY,
+                  "Time from a request to a peer to its response");
+    for (auto &[name, stats] : report.round_trips) {
+      writer.durations(
+          "kagome_network_round_trip_seconds", {{"request", name}}, stats);
+    }
+  }
+
+  void NetworkMetrics::reset() {
+    std::lock_guard lock{mutex_};
+    codecs_.clear();
+    round_trips_.clear();
+  }
+
+  NetworkMetrics::Codec &NetworkMetrics::codec(std::string_view protocol,
+                                               std::string_view type) {
+    auto protocol_it = codecs_.find(protocol);
+    if (protocol_it == codecs_.end()) {
+      protocol_it = codecs_.emplace(std::string(protocol), Codecs{}).first;
+    }
+    auto &types = protocol_it->second;
+    auto it = types.find(type);
+    if (it == types.end()) {
+      it = types.emplace(std::string(type), Codec{}).first;
+    }
+    return it->second;
+  }
+
+}  // namespace kagome::network
@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/peer_manager_impl.hpp"
+
+#include <limits>
+
+namespace kagome::network {
+
+  PeerManagerImpl::PeerManagerImpl(std::shared_ptr<clock::SteadyClock> clock)
+      : clock_{std::move(clock)},
+        logger_{common::createLogger("PeerManager")} {
+    BOOST_ASSERT(clock_ != nullptr);
+  }
+
+  void PeerManagerImpl::reportResponse(
+      const PeerId &peer,
+      size_t blocks,
+      std::chrono::steady_clock::duration elapsed) {
+    auto latency_ms =
+        std::chrono::duration<double, std::milli>(elapsed).count();
+    auto blocks_per_sec = blocks * 1000. / std::max(latency_ms, 1.);
+    std::lock_guard lock{mutex_};
+    auto [it, inserted] = stats_.emplace(peer, PeerStats{});
+    auto &stats = it->second;
+    if (inserted or stats.blocks_per_sec == 0) {
+      stats.latency_ms = latency_ms;
+      stats.blocks_per_sec = blocks_per_sec;
+    } else {
+      stats.latency_ms += kWeight * (latency_ms - stats.latency_ms);
+      stats.blocks_per_sec +=
+          kWeight * (blocks_per_sec - stats.blocks_per_sec);
+    }
+    stats.failures = 0;
+    logger_->debug(
+        "Peer {} latency {:.0f} ms, throughput {:.0f} blocks/s",
+        peer.toBase58(),
+        stats.latency_ms,
+        stats.blocks_per_sec);
+  }
+
+  void PeerManagerImpl::reportFailure(const PeerId &peer) {
+    std::lock_guard lock{mutex_};
+    ++stats_[peer].failures;
+  }
+
+  void PeerManagerImpl::reportInvalidBlock(const PeerId &peer) {
+    std::lock_guard lock{mutex_};
+    auto &stats = stats_[peer];
+    if (banned(stats)) {
+      return;
+    }
+    if (++stats.invalid_blocks >= kBanThreshold) {
+      stats.banned_until = clock_->now() + kBanDuration;
+      logger_->warn("Peer {} is banned for sending {} invalid blocks",
+                    peer.toBase58(),
+                    stats.invalid_blocks);
+    }
+  }
+
+  double PeerManagerImpl::score(const PeerId &peer) const {
+    std::lock_guard lock{mutex_};
+    auto it = stats_.find(peer);
+    if (it == stats_.end()) {
+      return std::numeric_limits<double>::infinity();
+    }
+    auto &stats = it->second;
+    if (banned(stats)) {
+      return 0;
+    }
+    if (stats.blocks_per_sec == 0 and stats.failures == 0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return stats.blocks_per_sec
+           / ((1 + stats.failures) * (1 + stats.invalid_blocks));
+  }
+
+  bool PeerManagerImpl::isBanned(const PeerId &peer) const {
+    std::lock_guard lock{mutex_};
+    auto it = stats_.find(peer);
+    return it != stats_.end() and banned(it->second);
+  }
+
+  bool PeerManagerImpl::banned(PeerStats &stats) const {
+    if (not stats.banned_until) {
+      return false;
+    }
+    if (clock_->now() < *stats.banned_until) {
+      return true;
+    }
+    // the peer starts over, as it may have been restarted with a fix
+    stats = PeerStats{};
+    return false;
+  }
+
+}  // namespace kagome::network
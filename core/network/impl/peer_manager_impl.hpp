@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_PEER_MANAGER_IMPL_HPP
+#define KAGOME_CORE_NETWORK_IMPL_PEER_MANAGER_IMPL_HPP
+
+#include "network/peer_manager.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "clock/clock.hpp"
+#include "common/logger.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Scores a peer by the moving average of its throughput, divided by the
+   * number of its requests failed in a row and of the invalid blocks it sent.
+   * A peer, which sent several invalid blocks, is banned for a while and
+   * starts over after that
+   */
+  class PeerManagerImpl : public PeerManager {
+   public:
+    /// weight of the latest response in the moving averages
+    static constexpr double kWeight = 0.25;
+
+    /// number of the invalid blocks a peer is banned for
+    static constexpr size_t kBanThreshold = 3;
+
+    /// how long a peer is banned
+    static constexpr std::chrono::hours kBanDuration{1};
+
+    explicit PeerManagerImpl(std::shared_ptr<clock::SteadyClock> clock);
+
+    ~PeerManagerImpl() override = default;
+
+    void reportResponse(
+        const PeerId &peer,
+        size_t blocks,
+        std::chrono::steady_clock::duration elapsed) override;
+
+    void reportFailure(const PeerId &peer) override;
+
+    void reportInvalidBlock(const PeerId &peer) override;
+
+    double score(const PeerId &peer) const override;
+
+    bool isBanned(const PeerId &peer) const override;
+
+   private:
+    struct PeerStats {
+      double latency_ms = 0;
+      double blocks_per_sec = 0;
+      // failed requests since the last successful one
+      size_t failures = 0;
+      // invalid blocks since the peer was banned last time
+      size_t invalid_blocks = 0;
+      boost::optional<clock::SteadyClock::TimePoint> banned_until;
+    };
+
+    /// @return true if \arg stats are of a banned peer, lifting an expired
+    /// ban
+    bool banned(PeerStats &stats) const;
+
+    std::shared_ptr<clock::SteadyClock> clock_;
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<PeerId, PeerStats> stats_;
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_PEER_MANAGER_IMPL_HPP
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_RATE_LIMITER_HPP
+#define KAGOME_CORE_NETWORK_IMPL_RATE_LIMITER_HPP
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include <boost/assert.hpp>
+
+#include "clock/clock.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Limits the rate of the requests of each peer with a token bucket: a
+   * request takes a token, and the tokens are refilled at a constant rate up
+   * to the burst. Not thread-safe
+   * @tparam Key identifies a peer
+   */
+  template <typename Key>
+  class RateLimiter {
+   public:
+    /// number of the peers, over which the ones with the full buckets are
+    /// forgotten
+    static constexpr size_t kMaxPeers = 1024;
+
+    /**
+     * @param per_second number of the tokens refilled each second
+     * @param burst number of the tokens a bucket holds
+     */
+    RateLimiter(std::shared_ptr<clock::SteadyClock> clock,
+                double per_second,
+                double burst)
+        : clock_{std::move(clock)}, per_second_{per_second}, burst_{burst} {
+      BOOST_ASSERT(clock_ != nullptr);
+      BOOST_ASSERT(per_second_ > 0);
+      BOOST_ASSERT(burst_ >= 1);
+    }
+
+    /// @return true if a request of \arg peer is allowed, taking a token
+    bool allow(const Key &peer) {
+      auto now = clock_->now();
+      if (buckets_.size() >= kMaxPeers) {
+        forgetIdle(now);
+      }
+      auto [it, inserted] = buckets_.emplace(peer, Bucket{burst_, now});
+      auto &bucket = it->second;
+      refill(bucket, now);
+      if (bucket.tokens < 1) {
+        return false;
+      }
+      bucket.tokens -= 1;
+      return true;
+    }
+
+   private:
+    struct Bucket {
+      double tokens;
+      clock::SteadyClock::TimePoint refilled_at;
+    };
+
+    void refill(Bucket &bucket, clock::SteadyClock::TimePoint now) const {
+      std::chrono::duration<double> elapsed = now - bucket.refilled_at;
+      bucket.tokens =
+          std::min(burst_, bucket.tokens + elapsed.count() * per_second_);
+      bucket.refilled_at = now;
+    }
+
+    /// Forgets the peers, which buckets are full, as the new ones
+    void forgetIdle(clock::SteadyClock::TimePoint now) {
+      for (auto it = buckets_.begin(); it != buckets_.end();) {
+        refill(it->second, now);
+        if (it->second.tokens >= burst_) {
+          it = buckets_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    std::shared_ptr<clock::SteadyClock> clock_;
+    double per_second_;
+    double burst_;
+    std::unordered_map<Key, Bucket> buckets_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_RATE_LIMITER_HPP
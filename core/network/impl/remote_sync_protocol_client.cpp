@@ -12,11 +12,35 @@
 
 namespace kagome::network {
   RemoteSyncProtocolClient::RemoteSyncProtocolClient(
-      libp2p::Host &host, libp2p::peer::PeerInfo peer_info)
+      libp2p::Host &host,
+      libp2p::peer::PeerInfo peer_info,
+      std::shared_ptr<NetworkMetrics> metrics)
       : host_{host},
         peer_info_{std::move(peer_info)},
+        metrics_{std::move(metrics)},
         log_(common::createLogger("RemoteSyncProtocolClient")) {}
 
+  template <typename Response>
+  std::function<void(outcome::result<Response>)>
+  RemoteSyncProtocolClient::timed(
+      std::string_view name,
+      std::function<void(outcome::result<Response>)> cb) const {
+    if (metrics_ == nullptr) {
+      return cb;
+    }
+    // only the answered requests are recorded, as the failed ones may take
+    // any time up to the timeouts of the connection
+    return [metrics = metrics_,
+            name,
+            start = NetworkMetrics::Clock::now(),
+            cb = std::move(cb)](outcome::result<Response> res) {
+      if (res) {
+        metrics->recordRoundTrip(name, NetworkMetrics::Clock::now() - start);
+      }
+      cb(std::move(res));
+    };
+  }
+
   void RemoteSyncProtocolClient::requestBlocks(
       const network::BlocksRequest &request,
       std::function<void(outcome::result<network::BlocksResponse>)> cb) {
@@ -34,8 +58,70 @@ namespace kagome::network {
                         request.to->toHex());
           }
         });
+    if (not compression_supported_) {
+      return requestBlocksUncompressed(request, std::move(cb));
+    }
+    // the peers, which don't speak the compressed protocol, don't accept
+    // its streams, so the request is written again over the uncompressed
+    // one
+    auto fallback = [weak{weak_from_this()}, request, cb](
+                        outcome::result<network::BlocksResponse> res) mutable {
+      auto self = weak.lock();
+      if (res or self == nullptr) {
+        return cb(std::move(res));
+      }
+      self->log_->debug("Compressed blocks request failed: {}",
+                        res.error().message());
+      self->requestBlocksUncompressed(
+          request,
+          [weak, cb{std::move(cb)}](
+              outcome::result<network::BlocksResponse> res) {
+            if (auto self = weak.lock(); self != nullptr and res) {
+              self->compression_supported_ = false;
+            }
+            cb(std::move(res));
+          });
+    };
+    network::RPC<network::CompressedScaleMessageReadWriter>::
+        write<network::BlocksRequest, network::BlocksResponse>(
+            host_,
+            peer_info_,
+            network::kCompressedSyncProtocol,
+            request,
+            timed<network::BlocksResponse>("requestBlocks",
+                                           std::move(fallback)),
+            metrics_);
+  }
+
+  void RemoteSyncProtocolClient::requestBlocksUncompressed(
+      const network::BlocksRequest &request,
+      std::function<void(outcome::result<network::BlocksResponse>)> cb) {
     network::RPC<network::ScaleMessageReadWriter>::
         write<network::BlocksRequest, network::BlocksResponse>(
-            host_, peer_info_, network::kSyncProtocol, request, std::move(cb));
+            host_,
+            peer_info_,
+            network::kSyncProtocol,
+            request,
+            timed<network::BlocksResponse>("requestBlocks", std::move(cb)),
+            metrics_);
+  }
+
+  void RemoteSyncProtocolClient::requestState(
+      const network::StateRequest &request,
+      std::function<void(outcome::result<network::StateResponse>)> cb) {
+    log_->debug("Requesting {} state nodes", request.keys.size());
+    network::RPC<network::ScaleMessageReadWriter>::
+        write<network::StateRequest, network::StateResponse>(
+            host_,
+            peer_info_,
+            network::kStateProtocol,
+            request,
+            timed<network::StateResponse>("requestState", std::move(cb)),
+            metrics_);
+  }
+
+  boost::optional<libp2p::peer::PeerId> RemoteSyncProtocolClient::peerId()
+      const {
+    return peer_info_.id;
   }
 }  // namespace kagome::network
@@ -8,10 +8,13 @@
 
 #include "network/sync_protocol_client.hpp"
 
+#include <atomic>
+
 #include <libp2p/host/host.hpp>
 #include <libp2p/peer/peer_info.hpp>
 
 #include "common/logger.hpp"
+#include "network/network_metrics.hpp"
 
 namespace kagome::network {
 
@@ -19,17 +22,50 @@ namespace kagome::network {
       : public network::SyncProtocolClient,
         public std::enable_shared_from_this<RemoteSyncProtocolClient> {
    public:
+    /**
+     * @param metrics records the requests, their responses and round trips,
+     * if any
+     */
     RemoteSyncProtocolClient(libp2p::Host &host,
-                             libp2p::peer::PeerInfo peer_info);
+                             libp2p::peer::PeerInfo peer_info,
+                             std::shared_ptr<NetworkMetrics> metrics = nullptr);
 
     void requestBlocks(
         const network::BlocksRequest &request,
         std::function<void(outcome::result<network::BlocksResponse>)> cb)
         override;
 
+    void requestState(
+        const network::StateRequest &request,
+        std::function<void(outcome::result<network::StateResponse>)> cb)
+        override;
+
+    boost::optional<libp2p::peer::PeerId> peerId() const override;
+
    private:
+    /**
+     * @return \arg cb, which records the round trip of request \arg name
+     * started now, when it is called
+     */
+    template <typename Response>
+    std::function<void(outcome::result<Response>)> timed(
+        std::string_view name,
+        std::function<void(outcome::result<Response>)> cb) const;
+
+    /**
+     * Requests blocks over the sync protocol, which messages are not
+     * compressed, as the peer does not speak the compressed one
+     */
+    void requestBlocksUncompressed(
+        const network::BlocksRequest &request,
+        std::function<void(outcome::result<network::BlocksResponse>)> cb);
+
     libp2p::Host &host_;
     const libp2p::peer::PeerInfo peer_info_;
+    /// the compressed sync protocol is tried, until the peer answers over
+    /// the uncompressed one after failing to over it
+    std::atomic_bool compression_supported_{true};
+    std::shared_ptr<NetworkMetrics> metrics_;
     common::Logger log_;
   };
 }  // namespace kagome::network
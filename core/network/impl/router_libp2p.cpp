@@ -22,14 +22,29 @@ namespace kagome::network {
       std::shared_ptr<SyncProtocolObserver> sync_observer,
       std::shared_ptr<ExtrinsicObserver> extrinsic_observer,
       std::shared_ptr<Gossiper> gossiper,
+      std::shared_ptr<crypto::Hasher> hasher,
+      std::shared_ptr<clock::SteadyClock> clock,
       const PeerList &peer_list,
-      const OwnPeerInfo &own_peer_info)
+      const OwnPeerInfo &own_peer_info,
+      std::shared_ptr<NetworkMetrics> metrics,
+      std::shared_ptr<GrandpaNeighbors> neighbors,
+      std::shared_ptr<LoopbackChannel> loopback,
+      std::shared_ptr<LightProtocolObserver> light_observer)
       : host_{host},
         babe_observer_{std::move(babe_observer)},
         grandpa_observer_{std::move(grandpa_observer)},
         sync_observer_{std::move(sync_observer)},
         extrinsic_observer_{std::move(extrinsic_observer)},
         gossiper_{std::move(gossiper)},
+        hasher_{std::move(hasher)},
+        metrics_{std::move(metrics)},
+        neighbors_{std::move(neighbors)},
+        loopback_{std::move(loopback)},
+        light_observer_{std::move(light_observer)},
+        gossip_cache_{std::make_unique<GossipCache>(
+            clock, kGossipCacheCapacity, kGossipCacheTtl)},
+        sync_limiter_{std::make_unique<RateLimiter<libp2p::peer::PeerId>>(
+            std::move(clock), kSyncRequestsPerSecond, kSyncRequestsBurst)},
         log_{common::createLogger("RouterLibp2p")} {
     BOOST_ASSERT_MSG(babe_observer_ != nullptr, "babe observer is nullptr");
     BOOST_ASSERT_MSG(grandpa_observer_ != nullptr,
@@ -38,6 +53,7 @@ namespace kagome::network {
     BOOST_ASSERT_MSG(extrinsic_observer_ != nullptr,
                      "author api observer is nullptr");
     BOOST_ASSERT_MSG(gossiper_ != nullptr, "gossiper is nullptr");
+    BOOST_ASSERT_MSG(hasher_ != nullptr, "hasher is nullptr");
     BOOST_ASSERT_MSG(!peer_list.peers.empty(), "peer list is empty");
 
     for (const auto &peer_info : peer_list.peers) {
@@ -56,13 +72,39 @@ namespace kagome::network {
         kSyncProtocol, [self{shared_from_this()}](auto &&stream) {
           self->handleSyncProtocol(std::forward<decltype(stream)>(stream));
         });
+    host_.setProtocolHandler(
+        kCompressedSyncProtocol, [self{shared_from_this()}](auto &&stream) {
+          if (self->allowSyncRequest(stream)) {
+            self->serveBlocksRequest<CompressedScaleMessageReadWriter>(
+                stream, kCompressedSyncProtocol);
+          }
+        });
+    host_.setProtocolHandler(
+        kStateProtocol, [self{shared_from_this()}](auto &&stream) {
+          self->handleStateProtocol(std::forward<decltype(stream)>(stream));
+        });
+    if (light_observer_ != nullptr) {
+      host_.setProtocolHandler(
+          kLightProtocol, [self{shared_from_this()}](auto &&stream) {
+            self->handleLightProtocol(std::forward<decltype(stream)>(stream));
+          });
+    }
     host_.setProtocolHandler(
         kGossipProtocol, [self{shared_from_this()}](auto &&stream) {
           self->handleGossipProtocol(std::forward<decltype(stream)>(stream));
         });
+    // the loopback stream is still read, as the messages the loopback
+    // channel does not pass are written to it
     if (auto stream = loopback_stream_.lock()) {
       readGossipMessage(std::move(stream));
     }
+    if (loopback_ != nullptr) {
+      loopback_->setHandler([weak{weak_from_this()}](const auto &msg) {
+        if (auto self = weak.lock()) {
+          self->processLoopbackMessage(*msg);
+        }
+      });
+    }
     host_.start();
     const auto &host_addresses = host_.getAddresses();
     BOOST_ASSERT_MSG(not host_addresses.empty(), "Host addresses empty");
@@ -73,9 +115,21 @@ namespace kagome::network {
 
   void RouterLibp2p::handleSyncProtocol(
       const std::shared_ptr<Stream> &stream) const {
-    RPC<ScaleMessageReadWriter>::read<BlocksRequest, BlocksResponse>(
+    if (not allowSyncRequest(stream)) {
+      return;
+    }
+    serveBlocksRequest<ScaleMessageReadWriter>(stream, kSyncProtocol);
+  }
+
+  template <typename MessageReadWriter>
+  void RouterLibp2p::serveBlocksRequest(
+      const std::shared_ptr<Stream> &stream,
+      const libp2p::peer::Protocol &protocol) const {
+    // the storage is read off this thread, which processes the consensus
+    // messages, and the response is written back on it
+    RPC<MessageReadWriter>::template readAsync<BlocksRequest, BlocksResponse>(
         stream,
-        [self{shared_from_this()}, stream](auto &&request) {
+        [self{shared_from_this()}, stream](auto &&request, auto &&respond) {
           // std::bind didn't work :(
           std::string from = visit_in_place(
               request.from,
@@ -88,9 +142,9 @@ namespace kagome::network {
               " to {}",
               stream->remotePeerId().value().toBase58(),
               from,
-              request.to->toHex());
-          return self->sync_observer_->onBlocksRequest(
-              std::forward<decltype(request)>(request));
+              request.to ? request.to->toHex() : "unspecified");
+          self->sync_observer_->onBlocksRequest(
+              request, std::forward<decltype(respond)>(respond));
         },
         [self{shared_from_this()}, stream](auto &&err) {
           self->log_->error(
@@ -98,7 +152,71 @@ namespace kagome::network {
               "protocol: {}",
               err.error().message());
           stream->reset();
-        });
+        },
+        metrics_,
+        protocol);
+  }
+
+  void RouterLibp2p::handleStateProtocol(
+      const std::shared_ptr<Stream> &stream) const {
+    if (not allowSyncRequest(stream)) {
+      return;
+    }
+    RPC<ScaleMessageReadWriter>::readAsync<StateRequest, StateResponse>(
+        stream,
+        [self{shared_from_this()}, stream](auto &&request, auto &&respond) {
+          self->log_->debug("Received request from peer {} for {} state nodes",
+                            stream->remotePeerId().value().toBase58(),
+                            request.keys.size());
+          self->sync_observer_->onStateRequest(
+              request, std::forward<decltype(respond)>(respond));
+        },
+        [self{shared_from_this()}, stream](auto &&err) {
+          self->log_->error(
+              "error happened while processing request/response over State "
+              "protocol: {}",
+              err.error().message());
+          stream->reset();
+        },
+        metrics_,
+        kStateProtocol);
+  }
+
+  void RouterLibp2p::handleLightProtocol(
+      const std::shared_ptr<Stream> &stream) const {
+    if (not allowSyncRequest(stream)) {
+      return;
+    }
+    RPC<ScaleMessageReadWriter>::readAsync<LightRequest, LightResponse>(
+        stream,
+        [self{shared_from_this()}, stream](auto &&request, auto &&respond) {
+          self->log_->debug("Received light request {} from peer {}",
+                            request.id,
+                            stream->remotePeerId().value().toBase58());
+          self->light_observer_->onLightRequest(
+              request, std::forward<decltype(respond)>(respond));
+        },
+        [self{shared_from_this()}, stream](auto &&err) {
+          self->log_->error(
+              "error happened while processing request/response over Light "
+              "protocol: {}",
+              err.error().message());
+          stream->reset();
+        },
+        metrics_,
+        kLightProtocol);
+  }
+
+  bool RouterLibp2p::allowSyncRequest(
+      const std::shared_ptr<Stream> &stream) const {
+    auto peer_res = stream->remotePeerId();
+    if (not peer_res or sync_limiter_->allow(peer_res.value())) {
+      return true;
+    }
+    log_->warn("Peer {} is over the rate of sync requests, rejected",
+               peer_res.value().toBase58());
+    stream->reset();
+    return false;
   }
 
   void RouterLibp2p::handleGossipProtocol(
@@ -118,7 +236,7 @@ namespace kagome::network {
             return stream->reset();
           }
 
-          if (!self->processGossipMessage(msg_res.value())) {
+          if (!self->processGossipMessage(msg_res.value(), *stream)) {
             stream->reset();
             return;
           }
@@ -126,32 +244,108 @@ namespace kagome::network {
         });
   }
 
-  bool RouterLibp2p::processGossipMessage(const GossipMessage &msg) const {
+  bool RouterLibp2p::processGossipMessage(const GossipMessage &msg,
+                                          Stream &stream) const {
+    // the same message comes from many peers, so it is dropped before being
+    // decoded and dispatched again
+    auto encoded = scale::encode(msg).value();
+    if (metrics_ != nullptr) {
+      metrics_->recordReceived(
+          kGossipProtocol, toString(msg.type), encoded.size());
+    }
+    auto hash = hasher_->blake2b_256(encoded);
+    if (gossip_cache_->isKnown(hash)) {
+      log_->trace("Dropped a gossip message received already");
+      return true;
+    }
+    return processNewGossipMessage(msg, hash, stream);
+  }
+
+  void RouterLibp2p::processLoopbackMessage(
+      const LoopbackChannel::Message &msg) const {
+    visit_in_place(
+        msg,
+        [this](const BlockAnnounce &announce) {
+          babe_observer_->onBlockAnnounce(announce);
+        },
+        [this](const consensus::grandpa::VoteMessage &vote) {
+          grandpa_observer_->onOwnVoteMessage(vote);
+        },
+        [this](const consensus::grandpa::Fin &fin) {
+          grandpa_observer_->onFinalize(fin);
+        });
+  }
+
+  template <typename T>
+  outcome::result<T> RouterLibp2p::decodeGossip(
+      const GossipMessage &msg) const {
+    auto start = NetworkMetrics::Clock::now();
+    auto res = scale::decode<T>(msg.data);
+    if (metrics_ != nullptr) {
+      metrics_->recordDecoding(kGossipProtocol,
+                               toString(msg.type),
+                               NetworkMetrics::Clock::now() - start);
+    }
+    return res;
+  }
+
+  bool RouterLibp2p::processNewGossipMessage(const GossipMessage &msg,
+                                             const common::Hash256 &hash,
+                                             Stream &stream) const {
     using MsgType = GossipMessage::Type;
+    using Topic = GossipCache::Topic;
 
     switch (msg.type) {
       case MsgType::BLOCK_ANNOUNCE: {
-        auto msg_res = scale::decode<BlockAnnounce>(msg.data);
+        auto msg_res = decodeGossip<BlockAnnounce>(msg);
         if (!msg_res) {
           log_->error("error while decoding a block announce message: {}",
                       msg_res.error().message());
           return false;
         }
-        log_->info("Received block announce: block number {}",
-                   msg_res.value().header.number);
+        // the numbers are not verified yet, so an announce of a wrong one
+        // only makes the earlier ones forgotten, and is not dropped
+        auto number = msg_res.value().header.number;
+        gossip_cache_->insert(hash, Topic::BLOCK_NUMBER, number);
+        if (number > kAnnouncesDepth) {
+          gossip_cache_->expireBelow(Topic::BLOCK_NUMBER,
+                                     number - kAnnouncesDepth);
+        }
+        log_->info("Received block announce: block number {}", number);
         babe_observer_->onBlockAnnounce(msg_res.value());
         return true;
       }
       case MsgType::CONSENSUS: {
+        // the messages of the rounds before the previous one are forgotten
+        auto remember = [&](consensus::grandpa::RoundNumber round) {
+          gossip_cache_->insert(hash, Topic::GRANDPA_ROUND, round);
+          if (round > 1) {
+            gossip_cache_->expireBelow(Topic::GRANDPA_ROUND, round - 1);
+          }
+        };
+
+        // both the votes and the fins start with their rounds, so the ones
+        // of the rounds this node is not in are dropped before being decoded
+        if (auto round =
+                scale::decode<consensus::grandpa::RoundNumber>(msg.data);
+            round and neighbors_ != nullptr
+            and not neighbors_->isRoundUseful(round.value())) {
+          log_->trace("Dropped a consensus message of grandpa round {}",
+                      round.value());
+          return true;
+        }
+
         auto vote_msg_res =
-            scale::decode<consensus::grandpa::VoteMessage>(msg.data);
+            decodeGossip<consensus::grandpa::VoteMessage>(msg);
         if (vote_msg_res) {
+          remember(vote_msg_res.value().round_number);
           grandpa_observer_->onVoteMessage(vote_msg_res.value());
           return true;
         }
 
-        auto fin_msg_res = scale::decode<consensus::grandpa::Fin>(msg.data);
+        auto fin_msg_res = decodeGossip<consensus::grandpa::Fin>(msg);
         if (fin_msg_res) {
+          remember(fin_msg_res.value().round_number);
           grandpa_observer_->onFinalize(fin_msg_res.value());
           return true;
         }
@@ -159,25 +353,57 @@ namespace kagome::network {
         log_->error("error while decoding a consensus message");
         return false;
       }
+      case MsgType::CATCH_UP: {
+        auto catch_up_msg_res =
+            decodeGossip<consensus::grandpa::CatchUpMessage>(msg);
+        if (not catch_up_msg_res) {
+          log_->error("error while decoding a catch-up message: {}",
+                      catch_up_msg_res.error().message());
+          return false;
+        }
+        // the same neighbor packet comes from the peers in the same round, so
+        // it is not remembered, as it tells of its sender; the rest are few
+        // and are about the latest rounds, so they are kept until the cache
+        // evicts them
+        if (auto packet = boost::get<consensus::grandpa::NeighborPacket>(
+                &catch_up_msg_res.value())) {
+          if (auto peer = stream.remotePeerId();
+              peer and neighbors_ != nullptr) {
+            neighbors_->update(peer.value(), *packet);
+          }
+        } else {
+          gossip_cache_->insert(hash);
+        }
+        grandpa_observer_->onCatchUpMessage(catch_up_msg_res.value());
+        return true;
+      }
       case MsgType::TRANSACTIONS: {
         auto txs_msg_res =
-            scale::decode<std::vector<primitives::Extrinsic>>(msg.data);
+            decodeGossip<std::vector<primitives::Extrinsic>>(msg);
 
         if (not txs_msg_res) {
           log_->error("error while decoding a transactions message");
           return false;
         }
 
+        gossip_cache_->insert(hash);
         log_->info("Received tx announce: {} txs", txs_msg_res.value().size());
 
-        for (auto &extrinsic : txs_msg_res.value()) {
-          auto result = extrinsic_observer_->onTxMessage(extrinsic);
+        std::vector<common::Hash256> received;
+        for (auto &result :
+             extrinsic_observer_->onTxMessages(txs_msg_res.value())) {
           if (result) {
             log_->debug("  Received tx {}", result.value());
+            received.push_back(result.value());
           } else {
             log_->debug("  Rejected tx: {}", result.error().message());
           }
         }
+        // the accepted ones are queued to be gossiped later on this thread,
+        // so the sender is known to have them before they are sent
+        if (auto peer = stream.remotePeerId(); peer and not received.empty()) {
+          gossiper_->transactionsReceived(peer.value(), received);
+        }
         return true;
       }
       case GossipMessage::Type::STATUS: {
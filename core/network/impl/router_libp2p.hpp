@@ -8,8 +8,10 @@
 
 #include <memory>
 
+#include "clock/clock.hpp"
 #include "common/logger.hpp"
 #include "consensus/grandpa/round_observer.hpp"
+#include "crypto/hasher.hpp"
 #include "libp2p/connection/stream.hpp"
 #include "libp2p/host/host.hpp"
 #include "libp2p/peer/peer_info.hpp"
@@ -17,8 +19,14 @@
 #include "network/babe_observer.hpp"
 #include "network/extrinsic_observer.hpp"
 #include "network/gossiper.hpp"
+#include "network/light_protocol_observer.hpp"
 #include "network/helpers/scale_message_read_writer.hpp"
+#include "network/impl/gossip_cache.hpp"
+#include "network/impl/grandpa_neighbors.hpp"
+#include "network/impl/loopback_channel.hpp"
+#include "network/impl/rate_limiter.hpp"
 #include "network/impl/loopback_stream.hpp"
+#include "network/network_metrics.hpp"
 #include "network/router.hpp"
 #include "network/sync_protocol_observer.hpp"
 #include "network/types/gossip_message.hpp"
@@ -29,6 +37,35 @@ namespace kagome::network {
   class RouterLibp2p : public Router,
                        public std::enable_shared_from_this<RouterLibp2p> {
    public:
+    /// number of the received gossip messages remembered to be dropped when
+    /// received again
+    static constexpr size_t kGossipCacheCapacity = 16384;
+
+    /// how long a received gossip message is remembered
+    static constexpr std::chrono::minutes kGossipCacheTtl{2};
+
+    /// number of the blocks below the most recently announced one, which
+    /// announces are still remembered
+    static constexpr uint64_t kAnnouncesDepth = 64;
+
+    /// rate of the sync and state requests served to a peer, the ones over
+    /// it are rejected, so that many syncing peers do not overload the node
+    static constexpr double kSyncRequestsPerSecond = 10;
+
+    /// number of the sync and state requests of a peer served at once
+    static constexpr double kSyncRequestsBurst = 40;
+
+    /**
+     * @param metrics records the received messages and the served requests,
+     * if any
+     * @param neighbors is told the neighbor packets of the peers and tells
+     * the GRANDPA messages, which are too far from the round of this node to
+     * be decoded, if any
+     * @param loopback passes the messages of this node to its observers as
+     * they are, instead of the loopback stream, if any
+     * @param light_observer serves the light client protocol, which is not
+     * served if none
+     */
     RouterLibp2p(
         libp2p::Host &host,
         std::shared_ptr<BabeObserver> babe_observer,
@@ -36,8 +73,14 @@ namespace kagome::network {
         std::shared_ptr<SyncProtocolObserver> sync_observer,
         std::shared_ptr<ExtrinsicObserver> extrinsic_observer,
         std::shared_ptr<Gossiper> gossiper,
+        std::shared_ptr<crypto::Hasher> hasher,
+        std::shared_ptr<clock::SteadyClock> clock,
         const PeerList &peer_list,
-        const OwnPeerInfo &own_info);
+        const OwnPeerInfo &own_info,
+        std::shared_ptr<NetworkMetrics> metrics = nullptr,
+        std::shared_ptr<GrandpaNeighbors> neighbors = nullptr,
+        std::shared_ptr<LoopbackChannel> loopback = nullptr,
+        std::shared_ptr<LightProtocolObserver> light_observer = nullptr);
 
     ~RouterLibp2p() override = default;
 
@@ -46,15 +89,54 @@ namespace kagome::network {
     void handleSyncProtocol(
         const std::shared_ptr<Stream> &stream) const override;
 
+    void handleStateProtocol(
+        const std::shared_ptr<Stream> &stream) const override;
+
     void handleGossipProtocol(std::shared_ptr<Stream> stream) const override;
 
+    /// Serves a light client request from \arg stream
+    void handleLightProtocol(const std::shared_ptr<Stream> &stream) const;
+
    private:
+    /**
+     * Serves a blocks request from \arg stream of \arg protocol, which
+     * messages are read and written by MessageReadWriter
+     */
+    template <typename MessageReadWriter>
+    void serveBlocksRequest(const std::shared_ptr<Stream> &stream,
+                            const libp2p::peer::Protocol &protocol) const;
+
     void readGossipMessage(std::shared_ptr<Stream> stream) const;
 
     /**
-     * Process a received gossip message
+     * Process a gossip message received from \arg stream, unless it was
+     * received already
+     */
+    bool processGossipMessage(const GossipMessage &msg, Stream &stream) const;
+
+    /**
+     * Process a gossip message, which was not received yet
+     * @param hash of the message, to be remembered as received
+     */
+    bool processNewGossipMessage(const GossipMessage &msg,
+                                 const common::Hash256 &hash,
+                                 Stream &stream) const;
+
+    /**
+     * Decodes the payload of gossip message \arg msg, recording the time it
+     * takes
+     */
+    template <typename T>
+    outcome::result<T> decodeGossip(const GossipMessage &msg) const;
+
+    /// Dispatches \arg msg of this node, received by the loopback channel
+    void processLoopbackMessage(const LoopbackChannel::Message &msg) const;
+
+    /**
+     * @return true if a sync or state request from \arg stream is within the
+     * rate limit of its peer, otherwise the stream is reset
      */
-    bool processGossipMessage(const GossipMessage &msg) const;
+    bool allowSyncRequest(const std::shared_ptr<Stream> &stream) const;
 
     libp2p::Host &host_;
     std::shared_ptr<BabeObserver> babe_observer_;
@@ -62,6 +144,15 @@ namespace kagome::network {
     std::shared_ptr<SyncProtocolObserver> sync_observer_;
     std::shared_ptr<ExtrinsicObserver> extrinsic_observer_;
     std::shared_ptr<Gossiper> gossiper_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    std::shared_ptr<NetworkMetrics> metrics_;
+    std::shared_ptr<GrandpaNeighbors> neighbors_;
+    std::shared_ptr<LoopbackChannel> loopback_;
+    std::shared_ptr<LightProtocolObserver> light_observer_;
+    /// the gossip messages are received on a single thread
+    std::unique_ptr<GossipCache> gossip_cache_;
+    /// the requests are received on a single thread
+    std::unique_ptr<RateLimiter<libp2p::peer::PeerId>> sync_limiter_;
     std::weak_ptr<network::LoopbackStream> loopback_stream_;
     common::Logger log_;
   };
@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/storage_read_executor.hpp"
+
+#include <algorithm>
+
+namespace kagome::network {
+
+  StorageReadExecutor::StorageReadExecutor(
+      std::shared_ptr<application::AppStateManager> app_state_manager,
+      size_t threads_num) {
+    threads_num = std::max<size_t>(threads_num, 1);
+    threads_.reserve(threads_num);
+    for (size_t i = 0; i < threads_num; ++i) {
+      threads_.emplace_back([this] { work(); });
+    }
+    if (app_state_manager != nullptr) {
+      app_state_manager->atShutdown([this] { stop(); });
+    }
+  }
+
+  StorageReadExecutor::~StorageReadExecutor() {
+    stop();
+  }
+
+  bool StorageReadExecutor::post(Task task) {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_ or queue_.size() >= kMaxQueuedTasks) {
+        return false;
+      }
+      queue_.push_back(std::move(task));
+    }
+    queue_cv_.notify_one();
+    return true;
+  }
+
+  void StorageReadExecutor::stop() {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+      queue_.clear();
+    }
+    queue_cv_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void StorageReadExecutor::work() {
+    while (true) {
+      Task task;
+      {
+        std::unique_lock lock{mutex_};
+        queue_cv_.wait(lock, [this] { return stopped_ or not queue_.empty(); });
+        if (stopped_) {
+          return;
+        }
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+}  // namespace kagome::network
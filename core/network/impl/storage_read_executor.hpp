@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_IMPL_STORAGE_READ_EXECUTOR_HPP
+#define KAGOME_CORE_NETWORK_IMPL_STORAGE_READ_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "application/app_state_manager.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Runs the tasks reading the storage to serve the requests of the peers,
+   * such as the sync ones, on the threads of its own, so that the network
+   * thread, which processes the consensus messages, does not wait for the
+   * storage. The queue of the tasks is bounded, a task over it is rejected
+   */
+  class StorageReadExecutor {
+   public:
+    using Task = std::function<void()>;
+
+    /// default number of the threads the tasks are run on
+    static constexpr size_t kThreads = 2;
+
+    /// number of the tasks waiting to be run
+    static constexpr size_t kMaxQueuedTasks = 64;
+
+    /**
+     * @param app_state_manager stops the executor at shutdown, if any
+     * @param threads_num number of the threads the tasks are run on, one at
+     * least
+     */
+    explicit StorageReadExecutor(
+        std::shared_ptr<application::AppStateManager> app_state_manager,
+        size_t threads_num = kThreads);
+
+    ~StorageReadExecutor();
+
+    /**
+     * Schedules \arg task to be run on one of the threads of the executor
+     * @return false if the queue is full or the executor is stopped, the
+     * task is not run then
+     */
+    bool post(Task task);
+
+    /**
+     * Drops the tasks which are not started yet and waits for the running
+     * ones, nothing is run after that
+     */
+    void stop();
+
+   private:
+    void work();
+
+    std::mutex mutex_;
+    std::condition_variable queue_cv_;
+    std::deque<Task> queue_;
+    bool stopped_ = false;
+    std::vector<std::thread> threads_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_IMPL_STORAGE_READ_EXECUTOR_HPP
@@ -5,9 +5,11 @@
 
 #include "network/impl/sync_protocol_observer_impl.hpp"
 
+#include <boost/asio/post.hpp>
 #include <boost/assert.hpp>
 
 #include "network/common.hpp"
+#include "scale/scale.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
                             SyncProtocolObserverImpl::Error,
@@ -16,37 +18,141 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::network,
   switch (e) {
     case E::DUPLICATE_REQUEST_ID:
       return "Request with a same id is handling right now";
+    case E::TOO_MANY_REQUESTS:
+      return "Too many requests are being served, the request is dropped";
   }
   return "unknown error";
 }
 
 namespace kagome::network {
+  namespace {
+    /// Upper bound of the size of the encoded \arg data, without encoding it
+    size_t encodedSize(const primitives::BlockData &data) {
+      // the compact length of a collection takes up to 5 bytes
+      constexpr size_t kMaxLengthSize = 5;
+      size_t size = data.hash.size() + kMaxLengthSize;
+      if (data.header) {
+        size += scale::encode(*data.header).value().size();
+      }
+      if (data.body) {
+        for (const auto &extrinsic : *data.body) {
+          size += extrinsic.data.size() + kMaxLengthSize;
+        }
+      }
+      if (data.justification) {
+        size += data.justification->data.size() + kMaxLengthSize;
+      }
+      return size;
+    }
+  }  // namespace
 
   SyncProtocolObserverImpl::SyncProtocolObserverImpl(
       std::shared_ptr<blockchain::BlockTree> block_tree,
-      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers)
+      std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+      std::shared_ptr<blockchain::BlockStorage> block_storage,
+      std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes,
+      std::shared_ptr<StorageReadExecutor> executor,
+      std::shared_ptr<boost::asio::io_context> io_context)
       : block_tree_{std::move(block_tree)},
         blocks_headers_{std::move(blocks_headers)},
+        block_storage_{std::move(block_storage)},
+        trie_nodes_{std::move(trie_nodes)},
+        executor_{std::move(executor)},
+        io_context_{std::move(io_context)},
         log_(common::createLogger("SyncProtocolObserver")) {
     BOOST_ASSERT(block_tree_);
     BOOST_ASSERT(blocks_headers_);
+    BOOST_ASSERT(executor_ == nullptr or io_context_ != nullptr);
   }
 
   outcome::result<network::BlocksResponse>
   SyncProtocolObserverImpl::onBlocksRequest(
       const BlocksRequest &request) const {
-    if (!requested_ids_.emplace(request.id).second) {
+    if (not registerRequest(request.id)) {
       return Error::DUPLICATE_REQUEST_ID;
     }
 
     BlocksResponse response{request.id};
+    fillBlocksResponse(request, response, requestedHashes(request));
+    if (not response.blocks.empty()) {
+      log_->debug("Return response: {}", response.blocks[0].hash.toHex());
+    }
+
+    unregisterRequest(request.id);
+    return response;
+  }
+
+  void SyncProtocolObserverImpl::onBlocksRequest(
+      const BlocksRequest &request,
+      ResponseHandler<BlocksResponse> handler) const {
+    if (executor_ == nullptr) {
+      return handler(onBlocksRequest(request));
+    }
+    if (not registerRequest(request.id)) {
+      return handler(Error::DUPLICATE_REQUEST_ID);
+    }
 
+    // the chain is found in the block tree, which is changed on this thread,
+    // and only the storage is read on the executor
+    auto posted = executor_->post(
+        [self{shared_from_this()},
+         request,
+         hashes{requestedHashes(request)},
+         handler]() mutable {
+          BlocksResponse response{request.id};
+          self->fillBlocksResponse(request, response, hashes);
+          self->unregisterRequest(request.id);
+          boost::asio::post(*self->io_context_,
+                            [handler{std::move(handler)},
+                             response{std::move(response)}]() mutable {
+                              handler(std::move(response));
+                            });
+        });
+    if (not posted) {
+      unregisterRequest(request.id);
+      handler(Error::TOO_MANY_REQUESTS);
+    }
+  }
+
+  void SyncProtocolObserverImpl::onStateRequest(
+      const StateRequest &request,
+      ResponseHandler<StateResponse> handler) const {
+    if (executor_ == nullptr) {
+      return handler(onStateRequest(request));
+    }
+    auto posted = executor_->post(
+        [self{shared_from_this()}, request, handler]() mutable {
+          auto response_res = self->onStateRequest(request);
+          boost::asio::post(*self->io_context_,
+                            [handler{std::move(handler)},
+                             response_res{std::move(response_res)}]() mutable {
+                              handler(std::move(response_res));
+                            });
+        });
+    if (not posted) {
+      handler(Error::TOO_MANY_REQUESTS);
+    }
+  }
+
+  bool SyncProtocolObserverImpl::registerRequest(
+      primitives::BlocksRequestId id) const {
+    std::lock_guard lock{requested_ids_mutex_};
+    return requested_ids_.emplace(id).second;
+  }
+
+  void SyncProtocolObserverImpl::unregisterRequest(
+      primitives::BlocksRequestId id) const {
+    std::lock_guard lock{requested_ids_mutex_};
+    requested_ids_.erase(id);
+  }
+
+  std::vector<primitives::BlockHash> SyncProtocolObserverImpl::requestedHashes(
+      const BlocksRequest &request) const {
     // firstly, check if we have both "from" & "to" blocks (if set)
     auto from_hash_res = blocks_headers_->getHashById(request.from);
     if (!from_hash_res) {
       log_->warn("cannot find a requested block with id {}", request.from);
-      requested_ids_.erase(request.id);
-      return response;
+      return {};
     }
 
     // secondly, retrieve hashes of blocks the other peer is interested in
@@ -55,17 +161,30 @@ namespace kagome::network {
     if (!chain_hash_res) {
       log_->warn("cannot retrieve a chain of blocks: {}",
                  chain_hash_res.error().message());
-      requested_ids_.erase(request.id);
-      return response;
+      return {};
     }
+    return std::move(chain_hash_res.value());
+  }
 
-    // thirdly, fill the resulting response with data, which we were asked for
-    fillBlocksResponse(request, response, chain_hash_res.value());
-    if (not response.blocks.empty()) {
-      log_->debug("Return response: {}", response.blocks[0].hash.toHex());
+  outcome::result<network::StateResponse>
+  SyncProtocolObserverImpl::onStateRequest(const StateRequest &request) const {
+    StateResponse response;
+    if (trie_nodes_ == nullptr) {
+      return response;
+    }
+    // the nodes are answered up to the first one which is not in the storage
+    auto count = request.keys.size() < maxRequestNodes ? request.keys.size()
+                                                       : maxRequestNodes;
+    response.nodes.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+      auto node_res = trie_nodes_->get(request.keys[i]);
+      if (not node_res) {
+        log_->warn("cannot find a requested state node: {}",
+                   node_res.error().message());
+        break;
+      }
+      response.nodes.push_back(std::move(node_res.value()));
     }
-
-    requested_ids_.erase(request.id);
     return response;
   }
 
@@ -75,11 +194,14 @@ namespace kagome::network {
       const primitives::BlockHash &from_hash) const {
     auto ascending_direction =
         request.direction == network::Direction::ASCENDING;
+    auto max_blocks = request.max
+                          ? std::min<size_t>(*request.max, maxRequestBlocks)
+                          : maxRequestBlocks;
     blockchain::BlockTree::BlockHashVecRes chain_hash_res{{}};
     if (!request.to) {
       // if there's no "stop" block, get as many as possible
       chain_hash_res = block_tree_->getChainByBlock(
-          from_hash, ascending_direction, maxRequestBlocks);
+          from_hash, ascending_direction, max_blocks);
     } else {
       // else, both blocks are specified
       OUTCOME_TRY(chain_hash,
@@ -87,6 +209,10 @@ namespace kagome::network {
       if (ascending_direction) {
         std::reverse(chain_hash.begin(), chain_hash.end());
       }
+      // the blocks are served from the first one in the direction
+      if (chain_hash.size() > max_blocks) {
+        chain_hash.resize(max_blocks);
+      }
       chain_hash_res = chain_hash;
     }
     return chain_hash_res;
@@ -103,28 +229,123 @@ namespace kagome::network {
     auto justification_needed =
         request.attributeIsSet(network::BlockAttributesBits::JUSTIFICATION);
 
-    for (const auto &hash : hash_chain) {
-      auto &new_block =
-          response.blocks.emplace_back(primitives::BlockData{hash});
+    // the blocks are added up to the size of a response, so the ones, which
+    // are not sent, are not read
+    size_t response_bytes = 0;
+    auto add_block = [&](primitives::BlockData &&block_data) {
+      response_bytes += encodedSize(block_data);
+      response.blocks.push_back(std::move(block_data));
+      return response_bytes < maxResponseBytes;
+    };
 
-      if (header_needed) {
-        auto header_res = blocks_headers_->getBlockHeader(hash);
-        if (header_res) {
-          new_block.header = std::move(header_res.value());
+    // bodies and justifications are read in batches, and the headers, which
+    // are kept in the data too, are taken from there
+    size_t served = 0;
+    if (block_storage_ and (body_needed or justification_needed)) {
+      gsl::span<const primitives::BlockHash> hashes{hash_chain};
+      while (served < hash_chain.size()) {
+        auto batch = hashes.subspan(
+            served, std::min(blocksReadBatch, hash_chain.size() - served));
+        auto blocks_data_res = readBlocksData(request, batch);
+        if (not blocks_data_res or blocks_data_res.value().empty()) {
+          if (not blocks_data_res) {
+            log_->warn("cannot read the data of the requested blocks: {}",
+                       blocks_data_res.error().message());
+          }
+          break;
         }
-      }
-      if (body_needed) {
-        auto body_res = block_tree_->getBlockBody(hash);
-        if (body_res) {
-          new_block.body = std::move(body_res.value());
+        for (auto &block_data : blocks_data_res.value()) {
+          primitives::BlockData new_block{block_data.hash};
+          if (header_needed) {
+            if (block_data.header) {
+              new_block.header = std::move(block_data.header);
+            } else if (auto header_res =
+                           blocks_headers_->getBlockHeader(block_data.hash)) {
+              new_block.header = std::move(header_res.value());
+            }
+          }
+          if (body_needed) {
+            // the response ends at a pruned body, so that the peer asks
+            // the rest of the chain from a node which keeps it
+            if (not block_data.body) {
+              return;
+            }
+            new_block.body = std::move(block_data.body);
+          }
+          if (justification_needed) {
+            new_block.justification = std::move(block_data.justification);
+          }
+          ++served;
+          if (not add_block(std::move(new_block))) {
+            return;
+          }
         }
       }
-      if (justification_needed) {
-        auto justification_res = block_tree_->getBlockJustification(hash);
-        if (justification_res) {
-          new_block.justification = std::move(justification_res.value());
-        }
+    }
+
+    // the blocks, which are not read in batches, are read one by one
+    for (; served < hash_chain.size(); ++served) {
+      primitives::BlockData new_block{hash_chain[served]};
+      readBlockData(request, new_block);
+      if (body_needed and not new_block.body) {
+        return;
       }
+      if (not add_block(std::move(new_block))) {
+        return;
+      }
+    }
+  }
+
+  void SyncProtocolObserverImpl::readBlockData(
+      const BlocksRequest &request, primitives::BlockData &new_block) const {
+    const auto &hash = new_block.hash;
+    if (request.attributeIsSet(network::BlockAttributesBits::HEADER)) {
+      auto header_res = blocks_headers_->getBlockHeader(hash);
+      if (header_res) {
+        new_block.header = std::move(header_res.value());
+      }
+    }
+    if (request.attributeIsSet(network::BlockAttributesBits::BODY)) {
+      auto body_res = block_tree_->getBlockBody(hash);
+      if (body_res) {
+        new_block.body = std::move(body_res.value());
+      }
+    }
+    if (request.attributeIsSet(network::BlockAttributesBits::JUSTIFICATION)) {
+      auto justification_res = block_tree_->getBlockJustification(hash);
+      if (justification_res) {
+        new_block.justification = std::move(justification_res.value());
+      }
+    }
+  }
+
+  outcome::result<std::vector<primitives::BlockData>>
+  SyncProtocolObserverImpl::readBlocksData(
+      const BlocksRequest &request,
+      gsl::span<const primitives::BlockHash> hash_chain) const {
+    // the blocks of a chain have consecutive numbers, and the storage finds
+    // a block anyway if its number is wrong
+    OUTCOME_TRY(first_number,
+                blocks_headers_->getNumberByHash(hash_chain[0]));
+    auto ascending_direction =
+        request.direction == network::Direction::ASCENDING;
+    std::vector<primitives::BlockInfo> blocks;
+    blocks.reserve(hash_chain.size());
+    for (size_t i = 0; i < hash_chain.size(); ++i) {
+      // ascending direction is from a child to its parent
+      auto number = ascending_direction
+                        ? first_number - std::min<uint64_t>(first_number, i)
+                        : first_number + i;
+      blocks.emplace_back(number, hash_chain[i]);
+    }
+    // the storage is read sequentially in the order of the numbers
+    if (ascending_direction) {
+      std::reverse(blocks.begin(), blocks.end());
+    }
+    OUTCOME_TRY(blocks_data, block_storage_->getBlockDataRange(blocks));
+    if (ascending_direction) {
+      std::reverse(blocks_data.begin(), blocks_data.end());
     }
+    return std::move(blocks_data);
   }
 }  // namespace kagome::network
@@ -8,14 +8,21 @@
 
 #include "network/sync_protocol_observer.hpp"
 
+#include <mutex>
+#include <unordered_set>
+
+#include <boost/asio/io_context.hpp>
 #include <libp2p/host/host.hpp>
 #include <libp2p/peer/peer_info.hpp>
 
 #include "blockchain/block_header_repository.hpp"
+#include "blockchain/block_storage.hpp"
 #include "blockchain/block_tree.hpp"
 #include "common/logger.hpp"
+#include "network/impl/storage_read_executor.hpp"
 #include "network/types/own_peer_info.hpp"
 #include "primitives/common.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
 
 namespace kagome::network {
 
@@ -24,31 +31,93 @@ namespace kagome::network {
         public std::enable_shared_from_this<SyncProtocolObserverImpl> {
    public:
     /// how much blocks we can send at once
-    static const size_t maxRequestBlocks = 128u;
-
-    enum class Error { DUPLICATE_REQUEST_ID = 1 };
-
+    static constexpr size_t maxRequestBlocks = 128u;
+    /// how much state nodes we can send at once
+    static constexpr size_t maxRequestNodes = 1024u;
+    /// the blocks are added to a response up to this size, at least one
+    static constexpr size_t maxResponseBytes = 16u * 1024 * 1024;
+    /// how much blocks are read from the block storage at once, so that the
+    /// ones over the size of a response are not read
+    static constexpr size_t blocksReadBatch = 16u;
+
+    enum class Error { DUPLICATE_REQUEST_ID = 1, TOO_MANY_REQUESTS };
+
+    /**
+     * @param block_storage reads the bodies and justifications of the
+     * requested blocks at once, if any
+     * @param trie_nodes storage of the state nodes, which are served to the
+     * peers downloading the state, if any
+     * @param executor reads the storage for the requests handled
+     * asynchronously, which are answered on \arg io_context; if none, they
+     * are handled on the thread of the call
+     */
     SyncProtocolObserverImpl(
         std::shared_ptr<blockchain::BlockTree> block_tree,
-        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers);
+        std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers,
+        std::shared_ptr<blockchain::BlockStorage> block_storage = nullptr,
+        std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes =
+            nullptr,
+        std::shared_ptr<StorageReadExecutor> executor = nullptr,
+        std::shared_ptr<boost::asio::io_context> io_context = nullptr);
 
     ~SyncProtocolObserverImpl() override = default;
 
     outcome::result<BlocksResponse> onBlocksRequest(
         const BlocksRequest &request) const override;
 
+    outcome::result<StateResponse> onStateRequest(
+        const StateRequest &request) const override;
+
+    void onBlocksRequest(
+        const BlocksRequest &request,
+        ResponseHandler<BlocksResponse> handler) const override;
+
+    void onStateRequest(const StateRequest &request,
+                        ResponseHandler<StateResponse> handler) const override;
+
    private:
+    /// @return false if the request of \arg id is being served already
+    bool registerRequest(primitives::BlocksRequestId id) const;
+
+    void unregisterRequest(primitives::BlocksRequestId id) const;
+
+    /// @return hashes of the blocks of \arg request, empty if not found
+    std::vector<primitives::BlockHash> requestedHashes(
+        const network::BlocksRequest &request) const;
+
     blockchain::BlockTree::BlockHashVecRes retrieveRequestedHashes(
         const network::BlocksRequest &request,
         const primitives::BlockHash &from_hash) const;
 
+    /**
+     * Fills \arg response with the data of the blocks of \arg hash_chain,
+     * until its size is over maxResponseBytes
+     */
     void fillBlocksResponse(
         const network::BlocksRequest &request,
         network::BlocksResponse &response,
         const std::vector<primitives::BlockHash> &hash_chain) const;
 
+    /**
+     * @return data of the blocks of \arg hash_chain in the direction of
+     * \arg request, read from the block storage at once
+     */
+    outcome::result<std::vector<primitives::BlockData>> readBlocksData(
+        const network::BlocksRequest &request,
+        gsl::span<const primitives::BlockHash> hash_chain) const;
+
+    /// Fills \arg new_block with the requested data of the block of its hash
+    void readBlockData(const network::BlocksRequest &request,
+                       primitives::BlockData &new_block) const;
+
     std::shared_ptr<blockchain::BlockTree> block_tree_;
     std::shared_ptr<blockchain::BlockHeaderRepository> blocks_headers_;
+    std::shared_ptr<blockchain::BlockStorage> block_storage_;
+    std::shared_ptr<storage::trie::TrieStorageBackend> trie_nodes_;
+    std::shared_ptr<StorageReadExecutor> executor_;
+    std::shared_ptr<boost::asio::io_context> io_context_;
+    /// the requests are served on the threads of the executor
+    mutable std::mutex requested_ids_mutex_;
     mutable std::unordered_set<primitives::BlocksRequestId> requested_ids_;
     common::Logger log_;
   };
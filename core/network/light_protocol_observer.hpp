@@ -0,0 +1,49 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_LIGHT_PROTOCOL_OBSERVER_HPP
+#define KAGOME_CORE_NETWORK_LIGHT_PROTOCOL_OBSERVER_HPP
+
+#include <functional>
+
+#include <outcome/outcome.hpp>
+
+#include "network/types/light_request.hpp"
+#include "network/types/light_response.hpp"
+
+namespace kagome::network {
+
+  /**
+   * Reactive part of the light client protocol, which serves the headers,
+   * the values of the state and the results of the runtime calls along with
+   * their proofs
+   */
+  struct LightProtocolObserver {
+    using ResponseHandler = std::function<void(outcome::result<LightResponse>)>;
+
+    virtual ~LightProtocolObserver() = default;
+
+    /**
+     * Process a light client request
+     * @return response of the same id or error
+     */
+    virtual outcome::result<LightResponse> onLightRequest(
+        const LightRequest &request) const = 0;
+
+    /**
+     * Process a light client request, possibly reading the storage and
+     * calling the runtime on another thread
+     * @param handler is called with the response or error on the thread of
+     * the call, possibly later
+     */
+    virtual void onLightRequest(const LightRequest &request,
+                                ResponseHandler handler) const {
+      handler(onLightRequest(request));
+    }
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_LIGHT_PROTOCOL_OBSERVER_HPP
@@ -0,0 +1,152 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_NETWORK_METRICS_HPP
+#define KAGOME_CORE_NETWORK_NETWORK_METRICS_HPP
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include <boost/core/demangle.hpp>
+
+#include "common/duration_histogram.hpp"
+#include "common/metrics_registry.hpp"
+
+namespace kagome::network {
+
+  /**
+   * @return name of message type \tparam T without its namespaces, under
+   * which the messages of the type are recorded
+   */
+  template <typename T>
+  const std::string &messageTypeName() {
+    static const std::string name = [] {
+      auto name = boost::core::demangle(typeid(T).name());
+      auto pos = name.rfind("::");
+      return pos == std::string::npos ? name : name.substr(pos + 2);
+    }();
+    return name;
+  }
+
+  /**
+   * Collects the traffic of the node by the protocols and the types of the
+   * messages along with the time they take to be encoded and decoded, the
+   * depths of the outbound queues of the peers, and the round trips of the
+   * requests to them. Thread-safe
+   */
+  class NetworkMetrics {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using DurationStats = common::DurationHistogram::Stats;
+
+    struct Traffic {
+      uint64_t messages = 0;
+      uint64_t bytes = 0;
+    };
+
+    struct MessageStats {
+      Traffic received;
+      Traffic sent;
+      DurationStats decoding;
+      DurationStats encoding;
+    };
+
+    struct QueueStats {
+      uint64_t messages = 0;
+      uint64_t bytes = 0;
+    };
+
+    struct Report {
+      // by the protocols, then by the types of the messages
+      std::map<std::string, std::map<std::string, MessageStats>> messages;
+      // by the peers, only the queues not empty
+      std::map<std::string, QueueStats> queues;
+      // by the names of the requests
+      std::map<std::string, DurationStats> round_trips;
+    };
+
+    /**
+     * Records a message of \arg type, \arg bytes long, received over
+     * \arg protocol
+     */
+    void recordReceived(std::string_view protocol,
+                        std::string_view type,
+                        size_t bytes);
+
+    /**
+     * Records a message of \arg type, \arg bytes long, sent over
+     * \arg protocol
+     */
+    void recordSent(std::string_view protocol,
+                    std::string_view type,
+                    size_t bytes);
+
+    /**
+     * Records the time a message of \arg type of \arg protocol took to be
+     * decoded
+     */
+    void recordDecoding(std::string_view protocol,
+                        std::string_view type,
+                        Clock::duration duration);
+
+    /**
+     * Records the time a message of \arg type of \arg protocol took to be
+     * encoded, once for a message sent to several peers
+     */
+    void recordEncoding(std::string_view protocol,
+                        std::string_view type,
+                        Clock::duration duration);
+
+    /**
+     * Records the messages waiting to be sent to \arg peer, the queue is
+     * forgotten once it is empty
+     */
+    void recordQueue(std::string_view peer, size_t messages, size_t bytes);
+
+    /**
+     * Records the time a request of \arg name took from being sent to its
+     * response being received
+     */
+    void recordRoundTrip(std::string_view name, Clock::duration duration);
+
+    Report report() const;
+
+    /**
+     * Writes the report to \arg writer, on the scrapes of Prometheus
+     */
+    void collect(common::MetricsRegistry::Writer &writer) const;
+
+    /**
+     * Forgets everything collected so far, but the depths of the queues
+     */
+    void reset();
+
+   private:
+    struct Codec {
+      Traffic received;
+      Traffic sent;
+      common::DurationHistogram decoding;
+      common::DurationHistogram encoding;
+    };
+
+    /// by the types of the messages
+    using Codecs = std::map<std::string, Codec, std::less<>>;
+
+    Codec &codec(std::string_view protocol, std::string_view type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Codecs, std::less<>> codecs_;
+    std::map<std::string, QueueStats, std::less<>> queues_;
+    std::map<std::string, common::DurationHistogram, std::less<>>
+        round_trips_;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_NETWORK_METRICS_HPP
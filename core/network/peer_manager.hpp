@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_PEER_MANAGER_HPP
+#define KAGOME_CORE_NETWORK_PEER_MANAGER_HPP
+
+#include <chrono>
+
+#include <libp2p/peer/peer_id.hpp>
+
+namespace kagome::network {
+
+  /**
+   * Keeps the reputation of the peers by the way they serve the requests and
+   * by the data they send, so that the faster and the honest peers are
+   * preferred, while the ones sending the invalid blocks are banned
+   */
+  class PeerManager {
+   public:
+    using PeerId = libp2p::peer::PeerId;
+
+    virtual ~PeerManager() = default;
+
+    /**
+     * Reports that \arg peer returned \arg blocks in response to a request
+     * in \arg elapsed time
+     */
+    virtual void reportResponse(
+        const PeerId &peer,
+        size_t blocks,
+        std::chrono::steady_clock::duration elapsed) = 0;
+
+    /**
+     * Reports that a request to \arg peer failed or was answered with the
+     * data not requested
+     */
+    virtual void reportFailure(const PeerId &peer) = 0;
+
+    /**
+     * Reports that \arg peer sent a block, which is invalid
+     */
+    virtual void reportInvalidBlock(const PeerId &peer) = 0;
+
+    /**
+     * @return score of \arg peer, the higher the better, infinity if it is
+     * not measured yet, so that it is tried first, and 0 if it is banned
+     */
+    virtual double score(const PeerId &peer) const = 0;
+
+    /**
+     * @return true if \arg peer is not asked and not sent anything
+     */
+    virtual bool isBanned(const PeerId &peer) const = 0;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_PEER_MANAGER_HPP
@@ -32,6 +32,13 @@ namespace kagome::network {
     virtual void handleSyncProtocol(
         const std::shared_ptr<Stream> &stream) const = 0;
 
+    /**
+     * Handle stream, which is opened over a State protocol
+     * @param stream to be handled
+     */
+    virtual void handleStateProtocol(
+        const std::shared_ptr<Stream> &stream) const = 0;
+
     /**
      * Handle stream, which is opened over a Gossip protocol
      * @param stream to be handled
@@ -15,6 +15,7 @@
 #include "libp2p/host/host.hpp"
 #include "libp2p/peer/peer_info.hpp"
 #include "libp2p/peer/protocol.hpp"
+#include "network/network_metrics.hpp"
 
 namespace kagome::network {
   /**
@@ -62,6 +63,58 @@ namespace kagome::network {
           });
     }
 
+    /**
+     * Read an RPC request and answer with a response, which is produced
+     * asynchronously
+     * @tparam Request - type of the request to be read
+     * @tparam Response - type of the response to be written
+     * @param read_writer - channel, from which to read and to which to write
+     * @param cb, which is called, when the request is read; it is expected to
+     * call the given handler with a corresponding response, on the thread the
+     * channel is served on
+     * @param error_cb, which is called, when error happens during read/write or
+     * message processing
+     * @param metrics, to which the request and the response are recorded as
+     * the messages of \arg protocol, if any
+     */
+    template <typename Request, typename Response>
+    static void readAsync(
+        std::shared_ptr<libp2p::basic::ReadWriter> read_writer,
+        std::function<void(Request,
+                           std::function<void(outcome::result<Response>)>)>
+            cb,
+        std::function<void(outcome::result<void>)> error_cb,
+        std::shared_ptr<NetworkMetrics> metrics = nullptr,
+        const libp2p::peer::Protocol &protocol = {}) {
+      auto msg_read_writer =
+          std::make_shared<MessageReadWriterT>(std::move(read_writer));
+      if (metrics != nullptr) {
+        msg_read_writer->setMetrics(std::move(metrics), protocol);
+      }
+      msg_read_writer->template read<Request>(
+          [msg_read_writer, cb = std::move(cb), error_cb = std::move(error_cb)](
+              auto &&request_res) mutable {
+            if (!request_res) {
+              return error_cb(request_res.error());
+            }
+
+            cb(std::move(request_res.value()),
+               [msg_read_writer, error_cb](auto &&response_res) {
+                 if (!response_res) {
+                   return error_cb(response_res.error());
+                 }
+
+                 msg_read_writer->template write<Response>(
+                     response_res.value(),
+                     [error_cb](auto &&write_res) {
+                       if (!write_res) {
+                         return error_cb(write_res.error());
+                       }
+                     });
+               });
+          });
+    }
+
     /**
      * Read an RPC request
      * @tparam Request - type of the request to be read
@@ -93,18 +146,23 @@ namespace kagome::network {
      * @param protocol, over which we want to write the request to
      * @param request we want to write
      * @param cb, which is called, when a response arrives, or error happens
+     * @param metrics, to which the request and the response are recorded, if
+     * any
      */
     template <typename Request, typename Response>
     static void write(libp2p::Host &host,
                       const libp2p::peer::PeerInfo &peer_info,
                       const libp2p::peer::Protocol &protocol,
                       Request request,
-                      std::function<void(outcome::result<Response>)> cb) {
+                      std::function<void(outcome::result<Response>)> cb,
+                      std::shared_ptr<NetworkMetrics> metrics = nullptr) {
       host.newStream(
           peer_info,
           protocol,
           [request = std::move(request),
-           cb = std::move(cb)](auto &&stream_res) mutable {
+           cb = std::move(cb),
+           metrics = std::move(metrics),
+           protocol](auto &&stream_res) mutable {
             if (!stream_res) {
               return cb(stream_res.error());
             }
@@ -112,6 +170,9 @@ namespace kagome::network {
             auto stream = std::move(stream_res.value());
             spdlog::debug("Sending blocks request to {}", stream->remotePeerId().value().toBase58());
             auto read_writer = std::make_shared<MessageReadWriterT>(stream);
+            if (metrics != nullptr) {
+              read_writer->setMetrics(std::move(metrics), protocol);
+            }
             read_writer->template write<Request>(
                 request,
                 [read_writer, stream = std::move(stream), cb = std::move(cb)](
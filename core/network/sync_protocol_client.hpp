@@ -8,9 +8,13 @@
 
 #include <functional>
 
+#include <boost/optional.hpp>
+#include <libp2p/peer/peer_id.hpp>
 #include <outcome/outcome.hpp>
 #include "network/types/blocks_request.hpp"
 #include "network/types/blocks_response.hpp"
+#include "network/types/state_request.hpp"
+#include "network/types/state_response.hpp"
 
 namespace kagome::network {
   /**
@@ -27,6 +31,23 @@ namespace kagome::network {
     virtual void requestBlocks(
         const BlocksRequest &request,
         std::function<void(outcome::result<BlocksResponse>)> cb) = 0;
+
+    /**
+     * Make a request for the nodes of a state trie
+     * @param request to be made
+     * @param cb to be called, when a response or error arrives
+     */
+    virtual void requestState(
+        const StateRequest &request,
+        std::function<void(outcome::result<StateResponse>)> cb) = 0;
+
+    /**
+     * @return id of the peer the requests are made to, none for the node
+     * itself
+     */
+    virtual boost::optional<libp2p::peer::PeerId> peerId() const {
+      return boost::none;
+    }
   };
 }  // namespace kagome::network
 
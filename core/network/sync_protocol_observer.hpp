@@ -6,15 +6,22 @@
 #ifndef KAGOME_SYNC_PROTOCOL_OBSERVER_HPP
 #define KAGOME_SYNC_PROTOCOL_OBSERVER_HPP
 
+#include <functional>
+
 #include <outcome/outcome.hpp>
 #include "network/types/blocks_request.hpp"
 #include "network/types/blocks_response.hpp"
+#include "network/types/state_request.hpp"
+#include "network/types/state_response.hpp"
 
 namespace kagome::network {
   /**
    * Reactive part of Sync protocol
    */
   struct SyncProtocolObserver {
+    template <typename Response>
+    using ResponseHandler = std::function<void(outcome::result<Response>)>;
+
     virtual ~SyncProtocolObserver() = default;
 
     /**
@@ -24,6 +31,37 @@ namespace kagome::network {
      */
     virtual outcome::result<BlocksResponse> onBlocksRequest(
         const BlocksRequest &request) const = 0;
+
+    /**
+     * Process a request for the nodes of a state trie
+     * @param request to be processed
+     * @return nodes for the requested keys or error
+     */
+    virtual outcome::result<StateResponse> onStateRequest(
+        const StateRequest &request) const = 0;
+
+    /**
+     * Process a blocks request, possibly reading the storage on another
+     * thread
+     * @param handler is called with the response or error on the thread of
+     * the call, possibly later
+     */
+    virtual void onBlocksRequest(
+        const BlocksRequest &request,
+        ResponseHandler<BlocksResponse> handler) const {
+      handler(onBlocksRequest(request));
+    }
+
+    /**
+     * Process a request for the nodes of a state trie, possibly reading the
+     * storage on another thread
+     * @param handler is called with the response or error on the thread of
+     * the call, possibly later
+     */
+    virtual void onStateRequest(const StateRequest &request,
+                                ResponseHandler<StateResponse> handler) const {
+      handler(onStateRequest(request));
+    }
   };
 }  // namespace kagome::network
 
@@ -6,14 +6,24 @@
 #ifndef KAGOME_BLOCK_ANNOUNCE_HPP
 #define KAGOME_BLOCK_ANNOUNCE_HPP
 
+#include <boost/optional.hpp>
+
 #include "primitives/block_header.hpp"
+#include "primitives/transaction.hpp"
 
 namespace kagome::network {
   /**
-   * Announce a new complete block on the network
+   * Announce a new complete block on the network. A compact one carries the
+   * hashes of the extrinsics of the block too, so that the body is built from
+   * the transaction pool of the receiver instead of being requested. They
+   * are encoded after the header, which is all a node not knowing them
+   * decodes
    */
   struct BlockAnnounce {
     primitives::BlockHeader header;
+    /// hashes of the extrinsics of the body, in their order, if compact
+    boost::optional<std::vector<primitives::Transaction::Hash>>
+        extrinsic_hashes;
   };
 
   /**
@@ -23,7 +33,8 @@ namespace kagome::network {
    * @return true if equal false otherwise
    */
   inline bool operator==(const BlockAnnounce &lhs, const BlockAnnounce &rhs) {
-    return lhs.header == rhs.header;
+    return lhs.header == rhs.header
+           and lhs.extrinsic_hashes == rhs.extrinsic_hashes;
   }
   inline bool operator!=(const BlockAnnounce &lhs, const BlockAnnounce &rhs) {
     return !(lhs == rhs);
@@ -39,7 +50,11 @@ namespace kagome::network {
   template <class Stream,
             typename = std::enable_if_t<Stream::is_encoder_stream>>
   Stream &operator<<(Stream &s, const BlockAnnounce &v) {
-    return s << v.header;
+    s << v.header;
+    if (v.extrinsic_hashes) {
+      s << *v.extrinsic_hashes;
+    }
+    return s;
   }
 
   /**
@@ -52,7 +67,14 @@ namespace kagome::network {
   template <class Stream,
             typename = std::enable_if_t<Stream::is_decoder_stream>>
   Stream &operator>>(Stream &s, BlockAnnounce &v) {
-    return s >> v.header;
+    s >> v.header;
+    if (s.hasMore(1)) {
+      v.extrinsic_hashes.emplace();
+      s >> *v.extrinsic_hashes;
+    } else {
+      v.extrinsic_hashes = boost::none;
+    }
+    return s;
   }
 }  // namespace kagome::network
 
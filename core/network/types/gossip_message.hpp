@@ -6,6 +6,8 @@
 #ifndef KAGOME_GOSSIP_MESSAGE_HPP
 #define KAGOME_GOSSIP_MESSAGE_HPP
 
+#include <string_view>
+
 #include "common/buffer.hpp"
 
 namespace kagome::network {
@@ -22,6 +24,8 @@ namespace kagome::network {
       BLOCK_ANNOUNCE,
       TRANSACTIONS,
       CONSENSUS,
+      // grandpa neighbor packets, catch-up requests and catch-ups
+      CATCH_UP,
       UNKNOWN = 99
     };
 
@@ -29,6 +33,30 @@ namespace kagome::network {
     common::Buffer data;
   };
 
+  /**
+   * @return name of \arg type, under which the gossip messages are recorded
+   * to the metrics
+   */
+  inline std::string_view toString(GossipMessage::Type type) {
+    switch (type) {
+      case GossipMessage::Type::STATUS:
+        return "STATUS";
+      case GossipMessage::Type::BLOCK_REQUEST:
+        return "BLOCK_REQUEST";
+      case GossipMessage::Type::BLOCK_ANNOUNCE:
+        return "BLOCK_ANNOUNCE";
+      case GossipMessage::Type::TRANSACTIONS:
+        return "TRANSACTIONS";
+      case GossipMessage::Type::CONSENSUS:
+        return "CONSENSUS";
+      case GossipMessage::Type::CATCH_UP:
+        return "CATCH_UP";
+      case GossipMessage::Type::UNKNOWN:
+        break;
+    }
+    return "UNKNOWN";
+  }
+
   template <class Stream,
             typename = std::enable_if_t<Stream::is_encoder_stream>>
   Stream &operator<<(Stream &s, const GossipMessage &m) {
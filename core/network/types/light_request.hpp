@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_TYPES_LIGHT_REQUEST_HPP
+#define KAGOME_CORE_NETWORK_TYPES_LIGHT_REQUEST_HPP
+
+#include <string>
+#include <vector>
+
+#include <boost/variant.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+#include "scale/scale_fields.hpp"
+
+namespace kagome::network {
+
+  /// asks for the proof of the values of \a keys in the state of \a block
+  struct RemoteReadRequest {
+    primitives::BlockHash block;
+    std::vector<common::Buffer> keys;
+
+    SCALE_FIELDS(block, keys)
+  };
+
+  /// asks for the header of the block of \a block number
+  struct RemoteHeaderRequest {
+    primitives::BlockNumber block{0};
+
+    SCALE_FIELDS(block)
+  };
+
+  /**
+   * Asks for the result of runtime export \a method called with the encoded
+   * arguments \a data in the state of \a block, and for the proof of the
+   * state the call reads
+   */
+  struct RemoteCallRequest {
+    primitives::BlockHash block;
+    std::string method;
+    common::Buffer data;
+
+    SCALE_FIELDS(block, method, data)
+  };
+
+  /**
+   * Request of a light client, which does not keep the state, and checks the
+   * proofs of the parts of it it needs against the state roots of the
+   * headers. The response carries the same \a id
+   */
+  struct LightRequest {
+    uint64_t id{0};
+    boost::variant<RemoteReadRequest, RemoteHeaderRequest, RemoteCallRequest>
+        request;
+
+    SCALE_FIELDS(id, request)
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_TYPES_LIGHT_REQUEST_HPP
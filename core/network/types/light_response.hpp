@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_NETWORK_TYPES_LIGHT_RESPONSE_HPP
+#define KAGOME_CORE_NETWORK_TYPES_LIGHT_RESPONSE_HPP
+
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/block_header.hpp"
+#include "scale/scale_fields.hpp"
+
+namespace kagome::network {
+
+  /// encoded nodes of the state trie, which prove the requested values
+  struct RemoteReadResponse {
+    std::vector<common::Buffer> proof;
+
+    SCALE_FIELDS(proof)
+  };
+
+  /// header of the requested block, none if it is not known
+  struct RemoteHeaderResponse {
+    boost::optional<primitives::BlockHeader> header;
+
+    SCALE_FIELDS(header)
+  };
+
+  /**
+   * Encoded result of the call along with the encoded nodes of the state
+   * trie, which prove the values the call reads, including the runtime code
+   */
+  struct RemoteCallResponse {
+    common::Buffer result;
+    std::vector<common::Buffer> proof;
+
+    SCALE_FIELDS(result, proof)
+  };
+
+  /// response to the light request of the same \a id
+  struct LightResponse {
+    uint64_t id{0};
+    boost::variant<RemoteReadResponse, RemoteHeaderResponse, RemoteCallResponse>
+        response;
+
+    SCALE_FIELDS(id, response)
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_CORE_NETWORK_TYPES_LIGHT_RESPONSE_HPP
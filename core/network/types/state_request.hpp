@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STATE_REQUEST_HPP
+#define KAGOME_STATE_REQUEST_HPP
+
+#include <vector>
+
+#include "common/buffer.hpp"
+
+namespace kagome::network {
+  /**
+   * Request for the nodes of a state trie, which are requested by their keys
+   * in the trie storage, so that the state is downloaded without executing
+   * the blocks
+   */
+  struct StateRequest {
+    std::vector<common::Buffer> keys;
+  };
+
+  inline bool operator==(const StateRequest &lhs, const StateRequest &rhs) {
+    return lhs.keys == rhs.keys;
+  }
+
+  /**
+   * @brief outputs object of type StateRequest to stream
+   * @tparam Stream output stream type
+   * @param s stream reference
+   * @param v value to output
+   * @return reference to stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const StateRequest &v) {
+    return s << v.keys;
+  }
+
+  /**
+   * @brief decodes object of type StateRequest from stream
+   * @tparam Stream input stream type
+   * @param s stream reference
+   * @param v value to decode
+   * @return reference to stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, StateRequest &v) {
+    return s >> v.keys;
+  }
+}  // namespace kagome::network
+
+#endif  // KAGOME_STATE_REQUEST_HPP
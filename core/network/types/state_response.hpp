@@ -0,0 +1,54 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STATE_RESPONSE_HPP
+#define KAGOME_STATE_RESPONSE_HPP
+
+#include <vector>
+
+#include "common/buffer.hpp"
+
+namespace kagome::network {
+  /**
+   * Response to the StateRequest: the encoded nodes for the requested keys in
+   * the same order. The nodes may be fewer than the keys, then the ones
+   * after the last node are not answered
+   */
+  struct StateResponse {
+    std::vector<common::Buffer> nodes;
+  };
+
+  inline bool operator==(const StateResponse &lhs, const StateResponse &rhs) {
+    return lhs.nodes == rhs.nodes;
+  }
+
+  /**
+   * @brief outputs object of type StateResponse to stream
+   * @tparam Stream output stream type
+   * @param s stream reference
+   * @param v value to output
+   * @return reference to stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_encoder_stream>>
+  Stream &operator<<(Stream &s, const StateResponse &v) {
+    return s << v.nodes;
+  }
+
+  /**
+   * @brief decodes object of type StateResponse from stream
+   * @tparam Stream input stream type
+   * @param s stream reference
+   * @param v value to decode
+   * @return reference to stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, StateResponse &v) {
+    return s >> v.nodes;
+  }
+}  // namespace kagome::network
+
+#endif  // KAGOME_STATE_RESPONSE_HPP
@@ -11,9 +11,11 @@
 
 #include <boost/multiprecision/cpp_int.hpp>
 #include "common/blob.hpp"
+#include "common/logger.hpp"
 #include "primitives/common.hpp"
 #include "primitives/compact_integer.hpp"
 #include "primitives/digest.hpp"
+#include "scale/scale_fields.hpp"
 
 namespace kagome::primitives {
   /**
@@ -38,38 +40,35 @@ namespace kagome::primitives {
     bool operator!=(const BlockHeader &rhs) const {
       return !operator==(rhs);
     }
+
+    SCALE_FIELDS(parent_hash,
+                 scale::asCompact(number),
+                 state_root,
+                 extrinsics_root,
+                 digest)
   };
+}  // namespace kagome::primitives
 
-  /**
-   * @brief outputs object of type BlockHeader to stream
-   * @tparam Stream output stream type
-   * @param s stream reference
-   * @param v value to output
-   * @return reference to stream
-   */
-  template <class Stream,
-            typename = std::enable_if_t<Stream::is_encoder_stream>>
-  Stream &operator<<(Stream &s, const BlockHeader &bh) {
-    return s << bh.parent_hash << CompactInteger(bh.number) << bh.state_root
-             << bh.extrinsics_root << bh.digest;
+/**
+ * Formats a header in the logs as its number and the hashes it refers to,
+ * the digest is left out
+ */
+template <>
+struct fmt::formatter<kagome::primitives::BlockHeader> {
+  template <typename ParseContext>
+  constexpr auto parse(ParseContext &ctx) {
+    return ctx.begin();
   }
 
-  /**
-   * @brief decodes object of type BlockHeader from stream
-   * @tparam Stream input stream type
-   * @param s stream reference
-   * @param v value to output
-   * @return reference to stream
-   */
-  template <class Stream,
-            typename = std::enable_if_t<Stream::is_decoder_stream>>
-  Stream &operator>>(Stream &s, BlockHeader &bh) {
-    CompactInteger number_compact;
-    s >> bh.parent_hash >> number_compact >> bh.state_root >> bh.extrinsics_root
-        >> bh.digest;
-    bh.number = number_compact.convert_to<BlockNumber>();
-    return s;
+  template <typename FormatContext>
+  auto format(const kagome::primitives::BlockHeader &header,
+              FormatContext &ctx) const {
+    return fmt::format_to(ctx.out(),
+                          "#{} (parent {}, state root {})",
+                          header.number,
+                          header.parent_hash,
+                          header.state_root);
   }
-}  // namespace kagome::primitives
+};
 
 #endif  // KAGOME_PRIMITIVES_BLOCK_HEADER_HPP
@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_PRIMITIVES_BLOCK_HEADER_VIEW_HPP
+#define KAGOME_PRIMITIVES_BLOCK_HEADER_VIEW_HPP
+
+#include <gsl/span>
+
+#include "primitives/block_header.hpp"
+#include "scale/scale.hpp"
+
+namespace kagome::primitives {
+
+  /**
+   * Digest item, which refers to its bytes in the encoded header instead of
+   * copying them
+   */
+  struct DigestItemView {
+    /// indices of the types of DigestItem, the fake ones included
+    enum Type : uint8_t {
+      OTHER = 0,
+      FAKE_NUMBER = 1,
+      CHANGES_TRIE_ROOT = 2,
+      FAKE_STRING = 3,
+      CONSENSUS = 4,
+      SEAL = 5,
+      PRE_RUNTIME = 6,
+    };
+
+    uint8_t type = OTHER;
+    /// engine of the consensus items, which are PreRuntime, Consensus and
+    /// Seal
+    ConsensusEngineId consensus_engine_id{};
+    /// bytes of the item, the data of the consensus items
+    gsl::span<const uint8_t> data;
+
+    DigestItem toDigestItem() const {
+      switch (type) {
+        case FAKE_NUMBER:
+          return scale::decode<uint32_t>(data).value();
+        case CHANGES_TRIE_ROOT:
+          return ChangesTrieRoot::fromSpan(data).value();
+        case FAKE_STRING:
+          return std::string{data.begin(), data.end()};
+        case CONSENSUS:
+          return Consensus{{consensus_engine_id, common::Buffer{data}}};
+        case SEAL:
+          return Seal{{consensus_engine_id, common::Buffer{data}}};
+        case PRE_RUNTIME:
+          return PreRuntime{{consensus_engine_id, common::Buffer{data}}};
+        default:
+          return Other{data};
+      }
+    }
+  };
+
+  /**
+   * Block header, which refers to the digest in the encoded header instead
+   * of copying it, for the paths which only read the header. It is valid as
+   * long as the encoded header is
+   */
+  struct BlockHeaderView {
+    BlockHash parent_hash{};
+    BlockNumber number = 0u;
+    common::Hash256 state_root{};
+    common::Hash256 extrinsics_root{};
+    std::vector<DigestItemView> digest;
+
+    /// @return the header, which owns all of its data
+    BlockHeader toHeader() const {
+      BlockHeader header{
+          parent_hash, number, state_root, extrinsics_root, {}};
+      header.digest.reserve(digest.size());
+      for (auto &item : digest) {
+        header.digest.push_back(item.toDigestItem());
+      }
+      return header;
+    }
+  };
+
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, DigestItemView &item) {
+    s >> item.type;
+    switch (item.type) {
+      case DigestItemView::OTHER:
+      case DigestItemView::FAKE_STRING:
+        return s >> item.data;
+      case DigestItemView::FAKE_NUMBER:
+        item.data = s.nextBytes(sizeof(uint32_t));
+        return s;
+      case DigestItemView::CHANGES_TRIE_ROOT:
+        item.data = s.nextBytes(ChangesTrieRoot::size());
+        return s;
+      case DigestItemView::CONSENSUS:
+      case DigestItemView::SEAL:
+      case DigestItemView::PRE_RUNTIME:
+        return s >> item.consensus_engine_id >> item.data;
+      default:
+        common::raise(scale::DecodeError::WRONG_TYPE_INDEX);
+    }
+    return s;
+  }
+
+  /**
+   * @brief decodes the header as it is encoded by BlockHeader, the digest
+   * referring to the bytes of the stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, BlockHeaderView &bh) {
+    CompactInteger number_compact;
+    s >> bh.parent_hash >> number_compact >> bh.state_root >> bh.extrinsics_root
+        >> bh.digest;
+    bh.number = number_compact.convert_to<BlockNumber>();
+    return s;
+  }
+}  // namespace kagome::primitives
+
+#endif  // KAGOME_PRIMITIVES_BLOCK_HEADER_VIEW_HPP
@@ -10,6 +10,7 @@
 
 #include <boost/operators.hpp>
 #include "primitives/session_key.hpp"
+#include "scale/scale_fields.hpp"
 
 namespace kagome::primitives {
   using BlocksRequestId = uint64_t;
@@ -33,21 +34,9 @@ namespace kagome::primitives {
       bool operator==(const BlockInfoT<Tag> &o) const {
         return block_number == o.block_number && block_hash == o.block_hash;
       }
-    };
 
-    template <class Stream,
-              typename Tag,
-              typename = std::enable_if_t<Stream::is_encoder_stream>>
-    Stream &operator<<(Stream &s, const BlockInfoT<Tag> &msg) {
-      return s << msg.block_hash << msg.block_number;
-    }
-
-    template <class Stream,
-              typename Tag,
-              typename = std::enable_if_t<Stream::is_decoder_stream>>
-    Stream &operator>>(Stream &s, BlockInfoT<Tag> &msg) {
-      return s >> msg.block_hash >> msg.block_number;
-    }
+      SCALE_FIELDS(block_hash, block_number)
+    };
   }  // namespace detail
 
   using BlockInfo = detail::BlockInfoT<struct BlockInfoTag>;
@@ -18,6 +18,8 @@ namespace kagome::primitives {
 
   inline const auto kBabeEngineId =
       ConsensusEngineId::fromString("BABE").value();
+  inline const auto kGrandpaEngineId =
+      ConsensusEngineId::fromString("FRNK").value();
 
   /// System digest item that contains the root of changes trie at given
   /// block. It is created for every block iff runtime supports changes
@@ -6,6 +6,8 @@
 #ifndef KAGOME_PRIMITIVES_EXTRINSIC_HPP
 #define KAGOME_PRIMITIVES_EXTRINSIC_HPP
 
+#include <gsl/span>
+
 #include "common/buffer.hpp"
 
 namespace kagome::primitives {
@@ -51,6 +53,29 @@ namespace kagome::primitives {
   Stream &operator>>(Stream &s, Extrinsic &v) {
     return s >> v.data;
   }
+
+  /**
+   * Extrinsic, which refers to its content in the encoded data instead of
+   * copying it. It is valid as long as the encoded data is
+   */
+  struct ExtrinsicView {
+    gsl::span<const uint8_t> data;
+
+    /// @return the extrinsic, which owns its content
+    Extrinsic toExtrinsic() const {
+      return Extrinsic{common::Buffer{data}};
+    }
+  };
+
+  /**
+   * @brief decodes the extrinsic as it is encoded by Extrinsic, referring to
+   * the bytes of the stream
+   */
+  template <class Stream,
+            typename = std::enable_if_t<Stream::is_decoder_stream>>
+  Stream &operator>>(Stream &s, ExtrinsicView &v) {
+    return s >> v.data;
+  }
 }  // namespace kagome::primitives
 
 #endif  // KAGOME_PRIMITIVES_EXTRINSIC_HPP
@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_PRIMITIVES_READ_PROOF_HPP
+#define KAGOME_CORE_PRIMITIVES_READ_PROOF_HPP
+
+#include <vector>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::primitives {
+
+  /**
+   * Merkle proof of storage entries at a block, the same structure as
+   * ReadProof from substrate
+   */
+  struct ReadProof {
+    BlockHash at;
+    // encoded trie nodes, each of them once
+    std::vector<common::Buffer> proof;
+  };
+
+}  // namespace kagome::primitives
+
+#endif  // KAGOME_CORE_PRIMITIVES_READ_PROOF_HPP
@@ -0,0 +1,35 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
+#define KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::primitives {
+
+  /**
+   * Values of storage entries at a block, the same structure as
+   * StorageChangeSet from substrate
+   */
+  struct StorageChangeSet {
+    struct Change {
+      common::Buffer key;
+      // none if there is no entry for the key
+      boost::optional<common::Buffer> data;
+    };
+
+    BlockHash block;
+    std::vector<Change> changes;
+  };
+
+}  // namespace kagome::primitives
+
+#endif  // KAGOME_CORE_PRIMITIVES_STORAGE_CHANGE_SET_HPP
@@ -5,19 +5,110 @@
 
 #include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <boost/filesystem.hpp>
+
 #include "runtime/binaryen/module/wasm_module_impl.hpp"
 
 namespace kagome::runtime::binaryen {
 
+  namespace {
+    boost::optional<common::Buffer> readFile(const std::string &path) {
+      std::ifstream in{path, std::ios::binary};
+      if (not in) {
+        return boost::none;
+      }
+      std::vector<uint8_t> content{std::istreambuf_iterator<char>{in},
+                                   std::istreambuf_iterator<char>{}};
+      if (in.bad()) {
+        return boost::none;
+      }
+      return common::Buffer{std::move(content)};
+    }
+
+    /**
+     * Writes a temporary file and renames it, so that a crash never leaves
+     * a partially written file at \arg path
+     */
+    bool writeFile(const std::string &path, const common::Buffer &content) {
+      auto tmp_path = path + ".tmp";
+      {
+        std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+        out.write(
+            reinterpret_cast<const char *>(content.data()),  // NOLINT
+            content.size());
+        if (not out) {
+          std::remove(tmp_path.c_str());
+          return false;
+        }
+      }
+      return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+  }  // namespace
+
+  WasmModuleFactoryImpl::WasmModuleFactoryImpl(uint32_t optimization_level)
+      : optimization_level_{optimization_level},
+        logger_{common::createLogger("WasmModuleFactory")} {}
+
+  WasmModuleFactoryImpl::WasmModuleFactoryImpl(
+      uint32_t optimization_level,
+      std::string cache_path,
+      std::shared_ptr<crypto::Hasher> hasher)
+      : optimization_level_{optimization_level},
+        cache_path_{std::move(cache_path)},
+        hasher_{std::move(hasher)},
+        logger_{common::createLogger("WasmModuleFactory")} {
+    BOOST_ASSERT(hasher_ != nullptr);
+  }
+
   outcome::result<std::unique_ptr<WasmModule>>
   WasmModuleFactoryImpl::createModule(
       const common::Buffer &code,
       std::shared_ptr<RuntimeExternalInterface> rei) const {
-    auto res = WasmModuleImpl::createFromCode(code, rei);
-    if (res.has_value()) {
-      return std::unique_ptr<WasmModule>(res.value().release());
+    // code, which is not optimized, is parsed as quickly as it is read
+    if (cache_path_.empty() or optimization_level_ == 0) {
+      OUTCOME_TRY(
+          module,
+          WasmModuleImpl::createFromCode(code, rei, optimization_level_));
+      return std::unique_ptr<WasmModule>(std::move(module));
+    }
+
+    auto path = cachedCodePath(code);
+    if (auto cached = readFile(path)) {
+      // the cached code is optimized already
+      auto module = WasmModuleImpl::createFromCode(cached.value(), rei, 0);
+      if (module) {
+        logger_->debug("Loaded optimized runtime code from {}", path);
+        return std::unique_ptr<WasmModule>(std::move(module.value()));
+      }
+      logger_->warn("Cached runtime code {} is invalid: {}",
+                    path,
+                    module.error().message());
     }
-    return res.error();
+
+    OUTCOME_TRY(module,
+                WasmModuleImpl::createFromCode(code, rei, optimization_level_));
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(cache_path_, ec);
+    // the module works without the cache, so a failure to write it is not
+    // an error
+    if (ec or not writeFile(path, module->serialize())) {
+      logger_->warn("Failed to cache optimized runtime code in {}", path);
+    } else {
+      logger_->info("Cached optimized runtime code in {}", path);
+    }
+    return std::unique_ptr<WasmModule>(std::move(module));
+  }
+
+  std::string WasmModuleFactoryImpl::cachedCodePath(
+      const common::Buffer &code) const {
+    // code optimized with different levels differs
+    auto name = hasher_->twox_256(code).toHex() + ".O"
+                + std::to_string(optimization_level_) + ".wasm";
+    return (boost::filesystem::path{cache_path_} / name).string();
   }
 
 }  // namespace kagome::runtime::binaryen
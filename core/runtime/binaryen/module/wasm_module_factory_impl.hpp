@@ -8,15 +8,45 @@
 
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
 
+#include "common/logger.hpp"
+#include "crypto/hasher.hpp"
+
 namespace kagome::runtime::binaryen {
 
   class WasmModuleFactoryImpl final : public WasmModuleFactory {
    public:
+    /**
+     * @param optimization_level level of the optimizations of the created
+     * modules, @see WasmModuleImpl#createFromCode
+     */
+    explicit WasmModuleFactoryImpl(uint32_t optimization_level = 0);
+
+    /**
+     * Creates a factory, which keeps the optimized code of the modules in
+     * \arg cache_path directory, so that the code is optimized once and not
+     * on every start of the node
+     * @param hasher hasher of the code, which names the cached files
+     */
+    WasmModuleFactoryImpl(uint32_t optimization_level,
+                          std::string cache_path,
+                          std::shared_ptr<crypto::Hasher> hasher);
     ~WasmModuleFactoryImpl() override = default;
 
     outcome::result<std::unique_ptr<WasmModule>> createModule(
         const common::Buffer &code,
         std::shared_ptr<RuntimeExternalInterface> rei) const override;
+
+   private:
+    /**
+     * @return path of the file with the optimized \arg code
+     */
+    std::string cachedCodePath(const common::Buffer &code) const;
+
+    uint32_t optimization_level_;
+    // empty if the optimized code is not cached
+    std::string cache_path_;
+    std::shared_ptr<crypto::Hasher> hasher_;
+    common::Logger logger_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include <binaryen/pass.h>
 #include <binaryen/wasm-binary.h>
 #include <binaryen/wasm-interpreter.h>
 
@@ -43,7 +44,8 @@ namespace kagome::runtime::binaryen {
   outcome::result<std::unique_ptr<WasmModuleImpl>>
   WasmModuleImpl::createFromCode(
       const common::Buffer &code,
-      const std::shared_ptr<RuntimeExternalInterface> &rei) {
+      const std::shared_ptr<RuntimeExternalInterface> &rei,
+      uint32_t optimization_level) {
     // that nolint suppresses false positive in a library function
     // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
     if (code.empty()) {
@@ -68,6 +70,17 @@ namespace kagome::runtime::binaryen {
         return Error::INVALID_STATE_CODE;
       }
     }
+    // the interpreter walks the expression tree, so inlining, merging the
+    // blocks and simplifying the locals cut the nodes it visits on every
+    // call, while the module is only optimized once and then cached
+    if (optimization_level > 0) {
+      wasm::PassOptions options;
+      options.optimizeLevel = static_cast<int>(optimization_level);
+      options.shrinkLevel = 0;
+      wasm::PassRunner runner(module.get(), options);
+      runner.addDefaultOptimizationPasses();
+      runner.run();
+    }
     auto module_instance =
         std::make_unique<wasm::ModuleInstance>(*module, rei.get());
 
@@ -81,4 +94,11 @@ namespace kagome::runtime::binaryen {
     return module_instance_->callExport(name, arguments);
   }
 
+  common::Buffer WasmModuleImpl::serialize() const {
+    wasm::BufferWithRandomAccess buffer;
+    wasm::WasmBinaryWriter writer(module_.get(), buffer);
+    writer.write();
+    return common::Buffer{std::vector<uint8_t>(buffer.begin(), buffer.end())};
+  }
+
 }  // namespace kagome::runtime::binaryen
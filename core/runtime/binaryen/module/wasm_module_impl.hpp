@@ -34,13 +34,24 @@ namespace kagome::runtime::binaryen {
 
     ~WasmModuleImpl() override;
 
+    /**
+     * @param optimization_level level of the Binaryen optimizations run over
+     * the code once before it is interpreted, 0 means no optimizations
+     */
     static outcome::result<std::unique_ptr<WasmModuleImpl>> createFromCode(
         const common::Buffer &code,
-        const std::shared_ptr<RuntimeExternalInterface> &rei);
+        const std::shared_ptr<RuntimeExternalInterface> &rei,
+        uint32_t optimization_level = 0);
 
     wasm::Literal callExport(
         wasm::Name name, const std::vector<wasm::Literal> &arguments) override;
 
+    /**
+     * @return binary code of the module, which is optimized if the module
+     * was created with optimizations
+     */
+    common::Buffer serialize() const;
+
    private:
     explicit WasmModuleImpl(
         std::unique_ptr<wasm::Module>&& module,
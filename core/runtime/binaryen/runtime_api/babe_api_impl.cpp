@@ -12,8 +12,8 @@ namespace kagome::runtime::binaryen {
       : RuntimeApi(runtime_manager) {}
 
   outcome::result<primitives::BabeConfiguration> BabeApiImpl::configuration() {
-    return execute<primitives::BabeConfiguration>("BabeApi_configuration",
-                                                  CallPersistency::EPHEMERAL);
+    return executePure<primitives::BabeConfiguration>(
+        "BabeApi_configuration");
   }
 
 }  // namespace kagome::runtime::binaryen
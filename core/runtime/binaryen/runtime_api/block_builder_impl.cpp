@@ -26,7 +26,7 @@ namespace kagome::runtime::binaryen {
 
   outcome::result<BlockHeader> BlockBuilderImpl::finalise_block() {
     return execute<BlockHeader>("BlockBuilder_finalize_block",
-                                CallPersistency::PERSISTENT);
+                                CallPersistency::COMMITTED);
   }
 
   outcome::result<std::vector<Extrinsic>> BlockBuilderImpl::inherent_extrinsics(
@@ -48,4 +48,12 @@ namespace kagome::runtime::binaryen {
     return execute<common::Hash256>("BlockBuilder_random_seed",
                                     CallPersistency::EPHEMERAL);
   }
+
+  outcome::result<void> BlockBuilderImpl::holdEnvironment() {
+    return holdPersistentEnvironment();
+  }
+
+  void BlockBuilderImpl::releaseEnvironment() {
+    releasePersistentEnvironment();
+  }
 }  // namespace kagome::runtime::binaryen
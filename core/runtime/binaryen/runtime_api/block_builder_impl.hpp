@@ -31,6 +31,10 @@ namespace kagome::runtime::binaryen {
         const primitives::InherentData &data) override;
 
     outcome::result<common::Hash256> random_seed() override;
+
+    outcome::result<void> holdEnvironment() override;
+
+    void releaseEnvironment() override;
   };
 }  // namespace kagome::runtime::binaryen
 
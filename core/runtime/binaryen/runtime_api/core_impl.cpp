@@ -17,10 +17,12 @@ namespace kagome::runtime::binaryen {
   CoreImpl::CoreImpl(
       const std::shared_ptr<RuntimeManager> &runtime_manager,
       std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
-      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo)
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+      std::shared_ptr<storage::trie::StatePrefetcher> prefetcher)
       : RuntimeApi(runtime_manager),
         changes_tracker_{std::move(changes_tracker)},
-        header_repo_{std::move(header_repo)} {
+        header_repo_{std::move(header_repo)},
+        prefetcher_{std::move(prefetcher)} {
     BOOST_ASSERT(changes_tracker_ != nullptr);
     BOOST_ASSERT(header_repo_ != nullptr);
   }
@@ -28,10 +30,9 @@ namespace kagome::runtime::binaryen {
   outcome::result<Version> CoreImpl::version(
       const boost::optional<primitives::BlockHash> &block_hash) {
     if (block_hash) {
-      return execute<Version>(
-          "Core_version", CallPersistency::EPHEMERAL, *block_hash);
+      return executePure<Version>("Core_version", *block_hash);
     }
-    return execute<Version>("Core_version", CallPersistency::EPHEMERAL);
+    return executePure<Version>("Core_version");
   }
 
   outcome::result<void> CoreImpl::execute_block(
@@ -40,10 +41,23 @@ namespace kagome::runtime::binaryen {
     OUTCOME_TRY(changes_tracker_->onBlockChange(
         block.header.parent_hash,
         block.header.number - 1));  // parent's number
-    return executeAt<void>("Core_execute_block",
-                           parent.state_root,
-                           CallPersistency::PERSISTENT,
-                           block);
+    if (prefetcher_ == nullptr) {
+      return executeAt<void>("Core_execute_block",
+                             parent.state_root,
+                             CallPersistency::COMMITTED,
+                             block);
+    }
+    // the nodes are read ahead while the block is executed, the keys it
+    // accesses are expected to be accessed by the next block as well
+    prefetcher_->prefetch(parent.state_root, block.body);
+    std::vector<Buffer> accessed_keys;
+    OUTCOME_TRY(executeRecordingAccess<void>("Core_execute_block",
+                                             parent.state_root,
+                                             CallPersistency::COMMITTED,
+                                             accessed_keys,
+                                             block));
+    prefetcher_->recordBlock(std::move(accessed_keys));
+    return outcome::success();
   }
 
   outcome::result<void> CoreImpl::initialise_block(const BlockHeader &header) {
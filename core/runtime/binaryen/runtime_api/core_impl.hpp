@@ -11,15 +11,22 @@
 
 #include "blockchain/block_header_repository.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
+#include "storage/trie/impl/state_prefetcher.hpp"
 
 namespace kagome::runtime::binaryen {
 
   class CoreImpl : public RuntimeApi, public Core {
    public:
-    explicit CoreImpl(
+    /**
+     * @param prefetcher looks up the keys a block is expected to access on
+     * the threads of its own before the block is executed, nullptr if there
+     * is no prefetching
+     */
+    CoreImpl(
         const std::shared_ptr<RuntimeManager> &runtime_manager,
         std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker,
-        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo);
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+        std::shared_ptr<storage::trie::StatePrefetcher> prefetcher = nullptr);
 
     ~CoreImpl() override = default;
 
@@ -38,6 +45,7 @@ namespace kagome::runtime::binaryen {
    private:
     std::shared_ptr<storage::changes_trie::ChangesTracker> changes_tracker_;
     std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<storage::trie::StatePrefetcher> prefetcher_;
   };
 }  // namespace kagome::runtime::binaryen
 
@@ -35,7 +35,7 @@ namespace kagome::runtime::binaryen {
 
   outcome::result<std::vector<Authority>> GrandpaImpl::authorities(
       const primitives::BlockId &block_id) {
-    return execute<std::vector<Authority>>(
-        "GrandpaApi_grandpa_authorities", CallPersistency::EPHEMERAL, block_id);
+    return executePure<std::vector<Authority>>(
+        "GrandpaApi_grandpa_authorities", block_id);
   }
 }  // namespace kagome::runtime::binaryen
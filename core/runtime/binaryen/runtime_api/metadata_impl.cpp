@@ -13,7 +13,6 @@ namespace kagome::runtime::binaryen {
       : RuntimeApi(runtime_manager) {}
 
   outcome::result<OpaqueMetadata> MetadataImpl::metadata() {
-    return execute<OpaqueMetadata>("Metadata_metadata",
-                                   CallPersistency::EPHEMERAL);
+    return executePure<OpaqueMetadata>("Metadata_metadata");
   }
 }  // namespace kagome::runtime::binaryen
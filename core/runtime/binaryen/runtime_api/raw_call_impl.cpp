@@ -0,0 +1,26 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_api/raw_call_impl.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  RawCallImpl::RawCallImpl(
+      const std::shared_ptr<RuntimeManager> &runtime_manager)
+      : RuntimeApi(runtime_manager) {}
+
+  outcome::result<common::Buffer> RawCallImpl::callAt(
+      const common::Hash256 &state_root,
+      std::string_view method,
+      gsl::span<const uint8_t> args,
+      std::vector<common::Buffer> &accessed_keys) {
+    return executeRaw(method,
+                      state_root,
+                      CallPersistency::EPHEMERAL,
+                      &accessed_keys,
+                      args);
+  }
+
+}  // namespace kagome::runtime::binaryen
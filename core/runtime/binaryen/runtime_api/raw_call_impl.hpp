@@ -0,0 +1,30 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RAW_CALL_IMPL_HPP
+#define KAGOME_CORE_RUNTIME_BINARYEN_RAW_CALL_IMPL_HPP
+
+#include "runtime/binaryen/runtime_api/runtime_api.hpp"
+#include "runtime/raw_call.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  class RawCallImpl : public RuntimeApi, public RawCall {
+   public:
+    explicit RawCallImpl(
+        const std::shared_ptr<RuntimeManager> &runtime_manager);
+
+    ~RawCallImpl() override = default;
+
+    outcome::result<common::Buffer> callAt(
+        const common::Hash256 &state_root,
+        std::string_view method,
+        gsl::span<const uint8_t> args,
+        std::vector<common::Buffer> &accessed_keys) override;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RAW_CALL_IMPL_HPP
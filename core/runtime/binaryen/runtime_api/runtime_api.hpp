@@ -6,15 +6,20 @@
 #ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_HPP
 #define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_HPP
 
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <binaryen/wasm-binary.h>
 #include <binaryen/wasm-interpreter.h>
 #include <boost/optional.hpp>
+#include <gsl/gsl_util>
 
 #include "common/buffer.hpp"
 #include "common/logger.hpp"
 #include "extensions/extension_factory.hpp"
+#include "runtime/binaryen/runtime_call_cache.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
 #include "runtime/binaryen/runtime_manager.hpp"
 #include "runtime/binaryen/wasm_executor.hpp"
@@ -30,9 +35,15 @@ namespace kagome::runtime::binaryen {
    */
   class RuntimeApi {
    public:
+    // max number of the results of pure calls kept by an api
+    static constexpr size_t kPureCallsCacheSize = 32;
+
     enum class CallPersistency {
       PERSISTENT,  // the changes made by this call will be applied to the state
                    // trie storage
+      COMMITTED,   // same as PERSISTENT, and the state is written to the
+                   // storage once the call is completed, as it is the state
+                   // of a block
       EPHEMERAL    // the changes made by this call will vanish once it's
                    // completed
     };
@@ -50,6 +61,7 @@ namespace kagome::runtime::binaryen {
       if (state_root_opt.has_value()) {
         switch (persistency) {
           case CallPersistency::PERSISTENT:
+          case CallPersistency::COMMITTED:
             return runtime_manager_
                 ->createPersistentRuntimeEnvironmentAt(state_root_opt.value())
                 .value();
@@ -61,6 +73,7 @@ namespace kagome::runtime::binaryen {
       } else {
         switch (persistency) {
           case CallPersistency::PERSISTENT:
+          case CallPersistency::COMMITTED:
             return runtime_manager_->createPersistentRuntimeEnvironment()
                 .value();
           case CallPersistency::EPHEMERAL:
@@ -88,8 +101,11 @@ namespace kagome::runtime::binaryen {
                                  const common::Hash256 &state_root,
                                  CallPersistency persistency,
                                  Args &&... args) {
-      return executeMaybeAt<R>(
-          name, state_root, persistency, std::forward<Args>(args)...);
+      return executeMaybeAt<R>(name,
+                               state_root,
+                               persistency,
+                               nullptr,
+                               std::forward<Args>(args)...);
     }
 
     /**
@@ -106,11 +122,171 @@ namespace kagome::runtime::binaryen {
     outcome::result<R> execute(std::string_view name,
                                CallPersistency persistency,
                                Args &&... args) {
-      return executeMaybeAt<R>(
-          name, boost::none, persistency, std::forward<Args>(args)...);
+      return executeMaybeAt<R>(name,
+                               boost::none,
+                               persistency,
+                               nullptr,
+                               std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief same as executeAt(), or execute() if there is no \arg
+     * state_root, also collecting the keys of the state accessed by the call
+     * @param accessed_keys - receives the accessed keys, sorted, even if the
+     * call fails
+     */
+    template <typename R, typename... Args>
+    outcome::result<R> executeRecordingAccess(
+        std::string_view name,
+        const boost::optional<common::Hash256> &state_root,
+        CallPersistency persistency,
+        std::vector<common::Buffer> &accessed_keys,
+        Args &&... args) {
+      return executeMaybeAt<R>(name,
+                               state_root,
+                               persistency,
+                               &accessed_keys,
+                               std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief executes wasm export method \arg name with \arg args encoded
+     * already, as executeRecordingAccess() does; the name is not required to
+     * outlive the call
+     * @param accessed_keys - receives the accessed keys, if not null
+     * @return the encoded result
+     */
+    outcome::result<common::Buffer> executeRaw(
+        std::string_view name,
+        const boost::optional<common::Hash256> &state_root,
+        CallPersistency persistency,
+        std::vector<common::Buffer> *accessed_keys,
+        gsl::span<const uint8_t> args) {
+      return callExport(
+          name,
+          state_root,
+          persistency,
+          accessed_keys,
+          args.size(),
+          [&args](gsl::span<uint8_t> out) -> outcome::result<void> {
+            std::copy(args.begin(), args.end(), out.begin());
+            return outcome::success();
+          },
+          true,
+          "raw_call");
+    }
+
+    /**
+     * @brief executes ephemerally wasm export method, the result of which
+     * depends on nothing but the code, the current state and the arguments,
+     * so that it is memoized by them
+     * @tparam R result type
+     * @tparam Args arguments types list
+     * @param name - export method name
+     * @param args - export method arguments
+     * @return a parsed result or an error
+     */
+    template <typename R, typename... Args>
+    outcome::result<R> executePure(std::string_view name, Args &&... args) {
+      static_assert(not std::is_same_v<void, R>);
+      common::Buffer encoded_args;
+      if constexpr (sizeof...(args) > 0) {
+        OUTCOME_TRY(buffer, scale::encode(std::forward<Args>(args)...));
+        encoded_args = common::Buffer(std::move(buffer));
+      }
+
+      // the state is unknown without the storage, the call isn't cached then
+      auto state_root = runtime_manager_->stateRoot();
+      boost::optional<common::Buffer> key;
+      if (state_root.has_value()) {
+        key = RuntimeCallCache::makeKey(runtime_manager_->stateCodeHash(),
+                                        state_root.value(),
+                                        name,
+                                        encoded_args);
+        if (auto cached = pure_calls_.get(key.value())) {
+          logger_->debug("Export function {} result is cached", name);
+          return scale::decode<R>(std::move(cached.value()));
+        }
+      }
+
+      OUTCOME_TRY(result,
+                  callExport(
+                      name,
+                      boost::none,
+                      CallPersistency::EPHEMERAL,
+                      nullptr,
+                      encoded_args.size(),
+                      [&](gsl::span<uint8_t> out) -> outcome::result<void> {
+                        std::copy(encoded_args.begin(),
+                                  encoded_args.end(),
+                                  out.begin());
+                        return outcome::success();
+                      },
+                      true));
+      OUTCOME_TRY(decoded, scale::decode<R>(result));
+      // the call might have run on a newer state committed meanwhile
+      if (key.has_value() and runtime_manager_->stateRoot() == state_root) {
+        pure_calls_.put(key.value(), std::move(result));
+      }
+      return std::move(decoded);
+    }
+
+    /**
+     * Keeps the environment of the persistent calls on the current state for
+     * such calls of the api made by this thread until
+     * releasePersistentEnvironment(), so that a series of them, like the one
+     * building a block, doesn't set it up for every call. Persistent calls
+     * of the other threads and the apis wait for the environment to be
+     * released, so this thread must not make them meanwhile
+     */
+    outcome::result<void> holdPersistentEnvironment() {
+      {
+        std::lock_guard lock{held_mutex_};
+        if (held_environment_
+            and held_environment_owner_ == std::this_thread::get_id()) {
+          return outcome::success();
+        }
+      }
+      OUTCOME_TRY(environment,
+                  runtime_manager_->createPersistentRuntimeEnvironment());
+      std::lock_guard lock{held_mutex_};
+      held_environment_ = std::move(environment);
+      held_environment_owner_ = std::this_thread::get_id();
+      return outcome::success();
+    }
+
+    /**
+     * Lets the other persistent calls run, \see holdPersistentEnvironment()
+     */
+    void releasePersistentEnvironment() {
+      // the instance is returned to its pool out of the lock
+      boost::optional<RuntimeManager::RuntimeEnvironment> released;
+      std::lock_guard lock{held_mutex_};
+      if (held_environment_owner_ == std::this_thread::get_id()) {
+        released = std::move(held_environment_);
+        held_environment_.reset();
+      }
     }
 
    private:
+    /**
+     * @return the environment held by this thread for the call, if any
+     */
+    boost::optional<RuntimeManager::RuntimeEnvironment> heldEnvironment(
+        CallPersistency persistency,
+        const boost::optional<common::Hash256> &state_root) {
+      if (persistency == CallPersistency::EPHEMERAL
+          or state_root.has_value()) {
+        return boost::none;
+      }
+      std::lock_guard lock{held_mutex_};
+      if (held_environment_
+          and held_environment_owner_ == std::this_thread::get_id()) {
+        return held_environment_;
+      }
+      return boost::none;
+    }
+
     /**
      * If \arg state_root contains a value, then the state will be reset to the
      * hash in this value, otherwise the export method will be executed on the
@@ -122,46 +298,171 @@ namespace kagome::runtime::binaryen {
         std::string_view name,
         const boost::optional<common::Hash256> &state_root,
         CallPersistency persistency,
+        std::vector<common::Buffer> *accessed_keys,
         Args &&... args) {
+      // the arguments are encoded right into the memory of the instance
+      size_t args_size = 0;
+      if constexpr (sizeof...(args) > 0) {
+        OUTCOME_TRY(size, scale::encodedSize(args...));
+        args_size = size;
+      }
+      auto write_args = [&](gsl::span<uint8_t> out) -> outcome::result<void> {
+        if constexpr (sizeof...(args) > 0) {
+          OUTCOME_TRY(scale::encodeInto(out, args...));
+        }
+        return outcome::success();
+      };
+
+      constexpr bool has_result = not std::is_same_v<void, R>;
+      OUTCOME_TRY(result,
+                  callExport(name,
+                             state_root,
+                             persistency,
+                             accessed_keys,
+                             args_size,
+                             write_args,
+                             has_result));
+      if constexpr (has_result) {
+        // TODO (yuraz) PRE-98: after check for memory overflow is done,
+        //  refactor it
+        return scale::decode<R>(std::move(result));
+      } else {
+        return outcome::success();
+      }
+    }
+
+    /**
+     * Writes the encoded arguments of a call to the memory of the instance
+     */
+    using ArgsWriter =
+        std::function<outcome::result<void>(gsl::span<uint8_t>)>;
+
+    /**
+     * Calls export method \arg name with the arguments \arg args_size bytes
+     * long, which \arg write_args writes
+     * @param accessed_keys receives the keys of the state accessed by the
+     * call, if not null
+     * @param has_result whether the method returns a value, otherwise the
+     * changes of a persistent call are written back
+     * @param span_name names the span of the call instead of \arg name,
+     * which does not outlive the tracer, if not empty
+     * @return the encoded result, empty if there is none
+     */
+    outcome::result<common::Buffer> callExport(
+        std::string_view name,
+        const boost::optional<common::Hash256> &state_root,
+        CallPersistency persistency,
+        std::vector<common::Buffer> *accessed_keys,
+        size_t args_size,
+        const ArgsWriter &write_args,
+        bool has_result,
+        std::string_view span_name = {}) {
       logger_->debug("Executing export function: {}", name);
+      // the names of the exports are literals of the apis, the others are
+      // traced under a literal \arg span_name
+      common::Tracer::Scope span{runtime_manager_->tracer().get(),
+                                 "runtime",
+                                 span_name.empty() ? name : span_name};
       if (state_root.has_value()) {
         logger_->debug("Resetting state to: {}", state_root.value().toHex());
       }
 
-      auto environment = createRuntimeEnvironment(persistency, state_root);
-      auto &&[module, memory, opt_batch] = environment;
+      auto held = heldEnvironment(persistency, state_root);
+      if (held) {
+        // the previous call left the memory of the instance dirty
+        held->restore_memory();
+      }
+      auto environment =
+          held ? std::move(held.value())
+               : createRuntimeEnvironment(persistency, state_root);
+      auto &&[module,
+              memory,
+              opt_batch,
+              restore_memory,
+              storage_provider,
+              discard] = environment;
+      if (accessed_keys != nullptr) {
+        storage_provider->startAccessRecording();
+      }
+      auto finish_recording = gsl::finally([&environment, accessed_keys] {
+        if (accessed_keys != nullptr) {
+          *accessed_keys =
+              environment.storage_provider->finishAccessRecording();
+        }
+      });
+
+      // growing the memory during the call copies it each time, so it is
+      // grown at once to the size the previous calls of the export needed
+      if (auto peak = runtime_manager_->memoryPeak(name);
+          peak > memory->size()) {
+        memory->resize(peak);
+      }
+
+      // a failed call, even a trapped one, might leave the instance dirty
+      // beyond the memory, so it is not reused then; a held one is dropped
+      // once it is released
+      bool called = false;
+      auto discard_failed = gsl::finally([&called, &discard] {
+        if (not called) {
+          discard();
+        }
+      });
 
       runtime::WasmPointer ptr = 0u;
       runtime::WasmSize len = 0u;
 
-      if constexpr (sizeof...(args) > 0) {
-        OUTCOME_TRY(buffer, scale::encode(std::forward<Args>(args)...));
-        len = buffer.size();
+      if (args_size != 0) {
+        len = args_size;
         ptr = memory->allocate(len);
-        memory->storeBuffer(ptr, common::Buffer(std::move(buffer)));
+        // a view out of the memory is empty, and is not written then
+        auto view = memory->mutableView(ptr, len);
+        OUTCOME_TRY(write_args(view ? view.value() : gsl::span<uint8_t>{}));
       }
 
       wasm::LiteralList ll{wasm::Literal(ptr), wasm::Literal(len)};
 
       wasm::Name wasm_name = std::string(name);
 
-      OUTCOME_TRY(res, executor_.call(*module, wasm_name, ll));
+      OUTCOME_TRY(res, [&] {
+        if (const auto &profiler = runtime_manager_->profiler();
+            profiler != nullptr and profiler->isEnabled()) {
+          auto timer = profiler->exportTimer(name);
+          return executor_.call(*module, wasm_name, ll);
+        }
+        return executor_.call(*module, wasm_name, ll);
+      }());
+      called = true;
+      runtime_manager_->recordMemoryPeak(name, memory->size());
+      if (const auto &profiler = runtime_manager_->profiler();
+          profiler != nullptr and profiler->isEnabled()) {
+        profiler->recordHeap(name, memory->allocatorStats());
+      }
       memory->reset();
-      if constexpr (!std::is_same_v<void, R>) {
+      common::Buffer result;
+      if (has_result) {
         WasmResult r(res.geti64());
-        auto buffer = memory->loadN(r.address, r.length);
-        // TODO (yuraz) PRE-98: after check for memory overflow is done,
-        //  refactor it
-        return scale::decode<R>(std::move(buffer));
-      }
-
-      if(opt_batch) {
+        result = memory->loadN(r.address, r.length);
+      } else if (opt_batch) {
         OUTCOME_TRY(opt_batch.value()->writeBack());
       }
-      return outcome::success();
+      // the environment is still held, so no other persistent call replaces
+      // the batch before it is committed
+      if (persistency == CallPersistency::COMMITTED) {
+        common::Tracer::Scope commit_span{
+            runtime_manager_->tracer().get(), "runtime", "commit_state"};
+        OUTCOME_TRY(runtime_manager_->commitPersistentState());
+      }
+      return result;
     }
+
     std::shared_ptr<RuntimeManager> runtime_manager_;
     WasmExecutor executor_;
+    RuntimeCallCache pure_calls_{kPureCallsCacheSize};
+
+    std::mutex held_mutex_;
+    boost::optional<RuntimeManager::RuntimeEnvironment> held_environment_;
+    std::thread::id held_environment_owner_;
+
     common::Logger logger_ = common::createLogger("Runtime API");
   };
 }  // namespace kagome::runtime::binaryen
@@ -9,15 +9,28 @@ namespace kagome::runtime::binaryen {
   using primitives::TransactionValidity;
 
   TaggedTransactionQueueImpl::TaggedTransactionQueueImpl(
-      const std::shared_ptr<RuntimeManager> &runtime_manager)
-      : RuntimeApi(runtime_manager) {}
+      const std::shared_ptr<RuntimeManager> &runtime_manager,
+      std::shared_ptr<storage::trie::StatePrefetcher> prefetcher)
+      : RuntimeApi(runtime_manager), prefetcher_{std::move(prefetcher)} {}
 
   outcome::result<primitives::TransactionValidity>
   TaggedTransactionQueueImpl::validate_transaction(
       const primitives::Extrinsic &ext) {
-    return execute<TransactionValidity>(
+    if (prefetcher_ == nullptr) {
+      return execute<TransactionValidity>(
+          "TaggedTransactionQueue_validate_transaction",
+          CallPersistency::EPHEMERAL,
+          ext);
+    }
+    // the transaction accesses mostly the same keys once it is in a block
+    std::vector<common::Buffer> accessed_keys;
+    auto res = executeRecordingAccess<TransactionValidity>(
         "TaggedTransactionQueue_validate_transaction",
+        boost::none,
         CallPersistency::EPHEMERAL,
+        accessed_keys,
         ext);
+    prefetcher_->recordExtrinsic(ext, std::move(accessed_keys));
+    return res;
   }
 }  // namespace kagome::runtime::binaryen
@@ -8,19 +8,29 @@
 
 #include "runtime/binaryen/runtime_api/runtime_api.hpp"
 #include "runtime/tagged_transaction_queue.hpp"
+#include "storage/trie/impl/state_prefetcher.hpp"
 
 namespace kagome::runtime::binaryen {
 
   class TaggedTransactionQueueImpl : public RuntimeApi,
                                      public TaggedTransactionQueue {
    public:
+    /**
+     * @param prefetcher remembers the keys of the state accessed by the
+     * validated transactions to prefetch them for the blocks including them,
+     * nullptr if there is no prefetching
+     */
     explicit TaggedTransactionQueueImpl(
-        const std::shared_ptr<RuntimeManager> &runtime_manager);
+        const std::shared_ptr<RuntimeManager> &runtime_manager,
+        std::shared_ptr<storage::trie::StatePrefetcher> prefetcher = nullptr);
 
     ~TaggedTransactionQueueImpl() override = default;
 
     outcome::result<primitives::TransactionValidity> validate_transaction(
         const primitives::Extrinsic &ext) override;
+
+   private:
+    std::shared_ptr<storage::trie::StatePrefetcher> prefetcher_;
   };
 }  // namespace kagome::runtime::binaryen
 
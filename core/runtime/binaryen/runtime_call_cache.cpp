@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_call_cache.hpp"
+
+#include "scale/scale.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  RuntimeCallCache::RuntimeCallCache(size_t capacity) : capacity_{capacity} {
+    BOOST_ASSERT(capacity_ > 0);
+  }
+
+  common::Buffer RuntimeCallCache::makeKey(const common::Hash256 &code_hash,
+                                           const common::Buffer &state_root,
+                                           std::string_view name,
+                                           const common::Buffer &args) {
+    // the parts of variable length are prefixed with their lengths, so that
+    // the keys of different calls never match
+    return common::Buffer{
+        scale::encode(code_hash, state_root, std::string(name), args)
+            .value()};
+  }
+
+  boost::optional<common::Buffer> RuntimeCallCache::get(
+      const common::Buffer &key) {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return boost::none;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  void RuntimeCallCache::put(const common::Buffer &key,
+                             common::Buffer result) {
+    std::lock_guard lock{mutex_};
+    if (auto it = index_.find(key); it != index_.end()) {
+      it->second->second = std::move(result);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    if (entries_.size() == capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(key, std::move(result));
+    index_.emplace(key, entries_.begin());
+  }
+
+  size_t RuntimeCallCache::size() const {
+    std::lock_guard lock{mutex_};
+    return entries_.size();
+  }
+
+}  // namespace kagome::runtime::binaryen
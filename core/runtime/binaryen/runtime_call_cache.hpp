@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_CALL_CACHE
+#define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_CALL_CACHE
+
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Encoded results of the runtime calls, which depend only on the code, the
+   * state and the arguments, e.g. the queries of the runtime version.
+   * Keeps up to a number of results, evicting the least recently used ones
+   */
+  class RuntimeCallCache {
+   public:
+    /**
+     * @param capacity max number of the results kept, at least 1
+     */
+    explicit RuntimeCallCache(size_t capacity);
+
+    /**
+     * @return key of a call of export method \arg name with SCALE encoded
+     * \arg args on the state with \arg state_root of the code with
+     * \arg code_hash
+     */
+    static common::Buffer makeKey(const common::Hash256 &code_hash,
+                                  const common::Buffer &state_root,
+                                  std::string_view name,
+                                  const common::Buffer &args);
+
+    /**
+     * @return result of the call with \arg key, none if it is not cached
+     */
+    boost::optional<common::Buffer> get(const common::Buffer &key);
+
+    void put(const common::Buffer &key, common::Buffer result);
+
+    size_t size() const;
+
+   private:
+    using Entry = std::pair<common::Buffer, common::Buffer>;
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    // the most recently used entries first
+    std::list<Entry> entries_;
+    std::unordered_map<common::Buffer, std::list<Entry>::iterator> index_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_CALL_CACHE
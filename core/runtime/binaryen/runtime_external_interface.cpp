@@ -15,6 +15,8 @@ namespace kagome::runtime::binaryen {
   const static wasm::Name ext_free = "ext_free";
 
   const static wasm::Name ext_clear_prefix = "ext_clear_prefix";
+  const static wasm::Name ext_storage_clear_prefix_version_2 =
+      "ext_storage_clear_prefix_version_2";
   const static wasm::Name ext_clear_storage = "ext_clear_storage";
   const static wasm::Name ext_exists_storage = "ext_exists_storage";
   const static wasm::Name ext_get_allocated_storage =
@@ -70,12 +72,67 @@ namespace kagome::runtime::binaryen {
   const static wasm::Name ext_sr25519_verify_v2 =
       "ext_crypto_sr25519_verify_version_2";
 
+  const static wasm::Name ext_start_batch_verify_v1 =
+      "ext_crypto_start_batch_verify_version_1";
+  const static wasm::Name ext_finish_batch_verify_v1 =
+      "ext_crypto_finish_batch_verify_version_1";
+  const static wasm::Name ext_ed25519_batch_verify_v1 =
+      "ext_crypto_ed25519_batch_verify_version_1";
+  const static wasm::Name ext_sr25519_batch_verify_v1 =
+      "ext_crypto_sr25519_batch_verify_version_1";
+
   const static wasm::Name ext_secp256k1_ecdsa_recover_v1 =
       "ext_crypto_secp256k1_ecdsa_recover_version_1";
   const static wasm::Name ext_secp256k1_ecdsa_recover_compressed_v1 =
       "ext_crypto_secp256k1_ecdsa_recover_compressed_version_1";
 
   const static wasm::Name ext_chain_id = "ext_chain_id";
+
+  // a case of the dispatch of the imports in callImport
+  enum class RuntimeExternalInterface::HostFunction : uint8_t {
+    ext_malloc,
+    ext_free,
+    ext_clear_prefix,
+    ext_storage_clear_prefix_version_2,
+    ext_clear_storage,
+    ext_exists_storage,
+    ext_get_allocated_storage,
+    ext_get_storage_into,
+    ext_storage_read_version_1,
+    ext_set_storage,
+    ext_blake2_256_enumerated_trie_root,
+    ext_storage_changes_root,
+    ext_storage_root,
+    ext_print_hex,
+    ext_logging_log_version_1,
+    ext_print_num,
+    ext_print_utf8,
+    ext_blake2_128,
+    ext_blake2_256,
+    ext_keccak_256,
+    ext_ed25519_verify,
+    ext_sr25519_verify,
+    ext_twox_64,
+    ext_twox_128,
+    ext_twox_256,
+    ext_chain_id,
+    ext_ed25519_public_keys_v1,
+    ext_ed25519_generate_v1,
+    ext_ed25519_sign_v1,
+    ext_ed25519_verify_v1,
+    ext_sr25519_public_keys_v1,
+    ext_sr25519_generate_v1,
+    ext_sr25519_sign_v1,
+    ext_sr25519_verify_v2,
+    ext_start_batch_verify_v1,
+    ext_finish_batch_verify_v1,
+    ext_ed25519_batch_verify_v1,
+    ext_sr25519_batch_verify_v1,
+    ext_secp256k1_ecdsa_recover_v1,
+    ext_secp256k1_ecdsa_recover_compressed_v1,
+    kUnknown,
+  };
+
   /**
    * @note: some implementation details were taken from
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h
@@ -83,60 +140,167 @@ namespace kagome::runtime::binaryen {
 
   RuntimeExternalInterface::RuntimeExternalInterface(
       const std::shared_ptr<extensions::ExtensionFactory> &extension_factory,
-      std::shared_ptr<TrieStorageProvider> storage_provider) {
+      std::shared_ptr<TrieStorageProvider> storage_provider,
+      std::shared_ptr<RuntimeProfiler> profiler,
+      std::shared_ptr<common::Tracer> tracer)
+      : profiler_{std::move(profiler)}, tracer_{std::move(tracer)} {
     BOOST_ASSERT_MSG(extension_factory != nullptr,
                      "extension factory is nullptr");
     BOOST_ASSERT_MSG(storage_provider != nullptr,
                      "storage provider is nullptr");
-    auto memory_impl =
-        std::make_shared<WasmMemoryImpl>(&(ShellExternalInterface::memory));
+    memory_impl_ = std::make_shared<WasmMemoryImpl>(
+        WasmMemoryImpl::kDefaultSize, profiler_);
     extension_ = extension_factory->createExtension(
-        memory_impl, std::move(storage_provider));
+        memory_impl_, std::move(storage_provider));
+  }
+
+  void RuntimeExternalInterface::init(wasm::Module &wasm,
+                                      wasm::ModuleInstance &instance) {
+    // the base applies the data segments to its own memory, which are then
+    // moved to the memory used by both the wasm code and the host functions
+    ShellExternalInterface::init(wasm, instance);
+    auto initial_size =
+        static_cast<WasmSize>(wasm.memory.initial * wasm::Memory::kPageSize);
+    memory_impl_->resize(std::max(memory_impl_->size(), initial_size));
+    for (WasmPointer i = 0; i < initial_size; i++) {
+      memory_impl_->store8(i, ShellExternalInterface::memory.get<int8_t>(i));
+    }
+    ShellExternalInterface::memory.resize(0);
+  }
+
+  void RuntimeExternalInterface::growMemory(wasm::Address /*oldSize*/,
+                                            wasm::Address newSize) {
+    // the host allocator might have grown the memory more already
+    memory_impl_->resize(std::max<WasmSize>(memory_impl_->size(), newSize));
+  }
+
+  int8_t RuntimeExternalInterface::load8s(wasm::Address addr) {
+    return memory_impl_->load8s(addr);
+  }
+
+  uint8_t RuntimeExternalInterface::load8u(wasm::Address addr) {
+    return memory_impl_->load8u(addr);
+  }
+
+  int16_t RuntimeExternalInterface::load16s(wasm::Address addr) {
+    return memory_impl_->load16s(addr);
+  }
+
+  uint16_t RuntimeExternalInterface::load16u(wasm::Address addr) {
+    return memory_impl_->load16u(addr);
+  }
+
+  int32_t RuntimeExternalInterface::load32s(wasm::Address addr) {
+    return memory_impl_->load32s(addr);
+  }
+
+  uint32_t RuntimeExternalInterface::load32u(wasm::Address addr) {
+    return memory_impl_->load32u(addr);
+  }
+
+  int64_t RuntimeExternalInterface::load64s(wasm::Address addr) {
+    return memory_impl_->load64s(addr);
+  }
+
+  uint64_t RuntimeExternalInterface::load64u(wasm::Address addr) {
+    return memory_impl_->load64u(addr);
+  }
+
+  std::array<uint8_t, 16> RuntimeExternalInterface::load128(
+      wasm::Address addr) {
+    return memory_impl_->load128(addr);
+  }
+
+  void RuntimeExternalInterface::store8(wasm::Address addr, int8_t value) {
+    memory_impl_->store8(addr, value);
+  }
+
+  void RuntimeExternalInterface::store16(wasm::Address addr, int16_t value) {
+    memory_impl_->store16(addr, value);
+  }
+
+  void RuntimeExternalInterface::store32(wasm::Address addr, int32_t value) {
+    memory_impl_->store32(addr, value);
+  }
+
+  void RuntimeExternalInterface::store64(wasm::Address addr, int64_t value) {
+    memory_impl_->store64(addr, value);
+  }
+
+  void RuntimeExternalInterface::store128(
+      wasm::Address addr, const std::array<uint8_t, 16> &value) {
+    memory_impl_->store128(addr, value);
+  }
+
+  void RuntimeExternalInterface::snapshotMemory() {
+    memory_impl_->snapshot();
+  }
+
+  void RuntimeExternalInterface::restoreMemory() {
+    memory_impl_->restore();
   }
 
   wasm::Literal RuntimeExternalInterface::callImport(
       wasm::Function *import, wasm::LiteralList &arguments) {
-    // TODO(kamilsa): PRE-359 Replace ifs with switch case
-    if (import->module == env) {
+    // names of the imports are interned by binaryen, so they outlive the
+    // timer and the span
+    common::Tracer::Scope span{tracer_.get(), "host", import->base.str};
+    if (profiler_ != nullptr and profiler_->isEnabled()) {
+      auto timer = profiler_->hostCallTimer(import->base.str);
+      return dispatchImport(import, arguments);
+    }
+    return dispatchImport(import, arguments);
+  }
+
+  wasm::Literal RuntimeExternalInterface::dispatchImport(
+      wasm::Function *import, wasm::LiteralList &arguments) {
+    switch (resolveImport(import)) {
       /// memory externals
       /// ext_malloc
-      if (import->base == ext_malloc) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_malloc: {
+        checkArguments(import->base, 1, arguments.size());
         auto ptr = extension_->ext_malloc(arguments.at(0).geti32());
         return wasm::Literal(ptr);
       }
       /// ext_free
-      if (import->base == ext_free) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_free: {
+        checkArguments(import->base, 1, arguments.size());
         extension_->ext_free(arguments.at(0).geti32());
         return wasm::Literal();
       }
       /// storage externals
 
       /// ext_clear_prefix
-      if (import->base == ext_clear_prefix) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_clear_prefix: {
+        checkArguments(import->base, 2, arguments.size());
         extension_->ext_clear_prefix(arguments.at(0).geti32(),
                                      arguments.at(1).geti32());
         return wasm::Literal();
       }
+      /// ext_storage_clear_prefix_version_2
+      case HostFunction::ext_storage_clear_prefix_version_2: {
+        checkArguments(import->base, 2, arguments.size());
+        auto res = extension_->ext_storage_clear_prefix_version_2(
+            arguments.at(0).geti64(), arguments.at(1).geti64());
+        return wasm::Literal(res);
+      }
       /// ext_clear_storage
-      if (import->base == ext_clear_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_clear_storage: {
+        checkArguments(import->base, 2, arguments.size());
         extension_->ext_clear_storage(arguments.at(0).geti32(),
                                       arguments.at(1).geti32());
         return wasm::Literal();
       }
       /// ext_exists_storage
-      if (import->base == ext_exists_storage) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_exists_storage: {
+        checkArguments(import->base, 2, arguments.size());
         auto storage_exists = extension_->ext_exists_storage(
             arguments.at(0).geti32(), arguments.at(1).geti32());
         return wasm::Literal(storage_exists);
       }
       /// ext_get_allocated_storage
-      if (import->base == ext_get_allocated_storage) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_get_allocated_storage: {
+        checkArguments(import->base, 3, arguments.size());
         auto ptr =
             extension_->ext_get_allocated_storage(arguments.at(0).geti32(),
                                                   arguments.at(1).geti32(),
@@ -144,8 +308,8 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal(ptr);
       }
       /// ext_get_storage_into
-      if (import->base == ext_get_storage_into) {
-        checkArguments(import->base.c_str(), 5, arguments.size());
+      case HostFunction::ext_get_storage_into: {
+        checkArguments(import->base, 5, arguments.size());
         auto res = extension_->ext_get_storage_into(arguments.at(0).geti32(),
                                                     arguments.at(1).geti32(),
                                                     arguments.at(2).geti32(),
@@ -154,8 +318,8 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal(res);
       }
       /// ext_storage_read_version_1
-      if (import->base == ext_storage_read_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_storage_read_version_1: {
+        checkArguments(import->base, 3, arguments.size());
         auto res =
             extension_->ext_storage_read_version_1(arguments.at(0).geti64(),
                                                    arguments.at(1).geti64(),
@@ -163,8 +327,8 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal(res);
       }
       /// ext_set_storage
-      if (import->base == ext_set_storage) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
+      case HostFunction::ext_set_storage: {
+        checkArguments(import->base, 4, arguments.size());
         extension_->ext_set_storage(arguments.at(0).geti32(),
                                     arguments.at(1).geti32(),
                                     arguments.at(2).geti32(),
@@ -172,8 +336,8 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal();
       }
       /// ext_blake2_256_enumerated_trie_root
-      if (import->base == ext_blake2_256_enumerated_trie_root) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
+      case HostFunction::ext_blake2_256_enumerated_trie_root: {
+        checkArguments(import->base, 4, arguments.size());
         extension_->ext_blake2_256_enumerated_trie_root(
             arguments.at(0).geti32(),
             arguments.at(1).geti32(),
@@ -182,15 +346,15 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal();
       }
       /// ext_storage_changes_root
-      if (import->base == ext_storage_changes_root) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_storage_changes_root: {
+        checkArguments(import->base, 3, arguments.size());
         auto res = extension_->ext_storage_changes_root(
             arguments.at(0).geti32(), arguments.at(2).geti32());
         return wasm::Literal(res);
       }
       /// ext_storage_root
-      if (import->base == ext_storage_root) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_storage_root: {
+        checkArguments(import->base, 1, arguments.size());
         extension_->ext_storage_root(arguments.at(0).geti32());
         return wasm::Literal();
       }
@@ -198,29 +362,29 @@ namespace kagome::runtime::binaryen {
       /// IO extensions
 
       /// ext_print_hex
-      if (import->base == ext_print_hex) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_print_hex: {
+        checkArguments(import->base, 2, arguments.size());
         extension_->ext_print_hex(arguments.at(0).geti32(),
                                   arguments.at(1).geti32());
         return wasm::Literal();
       }
       /// ext_logging_log_version_1
-      if (import->base == ext_logging_log_version_1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_logging_log_version_1: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_logging_log_version_1(arguments.at(0).geti32(),
                                               arguments.at(1).geti64(),
                                               arguments.at(2).geti64());
         return wasm::Literal();
       }
       /// ext_print_num
-      if (import->base == ext_print_num) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_print_num: {
+        checkArguments(import->base, 1, arguments.size());
         extension_->ext_print_num(arguments.at(0).geti64());
         return wasm::Literal();
       }
       /// ext_print_utf8
-      if (import->base == ext_print_utf8) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_print_utf8: {
+        checkArguments(import->base, 2, arguments.size());
         extension_->ext_print_utf8(arguments.at(0).geti32(),
                                    arguments.at(1).geti32());
         return wasm::Literal();
@@ -228,8 +392,8 @@ namespace kagome::runtime::binaryen {
 
       /// Cryptographic extensions
       /// ext_blake2_128
-      if (import->base == ext_blake2_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_blake2_128: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_blake2_128(arguments.at(0).geti32(),
                                    arguments.at(1).geti32(),
                                    arguments.at(2).geti32());
@@ -237,8 +401,8 @@ namespace kagome::runtime::binaryen {
       }
 
       /// ext_blake2_256
-      if (import->base == ext_blake2_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_blake2_256: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_blake2_256(arguments.at(0).geti32(),
                                    arguments.at(1).geti32(),
                                    arguments.at(2).geti32());
@@ -246,8 +410,8 @@ namespace kagome::runtime::binaryen {
       }
 
       /// ext_keccak_256
-      if (import->base == ext_keccak_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_keccak_256: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_keccak_256(arguments.at(0).geti32(),
                                    arguments.at(1).geti32(),
                                    arguments.at(2).geti32());
@@ -255,8 +419,8 @@ namespace kagome::runtime::binaryen {
       }
 
       /// ext_ed25519_verify
-      if (import->base == ext_ed25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
+      case HostFunction::ext_ed25519_verify: {
+        checkArguments(import->base, 4, arguments.size());
         auto res = extension_->ext_ed25519_verify(arguments.at(0).geti32(),
                                                   arguments.at(1).geti32(),
                                                   arguments.at(2).geti32(),
@@ -264,8 +428,8 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal(res);
       }
       /// ext_sr25519_verify
-      if (import->base == ext_sr25519_verify) {
-        checkArguments(import->base.c_str(), 4, arguments.size());
+      case HostFunction::ext_sr25519_verify: {
+        checkArguments(import->base, 4, arguments.size());
         auto res = extension_->ext_sr25519_verify(arguments.at(0).geti32(),
                                                   arguments.at(1).geti32(),
                                                   arguments.at(2).geti32(),
@@ -273,24 +437,24 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal(res);
       }
       /// ext_twox_64
-      if (import->base == ext_twox_64) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_twox_64: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_twox_64(arguments.at(0).geti32(),
                                 arguments.at(1).geti32(),
                                 arguments.at(2).geti32());
         return wasm::Literal();
       }
       /// ext_twox_128
-      if (import->base == ext_twox_128) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_twox_128: {
+        checkArguments(import->base, 3, arguments.size());
         extension_->ext_twox_128(arguments.at(0).geti32(),
                                  arguments.at(1).geti32(),
                                  arguments.at(2).geti32());
         return wasm::Literal();
       }
       /// ext_twox_256
-      if (import->base == ext_twox_256) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_twox_256: {
+        checkArguments(import->base, 3, arguments.size());
 
         extension_->ext_twox_256(arguments.at(0).geti32(),
                                  arguments.at(1).geti32(),
@@ -298,101 +462,203 @@ namespace kagome::runtime::binaryen {
         return wasm::Literal();
       }
       /// ext_chain_id
-      if (import->base == ext_chain_id) {
-        checkArguments(import->base.c_str(), 0, arguments.size());
+      case HostFunction::ext_chain_id: {
+        checkArguments(import->base, 0, arguments.size());
         auto res = extension_->ext_chain_id();
         return wasm::Literal(res);
       }
 
       /// crypto version 1
-      if (import->base == ext_ed25519_public_keys_v1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_ed25519_public_keys_v1: {
+        checkArguments(import->base, 1, arguments.size());
         auto res =
             extension_->ext_ed25519_public_keys_v1(arguments.at(0).geti32());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_ed25519_generate_v1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_ed25519_generate_v1: {
+        checkArguments(import->base, 2, arguments.size());
         auto res = extension_->ext_ed25519_generate_v1(
             arguments.at(0).geti32(), arguments.at(1).geti64());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_ed25519_sign_v1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_ed25519_sign_v1: {
+        checkArguments(import->base, 3, arguments.size());
         auto res = extension_->ext_ed25519_sign_v1(arguments.at(0).geti32(),
                                                    arguments.at(1).geti32(),
                                                    arguments.at(2).geti64());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_ed25519_verify_v1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_ed25519_verify_v1: {
+        checkArguments(import->base, 3, arguments.size());
         auto res = extension_->ext_ed25519_verify_v1(arguments.at(0).geti32(),
                                                      arguments.at(1).geti64(),
                                                      arguments.at(2).geti32());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_sr25519_public_keys_v1) {
-        checkArguments(import->base.c_str(), 1, arguments.size());
+      case HostFunction::ext_sr25519_public_keys_v1: {
+        checkArguments(import->base, 1, arguments.size());
         auto res =
             extension_->ext_sr25519_public_keys_v1(arguments.at(0).geti32());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_sr25519_generate_v1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_sr25519_generate_v1: {
+        checkArguments(import->base, 2, arguments.size());
         auto res = extension_->ext_sr25519_generate_v1(
             arguments.at(0).geti32(), arguments.at(1).geti64());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_sr25519_sign_v1) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_sr25519_sign_v1: {
+        checkArguments(import->base, 3, arguments.size());
         auto res = extension_->ext_sr25519_sign_v1(arguments.at(0).geti32(),
                                                    arguments.at(1).geti32(),
                                                    arguments.at(2).geti64());
         return wasm::Literal(res);
       }
 
-      if (import->base == ext_sr25519_verify_v2) {
-        checkArguments(import->base.c_str(), 3, arguments.size());
+      case HostFunction::ext_sr25519_verify_v2: {
+        checkArguments(import->base, 3, arguments.size());
         auto res = extension_->ext_sr25519_verify_v1(arguments.at(0).geti32(),
                                                      arguments.at(1).geti64(),
                                                      arguments.at(2).geti32());
         return wasm::Literal(res);
       }
 
+      case HostFunction::ext_start_batch_verify_v1: {
+        checkArguments(import->base, 0, arguments.size());
+        extension_->ext_start_batch_verify_v1();
+        return wasm::Literal();
+      }
+
+      case HostFunction::ext_finish_batch_verify_v1: {
+        checkArguments(import->base, 0, arguments.size());
+        auto res = extension_->ext_finish_batch_verify_v1();
+        return wasm::Literal(res);
+      }
+
+      case HostFunction::ext_ed25519_batch_verify_v1: {
+        checkArguments(import->base, 3, arguments.size());
+        auto res = extension_->ext_ed25519_batch_verify_v1(
+            arguments.at(0).geti32(),
+            arguments.at(1).geti64(),
+            arguments.at(2).geti32());
+        return wasm::Literal(res);
+      }
+
+      case HostFunction::ext_sr25519_batch_verify_v1: {
+        checkArguments(import->base, 3, arguments.size());
+        auto res = extension_->ext_sr25519_batch_verify_v1(
+            arguments.at(0).geti32(),
+            arguments.at(1).geti64(),
+            arguments.at(2).geti32());
+        return wasm::Literal(res);
+      }
+
       /// ext_secp256k1_ecdsa_recover_v1
-      if (import->base == ext_secp256k1_ecdsa_recover_v1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_secp256k1_ecdsa_recover_v1: {
+        checkArguments(import->base, 2, arguments.size());
         auto res = extension_->ext_crypto_secp256k1_ecdsa_recover_v1(
             arguments.at(0).geti32(), arguments.at(1).geti32());
         return wasm::Literal(res);
       }
 
       /// ext_secp256k1_ecdsa_recover_compressed_v1
-      if (import->base == ext_secp256k1_ecdsa_recover_compressed_v1) {
-        checkArguments(import->base.c_str(), 2, arguments.size());
+      case HostFunction::ext_secp256k1_ecdsa_recover_compressed_v1: {
+        checkArguments(import->base, 2, arguments.size());
         auto res = extension_->ext_crypto_secp256k1_ecdsa_recover_compressed_v1(
             arguments.at(0).geti32(), arguments.at(1).geti32());
         return wasm::Literal(res);
       }
+
+      case HostFunction::kUnknown:
+        break;
     }
 
     wasm::Fatal() << "callImport: unknown import: " << import->module.str << "."
                   << import->name.str;
   }
 
-  void RuntimeExternalInterface::checkArguments(std::string_view extern_name,
+  RuntimeExternalInterface::HostFunction
+  RuntimeExternalInterface::resolveImport(const wasm::Function *import) {
+    auto it = imports_.find(import);
+    if (it != imports_.end()) {
+      return it->second;
+    }
+    // host functions by the names they are imported with
+    static const std::pair<wasm::Name, HostFunction> kHostFunctions[]{
+        {ext_malloc, HostFunction::ext_malloc},
+        {ext_free, HostFunction::ext_free},
+        {ext_clear_prefix, HostFunction::ext_clear_prefix},
+        {ext_storage_clear_prefix_version_2,
+         HostFunction::ext_storage_clear_prefix_version_2},
+        {ext_clear_storage, HostFunction::ext_clear_storage},
+        {ext_exists_storage, HostFunction::ext_exists_storage},
+        {ext_get_allocated_storage, HostFunction::ext_get_allocated_storage},
+        {ext_get_storage_into, HostFunction::ext_get_storage_into},
+        {ext_storage_read_version_1, HostFunction::ext_storage_read_version_1},
+        {ext_set_storage, HostFunction::ext_set_storage},
+        {ext_blake2_256_enumerated_trie_root,
+         HostFunction::ext_blake2_256_enumerated_trie_root},
+        {ext_storage_changes_root, HostFunction::ext_storage_changes_root},
+        {ext_storage_root, HostFunction::ext_storage_root},
+        {ext_print_hex, HostFunction::ext_print_hex},
+        {ext_logging_log_version_1, HostFunction::ext_logging_log_version_1},
+        {ext_print_num, HostFunction::ext_print_num},
+        {ext_print_utf8, HostFunction::ext_print_utf8},
+        {ext_blake2_128, HostFunction::ext_blake2_128},
+        {ext_blake2_256, HostFunction::ext_blake2_256},
+        {ext_keccak_256, HostFunction::ext_keccak_256},
+        {ext_ed25519_verify, HostFunction::ext_ed25519_verify},
+        {ext_sr25519_verify, HostFunction::ext_sr25519_verify},
+        {ext_twox_64, HostFunction::ext_twox_64},
+        {ext_twox_128, HostFunction::ext_twox_128},
+        {ext_twox_256, HostFunction::ext_twox_256},
+        {ext_chain_id, HostFunction::ext_chain_id},
+        {ext_ed25519_public_keys_v1, HostFunction::ext_ed25519_public_keys_v1},
+        {ext_ed25519_generate_v1, HostFunction::ext_ed25519_generate_v1},
+        {ext_ed25519_sign_v1, HostFunction::ext_ed25519_sign_v1},
+        {ext_ed25519_verify_v1, HostFunction::ext_ed25519_verify_v1},
+        {ext_sr25519_public_keys_v1, HostFunction::ext_sr25519_public_keys_v1},
+        {ext_sr25519_generate_v1, HostFunction::ext_sr25519_generate_v1},
+        {ext_sr25519_sign_v1, HostFunction::ext_sr25519_sign_v1},
+        {ext_sr25519_verify_v2, HostFunction::ext_sr25519_verify_v2},
+        {ext_start_batch_verify_v1, HostFunction::ext_start_batch_verify_v1},
+        {ext_finish_batch_verify_v1,
+         HostFunction::ext_finish_batch_verify_v1},
+        {ext_ed25519_batch_verify_v1,
+         HostFunction::ext_ed25519_batch_verify_v1},
+        {ext_sr25519_batch_verify_v1,
+         HostFunction::ext_sr25519_batch_verify_v1},
+        {ext_secp256k1_ecdsa_recover_v1,
+         HostFunction::ext_secp256k1_ecdsa_recover_v1},
+        {ext_secp256k1_ecdsa_recover_compressed_v1,
+         HostFunction::ext_secp256k1_ecdsa_recover_compressed_v1},
+    };
+    auto host_function = HostFunction::kUnknown;
+    if (import->module == env) {
+      for (auto &[name, function] : kHostFunctions) {
+        if (import->base == name) {
+          host_function = function;
+          break;
+        }
+      }
+    }
+    imports_.emplace(import, host_function);
+    return host_function;
+  }
+
+  void RuntimeExternalInterface::checkArguments(wasm::Name extern_name,
                                                 size_t expected,
                                                 size_t actual) {
     if (expected != actual) {
       logger_->error(
           "Wrong number of arguments in {}. Expected: {}. Actual: {}",
-          extern_name,
+          extern_name.str,
           expected,
           actual);
       std::terminate();
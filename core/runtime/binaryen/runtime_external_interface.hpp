@@ -8,8 +8,13 @@
 
 #include <binaryen/shell-interface.h>
 
+#include <unordered_map>
+
 #include "common/logger.hpp"
+#include "common/tracer.hpp"
 #include "extensions/extension_factory.hpp"
+#include "runtime/binaryen/wasm_memory_impl.hpp"
+#include "runtime/runtime_profiler.hpp"
 #include "runtime/wasm_memory.hpp"
 #include "runtime/trie_storage_provider.hpp"
 
@@ -17,27 +22,86 @@ namespace kagome::runtime::binaryen {
 
   class RuntimeExternalInterface : public wasm::ShellExternalInterface {
    public:
+    /**
+     * @param profiler times the host functions and counts the bytes they
+     * copy, if any
+     * @param tracer records the spans of the host functions, if any
+     */
     explicit RuntimeExternalInterface(
         const std::shared_ptr<extensions::ExtensionFactory>& extension_factory,
-        std::shared_ptr<TrieStorageProvider> storage_provider);
+        std::shared_ptr<TrieStorageProvider> storage_provider,
+        std::shared_ptr<RuntimeProfiler> profiler = nullptr,
+        std::shared_ptr<common::Tracer> tracer = nullptr);
+
+    void init(wasm::Module &wasm, wasm::ModuleInstance &instance) override;
 
     wasm::Literal callImport(wasm::Function *import,
                              wasm::LiteralList &arguments) override;
 
+    void growMemory(wasm::Address oldSize, wasm::Address newSize) override;
+
+    // the memory accesses of the wasm code, which go to the same memory the
+    // host functions use instead of the one of the base
+    int8_t load8s(wasm::Address addr) override;
+    uint8_t load8u(wasm::Address addr) override;
+    int16_t load16s(wasm::Address addr) override;
+    uint16_t load16u(wasm::Address addr) override;
+    int32_t load32s(wasm::Address addr) override;
+    uint32_t load32u(wasm::Address addr) override;
+    int64_t load64s(wasm::Address addr) override;
+    uint64_t load64u(wasm::Address addr) override;
+    std::array<uint8_t, 16> load128(wasm::Address addr) override;
+    void store8(wasm::Address addr, int8_t value) override;
+    void store16(wasm::Address addr, int16_t value) override;
+    void store32(wasm::Address addr, int32_t value) override;
+    void store64(wasm::Address addr, int64_t value) override;
+    void store128(wasm::Address addr,
+                  const std::array<uint8_t, 16> &value) override;
+
     inline std::shared_ptr<WasmMemory> memory() const {
       return extension_->memory();
     }
 
+    /**
+     * Makes the current contents of the memory the ones restoreMemory()
+     * brings it back to
+     */
+    void snapshotMemory();
+
+    /**
+     * Brings back the memory contents of the snapshot and resets the
+     * allocator, which costs only the pages written since the snapshot
+     */
+    void restoreMemory();
+
    private:
+    enum class HostFunction : uint8_t;
+
+    /**
+     * @return the host function called by \arg import, which is looked up by
+     * its name on the first call only
+     */
+    HostFunction resolveImport(const wasm::Function *import);
+
+    /**
+     * Calls the host function \arg import refers to
+     */
+    wasm::Literal dispatchImport(wasm::Function *import,
+                                 wasm::LiteralList &arguments);
+
     /**
      * Checks that the number of arguments is as expected and terminates the
      * program if it is not
      */
-    void checkArguments(std::string_view extern_name,
+    void checkArguments(wasm::Name extern_name,
                         size_t expected,
                         size_t actual);
 
+    std::shared_ptr<RuntimeProfiler> profiler_;
+    std::shared_ptr<common::Tracer> tracer_;
+    std::shared_ptr<WasmMemoryImpl> memory_impl_;
     std::shared_ptr<extensions::Extension> extension_;
+    std::unordered_map<const wasm::Function *, HostFunction> imports_;
     common::Logger logger_ = common::createLogger(kDefaultLoggerTag);
 
     constexpr static auto kDefaultLoggerTag = "Runtime external interface";
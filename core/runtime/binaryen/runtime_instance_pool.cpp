@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_instance_pool.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  RuntimeInstancePool::RuntimeInstancePool(size_t capacity, Factory factory)
+      : capacity_{capacity}, factory_{std::move(factory)} {
+    BOOST_ASSERT(capacity_ > 0);
+    BOOST_ASSERT(factory_);
+  }
+
+  outcome::result<std::shared_ptr<RuntimeInstance>>
+  RuntimeInstancePool::acquire() {
+    std::unique_ptr<RuntimeInstance> instance;
+    {
+      std::unique_lock lock{mutex_};
+      released_.wait(lock, [this] {
+        return not idle_.empty() or instances_num_ < capacity_;
+      });
+      if (not idle_.empty()) {
+        instance = std::move(idle_.back());
+        idle_.pop_back();
+      } else {
+        instances_num_++;
+      }
+    }
+
+    if (instance != nullptr) {
+      instance->external_interface->restoreMemory();
+    } else {
+      // parsing and instantiating the code takes long, so it is done
+      // without the lock
+      auto created = factory_();
+      if (not created) {
+        std::lock_guard lock{mutex_};
+        instances_num_--;
+        released_.notify_one();
+        return created.error();
+      }
+      instance = std::move(created.value());
+      instance->external_interface->snapshotMemory();
+    }
+
+    auto self = shared_from_this();
+    return std::shared_ptr<RuntimeInstance>(
+        instance.release(), [self](RuntimeInstance *released) {
+          self->release(std::unique_ptr<RuntimeInstance>(released));
+        });
+  }
+
+  outcome::result<void> RuntimeInstancePool::prepare() {
+    {
+      std::lock_guard lock{mutex_};
+      if (instances_num_ != 0) {
+        return outcome::success();
+      }
+      instances_num_++;
+    }
+    auto created = factory_();
+    if (not created) {
+      std::lock_guard lock{mutex_};
+      instances_num_--;
+      released_.notify_one();
+      return created.error();
+    }
+    created.value()->external_interface->snapshotMemory();
+    release(std::move(created.value()));
+    return outcome::success();
+  }
+
+  size_t RuntimeInstancePool::size() const {
+    std::lock_guard lock{mutex_};
+    return instances_num_;
+  }
+
+  void RuntimeInstancePool::release(
+      std::unique_ptr<RuntimeInstance> instance) {
+    {
+      std::lock_guard lock{mutex_};
+      if (instance->broken) {
+        instances_num_--;
+      } else {
+        idle_.push_back(std::move(instance));
+      }
+    }
+    // a broken instance is destroyed out of the lock
+    released_.notify_one();
+  }
+
+}  // namespace kagome::runtime::binaryen
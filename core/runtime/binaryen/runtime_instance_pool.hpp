@@ -0,0 +1,89 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_INSTANCE_POOL
+#define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_INSTANCE_POOL
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "outcome/outcome.hpp"
+#include "runtime/binaryen/module/wasm_module.hpp"
+#include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/trie_storage_provider.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * A module instantiated with its own external interface, hence its own
+   * memory, and bound to a storage provider
+   */
+  struct RuntimeInstance {
+    std::shared_ptr<TrieStorageProvider> storage_provider;
+    std::shared_ptr<RuntimeExternalInterface> external_interface;
+    std::unique_ptr<WasmModule> module;
+    // set once a call fails, as it might have left the globals, e.g. the
+    // stack pointer, dirty, while only the memory is restored on reuse
+    bool broken = false;
+  };
+
+  /**
+   * Keeps up to a number of instances of the same code, so that calls made
+   * in parallel use different ones instead of sharing the memory.
+   * Instances are created on demand and reused afterwards
+   */
+  class RuntimeInstancePool
+      : public std::enable_shared_from_this<RuntimeInstancePool> {
+   public:
+    using Factory =
+        std::function<outcome::result<std::unique_ptr<RuntimeInstance>>()>;
+
+    /**
+     * @param capacity max number of instances, at least 1
+     * @param factory creates a new instance, the memory of which is
+     * snapshotted by the pool right after that
+     */
+    RuntimeInstancePool(size_t capacity, Factory factory);
+
+    /**
+     * Takes an idle instance with its memory restored to the state right
+     * after the instantiation, as if it was a fresh one, or creates a new
+     * one if there is none and the pool is not full, or waits for an
+     * instance to be returned otherwise
+     * @return the instance, which is returned to the pool once released,
+     * unless it is broken, then it is dropped, so that a new one is created
+     * instead
+     */
+    outcome::result<std::shared_ptr<RuntimeInstance>> acquire();
+
+    /**
+     * Creates an idle instance if the pool has none yet, so that the first
+     * acquire() doesn't wait for the creation
+     */
+    outcome::result<void> prepare();
+
+    /**
+     * @return number of the instances created so far
+     */
+    size_t size() const;
+
+   private:
+    void release(std::unique_ptr<RuntimeInstance> instance);
+
+    const size_t capacity_;
+    Factory factory_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    std::vector<std::unique_ptr<RuntimeInstance>> idle_;
+    // including the ones being created
+    size_t instances_num_ = 0;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_INSTANCE_POOL
@@ -7,8 +7,8 @@
 
 #include <gsl/gsl>
 
-#include "crypto/hasher/hasher_impl.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/common/trie_storage_provider_impl.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
                             RuntimeManager::Error,
@@ -22,104 +22,173 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime::binaryen,
 
 namespace kagome::runtime::binaryen {
 
-  thread_local std::shared_ptr<RuntimeExternalInterface>
-      RuntimeManager::external_interface_{};
-
   RuntimeManager::RuntimeManager(
       std::shared_ptr<runtime::WasmProvider> wasm_provider,
       std::shared_ptr<extensions::ExtensionFactory> extension_factory,
       std::shared_ptr<WasmModuleFactory> module_factory,
       std::shared_ptr<TrieStorageProvider> storage_provider,
-      std::shared_ptr<crypto::Hasher> hasher)
+      std::shared_ptr<storage::trie::TrieStorage> trie_storage,
+      size_t instances_num,
+      std::shared_ptr<RuntimeProfiler> profiler,
+      std::shared_ptr<common::Tracer> tracer)
       : wasm_provider_{std::move(wasm_provider)},
         storage_provider_{std::move(storage_provider)},
         extension_factory_{std::move(extension_factory)},
         module_factory_{std::move(module_factory)},
-        hasher_{std::move(hasher)} {
+        trie_storage_{std::move(trie_storage)},
+        instances_num_{instances_num},
+        profiler_{std::move(profiler)},
+        tracer_{std::move(tracer)} {
     BOOST_ASSERT(wasm_provider_);
     BOOST_ASSERT(storage_provider_);
     BOOST_ASSERT(extension_factory_);
     BOOST_ASSERT(module_factory_);
-    BOOST_ASSERT(hasher_);
+    BOOST_ASSERT(instances_num_ > 0);
   }
 
   outcome::result<RuntimeManager::RuntimeEnvironment>
   RuntimeManager::createPersistentRuntimeEnvironmentAt(
       const common::Hash256 &state_root) {
-    OUTCOME_TRY(storage_provider_->setToPersistentAt(state_root));
-    auto env = createRuntimeEnvironment();
-    if (env.has_value()) {
-      env.value().batch =
-          storage_provider_->tryGetPersistentBatch().value()->batchOnTop();
-    }
-    return env;
+    OUTCOME_TRY(instance, acquireInstance(true));
+    OUTCOME_TRY(instance->storage_provider->setToPersistentAt(state_root));
+    return createRuntimeEnvironment(std::move(instance), true);
   }
 
   outcome::result<RuntimeManager::RuntimeEnvironment>
   RuntimeManager::createEphemeralRuntimeEnvironmentAt(
       const common::Hash256 &state_root) {
-    OUTCOME_TRY(storage_provider_->setToEphemeralAt(state_root));
-    return createRuntimeEnvironment();
+    OUTCOME_TRY(instance, acquireInstance(false));
+    OUTCOME_TRY(instance->storage_provider->setToEphemeralAt(state_root));
+    return createRuntimeEnvironment(std::move(instance), false);
   }
 
   outcome::result<RuntimeManager::RuntimeEnvironment>
   RuntimeManager::createPersistentRuntimeEnvironment() {
-    OUTCOME_TRY(storage_provider_->setToPersistent());
-    auto env = createRuntimeEnvironment();
-    if (env.has_value()) {
-      env.value().batch =
-          storage_provider_->tryGetPersistentBatch().value()->batchOnTop();
-    }
-    return env;
+    OUTCOME_TRY(instance, acquireInstance(true));
+    OUTCOME_TRY(instance->storage_provider->setToPersistent());
+    return createRuntimeEnvironment(std::move(instance), true);
   }
 
   outcome::result<RuntimeManager::RuntimeEnvironment>
   RuntimeManager::createEphemeralRuntimeEnvironment() {
-    OUTCOME_TRY(storage_provider_->setToEphemeral());
-    return createRuntimeEnvironment();
+    OUTCOME_TRY(instance, acquireInstance(false));
+    OUTCOME_TRY(instance->storage_provider->setToEphemeral());
+    return createRuntimeEnvironment(std::move(instance), false);
   }
 
-  outcome::result<RuntimeManager::RuntimeEnvironment>
-  RuntimeManager::createRuntimeEnvironment() {
+  size_t RuntimeManager::ephemeralInstancesNum() {
+    auto hash = stateCodeHash();
+    std::lock_guard lock{pools_mutex_};
+    auto &pools = trie_storage_ ? ephemeral_pools_ : persistent_pools_;
+    auto it = pools.find(hash);
+    return it == pools.end() ? 0 : it->second->size();
+  }
+
+  common::Hash256 RuntimeManager::stateCodeHash() const {
+    return wasm_provider_->getStateCodeHash();
+  }
+
+  WasmSize RuntimeManager::memoryPeak(std::string_view name) const {
+    std::lock_guard lock{memory_peaks_mutex_};
+    auto it = memory_peaks_.find(std::string(name));
+    return it == memory_peaks_.end() ? 0 : it->second;
+  }
+
+  void RuntimeManager::recordMemoryPeak(std::string_view name, WasmSize size) {
+    std::lock_guard lock{memory_peaks_mutex_};
+    auto &peak = memory_peaks_[std::string(name)];
+    peak = std::max(peak, size);
+  }
+
+  boost::optional<common::Buffer> RuntimeManager::stateRoot() const {
+    if (trie_storage_ == nullptr) {
+      return boost::none;
+    }
+    return trie_storage_->getRootHash();
+  }
+
+  outcome::result<common::Buffer> RuntimeManager::commitPersistentState() {
+    return storage_provider_->forceCommit();
+  }
+
+  outcome::result<std::shared_ptr<RuntimeInstance>>
+  RuntimeManager::acquireInstance(bool persistent) {
+    auto hash = wasm_provider_->getStateCodeHash();
     const auto &state_code = wasm_provider_->getStateCode();
 
     if (state_code.empty()) {
       return Error::EMPTY_STATE_CODE;
     }
 
-    auto hash = hasher_->twox_256(state_code);
-
-    std::shared_ptr<WasmModule> module;
+    // instances bound to the common storage provider must not be used by
+    // several calls at once, as the provider keeps the batch of a call
+    bool own_storage = not persistent and trie_storage_ != nullptr;
+    return poolOf(hash, state_code, own_storage)->acquire();
+  }
 
-    // Trying retrieve pre-prepared module
-    {
-      std::lock_guard lockGuard(modules_mutex_);
-      auto it = modules_.find(hash);
-      if (it != modules_.end()) {
-        module = it->second;
-      }
+  outcome::result<void> RuntimeManager::prepareInstances(
+      const common::Hash256 &code_hash, const common::Buffer &code) {
+    if (code.empty()) {
+      return Error::EMPTY_STATE_CODE;
     }
-
-    if (!external_interface_) {
-      external_interface_ = std::make_shared<RuntimeExternalInterface>(
-          extension_factory_, storage_provider_);
+    OUTCOME_TRY(poolOf(code_hash, code, false)->prepare());
+    if (trie_storage_ != nullptr) {
+      OUTCOME_TRY(poolOf(code_hash, code, true)->prepare());
     }
+    return outcome::success();
+  }
 
-    if (!module) {
-      // Prepare new module
-      OUTCOME_TRY(
-          new_module,
-          module_factory_->createModule(state_code, external_interface_));
-
-      // Trying to safe emplace new module, and use existed one
-      //  if it already emplaced in another thread
-      std::lock_guard lockGuard(modules_mutex_);
-      module = modules_.emplace(hash, std::move(new_module))
-                   .first->second;
+  std::shared_ptr<RuntimeInstancePool> RuntimeManager::poolOf(
+      const common::Hash256 &code_hash,
+      const common::Buffer &code,
+      bool own_storage) {
+    std::lock_guard lock{pools_mutex_};
+    auto &pool =
+        (own_storage ? ephemeral_pools_ : persistent_pools_)[code_hash];
+    if (pool == nullptr) {
+      pool = std::make_shared<RuntimeInstancePool>(
+          own_storage ? instances_num_ : 1, [this, code, own_storage] {
+            return createInstance(code, own_storage);
+          });
     }
+    return pool;
+  }
 
-    return RuntimeManager::RuntimeEnvironment{
-        module, external_interface_->memory(), boost::none};
+  outcome::result<std::unique_ptr<RuntimeInstance>>
+  RuntimeManager::createInstance(const common::Buffer &state_code,
+                                 bool own_storage) const {
+    auto instance = std::make_unique<RuntimeInstance>();
+    instance->storage_provider =
+        own_storage ? std::make_shared<TrieStorageProviderImpl>(trie_storage_)
+                    : storage_provider_;
+    instance->external_interface = std::make_shared<RuntimeExternalInterface>(
+        extension_factory_, instance->storage_provider, profiler_, tracer_);
+    OUTCOME_TRY(module,
+                module_factory_->createModule(state_code,
+                                              instance->external_interface));
+    instance->module = std::move(module);
+    return instance;
+  }
+
+  RuntimeManager::RuntimeEnvironment RuntimeManager::createRuntimeEnvironment(
+      std::shared_ptr<RuntimeInstance> instance, bool persistent) const {
+    RuntimeEnvironment env{
+        std::shared_ptr<WasmModule>(instance, instance->module.get()),
+        std::shared_ptr<WasmMemory>(
+            instance, instance->external_interface->memory().get()),
+        boost::none,
+        [external_interface = instance->external_interface] {
+          external_interface->restoreMemory();
+        },
+        instance->storage_provider,
+        // the environment keeps the instance alive
+        [raw = instance.get()] { raw->broken = true; }};
+    if (persistent) {
+      env.batch = instance->storage_provider->tryGetPersistentBatch()
+                      .value()
+                      ->batchOnTop();
+    }
+    return env;
   }
 
 }  // namespace kagome::runtime::binaryen
@@ -6,14 +6,19 @@
 #ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_MANAGER
 #define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_API_RUNTIME_MANAGER
 
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+
 #include "common/blob.hpp"
 #include "common/logger.hpp"
-#include "crypto/hasher.hpp"
 #include "extensions/extension_factory.hpp"
 #include "outcome/outcome.hpp"
 #include "runtime/binaryen/module/wasm_module.hpp"
 #include "runtime/binaryen/module/wasm_module_factory.hpp"
 #include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/binaryen/runtime_instance_pool.hpp"
+#include "runtime/runtime_profiler.hpp"
 #include "runtime/trie_storage_provider.hpp"
 #include "runtime/wasm_provider.hpp"
 #include "storage/trie/trie_batches.hpp"
@@ -25,24 +30,52 @@ namespace kagome::runtime::binaryen {
    * @brief RuntimeManager is a mechanism to prepare environment for launching
    * execute() function of runtime APIs. It supports in-memory cache to reuse
    * existing environments, avoid hi-load operations.
+   * Every environment has an instance of the code of its own for the
+   * duration of the call, the persistent ones share a single instance bound
+   * to the common storage provider, so they run one at a time, while the
+   * ephemeral ones take instances from a pool
    */
   class RuntimeManager {
    public:
     enum class Error { EMPTY_STATE_CODE = 1 };
 
+    /**
+     * @param trie_storage storage the instances for ephemeral calls bind
+     * storage providers of their own to, so that these calls run in
+     * parallel, without it they share the instance of the persistent calls
+     * @param instances_num max number of the instances for ephemeral calls
+     * of the same code
+     * @param profiler collects the timings of the calls, if any
+     * @param tracer records the spans of the calls, if any
+     */
     RuntimeManager(
         std::shared_ptr<WasmProvider> wasm_provider,
         std::shared_ptr<extensions::ExtensionFactory> extension_factory,
         std::shared_ptr<WasmModuleFactory> module_factory,
         std::shared_ptr<TrieStorageProvider> storage_provider,
-        std::shared_ptr<crypto::Hasher> hasher);
+        std::shared_ptr<storage::trie::TrieStorage> trie_storage = nullptr,
+        size_t instances_num = 1,
+        std::shared_ptr<RuntimeProfiler> profiler = nullptr,
+        std::shared_ptr<common::Tracer> tracer = nullptr);
 
+    /**
+     * The module and the memory keep the instance of the environment, which
+     * is returned to its pool once both of them are released
+     */
     struct RuntimeEnvironment {
       std::shared_ptr<WasmModule> module;
       std::shared_ptr<WasmMemory> memory;
       boost::optional<std::shared_ptr<storage::trie::TopperTrieBatch>>
           batch;  // in persistent environments all changes of a call must be
                   // either applied together or discarded in case of failure
+      // brings the memory back to its state right after the instantiation,
+      // for an environment used by several calls
+      std::function<void()> restore_memory;
+      // storage provider the instance is bound to
+      std::shared_ptr<TrieStorageProvider> storage_provider;
+      // marks the instance broken by a failed call, so that it is dropped
+      // rather than returned to its pool
+      std::function<void()> discard;
     };
 
     outcome::result<RuntimeEnvironment> createPersistentRuntimeEnvironment();
@@ -59,8 +92,89 @@ namespace kagome::runtime::binaryen {
     outcome::result<RuntimeEnvironment> createEphemeralRuntimeEnvironmentAt(
         const common::Hash256 &state_root);
 
+    /**
+     * @return number of the instances created for ephemeral calls of the
+     * current code so far
+     */
+    size_t ephemeralInstancesNum();
+
+    /**
+     * Creates the instances of \arg code with \arg code_hash for the
+     * persistent and for the ephemeral calls, unless there are ones already,
+     * so that the first calls of the code, e.g. once it is set by a runtime
+     * upgrade, find them ready rather than parse and instantiate the code
+     */
+    outcome::result<void> prepareInstances(const common::Hash256 &code_hash,
+                                           const common::Buffer &code);
+
+    /**
+     * @return hash of the current code, which keys its instances
+     */
+    common::Hash256 stateCodeHash() const;
+
+    /**
+     * @return root of the state the calls without one run on, none if it is
+     * unknown, as there is no trie storage
+     */
+    boost::optional<common::Buffer> stateRoot() const;
+
+    /**
+     * Writes the changes made by the persistent calls to the storage. The
+     * calls themselves only calculate the roots of the states, so that the
+     * states, which are never imported, are not written
+     * @return root of the committed state
+     */
+    outcome::result<common::Buffer> commitPersistentState();
+
+    /**
+     * @return profiler of the calls, nullptr if they are not profiled
+     */
+    const std::shared_ptr<RuntimeProfiler> &profiler() const {
+      return profiler_;
+    }
+
+    /**
+     * @return tracer of the calls, nullptr if they are not traced
+     */
+    const std::shared_ptr<common::Tracer> &tracer() const {
+      return tracer_;
+    }
+
+    /**
+     * @return the largest size of the memory a call of export \arg name
+     * ended with, 0 if it was not called yet
+     */
+    WasmSize memoryPeak(std::string_view name) const;
+
+    /**
+     * Records that a call of export \arg name ended with the memory of
+     * \arg size, so that the memory is grown to it before the next calls
+     * at once rather than repeatedly during them
+     */
+    void recordMemoryPeak(std::string_view name, WasmSize size);
+
    private:
-    outcome::result<RuntimeEnvironment> createRuntimeEnvironment();
+    /**
+     * Takes an instance of the current code, waiting for one if all of them
+     * are in use
+     */
+    outcome::result<std::shared_ptr<RuntimeInstance>> acquireInstance(
+        bool persistent);
+
+    /**
+     * @return the pool of the instances of \arg code with \arg code_hash
+     * bound to storage providers of their own or to the common one
+     */
+    std::shared_ptr<RuntimeInstancePool> poolOf(
+        const common::Hash256 &code_hash,
+        const common::Buffer &code,
+        bool own_storage);
+
+    outcome::result<std::unique_ptr<RuntimeInstance>> createInstance(
+        const common::Buffer &state_code, bool own_storage) const;
+
+    RuntimeEnvironment createRuntimeEnvironment(
+        std::shared_ptr<RuntimeInstance> instance, bool persistent) const;
 
     common::Logger logger_ = common::createLogger("Runtime manager");
 
@@ -68,16 +182,20 @@ namespace kagome::runtime::binaryen {
     std::shared_ptr<TrieStorageProvider> storage_provider_;
     std::shared_ptr<extensions::ExtensionFactory> extension_factory_;
     std::shared_ptr<WasmModuleFactory> module_factory_;
-    std::shared_ptr<crypto::Hasher> hasher_;
-
-    // hash of WASM state code
-    common::Hash256 state_code_hash_{};
-
-    std::mutex modules_mutex_;
-    std::map<common::Hash256, std::shared_ptr<WasmModule>> modules_;
-
-    static thread_local std::shared_ptr<RuntimeExternalInterface>
-        external_interface_;
+    std::shared_ptr<storage::trie::TrieStorage> trie_storage_;
+    const size_t instances_num_;
+    std::shared_ptr<RuntimeProfiler> profiler_;
+    std::shared_ptr<common::Tracer> tracer_;
+
+    // by hashes of WASM state code
+    std::mutex pools_mutex_;
+    std::map<common::Hash256, std::shared_ptr<RuntimeInstancePool>>
+        persistent_pools_;
+    std::map<common::Hash256, std::shared_ptr<RuntimeInstancePool>>
+        ephemeral_pools_;
+
+    mutable std::mutex memory_peaks_mutex_;
+    std::unordered_map<std::string, WasmSize> memory_peaks_;
   };
 
 }  // namespace kagome::runtime::binaryen
@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_upgrade_preparer.hpp"
+
+#include <algorithm>
+
+#include <boost/asio/post.hpp>
+
+#include "runtime/common/storage_wasm_provider.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  RuntimeUpgradePreparer::RuntimeUpgradePreparer(
+      std::shared_ptr<RuntimeManager> runtime_manager,
+      std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+      std::shared_ptr<const storage::trie::TrieStorage> trie_storage,
+      std::shared_ptr<subscription::ChainEvents> chain_events)
+      : runtime_manager_{std::move(runtime_manager)},
+        header_repo_{std::move(header_repo)},
+        trie_storage_{std::move(trie_storage)},
+        chain_events_{std::move(chain_events)} {
+    BOOST_ASSERT(runtime_manager_ != nullptr);
+    BOOST_ASSERT(header_repo_ != nullptr);
+    BOOST_ASSERT(trie_storage_ != nullptr);
+    BOOST_ASSERT(chain_events_ != nullptr);
+    storage_connection_ = chain_events_->storage_changes.connect(
+        [this](const primitives::BlockHash &block,
+               const std::vector<common::Buffer> &keys) {
+          onStorageChanges(block, keys);
+        });
+  }
+
+  RuntimeUpgradePreparer::~RuntimeUpgradePreparer() {
+    storage_connection_.disconnect();
+    pool_.stop();
+    pool_.join();
+  }
+
+  outcome::result<bool> RuntimeUpgradePreparer::prepareCodeOf(
+      const primitives::BlockHash &block) {
+    OUTCOME_TRY(header, header_repo_->getBlockHeader(block));
+    OUTCOME_TRY(snapshot, trie_storage_->getSnapshotAt(header.state_root));
+    OUTCOME_TRY(merkle_value, snapshot->getMerkleValue(kRuntimeKey));
+    if (not merkle_value) {
+      return false;
+    }
+    // the code is read only when it is a new one, as it takes megabytes
+    auto code_hash = StorageWasmProvider::toCodeHash(merkle_value.value());
+    {
+      std::lock_guard lock{mutex_};
+      if (prepared_.count(code_hash) != 0) {
+        return false;
+      }
+    }
+    OUTCOME_TRY(code, snapshot->get(kRuntimeKey));
+    OUTCOME_TRY(runtime_manager_->prepareInstances(code_hash, code));
+    std::lock_guard lock{mutex_};
+    return prepared_.insert(code_hash).second;
+  }
+
+  void RuntimeUpgradePreparer::waitIdle() {
+    std::unique_lock lock{mutex_};
+    idle_.wait(lock, [this] { return pending_tasks_ == 0; });
+  }
+
+  void RuntimeUpgradePreparer::onStorageChanges(
+      const primitives::BlockHash &block,
+      const std::vector<common::Buffer> &keys) {
+    if (std::find(keys.begin(), keys.end(), kRuntimeKey) == keys.end()) {
+      return;
+    }
+    {
+      std::lock_guard lock{mutex_};
+      pending_tasks_++;
+    }
+    boost::asio::post(pool_, [this, block] {
+      if (auto prepared = prepareCodeOf(block); not prepared) {
+        logger_->warn("Code set by block {} is not prepared: {}",
+                      block.toHex(),
+                      prepared.error().message());
+      } else if (prepared.value()) {
+        logger_->info("Code set by block {} is prepared", block.toHex());
+      }
+      std::lock_guard lock{mutex_};
+      if (--pending_tasks_ == 0) {
+        idle_.notify_all();
+      }
+    });
+  }
+
+}  // namespace kagome::runtime::binaryen
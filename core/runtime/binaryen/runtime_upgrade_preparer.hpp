@@ -0,0 +1,75 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_UPGRADE_PREPARER_HPP
+#define KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_UPGRADE_PREPARER_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+
+#include <boost/asio/thread_pool.hpp>
+#include <boost/signals2/connection.hpp>
+
+#include "blockchain/block_header_repository.hpp"
+#include "common/logger.hpp"
+#include "runtime/binaryen/runtime_manager.hpp"
+#include "storage/trie/trie_storage.hpp"
+#include "subscription/chain_events.hpp"
+
+namespace kagome::runtime::binaryen {
+
+  /**
+   * Prepares the instances of the code set by a runtime upgrade. Once an
+   * imported block, finalized or not, changes the code, the new one is
+   * instantiated on a thread of its own, so that the first block executed
+   * on top of the upgrade finds the instances ready rather than stalls for
+   * the compilation of the code
+   */
+  class RuntimeUpgradePreparer {
+   public:
+    RuntimeUpgradePreparer(
+        std::shared_ptr<RuntimeManager> runtime_manager,
+        std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
+        std::shared_ptr<const storage::trie::TrieStorage> trie_storage,
+        std::shared_ptr<subscription::ChainEvents> chain_events);
+
+    ~RuntimeUpgradePreparer();
+
+    /**
+     * Prepares the instances of the code of the state of \arg block, unless
+     * they are prepared already
+     * @return true if the code was not prepared before
+     */
+    outcome::result<bool> prepareCodeOf(const primitives::BlockHash &block);
+
+    /**
+     * Waits for the scheduled preparations to be done
+     */
+    void waitIdle();
+
+   private:
+    void onStorageChanges(const primitives::BlockHash &block,
+                          const std::vector<common::Buffer> &keys);
+
+    std::shared_ptr<RuntimeManager> runtime_manager_;
+    std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    std::shared_ptr<const storage::trie::TrieStorage> trie_storage_;
+    std::shared_ptr<subscription::ChainEvents> chain_events_;
+
+    std::mutex mutex_;
+    std::set<common::Hash256> prepared_;
+    std::condition_variable idle_;
+    size_t pending_tasks_ = 0;
+
+    common::Logger logger_ = common::createLogger("RuntimeUpgradePreparer");
+
+    boost::asio::thread_pool pool_{1};
+    boost::signals2::scoped_connection storage_connection_;
+  };
+
+}  // namespace kagome::runtime::binaryen
+
+#endif  // KAGOME_CORE_RUNTIME_BINARYEN_RUNTIME_UPGRADE_PREPARER_HPP
@@ -7,21 +7,33 @@
 #include <runtime/wasm_result.hpp>
 
 namespace kagome::runtime::binaryen {
-  WasmMemoryImpl::WasmMemoryImpl(wasm::ShellExternalInterface::Memory *memory,
-                                 WasmSize size)
-      : memory_(memory),
+  namespace {
+    // set in the second word of the header of an allocated chunk, the rest
+    // of which is the order of the chunk
+    constexpr uint32_t kOccupiedFlag = 1u << 31;
+  }  // namespace
+
+  WasmMemoryImpl::WasmMemoryImpl(WasmSize size,
+                                 std::shared_ptr<RuntimeProfiler> profiler)
+      : profiler_(std::move(profiler)),
         size_(size),
-        offset_{1}  // We should allocate very first byte to prohibit allocating
-                    // memory at 0 in future, as returning 0 from allocate
-                    // method means that wasm memory was exhausted
+        offset_{0}  // the first chunk starts after its header, so 0 is never
+                    // allocated, as returning 0 from allocate method means
+                    // that wasm memory was exhausted
   {
     WasmMemoryImpl::resize(size_);
   }
 
   void WasmMemoryImpl::reset() {
-    offset_ = 1;
-    allocated_.clear();
-    deallocated_.clear();
+    offset_ = 0;
+    free_lists_.fill(0);
+    stats_ = {};
+  }
+
+  AllocatorStats WasmMemoryImpl::allocatorStats() const {
+    auto stats = stats_;
+    stats.heap_size = offset_;
+    return stats;
   }
 
   WasmSize WasmMemoryImpl::size() const {
@@ -29,164 +41,174 @@ namespace kagome::runtime::binaryen {
   }
 
   void WasmMemoryImpl::resize(runtime::WasmSize new_size) {
+    // always at least 1 page, as in binaryen's shell interface
+    constexpr size_t kMinSize = 1 << 12;
     size_ = new_size;
-    return memory_->resize(new_size);
+    memory_.resize(std::max<size_t>(new_size, kMinSize));
   }
 
-  WasmPointer WasmMemoryImpl::allocate(WasmSize size) {
-    if (size == 0) {
+  size_t WasmMemoryImpl::orderOf(WasmSize size) {
+    if (size <= kMinAllocationSize) {
       return 0;
     }
-    const auto ptr = offset_;
-    const auto new_offset = ptr + size;
+    // the number of bits of (size - 1) is the power of two fitting size
+    constexpr auto kMinBits = 3;
+    static_assert(kMinAllocationSize == 1u << kMinBits);
+    return 32 - __builtin_clz(size - 1) - kMinBits;
+  }
 
-    if (new_offset < static_cast<const uint32_t>(ptr)) {  // overflow
+  WasmPointer WasmMemoryImpl::allocate(WasmSize size) {
+    if (size == 0 or size > kMaxAllocationSize) {
       return 0;
     }
-    if (new_offset <= size_) {
-      offset_ = new_offset;
-      allocated_[ptr] = size;
-      return ptr;
-    }
+    const auto order = orderOf(size);
 
-    return freealloc(size);
+    WasmPointer ptr = free_lists_[order];
+    if (ptr != 0) {
+      free_lists_[order] = load32u(ptr - kAllocationHeaderSize);
+    } else {
+      ptr = bumpAlloc(order);
+      if (ptr == 0) {
+        return 0;
+      }
+    }
+    store32(ptr - kAllocationHeaderSize, size);
+    store32(ptr - kAllocationHeaderSize / 2, kOccupiedFlag | order);
+    stats_.allocations++;
+    stats_.bytes_allocated += size;
+    stats_.peak_live = std::max(stats_.peak_live,
+                                stats_.bytes_allocated - stats_.bytes_freed);
+    return ptr;
   }
 
   boost::optional<WasmSize> WasmMemoryImpl::deallocate(WasmPointer ptr) {
-    const auto it = allocated_.find(ptr);
-    if (it == allocated_.end()) {
+    // chunks and their headers have sizes divisible by the min size
+    if (ptr < kAllocationHeaderSize or ptr > offset_
+        or ptr % kMinAllocationSize != 0) {
       return boost::none;
     }
-    const auto size = it->second;
+    const auto flags = load32u(ptr - kAllocationHeaderSize / 2);
+    const auto order = flags & ~kOccupiedFlag;
+    if ((flags & kOccupiedFlag) == 0 or order >= kOrdersNum) {
+      return boost::none;
+    }
+    const auto size = load32u(ptr - kAllocationHeaderSize);
 
-    allocated_.erase(ptr);
-    deallocated_[ptr] = size;
+    store32(ptr - kAllocationHeaderSize, free_lists_[order]);
+    store32(ptr - kAllocationHeaderSize / 2, order);
+    free_lists_[order] = ptr;
+    stats_.bytes_freed += size;
 
     return size;
   }
 
-  WasmPointer WasmMemoryImpl::freealloc(WasmSize size) {
-    auto ptr = findContaining(size);
-    if (ptr == 0) {
-      // if did not find available space among deallocated memory chunks, then
-      // grow memory and allocate in new space
-      return growAlloc(size);
-    }
-    deallocated_.erase(ptr);
-    allocated_[ptr] = size;
-    return ptr;
-  }
-
-  WasmPointer WasmMemoryImpl::findContaining(WasmSize size) {
-    auto min_value = std::numeric_limits<WasmPointer>::max();
-    WasmPointer min_key = 0;
-    for (const auto &[key, value] : deallocated_) {
-      if (min_value < 0) {
-        return 0;
-      }
-      if (value < static_cast<uint32_t>(min_value) and value >= size) {
-        min_value = value;
-        min_key = key;
-      }
-    }
-    return min_key;
-  }
-
-  WasmPointer WasmMemoryImpl::growAlloc(WasmSize size) {
-    if (offset_ < 0) {
-      return 0;
-    }
-
+  WasmPointer WasmMemoryImpl::bumpAlloc(size_t order) {
+    const WasmSize chunk_size =
+        kAllocationHeaderSize + (kMinAllocationSize << order);
     // check that we do not exceed max memory size
-    if (static_cast<uint32_t>(offset_) > kMaxMemorySize - size) {
+    if (offset_ > kMaxMemorySize - chunk_size) {
       return 0;
     }
-    // try to increase memory size up to offset + size * 4 (we multiply by 4
-    // to have more memory than currently needed to avoid resizing every time
-    // when we exceed current memory)
-    if (static_cast<uint32_t>(offset_) < kMaxMemorySize - size * 4) {
-      resize(offset_ + size * 4);
-    } else {
-      // if we can't increase by size * 4 then increase memory size by
-      // provided size
-      resize(offset_ + size);
+    const WasmPointer new_offset = offset_ + chunk_size;
+    if (new_offset > size_) {
+      stats_.grows++;
+      // grow more than currently needed to avoid resizing every time when
+      // we exceed current memory
+      if (new_offset < kMaxMemorySize - chunk_size * 3) {
+        resize(new_offset + chunk_size * 3);
+      } else {
+        resize(new_offset);
+      }
     }
-    return allocate(size);
+    const auto ptr = offset_ + kAllocationHeaderSize;
+    offset_ = new_offset;
+    return ptr;
   }
 
   int8_t WasmMemoryImpl::load8s(WasmPointer addr) const {
-    return memory_->get<int8_t>(addr);
+    return get<int8_t>(addr);
   }
   uint8_t WasmMemoryImpl::load8u(WasmPointer addr) const {
-    return memory_->get<uint8_t>(addr);
+    return get<uint8_t>(addr);
   }
   int16_t WasmMemoryImpl::load16s(WasmPointer addr) const {
-    return memory_->get<int16_t>(addr);
+    return get<int16_t>(addr);
   }
   uint16_t WasmMemoryImpl::load16u(WasmPointer addr) const {
-    return memory_->get<uint16_t>(addr);
+    return get<uint16_t>(addr);
   }
   int32_t WasmMemoryImpl::load32s(WasmPointer addr) const {
-    return memory_->get<int32_t>(addr);
+    return get<int32_t>(addr);
   }
   uint32_t WasmMemoryImpl::load32u(WasmPointer addr) const {
-    return memory_->get<uint32_t>(addr);
+    return get<uint32_t>(addr);
   }
   int64_t WasmMemoryImpl::load64s(WasmPointer addr) const {
-    return memory_->get<int64_t>(addr);
+    return get<int64_t>(addr);
   }
   uint64_t WasmMemoryImpl::load64u(WasmPointer addr) const {
-    return memory_->get<uint64_t>(addr);
+    return get<uint64_t>(addr);
   }
   std::array<uint8_t, 16> WasmMemoryImpl::load128(WasmPointer addr) const {
-    return memory_->get<std::array<uint8_t, 16>>(addr);
+    return get<std::array<uint8_t, 16>>(addr);
   }
 
   common::Buffer WasmMemoryImpl::loadN(kagome::runtime::WasmPointer addr,
                                        kagome::runtime::WasmSize n) const {
     // TODO (kamilsa) PRE-98: check if we do not go outside of memory
-    common::Buffer res;
-    res.reserve(n);
-    for (auto i = addr; i < addr + n; i++) {
-      res.putUint8(memory_->get<uint8_t>(i));
+    if (profiler_ != nullptr) {
+      profiler_->recordLoaded(n);
     }
-    return res;
+    return common::Buffer(memory_.data() + addr, memory_.data() + addr + n);
   }
 
   std::string WasmMemoryImpl::loadStr(kagome::runtime::WasmPointer addr,
                       kagome::runtime::WasmSize n) const {
-    std::string res;
-    res.reserve(n);
-    for (auto i = addr; i < addr + n; i++) {
-      res.push_back(memory_->get<uint8_t>(i));
+    return std::string(memory_.begin() + addr, memory_.begin() + addr + n);
+  }
+
+  boost::optional<gsl::span<const uint8_t>> WasmMemoryImpl::view(
+      WasmPointer addr, WasmSize n) const {
+    if (static_cast<size_t>(addr) + n > size_) {
+      return boost::none;
+    }
+    return gsl::span<const uint8_t>(memory_.data() + addr, n);
+  }
+
+  boost::optional<gsl::span<uint8_t>> WasmMemoryImpl::mutableView(
+      WasmPointer addr, WasmSize n) {
+    if (static_cast<size_t>(addr) + n > size_) {
+      return boost::none;
     }
-    return res;
+    markDirty(addr, n);
+    return gsl::span<uint8_t>(memory_.data() + addr, n);
   }
 
   void WasmMemoryImpl::store8(WasmPointer addr, int8_t value) {
-    memory_->set<int8_t>(addr, value);
+    set(addr, value);
   }
   void WasmMemoryImpl::store16(WasmPointer addr, int16_t value) {
-    memory_->set<int16_t>(addr, value);
+    set(addr, value);
   }
   void WasmMemoryImpl::store32(WasmPointer addr, int32_t value) {
-    memory_->set<int32_t>(addr, value);
+    set(addr, value);
   }
   void WasmMemoryImpl::store64(WasmPointer addr, int64_t value) {
-    memory_->set<int64_t>(addr, value);
+    set(addr, value);
   }
   void WasmMemoryImpl::store128(WasmPointer addr,
                                 const std::array<uint8_t, 16> &value) {
-    memory_->set<std::array<uint8_t, 16>>(addr, value);
+    set(addr, value);
   }
   void WasmMemoryImpl::storeBuffer(kagome::runtime::WasmPointer addr,
                                    gsl::span<const uint8_t> value) {
     // TODO (kamilsa) PRE-98: check if we do not go outside of memory
     // boundaries, 04.04.2019
-    for (size_t i = addr, j = 0; i < addr + static_cast<size_t>(value.size());
-         i++, j++) {
-      memory_->set(i, value[j]);
+    if (profiler_ != nullptr) {
+      profiler_->recordStored(value.size());
     }
+    markDirty(addr, value.size());
+    std::copy(value.begin(), value.end(), memory_.begin() + addr);
   }
 
   WasmSpan WasmMemoryImpl::storeBuffer(gsl::span<const uint8_t> value) {
@@ -198,4 +220,22 @@ namespace kagome::runtime::binaryen {
     return WasmResult(wasm_pointer, value.size()).combine();
   }
 
+  void WasmMemoryImpl::snapshot() {
+    snapshot_.assign(memory_.begin(), memory_.begin() + size_);
+    dirty_pages_.assign(
+        (snapshot_.size() + kSnapshotPageSize - 1) / kSnapshotPageSize, 0);
+    dirty_list_.clear();
+  }
+
+  void WasmMemoryImpl::restore() {
+    for (auto page : dirty_list_) {
+      auto begin = page * kSnapshotPageSize;
+      auto end = std::min(begin + kSnapshotPageSize, snapshot_.size());
+      std::memcpy(&memory_[begin], &snapshot_[begin], end - begin);
+      dirty_pages_[page] = 0;
+    }
+    dirty_list_.clear();
+    reset();
+  }
+
 }  // namespace kagome::runtime::binaryen
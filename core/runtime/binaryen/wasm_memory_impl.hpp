@@ -6,32 +6,54 @@
 #ifndef KAGOME_RUNTIME_BINARYEN_WASM_MEMORY_IMPL_HPP
 #define KAGOME_RUNTIME_BINARYEN_WASM_MEMORY_IMPL_HPP
 
-#include <binaryen/shell-interface.h>
-
+#include <algorithm>
 #include <array>
-#include <cstring>  // for std::memset in gcc
+#include <cstring>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include <boost/optional.hpp>
 
+#include "common/memory_arena.hpp"
+#include "runtime/runtime_profiler.hpp"
 #include "runtime/wasm_memory.hpp"
 
 namespace kagome::runtime::binaryen {
 
   /**
-   * Memory implementation for wasm environment
+   * Memory implementation for wasm environment, which owns the linear memory
+   * of a module instance, so that both the wasm code (through
+   * RuntimeExternalInterface) and the host functions access the same bytes
+   * and the latter may refer to them without copying.
    * Most code is taken from Binaryen's implementation here:
    * https://github.com/WebAssembly/binaryen/blob/master/src/shell-interface.h#L37
    * @note Memory size of this implementation is at least of the size of one
    * wasm page (4096 bytes)
+   * Allocations are made of power of two sizes, each one preceded by a
+   * header in the memory, which keeps the requested size of an allocated
+   * chunk or links a freed one into the list of the free chunks of its
+   * size, so both allocation and deallocation take constant time
    */
-  class WasmMemoryImpl : public WasmMemory {
+  class WasmMemoryImpl final : public WasmMemory {
    public:
+    // a header of a chunk is right before the pointer to the chunk
+    static constexpr WasmSize kAllocationHeaderSize = 8;
+    static constexpr WasmSize kMinAllocationSize = 8;
+    // number of the sizes of chunks, up to 32 MiB
+    static constexpr size_t kOrdersNum = 23;
+    static constexpr WasmSize kMaxAllocationSize = kMinAllocationSize
+                                                   << (kOrdersNum - 1);
+
+    // default value for binaryen's shell interface
+    static constexpr WasmSize kDefaultSize = 1114112;
+
+    /**
+     * @param profiler counts the bytes copied by loadN and storeBuffer, if
+     * any
+     */
     explicit WasmMemoryImpl(
-        wasm::ShellExternalInterface::Memory *memory,
-        WasmSize size =
-            1114112);  // default value for binaryen's shell interface
+        WasmSize size = kDefaultSize,
+        std::shared_ptr<RuntimeProfiler> profiler = nullptr);
     WasmMemoryImpl(const WasmMemoryImpl &copy) = delete;
     WasmMemoryImpl &operator=(const WasmMemoryImpl &copy) = delete;
     WasmMemoryImpl(WasmMemoryImpl &&move) = delete;
@@ -40,6 +62,8 @@ namespace kagome::runtime::binaryen {
 
     void reset() override;
 
+    AllocatorStats allocatorStats() const override;
+
     WasmSize size() const override;
     void resize(WasmSize newSize) override;
 
@@ -60,6 +84,11 @@ namespace kagome::runtime::binaryen {
     std::string loadStr(kagome::runtime::WasmPointer addr,
                          kagome::runtime::WasmSize n) const override;
 
+    boost::optional<gsl::span<const uint8_t>> view(
+        WasmPointer addr, WasmSize n) const override;
+    boost::optional<gsl::span<uint8_t>> mutableView(WasmPointer addr,
+                                                    WasmSize n) override;
+
     void store8(WasmPointer addr, int8_t value) override;
     void store16(WasmPointer addr, int16_t value) override;
     void store32(WasmPointer addr, int32_t value) override;
@@ -71,50 +100,96 @@ namespace kagome::runtime::binaryen {
 
     WasmSpan storeBuffer(gsl::span<const uint8_t> value) override;
 
+    /**
+     * Makes the current contents of the memory the ones restore() brings it
+     * back to, the writes to the memory are tracked since then
+     */
+    void snapshot();
+
+    /**
+     * Brings the pages written since the snapshot back to their contents in
+     * it and resets the allocator, so that it costs only the touched pages.
+     * The memory grown beyond the snapshot is left as is, as it is only
+     * handed out by the allocator
+     */
+    void restore();
+
    private:
-    wasm::ShellExternalInterface::Memory *memory_;
+    // granularity of tracking the writes
+    static constexpr size_t kSnapshotPageSize = 4096;
+
+    // bytes held by the arena of the memories of the runtime
+    using Bytes = std::vector<
+        uint8_t,
+        common::ArenaAllocator<uint8_t, common::MemoryArena::RUNTIME_MEMORY>>;
+
+    std::shared_ptr<RuntimeProfiler> profiler_;
+
+    // the linear memory, at least of 4096 bytes even if size_ is less
+    Bytes memory_;
     WasmSize size_;
 
     // Offset on the tail of the last allocated MemoryImpl chunk
     WasmPointer offset_;
 
-    // map containing addresses of allocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> allocated_;
+    // pointers to the last freed chunks of each size, which link to the
+    // previous ones in their headers, 0 if there are no free chunks
+    std::array<WasmPointer, kOrdersNum> free_lists_{};
 
-    // map containing addresses to the deallocated MemoryImpl chunks
-    std::unordered_map<WasmPointer, WasmSize> deallocated_;
+    // counters of the allocator since the last reset, but the heap size,
+    // which is offset_
+    AllocatorStats stats_;
+
+    // contents of the memory at the snapshot, empty if there is none
+    Bytes snapshot_;
+    // flags for the pages of the snapshot written since it was taken, and
+    // the numbers of these pages
+    std::vector<uint8_t> dirty_pages_;
+    std::vector<size_t> dirty_list_;
 
     template <typename T>
-    static bool aligned(const char *address) {
-      static_assert(!(sizeof(T) & (sizeof(T) - 1)), "must be a power of 2");
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      return 0 == (reinterpret_cast<uintptr_t>(address) & (sizeof(T) - 1));
+    T get(WasmPointer addr) const {
+      T value;
+      std::memcpy(&value, &memory_[addr], sizeof(T));
+      return value;
+    }
+
+    template <typename T>
+    void set(WasmPointer addr, const T &value) {
+      markDirty(addr, sizeof(T));
+      std::memcpy(&memory_[addr], &value, sizeof(T));
     }
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * and allocates a memory there
-     * @param size of target memory
-     * @return address of memory of given size, or -1 if it is impossible to
-     * allocate this amount of memory
+     * Records a write of \arg size bytes at \arg addr for restore()
      */
-    WasmPointer freealloc(WasmSize size);
+    void markDirty(WasmPointer addr, size_t size) {
+      if (snapshot_.empty() or size == 0) {
+        return;
+      }
+      auto last = std::min<size_t>((static_cast<size_t>(addr) + size - 1)
+                                       / kSnapshotPageSize,
+                                   dirty_pages_.size() - 1);
+      for (size_t page = addr / kSnapshotPageSize; page <= last; ++page) {
+        if (dirty_pages_[page] == 0) {
+          dirty_pages_[page] = 1;
+          dirty_list_.push_back(page);
+        }
+      }
+    }
 
     /**
-     * Finds memory segment of given size among deallocated pieces of memory
-     * @param size of target memory
-     * @return address of memory of given size, or 0 if it is impossible to
-     * allocate this amount of memory
+     * @return order of the smallest chunk size fitting \arg size, which is
+     * kMinAllocationSize << order
      */
-    WasmPointer findContaining(WasmSize size);
+    static size_t orderOf(WasmSize size);
 
     /**
-     * Resize memory and allocate memory segment of given size
-     * @param size memory size to be allocated
-     * @return pointer to the allocated memory @or 0 if it is impossible to
-     * allocate this amount of memory
+     * Takes a chunk of \arg order from the tail of the allocated memory,
+     * growing the memory if needed
+     * @return pointer to the chunk @or 0 if the memory can't fit it
      */
-    WasmPointer growAlloc(WasmSize size);
+    WasmPointer bumpAlloc(size_t order);
 
     void resizeInternal(WasmSize newSize);
   };
@@ -54,6 +54,19 @@ namespace kagome::runtime {
      * Generate a random seed.
      */
     virtual outcome::result<common::Hash256> random_seed() = 0;
+
+    /**
+     * Keeps the runtime environment of apply_extrinsic() and finalise_block()
+     * for the calls of this thread until releaseEnvironment(), so that the
+     * extrinsics of a block are applied without setting it up for each of
+     * them. The other calls changing the state wait until then
+     */
+    virtual outcome::result<void> holdEnvironment() = 0;
+
+    /**
+     * Lets the other calls changing the state run, \see holdEnvironment()
+     */
+    virtual void releaseEnvironment() = 0;
   };
 }  // namespace kagome::runtime
 
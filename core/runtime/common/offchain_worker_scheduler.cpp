@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/offchain_worker_scheduler.hpp"
+
+namespace kagome::runtime {
+
+  OffchainWorkerScheduler::OffchainWorkerScheduler(
+      std::shared_ptr<application::AppStateManager> app_state_manager,
+      std::shared_ptr<OffchainWorker> offchain_worker,
+      size_t threads_num)
+      : offchain_worker_{std::move(offchain_worker)},
+        max_pending_{threads_num},
+        logger_{common::createLogger("OffchainWorkerScheduler")} {
+    BOOST_ASSERT(app_state_manager != nullptr);
+    BOOST_ASSERT(offchain_worker_ != nullptr);
+    threads_.reserve(threads_num);
+    for (size_t i = 0; i < threads_num; i++) {
+      threads_.emplace_back([this] { work(); });
+    }
+    app_state_manager->atShutdown([this] { stop(); });
+  }
+
+  OffchainWorkerScheduler::~OffchainWorkerScheduler() {
+    stop();
+  }
+
+  void OffchainWorkerScheduler::schedule(primitives::BlockNumber number) {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_ or max_pending_ == 0) {
+        return;
+      }
+      if (pending_.size() == max_pending_) {
+        logger_->debug("Offchain worker for block #{} is skipped",
+                       pending_.front());
+        pending_.pop_front();
+      }
+      pending_.push_back(number);
+    }
+    pending_cv_.notify_one();
+  }
+
+  void OffchainWorkerScheduler::stop() {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+      pending_.clear();
+    }
+    pending_cv_.notify_all();
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void OffchainWorkerScheduler::work() {
+    while (true) {
+      primitives::BlockNumber number;
+      {
+        std::unique_lock lock{mutex_};
+        pending_cv_.wait(lock,
+                         [this] { return stopped_ or not pending_.empty(); });
+        if (stopped_) {
+          return;
+        }
+        number = pending_.front();
+        pending_.pop_front();
+      }
+      if (auto res = offchain_worker_->offchain_worker(number); not res) {
+        logger_->warn("Offchain worker for block #{} failed: {}",
+                      number,
+                      res.error().message());
+      }
+    }
+  }
+
+}  // namespace kagome::runtime
@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_COMMON_OFFCHAIN_WORKER_SCHEDULER_HPP
+#define KAGOME_CORE_RUNTIME_COMMON_OFFCHAIN_WORKER_SCHEDULER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+#include "runtime/offchain_worker.hpp"
+
+namespace kagome::runtime {
+
+  /**
+   * Runs the offchain workers of the runtime for the imported best blocks on
+   * threads of its own, so that they never delay the block import or the
+   * slots of the block production.
+   * At most one block per thread waits for its worker, the oldest waiting
+   * block is skipped when a new one is scheduled, as the workers of the
+   * blocks which are no longer the best ones are of no use
+   */
+  class OffchainWorkerScheduler {
+   public:
+    /**
+     * @param offchain_worker calls the workers, should use runtime instances
+     * not shared with the block import
+     * @param threads_num number of the workers run at once, 0 disables them
+     */
+    OffchainWorkerScheduler(
+        std::shared_ptr<application::AppStateManager> app_state_manager,
+        std::shared_ptr<OffchainWorker> offchain_worker,
+        size_t threads_num);
+
+    ~OffchainWorkerScheduler();
+
+    /**
+     * Schedules the offchain worker for the block with \arg number, returns
+     * without waiting for it
+     */
+    void schedule(primitives::BlockNumber number);
+
+    /**
+     * Cancels the workers which are not started yet and waits for the running
+     * ones, no workers are run after that
+     */
+    void stop();
+
+   private:
+    void work();
+
+    std::shared_ptr<OffchainWorker> offchain_worker_;
+    const size_t max_pending_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_cv_;
+    std::deque<primitives::BlockNumber> pending_;
+    bool stopped_ = false;
+    std::vector<std::thread> threads_;
+
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_CORE_RUNTIME_COMMON_OFFCHAIN_WORKER_SCHEDULER_HPP
@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/runtime_profiler.hpp"
+
+namespace kagome::runtime {
+
+  RuntimeProfiler::Timer::Timer(RuntimeProfiler *profiler,
+                                std::string_view name,
+                                bool host)
+      : profiler_{profiler}, name_{name}, host_{host} {
+    if (profiler_ != nullptr) {
+      start_ = Clock::now();
+    }
+  }
+
+  RuntimeProfiler::Timer::~Timer() {
+    if (profiler_ == nullptr) {
+      return;
+    }
+    auto duration = Clock::now() - start_;
+    if (host_) {
+      profiler_->recordHostCall(name_, duration);
+    } else {
+      profiler_->recordExport(name_, duration);
+    }
+  }
+
+  RuntimeProfiler::RuntimeProfiler(bool enabled) : enabled_{enabled} {}
+
+  void RuntimeProfiler::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  RuntimeProfiler::Timer RuntimeProfiler::exportTimer(std::string_view name) {
+    return Timer{isEnabled() ? this : nullptr, name, false};
+  }
+
+  RuntimeProfiler::Timer RuntimeProfiler::hostCallTimer(
+      std::string_view name) {
+    return Timer{isEnabled() ? this : nullptr, name, true};
+  }
+
+  void RuntimeProfiler::recordExport(std::string_view name,
+                                     Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    record(exports_, name, duration);
+  }
+
+  void RuntimeProfiler::recordHostCall(std::string_view name,
+                                       Clock::duration duration) {
+    std::lock_guard lock{mutex_};
+    record(host_functions_, name, duration);
+  }
+
+  void RuntimeProfiler::recordHeap(std::string_view name,
+                                   const AllocatorStats &stats) {
+    if (not isEnabled()) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    auto it = heaps_.find(name);
+    if (it == heaps_.end()) {
+      it = heaps_.emplace(std::string(name), Heap{}).first;
+    }
+    it->second.add(stats);
+  }
+
+  void RuntimeProfiler::record(Histograms &histograms,
+                               std::string_view name,
+                               Clock::duration duration) {
+    auto it = histograms.find(name);
+    if (it == histograms.end()) {
+      it = histograms.emplace(std::string(name), common::DurationHistogram{})
+               .first;
+    }
+    it->second.add(duration);
+  }
+
+  RuntimeProfiler::Report RuntimeProfiler::report() const {
+    Report report;
+    report.bytes_loaded = bytes_loaded_.load(std::memory_order_relaxed);
+    report.bytes_stored = bytes_stored_.load(std::memory_order_relaxed);
+    std::lock_guard lock{mutex_};
+    for (auto &[name, histogram] : exports_) {
+      report.exports.emplace(name, histogram.stats());
+    }
+    for (auto &[name, histogram] : host_functions_) {
+      report.host_functions.emplace(name, histogram.stats());
+    }
+    for (auto &[name, heap] : heaps_) {
+      report.heaps.emplace(name, heap.report());
+    }
+    return report;
+  }
+
+  void RuntimeProfiler::reset() {
+    bytes_loaded_.store(0, std::memory_order_relaxed);
+    bytes_stored_.store(0, std::memory_order_relaxed);
+    std::lock_guard lock{mutex_};
+    exports_.clear();
+    host_functions_.clear();
+    heaps_.clear();
+  }
+
+  void RuntimeProfiler::Heap::add(const AllocatorStats &allocator) {
+    stats.calls++;
+    stats.allocations += allocator.allocations;
+    stats.bytes_allocated += allocator.bytes_allocated;
+    stats.bytes_freed += allocator.bytes_freed;
+    stats.peak_heap = std::max(stats.peak_heap, allocator.heap_size);
+    stats.grows += allocator.grows;
+    heap_total += allocator.heap_size;
+    live_total += allocator.peak_live;
+  }
+
+  RuntimeProfiler::HeapStats RuntimeProfiler::Heap::report() const {
+    auto report = stats;
+    if (heap_total != 0) {
+      report.fragmentation =
+          1. - static_cast<double>(live_total) / static_cast<double>(heap_total);
+    }
+    return report;
+  }
+
+}  // namespace kagome::runtime
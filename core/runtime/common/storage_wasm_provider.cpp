@@ -7,36 +7,59 @@
 
 namespace kagome::runtime {
 
+  common::Hash256 StorageWasmProvider::toCodeHash(
+      const common::Buffer &merkle_value) {
+    common::Hash256 hash;
+    std::copy_n(merkle_value.begin(),
+                std::min(merkle_value.size(), hash.size()),
+                hash.begin());
+    return hash;
+  }
+
   StorageWasmProvider::StorageWasmProvider(
       std::shared_ptr<const storage::trie::TrieStorage> storage)
       : storage_{std::move(storage)} {
     BOOST_ASSERT(storage_ != nullptr);
 
-    last_state_root_ = storage_->getRootHash();
-    auto batch = storage_->getEphemeralBatch();
-    BOOST_ASSERT_MSG(batch.has_value(),
-                     "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeKey);
-    BOOST_ASSERT_MSG(state_code_res.has_value(),
-                     "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
+    updateStateCode();
   }
 
   const common::Buffer &StorageWasmProvider::getStateCode() const {
-    auto current_state_root = storage_->getRootHash();
-    if (last_state_root_ == current_state_root) {
-      return state_code_;
-    }
-    last_state_root_ = current_state_root;
+    updateStateCode();
+    return state_code_;
+  }
 
-    auto batch = storage_->getEphemeralBatch();
-    BOOST_ASSERT_MSG(batch.has_value(),
-                     "Error getting a batch of the storage");
-    auto state_code_res = batch.value()->get(kRuntimeKey);
-    BOOST_ASSERT_MSG(state_code_res.has_value(),
+  common::Hash256 StorageWasmProvider::getStateCodeHash() const {
+    updateStateCode();
+    std::lock_guard lock{mutex_};
+    return state_code_hash_;
+  }
+
+  void StorageWasmProvider::updateStateCode() const {
+    std::lock_guard lock{mutex_};
+    if (not last_state_root_.empty()
+        and last_state_root_ == storage_->getRootHash()) {
+      return;
+    }
+    auto snapshot = storage_->getSnapshot();
+    BOOST_ASSERT_MSG(snapshot.has_value(),
+                     "Error getting a snapshot of the storage");
+    // the code and its root are taken from the same snapshot, so that they
+    // match even if a new state is committed meanwhile
+    auto merkle_value_res = snapshot.value()->getMerkleValue(kRuntimeKey);
+    BOOST_ASSERT_MSG(merkle_value_res.has_value()
+                         and merkle_value_res.value().has_value(),
                      "Runtime code does not exist in the storage");
-    state_code_ = state_code_res.value();
-    return state_code_;
+    auto hash = toCodeHash(merkle_value_res.value().value());
+    // most new states keep the code, which is then neither read nor copied
+    if (state_code_.empty() or hash != state_code_hash_) {
+      auto state_code_res = snapshot.value()->get(kRuntimeKey);
+      BOOST_ASSERT_MSG(state_code_res.has_value(),
+                       "Runtime code does not exist in the storage");
+      state_code_ = std::move(state_code_res.value());
+      state_code_hash_ = hash;
+    }
+    last_state_root_ = snapshot.value()->getRootHash();
   }
 
 }  // namespace kagome::runtime
@@ -8,6 +8,8 @@
 
 #include "runtime/wasm_provider.hpp"
 
+#include <mutex>
+
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::runtime {
@@ -16,6 +18,11 @@ namespace kagome::runtime {
   inline const common::Buffer kRuntimeKey =
       common::Buffer::fromHex("3a636f6465").value();
 
+  /**
+   * Provides the code of the current state. The code is identified by the
+   * merkle value of its trie node, so a new state, which keeps the code, costs
+   * a lookup of the node instead of reading and copying the code
+   */
   class StorageWasmProvider : public WasmProvider {
    public:
     ~StorageWasmProvider() override = default;
@@ -25,9 +32,25 @@ namespace kagome::runtime {
 
     const common::Buffer &getStateCode() const override;
 
+    common::Hash256 getStateCodeHash() const override;
+
+    /**
+     * @return hash identifying the code node with \arg merkle_value, which is
+     * the merkle value itself, or the encoding of a small node padded with
+     * zeros
+     */
+    static common::Hash256 toCodeHash(const common::Buffer &merkle_value);
+
    private:
+    /**
+     * Loads the code of the current state, unless it is the one loaded
+     */
+    void updateStateCode() const;
+
     std::shared_ptr<const storage::trie::TrieStorage> storage_;
+    mutable std::mutex mutex_;
     mutable common::Buffer state_code_;
+    mutable common::Hash256 state_code_hash_;
     mutable common::Buffer last_state_root_;
   };
 
@@ -5,6 +5,19 @@
 
 #include "runtime/common/trie_storage_provider_impl.hpp"
 
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::runtime, TrieStorageProviderImpl::Error, e) {
+  using E = kagome::runtime::TrieStorageProviderImpl::Error;
+  switch (e) {
+    case E::NO_PERSISTENT_BATCH:
+      return "Transaction cannot be started without a persistent batch";
+    case E::NO_TRANSACTION:
+      return "There is no transaction to finish";
+  }
+  return "Unknown error";
+}
+
 namespace kagome::runtime {
 
   TrieStorageProviderImpl::TrieStorageProviderImpl(
@@ -31,13 +44,15 @@ namespace kagome::runtime {
       OUTCOME_TRY(batch, trie_storage_->getPersistentBatch());
       persistent_batch_ = std::move(batch);
     }
-    current_batch_ = persistent_batch_;
+    current_batch_ = getPersistentTop();
     return outcome::success();
   }
 
   outcome::result<void> TrieStorageProviderImpl::setToPersistentAt(
       const common::Hash256 &state_root) {
     OUTCOME_TRY(batch, trie_storage_->getPersistentBatchAt(state_root));
+    // the transactions were started over the discarded batch
+    transaction_layers_.clear();
     persistent_batch_ = std::move(batch);
     current_batch_ = persistent_batch_;
     return outcome::success();
@@ -55,8 +70,7 @@ namespace kagome::runtime {
   }
 
   bool TrieStorageProviderImpl::isCurrentlyPersistent() const {
-    return std::dynamic_pointer_cast<PersistentBatch>(current_batch_)
-           != nullptr;
+    return current_batch_ != nullptr and current_batch_ == getPersistentTop();
   }
 
   outcome::result<common::Buffer> TrieStorageProviderImpl::forceCommit() {
@@ -66,4 +80,81 @@ namespace kagome::runtime {
     return common::Buffer{};
   }
 
+  outcome::result<common::Buffer> TrieStorageProviderImpl::calculateRoot()
+      const {
+    if (persistent_batch_ != nullptr) {
+      return persistent_batch_->calculateRoot();
+    }
+    return common::Buffer{};
+  }
+
+  outcome::result<void> TrieStorageProviderImpl::startTransaction() {
+    if (persistent_batch_ == nullptr) {
+      return Error::NO_PERSISTENT_BATCH;
+    }
+    bool is_persistent = isCurrentlyPersistent();
+    transaction_layers_.push_back(
+        std::make_shared<storage::trie::TopperTrieBatchImpl>(
+            getPersistentTop()));
+    if (is_persistent) {
+      current_batch_ = transaction_layers_.back();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TrieStorageProviderImpl::rollbackTransaction() {
+    if (transaction_layers_.empty()) {
+      return Error::NO_TRANSACTION;
+    }
+    popTransaction();
+    return outcome::success();
+  }
+
+  outcome::result<void> TrieStorageProviderImpl::commitTransaction() {
+    if (transaction_layers_.empty()) {
+      return Error::NO_TRANSACTION;
+    }
+    OUTCOME_TRY(transaction_layers_.back()->writeBack());
+    popTransaction();
+    return outcome::success();
+  }
+
+  void TrieStorageProviderImpl::startAccessRecording() {
+    accessed_keys_.emplace();
+  }
+
+  void TrieStorageProviderImpl::recordAccess(const common::Buffer &key) {
+    if (accessed_keys_) {
+      accessed_keys_->insert(key);
+    }
+  }
+
+  std::vector<common::Buffer>
+  TrieStorageProviderImpl::finishAccessRecording() {
+    if (not accessed_keys_) {
+      return {};
+    }
+    std::vector<common::Buffer> keys{
+        std::make_move_iterator(accessed_keys_->begin()),
+        std::make_move_iterator(accessed_keys_->end())};
+    accessed_keys_.reset();
+    return keys;
+  }
+
+  std::shared_ptr<TrieStorageProviderImpl::Batch>
+  TrieStorageProviderImpl::getPersistentTop() const {
+    if (transaction_layers_.empty()) {
+      return persistent_batch_;
+    }
+    return transaction_layers_.back();
+  }
+
+  void TrieStorageProviderImpl::popTransaction() {
+    bool is_persistent = isCurrentlyPersistent();
+    transaction_layers_.pop_back();
+    if (is_persistent) {
+      current_batch_ = getPersistentTop();
+    }
+  }
+
 }  // namespace kagome::runtime
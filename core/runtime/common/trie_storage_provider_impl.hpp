@@ -6,15 +6,23 @@
 #ifndef KAGOME_CORE_RUNTIME_COMMON_TRIE_STORAGE_PROVIDER_IMPL
 #define KAGOME_CORE_RUNTIME_COMMON_TRIE_STORAGE_PROVIDER_IMPL
 
+#include <set>
+
 #include <common/buffer.hpp>
 #include "runtime/trie_storage_provider.hpp"
 
+#include "storage/trie/trie_batches.hpp"
 #include "storage/trie/trie_storage.hpp"
 
 namespace kagome::runtime {
 
   class TrieStorageProviderImpl : public TrieStorageProvider {
    public:
+    enum class Error {
+      NO_PERSISTENT_BATCH = 1,
+      NO_TRANSACTION,
+    };
+
     explicit TrieStorageProviderImpl(
         std::shared_ptr<storage::trie::TrieStorage> trie_storage);
 
@@ -35,8 +43,29 @@ namespace kagome::runtime {
     bool isCurrentlyPersistent() const override;
 
     outcome::result<common::Buffer> forceCommit() override;
+    outcome::result<common::Buffer> calculateRoot() const override;
+
+    outcome::result<void> startTransaction() override;
+    outcome::result<void> rollbackTransaction() override;
+    outcome::result<void> commitTransaction() override;
+
+    void startAccessRecording() override;
+    void recordAccess(const common::Buffer &key) override;
+    std::vector<common::Buffer> finishAccessRecording() override;
 
    private:
+    /**
+     * @return the innermost transaction layer, which the changes to the
+     * persistent state go to, or the persistent batch if there is none
+     */
+    std::shared_ptr<Batch> getPersistentTop() const;
+
+    /**
+     * Removes the innermost transaction layer, making the enclosing one
+     * current instead of it
+     */
+    void popTransaction();
+
     std::shared_ptr <storage::trie::TrieStorage> trie_storage_;
 
     std::shared_ptr<Batch> current_batch_;
@@ -44,8 +73,18 @@ namespace kagome::runtime {
     // need to store it because it has to be the same in different runtime calls
     // to keep accumulated changes for commit to the main storage
     std::shared_ptr<PersistentBatch> persistent_batch_;
+
+    // layers of the nested transactions over the persistent batch, each one
+    // keeps only the changes made in it and is the parent of the next one
+    std::vector<std::shared_ptr<storage::trie::TopperTrieBatch>>
+        transaction_layers_;
+
+    // keys accessed by the runtime, while the recording is on
+    boost::optional<std::set<common::Buffer>> accessed_keys_;
   };
 
 }  // namespace kagome::runtime
 
+OUTCOME_HPP_DECLARE_ERROR(kagome::runtime, TrieStorageProviderImpl::Error);
+
 #endif  // KAGOME_CORE_RUNTIME_COMMON_TRIE_STORAGE_PROVIDER_IMPL
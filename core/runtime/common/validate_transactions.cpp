@@ -0,0 +1,32 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/validate_transactions.hpp"
+
+namespace kagome::runtime {
+
+  std::vector<outcome::result<primitives::TransactionValidity>>
+  validateTransactions(
+      TaggedTransactionQueue &api,
+      const std::vector<std::reference_wrapper<const primitives::Extrinsic>>
+          &extrinsics,
+      const std::shared_ptr<common::WorkerPool> &workers) {
+    std::vector<outcome::result<primitives::TransactionValidity>> validities(
+        extrinsics.size(),
+        outcome::success(primitives::TransactionValidity{}));
+    auto validate = [&](size_t i) {
+      validities[i] = api.validate_transaction(extrinsics[i]);
+    };
+    if (workers != nullptr) {
+      workers->parallelFor(extrinsics.size(), validate);
+    } else {
+      for (size_t i = 0; i < extrinsics.size(); ++i) {
+        validate(i);
+      }
+    }
+    return validities;
+  }
+
+}  // namespace kagome::runtime
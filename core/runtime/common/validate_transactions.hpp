@@ -0,0 +1,34 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_COMMON_VALIDATE_TRANSACTIONS_HPP
+#define KAGOME_CORE_RUNTIME_COMMON_VALIDATE_TRANSACTIONS_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/worker_pool.hpp"
+#include "runtime/tagged_transaction_queue.hpp"
+
+namespace kagome::runtime {
+
+  /**
+   * Validates each of \arg extrinsics with \arg api. The validation is an
+   * ephemeral runtime call, which runs on an instance of its own, so several
+   * of them run concurrently on \arg workers, if any, otherwise they run on
+   * the calling thread
+   * @return validities in the order of the extrinsics
+   */
+  std::vector<outcome::result<primitives::TransactionValidity>>
+  validateTransactions(
+      TaggedTransactionQueue &api,
+      const std::vector<std::reference_wrapper<const primitives::Extrinsic>>
+          &extrinsics,
+      const std::shared_ptr<common::WorkerPool> &workers);
+
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_CORE_RUNTIME_COMMON_VALIDATE_TRANSACTIONS_HPP
@@ -0,0 +1,45 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_RAW_CALL_HPP
+#define KAGOME_CORE_RUNTIME_RAW_CALL_HPP
+
+#include <string_view>
+#include <vector>
+
+#include <gsl/span>
+#include <outcome/outcome.hpp>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+
+namespace kagome::runtime {
+
+  /**
+   * Calls of the exports of the runtime by their names, which arguments and
+   * results are encoded by the callers, such as the peers asking for the
+   * proofs of the calls
+   */
+  class RawCall {
+   public:
+    virtual ~RawCall() = default;
+
+    /**
+     * Calls export \arg method with the encoded \arg args at the state of
+     * \arg state_root, the changes made by the call are discarded
+     * @param accessed_keys receives the keys of the state accessed by the
+     * call
+     * @return encoded result of the call
+     */
+    virtual outcome::result<common::Buffer> callAt(
+        const common::Hash256 &state_root,
+        std::string_view method,
+        gsl::span<const uint8_t> args,
+        std::vector<common::Buffer> &accessed_keys) = 0;
+  };
+
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_CORE_RUNTIME_RAW_CALL_HPP
@@ -0,0 +1,162 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_RUNTIME_RUNTIME_PROFILER_HPP
+#define KAGOME_CORE_RUNTIME_RUNTIME_PROFILER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "common/duration_histogram.hpp"
+#include "runtime/wasm_memory.hpp"
+
+namespace kagome::runtime {
+
+  /**
+   * Collects the number and the durations of the calls of the runtime
+   * exports and of the host functions, the usage of the wasm heap by the
+   * exports, and the number of bytes copied between the host and the wasm
+   * memory. Does nothing but checking a flag
+   * while it is disabled
+   */
+  class RuntimeProfiler {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    using CallStats = common::DurationHistogram::Stats;
+
+    struct HeapStats {
+      uint64_t calls = 0;
+      uint64_t allocations = 0;
+      uint64_t bytes_allocated = 0;
+      uint64_t bytes_freed = 0;
+      // the largest heap of a call
+      WasmSize peak_heap = 0;
+      // times the memory was grown by the allocator
+      uint64_t grows = 0;
+      // share of the heaps not taken by the allocations alive at their
+      // peaks, i.e. lost to the headers, the rounding of the sizes and the
+      // free chunks not reused, over all the calls
+      double fragmentation = 0;
+    };
+
+    struct Report {
+      // by names of the export methods
+      std::map<std::string, CallStats> exports;
+      // by names of the export methods
+      std::map<std::string, HeapStats> heaps;
+      // by names of the host functions
+      std::map<std::string, CallStats> host_functions;
+      // by the host from the wasm memory
+      uint64_t bytes_loaded = 0;
+      // by the host to the wasm memory
+      uint64_t bytes_stored = 0;
+    };
+
+    /**
+     * Measures the time from its construction to its destruction, if the
+     * profiler is enabled at the construction
+     */
+    class Timer {
+     public:
+      Timer(Timer &&) = delete;
+      Timer(const Timer &) = delete;
+      Timer &operator=(Timer &&) = delete;
+      Timer &operator=(const Timer &) = delete;
+      ~Timer();
+
+     private:
+      friend class RuntimeProfiler;
+      Timer(RuntimeProfiler *profiler, std::string_view name, bool host);
+
+      RuntimeProfiler *profiler_;
+      std::string_view name_;
+      bool host_;
+      Clock::time_point start_;
+    };
+
+    explicit RuntimeProfiler(bool enabled = false);
+
+    bool isEnabled() const {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled);
+
+    /**
+     * @return timer of a call of export method \arg name, which has to stay
+     * valid until the timer is destroyed
+     */
+    Timer exportTimer(std::string_view name);
+
+    /**
+     * @return timer of a call of host function \arg name, which has to stay
+     * valid until the timer is destroyed
+     */
+    Timer hostCallTimer(std::string_view name);
+
+    void recordExport(std::string_view name, Clock::duration duration);
+    void recordHostCall(std::string_view name, Clock::duration duration);
+
+    /**
+     * Records \arg stats of the allocator of the memory after a call of
+     * export method \arg name, if the profiler is enabled
+     */
+    void recordHeap(std::string_view name, const AllocatorStats &stats);
+
+    void recordLoaded(size_t bytes) {
+      if (isEnabled()) {
+        bytes_loaded_.fetch_add(bytes, std::memory_order_relaxed);
+      }
+    }
+
+    void recordStored(size_t bytes) {
+      if (isEnabled()) {
+        bytes_stored_.fetch_add(bytes, std::memory_order_relaxed);
+      }
+    }
+
+    Report report() const;
+
+    /**
+     * Forgets everything collected so far
+     */
+    void reset();
+
+   private:
+    using Histograms =
+        std::map<std::string, common::DurationHistogram, std::less<>>;
+
+    struct Heap {
+      HeapStats stats;
+      // sums of the heap sizes and of the peak live allocations of the
+      // calls
+      uint64_t heap_total = 0;
+      uint64_t live_total = 0;
+
+      void add(const AllocatorStats &allocator);
+      HeapStats report() const;
+    };
+
+    static void record(Histograms &histograms,
+                       std::string_view name,
+                       Clock::duration duration);
+
+    std::atomic_bool enabled_;
+    std::atomic_uint64_t bytes_loaded_{0};
+    std::atomic_uint64_t bytes_stored_{0};
+    mutable std::mutex mutex_;
+    Histograms exports_;
+    Histograms host_functions_;
+    std::map<std::string, Heap, std::less<>> heaps_;
+  };
+
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_CORE_RUNTIME_RUNTIME_PROFILER_HPP
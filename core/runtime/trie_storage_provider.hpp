@@ -70,9 +70,53 @@ namespace kagome::runtime {
     virtual bool isCurrentlyPersistent() const = 0;
 
     /**
-     * Commits persistent changes even if the current batch is not persistent
+     * Commits persistent changes even if the current batch is not persistent.
+     * Changes of transactions, which are not committed yet, are not included
      */
     virtual outcome::result<common::Buffer> forceCommit() = 0;
+
+    /**
+     * Calculates the root of the persistent changes, even if the current
+     * batch is not persistent, without writing them to the storage.
+     * Changes of transactions, which are not committed yet, are not included
+     */
+    virtual outcome::result<common::Buffer> calculateRoot() const = 0;
+
+    /**
+     * Starts a transaction nested in the current one, if any: the changes
+     * made to the persistent batch after the call are kept aside until the
+     * transaction is either committed or rolled back
+     */
+    virtual outcome::result<void> startTransaction() = 0;
+
+    /**
+     * Discards the changes made in the innermost transaction
+     */
+    virtual outcome::result<void> rollbackTransaction() = 0;
+
+    /**
+     * Applies the changes made in the innermost transaction to the enclosing
+     * one or, if there is none, to the persistent batch
+     */
+    virtual outcome::result<void> commitTransaction() = 0;
+
+    /**
+     * Starts recording the keys of the state accessed by the runtime,
+     * forgetting the ones recorded before
+     */
+    virtual void startAccessRecording() = 0;
+
+    /**
+     * Records an access of the runtime to \arg key, if the recording is on
+     */
+    virtual void recordAccess(const common::Buffer &key) = 0;
+
+    /**
+     * Stops the recording
+     * @return the keys accessed since startAccessRecording(), sorted and
+     * without repetitions
+     */
+    virtual std::vector<common::Buffer> finishAccessRecording() = 0;
   };
 
 }  // namespace kagome::runtime
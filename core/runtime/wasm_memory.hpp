@@ -15,6 +15,23 @@
 
 namespace kagome::runtime {
 
+  /**
+   * Counters of the allocator of a memory since it was last reset
+   */
+  struct AllocatorStats {
+    uint64_t allocations = 0;
+    // sizes requested by the allocations and freed by the deallocations
+    uint64_t bytes_allocated = 0;
+    uint64_t bytes_freed = 0;
+    // the size of the heap, i.e. of the chunks taken from the memory with
+    // their headers, which only grows until a reset
+    WasmSize heap_size = 0;
+    // the largest size of the allocations alive at once
+    uint64_t peak_live = 0;
+    // number of times the memory was grown to fit an allocation
+    uint64_t grows = 0;
+  };
+
   // The underlying memory can be accessed through unaligned pointers which
   // isn't well-behaved in C++. WebAssembly nonetheless expects it to behave
   // properly. Avoid emitting unaligned load/store by checking for alignment
@@ -34,6 +51,11 @@ namespace kagome::runtime {
      */
     virtual void reset() = 0;
 
+    /**
+     * @return counters of the allocator since the last reset
+     */
+    virtual AllocatorStats allocatorStats() const = 0;
+
     /**
      * @brief Return the size of the memory
      */
@@ -89,6 +111,21 @@ namespace kagome::runtime {
      */
     virtual std::string loadStr(WasmPointer addr, WasmSize n) const = 0;
 
+    /**
+     * Refer to bytes of the memory without copying them
+     * @param addr address in memory of the first byte
+     * @param n number of bytes
+     * @return view of the bytes, which is valid until the memory is resized,
+     * or none if they are not within the memory
+     */
+    virtual boost::optional<gsl::span<const uint8_t>> view(
+        WasmPointer addr, WasmSize n) const = 0;
+    /**
+     * Same as view(), but the bytes may be written through the returned view
+     */
+    virtual boost::optional<gsl::span<uint8_t>> mutableView(WasmPointer addr,
+                                                            WasmSize n) = 0;
+
     /**
      * Store integers at given address of the wasm memory
      */
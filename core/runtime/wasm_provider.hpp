@@ -6,6 +6,7 @@
 #ifndef KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 #define KAGOME_CORE_RUNTIME_WASM_PROVIDER_HPP
 
+#include "common/blob.hpp"
 #include "common/buffer.hpp"
 
 namespace kagome::runtime {
@@ -20,6 +21,12 @@ namespace kagome::runtime {
      * @return wasm runtime code
      */
     virtual const common::Buffer &getStateCode() const = 0;
+
+    /**
+     * @return hash identifying the code returned by getStateCode(), so that
+     * the code itself is never hashed to tell whether it changed
+     */
+    virtual common::Hash256 getStateCodeHash() const = 0;
   };
 }  // namespace kagome::runtime
 
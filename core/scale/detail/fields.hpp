@@ -0,0 +1,158 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_SCALE_DETAIL_FIELDS_HPP
+#define KAGOME_SCALE_DETAIL_FIELDS_HPP
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+#include <boost/endian/conversion.hpp>
+#include "common/outcome_throw.hpp"
+#include "scale/scale_error.hpp"
+#include "scale/scale_fields.hpp"
+
+namespace kagome::scale::detail {
+
+  /// whether \arg T declares its fields with SCALE_FIELDS
+  template <typename T, typename = void>
+  constexpr bool kHasFields = false;
+
+  template <typename T>
+  constexpr bool kHasFields<
+      T,
+      std::void_t<decltype(std::declval<const T &>().scaleFields())>> = true;
+
+  /// whether \arg T is a blob, which is encoded as its bytes only
+  template <typename T>
+  constexpr bool kIsBlob =
+      std::is_base_of_v<std::array<uint8_t, sizeof(T)>, T>
+      and not std::is_same_v<T, std::array<uint8_t, sizeof(T)>>;
+
+  /// type of the field \arg I of the fields \arg Tuple
+  template <typename Tuple, size_t I>
+  using Field = std::remove_cv_t<
+      std::remove_reference_t<std::tuple_element_t<I, Tuple>>>;
+
+  template <typename T>
+  constexpr size_t fixedSize();
+
+  /**
+   * Size of the encoding of \arg T, if it is the same for all the values of
+   * it, and 0 otherwise
+   */
+  template <typename T>
+  constexpr size_t kFixedSize = fixedSize<T>();
+
+  /// @return the total size of the fields from \arg I till \arg End
+  template <typename Tuple, size_t I, size_t End>
+  constexpr size_t fixedFieldsSize() {
+    if constexpr (I < End) {
+      return kFixedSize<Field<Tuple, I>> + fixedFieldsSize<Tuple, I + 1, End>();
+    } else {
+      return 0;
+    }
+  }
+
+  /// @return the index of the first field from \arg I of no fixed size
+  template <typename Tuple, size_t I>
+  constexpr size_t fixedFieldsEnd() {
+    if constexpr (I < std::tuple_size_v<Tuple>) {
+      if constexpr (kFixedSize<Field<Tuple, I>> != 0) {
+        return fixedFieldsEnd<Tuple, I + 1>();
+      } else {
+        return I;
+      }
+    } else {
+      return I;
+    }
+  }
+
+  template <typename T>
+  constexpr size_t fixedSize() {
+    if constexpr (std::is_integral_v<T>) {
+      return sizeof(T);
+    } else if constexpr (kIsBlob<T>) {
+      return sizeof(T);
+    } else if constexpr (kHasFields<T>) {
+      using Fields = decltype(std::declval<const T &>().scaleFields());
+      constexpr auto count = std::tuple_size_v<Fields>;
+      if constexpr (fixedFieldsEnd<Fields, 0>() == count) {
+        return fixedFieldsSize<Fields, 0, count>();
+      } else {
+        return 0;
+      }
+    } else {
+      return 0;
+    }
+  }
+
+  template <size_t I, size_t End, typename Tuple>
+  void writeFixedFields(uint8_t *out, const Tuple &fields);
+
+  /**
+   * Writes \arg value of a fixed size to \arg out as it is encoded
+   */
+  template <typename T>
+  void writeFixed(uint8_t *out, const T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      *out = value ? 1u : 0u;
+    } else if constexpr (std::is_integral_v<T>) {
+      auto little = boost::endian::native_to_little(value);
+      std::memcpy(out, &little, sizeof(T));
+    } else if constexpr (kIsBlob<T>) {
+      std::memcpy(out, value.data(), sizeof(T));
+    } else {
+      auto fields = value.scaleFields();
+      writeFixedFields<0, std::tuple_size_v<decltype(fields)>>(out, fields);
+    }
+  }
+
+  /// writes the fields from \arg I till \arg End to \arg out
+  template <size_t I, size_t End, typename Tuple>
+  void writeFixedFields(uint8_t *out, const Tuple &fields) {
+    if constexpr (I < End) {
+      writeFixed<Field<Tuple, I>>(out, std::get<I>(fields));
+      writeFixedFields<I + 1, End>(out + kFixedSize<Field<Tuple, I>>, fields);
+    }
+  }
+
+  template <size_t I, size_t End, typename Tuple>
+  void readFixedFields(const uint8_t *in, Tuple &fields);
+
+  /**
+   * Reads \arg value of a fixed size from its encoding \arg in
+   */
+  template <typename T>
+  void readFixed(const uint8_t *in, T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      if (*in > 1u) {
+        common::raise(DecodeError::UNEXPECTED_VALUE);
+      }
+      value = *in == 1u;
+    } else if constexpr (std::is_integral_v<T>) {
+      std::memcpy(&value, in, sizeof(T));
+      boost::endian::little_to_native_inplace(value);
+    } else if constexpr (kIsBlob<T>) {
+      std::memcpy(value.data(), in, sizeof(T));
+    } else {
+      auto fields = value.scaleFields();
+      readFixedFields<0, std::tuple_size_v<decltype(fields)>>(in, fields);
+    }
+  }
+
+  /// reads the fields from \arg I till \arg End from \arg in
+  template <size_t I, size_t End, typename Tuple>
+  void readFixedFields(const uint8_t *in, Tuple &fields) {
+    if constexpr (I < End) {
+      readFixed<Field<Tuple, I>>(in, std::get<I>(fields));
+      readFixedFields<I + 1, End>(in + kFixedSize<Field<Tuple, I>>, fields);
+    }
+  }
+
+}  // namespace kagome::scale::detail
+
+#endif  // KAGOME_SCALE_DETAIL_FIELDS_HPP
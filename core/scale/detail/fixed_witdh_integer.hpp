@@ -9,9 +9,11 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 #include <boost/endian/arithmetic.hpp>
+#include <gsl/span>
 #include "common/outcome_throw.hpp"
 #include "macro/unreachable.hpp"
 #include "scale/scale_error.hpp"
@@ -33,10 +35,7 @@ namespace kagome::scale::detail {
     constexpr size_t bits = size * 8;
     boost::endian::endian_buffer<boost::endian::order::little, T, bits> buf{};
     buf = value;  // cannot initialize, only assign
-    for (size_t i = 0; i < size; ++i) {
-      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-      out << buf.data()[i];
-    }
+    out.putBytes(gsl::make_span(buf.data(), size));
   }
 
   /**
@@ -83,6 +82,14 @@ namespace kagome::scale::detail {
       UNREACHABLE
     }
 
+    // the little-endian hosts keep the integers as they are encoded
+    if constexpr (boost::endian::order::native
+                  == boost::endian::order::little) {
+      I v{};
+      std::memcpy(&v, stream.nextBytes(size).data(), size);
+      return v;
+    }
+
     // get integer as 4 bytes from little-endian stream
     // and represent it as native-endian unsigned int eger
     uint64_t v = 0u;
@@ -30,7 +30,48 @@ namespace kagome::scale {
     } catch (std::system_error &e) {
       return outcome::failure(e.code());
     }
-    return s.data();
+    return std::move(s).data();
+  }
+
+  /**
+   * @brief computes the size of the data encoded, without keeping it
+   * @tparam Args primitive types to be encoded
+   * @param args data to encode
+   * @return number of bytes \arg args are encoded to
+   */
+  template <typename... Args>
+  outcome::result<size_t> encodedSize(Args &&... args) {
+    // the sizes of the values of a fixed size are known without encoding
+    if constexpr (((detail::kFixedSize<std::decay_t<Args>> != 0) and ...)) {
+      return (size_t{0} + ... + detail::kFixedSize<std::decay_t<Args>>);
+    }
+    ScaleEncoderStream s{true};
+    try {
+      (s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return s.size();
+  }
+
+  /**
+   * @brief encodes primitives data to the buffer of the caller
+   * @tparam Args primitive types to be encoded
+   * @param out buffer to write to, EncodeError::NOT_ENOUGH_SPACE is returned
+   * if the data doesn't fit it
+   * @param args data to encode
+   * @return number of bytes written
+   */
+  template <typename... Args>
+  outcome::result<size_t> encodeInto(gsl::span<uint8_t> out,
+                                     Args &&... args) {
+    ScaleEncoderStream s{out};
+    try {
+      (s << ... << std::forward<Args>(args));
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    return s.size();
   }
 
   /**
@@ -117,15 +117,31 @@ namespace kagome::scale {
   }
 
   ScaleDecoderStream &ScaleDecoderStream::operator>>(std::string &v) {
-    std::vector<uint8_t> collection;
-    *this >> collection;
-    v.clear();
-    v.append(collection.begin(), collection.end());
+    CompactInteger size{0u};
+    *this >> size;
+    if (size > std::numeric_limits<uint64_t>::max()) {
+      common::raise(DecodeError::TOO_MANY_ITEMS);
+    }
+    auto bytes = nextBytes(size.convert_to<uint64_t>());
+    v.assign(bytes.begin(), bytes.end());
+    return *this;
+  }
+
+  ScaleDecoderStream &ScaleDecoderStream::operator>>(
+      gsl::span<const uint8_t> &v) {
+    CompactInteger size{0u};
+    *this >> size;
+    if (size > std::numeric_limits<uint64_t>::max()) {
+      common::raise(DecodeError::TOO_MANY_ITEMS);
+    }
+    v = nextBytes(size.convert_to<uint64_t>());
     return *this;
   }
 
   bool ScaleDecoderStream::hasMore(uint64_t n) const {
-    return static_cast<SizeType>(current_index_ + n) <= span_.size();
+    // the number of the bytes left is compared, as a decoded size may be
+    // large enough to overflow the sum
+    return n <= static_cast<uint64_t>(span_.size() - current_index_);
   }
 
   uint8_t ScaleDecoderStream::nextByte() {
@@ -135,4 +151,14 @@ namespace kagome::scale {
     ++current_index_;
     return *current_iterator_++;
   }
+
+  gsl::span<const uint8_t> ScaleDecoderStream::nextBytes(uint64_t n) {
+    if (not hasMore(n)) {
+      common::raise(DecodeError::NOT_ENOUGH_DATA);
+    }
+    auto bytes = span_.subspan(current_index_, n);
+    current_index_ += n;
+    current_iterator_ += n;
+    return bytes;
+  }
 }  // namespace kagome::scale
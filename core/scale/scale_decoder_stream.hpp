@@ -7,11 +7,14 @@
 #define KAGOME_CORE_SCALE_SCALE_DECODER_STREAM_HPP
 
 #include <array>
+#include <cstring>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/optional.hpp>
 #include <gsl/span>
 #include "common/outcome_throw.hpp"
+#include "scale/detail/fields.hpp"
 #include "scale/detail/fixed_witdh_integer.hpp"
 #include "scale/detail/tuple.hpp"
 #include "scale/detail/variant.hpp"
@@ -108,7 +111,7 @@ namespace kagome::scale {
       // decode value
       T t{};
       *this >> t;
-      v = t;
+      v = std::move(t);
 
       return *this;
     }
@@ -120,6 +123,31 @@ namespace kagome::scale {
      */
     ScaleDecoderStream &operator>>(CompactInteger &v);
 
+    /**
+     * @brief scale-decodes integer field encoded as compact integer
+     * @param v field reference
+     * @return reference to stream
+     */
+    template <typename T>
+    ScaleDecoderStream &operator>>(CompactField<T> &v) {
+      CompactInteger value;
+      *this >> value;
+      v.value = value.convert_to<T>();
+      return *this;
+    }
+
+    /**
+     * @brief scale-decodes the fields of a struct declared by SCALE_FIELDS
+     * @tparam T struct type
+     * @param v struct reference
+     * @return reference to stream
+     */
+    template <typename T, typename = std::enable_if_t<detail::kHasFields<T>>>
+    ScaleDecoderStream &operator>>(T &v) {
+      auto fields = v.scaleFields();
+      return decodeFields<0>(fields);
+    }
+
     /**
      * @brief decodes collection of items
      * @tparam T item type
@@ -138,6 +166,19 @@ namespace kagome::scale {
         common::raise(DecodeError::TOO_MANY_ITEMS);
       }
       auto item_count = size.convert_to<size_type>();
+      // the bytes are copied at once, as the payloads of the network
+      // messages, such as the extrinsics, may take megabytes
+      if constexpr (std::is_same_v<T, uint8_t>) {
+        auto bytes = nextBytes(item_count);
+        v.assign(bytes.begin(), bytes.end());
+        return *this;
+      }
+      if constexpr (kCopiedAsBytes<T>) {
+        auto bytes = nextItemBytes<T>(item_count);
+        v.resize(item_count);
+        std::memcpy(v.data(), bytes.data(), bytes.size());
+        return *this;
+      }
       v.reserve(item_count);
       for (size_type i = 0u; i < item_count; ++i) {
         T t{};
@@ -148,7 +189,8 @@ namespace kagome::scale {
     }
 
     /**
-     * @brief decodes array of items
+     * @brief decodes array of items, which are preceded by their number as
+     * the ones of the collections are
      * @tparam T item type
      * @tparam size of the array
      * @param a reference to the array
@@ -156,12 +198,21 @@ namespace kagome::scale {
      */
     template <typename T, size_t size>
     ScaleDecoderStream &operator>>(std::array<T, size> &a) {
-      // TODO(akvinikym) PRE-285: bad implementation: maybe move to another file
-      // and implement it
-      std::vector<T> v;
-      v.reserve(size);
-      *this >> v;
-      std::copy(v.begin(), v.end(), a.begin());
+      CompactInteger count{0u};
+      *this >> count;
+      // the items past the decoded ones are left as they are
+      if (count > size) {
+        common::raise(DecodeError::TOO_MANY_ITEMS);
+      }
+      auto item_count = count.convert_to<size_t>();
+      if constexpr (kCopiedAsBytes<T>) {
+        auto bytes = nextItemBytes<T>(item_count);
+        std::memcpy(a.data(), bytes.data(), bytes.size());
+        return *this;
+      }
+      for (size_t i = 0u; i < item_count; ++i) {
+        *this >> a[i];
+      }
       return *this;
     }
 
@@ -182,6 +233,14 @@ namespace kagome::scale {
      */
     ScaleDecoderStream &operator>>(std::string &v);
 
+    /**
+     * @brief decodes a collection of bytes as the slice of the decoded span
+     * it takes, without copying them
+     * @param v the slice, valid as long as the decoded span is
+     * @return reference to stream
+     */
+    ScaleDecoderStream &operator>>(gsl::span<const uint8_t> &v);
+
     /**
      * @brief hasMore Checks whether n more bytes are available
      * @param n Number of bytes to check
@@ -196,7 +255,54 @@ namespace kagome::scale {
      */
     uint8_t nextByte();
 
+    /**
+     * @brief takes \arg n bytes from stream and advances current byte
+     * iterator by them
+     * @return the bytes, valid as long as the decoded span is
+     */
+    gsl::span<const uint8_t> nextBytes(uint64_t n);
+
    private:
+    /**
+     * @brief decodes the fields from \arg I on, the adjacent ones of fixed
+     * size are checked against the bytes left and read at once
+     */
+    template <size_t I, typename Tuple>
+    ScaleDecoderStream &decodeFields(Tuple &fields) {
+      if constexpr (I < std::tuple_size_v<Tuple>) {
+        constexpr auto end = detail::fixedFieldsEnd<Tuple, I>();
+        if constexpr (end == I) {
+          *this >> std::get<I>(fields);
+          return decodeFields<I + 1>(fields);
+        } else {
+          auto bytes = nextBytes(detail::fixedFieldsSize<Tuple, I, end>());
+          detail::readFixedFields<I, end>(bytes.data(), fields);
+          return decodeFields<end>(fields);
+        }
+      }
+      return *this;
+    }
+
+    /// whether the items of \arg T are encoded as they are in memory, and
+    /// so are decoded by copying the bytes of them all at once
+    template <typename T>
+    static constexpr bool kCopiedAsBytes =
+        std::is_integral_v<T> and not std::is_same_v<T, bool>
+        and (sizeof(T) == 1u
+             or boost::endian::order::native == boost::endian::order::little);
+
+    /**
+     * @brief takes the bytes of \arg count items of \arg T from stream,
+     * checked against the bytes left once
+     */
+    template <typename T>
+    gsl::span<const uint8_t> nextItemBytes(uint64_t count) {
+      if (count > std::numeric_limits<uint64_t>::max() / sizeof(T)) {
+        common::raise(DecodeError::NOT_ENOUGH_DATA);
+      }
+      return nextBytes(count * sizeof(T));
+    }
+
     bool decodeBool();
     /**
      * @brief special case of optional values as described in specification
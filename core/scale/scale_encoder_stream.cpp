@@ -5,6 +5,8 @@
 
 #include "scale/scale_encoder_stream.hpp"
 
+#include <algorithm>
+
 #include "common/outcome_throw.hpp"
 #include "scale/scale_error.hpp"
 #include "scale/types.hpp"
@@ -119,17 +121,62 @@ namespace kagome::scale {
     }
   }  // namespace
 
-  ByteArray ScaleEncoderStream::data() const {
-    ByteArray buffer(stream_.size(), 0u);
-    for (auto &&[it, dest] = std::pair(stream_.begin(), buffer.begin());
-         it != stream_.end(); ++it, ++dest) {
-      *dest = *it;
+  ScaleEncoderStream::ScaleEncoderStream(bool drop_data)
+      : sink_{drop_data ? Sink::COUNTER : Sink::BUFFER} {}
+
+  ScaleEncoderStream::ScaleEncoderStream(gsl::span<uint8_t> out)
+      : sink_{Sink::SPAN}, out_{out} {}
+
+  ByteArray ScaleEncoderStream::data() const & {
+    return stream_;
+  }
+
+  ByteArray ScaleEncoderStream::data() && {
+    return std::move(stream_);
+  }
+
+  void ScaleEncoderStream::reserve(size_t bytes) {
+    stream_.reserve(bytes);
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::putBytes(
+      gsl::span<const uint8_t> bytes) {
+    switch (sink_) {
+      case Sink::BUFFER:
+        stream_.insert(stream_.end(), bytes.begin(), bytes.end());
+        break;
+      case Sink::SPAN:
+        if (static_cast<size_t>(bytes.size()) > out_.size() - size_) {
+          common::raise(EncodeError::NOT_ENOUGH_SPACE);
+        }
+        std::copy(bytes.begin(), bytes.end(), out_.begin() + size_);
+        break;
+      case Sink::COUNTER:
+        break;
     }
-    return buffer;
+    size_ += bytes.size();
+    return *this;
   }
 
   ScaleEncoderStream &ScaleEncoderStream::putByte(uint8_t v) {
+    if (sink_ != Sink::BUFFER) {
+      return putBytes(gsl::make_span(&v, 1));
+    }
     stream_.push_back(v);
+    ++size_;
+    return *this;
+  }
+
+  ScaleEncoderStream &ScaleEncoderStream::encodeLength(size_t size) {
+    if (size < compact::EncodingCategoryLimits::kMinUint16) {
+      encodeFirstCategory(static_cast<uint8_t>(size), *this);
+    } else if (size < compact::EncodingCategoryLimits::kMinUint32) {
+      encodeSecondCategory(static_cast<uint16_t>(size), *this);
+    } else if (size < compact::EncodingCategoryLimits::kMinBigInteger) {
+      encodeThirdCategory(static_cast<uint32_t>(size), *this);
+    } else {
+      encodeCompactInteger(size, *this);
+    }
     return *this;
   }
 
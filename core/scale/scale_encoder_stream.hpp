@@ -6,28 +6,70 @@
 #ifndef KAGOME_CORE_SCALE_SCALE_ENCODER_STREAM_HPP
 #define KAGOME_CORE_SCALE_SCALE_ENCODER_STREAM_HPP
 
-#include <deque>
+#include <vector>
 
 #include <boost/optional.hpp>
 #include <gsl/span>
+#include "scale/detail/fields.hpp"
 #include "scale/detail/fixed_witdh_integer.hpp"
 #include "scale/detail/tuple.hpp"
 #include "scale/detail/variant.hpp"
 
 namespace kagome::scale {
   /**
-   * @class ScaleEncoderStream designed to scale-encode data to stream
+   * @class ScaleEncoderStream designed to scale-encode data to stream. The
+   * data is written to a contiguous buffer, the collections of bytes are
+   * appended to it at once. The stream may also write the data to a span
+   * given instead, or only count its size
    */
   class ScaleEncoderStream {
    public:
     // special tag to differentiate encoding streams from others
     static constexpr auto is_encoder_stream = true;
 
+    ScaleEncoderStream() = default;
+
+    /**
+     * @param drop_data - if true, the data is not kept, only its size is
+     * counted
+     */
+    explicit ScaleEncoderStream(bool drop_data);
+
+    /**
+     * @param out - span the data is written to, encoding more data than it
+     * fits raises EncodeError::NOT_ENOUGH_SPACE
+     */
+    explicit ScaleEncoderStream(gsl::span<uint8_t> out);
+
     /// Getters
     /**
      * @return vector of bytes containing encoded data
      */
-    std::vector<uint8_t> data() const;
+    std::vector<uint8_t> data() const &;
+
+    /**
+     * @return vector of bytes containing encoded data, which is moved out of
+     * the stream
+     */
+    std::vector<uint8_t> data() &&;
+
+    /**
+     * @return number of bytes encoded
+     */
+    size_t size() const {
+      return size_;
+    }
+
+    /**
+     * @brief reserves the buffer for \arg bytes of encoded data
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * @brief appends \arg bytes as they are, without their length
+     * @return reference to stream
+     */
+    ScaleEncoderStream &putBytes(gsl::span<const uint8_t> bytes);
 
     /**
      * @brief scale-encodes pair of values
@@ -71,6 +113,9 @@ namespace kagome::scale {
      */
     template <class T>
     ScaleEncoderStream &operator<<(const std::vector<T> &c) {
+      if constexpr (std::is_same_v<T, uint8_t>) {
+        return encodeBytes(c);
+      }
       return encodeCollection(c.size(), c.begin(), c.end());
     }
 
@@ -101,6 +146,9 @@ namespace kagome::scale {
      */
     template <class T>
     ScaleEncoderStream &operator<<(const gsl::span<T> &v) {
+      if constexpr (std::is_same_v<std::remove_const_t<T>, uint8_t>) {
+        return encodeBytes(v);
+      }
       return encodeCollection(v.size(), v.begin(), v.end());
     }
 
@@ -115,6 +163,9 @@ namespace kagome::scale {
     ScaleEncoderStream &operator<<(const std::array<T, size> &a) {
       // TODO(akvinikym) PRE-285: bad implementation: maybe move to another file
       // and implement it
+      if constexpr (std::is_same_v<T, uint8_t>) {
+        return encodeBytes(a);
+      }
       return encodeCollection(size, a.begin(), a.end());
     }
 
@@ -145,7 +196,8 @@ namespace kagome::scale {
      * @return reference to stream
      */
     ScaleEncoderStream &operator<<(std::string_view sv) {
-      return encodeCollection(sv.size(), sv.begin(), sv.end());
+      return encodeBytes(gsl::make_span(
+          reinterpret_cast<const uint8_t *>(sv.data()), sv.size()));
     }
 
     /**
@@ -180,6 +232,27 @@ namespace kagome::scale {
      */
     ScaleEncoderStream &operator<<(const CompactInteger &v);
 
+    /**
+     * @brief scale-encodes integer field as compact integer
+     * @param v field to encode
+     * @return reference to stream
+     */
+    template <typename T>
+    ScaleEncoderStream &operator<<(const CompactField<T> &v) {
+      return *this << CompactInteger{v.value};
+    }
+
+    /**
+     * @brief scale-encodes the fields of a struct declared by SCALE_FIELDS
+     * @tparam T struct type
+     * @param v struct to encode
+     * @return reference to stream
+     */
+    template <typename T, typename = std::enable_if_t<detail::kHasFields<T>>>
+    ScaleEncoderStream &operator<<(const T &v) {
+      return encodeFields<0>(v.scaleFields());
+    }
+
    protected:
     /**
      * @brief scale-encodes any collection
@@ -190,10 +263,8 @@ namespace kagome::scale {
      * @return reference to stream
      */
     template <class It>
-    ScaleEncoderStream &encodeCollection(const CompactInteger &size,
-                                         It &&begin,
-                                         It &&end) {
-      *this << size;
+    ScaleEncoderStream &encodeCollection(size_t size, It &&begin, It &&end) {
+      encodeLength(size);
       // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
       for (auto &&it = begin; it != end; ++it) {
         *this << *it;
@@ -210,8 +281,48 @@ namespace kagome::scale {
     ScaleEncoderStream &putByte(uint8_t v);
 
    private:
+    /**
+     * @brief encodes the fields from \arg I on, the adjacent ones of fixed
+     * size are written at once
+     */
+    template <size_t I, typename Tuple>
+    ScaleEncoderStream &encodeFields(const Tuple &fields) {
+      if constexpr (I < std::tuple_size_v<Tuple>) {
+        constexpr auto end = detail::fixedFieldsEnd<Tuple, I>();
+        if constexpr (end == I) {
+          *this << std::get<I>(fields);
+          return encodeFields<I + 1>(fields);
+        } else {
+          std::array<uint8_t, detail::fixedFieldsSize<Tuple, I, end>()> bytes;
+          detail::writeFixedFields<I, end>(bytes.data(), fields);
+          putBytes(bytes);
+          return encodeFields<end>(fields);
+        }
+      }
+      return *this;
+    }
+
+    enum class Sink { BUFFER, SPAN, COUNTER };
+
+    /**
+     * @brief compact-encodes the length of a collection, the ones which
+     * don't need a big integer are encoded without constructing it
+     */
+    ScaleEncoderStream &encodeLength(size_t size);
+
+    /**
+     * @brief scale-encodes collection of bytes, which are appended at once
+     */
+    ScaleEncoderStream &encodeBytes(gsl::span<const uint8_t> bytes) {
+      return encodeLength(bytes.size()).putBytes(bytes);
+    }
+
     ScaleEncoderStream &encodeOptionalBool(const boost::optional<bool> &v);
-    std::deque<uint8_t> stream_;
+
+    Sink sink_ = Sink::BUFFER;
+    std::vector<uint8_t> stream_;
+    gsl::span<uint8_t> out_;
+    size_t size_ = 0;
   };
 
 }  // namespace kagome::scale
@@ -16,6 +16,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::scale, EncodeError, e) {
       return "wrong compact encoding category";
     case EncodeError::WRONG_ALTERNATIVE:
       return "wrong cast to alternative";
+    case EncodeError::NOT_ENOUGH_SPACE:
+      return "not enough space for encoded data";
   }
   return "unknown EncodeError";
 }
@@ -0,0 +1,60 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_SCALE_SCALE_FIELDS_HPP
+#define KAGOME_CORE_SCALE_SCALE_FIELDS_HPP
+
+#include <tuple>
+#include <utility>
+
+/**
+ * Declares the fields of the struct it is put in, which are encoded and
+ * decoded in the given order by the streams, instead of the operators
+ * written by hand. The fields encoded as compact integers are wrapped with
+ * scale::asCompact:
+ *
+ *   struct Header {
+ *     Hash256 parent;
+ *     BlockNumber number;
+ *     SCALE_FIELDS(parent, scale::asCompact(number))
+ *   };
+ *
+ * The adjacent fields of fixed size, which are the integers, the blobs and
+ * the structs of such fields only, are written and read at once
+ */
+#define SCALE_FIELDS(...)                                    \
+  auto scaleFields() {                                       \
+    return ::kagome::scale::detail::makeFields(__VA_ARGS__); \
+  }                                                          \
+  auto scaleFields() const {                                 \
+    return ::kagome::scale::detail::makeFields(__VA_ARGS__); \
+  }
+
+namespace kagome::scale {
+
+  /**
+   * Field of an integer type, which is encoded as a compact integer
+   */
+  template <typename T>
+  struct CompactField {
+    T &value;
+  };
+
+  template <typename T>
+  CompactField<T> asCompact(T &value) {
+    return {value};
+  }
+
+  namespace detail {
+    /// the fields are referred to, and the wrappers of them are kept
+    template <typename... T>
+    std::tuple<T...> makeFields(T &&... fields) {
+      return std::tuple<T...>{std::forward<T>(fields)...};
+    }
+  }  // namespace detail
+
+}  // namespace kagome::scale
+
+#endif  // KAGOME_CORE_SCALE_SCALE_FIELDS_HPP
@@ -51,6 +51,15 @@ namespace kagome::storage::changes_trie {
      */
     virtual outcome::result<common::Hash256> constructChangesTrie(
         const primitives::BlockHash &parent, const ChangesTrieConfig &conf) = 0;
+
+    /**
+     * Supposed to be called when the changes of the latest registered block
+     * are committed to the storage as the ones of \arg block on top of
+     * \arg parent. The changes are dropped if the latest registered block is
+     * on top of another one, as they are not of \arg block then
+     */
+    virtual void onBlockImported(const primitives::BlockHash &block,
+                                 const primitives::BlockHash &parent) = 0;
   };
 
 }  // namespace kagome::storage::changes_trie
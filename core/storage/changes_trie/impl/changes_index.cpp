@@ -0,0 +1,258 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/changes_trie/impl/changes_index.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::changes_trie,
+                            ChangesIndex::Error,
+                            e) {
+  using E = kagome::storage::changes_trie::ChangesIndex::Error;
+  switch (e) {
+    case E::BLOCK_NOT_INDEXED:
+      return "The changes of the block are not indexed";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::storage::changes_trie {
+
+  namespace {
+    // subspaces of the prefix of the index
+    constexpr uint8_t kRecordTag = 'r';
+    constexpr uint8_t kDigestTag = 'd';
+    constexpr uint8_t kKeyTag = 'k';
+
+    bool startsWith(const common::Buffer &key, const common::Buffer &prefix) {
+      return key.size() >= prefix.size()
+             and std::equal(prefix.begin(), prefix.end(), key.begin());
+    }
+
+    /**
+     * @return number of the blocks in the range of a digest of \arg level,
+     * saturated, so that a range too long is never complete
+     */
+    uint64_t rangeOf(uint32_t digest_interval, uint32_t level) {
+      uint64_t range = 1;
+      for (uint32_t i = 0; i < level; ++i) {
+        if (range > std::numeric_limits<uint32_t>::max()) {
+          break;
+        }
+        range *= digest_interval;
+      }
+      return range;
+    }
+  }  // namespace
+
+  ChangesIndex::ChangesIndex(std::shared_ptr<BufferStorage> storage,
+                             common::Buffer prefix)
+      : storage_{std::move(storage)}, prefix_{std::move(prefix)} {
+    BOOST_ASSERT(storage_ != nullptr);
+  }
+
+  outcome::result<void> ChangesIndex::addBlock(
+      const primitives::BlockInfo &block,
+      const primitives::BlockHash &parent,
+      const std::vector<common::Buffer> &keys,
+      const ChangesTrieConfig &config) {
+    auto levels = config.digest_interval > 1 ? config.digest_levels : 0;
+    Record record{block.block_number, config.digest_interval, {parent}};
+    OUTCOME_TRY(parent_record, getRecord(parent));
+    if (parent_record
+        and parent_record->digest_interval == config.digest_interval) {
+      for (uint32_t level = 1; level <= levels; ++level) {
+        auto range = rangeOf(config.digest_interval, level);
+        if (parent_record->number % range == 0) {
+          record.previous.push_back(parent);
+        } else if (parent_record->previous.size() > level) {
+          record.previous.push_back(parent_record->previous[level]);
+        } else {
+          break;
+        }
+      }
+    }
+
+    auto batch = storage_->batch();
+    OUTCOME_TRY(encoded, scale::encode(record));
+    OUTCOME_TRY(
+        batch->put(recordKey(block.block_hash), common::Buffer{encoded}));
+    auto keys_prefix = keysPrefix(block.block_hash, 0);
+    for (auto &key : keys) {
+      OUTCOME_TRY(batch->put(common::Buffer{keys_prefix}.putBuffer(key),
+                             common::Buffer{}));
+    }
+    OUTCOME_TRY(batch->commit());
+
+    // a digest of a level is made of the ones of the level below, which
+    // are built by then
+    for (uint32_t level = 1; level <= levels and block.block_number != 0;
+         ++level) {
+      if (block.block_number % rangeOf(config.digest_interval, level) != 0) {
+        break;
+      }
+      OUTCOME_TRY(built, addDigest(block.block_hash, record, level));
+      if (not built) {
+        break;
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<bool> ChangesIndex::addDigest(
+      const primitives::BlockHash &block, const Record &record, uint32_t level) {
+    std::set<common::Buffer> keys;
+    auto sub_block = block;
+    auto sub_record = record;
+    for (uint32_t i = 0; i < record.digest_interval; ++i) {
+      if (i != 0) {
+        if (sub_record.previous.size() < level) {
+          return false;
+        }
+        sub_block = sub_record.previous[level - 1];
+        OUTCOME_TRY(next_record, getRecord(sub_block));
+        if (not next_record) {
+          return false;
+        }
+        sub_record = std::move(next_record.value());
+      }
+      if (not hasDigest(sub_block, level - 1)) {
+        return false;
+      }
+      auto prefix = keysPrefix(sub_block, level - 1);
+      auto cursor = storage_->cursor();
+      OUTCOME_TRY(cursor->seek(prefix));
+      while (cursor->isValid()) {
+        OUTCOME_TRY(key, cursor->key());
+        if (not startsWith(key, prefix)) {
+          break;
+        }
+        keys.emplace(key.subbuffer(prefix.size()));
+        OUTCOME_TRY(cursor->next());
+      }
+    }
+
+    auto batch = storage_->batch();
+    auto prefix = keysPrefix(block, level);
+    for (auto &key : keys) {
+      OUTCOME_TRY(
+          batch->put(common::Buffer{prefix}.putBuffer(key), common::Buffer{}));
+    }
+    OUTCOME_TRY(batch->put(digestKey(block, level), common::Buffer{}));
+    OUTCOME_TRY(batch->commit());
+    return true;
+  }
+
+  outcome::result<std::vector<primitives::BlockInfo>> ChangesIndex::keyChanges(
+      const common::Buffer &key,
+      primitives::BlockNumber from,
+      const primitives::BlockInfo &to) const {
+    std::vector<primitives::BlockInfo> blocks;
+    // the genesis block is not imported, so it changes nothing
+    auto block = to;
+    while (block.block_number >= from and block.block_number != 0) {
+      OUTCOME_TRY(record, getRecord(block.block_hash));
+      if (not record) {
+        return Error::BLOCK_NOT_INDEXED;
+      }
+      // the highest level, the digest of which is within the range
+      uint32_t level = 0;
+      while (level + 1 < record->previous.size()) {
+        auto range = rangeOf(record->digest_interval, level + 1);
+        if (block.block_number % range != 0
+            or block.block_number + 1 < from + range
+            or not hasDigest(block.block_hash, level + 1)) {
+          break;
+        }
+        ++level;
+      }
+      OUTCOME_TRY(findChanges(key, block, level, blocks));
+      block = {static_cast<primitives::BlockNumber>(
+                   block.block_number
+                   - rangeOf(record->digest_interval, level)),
+               record->previous[level]};
+    }
+    std::reverse(blocks.begin(), blocks.end());
+    return blocks;
+  }
+
+  outcome::result<void> ChangesIndex::findChanges(
+      const common::Buffer &key,
+      const primitives::BlockInfo &block,
+      uint32_t level,
+      std::vector<primitives::BlockInfo> &blocks) const {
+    if (not storage_->contains(
+            common::Buffer{keysPrefix(block.block_hash, level)}.putBuffer(
+                key))) {
+      return outcome::success();
+    }
+    if (level == 0) {
+      blocks.push_back(block);
+      return outcome::success();
+    }
+    OUTCOME_TRY(record, getRecord(block.block_hash));
+    if (not record) {
+      return Error::BLOCK_NOT_INDEXED;
+    }
+    auto range = rangeOf(record->digest_interval, level - 1);
+    auto sub_block = block;
+    for (uint32_t i = 0; i < record->digest_interval; ++i) {
+      if (i != 0) {
+        OUTCOME_TRY(sub_record, getRecord(sub_block.block_hash));
+        if (not sub_record or sub_record->previous.size() < level) {
+          return Error::BLOCK_NOT_INDEXED;
+        }
+        sub_block = {
+            static_cast<primitives::BlockNumber>(sub_block.block_number - range),
+            sub_record->previous[level - 1]};
+      }
+      OUTCOME_TRY(findChanges(key, sub_block, level - 1, blocks));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<ChangesIndex::Record>>
+  ChangesIndex::getRecord(const primitives::BlockHash &block) const {
+    auto encoded = storage_->get(recordKey(block));
+    if (not encoded) {
+      if (encoded.error() == DatabaseError::NOT_FOUND) {
+        return boost::none;
+      }
+      return encoded.error();
+    }
+    OUTCOME_TRY(record, scale::decode<Record>(encoded.value()));
+    return std::move(record);
+  }
+
+  bool ChangesIndex::hasDigest(const primitives::BlockHash &block,
+                               uint32_t level) const {
+    if (level == 0) {
+      return storage_->contains(recordKey(block));
+    }
+    return storage_->contains(digestKey(block, level));
+  }
+
+  common::Buffer ChangesIndex::recordKey(
+      const primitives::BlockHash &block) const {
+    return common::Buffer{prefix_}.putUint8(kRecordTag).put(block);
+  }
+
+  common::Buffer ChangesIndex::digestKey(const primitives::BlockHash &block,
+                                         uint32_t level) const {
+    return common::Buffer{prefix_}.putUint8(kDigestTag).put(block).putUint32(
+        level);
+  }
+
+  common::Buffer ChangesIndex::keysPrefix(const primitives::BlockHash &block,
+                                          uint32_t level) const {
+    return common::Buffer{prefix_}.putUint8(kKeyTag).put(block).putUint32(
+        level);
+  }
+
+}  // namespace kagome::storage::changes_trie
@@ -0,0 +1,113 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_INDEX
+#define KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_INDEX
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+#include "scale/scale_fields.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/changes_trie/changes_trie_config.hpp"
+
+namespace kagome::storage::changes_trie {
+
+  /**
+   * Keys changed by the imported blocks, which answers what blocks of a range
+   * changed a key without reading the states of the blocks.
+   * The keys of a block are kept as the level 0 of the index. Following the
+   * digests of the changes tries, every digest_interval^level-th block also
+   * gets the keys changed by the digest_interval blocks of the level below,
+   * up to digest_levels, so that the changes of a key over N blocks are
+   * found in O(log N) lookups: a digest, which doesn't have the key, skips
+   * its whole range, and the levels below are looked at only for the ones
+   * having it. Every block refers to the blocks of each level before it on
+   * its own chain, so the forks are indexed independently
+   */
+  class ChangesIndex {
+   public:
+    enum class Error { BLOCK_NOT_INDEXED = 1 };
+
+    /**
+     * @param storage keeps the index under \arg prefix
+     */
+    ChangesIndex(std::shared_ptr<BufferStorage> storage, common::Buffer prefix);
+
+    /**
+     * Records that \arg keys are changed by \arg block, the child of
+     * \arg parent, and builds the digests the block completes according to
+     * \arg config. A digest is not built if a block of its range is missing
+     * in the index, e.g. the ones imported before the index appeared
+     */
+    outcome::result<void> addBlock(const primitives::BlockInfo &block,
+                                   const primitives::BlockHash &parent,
+                                   const std::vector<common::Buffer> &keys,
+                                   const ChangesTrieConfig &config);
+
+    /**
+     * @return blocks in the order of their numbers, from the one with
+     * \arg from number up to \arg to on the chain of the latter, which
+     * change \arg key, BLOCK_NOT_INDEXED if a block of the range is missing
+     * in the index
+     */
+    outcome::result<std::vector<primitives::BlockInfo>> keyChanges(
+        const common::Buffer &key,
+        primitives::BlockNumber from,
+        const primitives::BlockInfo &to) const;
+
+   private:
+    struct Record {
+      primitives::BlockNumber number{};
+      uint32_t digest_interval{};
+      // the parent, then the last block of each digest level before the
+      // block on its chain, while they are known
+      std::vector<primitives::BlockHash> previous;
+
+      SCALE_FIELDS(number, digest_interval, previous)
+    };
+
+    outcome::result<boost::optional<Record>> getRecord(
+        const primitives::BlockHash &block) const;
+
+    /**
+     * Puts the keys of the level \arg level digest of \arg block, made of
+     * the digests of the level below, to the index
+     * @return false if the digest can't be built
+     */
+    outcome::result<bool> addDigest(const primitives::BlockHash &block,
+                                    const Record &record,
+                                    uint32_t level);
+
+    /**
+     * Appends the blocks of the range of the level \arg level digest of
+     * \arg block, which change \arg key, to \arg blocks, the later first
+     */
+    outcome::result<void> findChanges(
+        const common::Buffer &key,
+        const primitives::BlockInfo &block,
+        uint32_t level,
+        std::vector<primitives::BlockInfo> &blocks) const;
+
+    bool hasDigest(const primitives::BlockHash &block, uint32_t level) const;
+
+    common::Buffer recordKey(const primitives::BlockHash &block) const;
+    common::Buffer digestKey(const primitives::BlockHash &block,
+                             uint32_t level) const;
+    common::Buffer keysPrefix(const primitives::BlockHash &block,
+                              uint32_t level) const;
+
+    std::shared_ptr<BufferStorage> storage_;
+    common::Buffer prefix_;
+  };
+
+}  // namespace kagome::storage::changes_trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::changes_trie, ChangesIndex::Error);
+
+#endif  // KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_INDEX
@@ -0,0 +1,175 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/changes_trie/impl/changes_trie_builder.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+
+#include "scale/scale.hpp"
+#include "storage/trie/serialization/ordered_trie_hash.hpp"
+
+namespace kagome::storage::changes_trie {
+
+  namespace {
+    // index of ExtrinsicsChangesKey in ChangesTrie::KeyIndexVariant
+    constexpr uint8_t kExtrinsicsChangesKeyIndex = 1;
+  }  // namespace
+
+  ChangesTrieBuilder::ChangesTrieBuilder()
+      : index_{0, KeyHash{this}, KeyEqual{this}} {}
+
+  size_t ChangesTrieBuilder::KeyHash::operator()(uint32_t entry) const {
+    auto key = builder->keyOf(entry);
+    return std::hash<std::string_view>{}(
+        std::string_view{reinterpret_cast<const char *>(key.data()),
+                         static_cast<size_t>(key.size())});
+  }
+
+  bool ChangesTrieBuilder::KeyEqual::operator()(uint32_t lhs,
+                                                uint32_t rhs) const {
+    auto lhs_key = builder->keyOf(lhs);
+    auto rhs_key = builder->keyOf(rhs);
+    return std::equal(
+        lhs_key.begin(), lhs_key.end(), rhs_key.begin(), rhs_key.end());
+  }
+
+  gsl::span<const uint8_t> ChangesTrieBuilder::keyOf(uint32_t entry) const {
+    if (entry == kProbe) {
+      return probe_;
+    }
+    auto &e = entries_[entry];
+    return {keys_.data() + e.key_offset, e.key_size};
+  }
+
+  uint32_t ChangesTrieBuilder::findOrInsert(gsl::span<const uint8_t> key,
+                                            bool &inserted) {
+    probe_ = key;
+    auto it = index_.find(kProbe);
+    probe_ = {};
+    if (it != index_.end()) {
+      inserted = false;
+      return *it;
+    }
+    inserted = true;
+    auto id = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(Entry{static_cast<uint32_t>(keys_.size()),
+                             static_cast<uint32_t>(key.size()),
+                             false,
+                             false});
+    keys_.insert(keys_.end(), key.begin(), key.end());
+    index_.insert(id);
+    return id;
+  }
+
+  void ChangesTrieBuilder::onPut(gsl::span<const uint8_t> key,
+                                 primitives::ExtrinsicIndex idx,
+                                 bool new_entry) {
+    bool inserted = false;
+    auto id = findOrInsert(key, inserted);
+    if (inserted) {
+      entries_[id].is_new = new_entry;
+    }
+    changes_.push_back(Change{id, idx});
+  }
+
+  void ChangesTrieBuilder::onRemove(gsl::span<const uint8_t> key,
+                                    primitives::ExtrinsicIndex idx) {
+    bool inserted = false;
+    auto id = findOrInsert(key, inserted);
+    if (not inserted and entries_[id].is_new) {
+      // the key is neither in the storage nor in the trie then
+      entries_[id].is_forgotten = true;
+      index_.erase(id);
+      return;
+    }
+    changes_.push_back(Change{id, idx});
+  }
+
+  std::vector<common::Buffer> ChangesTrieBuilder::changedKeys() const {
+    std::vector<common::Buffer> keys;
+    keys.reserve(index_.size());
+    for (uint32_t id = 0; id < entries_.size(); id++) {
+      if (not entries_[id].is_forgotten) {
+        auto key = keyOf(id);
+        keys.emplace_back(std::vector<uint8_t>{key.begin(), key.end()});
+      }
+    }
+    return keys;
+  }
+
+  void ChangesTrieBuilder::clear() {
+    index_.clear();
+    keys_.clear();
+    entries_.clear();
+    changes_.clear();
+  }
+
+  outcome::result<common::Hash256> ChangesTrieBuilder::calculateRoot(
+      primitives::BlockNumber block_number) const {
+    // extrinsics of every entry in the order of the changes, grouped by
+    // entries, so that no per entry containers are needed
+    std::vector<uint32_t> begins(entries_.size() + 1, 0);
+    for (auto &change : changes_) {
+      begins[change.entry + 1]++;
+    }
+    std::partial_sum(begins.begin(), begins.end(), begins.begin());
+    std::vector<primitives::ExtrinsicIndex> extrinsics(changes_.size());
+    auto ends = begins;
+    for (auto &change : changes_) {
+      extrinsics[ends[change.entry]++] = change.extrinsic;
+    }
+
+    // trie entries are encoded the same way as ChangesTrie encodes them
+    OUTCOME_TRY(prefix,
+                scale::encode(kExtrinsicsChangesKeyIndex, block_number));
+    std::vector<uint8_t> data;
+    std::vector<std::pair<size_t, size_t>> key_ranges;
+    std::vector<std::pair<size_t, size_t>> value_ranges;
+    std::vector<uint32_t> order;
+    for (uint32_t id = 0; id < entries_.size(); id++) {
+      if (entries_[id].is_forgotten) {
+        continue;
+      }
+      auto key = keyOf(id);
+      OUTCOME_TRY(key_size,
+                  scale::encode(scale::CompactInteger{key.size()}));
+      auto key_begin = data.size();
+      data.insert(data.end(), prefix.begin(), prefix.end());
+      data.insert(data.end(), key_size.begin(), key_size.end());
+      data.insert(data.end(), key.begin(), key.end());
+      key_ranges.emplace_back(key_begin, data.size() - key_begin);
+
+      OUTCOME_TRY(value,
+                  scale::encode(gsl::span<const primitives::ExtrinsicIndex>(
+                      extrinsics.data() + begins[id],
+                      begins[id + 1] - begins[id])));
+      value_ranges.emplace_back(data.size(), value.size());
+      data.insert(data.end(), value.begin(), value.end());
+      order.push_back(order.size());
+    }
+
+    auto span_of = [&data](const std::pair<size_t, size_t> &range) {
+      return gsl::span<const uint8_t>{data.data() + range.first,
+                                      range.second};
+    };
+    std::sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+      auto lhs_key = span_of(key_ranges[lhs]);
+      auto rhs_key = span_of(key_ranges[rhs]);
+      return std::lexicographical_compare(
+          lhs_key.begin(), lhs_key.end(), rhs_key.begin(), rhs_key.end());
+    });
+    std::vector<trie::SortedTrieEntry> trie_entries;
+    trie_entries.reserve(order.size());
+    for (auto i : order) {
+      trie_entries.emplace_back(span_of(key_ranges[i]),
+                                span_of(value_ranges[i]));
+    }
+    OUTCOME_TRY(root, trie::calculateSortedTrieHash(trie_entries));
+    return common::Hash256::fromSpan(root);
+  }
+
+}  // namespace kagome::storage::changes_trie
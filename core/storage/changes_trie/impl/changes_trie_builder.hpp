@@ -0,0 +1,115 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_TRIE_BUILDER
+#define KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_TRIE_BUILDER
+
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "primitives/common.hpp"
+#include "primitives/extrinsic.hpp"
+
+namespace kagome::storage::changes_trie {
+
+  /**
+   * Accumulates the changes made by the extrinsics of a block in flat arrays
+   * as they happen and calculates the root of the changes trie out of them
+   * in one pass, building neither a map of the changes nor a trie.
+   * The result is the same as the one of ChangesTrie, which is built from a
+   * map of the changes
+   */
+  class ChangesTrieBuilder {
+   public:
+    ChangesTrieBuilder();
+
+    // the index refers to the builder
+    ChangesTrieBuilder(const ChangesTrieBuilder &) = delete;
+    ChangesTrieBuilder &operator=(const ChangesTrieBuilder &) = delete;
+
+    /**
+     * Records that \arg key is put by the extrinsic \arg idx
+     * @param new_entry whether the key is absent in the underlying storage
+     */
+    void onPut(gsl::span<const uint8_t> key,
+               primitives::ExtrinsicIndex idx,
+               bool new_entry);
+
+    /**
+     * Records that \arg key is removed by the extrinsic \arg idx. A key, which
+     * is absent in the underlying storage, is forgotten instead, as it is
+     * just temporary
+     */
+    void onRemove(gsl::span<const uint8_t> key, primitives::ExtrinsicIndex idx);
+
+    /**
+     * @return the keys changed, but the forgotten ones, in the order they
+     * were first changed in
+     */
+    std::vector<common::Buffer> changedKeys() const;
+
+    /**
+     * Forgets all the changes
+     */
+    void clear();
+
+    /**
+     * @return root of the changes trie of the block \arg block_number
+     * containing the recorded changes
+     */
+    outcome::result<common::Hash256> calculateRoot(
+        primitives::BlockNumber block_number) const;
+
+   private:
+    // a changed key, which is a range of keys_
+    struct Entry {
+      uint32_t key_offset;
+      uint32_t key_size;
+      bool is_new;
+      bool is_forgotten;
+    };
+    struct Change {
+      uint32_t entry;
+      primitives::ExtrinsicIndex extrinsic;
+    };
+
+    // an entry id referring to probe_ instead of an actual entry, so that the
+    // index can be searched by a key, which is not in keys_
+    static constexpr uint32_t kProbe = std::numeric_limits<uint32_t>::max();
+
+    struct KeyHash {
+      size_t operator()(uint32_t entry) const;
+      const ChangesTrieBuilder *builder;
+    };
+    struct KeyEqual {
+      bool operator()(uint32_t lhs, uint32_t rhs) const;
+      const ChangesTrieBuilder *builder;
+    };
+
+    gsl::span<const uint8_t> keyOf(uint32_t entry) const;
+
+    /**
+     * @return id of the live entry of \arg key, a new entry if there is none
+     * @param inserted set to whether the entry is new
+     */
+    uint32_t findOrInsert(gsl::span<const uint8_t> key, bool &inserted);
+
+    std::vector<uint8_t> keys_;
+    std::vector<Entry> entries_;
+    // in the order the changes happened
+    std::vector<Change> changes_;
+    // ids of the live entries
+    std::unordered_set<uint32_t, KeyHash, KeyEqual> index_;
+    gsl::span<const uint8_t> probe_;
+  };
+
+}  // namespace kagome::storage::changes_trie
+
+#endif  // KAGOME_STORAGE_CHANGES_TRIE_IMPL_CHANGES_TRIE_BUILDER
@@ -1,7 +1,6 @@
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 
 #include "scale/scale.hpp"
-#include "storage/changes_trie/impl/changes_trie.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::changes_trie,
                             StorageChangesTrackerImpl::Error,
@@ -20,15 +19,12 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::changes_trie,
 namespace kagome::storage::changes_trie {
 
   StorageChangesTrackerImpl::StorageChangesTrackerImpl(
-      std::shared_ptr<storage::trie::PolkadotTrieFactory> trie_factory,
-      std::shared_ptr<storage::trie::Codec> codec)
-      : trie_factory_(std::move(trie_factory)),
-        codec_(std::move(codec)),
-        parent_hash_{},
-        parent_number_{std::numeric_limits<primitives::BlockNumber>::max()} {
-    BOOST_ASSERT(trie_factory_ != nullptr);
-    BOOST_ASSERT(codec_ != nullptr);
-  }
+      std::shared_ptr<subscription::ChainEvents> chain_events,
+      std::shared_ptr<ChangesIndex> changes_index)
+      : parent_hash_{},
+        parent_number_{std::numeric_limits<primitives::BlockNumber>::max()},
+        chain_events_{std::move(chain_events)},
+        changes_index_{std::move(changes_index)} {}
 
   outcome::result<void> StorageChangesTrackerImpl::onBlockChange(
       primitives::BlockHash new_parent_hash,
@@ -36,8 +32,8 @@ namespace kagome::storage::changes_trie {
     parent_hash_ = new_parent_hash;
     parent_number_ = new_parent_number;
     // new block -- new extrinsics
-    extrinsics_changes_.clear();
-    new_entries_.clear();
+    changes_.clear();
+    config_.reset();
     return outcome::success();
   }
 
@@ -46,46 +42,26 @@ namespace kagome::storage::changes_trie {
     get_extrinsic_index_ = std::move(f);
   }
 
-  outcome::result<void> StorageChangesTrackerImpl::onPut(
-      const common::Buffer &key, bool is_new_entry) {
-    auto change_it = extrinsics_changes_.find(key);
+  outcome::result<primitives::ExtrinsicIndex>
+  StorageChangesTrackerImpl::getExtrinsicIndex() const {
+    if (not get_extrinsic_index_) {
+      return Error::EXTRINSIC_IDX_GETTER_UNINITIALIZED;
+    }
     OUTCOME_TRY(idx_bytes, get_extrinsic_index_());
-    OUTCOME_TRY(idx, scale::decode<primitives::ExtrinsicIndex>(idx_bytes));
+    return scale::decode<primitives::ExtrinsicIndex>(idx_bytes);
+  }
 
-    // if key was already changed in the same block, just add extrinsic to
-    // the changers list
-    if (change_it != extrinsics_changes_.end()) {
-      change_it->second.push_back(idx);
-    } else {
-      extrinsics_changes_.insert(std::make_pair(key, std::vector{idx}));
-      if (is_new_entry) {
-        new_entries_.insert(key);
-      }
-    }
+  outcome::result<void> StorageChangesTrackerImpl::onPut(
+      const common::Buffer &key, bool is_new_entry) {
+    OUTCOME_TRY(idx, getExtrinsicIndex());
+    changes_.onPut(key, idx, is_new_entry);
     return outcome::success();
   }
 
   outcome::result<void> StorageChangesTrackerImpl::onRemove(
       const common::Buffer &key) {
-    auto change_it = extrinsics_changes_.find(key);
-    OUTCOME_TRY(idx_bytes, get_extrinsic_index_());
-    OUTCOME_TRY(idx, scale::decode<primitives::ExtrinsicIndex>(idx_bytes));
-
-    // if key was already changed in the same block, just add extrinsic to
-    // the changers list
-    if (change_it != extrinsics_changes_.end()) {
-      // if new entry, i. e. it doesn't exist in the persistent storage, then
-      // don't track it, because it's just temporary
-      if (auto i = new_entries_.find(key); i != new_entries_.end()) {
-        extrinsics_changes_.erase(change_it);
-        new_entries_.erase(i);
-      } else {
-        change_it->second.push_back(idx);
-      }
-
-    } else {
-      extrinsics_changes_.insert(std::make_pair(key, std::vector{idx}));
-    }
+    OUTCOME_TRY(idx, getExtrinsicIndex());
+    changes_.onRemove(key, idx);
     return outcome::success();
   }
 
@@ -95,11 +71,38 @@ namespace kagome::storage::changes_trie {
     if (parent != parent_hash_) {
       return Error::INVALID_PARENT_HASH;
     }
-    OUTCOME_TRY(
-        trie,
-        ChangesTrie::buildFromChanges(
-            parent_number_, trie_factory_, codec_, extrinsics_changes_, conf));
-    return trie->getHash();
+    // the zero config stands for the one absent in the state
+    if (conf.digest_interval != 0 or conf.digest_levels != 0) {
+      config_ = conf;
+    }
+    return changes_.calculateRoot(parent_number_ + 1);
+  }
+
+  void StorageChangesTrackerImpl::onBlockImported(
+      const primitives::BlockHash &block, const primitives::BlockHash &parent) {
+    if (parent != parent_hash_) {
+      logger_->debug("Changes of block {} are not tracked", block.toHex());
+      return;
+    }
+    auto notify =
+        chain_events_ != nullptr and not chain_events_->storage_changes.empty();
+    auto index = changes_index_ != nullptr and config_.has_value();
+    if (not notify and not index) {
+      return;
+    }
+    auto keys = changes_.changedKeys();
+    if (index) {
+      if (auto res = changes_index_->addBlock(
+              {parent_number_ + 1, block}, parent_hash_, keys, config_.value());
+          not res) {
+        logger_->warn("Changes of block #{} are not indexed: {}",
+                      parent_number_ + 1,
+                      res.error().message());
+      }
+    }
+    if (notify and not keys.empty()) {
+      chain_events_->storage_changes(block, keys);
+    }
   }
 
 }  // namespace kagome::storage::changes_trie
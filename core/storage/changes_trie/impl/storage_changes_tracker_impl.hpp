@@ -3,10 +3,12 @@
 
 #include "storage/changes_trie/changes_tracker.hpp"
 
-namespace kagome::storage::trie {
-  class Codec;
-  class PolkadotTrieFactory;
-}  // namespace kagome::storage::trie
+#include <boost/optional.hpp>
+
+#include "common/logger.hpp"
+#include "storage/changes_trie/impl/changes_index.hpp"
+#include "storage/changes_trie/impl/changes_trie_builder.hpp"
+#include "subscription/chain_events.hpp"
 
 namespace kagome::storage::changes_trie {
 
@@ -17,9 +19,15 @@ namespace kagome::storage::changes_trie {
       INVALID_PARENT_HASH
     };
 
-    StorageChangesTrackerImpl(
-        std::shared_ptr<storage::trie::PolkadotTrieFactory> trie_factory,
-        std::shared_ptr<storage::trie::Codec> codec);
+    /**
+     * @param chain_events - events the keys changed by the imported blocks
+     * are raised on, nullptr if nobody listens to them
+     * @param changes_index - index the keys changed by the imported blocks
+     * are put to when the changes tries are enabled, nullptr if none
+     */
+    explicit StorageChangesTrackerImpl(
+        std::shared_ptr<subscription::ChainEvents> chain_events = nullptr,
+        std::shared_ptr<ChangesIndex> changes_index = nullptr);
 
     /**
      * Functor that returns the current extrinsic index, which is supposed to
@@ -41,17 +49,21 @@ namespace kagome::storage::changes_trie {
         const primitives::BlockHash &parent,
         const ChangesTrieConfig &conf) override;
 
+    void onBlockImported(const primitives::BlockHash &block,
+                         const primitives::BlockHash &parent) override;
+
    private:
-    std::shared_ptr<storage::trie::PolkadotTrieFactory> trie_factory_;
-    std::shared_ptr<storage::trie::Codec> codec_;
+    outcome::result<primitives::ExtrinsicIndex> getExtrinsicIndex() const;
 
-    std::map<common::Buffer, std::vector<primitives::ExtrinsicIndex>>
-        extrinsics_changes_;
-    std::set<common::Buffer>
-        new_entries_; // entries that do not yet exist in the underlying storage
+    ChangesTrieBuilder changes_;
     primitives::BlockHash parent_hash_;
     primitives::BlockNumber parent_number_;
     GetExtrinsicIndexDelegate get_extrinsic_index_;
+    std::shared_ptr<subscription::ChainEvents> chain_events_;
+    std::shared_ptr<ChangesIndex> changes_index_;
+    // config of the changes trie of the block, none if it is disabled
+    boost::optional<ChangesTrieConfig> config_;
+    common::Logger logger_ = common::createLogger("StorageChangesTracker");
   };
 
 }  // namespace kagome::storage::changes_trie
@@ -20,6 +20,8 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage, DatabaseError, e) {
       return "IO error";
     case E::NOT_FOUND:
       return "not found";
+    case E::NO_SPACE:
+      return "no space left in the storage";
     case E::UNKNOWN:
       break;
   }
@@ -0,0 +1,218 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/deferred_write/deferred_write_storage.hpp"
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Batch, which goes to the unit of work of the committing thread on commit
+   * if it has one, and to the underlying storage otherwise
+   */
+  class DeferredWriteStorage::Batch : public BufferBatch {
+   public:
+    explicit Batch(DeferredWriteStorage &storage) : storage_{storage} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      entries_[key] = value;
+      return outcome::success();
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      entries_[key] = std::move(value);
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      entries_[key] = boost::none;
+      return outcome::success();
+    }
+
+    outcome::result<void> commit() override {
+      {
+        std::lock_guard lock{storage_.mutex_};
+        if (auto unit = storage_.unit()) {
+          for (auto &[key, value] : entries_) {
+            (*unit)[key] = value;
+          }
+          return outcome::success();
+        }
+      }
+      auto batch = storage_.storage_->batch();
+      for (auto &[key, value] : entries_) {
+        if (value) {
+          OUTCOME_TRY(batch->put(key, value.value()));
+        } else {
+          OUTCOME_TRY(batch->remove(key));
+        }
+      }
+      return batch->commit();
+    }
+
+    void clear() override {
+      entries_.clear();
+    }
+
+   private:
+    DeferredWriteStorage &storage_;
+    Pending entries_;
+  };
+
+  DeferredWriteStorage::DeferredWriteStorage(
+      std::shared_ptr<BufferStorage> storage)
+      : storage_{std::move(storage)} {
+    BOOST_ASSERT(storage_ != nullptr);
+  }
+
+  DeferredWriteStorage::Pending *DeferredWriteStorage::unit() const {
+    auto it = units_.find(std::this_thread::get_id());
+    return it != units_.end() ? &it->second : nullptr;
+  }
+
+  void DeferredWriteStorage::begin() {
+    std::lock_guard lock{mutex_};
+    [[maybe_unused]] auto inserted =
+        units_.emplace(std::this_thread::get_id(), Pending{}).second;
+    BOOST_ASSERT_MSG(inserted, "units of work can't be nested");
+  }
+
+  outcome::result<void> DeferredWriteStorage::commit() {
+    Pending pending;
+    {
+      std::lock_guard lock{mutex_};
+      auto it = units_.find(std::this_thread::get_id());
+      BOOST_ASSERT(it != units_.end());
+      pending = std::move(it->second);
+      units_.erase(it);
+    }
+    auto batch = storage_->batch();
+    for (auto &[key, value] : pending) {
+      if (value) {
+        OUTCOME_TRY(batch->put(key, std::move(value.value())));
+      } else {
+        OUTCOME_TRY(batch->remove(key));
+      }
+    }
+    return batch->commit();
+  }
+
+  void DeferredWriteStorage::rollback() {
+    std::lock_guard lock{mutex_};
+    units_.erase(std::this_thread::get_id());
+  }
+
+  bool DeferredWriteStorage::isOpen() const {
+    std::lock_guard lock{mutex_};
+    return unit() != nullptr;
+  }
+
+  std::unique_ptr<BufferMapCursor> DeferredWriteStorage::cursor() {
+    return storage_->cursor();
+  }
+
+  std::unique_ptr<BufferMapCursor> DeferredWriteStorage::scanCursor(
+      const Buffer &prefix) {
+    return storage_->scanCursor(prefix);
+  }
+
+  std::unique_ptr<BufferBatch> DeferredWriteStorage::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> DeferredWriteStorage::get(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        if (auto it = unit->find(key); it != unit->end()) {
+          if (it->second) {
+            return it->second.value();
+          }
+          return DatabaseError::NOT_FOUND;
+        }
+      }
+    }
+    return storage_->get(key);
+  }
+
+  outcome::result<face::PinnedView<Buffer>> DeferredWriteStorage::getPinned(
+      const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        if (auto it = unit->find(key); it != unit->end()) {
+          if (it->second) {
+            return face::PinnedView<Buffer>{it->second.value()};
+          }
+          return DatabaseError::NOT_FOUND;
+        }
+      }
+    }
+    return storage_->getPinned(key);
+  }
+
+  bool DeferredWriteStorage::contains(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        if (auto it = unit->find(key); it != unit->end()) {
+          return it->second.has_value();
+        }
+      }
+    }
+    return storage_->contains(key);
+  }
+
+  bool DeferredWriteStorage::empty() const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        for (auto &entry : *unit) {
+          if (entry.second) {
+            return false;
+          }
+        }
+      }
+    }
+    return storage_->empty();
+  }
+
+  outcome::result<void> DeferredWriteStorage::put(const Buffer &key,
+                                                  const Buffer &value) {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        (*unit)[key] = value;
+        return outcome::success();
+      }
+    }
+    return storage_->put(key, value);
+  }
+
+  outcome::result<void> DeferredWriteStorage::put(const Buffer &key,
+                                                  Buffer &&value) {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        (*unit)[key] = std::move(value);
+        return outcome::success();
+      }
+    }
+    return storage_->put(key, std::move(value));
+  }
+
+  outcome::result<void> DeferredWriteStorage::remove(const Buffer &key) {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto unit = this->unit()) {
+        (*unit)[key] = boost::none;
+        return outcome::success();
+      }
+    }
+    return storage_->remove(key);
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_DEFERRED_WRITE_DEFERRED_WRITE_STORAGE_HPP
+#define KAGOME_STORAGE_DEFERRED_WRITE_DEFERRED_WRITE_STORAGE_HPP
+
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Decorator of a storage, which is able to collect everything written
+   * through it, including committed batches, into a single batch of the
+   * underlying storage. It allows a unit of work, such as a block import,
+   * which writes through several components sharing the storage, to reach
+   * the disk with a single write, so that after a crash either all or none
+   * of it is there.
+   * A unit belongs to the thread which opened it: only the writes made on
+   * that thread are collected, while the ones of the other threads, e.g. of
+   * RPC or offchain workers, reach the underlying storage as usual and are
+   * never discarded with the unit. The thread sees the pending writes of its
+   * unit, except for cursors, which iterate over the underlying storage
+   * only, and the other threads don't see them until the commit
+   */
+  class DeferredWriteStorage : public BufferStorage {
+   public:
+    explicit DeferredWriteStorage(std::shared_ptr<BufferStorage> storage);
+    ~DeferredWriteStorage() override = default;
+
+    /**
+     * Starts collecting the writes of the calling thread instead of passing
+     * them to the underlying storage. Units of work of a thread can't be
+     * nested
+     */
+    void begin();
+
+    /**
+     * Writes everything collected since \see begin with a single batch and
+     * closes the unit of work of the calling thread
+     */
+    outcome::result<void> commit();
+
+    /**
+     * Discards everything collected since \see begin and closes the unit of
+     * work of the calling thread. Does nothing if it has no open unit
+     */
+    void rollback();
+
+    /**
+     * @return true if the calling thread has an open unit of work
+     */
+    bool isOpen() const;
+
+    std::unique_ptr<BufferMapCursor> cursor() override;
+
+    std::unique_ptr<BufferMapCursor> scanCursor(const Buffer &prefix) override;
+
+    std::unique_ptr<BufferBatch> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+
+    bool contains(const Buffer &key) const override;
+
+    // doesn't take removals pending in the unit of work into account
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    class Batch;
+
+    // none stands for a removed entry
+    using Pending = std::map<Buffer, boost::optional<Buffer>>;
+
+    /// @return writes of the unit of the calling thread, nullptr if it has
+    /// none; is called with the mutex locked
+    Pending *unit() const;
+
+    std::shared_ptr<BufferStorage> storage_;
+    // writes of the open units of work by the threads they belong to
+    mutable std::unordered_map<std::thread::id, Pending> units_;
+    // the storage is shared by the components working on different threads,
+    // e.g. block import and RPC
+    mutable std::mutex mutex_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_DEFERRED_WRITE_DEFERRED_WRITE_STORAGE_HPP
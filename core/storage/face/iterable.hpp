@@ -26,6 +26,19 @@ namespace kagome::storage::face {
      * @return kv iterator
      */
     virtual std::unique_ptr<MapCursor<K, V>> cursor() = 0;
+
+    /**
+     * @brief Returns new key-value iterator for a long scan over the keys
+     * with \arg prefix, e.g. by a pruning or an RPC call. The maps, which
+     * can, make it read a consistent view taken at its creation without
+     * caching the scanned entries, and stop it at the keys without the
+     * prefix, so the callers still check the keys. It is the plain cursor
+     * otherwise
+     * @return kv iterator
+     */
+    virtual std::unique_ptr<MapCursor<K, V>> scanCursor(const K &prefix) {
+      return cursor();
+    }
   };
 
 }  // namespace kagome::storage::face
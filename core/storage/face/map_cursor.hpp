@@ -29,6 +29,12 @@ namespace kagome::storage::face {
      */
     virtual outcome::result<void> seek(const K &key) = 0;
 
+    /**
+     * @brief Seek iterator to the first key which is greater than the given
+     * one. The given key doesn't have to be present in the map.
+     */
+    virtual outcome::result<void> seekUpperBound(const K &key) = 0;
+
     /**
      * @brief Same as std::rbegin(...);, e.g. points to the last valid element
      */
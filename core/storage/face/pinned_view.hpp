@@ -0,0 +1,68 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_FACE_PINNED_VIEW_HPP
+#define KAGOME_STORAGE_FACE_PINNED_VIEW_HPP
+
+#include <memory>
+#include <string>
+
+#include <boost/variant.hpp>
+#include <gsl/span>
+
+namespace kagome::storage::face {
+
+  /**
+   * @brief Bytes of a value read from a storage, which are either owned by
+   * the view or stay in the memory of the storage, kept alive by a handle
+   * @tparam V owning type of the value, a container of bytes
+   */
+  template <typename V>
+  class PinnedView {
+   public:
+    using Span = gsl::span<const uint8_t>;
+
+    /**
+     * View of an owned value
+     */
+    explicit PinnedView(V value) : owner_{std::move(value)} {}
+
+    /**
+     * View of a value read into a string, which is the way some databases
+     * return values
+     */
+    explicit PinnedView(std::string value) : owner_{std::move(value)} {}
+
+    /**
+     * View of \param span kept valid by \param handle
+     */
+    PinnedView(Span span, std::shared_ptr<const void> handle)
+        : owner_{std::move(handle)}, span_{span} {}
+
+    /**
+     * @return bytes of the value, valid while the view lives
+     */
+    Span view() const {
+      if (const auto *value = boost::get<V>(&owner_)) {
+        return gsl::make_span(value->data(), value->size());
+      }
+      if (const auto *str = boost::get<std::string>(&owner_)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto *ptr = reinterpret_cast<const uint8_t *>(str->data());
+        return gsl::make_span(ptr, str->size());
+      }
+      return span_;
+    }
+
+   private:
+    // a span into a moved string or value is recomputed in view(), as a
+    // string may keep small values inside itself
+    boost::variant<V, std::string, std::shared_ptr<const void>> owner_;
+    Span span_;
+  };
+
+}  // namespace kagome::storage::face
+
+#endif  // KAGOME_STORAGE_FACE_PINNED_VIEW_HPP
@@ -8,6 +8,7 @@
 
 #include <outcome/outcome.hpp>
 #include "storage/face/map_cursor.hpp"
+#include "storage/face/pinned_view.hpp"
 
 namespace kagome::storage::face {
 
@@ -27,6 +28,17 @@ namespace kagome::storage::face {
      */
     virtual outcome::result<V> get(const K &key) const = 0;
 
+    /**
+     * @brief Get value by key without copying it, if the storage is able to
+     * keep it in place, otherwise the same as get()
+     * @param key K
+     * @return view of the value
+     */
+    virtual outcome::result<PinnedView<V>> getPinned(const K &key) const {
+      OUTCOME_TRY(value, get(key));
+      return PinnedView<V>{std::move(value)};
+    }
+
     /**
      * @brief Returns true if given key-value binding exists in the storage.
      * @param key K
@@ -0,0 +1,237 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/group_commit/group_commit_storage.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Batch, which is queued as a single write on commit
+   */
+  class GroupCommitStorage::Batch : public BufferBatch {
+   public:
+    explicit Batch(GroupCommitStorage &storage) : storage_{storage} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      entries_[key] = value;
+      return outcome::success();
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      entries_[key] = std::move(value);
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      entries_[key] = boost::none;
+      return outcome::success();
+    }
+
+    outcome::result<void> commit() override {
+      return storage_.enqueue(entries_);
+    }
+
+    void clear() override {
+      entries_.clear();
+    }
+
+   private:
+    GroupCommitStorage &storage_;
+    Entries entries_;
+  };
+
+  GroupCommitStorage::GroupCommitStorage(
+      std::shared_ptr<BufferStorage> storage)
+      : storage_{std::move(storage)} {
+    BOOST_ASSERT(storage_ != nullptr);
+    writer_ = std::thread{[this] { writeGroups(); }};
+  }
+
+  GroupCommitStorage::~GroupCommitStorage() {
+    {
+      std::lock_guard lock{mutex_};
+      stopped_ = true;
+    }
+    queued_.notify_one();
+    writer_.join();
+  }
+
+  std::future<outcome::result<void>> GroupCommitStorage::flush() const {
+    std::promise<outcome::result<void>> promise;
+    auto future = promise.get_future();
+    std::lock_guard lock{mutex_};
+    if (last_written_ == last_queued_) {
+      promise.set_value(status_);
+    } else {
+      flushes_.emplace_back(last_queued_, std::move(promise));
+    }
+    return future;
+  }
+
+  std::unique_ptr<BufferMapCursor> GroupCommitStorage::cursor() {
+    // the cursor iterates over the underlying storage, so it has to have
+    // everything written before; a failed write is reported by the writes
+    flush().wait();
+    return storage_->cursor();
+  }
+
+  std::unique_ptr<BufferMapCursor> GroupCommitStorage::scanCursor(
+      const Buffer &prefix) {
+    flush().wait();
+    return storage_->scanCursor(prefix);
+  }
+
+  std::unique_ptr<BufferBatch> GroupCommitStorage::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> GroupCommitStorage::get(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto it = pending_.find(key); it != pending_.end()) {
+        if (it->second.first) {
+          return it->second.first.value();
+        }
+        return DatabaseError::NOT_FOUND;
+      }
+    }
+    return storage_->get(key);
+  }
+
+  outcome::result<face::PinnedView<Buffer>> GroupCommitStorage::getPinned(
+      const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto it = pending_.find(key); it != pending_.end()) {
+        if (it->second.first) {
+          return face::PinnedView<Buffer>{it->second.first.value()};
+        }
+        return DatabaseError::NOT_FOUND;
+      }
+    }
+    return storage_->getPinned(key);
+  }
+
+  bool GroupCommitStorage::contains(const Buffer &key) const {
+    {
+      std::lock_guard lock{mutex_};
+      if (auto it = pending_.find(key); it != pending_.end()) {
+        return it->second.first.has_value();
+      }
+    }
+    return storage_->contains(key);
+  }
+
+  bool GroupCommitStorage::empty() const {
+    flush().wait();
+    return storage_->empty();
+  }
+
+  outcome::result<void> GroupCommitStorage::put(const Buffer &key,
+                                                const Buffer &value) {
+    return enqueue({{key, value}});
+  }
+
+  outcome::result<void> GroupCommitStorage::put(const Buffer &key,
+                                                Buffer &&value) {
+    Entries entries;
+    entries.emplace(key, std::move(value));
+    return enqueue(std::move(entries));
+  }
+
+  outcome::result<void> GroupCommitStorage::remove(const Buffer &key) {
+    return enqueue({{key, boost::none}});
+  }
+
+  outcome::result<void> GroupCommitStorage::enqueue(Entries entries) {
+    {
+      std::lock_guard lock{mutex_};
+      if (not status_) {
+        return status_;
+      }
+      ++last_queued_;
+      for (auto &[key, value] : entries) {
+        pending_[key] = {value, last_queued_};
+      }
+      queue_.emplace_back(std::move(entries));
+    }
+    queued_.notify_one();
+    return outcome::success();
+  }
+
+  void GroupCommitStorage::writeGroups() {
+    while (true) {
+      std::deque<Entries> group;
+      outcome::result<void> status = outcome::success();
+      {
+        std::unique_lock lock{mutex_};
+        queued_.wait(lock, [this] { return stopped_ or not queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+        auto size = std::min(queue_.size(), kMaxGroupWrites);
+        std::move(queue_.begin(),
+                  queue_.begin() + size,
+                  std::back_inserter(group));
+        queue_.erase(queue_.begin(), queue_.begin() + size);
+        status = status_;
+      }
+
+      // the writes queued before a failure are not written after it, as
+      // they may depend on the failed ones
+      auto res = status ? writeGroup(group) : status;
+
+      std::lock_guard lock{mutex_};
+      last_written_ += group.size();
+      if (res) {
+        // the entries put again by the writes queued since stay pending
+        for (auto it = pending_.begin(); it != pending_.end();) {
+          if (it->second.second <= last_written_) {
+            it = pending_.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      } else if (status_) {
+        // the entries stay pending, so that the reads are consistent with
+        // the writes reported as successful
+        logger_->error("Writes to the storage failed: {}",
+                       res.error().message());
+        status_ = res;
+      }
+      while (not flushes_.empty()
+             and flushes_.front().first <= last_written_) {
+        flushes_.front().second.set_value(status_);
+        flushes_.pop_front();
+      }
+    }
+  }
+
+  outcome::result<void> GroupCommitStorage::writeGroup(
+      const std::deque<Entries> &group) {
+    // a key put by several writes of the group is written once
+    Entries merged;
+    for (auto &entries : group) {
+      for (auto &[key, value] : entries) {
+        merged[key] = value;
+      }
+    }
+    auto batch = storage_->batch();
+    for (auto &[key, value] : merged) {
+      if (value) {
+        OUTCOME_TRY(batch->put(key, std::move(value.value())));
+      } else {
+        OUTCOME_TRY(batch->remove(key));
+      }
+    }
+    return batch->commit();
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,118 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_GROUP_COMMIT_GROUP_COMMIT_STORAGE_HPP
+#define KAGOME_STORAGE_GROUP_COMMIT_GROUP_COMMIT_STORAGE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <boost/optional.hpp>
+
+#include "common/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Decorator of a storage, which takes the writes off the threads of the
+   * callers. The committed batches and the single writes are queued and
+   * written by a thread of its own, which merges all the writes queued
+   * while the previous group was being written into a single write of the
+   * underlying storage, so that the callers share the latency of a synced
+   * write instead of waiting for one each.
+   * Until a write reaches the underlying storage, reads see it from the
+   * memory. Cursors and emptiness checks wait for the queued writes to be
+   * written first
+   */
+  class GroupCommitStorage : public BufferStorage {
+   public:
+    /// max number of the queued writes merged into a single one
+    static constexpr size_t kMaxGroupWrites = 256;
+
+    explicit GroupCommitStorage(std::shared_ptr<BufferStorage> storage);
+
+    /**
+     * Writes the queued writes and stops the writer thread
+     */
+    ~GroupCommitStorage() override;
+
+    /**
+     * @return future, which is ready when everything written through the
+     * storage so far reaches the underlying storage, with the error of the
+     * failed write if any
+     */
+    std::future<outcome::result<void>> flush() const;
+
+    std::unique_ptr<BufferMapCursor> cursor() override;
+
+    std::unique_ptr<BufferMapCursor> scanCursor(const Buffer &prefix) override;
+
+    std::unique_ptr<BufferBatch> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+
+    bool contains(const Buffer &key) const override;
+
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    class Batch;
+
+    // none stands for a removed entry
+    using Entries = std::map<Buffer, boost::optional<Buffer>>;
+
+    /**
+     * Queues \arg entries as a single write, fails if a previous write
+     * failed, as the underlying storage is not written after that
+     */
+    outcome::result<void> enqueue(Entries entries);
+
+    /**
+     * Body of the writer thread
+     */
+    void writeGroups();
+
+    outcome::result<void> writeGroup(const std::deque<Entries> &group);
+
+    std::shared_ptr<BufferStorage> storage_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    // the entries, which are not written yet, with the numbers of the writes
+    // they were put with
+    std::map<Buffer, std::pair<boost::optional<Buffer>, uint64_t>> pending_;
+    std::deque<Entries> queue_;
+    // numbers of the last queued and the last written writes
+    uint64_t last_queued_ = 0;
+    uint64_t last_written_ = 0;
+    // promises of the flushes with the numbers of the writes they wait for
+    mutable std::deque<
+        std::pair<uint64_t, std::promise<outcome::result<void>>>>
+        flushes_;
+    outcome::result<void> status_ = outcome::success();
+    bool stopped_ = false;
+
+    common::Logger logger_ = common::createLogger("GroupCommitStorage");
+
+    std::thread writer_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_GROUP_COMMIT_GROUP_COMMIT_STORAGE_HPP
@@ -0,0 +1,420 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/in_memory/arena_storage.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "storage/database_error.hpp"
+
+namespace kagome::storage {
+
+  namespace {
+    constexpr size_t kInitialSlotsNum = 16;
+    // entries larger than that get chunks of their own, so that they don't
+    // leave much of a chunk unused
+    constexpr size_t kMaxSharedEntrySize = 64ull << 10;
+  }  // namespace
+
+  /**
+   * Collects the writes to apply them under a single lock
+   */
+  class ArenaStorage::Batch : public BufferBatch {
+   public:
+    explicit Batch(ArenaStorage &storage) : storage_{storage} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      changes_[key] = value;
+      return outcome::success();
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      changes_[key] = std::move(value);
+      return outcome::success();
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      changes_[key] = boost::none;
+      return outcome::success();
+    }
+
+    outcome::result<void> commit() override {
+      std::unique_lock lock{storage_.mutex_};
+      if (storage_.budget_ != 0
+          and storage_.usedBytesAfter(changes_) > storage_.budget_) {
+        return DatabaseError::NO_SPACE;
+      }
+      for (auto &[key, value] : changes_) {
+        if (value) {
+          storage_.putEntry(key, value.value());
+        } else {
+          storage_.removeEntry(key);
+        }
+      }
+      return outcome::success();
+    }
+
+    void clear() override {
+      changes_.clear();
+    }
+
+   private:
+    ArenaStorage &storage_;
+    // none stands for a removed entry
+    std::map<Buffer, boost::optional<Buffer>> changes_;
+  };
+
+  /**
+   * Keeps a copy of the current key and looks it up in the sorted index on
+   * every move, so it is not invalidated by the writes
+   */
+  class ArenaStorage::Cursor : public BufferMapCursor {
+   public:
+    explicit Cursor(const ArenaStorage &storage) : storage_{storage} {}
+
+    outcome::result<void> seekToFirst() override {
+      std::shared_lock lock{storage_.mutex_};
+      setKey(storage_.index_.begin());
+      return outcome::success();
+    }
+
+    outcome::result<void> seek(const Buffer &key) override {
+      std::shared_lock lock{storage_.mutex_};
+      setKey(storage_.index_.lower_bound(key));
+      return outcome::success();
+    }
+
+    outcome::result<void> seekUpperBound(const Buffer &key) override {
+      std::shared_lock lock{storage_.mutex_};
+      setKey(storage_.index_.upper_bound(key));
+      return outcome::success();
+    }
+
+    outcome::result<void> seekToLast() override {
+      std::shared_lock lock{storage_.mutex_};
+      if (storage_.index_.empty()) {
+        key_ = boost::none;
+        return outcome::success();
+      }
+      setKey(std::prev(storage_.index_.end()));
+      return outcome::success();
+    }
+
+    bool isValid() const override {
+      return key_.has_value();
+    }
+
+    outcome::result<void> next() override {
+      if (not key_) {
+        return DatabaseError::INVALID_ARGUMENT;
+      }
+      std::shared_lock lock{storage_.mutex_};
+      setKey(storage_.index_.upper_bound(key_.value()));
+      return outcome::success();
+    }
+
+    outcome::result<void> prev() override {
+      if (not key_) {
+        return DatabaseError::INVALID_ARGUMENT;
+      }
+      std::shared_lock lock{storage_.mutex_};
+      auto it = storage_.index_.lower_bound(key_.value());
+      if (it == storage_.index_.begin()) {
+        key_ = boost::none;
+        return outcome::success();
+      }
+      setKey(std::prev(it));
+      return outcome::success();
+    }
+
+    outcome::result<Buffer> key() const override {
+      if (not key_) {
+        return DatabaseError::INVALID_ARGUMENT;
+      }
+      return key_.value();
+    }
+
+    // the entry may have been removed since the cursor reached it
+    outcome::result<Buffer> value() const override {
+      if (not key_) {
+        return DatabaseError::INVALID_ARGUMENT;
+      }
+      return storage_.get(key_.value());
+    }
+
+   private:
+    void setKey(std::set<Span, Less>::const_iterator it) {
+      if (it == storage_.index_.end()) {
+        key_ = boost::none;
+      } else {
+        key_ = Buffer{*it};
+      }
+    }
+
+    const ArenaStorage &storage_;
+    boost::optional<Buffer> key_;
+  };
+
+  ArenaStorage::ArenaStorage(size_t budget)
+      : budget_{budget}, slots_(kInitialSlotsNum) {}
+
+  size_t ArenaStorage::usedBytes() const {
+    std::shared_lock lock{mutex_};
+    return accountedBytes();
+  }
+
+  std::unique_ptr<BufferMapCursor> ArenaStorage::cursor() {
+    return std::make_unique<Cursor>(*this);
+  }
+
+  std::unique_ptr<BufferBatch> ArenaStorage::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> ArenaStorage::get(const Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    auto pos = find(key);
+    if (pos == kNotFound) {
+      return DatabaseError::NOT_FOUND;
+    }
+    return Buffer{slots_[pos].value()};
+  }
+
+  outcome::result<face::PinnedView<Buffer>> ArenaStorage::getPinned(
+      const Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    auto pos = find(key);
+    if (pos == kNotFound) {
+      return DatabaseError::NOT_FOUND;
+    }
+    auto &slot = slots_[pos];
+    return face::PinnedView<Buffer>{slot.value(), chunks_[slot.chunk]};
+  }
+
+  bool ArenaStorage::contains(const Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    return find(key) != kNotFound;
+  }
+
+  bool ArenaStorage::empty() const {
+    std::shared_lock lock{mutex_};
+    return entries_num_ == 0;
+  }
+
+  outcome::result<void> ArenaStorage::put(const Buffer &key,
+                                          const Buffer &value) {
+    std::unique_lock lock{mutex_};
+    auto used = accountedBytes() - entrySize(key) + key.size() + value.size()
+                + kEntryOverhead;
+    if (budget_ != 0 and used > budget_) {
+      return DatabaseError::NO_SPACE;
+    }
+    putEntry(key, value);
+    return outcome::success();
+  }
+
+  outcome::result<void> ArenaStorage::put(const Buffer &key, Buffer &&value) {
+    return put(key, static_cast<const Buffer &>(value));
+  }
+
+  outcome::result<void> ArenaStorage::remove(const Buffer &key) {
+    std::unique_lock lock{mutex_};
+    removeEntry(key);
+    return outcome::success();
+  }
+
+  bool ArenaStorage::Less::operator()(const Span &lhs,
+                                      const Span &rhs) const {
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  size_t ArenaStorage::accountedBytes() const {
+    return data_bytes_ + entries_num_ * kEntryOverhead;
+  }
+
+  uint64_t ArenaStorage::hashOf(Span key) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto *chars = reinterpret_cast<const char *>(key.data());
+    return std::hash<std::string_view>{}(
+        std::string_view{chars, static_cast<size_t>(key.size())});
+  }
+
+  size_t ArenaStorage::find(Span key) const {
+    auto hash = hashOf(key);
+    auto mask = slots_.size() - 1;
+    // the table always has empty slots, which end the probing
+    for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+      auto &slot = slots_[pos];
+      if (slot.data == nullptr) {
+        return kNotFound;
+      }
+      if (slot.hash == hash and std::equal(slot.key().begin(),
+                                           slot.key().end(),
+                                           key.begin(),
+                                           key.end())) {
+        return pos;
+      }
+    }
+  }
+
+  size_t ArenaStorage::entrySize(Span key) const {
+    auto pos = find(key);
+    if (pos == kNotFound) {
+      return 0;
+    }
+    return slots_[pos].key_size + slots_[pos].value_size + kEntryOverhead;
+  }
+
+  size_t ArenaStorage::usedBytesAfter(
+      const std::map<Buffer, boost::optional<Buffer>> &changes) const {
+    auto used = accountedBytes();
+    for (auto &[key, value] : changes) {
+      used -= entrySize(key);
+      if (value) {
+        used += key.size() + value->size() + kEntryOverhead;
+      }
+    }
+    return used;
+  }
+
+  void ArenaStorage::putEntry(Span key, Span value) {
+    auto pos = find(key);
+    if (pos != kNotFound) {
+      auto &slot = slots_[pos];
+      // the old key and value become garbage, and the index has to refer to
+      // the key, which stays alive
+      auto it = index_.find(key);
+      auto hint = index_.erase(it);
+      data_bytes_ -= slot.key_size + slot.value_size;
+      auto hash = slot.hash;
+      slot = allocate(key, value);
+      slot.hash = hash;
+      index_.insert(hint, slot.key());
+      data_bytes_ += slot.key_size + slot.value_size;
+    } else {
+      if ((entries_num_ + 1) * 10 > slots_.size() * 7) {
+        grow();
+      }
+      auto slot = allocate(key, value);
+      slot.hash = hashOf(key);
+      auto mask = slots_.size() - 1;
+      pos = slot.hash & mask;
+      while (slots_[pos].data != nullptr) {
+        pos = (pos + 1) & mask;
+      }
+      slots_[pos] = slot;
+      index_.insert(slot.key());
+      entries_num_++;
+      data_bytes_ += slot.key_size + slot.value_size;
+    }
+    if (chunks_bytes_ - data_bytes_ > std::max(data_bytes_, kChunkSize)) {
+      compact();
+    }
+  }
+
+  void ArenaStorage::removeEntry(Span key) {
+    auto pos = find(key);
+    if (pos == kNotFound) {
+      return;
+    }
+    index_.erase(index_.find(key));
+    data_bytes_ -= slots_[pos].key_size + slots_[pos].value_size;
+    entries_num_--;
+
+    // the following entries of the probe sequence are shifted back in place
+    // of the removed one, so that lookups don't need tombstones
+    auto mask = slots_.size() - 1;
+    auto hole = pos;
+    for (auto next = (hole + 1) & mask; slots_[next].data != nullptr;
+         next = (next + 1) & mask) {
+      auto home = slots_[next].hash & mask;
+      // distances from the home position of the entry
+      auto to_hole = (hole - home) & mask;
+      auto to_next = (next - home) & mask;
+      if (to_hole < to_next) {
+        slots_[hole] = slots_[next];
+        hole = next;
+      }
+    }
+    slots_[hole] = Slot{};
+
+    if (chunks_bytes_ - data_bytes_ > std::max(data_bytes_, kChunkSize)) {
+      compact();
+    }
+  }
+
+  ArenaStorage::Slot ArenaStorage::allocate(Span key, Span value) {
+    size_t size = key.size() + value.size();
+    size_t chunk = 0;
+    size_t offset = 0;
+    if (size > kMaxSharedEntrySize) {
+      chunk = chunks_.size();
+      chunks_.emplace_back(new uint8_t[size]);
+      chunks_bytes_ += size;
+    } else {
+      // an empty entry doesn't get a pointer past the end of a chunk either
+      if (chunk_offset_ + size >= kChunkSize) {
+        current_chunk_ = chunks_.size();
+        chunks_.emplace_back(new uint8_t[kChunkSize]);
+        chunks_bytes_ += kChunkSize;
+        chunk_offset_ = 0;
+      }
+      chunk = current_chunk_;
+      offset = chunk_offset_;
+      chunk_offset_ += size;
+    }
+    auto *data = chunks_[chunk].get() + offset;
+    std::copy(key.begin(), key.end(), data);
+    std::copy(value.begin(), value.end(), data + key.size());
+
+    Slot slot;
+    slot.data = data;
+    slot.key_size = key.size();
+    slot.value_size = value.size();
+    slot.chunk = chunk;
+    return slot;
+  }
+
+  void ArenaStorage::grow() {
+    std::vector<Slot> slots(slots_.size() * 2);
+    auto mask = slots.size() - 1;
+    for (auto &slot : slots_) {
+      if (slot.data == nullptr) {
+        continue;
+      }
+      auto pos = slot.hash & mask;
+      while (slots[pos].data != nullptr) {
+        pos = (pos + 1) & mask;
+      }
+      slots[pos] = slot;
+    }
+    slots_ = std::move(slots);
+  }
+
+  void ArenaStorage::compact() {
+    // the old chunks stay alive until the entries are copied, and after
+    // that as long as pinned views refer to them
+    auto old_chunks = std::move(chunks_);
+    chunks_.clear();
+    chunks_bytes_ = 0;
+    chunk_offset_ = kChunkSize;
+
+    // the keys are copied in the order of the index, so that it is rebuilt
+    // by appending to it
+    std::set<Span, Less> index;
+    for (auto &key : index_) {
+      auto &slot = slots_[find(key)];
+      auto hash = slot.hash;
+      slot = allocate(slot.key(), slot.value());
+      slot.hash = hash;
+      index.insert(index.end(), slot.key());
+    }
+    index_ = std::move(index);
+  }
+
+}  // namespace kagome::storage
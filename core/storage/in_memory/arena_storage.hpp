@@ -0,0 +1,165 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_IN_MEMORY_ARENA_STORAGE_HPP
+#define KAGOME_STORAGE_IN_MEMORY_ARENA_STORAGE_HPP
+
+#include <limits>
+#include <map>
+#include <set>
+#include <shared_mutex>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * Storage keeping all the data in memory within a budget, which allows
+   * running a node without a database.
+   * Keys and values are copied into large chunks of memory, point lookups
+   * go through an open addressing hash table, and a separate sorted index of
+   * the keys serves cursors. Memory of the overwritten and removed entries
+   * is reclaimed by moving the live entries to fresh chunks once it exceeds
+   * the memory of the live ones, so the chunks take up to twice the size of
+   * the data.
+   * Writes, which would make the data exceed the budget, fail with
+   * DatabaseError::NO_SPACE
+   */
+  class ArenaStorage : public BufferStorage {
+   public:
+    class Batch;
+    class Cursor;
+
+    /**
+     * Accounted size of an entry besides its key and value, which are the
+     * slot in the table and the node of the sorted index
+     */
+    static constexpr size_t kEntryOverhead = 96;
+
+    /**
+     * @param budget max total size of the entries in bytes, each of them
+     * taking its key, value and kEntryOverhead, 0 means no limit
+     */
+    explicit ArenaStorage(size_t budget = 0);
+    ~ArenaStorage() override = default;
+
+    /**
+     * @return accounted size of the stored entries in bytes
+     */
+    size_t usedBytes() const;
+
+    /**
+     * The cursor must not outlive the storage. Writes made while it is used
+     * are seen on its next move, as it seeks by the current key every time
+     */
+    std::unique_ptr<BufferMapCursor> cursor() override;
+
+    /**
+     * The batch is applied atomically, failing as a whole if it doesn't fit
+     * into the budget
+     */
+    std::unique_ptr<BufferBatch> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+
+    // the view refers to the chunk of the value, which is kept alive by it
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+
+    bool contains(const Buffer &key) const override;
+
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    using Span = gsl::span<const uint8_t>;
+
+    /**
+     * An entry of the hash table. The key and the value of an entry are
+     * adjacent in a chunk, an empty slot has no data
+     */
+    struct Slot {
+      const uint8_t *data = nullptr;
+      uint64_t hash = 0;
+      uint32_t key_size = 0;
+      uint32_t value_size = 0;
+      uint32_t chunk = 0;
+
+      Span key() const {
+        return {data, key_size};
+      }
+      Span value() const {
+        return {data + key_size, value_size};
+      }
+    };
+
+    struct Less {
+      bool operator()(const Span &lhs, const Span &rhs) const;
+    };
+
+    static constexpr size_t kChunkSize = 1ull << 20;
+    static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+
+    static uint64_t hashOf(Span key);
+
+    /**
+     * @return the position of the slot of \arg key, kNotFound if it is absent
+     */
+    size_t find(Span key) const;
+
+    // the accessors below expect a lock
+    size_t accountedBytes() const;
+
+    /**
+     * @return accounted size of the entry with \arg key, 0 if it is absent
+     */
+    size_t entrySize(Span key) const;
+
+    /**
+     * @return accounted size of the storage after the writes of \arg changes,
+     * which is none for a removal
+     */
+    size_t usedBytesAfter(
+        const std::map<Buffer, boost::optional<Buffer>> &changes) const;
+
+    // the modifiers below don't check the budget and expect a unique lock
+    void putEntry(Span key, Span value);
+    void removeEntry(Span key);
+
+    /**
+     * Copies \arg key and \arg value into a chunk
+     * @return the slot of the copy without its hash
+     */
+    Slot allocate(Span key, Span value);
+    void grow();
+    void compact();
+
+    const size_t budget_;
+    // size is a power of two
+    std::vector<Slot> slots_;
+    size_t entries_num_ = 0;
+    // keys in the chunks, in the ascending order
+    std::set<Span, Less> index_;
+    std::vector<std::shared_ptr<uint8_t[]>> chunks_;
+    // the chunk small entries are appended to and its used size
+    size_t current_chunk_ = 0;
+    size_t chunk_offset_ = kChunkSize;
+    size_t chunks_bytes_ = 0;
+    // sizes of the keys and values of the stored entries
+    size_t data_bytes_ = 0;
+    mutable std::shared_mutex mutex_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_IN_MEMORY_ARENA_STORAGE_HPP
@@ -17,10 +17,13 @@ namespace kagome::storage {
 
   outcome::result<std::shared_ptr<LevelDB>> LevelDB::create(
       std::string_view path, leveldb::Options options) {
+    auto l = std::make_unique<LevelDB>();
+    l->block_cache_.reset(options.block_cache);
+    l->filter_policy_.reset(options.filter_policy);
+
     leveldb::DB *db = nullptr;
     auto status = leveldb::DB::Open(options, std::string(path), &db);
     if (status.ok()) {
-      auto l = std::make_unique<LevelDB>();
       l->db_ = std::unique_ptr<leveldb::DB>(db);
       l->logger_ = common::createLogger("leveldb");
       return l;
@@ -29,11 +32,29 @@ namespace kagome::storage {
     return error_as_result<std::shared_ptr<LevelDB>>(status);
   }
 
+  LevelDB::~LevelDB() {
+    if (db_ != nullptr) {
+      logStats();
+    }
+  }
+
   std::unique_ptr<BufferMapCursor> LevelDB::cursor() {
     auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro_));
     return std::make_unique<Cursor>(std::move(it));
   }
 
+  std::unique_ptr<BufferMapCursor> LevelDB::scanCursor(const Buffer &prefix) {
+    std::shared_ptr<const leveldb::Snapshot> snapshot{
+        db_->GetSnapshot(),
+        [db{db_.get()}](auto snapshot) { db->ReleaseSnapshot(snapshot); }};
+    auto ro = ro_;
+    ro.snapshot = snapshot.get();
+    ro.fill_cache = false;
+    auto it = std::unique_ptr<leveldb::Iterator>(db_->NewIterator(ro));
+    return std::make_unique<Cursor>(
+        std::move(it), std::move(snapshot), prefix);
+  }
+
   std::unique_ptr<BufferBatch> LevelDB::batch() {
     return std::make_unique<Batch>(*this);
   }
@@ -46,6 +67,35 @@ namespace kagome::storage {
     wo_ = wo;
   }
 
+  boost::optional<std::string> LevelDB::getProperty(
+      const std::string &name) const {
+    std::string value;
+    if (not db_->GetProperty(name, &value)) {
+      return boost::none;
+    }
+    return value;
+  }
+
+  uint64_t LevelDB::approximateSize(const Buffer &from,
+                                    const Buffer &to) const {
+    leveldb::Range range{make_slice(from), make_slice(to)};
+    uint64_t size = 0;
+    db_->GetApproximateSizes(&range, 1, &size);
+    return size;
+  }
+
+  void LevelDB::logStats() const {
+    // all the keys are shorter than that
+    static const Buffer kMaxKey(64, 0xff);
+    logger_->debug("approximate size: {} bytes, memory usage: {} bytes",
+                   approximateSize({}, kMaxKey),
+                   getProperty("leveldb.approximate-memory-usage")
+                       .value_or("unknown"));
+    if (auto stats = getProperty("leveldb.stats")) {
+      logger_->debug("{}", stats.value());
+    }
+  }
+
   outcome::result<Buffer> LevelDB::get(const Buffer &key) const {
     std::string value;
     auto status = db_->Get(ro_, make_slice(key), &value);
@@ -62,6 +112,21 @@ namespace kagome::storage {
     return error_as_result<Buffer>(status, logger_);
   }
 
+  outcome::result<face::PinnedView<Buffer>> LevelDB::getPinned(
+      const Buffer &key) const {
+    std::string value;
+    auto status = db_->Get(ro_, make_slice(key), &value);
+    if (status.ok()) {
+      return face::PinnedView<Buffer>{std::move(value)};
+    }
+
+    if (status.IsNotFound()) {
+      return error_as_result<face::PinnedView<Buffer>>(status);
+    }
+
+    return error_as_result<face::PinnedView<Buffer>>(status, logger_);
+  }
+
   bool LevelDB::contains(const Buffer &key) const {
     // here we interpret all kinds of errors as "not found".
     // is there a better way?
@@ -6,7 +6,10 @@
 #ifndef KAGOME_LEVELDB_HPP
 #define KAGOME_LEVELDB_HPP
 
+#include <boost/optional.hpp>
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
 #include <leveldb/write_batch.h>
 
 #include "common/logger.hpp"
@@ -23,12 +26,13 @@ namespace kagome::storage {
     class Batch;
     class Cursor;
 
-    ~LevelDB() override = default;
+    ~LevelDB() override;
 
     /**
      * @brief Factory method to create an instance of LevelDB class.
      * @param path filesystem path where database is going to be
-     * @param options leveldb options, such as caching, logging, etc.
+     * @param options leveldb options, such as caching, logging, etc. The
+     * block cache and the filter policy set in them are owned by the database
      * @return instance of LevelDB
      */
     static outcome::result<std::shared_ptr<LevelDB>> create(
@@ -46,12 +50,38 @@ namespace kagome::storage {
      */
     void setWriteOptions(leveldb::WriteOptions wo);
 
+    /**
+     * @return value of the leveldb property \param name, e.g. "leveldb.stats",
+     * none if there is no such property
+     */
+    boost::optional<std::string> getProperty(const std::string &name) const;
+
+    /**
+     * @return approximate size in bytes of the keys in the range
+     * [\param from, \param to) on the disk
+     */
+    uint64_t approximateSize(const Buffer &from, const Buffer &to) const;
+
+    /**
+     * @brief Log statistics of the compactions and sizes of the cache and the
+     * files
+     */
+    void logStats() const;
+
     std::unique_ptr<BufferMapCursor> cursor() override;
 
+    // the cursor reads a snapshot of the database taken at its creation and
+    // does not fill the block cache, it stops at the keys without the prefix
+    std::unique_ptr<BufferMapCursor> scanCursor(const Buffer &prefix) override;
+
     std::unique_ptr<BufferBatch> batch() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
 
+    // the value is moved from the string it is read into instead of copying
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+
     bool contains(const Buffer &key) const override;
 
     bool empty() const override;
@@ -64,6 +94,9 @@ namespace kagome::storage {
     outcome::result<void> remove(const Buffer &key) override;
 
    private:
+    // stay alive until the database is closed
+    std::unique_ptr<leveldb::Cache> block_cache_;
+    std::unique_ptr<const leveldb::FilterPolicy> filter_policy_;
     std::unique_ptr<leveldb::DB> db_;
     leveldb::ReadOptions ro_;
     leveldb::WriteOptions wo_;
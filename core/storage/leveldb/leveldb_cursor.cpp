@@ -9,26 +9,59 @@
 
 namespace kagome::storage {
 
-  LevelDB::Cursor::Cursor(std::shared_ptr<leveldb::Iterator> it)
-      : i_(std::move(it)) {}
+  LevelDB::Cursor::Cursor(std::shared_ptr<leveldb::Iterator> it,
+                          std::shared_ptr<const leveldb::Snapshot> snapshot,
+                          Buffer prefix)
+      : snapshot_(std::move(snapshot)),
+        i_(std::move(it)),
+        prefix_(std::move(prefix)) {}
 
   outcome::result<void> LevelDB::Cursor::seekToFirst() {
-    i_->SeekToFirst();
+    if (prefix_.empty()) {
+      i_->SeekToFirst();
+    } else {
+      i_->Seek(make_slice(prefix_));
+    }
     return outcome::success();
   }
 
   outcome::result<void> LevelDB::Cursor::seek(const Buffer &key) {
-    i_->Seek(make_slice(key));
+    i_->Seek(boundKey(key));
+    return outcome::success();
+  }
+
+  outcome::result<void> LevelDB::Cursor::seekUpperBound(const Buffer &key) {
+    i_->Seek(boundKey(key));
+    if (i_->Valid() and i_->key() == make_slice(key)) {
+      i_->Next();
+    }
     return outcome::success();
   }
 
   outcome::result<void> LevelDB::Cursor::seekToLast() {
-    i_->SeekToLast();
+    // the first key after the ones with the prefix, which is the prefix with
+    // its last byte, which is not 0xff, incremented
+    auto end = prefix_;
+    auto &bytes = end.toVector();
+    while (not bytes.empty() and bytes.back() == 0xff) {
+      bytes.pop_back();
+    }
+    if (bytes.empty()) {
+      i_->SeekToLast();
+      return outcome::success();
+    }
+    ++bytes.back();
+    i_->Seek(make_slice(end));
+    if (i_->Valid()) {
+      i_->Prev();
+    } else {
+      i_->SeekToLast();
+    }
     return outcome::success();
   }
 
   bool LevelDB::Cursor::isValid() const {
-    return i_->Valid();
+    return i_->Valid() and i_->key().starts_with(make_slice(prefix_));
   }
 
   outcome::result<void> LevelDB::Cursor::next() {
@@ -49,4 +82,8 @@ namespace kagome::storage {
     return make_buffer(i_->value());
   }
 
+  leveldb::Slice LevelDB::Cursor::boundKey(const Buffer &key) const {
+    return make_slice(key < prefix_ ? prefix_ : key);
+  }
+
 }  // namespace kagome::storage
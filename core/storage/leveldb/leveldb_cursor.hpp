@@ -13,18 +13,23 @@ namespace kagome::storage {
 
   /**
    * @brief Instance of cursor can be used as bidirectional iterator over
-   * key-value bindings of the Map.
+   * key-value bindings of the Map. The cursor with a prefix sees only the
+   * keys with it, the one with a snapshot holds it until it is destroyed
    */
   class LevelDB::Cursor : public BufferMapCursor {
    public:
     ~Cursor() override = default;
 
-    explicit Cursor(std::shared_ptr<leveldb::Iterator> it);
+    explicit Cursor(std::shared_ptr<leveldb::Iterator> it,
+                    std::shared_ptr<const leveldb::Snapshot> snapshot = nullptr,
+                    Buffer prefix = {});
 
     outcome::result<void> seekToFirst() override;
 
     outcome::result<void> seek(const Buffer &key) override;
 
+    outcome::result<void> seekUpperBound(const Buffer &key) override;
+
     outcome::result<void> seekToLast() override;
 
     bool isValid() const override;
@@ -38,7 +43,13 @@ namespace kagome::storage {
     outcome::result<Buffer> value() const override;
 
    private:
+    /// @return the greater of \arg key and the prefix
+    leveldb::Slice boundKey(const Buffer &key) const;
+
+    // the snapshot is released after the iterator reading it
+    std::shared_ptr<const leveldb::Snapshot> snapshot_;
     std::shared_ptr<leveldb::Iterator> i_;
+    Buffer prefix_;
   };
 
 }  // namespace kagome::storage
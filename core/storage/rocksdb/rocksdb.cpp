@@ -0,0 +1,230 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb.hpp"
+
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+
+#include "storage/rocksdb/rocksdb_batch.hpp"
+#include "storage/rocksdb/rocksdb_cursor.hpp"
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+
+  namespace {
+    // column family names, indexed by RocksDB::Space
+    const std::array<std::string, RocksDB::kSpacesNum> kSpaceNames{
+        rocksdb::kDefaultColumnFamilyName, "trie_node", "block_data"};
+
+    // a filter answers most of the reads of absent keys without reading a
+    // block from the disk
+    constexpr int kBloomBitsPerKey = 10;
+
+    rocksdb::BlockBasedTableOptions makeTableOptions(size_t block_cache_size) {
+      rocksdb::BlockBasedTableOptions table_options;
+      table_options.block_cache = rocksdb::NewLRUCache(block_cache_size);
+      table_options.filter_policy.reset(
+          rocksdb::NewBloomFilterPolicy(kBloomBitsPerKey, false));
+      table_options.cache_index_and_filter_blocks = true;
+      table_options.pin_l0_filter_and_index_blocks_in_cache = true;
+      return table_options;
+    }
+  }  // namespace
+
+  RocksDB::~RocksDB() {
+    if (db_ == nullptr) {
+      return;
+    }
+    for (auto *handle : column_families_) {
+      db_->DestroyColumnFamilyHandle(handle);
+    }
+  }
+
+  outcome::result<std::shared_ptr<RocksDB>> RocksDB::create(
+      std::string_view path,
+      rocksdb::DBOptions options,
+      SpacesOptions spaces_options) {
+    std::vector<rocksdb::ColumnFamilyDescriptor> column_families;
+    for (size_t i = 0; i < kSpacesNum; i++) {
+      column_families.emplace_back(kSpaceNames[i],
+                                   std::move(spaces_options[i]));
+    }
+
+    auto r = std::make_shared<RocksDB>();
+    r->logger_ = common::createLogger("rocksdb");
+    rocksdb::DB *db = nullptr;
+    auto status = rocksdb::DB::Open(options,
+                                    std::string(path),
+                                    column_families,
+                                    &r->column_families_,
+                                    &db);
+    if (status.ok()) {
+      r->db_ = std::unique_ptr<rocksdb::DB>(db);
+      return r;
+    }
+
+    return rocks::error_as_result<std::shared_ptr<RocksDB>>(status);
+  }
+
+  rocksdb::DBOptions RocksDB::defaultOptions() {
+    rocksdb::DBOptions options;
+    options.create_if_missing = true;
+    options.create_missing_column_families = true;
+    // flushes and compactions of different column families don't wait for
+    // each other
+    options.IncreaseParallelism();
+    return options;
+  }
+
+  RocksDB::SpacesOptions RocksDB::defaultSpacesOptions() {
+    SpacesOptions spaces_options;
+
+    auto &meta = spaces_options[static_cast<size_t>(Space::kDefault)];
+    meta.table_factory.reset(
+        rocksdb::NewBlockBasedTableFactory(makeTableOptions(8ull << 20)));
+
+    // trie nodes are small values read by random keys, which are hashes, so
+    // they need a large cache and a filter on each level, while iteration
+    // over them is rare
+    auto &trie = spaces_options[static_cast<size_t>(Space::kTrieNode)];
+    trie.table_factory.reset(
+        rocksdb::NewBlockBasedTableFactory(makeTableOptions(256ull << 20)));
+    trie.level_compaction_dynamic_level_bytes = true;
+
+    // blocks are appended in the order of their numbers and are rarely read
+    // after import, so big blocks and a small cache suffice, and universal
+    // compaction rewrites them less often than the leveled one
+    auto &blocks = spaces_options[static_cast<size_t>(Space::kBlockData)];
+    auto blocks_table = makeTableOptions(32ull << 20);
+    blocks_table.block_size = 64ull << 10;
+    blocks.table_factory.reset(
+        rocksdb::NewBlockBasedTableFactory(blocks_table));
+    blocks.write_buffer_size = 64ull << 20;
+    blocks.compaction_style = rocksdb::kCompactionStyleUniversal;
+
+    return spaces_options;
+  }
+
+  std::shared_ptr<BufferStorage> RocksDB::getSpace(Space space) {
+    auto idx = static_cast<size_t>(space);
+    BOOST_ASSERT(idx < column_families_.size());
+    return std::make_shared<RocksDBSpace>(shared_from_this(),
+                                          column_families_[idx]);
+  }
+
+  void RocksDB::setReadOptions(rocksdb::ReadOptions ro) {
+    ro_ = ro;
+  }
+
+  void RocksDB::setWriteOptions(rocksdb::WriteOptions wo) {
+    wo_ = wo;
+  }
+
+  RocksDBSpace::RocksDBSpace(std::shared_ptr<RocksDB> db,
+                             rocksdb::ColumnFamilyHandle *column_family)
+      : db_{std::move(db)}, column_family_{column_family} {
+    BOOST_ASSERT(db_ != nullptr);
+    BOOST_ASSERT(column_family_ != nullptr);
+  }
+
+  std::unique_ptr<BufferMapCursor> RocksDBSpace::cursor() {
+    auto it = std::unique_ptr<rocksdb::Iterator>(
+        db_->db_->NewIterator(db_->ro_, column_family_));
+    return std::make_unique<Cursor>(db_, std::move(it));
+  }
+
+  std::unique_ptr<BufferBatch> RocksDBSpace::batch() {
+    return std::make_unique<Batch>(*this);
+  }
+
+  outcome::result<Buffer> RocksDBSpace::get(const Buffer &key) const {
+    rocksdb::PinnableSlice value;
+    auto status =
+        db_->db_->Get(db_->ro_, column_family_, rocks::make_slice(key), &value);
+    if (status.ok()) {
+      return rocks::make_buffer(value);
+    }
+
+    // not always an actual error so don't log it
+    if (status.IsNotFound()) {
+      return rocks::error_as_result<Buffer>(status);
+    }
+
+    return rocks::error_as_result<Buffer>(status, db_->logger_);
+  }
+
+  outcome::result<face::PinnedView<Buffer>> RocksDBSpace::getPinned(
+      const Buffer &key) const {
+    // the slice may refer to the block cache, so the database is kept alive
+    // along with it
+    struct Pinned {
+      std::shared_ptr<RocksDB> db;
+      rocksdb::PinnableSlice slice;
+    };
+    auto pinned = std::make_shared<Pinned>();
+    pinned->db = db_;
+    auto status = db_->db_->Get(
+        db_->ro_, column_family_, rocks::make_slice(key), &pinned->slice);
+    if (status.ok()) {
+      auto span = rocks::make_span(pinned->slice);
+      return face::PinnedView<Buffer>{span, std::move(pinned)};
+    }
+
+    if (status.IsNotFound()) {
+      return rocks::error_as_result<face::PinnedView<Buffer>>(status);
+    }
+
+    return rocks::error_as_result<face::PinnedView<Buffer>>(status,
+                                                           db_->logger_);
+  }
+
+  bool RocksDBSpace::contains(const Buffer &key) const {
+    std::string value;
+    // filters tell that most of the absent keys are absent without reading
+    // the disk
+    if (not db_->db_->KeyMayExist(
+            db_->ro_, column_family_, rocks::make_slice(key), &value)) {
+      return false;
+    }
+    return get(key).has_value();
+  }
+
+  bool RocksDBSpace::empty() const {
+    auto it = std::unique_ptr<rocksdb::Iterator>(
+        db_->db_->NewIterator(db_->ro_, column_family_));
+    it->SeekToFirst();
+    return not it->Valid();
+  }
+
+  outcome::result<void> RocksDBSpace::put(const Buffer &key,
+                                          const Buffer &value) {
+    auto status = db_->db_->Put(db_->wo_,
+                                column_family_,
+                                rocks::make_slice(key),
+                                rocks::make_slice(value));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return rocks::error_as_result<void>(status, db_->logger_);
+  }
+
+  outcome::result<void> RocksDBSpace::put(const Buffer &key, Buffer &&value) {
+    return put(key, static_cast<const Buffer &>(value));
+  }
+
+  outcome::result<void> RocksDBSpace::remove(const Buffer &key) {
+    auto status =
+        db_->db_->Delete(db_->wo_, column_family_, rocks::make_slice(key));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return rocks::error_as_result<void>(status, db_->logger_);
+  }
+
+}  // namespace kagome::storage
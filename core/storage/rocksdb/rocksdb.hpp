@@ -0,0 +1,135 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_ROCKSDB_ROCKSDB_HPP
+#define KAGOME_STORAGE_ROCKSDB_ROCKSDB_HPP
+
+#include <array>
+
+#include <rocksdb/db.h>
+
+#include "common/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/space.hpp"
+
+namespace kagome::storage {
+
+  class RocksDBSpace;
+
+  /**
+   * @brief RocksDB database, which keeps different kinds of data in separate
+   * column families, so that each of them has its own cache, filters and
+   * compaction settings suitable for the way it is accessed. A column family
+   * is accessed as a separate BufferStorage, @see RocksDB#getSpace
+   */
+  class RocksDB : public std::enable_shared_from_this<RocksDB> {
+   public:
+    /**
+     * Column families of the database
+     */
+    using Space = storage::Space;
+    static constexpr size_t kSpacesNum = 3;
+
+    using SpacesOptions = std::array<rocksdb::ColumnFamilyOptions, kSpacesNum>;
+
+    ~RocksDB();
+
+    /**
+     * @brief Factory method to create an instance of RocksDB class.
+     * @param path filesystem path where database is going to be
+     * @param options options of the database as a whole, such as background
+     * threads, logging, etc.
+     * @param spaces_options options of each column family, indexed by Space,
+     * such as caching, filters, compaction, etc.
+     * @return instance of RocksDB
+     */
+    static outcome::result<std::shared_ptr<RocksDB>> create(
+        std::string_view path,
+        rocksdb::DBOptions options = defaultOptions(),
+        SpacesOptions spaces_options = defaultSpacesOptions());
+
+    /**
+     * @return options, which create the database along with its column
+     * families if they are missing
+     */
+    static rocksdb::DBOptions defaultOptions();
+
+    /**
+     * @return options of the column families tuned for the data they keep
+     */
+    static SpacesOptions defaultSpacesOptions();
+
+    /**
+     * @return storage of the column family \param space. The database is
+     * kept alive as long as the storage is
+     */
+    std::shared_ptr<BufferStorage> getSpace(Space space);
+
+    /**
+     * @brief Set read options, which are used in @see RocksDBSpace#get
+     * @param ro options
+     */
+    void setReadOptions(rocksdb::ReadOptions ro);
+
+    /**
+     * @brief Set write options, which are used in @see RocksDBSpace#put
+     * @param wo options
+     */
+    void setWriteOptions(rocksdb::WriteOptions wo);
+
+   private:
+    friend class RocksDBSpace;
+
+    std::unique_ptr<rocksdb::DB> db_;
+    // indexed by Space
+    std::vector<rocksdb::ColumnFamilyHandle *> column_families_;
+    rocksdb::ReadOptions ro_;
+    rocksdb::WriteOptions wo_;
+    common::Logger logger_;
+  };
+
+  /**
+   * @brief An implementation of PersistentBufferMap interface over a single
+   * column family of RocksDB
+   */
+  class RocksDBSpace : public BufferStorage {
+   public:
+    class Batch;
+    class Cursor;
+
+    RocksDBSpace(std::shared_ptr<RocksDB> db,
+                 rocksdb::ColumnFamilyHandle *column_family);
+
+    ~RocksDBSpace() override = default;
+
+    std::unique_ptr<BufferMapCursor> cursor() override;
+
+    std::unique_ptr<BufferBatch> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+
+    // the value stays pinned in the block cache while the view lives
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+
+    bool contains(const Buffer &key) const override;
+
+    bool empty() const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+
+    // value will be copied, not moved, due to internal structure of RocksDB
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    std::shared_ptr<RocksDB> db_;
+    rocksdb::ColumnFamilyHandle *column_family_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_ROCKSDB_ROCKSDB_HPP
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_batch.hpp"
+
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+
+  RocksDBSpace::Batch::Batch(RocksDBSpace &space) : space_(space) {}
+
+  outcome::result<void> RocksDBSpace::Batch::put(const Buffer &key,
+                                                 const Buffer &value) {
+    auto status = batch_.Put(space_.column_family_,
+                             rocks::make_slice(key),
+                             rocks::make_slice(value));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return rocks::error_as_result<void>(status, space_.db_->logger_);
+  }
+
+  outcome::result<void> RocksDBSpace::Batch::put(const Buffer &key,
+                                                 Buffer &&value) {
+    return put(key, static_cast<const Buffer &>(value));
+  }
+
+  outcome::result<void> RocksDBSpace::Batch::remove(const Buffer &key) {
+    auto status = batch_.Delete(space_.column_family_, rocks::make_slice(key));
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return rocks::error_as_result<void>(status, space_.db_->logger_);
+  }
+
+  outcome::result<void> RocksDBSpace::Batch::commit() {
+    auto status = space_.db_->db_->Write(space_.db_->wo_, &batch_);
+    if (status.ok()) {
+      return outcome::success();
+    }
+
+    return rocks::error_as_result<void>(status, space_.db_->logger_);
+  }
+
+  void RocksDBSpace::Batch::clear() {
+    batch_.Clear();
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb_cursor.hpp"
+
+#include "storage/rocksdb/rocksdb_util.hpp"
+
+namespace kagome::storage {
+
+  RocksDBSpace::Cursor::Cursor(std::shared_ptr<RocksDB> db,
+                               std::unique_ptr<rocksdb::Iterator> it)
+      : db_(std::move(db)), i_(std::move(it)) {}
+
+  outcome::result<void> RocksDBSpace::Cursor::seekToFirst() {
+    i_->SeekToFirst();
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDBSpace::Cursor::seek(const Buffer &key) {
+    i_->Seek(rocks::make_slice(key));
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDBSpace::Cursor::seekUpperBound(
+      const Buffer &key) {
+    auto slice = rocks::make_slice(key);
+    i_->Seek(slice);
+    if (i_->Valid() and i_->key() == slice) {
+      i_->Next();
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDBSpace::Cursor::seekToLast() {
+    i_->SeekToLast();
+    return outcome::success();
+  }
+
+  bool RocksDBSpace::Cursor::isValid() const {
+    return i_->Valid();
+  }
+
+  outcome::result<void> RocksDBSpace::Cursor::next() {
+    i_->Next();
+    return outcome::success();
+  }
+
+  outcome::result<void> RocksDBSpace::Cursor::prev() {
+    i_->Prev();
+    return outcome::success();
+  }
+
+  outcome::result<Buffer> RocksDBSpace::Cursor::key() const {
+    return rocks::make_buffer(i_->key());
+  }
+
+  outcome::result<Buffer> RocksDBSpace::Cursor::value() const {
+    return rocks::make_buffer(i_->value());
+  }
+
+}  // namespace kagome::storage
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_ROCKSDB_ROCKSDB_CURSOR_HPP
+#define KAGOME_STORAGE_ROCKSDB_ROCKSDB_CURSOR_HPP
+
+#include <rocksdb/iterator.h>
+#include "storage/rocksdb/rocksdb.hpp"
+
+namespace kagome::storage {
+
+  /**
+   * @brief Instance of cursor can be used as bidirectional iterator over
+   * key-value bindings of a column family.
+   */
+  class RocksDBSpace::Cursor : public BufferMapCursor {
+   public:
+    ~Cursor() override = default;
+
+    /**
+     * @param db database of the iterator, which must outlive it
+     */
+    Cursor(std::shared_ptr<RocksDB> db, std::unique_ptr<rocksdb::Iterator> it);
+
+    outcome::result<void> seekToFirst() override;
+
+    outcome::result<void> seek(const Buffer &key) override;
+
+    outcome::result<void> seekUpperBound(const Buffer &key) override;
+
+    outcome::result<void> seekToLast() override;
+
+    bool isValid() const override;
+
+    outcome::result<void> next() override;
+
+    outcome::result<void> prev() override;
+
+    outcome::result<Buffer> key() const override;
+
+    outcome::result<Buffer> value() const override;
+
+   private:
+    // declared before the iterator to be destroyed after it
+    std::shared_ptr<RocksDB> db_;
+    std::unique_ptr<rocksdb::Iterator> i_;
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_STORAGE_ROCKSDB_ROCKSDB_CURSOR_HPP
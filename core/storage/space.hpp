@@ -0,0 +1,28 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_STORAGE_SPACE_HPP
+#define KAGOME_CORE_STORAGE_SPACE_HPP
+
+#include <cstdint>
+
+namespace kagome::storage {
+
+  /**
+   * Kinds of the data of the node, which a database may keep apart, e.g. in
+   * the column families of RocksDB, as they are accessed differently
+   */
+  enum class Space : uint8_t {
+    // all the data not listed below, e.g. consensus metadata
+    kDefault = 0,
+    // trie nodes, which are read randomly by their hashes
+    kTrieNode,
+    // block headers, bodies and justifications, which are mostly appended
+    kBlockData,
+  };
+
+}  // namespace kagome::storage
+
+#endif  // KAGOME_CORE_STORAGE_SPACE_HPP
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_CLEAR_PREFIX_HPP
+#define KAGOME_STORAGE_TRIE_CLEAR_PREFIX_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+
+namespace kagome::storage::trie {
+
+  /// result of the removal of a limited number of the entries by a prefix
+  struct ClearPrefixResult {
+    // no entry with the prefix is left
+    bool all_removed{false};
+    uint32_t removed{0};
+  };
+
+  /**
+   * Removes at most \arg limit entries of \arg map, the keys of which begin
+   * with \arg prefix, in the order of the keys, one by one, so that the work
+   * is bounded by the limit, and the next call resumes with the entries left
+   */
+  template <typename Map>
+  outcome::result<ClearPrefixResult> clearPrefixLimited(
+      Map &map, const common::Buffer &prefix, uint32_t limit) {
+    // the keys are collected before the removal invalidates the cursor, the
+    // one over the limit tells that some are left
+    std::vector<common::Buffer> keys;
+    if (map.contains(prefix)) {
+      keys.push_back(prefix);
+    }
+    auto cursor = map.cursor();
+    OUTCOME_TRY(cursor->seekUpperBound(prefix));
+    while (keys.size() <= limit and cursor->isValid()) {
+      OUTCOME_TRY(key, cursor->key());
+      if (key.size() < prefix.size()
+          or not std::equal(prefix.begin(), prefix.end(), key.begin())) {
+        break;
+      }
+      keys.push_back(std::move(key));
+      OUTCOME_TRY(cursor->next());
+    }
+    ClearPrefixResult result{keys.size() <= limit, 0};
+    if (not result.all_removed) {
+      keys.pop_back();
+    }
+    for (const auto &key : keys) {
+      OUTCOME_TRY(map.remove(key));
+    }
+    result.removed = keys.size();
+    return result;
+  }
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_CLEAR_PREFIX_HPP
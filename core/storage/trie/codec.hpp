@@ -28,13 +28,25 @@ namespace kagome::storage::trie {
     virtual outcome::result<common::Buffer> encodeNode(
         const Node &node) const = 0;
 
+    /**
+     * @brief Encode node to the end of a buffer
+     * @param node node in the trie
+     * @param out buffer to append the encoded representation of {@param
+     * node} to, which may be reused as a scratch buffer for many nodes to
+     * save the allocations. Its content past the original size is
+     * unspecified on an error
+     */
+    virtual outcome::result<void> encodeNodeTo(const Node &node,
+                                               common::Buffer &out) const = 0;
+
     /**
      * @brief Decode node from bytes
-     * @param encoded_data a buffer containing encoded representation of a node
+     * @param encoded_data bytes of encoded representation of a node, which
+     * may be a view of the storage the node is read from
      * @return a node in the trie
      */
     virtual outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const = 0;
+        gsl::span<const uint8_t> encoded_data) const = 0;
 
     /**
      * @brief Get the merkle value of a node
@@ -6,25 +6,60 @@
 #include "storage/trie/impl/ephemeral_trie_batch_impl.hpp"
 
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
 
 namespace kagome::storage::trie {
 
   EphemeralTrieBatchImpl::EphemeralTrieBatchImpl(
-      std::shared_ptr<Codec> codec, std::unique_ptr<PolkadotTrie> trie)
+      std::shared_ptr<Codec> codec,
+      std::unique_ptr<PolkadotTrie> trie,
+      std::shared_ptr<FlatState> flat_state,
+      const common::Buffer &root)
       : codec_{std::move(codec)}, trie_{std::move(trie)} {
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(trie_ != nullptr);
+    if (flat_state != nullptr) {
+      flat_overlay_.emplace(std::move(flat_state), root);
+    }
   }
 
   outcome::result<Buffer> EphemeralTrieBatchImpl::get(const Buffer &key) const {
+    if (flat_overlay_) {
+      auto value = flat_overlay_->get(key);
+      if (value) {
+        if (not value.value()) {
+          return TrieError::NO_VALUE;
+        }
+        return std::move(value.value().value());
+      }
+      if (value.error() != FlatState::Error::UNKNOWN_STATE) {
+        return value.error();
+      }
+    }
     return trie_->get(key);
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  EphemeralTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    if (flat_overlay_) {
+      auto values = flat_overlay_->getMany(keys);
+      if (values or values.error() != FlatState::Error::UNKNOWN_STATE) {
+        return values;
+      }
+    }
+    return trie_->getMany(keys);
+  }
+
   std::unique_ptr<BufferMapCursor> EphemeralTrieBatchImpl::cursor() {
     return std::make_unique<PolkadotTrieCursor>(*trie_);
   }
 
   bool EphemeralTrieBatchImpl::contains(const Buffer &key) const {
+    if (flat_overlay_) {
+      if (auto value = flat_overlay_->get(key); value) {
+        return value.value().has_value();
+      }
+    }
     return trie_->contains(key);
   }
 
@@ -34,20 +69,37 @@ namespace kagome::storage::trie {
 
   outcome::result<void> EphemeralTrieBatchImpl::clearPrefix(
       const Buffer &prefix) {
-    return trie_->clearPrefix(prefix);
+    OUTCOME_TRY(trie_->clearPrefix(prefix));
+    if (flat_overlay_) {
+      flat_overlay_->clearPrefix(prefix);
+    }
+    return outcome::success();
+  }
+
+  outcome::result<ClearPrefixResult> EphemeralTrieBatchImpl::clearPrefix(
+      const Buffer &prefix, uint32_t limit) {
+    // the flat overlay is updated by the removal of each entry
+    return clearPrefixLimited(*this, prefix, limit);
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::put(const Buffer &key,
                                                     const Buffer &value) {
-    return trie_->put(key, value);
+    return put(key, Buffer{value});
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::put(const Buffer &key,
                                                     Buffer &&value) {
+    if (flat_overlay_) {
+      flat_overlay_->put(key, value);
+    }
     return trie_->put(key, std::move(value));
   }
 
   outcome::result<void> EphemeralTrieBatchImpl::remove(const Buffer &key) {
-    return trie_->remove(key);
+    OUTCOME_TRY(trie_->remove(key));
+    if (flat_overlay_) {
+      flat_overlay_->remove(key);
+    }
+    return outcome::success();
   }
 }  // namespace kagome::storage::trie
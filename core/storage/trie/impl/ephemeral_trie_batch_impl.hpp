@@ -7,6 +7,7 @@
 #define KAGOME_STORAGE_TRIE_IMPL_EPHEMERAL_TRIE_BATCH
 
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 #include "storage/trie/trie_batches.hpp"
 
@@ -14,15 +15,25 @@ namespace kagome::storage::trie {
 
   class EphemeralTrieBatchImpl : public EphemeralTrieBatch {
    public:
+    /**
+     * @param flat_state if set, the values are read from it instead of the
+     * trie while it has the state of the batch with \arg root
+     */
     EphemeralTrieBatchImpl(std::shared_ptr<Codec> codec,
-                           std::unique_ptr<PolkadotTrie> trie);
+                           std::unique_ptr<PolkadotTrie> trie,
+                           std::shared_ptr<FlatState> flat_state = nullptr,
+                           const common::Buffer &root = {});
     ~EphemeralTrieBatchImpl() override = default;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
     std::unique_ptr<BufferMapCursor> cursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
     outcome::result<void> clearPrefix(const Buffer &prefix) override;
+    outcome::result<ClearPrefixResult> clearPrefix(const Buffer &prefix,
+                                                   uint32_t limit) override;
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
@@ -30,6 +41,7 @@ namespace kagome::storage::trie {
    private:
     std::shared_ptr<Codec> codec_;
     std::unique_ptr<PolkadotTrie> trie_;
+    boost::optional<FlatStateOverlay> flat_overlay_;
   };
 
 }  // namespace kagome::storage::trie
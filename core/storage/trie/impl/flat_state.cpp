@@ -0,0 +1,589 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/flat_state.hpp"
+
+#include <algorithm>
+
+#include "scale/scale.hpp"
+#include "storage/database_error.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, FlatState::Error, e) {
+  using E = kagome::storage::trie::FlatState::Error;
+  switch (e) {
+    case E::UNKNOWN_STATE:
+      return "The state is not in the flat state";
+    case E::REBUILD_STOPPED:
+      return "The rebuild of the flat state is stopped";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::storage::trie {
+
+  namespace {
+    // subspaces of the prefix of the flat state
+    constexpr uint8_t kEntryTag = 'e';
+    constexpr uint8_t kDiffTag = 'd';
+    constexpr uint8_t kBaseRootTag = 'r';
+
+    // max number of the entries written by one batch when the entries are
+    // rebuilt, so that the whole state is never kept in the memory
+    constexpr size_t kRebuildBatchSize = 65536;
+
+    bool startsWith(const common::Buffer &key, const common::Buffer &prefix) {
+      return key.size() >= prefix.size()
+             and std::equal(prefix.begin(), prefix.end(), key.begin());
+    }
+
+    // the changes are kept in a map, which the codec doesn't know
+    using EncodedDiff =
+        std::tuple<common::Buffer,
+                   std::vector<common::Buffer>,
+                   std::vector<std::pair<common::Buffer,
+                                         boost::optional<common::Buffer>>>>;
+
+    /// @return parent and diff of a state decoded from \arg encoded
+    outcome::result<std::pair<common::Buffer, FlatState::Diff>> decodeDiff(
+        const common::Buffer &encoded) {
+      OUTCOME_TRY(decoded, scale::decode<EncodedDiff>(encoded));
+      auto &[parent, cleared_prefixes, changes] = decoded;
+      FlatState::Diff diff;
+      diff.cleared_prefixes = std::move(cleared_prefixes);
+      for (auto &[key, value] : changes) {
+        diff.changes.emplace(std::move(key), std::move(value));
+      }
+      return std::make_pair(std::move(parent), std::move(diff));
+    }
+  }  // namespace
+
+  void FlatState::Diff::put(const common::Buffer &key, common::Buffer value) {
+    changes[key] = std::move(value);
+  }
+
+  void FlatState::Diff::remove(const common::Buffer &key) {
+    changes[key] = boost::none;
+  }
+
+  void FlatState::Diff::clearPrefix(const common::Buffer &prefix) {
+    // the changes made before are cleared along with the stored values
+    for (auto it = changes.lower_bound(prefix);
+         it != changes.end() and startsWith(it->first, prefix);) {
+      it = changes.erase(it);
+    }
+    auto covered = std::any_of(
+        cleared_prefixes.begin(),
+        cleared_prefixes.end(),
+        [&](auto &cleared) { return startsWith(prefix, cleared); });
+    if (not covered) {
+      cleared_prefixes.push_back(prefix);
+    }
+  }
+
+  bool FlatState::Diff::touches(const common::Buffer &key) const {
+    return changes.count(key) != 0;
+  }
+
+  bool FlatState::Diff::clears(const common::Buffer &key) const {
+    return std::any_of(
+        cleared_prefixes.begin(),
+        cleared_prefixes.end(),
+        [&](auto &prefix) { return startsWith(key, prefix); });
+  }
+
+  void FlatState::Diff::append(Diff next) {
+    for (auto &prefix : next.cleared_prefixes) {
+      clearPrefix(prefix);
+    }
+    for (auto &[key, value] : next.changes) {
+      changes[key] = std::move(value);
+    }
+  }
+
+  outcome::result<std::shared_ptr<FlatState>> FlatState::create(
+      std::shared_ptr<BufferStorage> storage,
+      common::Buffer prefix,
+      std::shared_ptr<TrieSerializer> serializer) {
+    std::shared_ptr<FlatState> flat_state{new FlatState(
+        std::move(storage), std::move(prefix), std::move(serializer))};
+    OUTCOME_TRY(flat_state->load());
+    return flat_state;
+  }
+
+  FlatState::FlatState(std::shared_ptr<BufferStorage> storage,
+                       common::Buffer prefix,
+                       std::shared_ptr<TrieSerializer> serializer)
+      : storage_{std::move(storage)},
+        prefix_{std::move(prefix)},
+        serializer_{std::move(serializer)},
+        logger_{common::createLogger("Flat State: ")} {
+    BOOST_ASSERT(storage_ != nullptr);
+    BOOST_ASSERT(serializer_ != nullptr);
+  }
+
+  FlatState::~FlatState() {
+    stopped_ = true;
+    if (rebuild_thread_.joinable()) {
+      rebuild_thread_.join();
+    }
+  }
+
+  outcome::result<void> FlatState::load() {
+    auto base_root = storage_->get(baseRootKey());
+    if (not base_root) {
+      if (base_root.error() != DatabaseError::NOT_FOUND) {
+        return base_root.error();
+      }
+      logger_->info("No flat state yet, it is built at the next finalization");
+      return outcome::success();
+    }
+    base_root_ = std::move(base_root.value());
+    base_ready_ = true;
+
+    auto diffs_prefix = common::Buffer{prefix_}.putUint8(kDiffTag);
+    auto cursor = storage_->scanCursor(diffs_prefix);
+    OUTCOME_TRY(cursor->seek(diffs_prefix));
+    while (cursor->isValid()) {
+      OUTCOME_TRY(key, cursor->key());
+      if (not startsWith(key, diffs_prefix)) {
+        break;
+      }
+      OUTCOME_TRY(value, cursor->value());
+      OUTCOME_TRY(decoded, decodeDiff(value));
+      emplaceDiff(key.subbuffer(diffs_prefix.size()),
+                  std::move(decoded.first),
+                  std::move(decoded.second));
+      OUTCOME_TRY(cursor->next());
+    }
+    logger_->info("Loaded flat state at {} with {} unfinalized states",
+                  base_root_.value(),
+                  diffs_.size());
+    return outcome::success();
+  }
+
+  void FlatState::emplaceDiff(common::Buffer root,
+                              common::Buffer parent,
+                              Diff diff) {
+    StateDiff state{std::move(parent), boost::none};
+    if (loaded_diffs_num_ < kMaxDiffsNum) {
+      state.diff = std::move(diff);
+      loaded_diffs_num_++;
+    }
+    diffs_.emplace(std::move(root), std::move(state));
+  }
+
+  void FlatState::eraseDiff(const common::Buffer &root) {
+    auto it = diffs_.find(root);
+    if (it == diffs_.end()) {
+      return;
+    }
+    if (it->second.diff) {
+      loaded_diffs_num_--;
+    }
+    diffs_.erase(it);
+  }
+
+  outcome::result<FlatState::Diff> FlatState::loadDiff(
+      const common::Buffer &root) const {
+    OUTCOME_TRY(encoded, storage_->get(diffKey(root)));
+    OUTCOME_TRY(decoded, decodeDiff(encoded));
+    return std::move(decoded.second);
+  }
+
+  bool FlatState::hasState(const common::Buffer &root) const {
+    std::shared_lock lock{mutex_};
+    if (not base_ready_) {
+      return false;
+    }
+    auto chain = chainTo(root);
+    // the states with the diffs in the storage only are read from the trie
+    return chain.has_value()
+           and std::all_of(chain->begin(), chain->end(), [&](auto &state) {
+                 return diffs_.at(state).diff.has_value();
+               });
+  }
+
+  outcome::result<boost::optional<common::Buffer>> FlatState::get(
+      const common::Buffer &root, const common::Buffer &key) const {
+    std::shared_lock lock{mutex_};
+    if (not base_ready_) {
+      return Error::UNKNOWN_STATE;
+    }
+    auto chain = chainTo(root);
+    if (not chain) {
+      return Error::UNKNOWN_STATE;
+    }
+    // the latest change of the key is the one in the closest state
+    for (auto it = chain->rbegin(); it != chain->rend(); ++it) {
+      auto &state = diffs_.at(*it);
+      if (not state.diff) {
+        return Error::UNKNOWN_STATE;
+      }
+      auto &diff = state.diff.value();
+      if (auto change = diff.changes.find(key); change != diff.changes.end()) {
+        return change->second;
+      }
+      if (diff.clears(key)) {
+        return boost::none;
+      }
+    }
+    auto value = storage_->get(entryKey(key));
+    if (not value) {
+      if (value.error() == DatabaseError::NOT_FOUND) {
+        return boost::none;
+      }
+      return value.error();
+    }
+    return std::move(value.value());
+  }
+
+  outcome::result<void> FlatState::addState(const common::Buffer &parent,
+                                            const common::Buffer &root,
+                                            Diff diff) {
+    std::unique_lock lock{mutex_};
+    if (root == base_root_ or diffs_.count(root) != 0) {
+      return outcome::success();
+    }
+    if (parent != base_root_ and diffs_.count(parent) == 0) {
+      return outcome::success();
+    }
+    std::vector<std::pair<common::Buffer, boost::optional<common::Buffer>>>
+        changes{diff.changes.begin(), diff.changes.end()};
+    OUTCOME_TRY(encoded,
+                scale::encode(EncodedDiff{
+                    parent, diff.cleared_prefixes, std::move(changes)}));
+    OUTCOME_TRY(storage_->put(diffKey(root), common::Buffer{encoded}));
+    if (loaded_diffs_num_ >= kMaxDiffsNum) {
+      logger_->debug("Diff of state {} is kept in the storage only, as there "
+                     "are {} unfinalized states",
+                     root,
+                     diffs_.size());
+    }
+    emplaceDiff(root, parent, std::move(diff));
+    return outcome::success();
+  }
+
+  outcome::result<void> FlatState::finalize(const common::Buffer &root) {
+    std::lock_guard finalize_lock{finalize_mutex_};
+    if (rebuilding_) {
+      // applied once the entries are rebuilt
+      finalized_meanwhile_ = root;
+      return outcome::success();
+    }
+    OUTCOME_TRY(rebuild_needed, finalizeLocked(root));
+    if (rebuild_needed) {
+      if (rebuild_thread_.joinable()) {
+        rebuild_thread_.join();
+      }
+      rebuilding_ = true;
+      rebuild_thread_ =
+          std::thread{[this, root] { rebuildInBackground(root); }};
+    }
+    return outcome::success();
+  }
+
+  void FlatState::waitForRebuild() {
+    std::unique_lock lock{finalize_mutex_};
+    rebuilt_cv_.wait(lock, [this] { return not rebuilding_; });
+  }
+
+  outcome::result<bool> FlatState::finalizeLocked(const common::Buffer &root) {
+    boost::optional<std::vector<common::Buffer>> chain;
+    std::vector<common::Buffer> dropped;
+    Diff applied;
+    {
+      std::shared_lock lock{mutex_};
+      if (base_ready_ and root == base_root_) {
+        return false;
+      }
+      if (base_ready_) {
+        chain = chainTo(root);
+      }
+      if (chain) {
+        dropped = diffsNotAbove(root);
+        // the diffs are applied by the finalizations only, which don't
+        // overlap, so they stay after the lock is released
+        for (auto &state : chain.value()) {
+          if (auto &diff = diffs_.at(state).diff) {
+            applied.append(diff.value());
+          } else {
+            OUTCOME_TRY(stored, loadDiff(state));
+            applied.append(std::move(stored));
+          }
+        }
+      }
+    }
+    if (not chain) {
+      OUTCOME_TRY(startRebuild(root));
+      return true;
+    }
+
+    auto batch = storage_->batch();
+    for (auto &prefix : applied.cleared_prefixes) {
+      auto entries_prefix = entryKey(prefix);
+      auto cursor = storage_->cursor();
+      OUTCOME_TRY(cursor->seek(entries_prefix));
+      while (cursor->isValid()) {
+        OUTCOME_TRY(key, cursor->key());
+        if (not startsWith(key, entries_prefix)) {
+          break;
+        }
+        OUTCOME_TRY(batch->remove(key));
+        OUTCOME_TRY(cursor->next());
+      }
+    }
+    for (auto &[key, value] : applied.changes) {
+      if (value) {
+        OUTCOME_TRY(batch->put(entryKey(key), std::move(value.value())));
+      } else {
+        OUTCOME_TRY(batch->remove(entryKey(key)));
+      }
+    }
+    for (auto &state : dropped) {
+      OUTCOME_TRY(batch->remove(diffKey(state)));
+    }
+    OUTCOME_TRY(batch->put(baseRootKey(), root));
+
+    // the readers of the previous state mustn't see the entries of the new
+    // one, so they wait for the write
+    std::unique_lock lock{mutex_};
+    OUTCOME_TRY(batch->commit());
+    base_root_ = root;
+    for (auto &state : dropped) {
+      eraseDiff(state);
+    }
+    logger_->debug("Flat state is moved to {} over {} states, {} dropped",
+                   root,
+                   chain->size(),
+                   dropped.size());
+    return false;
+  }
+
+  boost::optional<std::vector<common::Buffer>> FlatState::chainTo(
+      const common::Buffer &root) const {
+    std::vector<common::Buffer> chain;
+    auto current = std::cref(root);
+    while (current.get() != base_root_) {
+      auto it = diffs_.find(current.get());
+      // the diffs don't form a cycle, but a corrupted storage might
+      if (it == diffs_.end() or chain.size() > diffs_.size()) {
+        return boost::none;
+      }
+      chain.push_back(it->first);
+      current = std::cref(it->second.parent);
+    }
+    std::reverse(chain.begin(), chain.end());
+    return chain;
+  }
+
+  bool FlatState::isDescendant(const common::Buffer &root,
+                               const common::Buffer &ancestor) const {
+    auto current = std::cref(root);
+    for (size_t steps = 0; steps <= diffs_.size(); steps++) {
+      auto it = diffs_.find(current.get());
+      if (it == diffs_.end()) {
+        return false;
+      }
+      if (it->second.parent == ancestor) {
+        return true;
+      }
+      current = std::cref(it->second.parent);
+    }
+    return false;
+  }
+
+  std::vector<common::Buffer> FlatState::diffsNotAbove(
+      const common::Buffer &root) const {
+    std::vector<common::Buffer> roots;
+    for (auto &[state, diff] : diffs_) {
+      if (not isDescendant(state, root)) {
+        roots.push_back(state);
+      }
+    }
+    return roots;
+  }
+
+  outcome::result<void> FlatState::startRebuild(const common::Buffer &root) {
+    logger_->info("Rebuild the flat state at {}", root);
+    std::unique_lock lock{mutex_};
+    auto dropped = diffsNotAbove(root);
+    // the entries are incomplete until the root is written back, so an
+    // interrupted rebuild is started over
+    auto batch = storage_->batch();
+    OUTCOME_TRY(batch->remove(baseRootKey()));
+    for (auto &state : dropped) {
+      OUTCOME_TRY(batch->remove(diffKey(state)));
+    }
+    OUTCOME_TRY(batch->commit());
+    for (auto &state : dropped) {
+      eraseDiff(state);
+    }
+    // the states imported during the rebuild are added on top of the root
+    base_root_ = root;
+    base_ready_ = false;
+    return outcome::success();
+  }
+
+  void FlatState::rebuildInBackground(common::Buffer root) {
+    while (true) {
+      if (auto res = rebuild(root); not res) {
+        // started over with the next finalization
+        logger_->warn(
+            "Flat state is not rebuilt at {}: {}", root, res.error().message());
+      }
+      std::unique_lock lock{finalize_mutex_};
+      auto next = std::move(finalized_meanwhile_);
+      finalized_meanwhile_.reset();
+      bool rebuild_needed = false;
+      if (next and not stopped_) {
+        auto res = finalizeLocked(next.value());
+        if (not res) {
+          logger_->warn("Flat state is not moved to {}: {}",
+                        next.value(),
+                        res.error().message());
+        }
+        rebuild_needed = res and res.value();
+      }
+      if (not rebuild_needed) {
+        rebuilding_ = false;
+        lock.unlock();
+        rebuilt_cv_.notify_all();
+        return;
+      }
+      root = std::move(next.value());
+    }
+  }
+
+  outcome::result<void> FlatState::rebuild(const common::Buffer &root) {
+    auto batch = storage_->batch();
+    auto flush = [&]() -> outcome::result<void> {
+      OUTCOME_TRY(batch->commit());
+      batch->clear();
+      return outcome::success();
+    };
+
+    auto entries_prefix = common::Buffer{prefix_}.putUint8(kEntryTag);
+    size_t batch_size = 0;
+    {
+      auto cursor = storage_->scanCursor(entries_prefix);
+      OUTCOME_TRY(cursor->seek(entries_prefix));
+      while (cursor->isValid()) {
+        OUTCOME_TRY(key, cursor->key());
+        if (not startsWith(key, entries_prefix)) {
+          break;
+        }
+        OUTCOME_TRY(batch->remove(key));
+        if (++batch_size == kRebuildBatchSize) {
+          if (stopped_) {
+            return Error::REBUILD_STOPPED;
+          }
+          OUTCOME_TRY(flush());
+          batch_size = 0;
+        }
+        OUTCOME_TRY(cursor->next());
+      }
+    }
+
+    // the nodes loaded by the scan are not attached to the trie and are
+    // freed right away
+    OUTCOME_TRY(state, serializer_->retrieveImmutableTrie(root));
+    size_t entries_num = 0;
+    if (not state->empty()) {
+      PolkadotTrieCursor cursor{*state};
+      OUTCOME_TRY(cursor.seekToFirst());
+      while (cursor.isValid()) {
+        OUTCOME_TRY(key, cursor.key());
+        OUTCOME_TRY(value, cursor.value());
+        OUTCOME_TRY(batch->put(entryKey(key), std::move(value)));
+        entries_num++;
+        if (++batch_size == kRebuildBatchSize) {
+          if (stopped_) {
+            return Error::REBUILD_STOPPED;
+          }
+          OUTCOME_TRY(flush());
+          batch_size = 0;
+        }
+        OUTCOME_TRY(cursor.next());
+      }
+    }
+    OUTCOME_TRY(batch->put(baseRootKey(), root));
+    OUTCOME_TRY(flush());
+
+    std::unique_lock lock{mutex_};
+    base_ready_ = true;
+    logger_->info("Flat state is rebuilt at {} with {} entries",
+                  root,
+                  entries_num);
+    return outcome::success();
+  }
+
+  common::Buffer FlatState::entryKey(const common::Buffer &key) const {
+    return common::Buffer{prefix_}.putUint8(kEntryTag).putBuffer(key);
+  }
+
+  common::Buffer FlatState::diffKey(const common::Buffer &root) const {
+    return common::Buffer{prefix_}.putUint8(kDiffTag).putBuffer(root);
+  }
+
+  common::Buffer FlatState::baseRootKey() const {
+    return common::Buffer{prefix_}.putUint8(kBaseRootTag);
+  }
+
+  FlatStateOverlay::FlatStateOverlay(std::shared_ptr<FlatState> flat_state,
+                                     common::Buffer root)
+      : flat_state_{std::move(flat_state)}, root_{std::move(root)} {
+    BOOST_ASSERT(flat_state_ != nullptr);
+    known_ = flat_state_->hasState(root_);
+  }
+
+  outcome::result<boost::optional<common::Buffer>> FlatStateOverlay::get(
+      const common::Buffer &key) const {
+    if (auto change = diff_.changes.find(key); change != diff_.changes.end()) {
+      return change->second;
+    }
+    if (diff_.clears(key)) {
+      return boost::none;
+    }
+    if (not known_) {
+      return FlatState::Error::UNKNOWN_STATE;
+    }
+    return flat_state_->get(root_, key);
+  }
+
+  outcome::result<std::vector<boost::optional<common::Buffer>>>
+  FlatStateOverlay::getMany(gsl::span<const common::Buffer> keys) const {
+    std::vector<boost::optional<common::Buffer>> values;
+    values.reserve(keys.size());
+    for (auto &key : keys) {
+      OUTCOME_TRY(value, get(key));
+      values.emplace_back(std::move(value));
+    }
+    return values;
+  }
+
+  void FlatStateOverlay::put(const common::Buffer &key, common::Buffer value) {
+    diff_.put(key, std::move(value));
+  }
+
+  void FlatStateOverlay::remove(const common::Buffer &key) {
+    diff_.remove(key);
+  }
+
+  void FlatStateOverlay::clearPrefix(const common::Buffer &prefix) {
+    diff_.clearPrefix(prefix);
+  }
+
+  outcome::result<void> FlatStateOverlay::commit(
+      const common::Buffer &new_root) {
+    auto diff = std::move(diff_);
+    diff_ = {};
+    OUTCOME_TRY(flat_state_->addState(root_, new_root, std::move(diff)));
+    root_ = new_root;
+    known_ = flat_state_->hasState(root_);
+    return outcome::success();
+  }
+
+}  // namespace kagome::storage::trie
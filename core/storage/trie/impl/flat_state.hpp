@@ -0,0 +1,293 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "common/logger.hpp"
+#include "storage/buffer_map_types.hpp"
+#include "storage/trie/serialization/trie_serializer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Values of the storage keys of the states, which are read with a single
+   * lookup instead of a walk from the root of the trie to a leaf.
+   * The entries of the last finalized state are kept in a keyspace of their
+   * own, and the states imported on top of it as the differences from their
+   * parents, which are in the memory and in the storage, so that they
+   * survive a restart. When a state is finalized, the differences of the
+   * states up to it are applied to the entries and the differences of the
+   * discarded forks are dropped. The entries of a state, which is not
+   * derived from the current one, are rebuilt from its trie in the
+   * background, the states are read from the trie meanwhile.
+   * The trie is still the source of the roots and the proofs, the flat state
+   * only answers the reads of the states it has. Thread-safe
+   */
+  class FlatState {
+   public:
+    enum class Error { UNKNOWN_STATE = 1, REBUILD_STOPPED };
+
+    /**
+     * Changes made to a state by a batch, in the order they are applied:
+     * the prefixes are cleared first, then the values are put or removed
+     */
+    struct Diff {
+      std::vector<common::Buffer> cleared_prefixes;
+      // none for the removed keys
+      std::map<common::Buffer, boost::optional<common::Buffer>> changes;
+
+      bool empty() const {
+        return cleared_prefixes.empty() and changes.empty();
+      }
+
+      void put(const common::Buffer &key, common::Buffer value);
+
+      void remove(const common::Buffer &key);
+
+      void clearPrefix(const common::Buffer &prefix);
+
+      /**
+       * @return true if the value of \arg key is changed by the diff
+       */
+      bool touches(const common::Buffer &key) const;
+
+      /**
+       * @return true if \arg key is under one of the cleared prefixes
+       */
+      bool clears(const common::Buffer &key) const;
+
+      /**
+       * Applies \arg next, made on top of the state of this diff, to it
+       */
+      void append(Diff next);
+    };
+
+    /**
+     * Max number of the differences kept in the memory, so that it doesn't
+     * grow without bound while the finality stalls. The differences of the
+     * states imported past it are kept in the storage only, these states
+     * are read from the trie, and their differences are loaded to be
+     * applied once they are finalized
+     */
+    static constexpr size_t kMaxDiffsNum = 1024;
+
+    /**
+     * Loads the flat state kept in \arg storage under \arg prefix
+     * @param serializer retrieves the states, which entries are rebuilt
+     */
+    static outcome::result<std::shared_ptr<FlatState>> create(
+        std::shared_ptr<BufferStorage> storage,
+        common::Buffer prefix,
+        std::shared_ptr<TrieSerializer> serializer);
+
+    /**
+     * Interrupts the rebuild of the entries, if any, it is started over
+     * with the next finalization after a restart
+     */
+    ~FlatState();
+
+    /**
+     * @return true if the values of the state with \arg root are read from
+     * the flat state
+     */
+    bool hasState(const common::Buffer &root) const;
+
+    /**
+     * @return value of \arg key in the state with \arg root, none if the
+     * key is absent, UNKNOWN_STATE if there is no such state
+     */
+    outcome::result<boost::optional<common::Buffer>> get(
+        const common::Buffer &root, const common::Buffer &key) const;
+
+    /**
+     * Adds the state with \arg root made by \arg diff on top of the state
+     * with \arg parent, if the latter is known
+     */
+    outcome::result<void> addState(const common::Buffer &parent,
+                                   const common::Buffer &root,
+                                   Diff diff);
+
+    /**
+     * Makes the state with \arg root the one of the entries. If the state
+     * is not derived from the current one, e.g. on the first start with the
+     * flat state, the entries are rebuilt from the trie in the background,
+     * and the states finalized meanwhile are applied once it is done
+     */
+    outcome::result<void> finalize(const common::Buffer &root);
+
+    /**
+     * Waits for the rebuild of the entries, including the finalizations
+     * deferred until it is done, if there is one
+     */
+    void waitForRebuild();
+
+   private:
+    struct StateDiff {
+      common::Buffer parent;
+      // none if the diff is kept in the storage only
+      boost::optional<Diff> diff;
+    };
+
+    FlatState(std::shared_ptr<BufferStorage> storage,
+              common::Buffer prefix,
+              std::shared_ptr<TrieSerializer> serializer);
+
+    outcome::result<void> load();
+
+    /**
+     * Adds the diff of the state with \arg root, it is kept in the memory
+     * unless there are kMaxDiffsNum diffs there. Is called under the mutex
+     */
+    void emplaceDiff(common::Buffer root, common::Buffer parent, Diff diff);
+
+    /**
+     * Erases the diff of the state with \arg root. Is called under the
+     * mutex
+     */
+    void eraseDiff(const common::Buffer &root);
+
+    /**
+     * @return diff of the state with \arg root read from the storage
+     */
+    outcome::result<Diff> loadDiff(const common::Buffer &root) const;
+
+    /**
+     * @return the chain of the states from the one of the entries to
+     * \arg root, excluding the former, none if \arg root is not derived
+     * from it. Is called under the mutex
+     */
+    boost::optional<std::vector<common::Buffer>> chainTo(
+        const common::Buffer &root) const;
+
+    /**
+     * @return true if the state with \arg root is built on top of the one
+     * with \arg ancestor. Is called under the mutex
+     */
+    bool isDescendant(const common::Buffer &root,
+                      const common::Buffer &ancestor) const;
+
+    /**
+     * @return roots of the diffs of the states, which are not built on top
+     * of the one with \arg root, and of itself. Is called under the mutex
+     */
+    std::vector<common::Buffer> diffsNotAbove(
+        const common::Buffer &root) const;
+
+    /**
+     * Applies the diffs up to the state with \arg root to the entries, or
+     * starts the rebuild of them if there is no such chain of the diffs.
+     * Is called under the finalize mutex
+     * @return true if the rebuild is to be run
+     */
+    outcome::result<bool> finalizeLocked(const common::Buffer &root);
+
+    /**
+     * Drops the entries of the current state and the diffs not derived from
+     * the state with \arg root, which becomes the one of the entries
+     */
+    outcome::result<void> startRebuild(const common::Buffer &root);
+
+    /**
+     * Rebuilds the entries of the state with \arg root, then the ones
+     * finalized meanwhile, on the rebuild thread
+     */
+    void rebuildInBackground(common::Buffer root);
+
+    /**
+     * Writes the entries of the state with \arg root in place of the ones
+     * of the current state
+     */
+    outcome::result<void> rebuild(const common::Buffer &root);
+
+    common::Buffer entryKey(const common::Buffer &key) const;
+    common::Buffer diffKey(const common::Buffer &root) const;
+    common::Buffer baseRootKey() const;
+
+    std::shared_ptr<BufferStorage> storage_;
+    const common::Buffer prefix_;
+    std::shared_ptr<TrieSerializer> serializer_;
+
+    // the states are read by the runtime calls, while the import adds them
+    // and the finalization applies them to the entries
+    mutable std::shared_mutex mutex_;
+    // root of the state of the entries, none if there are no entries
+    boost::optional<common::Buffer> base_root_;
+    // the entries are not read while they are rebuilt, but the states
+    // imported meanwhile are added on top of them
+    bool base_ready_ = false;
+    std::map<common::Buffer, StateDiff> diffs_;
+    // number of the diffs kept in the memory
+    size_t loaded_diffs_num_ = 0;
+    // finalizations don't overlap, as each applies the diffs to the storage
+    std::mutex finalize_mutex_;
+    // the ones below are guarded by the finalize mutex
+    std::condition_variable rebuilt_cv_;
+    bool rebuilding_ = false;
+    // the last state finalized while the entries are rebuilt
+    boost::optional<common::Buffer> finalized_meanwhile_;
+    std::thread rebuild_thread_;
+    std::atomic_bool stopped_ = false;
+    common::Logger logger_;
+  };
+
+  /**
+   * Reads of a batch made at a state of the flat state. The keys changed by
+   * the batch are read from its diff, the others from the flat state, and
+   * the diff is added to the flat state when the batch is committed
+   */
+  class FlatStateOverlay {
+   public:
+    FlatStateOverlay(std::shared_ptr<FlatState> flat_state,
+                     common::Buffer root);
+
+    /**
+     * @return value of \arg key in the state of the batch, none if the key
+     * is absent, UNKNOWN_STATE if the state is to be read from the trie
+     */
+    outcome::result<boost::optional<common::Buffer>> get(
+        const common::Buffer &key) const;
+
+    /**
+     * @return values of \arg keys in their order, @see get
+     */
+    outcome::result<std::vector<boost::optional<common::Buffer>>> getMany(
+        gsl::span<const common::Buffer> keys) const;
+
+    void put(const common::Buffer &key, common::Buffer value);
+    void remove(const common::Buffer &key);
+    void clearPrefix(const common::Buffer &prefix);
+
+    /**
+     * Adds the state of the batch with \arg new_root to the flat state, the
+     * next changes are made on top of it
+     */
+    outcome::result<void> commit(const common::Buffer &new_root);
+
+   private:
+    std::shared_ptr<FlatState> flat_state_;
+    common::Buffer root_;
+    // the state is looked up once, as it doesn't appear in the flat state
+    // later, unless the latter is rebuilt
+    bool known_;
+    FlatState::Diff diff_;
+  };
+
+}  // namespace kagome::storage::trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::trie, FlatState::Error);
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_FLAT_STATE_HPP
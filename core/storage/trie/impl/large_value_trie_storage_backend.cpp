@@ -0,0 +1,187 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/large_value_trie_storage_backend.hpp"
+
+#include <algorithm>
+
+#include "scale/scale.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    // the node without a value starts with the marker and the offset
+    constexpr size_t kOffsetSize = sizeof(uint32_t);
+    constexpr size_t kStoredHeaderSize = 1 + kOffsetSize;
+
+    bool isStoredWithoutValue(gsl::span<const uint8_t> stored) {
+      return not stored.empty()
+             and stored[0] == LargeValueTrieStorageBackend::kNodeWithoutValue;
+    }
+  }  // namespace
+
+  /**
+   * Batch, which splits the large values off the nodes put to it
+   */
+  class LargeValueTrieStorageBackend::Batch : public BufferBatch {
+   public:
+    Batch(const LargeValueTrieStorageBackend &backend,
+          std::unique_ptr<BufferBatch> batch)
+        : backend_{backend}, batch_{std::move(batch)} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      return put(key, Buffer{value});
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      // what is not a node with a value is stored as it is
+      auto location = backend_.codec_.locateValue(value);
+      if (not location or not location.value()
+          or location.value()->second < backend_.threshold_) {
+        return batch_->put(key, std::move(value));
+      }
+      auto [offset, size] = location.value().value();
+      OUTCOME_TRY(batch_->put(valueKey(key), value.subbuffer(offset, size)));
+      Buffer stored;
+      stored.reserve(kStoredHeaderSize + value.size() - size);
+      stored.putUint8(kNodeWithoutValue)
+          .putUint32(offset)
+          .put(gsl::make_span(value.data(), offset))
+          .put(gsl::make_span(value.data() + offset + size,
+                              value.size() - offset - size));
+      return batch_->put(key, std::move(stored));
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      // the value is removed along with the node, whether it is there or not
+      OUTCOME_TRY(batch_->remove(valueKey(key)));
+      return batch_->remove(key);
+    }
+
+    outcome::result<void> commit() override {
+      return batch_->commit();
+    }
+
+    void clear() override {
+      batch_->clear();
+    }
+
+   private:
+    const LargeValueTrieStorageBackend &backend_;
+    std::unique_ptr<BufferBatch> batch_;
+  };
+
+  LargeValueTrieStorageBackend::LargeValueTrieStorageBackend(
+      std::shared_ptr<TrieStorageBackend> backend, size_t threshold)
+      // the nodes shorter than a hash are embedded in their parents, so the
+      // values split off are never as short
+      : backend_{std::move(backend)},
+        threshold_{std::max(threshold, common::Hash256::size())} {
+    BOOST_ASSERT(backend_ != nullptr);
+  }
+
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  LargeValueTrieStorageBackend::cursor() {
+    return backend_->cursor();
+  }
+
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  LargeValueTrieStorageBackend::scanCursor(const Buffer &prefix) {
+    return backend_->scanCursor(prefix);
+  }
+
+  std::unique_ptr<face::WriteBatch<Buffer, Buffer>>
+  LargeValueTrieStorageBackend::batch() {
+    return std::make_unique<Batch>(*this, backend_->batch());
+  }
+
+  outcome::result<Buffer> LargeValueTrieStorageBackend::get(
+      const Buffer &key) const {
+    OUTCOME_TRY(node, getPinned(key));
+    return Buffer{node.view()};
+  }
+
+  outcome::result<face::PinnedView<Buffer>>
+  LargeValueTrieStorageBackend::getPinned(const Buffer &key) const {
+    OUTCOME_TRY(node, backend_->getPinned(key));
+    if (not isStoredWithoutValue(node.view())) {
+      return std::move(node);
+    }
+    OUTCOME_TRY(value, backend_->getPinned(valueKey(key)));
+    OUTCOME_TRY(encoding, joinValue(node.view(), value.view()));
+    return face::PinnedView<Buffer>{std::move(encoding)};
+  }
+
+  bool LargeValueTrieStorageBackend::contains(const Buffer &key) const {
+    return backend_->contains(key);
+  }
+
+  bool LargeValueTrieStorageBackend::empty() const {
+    return backend_->empty();
+  }
+
+  outcome::result<std::pair<face::PinnedView<Buffer>, bool>>
+  LargeValueTrieStorageBackend::getNodeWithoutValue(const Buffer &key) const {
+    OUTCOME_TRY(node, backend_->getPinned(key));
+    if (not isStoredWithoutValue(node.view())) {
+      return std::make_pair(std::move(node), false);
+    }
+    // the empty value is encoded by its zero length
+    static const uint8_t kEmptyValue = 0;
+    OUTCOME_TRY(encoding, joinValue(node.view(), {&kEmptyValue, 1}));
+    return std::make_pair(face::PinnedView<Buffer>{std::move(encoding)}, true);
+  }
+
+  outcome::result<Buffer> LargeValueTrieStorageBackend::getNodeValue(
+      const Buffer &key) const {
+    OUTCOME_TRY(value, backend_->getPinned(valueKey(key)));
+    return scale::decode<Buffer>(value.view());
+  }
+
+  outcome::result<void> LargeValueTrieStorageBackend::put(
+      const Buffer &key, const Buffer &value) {
+    return put(key, Buffer{value});
+  }
+
+  outcome::result<void> LargeValueTrieStorageBackend::put(const Buffer &key,
+                                                          Buffer &&value) {
+    auto batch = this->batch();
+    OUTCOME_TRY(batch->put(key, std::move(value)));
+    return batch->commit();
+  }
+
+  outcome::result<void> LargeValueTrieStorageBackend::remove(
+      const Buffer &key) {
+    auto batch = this->batch();
+    OUTCOME_TRY(batch->remove(key));
+    return batch->commit();
+  }
+
+  Buffer LargeValueTrieStorageBackend::valueKey(const Buffer &key) {
+    return Buffer{key}.putUint8(kNodeWithoutValue);
+  }
+
+  outcome::result<Buffer> LargeValueTrieStorageBackend::joinValue(
+      gsl::span<const uint8_t> stored, gsl::span<const uint8_t> value) {
+    if (static_cast<size_t>(stored.size()) < kStoredHeaderSize) {
+      return DatabaseError::CORRUPTION;
+    }
+    size_t offset = 0;
+    for (size_t i = 1; i < kStoredHeaderSize; i++) {
+      offset = (offset << 8u) | stored[i];
+    }
+    auto rest = stored.subspan(kStoredHeaderSize);
+    if (static_cast<size_t>(rest.size()) < offset) {
+      return DatabaseError::CORRUPTION;
+    }
+    Buffer encoding;
+    encoding.reserve(rest.size() + value.size());
+    encoding.put(rest.first(offset))
+        .put(value)
+        .put(rest.subspan(offset));
+    return encoding;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,86 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_LARGE_VALUE_TRIE_STORAGE_BACKEND_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_LARGE_VALUE_TRIE_STORAGE_BACKEND_HPP
+
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Trie storage backend, which keeps the large values of the nodes, e.g.
+   * the runtime code, apart from the nodes in the underlying backend, so
+   * that reading a node by getNodeWithoutValue does not read its value.
+   * The nodes are still read whole by get and getPinned, and their keys,
+   * which are the hashes of their encodings, are not changed, so the trie
+   * and its merkle proofs stay the same. The cursor iterates over the
+   * entries of the underlying backend as they are stored
+   */
+  class LargeValueTrieStorageBackend : public TrieStorageBackend {
+   public:
+    /**
+     * First byte of a node stored without its value, which is never the
+     * first byte of the encoding of a stored node, as it stands for the
+     * special node type. It is followed by the offset of the value in the
+     * encoding and by the encoding without the value
+     */
+    static constexpr uint8_t kNodeWithoutValue = 0;
+
+    /**
+     * @param threshold min size of the values kept apart from their nodes,
+     * it is not less than the size of a hash
+     */
+    LargeValueTrieStorageBackend(std::shared_ptr<TrieStorageBackend> backend,
+                                 size_t threshold);
+
+    ~LargeValueTrieStorageBackend() override = default;
+
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> cursor() override;
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> scanCursor(
+        const Buffer &prefix) override;
+    std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+    bool contains(const Buffer &key) const override;
+    bool empty() const override;
+
+    outcome::result<std::pair<face::PinnedView<Buffer>, bool>>
+    getNodeWithoutValue(const Buffer &key) const override;
+    outcome::result<Buffer> getNodeValue(const Buffer &key) const override;
+
+    // a node and its value are written at once, as with a batch
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+    outcome::result<void> remove(const Buffer &key) override;
+
+    /**
+     * @return key of the value of the node stored by \arg key, which is kept
+     * apart from the node, it is longer than the keys of the nodes
+     */
+    static Buffer valueKey(const Buffer &key);
+
+   private:
+    class Batch;
+
+    /**
+     * Puts SCALE-encoded \arg value to the place of the value of \arg stored
+     * node without a value
+     * @return the encoding of the node
+     */
+    static outcome::result<Buffer> joinValue(
+        gsl::span<const uint8_t> stored, gsl::span<const uint8_t> value);
+
+    std::shared_ptr<TrieStorageBackend> backend_;
+    size_t threshold_;
+    PolkadotCodec codec_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_LARGE_VALUE_TRIE_STORAGE_BACKEND_HPP
@@ -23,7 +23,9 @@ namespace kagome::storage::trie {
       std::shared_ptr<TrieSerializer> serializer,
       boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
       std::unique_ptr<PolkadotTrie> trie,
-      RootChangedEventHandler handler)
+      RootChangedEventHandler handler,
+      std::shared_ptr<FlatState> flat_state,
+      const common::Buffer &root)
       : codec_{std::move(codec)},
         serializer_{std::move(serializer)},
         changes_{std::move(changes)},
@@ -34,6 +36,9 @@ namespace kagome::storage::trie {
     BOOST_ASSERT((changes_.has_value() && changes_.value() != nullptr)
                  or not changes_.has_value());
     BOOST_ASSERT(trie_ != nullptr);
+    if (flat_state != nullptr) {
+      flat_overlay_.emplace(std::move(flat_state), root);
+    }
     if (changes_) {
       changes_.value()->setExtrinsicIdxGetter(
           [this]() -> outcome::result<Buffer> {
@@ -48,24 +53,59 @@ namespace kagome::storage::trie {
 
   outcome::result<Buffer> PersistentTrieBatchImpl::commit() {
     OUTCOME_TRY(root, serializer_->storeTrie(*trie_));
+    if (flat_overlay_) {
+      OUTCOME_TRY(flat_overlay_->commit(root));
+    }
     root_changed_handler_(root);
     return std::move(root);
   }
 
+  outcome::result<Buffer> PersistentTrieBatchImpl::calculateRoot() const {
+    return serializer_->calculateRoot(*trie_);
+  }
+
   std::unique_ptr<TopperTrieBatch> PersistentTrieBatchImpl::batchOnTop() {
     return std::make_unique<TopperTrieBatchImpl>(shared_from_this());
   }
 
   outcome::result<Buffer> PersistentTrieBatchImpl::get(
       const Buffer &key) const {
+    if (flat_overlay_) {
+      auto value = flat_overlay_->get(key);
+      if (value) {
+        if (not value.value()) {
+          return TrieError::NO_VALUE;
+        }
+        return std::move(value.value().value());
+      }
+      if (value.error() != FlatState::Error::UNKNOWN_STATE) {
+        return value.error();
+      }
+    }
     return trie_->get(key);
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  PersistentTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    if (flat_overlay_) {
+      auto values = flat_overlay_->getMany(keys);
+      if (values or values.error() != FlatState::Error::UNKNOWN_STATE) {
+        return values;
+      }
+    }
+    return trie_->getMany(keys);
+  }
+
   std::unique_ptr<BufferMapCursor> PersistentTrieBatchImpl::cursor() {
     return std::make_unique<PolkadotTrieCursor>(*trie_);
   }
 
   bool PersistentTrieBatchImpl::contains(const Buffer &key) const {
+    if (flat_overlay_) {
+      if (auto value = flat_overlay_->get(key); value) {
+        return value.value().has_value();
+      }
+    }
     return trie_->contains(key);
   }
 
@@ -76,7 +116,18 @@ namespace kagome::storage::trie {
   outcome::result<void> PersistentTrieBatchImpl::clearPrefix(
       const Buffer &prefix) {
     // TODO(Harrm): notify changes tracker
-    return trie_->clearPrefix(prefix);
+    OUTCOME_TRY(trie_->clearPrefix(prefix));
+    if (flat_overlay_) {
+      flat_overlay_->clearPrefix(prefix);
+    }
+    return outcome::success();
+  }
+
+  outcome::result<ClearPrefixResult> PersistentTrieBatchImpl::clearPrefix(
+      const Buffer &prefix, uint32_t limit) {
+    // the flat overlay and the changes tracker are updated by the removal of
+    // each entry
+    return clearPrefixLimited(*this, prefix, limit);
   }
 
   outcome::result<void> PersistentTrieBatchImpl::put(const Buffer &key,
@@ -87,6 +138,9 @@ namespace kagome::storage::trie {
   outcome::result<void> PersistentTrieBatchImpl::put(const Buffer &key,
                                                      Buffer &&value) {
     bool is_new_entry = not trie_->contains(key);
+    if (flat_overlay_) {
+      flat_overlay_->put(key, value);
+    }
     auto res = trie_->put(key, std::move(value));
     if (res and changes_.has_value()) {
       OUTCOME_TRY(changes_.value()->onPut(key, is_new_entry));
@@ -96,6 +150,9 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PersistentTrieBatchImpl::remove(const Buffer &key) {
     auto res = trie_->remove(key);
+    if (res and flat_overlay_) {
+      flat_overlay_->remove(key);
+    }
     if (res and changes_.has_value()) {
       OUTCOME_TRY(changes_.value()->onRemove(key));
     }
@@ -8,6 +8,7 @@
 
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
 #include "storage/trie/trie_batches.hpp"
 
@@ -17,22 +18,34 @@ namespace kagome::storage::trie {
    public:
     using RootChangedEventHandler = std::function<void(const common::Buffer &)>;
 
+    /**
+     * @param flat_state if set, the values are read from it instead of the
+     * trie while it has the state of the batch with \arg root, and the
+     * committed states are added to it
+     */
     PersistentTrieBatchImpl(
         std::shared_ptr<Codec> codec,
         std::shared_ptr<TrieSerializer> serializer,
         boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes,
         std::unique_ptr<PolkadotTrie> trie,
-        RootChangedEventHandler handler);
+        RootChangedEventHandler handler,
+        std::shared_ptr<FlatState> flat_state = nullptr,
+        const common::Buffer &root = {});
     ~PersistentTrieBatchImpl() override = default;
 
     outcome::result<Buffer> commit() override;
+    outcome::result<Buffer> calculateRoot() const override;
     std::unique_ptr<TopperTrieBatch> batchOnTop() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
     std::unique_ptr<BufferMapCursor> cursor() override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
     outcome::result<void> clearPrefix(const Buffer &prefix) override;
+    outcome::result<ClearPrefixResult> clearPrefix(const Buffer &prefix,
+                                                   uint32_t limit) override;
     outcome::result<void> put(const Buffer &key, const Buffer &value) override;
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
@@ -43,6 +56,7 @@ namespace kagome::storage::trie {
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
     std::unique_ptr<PolkadotTrie> trie_;
     RootChangedEventHandler root_changed_handler_;
+    boost::optional<FlatStateOverlay> flat_overlay_;
   };
 
 }  // namespace kagome::storage::trie
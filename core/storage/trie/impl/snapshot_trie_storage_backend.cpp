@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/snapshot_trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  SnapshotTrieStorageBackend::SnapshotTrieStorageBackend(
+      std::shared_ptr<const StateSnapshotFile> file,
+      std::shared_ptr<TrieStorageBackend> backend)
+      : file_{std::move(file)}, backend_{std::move(backend)} {
+    BOOST_ASSERT(file_ != nullptr);
+    BOOST_ASSERT(backend_ != nullptr);
+  }
+
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  SnapshotTrieStorageBackend::cursor() {
+    // the nodes of the snapshot are looked up by their keys only
+    return backend_->cursor();
+  }
+
+  std::unique_ptr<face::WriteBatch<Buffer, Buffer>>
+  SnapshotTrieStorageBackend::batch() {
+    return backend_->batch();
+  }
+
+  outcome::result<Buffer> SnapshotTrieStorageBackend::get(
+      const Buffer &key) const {
+    if (auto encoding = file_->find(key); encoding) {
+      return Buffer{encoding.value()};
+    }
+    return backend_->get(key);
+  }
+
+  outcome::result<face::PinnedView<Buffer>>
+  SnapshotTrieStorageBackend::getPinned(const Buffer &key) const {
+    if (auto encoding = file_->find(key); encoding) {
+      return face::PinnedView<Buffer>{encoding.value(), file_};
+    }
+    return backend_->getPinned(key);
+  }
+
+  outcome::result<std::pair<face::PinnedView<Buffer>, bool>>
+  SnapshotTrieStorageBackend::getNodeWithoutValue(const Buffer &key) const {
+    // the nodes of the snapshot are kept whole
+    if (auto encoding = file_->find(key); encoding) {
+      return std::make_pair(face::PinnedView<Buffer>{encoding.value(), file_},
+                            false);
+    }
+    return backend_->getNodeWithoutValue(key);
+  }
+
+  outcome::result<Buffer> SnapshotTrieStorageBackend::getNodeValue(
+      const Buffer &key) const {
+    return backend_->getNodeValue(key);
+  }
+
+  bool SnapshotTrieStorageBackend::contains(const Buffer &key) const {
+    return file_->find(key).has_value() or backend_->contains(key);
+  }
+
+  bool SnapshotTrieStorageBackend::empty() const {
+    return file_->size() == 0 and backend_->empty();
+  }
+
+  outcome::result<void> SnapshotTrieStorageBackend::put(const Buffer &key,
+                                                        const Buffer &value) {
+    return backend_->put(key, value);
+  }
+
+  outcome::result<void> SnapshotTrieStorageBackend::put(const Buffer &key,
+                                                        Buffer &&value) {
+    return backend_->put(key, std::move(value));
+  }
+
+  outcome::result<void> SnapshotTrieStorageBackend::remove(const Buffer &key) {
+    return backend_->remove(key);
+  }
+
+}  // namespace kagome::storage::trie
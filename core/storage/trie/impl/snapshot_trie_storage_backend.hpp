@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_SNAPSHOT_TRIE_STORAGE_BACKEND_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_SNAPSHOT_TRIE_STORAGE_BACKEND_HPP
+
+#include "storage/trie/trie_storage_backend.hpp"
+
+#include "storage/trie/impl/state_snapshot_file.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Trie storage backend, which reads the nodes from a state snapshot file
+   * first and from the underlying backend after that. The nodes written
+   * after the snapshot, e.g. by the blocks imported on top of it, go to the
+   * underlying backend, while the nodes of the snapshot are never removed
+   */
+  class SnapshotTrieStorageBackend : public TrieStorageBackend {
+   public:
+    SnapshotTrieStorageBackend(std::shared_ptr<const StateSnapshotFile> file,
+                               std::shared_ptr<TrieStorageBackend> backend);
+
+    ~SnapshotTrieStorageBackend() override = default;
+
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> cursor() override;
+    std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+    // the view refers to the mapped file, which is kept open along with it
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
+    bool contains(const Buffer &key) const override;
+    bool empty() const override;
+
+    outcome::result<std::pair<face::PinnedView<Buffer>, bool>>
+    getNodeWithoutValue(const Buffer &key) const override;
+    outcome::result<Buffer> getNodeValue(const Buffer &key) const override;
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override;
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override;
+    outcome::result<void> remove(const Buffer &key) override;
+
+   private:
+    std::shared_ptr<const StateSnapshotFile> file_;
+    std::shared_ptr<TrieStorageBackend> backend_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_SNAPSHOT_TRIE_STORAGE_BACKEND_HPP
@@ -0,0 +1,133 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_prefetcher.hpp"
+
+#include <set>
+
+#include <boost/asio/post.hpp>
+
+#include "crypto/blake2/blake2b.h"
+
+namespace kagome::storage::trie {
+
+  StatePrefetcher::StatePrefetcher(std::shared_ptr<TrieSerializer> serializer,
+                                   size_t threads_num)
+      : serializer_{std::move(serializer)}, pool_{threads_num} {
+    BOOST_ASSERT(serializer_ != nullptr);
+    BOOST_ASSERT(threads_num > 0);
+  }
+
+  StatePrefetcher::~StatePrefetcher() {
+    pool_.stop();
+    pool_.join();
+  }
+
+  void StatePrefetcher::recordExtrinsic(const primitives::Extrinsic &extrinsic,
+                                        std::vector<common::Buffer> keys) {
+    auto hash = hashOf(extrinsic);
+    std::lock_guard lock{mutex_};
+    if (auto it = extrinsic_keys_.find(hash); it != extrinsic_keys_.end()) {
+      extrinsics_order_.erase(it->second.second);
+      extrinsic_keys_.erase(it);
+    }
+    if (extrinsic_keys_.size() >= kMaxExtrinsics) {
+      extrinsic_keys_.erase(extrinsics_order_.front());
+      extrinsics_order_.pop_front();
+    }
+    extrinsics_order_.push_back(hash);
+    extrinsic_keys_.emplace(
+        hash,
+        std::make_pair(std::move(keys), std::prev(extrinsics_order_.end())));
+  }
+
+  void StatePrefetcher::recordBlock(std::vector<common::Buffer> keys) {
+    std::lock_guard lock{mutex_};
+    block_keys_ = std::move(keys);
+  }
+
+  size_t StatePrefetcher::prefetch(
+      const common::Hash256 &state_root,
+      const std::vector<primitives::Extrinsic> &extrinsics) {
+    // sorted, so that the keys of a task share the most of their paths
+    std::set<common::Buffer> keys;
+    {
+      std::lock_guard lock{mutex_};
+      keys.insert(block_keys_.begin(), block_keys_.end());
+      for (auto &extrinsic : extrinsics) {
+        if (auto it = extrinsic_keys_.find(hashOf(extrinsic));
+            it != extrinsic_keys_.end()) {
+          keys.insert(it->second.first.begin(), it->second.first.end());
+        }
+      }
+    }
+    std::vector<std::vector<common::Buffer>> tasks;
+    for (auto &key : keys) {
+      if (tasks.empty() or tasks.back().size() == kKeysPerTask) {
+        tasks.emplace_back().reserve(kKeysPerTask);
+      }
+      tasks.back().push_back(key);
+    }
+    {
+      std::lock_guard lock{mutex_};
+      pending_tasks_ += tasks.size();
+    }
+    for (auto &task_keys : tasks) {
+      boost::asio::post(pool_,
+                        [this, state_root, task_keys{std::move(task_keys)}] {
+                          lookUp(state_root, task_keys);
+                          onTaskDone();
+                        });
+    }
+    logger_->debug("{} keys of {} extrinsics are prefetched from state {}",
+                   keys.size(),
+                   extrinsics.size(),
+                   state_root.toHex());
+    return keys.size();
+  }
+
+  void StatePrefetcher::waitIdle() {
+    std::unique_lock lock{mutex_};
+    idle_.wait(lock, [this] { return pending_tasks_ == 0; });
+  }
+
+  common::Hash256 StatePrefetcher::hashOf(
+      const primitives::Extrinsic &extrinsic) {
+    common::Hash256 hash;
+    blake2b(hash.data(),
+            common::Hash256::size(),
+            nullptr,
+            0,
+            extrinsic.data.data(),
+            extrinsic.data.size());
+    return hash;
+  }
+
+  void StatePrefetcher::lookUp(const common::Hash256 &state_root,
+                               const std::vector<common::Buffer> &keys) const {
+    // the nodes on the paths of the keys are left in the cache by the
+    // lookups, the values themselves are not needed
+    auto trie = serializer_->retrieveImmutableTrie(common::Buffer{state_root});
+    if (not trie) {
+      logger_->debug("State {} is not prefetched: {}",
+                     state_root.toHex(),
+                     trie.error().message());
+      return;
+    }
+    if (auto res = trie.value()->getMany(keys); not res) {
+      logger_->debug("Keys of state {} are not prefetched: {}",
+                     state_root.toHex(),
+                     res.error().message());
+    }
+  }
+
+  void StatePrefetcher::onTaskDone() {
+    std::lock_guard lock{mutex_};
+    if (--pending_tasks_ == 0) {
+      idle_.notify_all();
+    }
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,107 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_STATE_PREFETCHER_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_STATE_PREFETCHER_HPP
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "common/logger.hpp"
+#include "primitives/extrinsic.hpp"
+#include "storage/trie/serialization/trie_serializer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Warms the node cache up for the execution of a block. The keys of the
+   * state accessed by an extrinsic when it was validated, as well as the
+   * keys accessed by the previous block, which mostly repeat from block to
+   * block, are looked up in the state of the parent block on the threads of
+   * its own while the block is executed, so that the execution finds the
+   * nodes on their paths decoded in the cache rather than reads them from
+   * the disk
+   */
+  class StatePrefetcher {
+   public:
+    /// max number of the extrinsics the accessed keys are kept for
+    static constexpr size_t kMaxExtrinsics = 8192;
+
+    /// max number of the keys looked up by a single task
+    static constexpr size_t kKeysPerTask = 256;
+
+    /**
+     * @param serializer retrieves the nodes of the states, caching them
+     * @param threads_num number of the threads the keys are looked up on
+     */
+    StatePrefetcher(std::shared_ptr<TrieSerializer> serializer,
+                    size_t threads_num);
+
+    ~StatePrefetcher();
+
+    /**
+     * Remembers \arg keys as the ones \arg extrinsic accesses, replacing the
+     * ones recorded for it before
+     */
+    void recordExtrinsic(const primitives::Extrinsic &extrinsic,
+                         std::vector<common::Buffer> keys);
+
+    /**
+     * Remembers \arg keys as the ones accessed by the last executed block
+     */
+    void recordBlock(std::vector<common::Buffer> keys);
+
+    /**
+     * Schedules the lookups of the keys the block with \arg extrinsics is
+     * expected to access in the state with \arg state_root, the parent one
+     * @return number of the keys scheduled
+     */
+    size_t prefetch(const common::Hash256 &state_root,
+                    const std::vector<primitives::Extrinsic> &extrinsics);
+
+    /**
+     * Waits for the scheduled lookups to be done
+     */
+    void waitIdle();
+
+   private:
+    static common::Hash256 hashOf(const primitives::Extrinsic &extrinsic);
+
+    void lookUp(const common::Hash256 &state_root,
+                const std::vector<common::Buffer> &keys) const;
+
+    void onTaskDone();
+
+    std::shared_ptr<TrieSerializer> serializer_;
+
+    std::mutex mutex_;
+    // keys by the hashes of the extrinsics, the least recently recorded
+    // ones are dropped first
+    std::list<common::Hash256> extrinsics_order_;
+    std::unordered_map<
+        common::Hash256,
+        std::pair<std::vector<common::Buffer>,
+                  std::list<common::Hash256>::iterator>>
+        extrinsic_keys_;
+    std::vector<common::Buffer> block_keys_;
+
+    std::condition_variable idle_;
+    size_t pending_tasks_ = 0;
+
+    common::Logger logger_ = common::createLogger("StatePrefetcher");
+
+    boost::asio::thread_pool pool_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_STATE_PREFETCHER_HPP
@@ -0,0 +1,241 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_snapshot_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+#include <boost/endian/arithmetic.hpp>
+
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, StateSnapshotError, e) {
+  using E = kagome::storage::trie::StateSnapshotError;
+  switch (e) {
+    case E::CANNOT_OPEN_FILE:
+      return "Cannot open the state snapshot file";
+    case E::CANNOT_WRITE_FILE:
+      return "Cannot write the state snapshot file";
+    case E::INVALID_FORMAT:
+      return "The state snapshot file is malformed";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::storage::trie {
+
+  namespace {
+    using boost::endian::little_uint32_buf_t;
+    using boost::endian::little_uint64_buf_t;
+
+    constexpr std::array<char, 8> kMagic{
+        'k', 'g', 'm', 's', 't', 'a', 't', '1'};
+
+    bool less(gsl::span<const uint8_t> lhs, gsl::span<const uint8_t> rhs) {
+      return std::lexicographical_compare(
+          lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+  }  // namespace
+
+  // fields are unaligned little endian integers, so the structures are
+  // read right from the mapped file on any platform
+  struct StateSnapshotFile::Header {
+    std::array<char, 8> magic;
+    std::array<uint8_t, common::Hash256::size()> root;
+    little_uint64_buf_t nodes_num;
+    // the nodes follow the header, and the index follows the nodes
+    little_uint64_buf_t index_offset;
+  };
+
+  struct StateSnapshotFile::IndexEntry {
+    // a key is the merkle value of a node, which is its hash or, for the
+    // nodes shorter than a hash, the encoding itself padded with zeros
+    std::array<uint8_t, common::Hash256::size()> key;
+    uint8_t key_size;
+    // offset of the encoding from the start of the file
+    little_uint64_buf_t offset;
+    little_uint32_buf_t size;
+  };
+
+  gsl::span<const uint8_t> StateSnapshotFile::keyOf(const IndexEntry &entry) {
+    return gsl::make_span(entry.key.data(),
+                          std::min<size_t>(entry.key_size, entry.key.size()));
+  }
+
+  StateSnapshotFile::StateSnapshotFile(const uint8_t *data, size_t size)
+      : data_{data}, size_{size}, index_{nullptr}, nodes_num_{0} {}
+
+  StateSnapshotFile::~StateSnapshotFile() {
+    if (data_ != nullptr) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      munmap(const_cast<uint8_t *>(data_), size_);
+    }
+  }
+
+  outcome::result<std::shared_ptr<StateSnapshotFile>> StateSnapshotFile::open(
+      const std::string &path) {
+    static_assert(sizeof(Header) == 56);
+    static_assert(sizeof(IndexEntry) == 45);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return StateSnapshotError::CANNOT_OPEN_FILE;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      return StateSnapshotError::CANNOT_OPEN_FILE;
+    }
+    auto size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(Header)) {
+      close(fd);
+      return StateSnapshotError::INVALID_FORMAT;
+    }
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping keeps the file open by itself
+    close(fd);
+    if (mapped == MAP_FAILED) {
+      return StateSnapshotError::CANNOT_OPEN_FILE;
+    }
+    // the index is searched randomly, while the nodes of a state are read
+    // in no particular order either
+    madvise(mapped, size, MADV_RANDOM);
+
+    // constructor is private
+    std::shared_ptr<StateSnapshotFile> file{
+        new StateSnapshotFile{static_cast<const uint8_t *>(mapped), size}};
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto &header = *reinterpret_cast<const Header *>(file->data_);
+    uint64_t nodes_num = header.nodes_num.value();
+    uint64_t index_offset = header.index_offset.value();
+    if (header.magic != kMagic or index_offset < sizeof(Header)
+        or index_offset > size
+        or (size - index_offset) / sizeof(IndexEntry) != nodes_num
+        or (size - index_offset) % sizeof(IndexEntry) != 0) {
+      return StateSnapshotError::INVALID_FORMAT;
+    }
+    std::copy(header.root.begin(), header.root.end(), file->root_.begin());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file->index_ = reinterpret_cast<const IndexEntry *>(
+        file->data_ + index_offset);
+    file->nodes_num_ = nodes_num;
+    return file;
+  }
+
+  outcome::result<void> StateSnapshotFile::exportState(
+      const std::string &path,
+      const common::Hash256 &root,
+      const TrieStorageBackend &nodes,
+      const Codec &codec) {
+    auto tmp_path = path + ".tmp";
+    std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+    if (not out) {
+      return StateSnapshotError::CANNOT_OPEN_FILE;
+    }
+    auto write = [&out](const void *data, size_t size) {
+      out.write(static_cast<const char *>(data),
+                static_cast<std::streamsize>(size));
+    };
+    Header header{};
+    write(&header, sizeof(header));
+
+    // the nodes are written while the state is traversed, and only the
+    // index is kept in memory, which is a few dozen bytes per node
+    std::vector<IndexEntry> index;
+    std::unordered_set<common::Buffer> visited;
+    std::vector<common::Buffer> pending{common::Buffer{root}};
+    uint64_t offset = sizeof(Header);
+    while (not pending.empty()) {
+      auto key = std::move(pending.back());
+      pending.pop_back();
+      if (not visited.insert(key).second) {
+        continue;
+      }
+      OUTCOME_TRY(encoding, nodes.getPinned(key));
+      auto view = encoding.view();
+      if (key.size() > common::Hash256::size()) {
+        return StateSnapshotError::INVALID_FORMAT;
+      }
+      IndexEntry &entry = index.emplace_back();
+      std::copy(key.begin(), key.end(), entry.key.begin());
+      entry.key_size = static_cast<uint8_t>(key.size());
+      entry.offset = offset;
+      entry.size = static_cast<uint32_t>(view.size());
+      write(view.data(), view.size());
+      offset += view.size();
+
+      OUTCOME_TRY(node, codec.decodeNode(view));
+      auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+      if (branch == nullptr) {
+        continue;
+      }
+      // stored children of a decoded branch are dummy nodes keeping their
+      // merkle values, which are the storage keys of the children, the short
+      // ones are embedded in the branch
+      for (auto &child : branch->children) {
+        if (child->isDummy()) {
+          pending.push_back(static_cast<const DummyNode &>(*child).db_key);
+        }
+      }
+    }
+
+    std::sort(index.begin(), index.end(), [](auto &lhs, auto &rhs) {
+      return less(keyOf(lhs), keyOf(rhs));
+    });
+    write(index.data(), index.size() * sizeof(IndexEntry));
+
+    header.magic = kMagic;
+    std::copy(root.begin(), root.end(), header.root.begin());
+    header.nodes_num = index.size();
+    header.index_offset = offset;
+    out.seekp(0);
+    write(&header, sizeof(header));
+    out.close();
+    if (not out or std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+      return StateSnapshotError::CANNOT_WRITE_FILE;
+    }
+    return outcome::success();
+  }
+
+  const common::Hash256 &StateSnapshotFile::getRootHash() const {
+    return root_;
+  }
+
+  size_t StateSnapshotFile::size() const {
+    return nodes_num_;
+  }
+
+  boost::optional<gsl::span<const uint8_t>> StateSnapshotFile::find(
+      gsl::span<const uint8_t> key) const {
+    if (key.empty() or key.size() > common::Hash256::size()) {
+      return boost::none;
+    }
+    auto end = index_ + nodes_num_;
+    auto it = std::lower_bound(
+        index_, end, key, [](const IndexEntry &entry, const auto &key) {
+          return less(keyOf(entry), key);
+        });
+    if (it == end or less(key, keyOf(*it))) {
+      return boost::none;
+    }
+    uint64_t offset = it->offset.value();
+    uint64_t size = it->size.value();
+    if (offset < sizeof(Header) or offset + size > size_) {
+      return boost::none;
+    }
+    return gsl::make_span(data_ + offset, size);
+  }
+
+}  // namespace kagome::storage::trie
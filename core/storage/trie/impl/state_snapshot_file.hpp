@@ -0,0 +1,97 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_STATE_SNAPSHOT_FILE_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_STATE_SNAPSHOT_FILE_HPP
+
+#include <string>
+
+#include <boost/optional.hpp>
+#include <gsl/span>
+
+#include "common/blob.hpp"
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  enum class StateSnapshotError {
+    CANNOT_OPEN_FILE = 1,
+    CANNOT_WRITE_FILE,
+    INVALID_FORMAT
+  };
+
+  /**
+   * Read-only file with all the trie nodes of a state, which is mapped into
+   * the memory, so that a fresh node reads the state right away instead of
+   * importing it to the database first.
+   * The file starts with a header keeping the root hash, which is followed
+   * by the encodings of the nodes and by an index of them sorted by their
+   * storage keys, so a node is found with a binary search over the index and
+   * is read by the system only when it is accessed
+   */
+  class StateSnapshotFile {
+   public:
+    ~StateSnapshotFile();
+
+    StateSnapshotFile(const StateSnapshotFile &) = delete;
+    StateSnapshotFile &operator=(const StateSnapshotFile &) = delete;
+
+    /**
+     * Maps the snapshot at \arg path into the memory
+     */
+    static outcome::result<std::shared_ptr<StateSnapshotFile>> open(
+        const std::string &path);
+
+    /**
+     * Writes a snapshot of the state with \arg root to \arg path. The file
+     * is replaced only when the whole snapshot is written
+     * @param nodes storage of the nodes of the state
+     * @param codec codec of the nodes, used to find their children
+     */
+    static outcome::result<void> exportState(const std::string &path,
+                                             const common::Hash256 &root,
+                                             const TrieStorageBackend &nodes,
+                                             const Codec &codec);
+
+    /**
+     * @return storage key of the root node of the state
+     */
+    const common::Hash256 &getRootHash() const;
+
+    /**
+     * @return number of the nodes in the snapshot
+     */
+    size_t size() const;
+
+    /**
+     * @return encoding of the node with storage key \arg key, which stays
+     * valid while the file is open, none if there is no such node
+     */
+    boost::optional<gsl::span<const uint8_t>> find(
+        gsl::span<const uint8_t> key) const;
+
+   private:
+    struct Header;
+    struct IndexEntry;
+
+    StateSnapshotFile(const uint8_t *data, size_t size);
+
+    static gsl::span<const uint8_t> keyOf(const IndexEntry &entry);
+
+    const uint8_t *data_;
+    size_t size_;
+    common::Hash256 root_;
+    const IndexEntry *index_;
+    size_t nodes_num_;
+  };
+
+}  // namespace kagome::storage::trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::trie, StateSnapshotError);
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_STATE_SNAPSHOT_FILE_HPP
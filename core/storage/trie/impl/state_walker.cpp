@@ -0,0 +1,135 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_walker.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace kagome::storage::trie {
+
+  namespace {
+    bool isBranch(const PolkadotNode &node) {
+      auto type = node.getTrieType();
+      return type == PolkadotNode::Type::BranchEmptyValue
+             or type == PolkadotNode::Type::BranchWithValue;
+    }
+  }  // namespace
+
+  StateWalker::StateWalker(std::shared_ptr<TrieSerializer> serializer,
+                           std::shared_ptr<common::WorkerPool> workers)
+      : serializer_{std::move(serializer)},
+        workers_{std::move(workers)},
+        workers_num_{workers_ != nullptr ? workers_->threadsNum() + 1 : 1} {
+    BOOST_ASSERT(serializer_ != nullptr);
+  }
+
+  size_t StateWalker::workersNum() const {
+    return workers_num_;
+  }
+
+  outcome::result<void> StateWalker::walk(const common::Buffer &state_root,
+                                          const Visitor &visitor) const {
+    OUTCOME_TRY(trie, serializer_->retrieveImmutableTrie(state_root));
+    auto root = trie->getRoot();
+    if (root == nullptr) {
+      return outcome::success();
+    }
+
+    // the top branches are visited at once and replaced by their children,
+    // level by level, until there are enough subtrees for the workers
+    std::vector<Subtree> subtrees{{root, {}}};
+    auto enough = workers_num_ * kSubtreesPerWorker;
+    for (size_t depth = 0;
+         depth < kMaxSplitDepth and subtrees.size() < enough;
+         ++depth) {
+      std::vector<Subtree> next;
+      for (auto &subtree : subtrees) {
+        if (not isBranch(*subtree.node)) {
+          next.emplace_back(std::move(subtree));
+          continue;
+        }
+        auto key = keyOf(subtree);
+        OUTCOME_TRY(visitor(0, key, *subtree.node));
+        auto branch = std::static_pointer_cast<BranchNode>(subtree.node);
+        for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+          OUTCOME_TRY(child, trie->retrieveChild(branch, idx));
+          if (child != nullptr) {
+            KeyNibbles prefix{key};
+            prefix.putUint8(idx);
+            next.push_back({std::move(child), std::move(prefix)});
+          }
+        }
+      }
+      subtrees = std::move(next);
+    }
+
+    // the workers take the subtrees one by one, so the ones done with the
+    // small subtrees take the rest
+    std::atomic_size_t next_subtree{0};
+    std::atomic_bool failed{false};
+    std::mutex error_mutex;
+    outcome::result<void> result = outcome::success();
+    auto work = [&](size_t worker) {
+      size_t i = 0;
+      while (not failed and (i = next_subtree++) < subtrees.size()) {
+        auto res = walkSubtree(*trie, std::move(subtrees[i]), worker, visitor);
+        if (not res) {
+          std::lock_guard lock{error_mutex};
+          if (not failed) {
+            result = res.error();
+            failed = true;
+          }
+        }
+      }
+    };
+    auto workers_num = std::min(workers_num_, subtrees.size());
+    if (workers_ != nullptr) {
+      // one worker per thread, as long as the walk is not called on the
+      // pool, otherwise the first one takes all the subtrees
+      workers_->parallelFor(workers_num, work);
+    } else {
+      work(0);
+    }
+    return result;
+  }
+
+  KeyNibbles StateWalker::keyOf(const Subtree &subtree) {
+    KeyNibbles key{subtree.prefix};
+    key.putBuffer(subtree.node->key_nibbles);
+    return key;
+  }
+
+  outcome::result<void> StateWalker::walkSubtree(const PolkadotTrie &trie,
+                                                 Subtree subtree,
+                                                 size_t worker,
+                                                 const Visitor &visitor) {
+    // the children are pushed in the reverse order, so they are popped in
+    // the order of their keys
+    std::vector<Subtree> stack;
+    stack.emplace_back(std::move(subtree));
+    while (not stack.empty()) {
+      auto current = std::move(stack.back());
+      stack.pop_back();
+      auto key = keyOf(current);
+      OUTCOME_TRY(visitor(worker, key, *current.node));
+      if (not isBranch(*current.node)) {
+        continue;
+      }
+      auto branch = std::static_pointer_cast<BranchNode>(current.node);
+      for (int idx = BranchNode::kMaxChildren - 1; idx >= 0; --idx) {
+        OUTCOME_TRY(child,
+                    trie.retrieveChild(branch, static_cast<uint8_t>(idx)));
+        if (child != nullptr) {
+          KeyNibbles prefix{key};
+          prefix.putUint8(static_cast<uint8_t>(idx));
+          stack.push_back({std::move(child), std::move(prefix)});
+        }
+      }
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::storage::trie
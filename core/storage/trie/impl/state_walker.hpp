@@ -0,0 +1,90 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_STATE_WALKER_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_STATE_WALKER_HPP
+
+#include <functional>
+
+#include "common/worker_pool.hpp"
+#include "storage/trie/serialization/trie_serializer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Walks all the nodes of a state on the workers at once, e.g. to check
+   * the hashes of the nodes, to export the state or to count its size. The
+   * state is split into the subtrees of the branches at its top levels,
+   * which are walked by the workers through a trie, which does not attach
+   * the nodes it loads to their parents, so the workers share the trie and
+   * each of them keeps only the nodes of the subtree it walks
+   */
+  class StateWalker {
+   public:
+    /// min number of the subtrees per worker the state is split into, so
+    /// that the workers stay busy when the subtrees differ in size
+    static constexpr size_t kSubtreesPerWorker = 4;
+
+    /// max depth of the branches the state is split at
+    static constexpr size_t kMaxSplitDepth = 4;
+
+    /**
+     * Called for a node with the index of the worker visiting it and with
+     * the nibbles of the full key of the node
+     */
+    using Visitor = std::function<outcome::result<void>(
+        size_t worker, const KeyNibbles &key, const PolkadotNode &node)>;
+
+    /**
+     * @param serializer retrieves the nodes of the states
+     * @param workers the state is walked on the threads of, along with the
+     * calling one; it is walked on the calling thread only, if there are none
+     */
+    explicit StateWalker(std::shared_ptr<TrieSerializer> serializer,
+                         std::shared_ptr<common::WorkerPool> workers = nullptr);
+
+    /**
+     * @return number of the workers, the indices passed to the visitors are
+     * less than it; the threads of the pool are reused between the walks, so
+     * the visitors may keep their scratch buffers thread-local
+     */
+    size_t workersNum() const;
+
+    /**
+     * Visits every node of the state with \arg state_root by \arg visitor,
+     * which is called by the workers concurrently. The nodes of a subtree
+     * are visited by a single worker, the parents before their children and
+     * in the order of the keys, while the top branches are visited by the
+     * worker 0 before the workers start. The walk stops at the first error
+     * of the visitor or of the storage
+     */
+    outcome::result<void> walk(const common::Buffer &state_root,
+                               const Visitor &visitor) const;
+
+   private:
+    struct Subtree {
+      PolkadotTrie::NodePtr node;
+      // nibbles of the key of the node up to its own ones
+      KeyNibbles prefix;
+    };
+
+    static KeyNibbles keyOf(const Subtree &subtree);
+
+    /**
+     * Visits the nodes of \arg subtree depth-first by \arg worker
+     */
+    static outcome::result<void> walkSubtree(const PolkadotTrie &trie,
+                                             Subtree subtree,
+                                             size_t worker,
+                                             const Visitor &visitor);
+
+    std::shared_ptr<TrieSerializer> serializer_;
+    std::shared_ptr<common::WorkerPool> workers_;
+    size_t workers_num_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_STATE_WALKER_HPP
@@ -5,6 +5,7 @@
 
 #include "storage/trie/impl/topper_trie_batch_impl.hpp"
 
+#include "storage/trie/impl/topper_trie_cursor.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
 
 OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
@@ -20,6 +21,14 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie,
 
 namespace kagome::storage::trie {
 
+  namespace {
+    bool startsWith(gsl::span<const uint8_t> key,
+                    gsl::span<const uint8_t> prefix) {
+      return key.size() >= prefix.size()
+             and std::equal(prefix.begin(), prefix.end(), key.begin());
+    }
+  }  // namespace
+
   TopperTrieBatchImpl::TopperTrieBatchImpl(
       const std::shared_ptr<TrieBatch> &parent)
       : parent_(parent) {}
@@ -40,9 +49,36 @@ namespace kagome::storage::trie {
     return Error::PARENT_EXPIRED;
   }
 
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  TopperTrieBatchImpl::getMany(gsl::span<const Buffer> keys) const {
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    // keys that are not affected by this batch and their positions
+    std::vector<Buffer> parent_keys;
+    std::vector<size_t> parent_key_positions;
+    for (size_t i = 0; i < static_cast<size_t>(keys.size()); i++) {
+      if (auto it = cache_.find(keys[i]); it != cache_.end()) {
+        values[i] = it->second;
+      } else if (not wasClearedByPrefix(keys[i])) {
+        parent_keys.push_back(keys[i]);
+        parent_key_positions.push_back(i);
+      }
+    }
+    if (parent_keys.empty()) {
+      return std::move(values);
+    }
+    if (auto p = parent_.lock(); p != nullptr) {
+      OUTCOME_TRY(parent_values, p->getMany(parent_keys));
+      for (size_t i = 0; i < parent_values.size(); i++) {
+        values[parent_key_positions[i]] = std::move(parent_values[i]);
+      }
+      return std::move(values);
+    }
+    return Error::PARENT_EXPIRED;
+  }
+
   std::unique_ptr<BufferMapCursor> TopperTrieBatchImpl::cursor() {
     if (auto p = parent_.lock(); p != nullptr) {
-      return p->cursor();
+      return std::make_unique<TopperTrieCursor>(*this, std::move(p));
     }
     return nullptr;
   }
@@ -82,28 +118,45 @@ namespace kagome::storage::trie {
 
   outcome::result<void> TopperTrieBatchImpl::put(const Buffer &key,
                                                  Buffer &&value) {
-    cache_[key] = std::move(value);
+    cache_.insert_or_assign(CachedKey{key}, std::move(value));
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::remove(const Buffer &key) {
-    cache_[key] = boost::none;
+    cache_.insert_or_assign(CachedKey{key}, boost::none);
     return outcome::success();
   }
 
   outcome::result<void> TopperTrieBatchImpl::clearPrefix(const Buffer &prefix) {
-    for (auto &p : cache_) {
-      if (p.first.subbuffer(0, prefix.size()) == prefix) {
-        cache_[p.first] = boost::none;
+    for (auto it = cache_.lower_bound(prefix);
+         it != cache_.end() and startsWith(it->first, prefix);
+         ++it) {
+      it->second = boost::none;
+    }
+    if (findClearedPrefix(prefix) == nullptr) {
+      // the longer prefixes are covered by the new one
+      auto it = cleared_prefixes_.lower_bound(prefix);
+      while (it != cleared_prefixes_.end() and startsWith(*it, prefix)) {
+        it = cleared_prefixes_.erase(it);
       }
+      cleared_prefixes_.insert(it, prefix);
     }
-    cleared_prefixes_.push_back(prefix);
     if (parent_.lock() != nullptr) {
       return outcome::success();
     }
     return Error::PARENT_EXPIRED;
   }
 
+  outcome::result<ClearPrefixResult> TopperTrieBatchImpl::clearPrefix(
+      const Buffer &prefix, uint32_t limit) {
+    if (parent_.lock() == nullptr) {
+      return Error::PARENT_EXPIRED;
+    }
+    // the removed entries are put to the cache, instead of the prefix, so
+    // the parent is not scanned by the prefix on the write back
+    return clearPrefixLimited(*this, prefix, limit);
+  }
+
   outcome::result<void> TopperTrieBatchImpl::writeBack() {
     if (auto p = parent_.lock(); p != nullptr) {
       auto it = cache_.begin();
@@ -112,9 +165,9 @@ namespace kagome::storage::trie {
       }
       for (; it != cache_.end(); it++) {
         if (it->second.has_value()) {
-          OUTCOME_TRY(p->put(it->first, it->second.value()));
+          OUTCOME_TRY(p->put(Buffer{it->first}, it->second.value()));
         } else {
-          OUTCOME_TRY(p->remove(it->first));
+          OUTCOME_TRY(p->remove(Buffer{it->first}));
         }
       }
       return outcome::success();
@@ -123,13 +176,17 @@ namespace kagome::storage::trie {
   }
 
   bool TopperTrieBatchImpl::wasClearedByPrefix(const Buffer &key) const {
-    for (auto prefix : cleared_prefixes_) {
-      auto key_end = key.begin();
-      std::advance(key_end, std::min(key.size(), prefix.size()) - 1);
-      auto is_cleared = std::equal(key.begin(), key_end, prefix.begin());
-      if (is_cleared) return true;
+    return findClearedPrefix(key) != nullptr;
+  }
+
+  const Buffer *TopperTrieBatchImpl::findClearedPrefix(
+      const Buffer &key) const {
+    auto it = cleared_prefixes_.upper_bound(key);
+    if (it == cleared_prefixes_.begin()) {
+      return nullptr;
     }
-    return false;
+    --it;
+    return startsWith(key, *it) ? &*it : nullptr;
   }
 
 }  // namespace kagome::storage::trie
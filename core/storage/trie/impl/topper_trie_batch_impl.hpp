@@ -8,6 +8,10 @@
 
 #include "storage/trie/trie_batches.hpp"
 
+#include <map>
+#include <set>
+
+#include "common/small_buffer.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
 
 namespace kagome::storage::trie {
@@ -19,9 +23,12 @@ namespace kagome::storage::trie {
     explicit TopperTrieBatchImpl(const std::shared_ptr<TrieBatch> &parent);
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
 
     /**
-     * Won't consider changes not written back to the parent batch
+     * Cursor over the changes of this batch merged with the entries of the
+     * parent one, valid while this batch lives
      */
     std::unique_ptr<BufferMapCursor> cursor() override;
     bool contains(const Buffer &key) const override;
@@ -31,14 +38,31 @@ namespace kagome::storage::trie {
     outcome::result<void> put(const Buffer &key, Buffer &&value) override;
     outcome::result<void> remove(const Buffer &key) override;
     outcome::result<void> clearPrefix(const Buffer &prefix) override;
+    outcome::result<ClearPrefixResult> clearPrefix(const Buffer &prefix,
+                                                   uint32_t limit) override;
 
     outcome::result<void> writeBack() override;
 
    private:
-    bool wasClearedByPrefix(const Buffer& key) const;
+    friend class TopperTrieCursor;
+
+    // the keys of the storage items are mostly 32 bytes long or somewhat
+    // longer, and are kept without allocations; the cache is looked up with
+    // the keys of the requests as they are
+    using CachedKey = common::SmallBuffer<48>;
+    using Cache = std::map<CachedKey, boost::optional<Buffer>, std::less<>>;
+
+    bool wasClearedByPrefix(const Buffer &key) const;
+
+    /**
+     * @return the cleared prefix of \arg key, nullptr if there is none
+     */
+    const Buffer *findClearedPrefix(const Buffer &key) const;
 
-    std::map<Buffer, boost::optional<Buffer>> cache_;
-    std::list<Buffer> cleared_prefixes_;
+    Cache cache_;
+    // none of the prefixes is a prefix of another one, so the only cleared
+    // prefix a key may have is the greatest one not greater than the key
+    std::set<Buffer> cleared_prefixes_;
     std::weak_ptr<TrieBatch> parent_;
   };
 
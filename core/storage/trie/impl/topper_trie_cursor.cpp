@@ -0,0 +1,185 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/topper_trie_cursor.hpp"
+
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, TopperTrieCursor::Error, e) {
+  using E = kagome::storage::trie::TopperTrieCursor::Error;
+  switch (e) {
+    case E::INVALID_CURSOR_POSITION:
+      return "operation cannot be performed; cursor points to no entry";
+    case E::NOT_FOUND:
+      return "the sought value is not found";
+    case E::METHOD_NOT_IMPLEMENTED:
+      return "the method is not yet implemented";
+  }
+  return "unknown error";
+}
+
+namespace kagome::storage::trie {
+
+  TopperTrieCursor::TopperTrieCursor(const TopperTrieBatchImpl &batch,
+                                     std::shared_ptr<TrieBatch> parent)
+      : batch_{batch},
+        parent_{std::move(parent)},
+        parent_cursor_{parent_->cursor()},
+        overlay_it_{batch_.cache_.end()} {
+    BOOST_ASSERT(parent_cursor_ != nullptr);
+  }
+
+  outcome::result<void> TopperTrieCursor::seekToFirst() {
+    overlay_it_ = batch_.cache_.begin();
+    // the cursor of an empty trie refuses to seek
+    if (parent_->empty()) {
+      parent_key_ = boost::none;
+    } else {
+      OUTCOME_TRY(parent_cursor_->seekToFirst());
+      OUTCOME_TRY(updateParentKey());
+    }
+    return skipAbsent();
+  }
+
+  outcome::result<void> TopperTrieCursor::seek(const common::Buffer &key) {
+    overlay_it_ = batch_.cache_.lower_bound(key);
+    OUTCOME_TRY(seekParentLowerBound(key));
+    OUTCOME_TRY(skipAbsent());
+    if (not isValid() or not isCurrentKey(key)) {
+      return Error::NOT_FOUND;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TopperTrieCursor::seekUpperBound(
+      const common::Buffer &key) {
+    overlay_it_ = batch_.cache_.upper_bound(key);
+    OUTCOME_TRY(parent_cursor_->seekUpperBound(key));
+    OUTCOME_TRY(updateParentKey());
+    return skipAbsent();
+  }
+
+  outcome::result<void> TopperTrieCursor::seekToLast() {
+    return Error::METHOD_NOT_IMPLEMENTED;
+  }
+
+  bool TopperTrieCursor::isValid() const {
+    return overlay_it_ != batch_.cache_.end() or parent_key_.has_value();
+  }
+
+  outcome::result<void> TopperTrieCursor::next() {
+    if (not isValid()) {
+      return Error::INVALID_CURSOR_POSITION;
+    }
+    if (isOverlayCurrent()) {
+      // the entry of the batch shadows the parent one with the same key
+      if (parent_key_ and *parent_key_ == overlay_it_->first) {
+        OUTCOME_TRY(nextInParent());
+      }
+      ++overlay_it_;
+    } else {
+      OUTCOME_TRY(nextInParent());
+    }
+    return skipAbsent();
+  }
+
+  outcome::result<void> TopperTrieCursor::prev() {
+    return Error::METHOD_NOT_IMPLEMENTED;
+  }
+
+  outcome::result<common::Buffer> TopperTrieCursor::key() const {
+    if (not isValid()) {
+      return Error::INVALID_CURSOR_POSITION;
+    }
+    if (isOverlayCurrent()) {
+      return common::Buffer{overlay_it_->first};
+    }
+    return parent_key_.value();
+  }
+
+  outcome::result<common::Buffer> TopperTrieCursor::value() const {
+    if (not isValid()) {
+      return Error::INVALID_CURSOR_POSITION;
+    }
+    if (isOverlayCurrent()) {
+      return overlay_it_->second.value();
+    }
+    return parent_cursor_->value();
+  }
+
+  outcome::result<void> TopperTrieCursor::skipAbsent() {
+    while (isValid()) {
+      if (isOverlayCurrent()) {
+        if (overlay_it_->second.has_value()) {
+          return outcome::success();
+        }
+        // a removed key, which may shadow the same key of the parent
+        if (parent_key_ and *parent_key_ == overlay_it_->first) {
+          OUTCOME_TRY(nextInParent());
+        }
+        ++overlay_it_;
+        continue;
+      }
+      const auto *prefix = batch_.findClearedPrefix(parent_key_.value());
+      if (prefix == nullptr) {
+        return outcome::success();
+      }
+      // the whole range of the cleared prefix is skipped at once
+      OUTCOME_TRY(skipParentPrefix(*prefix));
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TopperTrieCursor::skipParentPrefix(
+      const common::Buffer &prefix) {
+    // the least key, which is greater than all the keys with the prefix
+    auto prefix_end = prefix;
+    while (not prefix_end.empty() and prefix_end.toVector().back() == 0xff) {
+      prefix_end.toVector().pop_back();
+    }
+    if (prefix_end.empty()) {
+      parent_key_ = boost::none;
+      return outcome::success();
+    }
+    prefix_end.toVector().back()++;
+    return seekParentLowerBound(prefix_end);
+  }
+
+  outcome::result<void> TopperTrieCursor::seekParentLowerBound(
+      const common::Buffer &key) {
+    // a trie cursor seeks only to present keys
+    if (parent_->contains(key)) {
+      OUTCOME_TRY(parent_cursor_->seek(key));
+    } else {
+      OUTCOME_TRY(parent_cursor_->seekUpperBound(key));
+    }
+    return updateParentKey();
+  }
+
+  outcome::result<void> TopperTrieCursor::nextInParent() {
+    OUTCOME_TRY(parent_cursor_->next());
+    return updateParentKey();
+  }
+
+  outcome::result<void> TopperTrieCursor::updateParentKey() {
+    if (not parent_cursor_->isValid()) {
+      parent_key_ = boost::none;
+      return outcome::success();
+    }
+    OUTCOME_TRY(key, parent_cursor_->key());
+    parent_key_ = std::move(key);
+    return outcome::success();
+  }
+
+  bool TopperTrieCursor::isOverlayCurrent() const {
+    return overlay_it_ != batch_.cache_.end()
+           and (not parent_key_ or not(*parent_key_ < overlay_it_->first));
+  }
+
+  bool TopperTrieCursor::isCurrentKey(const common::Buffer &key) const {
+    return isOverlayCurrent() ? overlay_it_->first == key : parent_key_ == key;
+  }
+
+}  // namespace kagome::storage::trie
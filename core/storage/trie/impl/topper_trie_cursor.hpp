@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_STORAGE_TRIE_IMPL_TOPPER_TRIE_CURSOR
+#define KAGOME_CORE_STORAGE_TRIE_IMPL_TOPPER_TRIE_CURSOR
+
+#include "storage/face/map_cursor.hpp"
+
+#include <map>
+
+#include <boost/optional.hpp>
+
+#include "common/buffer.hpp"
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+#include "storage/trie/trie_batches.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Cursor over the entries of a topper batch, which merges the changes kept
+   * in the batch with the entries of its parent: entries of the batch
+   * shadow the entries of the parent with the same keys, while removed keys
+   * and keys under the cleared prefixes of the parent are skipped.
+   * Only iteration forward is supported.
+   */
+  class TopperTrieCursor
+      : public face::MapCursor<common::Buffer, common::Buffer> {
+   public:
+    enum class Error {
+      INVALID_CURSOR_POSITION = 1,  // the cursor points to no entry
+      NOT_FOUND,                    // the sought key is not found
+      METHOD_NOT_IMPLEMENTED
+    };
+
+    /**
+     * @param batch the batch, which must outlive the cursor
+     * @param parent the parent of the batch
+     */
+    TopperTrieCursor(const TopperTrieBatchImpl &batch,
+                     std::shared_ptr<TrieBatch> parent);
+    ~TopperTrieCursor() override = default;
+
+    outcome::result<void> seekToFirst() override;
+    outcome::result<void> seek(const common::Buffer &key) override;
+    outcome::result<void> seekUpperBound(const common::Buffer &key) override;
+    outcome::result<void> seekToLast() override;
+    bool isValid() const override;
+    outcome::result<void> next() override;
+    outcome::result<void> prev() override;
+    outcome::result<common::Buffer> key() const override;
+    outcome::result<common::Buffer> value() const override;
+
+   private:
+    using OverlayIt = TopperTrieBatchImpl::Cache::const_iterator;
+
+    /**
+     * Moves both cursors forward until the current entry is a present one
+     */
+    outcome::result<void> skipAbsent();
+
+    /**
+     * Moves the parent cursor past all the keys with \arg prefix
+     */
+    outcome::result<void> skipParentPrefix(const common::Buffer &prefix);
+
+    /**
+     * Moves the parent cursor to the first key not less than \arg key
+     */
+    outcome::result<void> seekParentLowerBound(const common::Buffer &key);
+
+    /**
+     * Moves the parent cursor to its next entry
+     */
+    outcome::result<void> nextInParent();
+
+    /**
+     * Remembers the key of the parent cursor or its absence
+     */
+    outcome::result<void> updateParentKey();
+
+    /**
+     * @return true if the current entry is the one of the batch, which is the
+     * case when the batch has an entry not greater than the parent one
+     */
+    bool isOverlayCurrent() const;
+
+    bool isCurrentKey(const common::Buffer &key) const;
+
+    const TopperTrieBatchImpl &batch_;
+    std::shared_ptr<TrieBatch> parent_;
+    std::unique_ptr<face::MapCursor<common::Buffer, common::Buffer>>
+        parent_cursor_;
+    OverlayIt overlay_it_;
+    // key of the parent cursor, none if it's at the end
+    boost::optional<common::Buffer> parent_key_;
+  };
+
+}  // namespace kagome::storage::trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::trie, TopperTrieCursor::Error);
+
+#endif  // KAGOME_CORE_STORAGE_TRIE_IMPL_TOPPER_TRIE_CURSOR
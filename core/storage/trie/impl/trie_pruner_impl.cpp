@@ -0,0 +1,163 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+
+#include <unordered_map>
+
+#include "scale/scale.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    common::Buffer encodeRefCount(uint32_t count) {
+      return common::Buffer{scale::encode(count).value()};
+    }
+  }  // namespace
+
+  TriePrunerImpl::TriePrunerImpl(
+      std::shared_ptr<TrieStorageBackend> node_storage,
+      std::shared_ptr<TrieStorageBackend> ref_counts,
+      std::shared_ptr<Codec> codec)
+      : node_storage_{std::move(node_storage)},
+        ref_counts_{std::move(ref_counts)},
+        codec_{std::move(codec)} {
+    BOOST_ASSERT(node_storage_ != nullptr);
+    BOOST_ASSERT(ref_counts_ != nullptr);
+    BOOST_ASSERT(codec_ != nullptr);
+  }
+
+  outcome::result<void> TriePrunerImpl::addState(
+      const common::Buffer &root_key,
+      const std::vector<std::pair<common::Buffer, common::Buffer>>
+          &new_nodes) {
+    std::lock_guard lock{mutex_};
+    // counters changed by this state, starting from zero for the fresh nodes
+    std::unordered_map<common::Buffer, uint32_t> counts;
+    std::vector<const common::Buffer *> fresh_nodes;
+
+    auto nodes_batch = node_storage_->batch();
+    for (auto &[key, encoding] : new_nodes) {
+      // a node which is already stored is only referenced once more by the
+      // fresh parents below, while a node stored without a counter is never
+      // removed anyway
+      if (counts.count(key) != 0 or ref_counts_->contains(key)
+          or node_storage_->contains(key)) {
+        continue;
+      }
+      counts.emplace(key, 0);
+      fresh_nodes.push_back(&encoding);
+      OUTCOME_TRY(nodes_batch->put(key, encoding));
+    }
+
+    auto reference = [&](const common::Buffer &key) -> outcome::result<void> {
+      auto it = counts.find(key);
+      if (it == counts.end()) {
+        OUTCOME_TRY(count, getRefCount(key));
+        if (not count) {
+          return outcome::success();
+        }
+        it = counts.emplace(key, count.value()).first;
+      }
+      it->second++;
+      return outcome::success();
+    };
+    for (auto encoding : fresh_nodes) {
+      OUTCOME_TRY(children, getChildren(*encoding));
+      for (auto &child : children) {
+        OUTCOME_TRY(reference(child));
+      }
+    }
+    OUTCOME_TRY(reference(root_key));
+
+    auto counts_batch = ref_counts_->batch();
+    for (auto &[key, count] : counts) {
+      OUTCOME_TRY(counts_batch->put(key, encodeRefCount(count)));
+    }
+    // nodes go first, so that a failure in between leaves stored nodes
+    // without counters, which is just a leak, instead of counters of
+    // missing nodes
+    OUTCOME_TRY(nodes_batch->commit());
+    return counts_batch->commit();
+  }
+
+  outcome::result<void> TriePrunerImpl::pruneState(
+      const common::Buffer &root_key) {
+    std::lock_guard lock{mutex_};
+    std::unordered_map<common::Buffer, uint32_t> counts;
+    auto nodes_batch = node_storage_->batch();
+
+    std::vector<common::Buffer> dereferenced{root_key};
+    while (not dereferenced.empty()) {
+      auto key = std::move(dereferenced.back());
+      dereferenced.pop_back();
+      auto it = counts.find(key);
+      if (it == counts.end()) {
+        OUTCOME_TRY(count, getRefCount(key));
+        if (not count) {
+          continue;
+        }
+        it = counts.emplace(key, count.value()).first;
+      }
+      // already removed during this pruning
+      if (it->second == 0) {
+        continue;
+      }
+      if (--it->second > 0) {
+        continue;
+      }
+      OUTCOME_TRY(encoding, node_storage_->getPinned(key));
+      OUTCOME_TRY(children, getChildren(encoding.view()));
+      for (auto &child : children) {
+        dereferenced.push_back(std::move(child));
+      }
+      OUTCOME_TRY(nodes_batch->remove(key));
+    }
+
+    auto counts_batch = ref_counts_->batch();
+    for (auto &[key, count] : counts) {
+      if (count == 0) {
+        OUTCOME_TRY(counts_batch->remove(key));
+      } else {
+        OUTCOME_TRY(counts_batch->put(key, encodeRefCount(count)));
+      }
+    }
+    // counters go first for the same reason as in addState
+    OUTCOME_TRY(counts_batch->commit());
+    return nodes_batch->commit();
+  }
+
+  outcome::result<boost::optional<uint32_t>> TriePrunerImpl::getRefCount(
+      const common::Buffer &key) const {
+    if (not ref_counts_->contains(key)) {
+      return boost::none;
+    }
+    OUTCOME_TRY(encoded, ref_counts_->get(key));
+    OUTCOME_TRY(count, scale::decode<uint32_t>(encoded));
+    return boost::optional<uint32_t>{count};
+  }
+
+  outcome::result<std::vector<common::Buffer>> TriePrunerImpl::getChildren(
+      gsl::span<const uint8_t> encoding) const {
+    OUTCOME_TRY(node, codec_->decodeNode(encoding));
+    auto branch = std::dynamic_pointer_cast<BranchNode>(node);
+    if (branch == nullptr) {
+      return std::vector<common::Buffer>{};
+    }
+    std::vector<common::Buffer> children;
+    children.reserve(branch->children.count());
+    // stored children of a decoded branch are dummy nodes keeping their
+    // merkle values, which are the storage keys of the children. The short
+    // ones are embedded in the branch and are not stored apart from it
+    for (auto &child : branch->children) {
+      if (child->isDummy()) {
+        children.push_back(static_cast<const DummyNode &>(*child).db_key);
+      }
+    }
+    return children;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,71 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL_HPP
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL_HPP
+
+#include "storage/trie/trie_pruner.hpp"
+
+#include <mutex>
+
+#include <boost/optional.hpp>
+
+#include "storage/trie/codec.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Keeps a reference counter for every node written through it in a
+   * separate key space. A counter is the number of distinct stored nodes
+   * having the node as a child plus the number of added and not yet pruned
+   * states having it as a root.
+   * Nodes, which are in the storage but have no counter (e.g. written before
+   * pruning was enabled), are never removed.
+   */
+  class TriePrunerImpl : public TriePruner {
+   public:
+    /**
+     * @param node_storage storage of trie nodes
+     * @param ref_counts storage of reference counters of the nodes, keyed by
+     * the same keys as the nodes
+     * @param codec codec of the nodes, used to find children of a node
+     */
+    TriePrunerImpl(std::shared_ptr<TrieStorageBackend> node_storage,
+                   std::shared_ptr<TrieStorageBackend> ref_counts,
+                   std::shared_ptr<Codec> codec);
+    ~TriePrunerImpl() override = default;
+
+    outcome::result<void> addState(
+        const common::Buffer &root_key,
+        const std::vector<std::pair<common::Buffer, common::Buffer>>
+            &new_nodes) override;
+
+    outcome::result<void> pruneState(const common::Buffer &root_key) override;
+
+   private:
+    /**
+     * @return reference counter of a node, none if there is no counter for it
+     */
+    outcome::result<boost::optional<uint32_t>> getRefCount(
+        const common::Buffer &key) const;
+
+    /**
+     * @return storage keys of the children of a node with \arg encoding
+     */
+    outcome::result<std::vector<common::Buffer>> getChildren(
+        gsl::span<const uint8_t> encoding) const;
+
+    std::shared_ptr<TrieStorageBackend> node_storage_;
+    std::shared_ptr<TrieStorageBackend> ref_counts_;
+    std::shared_ptr<Codec> codec_;
+    // states are added on block import and pruned on finalization, which
+    // may happen on different threads
+    std::mutex mutex_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_PRUNER_IMPL_HPP
@@ -0,0 +1,92 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_snapshot_impl.hpp"
+
+#include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+
+namespace kagome::storage::trie {
+
+  TrieSnapshotImpl::TrieSnapshotImpl(
+      Buffer root_hash,
+      std::unique_ptr<const PolkadotTrie> trie,
+      std::shared_ptr<const KeyFilter> key_filter)
+      : root_hash_{std::move(root_hash)},
+        trie_{std::move(trie)},
+        key_filter_{std::move(key_filter)} {
+    BOOST_ASSERT(trie_ != nullptr);
+  }
+
+  outcome::result<Buffer> TrieSnapshotImpl::get(const Buffer &key) const {
+    if (key_filter_ != nullptr and not key_filter_->mayContain(key)) {
+      return TrieError::NO_VALUE;
+    }
+    return trie_->get(key);
+  }
+
+  outcome::result<std::vector<boost::optional<Buffer>>>
+  TrieSnapshotImpl::getMany(gsl::span<const Buffer> keys) const {
+    if (key_filter_ == nullptr) {
+      return trie_->getMany(keys);
+    }
+    // only the keys which may be in the state are looked up in the trie
+    std::vector<Buffer> present_keys;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < static_cast<size_t>(keys.size()); i++) {
+      if (key_filter_->mayContain(keys[i])) {
+        present_keys.push_back(keys[i]);
+        positions.push_back(i);
+      }
+    }
+    std::vector<boost::optional<Buffer>> values(keys.size());
+    if (present_keys.empty()) {
+      return std::move(values);
+    }
+    OUTCOME_TRY(present_values, trie_->getMany(present_keys));
+    for (size_t i = 0; i < positions.size(); i++) {
+      values[positions[i]] = std::move(present_values[i]);
+    }
+    return std::move(values);
+  }
+
+  outcome::result<boost::optional<Buffer>> TrieSnapshotImpl::getMerkleValue(
+      const Buffer &key) const {
+    auto root = trie_->getRoot();
+    if (root == nullptr
+        or (key_filter_ != nullptr and not key_filter_->mayContain(key))) {
+      return boost::none;
+    }
+    OUTCOME_TRY(node, trie_->getNode(root, NibbleView::ofKey(key)));
+    if (node == nullptr or not node->value) {
+      return boost::none;
+    }
+    // the nodes of a snapshot are never modified, so all of them came from
+    // the storage with their merkle values
+    BOOST_ASSERT(node->merkle_value.has_value());
+    return node->merkle_value;
+  }
+
+  bool TrieSnapshotImpl::contains(const Buffer &key) const {
+    if (key_filter_ != nullptr and not key_filter_->mayContain(key)) {
+      return false;
+    }
+    return trie_->contains(key);
+  }
+
+  bool TrieSnapshotImpl::empty() const {
+    return trie_->empty();
+  }
+
+  std::unique_ptr<BufferMapCursor> TrieSnapshotImpl::cursor() const {
+    // the cursor only reads the trie, the loaded nodes are not attached
+    return std::make_unique<PolkadotTrieCursor>(*trie_);
+  }
+
+  const Buffer &TrieSnapshotImpl::getRootHash() const {
+    return root_hash_;
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_IMPL_TRIE_SNAPSHOT_IMPL
+#define KAGOME_STORAGE_TRIE_IMPL_TRIE_SNAPSHOT_IMPL
+
+#include "storage/trie/trie_snapshot.hpp"
+
+#include "storage/trie/polkadot_trie/polkadot_trie.hpp"
+
+namespace kagome::storage::trie {
+
+  class TrieSnapshotImpl : public TrieSnapshot {
+   public:
+    /**
+     * @param trie a trie, which doesn't attach the nodes it loads to their
+     * parents, @see TrieSerializer#retrieveImmutableTrie
+     * @param key_filter filter, which has seen all the keys of the state, if
+     * there is one, @see PolkadotTrie#setKeyFilter
+     */
+    TrieSnapshotImpl(Buffer root_hash,
+                     std::unique_ptr<const PolkadotTrie> trie,
+                     std::shared_ptr<const KeyFilter> key_filter = nullptr);
+    ~TrieSnapshotImpl() override = default;
+
+    outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const override;
+    outcome::result<boost::optional<Buffer>> getMerkleValue(
+        const Buffer &key) const override;
+    bool contains(const Buffer &key) const override;
+    bool empty() const override;
+    std::unique_ptr<BufferMapCursor> cursor() const override;
+    const Buffer &getRootHash() const override;
+
+   private:
+    const Buffer root_hash_;
+    const std::unique_ptr<const PolkadotTrie> trie_;
+    const std::shared_ptr<const KeyFilter> key_filter_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_IMPL_TRIE_SNAPSHOT_IMPL
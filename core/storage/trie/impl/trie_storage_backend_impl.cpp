@@ -22,17 +22,27 @@ namespace kagome::storage::trie {
         ->cursor();  // TODO(Harrm): perhaps should iterate over trie nodes only
   }
 
+  std::unique_ptr<face::MapCursor<Buffer, Buffer>>
+  TrieStorageBackendImpl::scanCursor(const Buffer &prefix) {
+    return storage_->scanCursor(prefix);
+  }
+
   std::unique_ptr<face::WriteBatch<Buffer, Buffer>> TrieStorageBackendImpl::batch() {
     return std::make_unique<TrieStorageBackendBatch>(storage_->batch(),
                                                         node_prefix_);
   }
 
   outcome::result<Buffer> TrieStorageBackendImpl::get(const Buffer &key) const {
-    return storage_->get(prefixKey(key));
+    return storage_->get(prefixReadKey(key));
+  }
+
+  outcome::result<face::PinnedView<Buffer>> TrieStorageBackendImpl::getPinned(
+      const Buffer &key) const {
+    return storage_->getPinned(prefixReadKey(key));
   }
 
   bool TrieStorageBackendImpl::contains(const Buffer &key) const {
-    return storage_->contains(prefixKey(key));
+    return storage_->contains(prefixReadKey(key));
   }
 
   bool TrieStorageBackendImpl::empty() const {
@@ -57,4 +67,12 @@ namespace kagome::storage::trie {
     return common::Buffer{node_prefix_}.put(key);
   }
 
+  const common::Buffer &TrieStorageBackendImpl::prefixReadKey(
+      const common::Buffer &key) const {
+    thread_local common::Buffer prefixed_key;
+    prefixed_key.clear();
+    prefixed_key.putBuffer(node_prefix_).putBuffer(key);
+    return prefixed_key;
+  }
+
 }  // namespace kagome::storage::trie
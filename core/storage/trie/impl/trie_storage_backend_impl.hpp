@@ -20,9 +20,13 @@ namespace kagome::storage::trie {
     ~TrieStorageBackendImpl() override = default;
 
     std::unique_ptr<face::MapCursor<Buffer, Buffer>> cursor() override;
+    std::unique_ptr<face::MapCursor<Buffer, Buffer>> scanCursor(
+        const Buffer &prefix) override;
     std::unique_ptr<face::WriteBatch<Buffer, Buffer>> batch() override;
 
     outcome::result<Buffer> get(const Buffer &key) const override;
+    outcome::result<face::PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override;
     bool contains(const Buffer &key) const override;
     bool empty() const override;
 
@@ -33,6 +37,13 @@ namespace kagome::storage::trie {
    private:
     common::Buffer prefixKey(const common::Buffer &key) const;
 
+    /**
+     * Same as prefixKey, but the key is built in a buffer reused by the
+     * calling thread, which saves an allocation per read. The result is valid
+     * until the next call on the same thread
+     */
+    const common::Buffer &prefixReadKey(const common::Buffer &key) const;
+
     std::shared_ptr<BufferStorage> storage_;
     common::Buffer node_prefix_;
   };
@@ -5,11 +5,14 @@
 
 #include "storage/trie/impl/trie_storage_impl.hpp"
 
+#include <algorithm>
 #include <memory>
 
 #include "outcome/outcome.hpp"
 #include "storage/trie/impl/ephemeral_trie_batch_impl.hpp"
 #include "storage/trie/impl/persistent_trie_batch_impl.hpp"
+#include "storage/trie/impl/trie_snapshot_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 
 namespace kagome::storage::trie {
 
@@ -58,68 +61,201 @@ namespace kagome::storage::trie {
     BOOST_ASSERT(serializer_ != nullptr);
     BOOST_ASSERT((changes_.has_value() and changes_.value() != nullptr)
                  or not changes_.has_value());
-    logger_->info("Initialize trie storage with root: {}", root_hash_.toHex());
+    logger_->info("Initialize trie storage with root: {}", root_hash_);
   }
 
   outcome::result<std::unique_ptr<PersistentTrieBatch>>
   TrieStorageImpl::getPersistentBatch() {
-    logger_->debug("Initialize persistent trie batch with root: {}",
-                   root_hash_.toHex());
-    auto trie_res = serializer_->retrieveTrie(Buffer{root_hash_});
+    auto root_hash = getRootHash();
+    logger_->debug("Initialize persistent trie batch with root: {}", root_hash);
+    auto trie_res = serializer_->retrieveTrie(root_hash);
     if (trie_res.has_error()) {
       logger_->error("Batch initialization failed, invalid root: {}",
-                     root_hash_.toHex());
+                     root_hash);
       return trie_res.error();
     }
+    OUTCOME_TRY(filtered, attachKeyFilter(root_hash, *trie_res.value(), true));
     return std::make_unique<PersistentTrieBatchImpl>(
         codec_,
         serializer_,
         changes_,
         std::move(trie_res.value()),
-        [this](auto const &new_root) {
-          root_hash_ = new_root;
-          logger_->debug("Update state root: {}", root_hash_);
-        });
+        [this, filtered](auto const &new_root) {
+          updateRootHash(new_root);
+          if (filtered) {
+            markFiltered(new_root);
+          }
+        },
+        flat_state_,
+        root_hash);
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
   TrieStorageImpl::getEphemeralBatch() const {
-    logger_->debug("Initialize ephemeral trie batch with root: {}",
-                   root_hash_.toHex());
-    OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root_hash_}));
-    return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
+    auto root_hash = getRootHash();
+    logger_->debug("Initialize ephemeral trie batch with root: {}", root_hash);
+    OUTCOME_TRY(trie, serializer_->retrieveTrie(root_hash));
+    OUTCOME_TRY(attachKeyFilter(root_hash, *trie, false));
+    return std::make_unique<EphemeralTrieBatchImpl>(
+        codec_, std::move(trie), flat_state_, root_hash);
   }
 
   outcome::result<std::unique_ptr<PersistentTrieBatch>>
   TrieStorageImpl::getPersistentBatchAt(const common::Hash256 &root) {
-    logger_->debug("Initialize persistent trie batch with root: {}",
-                   root.toHex());
+    logger_->debug("Initialize persistent trie batch with root: {}", root);
     auto trie_res = serializer_->retrieveTrie(Buffer{root});
     if (trie_res.has_error()) {
-      logger_->error("Batch initialization failed, invalid root: {}",
-                     root.toHex());
+      logger_->error("Batch initialization failed, invalid root: {}", root);
       return trie_res.error();
     }
+    OUTCOME_TRY(filtered,
+                attachKeyFilter(Buffer{root}, *trie_res.value(), true));
     return std::make_unique<PersistentTrieBatchImpl>(
         codec_,
         serializer_,
         changes_,
         std::move(trie_res.value()),
-        [this](auto const &new_root) {
-          root_hash_ = new_root;
-          logger_->debug("Update state root: {}", root_hash_);
-        });
+        [this, filtered](auto const &new_root) {
+          updateRootHash(new_root);
+          if (filtered) {
+            markFiltered(new_root);
+          }
+        },
+        flat_state_,
+        Buffer{root});
   }
 
   outcome::result<std::unique_ptr<EphemeralTrieBatch>>
   TrieStorageImpl::getEphemeralBatchAt(const common::Hash256 &root) const {
-    logger_->debug("Initialize ephemeral trie batch with root: {}",
-                   root_hash_.toHex());
+    logger_->debug("Initialize ephemeral trie batch with root: {}", root);
     OUTCOME_TRY(trie, serializer_->retrieveTrie(Buffer{root}));
-    return std::make_unique<EphemeralTrieBatchImpl>(codec_, std::move(trie));
+    OUTCOME_TRY(attachKeyFilter(Buffer{root}, *trie, false));
+    return std::make_unique<EphemeralTrieBatchImpl>(
+        codec_, std::move(trie), flat_state_, Buffer{root});
+  }
+
+  outcome::result<std::shared_ptr<const TrieSnapshot>>
+  TrieStorageImpl::getSnapshot() const {
+    return snapshotOf(getRootHash());
+  }
+
+  outcome::result<std::shared_ptr<const TrieSnapshot>>
+  TrieStorageImpl::getSnapshotAt(const common::Hash256 &root) const {
+    return snapshotOf(Buffer{root});
+  }
+
+  outcome::result<std::vector<common::Buffer>> TrieStorageImpl::getProofAt(
+      const common::Hash256 &root, gsl::span<const common::Buffer> keys) const {
+    // the trie is never shared, as its nodes are recorded as they are loaded
+    // and the snapshots keep theirs. No key filter is set, because a proof
+    // of absence needs the nodes on the path to an absent key as well
+    auto recorder = std::make_shared<TrieProofRecorder>();
+    OUTCOME_TRY(trie,
+                serializer_->retrieveRecordingTrie(Buffer{root}, recorder));
+    OUTCOME_TRY(trie->getMany(keys));
+    return recorder->release();
+  }
+
+  outcome::result<std::shared_ptr<const TrieSnapshot>>
+  TrieStorageImpl::snapshotOf(const common::Buffer &root) const {
+    {
+      std::lock_guard lock{mutex_};
+      auto it = std::find_if(
+          snapshots_.begin(), snapshots_.end(), [&root](auto &snapshot) {
+            return snapshot->getRootHash() == root;
+          });
+      if (it != snapshots_.end()) {
+        snapshots_.splice(snapshots_.begin(), snapshots_, it);
+        return snapshots_.front();
+      }
+    }
+    // the trie is retrieved without the lock, so that a slow read from the
+    // storage doesn't stall the other readers; if two threads happen to race
+    // for the same root, one of the equal snapshots is just dropped
+    logger_->debug("Initialize trie snapshot with root: {}", root);
+    OUTCOME_TRY(trie, serializer_->retrieveImmutableTrie(root));
+    std::shared_ptr<const TrieSnapshot> snapshot =
+        std::make_shared<TrieSnapshotImpl>(
+            root,
+            std::move(trie),
+            isFiltered(root) ? key_filter_ : nullptr);
+
+    std::lock_guard lock{mutex_};
+    snapshots_.push_front(snapshot);
+    if (snapshots_.size() > kSnapshotCacheSize) {
+      snapshots_.pop_back();
+    }
+    return snapshot;
+  }
+
+  void TrieStorageImpl::setRootHash(const common::Buffer &root) {
+    updateRootHash(root);
+  }
+
+  void TrieStorageImpl::updateRootHash(const common::Buffer &new_root) {
+    std::lock_guard lock{mutex_};
+    root_hash_ = new_root;
+    logger_->debug("Update state root: {}", root_hash_);
+  }
+
+  void TrieStorageImpl::setKeyFilter(std::shared_ptr<KeyFilter> filter) {
+    key_filter_ = std::move(filter);
+    // the empty state has no keys to add to the filter
+    markFiltered(serializer_->getEmptyRootHash());
+  }
+
+  void TrieStorageImpl::setFlatState(std::shared_ptr<FlatState> flat_state) {
+    flat_state_ = std::move(flat_state);
+  }
+
+  bool TrieStorageImpl::isFiltered(const common::Buffer &root) const {
+    if (key_filter_ == nullptr) {
+      return false;
+    }
+    std::lock_guard lock{mutex_};
+    return filtered_set_.count(root) != 0;
+  }
+
+  void TrieStorageImpl::markFiltered(const common::Buffer &root) const {
+    std::lock_guard lock{mutex_};
+    if (not filtered_set_.insert(root).second) {
+      return;
+    }
+    filtered_states_.push_back(root);
+    if (filtered_states_.size() > kFilteredStatesNum) {
+      filtered_set_.erase(filtered_states_.front());
+      filtered_states_.pop_front();
+    }
+  }
+
+  outcome::result<bool> TrieStorageImpl::attachKeyFilter(
+      const common::Buffer &root, PolkadotTrie &trie, bool scan) const {
+    if (key_filter_ == nullptr) {
+      return false;
+    }
+    if (not isFiltered(root)) {
+      if (not scan) {
+        return false;
+      }
+      logger_->info("Add the keys of the state {} to the key filter", root);
+      // the nodes loaded by the scan are not attached to the trie and are
+      // freed right away
+      OUTCOME_TRY(state, serializer_->retrieveImmutableTrie(root));
+      PolkadotTrieCursor cursor{*state};
+      OUTCOME_TRY(cursor.seekToFirst());
+      while (cursor.isValid()) {
+        OUTCOME_TRY(key, cursor.key());
+        key_filter_->add(key);
+        OUTCOME_TRY(cursor.next());
+      }
+      markFiltered(root);
+    }
+    trie.setKeyFilter(key_filter_);
+    return true;
   }
 
   common::Buffer TrieStorageImpl::getRootHash() const {
+    std::lock_guard lock{mutex_};
     return root_hash_;
   }
 }  // namespace kagome::storage::trie
@@ -8,9 +8,16 @@
 
 #include "storage/trie/trie_storage.hpp"
 
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_set>
+
 #include "common/logger.hpp"
 #include "storage/changes_trie/changes_tracker.hpp"
 #include "storage/trie/codec.hpp"
+#include "storage/trie/impl/flat_state.hpp"
+#include "storage/trie/polkadot_trie/key_filter.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
 #include "storage/trie/serialization/trie_serializer.hpp"
 
@@ -18,6 +25,18 @@ namespace kagome::storage::trie {
 
   class TrieStorageImpl : public TrieStorage {
    public:
+    /**
+     * Number of the most recently requested snapshots kept alive, so that
+     * readers of the same state share a snapshot along with its loaded nodes
+     */
+    static constexpr size_t kSnapshotCacheSize = 16;
+
+    /**
+     * Number of the most recent states, which keys are known to be all in
+     * the key filter
+     */
+    static constexpr size_t kFilteredStatesNum = 4096;
+
     static outcome::result<std::unique_ptr<TrieStorageImpl>> createEmpty(
         const std::shared_ptr<PolkadotTrieFactory> &trie_factory,
         std::shared_ptr<Codec> codec,
@@ -47,8 +66,41 @@ namespace kagome::storage::trie {
     outcome::result<std::unique_ptr<EphemeralTrieBatch>> getEphemeralBatchAt(
         const common::Hash256 &root) const override;
 
+    outcome::result<std::shared_ptr<const TrieSnapshot>> getSnapshot()
+        const override;
+    outcome::result<std::shared_ptr<const TrieSnapshot>> getSnapshotAt(
+        const common::Hash256 &root) const override;
+
+    outcome::result<std::vector<common::Buffer>> getProofAt(
+        const common::Hash256 &root,
+        gsl::span<const common::Buffer> keys) const override;
+
     common::Buffer getRootHash() const override;
 
+    /**
+     * Makes the state with \arg root the current one. Is for the states,
+     * which nodes are written to the storage bypassing the batches, as the
+     * genesis one is
+     */
+    void setRootHash(const common::Buffer &root);
+
+    /**
+     * Enables \arg filter for the tries of the states, which keys it has
+     * all seen. These are the empty state and the states committed on top
+     * of a state with the filter. A persistent batch at a state without the
+     * filter adds all the keys of the state to the filter first, which
+     * happens once after a restart, as the later states are derived from it.
+     * Is to be called before the storage is used
+     */
+    void setKeyFilter(std::shared_ptr<KeyFilter> filter);
+
+    /**
+     * Makes the batches read the values from \arg flat_state while it has
+     * their states, and add the states they commit to it. Is to be called
+     * before the storage is used
+     */
+    void setFlatState(std::shared_ptr<FlatState> flat_state);
+
    protected:
     TrieStorageImpl(
         common::Buffer root_hash,
@@ -57,7 +109,33 @@ namespace kagome::storage::trie {
         boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes);
 
    private:
+    outcome::result<std::shared_ptr<const TrieSnapshot>> snapshotOf(
+        const common::Buffer &root) const;
+    void updateRootHash(const common::Buffer &new_root);
+
+    /**
+     * Sets the key filter to \arg trie of the state with \arg root if the
+     * filter has seen all the keys of the state. If it hasn't and \arg scan
+     * is set, the keys are added to the filter first
+     * @return true if the filter is set
+     */
+    outcome::result<bool> attachKeyFilter(const common::Buffer &root,
+                                          PolkadotTrie &trie,
+                                          bool scan) const;
+    bool isFiltered(const common::Buffer &root) const;
+    void markFiltered(const common::Buffer &root) const;
+
+    // guards the root hash, which is updated on import while RPC threads
+    // read it, the snapshots and the filtered states
+    mutable std::mutex mutex_;
     common::Buffer root_hash_;
+    // the most recently used snapshot is at the front
+    mutable std::list<std::shared_ptr<const TrieSnapshot>> snapshots_;
+    // states, which keys are all in the key filter, the oldest at the front
+    mutable std::deque<common::Buffer> filtered_states_;
+    mutable std::unordered_set<common::Buffer> filtered_set_;
+    std::shared_ptr<KeyFilter> key_filter_;
+    std::shared_ptr<FlatState> flat_state_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieSerializer> serializer_;
     boost::optional<std::shared_ptr<changes_trie::ChangesTracker>> changes_;
@@ -0,0 +1,62 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_filter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace kagome::storage::trie {
+
+  namespace {
+    uint64_t mix(uint64_t x) {
+      x ^= x >> 30u;
+      x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27u;
+      x *= 0x94d049bb133111ebull;
+      return x ^ (x >> 31u);
+    }
+
+    /**
+     * @return two independent hashes of \arg key, which give the positions
+     * of all its bits by double hashing
+     */
+    std::pair<uint64_t, uint64_t> hashesOf(gsl::span<const uint8_t> key) {
+      uint64_t h = 0xcbf29ce484222325ull;
+      for (auto byte : key) {
+        h = (h ^ byte) * 0x100000001b3ull;
+      }
+      // an odd second hash is never a multiple of the even number of bits,
+      // so the positions of a key don't all coincide
+      return {mix(h), mix(h ^ 0x9e3779b97f4a7c15ull) | 1u};
+    }
+  }  // namespace
+
+  KeyFilter::KeyFilter(size_t size_bytes)
+      : words_(std::max<size_t>(size_bytes / sizeof(uint64_t), 1)),
+        bits_num_{words_.size() * 64} {}
+
+  void KeyFilter::add(gsl::span<const uint8_t> key) {
+    auto [h1, h2] = hashesOf(key);
+    for (size_t i = 0; i < kHashesNum; i++) {
+      auto bit = (h1 + i * h2) % bits_num_;
+      words_[bit / 64].fetch_or(1ull << (bit % 64), std::memory_order_relaxed);
+    }
+  }
+
+  bool KeyFilter::mayContain(gsl::span<const uint8_t> key) const {
+    auto [h1, h2] = hashesOf(key);
+    for (size_t i = 0; i < kHashesNum; i++) {
+      auto bit = (h1 + i * h2) % bits_num_;
+      if ((words_[bit / 64].load(std::memory_order_relaxed)
+           & (1ull << (bit % 64)))
+          == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+}  // namespace kagome::storage::trie
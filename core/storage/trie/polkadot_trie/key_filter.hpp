@@ -0,0 +1,51 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_FILTER_HPP
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_FILTER_HPP
+
+#include <atomic>
+#include <vector>
+
+#include <gsl/span>
+
+namespace kagome::storage::trie {
+
+  /**
+   * Bloom filter over the keys of trie states, which tells that a key is
+   * surely absent without walking its path through the nodes in the
+   * storage. Keys are only ever added, so a filter which has seen all the
+   * keys of a state answers correctly for the state and for all the states
+   * derived from it with the tries using the filter, while the removed keys
+   * just become false positives.
+   * A filter is shared by the tries of different states, which are used on
+   * different threads, so its bits are set atomically
+   */
+  class KeyFilter {
+   public:
+    /**
+     * @param size_bytes size of the filter, ~10 bits per key give about 1%
+     * of false positives
+     */
+    explicit KeyFilter(size_t size_bytes);
+
+    void add(gsl::span<const uint8_t> key);
+
+    /**
+     * @return false if \arg key has never been added, true if it probably
+     * has been
+     */
+    bool mayContain(gsl::span<const uint8_t> key) const;
+
+   private:
+    static constexpr size_t kHashesNum = 7;
+
+    std::vector<std::atomic<uint64_t>> words_;
+    uint64_t bits_num_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_KEY_FILTER_HPP
@@ -5,28 +5,98 @@
 
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
 namespace kagome::storage::trie {
 
+  KeyNibbles NibbleView::toNibbles() const {
+    if (not packed_) {
+      return KeyNibbles{KeyNibbles::Base{data_ + begin_, data_ + end_}};
+    }
+    KeyNibbles nibbles;
+    nibbles.resize(size());
+    for (size_t i = 0; i < nibbles.size(); ++i) {
+      nibbles[i] = (*this)[i];
+    }
+    return nibbles;
+  }
+
+  size_t NibbleView::commonPrefixLength(const NibbleView &a,
+                                        const NibbleView &b) {
+    auto length = std::min(a.size(), b.size());
+    if (not a.packed_ and not b.packed_) {
+      auto begin = a.data_ + a.begin_;
+      return std::mismatch(begin, begin + length, b.data_ + b.begin_).first
+             - begin;
+    }
+    size_t i = 0;
+    if (a.packed_ and b.packed_ and a.begin_ % 2 == b.begin_ % 2) {
+      // the nibbles are aligned alike, so the whole bytes are compared
+      if (a.begin_ % 2 == 1 and length != 0) {
+        if (a[0] != b[0]) {
+          return 0;
+        }
+        i = 1;
+      }
+      auto begin = a.data_ + (a.begin_ + i) / 2;
+      auto bytes = (length - i) / 2;
+      auto mismatch =
+          std::mismatch(begin, begin + bytes, b.data_ + (b.begin_ + i) / 2);
+      i += (mismatch.first - begin) * 2;
+    }
+    // the rest nibble by nibble, which is at most a byte of aligned views
+    for (; i < length and a[i] == b[i]; ++i) {
+    }
+    return i;
+  }
+
+  const BranchChildren::NodePtr &BranchChildren::at(size_t idx) const {
+    static const NodePtr kNoChild{};
+    if (idx >= kMaxChildren) {
+      throw std::out_of_range{"Branch child index is out of range"};
+    }
+    if ((bitmap_ & (1u << idx)) == 0) {
+      return kNoChild;
+    }
+    return nodes_[rankOf(idx)];
+  }
+
+  void BranchChildren::set(size_t idx, NodePtr child) {
+    if (idx >= kMaxChildren) {
+      throw std::out_of_range{"Branch child index is out of range"};
+    }
+    auto pos = nodes_.begin() + rankOf(idx);
+    uint16_t bit = 1u << idx;
+    if ((bitmap_ & bit) != 0) {
+      if (child) {
+        *pos = std::move(child);
+      } else {
+        nodes_.erase(pos);
+        bitmap_ &= ~bit;
+      }
+    } else if (child) {
+      nodes_.insert(pos, std::move(child));
+      bitmap_ |= bit;
+    }
+  }
+
+  size_t BranchChildren::rankOf(size_t idx) const {
+    return std::bitset<kMaxChildren>(bitmap_ & ((1u << idx) - 1u)).count();
+  }
+
   int BranchNode::getType() const {
     return static_cast<int>(value ? PolkadotNode::Type::BranchWithValue
                                   : PolkadotNode::Type::BranchEmptyValue);
   }
 
   uint16_t BranchNode::childrenBitmap() const {
-    uint16_t bitmap = 0u;
-    for (auto i = 0u; i < kMaxChildren; i++) {
-      if (children.at(i)) {
-        bitmap = bitmap | 1u << i;
-      }
-    }
-    return bitmap;
+    return children.bitmap();
   }
 
   uint8_t BranchNode::childrenNum() const {
-    return std::count_if(children.begin(),
-                         children.end(),
-                         [](auto const &child) { return child; });
-    ;
+    return children.count();
   }
 
   int LeafNode::getType() const {
@@ -6,29 +6,270 @@
 #ifndef KAGOME_STORAGE_TRIE_POLKADOT_NODE
 #define KAGOME_STORAGE_TRIE_POLKADOT_NODE
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 
 #include "common/blob.hpp"
 #include "common/buffer.hpp"
+#include "common/memory_arena.hpp"
+#include "common/small_buffer.hpp"
+#include "outcome/outcome.hpp"
 #include "storage/trie/node.hpp"
 
 namespace kagome::storage::trie {
 
-  struct KeyNibbles : public common::Buffer {
+  /**
+   * Nibbles of a key, the ones of a 32-byte key are kept inline, as most of
+   * the keys and the partial keys of the nodes are not longer
+   */
+  struct KeyNibbles : public common::SmallBuffer<64> {
+    using Base = common::SmallBuffer<64>;
+
     KeyNibbles() = default;
 
-    explicit KeyNibbles(common::Buffer b) : Buffer{std::move(b)} {}
-    KeyNibbles(std::initializer_list<uint8_t> b)
-        : Buffer{b} {}
+    explicit KeyNibbles(Base b) : Base{std::move(b)} {}
+    explicit KeyNibbles(const common::Buffer &b) : Base{b} {}
+    KeyNibbles(std::initializer_list<uint8_t> b) : Base{b} {}
 
-    KeyNibbles &operator=(common::Buffer b) {
-      Buffer::operator=(std::move(b));
+    KeyNibbles &operator=(Base b) {
+      Base::operator=(std::move(b));
+      return *this;
+    }
+
+    KeyNibbles &operator=(const common::Buffer &b) {
+      Base::operator=(Base{b});
       return *this;
     }
 
     KeyNibbles subspan(size_t offset = 0, size_t length = -1) const {
-      return KeyNibbles{Buffer::subbuffer(offset, length)};
+      return KeyNibbles{subbuffer(offset, length)};
+    }
+  };
+
+  /**
+   * Nibbles of a key, which are not copied: either the ones of the bytes of
+   * a key, two in a byte and the high one first, or a part of KeyNibbles,
+   * one in a byte. The lookups go down the trie with the views of the rest
+   * of the key, so nothing is allocated between the root and the leaf
+   */
+  class NibbleView {
+   public:
+    NibbleView() = default;
+
+    NibbleView(const KeyNibbles &nibbles)  // NOLINT
+        : data_{nibbles.data()}, end_{nibbles.size()} {}
+
+    /**
+     * @return the view of the nibbles of the bytes of \arg key
+     */
+    static NibbleView ofKey(gsl::span<const uint8_t> key) {
+      NibbleView view;
+      view.data_ = key.data();
+      view.end_ = static_cast<size_t>(key.size()) * 2;
+      view.packed_ = true;
+      return view;
+    }
+
+    size_t size() const {
+      return end_ - begin_;
+    }
+
+    bool empty() const {
+      return begin_ == end_;
+    }
+
+    uint8_t operator[](size_t index) const {
+      auto i = begin_ + index;
+      if (not packed_) {
+        return data_[i];
+      }
+      return i % 2 == 0 ? data_[i / 2] >> 4u : data_[i / 2] & 0xfu;
+    }
+
+    /**
+     * Returns a part of the view, works alike subbuffer() of Buffer
+     */
+    NibbleView subview(size_t offset, size_t length = -1) const {
+      offset = std::min(offset, size());
+      auto view = *this;
+      view.begin_ += offset;
+      view.end_ = view.begin_ + std::min(length, size() - offset);
+      return view;
+    }
+
+    bool startsWith(const NibbleView &prefix) const {
+      return size() >= prefix.size()
+             and commonPrefixLength(*this, prefix) == prefix.size();
+    }
+
+    /**
+     * @return a copy of the nibbles, one in a byte
+     */
+    KeyNibbles toNibbles() const;
+
+    /**
+     * @return the number of the first nibbles \arg a and \arg b share. The
+     * views of the same layout are compared by whole bytes
+     */
+    static size_t commonPrefixLength(const NibbleView &a, const NibbleView &b);
+
+    friend bool operator==(const NibbleView &a, const NibbleView &b) {
+      return a.size() == b.size() and commonPrefixLength(a, b) == a.size();
     }
+
+    friend bool operator!=(const NibbleView &a, const NibbleView &b) {
+      return not(a == b);
+    }
+
+   private:
+    const uint8_t *data_ = nullptr;
+    // positions of the nibbles, the nibble i of the packed bytes is the
+    // one in the byte i / 2
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    bool packed_ = false;
+  };
+
+  /**
+   * Value of a node. The value is immutable once decoded or set, so the
+   * copies of a node, e.g. the ones of the node cache, share it instead of
+   * copying its bytes, and a value is assigned rather than modified in place.
+   * A large value may be left in the storage when its node is read, then it
+   * is read by the first load() of any of the copies.
+   * Mimics the interface of boost::optional<common::Buffer>, the bytes of a
+   * value are accessed that way only once it is loaded
+   */
+  class NodeValue {
+   public:
+    using Loader = std::function<outcome::result<common::Buffer>()>;
+
+    NodeValue() = default;
+
+    NodeValue(boost::none_t) {}  // NOLINT
+
+    NodeValue(common::Buffer value)  // NOLINT
+        : value_{std::make_shared<const common::Buffer>(std::move(value))} {}
+
+    NodeValue(boost::optional<common::Buffer> value) {  // NOLINT
+      if (value) {
+        value_ = std::make_shared<const common::Buffer>(std::move(*value));
+      }
+    }
+
+    /**
+     * @return a value, which is read by \arg loader once it is needed
+     */
+    static NodeValue lazy(Loader loader) {
+      NodeValue value;
+      value.lazy_ = std::make_shared<Lazy>();
+      value.lazy_->loader = std::move(loader);
+      return value;
+    }
+
+    bool has_value() const {
+      return value_ != nullptr or lazy_ != nullptr;
+    }
+
+    explicit operator bool() const {
+      return has_value();
+    }
+
+    bool isLoaded() const {
+      return loaded() != nullptr;
+    }
+
+    /**
+     * Reads the value if it is left in the storage, a failed read is
+     * repeated by the next call
+     * @return the bytes of the value, which has to be present
+     */
+    outcome::result<std::shared_ptr<const common::Buffer>> load() const {
+      BOOST_ASSERT(has_value());
+      if (value_ != nullptr) {
+        return value_;
+      }
+      std::lock_guard lock{lazy_->mutex};
+      if (lazy_->value == nullptr) {
+        OUTCOME_TRY(value, lazy_->loader());
+        lazy_->value = std::make_shared<const common::Buffer>(std::move(value));
+      }
+      return lazy_->value;
+    }
+
+    const common::Buffer &get() const {
+      auto value = loaded();
+      BOOST_ASSERT(value != nullptr);
+      // the loaded value is kept by the shared state as long as this one
+      return *value;
+    }
+
+    /**
+     * @throws boost::bad_optional_access if there is no loaded value
+     */
+    const common::Buffer &value() const {
+      if (not isLoaded()) {
+        throw boost::bad_optional_access{};
+      }
+      return get();
+    }
+
+    const common::Buffer &operator*() const {
+      return get();
+    }
+
+    const common::Buffer *operator->() const {
+      return &get();
+    }
+
+    /**
+     * @return a copy of the loaded value
+     */
+    boost::optional<common::Buffer> toOptional() const {
+      if (not has_value()) {
+        return boost::none;
+      }
+      return get();
+    }
+
+    /**
+     * The values, which are not loaded, are equal to their copies only
+     */
+    friend bool operator==(const NodeValue &a, const NodeValue &b) {
+      if (a.value_ == b.value_ and a.lazy_ == b.lazy_) {
+        return true;
+      }
+      auto a_value = a.loaded();
+      auto b_value = b.loaded();
+      return a_value != nullptr and b_value != nullptr and *a_value == *b_value;
+    }
+
+    friend bool operator!=(const NodeValue &a, const NodeValue &b) {
+      return not(a == b);
+    }
+
+   private:
+    // state shared by the copies of a value left in the storage
+    struct Lazy {
+      Loader loader;
+      std::mutex mutex;
+      std::shared_ptr<const common::Buffer> value;
+    };
+
+    std::shared_ptr<const common::Buffer> loaded() const {
+      if (value_ != nullptr or lazy_ == nullptr) {
+        return value_;
+      }
+      std::lock_guard lock{lazy_->mutex};
+      return lazy_->value;
+    }
+
+    std::shared_ptr<const common::Buffer> value_;
+    std::shared_ptr<Lazy> lazy_;
   };
 
   /**
@@ -39,7 +280,7 @@ namespace kagome::storage::trie {
 
   struct PolkadotNode : public Node {
     PolkadotNode() = default;
-    PolkadotNode(KeyNibbles key_nibbles, boost::optional<common::Buffer> value)
+    PolkadotNode(KeyNibbles key_nibbles, NodeValue value)
         : key_nibbles{std::move(key_nibbles)}, value{std::move(value)} {}
 
     ~PolkadotNode() override = default;
@@ -59,16 +300,113 @@ namespace kagome::storage::trie {
       return static_cast<Type>(getType());
     }
 
+    /**
+     * A node is dirty if it was modified since it was last read from or
+     * written to the storage, or if it has never been there
+     */
+    bool isDirty() const {
+      return not merkle_value.has_value();
+    }
+
+    void markDirty() {
+      merkle_value = boost::none;
+      calculated_merkle_value = boost::none;
+    }
+
     KeyNibbles key_nibbles;
-    boost::optional<common::Buffer> value;
+    NodeValue value;
+
+    // merkle value of the node as it is in the storage, none if the node is
+    // dirty, so that an unmodified node is never encoded and hashed again
+    boost::optional<common::Buffer> merkle_value;
+
+    // merkle value of the dirty node calculated without storing it, so that
+    // the root of a trie is calculated again only along the modified paths,
+    // none once the node is modified
+    boost::optional<common::Buffer> calculated_merkle_value;
+  };
+
+  /**
+   * Children of a branch node. Only the present children are kept, densely
+   * and in the order of their indices, together with a bitmap of occupied
+   * indices, so that a branch does not pay for all of its 16 slots when it
+   * has just a couple of children. The first few children are stored inline,
+   * without a separate allocation.
+   */
+  class BranchChildren {
+   public:
+    using NodePtr = std::shared_ptr<PolkadotNode>;
+    static constexpr size_t kMaxChildren = 16;
+    // most of the branches deep in a state trie have 2-4 children
+    static constexpr size_t kInlineChildren = 4;
+
+   private:
+    using Storage = boost::container::small_vector<NodePtr, kInlineChildren>;
+
+   public:
+    using iterator = Storage::iterator;
+    using const_iterator = Storage::const_iterator;
+
+    /**
+     * @return the child at \arg idx, a null pointer if there is no such child
+     * @throws std::out_of_range if \arg idx is not less than kMaxChildren
+     */
+    const NodePtr &at(size_t idx) const;
+
+    const NodePtr &operator[](size_t idx) const {
+      return at(idx);
+    }
+
+    /**
+     * Puts \arg child to \arg idx, a null pointer removes the child
+     * @throws std::out_of_range if \arg idx is not less than kMaxChildren
+     */
+    void set(size_t idx, NodePtr child);
+
+    /**
+     * @return number of slots for children, which is the same for any branch
+     */
+    constexpr size_t size() const {
+      return kMaxChildren;
+    }
+
+    uint16_t bitmap() const {
+      return bitmap_;
+    }
+
+    size_t count() const {
+      return nodes_.size();
+    }
+
+    // iterators go over the present children only, in the order of their
+    // indices. A child may be replaced through an iterator, but must not be
+    // reset to null, use set() to remove it instead
+    iterator begin() {
+      return nodes_.begin();
+    }
+    iterator end() {
+      return nodes_.end();
+    }
+    const_iterator begin() const {
+      return nodes_.begin();
+    }
+    const_iterator end() const {
+      return nodes_.end();
+    }
+
+   private:
+    // position of the child with \arg idx among the present children
+    size_t rankOf(size_t idx) const;
+
+    uint16_t bitmap_ = 0u;
+    Storage nodes_;
   };
 
   struct BranchNode : public PolkadotNode {
-    static constexpr int kMaxChildren = 16;
+    static constexpr int kMaxChildren = BranchChildren::kMaxChildren;
 
     BranchNode() = default;
-    explicit BranchNode(KeyNibbles key_nibbles,
-                        boost::optional<common::Buffer> value = boost::none)
+    explicit BranchNode(KeyNibbles key_nibbles, NodeValue value = boost::none)
         : PolkadotNode{std::move(key_nibbles), std::move(value)} {}
 
     ~BranchNode() override = default;
@@ -84,12 +422,12 @@ namespace kagome::storage::trie {
     // Has 1..16 children.
     // Stores their hashes to search for them in a storage and encode them more
     // easily.
-    std::array<std::shared_ptr<PolkadotNode>, kMaxChildren> children;
+    BranchChildren children;
   };
 
   struct LeafNode : public PolkadotNode {
     LeafNode() = default;
-    LeafNode(KeyNibbles key_nibbles, boost::optional<common::Buffer> value)
+    LeafNode(KeyNibbles key_nibbles, NodeValue value)
         : PolkadotNode{std::move(key_nibbles), std::move(value)} {}
 
     ~LeafNode() override = default;
@@ -126,6 +464,17 @@ namespace kagome::storage::trie {
     common::Buffer db_key;
   };
 
+  /**
+   * @return a new node, the memory of which is held by the arena of the
+   * trie nodes and is reused by the thread once it is freed
+   */
+  template <typename T, typename... Args>
+  std::shared_ptr<T> makeNode(Args &&...args) {
+    return std::allocate_shared<T>(
+        common::ArenaAllocator<T, common::MemoryArena::TRIE_NODES>{},
+        std::forward<Args>(args)...);
+  }
+
 }  // namespace kagome::storage::trie
 
 #endif  // KAGOME_STORAGE_TRIE_POLKADOT_NODE
@@ -7,7 +7,9 @@
 #define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_HPP
 
 #include "storage/face/generic_maps.hpp"
+#include "storage/trie/clear_prefix.hpp"
 
+#include "storage/trie/polkadot_trie/key_filter.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 
 namespace kagome::storage::trie {
@@ -26,6 +28,28 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<void> clearPrefix(const common::Buffer &prefix) = 0;
 
+    /**
+     * Remove at most \arg limit trie entries which key begins with the
+     * supplied prefix, so that the work is bounded
+     */
+    virtual outcome::result<ClearPrefixResult> clearPrefix(
+        const common::Buffer &prefix, uint32_t limit) = 0;
+
+    /**
+     * Looks up values of all \arg keys at once, visiting the nodes common to
+     * paths of several keys only once
+     * @return values in the order of the keys, none for absent keys
+     */
+    virtual outcome::result<std::vector<boost::optional<common::Buffer>>>
+    getMany(gsl::span<const common::Buffer> keys) const = 0;
+
+    /**
+     * Sets a filter, which has seen all the keys of the trie, so that
+     * lookups of the keys it has never seen skip the trie. The keys put to
+     * the trie are added to the filter from then on
+     */
+    virtual void setKeyFilter(std::shared_ptr<KeyFilter> filter) = 0;
+
     /**
      * @return the root node of the trie
      */
@@ -35,7 +59,7 @@ namespace kagome::storage::trie {
      * @returns a child node pointer of a provided \arg parent node
      * at the index \idx
      */
-    virtual outcome::result<NodePtr> retrieveChild(BranchPtr parent,
+    virtual outcome::result<NodePtr> retrieveChild(const BranchPtr &parent,
                                                    uint8_t idx) const = 0;
 
     // TODO(Harrm) Make key nibbles type distinguishable with just key
@@ -43,15 +67,15 @@ namespace kagome::storage::trie {
      * @returns a node which is a descendant of \arg parent found by following
      * \arg key_nibbles
      */
-    virtual outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+    virtual outcome::result<NodePtr> getNode(const NodePtr &parent,
+                                             NibbleView key_nibbles) const = 0;
 
     /**
      * @returns a sequence of nodes in between \arg parent and the node found by
      * following \arg key_nibbles. The parent is included, the end node isn't.
      */
     virtual outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const = 0;
+        const NodePtr &parent, NibbleView key_nibbles) const = 0;
   };
 
 }  // namespace kagome::storage::trie
@@ -5,6 +5,8 @@
 
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 
+#include <algorithm>
+
 #include "common/buffer_back_insert_iterator.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
 
@@ -36,17 +38,17 @@ namespace kagome::storage::trie {
   PolkadotTrieCursor::createAt(const common::Buffer &key, const PolkadotTrie &trie) {
     auto c = std::make_unique<PolkadotTrieCursor>(trie);
     OUTCOME_TRY(node,
-                trie.getNode(trie.getRoot(), c->codec_.keyToNibbles(key)));
+                trie.getNode(trie.getRoot(), NibbleView::ofKey(key)));
     c->visited_root_ = true;  // root is always visited first
     c->current_ = node;
-    OUTCOME_TRY(last_child_path, c->constructLastVisitedChildPath(key));
-    c->last_visited_child_ = std::move(last_child_path);
+    OUTCOME_TRY(c->constructLastVisitedChildPath(key));
 
     return c;
   }
 
   outcome::result<void> PolkadotTrieCursor::seekToFirst() {
     visited_root_ = false;
+    clearPath();
     current_ = trie_.getRoot();
     return next();
   }
@@ -57,21 +59,77 @@ namespace kagome::storage::trie {
       return Error::NULL_ROOT;
     }
     visited_root_ = true;  // root is always visited first
-    OUTCOME_TRY(last_child_path, constructLastVisitedChildPath(key));
     auto nibbles = PolkadotCodec::keyToNibbles(key);
     OUTCOME_TRY(node, trie_.getNode(trie_.getRoot(), nibbles));
 
     bool node_has_value = node != nullptr and node->value.has_value();
-    if (node_has_value) {
-      current_ = node;
-    } else {
+    if (not node_has_value) {
       current_ = nullptr;
       return Error::NOT_FOUND;
     }
-    last_visited_child_ = std::move(last_child_path);
+    OUTCOME_TRY(constructLastVisitedChildPath(key));
+    current_ = node;
     return outcome::success();
   }
 
+  outcome::result<void> PolkadotTrieCursor::seekUpperBound(
+      const common::Buffer &key) {
+    visited_root_ = true;  // root is always visited first
+    clearPath();
+    current_ = nullptr;
+    NodePtr node = trie_.getRoot();
+    if (node == nullptr) {
+      return outcome::success();
+    }
+    auto nibbles = PolkadotCodec::keyToNibbles(key);
+    size_t offset = 0;
+    while (true) {
+      const auto &node_key = node->key_nibbles;
+      const auto rest_size = nibbles.size() - offset;
+      const auto common_size = std::min(node_key.size(), rest_size);
+      auto [node_it, key_it] =
+          std::mismatch(node_key.begin(),
+                        node_key.begin() + common_size,
+                        nibbles.begin() + offset);
+      if (node_it != node_key.begin() + common_size) {
+        // the whole subtree is either before or after the key
+        return *node_it > *key_it ? seekFirstInSubtree(node)
+                                  : seekAfterSubtree(node);
+      }
+      if (node_key.size() > rest_size) {
+        // the key is a prefix of every key in the subtree
+        return seekFirstInSubtree(node);
+      }
+      if (node_key.size() == rest_size) {
+        // the node matches the key, so the next node in order is the sought
+        // one
+        current_ = node;
+        return next();
+      }
+      // the key of the node is a proper prefix of the sought key
+      auto type = node->getTrieType();
+      if (type != NodeType::BranchEmptyValue
+          and type != NodeType::BranchWithValue) {
+        return seekAfterSubtree(node);
+      }
+      auto branch = std::static_pointer_cast<BranchNode>(node);
+      auto idx = nibbles[offset + node_key.size()];
+      if (branch->children.at(idx) == nullptr) {
+        auto next_idx = getNextChildIdx(branch, idx);
+        if (next_idx == -1) {
+          return seekAfterSubtree(node);
+        }
+        pushPathEntry(branch, next_idx);
+        OUTCOME_TRY(child, trie_.retrieveChild(branch, next_idx));
+        return seekFirstInSubtree(child);
+      }
+      pushPathEntry(branch, idx);
+      OUTCOME_TRY(child, trie_.retrieveChild(branch, idx));
+      offset += node_key.size() + 1;
+      node = std::move(child);
+    }
+  }
+
   outcome::result<void> PolkadotTrieCursor::seekToLast() {
     NodePtr current = trie_.getRoot();
     if (current == nullptr) {
@@ -79,21 +137,19 @@ namespace kagome::storage::trie {
       return Error::NULL_ROOT;
     }
     visited_root_ = true;  // root is always visited first
-    last_visited_child_.clear();
+    clearPath();
     // find the rightmost leaf
     while (current->getTrieType() != NodeType::Leaf) {
       auto type = current->getTrieType();
       if (type == NodeType::BranchEmptyValue
           or type == NodeType::BranchWithValue) {
-        auto branch = std::dynamic_pointer_cast<BranchNode>(current);
+        auto branch = std::static_pointer_cast<BranchNode>(current);
         // find the rightmost child
-        for (int8_t i = branch->kMaxChildren - 1; i >= 0; i--) {
-          if (branch->children.at(i) != nullptr) {
-            OUTCOME_TRY(c, trie_.retrieveChild(branch, i));
-            last_visited_child_.emplace_back(branch, i);
-            current = c;
-          }
-        }
+        auto i = getPrevChildIdx(branch, branch->kMaxChildren);
+        BOOST_ASSERT_MSG(i != -1, "a branch node always has children");
+        OUTCOME_TRY(c, trie_.retrieveChild(branch, i));
+        pushPathEntry(branch, i);
+        current = c;
 
       } else {
         BOOST_ASSERT_MSG(
@@ -132,7 +188,7 @@ namespace kagome::storage::trie {
         // assert last_visited_child_.back() == current.parent
         auto p = last_visited_child_.back().parent;  // self.current.parent
         while (not hasNextChild(p, last_visited_child_.back().child_idx)) {
-          last_visited_child_.pop_back();
+          popPathEntry();
           if (last_visited_child_.empty()) {
             current_ = nullptr;
             return outcome::success();
@@ -146,13 +202,13 @@ namespace kagome::storage::trie {
 
       } else if (current_->getTrieType() == NodeType::BranchEmptyValue
                  or current_->getTrieType() == NodeType::BranchWithValue) {
-        auto p = std::dynamic_pointer_cast<BranchNode>(current_);
+        auto p = std::static_pointer_cast<BranchNode>(current_);
         if (last_visited_child_.empty()
             or last_visited_child_.back().parent != p) {
-          last_visited_child_.emplace_back(p, -1);
+          pushPathEntry(p, -1);
         }
         while (not hasNextChild(p, last_visited_child_.back().child_idx)) {
-          last_visited_child_.pop_back();
+          popPathEntry();
           if (last_visited_child_.empty()) {
             current_ = nullptr;
             return outcome::success();
@@ -175,15 +231,8 @@ namespace kagome::storage::trie {
 
   common::Buffer PolkadotTrieCursor::collectKey() const {
     KeyNibbles key_nibbles;
-    for (auto &node_idx : last_visited_child_) {
-      auto &node = node_idx.parent;
-      auto idx = node_idx.child_idx;
-      std::copy(node->key_nibbles.begin(),
-                node->key_nibbles.end(),
-                std::back_inserter<Buffer>(key_nibbles));
-      key_nibbles.putUint8(idx);
-    }
-    key_nibbles.put(current_->key_nibbles);
+    key_nibbles.reserve(path_key_.size() + current_->key_nibbles.size());
+    key_nibbles.putBuffer(path_key_).putBuffer(current_->key_nibbles);
     return codec_.nibblesToKey(key_nibbles);
   }
 
@@ -196,14 +245,15 @@ namespace kagome::storage::trie {
 
   outcome::result<common::Buffer> PolkadotTrieCursor::value() const {
     if (current_ != nullptr) {
-      return current_->value.value();
+      OUTCOME_TRY(value, current_->value.load());
+      return *value;
     }
     return Error::INVALID_CURSOR_POSITION;
   }
 
   int8_t PolkadotTrieCursor::getNextChildIdx(const BranchPtr &parent,
-                                             uint8_t child_idx) {
-    for (uint8_t i = child_idx + 1; i < parent->kMaxChildren; i++) {
+                                             int8_t child_idx) {
+    for (int8_t i = child_idx + 1; i < parent->kMaxChildren; i++) {
       if (parent->children.at(i) != nullptr) {
         return i;
       }
@@ -212,12 +262,12 @@ namespace kagome::storage::trie {
   }
 
   bool PolkadotTrieCursor::hasNextChild(const BranchPtr &parent,
-                                          uint8_t child_idx) {
+                                        int8_t child_idx) {
     return getNextChildIdx(parent, child_idx) != -1;
   }
 
   int8_t PolkadotTrieCursor::getPrevChildIdx(const BranchPtr &parent,
-                                             uint8_t child_idx) {
+                                             int8_t child_idx) {
     for (int8_t i = child_idx - 1; i >= 0; i--) {
       if (parent->children.at(i) != nullptr) {
         return i;
@@ -227,29 +277,75 @@ namespace kagome::storage::trie {
   }
 
   bool PolkadotTrieCursor::hasPrevChild(const BranchPtr &parent,
-                                          uint8_t child_idx) {
+                                        int8_t child_idx) {
     return getPrevChildIdx(parent, child_idx) != -1;
   }
 
   void PolkadotTrieCursor::updateLastVisitedChild(const BranchPtr &parent,
-                                                  uint8_t child_idx) {
-    if (last_visited_child_.back().parent == parent) {
-      last_visited_child_.pop_back();
+                                                  int8_t child_idx) {
+    if (not last_visited_child_.empty()
+        and last_visited_child_.back().parent == parent) {
+      last_visited_child_.back().child_idx = child_idx;
+      path_key_[path_key_.size() - 1] = child_idx;
+      return;
     }
+    pushPathEntry(parent, child_idx);
+  }
+
+  void PolkadotTrieCursor::pushPathEntry(const BranchPtr &parent,
+                                         int8_t child_idx) {
     last_visited_child_.emplace_back(parent, child_idx);
+    // an entry which doesn't point to a child yet gets a placeholder nibble
+    path_key_.putBuffer(parent->key_nibbles)
+        .putUint8(child_idx < 0 ? 0 : child_idx);
   }
 
-  auto PolkadotTrieCursor::constructLastVisitedChildPath(
-      const common::Buffer &key)
-      -> outcome::result<
-          std::list<TriePathEntry>> {
-    OUTCOME_TRY(path, trie_.getPath(trie_.getRoot(), codec_.keyToNibbles(key)));
-    std::list<TriePathEntry>
-        last_visited_child;
+  void PolkadotTrieCursor::popPathEntry() {
+    BOOST_ASSERT(not last_visited_child_.empty());
+    auto entry_key_size =
+        last_visited_child_.back().parent->key_nibbles.size() + 1;
+    BOOST_ASSERT(path_key_.size() >= entry_key_size);
+    path_key_.resize(path_key_.size() - entry_key_size);
+    last_visited_child_.pop_back();
+  }
+
+  void PolkadotTrieCursor::clearPath() {
+    last_visited_child_.clear();
+    path_key_.clear();
+  }
+
+  outcome::result<void> PolkadotTrieCursor::constructLastVisitedChildPath(
+      const common::Buffer &key) {
+    OUTCOME_TRY(path, trie_.getPath(trie_.getRoot(), NibbleView::ofKey(key)));
+    clearPath();
+    last_visited_child_.reserve(path.size());
     for (auto &&[branch, idx] : path) {
-      last_visited_child.emplace_back(branch, idx);
+      pushPathEntry(branch, idx);
     }
-    return last_visited_child;
+    return outcome::success();
+  }
+
+  outcome::result<void> PolkadotTrieCursor::seekFirstInSubtree(
+      const NodePtr &node) {
+    current_ = node;
+    if (node->value.has_value()) {
+      return outcome::success();
+    }
+    // a node without a value is a branch, which is followed by its children
+    return next();
+  }
+
+  outcome::result<void> PolkadotTrieCursor::seekAfterSubtree(
+      const NodePtr &node) {
+    current_ = node;
+    auto type = node->getTrieType();
+    if (type == NodeType::BranchEmptyValue
+        or type == NodeType::BranchWithValue) {
+      // mark all children of the branch as visited
+      pushPathEntry(std::static_pointer_cast<BranchNode>(node),
+                    BranchNode::kMaxChildren - 1);
+    }
+    return next();
   }
 
 }  // namespace kagome::storage::trie
@@ -8,6 +8,8 @@
 
 #include "storage/face/map_cursor.hpp"
 
+#include <vector>
+
 #include "common/buffer.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
@@ -39,6 +41,7 @@ namespace kagome::storage::trie {
 
     outcome::result<void> seekToFirst() override;
     outcome::result<void> seek(const common::Buffer &key) override;
+    outcome::result<void> seekUpperBound(const common::Buffer &key) override;
     outcome::result<void> seekToLast() override;
     bool isValid() const override;
     outcome::result<void> next() override;
@@ -47,15 +50,15 @@ namespace kagome::storage::trie {
     outcome::result<common::Buffer> value() const override;
 
    private:
-    static int8_t getNextChildIdx(const BranchPtr &parent, uint8_t child_idx);
-    static bool hasNextChild(const BranchPtr &parent, uint8_t child_idx);
+    static int8_t getNextChildIdx(const BranchPtr &parent, int8_t child_idx);
+    static bool hasNextChild(const BranchPtr &parent, int8_t child_idx);
 
-    static int8_t getPrevChildIdx(const BranchPtr &parent, uint8_t child_idx);
-    static bool hasPrevChild(const BranchPtr &parent, uint8_t child_idx);
+    static int8_t getPrevChildIdx(const BranchPtr &parent, int8_t child_idx);
+    static bool hasPrevChild(const BranchPtr &parent, int8_t child_idx);
 
     // will either put a new entry or update the top entry (in case that parent
     // in the top entry is the same as \param parent
-    void updateLastVisitedChild(const BranchPtr &parent, uint8_t child_idx);
+    void updateLastVisitedChild(const BranchPtr &parent, int8_t child_idx);
 
     /**
      * An element of a path in trie. A node that is a part of the path and the
@@ -69,11 +72,33 @@ namespace kagome::storage::trie {
     };
 
     /**
-     * Constructs a list of branch nodes on the path from the root to the node
-     * with the given \arg key
+     * Path modifiers, which keep the key of the path in sync with the path
+     * itself, so that the key of the current node is never collected from
+     * scratch
+     */
+    void pushPathEntry(const BranchPtr &parent, int8_t child_idx);
+    void popPathEntry();
+    void clearPath();
+
+    /**
+     * Constructs the path of branch nodes from the root to the node with the
+     * given \arg key
+     */
+    outcome::result<void> constructLastVisitedChildPath(
+        const common::Buffer &key);
+
+    /**
+     * Makes the first node with a value in the subtree of \arg node current
+     * @note the path must lead to \arg node
+     */
+    outcome::result<void> seekFirstInSubtree(const NodePtr &node);
+
+    /**
+     * Makes the first node with a value after the subtree of \arg node
+     * current
+     * @note the path must lead to \arg node
      */
-    auto constructLastVisitedChildPath(const common::Buffer &key)
-        -> outcome::result<std::list<TriePathEntry>>;
+    outcome::result<void> seekAfterSubtree(const NodePtr &node);
 
     common::Buffer collectKey() const;
 
@@ -81,7 +106,10 @@ namespace kagome::storage::trie {
     PolkadotCodec codec_;
     NodePtr current_;
     bool visited_root_ = false;
-    std::list<TriePathEntry> last_visited_child_;
+    std::vector<TriePathEntry> last_visited_child_;
+    // nibbles of the key prefix which the path leads to; every entry
+    // contributes the key of its parent node and the index of its child
+    KeyNibbles path_key_;
   };
 
 }  // namespace kagome::storage::trie
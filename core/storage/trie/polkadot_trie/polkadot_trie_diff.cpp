@@ -0,0 +1,198 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/polkadot_trie_diff.hpp"
+
+#include "storage/trie/serialization/polkadot_codec.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+
+    using NodePtr = PolkadotTrie::NodePtr;
+    using BranchPtr = PolkadotTrie::BranchPtr;
+
+    /**
+     * A subtree of a trie: the node as it is kept by its parent, possibly a
+     * dummy one, and the nibbles of the path to it, not including its own
+     * key nibbles
+     */
+    struct Subtree {
+      NodePtr node;
+      BranchPtr parent;
+      uint8_t idx = 0;
+      KeyNibbles prefix;
+    };
+
+    /**
+     * @return merkle value of \arg node as it is in the storage, null if
+     * the node is modified since it was retrieved
+     */
+    const common::Buffer *merkleValueOf(const PolkadotNode &node) {
+      if (node.isDummy()) {
+        return &static_cast<const DummyNode &>(node).db_key;
+      }
+      return node.merkle_value ? &*node.merkle_value : nullptr;
+    }
+
+    class TrieDiff {
+     public:
+      TrieDiff(const PolkadotTrie &old_trie,
+               const PolkadotTrie &new_trie,
+               const TrieDiffCallback &on_entry)
+          : old_trie_{old_trie}, new_trie_{new_trie}, on_entry_{on_entry} {}
+
+      outcome::result<void> diff(const Subtree &old_tree,
+                                 const Subtree &new_tree) const {
+        if (old_tree.node == nullptr and new_tree.node == nullptr) {
+          return outcome::success();
+        }
+        if (old_tree.node == nullptr) {
+          return enumerate(new_trie_, new_tree, false);
+        }
+        if (new_tree.node == nullptr) {
+          return enumerate(old_trie_, old_tree, true);
+        }
+        if (old_tree.prefix == new_tree.prefix) {
+          auto old_merkle = merkleValueOf(*old_tree.node);
+          auto new_merkle = merkleValueOf(*new_tree.node);
+          if (old_merkle != nullptr and new_merkle != nullptr
+              and *old_merkle == *new_merkle) {
+            return outcome::success();
+          }
+        }
+        OUTCOME_TRY(old_node, load(old_trie_, old_tree));
+        OUTCOME_TRY(new_node, load(new_trie_, new_tree));
+        auto old_path = pathOf(old_tree.prefix, *old_node);
+        auto new_path = pathOf(new_tree.prefix, *new_node);
+        auto common = NibbleView::commonPrefixLength(old_path, new_path);
+
+        if (common == old_path.size() and common == new_path.size()) {
+          OUTCOME_TRY(emit(old_path, old_node->value, new_node->value));
+          for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+            OUTCOME_TRY(diff(childOf(old_node, old_path, idx),
+                             childOf(new_node, new_path, idx)));
+          }
+          return outcome::success();
+        }
+        // the node with the shorter path is above the other one, which is
+        // then compared to its child on the way
+        if (common == old_path.size()) {
+          OUTCOME_TRY(emit(old_path, old_node->value, boost::none));
+          for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+            OUTCOME_TRY(diff(childOf(old_node, old_path, idx),
+                             idx == new_path[common] ? new_tree : Subtree{}));
+          }
+          return outcome::success();
+        }
+        if (common == new_path.size()) {
+          OUTCOME_TRY(emit(new_path, boost::none, new_node->value));
+          for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+            OUTCOME_TRY(diff(idx == old_path[common] ? old_tree : Subtree{},
+                             childOf(new_node, new_path, idx)));
+          }
+          return outcome::success();
+        }
+        // the paths diverge, so the tries share no keys here
+        if (old_path[common] < new_path[common]) {
+          OUTCOME_TRY(enumerate(old_trie_, old_tree, true));
+          return enumerate(new_trie_, new_tree, false);
+        }
+        OUTCOME_TRY(enumerate(new_trie_, new_tree, false));
+        return enumerate(old_trie_, old_tree, true);
+      }
+
+     private:
+      /**
+       * Emits all the keys of \arg tree as removed or as added ones
+       */
+      outcome::result<void> enumerate(const PolkadotTrie &trie,
+                                      const Subtree &tree,
+                                      bool removed) const {
+        OUTCOME_TRY(node, load(trie, tree));
+        auto path = pathOf(tree.prefix, *node);
+        if (removed) {
+          OUTCOME_TRY(emit(path, node->value, boost::none));
+        } else {
+          OUTCOME_TRY(emit(path, boost::none, node->value));
+        }
+        for (uint8_t idx = 0; idx < BranchNode::kMaxChildren; ++idx) {
+          if (auto child = childOf(node, path, idx); child.node != nullptr) {
+            OUTCOME_TRY(enumerate(trie, child, removed));
+          }
+        }
+        return outcome::success();
+      }
+
+      static outcome::result<NodePtr> load(const PolkadotTrie &trie,
+                                           const Subtree &tree) {
+        if (tree.node->isDummy()) {
+          return trie.retrieveChild(tree.parent, tree.idx);
+        }
+        return tree.node;
+      }
+
+      static KeyNibbles pathOf(const KeyNibbles &prefix,
+                               const PolkadotNode &node) {
+        KeyNibbles path;
+        path.reserve(prefix.size() + node.key_nibbles.size());
+        path.putBuffer(prefix).putBuffer(node.key_nibbles);
+        return path;
+      }
+
+      static Subtree childOf(const NodePtr &node,
+                             const KeyNibbles &path,
+                             uint8_t idx) {
+        using T = PolkadotNode::Type;
+        auto type = node->getTrieType();
+        if (type != T::BranchEmptyValue and type != T::BranchWithValue) {
+          return {};
+        }
+        auto branch = std::static_pointer_cast<BranchNode>(node);
+        auto &child = branch->children.at(idx);
+        if (child == nullptr) {
+          return {};
+        }
+        Subtree tree{child, branch, idx, path};
+        tree.prefix.putUint8(idx);
+        return tree;
+      }
+
+      outcome::result<void> emit(const KeyNibbles &path,
+                                 const NodeValue &old_value,
+                                 const NodeValue &new_value) const {
+        // the values shared by the nodes are compared without their bytes,
+        // the ones left in the storage are read only if they may differ
+        if (old_value == new_value) {
+          return outcome::success();
+        }
+        for (auto *value : {&old_value, &new_value}) {
+          if (value->has_value()) {
+            OUTCOME_TRY(value->load());
+          }
+        }
+        if (old_value != new_value) {
+          on_entry_({PolkadotCodec::nibblesToKey(path),
+                     old_value.toOptional(),
+                     new_value.toOptional()});
+        }
+        return outcome::success();
+      }
+
+      const PolkadotTrie &old_trie_;
+      const PolkadotTrie &new_trie_;
+      const TrieDiffCallback &on_entry_;
+    };
+
+  }  // namespace
+
+  outcome::result<void> diffTries(const PolkadotTrie &old_trie,
+                                  const PolkadotTrie &new_trie,
+                                  const TrieDiffCallback &on_entry) {
+    return TrieDiff{old_trie, new_trie, on_entry}.diff(
+        Subtree{old_trie.getRoot()}, Subtree{new_trie.getRoot()});
+  }
+
+}  // namespace kagome::storage::trie
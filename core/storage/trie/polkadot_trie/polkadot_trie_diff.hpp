@@ -0,0 +1,43 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_POLKADOT_TRIE_DIFF_HPP
+#define KAGOME_STORAGE_TRIE_POLKADOT_TRIE_DIFF_HPP
+
+#include <functional>
+
+#include "storage/trie/polkadot_trie/polkadot_trie.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * A key, the value of which differs in two tries
+   */
+  struct TrieDiffEntry {
+    common::Buffer key;
+    // none if the key is added
+    boost::optional<common::Buffer> old_value;
+    // none if the key is removed
+    boost::optional<common::Buffer> new_value;
+  };
+
+  using TrieDiffCallback = std::function<void(TrieDiffEntry)>;
+
+  /**
+   * Calls \arg on_entry with each key added, removed or changed in
+   * \arg new_trie compared to \arg old_trie, in the order of the keys. The
+   * tries are walked down together, and the subtrees found at the same path
+   * with the same merkle values are skipped without being retrieved, so the
+   * cost is proportional to the size of the difference rather than to the
+   * size of the tries. The tries are best retrieved immutable, so that the
+   * walk does not attach the nodes it visits to them
+   */
+  outcome::result<void> diffTries(const PolkadotTrie &old_trie,
+                                  const PolkadotTrie &new_trie,
+                                  const TrieDiffCallback &on_entry);
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_POLKADOT_TRIE_DIFF_HPP
@@ -14,7 +14,7 @@ namespace kagome::storage::trie {
    public:
     using ChildRetrieveFunctor =
         std::function<outcome::result<PolkadotTrie::NodePtr>(
-            PolkadotTrie::BranchPtr, uint8_t)>;
+            const PolkadotTrie::BranchPtr &, uint8_t)>;
 
    protected:
     static outcome::result<PolkadotTrie::NodePtr> defaultChildRetriever(
@@ -5,6 +5,7 @@
 
 #include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 
@@ -39,21 +40,29 @@ namespace kagome::storage::trie {
     return put(key, std::move(value_copy));
   }
 
+  void PolkadotTrieImpl::setKeyFilter(std::shared_ptr<KeyFilter> filter) {
+    key_filter_ = std::move(filter);
+  }
+
   PolkadotTrie::NodePtr PolkadotTrieImpl::getRoot() const {
     return root_;
   }
 
   outcome::result<void> PolkadotTrieImpl::put(const Buffer &key,
                                               Buffer &&value) {
-    auto k_enc = PolkadotCodec::keyToNibbles(key);
-
+    if (key_filter_ != nullptr) {
+      key_filter_->add(key);
+    }
     NodePtr root = root_;
 
     // insert fetches a sequence of nodes (a path) from the storage and
     // these nodes are processed in memory, so any changes applied to them
-    // will be written back to the storage only on storeNode call
+    // will be written back to the storage only on storeNode call; the leaf
+    // gets its partial key there
     OUTCOME_TRY(n,
-                insert(root, k_enc, std::make_shared<LeafNode>(k_enc, value)));
+                insert(root,
+                       NibbleView::ofKey(key),
+                       makeNode<LeafNode>(KeyNibbles{}, std::move(value))));
     root_ = n;
 
     return outcome::success();
@@ -64,41 +73,47 @@ namespace kagome::storage::trie {
     if (not root_) {
       return outcome::success();
     }
-    auto key_nibbles = PolkadotCodec::keyToNibbles(prefix);
-    OUTCOME_TRY(new_root, detachNode(root_, key_nibbles));
+    OUTCOME_TRY(new_root, detachNode(root_, NibbleView::ofKey(prefix)));
     root_ = new_root;
 
     return outcome::success();
   }
 
+  outcome::result<ClearPrefixResult> PolkadotTrieImpl::clearPrefix(
+      const common::Buffer &prefix, uint32_t limit) {
+    return clearPrefixLimited(*this, prefix, limit);
+  }
+
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::insert(
-      const NodePtr &parent, const KeyNibbles &key_nibbles, NodePtr node) {
+      const NodePtr &parent, NibbleView key_nibbles, NodePtr node) {
     using T = PolkadotNode::Type;
 
     // just update the node key and return it as the new root
     if (parent == nullptr) {
-      node->key_nibbles = key_nibbles;
+      node->key_nibbles = key_nibbles.toNibbles();
+      node->markDirty();
       return node;
     }
 
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         return updateBranch(parent_as_branch, key_nibbles, node);
       }
       case T::Leaf: {
         // need to convert this leaf into a branch
-        auto br = std::make_shared<BranchNode>();
-        auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
+        auto br = makeNode<BranchNode>();
+        auto length =
+            NibbleView::commonPrefixLength(key_nibbles, parent->key_nibbles);
 
         if (parent->key_nibbles == key_nibbles
             && key_nibbles.size() == length) {
-          node->key_nibbles = key_nibbles;
+          node->key_nibbles = key_nibbles.toNibbles();
           return node;
         }
 
-        br->key_nibbles = key_nibbles.subbuffer(0, length);
+        br->key_nibbles = key_nibbles.subview(0, length).toNibbles();
         auto parentKey = parent->key_nibbles;
 
         // value goes at this branch
@@ -109,25 +124,27 @@ namespace kagome::storage::trie {
           // child to the new branch
           if (parent->key_nibbles.size() > key_nibbles.size()) {
             parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-            br->children.at(parentKey[length]) = parent;
+            parent->markDirty();
+            br->children.set(parentKey[length], parent);
           }
 
           return br;
         }
 
-        node->key_nibbles = key_nibbles.subbuffer(length + 1);
+        node->key_nibbles = key_nibbles.subview(length + 1).toNibbles();
 
         if (length == parent->key_nibbles.size()) {
           // if leaf's key is covered by this branch, then make the leaf's
           // value the value at this branch
           br->value = parent->value;
-          br->children.at(key_nibbles[length]) = node;
+          br->children.set(key_nibbles[length], node);
         } else {
           // otherwise, make the leaf a child of the branch and update its
           // partial key
           parent->key_nibbles = parent->key_nibbles.subbuffer(length + 1);
-          br->children.at(parentKey[length]) = parent;
-          br->children.at(key_nibbles[length]) = node;
+          parent->markDirty();
+          br->children.set(parentKey[length], parent);
+          br->children.set(key_nibbles[length], node);
         }
 
         return br;
@@ -138,12 +155,13 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::updateBranch(
-      BranchPtr parent,
-      const KeyNibbles &key_nibbles,
-      const NodePtr &node) {
-    auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
+      const BranchPtr &parent, NibbleView key_nibbles, const NodePtr &node) {
+    auto length =
+        NibbleView::commonPrefixLength(key_nibbles, parent->key_nibbles);
 
     if (length == parent->key_nibbles.size()) {
+      // the parent is on the path to the node and is modified in any case
+      parent->markDirty();
       // just set the value in the parent to the node value
       if (key_nibbles == parent->key_nibbles) {
         parent->value = node->value;
@@ -151,45 +169,129 @@ namespace kagome::storage::trie {
       }
       OUTCOME_TRY(child, retrieveChild(parent, key_nibbles[length]));
       if (child) {
-        OUTCOME_TRY(n, insert(child, key_nibbles.subspan(length + 1), node));
-        parent->children.at(key_nibbles[length]) = n;
+        OUTCOME_TRY(n, insert(child, key_nibbles.subview(length + 1), node));
+        parent->children.set(key_nibbles[length], n);
         return parent;
       }
-      node->key_nibbles = key_nibbles.subbuffer(length + 1);
-      parent->children.at(key_nibbles[length]) = node;
+      node->key_nibbles = key_nibbles.subview(length + 1).toNibbles();
+      parent->children.set(key_nibbles[length], node);
       return parent;
     }
-    auto br = std::make_shared<BranchNode>(key_nibbles.subspan(0, length));
+    auto br =
+        makeNode<BranchNode>(key_nibbles.subview(0, length).toNibbles());
     auto parentIdx = parent->key_nibbles[length];
-    OUTCOME_TRY(
-        new_branch,
-        insert(nullptr, parent->key_nibbles.subspan(length + 1), parent));
-    br->children.at(parentIdx) = new_branch;
+    OUTCOME_TRY(new_branch,
+                insert(nullptr,
+                       NibbleView{parent->key_nibbles}.subview(length + 1),
+                       parent));
+    br->children.set(parentIdx, new_branch);
     if (key_nibbles.size() <= length) {
       br->value = node->value;
     } else {
       OUTCOME_TRY(new_child,
-                  insert(nullptr, key_nibbles.subspan(length + 1), node));
-      br->children.at(key_nibbles[length]) = new_child;
+                  insert(nullptr, key_nibbles.subview(length + 1), node));
+      br->children.set(key_nibbles[length], new_child);
     }
     return br;
   }
 
   outcome::result<common::Buffer> PolkadotTrieImpl::get(
       const common::Buffer &key) const {
-    if (not root_) {
+    if (not root_ or not mayContain(key)) {
       return TrieError::NO_VALUE;
     }
-    auto nibbles = PolkadotCodec::keyToNibbles(key);
-    OUTCOME_TRY(node, getNode(root_, nibbles));
+    OUTCOME_TRY(node, getNode(root_, NibbleView::ofKey(key)));
     if (node && node->value) {
-      return node->value.get();
+      OUTCOME_TRY(value, node->value.load());
+      return *value;
     }
     return TrieError::NO_VALUE;
   }
 
+  outcome::result<std::vector<boost::optional<common::Buffer>>>
+  PolkadotTrieImpl::getMany(gsl::span<const common::Buffer> keys) const {
+    std::vector<boost::optional<common::Buffer>> values(keys.size());
+    if (not root_ or keys.empty()) {
+      return std::move(values);
+    }
+    std::vector<Lookup> lookups;
+    lookups.reserve(keys.size());
+    for (size_t i = 0; i < static_cast<size_t>(keys.size()); i++) {
+      if (mayContain(keys[i])) {
+        lookups.emplace_back(NibbleView::ofKey(keys[i]), i);
+      }
+    }
+    if (lookups.empty()) {
+      return std::move(values);
+    }
+    // keys sharing a path in the trie become adjacent, the order of the
+    // bytes of the keys is the one of their nibbles
+    std::sort(lookups.begin(),
+              lookups.end(),
+              [&](const Lookup &lhs, const Lookup &rhs) {
+                return keys[lhs.second] < keys[rhs.second];
+              });
+    OUTCOME_TRY(lookUpMany(root_, 0, lookups.cbegin(), lookups.cend(), values));
+    return std::move(values);
+  }
+
+  outcome::result<void> PolkadotTrieImpl::lookUpMany(
+      const NodePtr &node,
+      size_t offset,
+      LookupIt begin,
+      LookupIt end,
+      std::vector<boost::optional<common::Buffer>> &values) const {
+    using T = PolkadotNode::Type;
+    auto &partial_key = node->key_nibbles;
+    auto children_offset = offset + partial_key.size();
+    // whether a key goes through the node, and not just through its parent
+    auto passes_node = [&](const NibbleView &key) {
+      return key.size() >= children_offset
+             and key.subview(offset).startsWith(partial_key);
+    };
+    bool is_branch = node->getTrieType() == T::BranchEmptyValue
+                     or node->getTrieType() == T::BranchWithValue;
+
+    auto it = begin;
+    while (it != end) {
+      auto &key = it->first;
+      if (not passes_node(key)) {
+        ++it;
+        continue;
+      }
+      if (key.size() == children_offset) {
+        if (node->value) {
+          OUTCOME_TRY(value, node->value.load());
+          values[it->second] = *value;
+        }
+        ++it;
+        continue;
+      }
+      if (not is_branch) {
+        ++it;
+        continue;
+      }
+      // all the keys leading to the same child are looked up in one go
+      auto idx = key[children_offset];
+      auto group_end = std::find_if(it, end, [&](const Lookup &lookup) {
+        return not passes_node(lookup.first)
+               or lookup.first.size() == children_offset
+               or lookup.first[children_offset] != idx;
+      });
+      OUTCOME_TRY(child,
+                  retrieveChild(std::static_pointer_cast<BranchNode>(node),
+                                idx));
+      if (child) {
+        OUTCOME_TRY(
+            lookUpMany(child, children_offset + 1, it, group_end, values));
+      }
+      it = group_end;
+    }
+    return outcome::success();
+  }
+
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::getNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) const {
+      const NodePtr &parent, NibbleView key_nibbles) const {
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
       return nullptr;
@@ -197,17 +299,18 @@ namespace kagome::storage::trie {
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
+        auto length =
+            NibbleView::commonPrefixLength(parent->key_nibbles, key_nibbles);
         if (parent->key_nibbles == key_nibbles || key_nibbles.empty()) {
           return parent;
         }
-        if ((parent->key_nibbles.subbuffer(0, length) == key_nibbles)
+        if (length == key_nibbles.size()
             && key_nibbles.size() < parent->key_nibbles.size()) {
           return nullptr;
         }
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
-        return getNode(n, key_nibbles.subspan(length + 1));
+        return getNode(n, key_nibbles.subview(length + 1));
       }
       case T::Leaf:
         if (parent->key_nibbles == key_nibbles) {
@@ -221,8 +324,8 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>>
-  PolkadotTrieImpl::getPath(NodePtr parent,
-                            const KeyNibbles &key_nibbles) const {
+  PolkadotTrieImpl::getPath(const NodePtr &parent,
+                            NibbleView key_nibbles) const {
     using Path = std::list<std::pair<PolkadotTrieImpl::BranchPtr, uint8_t>>;
     using T = PolkadotNode::Type;
     if (parent == nullptr) {
@@ -231,17 +334,18 @@ namespace kagome::storage::trie {
     switch (parent->getTrieType()) {
       case T::BranchEmptyValue:
       case T::BranchWithValue: {
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
+        auto length =
+            NibbleView::commonPrefixLength(parent->key_nibbles, key_nibbles);
         if (parent->key_nibbles == key_nibbles || key_nibbles.empty()) {
           return Path{};
         }
-        if ((parent->key_nibbles.subbuffer(0, length) == key_nibbles)
+        if (length == key_nibbles.size()
             && key_nibbles.size() < parent->key_nibbles.size()) {
           return Path{};
         }
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
         OUTCOME_TRY(n, retrieveChild(parent_as_branch, key_nibbles[length]));
-        OUTCOME_TRY(path, getPath(n, key_nibbles.subspan(length + 1)));
+        OUTCOME_TRY(path, getPath(n, key_nibbles.subview(length + 1)));
         path.push_front({parent_as_branch, key_nibbles[length]});
         return std::move(path);
       }
@@ -261,11 +365,11 @@ namespace kagome::storage::trie {
   }
 
   bool PolkadotTrieImpl::contains(const common::Buffer &key) const {
-    if (not root_) {
+    if (not root_ or not mayContain(key)) {
       return false;
     }
 
-    auto node = getNode(root_, PolkadotCodec::keyToNibbles(key));
+    auto node = getNode(root_, NibbleView::ofKey(key));
     return node.has_value() && (node.value() != nullptr)
            && (node.value()->value);
   }
@@ -276,10 +380,9 @@ namespace kagome::storage::trie {
 
   outcome::result<void> PolkadotTrieImpl::remove(const common::Buffer &key) {
     if (root_) {
-      auto key_nibbles = PolkadotCodec::keyToNibbles(key);
       // delete node will fetch nodes that it needs from the storage (the nodes
       // typically are a path in the trie) and work on them in memory
-      OUTCOME_TRY(n, deleteNode(root_, key_nibbles));
+      OUTCOME_TRY(n, deleteNode(root_, NibbleView::ofKey(key)));
       // afterwards, the nodes are written back to the storage and the new trie
       // root hash is obtained
       root_ = n;
@@ -288,7 +391,7 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::deleteNode(
-      NodePtr parent, const KeyNibbles &key_nibbles) {
+      const NodePtr &parent, NibbleView key_nibbles) {
     if (!parent) {
       return nullptr;
     }
@@ -297,17 +400,19 @@ namespace kagome::storage::trie {
     switch (parent->getTrieType()) {
       case T::BranchWithValue:
       case T::BranchEmptyValue: {
-        auto length = getCommonPrefixLength(parent->key_nibbles, key_nibbles);
-        auto parent_as_branch = std::dynamic_pointer_cast<BranchNode>(parent);
+        auto length =
+            NibbleView::commonPrefixLength(parent->key_nibbles, key_nibbles);
+        auto parent_as_branch = std::static_pointer_cast<BranchNode>(parent);
+        parent->markDirty();
         if (parent->key_nibbles == key_nibbles || key_nibbles.empty()) {
           parent->value = boost::none;
           newRoot = parent;
         } else {
           OUTCOME_TRY(child,
                       retrieveChild(parent_as_branch, key_nibbles[length]));
-          OUTCOME_TRY(n, deleteNode(child, key_nibbles.subspan(length + 1)));
+          OUTCOME_TRY(n, deleteNode(child, key_nibbles.subview(length + 1)));
           newRoot = parent;
-          parent_as_branch->children.at(key_nibbles[length]) = n;
+          parent_as_branch->children.set(key_nibbles[length], n);
         }
         OUTCOME_TRY(n, handleDeletion(parent_as_branch, newRoot, key_nibbles));
         return std::move(n);
@@ -325,14 +430,15 @@ namespace kagome::storage::trie {
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::handleDeletion(
       const BranchPtr &parent,
       NodePtr node,
-      const KeyNibbles &key_nibbles) {
+      NibbleView key_nibbles) {
     auto newRoot = std::move(node);
-    auto length = getCommonPrefixLength(key_nibbles, parent->key_nibbles);
+    auto length =
+        NibbleView::commonPrefixLength(key_nibbles, parent->key_nibbles);
     auto bitmap = parent->childrenBitmap();
     // turn branch node left with no children to a leaf node
     if (bitmap == 0 && parent->value) {
-      newRoot = std::make_shared<LeafNode>(key_nibbles.subspan(0, length),
-                                           parent->value);
+      newRoot = makeNode<LeafNode>(
+          key_nibbles.subview(0, length).toNibbles(), parent->value);
     } else if (parent->childrenNum() == 1 && !parent->value) {
       size_t idx = 0;
       for (idx = 0; idx < 16; idx++) {
@@ -347,19 +453,15 @@ namespace kagome::storage::trie {
         auto newKey = parent->key_nibbles;
         newKey.putUint8(idx);
         newKey.putBuffer(child->key_nibbles);
-        newRoot = std::make_shared<LeafNode>(newKey, child->value);
+        newRoot = makeNode<LeafNode>(newKey, child->value);
       } else if (child->getTrieType() == T::BranchEmptyValue
                  || child->getTrieType() == T::BranchWithValue) {
-        auto branch = std::make_shared<BranchNode>();
+        auto branch = makeNode<BranchNode>();
         branch->key_nibbles.putBuffer(parent->key_nibbles)
             .putUint8(idx)
             .putBuffer(child->key_nibbles);
-        auto child_as_branch = std::dynamic_pointer_cast<BranchNode>(child);
-        for (size_t i = 0; i < child_as_branch->children.size(); i++) {
-          if (child_as_branch->children.at(i)) {
-            branch->children.at(i) = child_as_branch->children.at(i);
-          }
-        }
+        auto child_as_branch = std::static_pointer_cast<BranchNode>(child);
+        branch->children = child_as_branch->children;
         branch->value = child->value;
         newRoot = branch;
       }
@@ -368,61 +470,47 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::detachNode(
-      const NodePtr &parent, const KeyNibbles &prefix_nibbles) {
+      const NodePtr &parent, NibbleView prefix_nibbles) {
     if (parent == nullptr) {
       return nullptr;
     }
     if (parent->key_nibbles.size() >= prefix_nibbles.size()) {
       // if this is the node to be detached -- detach it
-      if (parent->key_nibbles.subbuffer(0, prefix_nibbles.size())
-          == prefix_nibbles) {
+      if (NibbleView{parent->key_nibbles}.startsWith(prefix_nibbles)) {
         return nullptr;
       }
       return parent;
     }
     // if parent's key is smaller and it is not a prefix of the prefix, don't
     // change anything
-    if (prefix_nibbles.subbuffer(0, parent->key_nibbles.size())
-        != parent->key_nibbles) {
+    if (not prefix_nibbles.startsWith(parent->key_nibbles)) {
       return parent;
     }
     using T = PolkadotNode::Type;
     if (parent->getTrieType() == T::BranchWithValue
         || parent->getTrieType() == T::BranchEmptyValue) {
-      auto branch = std::dynamic_pointer_cast<BranchNode>(parent);
-      auto length = getCommonPrefixLength(parent->key_nibbles, prefix_nibbles);
+      auto branch = std::static_pointer_cast<BranchNode>(parent);
+      auto length =
+          NibbleView::commonPrefixLength(parent->key_nibbles, prefix_nibbles);
       OUTCOME_TRY(child, retrieveChild(branch, prefix_nibbles[length]));
       if (child == nullptr) {
         return parent;
       }
-      OUTCOME_TRY(n, detachNode(child, prefix_nibbles.subspan(length + 1)));
-      branch->children.at(prefix_nibbles[length]) = n;
+      OUTCOME_TRY(n, detachNode(child, prefix_nibbles.subview(length + 1)));
+      branch->children.set(prefix_nibbles[length], n);
+      branch->markDirty();
       return branch;
     }
     return parent;
   }
 
-  outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::retrieveChild(
-      BranchPtr parent, uint8_t idx) const {
-    return retrieve_child_(std::move(parent), idx);
+  bool PolkadotTrieImpl::mayContain(const common::Buffer &key) const {
+    return key_filter_ == nullptr or key_filter_->mayContain(key);
   }
 
-  uint32_t PolkadotTrieImpl::getCommonPrefixLength(const KeyNibbles &pref1,
-                                                   const KeyNibbles &pref2) const {
-    size_t length = 0;
-    auto min = pref1.size();
-
-    if (pref1.size() > pref2.size()) {
-      min = pref2.size();
-    }
-
-    for (; length < min; length++) {
-      if (pref1[length] != pref2[length]) {
-        break;
-      }
-    }
-
-    return length;
+  outcome::result<PolkadotTrie::NodePtr> PolkadotTrieImpl::retrieveChild(
+      const BranchPtr &parent, uint8_t idx) const {
+    return retrieve_child_(parent, idx);
   }
 
 }  // namespace kagome::storage::trie
@@ -23,7 +23,7 @@ namespace kagome::storage::trie {
 
    public:
     using ChildRetrieveFunctor =
-        std::function<outcome::result<NodePtr>(BranchPtr, uint8_t)>;
+        std::function<outcome::result<NodePtr>(const BranchPtr &, uint8_t)>;
 
     enum class Error { INVALID_NODE_TYPE = 1 };
 
@@ -39,18 +39,22 @@ namespace kagome::storage::trie {
     explicit PolkadotTrieImpl(
         NodePtr root, ChildRetrieveFunctor f = defaultChildRetrieveFunctor);
 
+    void setKeyFilter(std::shared_ptr<KeyFilter> filter) override;
+
     NodePtr getRoot() const override;
 
-    outcome::result<NodePtr> getNode(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+    outcome::result<NodePtr> getNode(const NodePtr &parent,
+                                     NibbleView key_nibbles) const override;
 
     outcome::result<std::list<std::pair<BranchPtr, uint8_t>>> getPath(
-        NodePtr parent, const KeyNibbles &key_nibbles) const override;
+        const NodePtr &parent, NibbleView key_nibbles) const override;
 
     /**
      * Remove all entries, which key starts with the prefix
      */
     outcome::result<void> clearPrefix(const common::Buffer &prefix) override;
+    outcome::result<ClearPrefixResult> clearPrefix(const common::Buffer &prefix,
+                                                   uint32_t limit) override;
 
     // value will be copied
     outcome::result<void> put(const common::Buffer &key,
@@ -64,6 +68,9 @@ namespace kagome::storage::trie {
     outcome::result<common::Buffer> get(
         const common::Buffer &key) const override;
 
+    outcome::result<std::vector<boost::optional<common::Buffer>>> getMany(
+        gsl::span<const common::Buffer> keys) const override;
+
     std::unique_ptr<BufferMapCursor> cursor() override;
 
     bool contains(const common::Buffer &key) const override;
@@ -72,30 +79,47 @@ namespace kagome::storage::trie {
 
    private:
     outcome::result<NodePtr> insert(const NodePtr &parent,
-                                    const KeyNibbles &key_nibbles,
+                                    NibbleView key_nibbles,
                                     NodePtr node);
 
-    outcome::result<NodePtr> updateBranch(BranchPtr parent,
-                                          const KeyNibbles &key_nibbles,
+    outcome::result<NodePtr> updateBranch(const BranchPtr &parent,
+                                          NibbleView key_nibbles,
                                           const NodePtr &node);
 
-    outcome::result<NodePtr> deleteNode(NodePtr parent,
-                                        const KeyNibbles &key_nibbles);
+    outcome::result<NodePtr> deleteNode(const NodePtr &parent,
+                                        NibbleView key_nibbles);
     outcome::result<NodePtr> handleDeletion(const BranchPtr &parent,
                                             NodePtr node,
-                                            const KeyNibbles &key_nibbles);
+                                            NibbleView key_nibbles);
     // remove a node with its children
     outcome::result<NodePtr> detachNode(const NodePtr &parent,
-                                        const KeyNibbles &prefix_nibbles);
+                                        NibbleView prefix_nibbles);
+
+    // nibbles of a looked up key and its position among the requested keys
+    using Lookup = std::pair<NibbleView, size_t>;
+    using LookupIt = std::vector<Lookup>::const_iterator;
+
+    /**
+     * Looks up sorted keys in [\arg begin, \arg end), which all share their
+     * first \arg offset nibbles, in the subtree of \arg node, storing the
+     * found values to \arg values
+     */
+    outcome::result<void> lookUpMany(
+        const NodePtr &node,
+        size_t offset,
+        LookupIt begin,
+        LookupIt end,
+        std::vector<boost::optional<common::Buffer>> &values) const;
 
-    uint32_t getCommonPrefixLength(const KeyNibbles &pref1,
-                                   const KeyNibbles &pref2) const;
+    // false if the key filter tells that there is no such key in the trie
+    bool mayContain(const common::Buffer &key) const;
 
-    outcome::result<NodePtr> retrieveChild(BranchPtr parent,
+    outcome::result<NodePtr> retrieveChild(const BranchPtr &parent,
                                            uint8_t idx) const override;
 
     ChildRetrieveFunctor retrieve_child_;
     NodePtr root_;
+    std::shared_ptr<KeyFilter> key_filter_;
   };
 
 }  // namespace kagome::storage::trie
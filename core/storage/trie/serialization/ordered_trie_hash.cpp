@@ -0,0 +1,291 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/ordered_trie_hash.hpp"
+
+#include <algorithm>
+
+#include "common/blob.hpp"
+#include "crypto/blake2/blake2b.h"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+
+namespace kagome::storage::trie {
+
+  namespace {
+    using Bytes = std::vector<uint8_t>;
+
+    /**
+     * Appends SCALE compact encoding of \arg value to \arg out
+     */
+    void putCompact(Bytes &out, uint64_t value) {
+      if (value < (1ull << 6u)) {
+        out.push_back(value << 2u);
+        return;
+      }
+      if (value < (1ull << 14u)) {
+        value = (value << 2u) | 0b01u;
+        out.insert(out.end(), {uint8_t(value), uint8_t(value >> 8u)});
+        return;
+      }
+      if (value < (1ull << 30u)) {
+        value = (value << 2u) | 0b10u;
+        for (size_t i = 0; i < 4; i++) {
+          out.push_back(value >> (8 * i));
+        }
+        return;
+      }
+      size_t length = 4;
+      while (length < sizeof(value) and (value >> (8 * length)) != 0) {
+        length++;
+      }
+      out.push_back(((length - 4) << 2u) | 0b11u);
+      for (size_t i = 0; i < length; i++) {
+        out.push_back(value >> (8 * i));
+      }
+    }
+
+    common::Hash256 hash256(gsl::span<const uint8_t> bytes) {
+      common::Hash256 out;
+      blake2b(out.data(),
+              common::Hash256::size(),
+              nullptr,
+              0,
+              bytes.data(),
+              bytes.size());
+      return out;
+    }
+
+    /**
+     * Encodes the nodes of the trie with the given sorted keys, so that the
+     * encoding of every node is written to the end of the scratch buffer
+     * right after the encodings of its header, key and value, and is
+     * replaced with the merkle value as soon as it is complete.
+     * @see PolkadotCodec, which is the reference encoding
+     */
+    class OrderedTrieEncoder {
+     public:
+      // a key of the trie, which is a range of nibbles_
+      struct Key {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t value_idx;
+      };
+      using KeyIt = std::vector<Key>::const_iterator;
+
+      OrderedTrieEncoder(const Bytes &nibbles,
+                         gsl::span<const gsl::span<const uint8_t>> values,
+                         Bytes &scratch)
+          : nibbles_{nibbles}, values_{values}, scratch_{scratch} {}
+
+      /**
+       * Encodes the node having the keys [begin, end), all of which have
+       * \arg depth nibbles in common with it parents, and appends its
+       * SCALE-encoded merkle value to the scratch buffer, or its hash if it
+       * is the root
+       */
+      outcome::result<void> encode(KeyIt begin,
+                                   KeyIt end,
+                                   size_t depth,
+                                   bool is_root) {
+        auto start = scratch_.size();
+        auto &first = *begin;
+        auto &last = *(end - 1);
+        // keys are sorted, thus the common prefix of the first and the last
+        // ones is common for all of them
+        size_t key_end = depth;
+        while (key_end < first.size and key_end < last.size
+               and nibbleOf(first, key_end) == nibbleOf(last, key_end)) {
+          key_end++;
+        }
+        if (begin + 1 == end) {
+          key_end = first.size;
+        }
+        // the shortest key comes first, so only it may belong to the node
+        bool has_value = first.size == key_end;
+        using T = PolkadotNode::Type;
+        auto type = T::Leaf;
+        if (begin + 1 != end) {
+          type = has_value ? T::BranchWithValue : T::BranchEmptyValue;
+        }
+        OUTCOME_TRY(putHeader(type, key_end - depth));
+        putPartialKey(first, depth, key_end);
+
+        auto bitmap_pos = scratch_.size();
+        if (type != T::Leaf) {
+          scratch_.insert(scratch_.end(), 2, 0);
+        }
+        if (has_value) {
+          auto &value = values_[first.value_idx];
+          putCompact(scratch_, value.size());
+          scratch_.insert(scratch_.end(), value.begin(), value.end());
+          begin++;
+        }
+        if (type != T::Leaf) {
+          uint16_t bitmap = 0;
+          while (begin != end) {
+            auto nibble = nibbleOf(*begin, key_end);
+            auto child_end = std::find_if(begin, end, [&](const Key &key) {
+              return nibbleOf(key, key_end) != nibble;
+            });
+            OUTCOME_TRY(encode(begin, child_end, key_end + 1, false));
+            bitmap |= 1u << nibble;
+            begin = child_end;
+          }
+          scratch_[bitmap_pos] = bitmap & 0xffu;
+          scratch_[bitmap_pos + 1] = bitmap >> 8u;
+        }
+
+        gsl::span<const uint8_t> encoding{scratch_.data() + start,
+                                          scratch_.size() - start};
+        if (is_root or encoding.size() >= common::Hash256::size()) {
+          auto hash = hash256(encoding);
+          scratch_.resize(start);
+          if (not is_root) {
+            putCompact(scratch_, hash.size());
+          }
+          scratch_.insert(scratch_.end(), hash.begin(), hash.end());
+          return outcome::success();
+        }
+        // a short encoding is the merkle value itself, which is moved to
+        // make room for its length
+        auto size = encoding.size();
+        scratch_.insert(scratch_.begin() + start, uint8_t(size << 2u));
+        return outcome::success();
+      }
+
+     private:
+      uint8_t nibbleOf(const Key &key, size_t idx) const {
+        return nibbles_[key.offset + idx];
+      }
+
+      // @see PolkadotCodec::encodeHeader
+      outcome::result<void> putHeader(PolkadotNode::Type type,
+                                      size_t key_size) {
+        if (key_size > 0xffffu) {
+          return PolkadotCodec::Error::TOO_MANY_NIBBLES;
+        }
+        uint8_t head = static_cast<uint8_t>(type) << 6u;
+        if (key_size < 63u) {
+          scratch_.push_back(head | key_size);
+          return outcome::success();
+        }
+        scratch_.push_back(head | 63u);
+        auto rest = key_size - 63u;
+        scratch_.insert(scratch_.end(), rest / 0xffu, 0xffu);
+        scratch_.push_back(rest % 0xffu);
+        return outcome::success();
+      }
+
+      // @see PolkadotCodec::nibblesToKey
+      void putPartialKey(const Key &key, size_t begin, size_t end) {
+        if ((end - begin) % 2 == 1) {
+          scratch_.push_back(nibbleOf(key, begin++));
+        }
+        for (auto i = begin; i < end; i += 2) {
+          scratch_.push_back((nibbleOf(key, i) << 4u) | nibbleOf(key, i + 1));
+        }
+      }
+
+      const Bytes &nibbles_;
+      gsl::span<const gsl::span<const uint8_t>> values_;
+      Bytes &scratch_;
+    };
+
+    using Key = OrderedTrieEncoder::Key;
+
+    /**
+     * Buffers of a single calculation. They are reused by the subsequent
+     * calculations on the same thread, as blocks of a similar size tend to
+     * follow each other
+     */
+    struct Arena {
+      Bytes nibbles;
+      std::vector<Key> keys;
+      std::vector<gsl::span<const uint8_t>> values;
+      Bytes scratch;
+
+      void putKey(gsl::span<const uint8_t> key, size_t value_idx) {
+        keys.push_back(Key{static_cast<uint32_t>(nibbles.size()),
+                           static_cast<uint32_t>(key.size() * 2),
+                           static_cast<uint32_t>(value_idx)});
+        for (auto byte : key) {
+          nibbles.push_back(byte >> 4u);
+          nibbles.push_back(byte & 0xfu);
+        }
+      }
+
+      outcome::result<common::Buffer> encode(
+          gsl::span<const gsl::span<const uint8_t>> values) {
+        OrderedTrieEncoder encoder{nibbles, values, scratch};
+        OUTCOME_TRY(encoder.encode(keys.cbegin(), keys.cend(), 0, true));
+        return common::Buffer{scratch};
+      }
+    };
+
+    Arena &threadArena() {
+      thread_local Arena arena;
+      arena.nibbles.clear();
+      arena.keys.clear();
+      arena.values.clear();
+      arena.scratch.clear();
+      return arena;
+    }
+
+    const common::Buffer &emptyRoot() {
+      // @see TrieSerializer::getEmptyRootHash
+      static const uint8_t kEmptyNode = 0;
+      static const auto empty_root =
+          common::Buffer{}.put(hash256({&kEmptyNode, 1}));
+      return empty_root;
+    }
+  }  // namespace
+
+  outcome::result<common::Buffer> calculateOrderedTrieHash(
+      gsl::span<const gsl::span<const uint8_t>> values) {
+    if (values.empty()) {
+      return emptyRoot();
+    }
+    auto &arena = threadArena();
+    Bytes key;
+    for (size_t i = 0; i < static_cast<size_t>(values.size()); i++) {
+      key.clear();
+      putCompact(key, i);
+      arena.putKey(key, i);
+    }
+    // compact encoding is little-endian, so the order of the keys in the trie
+    // differs from the order of the indices
+    auto &nibbles = arena.nibbles;
+    std::sort(arena.keys.begin(),
+              arena.keys.end(),
+              [&nibbles](const Key &lhs, const Key &rhs) {
+                return std::lexicographical_compare(
+                    nibbles.begin() + lhs.offset,
+                    nibbles.begin() + lhs.offset + lhs.size,
+                    nibbles.begin() + rhs.offset,
+                    nibbles.begin() + rhs.offset + rhs.size);
+              });
+    return arena.encode(values);
+  }
+
+  outcome::result<common::Buffer> calculateSortedTrieHash(
+      gsl::span<const SortedTrieEntry> entries) {
+    if (entries.empty()) {
+      return emptyRoot();
+    }
+    auto &arena = threadArena();
+    for (size_t i = 0; i < static_cast<size_t>(entries.size()); i++) {
+      BOOST_ASSERT(i == 0
+                   or std::lexicographical_compare(entries[i - 1].first.begin(),
+                                                   entries[i - 1].first.end(),
+                                                   entries[i].first.begin(),
+                                                   entries[i].first.end()));
+      arena.putKey(entries[i].first, i);
+      arena.values.push_back(entries[i].second);
+    }
+    return arena.encode(arena.values);
+  }
+
+}  // namespace kagome::storage::trie
@@ -6,14 +6,41 @@
 #ifndef KAGOME_ORDERED_TRIE_HASH_HPP
 #define KAGOME_ORDERED_TRIE_HASH_HPP
 
+#include <utility>
+#include <vector>
+
+#include <gsl/span>
+
 #include "common/buffer.hpp"
-#include "crypto/hasher.hpp"
-#include "scale/scale.hpp"
-#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
-#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "outcome/outcome.hpp"
 
 namespace kagome::storage::trie {
 
+  /**
+   * Calculates the hash of a Merkle tree containing the provided values and
+   * compact-encoded indices of those values (starting from 0) as keys.
+   * The tree is not built: its nodes are encoded bottom-up right into a
+   * reused scratch buffer, since all the keys are known in advance
+   * @return the Merkle tree root hash of the tree containing provided values
+   */
+  outcome::result<common::Buffer> calculateOrderedTrieHash(
+      gsl::span<const gsl::span<const uint8_t>> values);
+
+  /**
+   * Key and value of a trie entry
+   */
+  using SortedTrieEntry =
+      std::pair<gsl::span<const uint8_t>, gsl::span<const uint8_t>>;
+
+  /**
+   * Calculates the hash of a Merkle tree containing the provided entries,
+   * encoding it the same way as calculateOrderedTrieHash does
+   * @param entries entries sorted by their keys, which are distinct
+   * @return the Merkle tree root hash of the tree containing the entries
+   */
+  outcome::result<common::Buffer> calculateSortedTrieHash(
+      gsl::span<const SortedTrieEntry> entries);
+
   /**
    * Calculates the hash of a Merkle tree containing the items from the provided
    * range [begin; end) as values and compact-encoded indices of those
@@ -24,26 +51,15 @@ namespace kagome::storage::trie {
   template <typename It>
   outcome::result<common::Buffer> calculateOrderedTrieHash(const It &begin,
                                                            const It &end) {
-    PolkadotTrieImpl trie;
-    PolkadotCodec codec;
-    // empty root
-    if (begin == end) {
-      static const auto empty_root = common::Buffer{}.put(codec.hash256({0}));
-      return empty_root;
-    }
     // clang-format off
     static_assert(
         std::is_same_v<std::decay_t<decltype(*begin)>, common::Buffer>);
     // clang-format on
-    It it = begin;
-    scale::CompactInteger key = 0;
-    while (it != end) {
-      OUTCOME_TRY(enc, scale::encode(key++));
-      OUTCOME_TRY(trie.put(common::Buffer{enc}, *it));
-      it++;
+    std::vector<gsl::span<const uint8_t>> values;
+    for (It it = begin; it != end; it++) {
+      values.emplace_back(it->data(), it->size());
     }
-    OUTCOME_TRY(enc, codec.encodeNode(*trie.getRoot()));
-    return common::Buffer{codec.hash256(enc)};
+    return calculateOrderedTrieHash(values);
   }
 
 }  // namespace kagome::storage::trie
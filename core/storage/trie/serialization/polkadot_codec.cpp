@@ -35,12 +35,49 @@ namespace kagome::storage::trie {
     return (high << 4u) | (low & 0xfu);
   }
 
-  inline common::Buffer ushortToBytes(uint16_t b) {
-    common::Buffer out(2, 0);
-    out[1] = (b >> 8u) & 0xffu;
-    out[0] = b & 0xffu;
-    return out;
-  }
+  namespace {
+    /**
+     * Appends SCALE compact encoding of \arg value to \arg out
+     * @see OrderedTrieEncoder, which encodes the same way
+     */
+    void putCompact(common::Buffer &out, uint64_t value) {
+      if (value < (1ull << 6u)) {
+        out.putUint8(value << 2u);
+        return;
+      }
+      if (value < (1ull << 14u)) {
+        value = (value << 2u) | 0b01u;
+        out.putUint8(value).putUint8(value >> 8u);
+        return;
+      }
+      if (value < (1ull << 30u)) {
+        value = (value << 2u) | 0b10u;
+        for (size_t i = 0; i < 4; i++) {
+          out.putUint8(value >> (8 * i));
+        }
+        return;
+      }
+      size_t length = 4;
+      while (length < sizeof(value) and (value >> (8 * length)) != 0) {
+        length++;
+      }
+      out.putUint8(((length - 4) << 2u) | 0b11u);
+      for (size_t i = 0; i < length; i++) {
+        out.putUint8(value >> (8 * i));
+      }
+    }
+
+    common::Hash256 blake2b256(gsl::span<const uint8_t> bytes) {
+      common::Hash256 out;
+      blake2b(out.data(),
+              common::Hash256::size(),
+              nullptr,
+              0,
+              bytes.data(),
+              bytes.size());
+      return out;
+    }
+  }  // namespace
 
   common::Buffer PolkadotCodec::nibblesToKey(const KeyNibbles &nibbles) {
     Buffer res;
@@ -64,11 +101,11 @@ namespace kagome::storage::trie {
       return {};
     }
     if (key.size() == 1 && key[0] == 0) {
-      return KeyNibbles{common::Buffer{0, 0}};
+      return KeyNibbles{0, 0};
     }
 
     auto l = key.size() * 2;
-    KeyNibbles res(common::Buffer(l, 0));
+    KeyNibbles res{KeyNibbles::Base(l, 0)};
     for (size_t i = 0; i < key.size(); i++) {
       res[2 * i] = key[i] >> 4u;
       res[2 * i + 1] = key[i] & 0xfu;
@@ -88,25 +125,24 @@ namespace kagome::storage::trie {
   }
 
   common::Hash256 PolkadotCodec::hash256(const common::Buffer &buf) const {
-    common::Hash256 out;
-
-    blake2b(out.data(),
-            common::Hash256::size(),
-            nullptr,
-            0,
-            buf.data(),
-            buf.size());
-    return out;
+    return blake2b256(buf);
   }
 
   outcome::result<common::Buffer> PolkadotCodec::encodeNode(
       const Node &node) const {
+    Buffer encoding;
+    OUTCOME_TRY(encodeNodeTo(node, encoding));
+    return outcome::success(std::move(encoding));
+  }
+
+  outcome::result<void> PolkadotCodec::encodeNodeTo(const Node &node,
+                                                    Buffer &out) const {
     switch (static_cast<PolkadotNode::Type>(node.getType())) {
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue:
-        return encodeBranch(dynamic_cast<const BranchNode &>(node));
+        return encodeBranch(dynamic_cast<const BranchNode &>(node), out);
       case PolkadotNode::Type::Leaf:
-        return encodeLeaf(dynamic_cast<const LeafNode &>(node));
+        return encodeLeaf(dynamic_cast<const LeafNode &>(node), out);
 
       case PolkadotNode::Type::Special:
         // special node is not handled right now
@@ -117,6 +153,13 @@ namespace kagome::storage::trie {
 
   outcome::result<common::Buffer> PolkadotCodec::encodeHeader(
       const PolkadotNode &node) const {
+    Buffer header;
+    OUTCOME_TRY(putHeader(node, header));
+    return outcome::success(std::move(header));
+  }
+
+  outcome::result<void> PolkadotCodec::putHeader(const PolkadotNode &node,
+                                                 Buffer &out) const {
     if (node.key_nibbles.size() > 0xffffu) {
       return Error::TOO_MANY_NIBBLES;
     }
@@ -138,80 +181,160 @@ namespace kagome::storage::trie {
     // set bits 0..5, partial key length
     if (node.key_nibbles.size() < 63u) {
       head |= uint8_t(node.key_nibbles.size());
-      return Buffer{head};  // header contains 1 byte
+      out.putUint8(head);  // header contains 1 byte
+      return outcome::success();
     }
     // if partial key length is greater than 62, then the rest of the length is
-    // stored in consequent bytes
+    // stored in consequent bytes: 255 as many times as it fits and the
+    // remainder
     head += 63u;
+    out.putUint8(head);
 
     size_t l = node.key_nibbles.size() - 63u;
-    Buffer out(1u +             /// 1 byte head
-                   l / 0xffu +  /// number of 255 in l
-                   1u,          /// for last byte
-               0xffu            /// fill array with 255
-    );
-
-    // first byte is head
-    out[0] = head;
-    // last byte after while(l>255) l-=255;
-    out[out.size() - 1] = l % 0xffu;
-
-    return out;
+    for (size_t i = 0; i < l / 0xffu; i++) {
+      out.putUint8(0xffu);
+    }
+    out.putUint8(l % 0xffu);
+    return outcome::success();
+  }
+
+  void PolkadotCodec::putPartialKey(const KeyNibbles &nibbles, Buffer &out) {
+    // @see nibblesToKey, an odd number of nibbles starts with a single one
+    size_t i = 0;
+    if (nibbles.size() % 2 == 1) {
+      out.putUint8(nibbles[i++]);
+    }
+    for (; i < nibbles.size(); i += 2) {
+      out.putUint8(byteFromNibbles(nibbles[i], nibbles[i + 1]));
+    }
+  }
+
+  void PolkadotCodec::putMerkleValue(const Buffer &merkle_value, Buffer &out) {
+    putCompact(out, merkle_value.size());
+    out.putBuffer(merkle_value);
   }
 
-  outcome::result<common::Buffer> PolkadotCodec::encodeBranch(
-      const BranchNode &node) const {
+  outcome::result<void> PolkadotCodec::encodeBranch(const BranchNode &node,
+                                                    Buffer &out) const {
     // node header
-    OUTCOME_TRY(encoding, encodeHeader(node));
+    OUTCOME_TRY(putHeader(node, out));
 
     // key
-    encoding += nibblesToKey(node.key_nibbles);
+    putPartialKey(node.key_nibbles, out);
 
     // children bitmap
-    encoding += ushortToBytes(node.childrenBitmap());
+    auto bitmap = node.childrenBitmap();
+    out.putUint8(bitmap & 0xffu).putUint8(bitmap >> 8u);
 
     if (node.getTrieType() == PolkadotNode::Type::BranchWithValue) {
       // scale encoded value
-      OUTCOME_TRY(encNodeValue, scale::encode(node.value.get()));
-      encoding += Buffer(std::move(encNodeValue));
+      OUTCOME_TRY(value, node.value.load());
+      putCompact(out, value->size());
+      out.putBuffer(*value);
     }
 
     // encode each child
     for (auto &child : node.children) {
-      if (child) {
-        if (child->isDummy()) {
-          auto merkle_value =
-              std::dynamic_pointer_cast<DummyNode>(child)->db_key;
-          OUTCOME_TRY(scale_enc, scale::encode(std::move(merkle_value)));
-          encoding.put(scale_enc);
+      if (not child) {
+        continue;
+      }
+      if (child->isDummy()) {
+        putMerkleValue(static_cast<const DummyNode &>(*child).db_key, out);
+      } else if (not child->isDirty()) {
+        putMerkleValue(child->merkle_value.value(), out);
+      } else if (child->calculated_merkle_value) {
+        putMerkleValue(child->calculated_merkle_value.value(), out);
+      } else {
+        // the child is encoded right in place and then replaced with its
+        // merkle value, so that no temporary buffers are involved
+        auto start = out.size();
+        OUTCOME_TRY(encodeNodeTo(*child, out));
+        auto size = out.size() - start;
+        if (size >= common::Hash256::size()) {
+          auto hash = blake2b256({out.data() + start, size});
+          out.resize(start);
+          putCompact(out, hash.size());
+          out.put(hash);
         } else {
-          OUTCOME_TRY(enc, encodeNode(*child));
-          OUTCOME_TRY(scale_enc, scale::encode(merkleValue(enc)));
-          encoding.put(scale_enc);
+          // a short encoding is the merkle value itself, which is moved to
+          // make room for its length
+          auto &bytes = out.toVector();
+          bytes.insert(bytes.begin() + start, uint8_t(size << 2u));
         }
       }
     }
 
-    return outcome::success(std::move(encoding));
+    return outcome::success();
   }
 
-  outcome::result<common::Buffer> PolkadotCodec::encodeLeaf(
-      const LeafNode &node) const {
-    OUTCOME_TRY(encoding, encodeHeader(node));
+  outcome::result<void> PolkadotCodec::encodeLeaf(const LeafNode &node,
+                                                  Buffer &out) const {
+    if (!node.value) return Error::NO_NODE_VALUE;
+
+    OUTCOME_TRY(putHeader(node, out));
 
     // key
-    encoding += nibblesToKey(node.key_nibbles);
+    putPartialKey(node.key_nibbles, out);
 
-    if (!node.value) return Error::NO_NODE_VALUE;
     // scale encoded value
-    OUTCOME_TRY(encNodeValue, scale::encode(node.value.get()));
-    encoding += Buffer(std::move(encNodeValue));
+    OUTCOME_TRY(value, node.value.load());
+    putCompact(out, value->size());
+    out.putBuffer(*value);
 
-    return outcome::success(std::move(encoding));
+    return outcome::success();
+  }
+
+  outcome::result<boost::optional<std::pair<size_t, size_t>>>
+  PolkadotCodec::locateValue(gsl::span<const uint8_t> encoded_data) const {
+    BufferStream stream{encoded_data};
+    OUTCOME_TRY(header, decodeHeader(stream));
+    auto [type, pk_length] = header;
+    // the value follows the partial key of a leaf, and the children bitmap
+    // of a branch
+    size_t value_offset = pk_length / 2 + pk_length % 2;
+    if (type == PolkadotNode::Type::BranchWithValue) {
+      value_offset += 2;
+    } else if (type != PolkadotNode::Type::Leaf) {
+      return boost::none;
+    }
+    auto rest = stream.leftBytes();
+    if (static_cast<size_t>(rest.size()) <= value_offset) {
+      return Error::INPUT_TOO_SMALL;
+    }
+    rest = rest.subspan(value_offset);
+    // the mode of the compact length is in the two lowest bits of its first
+    // byte, the big mode keeps the number of the following bytes there
+    size_t length_size = 0;
+    switch (rest[0] & 0b11u) {
+      case 0b00u:
+        length_size = 1;
+        break;
+      case 0b01u:
+        length_size = 2;
+        break;
+      case 0b10u:
+        length_size = 4;
+        break;
+      default:
+        length_size = (rest[0] >> 2u) + 5;
+    }
+    scale::ScaleDecoderStream ss{rest};
+    scale::CompactInteger length;
+    try {
+      ss >> length;
+    } catch (std::system_error &e) {
+      return outcome::failure(e.code());
+    }
+    auto size = length_size + length.convert_to<size_t>();
+    if (static_cast<size_t>(rest.size()) < size) {
+      return Error::INPUT_TOO_SMALL;
+    }
+    return std::make_pair(
+        static_cast<size_t>(encoded_data.size() - rest.size()), size);
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeNode(
-      const common::Buffer &encoded_data) const {
+      gsl::span<const uint8_t> encoded_data) const {
     BufferStream stream{encoded_data};
     // decode the header with the node type and the partial key length
     OUTCOME_TRY(header, decodeHeader(stream));
@@ -223,11 +346,11 @@ namespace kagome::storage::trie {
     switch (type) {
       case PolkadotNode::Type::Leaf: {
         OUTCOME_TRY(value, scale::decode<Buffer>(stream.leftBytes()));
-        return std::make_shared<LeafNode>(partial_key, value);
+        return makeNode<LeafNode>(std::move(partial_key), std::move(value));
       }
       case PolkadotNode::Type::BranchEmptyValue:
       case PolkadotNode::Type::BranchWithValue: {
-        return decodeBranch(type, partial_key, stream);
+        return decodeBranch(type, std::move(partial_key), stream);
       }
       default:
         return Error::UNKNOWN_NODE_TYPE;
@@ -266,33 +389,35 @@ namespace kagome::storage::trie {
       size_t nibbles_num, BufferStream &stream) const {
     // length in bytes is length in nibbles over two round up
     auto byte_length = nibbles_num / 2 + nibbles_num % 2;
-    Buffer partial_key;
-    partial_key.reserve(byte_length);
-    while (byte_length-- != 0) {
-      if (not stream.hasMore(1)) {
-        return Error::INPUT_TOO_SMALL;
-      }
-      partial_key.putUint8(stream.next());
+    if (not stream.hasMore(byte_length)) {
+      return Error::INPUT_TOO_SMALL;
     }
     // array of nibbles is much more convenient than array of bytes, though it
-    // wastes some memory
-    KeyNibbles partial_key_nibbles = keyToNibbles(partial_key);
-    if (nibbles_num % 2 == 1) {
-      partial_key_nibbles = partial_key_nibbles.subbuffer(1);
+    // wastes some memory. The nibbles are put right into the inline storage
+    // of the key, the high nibble of the first byte of an odd length key is
+    // the padding
+    KeyNibbles partial_key;
+    partial_key.reserve(nibbles_num);
+    for (size_t i = 0; i < byte_length; i++) {
+      auto byte = stream.next();
+      if (i != 0 or nibbles_num % 2 == 0) {
+        partial_key.putUint8(byte >> 4u);
+      }
+      partial_key.putUint8(byte & 0xfu);
     }
-    return partial_key_nibbles;
+    return partial_key;
   }
 
   outcome::result<std::shared_ptr<Node>> PolkadotCodec::decodeBranch(
       PolkadotNode::Type type,
-      const KeyNibbles &partial_key,
+      KeyNibbles partial_key,
       BufferStream &stream) const {
     constexpr uint8_t kChildrenBitmapSize = 2;
 
     if (not stream.hasMore(kChildrenBitmapSize)) {
       return Error::INPUT_TOO_SMALL;
     }
-    auto node = std::make_shared<BranchNode>(partial_key);
+    auto node = makeNode<BranchNode>(std::move(partial_key));
 
     uint16_t children_bitmap = stream.next();
     children_bitmap += stream.next() << 8u;
@@ -300,14 +425,14 @@ namespace kagome::storage::trie {
     scale::ScaleDecoderStream ss(stream.leftBytes());
 
     // decode the branch value if needed
-    common::Buffer value;
     if (type == PolkadotNode::Type::BranchWithValue) {
+      common::Buffer value;
       try {
         ss >> value;
       } catch (std::system_error &e) {
         return outcome::failure(e.code());
       }
-      node->value = value;
+      node->value = std::move(value);
     }
 
     uint8_t i = 0;
@@ -316,15 +441,23 @@ namespace kagome::storage::trie {
       if ((children_bitmap & (1u << i)) != 0) {
         // unset bit for this child
         children_bitmap &= ~(1u << i);
-        // read the hash of the child and make a dummy node from it for this
-        // child in the processed branch
-        common::Buffer child_hash;
+        // read the merkle value of the child. A hash makes a dummy node for
+        // the child in the processed branch, while a short encoding is the
+        // child itself, which is not stored apart from the branch
+        common::Buffer merkle_value;
         try {
-          ss >> child_hash;
+          ss >> merkle_value;
         } catch (std::system_error &e) {
           return outcome::failure(e.code());
         }
-        node->children.at(i) = std::make_shared<DummyNode>(child_hash);
+        if (merkle_value.size() < common::Hash256::size()) {
+          OUTCOME_TRY(child, decodeNode(merkle_value));
+          auto inline_child = std::dynamic_pointer_cast<PolkadotNode>(child);
+          inline_child->merkle_value = std::move(merkle_value);
+          node->children.set(i, std::move(inline_child));
+        } else {
+          node->children.set(i, makeNode<DummyNode>(std::move(merkle_value)));
+        }
       }
       i++;
     }
@@ -32,8 +32,11 @@ namespace kagome::storage::trie {
 
     outcome::result<Buffer> encodeNode(const Node &node) const override;
 
+    outcome::result<void> encodeNodeTo(const Node &node,
+                                       Buffer &out) const override;
+
     outcome::result<std::shared_ptr<Node>> decodeNode(
-        const common::Buffer &encoded_data) const override;
+        gsl::span<const uint8_t> encoded_data) const override;
 
     common::Buffer merkleValue(const Buffer &buf) const override;
 
@@ -56,9 +59,26 @@ namespace kagome::storage::trie {
      */
     outcome::result<Buffer> encodeHeader(const PolkadotNode &node) const;
 
+    /**
+     * Finds the value in \arg encoded_data of a node without decoding it
+     * @return the offset and the size of the SCALE-encoded value, which is
+     * its length followed by its bytes, none if the node has no value
+     */
+    outcome::result<boost::optional<std::pair<size_t, size_t>>> locateValue(
+        gsl::span<const uint8_t> encoded_data) const;
+
    private:
-    outcome::result<Buffer> encodeBranch(const BranchNode &node) const;
-    outcome::result<Buffer> encodeLeaf(const LeafNode &node) const;
+    outcome::result<void> putHeader(const PolkadotNode &node,
+                                    Buffer &out) const;
+    static void putPartialKey(const KeyNibbles &nibbles, Buffer &out);
+    /**
+     * Appends SCALE-encoded \arg merkle_value of a child to \arg out
+     */
+    static void putMerkleValue(const Buffer &merkle_value, Buffer &out);
+
+    outcome::result<void> encodeBranch(const BranchNode &node,
+                                       Buffer &out) const;
+    outcome::result<void> encodeLeaf(const LeafNode &node, Buffer &out) const;
 
     outcome::result<std::pair<PolkadotNode::Type, size_t>> decodeHeader(
         BufferStream &stream) const;
@@ -68,7 +88,7 @@ namespace kagome::storage::trie {
 
     outcome::result<std::shared_ptr<Node>> decodeBranch(
         PolkadotNode::Type type,
-        const KeyNibbles &partial_key,
+        KeyNibbles partial_key,
         BufferStream &stream) const;
   };
 
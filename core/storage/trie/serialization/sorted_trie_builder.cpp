@@ -0,0 +1,150 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/sorted_trie_builder.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::storage::trie, SortedTrieBuilderError, e) {
+  using E = kagome::storage::trie::SortedTrieBuilderError;
+  switch (e) {
+    case E::UNSORTED_KEYS:
+      return "The keys of the sorted trie are not in the ascending order";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::storage::trie {
+
+  SortedTrieBuilder::SortedTrieBuilder(
+      std::shared_ptr<Codec> codec,
+      std::shared_ptr<TrieStorageBackend> backend,
+      std::shared_ptr<TriePruner> pruner)
+      : codec_{std::move(codec)},
+        backend_{std::move(backend)},
+        pruner_{std::move(pruner)} {
+    BOOST_ASSERT(codec_ != nullptr);
+    BOOST_ASSERT(backend_ != nullptr);
+  }
+
+  outcome::result<void> SortedTrieBuilder::add(
+      gsl::span<const uint8_t> key, gsl::span<const uint8_t> value) {
+    auto nibbles = NibbleView::ofKey(key);
+    if (not path_.empty()) {
+      auto common_prefix =
+          NibbleView::commonPrefixLength(last_key_, nibbles);
+      // the last key is either a prefix of the key or is less in the first
+      // nibble they differ in
+      bool ascending = common_prefix < nibbles.size()
+                       and (common_prefix == last_key_.size()
+                            or last_key_[common_prefix]
+                                   < nibbles[common_prefix]);
+      if (not ascending) {
+        return SortedTrieBuilderError::UNSORTED_KEYS;
+      }
+      OUTCOME_TRY(closeAfter(common_prefix));
+    }
+    auto depth = path_.empty() ? 0 : path_.back().key_end + 1;
+    last_key_ = nibbles.toNibbles();
+    path_.push_back(OpenNode{
+        depth,
+        last_key_.size(),
+        makeNode<BranchNode>(KeyNibbles{}, common::Buffer{value})});
+    return outcome::success();
+  }
+
+  outcome::result<common::Buffer> SortedTrieBuilder::finish() {
+    if (path_.empty()) {
+      // @see TrieSerializer::getEmptyRootHash
+      return common::Buffer{codec_->hash256({0})};
+    }
+    // all the nodes are closed but the root, which is hashed anyway
+    OUTCOME_TRY(closeAfter(path_.front().key_end));
+    auto root = std::move(path_.back());
+    path_.clear();
+    OUTCOME_TRY(root_hash, store(root, true));
+    last_key_.clear();
+    if (pruner_ != nullptr) {
+      auto nodes = std::move(pruner_nodes_);
+      pruner_nodes_.clear();
+      OUTCOME_TRY(pruner_->addState(root_hash, nodes));
+    } else if (batch_ != nullptr) {
+      auto batch = std::move(batch_);
+      batched_nodes_ = 0;
+      OUTCOME_TRY(batch->commit());
+    }
+    return root_hash;
+  }
+
+  outcome::result<void> SortedTrieBuilder::closeAfter(size_t common_prefix) {
+    boost::optional<OpenNode> closed;
+    while (not path_.empty() and path_.back().key_end > common_prefix) {
+      auto open = std::move(path_.back());
+      path_.pop_back();
+      if (closed) {
+        OUTCOME_TRY(merkle_value, store(*closed, false));
+        open.node->children.set(last_key_[open.key_end],
+                                makeNode<DummyNode>(std::move(merkle_value)));
+      }
+      closed = std::move(open);
+    }
+    if (not closed) {
+      return outcome::success();
+    }
+    // the keys part after the common prefix, so there is a branch there
+    if (path_.empty() or path_.back().key_end < common_prefix) {
+      path_.push_back(OpenNode{
+          closed->depth, common_prefix, makeNode<BranchNode>()});
+      closed->depth = common_prefix + 1;
+    }
+    OUTCOME_TRY(merkle_value, store(*closed, false));
+    path_.back().node->children.set(
+        last_key_[common_prefix], makeNode<DummyNode>(std::move(merkle_value)));
+    return outcome::success();
+  }
+
+  outcome::result<common::Buffer> SortedTrieBuilder::store(OpenNode &open,
+                                                           bool is_root) {
+    auto &node = *open.node;
+    node.key_nibbles =
+        last_key_.subspan(open.depth, open.key_end - open.depth);
+    common::Buffer encoding;
+    if (node.children.count() == 0) {
+      OUTCOME_TRY(leaf_encoding,
+                  codec_->encodeNode(LeafNode{std::move(node.key_nibbles),
+                                              std::move(node.value)}));
+      encoding = std::move(leaf_encoding);
+    } else {
+      OUTCOME_TRY(branch_encoding, codec_->encodeNode(node));
+      encoding = std::move(branch_encoding);
+    }
+    auto key = is_root ? common::Buffer{codec_->hash256(encoding)}
+                       : codec_->merkleValue(encoding);
+    // a short node is embedded in its parent, so it is not stored apart
+    if (key.size() == common::Hash256::size()) {
+      OUTCOME_TRY(put(key, std::move(encoding)));
+    }
+    return key;
+  }
+
+  outcome::result<void> SortedTrieBuilder::put(common::Buffer key,
+                                               common::Buffer encoding) {
+    if (pruner_ != nullptr) {
+      pruner_nodes_.emplace_back(std::move(key), std::move(encoding));
+      return outcome::success();
+    }
+    if (batch_ == nullptr) {
+      batch_ = backend_->batch();
+    }
+    OUTCOME_TRY(batch_->put(key, std::move(encoding)));
+    // the nodes are addressed by their content, so the ones of a failed
+    // build left in the storage do no harm
+    if (++batched_nodes_ == kNodesPerBatch) {
+      auto batch = std::move(batch_);
+      batched_nodes_ = 0;
+      OUTCOME_TRY(batch->commit());
+    }
+    return outcome::success();
+  }
+
+}  // namespace kagome::storage::trie
@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_SORTED_TRIE_BUILDER_HPP
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_SORTED_TRIE_BUILDER_HPP
+
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
+
+#include "common/buffer.hpp"
+#include "outcome/outcome.hpp"
+#include "storage/trie/codec.hpp"
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+#include "storage/trie/trie_pruner.hpp"
+#include "storage/trie/trie_storage_backend.hpp"
+
+namespace kagome::storage::trie {
+
+  enum class SortedTrieBuilderError { UNSORTED_KEYS = 1 };
+
+  /**
+   * Stores the trie of the entries, which are added in the ascending order
+   * of their keys, as the ones of a genesis state are, without building it
+   * in the memory. A node is complete once the keys go past it, then it is
+   * encoded and written to the storage right away, so only the nodes on the
+   * path to the last key are kept, which are as many as its nibbles at most.
+   * The nodes are the very ones TrieSerializer stores for the same entries
+   */
+  class SortedTrieBuilder {
+   public:
+    /// number of the nodes written to the storage in a batch
+    static constexpr size_t kNodesPerBatch = 4096;
+
+    /**
+     * @param pruner if set, the nodes are handed to it at once with the
+     * root, instead of being written in batches, as it counts the references
+     * to them
+     */
+    SortedTrieBuilder(std::shared_ptr<Codec> codec,
+                      std::shared_ptr<TrieStorageBackend> backend,
+                      std::shared_ptr<TriePruner> pruner = nullptr);
+
+    /**
+     * Adds the entry of \arg key, which is greater than the keys added
+     * before, and \arg value, and stores the nodes the key goes past
+     */
+    outcome::result<void> add(gsl::span<const uint8_t> key,
+                              gsl::span<const uint8_t> value);
+
+    /**
+     * Stores the rest of the nodes, the root being the last of them. The
+     * builder is empty afterwards
+     * @return the root hash of the trie, which is the storage key of its
+     * root, or the one of the empty trie if nothing was added
+     */
+    outcome::result<common::Buffer> finish();
+
+   private:
+    // a node on the path to the last key, its partial key is the nibbles
+    // [depth, key_end) of the key, and its children are at key_end
+    struct OpenNode {
+      size_t depth;
+      size_t key_end;
+      std::shared_ptr<BranchNode> node;
+    };
+
+    /**
+     * Stores the nodes having their children after \arg common_prefix
+     * nibbles of the last key, which the next key doesn't share, and links
+     * them to their parents. If the parent of the topmost of them is not on
+     * the path, a branch is opened at \arg common_prefix for them
+     */
+    outcome::result<void> closeAfter(size_t common_prefix);
+
+    /**
+     * Encodes \arg open and writes it to the storage
+     * @return its merkle value, or the hash of its encoding if \arg is_root
+     */
+    outcome::result<common::Buffer> store(OpenNode &open, bool is_root);
+
+    outcome::result<void> put(common::Buffer key, common::Buffer encoding);
+
+    std::shared_ptr<Codec> codec_;
+    std::shared_ptr<TrieStorageBackend> backend_;
+    std::shared_ptr<TriePruner> pruner_;
+
+    std::vector<OpenNode> path_;
+    KeyNibbles last_key_;
+    std::unique_ptr<BufferBatch> batch_;
+    size_t batched_nodes_ = 0;
+    // the nodes to be handed to the pruner
+    std::vector<std::pair<common::Buffer, common::Buffer>> pruner_nodes_;
+  };
+
+}  // namespace kagome::storage::trie
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::storage::trie, SortedTrieBuilderError);
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_SORTED_TRIE_BUILDER_HPP
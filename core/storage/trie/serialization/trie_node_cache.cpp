@@ -0,0 +1,106 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+namespace kagome::storage::trie {
+
+  TrieNodeCache::TrieNodeCache(size_t capacity) : capacity_{capacity} {}
+
+  boost::optional<PolkadotTrie::NodePtr> TrieNodeCache::get(
+      const common::Buffer &db_key) const {
+    std::lock_guard lock{mutex_};
+    auto it = index_.find(db_key);
+    if (it == index_.end()) {
+      ++misses_;
+      return boost::none;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return copyNode(*it->second->second);
+  }
+
+  void TrieNodeCache::put(const common::Buffer &db_key,
+                          const PolkadotNode &node) {
+    auto copy = copyNode(node);
+    if (copy == nullptr) {
+      return;
+    }
+    std::lock_guard lock{mutex_};
+    if (capacity_ == 0) {
+      return;
+    }
+    if (auto it = index_.find(db_key); it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    entries_.emplace_front(db_key, std::move(copy));
+    index_.emplace(db_key, entries_.begin());
+    evict();
+  }
+
+  void TrieNodeCache::evict() {
+    while (index_.size() > capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  size_t TrieNodeCache::size() const {
+    std::lock_guard lock{mutex_};
+    return index_.size();
+  }
+
+  size_t TrieNodeCache::capacity() const {
+    std::lock_guard lock{mutex_};
+    return capacity_;
+  }
+
+  common::BudgetedCache::Usage TrieNodeCache::usage() const {
+    std::lock_guard lock{mutex_};
+    return {index_.size() * kEntryBytes, hits_, misses_};
+  }
+
+  void TrieNodeCache::setBudget(size_t bytes) {
+    std::lock_guard lock{mutex_};
+    capacity_ = bytes / kEntryBytes;
+    evict();
+  }
+
+  PolkadotTrie::NodePtr TrieNodeCache::copyNode(const PolkadotNode &node) {
+    using T = PolkadotNode::Type;
+    PolkadotTrie::NodePtr copy;
+    switch (node.getTrieType()) {
+      case T::Leaf:
+        copy = makeNode<LeafNode>(node.key_nibbles, node.value);
+        break;
+      case T::BranchEmptyValue:
+      case T::BranchWithValue: {
+        auto &branch = static_cast<const BranchNode &>(node);
+        auto branch_copy =
+            makeNode<BranchNode>(branch.key_nibbles, branch.value);
+        // dummy children are never modified, so they can be shared between
+        // the copies, while the short children embedded in the branch are
+        // copied, as a trie modifies its nodes in place
+        for (size_t i = 0; i < branch.children.size(); i++) {
+          auto &child = branch.children.at(i);
+          if (child == nullptr) {
+            continue;
+          }
+          branch_copy->children.set(
+              i, child->isDummy() ? child : copyNode(*child));
+        }
+        copy = std::move(branch_copy);
+        break;
+      }
+      default:
+        // dummy nodes are not worth caching
+        return nullptr;
+    }
+    copy->merkle_value = node.merkle_value;
+    return copy;
+  }
+
+}  // namespace kagome::storage::trie
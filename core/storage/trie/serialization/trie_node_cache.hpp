@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "common/budgeted_cache.hpp"
+#include "common/buffer.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Bounded LRU cache of decoded trie nodes, shared between all tries
+   * retrieved by a serializer. Keyed by the merkle value of a node, which is
+   * also its key in the storage, so an entry never becomes stale.
+   * Tries modify their nodes in place, that is why only detached copies of
+   * nodes are stored and handed out. Children of a cached branch are always
+   * dummy nodes, so a copy is shallow and cheap.
+   */
+  class TrieNodeCache : public common::BudgetedCache {
+   public:
+    /// estimated memory taken by a cached node with its key, as the sizes
+    /// of the nodes are not tracked
+    static constexpr size_t kEntryBytes = 512;
+
+    /**
+     * @param capacity max number of nodes kept in the cache, zero disables
+     * caching
+     */
+    explicit TrieNodeCache(size_t capacity);
+
+    /**
+     * @return a copy of the node stored by \arg db_key, none if it is not
+     * cached
+     */
+    boost::optional<PolkadotTrie::NodePtr> get(
+        const common::Buffer &db_key) const;
+
+    /**
+     * Stores a copy of \arg node, evicting the least recently used entry
+     * if the cache is full.
+     * @note all children of the node (if it is a branch) must be dummy nodes
+     */
+    void put(const common::Buffer &db_key, const PolkadotNode &node);
+
+    size_t size() const;
+    size_t capacity() const;
+
+    Usage usage() const override;
+
+    /// sets the capacity to the number of nodes estimated to fit \arg bytes
+    void setBudget(size_t bytes) override;
+
+   private:
+    using Entry = std::pair<common::Buffer, PolkadotTrie::NodePtr>;
+    using EntryList = std::list<Entry>;
+
+    static PolkadotTrie::NodePtr copyNode(const PolkadotNode &node);
+
+    /// evicts the least recently used entries over the capacity
+    void evict();
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    mutable uint64_t hits_ = 0;
+    mutable uint64_t misses_ = 0;
+    // the most recently used entry is at the front
+    mutable EntryList entries_;
+    std::unordered_map<common::Buffer, EntryList::iterator> index_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_NODE_CACHE
@@ -0,0 +1,59 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_PROOF_RECORDER
+#define KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_PROOF_RECORDER
+
+#include <set>
+#include <vector>
+
+#include "common/buffer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Collects the encoded nodes read from the storage while a trie is
+   * traversed, which make up a merkle proof of the values read. Each node
+   * is recorded once, however many lookups pass through it. Not thread-safe,
+   * a recorder serves a single proof
+   */
+  class TrieProofRecorder {
+   public:
+    /**
+     * @return true if the node stored by \arg db_key is recorded already
+     */
+    bool contains(const common::Buffer &db_key) const {
+      return recorded_.count(db_key) != 0;
+    }
+
+    /**
+     * Records \arg encoding of the node stored by \arg db_key, unless it is
+     * recorded already
+     */
+    void record(const common::Buffer &db_key, common::Buffer encoding) {
+      if (recorded_.insert(db_key).second) {
+        nodes_.emplace_back(std::move(encoding));
+      }
+    }
+
+    /**
+     * @return the recorded nodes in the order they were visited, the
+     * recorder is left empty
+     */
+    std::vector<common::Buffer> release() {
+      recorded_.clear();
+      auto nodes = std::move(nodes_);
+      nodes_.clear();
+      return nodes;
+    }
+
+   private:
+    std::set<common::Buffer> recorded_;
+    std::vector<common::Buffer> nodes_;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_SERIALIZATION_TRIE_PROOF_RECORDER
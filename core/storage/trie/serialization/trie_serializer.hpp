@@ -8,6 +8,7 @@
 
 #include "outcome/outcome.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie.hpp"
+#include "storage/trie/serialization/trie_proof_recorder.hpp"
 
 namespace kagome::storage::trie {
 
@@ -29,12 +30,40 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<common::Buffer> storeTrie(PolkadotTrie &trie) = 0;
 
+    /**
+     * Calculates the root hash of a trie without writing anything to the
+     * storage. The merkle values of the modified nodes are kept in them, so
+     * that the next calculation or store of the trie hashes only the nodes
+     * modified since then
+     */
+    virtual outcome::result<common::Buffer> calculateRoot(
+        PolkadotTrie &trie) const = 0;
+
     /**
      * Fetches a trie from the storage. A nullptr is returned in case that there
      * is no entry for provided key.
      */
     virtual outcome::result<std::unique_ptr<PolkadotTrie>> retrieveTrie(
         const common::Buffer &db_key) const = 0;
+
+    /**
+     * Fetches a trie from the storage, which never attaches the nodes it
+     * loads to their parents, so that it stays unchanged and can be read by
+     * several threads at once. Its nodes are taken from the shared cache of
+     * decoded nodes, when they are there
+     */
+    virtual outcome::result<std::unique_ptr<const PolkadotTrie>>
+    retrieveImmutableTrie(const common::Buffer &db_key) const = 0;
+
+    /**
+     * Same as retrieveImmutableTrie, but the stored encodings of the nodes
+     * the trie visits are passed to \arg recorder as they are read, so that
+     * the lookups made in the trie produce a proof of their results
+     */
+    virtual outcome::result<std::unique_ptr<const PolkadotTrie>>
+    retrieveRecordingTrie(
+        const common::Buffer &db_key,
+        std::shared_ptr<TrieProofRecorder> recorder) const = 0;
   };
 
 }  // namespace kagome::storage::trie
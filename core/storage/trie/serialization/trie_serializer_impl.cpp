@@ -5,18 +5,110 @@
 
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 
+#include <future>
+
 namespace kagome::storage::trie {
 
+  namespace {
+    /**
+     * Accumulates puts made by a thread storing a subtree, so that they can
+     * be moved to the actual batch, which is not thread-safe, later on. Also
+     * collects the nodes of a trie to be handed to a pruner at once
+     */
+    class CollectingBatch : public BufferBatch {
+     public:
+      outcome::result<void> put(const Buffer &key,
+                                const Buffer &value) override {
+        entries.emplace_back(key, value);
+        return outcome::success();
+      }
+
+      outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+        entries.emplace_back(key, std::move(value));
+        return outcome::success();
+      }
+
+      outcome::result<void> remove(const Buffer &key) override {
+        // trie nodes are never removed while being stored
+        return std::errc::operation_not_supported;
+      }
+
+      outcome::result<void> commit() override {
+        return outcome::success();
+      }
+
+      void clear() override {
+        entries.clear();
+      }
+
+      std::vector<std::pair<Buffer, Buffer>> entries;
+    };
+
+    /**
+     * @return number of dirty nodes in the subtree of \arg node, but not
+     * more than \arg limit, so that a big trie isn't walked in whole
+     */
+    size_t countDirtyNodes(const PolkadotNode &node, size_t limit) {
+      if (node.isDummy() or not node.isDirty() or limit == 0) {
+        return 0;
+      }
+      size_t count = 1;
+      if (node.getTrieType() == PolkadotNode::Type::BranchEmptyValue
+          or node.getTrieType() == PolkadotNode::Type::BranchWithValue) {
+        for (auto &child : static_cast<const BranchNode &>(node).children) {
+          if (count >= limit) {
+            break;
+          }
+          count += countDirtyNodes(*child, limit - count);
+        }
+      }
+      return count;
+    }
+
+    /**
+     * @return scratch buffer of the thread, emptied, to encode a node to.
+     * It is reused by the subsequent nodes, so that it is grown once to the
+     * size of the largest node instead of being allocated for every node
+     */
+    Buffer &threadScratch() {
+      thread_local Buffer scratch;
+      scratch.clear();
+      return scratch;
+    }
+
+    /**
+     * @return merkle value of a node with \arg encoding, which is stored by
+     * \arg db_key. Either the encoding itself if it is short, or its hash,
+     * which is the very key then, so that it isn't calculated once again
+     */
+    Buffer merkleValueOfStored(gsl::span<const uint8_t> encoding,
+                               const Buffer &db_key) {
+      if (static_cast<size_t>(encoding.size()) < common::Hash256::size()) {
+        return Buffer{encoding};
+      }
+      return db_key;
+    }
+  }  // namespace
+
   TrieSerializerImpl::TrieSerializerImpl(
       std::shared_ptr<PolkadotTrieFactory> factory,
       std::shared_ptr<Codec> codec,
-      std::shared_ptr<TrieStorageBackend> backend)
+      std::shared_ptr<TrieStorageBackend> backend,
+      std::shared_ptr<TrieNodeCache> node_cache,
+      std::shared_ptr<TriePruner> pruner,
+      std::shared_ptr<common::Tracer> tracer,
+      std::shared_ptr<common::WorkerPool> workers)
       : trie_factory_{std::move(factory)},
         codec_{std::move(codec)},
-        backend_{std::move(backend)} {
+        backend_{std::move(backend)},
+        node_cache_{std::move(node_cache)},
+        pruner_{std::move(pruner)},
+        tracer_{std::move(tracer)},
+        workers_{std::move(workers)} {
     BOOST_ASSERT(trie_factory_ != nullptr);
     BOOST_ASSERT(codec_ != nullptr);
     BOOST_ASSERT(backend_ != nullptr);
+    BOOST_ASSERT(node_cache_ != nullptr);
   }
 
   Buffer TrieSerializerImpl::getEmptyRootHash() const {
@@ -24,12 +116,53 @@ namespace kagome::storage::trie {
   }
 
   outcome::result<Buffer> TrieSerializerImpl::storeTrie(PolkadotTrie &trie) {
+    common::Tracer::Scope span{tracer_.get(), "trie", "store_trie"};
     if (trie.getRoot() == nullptr) {
       return getEmptyRootHash();
     }
     return storeRootNode(*trie.getRoot());
   }
 
+  outcome::result<Buffer> TrieSerializerImpl::calculateRoot(
+      PolkadotTrie &trie) const {
+    common::Tracer::Scope span{tracer_.get(), "trie", "calculate_root"};
+    auto root = trie.getRoot();
+    if (root == nullptr) {
+      return getEmptyRootHash();
+    }
+    if (not root->isDirty()
+        and root->merkle_value->size() == common::Hash256::size()) {
+      return root->merkle_value.value();
+    }
+    OUTCOME_TRY(calculateChildren(*root));
+    // the root is hashed even if its encoding is short, so it is encoded
+    // every time, which is cheap with the merkle values of its children
+    auto &enc = threadScratch();
+    OUTCOME_TRY(codec_->encodeNodeTo(*root, enc));
+    return Buffer{codec_->hash256(enc)};
+  }
+
+  outcome::result<void> TrieSerializerImpl::calculateChildren(
+      const PolkadotNode &node) const {
+    using T = PolkadotNode::Type;
+    if (node.getTrieType() != T::BranchEmptyValue
+        and node.getTrieType() != T::BranchWithValue) {
+      return outcome::success();
+    }
+    for (auto &child : static_cast<const BranchNode &>(node).children) {
+      if (child == nullptr or child->isDummy() or not child->isDirty()
+          or child->calculated_merkle_value) {
+        continue;
+      }
+      OUTCOME_TRY(calculateChildren(*child));
+      // the children of the child are done, so the scratch is free
+      auto &enc = threadScratch();
+      OUTCOME_TRY(codec_->encodeNodeTo(*child, enc));
+      child->calculated_merkle_value = codec_->merkleValue(enc);
+    }
+    return outcome::success();
+  }
+
   outcome::result<std::unique_ptr<PolkadotTrie>>
   TrieSerializerImpl::retrieveTrie(const common::Buffer &db_key) const {
     PolkadotTrieFactory::ChildRetrieveFunctor f =
@@ -43,9 +176,66 @@ namespace kagome::storage::trie {
     return trie_factory_->createFromRoot(std::move(root), std::move(f));
   }
 
+  outcome::result<std::unique_ptr<const PolkadotTrie>>
+  TrieSerializerImpl::retrieveImmutableTrie(
+      const common::Buffer &db_key) const {
+    // unlike retrieveChild, a loaded child is only handed to the caller and
+    // its parent keeps the dummy node
+    PolkadotTrieFactory::ChildRetrieveFunctor f =
+        [this](const PolkadotTrie::BranchPtr &parent,
+               uint8_t idx) -> outcome::result<PolkadotTrie::NodePtr> {
+          auto child = parent->children.at(idx);
+          if (child == nullptr or not child->isDummy()) {
+            return child;
+          }
+          return retrieveNode(static_cast<const DummyNode &>(*child).db_key);
+        };
+    if (db_key == getEmptyRootHash()) {
+      return trie_factory_->createEmpty(std::move(f));
+    }
+    OUTCOME_TRY(root, retrieveNode(db_key));
+    return trie_factory_->createFromRoot(std::move(root), std::move(f));
+  }
+
+  outcome::result<std::unique_ptr<const PolkadotTrie>>
+  TrieSerializerImpl::retrieveRecordingTrie(
+      const common::Buffer &db_key,
+      std::shared_ptr<TrieProofRecorder> recorder) const {
+    BOOST_ASSERT(recorder != nullptr);
+    PolkadotTrieFactory::ChildRetrieveFunctor f =
+        [this, recorder](const PolkadotTrie::BranchPtr &parent, uint8_t idx)
+        -> outcome::result<PolkadotTrie::NodePtr> {
+          auto child = parent->children.at(idx);
+          if (child == nullptr or not child->isDummy()) {
+            return child;
+          }
+          return retrieveRecordedNode(
+              static_cast<const DummyNode &>(*child).db_key, *recorder);
+        };
+    if (db_key == getEmptyRootHash()) {
+      return trie_factory_->createEmpty(std::move(f));
+    }
+    OUTCOME_TRY(root, retrieveRecordedNode(db_key, *recorder));
+    return trie_factory_->createFromRoot(std::move(root), std::move(f));
+  }
+
   outcome::result<Buffer> TrieSerializerImpl::storeRootNode(
       PolkadotNode &node) {
-    auto batch = backend_->batch();
+    // an unmodified root is already in the storage by its hash
+    if (not node.isDirty()
+        and node.merkle_value->size() == common::Hash256::size()) {
+      if (pruner_ != nullptr) {
+        // the state is committed once again and is kept until it is pruned
+        // as many times
+        OUTCOME_TRY(pruner_->addState(node.merkle_value.value(), {}));
+      }
+      return node.merkle_value.value();
+    }
+    // in the pruning mode the pruner writes the nodes itself, as it has to
+    // tell the fresh nodes from the already stored ones
+    CollectingBatch collected_nodes;
+    auto backend_batch = pruner_ == nullptr ? backend_->batch() : nullptr;
+    BufferBatch &batch = pruner_ == nullptr ? *backend_batch : collected_nodes;
     using T = PolkadotNode::Type;
 
     // if node is a branch node, its children must be stored to the storage
@@ -54,19 +244,41 @@ namespace kagome::storage::trie {
     if (node.getTrieType() == T::BranchEmptyValue
         || node.getTrieType() == T::BranchWithValue) {
       auto &branch = dynamic_cast<BranchNode &>(node);
-      OUTCOME_TRY(storeChildren(branch, *batch));
+      if (workers_ != nullptr and workers_->threadsNum() > 1
+          and countDirtyNodes(node, kParallelStoreThreshold)
+                  >= kParallelStoreThreshold) {
+        OUTCOME_TRY(storeChildrenInParallel(branch, batch));
+      } else {
+        OUTCOME_TRY(storeChildren(branch, batch));
+      }
     }
 
-    OUTCOME_TRY(enc, codec_->encodeNode(node));
+    auto &enc = threadScratch();
+    OUTCOME_TRY(codec_->encodeNodeTo(node, enc));
     auto key = Buffer{codec_->hash256(enc)};
-    OUTCOME_TRY(batch->put(key, enc));
-    OUTCOME_TRY(batch->commit());
+    auto merkle_value = merkleValueOfStored(enc, key);
+    OUTCOME_TRY(batch.put(key, enc));
+    if (pruner_ != nullptr) {
+      OUTCOME_TRY(pruner_->addState(key, collected_nodes.entries));
+    } else {
+      OUTCOME_TRY(batch.commit());
+    }
+    node.merkle_value = std::move(merkle_value);
+    // the new root is the most likely node to be read next, as tries are
+    // retrieved by their state roots. Cached only after a successful commit,
+    // so that nothing is served from the cache that didn't reach the storage
+    node_cache_->put(key, node);
 
     return key;
   }
 
   outcome::result<common::Buffer> TrieSerializerImpl::storeNode(
       PolkadotNode &node, BufferBatch &batch) {
+    // neither the node nor its descendants were modified since the node was
+    // read from the storage
+    if (not node.isDirty()) {
+      return node.merkle_value.value();
+    }
     using T = PolkadotNode::Type;
 
     // if node is a branch node, its children must be stored to the storage
@@ -77,9 +289,19 @@ namespace kagome::storage::trie {
       auto &branch = dynamic_cast<BranchNode &>(node);
       OUTCOME_TRY(storeChildren(branch, batch));
     }
-    OUTCOME_TRY(enc, codec_->encodeNode(node));
-    auto key = Buffer{codec_->merkleValue(enc)};
-    OUTCOME_TRY(batch.put(key, enc));
+    // the children are stored before, so the scratch is free
+    auto &enc = threadScratch();
+    OUTCOME_TRY(codec_->encodeNodeTo(node, enc));
+    // the merkle value calculated for the root of the trie is still valid,
+    // as the node is not modified since then
+    auto key = node.calculated_merkle_value
+                   ? node.calculated_merkle_value.value()
+                   : Buffer{codec_->merkleValue(enc)};
+    // a short node is embedded in its parent's encoding, so it is not worth a
+    // separate entry
+    if (key.size() == common::Hash256::size()) {
+      OUTCOME_TRY(batch.put(key, enc));
+    }
     return key;
   }
 
@@ -87,27 +309,81 @@ namespace kagome::storage::trie {
                                                           BufferBatch &batch) {
     for (auto &child : branch.children) {
       if (child and not child->isDummy()) {
-        OUTCOME_TRY(hash, storeNode(*child, batch));
-        // when a node is written to the storage, it is replaced with a dummy
-        // node to avoid memory waste
-        child = std::make_shared<DummyNode>(hash);
+        OUTCOME_TRY(merkle_value, storeNode(*child, batch));
+        setStoredChild(child, std::move(merkle_value));
+      }
+    }
+    return outcome::success();
+  }
+
+  outcome::result<void> TrieSerializerImpl::storeChildrenInParallel(
+      BranchNode &branch, BufferBatch &batch) {
+    std::vector<std::reference_wrapper<PolkadotTrie::NodePtr>> dirty_children;
+    for (auto &child : branch.children) {
+      if (child->isDummy()) {
+        continue;
+      }
+      if (child->isDirty()) {
+        dirty_children.emplace_back(child);
+      } else {
+        setStoredChild(child, child->merkle_value.value());
       }
     }
+
+    // subtrees of different children share no nodes, and the codec is
+    // stateless, so they can be safely encoded and hashed concurrently
+    std::vector<CollectingBatch> subtree_batches(dirty_children.size());
+    std::vector<std::future<outcome::result<Buffer>>> merkle_values;
+    merkle_values.reserve(dirty_children.size());
+    for (size_t i = 0; i < dirty_children.size(); i++) {
+      merkle_values.emplace_back(workers_->async(
+          [this,
+           &child = *dirty_children[i].get(),
+           &subtree_batch = subtree_batches[i]] {
+            return storeNode(child, subtree_batch);
+          }));
+    }
+    // all of the workers are done with the batches before an early return
+    // destroys them
+    for (auto &merkle_value : merkle_values) {
+      merkle_value.wait();
+    }
+
+    for (size_t i = 0; i < dirty_children.size(); i++) {
+      OUTCOME_TRY(merkle_value, merkle_values[i].get());
+      for (auto &[key, value] : subtree_batches[i].entries) {
+        OUTCOME_TRY(batch.put(key, std::move(value)));
+      }
+      setStoredChild(dirty_children[i].get(), std::move(merkle_value));
+    }
     return outcome::success();
   }
 
+  void TrieSerializerImpl::setStoredChild(PolkadotTrie::NodePtr &child,
+                                          Buffer merkle_value) {
+    // when a node is written to the storage, it is replaced with a dummy
+    // node to avoid memory waste. A short node is not in the storage, so it
+    // is kept, as it would be decoded from its parent anyway
+    if (merkle_value.size() < common::Hash256::size()) {
+      child->merkle_value = std::move(merkle_value);
+    } else {
+      child = makeNode<DummyNode>(std::move(merkle_value));
+    }
+  }
+
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveChild(
       const PolkadotTrie::BranchPtr &parent, uint8_t idx) const {
-    if (parent->children.at(idx) == nullptr) {
+    auto &child = parent->children.at(idx);
+    if (child == nullptr) {
       return nullptr;
     }
-    if (parent->children.at(idx)->isDummy()) {
-      auto dummy =
-          std::dynamic_pointer_cast<DummyNode>(parent->children.at(idx));
-      OUTCOME_TRY(n, retrieveNode(dummy->db_key));
-      parent->children.at(idx) = n;
+    if (child->isDummy()) {
+      OUTCOME_TRY(n,
+                  retrieveNode(static_cast<const DummyNode &>(*child).db_key));
+      parent->children.set(idx, n);
+      return std::move(n);
     }
-    return parent->children.at(idx);
+    return child;
   }
 
   outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::retrieveNode(
@@ -115,9 +391,64 @@ namespace kagome::storage::trie {
     if (db_key.empty() or db_key == getEmptyRootHash()) {
       return nullptr;
     }
+    // a short node is not stored, its merkle value is its encoding
+    if (db_key.size() < common::Hash256::size()) {
+      OUTCOME_TRY(n, codec_->decodeNode(db_key));
+      auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+      node->merkle_value = db_key;
+      return node;
+    }
+    if (auto cached = node_cache_->get(db_key); cached) {
+      return std::move(cached.value());
+    }
+    // the node is decoded in place, as the encoding is not needed after that.
+    // A large value kept apart from the node is read once it is needed, and
+    // the copies of the node in the cache share it then
+    OUTCOME_TRY(stored, backend_->getNodeWithoutValue(db_key));
+    auto &[enc, without_value] = stored;
+    if (not without_value) {
+      return decodeStoredNode(db_key, enc.view());
+    }
+    OUTCOME_TRY(n, codec_->decodeNode(enc.view()));
+    auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+    node->value = NodeValue::lazy(
+        [backend = backend_, db_key] { return backend->getNodeValue(db_key); });
+    // such a node is not short, so it is stored by its hash
+    node->merkle_value = db_key;
+    node_cache_->put(db_key, *node);
+    return node;
+  }
+
+  outcome::result<PolkadotTrie::NodePtr>
+  TrieSerializerImpl::retrieveRecordedNode(const common::Buffer &db_key,
+                                           TrieProofRecorder &recorder) const {
+    if (db_key.size() != common::Hash256::size() or recorder.contains(db_key)
+        or db_key == getEmptyRootHash()) {
+      return retrieveNode(db_key);
+    }
+    // the encoding is read once and recorded as it is stored, the node
+    // itself is still taken from the cache if it is there
     OUTCOME_TRY(enc, backend_->get(db_key));
-    OUTCOME_TRY(n, codec_->decodeNode(enc));
-    return std::dynamic_pointer_cast<PolkadotNode>(n);
+    PolkadotTrie::NodePtr node;
+    if (auto cached = node_cache_->get(db_key); cached) {
+      node = std::move(cached.value());
+    } else {
+      OUTCOME_TRY(decoded, decodeStoredNode(db_key, enc));
+      node = std::move(decoded);
+    }
+    recorder.record(db_key, std::move(enc));
+    return node;
+  }
+
+  outcome::result<PolkadotTrie::NodePtr> TrieSerializerImpl::decodeStoredNode(
+      const common::Buffer &db_key, gsl::span<const uint8_t> encoding) const {
+    OUTCOME_TRY(n, codec_->decodeNode(encoding));
+    auto node = std::dynamic_pointer_cast<PolkadotNode>(n);
+    node->merkle_value = merkleValueOfStored(encoding, db_key);
+    // a decoded node is cached before it is handed to a trie, which may
+    // modify it
+    node_cache_->put(db_key, *node);
+    return node;
   }
 
 }  // namespace kagome::storage::trie
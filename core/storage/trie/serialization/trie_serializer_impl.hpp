@@ -8,27 +8,60 @@
 
 #include "storage/trie/serialization/trie_serializer.hpp"
 
+#include "common/tracer.hpp"
+#include "common/worker_pool.hpp"
 #include "storage/buffer_map_types.hpp"
 #include "storage/trie/codec.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/trie_pruner.hpp"
 #include "storage/trie/trie_storage_backend.hpp"
 
 namespace kagome::storage::trie {
 
   class TrieSerializerImpl : public TrieSerializer {
    public:
+    /**
+     * Number of modified nodes in a trie starting from which the subtrees of
+     * its root are stored in parallel; smaller tries aren't worth handing
+     * to the workers
+     */
+    static constexpr size_t kParallelStoreThreshold = 4096;
+
+    /**
+     * @param pruner if set, stored nodes are passed to it instead of being
+     * written to \arg backend directly, so that they can be pruned later;
+     * nullptr means that nodes are never removed
+     * @param tracer records the spans of the stores of the tries, if any
+     * @param workers encode the subtrees of the large tries in parallel, if
+     * any; they are stored on the calling thread otherwise
+     */
     TrieSerializerImpl(std::shared_ptr<PolkadotTrieFactory> factory,
                        std::shared_ptr<Codec> codec,
-                       std::shared_ptr<TrieStorageBackend> backend);
+                       std::shared_ptr<TrieStorageBackend> backend,
+                       std::shared_ptr<TrieNodeCache> node_cache,
+                       std::shared_ptr<TriePruner> pruner = nullptr,
+                       std::shared_ptr<common::Tracer> tracer = nullptr,
+                       std::shared_ptr<common::WorkerPool> workers = nullptr);
     ~TrieSerializerImpl() override = default;
 
     common::Buffer getEmptyRootHash() const override;
 
     outcome::result<common::Buffer> storeTrie(PolkadotTrie &trie) override;
 
+    outcome::result<common::Buffer> calculateRoot(
+        PolkadotTrie &trie) const override;
+
     outcome::result<std::unique_ptr<PolkadotTrie>> retrieveTrie(
         const common::Buffer &db_key) const override;
 
+    outcome::result<std::unique_ptr<const PolkadotTrie>> retrieveImmutableTrie(
+        const common::Buffer &db_key) const override;
+
+    outcome::result<std::unique_ptr<const PolkadotTrie>> retrieveRecordingTrie(
+        const common::Buffer &db_key,
+        std::shared_ptr<TrieProofRecorder> recorder) const override;
+
    private:
     /**
      * Writes a node to a persistent storage, recursively storing its
@@ -40,12 +73,43 @@ namespace kagome::storage::trie {
                                               BufferBatch &batch);
     outcome::result<void> storeChildren(BranchNode &branch, BufferBatch &batch);
     /**
-     * Fetches a node from the storage. A nullptr is returned in case that there
-     * is no entry for provided key. Mind that a branch node will have dummy
-     * nodes as its children
+     * Calculates merkle values of the modified descendants of \arg node and
+     * keeps them in the nodes
+     */
+    outcome::result<void> calculateChildren(const PolkadotNode &node) const;
+    /**
+     * Same as storeChildren, but each modified subtree is encoded by a
+     * worker and the resulting puts are collected to \arg batch afterwards
+     */
+    outcome::result<void> storeChildrenInParallel(BranchNode &branch,
+                                                  BufferBatch &batch);
+    /**
+     * Fetches a node from the node cache or, if it is not cached, from the
+     * storage. A nullptr is returned in case that there is no entry for
+     * provided key. Mind that a branch node will have dummy nodes as its
+     * children
      */
     outcome::result<PolkadotTrie::NodePtr> retrieveNode(
         const common::Buffer &db_key) const;
+    /**
+     * Same as retrieveNode, but also passes the stored encoding of the node
+     * to \arg recorder. Nodes shorter than a hash are not recorded, as they
+     * are inlined in the encodings of their parents
+     */
+    outcome::result<PolkadotTrie::NodePtr> retrieveRecordedNode(
+        const common::Buffer &db_key, TrieProofRecorder &recorder) const;
+    /**
+     * Decodes \arg encoding of the node stored by \arg db_key and caches it
+     */
+    outcome::result<PolkadotTrie::NodePtr> decodeStoredNode(
+        const common::Buffer &db_key,
+        gsl::span<const uint8_t> encoding) const;
+    /**
+     * Marks \arg child stored with \arg merkle_value, replacing it with a
+     * dummy node unless it is short enough to be embedded in its parent
+     */
+    static void setStoredChild(PolkadotTrie::NodePtr &child,
+                               common::Buffer merkle_value);
     /**
      * Retrieves a node child, replacing a dummy node to an actual node if
      * needed
@@ -56,6 +120,10 @@ namespace kagome::storage::trie {
     std::shared_ptr<PolkadotTrieFactory> trie_factory_;
     std::shared_ptr<Codec> codec_;
     std::shared_ptr<TrieStorageBackend> backend_;
+    std::shared_ptr<TrieNodeCache> node_cache_;
+    std::shared_ptr<TriePruner> pruner_;
+    std::shared_ptr<common::Tracer> tracer_;
+    std::shared_ptr<common::WorkerPool> workers_;
   };
 }  // namespace kagome::storage::trie
 
@@ -7,6 +7,7 @@
 #define KAGOME_STORAGE_TRIE_IMPL_TRIE_BATCH
 
 #include "storage/buffer_map_types.hpp"
+#include "storage/trie/clear_prefix.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_cursor.hpp"
 
 namespace kagome::storage::trie {
@@ -21,6 +22,22 @@ namespace kagome::storage::trie {
      * Remove all trie entries which key begins with the supplied prefix
      */
     virtual outcome::result<void> clearPrefix(const Buffer &prefix) = 0;
+
+    /**
+     * Remove at most \arg limit trie entries which key begins with the
+     * supplied prefix, one by one, so that the work is bounded and the
+     * entries left are removed by the next call
+     */
+    virtual outcome::result<ClearPrefixResult> clearPrefix(const Buffer &prefix,
+                                                           uint32_t limit) = 0;
+
+    /**
+     * Obtains values of several entries at once, which is cheaper than
+     * getting them one by one, as parts of their paths in the trie are common
+     * @return values in the order of \arg keys, none for absent entries
+     */
+    virtual outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const = 0;
   };
 
   class TopperTrieBatch;
@@ -39,6 +56,12 @@ namespace kagome::storage::trie {
      */
     virtual outcome::result<Buffer> commit() = 0;
 
+    /**
+     * Calculates the root of the trie with the changes, without writing
+     * them to the storage
+     */
+    virtual outcome::result<Buffer> calculateRoot() const = 0;
+
     /**
      * Creates a batch on top of this batch
      */
@@ -0,0 +1,50 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_TRIE_PRUNER_HPP
+#define KAGOME_STORAGE_TRIE_TRIE_PRUNER_HPP
+
+#include <vector>
+
+#include <outcome/outcome.hpp>
+
+#include "common/buffer.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Keeps track of how many parent nodes and state roots reference each trie
+   * node in the storage, so that nodes no longer reachable from any kept
+   * state can be removed
+   */
+  class TriePruner {
+   public:
+    virtual ~TriePruner() = default;
+
+    /**
+     * Writes the nodes of a newly committed state to the storage and takes a
+     * reference to its root, so that the state is kept until it is pruned
+     * @param root_key storage key of the root node of the state
+     * @param new_nodes pairs of storage keys and encodings of the nodes
+     * modified since the state was retrieved, the root is among them unless
+     * the state is unchanged
+     */
+    virtual outcome::result<void> addState(
+        const common::Buffer &root_key,
+        const std::vector<std::pair<common::Buffer, common::Buffer>>
+            &new_nodes) = 0;
+
+    /**
+     * Drops a reference to the root of a state taken by addState and removes
+     * from the storage all the nodes that became unreferenced, so the state
+     * can't be retrieved anymore unless it was added more than once
+     */
+    virtual outcome::result<void> pruneState(
+        const common::Buffer &root_key) = 0;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_TRIE_PRUNER_HPP
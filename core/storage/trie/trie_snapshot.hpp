@@ -0,0 +1,50 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_STORAGE_TRIE_TRIE_SNAPSHOT
+#define KAGOME_STORAGE_TRIE_TRIE_SNAPSHOT
+
+#include "storage/buffer_map_types.hpp"
+
+namespace kagome::storage::trie {
+
+  /**
+   * Read-only view of the state with a fixed root. Unlike a batch, a
+   * snapshot is never modified, so it can be shared by several threads reading
+   * it at once without any synchronization, while new states are committed
+   */
+  class TrieSnapshot : public face::Readable<Buffer, Buffer> {
+   public:
+    ~TrieSnapshot() override = default;
+
+    /**
+     * @see TrieBatch#getMany
+     */
+    virtual outcome::result<std::vector<boost::optional<Buffer>>> getMany(
+        gsl::span<const Buffer> keys) const = 0;
+
+    /**
+     * @return merkle value of the node keeping the value of \arg key, which
+     * changes only if the value changes or, for a branch node, a key under it
+     * is changed, none if there is no value by the key
+     */
+    virtual outcome::result<boost::optional<Buffer>> getMerkleValue(
+        const Buffer &key) const = 0;
+
+    /**
+     * @return cursor over the state, which loads the nodes as it moves and
+     * may be used while the snapshot is kept, by one thread at a time
+     */
+    virtual std::unique_ptr<BufferMapCursor> cursor() const = 0;
+
+    /**
+     * Root hash of the state the snapshot is pinned to
+     */
+    virtual const Buffer &getRootHash() const = 0;
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_STORAGE_TRIE_TRIE_SNAPSHOT
@@ -8,6 +8,7 @@
 
 #include "common/blob.hpp"
 #include "storage/trie/trie_batches.hpp"
+#include "storage/trie/trie_snapshot.hpp"
 
 namespace kagome::storage::trie {
 
@@ -37,6 +38,30 @@ namespace kagome::storage::trie {
     virtual outcome::result<std::unique_ptr<EphemeralTrieBatch>>
     getEphemeralBatchAt(const common::Hash256 &root) const = 0;
 
+    /**
+     * Snapshot of the latest committed state, @see getSnapshotAt
+     */
+    virtual outcome::result<std::shared_ptr<const TrieSnapshot>> getSnapshot()
+        const = 0;
+
+    /**
+     * Obtains an immutable snapshot of the state with the provided root,
+     * which may be shared by several readers. Commits made while it is used
+     * don't affect it
+     */
+    virtual outcome::result<std::shared_ptr<const TrieSnapshot>>
+    getSnapshotAt(const common::Hash256 &root) const = 0;
+
+    /**
+     * Builds a merkle proof of the values of \arg keys, present or absent,
+     * in the state with the provided root. The keys are looked up at once,
+     * so the nodes on their common paths are read and included only once
+     * @return the stored encodings of the nodes of the proof
+     */
+    virtual outcome::result<std::vector<common::Buffer>> getProofAt(
+        const common::Hash256 &root,
+        gsl::span<const common::Buffer> keys) const = 0;
+
     /**
      * Root hash of the latest committed trie
      */
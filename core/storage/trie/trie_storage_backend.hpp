@@ -10,6 +10,7 @@
 
 #include "common/buffer.hpp"
 #include "storage/buffer_map_types.hpp"
+#include "storage/database_error.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 
 namespace kagome::storage::trie {
@@ -21,6 +22,27 @@ namespace kagome::storage::trie {
   class TrieStorageBackend : public BufferStorage {
    public:
     ~TrieStorageBackend() override = default;
+
+    /**
+     * Reads the node stored by \arg key, but not its value if the value is
+     * large enough to be kept apart from the node, so that the nodes read on
+     * the way to other keys do not drag the large values along
+     * @return the encoding of the node, in which such a value is replaced
+     * with an empty one, and whether it is replaced
+     */
+    virtual outcome::result<std::pair<face::PinnedView<Buffer>, bool>>
+    getNodeWithoutValue(const Buffer &key) const {
+      OUTCOME_TRY(node, getPinned(key));
+      return std::make_pair(std::move(node), false);
+    }
+
+    /**
+     * @return the value of the node stored by \arg key, which is replaced in
+     * the encoding returned by getNodeWithoutValue
+     */
+    virtual outcome::result<Buffer> getNodeValue(const Buffer &key) const {
+      return DatabaseError::NOT_FOUND;
+    }
   };
 
 }  // namespace kagome::storage::trie
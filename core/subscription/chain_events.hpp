@@ -0,0 +1,42 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_SUBSCRIPTION_CHAIN_EVENTS_HPP
+#define KAGOME_CORE_SUBSCRIPTION_CHAIN_EVENTS_HPP
+
+#include <vector>
+
+#include <boost/signals2/signal.hpp>
+
+#include "common/buffer.hpp"
+#include "primitives/block_header.hpp"
+#include "primitives/common.hpp"
+
+namespace kagome::subscription {
+
+  /**
+   * Events of the chain, which are raised by their sources, such as the block
+   * tree, and listened to by the subscriptions of the RPC sessions. The
+   * signals are thread-safe, the slots are run on the thread raising them
+   */
+  struct ChainEvents {
+    using HeadSignal = boost::signals2::signal<void(
+        const primitives::BlockHash &, const primitives::BlockHeader &)>;
+    using StorageSignal = boost::signals2::signal<void(
+        const primitives::BlockHash &, const std::vector<common::Buffer> &)>;
+
+    /// a block became the best one
+    HeadSignal new_head;
+
+    /// a block is finalized
+    HeadSignal finalized_head;
+
+    /// keys of the storage changed by an imported block
+    StorageSignal storage_changes;
+  };
+
+}  // namespace kagome::subscription
+
+#endif  // KAGOME_CORE_SUBSCRIPTION_CHAIN_EVENTS_HPP
@@ -0,0 +1,476 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "telemetry/telemetry_client.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/assert.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace kagome::telemetry {
+
+  namespace {
+    namespace beast = boost::beast;
+    namespace websocket = boost::beast::websocket;
+
+    constexpr std::string_view kScheme = "ws://";
+
+    /// time a connection is given to be made
+    constexpr auto kConnectTimeout = std::chrono::seconds(30);
+
+    // the samples of the registry the stats are taken from
+    constexpr std::string_view kBestHeight =
+        R"(kagome_block_height{status="best"})";
+    constexpr std::string_view kFinalizedHeight =
+        R"(kagome_block_height{status="finalized"})";
+    constexpr std::string_view kPeers = "kagome_peers";
+    constexpr std::string_view kTransactions =
+        "kagome_transaction_pool_transactions";
+    constexpr std::string_view kImportedBlocks = "kagome_imported_blocks_total";
+    constexpr std::string_view kSentBytes = "kagome_network_sent_bytes_total";
+    constexpr std::string_view kReceivedBytes =
+        "kagome_network_received_bytes_total";
+    constexpr std::string_view kFinalityLag =
+        R"(kagome_finality_lag_seconds{quantile="0.99"})";
+    constexpr std::string_view kProposal =
+        R"(kagome_babe_proposal_seconds{quantile="0.99"})";
+    constexpr std::string_view kSubmission =
+        R"(kagome_rpc_call_seconds{method="author_submitExtrinsic",quantile="0.99"})";
+
+    double value(const TelemetryClient::Samples &samples,
+                 std::string_view name) {
+      auto it = samples.find(name);
+      return it == samples.end() or not std::isfinite(it->second)
+                 ? 0
+                 : it->second;
+    }
+
+    /// sum of the samples of the family \arg name, whatever their labels
+    double sum(const TelemetryClient::Samples &samples, std::string_view name) {
+      double total = 0;
+      for (auto it = samples.lower_bound(name); it != samples.end(); ++it) {
+        std::string_view key = it->first;
+        if (key.substr(0, name.size()) != name) {
+          break;
+        }
+        // not a family, which name only starts with the name
+        if (key.size() == name.size() or key[name.size()] == '{') {
+          total += it->second;
+        }
+      }
+      return total;
+    }
+
+    std::string timestamp(std::chrono::system_clock::time_point now) {
+      auto time = std::chrono::system_clock::to_time_t(now);
+      std::tm tm{};
+      gmtime_r(&time, &tm);
+      char buffer[32];
+      auto size =
+          std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm);
+      auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        now.time_since_epoch())
+                        .count()
+                    % 1000;
+      std::snprintf(buffer + size,
+                    sizeof(buffer) - size,
+                    ".%03dZ",
+                    static_cast<int>(millis));
+      return buffer;
+    }
+
+    void lowerPriority() {
+#ifdef __linux__
+      // the threads are scheduled as the processes of their own by linux
+      constexpr int kLowestPriority = 19;
+      setpriority(PRIO_PROCESS,
+                  static_cast<id_t>(::syscall(SYS_gettid)),
+                  kLowestPriority);
+#endif
+    }
+  }  // namespace
+
+  /**
+   * Connection to an aggregator, which is made on the first message queued
+   * and is made anew after a backoff, once it fails
+   */
+  class TelemetryClient::Connection
+      : public std::enable_shared_from_this<Connection> {
+   public:
+    using Message = std::shared_ptr<const std::string>;
+
+    Connection(boost::asio::io_context &io_context,
+               std::string name,
+               Url url,
+               const Configuration &config,
+               common::Logger logger)
+        : io_context_{io_context},
+          resolver_{io_context},
+          timer_{io_context},
+          name_{std::move(name)},
+          url_{std::move(url)},
+          config_{config},
+          backoff_{config.min_backoff},
+          logger_{std::move(logger)} {}
+
+    /**
+     * Queues \arg message, which is sent as soon as the connection is up
+     */
+    void send(Message message) {
+      if (queue_.size() >= config_.max_queued) {
+        queue_.pop_front();
+      }
+      queue_.push_back(std::move(message));
+      if (state_ == State::IDLE) {
+        connect();
+      } else if (state_ == State::CONNECTED) {
+        write();
+      }
+    }
+
+   private:
+    using Stream = websocket::stream<beast::tcp_stream>;
+
+    enum class State { IDLE, CONNECTING, CONNECTED, WAITING };
+
+    void connect() {
+      state_ = State::CONNECTING;
+      // the handlers of the previous connection are ignored
+      auto generation = ++generation_;
+      stream_ = std::make_unique<Stream>(io_context_);
+      resolver_.async_resolve(
+          url_.host,
+          url_.port,
+          [self = shared_from_this(), generation](auto ec, auto results) {
+            if (generation != self->generation_) {
+              return;
+            }
+            if (ec) {
+              return self->fail("resolve", ec);
+            }
+            auto &tcp = beast::get_lowest_layer(*self->stream_);
+            tcp.expires_after(kConnectTimeout);
+            tcp.async_connect(results, [self, generation](auto ec, auto) {
+              if (generation != self->generation_) {
+                return;
+              }
+              if (ec) {
+                return self->fail("connect", ec);
+              }
+              self->handshake(generation);
+            });
+          });
+    }
+
+    void handshake(size_t generation) {
+      beast::get_lowest_layer(*stream_).expires_never();
+      stream_->set_option(websocket::stream_base::timeout::suggested(
+          beast::role_type::client));
+      stream_->text(true);
+      stream_->async_handshake(
+          url_.host + ':' + url_.port,
+          url_.target,
+          [self = shared_from_this(), generation](auto ec) {
+            if (generation != self->generation_) {
+              return;
+            }
+            if (ec) {
+              return self->fail("handshake", ec);
+            }
+            self->logger_->info("Connected to telemetry {}", self->name_);
+            self->state_ = State::CONNECTED;
+            self->backoff_ = self->config_.min_backoff;
+            self->read(generation);
+            self->write();
+          });
+    }
+
+    // nothing is expected from the aggregator, the reads only answer its
+    // pings and notice it closing the connection
+    void read(size_t generation) {
+      stream_->async_read(
+          read_buffer_, [self = shared_from_this(), generation](auto ec, auto) {
+            if (generation != self->generation_) {
+              return;
+            }
+            if (ec) {
+              return self->fail("read", ec);
+            }
+            self->read_buffer_.clear();
+            self->read(generation);
+          });
+    }
+
+    void write() {
+      if (writing_ or queue_.empty()) {
+        return;
+      }
+      writing_ = true;
+      // the messages queued so far go in one batch
+      batch_.swap(queue_);
+      writeNext(generation_);
+    }
+
+    void writeNext(size_t generation) {
+      stream_->async_write(
+          boost::asio::buffer(*batch_.front()),
+          [self = shared_from_this(), generation](auto ec, auto) {
+            if (generation != self->generation_) {
+              return;
+            }
+            if (ec) {
+              return self->fail("write", ec);
+            }
+            self->batch_.pop_front();
+            if (not self->batch_.empty()) {
+              return self->writeNext(generation);
+            }
+            self->writing_ = false;
+            self->write();
+          });
+    }
+
+    void fail(const char *operation, const boost::system::error_code &ec) {
+      logger_->warn("Telemetry {} failed to {}: {}, retrying in {} ms",
+                    name_,
+                    operation,
+                    ec.message(),
+                    backoff_.count());
+      state_ = State::WAITING;
+      // the pending handlers of the connection are ignored, and the messages
+      // of its batch are stale by the time it is made anew
+      ++generation_;
+      writing_ = false;
+      batch_.clear();
+      boost::system::error_code ignored;
+      beast::get_lowest_layer(*stream_).socket().close(ignored);
+
+      timer_.expires_after(backoff_);
+      timer_.async_wait([self = shared_from_this()](auto ec) {
+        if (not ec) {
+          self->connect();
+        }
+      });
+      backoff_ = std::min(backoff_ * 2, config_.max_backoff);
+    }
+
+    boost::asio::io_context &io_context_;
+    boost::asio::ip::tcp::resolver resolver_;
+    boost::asio::steady_timer timer_;
+    std::unique_ptr<Stream> stream_;
+    beast::flat_buffer read_buffer_;
+
+    const std::string name_;
+    const Url url_;
+    const Configuration &config_;
+
+    State state_ = State::IDLE;
+    size_t generation_ = 0;
+    std::chrono::milliseconds backoff_;
+    bool writing_ = false;
+    std::deque<Message> queue_;
+    std::deque<Message> batch_;
+
+    common::Logger logger_;
+  };
+
+  TelemetryClient::TelemetryClient(
+      const std::shared_ptr<application::AppStateManager> &app_state_manager,
+      Configuration config,
+      std::shared_ptr<common::MetricsRegistry> registry)
+      : config_{std::move(config)},
+        registry_{std::move(registry)},
+        timer_{io_context_} {
+    BOOST_ASSERT(app_state_manager);
+    BOOST_ASSERT(registry_ != nullptr);
+    app_state_manager->takeControl(*this);
+  }
+
+  TelemetryClient::~TelemetryClient() {
+    stop();
+  }
+
+  void TelemetryClient::prepare() {
+    for (auto &url_text : config_.urls) {
+      auto url = parseUrl(url_text);
+      if (not url) {
+        logger_->error(
+            "Telemetry {} is skipped, only ws:// urls are supported",
+            url_text);
+        continue;
+      }
+      connections_.push_back(std::make_shared<Connection>(
+          io_context_, url_text, std::move(*url), config_, logger_));
+    }
+  }
+
+  void TelemetryClient::start() {
+    if (connections_.empty()) {
+      return;
+    }
+    previous_at_ = std::chrono::steady_clock::now();
+    boost::asio::post(io_context_, [this] { tick(); });
+    thread_ = std::thread([this] {
+      lowerPriority();
+      io_context_.run();
+    });
+  }
+
+  void TelemetryClient::stop() {
+    io_context_.stop();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void TelemetryClient::tick() {
+    auto now = std::chrono::steady_clock::now();
+    auto samples = parseSamples(registry_->exposition());
+    auto message = std::make_shared<const std::string>(
+        makeMessage(samples,
+                    previous_,
+                    now - previous_at_,
+                    std::chrono::system_clock::now()));
+    previous_ = std::move(samples);
+    previous_at_ = now;
+    for (auto &connection : connections_) {
+      connection->send(message);
+    }
+    scheduleTick();
+  }
+
+  void TelemetryClient::scheduleTick() {
+    timer_.expires_after(config_.interval);
+    timer_.async_wait([this](auto ec) {
+      if (not ec) {
+        tick();
+      }
+    });
+  }
+
+  boost::optional<TelemetryClient::Url> TelemetryClient::parseUrl(
+      std::string_view url) {
+    if (url.substr(0, kScheme.size()) != kScheme) {
+      return boost::none;
+    }
+    url.remove_prefix(kScheme.size());
+    auto slash = url.find('/');
+    auto authority = url.substr(0, slash);
+    Url result;
+    result.target =
+        slash == std::string_view::npos ? "/" : std::string{url.substr(slash)};
+    auto colon = authority.rfind(':');
+    // the colons of an ipv6 address are in the brackets
+    if (colon == std::string_view::npos
+        or authority.find(']', colon) != std::string_view::npos) {
+      result.host = authority;
+      result.port = "80";
+    } else {
+      result.host = authority.substr(0, colon);
+      result.port = authority.substr(colon + 1);
+    }
+    if (result.host.size() > 1 and result.host.front() == '['
+        and result.host.back() == ']') {
+      result.host = result.host.substr(1, result.host.size() - 2);
+    }
+    if (result.host.empty() or result.port.empty()
+        or not std::all_of(result.port.begin(),
+                           result.port.end(),
+                           [](char c) { return c >= '0' and c <= '9'; })) {
+      return boost::none;
+    }
+    return result;
+  }
+
+  TelemetryClient::Samples TelemetryClient::parseSamples(
+      std::string_view exposition) {
+    Samples samples;
+    while (not exposition.empty()) {
+      auto end = exposition.find('\n');
+      auto line = exposition.substr(0, end);
+      exposition.remove_prefix(end == std::string_view::npos ? exposition.size()
+                                                             : end + 1);
+      if (line.empty() or line.front() == '#') {
+        continue;
+      }
+      // the label values may have spaces, the value may not
+      auto space = line.rfind(' ');
+      if (space == std::string_view::npos) {
+        continue;
+      }
+      std::string text{line.substr(space + 1)};
+      char *parsed = nullptr;
+      auto number = std::strtod(text.c_str(), &parsed);
+      if (parsed == text.c_str()) {
+        continue;
+      }
+      samples.emplace(std::string{line.substr(0, space)}, number);
+    }
+    return samples;
+  }
+
+  std::string TelemetryClient::makeMessage(
+      const Samples &samples,
+      const Samples &previous,
+      std::chrono::duration<double> elapsed,
+      std::chrono::system_clock::time_point now) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer{buffer};
+    auto number = [&](const char *key, double value) {
+      writer.Key(key);
+      writer.Uint64(static_cast<uint64_t>(std::max(value, 0.0)));
+    };
+    auto real = [&](const char *key, double value) {
+      writer.Key(key);
+      writer.Double(value);
+    };
+
+    writer.StartObject();
+    writer.Key("msg");
+    writer.String("system.interval");
+    writer.Key("ts");
+    writer.String(timestamp(now).c_str());
+    number("height", value(samples, kBestHeight));
+    number("finalized_height", value(samples, kFinalizedHeight));
+    number("peers", sum(samples, kPeers));
+    number("txcount", sum(samples, kTransactions));
+    if (not previous.empty() and elapsed.count() > 0) {
+      auto rate = [&](std::string_view name) {
+        // a counter reset by the profile RPC starts over
+        auto increase = sum(samples, name) - sum(previous, name);
+        return std::max(increase, 0.0) / elapsed.count();
+      };
+      real("import_rate", rate(kImportedBlocks));
+      real("bandwidth_upload", rate(kSentBytes));
+      real("bandwidth_download", rate(kReceivedBytes));
+    }
+    // the 99th percentiles, in seconds
+    writer.Key("latency");
+    writer.StartObject();
+    real("block_finality", value(samples, kFinalityLag));
+    real("block_proposal", value(samples, kProposal));
+    real("tx_submission", value(samples, kSubmission));
+    writer.EndObject();
+    writer.EndObject();
+    return buffer.GetString();
+  }
+
+}  // namespace kagome::telemetry
@@ -0,0 +1,124 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_TELEMETRY_TELEMETRY_CLIENT_HPP
+#define KAGOME_CORE_TELEMETRY_TELEMETRY_CLIENT_HPP
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/optional.hpp>
+
+#include "application/app_state_manager.hpp"
+#include "common/logger.hpp"
+#include "common/metrics_registry.hpp"
+
+namespace kagome::telemetry {
+
+  /**
+   * Streams the stats of the node to the telemetry aggregators over
+   * websocket, in the manner of the telemetry of substrate, so that the
+   * operators of many nodes see all of them at once. Every interval the
+   * registry of the metrics is sampled for the best and the finalized
+   * heights, the rate of the import, the connected peers, the transactions
+   * in the pool and the latencies of the blocks and of the transactions,
+   * and the message is queued for each of the aggregators.
+   * The client runs on a thread of its own at the lowest priority and is
+   * the only one to wait for the aggregators, so it never stalls the node:
+   * a queue over its bound drops its oldest messages, the queued messages
+   * are sent in a batch once a connection is up, and a lost connection is
+   * made anew after a backoff, which doubles with each failure
+   */
+  class TelemetryClient {
+   public:
+    struct Configuration {
+      /// urls of the aggregators, as ws://host[:port][/path]
+      std::vector<std::string> urls;
+      /// time between the messages
+      std::chrono::seconds interval{5};
+      /// number of the messages queued for an aggregator, over which the
+      /// oldest ones are dropped
+      size_t max_queued = 64;
+      /// time the first attempt to reconnect is made after, and the most
+      /// the doubled backoff is let to grow to
+      std::chrono::milliseconds min_backoff{1000};
+      std::chrono::milliseconds max_backoff{60000};
+    };
+
+    struct Url {
+      std::string host;
+      std::string port;
+      std::string target;
+    };
+
+    /// values of the samples of the registry by their names with the
+    /// labels, e.g. `kagome_block_height{status="best"}`
+    using Samples = std::map<std::string, double, std::less<>>;
+
+    TelemetryClient(
+        const std::shared_ptr<application::AppStateManager> &app_state_manager,
+        Configuration config,
+        std::shared_ptr<common::MetricsRegistry> registry);
+
+    ~TelemetryClient();
+
+    void prepare();
+    void start();
+    void stop();
+
+    /**
+     * @return parts of \arg url, none if it is not a websocket url
+     */
+    static boost::optional<Url> parseUrl(std::string_view url);
+
+    /**
+     * @return samples of \arg exposition in the text format of Prometheus
+     */
+    static Samples parseSamples(std::string_view exposition);
+
+    /**
+     * @return message `system.interval` with the stats of \arg samples taken
+     * at \arg now, the rates of the counters are of the increase since
+     * \arg previous samples taken \arg elapsed before, none if they are
+     * empty
+     */
+    static std::string makeMessage(const Samples &samples,
+                                   const Samples &previous,
+                                   std::chrono::duration<double> elapsed,
+                                   std::chrono::system_clock::time_point now);
+
+   private:
+    class Connection;
+
+    /// Samples the registry and queues the message for the aggregators
+    void tick();
+
+    void scheduleTick();
+
+    const Configuration config_;
+    std::shared_ptr<common::MetricsRegistry> registry_;
+
+    // the connections are owned by their handlers as well, which are
+    // destroyed along with the context
+    boost::asio::io_context io_context_;
+    boost::asio::steady_timer timer_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+    std::thread thread_;
+
+    Samples previous_;
+    std::chrono::steady_clock::time_point previous_at_;
+
+    common::Logger logger_ = common::createLogger("Telemetry");
+  };
+
+}  // namespace kagome::telemetry
+
+#endif  // KAGOME_CORE_TELEMETRY_TELEMETRY_CLIENT_HPP
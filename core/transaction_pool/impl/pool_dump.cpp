@@ -0,0 +1,129 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "transaction_pool/impl/pool_dump.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <gsl/span>
+
+#include "scale/scale.hpp"
+#include "scale/scale_fields.hpp"
+
+OUTCOME_CPP_DEFINE_CATEGORY(kagome::transaction_pool, PoolDumpError, e) {
+  using E = kagome::transaction_pool::PoolDumpError;
+  switch (e) {
+    case E::CANNOT_OPEN_FILE:
+      return "Cannot open the transaction pool dump";
+    case E::CANNOT_WRITE_FILE:
+      return "Cannot write the transaction pool dump";
+    case E::INVALID_FORMAT:
+      return "The transaction pool dump is malformed";
+  }
+  return "Unknown error";
+}
+
+namespace kagome::transaction_pool {
+
+  namespace {
+    using primitives::Transaction;
+
+    // the format is changed along with the version in the last byte
+    constexpr std::array<uint8_t, 8> kMagic{
+        'k', 'g', 'm', 'p', 'o', 'o', 'l', '1'};
+
+    struct DumpedTransaction {
+      primitives::Extrinsic ext;
+      uint64_t bytes{};
+      Transaction::Hash hash;
+      Transaction::Priority priority{};
+      Transaction::Longevity valid_till{};
+      std::vector<Transaction::Tag> requires;
+      std::vector<Transaction::Tag> provides;
+      bool should_propagate{false};
+
+      SCALE_FIELDS(ext,
+                   bytes,
+                   hash,
+                   priority,
+                   valid_till,
+                   requires,
+                   provides,
+                   should_propagate)
+    };
+  }  // namespace
+
+  outcome::result<void> writePoolDump(
+      const std::string &path,
+      const std::vector<std::shared_ptr<const Transaction>> &txs) {
+    std::vector<DumpedTransaction> dumped;
+    dumped.reserve(txs.size());
+    for (auto &tx : txs) {
+      dumped.push_back(DumpedTransaction{tx->ext,
+                                         tx->bytes,
+                                         tx->hash,
+                                         tx->priority,
+                                         tx->valid_till,
+                                         tx->requires,
+                                         tx->provides,
+                                         tx->should_propagate});
+    }
+    OUTCOME_TRY(encoded, scale::encode(dumped));
+
+    auto tmp_path = path + ".tmp";
+    std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+    if (not out) {
+      return PoolDumpError::CANNOT_OPEN_FILE;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char *>(kMagic.data()), kMagic.size());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    out.write(reinterpret_cast<const char *>(encoded.data()),
+              static_cast<std::streamsize>(encoded.size()));
+    out.close();
+    if (not out or std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+      return PoolDumpError::CANNOT_WRITE_FILE;
+    }
+    return outcome::success();
+  }
+
+  outcome::result<std::vector<Transaction>> readPoolDump(
+      const std::string &path) {
+    std::ifstream in{path, std::ios::binary};
+    if (not in) {
+      return PoolDumpError::CANNOT_OPEN_FILE;
+    }
+    std::vector<uint8_t> content{std::istreambuf_iterator<char>{in},
+                                 std::istreambuf_iterator<char>{}};
+    if (content.size() < kMagic.size()
+        or not std::equal(kMagic.begin(), kMagic.end(), content.begin())) {
+      return PoolDumpError::INVALID_FORMAT;
+    }
+    auto decoded = scale::decode<std::vector<DumpedTransaction>>(
+        gsl::make_span(content).subspan(kMagic.size()));
+    if (not decoded) {
+      return PoolDumpError::INVALID_FORMAT;
+    }
+    std::vector<Transaction> txs;
+    txs.reserve(decoded.value().size());
+    for (auto &tx : decoded.value()) {
+      txs.push_back(Transaction{std::move(tx.ext),
+                                tx.bytes,
+                                tx.hash,
+                                tx.priority,
+                                tx.valid_till,
+                                std::move(tx.requires),
+                                std::move(tx.provides),
+                                tx.should_propagate});
+    }
+    return txs;
+  }
+
+}  // namespace kagome::transaction_pool
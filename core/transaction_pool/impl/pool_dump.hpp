@@ -0,0 +1,44 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_DUMP_HPP
+#define KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_DUMP_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "outcome/outcome.hpp"
+#include "primitives/transaction.hpp"
+
+namespace kagome::transaction_pool {
+
+  enum class PoolDumpError {
+    CANNOT_OPEN_FILE = 1,
+    CANNOT_WRITE_FILE,
+    INVALID_FORMAT
+  };
+
+  /**
+   * Writes \arg txs with their validities and tags to \arg path, so that
+   * the pool is filled with them again once the node is restarted. The file
+   * is replaced only when all of them are written
+   */
+  outcome::result<void> writePoolDump(
+      const std::string &path,
+      const std::vector<std::shared_ptr<const primitives::Transaction>> &txs);
+
+  /**
+   * @return the transactions written to \arg path by writePoolDump(), in the
+   * same order
+   */
+  outcome::result<std::vector<primitives::Transaction>> readPoolDump(
+      const std::string &path);
+
+}  // namespace kagome::transaction_pool
+
+OUTCOME_HPP_DECLARE_ERROR(kagome::transaction_pool, PoolDumpError);
+
+#endif  // KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_DUMP_HPP
@@ -0,0 +1,223 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "transaction_pool/impl/pool_revalidator_impl.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+#include <boost/filesystem/operations.hpp>
+
+#include "runtime/common/validate_transactions.hpp"
+#include "transaction_pool/impl/pool_dump.hpp"
+
+namespace kagome::transaction_pool {
+
+  PoolRevalidatorImpl::PoolRevalidatorImpl(
+      std::shared_ptr<application::AppStateManager> app_state_manager,
+      std::shared_ptr<blockchain::BlockTree> block_tree,
+      std::shared_ptr<TransactionPool> pool,
+      std::shared_ptr<runtime::TaggedTransactionQueue> tx_queue,
+      std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
+      std::string dump_path,
+      std::shared_ptr<common::WorkerPool> workers)
+      : block_tree_{std::move(block_tree)},
+        pool_{std::move(pool)},
+        tx_queue_{std::move(tx_queue)},
+        extrinsic_observer_{std::move(extrinsic_observer)},
+        dump_path_{std::move(dump_path)},
+        workers_{std::move(workers)},
+        logger_{common::createLogger("PoolRevalidator")} {
+    BOOST_ASSERT(app_state_manager != nullptr);
+    BOOST_ASSERT(block_tree_ != nullptr);
+    BOOST_ASSERT(pool_ != nullptr);
+    BOOST_ASSERT(tx_queue_ != nullptr);
+    BOOST_ASSERT(extrinsic_observer_ != nullptr);
+    thread_ = std::thread{[this] { work(); }};
+    if (dump_path_.empty()) {
+      app_state_manager->atShutdown([this] { stop(); });
+      return;
+    }
+    app_state_manager->atLaunch([this] { loadDump(); });
+    // the pool is written once nothing is removed from it by the revalidator
+    app_state_manager->atShutdown([this] {
+      stop();
+      saveDump();
+    });
+  }
+
+  PoolRevalidatorImpl::~PoolRevalidatorImpl() {
+    stop();
+  }
+
+  void PoolRevalidatorImpl::onNewBestBlock(const primitives::BlockInfo &best) {
+    std::vector<primitives::Extrinsic> retracted;
+    if (last_best_
+        and not block_tree_->hasDirectChain(last_best_->block_hash,
+                                            best.block_hash)) {
+      retracted = retractedExtrinsics(*last_best_, best);
+    }
+    last_best_ = best;
+    resubmit(std::move(retracted));
+  }
+
+  void PoolRevalidatorImpl::resubmit(
+      std::vector<primitives::Extrinsic> extrinsics) {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_) {
+        return;
+      }
+      pending_ = true;
+      resubmitted_.insert(resubmitted_.end(),
+                          std::make_move_iterator(extrinsics.begin()),
+                          std::make_move_iterator(extrinsics.end()));
+    }
+    pending_cv_.notify_one();
+  }
+
+  void PoolRevalidatorImpl::stop() {
+    {
+      std::lock_guard lock{mutex_};
+      if (stopped_) {
+        return;
+      }
+      stopped_ = true;
+    }
+    pending_cv_.notify_all();
+    thread_.join();
+  }
+
+  std::vector<primitives::Extrinsic> PoolRevalidatorImpl::retractedExtrinsics(
+      const primitives::BlockInfo &prev_best,
+      const primitives::BlockInfo &best) const {
+    std::vector<primitives::Extrinsic> extrinsics;
+    // the finalized block is an ancestor of any best one
+    auto finalized = block_tree_->getLastFinalized();
+    auto hash = prev_best.block_hash;
+    while (hash != finalized.block_hash
+           and not block_tree_->hasDirectChain(hash, best.block_hash)) {
+      auto header = block_tree_->getBlockHeader(hash);
+      if (not header) {
+        break;
+      }
+      if (auto body = block_tree_->getBlockBody(hash); body) {
+        extrinsics.insert(extrinsics.end(),
+                          std::make_move_iterator(body.value().begin()),
+                          std::make_move_iterator(body.value().end()));
+      }
+      hash = header.value().parent_hash;
+    }
+    return extrinsics;
+  }
+
+  void PoolRevalidatorImpl::work() {
+    while (true) {
+      std::vector<primitives::Extrinsic> extrinsics;
+      {
+        std::unique_lock lock{mutex_};
+        pending_cv_.wait(lock, [this] { return stopped_ or pending_; });
+        if (stopped_) {
+          return;
+        }
+        pending_ = false;
+        extrinsics = std::move(resubmitted_);
+        resubmitted_.clear();
+      }
+
+      if (not extrinsics.empty()) {
+        size_t resubmitted = 0;
+        for (auto &res : extrinsic_observer_->onTxMessages(extrinsics)) {
+          resubmitted += res.has_value() ? 1 : 0;
+        }
+        logger_->debug("{} of {} extrinsics are back to the pool",
+                       resubmitted,
+                       extrinsics.size());
+      }
+      revalidate();
+    }
+  }
+
+  void PoolRevalidatorImpl::revalidate() {
+    auto txs = pool_->getForRevalidation(kBatchSize);
+    if (txs.empty()) {
+      return;
+    }
+    std::vector<std::reference_wrapper<const primitives::Extrinsic>>
+        extrinsics;
+    extrinsics.reserve(txs.size());
+    for (auto &tx : txs) {
+      extrinsics.emplace_back(tx->ext);
+    }
+    auto validities =
+        runtime::validateTransactions(*tx_queue_, extrinsics, workers_);
+
+    // the ones failed to be validated are kept, as the failure may be of the
+    // node, not of the transaction
+    std::vector<Transaction::Hash> invalid;
+    for (size_t i = 0; i < txs.size(); i++) {
+      if (validities[i]
+          and boost::get<primitives::TransactionValidityError>(
+                  &validities[i].value())
+                  != nullptr) {
+        invalid.push_back(txs[i]->hash);
+      }
+    }
+    if (not invalid.empty()) {
+      if (auto res = pool_->remove(invalid); not res) {
+        logger_->warn("Invalid transactions were not dropped: {}",
+                      res.error().message());
+      }
+    }
+    logger_->debug("{} of {} revalidated transactions are dropped",
+                   invalid.size(),
+                   txs.size());
+  }
+
+  void PoolRevalidatorImpl::loadDump() {
+    if (not boost::filesystem::exists(dump_path_)) {
+      return;
+    }
+    auto txs = readPoolDump(dump_path_);
+    // a dump is submitted once, so that an old one is not submitted again
+    // after a crash
+    std::remove(dump_path_.c_str());
+    if (not txs) {
+      logger_->warn("Transaction pool dump {} is not loaded: {}",
+                    dump_path_,
+                    txs.error().message());
+      return;
+    }
+    // the ones of a higher priority go first, in case the pool gets full
+    std::stable_sort(
+        txs.value().begin(), txs.value().end(), [](auto &lhs, auto &rhs) {
+          return lhs.priority > rhs.priority;
+        });
+    std::vector<primitives::Extrinsic> extrinsics;
+    extrinsics.reserve(txs.value().size());
+    for (auto &tx : txs.value()) {
+      extrinsics.push_back(std::move(tx.ext));
+    }
+    logger_->info("{} transactions are loaded from the pool dump",
+                  extrinsics.size());
+    // they are validated again on the thread of the revalidator, as the
+    // state may have changed since they were dumped
+    resubmit(std::move(extrinsics));
+  }
+
+  void PoolRevalidatorImpl::saveDump() {
+    // the order of the revalidation does not matter any more
+    auto txs = pool_->getForRevalidation(std::numeric_limits<size_t>::max());
+    if (auto res = writePoolDump(dump_path_, txs); not res) {
+      logger_->warn("Transaction pool dump {} is not written: {}",
+                    dump_path_,
+                    res.error().message());
+      return;
+    }
+    logger_->info("{} transactions are written to the pool dump", txs.size());
+  }
+
+}  // namespace kagome::transaction_pool
@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_REVALIDATOR_IMPL_HPP
+#define KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_REVALIDATOR_IMPL_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "application/app_state_manager.hpp"
+#include "blockchain/block_tree.hpp"
+#include "common/logger.hpp"
+#include "common/worker_pool.hpp"
+#include "network/extrinsic_observer.hpp"
+#include "runtime/tagged_transaction_queue.hpp"
+#include "transaction_pool/pool_revalidator.hpp"
+#include "transaction_pool/transaction_pool.hpp"
+
+namespace kagome::transaction_pool {
+
+  /**
+   * Keeps the transaction pool valid for the state of the best block on a
+   * thread of its own, so that the block import and production never wait
+   * for it. On each new best block a batch of the transactions revalidated
+   * the longest ago is revalidated, and the invalid ones are dropped, so the
+   * whole pool is revalidated over several blocks without a full rescan. If
+   * the new best block does not descend from the previous one, the
+   * extrinsics of the retracted blocks are submitted to the pool again.
+   * A new best block replaces the one waiting for the revalidation, as only
+   * the latest state matters.
+   * If a dump path is given, the pool is written there at the shutdown and
+   * is submitted again from there at the launch, so that a restarted node
+   * has its transactions right away instead of waiting for the gossip
+   */
+  class PoolRevalidatorImpl : public PoolRevalidator {
+   public:
+    /// number of the transactions revalidated per best block
+    static constexpr size_t kBatchSize = 256;
+
+    PoolRevalidatorImpl(
+        std::shared_ptr<application::AppStateManager> app_state_manager,
+        std::shared_ptr<blockchain::BlockTree> block_tree,
+        std::shared_ptr<TransactionPool> pool,
+        std::shared_ptr<runtime::TaggedTransactionQueue> tx_queue,
+        std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer,
+        std::string dump_path = {},
+        std::shared_ptr<common::WorkerPool> workers = nullptr);
+
+    ~PoolRevalidatorImpl() override;
+
+    void onNewBestBlock(const primitives::BlockInfo &best) override;
+
+    void resubmit(std::vector<primitives::Extrinsic> extrinsics) override;
+
+    /**
+     * Cancels the revalidation which is not started yet and waits for the
+     * running one, nothing is revalidated after that
+     */
+    void stop();
+
+   private:
+    /**
+     * @return extrinsics of the blocks from \arg prev_best back to the common
+     * ancestor with \arg best
+     */
+    std::vector<primitives::Extrinsic> retractedExtrinsics(
+        const primitives::BlockInfo &prev_best,
+        const primitives::BlockInfo &best) const;
+
+    void work();
+
+    void revalidate();
+
+    /// Submits the transactions of the dump again, the dump is removed then
+    void loadDump();
+
+    /// Writes the transactions of the pool to the dump
+    void saveDump();
+
+    std::shared_ptr<blockchain::BlockTree> block_tree_;
+    std::shared_ptr<TransactionPool> pool_;
+    std::shared_ptr<runtime::TaggedTransactionQueue> tx_queue_;
+    std::shared_ptr<network::ExtrinsicObserver> extrinsic_observer_;
+    const std::string dump_path_;
+    // revalidate the transactions of a batch in parallel, if any
+    std::shared_ptr<common::WorkerPool> workers_;
+
+    // accessed from the thread of onNewBestBlock only
+    boost::optional<primitives::BlockInfo> last_best_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_cv_;
+    bool pending_ = false;
+    /// extrinsics to be submitted again
+    std::vector<primitives::Extrinsic> resubmitted_;
+    bool stopped_ = false;
+    std::thread thread_;
+
+    common::Logger logger_;
+  };
+
+}  // namespace kagome::transaction_pool
+
+#endif  // KAGOME_CORE_TRANSACTION_POOL_IMPL_POOL_REVALIDATOR_IMPL_HPP
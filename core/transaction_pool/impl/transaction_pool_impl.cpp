@@ -5,6 +5,9 @@
 
 #include "transaction_pool/impl/transaction_pool_impl.hpp"
 
+#include <algorithm>
+#include <set>
+
 #include "primitives/block_id.hpp"
 #include "transaction_pool/transaction_pool_error.hpp"
 
@@ -13,6 +16,111 @@ using kagome::primitives::Transaction;
 
 namespace kagome::transaction_pool {
 
+  /**
+   * Ready transactions in the order of the ready queue, with the interned
+   * tags they require and provide. Is not changed once built, so it is read
+   * without the lock of the pool
+   */
+  struct TransactionPoolImpl::ReadySnapshot {
+    struct Entry {
+      std::shared_ptr<const Transaction> tx;
+      std::vector<TagId> requires;
+      std::vector<TagId> provides;
+    };
+
+    std::vector<Entry> entries;
+    /// the tag ids are less than it
+    size_t tags_num = 0;
+  };
+
+  /**
+   * Walks the ready snapshot, deferring the transactions which require the
+   * tags not provided by the ones returned before, until those are returned.
+   * Costs the number of the returned transactions, not the size of the pool
+   */
+  class TransactionPoolImpl::ReadyTransactionsImpl : public ReadyTransactions {
+   public:
+    explicit ReadyTransactionsImpl(
+        std::shared_ptr<const ReadySnapshot> snapshot)
+        : snapshot_{std::move(snapshot)},
+          provided_(snapshot_->tags_num, false) {}
+
+    std::shared_ptr<const Transaction> next() override {
+      auto &entries = snapshot_->entries;
+      while (true) {
+        size_t index{};
+        // the unlocked ones were passed, so they come before the next one
+        if (not unlocked_.empty()) {
+          index = *unlocked_.begin();
+          unlocked_.erase(unlocked_.begin());
+        } else if (pos_ != entries.size()) {
+          index = pos_++;
+          if (not isUnlocked(index)) {
+            defer(index);
+            continue;
+          }
+        } else {
+          return nullptr;
+        }
+        provide(index);
+        return entries[index].tx;
+      }
+    }
+
+   private:
+    bool isUnlocked(size_t index) const {
+      auto &requires = snapshot_->entries[index].requires;
+      return std::all_of(requires.begin(), requires.end(), [this](auto tag) {
+        return provided_[tag];
+      });
+    }
+
+    // waits for the first of the tags \arg index requires, which is not
+    // provided
+    void defer(size_t index) {
+      for (auto tag : snapshot_->entries[index].requires) {
+        if (not provided_[tag]) {
+          deferred_[tag].push_back(index);
+          return;
+        }
+      }
+    }
+
+    // unlocks the deferred transactions, which depend on the tags of
+    // \arg index
+    void provide(size_t index) {
+      for (auto tag : snapshot_->entries[index].provides) {
+        if (provided_[tag]) {
+          continue;
+        }
+        provided_[tag] = true;
+        auto it = deferred_.find(tag);
+        if (it == deferred_.end()) {
+          continue;
+        }
+        auto dependents = std::move(it->second);
+        deferred_.erase(it);
+        for (auto dependent : dependents) {
+          if (isUnlocked(dependent)) {
+            unlocked_.insert(dependent);
+          } else {
+            defer(dependent);
+          }
+        }
+      }
+    }
+
+    std::shared_ptr<const ReadySnapshot> snapshot_;
+    // the next entry of the snapshot to be checked
+    size_t pos_ = 0;
+    // tags provided by the returned transactions
+    std::vector<bool> provided_;
+    // passed entries by the tag they wait for
+    std::unordered_map<TagId, std::vector<size_t>> deferred_;
+    // deferred entries, which have got all of the tags they require
+    std::set<size_t> unlocked_;
+  };
+
   TransactionPoolImpl::TransactionPoolImpl(
       std::unique_ptr<PoolModerator> moderator,
       std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
@@ -25,290 +133,508 @@ namespace kagome::transaction_pool {
   }
 
   outcome::result<void> TransactionPoolImpl::submitOne(Transaction &&tx) {
-    return submitOne(std::make_shared<Transaction>(std::move(tx)));
-  }
-
-  outcome::result<void> TransactionPoolImpl::submit(
-      std::vector<Transaction> txs) {
-    for (auto &tx : txs) {
-      OUTCOME_TRY(submitOne(std::make_shared<Transaction>(std::move(tx))));
+    if (not reserveHash(tx.hash)) {
+      return TransactionPoolError::TX_ALREADY_IMPORTED;
+    }
+    auto shared_tx = std::make_shared<Transaction>(std::move(tx));
+
+    auto evicted = [&] {
+      std::lock_guard lock{mutex_};
+      return insertTx(shared_tx);
+    }();
+    if (evicted.has_error()) {
+      forgetHash(shared_tx->hash);
+      return evicted.error();
+    }
+    for (auto &tx_hash : evicted.value()) {
+      forgetHash(tx_hash);
     }
 
+    logger_->debug("Extrinsic {} with hash {} was added to the pool",
+                   shared_tx->ext.data,
+                   shared_tx->hash);
     return outcome::success();
   }
 
-  outcome::result<void> TransactionPoolImpl::submitOne(
-      const std::shared_ptr<Transaction> &tx) {
-    if (auto [_, ok] = imported_txs_.emplace(tx->hash, tx); !ok) {
-      return TransactionPoolError::TX_ALREADY_IMPORTED;
+  outcome::result<std::vector<Transaction::Hash>>
+  TransactionPoolImpl::insertTx(std::shared_ptr<Transaction> tx) {
+    OUTCOME_TRY(evicted_slots, selectEvicted(*tx));
+    std::vector<Transaction::Hash> evicted;
+    evicted.reserve(evicted_slots.size());
+    for (auto evicted_slot : evicted_slots) {
+      evicted.push_back(txs_[evicted_slot].tx->hash);
+      imported_txs_.erase(evicted.back());
+      removeTx(evicted_slot);
+    }
+    if (not evicted.empty()) {
+      logger_->debug("{} extrinsics were evicted from the pool for {}",
+                     evicted.size(),
+                     tx->hash);
     }
 
-    auto processResult = processTransaction(tx);
-    if (processResult.has_error()
-        && processResult.error() == TransactionPoolError::POOL_IS_FULL) {
-      imported_txs_.erase(tx->hash);
-    } else {
-      logger_->debug("Extrinsic {} with hash {} was added to the pool",
-                     tx->ext.data.toHex(),
-                     tx->hash.toHex());
+    auto slot = allocateTx(std::move(tx));
+    auto &record = txs_[slot];
+    imported_txs_.emplace(record.tx->hash, slot);
+    bytes_ += record.tx->bytes;
+    record.revalidation =
+        revalidation_order_.insert(revalidation_order_.end(), slot);
+    record.evictable =
+        eviction_queue_
+            .emplace(EvictionKey{record.tx->priority, import_seq_++}, slot)
+            .first;
+    for (auto tag : record.requires) {
+      auto &tag_record = tags_[tag];
+      tag_record.dependents.push_back(slot);
+      if (tag_record.ready_providers == 0) {
+        ++record.missing;
+      }
     }
+    record.state = TxState::WAITING;
+    if (record.missing == 0) {
+      makeReady(slot);
+    }
+    return evicted;
+  }
 
-    return processResult;
+  outcome::result<std::vector<TransactionPoolImpl::TxSlot>>
+  TransactionPoolImpl::selectEvicted(const Transaction &tx) const {
+    std::vector<TxSlot> evicted;
+    auto count = imported_txs_.size();
+    auto bytes = bytes_;
+    auto it = eviction_queue_.begin();
+    while (count >= limits_.capacity
+           or bytes + tx.bytes > limits_.max_bytes) {
+      // nothing is evicted for a transaction which is not better
+      if (it == eviction_queue_.end() or it->first.priority >= tx.priority) {
+        return TransactionPoolError::POOL_IS_FULL;
+      }
+      evicted.push_back(it->second);
+      --count;
+      bytes -= txs_[it->second].tx->bytes;
+      ++it;
+    }
+    return evicted;
   }
 
-  outcome::result<void> TransactionPoolImpl::processTransaction(
-      const std::shared_ptr<Transaction> &tx) {
-    OUTCOME_TRY(ensureSpace());
-    if (checkForReady(tx)) {
-      OUTCOME_TRY(processTransactionAsReady(tx));
-    } else {
-      OUTCOME_TRY(processTransactionAsWaiting(tx));
+  outcome::result<void> TransactionPoolImpl::submit(
+      std::vector<Transaction> txs) {
+    for (auto &result : submitEach(std::move(txs))) {
+      OUTCOME_TRY(result);
     }
+
     return outcome::success();
   }
 
-  outcome::result<void> TransactionPoolImpl::processTransactionAsReady(
-      const std::shared_ptr<Transaction> &tx) {
-    if (hasSpaceInReady()) {
-      setReady(tx);
-    } else {
-      postponeTransaction(tx);
+  std::vector<outcome::result<void>> TransactionPoolImpl::submitEach(
+      std::vector<Transaction> txs) {
+    std::vector<outcome::result<void>> results(txs.size(),
+                                               outcome::success());
+    std::vector<std::pair<size_t, std::shared_ptr<Transaction>>> fresh;
+    fresh.reserve(txs.size());
+    for (size_t i = 0; i < txs.size(); ++i) {
+      if (reserveHash(txs[i].hash)) {
+        fresh.emplace_back(i, std::make_shared<Transaction>(std::move(txs[i])));
+      } else {
+        results[i] = TransactionPoolError::TX_ALREADY_IMPORTED;
+      }
     }
 
-    return outcome::success();
+    // the hashes of the evicted and of the refused transactions
+    std::vector<Transaction::Hash> forgotten;
+    {
+      std::lock_guard lock{mutex_};
+      for (auto &[i, tx] : fresh) {
+        auto evicted = insertTx(tx);
+        if (evicted.has_error()) {
+          results[i] = evicted.error();
+          forgotten.push_back(tx->hash);
+          continue;
+        }
+        forgotten.insert(
+            forgotten.end(), evicted.value().begin(), evicted.value().end());
+      }
+    }
+    for (auto &tx_hash : forgotten) {
+      forgetHash(tx_hash);
+    }
+
+    logger_->debug("{} of {} extrinsics were added to the pool",
+                   std::count_if(results.begin(),
+                                 results.end(),
+                                 [](auto &result) { return bool(result); }),
+                   results.size());
+    return results;
   }
 
-  bool TransactionPoolImpl::hasSpaceInReady() const {
-    return ready_txs_.size() < limits_.max_ready_num;
+  bool TransactionPoolImpl::reserveHash(const Transaction::Hash &hash) {
+    auto &shard = shardOf(hash);
+    std::lock_guard lock{shard.mutex};
+    return shard.hashes.insert(hash).second;
   }
 
-  void TransactionPoolImpl::postponeTransaction(
-      const std::shared_ptr<Transaction> &tx) {
-    postponed_txs_.push_back(tx);
+  TransactionPoolImpl::Shard &TransactionPoolImpl::shardOf(
+      const Transaction::Hash &hash) const {
+    return shards_[std::hash<Transaction::Hash>{}(hash) % kShardsNum];
   }
 
-  outcome::result<void> TransactionPoolImpl::processTransactionAsWaiting(
-      const std::shared_ptr<Transaction> &tx) {
-    OUTCOME_TRY(ensureSpace());
+  void TransactionPoolImpl::forgetHash(const Transaction::Hash &hash) {
+    auto &shard = shardOf(hash);
+    std::lock_guard lock{shard.mutex};
+    shard.hashes.erase(hash);
+  }
 
-    addTransactionAsWaiting(tx);
+  TransactionPoolImpl::TagId TransactionPoolImpl::internTag(
+      const Transaction::Tag &tag) {
+    auto [it, inserted] = tag_ids_.emplace(tag, 0);
+    if (inserted) {
+      if (free_tags_.empty()) {
+        it->second = static_cast<TagId>(tags_.size());
+        tags_.emplace_back();
+      } else {
+        it->second = free_tags_.back();
+        free_tags_.pop_back();
+      }
+      tags_[it->second].tag = &it->first;
+    }
+    ++tags_[it->second].refs;
+    return it->second;
+  }
 
-    return outcome::success();
+  void TransactionPoolImpl::releaseTag(TagId tag) {
+    auto &record = tags_[tag];
+    BOOST_ASSERT(record.refs != 0);
+    if (--record.refs != 0) {
+      return;
+    }
+    tag_ids_.erase(*record.tag);
+    record = TagRecord{};
+    free_tags_.push_back(tag);
   }
 
-  outcome::result<void> TransactionPoolImpl::ensureSpace() const {
-    if (imported_txs_.size() > limits_.capacity) {
-      return TransactionPoolError::POOL_IS_FULL;
+  std::vector<TransactionPoolImpl::TagId> TransactionPoolImpl::internTags(
+      const std::vector<Transaction::Tag> &tags) {
+    std::vector<TagId> ids;
+    ids.reserve(tags.size());
+    for (auto &tag : tags) {
+      auto id = internTag(tag);
+      if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+        ids.push_back(id);
+      } else {
+        releaseTag(id);
+      }
     }
+    return ids;
+  }
 
-    return outcome::success();
+  TransactionPoolImpl::TxSlot TransactionPoolImpl::allocateTx(
+      std::shared_ptr<Transaction> tx) {
+    TxSlot slot{};
+    if (free_txs_.empty()) {
+      slot = static_cast<TxSlot>(txs_.size());
+      txs_.emplace_back();
+    } else {
+      slot = free_txs_.back();
+      free_txs_.pop_back();
+    }
+    auto &record = txs_[slot];
+    record.requires = internTags(tx->requires);
+    record.provides = internTags(tx->provides);
+    record.tx = std::move(tx);
+    return slot;
   }
 
-  void TransactionPoolImpl::addTransactionAsWaiting(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->requires) {
-      tx_waits_tag_.emplace(tag, tx);
+  void TransactionPoolImpl::freeTx(TxSlot slot) {
+    auto &record = txs_[slot];
+    for (auto tag : record.requires) {
+      auto &dependents = tags_[tag].dependents;
+      auto it = std::find(dependents.begin(), dependents.end(), slot);
+      BOOST_ASSERT(it != dependents.end());
+      *it = dependents.back();
+      dependents.pop_back();
+      releaseTag(tag);
     }
+    for (auto tag : record.provides) {
+      releaseTag(tag);
+    }
+    revalidation_order_.erase(record.revalidation);
+    eviction_queue_.erase(record.evictable);
+    bytes_ -= record.tx->bytes;
+    record = TxRecord{};
+    free_txs_.push_back(slot);
   }
 
-  outcome::result<void> TransactionPoolImpl::removeOne(
-      const Transaction::Hash &tx_hash) {
-    auto tx_node = imported_txs_.extract(tx_hash);
-    if (tx_node.empty()) {
-      logger_->debug(
-          "Extrinsic with hash {} was not found in the pool during remove",
-          tx_hash);
-      return TransactionPoolError::TX_NOT_FOUND;
+  bool TransactionPoolImpl::hasSpaceInReady() const {
+    return ready_queue_.size() < limits_.max_ready_num;
+  }
+
+  void TransactionPoolImpl::makeReady(TxSlot slot) {
+    if (hasSpaceInReady()) {
+      setReady(slot);
+    } else {
+      postponeTransaction(slot);
     }
-    auto &tx = tx_node.mapped();
+  }
 
-    unsetReady(tx);
-    delTransactionAsWaiting(tx);
+  void TransactionPoolImpl::postponeTransaction(TxSlot slot) {
+    auto &record = txs_[slot];
+    record.state = TxState::POSTPONED;
+    record.postponed = postponed_txs_.insert(postponed_txs_.end(), slot);
+  }
 
-    processPostponedTransactions();
+  outcome::result<void> TransactionPoolImpl::removeOne(
+      const Transaction::Hash &tx_hash) {
+    std::shared_ptr<Transaction> tx;
+    {
+      std::lock_guard lock{mutex_};
+      auto it = imported_txs_.find(tx_hash);
+      if (it == imported_txs_.end()) {
+        logger_->debug(
+            "Extrinsic with hash {} was not found in the pool during remove",
+            tx_hash);
+        return TransactionPoolError::TX_NOT_FOUND;
+      }
+      auto slot = it->second;
+      imported_txs_.erase(it);
+      tx = removeTx(slot);
+    }
+    forgetHash(tx_hash);
 
     logger_->debug("Extrinsic {} with hash {} was removed from the pool",
-                   tx->ext.data.toHex(),
-                   tx->hash.toHex());
+                   tx->ext.data,
+                   tx->hash);
     return outcome::success();
   }
 
+  std::shared_ptr<Transaction> TransactionPoolImpl::removeTx(TxSlot slot) {
+    auto tx = txs_[slot].tx;
+    if (txs_[slot].state == TxState::READY) {
+      unsetReady(slot);
+    } else if (txs_[slot].state == TxState::POSTPONED) {
+      postponed_txs_.erase(txs_[slot].postponed);
+    }
+    freeTx(slot);
+
+    processPostponedTransactions();
+    return tx;
+  }
+
   outcome::result<void> TransactionPoolImpl::remove(
       const std::vector<Transaction::Hash> &tx_hashes) {
-    for (auto &tx_hash : tx_hashes) {
-      removeOne(tx_hash);
+    std::vector<Transaction::Hash> removed;
+    removed.reserve(tx_hashes.size());
+    {
+      std::lock_guard lock{mutex_};
+      for (auto &tx_hash : tx_hashes) {
+        if (auto it = imported_txs_.find(tx_hash);
+            it != imported_txs_.end()) {
+          auto slot = it->second;
+          imported_txs_.erase(it);
+          removeTx(slot);
+          removed.push_back(tx_hash);
+        }
+      }
+    }
+    for (auto &tx_hash : removed) {
+      forgetHash(tx_hash);
     }
+    logger_->debug("{} of {} extrinsics were removed from the pool",
+                   removed.size(),
+                   tx_hashes.size());
 
     return outcome::success();
   }
 
   void TransactionPoolImpl::processPostponedTransactions() {
-    // Move to local for avoid endless cycle at possible coming back tx
-    auto postponed_txs = std::move(postponed_txs_);
-    while (!postponed_txs.empty()) {
-      auto tx = postponed_txs.front().lock();
-      postponed_txs.pop_front();
-
-      auto result = processTransaction(tx);
-      if (result.has_error()
-          && result.error() == TransactionPoolError::POOL_IS_FULL) {
-        postponed_txs_.insert(postponed_txs_.end(),
-                              std::make_move_iterator(postponed_txs.begin()),
-                              std::make_move_iterator(postponed_txs.end()));
-        return;
+    while (not postponed_txs_.empty() and hasSpaceInReady()) {
+      auto slot = postponed_txs_.front();
+      postponed_txs_.pop_front();
+
+      // might have lost a required tag while postponed
+      txs_[slot].state = TxState::WAITING;
+      if (txs_[slot].missing == 0) {
+        setReady(slot);
       }
     }
   }
 
-  void TransactionPoolImpl::delTransactionAsWaiting(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->requires) {
-      auto range = tx_waits_tag_.equal_range(tag);
-      for (auto i = range.first; i != range.second;) {
-        if (i->second.lock() == tx) {
-          tx_waits_tag_.erase(i);
-          break;
+  std::unique_ptr<ReadyTransactions> TransactionPoolImpl::getReadyTransactions()
+      const {
+    std::shared_ptr<const ReadySnapshot> snapshot;
+    {
+      std::lock_guard lock{mutex_};
+      if (ready_snapshot_ == nullptr) {
+        auto fresh = std::make_shared<ReadySnapshot>();
+        fresh->entries.reserve(ready_queue_.size());
+        for (auto &[_, slot] : ready_queue_) {
+          auto &record = txs_[slot];
+          fresh->entries.push_back(ReadySnapshot::Entry{
+              record.tx, record.requires, record.provides});
         }
+        fresh->tags_num = tags_.size();
+        ready_snapshot_ = std::move(fresh);
       }
+      snapshot = ready_snapshot_;
     }
-  }
-
-  std::map<Transaction::Hash, std::shared_ptr<Transaction>>
-  TransactionPoolImpl::getReadyTransactions() const {
-    std::map<Transaction::Hash, std::shared_ptr<Transaction>> ready;
-    std::for_each(ready_txs_.begin(), ready_txs_.end(), [&ready](auto it) {
-      if (auto tx = it.second.lock()) {
-        ready.emplace(it.first, std::move(tx));
-      }
-    });
-    return ready;
+    return std::make_unique<ReadyTransactionsImpl>(std::move(snapshot));
   }
 
   outcome::result<std::vector<Transaction>> TransactionPoolImpl::removeStale(
       const primitives::BlockId &at) {
     OUTCOME_TRY(number, header_repo_->getNumberById(at));
 
-    std::vector<Transaction::Hash> remove_to;
-
-    for (auto &[txHash, tx] : imported_txs_) {
-      if (moderator_->banIfStale(number, *tx)) {
-        remove_to.emplace_back(txHash);
+    std::vector<Transaction::Hash> removed;
+    {
+      std::lock_guard lock{mutex_};
+      for (auto &[tx_hash, slot] : imported_txs_) {
+        if (moderator_->banIfStale(number, *txs_[slot].tx)) {
+          removed.emplace_back(tx_hash);
+        }
+      }
+      for (auto &tx_hash : removed) {
+        auto it = imported_txs_.find(tx_hash);
+        auto slot = it->second;
+        imported_txs_.erase(it);
+        removeTx(slot);
       }
-    }
 
-    for (auto &tx_hash : remove_to) {
-      OUTCOME_TRY(removeOne(tx_hash));
+      moderator_->updateBan();
+    }
+    for (auto &tx_hash : removed) {
+      forgetHash(tx_hash);
     }
-
-    moderator_->updateBan();
 
     return outcome::success();
   }
 
-  bool TransactionPoolImpl::isInReady(
-      const std::shared_ptr<const Transaction> &tx) const {
-    auto i = ready_txs_.find(tx->hash);
-    return i != ready_txs_.end() && !i->second.expired();
-  }
-
-  bool TransactionPoolImpl::checkForReady(
-      const std::shared_ptr<const Transaction> &tx) const {
-    return std::all_of(
-        tx->requires.begin(), tx->requires.end(), [this](auto &&tag) {
-          auto range = tx_provides_tag_.equal_range(tag);
-          return range.first != range.second;
-        });
-  }
-
-  void TransactionPoolImpl::setReady(const std::shared_ptr<Transaction> &tx) {
-    if (auto [_, ok] = ready_txs_.emplace(tx->hash, tx); ok) {
-      commitRequiredTags(tx);
-      commitProvidedTags(tx);
-    }
+  bool TransactionPoolImpl::contains(const Transaction::Hash &tx_hash) const {
+    auto &shard = shardOf(tx_hash);
+    std::lock_guard lock{shard.mutex};
+    return shard.hashes.count(tx_hash) != 0;
   }
 
-  void TransactionPoolImpl::commitRequiredTags(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->requires) {
-      auto range = tx_waits_tag_.equal_range(tag);
-      for (auto i = range.first; i != range.second;) {
-        auto ci = i++;
-        if (ci->second.lock() == tx) {
-          auto node = tx_waits_tag_.extract(ci);
-          tx_depends_on_tag_.emplace(std::move(node.key()),
-                                     std::move(node.mapped()));
-        }
+  std::vector<outcome::result<void>> TransactionPoolImpl::checkUnknown(
+      const std::vector<Transaction::Hash> &tx_hashes) const {
+    std::vector<outcome::result<void>> results;
+    results.reserve(tx_hashes.size());
+    for (auto &tx_hash : tx_hashes) {
+      if (contains(tx_hash)) {
+        results.emplace_back(TransactionPoolError::TX_ALREADY_IMPORTED);
+      } else {
+        results.emplace_back(outcome::success());
       }
     }
-  }
-
-  void TransactionPoolImpl::commitProvidedTags(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->provides) {
-      tx_provides_tag_.emplace(tag, tx);
-
-      provideTag(tag);
-    }
-  }
-
-  void TransactionPoolImpl::provideTag(const Transaction::Tag &tag) {
-    auto range = tx_waits_tag_.equal_range(tag);
-    for (auto it = range.first; it != range.second;) {
-      auto tx = (it++)->second.lock();
-      if (checkForReady(tx)) {
-        if (hasSpaceInReady()) {
-          setReady(tx);
-        } else {
-          postponeTransaction(tx);
-        }
+    // the moderator is asked about the rest under one lock
+    std::lock_guard lock{mutex_};
+    for (size_t i = 0; i < tx_hashes.size(); ++i) {
+      if (results[i] and moderator_->isBanned(tx_hashes[i])) {
+        results[i] = TransactionPoolError::TX_BANNED;
       }
     }
+    return results;
   }
 
-  void TransactionPoolImpl::unsetReady(const std::shared_ptr<Transaction> &tx) {
-    if (auto tx_node = ready_txs_.extract(tx->hash); !tx_node.empty()) {
-      rollbackRequiredTags(tx);
-      rollbackProvidedTags(tx);
+  std::vector<std::shared_ptr<const Transaction>>
+  TransactionPoolImpl::getTransactions(
+      const std::vector<Transaction::Hash> &tx_hashes) const {
+    std::vector<std::shared_ptr<const Transaction>> txs;
+    txs.reserve(tx_hashes.size());
+    std::lock_guard lock{mutex_};
+    for (const auto &hash : tx_hashes) {
+      auto it = imported_txs_.find(hash);
+      txs.push_back(it != imported_txs_.end() ? txs_[it->second].tx : nullptr);
     }
+    return txs;
   }
 
-  void TransactionPoolImpl::rollbackRequiredTags(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->requires) {
-      tx_waits_tag_.emplace(tag, tx);
+  std::vector<std::shared_ptr<const Transaction>>
+  TransactionPoolImpl::getForRevalidation(size_t max) {
+    std::lock_guard lock{mutex_};
+    std::vector<std::shared_ptr<const Transaction>> txs;
+    txs.reserve(std::min(max, revalidation_order_.size()));
+    auto end = revalidation_order_.begin();
+    while (txs.size() < max and end != revalidation_order_.end()) {
+      txs.push_back(txs_[*end++].tx);
     }
+    // the iterators kept by the records stay valid
+    revalidation_order_.splice(revalidation_order_.end(),
+                               revalidation_order_,
+                               revalidation_order_.begin(),
+                               end);
+    return txs;
   }
 
-  void TransactionPoolImpl::rollbackProvidedTags(
-      const std::shared_ptr<Transaction> &tx) {
-    for (auto &tag : tx->provides) {
-      auto range = tx_provides_tag_.equal_range(tag);
-      for (auto i = range.first; i != range.second; ++i) {
-        if (i->second.lock() == tx) {
-          tx_provides_tag_.erase(i);
-          break;
+  void TransactionPoolImpl::setReady(TxSlot slot) {
+    auto enqueue = [this](TxSlot slot) {
+      auto &record = txs_[slot];
+      BOOST_ASSERT(record.missing == 0);
+      record.state = TxState::READY;
+      auto key = ReadyKey{record.tx->priority, ready_seq_++};
+      record.queued = ready_queue_.emplace(key, slot).first;
+      ready_snapshot_.reset();
+    };
+
+    // a worklist instead of the recursion, as the chains of dependent
+    // transactions may be long
+    enqueue(slot);
+    std::vector<TxSlot> pending{slot};
+    while (not pending.empty()) {
+      auto &record = txs_[pending.back()];
+      pending.pop_back();
+
+      for (auto tag : record.provides) {
+        auto &tag_record = tags_[tag];
+        if (tag_record.ready_providers++ != 0) {
+          continue;
+        }
+        for (auto dependent : tag_record.dependents) {
+          auto &dependent_record = txs_[dependent];
+          if (--dependent_record.missing != 0
+              or dependent_record.state != TxState::WAITING) {
+            continue;
+          }
+          if (hasSpaceInReady()) {
+            enqueue(dependent);
+            pending.push_back(dependent);
+          } else {
+            postponeTransaction(dependent);
+          }
         }
       }
-
-      unprovideTag(tag);
     }
   }
 
-  void TransactionPoolImpl::unprovideTag(const Transaction::Tag &tag) {
-    if (tx_provides_tag_.find(tag) == tx_provides_tag_.end()) {
-      for (auto it = tx_depends_on_tag_.find(tag);
-           it != tx_depends_on_tag_.end();
-           it = tx_depends_on_tag_.find(tag)) {
-        if (auto tx = it->second.lock()) {
-          unsetReady(tx);
+  void TransactionPoolImpl::unsetReady(TxSlot slot) {
+    std::vector<TxSlot> pending{slot};
+    while (not pending.empty()) {
+      auto &record = txs_[pending.back()];
+      pending.pop_back();
+      ready_queue_.erase(record.queued);
+      ready_snapshot_.reset();
+      record.state = TxState::WAITING;
+
+      for (auto tag : record.provides) {
+        auto &tag_record = tags_[tag];
+        if (--tag_record.ready_providers != 0) {
+          continue;
+        }
+        for (auto dependent : tag_record.dependents) {
+          auto &dependent_record = txs_[dependent];
+          if (dependent_record.missing++ == 0
+              and dependent_record.state == TxState::READY) {
+            // taken out of the queue right away, so it is not taken twice
+            dependent_record.state = TxState::WAITING;
+            pending.push_back(dependent);
+          }
         }
-        tx_depends_on_tag_.erase(it);
       }
     }
   }
 
   TransactionPoolImpl::Status TransactionPoolImpl::getStatus() const {
-    return Status{ready_txs_.size(), imported_txs_.size() - ready_txs_.size()};
+    std::lock_guard lock{mutex_};
+    return Status{ready_queue_.size(),
+                  imported_txs_.size() - ready_queue_.size(),
+                  bytes_};
   }
 
 }  // namespace kagome::transaction_pool
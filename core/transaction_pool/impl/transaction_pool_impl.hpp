@@ -6,25 +6,45 @@
 #ifndef KAGOME_TRANSACTION_POOL_IMPL_HPP
 #define KAGOME_TRANSACTION_POOL_IMPL_HPP
 
+#include <array>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
 #include <outcome/outcome.hpp>
 
 #include "blockchain/block_header_repository.hpp"
+#include "common/flat_hash_map.hpp"
 #include "common/logger.hpp"
 #include "transaction_pool/pool_moderator.hpp"
 #include "transaction_pool/transaction_pool.hpp"
 
 namespace kagome::transaction_pool {
 
+  /**
+   * Is safe to be used from several threads. The hashes of the transactions
+   * are indexed in shards with their own locks, so that the duplicates, the
+   * most of the gossiped transactions, are rejected without taking the lock
+   * of the dependency graph. The graph is changed under a short lock, and the
+   * proposer iterates over a snapshot of the ready transactions, which is
+   * built once per change of the ready set, so it does not hold the lock
+   * while a block is built
+   */
   class TransactionPoolImpl : public TransactionPool {
     static constexpr auto kDefaultLoggerTag = "Transaction Pool";
 
+    /// number of the shards of the hashes of the transactions
+    static constexpr size_t kShardsNum = 16;
+
    public:
     TransactionPoolImpl(
         std::unique_ptr<PoolModerator> moderator,
         std::shared_ptr<blockchain::BlockHeaderRepository> header_repo,
         Limits limits);
 
-    TransactionPoolImpl(TransactionPoolImpl &&) = default;
+    TransactionPoolImpl(TransactionPoolImpl &&) = delete;
     TransactionPoolImpl(const TransactionPoolImpl &) = delete;
 
     ~TransactionPoolImpl() override = default;
@@ -34,93 +54,222 @@ namespace kagome::transaction_pool {
 
     outcome::result<void> submitOne(Transaction &&tx) override;
     outcome::result<void> submit(std::vector<Transaction> txs) override;
+    std::vector<outcome::result<void>> submitEach(
+        std::vector<Transaction> txs) override;
 
     outcome::result<void> removeOne(const Transaction::Hash &tx_hash) override;
     outcome::result<void> remove(
         const std::vector<Transaction::Hash> &tx_hashes) override;
 
-    std::map<Transaction::Hash, std::shared_ptr<Transaction>>
-    getReadyTransactions() const override;
+    std::unique_ptr<ReadyTransactions> getReadyTransactions() const override;
 
     outcome::result<std::vector<Transaction>> removeStale(
         const primitives::BlockId &at) override;
 
-    Status getStatus() const override;
+    bool contains(const Transaction::Hash &tx_hash) const override;
 
-   private:
-    outcome::result<void> submitOne(const std::shared_ptr<Transaction> &tx);
+    std::vector<outcome::result<void>> checkUnknown(
+        const std::vector<Transaction::Hash> &tx_hashes) const override;
 
-    outcome::result<void> processTransaction(
-        const std::shared_ptr<Transaction> &tx);
+    std::vector<std::shared_ptr<const Transaction>> getTransactions(
+        const std::vector<Transaction::Hash> &tx_hashes) const override;
 
-    outcome::result<void> processTransactionAsReady(
-        const std::shared_ptr<Transaction> &tx);
+    std::vector<std::shared_ptr<const Transaction>> getForRevalidation(
+        size_t max) override;
 
-    outcome::result<void> processTransactionAsWaiting(
-        const std::shared_ptr<Transaction> &tx);
+    Status getStatus() const override;
 
-    outcome::result<void> ensureSpace() const;
+   private:
+    class ReadyTransactionsImpl;
+    struct ReadySnapshot;
+
+    struct Shard {
+      std::mutex mutex;
+      common::FlatHashSet<Transaction::Hash> hashes;
+    };
+
+    /// Index of the record of a transaction in the slab of the records
+    using TxSlot = uint32_t;
+
+    /// Interned tag, index of its record in the slab of the tag records
+    using TagId = uint32_t;
+
+    /**
+     * Position of a ready transaction in the ready queue: the ones with a
+     * higher priority come first, then the ones which got ready earlier
+     */
+    struct ReadyKey {
+      Transaction::Priority priority;
+      uint64_t seq;
+
+      bool operator<(const ReadyKey &other) const {
+        return priority != other.priority ? priority > other.priority
+                                          : seq < other.seq;
+      }
+    };
+    using ReadyQueue = std::map<ReadyKey, TxSlot>;
+
+    /**
+     * Position of a transaction in the order of eviction: the ones with a
+     * lower priority go first, then the ones imported later
+     */
+    struct EvictionKey {
+      Transaction::Priority priority;
+      uint64_t seq;
+
+      bool operator<(const EvictionKey &other) const {
+        return priority != other.priority ? priority < other.priority
+                                          : seq > other.seq;
+      }
+    };
+    using EvictionQueue = std::map<EvictionKey, TxSlot>;
+
+    enum class TxState : uint8_t { FREE, WAITING, READY, POSTPONED };
+
+    struct TxRecord {
+      std::shared_ptr<Transaction> tx;
+      /// interned tags the transaction requires and provides, without repeats
+      std::vector<TagId> requires;
+      std::vector<TagId> provides;
+      /// number of the required tags provided by no ready transaction
+      size_t missing = 0;
+      TxState state = TxState::FREE;
+      /// valid if the transaction is ready
+      ReadyQueue::iterator queued;
+      /// valid if the transaction is postponed
+      std::list<TxSlot>::iterator postponed;
+      /// position in the order of revalidation
+      std::list<TxSlot>::iterator revalidation;
+      /// position in the order of eviction
+      EvictionQueue::iterator evictable;
+    };
+
+    struct TagRecord {
+      /// key of the tag in the interning table
+      const Transaction::Tag *tag = nullptr;
+      /// transactions requiring the tag, whatever their state is
+      std::vector<TxSlot> dependents;
+      /// number of the ready transactions providing the tag
+      size_t ready_providers = 0;
+      /// number of the transactions requiring or providing the tag
+      size_t refs = 0;
+    };
+
+    Shard &shardOf(const Transaction::Hash &hash) const;
+
+    /// Drops the hash from its shard, once the transaction is not in the pool
+    void forgetHash(const Transaction::Hash &hash);
+
+    /// Reserves the hash of the transaction in its shard
+    /// @return false if the transaction is in the pool already
+    bool reserveHash(const Transaction::Hash &hash);
+
+    /**
+     * Adds the transaction to the dependency graph, evicting the ones of a
+     * lower priority if the pool is full. Is called under the lock
+     * @return hashes of the evicted transactions
+     */
+    outcome::result<std::vector<Transaction::Hash>> insertTx(
+        std::shared_ptr<Transaction> tx);
+
+    /**
+     * @return the transactions to be evicted to fit \arg tx into the limits,
+     * POOL_IS_FULL if the ones of a lower priority are not enough
+     */
+    outcome::result<std::vector<TxSlot>> selectEvicted(
+        const Transaction &tx) const;
+
+    /// Removes the transaction from the dependency graph
+    /// @return the removed transaction
+    std::shared_ptr<Transaction> removeTx(TxSlot slot);
+
+    TagId internTag(const Transaction::Tag &tag);
+
+    /// Drops a reference to the tag, which is freed when none is left
+    void releaseTag(TagId tag);
+
+    /// @return interned \arg tags without repeats
+    std::vector<TagId> internTags(const std::vector<Transaction::Tag> &tags);
+
+    TxSlot allocateTx(std::shared_ptr<Transaction> tx);
+
+    void freeTx(TxSlot slot);
 
     bool hasSpaceInReady() const;
 
-    void addTransactionAsWaiting(const std::shared_ptr<Transaction> &tx);
-
-    void delTransactionAsWaiting(const std::shared_ptr<Transaction> &tx);
+    /// Sets ready the transaction with no missing tags, or postpones it if
+    /// the ready limit is reached
+    void makeReady(TxSlot slot);
 
     /// Postpone ready transaction (in case ready limit was enreach before)
-    void postponeTransaction(const std::shared_ptr<Transaction> &tx);
+    void postponeTransaction(TxSlot slot);
 
     /// Process postponed transactions (in case appearing space for them)
     void processPostponedTransactions();
 
-    void provideTag(const Transaction::Tag &tag);
-
-    void unprovideTag(const Transaction::Tag &tag);
+    /// Sets ready the transaction, as well as the ones which get all of their
+    /// tags from it
+    void setReady(TxSlot slot);
 
-    void commitRequiredTags(const std::shared_ptr<Transaction> &tx);
+    /// Sets waiting the transaction, as well as the ready ones which lose a
+    /// tag they require with it
+    void unsetReady(TxSlot slot);
 
-    void commitProvidedTags(const std::shared_ptr<Transaction> &tx);
+    std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
 
-    void rollbackRequiredTags(const std::shared_ptr<Transaction> &tx);
+    common::Logger logger_ = common::createLogger(kDefaultLoggerTag);
 
-    void rollbackProvidedTags(const std::shared_ptr<Transaction> &tx);
+    mutable std::array<Shard, kShardsNum> shards_;
 
-    bool checkForReady(const std::shared_ptr<const Transaction> &tx) const;
+    /// guards the moderator and the dependency graph, which are all of the
+    /// members below
+    mutable std::mutex mutex_;
 
-    void setReady(const std::shared_ptr<Transaction> &tx);
+    // bans stale and invalid transactions for some amount of time
+    std::unique_ptr<PoolModerator> moderator_;
 
-    void unsetReady(const std::shared_ptr<Transaction> &tx);
+    /// All of imported transaction, contained in the pool
+    common::FlatHashMap<Transaction::Hash, TxSlot> imported_txs_;
 
-    bool isInReady(const std::shared_ptr<const Transaction> &tx) const;
+    /// Records of the transactions, the free ones are reused
+    std::vector<TxRecord> txs_;
+    std::vector<TxSlot> free_txs_;
 
-    std::shared_ptr<blockchain::BlockHeaderRepository> header_repo_;
+    /// Interning table of the tags required or provided by the transactions
+    std::unordered_map<Transaction::Tag, TagId, boost::hash<Transaction::Tag>>
+        tag_ids_;
 
-    common::Logger logger_ = common::createLogger(kDefaultLoggerTag);
+    /// Records of the interned tags, the free ones are reused
+    std::vector<TagRecord> tags_;
+    std::vector<TagId> free_tags_;
 
-    // bans stale and invalid transactions for some amount of time
-    std::unique_ptr<PoolModerator> moderator_;
+    /// Transactions with full-satisfied dependensies, in the order they are
+    /// proposed for a block
+    ReadyQueue ready_queue_;
 
-    /// All of imported transaction, contained in the pool
-    std::unordered_map<Transaction::Hash, std::shared_ptr<Transaction>>
-        imported_txs_;
+    /// Ready transactions given to the proposer, reset when the ready set
+    /// changes
+    mutable std::shared_ptr<const ReadySnapshot> ready_snapshot_;
 
-    /// Collection transaction with full-satisfied dependensies
-    std::unordered_map<Transaction::Hash, std::weak_ptr<Transaction>>
-        ready_txs_;
+    /// Counter of the transactions got ready, which orders the ready ones of
+    /// the same priority
+    uint64_t ready_seq_ = 0;
 
     /// List of ready transaction over limit. It will be process first of all
-    std::list<std::weak_ptr<Transaction>> postponed_txs_;
+    std::list<TxSlot> postponed_txs_;
+
+    /// Transactions from the ones revalidated the longest ago
+    std::list<TxSlot> revalidation_order_;
 
-    /// Transactions which provides specific tags
-    std::multimap<Transaction::Tag, std::weak_ptr<Transaction>>
-        tx_provides_tag_;
+    /// Transactions from the ones evicted first when the pool is full
+    EvictionQueue eviction_queue_;
 
-    /// Transactions with resolved requirement of a specific tag
-    std::multimap<Transaction::Tag, std::weak_ptr<Transaction>>
-        tx_depends_on_tag_;
+    /// Counter of the imported transactions, which orders the evicted ones
+    /// of the same priority
+    uint64_t import_seq_ = 0;
 
-    /// Transactions with unresolved require of specific tags
-    std::multimap<Transaction::Tag, std::weak_ptr<Transaction>> tx_waits_tag_;
+    /// Total size of the transactions in the pool
+    size_t bytes_ = 0;
 
     Limits limits_;
   };
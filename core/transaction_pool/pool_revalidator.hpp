@@ -0,0 +1,40 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_HPP
+#define KAGOME_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_HPP
+
+#include <vector>
+
+#include "primitives/common.hpp"
+#include "primitives/extrinsic.hpp"
+
+namespace kagome::transaction_pool {
+
+  /**
+   * Keeps the transaction pool valid for the state of the best block
+   */
+  class PoolRevalidator {
+   public:
+    virtual ~PoolRevalidator() = default;
+
+    /**
+     * Schedules the revalidation for the new \arg best block, returns without
+     * waiting for it. Should be called from the thread the block tree is
+     * changed on
+     */
+    virtual void onNewBestBlock(const primitives::BlockInfo &best) = 0;
+
+    /**
+     * Schedules \arg extrinsics, which were taken from the pool for a block
+     * which is not imported, to be submitted to the pool again along with the
+     * next revalidation
+     */
+    virtual void resubmit(std::vector<primitives::Extrinsic> extrinsics) = 0;
+  };
+
+}  // namespace kagome::transaction_pool
+
+#endif  // KAGOME_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_HPP
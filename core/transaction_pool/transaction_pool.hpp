@@ -6,6 +6,8 @@
 #ifndef KAGOME_TRANSACTION_POOL_HPP
 #define KAGOME_TRANSACTION_POOL_HPP
 
+#include <memory>
+
 #include <outcome/outcome.hpp>
 
 #include "primitives/block_id.hpp"
@@ -15,6 +17,23 @@ namespace kagome::transaction_pool {
 
   using primitives::Transaction;
 
+  /**
+   * Lazily iterates over the transactions ready to be included in the next
+   * block: the ones with a higher priority come first, the ones of the same
+   * priority come in the order they got ready, and a transaction never comes
+   * before the ones providing the tags it requires. It iterates over the
+   * transactions ready when it was got, whatever happens to the pool after
+   */
+  class ReadyTransactions {
+   public:
+    virtual ~ReadyTransactions() = default;
+
+    /**
+     * @return the next transaction, nullptr if there are no more
+     */
+    virtual std::shared_ptr<const Transaction> next() = 0;
+  };
+
   class TransactionPool {
    public:
     struct Status;
@@ -34,10 +53,21 @@ namespace kagome::transaction_pool {
 
     /**
      * Import several transactions to the pool
-     * @see submitOne()
+     * @return the first failure, the transactions after it are imported
+     * nevertheless
+     * @see submitEach()
      */
     virtual outcome::result<void> submit(std::vector<Transaction> txs) = 0;
 
+    /**
+     * Import several transactions to the pool at once, which costs a single
+     * pass over the dependency graph instead of one per transaction
+     * @return result of the import of each of \arg txs, in the same order
+     * @see submitOne()
+     */
+    virtual std::vector<outcome::result<void>> submitEach(
+        std::vector<Transaction> txs) = 0;
+
     /**
      * Remove transaction from the pool
      * @param txHash - hash of the removed transaction
@@ -56,8 +86,8 @@ namespace kagome::transaction_pool {
      * @return transactions ready to included in the next block, sorted by their
      * priority
      */
-    virtual std::map<Transaction::Hash, std::shared_ptr<Transaction>>
-    getReadyTransactions() const = 0;
+    virtual std::unique_ptr<ReadyTransactions> getReadyTransactions()
+        const = 0;
 
     /**
      * Remove from the pool and temporarily ban transactions which longevity is
@@ -70,20 +100,57 @@ namespace kagome::transaction_pool {
     virtual outcome::result<std::vector<Transaction>> removeStale(
         const primitives::BlockId &at) = 0;
 
+    /**
+     * Cheap check for the duplicates, to drop them before they are validated
+     * @return true if the transaction with \arg tx_hash is in the pool
+     */
+    virtual bool contains(const Transaction::Hash &tx_hash) const = 0;
+
+    /**
+     * Cheap check of the transactions received together, to drop the known
+     * ones before they are validated
+     * @return for each of \arg tx_hashes, in the same order,
+     * TX_ALREADY_IMPORTED if it is in the pool, TX_BANNED if it is banned
+     * from the pool, success otherwise
+     */
+    virtual std::vector<outcome::result<void>> checkUnknown(
+        const std::vector<Transaction::Hash> &tx_hashes) const = 0;
+
+    /**
+     * @return the transactions with \arg tx_hashes, in the same order,
+     * nullptr for the ones not in the pool
+     */
+    virtual std::vector<std::shared_ptr<const Transaction>> getTransactions(
+        const std::vector<Transaction::Hash> &tx_hashes) const = 0;
+
+    /**
+     * @return up to \arg max transactions to be revalidated, the ones
+     * imported or revalidated the longest ago come first. They are considered
+     * revalidated since then, so that the next call returns the others
+     */
+    virtual std::vector<std::shared_ptr<const Transaction>>
+    getForRevalidation(size_t max) = 0;
+
     virtual Status getStatus() const = 0;
   };
 
   struct TransactionPool::Status {
     size_t ready_num;
     size_t waiting_num;
+    /// total size of the transactions in the pool
+    size_t bytes;
   };
 
   struct TransactionPool::Limits {
     static constexpr size_t kDefaultMaxReadyNum = 128;
     static constexpr size_t kDefaultCapacity = 512;
+    static constexpr size_t kDefaultMaxBytes = 20 * 1024 * 1024;
 
     size_t max_ready_num = kDefaultMaxReadyNum;
     size_t capacity = kDefaultCapacity;
+    /// limit of the total size of the transactions in the pool, the ones of
+    /// the lowest priority are evicted to fit a better one
+    size_t max_bytes = kDefaultMaxBytes;
   };
 
 }  // namespace kagome::transaction_pool
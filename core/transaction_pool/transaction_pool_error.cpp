@@ -14,5 +14,7 @@ OUTCOME_CPP_DEFINE_CATEGORY(kagome::transaction_pool, TransactionPoolError, e) {
       return "Transaction not found in the pool";
     case E::POOL_IS_FULL:
       return "Transaction pool is full";
+    case E::TX_BANNED:
+      return "Transaction is temporarily banned from the pool";
   }
 }
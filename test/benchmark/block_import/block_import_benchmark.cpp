@@ -0,0 +1,333 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the import of the blocks of a recorded chain segment, without
+ * the network, so that the import path is compared before and after a
+ * change on the same blocks.
+ *
+ * The segment is exported first from the database of a node, which has the
+ * blocks: --export writes the blocks --from..--to of the database at
+ * --database to the file at --blocks. The replay imports the blocks of the
+ * file one by one through the block executor into the database at
+ * --database, which has to have the parent of the first of them: a copy of
+ * the database of a node, or a fresh one, which is created from the genesis,
+ * for a segment starting at the block 1.
+ *
+ * The blocks per second, the percentiles of the times of the blocks, the
+ * time taken by each stage of the import, as it is traced, and the peak
+ * memory of the process are reported in a stable format
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <thread>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/program_options.hpp>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include "application/impl/app_config_impl.hpp"
+#include "benchmark/support/memory_usage.hpp"
+#include "common/logger.hpp"
+#include "injector/syncing_node_injector.hpp"
+#include "scale/scale.hpp"
+
+namespace {
+  using kagome::application::AppConfiguration;
+  using kagome::application::AppConfigurationImpl;
+  using kagome::application::AppStateManager;
+  using kagome::blockchain::BlockStorage;
+  using kagome::common::Tracer;
+  using kagome::consensus::BlockExecutor;
+  using kagome::primitives::Block;
+  using kagome::primitives::BlockNumber;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Params {
+    std::string genesis;
+    std::string database;
+    std::string blocks;
+    bool do_export;
+    BlockNumber from;
+    BlockNumber to;
+  };
+
+  double milliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+
+  /**
+   * The blocks are written one after another, each as the 4 bytes of the
+   * little endian size of its SCALE encoding and the encoding
+   */
+  outcome::result<void> writeBlock(std::ofstream &file, const Block &block) {
+    OUTCOME_TRY(encoded, kagome::scale::encode(block));
+    std::array<char, 4> size{};
+    for (size_t i = 0; i < size.size(); ++i) {
+      size[i] = static_cast<char>(encoded.size() >> (i * 8));
+    }
+    file.write(size.data(), size.size());
+    file.write(reinterpret_cast<const char *>(encoded.data()),
+               static_cast<std::streamsize>(encoded.size()));
+    return outcome::success();
+  }
+
+  /// @return the next block of \arg file, none at its end
+  boost::optional<Block> readBlock(std::ifstream &file) {
+    std::array<unsigned char, 4> size_bytes{};
+    if (not file.read(reinterpret_cast<char *>(size_bytes.data()),
+                      size_bytes.size())) {
+      return boost::none;
+    }
+    size_t size = 0;
+    for (size_t i = 0; i < size_bytes.size(); ++i) {
+      size |= static_cast<size_t>(size_bytes[i]) << (i * 8);
+    }
+    std::vector<uint8_t> encoded(size);
+    if (not file.read(reinterpret_cast<char *>(encoded.data()),
+                      static_cast<std::streamsize>(size))) {
+      throw std::runtime_error{"the file of the blocks is truncated"};
+    }
+    return kagome::scale::decode<Block>(encoded).value();
+  }
+
+  /**
+   * Writes the blocks --from..--to of the database to the file
+   */
+  int exportBlocks(const Params &params, BlockStorage &storage) {
+    std::ofstream file{params.blocks, std::ios::binary | std::ios::trunc};
+    if (not file) {
+      fmt::print(stderr, "cannot open {}\n", params.blocks);
+      return EXIT_FAILURE;
+    }
+    for (auto number = params.from; number <= params.to; ++number) {
+      auto header = storage.getBlockHeader(number);
+      auto body = storage.getBlockBody(number);
+      if (not header or not body) {
+        fmt::print(stderr,
+                   "block {} is not in the database: {}\n",
+                   number,
+                   (header ? body.error() : header.error()).message());
+        return EXIT_FAILURE;
+      }
+      auto written = writeBlock(file, Block{header.value(), body.value()});
+      if (not written or not file) {
+        fmt::print(stderr, "cannot write block {}\n", number);
+        return EXIT_FAILURE;
+      }
+    }
+    fmt::print("exported blocks {}..{} to {}\n",
+               params.from,
+               params.to,
+               params.blocks);
+    return EXIT_SUCCESS;
+  }
+
+  /**
+   * Total time of the spans of a stage
+   */
+  struct Stage {
+    size_t count = 0;
+    Clock::duration total{};
+  };
+
+  /**
+   * Imports the blocks of the file and reports how long it took
+   */
+  int replayBlocks(const Params &params,
+                   BlockExecutor &executor,
+                   Tracer &tracer) {
+    std::ifstream file{params.blocks, std::ios::binary};
+    if (not file) {
+      fmt::print(stderr, "cannot open {}\n", params.blocks);
+      return EXIT_FAILURE;
+    }
+    auto rss_before = benchutil::maxRss();
+    std::vector<Clock::duration> latencies;
+    std::map<std::string, Stage> stages;
+    size_t extrinsics = 0;
+    BlockNumber first = 0;
+    BlockNumber last = 0;
+
+    tracer.setEnabled(true);
+    while (auto block = readBlock(file)) {
+      auto start = Clock::now();
+      auto imported = executor.importBlock(*block);
+      latencies.push_back(Clock::now() - start);
+      if (not imported) {
+        fmt::print(stderr,
+                   "cannot import block {}: {}\n",
+                   block->header.number,
+                   imported.error().message());
+        return EXIT_FAILURE;
+      }
+      if (latencies.size() == 1) {
+        first = block->header.number;
+      }
+      last = block->header.number;
+      extrinsics += block->body.size();
+
+      // the spans are collected after each block, so that the ring buffers
+      // of the tracer do not drop them
+      for (auto &span : tracer.spans()) {
+        auto &stage = stages[fmt::format("{}/{}", span.category, span.name)];
+        ++stage.count;
+        stage.total += span.duration;
+      }
+      tracer.reset();
+    }
+    tracer.setEnabled(false);
+    if (latencies.empty()) {
+      fmt::print(stderr, "there are no blocks in {}\n", params.blocks);
+      return EXIT_FAILURE;
+    }
+
+    Clock::duration total{};
+    for (auto &latency : latencies) {
+      total += latency;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+      return milliseconds(
+          latencies[static_cast<size_t>(p * (latencies.size() - 1))]);
+    };
+    auto seconds = std::chrono::duration<double>(total).count();
+    fmt::print("blocks {}..{} extrinsics {}\n", first, last, extrinsics);
+    fmt::print(
+        "imported {} blocks in {:.3f}s blocks/s {:.2f} p50 {:.3f}ms p90 "
+        "{:.3f}ms p99 {:.3f}ms max {:.3f}ms\n",
+        latencies.size(),
+        seconds,
+        seconds > 0 ? latencies.size() / seconds : 0.,
+        percentile(0.5),
+        percentile(0.9),
+        percentile(0.99),
+        percentile(1.));
+    for (auto &[name, stage] : stages) {
+      fmt::print("{:<28} spans {:>9} total {:>12.3f}ms share {:>6.2f}%\n",
+                 name,
+                 stage.count,
+                 milliseconds(stage.total),
+                 100. * milliseconds(stage.total) / milliseconds(total));
+    }
+    fmt::print("max rss {} KiB, {} KiB of them taken by the import\n",
+               benchutil::maxRss(),
+               benchutil::maxRss() - rss_before);
+    return EXIT_SUCCESS;
+  }
+
+  int run(const Params &params) {
+    // the node of the benchmark is configured as a syncing one on the
+    // genesis and the database, the rest is left by default
+    std::vector<const char *> args{"block_import_benchmark",
+                                   "--genesis",
+                                   params.genesis.c_str(),
+                                   "--leveldb",
+                                   params.database.c_str()};
+    auto config = std::make_shared<AppConfigurationImpl>(
+        kagome::common::createLogger("BlockImportBenchmark"));
+    config->initialize_from_args(AppConfiguration::LoadScheme::kFullSyncing,
+                                 static_cast<int>(args.size()),
+                                 const_cast<char **>(args.data()));
+
+    auto injector = kagome::injector::makeSyncingNodeInjector(config);
+    auto app_state_manager =
+        injector.create<std::shared_ptr<AppStateManager>>();
+    auto io_context =
+        injector.create<std::shared_ptr<boost::asio::io_context>>();
+    auto storage = injector.create<std::shared_ptr<BlockStorage>>();
+    std::shared_ptr<BlockExecutor> executor;
+    std::shared_ptr<Tracer> tracer;
+    if (not params.do_export) {
+      executor = injector.create<std::shared_ptr<BlockExecutor>>();
+      tracer = injector.create<std::shared_ptr<Tracer>>();
+    }
+
+    // the components are prepared by the state manager, then the blocks are
+    // exported or imported while it works, and it is shut down after them.
+    // The handlers the import posts are run on a thread of their own
+    int result = EXIT_FAILURE;
+    std::thread worker;
+    app_state_manager->atLaunch([&] {
+      worker = std::thread{[&] {
+        auto work = boost::asio::make_work_guard(*io_context);
+        std::thread io_thread{[&] { io_context->run(); }};
+        result = params.do_export ? exportBlocks(params, *storage)
+                                  : replayBlocks(params, *executor, *tracer);
+        work.reset();
+        io_context->stop();
+        io_thread.join();
+        app_state_manager->shutdown();
+      }};
+    });
+    app_state_manager->run();
+    if (worker.joinable()) {
+      worker.join();
+    }
+    return result;
+  }
+}  // namespace
+
+int main(int argc, const char **argv) {
+  namespace po = boost::program_options;
+
+  Params params{};
+  po::options_description desc("Block import benchmark options");
+  desc.add_options()("help,h", "show help")(
+      "genesis",
+      po::value(&params.genesis),
+      "chain spec of the chain of the blocks")(
+      "database",
+      po::value(&params.database),
+      "LevelDB directory the blocks are exported from or imported into")(
+      "blocks",
+      po::value(&params.blocks),
+      "file the blocks are exported to or imported from")(
+      "export",
+      po::bool_switch(&params.do_export),
+      "export the blocks of the database to the file instead of importing")(
+      "from",
+      po::value(&params.from)->default_value(1),
+      "number of the first block exported")(
+      "to",
+      po::value(&params.to)->default_value(1000),
+      "number of the last block exported");
+
+  po::variables_map vm;
+  try {
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const po::error &e) {
+    std::cerr << e.what() << '\n' << desc << '\n';
+    return EXIT_FAILURE;
+  }
+  if (vm.count("help") != 0) {
+    std::cout << desc << '\n';
+    return EXIT_SUCCESS;
+  }
+  if (params.genesis.empty() or params.database.empty()
+      or params.blocks.empty()) {
+    std::cerr << "the genesis, the database and the blocks are required\n"
+              << desc << '\n';
+    return EXIT_FAILURE;
+  }
+  if (params.from == 0 or params.from > params.to) {
+    std::cerr << "the exported blocks must be 1 <= from <= to\n"
+              << desc << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // the logging of the import is not to be measured
+  spdlog::set_level(spdlog::level::err);
+
+  return run(params);
+}
@@ -0,0 +1,613 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the rounds of GRANDPA played in process by many voters: the time
+ * it takes them to finalize, the CPU their votes take and the memory a
+ * round takes per voter.
+ *
+ * Each voter runs its own voting round over its own view of a chain shared
+ * by all of them, some of the voters see a fork. The voters are connected by
+ * a simulated network, which delivers each vote and fin with a random delay
+ * and drops some of them, and the time is virtual: the simulation jumps to
+ * the time of the next message or timer, so the finality time is the one of
+ * the real network, while the CPU time is the one of the voting rounds. The
+ * signatures are not checked, their cost is measured by the crypto
+ * benchmarks. A voter, which has completed the round, drops the later
+ * messages, as the launcher drops the ones of the past rounds
+ */
+
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <tuple>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <boost/variant.hpp>
+
+#include "benchmark/support/memory_usage.hpp"
+#include "blockchain/block_tree_error.hpp"
+#include "common/visitor.hpp"
+#include "consensus/grandpa/environment.hpp"
+#include "consensus/grandpa/impl/indexed_vote_tracker_impl.hpp"
+#include "consensus/grandpa/impl/vote_tracker_impl.hpp"
+#include "consensus/grandpa/impl/voting_round_impl.hpp"
+#include "consensus/grandpa/vote_crypto_provider.hpp"
+#include "consensus/grandpa/vote_graph/vote_graph_impl.hpp"
+
+namespace {
+  using kagome::consensus::grandpa::BlockInfo;
+  using kagome::consensus::grandpa::BlockNumber;
+  using kagome::consensus::grandpa::CatchUpMessage;
+  using kagome::consensus::grandpa::CompletedRound;
+  using kagome::consensus::grandpa::Duration;
+  using kagome::consensus::grandpa::Environment;
+  using kagome::consensus::grandpa::Fin;
+  using kagome::consensus::grandpa::GrandpaConfig;
+  using kagome::consensus::grandpa::GrandpaJustification;
+  using kagome::consensus::grandpa::Id;
+  using kagome::consensus::grandpa::IndexedVoteTrackerImpl;
+  using kagome::consensus::grandpa::MembershipCounter;
+  using kagome::consensus::grandpa::Precommit;
+  using kagome::consensus::grandpa::Prevote;
+  using kagome::consensus::grandpa::PrimaryPropose;
+  using kagome::consensus::grandpa::RoundNumber;
+  using kagome::consensus::grandpa::RoundState;
+  using kagome::consensus::grandpa::Signature;
+  using kagome::consensus::grandpa::SignedMessage;
+  using kagome::consensus::grandpa::VoteCryptoProvider;
+  using kagome::consensus::grandpa::VoteGraphImpl;
+  using kagome::consensus::grandpa::VoterSet;
+  using kagome::consensus::grandpa::VoteTracker;
+  using kagome::consensus::grandpa::VoteTrackerImpl;
+  using kagome::consensus::grandpa::VotingRoundImpl;
+  using kagome::primitives::BlockHash;
+  using TimePoint = kagome::clock::SteadyClock::TimePoint;
+
+  enum class Tracker { PLAIN, INDEXED };
+
+  /// the duration of a round, as the launcher sets it
+  constexpr Duration kDuration = std::chrono::milliseconds(3333);
+  /// the round is given up, if it is not completed in as many durations
+  constexpr size_t kDeadlineDurations = 20;
+  /// the bounds of the delay of a message sent over the network
+  constexpr auto kMinDelay = std::chrono::milliseconds(20);
+  constexpr auto kMaxDelay = std::chrono::milliseconds(200);
+
+  /// the block finalized by the previous round
+  constexpr BlockNumber kFinalized = 100;
+  /// the best block of the main branch
+  constexpr BlockNumber kBest = 110;
+  /// the block the fork branches off from and the length of the fork
+  constexpr BlockNumber kForkBase = 105;
+  constexpr BlockNumber kForkLength = 3;
+
+  enum Branch : uint8_t { MAIN = 0, FORK = 1 };
+
+  /// the hash of a block tells its branch and its number
+  BlockHash makeHash(Branch branch, BlockNumber number) {
+    BlockHash hash;
+    hash.fill(0);
+    hash[0] = branch;
+    for (size_t i = 0; i < sizeof(number); ++i) {
+      hash[i + 1] = static_cast<uint8_t>(number >> (i * 8));
+    }
+    return hash;
+  }
+
+  BlockNumber numberOf(const BlockHash &hash) {
+    BlockNumber number = 0;
+    for (size_t i = 0; i < sizeof(number); ++i) {
+      number |= static_cast<BlockNumber>(hash[i + 1]) << (i * 8);
+    }
+    return number;
+  }
+
+  BlockHash parentOf(const BlockHash &hash) {
+    auto number = numberOf(hash);
+    if (hash[0] == FORK and number == kForkBase + 1) {
+      return makeHash(MAIN, kForkBase);
+    }
+    return makeHash(static_cast<Branch>(hash[0]), number - 1);
+  }
+
+  BlockInfo infoOf(const BlockHash &hash) {
+    return {numberOf(hash), hash};
+  }
+
+  Id makeId(size_t index) {
+    Id id;
+    id.fill(0);
+    for (size_t i = 0; i < sizeof(index); ++i) {
+      id[i] = static_cast<uint8_t>(index >> (i * 8));
+    }
+    id.back() = 1;
+    return id;
+  }
+
+  /// the clock of the simulation, which is set to the time of each event
+  class VirtualClock : public kagome::clock::SteadyClock {
+   public:
+    TimePoint now() const override {
+      return now_;
+    }
+
+    uint64_t nowUint64() const override {
+      return std::chrono::duration_cast<std::chrono::seconds>(
+                 now_.time_since_epoch())
+          .count();
+    }
+
+    void set(TimePoint time) {
+      now_ = time;
+    }
+
+   private:
+    // far ahead of the steady clock, so the timers of the rounds never
+    // expire by themselves and are fired by the simulation only
+    TimePoint now_ =
+        std::chrono::steady_clock::now() + std::chrono::hours(24 * 365);
+  };
+
+  /**
+   * Signs a vote with the id of the voter and accepts the votes signed so,
+   * as the signatures are not what is measured
+   */
+  class SimCryptoProvider : public VoteCryptoProvider {
+   public:
+    explicit SimCryptoProvider(Id id) : id_{id} {}
+
+    bool verifyPrimaryPropose(const SignedMessage &propose) const override {
+      return propose.is<PrimaryPropose>() and verify(propose);
+    }
+
+    bool verifyPrevote(const SignedMessage &prevote) const override {
+      return prevote.is<Prevote>() and verify(prevote);
+    }
+
+    bool verifyPrecommit(const SignedMessage &precommit) const override {
+      return precommit.is<Precommit>() and verify(precommit);
+    }
+
+    std::vector<bool> verifyVotes(
+        gsl::span<const SignedMessage> votes) const override {
+      std::vector<bool> result;
+      result.reserve(votes.size());
+      for (const auto &vote : votes) {
+        result.push_back(verify(vote));
+      }
+      return result;
+    }
+
+    SignedMessage signPrimaryPropose(
+        const PrimaryPropose &propose) const override {
+      return sign(propose);
+    }
+
+    SignedMessage signPrevote(const Prevote &prevote) const override {
+      return sign(prevote);
+    }
+
+    SignedMessage signPrecommit(const Precommit &precommit) const override {
+      return sign(precommit);
+    }
+
+   private:
+    static bool verify(const SignedMessage &vote) {
+      return std::equal(vote.id.begin(), vote.id.end(), vote.signature.begin());
+    }
+
+    template <typename Message>
+    SignedMessage sign(const Message &message) const {
+      Signature signature;
+      signature.fill(0);
+      std::copy(id_.begin(), id_.end(), signature.begin());
+      return {message, signature, id_};
+    }
+
+    Id id_;
+  };
+
+  class Simulation;
+
+  /**
+   * The chain as seen by a voter, whose best block is \arg best, and the
+   * network, over which the voter sends its votes
+   */
+  class SimEnvironment : public Environment {
+   public:
+    SimEnvironment(Simulation &simulation, size_t index, BlockHash best)
+        : simulation_{simulation}, index_{index}, best_{best} {}
+
+    outcome::result<std::vector<BlockHash>> getAncestry(
+        const BlockHash &base, const BlockHash &block) const override {
+      if (base == block) {
+        return std::vector<BlockHash>{};
+      }
+      std::vector<BlockHash> ancestry;
+      auto hash = block;
+      while (numberOf(hash) > numberOf(base) + 1) {
+        hash = parentOf(hash);
+        ancestry.push_back(hash);
+      }
+      if (numberOf(hash) == numberOf(base) + 1 and parentOf(hash) == base) {
+        return ancestry;
+      }
+      return kagome::blockchain::BlockTreeError::NO_SUCH_BLOCK;
+    }
+
+    bool isEqualOrDescendOf(const BlockHash &base,
+                            const BlockHash &block) const override {
+      auto hash = block;
+      while (numberOf(hash) > numberOf(base)) {
+        hash = parentOf(hash);
+      }
+      return hash == base;
+    }
+
+    outcome::result<BlockInfo> bestChainContaining(
+        const BlockHash &base) const override {
+      if (isEqualOrDescendOf(base, best_)) {
+        return infoOf(best_);
+      }
+      auto main_best = makeHash(MAIN, kBest);
+      if (isEqualOrDescendOf(base, main_best)) {
+        return infoOf(main_best);
+      }
+      return infoOf(base);
+    }
+
+    outcome::result<void> onProposed(RoundNumber,
+                                     MembershipCounter,
+                                     const SignedMessage &propose) override;
+
+    outcome::result<void> onPrevoted(RoundNumber,
+                                     MembershipCounter,
+                                     const SignedMessage &prevote) override;
+
+    outcome::result<void> onPrecommitted(
+        RoundNumber,
+        MembershipCounter,
+        const SignedMessage &precommit) override;
+
+    outcome::result<void> onCommitted(
+        RoundNumber round,
+        const BlockInfo &vote,
+        const GrandpaJustification &justification) override;
+
+    void onCatchUpMessage(const CatchUpMessage &) override {}
+
+    void doOnCompleted(const CompleteHandler &) override {}
+
+    void onCompleted(outcome::result<CompletedRound> round) override;
+
+    outcome::result<void> finalize(const BlockHash &,
+                                   const GrandpaJustification &) override;
+
+   private:
+    Simulation &simulation_;
+    size_t index_;
+    BlockHash best_;
+  };
+
+  /**
+   * A round of as many voters as \arg voters_num, whose messages are lost
+   * with \arg loss_percent probability
+   */
+  class Simulation {
+   public:
+    enum class Timer { PREVOTE, PRECOMMIT };
+    using Payload = boost::variant<SignedMessage, Fin, Timer>;
+
+    Simulation(std::shared_ptr<VoterSet> voters,
+               Tracker tracker,
+               size_t loss_percent,
+               uint64_t seed)
+        : clock_{std::make_shared<VirtualClock>()},
+          start_{clock_->now()},
+          loss_percent_{loss_percent},
+          random_{seed} {
+      auto finalized = makeHash(MAIN, kFinalized);
+      last_round_state_.prevote_ghost = Prevote{kFinalized, finalized};
+      last_round_state_.estimate = infoOf(finalized);
+      last_round_state_.finalized = infoOf(finalized);
+
+      voters_.resize(voters->size());
+      for (size_t i = 0; i < voters_.size(); ++i) {
+        auto &voter = voters_[i];
+        // every fourth voter sees the fork, the rest lag a bit behind the
+        // best block of the main branch
+        auto best = i % 4 == 0 ? makeHash(FORK, kForkBase + kForkLength)
+                               : makeHash(MAIN, kBest - i % 3);
+        voter.io_context = std::make_shared<boost::asio::io_context>();
+        auto env = std::make_shared<SimEnvironment>(*this, i, best);
+        std::shared_ptr<VoteTracker> prevotes, precommits;
+        if (tracker == Tracker::INDEXED) {
+          prevotes = std::make_shared<IndexedVoteTrackerImpl>(voters);
+          precommits = std::make_shared<IndexedVoteTrackerImpl>(voters);
+        } else {
+          prevotes = std::make_shared<VoteTrackerImpl>();
+          precommits = std::make_shared<VoteTrackerImpl>();
+        }
+        voter.round = std::make_shared<VotingRoundImpl>(
+            GrandpaConfig{voters, 1, kDuration, voters->voters().at(i)},
+            env,
+            std::make_shared<SimCryptoProvider>(voters->voters().at(i)),
+            std::move(prevotes),
+            std::move(precommits),
+            std::make_shared<VoteGraphImpl>(*last_round_state_.finalized, env),
+            clock_,
+            voter.io_context);
+      }
+    }
+
+    /// Plays the round till all the voters complete it or the deadline
+    void run() {
+      for (size_t i = 0; i < voters_.size(); ++i) {
+        auto &round = *voters_[i].round;
+        round.primaryPropose(last_round_state_);
+        round.prevote(last_round_state_);
+        round.precommit(last_round_state_);
+        push(start_ + kDuration * 2, i, Timer::PREVOTE, true);
+        push(start_ + kDuration * 4, i, Timer::PRECOMMIT, true);
+      }
+
+      auto deadline = start_ + kDuration * kDeadlineDurations;
+      while (not events_.empty() and completed_ < voters_.size()) {
+        auto event = events_.top();
+        events_.pop();
+        if (event.time > deadline) {
+          break;
+        }
+        auto &voter = voters_[event.voter];
+        if (voter.completed) {
+          continue;
+        }
+        clock_->set(event.time);
+        deliver(voter, event);
+        voter.io_context->restart();
+        voter.io_context->poll();
+      }
+    }
+
+    /// Sends \arg payload of the voter of \arg from to all the voters
+    void broadcast(size_t from, Payload payload) {
+      auto shared = std::make_shared<const Payload>(std::move(payload));
+      std::uniform_int_distribution<size_t> loss(0, 99);
+      std::uniform_int_distribution<Duration::rep> delay(
+          std::chrono::duration_cast<Duration>(kMinDelay).count(),
+          std::chrono::duration_cast<Duration>(kMaxDelay).count());
+      for (size_t to = 0; to < voters_.size(); ++to) {
+        if (to == from) {
+          // a voter receives its own messages at once
+          push(clock_->now(), to, shared, true);
+        } else if (not voters_[to].completed
+                   and loss(random_) >= loss_percent_) {
+          push(clock_->now() + Duration(delay(random_)), to, shared, false);
+        }
+      }
+    }
+
+    void onFinalized(size_t index) {
+      auto &voter = voters_[index];
+      if (not voter.finalized_at) {
+        voter.finalized_at = clock_->now();
+      }
+    }
+
+    void onCompleted(size_t index) {
+      auto &voter = voters_[index];
+      if (not voter.completed) {
+        voter.completed = true;
+        ++completed_;
+      }
+    }
+
+    /**
+     * @return the virtual time, it takes as many voters as \arg count to
+     * finalize, or the deadline, if fewer of them finalize
+     */
+    Duration finalityTime(size_t count) const {
+      std::vector<Duration> times;
+      for (const auto &voter : voters_) {
+        if (voter.finalized_at) {
+          times.push_back(*voter.finalized_at - start_);
+        }
+      }
+      if (count == 0 or times.size() < count) {
+        return kDuration * kDeadlineDurations;
+      }
+      std::nth_element(times.begin(), times.begin() + count - 1, times.end());
+      return times[count - 1];
+    }
+
+    size_t finalizedCount() const {
+      return std::count_if(voters_.begin(), voters_.end(), [](auto &voter) {
+        return voter.finalized_at.has_value();
+      });
+    }
+
+    /// number of the votes and fins handled by the voters
+    size_t messagesDelivered() const {
+      return delivered_;
+    }
+
+   private:
+    struct Voter {
+      // destroyed after the round, which leaves its timers there
+      std::shared_ptr<boost::asio::io_context> io_context;
+      std::shared_ptr<VotingRoundImpl> round;
+      boost::optional<TimePoint> finalized_at;
+      bool completed = false;
+    };
+
+    struct Event {
+      TimePoint time;
+      size_t seq;
+      size_t voter;
+      std::shared_ptr<const Payload> payload;
+      bool own;
+
+      bool operator>(const Event &other) const {
+        return std::tie(time, seq) > std::tie(other.time, other.seq);
+      }
+    };
+
+    void push(TimePoint time,
+              size_t voter,
+              std::shared_ptr<const Payload> payload,
+              bool own) {
+      events_.push({time, seq_++, voter, std::move(payload), own});
+    }
+
+    void push(TimePoint time, size_t voter, Timer timer, bool own) {
+      push(time, voter, std::make_shared<const Payload>(timer), own);
+    }
+
+    void deliver(Voter &voter, const Event &event) {
+      auto &round = *voter.round;
+      kagome::visit_in_place(
+          *event.payload,
+          [&](const SignedMessage &vote) {
+            ++delivered_;
+            if (vote.is<Prevote>()) {
+              event.own ? round.onVerifiedPrevote(vote) : round.onPrevote(vote);
+            } else if (vote.is<Precommit>()) {
+              event.own ? round.onVerifiedPrecommit(vote)
+                        : round.onPrecommit(vote);
+            } else {
+              round.onPrimaryPropose(vote);
+            }
+          },
+          [&](const Fin &fin) {
+            ++delivered_;
+            round.onFinalize(fin);
+          },
+          [&](Timer timer) {
+            // the timer is armed anew at the same time, which cancels the
+            // pending wait, so its handler runs as if the timer expired
+            if (timer == Timer::PREVOTE) {
+              round.prevote(last_round_state_);
+            } else {
+              round.precommit(last_round_state_);
+            }
+          });
+    }
+
+    std::shared_ptr<VirtualClock> clock_;
+    TimePoint start_;
+    size_t loss_percent_;
+    std::mt19937_64 random_;
+    RoundState last_round_state_;
+    std::vector<Voter> voters_;
+    std::priority_queue<Event, std::vector<Event>, std::greater<>> events_;
+    size_t seq_ = 0;
+    size_t completed_ = 0;
+    size_t delivered_ = 0;
+  };
+
+  outcome::result<void> SimEnvironment::onProposed(
+      RoundNumber, MembershipCounter, const SignedMessage &propose) {
+    simulation_.broadcast(index_, propose);
+    return outcome::success();
+  }
+
+  outcome::result<void> SimEnvironment::onPrevoted(
+      RoundNumber, MembershipCounter, const SignedMessage &prevote) {
+    simulation_.broadcast(index_, prevote);
+    return outcome::success();
+  }
+
+  outcome::result<void> SimEnvironment::onPrecommitted(
+      RoundNumber, MembershipCounter, const SignedMessage &precommit) {
+    simulation_.broadcast(index_, precommit);
+    return outcome::success();
+  }
+
+  outcome::result<void> SimEnvironment::onCommitted(
+      RoundNumber round,
+      const BlockInfo &vote,
+      const GrandpaJustification &justification) {
+    simulation_.broadcast(index_, Fin{round, vote, justification});
+    return outcome::success();
+  }
+
+  void SimEnvironment::onCompleted(outcome::result<CompletedRound>) {
+    simulation_.onCompleted(index_);
+  }
+
+  outcome::result<void> SimEnvironment::finalize(
+      const BlockHash &, const GrandpaJustification &) {
+    simulation_.onFinalized(index_);
+    return outcome::success();
+  }
+
+  double toMilliseconds(Duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+
+  /**
+   * Plays the rounds of as many voters as the first argument over the
+   * network losing as many percents of the messages as the second one, the
+   * voters track the votes with \arg tracker
+   */
+  void playRound(benchmark::State &state, Tracker tracker) {
+    auto voters_num = static_cast<size_t>(state.range(0));
+    auto loss_percent = static_cast<size_t>(state.range(1));
+    auto voters = std::make_shared<VoterSet>(0);
+    for (size_t i = 0; i < voters_num; ++i) {
+      voters->insert(makeId(i), 1);
+    }
+    // the supermajority, which finalizes the block for the network
+    auto threshold = voters_num - (voters_num - 1) / 3;
+
+    double finality_ms = 0;
+    double finality_all_ms = 0;
+    size_t unfinalized = 0;
+    size_t messages = 0;
+    auto allocations_before = benchutil::allocations();
+    auto bytes_before = benchutil::allocatedBytes();
+    uint64_t seed = 0;
+    for (auto _ : state) {
+      Simulation simulation{voters, tracker, loss_percent, seed++};
+      simulation.run();
+      finality_ms += toMilliseconds(simulation.finalityTime(threshold));
+      finality_all_ms += toMilliseconds(simulation.finalityTime(voters_num));
+      unfinalized += voters_num - simulation.finalizedCount();
+      messages += simulation.messagesDelivered();
+    }
+    auto rounds = static_cast<double>(state.iterations());
+    auto voter_rounds = rounds * voters_num;
+    state.SetItemsProcessed(messages);
+    state.counters["finality_ms"] = finality_ms / rounds;
+    state.counters["finality_all_ms"] = finality_all_ms / rounds;
+    state.counters["unfinalized"] = unfinalized / rounds;
+    state.counters["messages"] = messages / rounds;
+    state.counters["per_message"] = benchmark::Counter(
+        messages, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/voter"] =
+        (benchutil::allocations() - allocations_before) / voter_rounds;
+    state.counters["bytes/voter"] = benchmark::Counter(
+        (benchutil::allocatedBytes() - bytes_before) / voter_rounds,
+        benchmark::Counter::kDefaults,
+        benchmark::Counter::kIs1024);
+  }
+
+  void roundArgs(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgNames({"voters", "loss"})
+        ->Args({10, 0})
+        ->Args({100, 0})
+        ->Args({100, 5})
+        ->Args({300, 0})
+        ->Args({1000, 0})
+        ->Unit(benchmark::kMillisecond);
+  }
+}  // namespace
+
+BENCHMARK_CAPTURE(playRound, indexed, Tracker::INDEXED)->Apply(roundArgs);
+BENCHMARK_CAPTURE(playRound, plain, Tracker::PLAIN)->Apply(roundArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,269 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the network layer in process, without the transport: the fan-out
+ * of the gossip messages to a growing number of peers and the serving of
+ * the large blocks requests.
+ *
+ * The gossiper writes each message to the loopback streams of the peers,
+ * each of which reads it back and decodes it, as the router of a peer does,
+ * so an iteration is the latency of a broadcast and the time per message is
+ * the CPU it takes per peer. The blocks requests of the maximal size are
+ * served from a chain kept by the block storage in the memory, and the
+ * responses are written to a loopback stream and read back by the peer.
+ * Besides the messages per second, the bytes written to the streams, which
+ * are copied to and from their buffers, and the allocations made per
+ * message are reported
+ */
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/io_context.hpp>
+#include <libp2p/multi/uvarint.hpp>
+
+#include "benchmark/support/memory_usage.hpp"
+#include "blockchain/impl/key_value_block_header_repository.hpp"
+#include "blockchain/impl/key_value_block_storage.hpp"
+#include "clock/impl/basic_waitable_timer.hpp"
+#include "clock/impl/clock_impl.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/libp2p/host/host_mock.hpp"
+#include "network/helpers/scale_message_read_writer.hpp"
+#include "network/impl/gossiper_broadcast.hpp"
+#include "network/impl/loopback_stream.hpp"
+#include "network/impl/sync_protocol_observer_impl.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+
+namespace {
+  using kagome::blockchain::BlockTreeMock;
+  using kagome::blockchain::KeyValueBlockHeaderRepository;
+  using kagome::blockchain::KeyValueBlockStorage;
+  using kagome::common::Buffer;
+  using kagome::consensus::grandpa::VoteMessage;
+  using kagome::crypto::HasherImpl;
+  using kagome::network::BlockAnnounce;
+  using kagome::network::BlocksRequest;
+  using kagome::network::BlocksResponse;
+  using kagome::network::Direction;
+  using kagome::network::GossiperBroadcast;
+  using kagome::network::GossipMessage;
+  using kagome::network::LoopbackStream;
+  using kagome::network::ScaleMessageReadWriter;
+  using kagome::network::SyncProtocolObserverImpl;
+  using kagome::primitives::Block;
+  using kagome::primitives::BlockHash;
+  using kagome::primitives::BlockHeader;
+  using kagome::primitives::Extrinsic;
+
+  enum class Message { BLOCK_ANNOUNCE, VOTE };
+
+  /// size of the usual extrinsics, which are the balances transfers
+  constexpr size_t kExtrinsicSize = 150;
+
+  /// the header of a block of BABE, with its pre-digest and seal
+  BlockHeader makeHeader(kagome::primitives::BlockNumber number,
+                         const BlockHash &parent) {
+    BlockHeader header;
+    header.number = number;
+    header.parent_hash = parent;
+    header.state_root.fill(1);
+    header.extrinsics_root.fill(2);
+    kagome::primitives::PreRuntime pre_digest;
+    pre_digest.consensus_engine_id = kagome::primitives::kBabeEngineId;
+    pre_digest.data = Buffer(20, 3);
+    kagome::primitives::Seal seal;
+    seal.consensus_engine_id = kagome::primitives::kBabeEngineId;
+    seal.data = Buffer(64, 4);
+    header.digest = {pre_digest, seal};
+    return header;
+  }
+
+  VoteMessage makeVote() {
+    VoteMessage vote;
+    vote.round_number = 1000;
+    vote.counter = 10;
+    kagome::consensus::grandpa::Prevote prevote;
+    prevote.block_number = 1000;
+    prevote.block_hash.fill(5);
+    vote.vote.message = prevote;
+    vote.vote.signature.fill(6);
+    vote.vote.id.fill(7);
+    return vote;
+  }
+
+  libp2p::peer::PeerInfo makePeerInfo(size_t index) {
+    std::vector<uint8_t> key(32, 0);
+    for (size_t i = 0; i < sizeof(index); ++i) {
+      key[i] = static_cast<uint8_t>(index >> (i * 8));
+    }
+    return {libp2p::peer::PeerId::fromPublicKey(
+                libp2p::crypto::ProtobufKey{std::move(key)})
+                .value(),
+            {}};
+  }
+
+  /**
+   * A peer of the gossiper, which reads the messages of its stream as the
+   * router does
+   */
+  struct GossipPeer {
+    explicit GossipPeer(size_t index)
+        : stream{std::make_shared<LoopbackStream>(makePeerInfo(index))},
+          read_writer{std::make_shared<ScaleMessageReadWriter>(stream)} {}
+
+    /// Reads and decodes the next message, which is written already
+    void receive() {
+      read_writer->read<GossipMessage>([](auto &&msg_res) {
+        auto &msg = msg_res.value();
+        switch (msg.type) {
+          case GossipMessage::Type::BLOCK_ANNOUNCE:
+            benchmark::DoNotOptimize(
+                kagome::scale::decode<BlockAnnounce>(msg.data).value());
+            break;
+          default:
+            benchmark::DoNotOptimize(
+                kagome::scale::decode<VoteMessage>(msg.data).value());
+            break;
+        }
+      });
+    }
+
+    std::shared_ptr<LoopbackStream> stream;
+    std::shared_ptr<ScaleMessageReadWriter> read_writer;
+  };
+
+  /**
+   * Broadcasts the messages of \arg message to as many peers as the first
+   * argument
+   */
+  void broadcast(benchmark::State &state, Message message) {
+    auto peers_num = static_cast<size_t>(state.range(0));
+    boost::asio::io_context io_context;
+    testing::NiceMock<libp2p::HostMock> host;
+    auto gossiper = std::make_shared<GossiperBroadcast>(
+        host,
+        std::make_unique<kagome::clock::BasicWaitableTimer>(io_context),
+        std::make_shared<kagome::clock::SystemClockImpl>(),
+        std::make_shared<HasherImpl>());
+    std::vector<GossipPeer> peers;
+    peers.reserve(peers_num);
+    for (size_t i = 0; i < peers_num; ++i) {
+      peers.emplace_back(i);
+      gossiper->addStream(peers.back().stream);
+    }
+
+    BlockAnnounce announce{makeHeader(1000, BlockHash{}), boost::none};
+    auto vote = makeVote();
+    GossipMessage gossip;
+    gossip.data = Buffer{message == Message::BLOCK_ANNOUNCE
+                             ? kagome::scale::encode(announce).value()
+                             : kagome::scale::encode(vote).value()};
+    // the message with its length prefix, as it is written to a stream
+    auto encoded_size = kagome::scale::encode(gossip).value().size();
+    auto message_bytes =
+        libp2p::multi::UVarint{encoded_size}.toBytes().size() + encoded_size;
+
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      if (message == Message::BLOCK_ANNOUNCE) {
+        gossiper->blockAnnounce(announce);
+      } else {
+        gossiper->vote(vote);
+      }
+      for (auto &peer : peers) {
+        peer.receive();
+      }
+    }
+    auto messages = state.iterations() * peers_num;
+    state.SetItemsProcessed(messages);
+    state.SetBytesProcessed(messages * message_bytes);
+    state.counters["per_message"] = benchmark::Counter(
+        messages, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["allocs/message"] =
+        static_cast<double>(benchutil::allocations() - allocations_before)
+        / messages;
+  }
+
+  /// the chain of the blocks of a response in the storage in the memory
+  struct Chain {
+    std::shared_ptr<HasherImpl> hasher = std::make_shared<HasherImpl>();
+    std::shared_ptr<kagome::storage::InMemoryStorage> storage =
+        std::make_shared<kagome::storage::InMemoryStorage>();
+    std::shared_ptr<KeyValueBlockStorage> block_storage =
+        KeyValueBlockStorage::createWithGenesis(
+            Buffer(32, 1), storage, hasher, [](auto &) {})
+            .value();
+    std::shared_ptr<KeyValueBlockHeaderRepository> headers =
+        std::make_shared<KeyValueBlockHeaderRepository>(storage, hasher);
+    std::vector<BlockHash> hashes;
+
+    explicit Chain(size_t extrinsics_num) {
+      BlockHash parent{};
+      for (size_t number = 1;
+           number <= SyncProtocolObserverImpl::maxRequestBlocks;
+           ++number) {
+        Block block;
+        block.header = makeHeader(number, parent);
+        for (size_t i = 0; i < extrinsics_num; ++i) {
+          block.body.push_back(
+              Extrinsic{Buffer(kExtrinsicSize, static_cast<uint8_t>(i))});
+        }
+        parent = block_storage->putBlock(block).value();
+        hashes.push_back(parent);
+      }
+    }
+  };
+
+  /**
+   * Serves the requests of the maximal number of the blocks with the
+   * headers and the bodies of as many extrinsics as the first argument
+   */
+  void serveBlocks(benchmark::State &state) {
+    Chain chain{static_cast<size_t>(state.range(0))};
+    auto tree = std::make_shared<testing::NiceMock<BlockTreeMock>>();
+    ON_CALL(*tree, getChainByBlock(testing::_, testing::_, testing::_))
+        .WillByDefault(testing::Return(chain.hashes));
+    auto observer = std::make_shared<SyncProtocolObserverImpl>(
+        tree, chain.headers, chain.block_storage);
+
+    auto stream = std::make_shared<LoopbackStream>(makePeerInfo(0));
+    auto read_writer = std::make_shared<ScaleMessageReadWriter>(stream);
+    BlocksRequest request{1,
+                          BlocksRequest::kBasicAttributes,
+                          chain.hashes.front(),
+                          boost::none,
+                          Direction::DESCENDING,
+                          boost::none};
+
+    size_t bytes = 0;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto response = observer->onBlocksRequest(request).value();
+      read_writer->write(response,
+                         [&](auto &&res) { bytes += res.value(); });
+      read_writer->read<BlocksResponse>([](auto &&res) {
+        benchmark::DoNotOptimize(res.value());
+      });
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+    state.counters["allocs/request"] =
+        static_cast<double>(benchutil::allocations() - allocations_before)
+        / state.iterations();
+  }
+}  // namespace
+
+BENCHMARK_CAPTURE(broadcast, block_announce, Message::BLOCK_ANNOUNCE)
+    ->RangeMultiplier(4)
+    ->Range(1, 256);
+BENCHMARK_CAPTURE(broadcast, vote, Message::VOTE)
+    ->RangeMultiplier(4)
+    ->Range(1, 256);
+
+BENCHMARK(serveBlocks)->Arg(0)->Arg(100)->Arg(1000)->Unit(
+    benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,574 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the calls of a real runtime: Core_version, the validation of
+ * the transactions, the application of the extrinsics and the execution of
+ * the blocks, and, apart from the runtime, the host functions it imports
+ * the most, which are called right through the external interface.
+ *
+ * The runtime is the one of --runtime, the test runtime by default, on an
+ * empty state, or the one of the genesis state of the chain spec at
+ * --genesis. The blocks are read from the file at --blocks, which is written
+ * by block_import_benchmark --export, each of them is executed and its
+ * extrinsics are validated and applied on the genesis state, so the file is
+ * expected to start at the block 1 of the chain of --genesis. The benchmarks
+ * which need the blocks are skipped without them.
+ *
+ * The calls of the runtime are registered for each execution backend, the
+ * name of which is the last part of the name of the benchmark, so that the
+ * backends are compared on the same calls. The host functions are the same
+ * for all of them and are measured once
+ */
+
+#include <array>
+#include <fstream>
+#include <functional>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+
+#include "application/impl/configuration_storage_impl.hpp"
+#include "blockchain/block_header_repository.hpp"
+#include "crypto/bip39/impl/bip39_provider_impl.hpp"
+#include "crypto/crypto_store/crypto_store_impl.hpp"
+#include "crypto/ed25519/ed25519_provider_impl.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "crypto/pbkdf2/impl/pbkdf2_provider_impl.hpp"
+#include "crypto/random_generator/boost_generator.hpp"
+#include "crypto/secp256k1/secp256k1_provider_impl.hpp"
+#include "crypto/sr25519/sr25519_provider_impl.hpp"
+#include "extensions/impl/extension_factory_impl.hpp"
+#include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
+#include "runtime/binaryen/runtime_api/block_builder_impl.hpp"
+#include "runtime/binaryen/runtime_api/core_impl.hpp"
+#include "runtime/binaryen/runtime_api/tagged_transaction_queue_impl.hpp"
+#include "runtime/binaryen/runtime_external_interface.hpp"
+#include "runtime/binaryen/runtime_manager.hpp"
+#include "runtime/common/storage_wasm_provider.hpp"
+#include "runtime/common/trie_storage_provider_impl.hpp"
+#include "scale/scale.hpp"
+#include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/runtime/common/basic_wasm_provider.hpp"
+
+namespace {
+  using kagome::blockchain::BlockHeaderRepository;
+  using kagome::blockchain::BlockStatus;
+  using kagome::common::Buffer;
+  using kagome::common::Hash256;
+  using kagome::extensions::ExtensionFactory;
+  using kagome::primitives::Block;
+  using kagome::primitives::BlockHeader;
+  using kagome::primitives::BlockId;
+  using kagome::primitives::BlockNumber;
+  using kagome::runtime::TrieStorageProvider;
+  using kagome::runtime::WasmMemory;
+  using kagome::runtime::WasmModuleFactory;
+  using kagome::runtime::WasmPointer;
+  using kagome::runtime::WasmSize;
+  using kagome::runtime::binaryen::BlockBuilderImpl;
+  using kagome::runtime::binaryen::CoreImpl;
+  using kagome::runtime::binaryen::RuntimeExternalInterface;
+  using kagome::runtime::binaryen::RuntimeManager;
+  using kagome::runtime::binaryen::TaggedTransactionQueueImpl;
+  using kagome::storage::trie::TrieStorage;
+
+  /// the engines the runtime code is executed with
+  enum class Backend { BINARYEN };
+
+  constexpr std::array kBackends{Backend::BINARYEN};
+
+  const char *backendName(Backend backend) {
+    switch (backend) {
+      case Backend::BINARYEN:
+        return "binaryen";
+    }
+    return "unknown";
+  }
+
+  struct Params {
+    std::string runtime;
+    std::string genesis;
+    std::string blocks;
+  };
+
+  Params params;
+
+  /**
+   * The headers of the fixture: every block is a child of the genesis one,
+   * as all of the blocks are executed on the genesis state
+   */
+  class FixtureHeaders : public BlockHeaderRepository {
+   public:
+    explicit FixtureHeaders(BlockHeader genesis)
+        : genesis_{std::move(genesis)} {}
+
+    outcome::result<BlockNumber> getNumberByHash(
+        const Hash256 &) const override {
+      return genesis_.number;
+    }
+
+    outcome::result<Hash256> getHashByNumber(
+        const BlockNumber &) const override {
+      return Hash256{};
+    }
+
+    outcome::result<BlockHeader> getBlockHeader(
+        const BlockId &) const override {
+      return genesis_;
+    }
+
+    outcome::result<BlockStatus> getBlockStatus(
+        const BlockId &) const override {
+      return BlockStatus::InChain;
+    }
+
+   private:
+    BlockHeader genesis_;
+  };
+
+  /// @return the blocks of the file, written as block_import_benchmark does
+  std::vector<Block> readBlocks(const std::string &path) {
+    std::vector<Block> blocks;
+    std::ifstream file{path, std::ios::binary};
+    std::array<unsigned char, 4> size_bytes{};
+    while (file.read(reinterpret_cast<char *>(size_bytes.data()),
+                     size_bytes.size())) {
+      size_t size = 0;
+      for (size_t i = 0; i < size_bytes.size(); ++i) {
+        size |= static_cast<size_t>(size_bytes[i]) << (i * 8);
+      }
+      std::vector<uint8_t> encoded(size);
+      if (not file.read(reinterpret_cast<char *>(encoded.data()),
+                        static_cast<std::streamsize>(size))) {
+        throw std::runtime_error{"the file of the blocks is truncated"};
+      }
+      blocks.emplace_back(kagome::scale::decode<Block>(encoded).value());
+    }
+    return blocks;
+  }
+
+  /// the crypto of the host functions, which are the real ones
+  struct Crypto {
+    std::shared_ptr<kagome::crypto::BoostRandomGenerator> random =
+        std::make_shared<kagome::crypto::BoostRandomGenerator>();
+    std::shared_ptr<kagome::crypto::SR25519ProviderImpl> sr25519 =
+        std::make_shared<kagome::crypto::SR25519ProviderImpl>(random);
+    std::shared_ptr<kagome::crypto::ED25519ProviderImpl> ed25519 =
+        std::make_shared<kagome::crypto::ED25519ProviderImpl>();
+    std::shared_ptr<kagome::crypto::Secp256k1ProviderImpl> secp256k1 =
+        std::make_shared<kagome::crypto::Secp256k1ProviderImpl>();
+    std::shared_ptr<kagome::crypto::HasherImpl> hasher =
+        std::make_shared<kagome::crypto::HasherImpl>();
+    std::shared_ptr<kagome::crypto::Bip39ProviderImpl> bip39 =
+        std::make_shared<kagome::crypto::Bip39ProviderImpl>(
+            std::make_shared<kagome::crypto::Pbkdf2ProviderImpl>());
+    std::shared_ptr<kagome::crypto::CryptoStoreImpl> store =
+        std::make_shared<kagome::crypto::CryptoStoreImpl>(
+            ed25519, sr25519, secp256k1, bip39, random);
+  };
+
+  /**
+   * The state in the memory, the genesis one of --genesis or an empty one,
+   * and the runtime APIs on it
+   */
+  struct Fixture {
+    Crypto crypto;
+    std::shared_ptr<TrieStorage> trie_storage;
+    std::shared_ptr<TrieStorageProvider> storage_provider;
+    std::shared_ptr<kagome::storage::changes_trie::StorageChangesTrackerImpl>
+        changes_tracker = std::make_shared<
+            kagome::storage::changes_trie::StorageChangesTrackerImpl>();
+    std::shared_ptr<ExtensionFactory> extension_factory =
+        std::make_shared<kagome::extensions::ExtensionFactoryImpl>(
+            changes_tracker,
+            crypto.sr25519,
+            crypto.ed25519,
+            crypto.secp256k1,
+            crypto.hasher,
+            crypto.store,
+            crypto.bip39);
+    std::shared_ptr<RuntimeManager> runtime_manager;
+    std::shared_ptr<CoreImpl> core;
+    std::shared_ptr<TaggedTransactionQueueImpl> tx_queue;
+    std::shared_ptr<BlockBuilderImpl> block_builder;
+    std::vector<Block> blocks;
+
+    explicit Fixture(Backend backend) {
+      auto trie_factory =
+          std::make_shared<kagome::storage::trie::PolkadotTrieFactoryImpl>();
+      auto codec = std::make_shared<kagome::storage::trie::PolkadotCodec>();
+      auto serializer =
+          std::make_shared<kagome::storage::trie::TrieSerializerImpl>(
+              trie_factory,
+              codec,
+              std::make_shared<kagome::storage::trie::TrieStorageBackendImpl>(
+                  std::make_shared<kagome::storage::InMemoryStorage>(),
+                  Buffer{}),
+              std::make_shared<kagome::storage::trie::TrieNodeCache>(0));
+      trie_storage = kagome::storage::trie::TrieStorageImpl::createEmpty(
+                         trie_factory, codec, serializer, boost::none)
+                         .value();
+      storage_provider =
+          std::make_shared<kagome::runtime::TrieStorageProviderImpl>(
+              trie_storage);
+
+      std::shared_ptr<kagome::runtime::WasmProvider> wasm_provider;
+      if (params.genesis.empty()) {
+        wasm_provider =
+            std::make_shared<kagome::runtime::BasicWasmProvider>(
+                params.runtime);
+      } else {
+        auto config =
+            kagome::application::ConfigurationStorageImpl::create(
+                params.genesis)
+                .value();
+        auto batch = trie_storage->getPersistentBatch().value();
+        config
+            ->visitGenesis([&](auto key, auto value) {
+              return batch->put(Buffer{key}, Buffer{value});
+            })
+            .value();
+        batch->commit().value();
+        wasm_provider =
+            std::make_shared<kagome::runtime::StorageWasmProvider>(
+                trie_storage);
+      }
+
+      BlockHeader genesis;
+      genesis.state_root =
+          Hash256::fromSpan(trie_storage->getRootHash()).value();
+      auto header_repo = std::make_shared<FixtureHeaders>(genesis);
+
+      runtime_manager =
+          std::make_shared<RuntimeManager>(wasm_provider,
+                                           extension_factory,
+                                           makeModuleFactory(backend),
+                                           storage_provider,
+                                           trie_storage);
+      core = std::make_shared<CoreImpl>(
+          runtime_manager, changes_tracker, header_repo);
+      tx_queue = std::make_shared<TaggedTransactionQueueImpl>(runtime_manager);
+      block_builder = std::make_shared<BlockBuilderImpl>(runtime_manager);
+
+      if (not params.blocks.empty()) {
+        blocks = readBlocks(params.blocks);
+      }
+    }
+
+    static std::shared_ptr<WasmModuleFactory> makeModuleFactory(
+        Backend backend) {
+      switch (backend) {
+        case Backend::BINARYEN:
+          return std::make_shared<
+              kagome::runtime::binaryen::WasmModuleFactoryImpl>();
+      }
+      throw std::invalid_argument{"unknown backend"};
+    }
+  };
+
+  /// the fixture of the last benchmark is kept, as making it takes a while
+  Fixture &fixture(Backend backend) {
+    static boost::optional<Backend> cached_backend;
+    static std::unique_ptr<Fixture> cached;
+    if (cached == nullptr or cached_backend != backend) {
+      cached.reset();
+      cached = std::make_unique<Fixture>(backend);
+      cached_backend = backend;
+    }
+    return *cached;
+  }
+
+  /// @return false and skips \arg state if there are no blocks to run
+  bool hasBlocks(benchmark::State &state, const Fixture &fixture) {
+    if (fixture.blocks.empty()) {
+      state.SkipWithError("no blocks, see --blocks");
+      return false;
+    }
+    return true;
+  }
+
+  void coreVersion(benchmark::State &state, Backend backend) {
+    auto &f = fixture(backend);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(f.core->version(boost::none).value());
+    }
+  }
+
+  void validateTransaction(benchmark::State &state, Backend backend) {
+    auto &f = fixture(backend);
+    if (not hasBlocks(state, f)) {
+      return;
+    }
+    size_t extrinsics = 0;
+    for (auto _ : state) {
+      for (auto &block : f.blocks) {
+        for (auto &ext : block.body) {
+          // the inherents are invalid as transactions, but their
+          // validation takes as long as a call can take
+          benchmark::DoNotOptimize(f.tx_queue->validate_transaction(ext));
+          ++extrinsics;
+        }
+      }
+    }
+    state.counters["extrinsics/s"] =
+        benchmark::Counter(extrinsics, benchmark::Counter::kIsRate);
+  }
+
+  void applyExtrinsic(benchmark::State &state, Backend backend) {
+    auto &f = fixture(backend);
+    if (not hasBlocks(state, f)) {
+      return;
+    }
+    size_t extrinsics = 0;
+    for (auto _ : state) {
+      for (auto &block : f.blocks) {
+        state.PauseTiming();
+        f.core->initialise_block(block.header).value();
+        state.ResumeTiming();
+        for (auto &ext : block.body) {
+          benchmark::DoNotOptimize(f.block_builder->apply_extrinsic(ext));
+          ++extrinsics;
+        }
+      }
+    }
+    state.counters["extrinsics/s"] =
+        benchmark::Counter(extrinsics, benchmark::Counter::kIsRate);
+  }
+
+  void executeBlock(benchmark::State &state, Backend backend) {
+    auto &f = fixture(backend);
+    if (not hasBlocks(state, f)) {
+      return;
+    }
+    size_t blocks = 0;
+    for (auto _ : state) {
+      for (auto &block : f.blocks) {
+        auto res = f.core->execute_block(block);
+        if (not res) {
+          state.SkipWithError(res.error().message().c_str());
+          return;
+        }
+        ++blocks;
+      }
+    }
+    state.counters["blocks/s"] =
+        benchmark::Counter(blocks, benchmark::Counter::kIsRate);
+  }
+
+  /**
+   * A host function called through the external interface with the
+   * arguments, which are put to the memory once
+   */
+  struct HostCall {
+    const char *name;
+    std::function<wasm::LiteralList(WasmMemory &memory, Crypto &crypto)>
+        make_args;
+    /// the pointer the function returns is allocated and freed after it
+    bool returns_allocation = false;
+  };
+
+  /// the size of the data hashed, as big as a key of a map
+  constexpr WasmSize kHashedSize = 64;
+
+  /// the size of the values stored
+  constexpr WasmSize kValueSize = 80;
+
+  WasmPointer storeBytes(WasmMemory &memory, WasmSize size, uint8_t byte) {
+    auto ptr = memory.allocate(size);
+    memory.storeBuffer(ptr, Buffer(size, byte));
+    return ptr;
+  }
+
+  wasm::LiteralList hashArgs(WasmMemory &memory, Crypto &) {
+    return {wasm::Literal(storeBytes(memory, kHashedSize, 1)),
+            wasm::Literal(kHashedSize),
+            wasm::Literal(memory.allocate(32))};
+  }
+
+  /// the key, which is set before, and the value
+  wasm::LiteralList keyValueArgs(WasmMemory &memory, Crypto &) {
+    auto key = storeBytes(memory, kHashedSize, 2);
+    auto value = storeBytes(memory, kValueSize, 3);
+    return {wasm::Literal(key),
+            wasm::Literal(kHashedSize),
+            wasm::Literal(value),
+            wasm::Literal(kValueSize)};
+  }
+
+  wasm::LiteralList keyArgs(WasmMemory &memory, Crypto &crypto) {
+    auto args = keyValueArgs(memory, crypto);
+    return {args.at(0), args.at(1)};
+  }
+
+  wasm::LiteralList getStorageArgs(WasmMemory &memory, Crypto &crypto) {
+    auto args = keyArgs(memory, crypto);
+    args.push_back(wasm::Literal(memory.allocate(sizeof(WasmSize))));
+    return args;
+  }
+
+  /// the message, its signature and the public key
+  wasm::LiteralList verifyArgs(WasmMemory &memory,
+                               const Buffer &public_key,
+                               const Buffer &signature) {
+    auto message = storeBytes(memory, kHashedSize, 1);
+    auto sig = memory.allocate(signature.size());
+    memory.storeBuffer(sig, signature);
+    auto pub = memory.allocate(public_key.size());
+    memory.storeBuffer(pub, public_key);
+    return {wasm::Literal(message),
+            wasm::Literal(kHashedSize),
+            wasm::Literal(sig),
+            wasm::Literal(pub)};
+  }
+
+  wasm::LiteralList ed25519VerifyArgs(WasmMemory &memory, Crypto &crypto) {
+    auto keypair = crypto.ed25519->generateKeypair().value();
+    auto signature =
+        crypto.ed25519->sign(keypair, Buffer(kHashedSize, 1)).value();
+    return verifyArgs(
+        memory, Buffer{keypair.public_key}, Buffer{signature});
+  }
+
+  wasm::LiteralList sr25519VerifyArgs(WasmMemory &memory, Crypto &crypto) {
+    auto keypair = crypto.sr25519->generateKeypair();
+    auto signature =
+        crypto.sr25519->sign(keypair, Buffer(kHashedSize, 1)).value();
+    return verifyArgs(
+        memory, Buffer{keypair.public_key}, Buffer{signature});
+  }
+
+  const std::vector<HostCall> &hostCalls() {
+    static const std::vector<HostCall> calls{
+        {"ext_blake2_128", hashArgs},
+        {"ext_blake2_256", hashArgs},
+        {"ext_keccak_256", hashArgs},
+        {"ext_twox_64", hashArgs},
+        {"ext_twox_128", hashArgs},
+        {"ext_twox_256", hashArgs},
+        {"ext_set_storage", keyValueArgs},
+        {"ext_exists_storage", keyArgs},
+        {"ext_get_allocated_storage", getStorageArgs, true},
+        {"ext_clear_storage", keyArgs},
+        {"ext_storage_root",
+         [](WasmMemory &memory, Crypto &) -> wasm::LiteralList {
+           return {wasm::Literal(memory.allocate(32))};
+         }},
+        {"ext_malloc",
+         [](WasmMemory &, Crypto &) -> wasm::LiteralList {
+           return {wasm::Literal(kValueSize)};
+         },
+         true},
+        {"ext_ed25519_verify", ed25519VerifyArgs},
+        {"ext_sr25519_verify", sr25519VerifyArgs},
+    };
+    return calls;
+  }
+
+  /**
+   * Calls the host function of \arg call right through the external
+   * interface of Binaryen on the state of the fixture, which is made
+   * ephemeral, so that the writes do not pile up. The storage functions
+   * are called on a key, which is set beforehand
+   */
+  void hostFunction(benchmark::State &state, const HostCall &call) {
+    auto &f = fixture(Backend::BINARYEN);
+    f.storage_provider->setToEphemeral().value();
+    RuntimeExternalInterface rei{f.extension_factory, f.storage_provider};
+    auto &memory = *rei.memory();
+
+    wasm::Function set_storage;
+    set_storage.module = "env";
+    set_storage.base = "ext_set_storage";
+    auto set_args = keyValueArgs(memory, f.crypto);
+    rei.callImport(&set_storage, set_args);
+
+    wasm::Function import;
+    import.module = "env";
+    import.base = call.name;
+    auto args = call.make_args(memory, f.crypto);
+    for (auto _ : state) {
+      auto res = rei.callImport(&import, args);
+      if (call.returns_allocation) {
+        memory.deallocate(res.geti32());
+      }
+      benchmark::DoNotOptimize(res);
+    }
+  }
+
+  void registerBenchmarks() {
+    for (auto backend : kBackends) {
+      auto name = [&](const std::string &call) {
+        return call + "/" + backendName(backend);
+      };
+      benchmark::RegisterBenchmark(
+          name("Core_version").c_str(), coreVersion, backend)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(
+          name("validate_transaction").c_str(), validateTransaction, backend)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(
+          name("apply_extrinsic").c_str(), applyExtrinsic, backend)
+          ->Unit(benchmark::kMillisecond);
+      benchmark::RegisterBenchmark(
+          name("execute_block").c_str(), executeBlock, backend)
+          ->Unit(benchmark::kMillisecond);
+    }
+    // the host functions are the same for the backends, which only call
+    // them differently, so they are measured apart from the calls
+    for (auto &call : hostCalls()) {
+      benchmark::RegisterBenchmark(
+          (std::string{"host/"} + call.name).c_str(), hostFunction, call);
+    }
+  }
+
+  /**
+   * Takes the options of the fixture out of the arguments, the rest of them
+   * are the ones of the benchmark library
+   */
+  void parseParams(int &argc, char **argv) {
+    params.runtime =
+        (boost::filesystem::path(__FILE__).parent_path()
+         / "../../core/runtime/wasm/polkadot_runtime.compact.wasm")
+            .string();
+    auto take = [](std::string_view arg, std::string_view flag,
+                   std::string &value) {
+      if (arg.substr(0, flag.size()) != flag) {
+        return false;
+      }
+      value = std::string{arg.substr(flag.size())};
+      return true;
+    };
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+      std::string_view arg{argv[i]};
+      if (not take(arg, "--runtime=", params.runtime)
+          and not take(arg, "--genesis=", params.genesis)
+          and not take(arg, "--blocks=", params.blocks)) {
+        argv[kept++] = argv[i];
+      }
+    }
+    argc = kept;
+  }
+}  // namespace
+
+int main(int argc, char **argv) {
+  parseParams(argc, argv);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return EXIT_FAILURE;
+  }
+  registerBenchmarks();
+  benchmark::RunSpecifiedBenchmarks();
+  return EXIT_SUCCESS;
+}
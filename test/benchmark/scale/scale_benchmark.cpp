@@ -0,0 +1,222 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the encoding and the decoding of the SCALE codec on the values the
+ * node exchanges most: the compact integers, the byte vectors, the headers,
+ * the blocks, the responses to the block requests and the GRANDPA messages.
+ *
+ * Besides the time, the throughput of the encoded bytes and the number of the
+ * allocations made per operation are reported, as most of the cost of the
+ * codec is in copying and allocating, so that a change of either shows up
+ */
+
+#include <type_traits>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark/support/memory_usage.hpp"
+#include "consensus/grandpa/structs.hpp"
+#include "network/types/blocks_response.hpp"
+#include "primitives/block.hpp"
+#include "scale/scale.hpp"
+
+namespace {
+  using kagome::common::Buffer;
+  using kagome::common::Hash256;
+  using kagome::consensus::grandpa::Fin;
+  using kagome::consensus::grandpa::GrandpaJustification;
+  using kagome::consensus::grandpa::Precommit;
+  using kagome::consensus::grandpa::Prevote;
+  using kagome::consensus::grandpa::SignedMessage;
+  using kagome::consensus::grandpa::VoteMessage;
+  using kagome::network::BlocksResponse;
+  using kagome::primitives::Block;
+  using kagome::primitives::BlockData;
+  using kagome::primitives::BlockHeader;
+  using kagome::primitives::Extrinsic;
+  using kagome::primitives::Justification;
+  using kagome::primitives::kBabeEngineId;
+  using kagome::primitives::PreRuntime;
+  using kagome::primitives::Seal;
+  using kagome::scale::CompactInteger;
+
+  /// size of the usual extrinsics, which are the balances transfers
+  constexpr size_t kExtrinsicSize = 150;
+
+  /// \arg size bytes, which are not all the same
+  Buffer makeBytes(size_t size) {
+    Buffer bytes(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return bytes;
+  }
+
+  Hash256 makeHash(uint8_t seed) {
+    Hash256 hash;
+    for (size_t i = 0; i < hash.size(); ++i) {
+      hash[i] = static_cast<uint8_t>(seed + i);
+    }
+    return hash;
+  }
+
+  /// the largest integer of \arg bits, which takes the most bytes of them
+  CompactInteger makeCompact(int64_t bits) {
+    return (CompactInteger{1} << bits) - 1;
+  }
+
+  /// header of a BABE block, with its pre-runtime digest and its seal
+  BlockHeader makeHeader() {
+    BlockHeader header;
+    header.parent_hash = makeHash(1);
+    header.number = 1'000'000;
+    header.state_root = makeHash(2);
+    header.extrinsics_root = makeHash(3);
+    header.digest.emplace_back(PreRuntime{{kBabeEngineId, makeBytes(20)}});
+    header.digest.emplace_back(Seal{{kBabeEngineId, makeBytes(64)}});
+    return header;
+  }
+
+  Block makeBlock(int64_t extrinsics) {
+    Block block{makeHeader(), {}};
+    for (int64_t i = 0; i < extrinsics; ++i) {
+      block.body.push_back(Extrinsic{makeBytes(kExtrinsicSize)});
+    }
+    return block;
+  }
+
+  /// response of \arg blocks blocks of 100 extrinsics each, as the syncing
+  /// gets them
+  BlocksResponse makeBlocksResponse(int64_t blocks) {
+    BlocksResponse response{42, {}};
+    for (int64_t i = 0; i < blocks; ++i) {
+      auto block = makeBlock(100);
+      BlockData data{makeHash(i)};
+      data.header = std::move(block.header);
+      data.body = std::move(block.body);
+      data.justification = Justification{makeBytes(200)};
+      response.blocks.push_back(std::move(data));
+    }
+    return response;
+  }
+
+  SignedMessage makeSigned(kagome::consensus::grandpa::Vote vote) {
+    SignedMessage message{std::move(vote), {}, {}};
+    message.signature.fill(0x5a);
+    message.id.fill(0xa5);
+    return message;
+  }
+
+  VoteMessage makeVoteMessage() {
+    return VoteMessage{7, 1, makeSigned(Prevote{1'000'000, makeHash(4)})};
+  }
+
+  /// finalizing message, justified by the precommits of \arg voters voters
+  Fin makeFin(int64_t voters) {
+    Fin fin{7, {1'000'000, makeHash(4)}, GrandpaJustification{7, {}}};
+    for (int64_t i = 0; i < voters; ++i) {
+      fin.justification.items.push_back(
+          makeSigned(Precommit{1'000'000, makeHash(4)}));
+    }
+    return fin;
+  }
+
+  /**
+   * Reports the throughput of the \arg encoded_size bytes, which are encoded
+   * or decoded in each iteration of \arg state, and the allocations made
+   * since \arg allocations_before per iteration
+   */
+  void report(benchmark::State &state,
+              size_t encoded_size,
+              size_t allocations_before) {
+    auto allocated = benchutil::allocations() - allocations_before;
+    state.SetBytesProcessed(state.iterations() * encoded_size);
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(allocated), benchmark::Counter::kAvgIterations);
+    state.counters["bytes"] = static_cast<double>(encoded_size);
+  }
+
+  /// the value \arg make makes of the argument of \arg state, if it takes one
+  template <typename Make>
+  auto makeValue(const benchmark::State &state, Make make) {
+    if constexpr (std::is_invocable_v<Make>) {
+      return make();
+    } else {
+      return make(state.range(0));
+    }
+  }
+
+  /// encodes the value \arg make makes of the argument of the benchmark
+  template <typename Make>
+  void encode(benchmark::State &state, Make make) {
+    auto value = makeValue(state, make);
+    auto encoded_size = kagome::scale::encode(value).value().size();
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto encoded = kagome::scale::encode(value).value();
+      benchmark::DoNotOptimize(encoded.data());
+    }
+    report(state, encoded_size, allocations_before);
+  }
+
+  /// decodes the value \arg make makes of the argument of the benchmark
+  template <typename Make>
+  void decode(benchmark::State &state, Make make) {
+    auto value = makeValue(state, make);
+    auto encoded = kagome::scale::encode(value).value();
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto decoded = kagome::scale::decode<decltype(value)>(encoded).value();
+      benchmark::DoNotOptimize(decoded);
+    }
+    report(state, encoded.size(), allocations_before);
+  }
+}  // namespace
+
+// the integers of 1, 2, 4 bytes and the big ones
+BENCHMARK_CAPTURE(encode, compact, makeCompact)
+    ->Arg(6)
+    ->Arg(14)
+    ->Arg(30)
+    ->Arg(64)
+    ->Arg(128);
+BENCHMARK_CAPTURE(decode, compact, makeCompact)
+    ->Arg(6)
+    ->Arg(14)
+    ->Arg(30)
+    ->Arg(64)
+    ->Arg(128);
+
+BENCHMARK_CAPTURE(encode, bytes, makeBytes)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(decode, bytes, makeBytes)
+    ->RangeMultiplier(16)
+    ->Range(16, 1 << 20);
+
+BENCHMARK_CAPTURE(encode, header, makeHeader);
+BENCHMARK_CAPTURE(decode, header, makeHeader);
+
+// the number of the extrinsics
+BENCHMARK_CAPTURE(encode, block, makeBlock)->Arg(0)->Arg(10)->Arg(1000);
+BENCHMARK_CAPTURE(decode, block, makeBlock)->Arg(0)->Arg(10)->Arg(1000);
+
+// the number of the blocks
+BENCHMARK_CAPTURE(encode, blocks_response, makeBlocksResponse)
+    ->Arg(1)
+    ->Arg(64);
+BENCHMARK_CAPTURE(decode, blocks_response, makeBlocksResponse)
+    ->Arg(1)
+    ->Arg(64);
+
+BENCHMARK_CAPTURE(encode, vote_message, makeVoteMessage);
+BENCHMARK_CAPTURE(decode, vote_message, makeVoteMessage);
+
+// the number of the voters
+BENCHMARK_CAPTURE(encode, fin, makeFin)->Arg(4)->Arg(100);
+BENCHMARK_CAPTURE(decode, fin, makeFin)->Arg(4)->Arg(100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,46 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "benchmark/support/memory_usage.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  /// number of the allocations made by the process, \see operator new
+  std::atomic<size_t> allocations_num{0};
+  /// number of the bytes allocated by the process, \see operator new
+  std::atomic<size_t> allocated_bytes{0};
+}  // namespace
+
+void *operator new(size_t size) {
+  allocations_num.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace benchutil {
+
+  size_t allocations() {
+    return allocations_num.load(std::memory_order_relaxed);
+  }
+
+  size_t allocatedBytes() {
+    return allocated_bytes.load(std::memory_order_relaxed);
+  }
+
+}  // namespace benchutil
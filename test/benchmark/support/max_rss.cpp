@@ -0,0 +1,18 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "benchmark/support/memory_usage.hpp"
+
+#include <sys/resource.h>
+
+namespace benchutil {
+
+  long maxRss() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+  }
+
+}  // namespace benchutil
@@ -0,0 +1,33 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_BENCHMARK_SUPPORT_MEMORY_USAGE_HPP
+#define KAGOME_TEST_BENCHMARK_SUPPORT_MEMORY_USAGE_HPP
+
+#include <cstddef>
+
+namespace benchutil {
+
+  /**
+   * @return number of the allocations made by the process so far. A
+   * benchmark reading it gets the global operator new of the library, which
+   * counts the allocations
+   */
+  size_t allocations();
+
+  /**
+   * @return number of the bytes allocated by the process so far, \see
+   * allocations
+   */
+  size_t allocatedBytes();
+
+  /**
+   * @return peak resident memory of the process in KiB
+   */
+  long maxRss();
+
+}  // namespace benchutil
+
+#endif  // KAGOME_TEST_BENCHMARK_SUPPORT_MEMORY_USAGE_HPP
@@ -0,0 +1,379 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the throughput of the transaction pool under a synthetic load.
+ * The transactions are the ones of a number of accounts, each of which makes
+ * a chain of them by its nonces, like the balances transfers do, so that a
+ * transaction requires the tag its predecessor provides. They are submitted
+ * partially out of order, so some of them wait for their predecessors, then
+ * the blocks are built of the ready ones, which are removed from the pool
+ * along with the tags they provide, so their successors are revalidated,
+ * and the stale ones are pruned as the blocks go.
+ *
+ * For each of the operations, the number of calls per second, the
+ * percentiles of their latencies and the memory of the process are reported
+ * in a stable format, so that the runs before and after a change of the pool
+ * are compared line by line
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+#include <boost/program_options.hpp>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include "benchmark/support/memory_usage.hpp"
+#include "blockchain/block_tree_error.hpp"
+#include "clock/impl/clock_impl.hpp"
+#include "transaction_pool/impl/pool_moderator_impl.hpp"
+#include "transaction_pool/impl/transaction_pool_impl.hpp"
+
+namespace {
+  using kagome::blockchain::BlockHeaderRepository;
+  using kagome::blockchain::BlockStatus;
+  using kagome::blockchain::BlockTreeError;
+  using kagome::common::Hash256;
+  using kagome::primitives::BlockHeader;
+  using kagome::primitives::BlockId;
+  using kagome::primitives::BlockNumber;
+  using kagome::primitives::Transaction;
+  using kagome::transaction_pool::PoolModeratorImpl;
+  using kagome::transaction_pool::TransactionPool;
+  using kagome::transaction_pool::TransactionPoolImpl;
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Params {
+    size_t transactions;
+    size_t chain_length;
+    size_t block_size;
+    size_t reorder_window;
+    size_t max_longevity;
+    uint32_t seed;
+  };
+
+  /**
+   * The pool resolves only the block numbers to the ones they are, which is
+   * all the stale transactions pruning needs
+   */
+  class NumbersOnlyHeaderRepository : public BlockHeaderRepository {
+   public:
+    outcome::result<BlockNumber> getNumberByHash(
+        const Hash256 &) const override {
+      return BlockTreeError::NO_SUCH_BLOCK;
+    }
+
+    outcome::result<Hash256> getHashByNumber(
+        const BlockNumber &) const override {
+      return BlockTreeError::NO_SUCH_BLOCK;
+    }
+
+    outcome::result<BlockHeader> getBlockHeader(
+        const BlockId &) const override {
+      return BlockTreeError::NO_SUCH_BLOCK;
+    }
+
+    outcome::result<BlockStatus> getBlockStatus(
+        const BlockId &) const override {
+      return BlockTreeError::NO_SUCH_BLOCK;
+    }
+  };
+
+  /**
+   * Latencies of the calls of an operation
+   */
+  class Measurement {
+   public:
+    explicit Measurement(std::string name) : name_{std::move(name)} {}
+
+    /**
+     * Calls \arg f and records how long it took
+     * @return the result of \arg f
+     */
+    template <typename F>
+    auto measure(F &&f) {
+      auto start = Clock::now();
+      if constexpr (std::is_void_v<decltype(f())>) {
+        f();
+        latencies_.push_back(Clock::now() - start);
+      } else {
+        auto result = f();
+        latencies_.push_back(Clock::now() - start);
+        return result;
+      }
+    }
+
+    void report() {
+      if (latencies_.empty()) {
+        fmt::print("{:<16} no calls\n", name_);
+        return;
+      }
+      std::sort(latencies_.begin(), latencies_.end());
+      Clock::duration total{};
+      for (auto &latency : latencies_) {
+        total += latency;
+      }
+      auto percentile = [this](double p) {
+        auto index = static_cast<size_t>(p * (latencies_.size() - 1));
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   latencies_[index])
+            .count();
+      };
+      auto seconds = std::chrono::duration<double>(total).count();
+      fmt::print(
+          "{:<16} calls {:>9} ops/s {:>12.0f} p50 {:>9}ns p90 {:>9}ns "
+          "p99 {:>9}ns max {:>11}ns\n",
+          name_,
+          latencies_.size(),
+          seconds > 0 ? latencies_.size() / seconds : 0.,
+          percentile(0.5),
+          percentile(0.9),
+          percentile(0.99),
+          percentile(1.));
+    }
+
+   private:
+    std::string name_;
+    std::vector<Clock::duration> latencies_;
+  };
+
+  /// tag of the \arg nonce transaction of \arg account
+  Transaction::Tag makeTag(size_t account, size_t nonce) {
+    Transaction::Tag tag(16);
+    for (size_t i = 0; i < 8; ++i) {
+      tag[i] = static_cast<uint8_t>(account >> (i * 8));
+      tag[i + 8] = static_cast<uint8_t>(nonce >> (i * 8));
+    }
+    return tag;
+  }
+
+  /**
+   * Makes the transactions of the accounts, the \arg nonce one of \arg
+   * account is at nonce * accounts + account, and its hash is that index
+   */
+  std::vector<Transaction> makeTransactions(const Params &params,
+                                            size_t accounts,
+                                            std::mt19937_64 &rng) {
+    std::uniform_int_distribution<Transaction::Priority> priority(1, 1000);
+    std::uniform_int_distribution<Transaction::Longevity> longevity(
+        1, params.max_longevity);
+    // the sizes of the transfers and the rest of the usual extrinsics
+    std::uniform_int_distribution<size_t> size(100, 300);
+
+    std::vector<Transaction> txs(params.transactions);
+    for (size_t i = 0; i < txs.size(); ++i) {
+      auto account = i % accounts;
+      auto nonce = i / accounts;
+      auto &tx = txs[i];
+      tx.ext.data.resize(size(rng));
+      for (size_t byte = 0; byte < 8; ++byte) {
+        tx.hash[byte] = static_cast<uint8_t>(i >> (byte * 8));
+        tx.ext.data[byte] = tx.hash[byte];
+      }
+      tx.bytes = tx.ext.data.size();
+      tx.priority = priority(rng);
+      tx.valid_till = longevity(rng);
+      if (nonce > 0) {
+        tx.requires.push_back(makeTag(account, nonce - 1));
+      }
+      tx.provides.push_back(makeTag(account, nonce));
+      tx.should_propagate = true;
+    }
+    return txs;
+  }
+
+  /// index of the transaction with \arg hash, \see makeTransactions()
+  size_t indexOf(const Transaction::Hash &hash) {
+    size_t index = 0;
+    for (size_t byte = 0; byte < 8; ++byte) {
+      index |= static_cast<size_t>(hash[byte]) << (byte * 8);
+    }
+    return index;
+  }
+
+  /**
+   * @return the indices of the transactions in the order they are
+   * submitted: the chains of the accounts are interleaved, and each
+   * transaction is shuffled within a window of the ones next to it, so it
+   * may come before its predecessor
+   */
+  std::vector<size_t> makeSubmissionOrder(const Params &params,
+                                          std::mt19937_64 &rng) {
+    std::vector<size_t> order(params.transactions);
+    std::iota(order.begin(), order.end(), 0);
+    if (params.reorder_window > 1) {
+      for (size_t i = 0; i < order.size(); i += params.reorder_window) {
+        auto end = std::min(i + params.reorder_window, order.size());
+        std::shuffle(order.begin() + i, order.begin() + end, rng);
+      }
+    }
+    return order;
+  }
+
+  void run(const Params &params) {
+    std::mt19937_64 rng{params.seed};
+    auto accounts = (params.transactions + params.chain_length - 1)
+                    / params.chain_length;
+    auto txs = makeTransactions(params, accounts, rng);
+    auto order = makeSubmissionOrder(params, rng);
+    auto rss_before = benchutil::maxRss();
+
+    // the pool is not to evict anything, so that the same transactions are
+    // there whatever it is changed to
+    TransactionPool::Limits limits;
+    limits.capacity = params.transactions;
+    limits.max_ready_num = params.transactions;
+    limits.max_bytes = std::numeric_limits<size_t>::max();
+    TransactionPoolImpl pool{
+        std::make_unique<PoolModeratorImpl>(
+            std::make_shared<kagome::clock::SystemClockImpl>(),
+            PoolModeratorImpl::Params{}),
+        std::make_shared<NumbersOnlyHeaderRepository>(),
+        limits};
+
+    Measurement submit{"submitOne"};
+    Measurement get_ready{"getReady"};
+    Measurement iterate{"ready.next"};
+    Measurement remove{"removeOne"};
+    Measurement remove_stale{"removeStale"};
+    Measurement revalidate{"revalidated"};
+
+    size_t rejected = 0;
+    for (auto index : order) {
+      auto tx_copy = txs[index];
+      if (not submit.measure(
+              [&] { return pool.submitOne(std::move(tx_copy)); })) {
+        ++rejected;
+      }
+    }
+    auto status = pool.getStatus();
+    auto rss_filled = benchutil::maxRss();
+
+    // the blocks are built until there are no ready transactions left. After
+    // each of them the successors of the included transactions are replaced
+    // with the ones not requiring the tags of the chain anymore, like the
+    // revalidation does, and the stale ones are pruned
+    BlockNumber block = 0;
+    size_t included = 0;
+    while (true) {
+      auto ready =
+          get_ready.measure([&] { return pool.getReadyTransactions(); });
+      std::vector<Transaction::Hash> block_txs;
+      while (block_txs.size() < params.block_size) {
+        auto tx = iterate.measure([&] { return ready->next(); });
+        if (tx == nullptr) {
+          break;
+        }
+        block_txs.push_back(tx->hash);
+      }
+      ready.reset();
+      if (block_txs.empty()) {
+        break;
+      }
+      for (auto &hash : block_txs) {
+        (void)remove.measure([&] { return pool.removeOne(hash); });
+      }
+      for (auto &hash : block_txs) {
+        auto successor = indexOf(hash) + accounts;
+        if (successor >= txs.size()) {
+          continue;
+        }
+        auto tx = txs[successor];
+        tx.requires.clear();
+        (void)revalidate.measure([&]() -> outcome::result<void> {
+          OUTCOME_TRY(pool.removeOne(tx.hash));
+          return pool.submitOne(std::move(tx));
+        });
+      }
+      included += block_txs.size();
+      ++block;
+      (void)remove_stale.measure([&] { return pool.removeStale(block); });
+    }
+
+    fmt::print(
+        "transactions {} chain length {} block size {} reorder window {} "
+        "max longevity {} seed {}\n",
+        params.transactions,
+        params.chain_length,
+        params.block_size,
+        params.reorder_window,
+        params.max_longevity,
+        params.seed);
+    submit.report();
+    get_ready.report();
+    iterate.report();
+    remove.report();
+    remove_stale.report();
+    revalidate.report();
+    fmt::print(
+        "rejected {} ready {} waiting {} bytes {} after the submission\n",
+        rejected,
+        status.ready_num,
+        status.waiting_num,
+        status.bytes);
+    fmt::print("blocks {} included {} left {}\n",
+               block,
+               included,
+               pool.getStatus().ready_num + pool.getStatus().waiting_num);
+    fmt::print("max rss {} KiB, {} KiB of them taken by the filled pool\n",
+               benchutil::maxRss(),
+               rss_filled - rss_before);
+  }
+}  // namespace
+
+int main(int argc, const char **argv) {
+  namespace po = boost::program_options;
+
+  Params params{};
+  po::options_description desc("Transaction pool benchmark options");
+  desc.add_options()("help,h", "show help")(
+      "transactions,n",
+      po::value(&params.transactions)->default_value(100000),
+      "number of the transactions submitted")(
+      "chain-length",
+      po::value(&params.chain_length)->default_value(16),
+      "number of the transactions of an account, which depend on each other")(
+      "block-size",
+      po::value(&params.block_size)->default_value(1000),
+      "max number of the transactions of a block")(
+      "reorder-window",
+      po::value(&params.reorder_window)->default_value(64),
+      "number of the adjacent transactions shuffled before the submission")(
+      "max-longevity",
+      po::value(&params.max_longevity)->default_value(1000),
+      "max number of the blocks a transaction is valid till")(
+      "seed",
+      po::value(&params.seed)->default_value(42),
+      "seed of the generated load");
+
+  po::variables_map vm;
+  try {
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+  } catch (const po::error &e) {
+    std::cerr << e.what() << '\n' << desc << '\n';
+    return EXIT_FAILURE;
+  }
+  if (vm.count("help") != 0) {
+    std::cout << desc << '\n';
+    return EXIT_SUCCESS;
+  }
+  if (params.transactions == 0 or params.chain_length == 0
+      or params.block_size == 0 or params.max_longevity == 0) {
+    std::cerr << "the numbers must be positive\n" << desc << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // the logging of the pool is not to be measured
+  spdlog::set_level(spdlog::level::err);
+
+  run(params);
+  return EXIT_SUCCESS;
+}
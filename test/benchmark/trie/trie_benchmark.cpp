@@ -0,0 +1,586 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * Measures the trie and its storage on the shapes of the state the node
+ * keeps: a map of the balances of the accounts, a double map, the entries of
+ * which share their first keys by dozens, and a map of large values, such as
+ * the code of the contracts.
+ *
+ * The trie is measured in memory: the insertions, the lookups, the removal
+ * of the prefixes and the iteration. Then its serializer, which stores it to
+ * and retrieves it from the memory, LevelDB and RocksDB, if it is built, and
+ * the hash of the extrinsics of a block. Besides the operations per second,
+ * the bytes read from and written to the storage and the allocations made
+ * per iteration are reported
+ */
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
+
+#include "benchmark/support/memory_usage.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/leveldb/leveldb.hpp"
+#ifdef KAGOME_WITH_ROCKSDB
+#include "storage/rocksdb/rocksdb.hpp"
+#endif
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/serialization/ordered_trie_hash.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+
+namespace {
+  using kagome::common::Buffer;
+  using kagome::storage::BufferBatch;
+  using kagome::storage::BufferMapCursor;
+  using kagome::storage::BufferStorage;
+  using kagome::storage::InMemoryStorage;
+  using kagome::storage::LevelDB;
+#ifdef KAGOME_WITH_ROCKSDB
+  using kagome::storage::RocksDB;
+#endif
+  using kagome::storage::face::PinnedView;
+  using kagome::storage::trie::calculateOrderedTrieHash;
+  using kagome::storage::trie::PolkadotCodec;
+  using kagome::storage::trie::PolkadotTrie;
+  using kagome::storage::trie::PolkadotTrieFactoryImpl;
+  using kagome::storage::trie::PolkadotTrieImpl;
+  using kagome::storage::trie::TrieNodeCache;
+  using kagome::storage::trie::TrieSerializerImpl;
+  using kagome::storage::trie::TrieStorageBackendImpl;
+
+  using Entries = std::vector<std::pair<Buffer, Buffer>>;
+
+  enum class Shape { BALANCES, DOUBLE_MAP, LARGE_VALUES };
+
+  /// storages of the serializer, the second argument of its benchmarks
+  enum Backend : int64_t { kMemory, kLevelDb, kRocksDb };
+
+  /// size of the account info kept by the balances
+  constexpr size_t kAccountInfoSize = 80;
+
+  /// number of the entries of the double map sharing a first key
+  constexpr size_t kSecondKeysNum = 64;
+
+  constexpr size_t kDoubleMapValueSize = 32;
+
+  constexpr size_t kLargeValueSize = 64 * 1024;
+
+  /// number of the lookups made in a retrieved trie
+  constexpr size_t kRetrievedKeysNum = 1000;
+
+  /// size of the usual extrinsics, which are the balances transfers
+  constexpr size_t kExtrinsicSize = 150;
+
+  /// splitmix64, so that the keys are spread as the hashes are
+  uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  /// appends \arg size bytes derived from \arg seed
+  void appendBytes(std::vector<uint8_t> &bytes, uint64_t seed, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      bytes.push_back(static_cast<uint8_t>(mix(seed + i / 8) >> (i % 8 * 8)));
+    }
+  }
+
+  /// the hashes of the names of the pallet and of its storage item
+  std::vector<uint8_t> itemPrefix(Shape shape) {
+    std::vector<uint8_t> prefix;
+    appendBytes(prefix, static_cast<uint64_t>(shape) << 32, 32);
+    return prefix;
+  }
+
+  /// the key of \arg account hashed as blake2_128_concat
+  void appendMapKey(std::vector<uint8_t> &key, uint64_t account) {
+    appendBytes(key, mix(account), 16);
+    appendBytes(key, account << 8, 32);
+  }
+
+  Buffer makeValue(uint64_t seed, size_t size) {
+    std::vector<uint8_t> value;
+    value.reserve(size);
+    appendBytes(value, seed, size);
+    return Buffer{std::move(value)};
+  }
+
+  /// key of the entries of the double map under its \arg first key
+  Buffer doubleMapPrefix(size_t first) {
+    auto prefix = itemPrefix(Shape::DOUBLE_MAP);
+    appendMapKey(prefix, first);
+    return Buffer{std::move(prefix)};
+  }
+
+  /// \arg n entries of \arg shape
+  Entries makeEntries(Shape shape, size_t n) {
+    Entries entries;
+    entries.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      auto key = itemPrefix(shape);
+      switch (shape) {
+        case Shape::BALANCES:
+          appendMapKey(key, i);
+          entries.emplace_back(Buffer{std::move(key)},
+                               makeValue(i, kAccountInfoSize));
+          break;
+        case Shape::DOUBLE_MAP:
+          appendMapKey(key, i / kSecondKeysNum);
+          appendMapKey(key, i % kSecondKeysNum + (1ull << 32));
+          entries.emplace_back(Buffer{std::move(key)},
+                               makeValue(i, kDoubleMapValueSize));
+          break;
+        case Shape::LARGE_VALUES:
+          appendMapKey(key, i);
+          entries.emplace_back(Buffer{std::move(key)},
+                               makeValue(i, kLargeValueSize));
+          break;
+      }
+    }
+    return entries;
+  }
+
+  /// the entries of the last benchmark are kept, as they take a while
+  const Entries &cachedEntries(Shape shape, size_t n) {
+    static std::pair<Shape, size_t> cached_key{};
+    static Entries cached;
+    if (cached.empty() or cached_key != std::make_pair(shape, n)) {
+      cached = {};
+      cached = makeEntries(shape, n);
+      cached_key = {shape, n};
+    }
+    return cached;
+  }
+
+  std::unique_ptr<PolkadotTrieImpl> makeTrie(const Entries &entries) {
+    auto trie = std::make_unique<PolkadotTrieImpl>();
+    for (auto &[key, value] : entries) {
+      trie->put(key, value).value();
+    }
+    return trie;
+  }
+
+  /// the trie of the last benchmark is kept, as building it takes a while
+  PolkadotTrieImpl &cachedTrie(Shape shape, size_t n) {
+    static std::pair<Shape, size_t> cached_key{};
+    static std::unique_ptr<PolkadotTrieImpl> cached;
+    if (cached == nullptr or cached_key != std::make_pair(shape, n)) {
+      cached.reset();
+      cached = makeTrie(cachedEntries(shape, n));
+      cached_key = {shape, n};
+    }
+    return *cached;
+  }
+
+  /// index of the \arg step-th key looked up among \arg n ones
+  size_t randomIndex(size_t step, size_t n) {
+    return mix(step) % n;
+  }
+
+  /**
+   * Bytes read from and written to a storage: the values read, and the keys
+   * and the values of the committed writes
+   */
+  struct Traffic {
+    size_t read = 0;
+    size_t written = 0;
+  };
+
+  class CountingBatch : public BufferBatch {
+   public:
+    CountingBatch(std::unique_ptr<BufferBatch> batch, Traffic &traffic)
+        : batch_{std::move(batch)}, traffic_{traffic} {}
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      pending_ += key.size() + value.size();
+      return batch_->put(key, value);
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      pending_ += key.size() + value.size();
+      return batch_->put(key, std::move(value));
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      return batch_->remove(key);
+    }
+
+    outcome::result<void> commit() override {
+      OUTCOME_TRY(batch_->commit());
+      traffic_.written += pending_;
+      pending_ = 0;
+      return outcome::success();
+    }
+
+    void clear() override {
+      batch_->clear();
+      pending_ = 0;
+    }
+
+   private:
+    std::unique_ptr<BufferBatch> batch_;
+    Traffic &traffic_;
+    size_t pending_ = 0;
+  };
+
+  /**
+   * Counts the traffic of the storage it decorates
+   */
+  class CountingStorage : public BufferStorage {
+   public:
+    explicit CountingStorage(std::shared_ptr<BufferStorage> storage)
+        : storage_{std::move(storage)} {}
+
+    Traffic &traffic() {
+      return traffic_;
+    }
+
+    outcome::result<Buffer> get(const Buffer &key) const override {
+      OUTCOME_TRY(value, storage_->get(key));
+      traffic_.read += value.size();
+      return std::move(value);
+    }
+
+    outcome::result<PinnedView<Buffer>> getPinned(
+        const Buffer &key) const override {
+      OUTCOME_TRY(value, storage_->getPinned(key));
+      traffic_.read += value.view().size();
+      return std::move(value);
+    }
+
+    bool contains(const Buffer &key) const override {
+      return storage_->contains(key);
+    }
+
+    bool empty() const override {
+      return storage_->empty();
+    }
+
+    outcome::result<void> put(const Buffer &key, const Buffer &value) override {
+      traffic_.written += key.size() + value.size();
+      return storage_->put(key, value);
+    }
+
+    outcome::result<void> put(const Buffer &key, Buffer &&value) override {
+      traffic_.written += key.size() + value.size();
+      return storage_->put(key, std::move(value));
+    }
+
+    outcome::result<void> remove(const Buffer &key) override {
+      return storage_->remove(key);
+    }
+
+    std::unique_ptr<BufferBatch> batch() override {
+      return std::make_unique<CountingBatch>(storage_->batch(), traffic_);
+    }
+
+    std::unique_ptr<BufferMapCursor> cursor() override {
+      return storage_->cursor();
+    }
+
+   private:
+    std::shared_ptr<BufferStorage> storage_;
+    mutable Traffic traffic_;
+  };
+
+  /**
+   * Storage of the serializer in a fresh directory, which is removed along
+   * with it
+   */
+  class Database {
+   public:
+    explicit Database(Backend backend) {
+      std::shared_ptr<BufferStorage> storage;
+      if (backend == kMemory) {
+        storage = std::make_shared<InMemoryStorage>();
+      } else {
+        path_ = boost::filesystem::temp_directory_path()
+                / boost::filesystem::unique_path("kagome_trie_%%%%%%%%");
+#ifdef KAGOME_WITH_ROCKSDB
+        if (backend == kRocksDb) {
+          storage = RocksDB::create(path_.string())
+                        .value()
+                        ->getSpace(RocksDB::Space::kTrieNode);
+        }
+#endif
+        if (backend == kLevelDb) {
+          leveldb::Options options;
+          options.create_if_missing = true;
+          storage = LevelDB::create(path_.string(), options).value();
+        }
+      }
+      storage_ = std::make_shared<CountingStorage>(std::move(storage));
+      serializer_ = std::make_unique<TrieSerializerImpl>(
+          std::make_shared<PolkadotTrieFactoryImpl>(),
+          std::make_shared<PolkadotCodec>(),
+          std::make_shared<TrieStorageBackendImpl>(storage_, Buffer{}),
+          std::make_shared<TrieNodeCache>(0));
+    }
+
+    Database(const Database &) = delete;
+    Database &operator=(const Database &) = delete;
+
+    ~Database() {
+      serializer_.reset();
+      storage_.reset();
+      if (not path_.empty()) {
+        boost::filesystem::remove_all(path_);
+      }
+    }
+
+    TrieSerializerImpl &serializer() {
+      return *serializer_;
+    }
+
+    Traffic &traffic() {
+      return storage_->traffic();
+    }
+
+   private:
+    boost::filesystem::path path_;
+    std::shared_ptr<CountingStorage> storage_;
+    std::unique_ptr<TrieSerializerImpl> serializer_;
+  };
+
+  void report(benchmark::State &state,
+              size_t items_per_iteration,
+              size_t allocations_before) {
+    auto allocated = benchutil::allocations() - allocations_before;
+    state.SetItemsProcessed(state.iterations() * items_per_iteration);
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(allocated), benchmark::Counter::kAvgIterations);
+  }
+
+  void reportTraffic(benchmark::State &state, const Traffic &traffic) {
+    state.counters["read"] = benchmark::Counter(
+        static_cast<double>(traffic.read), benchmark::Counter::kAvgIterations);
+    state.counters["written"] =
+        benchmark::Counter(static_cast<double>(traffic.written),
+                           benchmark::Counter::kAvgIterations);
+  }
+
+  /// builds the trie of range(0) entries
+  void trie_put(benchmark::State &state, Shape shape) {
+    auto &entries = cachedEntries(shape, state.range(0));
+    std::unique_ptr<PolkadotTrieImpl> trie;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      state.PauseTiming();
+      trie = std::make_unique<PolkadotTrieImpl>();
+      state.ResumeTiming();
+      for (auto &[key, value] : entries) {
+        benchmark::DoNotOptimize(trie->put(key, value));
+      }
+    }
+    report(state, entries.size(), allocations_before);
+  }
+
+  /// looks up a random key of the trie of range(0) entries
+  void trie_get(benchmark::State &state, Shape shape) {
+    auto &entries = cachedEntries(shape, state.range(0));
+    auto &trie = cachedTrie(shape, state.range(0));
+    size_t step = 0;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto &key = entries[randomIndex(step++, entries.size())].first;
+      benchmark::DoNotOptimize(trie.get(key));
+    }
+    report(state, 1, allocations_before);
+  }
+
+  /// removes the entries under a first key of the double map
+  void trie_clear_prefix(benchmark::State &state) {
+    auto &entries = cachedEntries(Shape::DOUBLE_MAP, state.range(0));
+    auto first_keys = entries.size() / kSecondKeysNum;
+    std::vector<Buffer> prefixes;
+    for (size_t first = 0; first < first_keys; ++first) {
+      prefixes.push_back(doubleMapPrefix(first));
+    }
+    auto trie = makeTrie(entries);
+    size_t next = 0;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      if (next == prefixes.size()) {
+        state.PauseTiming();
+        trie.reset();
+        trie = makeTrie(entries);
+        next = 0;
+        state.ResumeTiming();
+      }
+      benchmark::DoNotOptimize(trie->clearPrefix(prefixes[next++]));
+    }
+    report(state, kSecondKeysNum, allocations_before);
+  }
+
+  /// iterates over all the entries of the trie of range(0) entries
+  void trie_cursor(benchmark::State &state, Shape shape) {
+    auto &trie = cachedTrie(shape, state.range(0));
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto cursor = trie.cursor();
+      cursor->seekToFirst().value();
+      while (cursor->isValid()) {
+        benchmark::DoNotOptimize(cursor->value());
+        cursor->next().value();
+      }
+    }
+    report(state, state.range(0), allocations_before);
+  }
+
+  /// stores the trie of range(0) entries to the backend range(1)
+  void store_trie(benchmark::State &state, Shape shape) {
+    auto &entries = cachedEntries(shape, state.range(0));
+    auto backend = static_cast<Backend>(state.range(1));
+    Traffic traffic;
+    size_t allocations_paused = 0;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      // the trie is stored once, so each time a fresh one goes to a fresh
+      // storage
+      state.PauseTiming();
+      auto paused_from = benchutil::allocations();
+      auto database = std::make_unique<Database>(backend);
+      auto trie = makeTrie(entries);
+      allocations_paused += benchutil::allocations() - paused_from;
+      state.ResumeTiming();
+
+      benchmark::DoNotOptimize(database->serializer().storeTrie(*trie));
+
+      state.PauseTiming();
+      paused_from = benchutil::allocations();
+      traffic.read += database->traffic().read;
+      traffic.written += database->traffic().written;
+      trie.reset();
+      database.reset();
+      allocations_paused += benchutil::allocations() - paused_from;
+      state.ResumeTiming();
+    }
+    report(state, entries.size(), allocations_before + allocations_paused);
+    reportTraffic(state, traffic);
+  }
+
+  /**
+   * Retrieves the trie of range(0) entries stored to the backend range(1)
+   * and looks up kRetrievedKeysNum random keys in it, which loads the
+   * nodes on their paths
+   */
+  void retrieve_trie(benchmark::State &state, Shape shape) {
+    auto &entries = cachedEntries(shape, state.range(0));
+    Database database{static_cast<Backend>(state.range(1))};
+    auto root = [&] {
+      auto trie = makeTrie(entries);
+      return database.serializer().storeTrie(*trie).value();
+    }();
+    database.traffic() = {};
+    size_t step = 0;
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      auto trie = database.serializer().retrieveTrie(root).value();
+      for (size_t i = 0; i < kRetrievedKeysNum; ++i) {
+        auto &key = entries[randomIndex(step++, entries.size())].first;
+        benchmark::DoNotOptimize(trie->get(key));
+      }
+    }
+    report(state, kRetrievedKeysNum, allocations_before);
+    reportTraffic(state, database.traffic());
+  }
+
+  /// hashes range(0) extrinsics as the extrinsics root of a block does
+  void ordered_trie_hash(benchmark::State &state) {
+    std::vector<Buffer> extrinsics;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      extrinsics.push_back(makeValue(i, kExtrinsicSize));
+    }
+    auto allocations_before = benchutil::allocations();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          calculateOrderedTrieHash(extrinsics.begin(), extrinsics.end()));
+    }
+    report(state, extrinsics.size(), allocations_before);
+    state.SetBytesProcessed(state.iterations() * extrinsics.size()
+                            * kExtrinsicSize);
+  }
+
+  /// backends the node is built with
+  const std::vector<int64_t> kBackends{kMemory,
+                                       kLevelDb,
+#ifdef KAGOME_WITH_ROCKSDB
+                                       kRocksDb
+#endif
+  };
+
+  /// a thousand and a hundred thousand entries in each of the backends
+  void storageArgs(benchmark::internal::Benchmark *benchmark) {
+    for (int64_t entries : {1000, 100000}) {
+      for (int64_t backend : kBackends) {
+        benchmark->Args({entries, backend});
+      }
+    }
+  }
+
+  /// a thousand entries in each of the backends
+  void smallStorageArgs(benchmark::internal::Benchmark *benchmark) {
+    for (int64_t backend : kBackends) {
+      benchmark->Args({1000, backend});
+    }
+  }
+}  // namespace
+
+// the balances of a test network, a parachain and a relay chain
+BENCHMARK_CAPTURE(trie_put, balances, Shape::BALANCES)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(trie_put, double_map, Shape::DOUBLE_MAP)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(trie_put, large_values, Shape::LARGE_VALUES)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(trie_get, balances, Shape::BALANCES)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_CAPTURE(trie_get, double_map, Shape::DOUBLE_MAP)
+    ->Arg(1000)
+    ->Arg(100000);
+BENCHMARK_CAPTURE(trie_get, large_values, Shape::LARGE_VALUES)->Arg(1000);
+
+BENCHMARK(trie_clear_prefix)->Arg(1000)->Arg(100000);
+
+BENCHMARK_CAPTURE(trie_cursor, balances, Shape::BALANCES)
+    ->Arg(1000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(trie_cursor, double_map, Shape::DOUBLE_MAP)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(store_trie, balances, Shape::BALANCES)
+    ->Apply(storageArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(store_trie, large_values, Shape::LARGE_VALUES)
+    ->Apply(smallStorageArgs)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(retrieve_trie, balances, Shape::BALANCES)
+    ->Apply(storageArgs)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(retrieve_trie, double_map, Shape::DOUBLE_MAP)
+    ->Apply(storageArgs)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(ordered_trie_hash)->Arg(10)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/jrpc/jrpc_batch.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::api::joinBatch;
+using kagome::api::splitBatch;
+using Requests = std::vector<std::string_view>;
+
+/**
+ * @given a batch of requests, which contain nested arrays and objects, and
+ * brackets and commas in the strings
+ * @when it is split
+ * @then the requests are given in their order, trimmed
+ */
+TEST(JrpcBatchTest, Split) {
+  auto batch = splitBatch(
+      R"( [ {"id":1,"params":[1,{"a":[]}]} ,
+            {"id":2,"params":["],[\"{,"]},3 ] )");
+  ASSERT_TRUE(batch);
+  EXPECT_EQ(*batch,
+            (Requests{R"({"id":1,"params":[1,{"a":[]}]})",
+                      R"({"id":2,"params":["],[\"{,"]})",
+                      "3"}));
+
+  batch = splitBatch("[]");
+  ASSERT_TRUE(batch);
+  EXPECT_TRUE(batch->empty());
+}
+
+/**
+ * @given the requests, which are not batches, and the malformed batches
+ * @when they are split
+ * @then none is given, so that they are processed as single requests
+ */
+TEST(JrpcBatchTest, NotBatch) {
+  EXPECT_FALSE(splitBatch(R"({"id":1})"));
+  EXPECT_FALSE(splitBatch(""));
+  EXPECT_FALSE(splitBatch("["));
+  EXPECT_FALSE(splitBatch(R"([{"id":1}})"));
+  EXPECT_FALSE(splitBatch(R"([{"id":"1}])"));
+  EXPECT_FALSE(splitBatch(R"([{"id":1}]])"));
+  EXPECT_FALSE(splitBatch(R"([{"id":1},])"));
+  EXPECT_FALSE(splitBatch(R"([,{"id":1}])"));
+}
+
+/**
+ * @given the responses to a batch, some of which are empty, as they are to
+ * notifications
+ * @when they are joined
+ * @then the empty ones are skipped, and nothing is given if all of them are
+ */
+TEST(JrpcBatchTest, Join) {
+  EXPECT_EQ(joinBatch({"{1}", "", "{3}"}), "[{1},{3}]");
+  EXPECT_EQ(joinBatch({"", ""}), "");
+}
+
+/**
+ * @given the requests, which have the method and the id among the other
+ * members, nested or quoted
+ * @when they are peeked at
+ * @then the method and the id of the request itself are given, and none if
+ * the request is not an object
+ */
+TEST(JrpcBatchTest, PeekCall) {
+  auto call = kagome::api::peekCall(
+      R"( {"params":{"method":"a","id":2},"id" : "x,}",)"
+      R"( "method":"state_getRuntimeVersion"} )");
+  ASSERT_TRUE(call);
+  EXPECT_EQ(call->method, "state_getRuntimeVersion");
+  EXPECT_EQ(call->id, R"("x,}")");
+
+  call = kagome::api::peekCall(R"({"method":"chain_getBlockHash"})");
+  ASSERT_TRUE(call);
+  EXPECT_EQ(call->method, "chain_getBlockHash");
+  EXPECT_TRUE(call->id.empty());
+
+  EXPECT_FALSE(kagome::api::peekCall("[]"));
+  EXPECT_FALSE(kagome::api::peekCall(R"({"id":1}{"id":2})"));
+  EXPECT_FALSE(kagome::api::peekCall(R"({"id":"1})"));
+}
+
+/**
+ * @given the ids of the requests
+ * @when they are refused as the server is busy
+ * @then the responses refer to the ids, and a notification gets none
+ */
+TEST(JrpcBatchTest, BusyResponse) {
+  EXPECT_EQ(kagome::api::busyResponse("7"),
+            R"({"jsonrpc":"2.0","error":{"code":-32000,)"
+            R"("message":"Server is busy"},"id":7})");
+  EXPECT_EQ(kagome::api::busyResponse(""), "");
+}
+
+/**
+ * @given the responses formatted by the server
+ * @when they are told apart
+ * @then only the ones with an error are error responses
+ */
+TEST(JrpcBatchTest, IsErrorResponse) {
+  EXPECT_TRUE(kagome::api::isErrorResponse(kagome::api::busyResponse("7")));
+  EXPECT_TRUE(kagome::api::isErrorResponse(kagome::api::kEmptyBatchResponse));
+  EXPECT_FALSE(kagome::api::isErrorResponse(
+      R"({"jsonrpc":"2.0","result":{"error":1},"id":7})"));
+  EXPECT_FALSE(kagome::api::isErrorResponse(""));
+}
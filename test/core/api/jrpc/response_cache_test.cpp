@@ -0,0 +1,64 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/jrpc/response_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::api::ResponseCache;
+
+class ResponseCacheTest : public testing::Test {
+ public:
+  static ResponseCache::Key key(uint8_t byte) {
+    ResponseCache::Key key;
+    key[0] = byte;
+    return key;
+  }
+
+  static jsonrpc::Value value(size_t size) {
+    return jsonrpc::Value{std::string(size, 'a')};
+  }
+};
+
+/**
+ * @given a response kept in the cache
+ * @when it is looked up
+ * @then the same response is got, while an unknown one is not
+ */
+TEST_F(ResponseCacheTest, GetsKeptResponse) {
+  ResponseCache cache{1024};
+  cache.put(key(1), value(10));
+
+  auto kept = cache.get(key(1));
+  ASSERT_TRUE(kept);
+  ASSERT_EQ(kept->AsString(), std::string(10, 'a'));
+  ASSERT_FALSE(cache.get(key(2)));
+  ASSERT_EQ(cache.bytes(), ResponseCache::sizeOf(value(10)));
+}
+
+/**
+ * @given a cache filled up with the responses
+ * @when one more response is put
+ * @then the least recently used ones are evicted to fit it into the size of
+ * the cache, and a response larger than the cache is not kept at all
+ */
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+  auto size = ResponseCache::sizeOf(value(100));
+  ResponseCache cache{size * 2};
+  cache.put(key(1), value(100));
+  cache.put(key(2), value(100));
+  // 1 is used more recently than 2
+  ASSERT_TRUE(cache.get(key(1)));
+
+  cache.put(key(3), value(100));
+  ASSERT_TRUE(cache.get(key(1)));
+  ASSERT_FALSE(cache.get(key(2)));
+  ASSERT_TRUE(cache.get(key(3)));
+  ASSERT_LE(cache.bytes(), size * 2);
+
+  cache.put(key(4), value(size * 2));
+  ASSERT_FALSE(cache.get(key(4)));
+  ASSERT_TRUE(cache.get(key(1)));
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/scale/scale_rpc_server.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/api/service/author/author_api_mock.hpp"
+#include "mock/core/api/service/chain/chain_api_mock.hpp"
+#include "mock/core/api/service/state/state_api_mock.hpp"
+#include "scale/scale.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::api::AuthorApiMock;
+using kagome::api::ChainApiMock;
+using kagome::api::ScaleRpcError;
+using kagome::api::ScaleRpcMethod;
+using kagome::api::ScaleRpcServer;
+using kagome::api::StateApiMock;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using testing::Return;
+
+class ScaleRpcServerTest : public testing::Test {
+ public:
+  using RequestId = ScaleRpcServer::RequestId;
+
+  template <typename... Params>
+  static std::vector<uint8_t> request(RequestId id,
+                                      ScaleRpcMethod method,
+                                      const Params &... params) {
+    return kagome::scale::encode(id, static_cast<uint16_t>(method), params...)
+        .value();
+  }
+
+  template <typename... Values>
+  static std::string response(RequestId id,
+                              uint8_t status,
+                              const Values &... values) {
+    auto encoded = kagome::scale::encode(id, status, values...).value();
+    return {encoded.begin(), encoded.end()};
+  }
+
+  std::shared_ptr<ChainApiMock> chain_api = std::make_shared<ChainApiMock>();
+  std::shared_ptr<StateApiMock> state_api = std::make_shared<StateApiMock>();
+  std::shared_ptr<AuthorApiMock> author_api =
+      std::make_shared<AuthorApiMock>();
+  ScaleRpcServer server{chain_api, state_api, author_api};
+};
+
+/**
+ * @given a request of a block header
+ * @when it is processed
+ * @then the response has the id of the request, the success status and the
+ * SCALE-encoded header
+ */
+TEST_F(ScaleRpcServerTest, CallsMethod) {
+  auto hash = "block"_hash256;
+  BlockHeader header;
+  header.number = 42;
+  header.parent_hash = "parent"_hash256;
+  EXPECT_CALL(*chain_api, getHeader(hash)).WillOnce(Return(header));
+
+  auto result =
+      server.process(request(7, ScaleRpcMethod::CHAIN_GET_HEADER, hash));
+  ASSERT_EQ(result, response(7, ScaleRpcServer::kSuccess, header));
+}
+
+/**
+ * @given a request of the storage at no block
+ * @when it is processed
+ * @then the state api is called without a block
+ */
+TEST_F(ScaleRpcServerTest, CallsMethodWithOptionalParams) {
+  EXPECT_CALL(*state_api, getStorage("key"_buf))
+      .WillOnce(Return("value"_buf));
+
+  auto result = server.process(request(1,
+                                       ScaleRpcMethod::STATE_GET_STORAGE,
+                                       "key"_buf,
+                                       boost::optional<BlockHash>{}));
+  ASSERT_EQ(result, response(1, ScaleRpcServer::kSuccess, "value"_buf));
+}
+
+/**
+ * @given requests of an unknown method, with params not matching the ones
+ * of the method, and too short to have a header
+ * @when they are processed
+ * @then the responses have the failure status and the messages of the errors
+ */
+TEST_F(ScaleRpcServerTest, Fails) {
+  auto message = [](ScaleRpcError error) {
+    return make_error_code(error).message();
+  };
+  ASSERT_EQ(server.process(request(2, static_cast<ScaleRpcMethod>(999))),
+            response(2,
+                     ScaleRpcServer::kFailure,
+                     message(ScaleRpcError::UNKNOWN_METHOD)));
+  ASSERT_EQ(server.process(request(3, ScaleRpcMethod::CHAIN_GET_HEADER)),
+            response(3,
+                     ScaleRpcServer::kFailure,
+                     message(ScaleRpcError::INVALID_PARAMS)));
+  ASSERT_EQ(server.process(std::vector<uint8_t>{1, 2}),
+            response(0,
+                     ScaleRpcServer::kFailure,
+                     message(ScaleRpcError::INVALID_REQUEST)));
+}
+
+/**
+ * @given requests of a cheap and of an expensive method
+ * @when they are checked
+ * @then only the expensive one is told so
+ */
+TEST_F(ScaleRpcServerTest, IsExpensive) {
+  ASSERT_FALSE(ScaleRpcServer::isExpensive(
+      request(1, ScaleRpcMethod::CHAIN_GET_BLOCK_HASH)));
+  ASSERT_TRUE(ScaleRpcServer::isExpensive(
+      request(1, ScaleRpcMethod::STATE_GET_PAIRS)));
+}
@@ -67,8 +67,13 @@ struct AuthorApiTest : public ::testing::Test {
     ttq = std::make_shared<TaggedTransactionQueueMock>();
     transaction_pool = std::make_shared<TransactionPoolMock>();
     gossiper = std::make_shared<ExtrinsicGossiperMock>();
+    // the batches are validated by the workers
     api = std::make_shared<AuthorApiImpl>(
-        ttq, transaction_pool, hasher, gossiper);
+        ttq,
+        transaction_pool,
+        hasher,
+        gossiper,
+        std::make_shared<kagome::common::WorkerPool>(2));
     extrinsic.reset(new Extrinsic{"12"_hex2buf});
     valid_transaction.reset(new ValidTransaction{1, {{2}}, {{3}}, 4, true});
     deepest_hash = createHash256({1u, 2u, 3u});
@@ -85,6 +90,7 @@ TEST_F(AuthorApiTest, SubmitExtrinsicSuccess) {
   TransactionValidity tv = *valid_transaction;
   gsl::span<const uint8_t> span = gsl::make_span(extrinsic->data);
   EXPECT_CALL(*hasher, blake2b_256(span)).WillOnce(Return(Hash256{}));
+  EXPECT_CALL(*transaction_pool, contains(Hash256{})).WillOnce(Return(false));
   EXPECT_CALL(*ttq, validate_transaction(*extrinsic)).WillOnce(Return(tv));
   Transaction tr{*extrinsic,
                  extrinsic->data.size(),
@@ -110,11 +116,126 @@ TEST_F(AuthorApiTest, SubmitExtrinsicSuccess) {
  */
 TEST_F(AuthorApiTest, SubmitExtrinsicFail) {
   TransactionValidity tv = InvalidTransaction{1u};
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillOnce(Return(Hash256{}));
+  EXPECT_CALL(*transaction_pool, contains(Hash256{})).WillOnce(Return(false));
   EXPECT_CALL(*ttq, validate_transaction(*extrinsic))
       .WillOnce(Return(outcome::failure(DummyError::ERROR)));
-  EXPECT_CALL(*hasher, blake2b_256(_)).Times(0);
   EXPECT_CALL(*transaction_pool, submitOne(_)).Times(0);
   EXPECT_CALL(*gossiper, transactionAnnounce(_)).Times(0);
   EXPECT_OUTCOME_ERROR(
       res, api->submitExtrinsic(*extrinsic), DummyError::ERROR);
 }
+
+/**
+ * @given configured extrinsic submission api object
+ * @when submit_extrinsic is called with an extrinsic which is in the
+ * transaction pool already
+ * @then it is rejected without being validated
+ */
+TEST_F(AuthorApiTest, SubmitExtrinsicSkipsImported) {
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillOnce(Return(Hash256{}));
+  EXPECT_CALL(*transaction_pool, contains(Hash256{})).WillOnce(Return(true));
+  EXPECT_CALL(*ttq, validate_transaction(_)).Times(0);
+  EXPECT_CALL(*transaction_pool, submitOne(_)).Times(0);
+  EXPECT_CALL(*gossiper, transactionAnnounce(_)).Times(0);
+  EXPECT_OUTCOME_ERROR(res,
+                       api->submitExtrinsic(*extrinsic),
+                       TransactionPoolError::TX_ALREADY_IMPORTED);
+}
+
+/**
+ * @given configured extrinsic submission api object
+ * @when submit_extrinsics is called with a valid extrinsic given twice and
+ * an invalid one
+ * @then each extrinsic is validated once, the valid one is sent to
+ * transaction pool and announced once, and the results keep the order of the
+ * extrinsics
+ */
+TEST_F(AuthorApiTest, SubmitExtrinsicsValidatesUniqueOnes) {
+  Extrinsic invalid{"34"_hex2buf};
+  Hash256 valid_hash = createHash256({1u});
+  Hash256 invalid_hash = createHash256({2u});
+  EXPECT_CALL(*hasher, blake2b_256(gsl::make_span(extrinsic->data)))
+      .WillRepeatedly(Return(valid_hash));
+  EXPECT_CALL(*hasher, blake2b_256(gsl::make_span(invalid.data)))
+      .WillOnce(Return(invalid_hash));
+  EXPECT_CALL(*transaction_pool,
+              checkUnknown(std::vector<Hash256>{valid_hash, invalid_hash}))
+      .WillOnce(Return(std::vector<outcome::result<void>>(
+          2, outcome::success())));
+  EXPECT_CALL(*ttq, validate_transaction(*extrinsic))
+      .WillOnce(Return(TransactionValidity{*valid_transaction}));
+  EXPECT_CALL(*ttq, validate_transaction(invalid))
+      .WillOnce(Return(outcome::failure(DummyError::ERROR)));
+  EXPECT_CALL(*transaction_pool, submitEach(testing::SizeIs(1)))
+      .WillOnce(Return(std::vector<outcome::result<void>>{
+          outcome::success()}));
+  EXPECT_CALL(*transaction_pool, submitOne(_)).Times(0);
+  EXPECT_CALL(*gossiper, transactionAnnounce(_)).Times(1);
+
+  auto results = api->submitExtrinsics({*extrinsic, invalid, *extrinsic});
+
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_OUTCOME_EQ(results[0], valid_hash);
+  EXPECT_OUTCOME_ERROR(second, results[1], DummyError::ERROR);
+  EXPECT_OUTCOME_EQ(results[2], valid_hash);
+}
+
+/**
+ * @given configured extrinsic submission api object
+ * @when submit_extrinsics is called with an extrinsic which is in the
+ * transaction pool already, given twice
+ * @then it is not validated, and both of its results are the rejection
+ */
+TEST_F(AuthorApiTest, SubmitExtrinsicsSkipsImported) {
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillRepeatedly(Return(Hash256{}));
+  EXPECT_CALL(*transaction_pool, checkUnknown(std::vector<Hash256>{Hash256{}}))
+      .WillOnce(Return(std::vector<outcome::result<void>>{
+          TransactionPoolError::TX_ALREADY_IMPORTED}));
+  EXPECT_CALL(*ttq, validate_transaction(_)).Times(0);
+  EXPECT_CALL(*transaction_pool, submitEach(_)).Times(0);
+  EXPECT_CALL(*gossiper, transactionAnnounce(_)).Times(0);
+
+  auto results = api->submitExtrinsics({*extrinsic, *extrinsic});
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_OUTCOME_ERROR(
+      first, results[0], TransactionPoolError::TX_ALREADY_IMPORTED);
+  EXPECT_OUTCOME_ERROR(
+      second, results[1], TransactionPoolError::TX_ALREADY_IMPORTED);
+}
+
+/**
+ * @given configured extrinsic submission api object
+ * @when submit_extrinsics is called with an extrinsic banned from the pool
+ * and a valid one, which the pool refuses as it is full
+ * @then the banned one is not validated, and the refusal of the pool is the
+ * result of the valid one, which is not announced
+ */
+TEST_F(AuthorApiTest, SubmitExtrinsicsSkipsBanned) {
+  Extrinsic banned{"34"_hex2buf};
+  Hash256 valid_hash = createHash256({1u});
+  Hash256 banned_hash = createHash256({2u});
+  EXPECT_CALL(*hasher, blake2b_256(gsl::make_span(extrinsic->data)))
+      .WillOnce(Return(valid_hash));
+  EXPECT_CALL(*hasher, blake2b_256(gsl::make_span(banned.data)))
+      .WillOnce(Return(banned_hash));
+  EXPECT_CALL(*transaction_pool,
+              checkUnknown(std::vector<Hash256>{banned_hash, valid_hash}))
+      .WillOnce(Return(std::vector<outcome::result<void>>{
+          TransactionPoolError::TX_BANNED, outcome::success()}));
+  EXPECT_CALL(*ttq, validate_transaction(*extrinsic))
+      .WillOnce(Return(TransactionValidity{*valid_transaction}));
+  EXPECT_CALL(*ttq, validate_transaction(banned)).Times(0);
+  EXPECT_CALL(*transaction_pool, submitEach(testing::SizeIs(1)))
+      .WillOnce(Return(std::vector<outcome::result<void>>{
+          TransactionPoolError::POOL_IS_FULL}));
+  EXPECT_CALL(*gossiper, transactionAnnounce(_)).Times(0);
+
+  auto results = api->submitExtrinsics({banned, *extrinsic});
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_OUTCOME_ERROR(first, results[0], TransactionPoolError::TX_BANNED);
+  EXPECT_OUTCOME_ERROR(
+      second, results[1], TransactionPoolError::POOL_IS_FULL);
+}
@@ -5,7 +5,10 @@
 
 #include <gtest/gtest.h>
 
+#include "api/jrpc/jrpc_method.hpp"
 #include "api/service/chain/impl/chain_api_impl.hpp"
+#include "api/service/chain/requests/get_block.hpp"
+#include "mock/core/api/service/chain/chain_api_mock.hpp"
 #include "mock/core/blockchain/block_tree_mock.hpp"
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
 #include "primitives/block_header.hpp"
@@ -13,14 +16,20 @@
 #include "testutil/outcome.hpp"
 
 using kagome::api::ChainApi;
+using kagome::api::CachedMethod;
 using kagome::api::ChainApiImpl;
+using kagome::api::ChainApiMock;
+using kagome::api::ResponseCache;
+using kagome::api::chain::request::GetBlock;
 using kagome::blockchain::BlockTreeMock;
 using kagome::blockchain::BlockHeaderRepositoryMock;
 using kagome::common::Buffer;
+using kagome::primitives::Block;
 using kagome::primitives::BlockHash;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::BlockInfo;
 using kagome::primitives::BlockNumber;
+using kagome::primitives::Extrinsic;
 using testing::Return;
 
 struct ChainApiTest : public ::testing::Test {
@@ -102,3 +111,60 @@ TEST_F(ChainApiTest, GetBlockHashArray) {
           {50, "0x64", 200})));
   ASSERT_EQ(r, std::vector<BlockHash>({hash1, hash2, hash3}));
 }
+
+/**
+ * @given chain api and the last finalized block
+ * @when the blocks are checked to be finalized
+ * @then the ancestors of the last finalized block are finalized, while the
+ * later blocks and the ones of the other forks are not
+ */
+TEST_F(ChainApiTest, IsFinalized) {
+  EXPECT_CALL(*block_tree, getLastFinalized())
+      .WillRepeatedly(Return(BlockInfo(42, hash1)));
+  EXPECT_CALL(*block_tree, hasDirectChain(hash1, hash1))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*block_tree, hasDirectChain(hash2, hash1))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(*block_tree, hasDirectChain(hash3, hash1))
+      .WillRepeatedly(Return(false));
+
+  ASSERT_TRUE(api->isFinalized(BlockInfo(42, hash1)));
+  ASSERT_TRUE(api->isFinalized(BlockInfo(41, hash2)));
+  ASSERT_FALSE(api->isFinalized(BlockInfo(41, hash3)));
+  ASSERT_FALSE(api->isFinalized(BlockInfo(43, hash2)));
+}
+
+/**
+ * @given chain_getBlock method with a response cache
+ * @when a finalized and a not finalized block are requested twice each
+ * @then the finalized block is read once, as its response is cached, while
+ * the other one is read on each request
+ */
+TEST(ChainGetBlockTest, CachesFinalizedBlocks) {
+  auto api = std::make_shared<ChainApiMock>();
+  auto cache = std::make_shared<ResponseCache>(1024 * 1024);
+  CachedMethod<GetBlock, ChainApiMock> method{api, cache};
+  auto finalized =
+      "4fee9b1803132954978652e4d73d4ec5b0dffae3832449cd5e4e4081d539aa22"_hash256;
+  auto unfinalized =
+      "46781d9a3350a0e02dbea4b5e7aee7c139331a65b2cd736bb45a824c2f3ffd1a"_hash256;
+  Block block;
+  block.header.number = 42;
+  block.body.push_back(Extrinsic{Buffer{1, 2, 3}});
+
+  EXPECT_CALL(*api, getBlock(finalized)).WillOnce(Return(block));
+  EXPECT_CALL(*api, isFinalized(BlockInfo(42, finalized)))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*api, getBlock(unfinalized))
+      .Times(2)
+      .WillRepeatedly(Return(block));
+  EXPECT_CALL(*api, isFinalized(BlockInfo(42, unfinalized)))
+      .Times(2)
+      .WillRepeatedly(Return(false));
+
+  for (auto &hash : {finalized, finalized, unfinalized, unfinalized}) {
+    auto value = method({jsonrpc::Value{"0x" + hash.toHex()}});
+    ASSERT_TRUE(value.IsStruct());
+  }
+  ASSERT_GT(cache->bytes(), 0);
+}
@@ -9,20 +9,27 @@
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
 #include "mock/core/blockchain/block_tree_mock.hpp"
 #include "mock/core/runtime/core_mock.hpp"
-#include "mock/core/storage/trie/trie_batches_mock.hpp"
+#include "mock/core/storage/trie/trie_snapshot_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 #include "primitives/block_header.hpp"
+#include "storage/changes_trie/impl/changes_index.hpp"
+#include "storage/in_memory/arena_storage.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
 using kagome::blockchain::BlockHeaderRepositoryMock;
+using kagome::api::StateApiImpl;
 using kagome::blockchain::BlockTreeMock;
 using kagome::common::Buffer;
 using kagome::primitives::BlockHash;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::BlockInfo;
 using kagome::runtime::CoreMock;
-using kagome::storage::trie::EphemeralTrieBatchMock;
+using kagome::storage::ArenaStorage;
+using kagome::storage::changes_trie::ChangesIndex;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieSnapshotMock;
 using kagome::storage::trie::TrieStorageMock;
 using testing::_;
 using testing::Return;
@@ -46,12 +53,12 @@ TEST(StateApiTest, GetStorage) {
   kagome::primitives::BlockId did = "D"_hash256;
   EXPECT_CALL(*block_header_repo, getBlockHeader(did))
       .WillOnce(testing::Return(BlockHeader{.state_root = "CDE"_hash256}));
-  EXPECT_CALL(*storage, getEphemeralBatchAt(_))
+  EXPECT_CALL(*storage, getSnapshotAt(_))
       .WillRepeatedly(testing::Invoke([](auto &root) {
-        auto batch = std::make_unique<EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get("a"_buf))
+        auto snapshot = std::make_shared<TrieSnapshotMock>();
+        EXPECT_CALL(*snapshot, get("a"_buf))
             .WillRepeatedly(testing::Return("1"_buf));
-        return batch;
+        return snapshot;
       }));
 
   EXPECT_OUTCOME_TRUE(r, api.getStorage("a"_buf));
@@ -65,6 +72,254 @@ TEST(StateApiTest, GetStorage) {
   ASSERT_EQ(r1, "1"_buf);
 }
 
+/**
+ * @given state api
+ * @when query values of several keys at the given block
+ * @then the values are obtained in one request to the trie and returned in
+ * the order of the keys
+ */
+TEST(StateApiTest, QueryStorageAt) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core};
+
+  kagome::primitives::BlockId bid = "B"_hash256;
+  EXPECT_CALL(*block_header_repo, getBlockHeader(bid))
+      .WillOnce(testing::Return(BlockHeader{.state_root = "ABC"_hash256}));
+  std::vector<Buffer> keys{"a"_buf, "b"_buf};
+  EXPECT_CALL(*storage, getSnapshotAt(_))
+      .WillOnce(testing::Invoke([&keys](auto &root) {
+        auto snapshot = std::make_shared<TrieSnapshotMock>();
+        EXPECT_CALL(*snapshot, getMany(_))
+            .WillOnce(testing::Return(
+                std::vector<boost::optional<Buffer>>{"1"_buf, boost::none}));
+        return snapshot;
+      }));
+
+  EXPECT_OUTCOME_TRUE(r, api.queryStorageAt(keys, "B"_hash256));
+  ASSERT_EQ(r.size(), 1);
+  ASSERT_EQ(r[0].block, "B"_hash256);
+  ASSERT_EQ(r[0].changes.size(), 2);
+  ASSERT_EQ(r[0].changes[0].key, "a"_buf);
+  ASSERT_EQ(r[0].changes[0].data.value(), "1"_buf);
+  ASSERT_EQ(r[0].changes[1].key, "b"_buf);
+  ASSERT_FALSE(r[0].changes[1].data);
+}
+
+/**
+ * @given state api with the index of the changes of the blocks
+ * @when query values of a key over a range of blocks
+ * @then the values at the first block and at the block changing the key are
+ * returned, and the state of the block not changing it is not read
+ */
+TEST(StateApiTest, QueryStorage) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+  auto changes_index =
+      std::make_shared<ChangesIndex>(std::make_shared<ArenaStorage>(), Buffer{});
+  EXPECT_OUTCOME_TRUE_1(changes_index->addBlock(
+      {2, "B"_hash256}, "A"_hash256, {"x"_buf}, {2, 1}));
+  EXPECT_OUTCOME_TRUE_1(changes_index->addBlock(
+      {3, "C"_hash256}, "B"_hash256, {"a"_buf}, {2, 1}));
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core, changes_index};
+
+  EXPECT_CALL(*block_header_repo, getNumberByHash("A"_hash256))
+      .WillOnce(Return(1));
+  EXPECT_CALL(*block_header_repo, getNumberByHash("C"_hash256))
+      .WillOnce(Return(3));
+  kagome::primitives::BlockId aid = "A"_hash256;
+  EXPECT_CALL(*block_header_repo, getBlockHeader(aid))
+      .WillOnce(Return(BlockHeader{.state_root = "RA"_hash256}));
+  kagome::primitives::BlockId cid = "C"_hash256;
+  EXPECT_CALL(*block_header_repo, getBlockHeader(cid))
+      .WillOnce(Return(BlockHeader{.state_root = "RC"_hash256}));
+  EXPECT_CALL(*storage, getSnapshotAt(_))
+      .Times(2)
+      .WillRepeatedly(testing::Invoke([](auto &root) {
+        auto snapshot = std::make_shared<TrieSnapshotMock>();
+        auto value = root == "RA"_hash256 ? "1"_buf : "2"_buf;
+        EXPECT_CALL(*snapshot, getMany(_))
+            .WillOnce(Return(std::vector<boost::optional<Buffer>>{value}));
+        return snapshot;
+      }));
+
+  EXPECT_OUTCOME_TRUE(
+      r, api.queryStorage({"a"_buf}, "A"_hash256, {"C"_hash256}));
+  ASSERT_EQ(r.size(), 2);
+  ASSERT_EQ(r[0].block, "A"_hash256);
+  ASSERT_EQ(r[0].changes.size(), 1);
+  ASSERT_EQ(r[0].changes[0].data.value(), "1"_buf);
+  ASSERT_EQ(r[1].block, "C"_hash256);
+  ASSERT_EQ(r[1].changes.size(), 1);
+  ASSERT_EQ(r[1].changes[0].data.value(), "2"_buf);
+}
+
+/**
+ * @given state api over a trie
+ * @when get keys with a prefix page by page
+ * @then every page contains the requested number of keys which start with
+ * the prefix and follow the last key of the previous page
+ */
+TEST(StateApiTest, GetKeysPaged) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core};
+
+  PolkadotTrieImpl trie;
+  for (auto &key : {"0102"_hex2buf,
+                    "02"_hex2buf,
+                    "0201"_hex2buf,
+                    "020102"_hex2buf,
+                    "0203"_hex2buf,
+                    "03"_hex2buf}) {
+    EXPECT_OUTCOME_TRUE_1(trie.put(key, key));
+  }
+  EXPECT_CALL(*block_header_repo, getBlockHeader(_))
+      .WillRepeatedly(Return(BlockHeader{.state_root = "ABC"_hash256}));
+  EXPECT_CALL(*storage, getSnapshotAt(_))
+      .WillRepeatedly(testing::Invoke([&trie](auto &root) {
+        auto snapshot = std::make_shared<TrieSnapshotMock>();
+        EXPECT_CALL(*snapshot, cursor())
+            .WillRepeatedly(testing::Invoke([&trie] { return trie.cursor(); }));
+        return snapshot;
+      }));
+
+  boost::optional<BlockHash> at = "B"_hash256;
+  EXPECT_OUTCOME_TRUE(page1,
+                      api.getKeysPaged("02"_hex2buf, 3, boost::none, at));
+  ASSERT_EQ(page1,
+            (std::vector<Buffer>{
+                "02"_hex2buf, "0201"_hex2buf, "020102"_hex2buf}));
+  EXPECT_OUTCOME_TRUE(page2,
+                      api.getKeysPaged("02"_hex2buf, 3, page1.back(), at));
+  ASSERT_EQ(page2, (std::vector<Buffer>{"0203"_hex2buf}));
+
+  EXPECT_OUTCOME_TRUE(all_keys,
+                      api.getKeysPaged(boost::none, 10, boost::none, at));
+  ASSERT_EQ(all_keys.size(), 6);
+
+  EXPECT_OUTCOME_TRUE(pairs, api.getPairs("0201"_hex2buf, at));
+  ASSERT_EQ(pairs,
+            (std::vector<std::pair<Buffer, Buffer>>{
+                {"0201"_hex2buf, "0201"_hex2buf},
+                {"020102"_hex2buf, "020102"_hex2buf}}));
+}
+
+/**
+ * @given state api over a trie with more keys of a prefix than the pairs
+ * returned at once
+ * @when get the pairs of the prefix, and of a narrower one
+ * @then the former fails, while the latter returns its pairs
+ */
+TEST(StateApiTest, GetPairsLimit) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core};
+
+  PolkadotTrieImpl trie;
+  for (size_t i = 0; i <= StateApiImpl::kMaxPairsNum; i++) {
+    Buffer key{1, static_cast<uint8_t>(i >> 8u), static_cast<uint8_t>(i)};
+    EXPECT_OUTCOME_TRUE_1(trie.put(key, key));
+  }
+  EXPECT_CALL(*block_header_repo, getBlockHeader(_))
+      .WillRepeatedly(Return(BlockHeader{.state_root = "ABC"_hash256}));
+  EXPECT_CALL(*storage, getSnapshotAt(_))
+      .WillRepeatedly(testing::Invoke([&trie](auto &root) {
+        auto snapshot = std::make_shared<TrieSnapshotMock>();
+        EXPECT_CALL(*snapshot, cursor())
+            .WillRepeatedly(testing::Invoke([&trie] { return trie.cursor(); }));
+        return snapshot;
+      }));
+
+  boost::optional<BlockHash> at = "B"_hash256;
+  EXPECT_OUTCOME_FALSE(error, api.getPairs("01"_hex2buf, at));
+  ASSERT_EQ(error, StateApiImpl::Error::TOO_MANY_PAIRS);
+
+  EXPECT_OUTCOME_TRUE(pairs, api.getPairs("0100"_hex2buf, at));
+  ASSERT_EQ(pairs.size(), 256);
+}
+
+/**
+ * @given state api
+ * @when the storage of the same block is read several times
+ * @then the header of the block is read and the snapshot of its state is
+ * obtained once, the snapshot is shared by the reads
+ */
+TEST(StateApiTest, SnapshotCache) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core};
+
+  kagome::primitives::BlockId bid = "B"_hash256;
+  EXPECT_CALL(*block_header_repo, getBlockHeader(bid))
+      .WillOnce(testing::Return(BlockHeader{.state_root = "ABC"_hash256}));
+  auto snapshot = std::make_shared<TrieSnapshotMock>();
+  EXPECT_CALL(*snapshot, get(_)).WillRepeatedly(Return("1"_buf));
+  EXPECT_CALL(*snapshot, getMany(_))
+      .WillOnce(Return(std::vector<boost::optional<Buffer>>{"1"_buf}));
+  EXPECT_CALL(*storage, getSnapshotAt("ABC"_hash256))
+      .WillOnce(Return(snapshot));
+
+  EXPECT_OUTCOME_TRUE_1(api.getStorage("a"_buf, "B"_hash256));
+  EXPECT_OUTCOME_TRUE_1(api.getStorage("b"_buf, "B"_hash256));
+  EXPECT_OUTCOME_TRUE_1(api.queryStorageAt({"a"_buf}, "B"_hash256));
+}
+
+/**
+ * @given state api
+ * @when get a proof of several keys at the last finalized block
+ * @then the proof of the keys at the state root of the block is built by the
+ * storage at once, without a snapshot of the state
+ */
+TEST(StateApiTest, GetReadProof) {
+  auto storage = std::make_shared<TrieStorageMock>();
+  auto block_header_repo = std::make_shared<BlockHeaderRepositoryMock>();
+  auto block_tree = std::make_shared<BlockTreeMock>();
+  auto runtime_core = std::make_shared<CoreMock>();
+
+  kagome::api::StateApiImpl api{
+      block_header_repo, storage, block_tree, runtime_core};
+
+  EXPECT_CALL(*block_tree, getLastFinalized())
+      .WillOnce(Return(BlockInfo(42, "D"_hash256)));
+  kagome::primitives::BlockId did = "D"_hash256;
+  EXPECT_CALL(*block_header_repo, getBlockHeader(did))
+      .WillOnce(Return(BlockHeader{.state_root = "CDE"_hash256}));
+  std::vector<Buffer> keys{"a"_buf, "b"_buf};
+  std::vector<Buffer> nodes{"node1"_buf, "node2"_buf};
+  EXPECT_CALL(*storage, getProofAt("CDE"_hash256, _))
+      .WillOnce(testing::Invoke([&](auto &, auto proved_keys) {
+        EXPECT_EQ(std::vector<Buffer>(proved_keys.begin(), proved_keys.end()),
+                  keys);
+        return nodes;
+      }));
+  EXPECT_CALL(*storage, getSnapshotAt(_)).Times(0);
+
+  EXPECT_OUTCOME_TRUE(proof, api.getReadProof(keys, boost::none));
+  ASSERT_EQ(proof.at, "D"_hash256);
+  ASSERT_EQ(proof.proof, nodes);
+}
+
 /**
  * @given state api
  * @when get a runtime version for the given block hash
@@ -10,6 +10,7 @@
 #include <unordered_map>
 
 #include "mock/core/api/jrpc/jrpc_server_mock.hpp"
+#include "api/service/state/requests/get_keys_paged.hpp"
 #include "mock/core/api/service/state/state_api_mock.hpp"
 #include "testutil/literals.hpp"
 
@@ -25,6 +26,10 @@ class StateJrpcProcessorTest : public testing::Test {
   enum struct CallType {
     kCallType_GetRuntimeVersion = 0,
     kCallType_GetStorage,
+    kCallType_QueryStorageAt,
+    kCallType_QueryStorage,
+    kCallType_GetKeysPaged,
+    kCallType_GetPairs,
   };
 
  private:
@@ -49,6 +54,29 @@ class StateJrpcProcessorTest : public testing::Test {
           call_contexts_.emplace(std::make_pair(CallType::kCallType_GetStorage,
                                                 CallContext{.handler = f}));
         }));
+    EXPECT_CALL(*server, registerHandler("state_queryStorageAt", _))
+        .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
+          call_contexts_.emplace(
+              std::make_pair(CallType::kCallType_QueryStorageAt,
+                             CallContext{.handler = f}));
+        }));
+    EXPECT_CALL(*server, registerHandler("state_queryStorage", _))
+        .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
+          call_contexts_.emplace(
+              std::make_pair(CallType::kCallType_QueryStorage,
+                             CallContext{.handler = f}));
+        }));
+    EXPECT_CALL(*server, registerHandler("state_getKeysPaged", _))
+        .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
+          call_contexts_.emplace(
+              std::make_pair(CallType::kCallType_GetKeysPaged,
+                             CallContext{.handler = f}));
+        }));
+    EXPECT_CALL(*server, registerHandler("state_getPairs", _))
+        .WillOnce(testing::Invoke([&](auto &name, auto &&f) {
+          call_contexts_.emplace(std::make_pair(CallType::kCallType_GetPairs,
+                                                CallContext{.handler = f}));
+        }));
     processor.registerHandlers();
   }
 
@@ -153,3 +181,120 @@ TEST_F(StateJrpcProcessorTest, ProcessGetVersionRequest) {
   ASSERT_EQ(result["specVersion"].AsInteger64(), test_version.spec_version);
   ASSERT_EQ(result["implVersion"].AsInteger64(), test_version.impl_version);
 }
+
+/**
+ * @given a request of state_queryStorageAt with a list of keys and a block
+ * @when processing it
+ * @then the values of the keys are returned, with null for an absent one
+ */
+TEST_F(StateJrpcProcessorTest, ProcessQueryStorageAtRequest) {
+  std::vector<Buffer> keys{"0102"_hex2buf, "0304"_hex2buf};
+  boost::optional<kagome::primitives::BlockHash> at = "010203"_hash256;
+  kagome::primitives::StorageChangeSet change_set{
+      .block = "010203"_hash256,
+      .changes = {{"0102"_hex2buf, "abcd"_hex2buf}, {"0304"_hex2buf, {}}}};
+  EXPECT_CALL(*state_api, queryStorageAt(keys, at))
+      .WillOnce(testing::Return(
+          std::vector<kagome::primitives::StorageChangeSet>{change_set}));
+
+  registerHandlers();
+
+  jsonrpc::Value::Array keys_param{"0x0102", "0x0304"};
+  jsonrpc::Request::Parameters params{keys_param,
+                                      "0x" + ("010203"_hash256).toHex()};
+  auto result = execute(CallType::kCallType_QueryStorageAt, params).AsArray();
+  ASSERT_EQ(result.size(), 1);
+  auto change_set_value = result[0].AsStruct();
+  auto changes = change_set_value["changes"].AsArray();
+  ASSERT_EQ(changes.size(), 2);
+  ASSERT_EQ(changes[0].AsArray()[1].AsArray().size(), 2);
+  ASSERT_TRUE(changes[1].AsArray()[1].IsNil());
+}
+
+/**
+ * @given a request of state_queryStorage with a list of keys and a range of
+ * blocks without its end
+ * @when processing it
+ * @then the change sets of the range up to the last finalized block are
+ * returned
+ */
+TEST_F(StateJrpcProcessorTest, ProcessQueryStorageRequest) {
+  std::vector<Buffer> keys{"0102"_hex2buf};
+  boost::optional<kagome::primitives::BlockHash> to = boost::none;
+  std::vector<kagome::primitives::StorageChangeSet> change_sets{
+      {.block = "01"_hash256, .changes = {{"0102"_hex2buf, "ab"_hex2buf}}},
+      {.block = "02"_hash256, .changes = {{"0102"_hex2buf, {}}}}};
+  EXPECT_CALL(*state_api, queryStorage(keys, "01"_hash256, to))
+      .WillOnce(testing::Return(change_sets));
+
+  registerHandlers();
+
+  jsonrpc::Value::Array keys_param{"0x0102"};
+  jsonrpc::Request::Parameters params{keys_param,
+                                      "0x" + ("01"_hash256).toHex()};
+  auto result = execute(CallType::kCallType_QueryStorage, params).AsArray();
+  ASSERT_EQ(result.size(), 2);
+  auto changes = result[1].AsStruct()["changes"].AsArray();
+  ASSERT_EQ(changes.size(), 1);
+  ASSERT_TRUE(changes[0].AsArray()[1].IsNil());
+}
+
+/**
+ * @given a request of state_getKeysPaged with a prefix, a count and a
+ * previous key
+ * @when processing it
+ * @then the keys of the page are returned
+ */
+TEST_F(StateJrpcProcessorTest, ProcessGetKeysPagedRequest) {
+  boost::optional<Buffer> prefix = "01"_hex2buf;
+  boost::optional<Buffer> prev_key = "0102"_hex2buf;
+  boost::optional<kagome::primitives::BlockHash> at = boost::none;
+  EXPECT_CALL(*state_api, getKeysPaged(prefix, 2, prev_key, at))
+      .WillOnce(testing::Return(
+          std::vector<Buffer>{"0103"_hex2buf, "0104"_hex2buf}));
+
+  registerHandlers();
+
+  jsonrpc::Request::Parameters params{"0x01", 2, "0x0102"};
+  auto result = execute(CallType::kCallType_GetKeysPaged, params).AsArray();
+  ASSERT_EQ(result.size(), 2);
+  ASSERT_EQ(result[0].AsArray().size(), 2);
+}
+
+/**
+ * @given a request of state_getKeysPaged with a count greater than the page
+ * limit
+ * @when processing it
+ * @then InvalidParametersFault exception is thrown
+ */
+TEST_F(StateJrpcProcessorTest, GetKeysPagedTooManyKeys) {
+  registerHandlers();
+
+  jsonrpc::Request::Parameters params{
+      "0x01",
+      kagome::api::state::request::GetKeysPaged::kMaxKeysAmount + 1};
+  ASSERT_THROW(execute(CallType::kCallType_GetKeysPaged, params),
+               jsonrpc::InvalidParametersFault);
+}
+
+/**
+ * @given a request of state_getPairs with a prefix
+ * @when processing it
+ * @then key-value pairs are returned as arrays of two elements
+ */
+TEST_F(StateJrpcProcessorTest, ProcessGetPairsRequest) {
+  boost::optional<kagome::primitives::BlockHash> at = boost::none;
+  EXPECT_CALL(*state_api, getPairs("01"_hex2buf, at))
+      .WillOnce(testing::Return(std::vector<std::pair<Buffer, Buffer>>{
+          {"0103"_hex2buf, "ab"_hex2buf}}));
+
+  registerHandlers();
+
+  jsonrpc::Request::Parameters params{"0x01"};
+  auto result = execute(CallType::kCallType_GetPairs, params).AsArray();
+  ASSERT_EQ(result.size(), 1);
+  auto pair = result[0].AsArray();
+  ASSERT_EQ(pair.size(), 2);
+  ASSERT_EQ(pair[0].AsArray().size(), 2);
+  ASSERT_EQ(pair[1].AsArray().size(), 1);
+}
@@ -0,0 +1,233 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/service/subscription/subscription_engine.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "common/hexutil.hpp"
+#include "mock/core/api/jrpc/jrpc_server_mock.hpp"
+#include "mock/core/api/service/state/state_api_mock.hpp"
+#include "mock/core/api/transport/session_mock.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace kagome;
+using namespace api;
+using primitives::StorageChangeSet;
+using subscription::ChainEvents;
+using testing::_;
+using testing::Eq;
+using testing::Invoke;
+using testing::Return;
+
+using Topic = SubscriptionEngine::Topic;
+
+namespace {
+  /**
+   * Formats the binaries as hex strings, the structs, which are the headers,
+   * as `header`
+   */
+  std::string fakeEncode(const jsonrpc::Value &value) {
+    if (value.IsNil()) {
+      return "null";
+    }
+    if (value.IsBinary()) {
+      return '"' + common::hex_lower(value.AsBinary()) + '"';
+    }
+    if (value.IsArray()) {
+      std::string result = "[";
+      for (auto &item : value.AsArray()) {
+        result += (result.size() > 1 ? "," : "") + fakeEncode(item);
+      }
+      return result + "]";
+    }
+    return "header";
+  }
+
+  std::string notification(const std::string &method,
+                           const std::string &result,
+                           SubscriptionEngine::SubscriptionId id) {
+    return R"({"jsonrpc":"2.0","method":")" + method
+           + R"(","params":{"result":)" + result + R"(,"subscription":)"
+           + std::to_string(id) + "}}";
+  }
+}  // namespace
+
+class SubscriptionEngineTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ON_CALL(*server_, encode(_)).WillByDefault(Invoke(fakeEncode));
+    engine_ = std::make_shared<SubscriptionEngine>(server_, events_, state_);
+  }
+
+  std::shared_ptr<SessionMock> makeSession(
+      Session::Type type = Session::Type::WEBSOCKET) {
+    auto session = std::make_shared<testing::NiceMock<SessionMock>>();
+    ON_CALL(*session, type()).WillByDefault(Return(type));
+    return session;
+  }
+
+  SubscriptionEngine::SubscriptionId subscribeHeads(
+      const std::shared_ptr<Session> &session, Topic topic) {
+    SubscriptionEngine::SessionScope scope{session};
+    EXPECT_OUTCOME_TRUE(id, engine_->subscribeHeads(topic));
+    return id;
+  }
+
+  SubscriptionEngine::SubscriptionId subscribeStorage(
+      const std::shared_ptr<Session> &session,
+      const std::vector<common::Buffer> &keys) {
+    SubscriptionEngine::SessionScope scope{session};
+    EXPECT_OUTCOME_TRUE(id, engine_->subscribeStorage(keys));
+    return id;
+  }
+
+  std::shared_ptr<testing::NiceMock<JRpcServerMock>> server_ =
+      std::make_shared<testing::NiceMock<JRpcServerMock>>();
+  std::shared_ptr<ChainEvents> events_ = std::make_shared<ChainEvents>();
+  std::shared_ptr<StateApiMock> state_ = std::make_shared<StateApiMock>();
+  std::shared_ptr<SubscriptionEngine> engine_;
+
+  primitives::BlockHash block_ = "block"_hash256;
+  primitives::BlockHeader header_{};
+};
+
+/**
+ * @given the websocket sessions subscribed to the new heads, and another one
+ * subscribed to the finalized heads
+ * @when a new head is raised
+ * @then it is formatted once and sent to each of the subscribed sessions
+ * under their subscription ids, but to the other one
+ */
+TEST_F(SubscriptionEngineTest, NewHeads) {
+  auto session1 = makeSession();
+  auto session2 = makeSession();
+  auto session3 = makeSession();
+  auto id1 = subscribeHeads(session1, Topic::NEW_HEADS);
+  auto id2 = subscribeHeads(session2, Topic::NEW_HEADS);
+  subscribeHeads(session3, Topic::FINALIZED_HEADS);
+  ASSERT_NE(id1, id2);
+
+  EXPECT_CALL(*server_, encode(_)).Times(1);
+  EXPECT_CALL(*session1,
+              respond(Eq(
+                  notification("chain_newHead", "header", id1))));
+  EXPECT_CALL(*session2,
+              respond(Eq(
+                  notification("chain_newHead", "header", id2))));
+  EXPECT_CALL(*session3, respond(_)).Times(0);
+  events_->new_head(block_, header_);
+}
+
+/**
+ * @given a session, which is not a websocket one, and no session at all
+ * @when they subscribe to the heads
+ * @then they are refused
+ */
+TEST_F(SubscriptionEngineTest, WebsocketOnly) {
+  EXPECT_OUTCOME_FALSE(no_session, engine_->subscribeHeads(Topic::NEW_HEADS));
+  EXPECT_EQ(no_session, SubscriptionEngine::Error::NO_SESSION);
+
+  SubscriptionEngine::SessionScope scope{makeSession(Session::Type::HTTP)};
+  EXPECT_OUTCOME_FALSE(http, engine_->subscribeHeads(Topic::NEW_HEADS));
+  EXPECT_EQ(http, SubscriptionEngine::Error::NOT_WEBSOCKET);
+}
+
+/**
+ * @given the sessions subscribed to some keys and to all the keys
+ * @when the changes of the keys of a block are raised
+ * @then the values of the keys anybody is subscribed to are read at once,
+ * each of them is formatted once, and each session is sent the ones it is
+ * subscribed to
+ */
+TEST_F(SubscriptionEngineTest, StorageChanges) {
+  auto a = "0a"_hex2buf;
+  auto b = "0b"_hex2buf;
+  auto c = "0c"_hex2buf;
+  auto d = "0d"_hex2buf;
+  auto session1 = makeSession();
+  auto session2 = makeSession();
+  auto session3 = makeSession();
+  auto id1 = subscribeStorage(session1, {a, b, b});
+  auto id2 = subscribeStorage(session2, {b});
+  auto id3 = subscribeStorage(session3, {});
+
+  StorageChangeSet values{block_, {{b, "01"_hex2buf}, {c, boost::none}}};
+  EXPECT_CALL(*state_,
+              queryStorageAt(std::vector<common::Buffer>{b, c},
+                             boost::optional<primitives::BlockHash>{block_}))
+      .WillOnce(Return(std::vector<StorageChangeSet>{values}));
+  // a pair for each key and the block hash
+  EXPECT_CALL(*server_, encode(_)).Times(3);
+
+  auto block = '"' + block_.toHex() + '"';
+  auto change_b = R"(["0b","01"])";
+  auto change_c = R"(["0c",null])";
+  EXPECT_CALL(
+      *session1,
+      respond(Eq(notification(
+          "state_storage",
+          R"({"block":)" + block + R"(,"changes":[)" + change_b + "]}",
+          id1))));
+  EXPECT_CALL(
+      *session2,
+      respond(Eq(notification(
+          "state_storage",
+          R"({"block":)" + block + R"(,"changes":[)" + change_b + "]}",
+          id2))));
+  EXPECT_CALL(*session3,
+              respond(Eq(notification(
+                  "state_storage",
+                  R"({"block":)" + block + R"(,"changes":[)" + change_b + ","
+                      + change_c + "]}",
+                  id3))));
+  events_->storage_changes(block_, {b, c});
+
+  // nobody is subscribed to the key
+  subscribeStorage(session1, {a});
+  EXPECT_CALL(*state_, queryStorageAt(_, _)).Times(0);
+  engine_->removeSession(session3->id());
+  events_->storage_changes(block_, {d});
+}
+
+/**
+ * @given the sessions subscribed to the heads
+ * @when they cancel the subscriptions, their own and of the other topics and
+ * sessions, and one of them is closed
+ * @then only their own subscriptions to the topic are cancelled, and all the
+ * ones of the closed session
+ */
+TEST_F(SubscriptionEngineTest, Unsubscribe) {
+  auto session1 = makeSession();
+  auto session2 = makeSession();
+  auto id1 = subscribeHeads(session1, Topic::NEW_HEADS);
+  auto id2 = subscribeHeads(session2, Topic::NEW_HEADS);
+  subscribeHeads(session2, Topic::FINALIZED_HEADS);
+
+  {
+    SubscriptionEngine::SessionScope scope{session1};
+    EXPECT_OUTCOME_TRUE(other_session,
+                        engine_->unsubscribe(Topic::NEW_HEADS, id2));
+    EXPECT_FALSE(other_session);
+    EXPECT_OUTCOME_TRUE(other_topic,
+                        engine_->unsubscribe(Topic::FINALIZED_HEADS, id1));
+    EXPECT_FALSE(other_topic);
+    EXPECT_OUTCOME_TRUE(own, engine_->unsubscribe(Topic::NEW_HEADS, id1));
+    EXPECT_TRUE(own);
+    EXPECT_OUTCOME_TRUE(again, engine_->unsubscribe(Topic::NEW_HEADS, id1));
+    EXPECT_FALSE(again);
+  }
+
+  EXPECT_CALL(*session1, respond(_)).Times(0);
+  EXPECT_CALL(*session2, respond(_)).Times(1);
+  events_->new_head(block_, header_);
+
+  engine_->removeSession(session2->id());
+  EXPECT_CALL(*server_, encode(_)).Times(0);
+  events_->new_head(block_, header_);
+  events_->finalized_head(block_, header_);
+}
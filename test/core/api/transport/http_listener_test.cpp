@@ -43,3 +43,46 @@ TEST_F(HttpListenerTest, EchoSuccess) {
   ASSERT_NO_THROW(service->stop());
   ASSERT_NO_THROW(listener->start());
 }
+
+/**
+ * @given runing HTTP transport based RPC service
+ * @when two requests are sent over one connection before any of the responses
+ * is read
+ * @then both of them are responded to in order, and the connection is kept
+ * alive
+ */
+TEST_F(HttpListenerTest, PipelinedRequests) {
+  namespace http = boost::beast::http;
+
+  ASSERT_NO_THROW(listener->prepare());
+  ASSERT_NO_THROW(service->prepare());
+
+  ASSERT_NO_THROW(listener->start());
+  ASSERT_NO_THROW(service->start());
+
+  std::thread client_thread([this] {
+    boost::beast::tcp_stream stream{*client_context};
+    stream.connect(listener_config.endpoint);
+
+    http::request<http::string_body> req{http::verb::post, "/", 11};
+    req.keep_alive(true);
+    req.body() = request;
+    req.prepare_payload();
+    http::write(stream, req);
+    http::write(stream, req);
+
+    boost::beast::flat_buffer buffer;
+    for (auto i = 0; i < 2; ++i) {
+      http::response<http::string_body> res;
+      http::read(stream, buffer, res);
+      EXPECT_EQ(res.body(), response);
+      EXPECT_TRUE(res.keep_alive());
+    }
+    main_context->stop();
+  });
+
+  main_context->run_for(std::chrono::seconds(2));
+  client_thread.join();
+
+  ASSERT_NO_THROW(service->stop());
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/rpc_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace kagome;
+using namespace api;
+using namespace std::chrono_literals;
+
+class RpcMetricsTest : public testing::Test {
+ public:
+  RpcMetrics metrics_{RpcMetrics::Configuration{100ms}};
+};
+
+/**
+ * @given rpc metrics with a slow call threshold
+ * @when the calls of the methods are started, finished and refused
+ * @then they are reported by the methods, along with the errors, the slow
+ * calls and the sizes, and forgotten after the reset, but the calls in flight
+ */
+TEST_F(RpcMetricsTest, Calls) {
+  metrics_.recordStarted();
+  metrics_.recordStarted();
+  metrics_.recordStarted();
+  metrics_.recordStarted();
+  auto method = "chain_getHeader";
+  EXPECT_FALSE(metrics_.recordFinished(method, 2ms, 100, 500, false));
+  EXPECT_TRUE(metrics_.recordFinished(method, 200ms, 300, 100, true));
+  metrics_.recordRefused("state_getPairs", 50);
+
+  auto report = metrics_.report();
+  EXPECT_EQ(report.in_flight, 1);
+  EXPECT_EQ(report.max_in_flight, 4);
+  ASSERT_EQ(report.methods.size(), 2);
+  auto &header = report.methods.at(method);
+  EXPECT_EQ(header.calls, 2);
+  EXPECT_EQ(header.errors, 1);
+  EXPECT_EQ(header.slow, 1);
+  EXPECT_EQ(header.refused, 0);
+  EXPECT_EQ(header.latency.max, 200ms);
+  EXPECT_EQ(header.requests.total, 400);
+  EXPECT_EQ(header.requests.max, 300);
+  EXPECT_EQ(header.responses.total, 600);
+  EXPECT_EQ(header.responses.max, 500);
+  auto &pairs = report.methods.at("state_getPairs");
+  EXPECT_EQ(pairs.calls, 0);
+  EXPECT_EQ(pairs.refused, 1);
+
+  metrics_.reset();
+  report = metrics_.report();
+  EXPECT_TRUE(report.methods.empty());
+  EXPECT_EQ(report.in_flight, 1);
+  EXPECT_EQ(report.max_in_flight, 1);
+}
+
+/**
+ * @given rpc metrics
+ * @when more methods than are recorded by their names are called, and a
+ * request of an unknown method
+ * @then the calls over the limit and the unknown one are recorded together
+ */
+TEST_F(RpcMetricsTest, MethodsLimit) {
+  for (size_t i = 0; i < RpcMetrics::kMaxMethods + 10; i++) {
+    metrics_.recordFinished("method" + std::to_string(i), 1ms, 10, 10, false);
+  }
+  metrics_.recordFinished("", 1ms, 10, 10, true);
+
+  auto report = metrics_.report();
+  EXPECT_EQ(report.methods.size(), RpcMetrics::kMaxMethods + 1);
+  auto &other = report.methods.at(std::string{RpcMetrics::kOtherMethods});
+  EXPECT_EQ(other.calls, 11);
+  EXPECT_EQ(other.errors, 1);
+}
+
+/**
+ * @given rpc metrics with the slow calls not told
+ * @when a long call is finished
+ * @then it is not a slow one
+ */
+TEST(RpcMetricsNoThresholdTest, NoSlowCalls) {
+  RpcMetrics metrics{RpcMetrics::Configuration{0ms}};
+  EXPECT_FALSE(metrics.recordFinished("system_health", 1h, 1, 1, false));
+}
+
+/**
+ * @given rpc metrics
+ * @when the sessions are opened and closed
+ * @then the open ones are reported by the transports
+ */
+TEST_F(RpcMetricsTest, Sessions) {
+  metrics_.recordSessionOpened(Session::Type::HTTP);
+  metrics_.recordSessionOpened(Session::Type::WEBSOCKET);
+  metrics_.recordSessionOpened(Session::Type::WEBSOCKET);
+  metrics_.recordSessionClosed(Session::Type::WEBSOCKET);
+  metrics_.recordSessionOpened(Session::Type::UNIX);
+
+  metrics_.reset();
+  auto report = metrics_.report();
+  EXPECT_EQ(report.http_sessions, 1);
+  EXPECT_EQ(report.ws_sessions, 1);
+  EXPECT_EQ(report.unix_sessions, 1);
+}
+
+/**
+ * @given rpc metrics of a call
+ * @when they are collected for the scrapes
+ * @then the call is exported under its method, and the sessions under their
+ * transports
+ */
+TEST_F(RpcMetricsTest, Collect) {
+  metrics_.recordStarted();
+  metrics_.recordFinished("chain_getBlock", 1ms, 10, 20, true);
+  metrics_.recordSessionOpened(Session::Type::HTTP);
+
+  common::MetricsRegistry registry;
+  registry.addCollector([this](common::MetricsRegistry::Writer &writer) {
+    metrics_.collect(writer);
+  });
+  auto text = registry.exposition();
+  for (auto sample : {"kagome_rpc_calls_total{method=\"chain_getBlock\"} 1",
+                      "kagome_rpc_errors_total{method=\"chain_getBlock\"} 1",
+                      "kagome_rpc_response_bytes_total{method="
+                      "\"chain_getBlock\"} 20",
+                      "kagome_rpc_call_seconds_count{method="
+                      "\"chain_getBlock\"} 1",
+                      "kagome_rpc_calls_in_flight 0",
+                      "kagome_rpc_sessions{transport=\"http\"} 1"}) {
+    EXPECT_NE(text.find(std::string{sample} + "\n"), std::string::npos)
+        << sample;
+  }
+  EXPECT_NE(text.find("# TYPE kagome_rpc_call_seconds summary\n"),
+            std::string::npos);
+}
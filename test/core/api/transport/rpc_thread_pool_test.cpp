@@ -0,0 +1,73 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/rpc_thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::api::RpcContext;
+using kagome::api::RpcThreadPool;
+using Lane = RpcThreadPool::Lane;
+
+/**
+ * The pool is not started, so that its tasks are run by the test, one by one
+ */
+class RpcThreadPoolTest : public testing::Test {
+ public:
+  std::shared_ptr<RpcThreadPool> makePool(size_t max_threads,
+                                          size_t max_expensive,
+                                          size_t max_queued) {
+    RpcThreadPool::Configuration config;
+    config.max_thread_number = max_threads;
+    config.max_expensive_calls = max_expensive;
+    config.max_queued_expensive_calls = max_queued;
+    return std::make_shared<RpcThreadPool>(context_, config);
+  }
+
+  RpcThreadPool::Task record(int id) {
+    return [this, id] { run_.push_back(id); };
+  }
+
+  std::shared_ptr<RpcContext> context_ = std::make_shared<RpcContext>();
+  std::vector<int> run_;
+};
+
+/**
+ * @given a pool running one expensive call at a time, which keeps one of them
+ * waiting
+ * @when more of the expensive calls are submitted
+ * @then the second one waits for the first one, the third one is rejected,
+ * and the cheap ones are not held up by them
+ */
+TEST_F(RpcThreadPoolTest, ExpensiveLimit) {
+  auto pool = makePool(2, 1, 1);
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(1)));
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(2)));
+  EXPECT_FALSE(pool->submit(Lane::EXPENSIVE, record(3)));
+  EXPECT_TRUE(pool->submit(Lane::CHEAP, record(4)));
+
+  context_->poll();
+  EXPECT_EQ(run_, (std::vector<int>{1, 4, 2}));
+}
+
+/**
+ * @given a pool running one expensive call at a time, out of four threads
+ * @when the expensive calls are submitted while there are no cheap ones
+ * @then they take the idle capacity of the cheap lane, but for a thread, and
+ * the rest of them wait
+ */
+TEST_F(RpcThreadPoolTest, StealIdleCapacity) {
+  auto pool = makePool(4, 1, 1);
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(1)));
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(2)));
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(3)));
+  // all the threads but one are taken, so this one waits
+  EXPECT_TRUE(pool->submit(Lane::EXPENSIVE, record(4)));
+  EXPECT_FALSE(pool->submit(Lane::EXPENSIVE, record(5)));
+
+  EXPECT_TRUE(pool->submit(Lane::CHEAP, record(6)));
+  context_->poll();
+  EXPECT_EQ(run_, (std::vector<int>{1, 2, 3, 6, 4}));
+}
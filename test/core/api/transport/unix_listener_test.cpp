@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/impl/unix/unix_listener_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/filesystem.hpp>
+
+#include "api/jrpc/jrpc_server_impl.hpp"
+#include "api/service/api_service.hpp"
+#include "application/impl/app_state_manager_impl.hpp"
+#include "mock/core/api/transport/api_stub.hpp"
+#include "mock/core/api/transport/jrpc_processor_stub.hpp"
+
+using kagome::api::ApiService;
+using kagome::api::ApiStub;
+using kagome::api::JRpcProcessor;
+using kagome::api::JrpcProcessorStub;
+using kagome::api::JRpcServer;
+using kagome::api::JRpcServerImpl;
+using kagome::api::Listener;
+using kagome::api::RpcContext;
+using kagome::api::RpcThreadPool;
+using kagome::api::Session;
+using kagome::api::UnixListenerImpl;
+using kagome::api::UnixSession;
+using kagome::application::AppStateManagerImpl;
+using Client = boost::asio::local::stream_protocol::socket;
+
+class UnixListenerTest : public testing::Test {
+ public:
+  void TearDown() override {
+    boost::filesystem::remove(path);
+  }
+
+  std::shared_ptr<UnixListenerImpl> makeListener(bool binary) {
+    UnixSession::Configuration session_config{};
+    session_config.binary = binary;
+    return std::make_shared<UnixListenerImpl>(
+        app_state_manager,
+        main_context,
+        UnixListenerImpl::Configuration{path},
+        session_config);
+  }
+
+  std::shared_ptr<RpcContext> main_context = std::make_shared<RpcContext>(1);
+  boost::asio::io_context client_context;
+
+  std::string path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path("kagome_rpc_%%%%%%%%.sock"))
+          .string();
+
+  std::shared_ptr<AppStateManagerImpl> app_state_manager =
+      std::make_shared<AppStateManagerImpl>();
+};
+
+/**
+ * @given RPC service listening at a unix socket
+ * @when a client writes two requests as lines at once
+ * @then it reads the responses to both of them as lines
+ */
+TEST_F(UnixListenerTest, EchoSuccess) {
+  auto listener = makeListener(false);
+  auto thread_pool = std::make_shared<RpcThreadPool>(
+      main_context, RpcThreadPool::Configuration{1, 1});
+  std::shared_ptr<JRpcServer> server = std::make_shared<JRpcServerImpl>();
+  std::vector<std::shared_ptr<JRpcProcessor>> processors{
+      std::make_shared<JrpcProcessorStub>(server, std::make_shared<ApiStub>())};
+  auto service = std::make_shared<ApiService>(
+      app_state_manager,
+      thread_pool,
+      std::vector<std::shared_ptr<Listener>>{listener},
+      server,
+      processors);
+
+  ASSERT_NO_THROW(listener->prepare());
+  ASSERT_NO_THROW(service->prepare());
+  ASSERT_NO_THROW(listener->start());
+  ASSERT_NO_THROW(service->start());
+
+  auto request = [](int id) {
+    return R"({"jsonrpc":"2.0","method":"echo","id":)" + std::to_string(id)
+           + R"(,"params":[)" + std::to_string(id * 10) + "]}\n";
+  };
+  auto response = [](int id) {
+    return R"({"jsonrpc":"2.0","id":)" + std::to_string(id) + R"(,"result":)"
+           + std::to_string(id * 10) + "}";
+  };
+  std::vector<std::string> responses;
+  std::thread client_thread([&] {
+    Client client{client_context};
+    client.connect({path});
+    boost::asio::write(client, boost::asio::buffer(request(1) + request(2)));
+    std::string buffer;
+    for (auto i = 0; i < 2; ++i) {
+      auto size = boost::asio::read_until(
+          client, boost::asio::dynamic_buffer(buffer), '\n');
+      responses.emplace_back(buffer.substr(0, size - 1));
+      buffer.erase(0, size);
+    }
+    main_context->stop();
+  });
+
+  main_context->run_for(std::chrono::seconds(2));
+  client_thread.join();
+  ASSERT_NO_THROW(service->stop());
+
+  std::sort(responses.begin(), responses.end());
+  ASSERT_EQ(responses, (std::vector{response(1), response(2)}));
+}
+
+/**
+ * @given a listener at a unix socket, which sessions speak binary messages
+ * @when a client writes a message prefixed with its length and disconnects
+ * @then the message is given to the session and the response is read
+ * prefixed with its length, and the socket file is removed once the listener
+ * is stopped
+ */
+TEST_F(UnixListenerTest, BinaryMessages) {
+  auto listener = makeListener(true);
+  listener->setHandlerForNewSession([](const std::shared_ptr<Session> &session) {
+    session->connectOnRequest(
+        [](std::string_view request, std::shared_ptr<Session> session) {
+          session->respond("re:" + std::string{request});
+        });
+  });
+  listener->prepare();
+  listener->start();
+  ASSERT_TRUE(boost::filesystem::exists(path));
+
+  std::string response;
+  std::thread client_thread([&] {
+    Client client{client_context};
+    client.connect({path});
+    boost::asio::write(client,
+                       boost::asio::buffer(std::string{"\x03\0\0\0abc", 7}));
+    std::string prefix(4, '\0');
+    boost::asio::read(client, boost::asio::buffer(prefix));
+    response.resize(static_cast<uint8_t>(prefix[0]));
+    boost::asio::read(client, boost::asio::buffer(response));
+    main_context->stop();
+  });
+
+  main_context->run_for(std::chrono::seconds(2));
+  client_thread.join();
+
+  ASSERT_EQ(response, "re:abc");
+  listener->stop();
+  ASSERT_FALSE(boost::filesystem::exists(path));
+}
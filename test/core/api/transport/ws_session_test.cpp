@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "api/transport/impl/ws/ws_session.hpp"
+
+#include <future>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <boost/asio/executor_work_guard.hpp>
+
+using kagome::api::RpcContext;
+using kagome::api::WsSession;
+using Tcp = boost::asio::ip::tcp;
+
+/**
+ * The session is accepted from a client on the loopback and run on a thread
+ * of its own, while the client is driven by the test. The socket buffers of
+ * both are small, so that a client which does not read stalls the writes of
+ * the session soon
+ */
+class WsSessionTest : public testing::Test {
+ public:
+  static constexpr size_t kMaxQueuedMessages = 4;
+  static constexpr int kSocketBufferSize = 4096;
+
+  void SetUp() override {
+    WsSession::Configuration config;
+    config.max_queued_messages = kMaxQueuedMessages;
+    session_ = std::make_shared<WsSession>(context_, config);
+    session_->connectOnClose([this](WsSession::SessionId) {
+      closed_.set_value();
+    });
+
+    Tcp::acceptor acceptor{context_,
+                           {boost::asio::ip::address_v4::loopback(), 0}};
+    client_.next_layer().open(Tcp::v4());
+    client_.next_layer().set_option(
+        boost::asio::socket_base::receive_buffer_size{kSocketBufferSize});
+    client_.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(session_->socket());
+    session_->socket().set_option(
+        boost::asio::socket_base::send_buffer_size{kSocketBufferSize});
+
+    session_->start();
+    thread_ = std::thread{[this] { context_.run(); }};
+    client_.handshake("127.0.0.1", "/");
+  }
+
+  void TearDown() override {
+    work_.reset();
+    context_.stop();
+    thread_.join();
+  }
+
+  RpcContext context_;
+  boost::asio::executor_work_guard<RpcContext::executor_type> work_ =
+      boost::asio::make_work_guard(context_);
+  std::thread thread_;
+
+  boost::asio::io_context client_context_;
+  boost::beast::websocket::stream<Tcp::socket> client_{client_context_};
+
+  std::shared_ptr<WsSession> session_;
+  std::promise<void> closed_;
+};
+
+/**
+ * @given websocket session of a client, which does not read
+ * @when the session is given more messages than it queues
+ * @then the session is closed, its close handler is called, and the client
+ * is disconnected
+ */
+TEST_F(WsSessionTest, ClosedWhenClientDoesNotRead) {
+  // more than the socket buffers and the queue hold together
+  const std::string message(64 << 10, 'x');
+  for (size_t i = 0; i < 64; i++) {
+    session_->respond(message);
+  }
+
+  ASSERT_EQ(closed_.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+
+  // what is in the buffers is read, then the connection is found closed
+  boost::beast::flat_buffer buffer;
+  boost::system::error_code ec;
+  for (size_t i = 0; i < 64 and not ec; i++) {
+    client_.read(buffer, ec);
+    buffer.clear();
+  }
+  ASSERT_TRUE(ec);
+}
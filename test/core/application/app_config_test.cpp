@@ -139,10 +139,47 @@ TEST_F(AppConfigurationTest, DefaultValuesTest) {
                                     (char **)args);
 
   ASSERT_EQ(app_config_->p2p_port(), 30363);
+  ASSERT_EQ(app_config_->sync_bodies_batch_size(), 0);
+  ASSERT_EQ(app_config_->rpc_max_request_size(), 15ull << 20);
+  ASSERT_EQ(app_config_->rpc_slow_call_threshold(), 1000);
+  ASSERT_TRUE(app_config_->process_profiles_path().empty());
+  ASSERT_TRUE(app_config_->prometheus_endpoint());
+  ASSERT_EQ(*app_config_->prometheus_endpoint(),
+            get_endpoint("127.0.0.1", 9615));
+  ASSERT_FALSE(app_config_->rpc_scale_endpoint());
+  ASSERT_TRUE(app_config_->rpc_unix_socket_path().empty());
+  ASSERT_TRUE(app_config_->rpc_scale_unix_socket_path().empty());
+  ASSERT_FALSE(app_config_->warp_sync());
+  ASSERT_EQ(app_config_->storage_read_threads_num(), 2);
   ASSERT_EQ(app_config_->rpc_http_endpoint(), http_endpoint);
   ASSERT_EQ(app_config_->rpc_ws_endpoint(), ws_endpoint);
   ASSERT_EQ(app_config_->verbosity(), spdlog::level::level_enum::info);
   ASSERT_EQ(app_config_->is_only_finalizing(), false);
+  ASSERT_EQ(app_config_->state_pruning_depth(), 0);
+  ASSERT_EQ(app_config_->blocks_pruning_depth(), 0);
+  ASSERT_EQ(app_config_->justification_period(), 0);
+  ASSERT_TRUE(app_config_->state_snapshot_path().empty());
+  ASSERT_TRUE(app_config_->block_freezer_path().empty());
+  ASSERT_EQ(app_config_->block_freezer_compression(), 0);
+  ASSERT_EQ(app_config_->trie_key_filter_size(), 0);
+  ASSERT_EQ(app_config_->cache_budget(), 0);
+  ASSERT_FALSE(app_config_->flat_state());
+  ASSERT_EQ(app_config_->state_prefetch_threads(), 0);
+  ASSERT_TRUE(app_config_->transaction_pool_dump_path().empty());
+  ASSERT_EQ(app_config_->storage_backend(),
+            AppConfiguration::StorageBackend::kLevelDB);
+  ASSERT_EQ(app_config_->memory_storage_budget(), 0);
+  ASSERT_FALSE(app_config_->leveldb_group_commit());
+  ASSERT_TRUE(app_config_->leveldb_trie_path().empty());
+  ASSERT_TRUE(app_config_->leveldb_blocks_path().empty());
+  ASSERT_EQ(app_config_->trie_large_value_threshold(), 0);
+  ASSERT_EQ(app_config_->runtime_optimization_level(), 0);
+  ASSERT_TRUE(app_config_->runtime_cache_path().empty());
+  ASSERT_EQ(app_config_->runtime_instances_num(), 0);
+  ASSERT_FALSE(app_config_->runtime_profiling());
+  ASSERT_EQ(app_config_->offchain_workers_num(), 1);
+  ASSERT_EQ(app_config_->leveldb_block_cache_size(), 64ull << 20);
+  ASSERT_EQ(app_config_->leveldb_bloom_filter_bits(), 10);
 }
 
 /**
@@ -424,6 +461,645 @@ TEST_F(AppConfigurationTest, LevelDBPathTest) {
   ASSERT_EQ(app_config_->leveldb_path(), "leveldb_path");
 }
 
+/**
+ * @given new created AppConfigurationImpl
+ * @when --state_pruning_depth cmd line arg is provided
+ * @then we must receive this value from state_pruning_depth() call
+ */
+TEST_F(AppConfigurationTest, StatePruningDepthTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--state_pruning_depth",
+                        "256"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->state_pruning_depth(), 256);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --blocks_pruning_depth cmd line arg is provided
+ * @then we must receive this value from blocks_pruning_depth() call
+ */
+TEST_F(AppConfigurationTest, BlocksPruningDepthTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--blocks_pruning_depth",
+                        "4096"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->blocks_pruning_depth(), 4096);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --justification_period cmd line arg is provided
+ * @then we must receive this value from justification_period() call
+ */
+TEST_F(AppConfigurationTest, JustificationPeriodTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--justification_period",
+                        "512"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->justification_period(), 512);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --trie_large_value_threshold cmd line arg is provided
+ * @then we must receive this value from trie_large_value_threshold() call
+ */
+TEST_F(AppConfigurationTest, TrieLargeValueThresholdTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--trie_large_value_threshold",
+                        "1024"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->trie_large_value_threshold(), 1024);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --state_snapshot cmd line arg is provided
+ * @then we must receive this path from state_snapshot_path() call
+ */
+TEST_F(AppConfigurationTest, StateSnapshotTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--state_snapshot",
+                        "state.snapshot"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->state_snapshot_path(), "state.snapshot");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --block_freezer cmd line arg is provided
+ * @then we must receive this path from block_freezer_path() call
+ */
+TEST_F(AppConfigurationTest, BlockFreezerTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--block_freezer",
+                        "freezer"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->block_freezer_path(), "freezer");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --leveldb_trie and --leveldb_blocks cmd line args are provided
+ * @then we must receive these paths from leveldb_trie_path() and
+ * leveldb_blocks_path() calls
+ */
+TEST_F(AppConfigurationTest, LevelDBSeparatePathsTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--leveldb_trie",
+                        "nvme/trie",
+                        "--leveldb_blocks",
+                        "hdd/blocks"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->leveldb_path(), "leveldb_path");
+  ASSERT_EQ(app_config_->leveldb_trie_path(), "nvme/trie");
+  ASSERT_EQ(app_config_->leveldb_blocks_path(), "hdd/blocks");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --sync_bodies_batch_size cmd line arg is provided
+ * @then we must receive this value from sync_bodies_batch_size() call
+ */
+TEST_F(AppConfigurationTest, SyncBodiesBatchSizeTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--sync_bodies_batch_size",
+                        "64"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->sync_bodies_batch_size(), 64);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --rpc_max_request_size cmd line arg is provided
+ * @then we must receive this value from rpc_max_request_size() call
+ */
+TEST_F(AppConfigurationTest, RpcMaxRequestSizeTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--rpc_max_request_size",
+                        "1048576"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->rpc_max_request_size(), 1048576);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --rpc_slow_call_threshold cmd line arg is provided
+ * @then we must receive this value from rpc_slow_call_threshold() call
+ */
+TEST_F(AppConfigurationTest, RpcSlowCallThresholdTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--rpc_slow_call_threshold",
+                        "250"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->rpc_slow_call_threshold(), 250);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --process_profiles cmd line arg is provided
+ * @then we must receive this value from process_profiles_path() call
+ */
+TEST_F(AppConfigurationTest, ProcessProfilesTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--process_profiles",
+                        "profiles_path"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->process_profiles_path(), "profiles_path");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --prometheus_host and --prometheus_port cmd line args are provided
+ * @then we must receive the endpoint from prometheus_endpoint() call, and
+ * none if the port is 0
+ */
+TEST_F(AppConfigurationTest, PrometheusEndpointTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--prometheus_host",
+                        "0.0.0.0",
+                        "--prometheus_port",
+                        "9999"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+  ASSERT_TRUE(app_config_->prometheus_endpoint());
+  ASSERT_EQ(*app_config_->prometheus_endpoint(),
+            get_endpoint("0.0.0.0", 9999));
+
+  char const *disabled[] = {"/path/",
+                            "--genesis",
+                            "genesis_path",
+                            "--leveldb",
+                            "leveldb_path",
+                            "--keystore",
+                            "keystore path",
+                            "--prometheus_port",
+                            "0"};
+  auto config = std::make_shared<AppConfigurationImpl>(
+      kagome::common::createLogger("App config test"));
+  config->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                               sizeof(disabled) / sizeof(disabled[0]),
+                               (char **)disabled);
+  ASSERT_FALSE(config->prometheus_endpoint());
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --rpc_ws_host and --rpc_scale_port cmd line args are provided
+ * @then we must receive the endpoint at the websocket host from
+ * rpc_scale_endpoint() call
+ */
+TEST_F(AppConfigurationTest, RpcScaleEndpointTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--rpc_ws_host",
+                        "127.0.0.1",
+                        "--rpc_scale_port",
+                        "40365"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+  ASSERT_TRUE(app_config_->rpc_scale_endpoint());
+  ASSERT_EQ(*app_config_->rpc_scale_endpoint(),
+            get_endpoint("127.0.0.1", 40365));
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --rpc_unix_socket and --rpc_scale_unix_socket cmd line args are
+ * provided
+ * @then we must receive the paths from rpc_unix_socket_path() and
+ * rpc_scale_unix_socket_path() calls
+ */
+TEST_F(AppConfigurationTest, RpcUnixSocketTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--rpc_unix_socket",
+                        "/run/kagome/rpc.sock",
+                        "--rpc_scale_unix_socket",
+                        "/run/kagome/scale.sock"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+  ASSERT_EQ(app_config_->rpc_unix_socket_path(), "/run/kagome/rpc.sock");
+  ASSERT_EQ(app_config_->rpc_scale_unix_socket_path(),
+            "/run/kagome/scale.sock");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --warp_sync cmd line arg is provided
+ * @then we must receive true from warp_sync() call
+ */
+TEST_F(AppConfigurationTest, WarpSyncTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--warp_sync"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_TRUE(app_config_->warp_sync());
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --storage_read_threads_num cmd line arg is provided
+ * @then we must receive this value from storage_read_threads_num() call
+ */
+TEST_F(AppConfigurationTest, StorageReadThreadsNumTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--storage_read_threads_num",
+                        "4"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->storage_read_threads_num(), 4);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --trie_key_filter_size cmd line arg is provided
+ * @then we must receive this value from trie_key_filter_size() call
+ */
+TEST_F(AppConfigurationTest, TrieKeyFilterSizeTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--trie_key_filter_size",
+                        "1048576"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->trie_key_filter_size(), 1048576);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --cache_budget cmd line arg is provided
+ * @then we must receive this value from cache_budget() call
+ */
+TEST_F(AppConfigurationTest, CacheBudgetTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--cache_budget",
+                        "268435456"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->cache_budget(), 268435456);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --block_freezer_compression cmd line arg is provided
+ * @then we must receive this value from block_freezer_compression() call
+ */
+TEST_F(AppConfigurationTest, BlockFreezerCompressionTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--block_freezer_compression",
+                        "3"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->block_freezer_compression(), 3);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --flat_state cmd line arg is provided
+ * @then we must receive true from flat_state() call
+ */
+TEST_F(AppConfigurationTest, FlatStateTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--flat_state"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_TRUE(app_config_->flat_state());
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --state_prefetch_threads cmd line arg is provided
+ * @then we must receive this value from state_prefetch_threads() call
+ */
+TEST_F(AppConfigurationTest, StatePrefetchThreadsTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--state_prefetch_threads",
+                        "2"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->state_prefetch_threads(), 2);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --transaction_pool_dump cmd line arg is provided
+ * @then we must receive this path from transaction_pool_dump_path() call
+ */
+TEST_F(AppConfigurationTest, TransactionPoolDumpTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--transaction_pool_dump",
+                        "pool.dump"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->transaction_pool_dump_path(), "pool.dump");
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --storage_backend cmd line arg is provided
+ * @then we must receive this backend from storage_backend() call
+ */
+TEST_F(AppConfigurationTest, StorageBackendTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--storage_backend",
+                        "rocksdb"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+#ifdef KAGOME_WITH_ROCKSDB
+  ASSERT_EQ(app_config_->storage_backend(),
+            AppConfiguration::StorageBackend::kRocksDB);
+#else
+  // refused by the nodes built without it
+  ASSERT_EQ(app_config_->storage_backend(),
+            AppConfiguration::StorageBackend::kLevelDB);
+#endif
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when --runtime_optimization_level, --runtime_cache and
+ * --runtime_instances_num, --runtime_profiling and --offchain_workers_num cmd
+ * line args are provided
+ * @then we must receive these values from the corresponding calls
+ */
+TEST_F(AppConfigurationTest, RuntimeOptimizationLevelTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--runtime_optimization_level",
+                        "2",
+                        "--runtime_cache",
+                        "runtime_cache_path",
+                        "--runtime_instances_num",
+                        "8",
+                        "--runtime_profiling",
+                        "--offchain_workers_num",
+                        "0"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->runtime_optimization_level(), 2);
+  ASSERT_EQ(app_config_->runtime_cache_path(), "runtime_cache_path");
+  ASSERT_EQ(app_config_->runtime_instances_num(), 8);
+  ASSERT_TRUE(app_config_->runtime_profiling());
+  ASSERT_EQ(app_config_->offchain_workers_num(), 0);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when memory storage backend and its budget cmd line args are provided
+ * @then we must receive these values from the corresponding calls
+ */
+TEST_F(AppConfigurationTest, MemoryStorageTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--storage_backend",
+                        "memory",
+                        "--memory_storage_budget",
+                        "1073741824"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->storage_backend(),
+            AppConfiguration::StorageBackend::kMemory);
+  ASSERT_EQ(app_config_->memory_storage_budget(), 1073741824);
+}
+
+/**
+ * @given new created AppConfigurationImpl
+ * @when leveldb tuning cmd line args are provided
+ * @then we must receive these values from the corresponding calls
+ */
+TEST_F(AppConfigurationTest, LevelDBTuningTest) {
+  char const *args[] = {"/path/",
+                        "--genesis",
+                        "genesis_path",
+                        "--leveldb",
+                        "leveldb_path",
+                        "--keystore",
+                        "keystore path",
+                        "--leveldb_block_cache_size",
+                        "1048576",
+                        "--leveldb_bloom_filter_bits",
+                        "0",
+                        "--leveldb_write_buffer_size",
+                        "2097152",
+                        "--leveldb_max_open_files",
+                        "512",
+                        "--leveldb_group_commit"};
+  app_config_->initialize_from_args(AppConfiguration::LoadScheme::kValidating,
+                                    sizeof(args) / sizeof(args[0]),
+                                    (char **)args);
+
+  ASSERT_EQ(app_config_->leveldb_block_cache_size(), 1048576);
+  ASSERT_EQ(app_config_->leveldb_bloom_filter_bits(), 0);
+  ASSERT_EQ(app_config_->leveldb_write_buffer_size(), 2097152);
+  ASSERT_EQ(app_config_->leveldb_max_open_files(), 512);
+  ASSERT_TRUE(app_config_->leveldb_group_commit());
+}
+
 /**
  * @given new created AppConfigurationImpl
  * @when verbosity provided with value 1
@@ -5,6 +5,9 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "application/impl/app_state_manager_impl.hpp"
@@ -212,3 +215,90 @@ TEST_F(AppStateManagerTest, Run_CallSequence) {
 
   EXPECT_NO_THROW(app_state_manager->run());
 }
+
+/**
+ * @given callbacks of stage 'prepare' added with and without dependencies
+ * @when the stage is run
+ * @then each callback is run after its dependencies, and the ones added
+ * without them are run in the order they are added
+ */
+TEST_F(AppStateManagerTest, Prepare_Dependencies) {
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](int tag) {
+    return [&, tag] {
+      std::lock_guard lock(mutex);
+      order.push_back(tag);
+    };
+  };
+
+  atPrepare(record(1));
+  auto second = atPrepare(record(2), {});
+  auto third = atPrepare(record(3), {second});
+  atPrepare(record(4), {second, third});
+  atPrepare(record(5));
+
+  ASSERT_NO_THROW(doPrepare());
+  ASSERT_EQ(state(), AppStateManager::State::ReadyToStart);
+  ASSERT_EQ(order.size(), 5);
+  auto position = [&](int tag) {
+    return std::find(order.begin(), order.end(), tag) - order.begin();
+  };
+  EXPECT_LT(position(1), position(5));
+  EXPECT_LT(position(2), position(3));
+  EXPECT_LT(position(3), position(4));
+}
+
+/**
+ * @given two callbacks of stage 'prepare', which do not depend on each other
+ * and each of which waits for the other to start
+ * @when the stage is run
+ * @then they are run concurrently, so both of them finish
+ */
+TEST_F(AppStateManagerTest, Prepare_Concurrent) {
+  if (std::thread::hardware_concurrency() < 2) {
+    GTEST_SKIP() << "a single thread prepares";
+  }
+  std::mutex mutex;
+  std::condition_variable cv;
+  int started = 0;
+  auto meet = [&] {
+    std::unique_lock lock(mutex);
+    ++started;
+    cv.notify_all();
+    return cv.wait_for(
+        lock, std::chrono::seconds(10), [&] { return started == 2; });
+  };
+  bool met_first = false;
+  bool met_second = false;
+  atPrepare([&] { met_first = meet(); }, {});
+  atPrepare([&] { met_second = meet(); }, {});
+
+  ASSERT_NO_THROW(doPrepare());
+  EXPECT_TRUE(met_first);
+  EXPECT_TRUE(met_second);
+}
+
+/**
+ * @given a callback of stage 'prepare', which fails, and one depending on it
+ * @when the stage is run
+ * @then the exception is thrown from the stage, and the dependent callback
+ * is not run
+ */
+TEST_F(AppStateManagerTest, Prepare_Failure) {
+  auto failing = atPrepare([] { throw std::runtime_error("failed"); }, {});
+  EXPECT_CALL(*prepare_cb, call()).Times(0);
+  atPrepare([&] { (*prepare_cb)(); }, {failing});
+
+  EXPECT_THROW(doPrepare(), std::runtime_error);
+}
+
+/**
+ * @given new created AppStateManager
+ * @when a callback of stage 'prepare' depends on one not added
+ * @then exception is thrown
+ */
+TEST_F(AppStateManagerTest, Prepare_UnknownDependency) {
+  auto id = atPrepare([] {}, {});
+  EXPECT_THROW(atPrepare([] {}, {id + 1}), AppStateException);
+}
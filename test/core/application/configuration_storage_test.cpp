@@ -59,6 +59,7 @@ TEST_F(ConfigurationStorageTest, MatchesConfig) {
   EXPECT_OUTCOME_TRUE(config_storage, ConfigurationStorageImpl::create(path_));
 
   // then
-  ASSERT_EQ(config_storage->getGenesis(), expected_genesis_config_);
+  EXPECT_OUTCOME_TRUE(genesis, config_storage->getGenesis());
+  ASSERT_EQ(genesis, expected_genesis_config_);
   ASSERT_EQ(config_storage->getBootNodes(), expected_boot_nodes_);
 }
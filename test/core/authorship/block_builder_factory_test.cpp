@@ -9,6 +9,7 @@
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
 #include "mock/core/runtime/block_builder_api_mock.hpp"
 #include "mock/core/runtime/core_mock.hpp"
+#include "mock/core/runtime/trie_storage_provider_mock.hpp"
 #include "testutil/outcome.hpp"
 
 using ::testing::Return;
@@ -22,6 +23,7 @@ using kagome::primitives::Digest;
 using kagome::primitives::PreRuntime;
 using kagome::runtime::BlockBuilderApiMock;
 using kagome::runtime::CoreMock;
+using kagome::runtime::TrieStorageProviderMock;
 
 class BlockBuilderFactoryTest : public ::testing::Test {
  public:
@@ -42,6 +44,8 @@ class BlockBuilderFactoryTest : public ::testing::Test {
       std::make_shared<BlockBuilderApiMock>();
   std::shared_ptr<BlockHeaderRepositoryMock> header_backend_ =
       std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<TrieStorageProviderMock> storage_provider_ =
+      std::make_shared<TrieStorageProviderMock>();
 
   BlockNumber parent_number_{41};
   BlockNumber expected_number_{parent_number_ + 1};
@@ -62,7 +66,8 @@ TEST_F(BlockBuilderFactoryTest, CreateSuccessful) {
   // given
   EXPECT_CALL(*core_, initialise_block(expected_header_))
       .WillOnce(Return(outcome::success()));
-  BlockBuilderFactoryImpl factory(core_, block_builder_api_, header_backend_);
+  BlockBuilderFactoryImpl factory(
+      core_, block_builder_api_, header_backend_, storage_provider_);
 
   // when
   auto block_builder_res = factory.create(parent_id_, inherent_digests_);
@@ -82,7 +87,8 @@ TEST_F(BlockBuilderFactoryTest, CreateFailed) {
   // given
   EXPECT_CALL(*core_, initialise_block(expected_header_))
       .WillOnce(Return(outcome::failure(boost::system::error_code{})));
-  BlockBuilderFactoryImpl factory(core_, block_builder_api_, header_backend_);
+  BlockBuilderFactoryImpl factory(
+      core_, block_builder_api_, header_backend_, storage_provider_);
 
   // when
   auto block_builder_res = factory.create(parent_id_, inherent_digests_);
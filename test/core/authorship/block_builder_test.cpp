@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 #include "mock/core/runtime/block_builder_api_mock.hpp"
+#include "mock/core/runtime/trie_storage_provider_mock.hpp"
 #include "testutil/outcome.hpp"
 
 using ::testing::ElementsAre;
@@ -21,6 +22,7 @@ using kagome::primitives::BlockNumber;
 using kagome::primitives::Extrinsic;
 using kagome::primitives::InherentData;
 using kagome::runtime::BlockBuilderApiMock;
+using kagome::runtime::TrieStorageProviderMock;
 
 class BlockBuilderTest : public ::testing::Test {
  public:
@@ -28,13 +30,22 @@ class BlockBuilderTest : public ::testing::Test {
     // add some number to the header to make it possible to differentiate it
     expected_header_.number = number_;
 
-    block_builder_ = std::make_shared<BlockBuilderImpl>(expected_header_,
-                                                        block_builder_api_);
+    block_builder_ = std::make_shared<BlockBuilderImpl>(
+        expected_header_, block_builder_api_, storage_provider_);
+
+    EXPECT_CALL(*storage_provider_, startTransaction())
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*block_builder_api_, holdEnvironment())
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*block_builder_api_, releaseEnvironment())
+        .Times(testing::AnyNumber());
   }
 
  protected:
   std::shared_ptr<BlockBuilderApiMock> block_builder_api_ =
       std::make_shared<BlockBuilderApiMock>();
+  std::shared_ptr<TrieStorageProviderMock> storage_provider_ =
+      std::make_shared<TrieStorageProviderMock>();
 
   BlockHeader expected_header_;
   BlockNumber number_ = 123;
@@ -53,6 +64,8 @@ TEST_F(BlockBuilderTest, PushWhenApplyFails) {
   Extrinsic xt{};
   EXPECT_CALL(*block_builder_api_, apply_extrinsic(xt))
       .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_provider_, rollbackTransaction())
+      .WillOnce(Return(outcome::success()));
   EXPECT_CALL(*block_builder_api_, finalise_block())
       .WillOnce(Return(expected_header_));
 
@@ -76,6 +89,8 @@ TEST_F(BlockBuilderTest, PushWhenApplySucceedsWithTrue) {
   Extrinsic xt{};
   EXPECT_CALL(*block_builder_api_, apply_extrinsic(xt))
       .WillOnce(Return(ApplyOutcome::SUCCESS));
+  EXPECT_CALL(*storage_provider_, commitTransaction())
+      .WillOnce(Return(outcome::success()));
   EXPECT_CALL(*block_builder_api_, finalise_block())
       .WillOnce(Return(expected_header_));
 
@@ -101,6 +116,8 @@ TEST_F(BlockBuilderTest, PushWhenApplySucceedsWithFalse) {
   Extrinsic xt{};
   EXPECT_CALL(*block_builder_api_, apply_extrinsic(xt))
       .WillOnce(Return(ApplyOutcome::FAIL));
+  EXPECT_CALL(*storage_provider_, rollbackTransaction())
+      .WillOnce(Return(outcome::success()));
   EXPECT_CALL(*block_builder_api_, finalise_block())
       .WillOnce(Return(expected_header_));
 
@@ -113,3 +130,41 @@ TEST_F(BlockBuilderTest, PushWhenApplySucceedsWithFalse) {
   ASSERT_EQ(block.header, expected_header_);
   ASSERT_THAT(block.body, IsEmpty());
 }
+
+/**
+ * @given BlockBuilder
+ * @when several extrinsics are pushed @and the block is baked
+ * @then the runtime environment is held once before the first extrinsic is
+ * applied @and released once after the block is finalised
+ */
+TEST_F(BlockBuilderTest, HoldsEnvironmentUntilBaked) {
+  // given
+  Extrinsic xt1{{1}}, xt2{{2}};
+  testing::Sequence s;
+  EXPECT_CALL(*block_builder_api_, holdEnvironment())
+      .InSequence(s)
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_builder_api_, apply_extrinsic(xt1))
+      .InSequence(s)
+      .WillOnce(Return(ApplyOutcome::SUCCESS));
+  EXPECT_CALL(*block_builder_api_, apply_extrinsic(xt2))
+      .InSequence(s)
+      .WillOnce(Return(ApplyOutcome::SUCCESS));
+  EXPECT_CALL(*block_builder_api_, finalise_block())
+      .InSequence(s)
+      .WillOnce(Return(expected_header_));
+  EXPECT_CALL(*block_builder_api_, releaseEnvironment())
+      .Times(1)
+      .InSequence(s);
+  EXPECT_CALL(*storage_provider_, commitTransaction())
+      .WillRepeatedly(Return(outcome::success()));
+
+  // when
+  ASSERT_TRUE(block_builder_->pushExtrinsic(xt1));
+  ASSERT_TRUE(block_builder_->pushExtrinsic(xt2));
+  EXPECT_OUTCOME_TRUE(block, block_builder_->bake());
+  block_builder_.reset();
+
+  // then
+  ASSERT_THAT(block.body, ElementsAre(xt1, xt2));
+}
@@ -8,12 +8,15 @@
 #include <gtest/gtest.h>
 #include "mock/core/authorship/block_builder_factory_mock.hpp"
 #include "mock/core/authorship/block_builder_mock.hpp"
+#include "mock/core/clock/clock_mock.hpp"
 #include "mock/core/runtime/block_builder_api_mock.hpp"
 #include "mock/core/transaction_pool/transaction_pool_mock.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
 using ::testing::_;
+using ::testing::ByMove;
+using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::Test;
 
@@ -21,6 +24,8 @@ using kagome::authorship::BlockBuilder;
 using kagome::authorship::BlockBuilderFactoryMock;
 using kagome::authorship::BlockBuilderMock;
 using kagome::authorship::ProposerImpl;
+using kagome::clock::SystemClock;
+using kagome::clock::SystemClockMock;
 using kagome::common::Buffer;
 using kagome::primitives::Block;
 using kagome::primitives::BlockId;
@@ -32,6 +37,7 @@ using kagome::primitives::InherentIdentifier;
 using kagome::primitives::PreRuntime;
 using kagome::primitives::Transaction;
 using kagome::runtime::BlockBuilderApiMock;
+using kagome::transaction_pool::ReadyTransactionsMock;
 using kagome::transaction_pool::TransactionPoolMock;
 
 // TODO (kamilsa): workaround unless we bump gtest version to 1.8.1+
@@ -59,6 +65,8 @@ class ProposerTest : public ::testing::Test {
 
     EXPECT_CALL(*block_builder_api_mock_, inherent_extrinsics(inherent_data_))
         .WillOnce(Return(inherent_xts));
+
+    ON_CALL(*clock_, now()).WillByDefault(Return(now_));
   }
 
  protected:
@@ -69,10 +77,18 @@ class ProposerTest : public ::testing::Test {
   std::shared_ptr<BlockBuilderApiMock> block_builder_api_mock_ =
       std::make_shared<BlockBuilderApiMock>();
 
+  std::shared_ptr<SystemClockMock> clock_ =
+      std::make_shared<NiceMock<SystemClockMock>>();
+
   BlockBuilderMock *block_builder_;
 
-  ProposerImpl proposer_{
-      block_builder_factory_, transaction_pool_, block_builder_api_mock_};
+  ProposerImpl proposer_{block_builder_factory_,
+                         transaction_pool_,
+                         block_builder_api_mock_,
+                         clock_};
+
+  SystemClock::TimePoint now_{std::chrono::seconds{42}};
+  SystemClock::TimePoint deadline_ = now_ + std::chrono::seconds{1};
 
   BlockNumber expected_number_{42};
   BlockId expected_block_id_{expected_number_};
@@ -98,12 +114,16 @@ TEST_F(ProposerTest, CreateBlockSuccess) {
       .WillOnce(Return(outcome::success()))
       .WillOnce(Return(outcome::success()));
 
-  // getReadyTransaction will return vector with single transaction
-  std::map<Transaction::Hash, std::shared_ptr<Transaction>> ready_transactions{
-      std::make_pair("fakeHash"_hash256, std::make_shared<Transaction>())};
+  // getReadyTransaction will return a single transaction
+  auto ready_transactions = std::make_unique<ReadyTransactionsMock>();
+  auto tx = std::make_shared<Transaction>();
+  tx->hash = "fakeHash"_hash256;
+  EXPECT_CALL(*ready_transactions, next())
+      .WillOnce(Return(tx))
+      .WillOnce(Return(nullptr));
 
   EXPECT_CALL(*transaction_pool_, getReadyTransactions())
-      .WillOnce(Return(ready_transactions));
+      .WillOnce(Return(ByMove(std::move(ready_transactions))));
 
   EXPECT_CALL(*transaction_pool_, removeOne("fakeHash"_hash256))
       .WillOnce(Return(outcome::success()));
@@ -112,7 +132,8 @@ TEST_F(ProposerTest, CreateBlockSuccess) {
 
   // when
   auto block_res =
-      proposer_.propose(expected_block_id_, inherent_data_, inherent_digests_);
+      proposer_.propose(
+          expected_block_id_, inherent_data_, inherent_digests_, deadline_);
 
   // then
   ASSERT_TRUE(block_res);
@@ -133,7 +154,8 @@ TEST_F(ProposerTest, CreateBlockFailsWhenXtNotPushed) {
 
   // when
   auto block_res =
-      proposer_.propose(expected_block_id_, inherent_data_, inherent_digests_);
+      proposer_.propose(
+          expected_block_id_, inherent_data_, inherent_digests_, deadline_);
 
   // then
   ASSERT_FALSE(block_res);
@@ -143,28 +165,113 @@ TEST_F(ProposerTest, CreateBlockFailsWhenXtNotPushed) {
  * @given BlockBuilderApi creating inherent extrinsics @and TransactionPool
  * returning extrinsics
  * @when Proposer created from these BlockBuilderApi and TransactionPool is
- * trying to create block @but push extrinsics to block builder failed
- * @then Block is not created
+ * trying to create block @but push of an extrinsic from the pool fails
+ * @then the extrinsic is skipped and left in the pool @and the block is
+ * created without it
  */
-TEST_F(ProposerTest, PushFailed) {
+TEST_F(ProposerTest, SkipsXtFailedToPush) {
   // given
-  // we push 1 xt from inherent_xts and 1 Xt from transaction pool. Second push
-  // fails
+  // we push 1 xt from inherent_xts and 2 Xts from transaction pool. Second
+  // push fails
   EXPECT_CALL(*block_builder_, pushExtrinsic(_))
       .WillOnce(Return(outcome::success()))  // for inherent xt
       .WillOnce(Return(outcome::failure(
-          boost::system::error_code{})));  // for xt from tx pool
+          boost::system::error_code{})))  // for failing xt from tx pool
+      .WillOnce(Return(outcome::success()));
 
-  std::map<Transaction::Hash, std::shared_ptr<Transaction>> ready_transactions{
-      std::make_pair("fakeHash"_hash256, std::make_shared<Transaction>())};
+  auto ready_transactions = std::make_unique<ReadyTransactionsMock>();
+  auto failing_tx = std::make_shared<Transaction>();
+  failing_tx->hash = "failing"_hash256;
+  auto tx = std::make_shared<Transaction>();
+  tx->hash = "fakeHash"_hash256;
+  EXPECT_CALL(*ready_transactions, next())
+      .WillOnce(Return(failing_tx))
+      .WillOnce(Return(tx))
+      .WillOnce(Return(nullptr));
 
   EXPECT_CALL(*transaction_pool_, getReadyTransactions())
-      .WillOnce(Return(ready_transactions));
+      .WillOnce(Return(ByMove(std::move(ready_transactions))));
+
+  EXPECT_CALL(*transaction_pool_, removeOne("fakeHash"_hash256))
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_CALL(*block_builder_, bake()).WillOnce(Return(expected_block));
 
   // when
-  auto block_res =
-      proposer_.propose(expected_block_id_, inherent_data_, inherent_digests_);
+  auto block_res = proposer_.propose(
+      expected_block_id_, inherent_data_, inherent_digests_, deadline_);
 
   // then
-  ASSERT_FALSE(block_res);
+  ASSERT_TRUE(block_res);
+  ASSERT_EQ(expected_block, block_res.value());
+}
+
+/**
+ * @given TransactionPool returning extrinsics
+ * @when Proposer is trying to create block @but the deadline is reached
+ * @then the block is created with the inherent extrinsics only
+ */
+TEST_F(ProposerTest, StopsAtDeadline) {
+  // given
+  EXPECT_CALL(*block_builder_, pushExtrinsic(inherent_xts[0]))
+      .WillOnce(Return(outcome::success()));
+
+  auto ready_transactions = std::make_unique<ReadyTransactionsMock>();
+  EXPECT_CALL(*ready_transactions, next())
+      .WillOnce(Return(std::make_shared<Transaction>()));
+
+  EXPECT_CALL(*transaction_pool_, getReadyTransactions())
+      .WillOnce(Return(ByMove(std::move(ready_transactions))));
+
+  EXPECT_CALL(*clock_, now()).WillRepeatedly(Return(deadline_));
+
+  EXPECT_CALL(*block_builder_, bake()).WillOnce(Return(expected_block));
+
+  // when
+  auto block_res = proposer_.propose(
+      expected_block_id_, inherent_data_, inherent_digests_, deadline_);
+
+  // then
+  ASSERT_TRUE(block_res);
+}
+
+/**
+ * @given TransactionPool returning an extrinsic too large for the block and
+ * a small one after it
+ * @when Proposer is trying to create block
+ * @then the large extrinsic is skipped @and the small one is added
+ */
+TEST_F(ProposerTest, SkipsXtOverSizeLimit) {
+  // given
+  auto large_tx = std::make_shared<Transaction>();
+  large_tx->ext.data = Buffer(ProposerImpl::kBlockSizeLimit, 0);
+  auto tx = std::make_shared<Transaction>();
+  tx->hash = "fakeHash"_hash256;
+  tx->ext.data = Buffer{1, 2, 3};
+
+  EXPECT_CALL(*block_builder_, pushExtrinsic(inherent_xts[0]))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_builder_, pushExtrinsic(tx->ext))
+      .WillOnce(Return(outcome::success()));
+
+  auto ready_transactions = std::make_unique<ReadyTransactionsMock>();
+  EXPECT_CALL(*ready_transactions, next())
+      .WillOnce(Return(large_tx))
+      .WillOnce(Return(tx))
+      .WillOnce(Return(nullptr));
+
+  EXPECT_CALL(*transaction_pool_, getReadyTransactions())
+      .WillOnce(Return(ByMove(std::move(ready_transactions))));
+
+  EXPECT_CALL(*transaction_pool_, removeOne("fakeHash"_hash256))
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_CALL(*block_builder_, bake()).WillOnce(Return(expected_block));
+
+  // when
+  auto block_res = proposer_.propose(
+      expected_block_id_, inherent_data_, inherent_digests_, deadline_);
+
+  // then
+  ASSERT_TRUE(block_res);
 }
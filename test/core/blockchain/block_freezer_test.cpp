@@ -0,0 +1,224 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_freezer.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::blockchain::BlockFreezer;
+using kagome::blockchain::BlockFreezerError;
+using kagome::common::Buffer;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockNumber;
+
+class BlockFreezerTest : public test::BaseFS_Test {
+ public:
+  BlockFreezerTest() : test::BaseFS_Test("/tmp/kagome_block_freezer") {}
+
+  std::shared_ptr<BlockFreezer> open() {
+    EXPECT_OUTCOME_TRUE(freezer, BlockFreezer::open(getPathString(), 2));
+    return freezer;
+  }
+
+  static BlockHash hashOf(BlockNumber number) {
+    BlockHash hash;
+    hash.fill(number + 1);
+    return hash;
+  }
+
+  static Buffer dataOf(BlockNumber number) {
+    return Buffer(number * 3 + 1, number);
+  }
+
+  /**
+   * Appends blocks from \arg first to \arg last inclusive to \arg freezer
+   */
+  static void append(BlockFreezer &freezer,
+                     BlockNumber first,
+                     BlockNumber last) {
+    for (auto number = first; number <= last; number++) {
+      EXPECT_OUTCOME_TRUE_1(
+          freezer.append(number, hashOf(number), dataOf(number)));
+    }
+  }
+
+  static void expectFrozen(const BlockFreezer &freezer,
+                           BlockNumber first,
+                           BlockNumber last) {
+    for (auto number = first; number <= last; number++) {
+      EXPECT_OUTCOME_TRUE(data, freezer.get(number, hashOf(number)));
+      ASSERT_EQ(data, dataOf(number));
+    }
+  }
+};
+
+/**
+ * @given an empty block freezer
+ * @when blocks spanning several segments are appended to it
+ * @then the data of each block is obtained by its number and hash, and
+ * nothing is obtained for the blocks not appended or by another hash
+ */
+TEST_F(BlockFreezerTest, AppendAndGet) {
+  auto freezer = open();
+  ASSERT_FALSE(freezer->nextNumber());
+
+  append(*freezer, 5, 9);
+  ASSERT_EQ(freezer->nextNumber(), BlockNumber{10});
+  expectFrozen(*freezer, 5, 9);
+
+  EXPECT_OUTCOME_TRUE(other_hash, freezer->get(7, hashOf(8)));
+  ASSERT_FALSE(other_hash);
+  EXPECT_OUTCOME_TRUE(older, freezer->get(4, hashOf(4)));
+  ASSERT_FALSE(older);
+  EXPECT_OUTCOME_TRUE(newer, freezer->get(10, hashOf(10)));
+  ASSERT_FALSE(newer);
+}
+
+/**
+ * @given a block freezer with blocks in it
+ * @when a block which is not the next one is appended
+ * @then an error is returned
+ */
+TEST_F(BlockFreezerTest, AppendsOnlyNextBlock) {
+  auto freezer = open();
+  append(*freezer, 0, 2);
+  EXPECT_OUTCOME_ERROR(
+      res, freezer->append(4, hashOf(4), dataOf(4)),
+      BlockFreezerError::NOT_NEXT_BLOCK);
+  EXPECT_OUTCOME_ERROR(
+      res2, freezer->append(2, hashOf(2), dataOf(2)),
+      BlockFreezerError::NOT_NEXT_BLOCK);
+}
+
+/**
+ * @given a block freezer with a block of no data
+ * @when the block is obtained
+ * @then there is no data, while the next block is appended after it
+ */
+TEST_F(BlockFreezerTest, EmptyData) {
+  auto freezer = open();
+  EXPECT_OUTCOME_TRUE_1(freezer->append(0, hashOf(0), Buffer{}));
+  EXPECT_OUTCOME_TRUE(data, freezer->get(0, hashOf(0)));
+  ASSERT_FALSE(data);
+  append(*freezer, 1, 1);
+  expectFrozen(*freezer, 1, 1);
+}
+
+/**
+ * @given a block freezer with blocks in it, which files have an incomplete
+ * block written at the end
+ * @when the freezer is opened again
+ * @then the complete blocks are there, and the incomplete one is dropped
+ */
+TEST_F(BlockFreezerTest, Reopen) {
+  append(*open(), 0, 4);
+  {
+    // the last segment keeps the block 4 only
+    auto segment = base_path / "00000000000000000004";
+    std::ofstream data{segment.string() + ".data",
+                       std::ios::binary | std::ios::app};
+    data << "incomplete";
+    std::ofstream index{segment.string() + ".index",
+                        std::ios::binary | std::ios::app};
+    index << "part";
+  }
+
+  auto freezer = open();
+  ASSERT_EQ(freezer->nextNumber(), BlockNumber{5});
+  expectFrozen(*freezer, 0, 4);
+  append(*freezer, 5, 6);
+  expectFrozen(*freezer, 0, 6);
+}
+
+/**
+ * @given a block freezer with blocks in it, synced to the disk
+ * @when the data file of the last segment is truncated in the middle of its
+ * last block, and then the index file in the middle of an entry, and the
+ * freezer is opened after each of them
+ * @then the blocks, which data is cut, and the entry, which is incomplete,
+ * are dropped, the rest of the blocks are there, and the dropped ones are
+ * appended again
+ */
+TEST_F(BlockFreezerTest, ReopenTruncated) {
+  {
+    auto freezer = open();
+    append(*freezer, 0, 5);
+    EXPECT_OUTCOME_TRUE_1(freezer->sync());
+  }
+  // the last segment keeps the blocks 4 and 5
+  auto segment = (base_path / "00000000000000000004").string();
+  boost::filesystem::resize_file(
+      segment + ".data", dataOf(4).size() + dataOf(5).size() / 2);
+
+  {
+    auto freezer = open();
+    ASSERT_EQ(freezer->nextNumber(), BlockNumber{5});
+    expectFrozen(*freezer, 0, 4);
+    EXPECT_OUTCOME_TRUE(cut, freezer->get(5, hashOf(5)));
+    ASSERT_FALSE(cut);
+  }
+  ASSERT_EQ(boost::filesystem::file_size(segment + ".data"),
+            dataOf(4).size());
+
+  boost::filesystem::resize_file(
+      segment + ".index", boost::filesystem::file_size(segment + ".index") / 2);
+  auto freezer = open();
+  ASSERT_EQ(freezer->nextNumber(), BlockNumber{4});
+  expectFrozen(*freezer, 0, 3);
+  append(*freezer, 4, 6);
+  EXPECT_OUTCOME_TRUE_1(freezer->sync());
+  expectFrozen(*freezer, 0, 6);
+}
+
+/**
+ * @given a block freezer with blocks appended and not synced
+ * @when the blocks are obtained
+ * @then they are there before the sync, as well as after it
+ */
+TEST_F(BlockFreezerTest, GetBeforeSync) {
+  auto freezer = open();
+  append(*freezer, 0, 2);
+  expectFrozen(*freezer, 0, 2);
+  EXPECT_OUTCOME_TRUE_1(freezer->sync());
+  append(*freezer, 3, 3);
+  expectFrozen(*freezer, 0, 3);
+}
+
+/**
+ * @given a block freezer compressing the data
+ * @when blocks are appended and the freezer is opened again without the
+ * compression, and more blocks are appended
+ * @then the data of all the blocks is obtained as it was appended, and the
+ * compressed data takes less space on the disk
+ */
+TEST_F(BlockFreezerTest, CompressedData) {
+  auto data_of = [](BlockNumber number) { return Buffer(1000, number); };
+  {
+    EXPECT_OUTCOME_TRUE(freezer, BlockFreezer::open(getPathString(), 2, 3));
+    for (BlockNumber number = 0; number <= 2; number++) {
+      EXPECT_OUTCOME_TRUE_1(
+          freezer->append(number, hashOf(number), data_of(number)));
+    }
+  }
+  ASSERT_LT(boost::filesystem::file_size(base_path
+                                         / "00000000000000000000.data"),
+            1000);
+
+  auto freezer = open();
+  for (BlockNumber number = 3; number <= 4; number++) {
+    EXPECT_OUTCOME_TRUE_1(
+        freezer->append(number, hashOf(number), data_of(number)));
+  }
+  for (BlockNumber number = 0; number <= 4; number++) {
+    EXPECT_OUTCOME_TRUE(data, freezer->get(number, hashOf(number)));
+    ASSERT_EQ(data, data_of(number));
+  }
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "blockchain/impl/block_header_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::blockchain::BlockHeaderCache;
+using kagome::primitives::BlockHeader;
+
+namespace {
+  BlockHeader makeHeader(kagome::primitives::BlockNumber number) {
+    BlockHeader header;
+    header.number = number;
+    return header;
+  }
+}  // namespace
+
+/**
+ * @given a full header cache
+ * @when a new header is put into it
+ * @then the least recently used header is evicted
+ */
+TEST(BlockHeaderCacheTest, EvictsLeastRecentlyUsed) {
+  BlockHeaderCache cache{2};
+  cache.put("a"_hash256, makeHeader(1));
+  cache.put("b"_hash256, makeHeader(2));
+  ASSERT_TRUE(cache.get("a"_hash256));
+
+  cache.put("c"_hash256, makeHeader(3));
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.get("a"_hash256)->number, 1);
+  ASSERT_FALSE(cache.get("b"_hash256));
+  ASSERT_EQ(cache.get("c"_hash256)->number, 3);
+}
+
+/**
+ * @given a header cache with a header in it
+ * @when the header is removed
+ * @then it is no longer obtained from the cache
+ */
+TEST(BlockHeaderCacheTest, Remove) {
+  BlockHeaderCache cache{2};
+  cache.put("a"_hash256, makeHeader(1));
+  cache.remove("a"_hash256);
+  cache.remove("b"_hash256);
+  ASSERT_FALSE(cache.get("a"_hash256));
+  ASSERT_EQ(cache.size(), 0);
+}
+
+/**
+ * @given a header cache of zero capacity
+ * @when a header is put into it
+ * @then nothing is cached
+ */
+TEST(BlockHeaderCacheTest, ZeroCapacity) {
+  BlockHeaderCache cache{0};
+  cache.put("a"_hash256, makeHeader(1));
+  ASSERT_FALSE(cache.get("a"_hash256));
+  ASSERT_EQ(cache.size(), 0);
+}
+
+/**
+ * @given a header cache with headers in it
+ * @when it is looked up and its budget is cut to a single header
+ * @then the lookups are counted, and only the most recently used header is
+ * kept
+ */
+TEST(BlockHeaderCacheTest, Budget) {
+  BlockHeaderCache cache{3};
+  cache.put("a"_hash256, makeHeader(1));
+  cache.put("b"_hash256, makeHeader(2));
+  ASSERT_TRUE(cache.get("a"_hash256));
+  ASSERT_FALSE(cache.get("c"_hash256));
+  auto usage = cache.usage();
+  ASSERT_EQ(usage.bytes, 2 * BlockHeaderCache::kEntryBytes);
+  ASSERT_EQ(usage.hits, 1);
+  ASSERT_EQ(usage.misses, 1);
+
+  cache.setBudget(BlockHeaderCache::kEntryBytes);
+  ASSERT_EQ(cache.capacity(), 1);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_TRUE(cache.get("a"_hash256));
+}
@@ -18,6 +18,7 @@
 #include "testutil/outcome.hpp"
 #include "testutil/storage/base_leveldb_test.hpp"
 
+using kagome::blockchain::BlockHeaderCache;
 using kagome::blockchain::BlockHeaderRepository;
 using kagome::blockchain::KeyValueBlockHeaderRepository;
 using kagome::blockchain::numberAndHashToLookupKey;
@@ -147,5 +148,31 @@ TEST_P(BlockHeaderRepository_NumberParametrized_Test, GetHeader) {
   ASSERT_EQ(header_by_num, header_should_be);
 }
 
+/**
+ * @given HeaderBackend instance with a header cache and a header read by its
+ * number
+ * @when the header is no longer in the storage
+ * @then the header and the block number are still obtained by the block hash
+ * from the cache
+ */
+TEST_F(BlockHeaderRepository_Test, CachedHeader) {
+  auto header_cache = std::make_shared<BlockHeaderCache>(8);
+  header_repo_ = std::make_shared<KeyValueBlockHeaderRepository>(
+      db_, hasher_, header_cache);
+  EXPECT_OUTCOME_TRUE(hash, storeHeader(42, getDefaultHeader()));
+  EXPECT_OUTCOME_TRUE(header, header_repo_->getBlockHeader(42));
+  EXPECT_OUTCOME_TRUE(hash_by_number, header_repo_->getHashByNumber(42));
+  ASSERT_EQ(hash_by_number, hash);
+  ASSERT_EQ(header_cache->size(), 1);
+
+  EXPECT_OUTCOME_TRUE_1(db_->remove(prependPrefix(
+      kagome::blockchain::numberAndHashToLookupKey(42, hash),
+      Prefix::HEADER)));
+  EXPECT_OUTCOME_TRUE(cached_header, header_repo_->getBlockHeader(hash));
+  ASSERT_EQ(cached_header, header);
+  EXPECT_OUTCOME_TRUE(number, header_repo_->getNumberByHash(hash));
+  ASSERT_EQ(number, 42);
+}
+
 INSTANTIATE_TEST_CASE_P(Numbers, BlockHeaderRepository_NumberParametrized_Test,
                         testing::ValuesIn(ParamValues));
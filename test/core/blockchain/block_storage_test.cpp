@@ -6,13 +6,21 @@
 #include "blockchain/impl/key_value_block_storage.hpp"
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
 #include "blockchain/impl/common.hpp"
+#include "blockchain/impl/storage_util.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
 #include "mock/core/crypto/hasher_mock.hpp"
 #include "mock/core/storage/persistent_map_mock.hpp"
+#include "mock/core/storage/write_batch_mock.hpp"
 #include "scale/scale.hpp"
 #include "storage/database_error.hpp"
+#include "storage/in_memory/arena_storage.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
 #include "testutil/outcome.hpp"
 
+using kagome::blockchain::BlockFreezer;
+using kagome::blockchain::BlockHeaderCache;
 using kagome::blockchain::KeyValueBlockStorage;
 using kagome::common::Buffer;
 using kagome::crypto::HasherMock;
@@ -23,8 +31,11 @@ using kagome::primitives::BlockHash;
 using kagome::primitives::BlockHeader;
 using kagome::primitives::BlockNumber;
 using kagome::scale::encode;
+using kagome::storage::BufferBatch;
 using kagome::storage::face::GenericStorageMock;
+using kagome::storage::face::WriteBatchMock;
 using testing::_;
+using testing::Invoke;
 using testing::Return;
 
 class BlockStorageTest : public testing::Test {
@@ -39,9 +50,25 @@ class BlockStorageTest : public testing::Test {
   BlockHash genesis_block_hash{{'g', 'e', 'n', 'e', 's', 'i', 's'}};
   BlockHash regular_block_hash{{'r', 'e', 'g', 'u', 'l', 'a', 'r'}};
   Buffer root_hash;
+  std::shared_ptr<BlockHeaderCache> header_cache;
 
   KeyValueBlockStorage::BlockHandler block_handler = [](auto &) {};
 
+  /**
+   * @return batch of the storage, which accepts all the writes and commits
+   * them with \arg commit_result
+   */
+  static std::unique_ptr<BufferBatch> makeBatch(
+      outcome::result<void> commit_result = outcome::success()) {
+    auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+    EXPECT_CALL(*batch, put(_, _)).WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*batch, put_rvalue(_, _))
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*batch, remove(_)).WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*batch, commit()).WillOnce(Return(commit_result));
+    return batch;
+  }
+
   std::shared_ptr<KeyValueBlockStorage> createWithGenesis() {
     EXPECT_CALL(*hasher, blake2b_256(_))
         // calculate hash of genesis block at check existance of block
@@ -64,9 +91,16 @@ class BlockStorageTest : public testing::Test {
         // put key-value for lookup data
         .WillRepeatedly(Return(outcome::success()));
 
+    EXPECT_CALL(*storage, batch())
+        // parts of a block are put with a single batch
+        .WillRepeatedly(Invoke([] { return makeBatch(); }));
+
     EXPECT_OUTCOME_TRUE(new_block_storage,
-                        KeyValueBlockStorage::createWithGenesis(
-                            root_hash, storage, hasher, block_handler));
+                        KeyValueBlockStorage::createWithGenesis(root_hash,
+                                                                storage,
+                                                                hasher,
+                                                                block_handler,
+                                                                header_cache));
 
     return new_block_storage;
   }
@@ -159,14 +193,13 @@ TEST_F(BlockStorageTest, CreateWithStorageError) {
 /**
  * @given a block storage and a block that is not in storage yet
  * @when putting a block in the storage
- * @then block is successfully put
+ * @then block is successfully put, its header is hashed once
  */
 TEST_F(BlockStorageTest, PutBlock) {
   auto block_storage = createWithGenesis();
 
-  EXPECT_CALL(*hasher, blake2b_256(_))
-      .WillOnce(Return(regular_block_hash))
-      .WillOnce(Return(regular_block_hash));
+  // the header is hashed once, both to check the block and to store it
+  EXPECT_CALL(*hasher, blake2b_256(_)).WillOnce(Return(regular_block_hash));
 
   EXPECT_CALL(*storage, get(_))
       .WillOnce(Return(kagome::blockchain::Error::BLOCK_NOT_FOUND))
@@ -224,17 +257,257 @@ TEST_F(BlockStorageTest, PutWithStorageError) {
 TEST_F(BlockStorageTest, Remove) {
   auto block_storage = createWithGenesis();
 
-  EXPECT_CALL(*storage, remove(_))
-      .WillOnce(Return(outcome::success()))
-      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([] { return makeBatch(); }));
   EXPECT_OUTCOME_TRUE_1(block_storage->removeBlock(genesis_block_hash, 0));
 
-  EXPECT_CALL(*storage, remove(_))
-      .WillOnce(Return(kagome::storage::DatabaseError::IO_ERROR));
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([] {
+    return makeBatch(kagome::storage::DatabaseError::IO_ERROR);
+  }));
   EXPECT_OUTCOME_FALSE_1(block_storage->removeBlock(genesis_block_hash, 0));
+}
 
-  EXPECT_CALL(*storage, remove(_))
-      .WillOnce(Return(outcome::success()))
-      .WillOnce(Return(kagome::storage::DatabaseError::IO_ERROR));
-  EXPECT_OUTCOME_FALSE_1(block_storage->removeBlock(genesis_block_hash, 0));
+/**
+ * @given a block storage
+ * @when removing several blocks from it at once
+ * @then the headers and the data of all of them are removed with a single
+ * write
+ */
+TEST_F(BlockStorageTest, RemoveSeveral) {
+  auto block_storage = createWithGenesis();
+
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([] {
+    auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+    // a header and the data for each of the blocks
+    EXPECT_CALL(*batch, remove(_))
+        .Times(4)
+        .WillRepeatedly(Return(outcome::success()));
+    EXPECT_CALL(*batch, commit()).WillOnce(Return(outcome::success()));
+    return batch;
+  }));
+  EXPECT_OUTCOME_TRUE_1(block_storage->removeBlocks(
+      {{0, genesis_block_hash}, {1, regular_block_hash}}));
+}
+
+/**
+ * @given a block storage with a header cache
+ * @when getting the header of the genesis block put on creation and then
+ * removing the block
+ * @then the header is taken from the cache without reading the storage, and
+ * it is dropped from the cache along with the block
+ */
+TEST_F(BlockStorageTest, CachesHeaders) {
+  header_cache = std::make_shared<BlockHeaderCache>(8);
+  auto block_storage = createWithGenesis();
+  ASSERT_EQ(header_cache->size(), 1);
+
+  EXPECT_CALL(*storage, get(_)).Times(0);
+  EXPECT_OUTCOME_TRUE(header,
+                      block_storage->getBlockHeader(genesis_block_hash));
+  ASSERT_EQ(header.number, 0);
+
+  EXPECT_CALL(*storage, batch()).WillOnce(Invoke([] { return makeBatch(); }));
+  EXPECT_OUTCOME_TRUE_1(block_storage->removeBlock(genesis_block_hash, 0));
+  ASSERT_FALSE(header_cache->get(genesis_block_hash));
+}
+
+/**
+ * @given a block storage with a freezer, and a block put on top of the
+ * genesis one with a justification
+ * @when the block is finalized
+ * @then its data is moved from the storage to the freezer, and is still
+ * obtained from the block storage
+ */
+TEST(BlockStorageFreezerTest, FreezesFinalizedBlocks) {
+  namespace fs = boost::filesystem;
+  auto path = fs::temp_directory_path() / fs::unique_path();
+  EXPECT_OUTCOME_TRUE(freezer, BlockFreezer::open(path.string()));
+  auto storage = std::make_shared<kagome::storage::InMemoryStorage>();
+  auto hasher = std::make_shared<kagome::crypto::HasherImpl>();
+  EXPECT_OUTCOME_TRUE(
+      block_storage,
+      KeyValueBlockStorage::createWithGenesis(
+          Buffer(32, 1), storage, hasher, [](auto &) {}, nullptr, freezer));
+  EXPECT_OUTCOME_TRUE(genesis_hash, block_storage->getLastFinalizedBlockHash());
+  ASSERT_EQ(freezer->nextNumber(), BlockNumber{1});
+
+  Block block;
+  block.header.number = 1;
+  block.header.parent_hash = genesis_hash;
+  block.body.emplace_back().data = Buffer{1, 2, 3};
+  EXPECT_OUTCOME_TRUE(block_hash, block_storage->putBlock(block));
+  EXPECT_OUTCOME_TRUE_1(block_storage->putJustification(
+      {Buffer{4, 5}}, block_hash, block.header.number));
+  EXPECT_OUTCOME_TRUE_1(block_storage->setLastFinalizedBlockHash(block_hash));
+  ASSERT_EQ(freezer->nextNumber(), BlockNumber{2});
+
+  auto data_key = kagome::blockchain::prependPrefix(
+      kagome::blockchain::numberAndHashToLookupKey(1, block_hash),
+      kagome::blockchain::prefix::Prefix::BLOCK_DATA);
+  ASSERT_FALSE(storage->contains(data_key));
+  EXPECT_OUTCOME_TRUE(body, block_storage->getBlockBody(block_hash));
+  ASSERT_EQ(body, block.body);
+  EXPECT_OUTCOME_TRUE(justification,
+                      block_storage->getJustification(block_hash));
+  ASSERT_EQ(justification.data, (Buffer{4, 5}));
+
+  fs::remove_all(path);
+}
+
+/**
+ * @given a block storage with several blocks, one of which is on a fork
+ * @when the data of a range of the blocks is read, including a block with a
+ * wrong number and an unknown block
+ * @then the data of each block is returned in the requested order, and only
+ * the hash is returned for the unknown block
+ */
+TEST(BlockStorageRangeTest, GetBlockDataRange) {
+  auto storage = std::make_shared<kagome::storage::ArenaStorage>();
+  auto hasher = std::make_shared<kagome::crypto::HasherImpl>();
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          Buffer(32, 1), storage, hasher, [](auto &) {}));
+  EXPECT_OUTCOME_TRUE(parent_hash, block_storage->getLastFinalizedBlockHash());
+
+  std::vector<kagome::primitives::BlockInfo> blocks;
+  for (BlockNumber number = 1; number <= 4; number++) {
+    Block block;
+    block.header.number = number;
+    block.header.parent_hash = parent_hash;
+    block.body.emplace_back().data = Buffer{static_cast<uint8_t>(number)};
+    EXPECT_OUTCOME_TRUE(hash, block_storage->putBlock(block));
+    blocks.emplace_back(number, hash);
+    parent_hash = hash;
+
+    // a sibling, which keys are between the ones of the chain
+    block.header.state_root.fill(number);
+    EXPECT_OUTCOME_TRUE_1(block_storage->putBlock(block));
+  }
+  blocks[2].block_number = 10;
+  blocks.emplace_back(5, BlockHash{});
+
+  EXPECT_OUTCOME_TRUE(range, block_storage->getBlockDataRange(blocks));
+  ASSERT_EQ(range.size(), blocks.size());
+  for (size_t i = 0; i < 4; i++) {
+    ASSERT_EQ(range[i].hash, blocks[i].block_hash);
+    ASSERT_TRUE(range[i].body);
+    ASSERT_EQ(range[i].body->at(0).data, Buffer{uint8_t(i + 1)});
+  }
+  ASSERT_EQ(range[4].hash, BlockHash{});
+  ASSERT_FALSE(range[4].body);
+}
+
+/**
+ * @given a block storage with a chain of blocks, one of which changes the
+ * authority set and is justified
+ * @when the bodies of the blocks below a number are pruned
+ * @then the bodies below the number are removed except the one of the
+ * authority set change, and the headers and the rest of the bodies are kept
+ */
+TEST(BlockStoragePruningTest, PruneBodies) {
+  auto storage = std::make_shared<kagome::storage::ArenaStorage>();
+  auto hasher = std::make_shared<kagome::crypto::HasherImpl>();
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          Buffer(32, 1), storage, hasher, [](auto &) {}));
+  EXPECT_OUTCOME_TRUE(parent_hash, block_storage->getLastFinalizedBlockHash());
+  ASSERT_EQ(block_storage->firstBodyNumber().value(), 0);
+
+  std::vector<BlockHash> hashes{parent_hash};
+  for (BlockNumber number = 1; number <= 4; number++) {
+    Block block;
+    block.header.number = number;
+    block.header.parent_hash = parent_hash;
+    if (number == 2) {
+      block.header.digest.emplace_back(kagome::primitives::Consensus{
+          {kagome::primitives::kGrandpaEngineId, Buffer{1}}});
+    }
+    block.body.emplace_back().data = Buffer{static_cast<uint8_t>(number)};
+    EXPECT_OUTCOME_TRUE(hash, block_storage->putBlock(block));
+    EXPECT_OUTCOME_TRUE_1(
+        block_storage->putJustification({Buffer{2}}, hash, number));
+    hashes.push_back(hash);
+    parent_hash = hash;
+  }
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->pruneBodies(3));
+  ASSERT_EQ(block_storage->firstBodyNumber().value(), 3);
+
+  for (BlockNumber number = 0; number <= 4; number++) {
+    EXPECT_OUTCOME_TRUE_1(block_storage->getBlockHeader(hashes[number]));
+  }
+  EXPECT_OUTCOME_FALSE_1(block_storage->getBlockBody(hashes[1]));
+  EXPECT_OUTCOME_FALSE_1(block_storage->getBlockBody(hashes[2]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getJustification(hashes[2]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getBlockBody(hashes[3]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getBlockBody(hashes[4]));
+}
+
+/**
+ * @given a block storage with a chain of justified blocks, one of which
+ * changes the authority set
+ * @when the justifications of the blocks below a number are pruned with a
+ * period
+ * @then the justifications below the number are removed except the ones of
+ * the authority set change and of the blocks with the numbers divisible by
+ * the period, and the bodies are kept
+ */
+TEST(BlockStoragePruningTest, PruneJustifications) {
+  auto storage = std::make_shared<kagome::storage::ArenaStorage>();
+  auto hasher = std::make_shared<kagome::crypto::HasherImpl>();
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          Buffer(32, 1), storage, hasher, [](auto &) {}));
+  EXPECT_OUTCOME_TRUE(parent_hash, block_storage->getLastFinalizedBlockHash());
+  ASSERT_EQ(block_storage->firstJustificationNumber().value(), 0);
+
+  std::vector<BlockHash> hashes{parent_hash};
+  for (BlockNumber number = 1; number <= 6; number++) {
+    Block block;
+    block.header.number = number;
+    block.header.parent_hash = parent_hash;
+    if (number == 3) {
+      block.header.digest.emplace_back(kagome::primitives::Consensus{
+          {kagome::primitives::kGrandpaEngineId, Buffer{1}}});
+    }
+    block.body.emplace_back().data = Buffer{static_cast<uint8_t>(number)};
+    EXPECT_OUTCOME_TRUE(hash, block_storage->putBlock(block));
+    EXPECT_OUTCOME_TRUE_1(
+        block_storage->putJustification({Buffer{2}}, hash, number));
+    hashes.push_back(hash);
+    parent_hash = hash;
+  }
+
+  EXPECT_OUTCOME_TRUE_1(block_storage->pruneJustifications(6, 4));
+  ASSERT_EQ(block_storage->firstJustificationNumber().value(), 6);
+
+  EXPECT_OUTCOME_FALSE_1(block_storage->getJustification(hashes[1]));
+  EXPECT_OUTCOME_FALSE_1(block_storage->getJustification(hashes[2]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getJustification(hashes[3]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getJustification(hashes[4]));
+  EXPECT_OUTCOME_FALSE_1(block_storage->getJustification(hashes[5]));
+  EXPECT_OUTCOME_TRUE_1(block_storage->getJustification(hashes[6]));
+  for (BlockNumber number = 1; number <= 6; number++) {
+    EXPECT_OUTCOME_TRUE_1(block_storage->getBlockBody(hashes[number]));
+  }
+}
+
+/**
+ * @given a block storage without a snapshot of the block tree
+ * @when a snapshot is stored
+ * @then it is obtained afterwards, while none is obtained before
+ */
+TEST(BlockStorageSnapshotTest, StoresBlockTreeSnapshot) {
+  auto storage = std::make_shared<kagome::storage::InMemoryStorage>();
+  auto hasher = std::make_shared<kagome::crypto::HasherImpl>();
+  EXPECT_OUTCOME_TRUE(block_storage,
+                      KeyValueBlockStorage::createWithGenesis(
+                          Buffer(32, 1), storage, hasher, [](auto &) {}));
+
+  EXPECT_OUTCOME_TRUE(none, block_storage->getBlockTreeSnapshot());
+  ASSERT_FALSE(none);
+
+  Buffer snapshot{1, 2, 3};
+  EXPECT_OUTCOME_TRUE_1(block_storage->setBlockTreeSnapshot(snapshot));
+  EXPECT_OUTCOME_TRUE(stored, block_storage->getBlockTreeSnapshot());
+  ASSERT_EQ(stored, snapshot);
 }
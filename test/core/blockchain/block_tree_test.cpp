@@ -15,10 +15,12 @@
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
 #include "mock/core/blockchain/block_storage_mock.hpp"
 #include "mock/core/storage/persistent_map_mock.hpp"
+#include "mock/core/storage/trie/trie_pruner_mock.hpp"
 #include "network/impl/extrinsic_observer_impl.hpp"
 #include "primitives/block_id.hpp"
 #include "primitives/justification.hpp"
 #include "scale/scale.hpp"
+#include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
 using namespace kagome;
@@ -33,6 +35,12 @@ using testing::Return;
 
 struct BlockTreeTest : public testing::Test {
   void SetUp() override {
+    ON_CALL(*storage_, getBlockTreeSnapshot())
+        .WillByDefault(
+            Return(outcome::result<boost::optional<Buffer>>(boost::none)));
+    ON_CALL(*storage_, setBlockTreeSnapshot(_))
+        .WillByDefault(Return(outcome::success()));
+
     // for LevelDbBlockTree::create(..)
     EXPECT_CALL(*storage_, getBlockHeader(kLastFinalizedBlockId))
         .WillOnce(Return(finalized_block_header_));
@@ -205,6 +213,179 @@ TEST_F(BlockTreeTest, Finalize) {
   ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash);
 }
 
+/**
+ * @given block tree with a chain of two blocks, a fork from the root and a
+ * fork from the first block of the chain
+ * @when finalizing the second block of the chain
+ * @then it becomes the only block of the tree, so neither the ancestors nor
+ * the forks can be found in the tree or built on anymore, and the forks are
+ * removed from the storage with a single write
+ */
+TEST_F(BlockTreeTest, FinalizeRemovesAncestorsAndForks) {
+  // GIVEN
+  auto hash1 = addBlock(Block{BlockHeader{.parent_hash = kFinalizedBlockHash,
+                                          .number = 1,
+                                          .digest = {PreRuntime{}}},
+                              {}});
+  auto hash2 = addBlock(Block{
+      BlockHeader{.parent_hash = hash1, .number = 2, .digest = {PreRuntime{}}},
+      {}});
+  auto root_fork_hash = addBlock(Block{
+      BlockHeader{.parent_hash = kFinalizedBlockHash,
+                  .number = 1,
+                  .state_root = "root_fork_state_root____________"_hash256,
+                  .digest = {PreRuntime{}}},
+      {}});
+  auto fork_hash = addBlock(Block{
+      BlockHeader{.parent_hash = hash1,
+                  .number = 2,
+                  .state_root = "fork_state_root_________________"_hash256,
+                  .digest = {PreRuntime{}}},
+      {}});
+
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(_, hash2, 2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash2))
+      .WillOnce(Return(outcome::success()));
+  std::vector<BlockInfo> forks{{1, root_fork_hash}, {2, fork_hash}};
+  EXPECT_CALL(*storage_, getBlockDataRange(forks))
+      .WillOnce(Return(std::vector<BlockData>{{root_fork_hash}, {fork_hash}}));
+  EXPECT_CALL(*storage_, removeBlocks(forks))
+      .WillOnce(Return(outcome::success()));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash2, Justification{{0x45, 0xF4}}));
+
+  // THEN
+  ASSERT_EQ(block_tree_->getLeaves(), std::vector<BlockHash>{hash2});
+  EXPECT_OUTCOME_TRUE(children, block_tree_->getChildren(hash2));
+  ASSERT_TRUE(children.empty());
+  for (auto &hash : {kFinalizedBlockHash, hash1, root_fork_hash, fork_hash}) {
+    EXPECT_OUTCOME_FALSE(error, block_tree_->getChildren(hash));
+    ASSERT_EQ(error, BlockTreeError::NO_SUCH_BLOCK);
+  }
+  EXPECT_OUTCOME_FALSE(
+      add_error,
+      block_tree_->addBlockHeader(
+          BlockHeader{.parent_hash = fork_hash, .number = 3}));
+  ASSERT_EQ(add_error, BlockTreeError::NO_PARENT);
+}
+
+/**
+ * @given block tree with a state pruner and pruning depth 1, which has a
+ * chain of two blocks and a fork from the first of them
+ * @when finalizing the second block of the chain
+ * @then the states of the fork block and of the blocks deeper than one block
+ * under the new finalized one are pruned
+ */
+TEST_F(BlockTreeTest, FinalizePrunesStates) {
+  // GIVEN
+  auto pruner = std::make_shared<trie::TriePrunerMock>();
+  EXPECT_CALL(*storage_, getBlockHeader(kLastFinalizedBlockId))
+      .WillOnce(Return(finalized_block_header_));
+  block_tree_ = BlockTreeImpl::create(header_repo_,
+                                      storage_,
+                                      kLastFinalizedBlockId,
+                                      extrinsic_observer_,
+                                      hasher_,
+                                      pruner,
+                                      1)
+                    .value();
+
+  BlockHeader header1{.parent_hash = kFinalizedBlockHash,
+                      .number = 1,
+                      .state_root = "state_root_1____________________"_hash256,
+                      .digest = {PreRuntime{}}};
+  auto hash1 = addBlock(Block{header1, {}});
+  BlockHeader header2{.parent_hash = hash1,
+                      .number = 2,
+                      .state_root = "state_root_2____________________"_hash256,
+                      .digest = {PreRuntime{}}};
+  auto hash2 = addBlock(Block{header2, {}});
+  BlockHeader fork_header{
+      .parent_hash = hash1,
+      .number = 2,
+      .state_root = "fork_state_root_________________"_hash256,
+      .digest = {PreRuntime{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash2)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(_, hash2, 2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash2))
+      .WillOnce(Return(outcome::success()));
+
+  std::vector<BlockInfo> forks{{2, fork_hash}};
+  EXPECT_CALL(*storage_, getBlockDataRange(forks))
+      .WillOnce(Return(std::vector<BlockData>{{fork_hash}}));
+  EXPECT_CALL(*storage_, getBlockHeader(primitives::BlockId(fork_hash)))
+      .WillOnce(Return(fork_header));
+  EXPECT_CALL(*storage_, removeBlocks(forks))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*pruner, pruneState(Buffer{fork_header.state_root}))
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_CALL(*header_repo_, getBlockHeader(primitives::BlockId(0ul)))
+      .WillOnce(Return(finalized_block_header_));
+  EXPECT_CALL(*header_repo_, getBlockHeader(primitives::BlockId(1ul)))
+      .WillOnce(Return(header1));
+  EXPECT_CALL(*pruner, pruneState(Buffer{finalized_block_header_.state_root}))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*pruner, pruneState(Buffer{header1.state_root}))
+      .WillOnce(Return(outcome::success()));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash2, Justification{{0x45, 0xF4}}));
+
+  // THEN
+  ASSERT_EQ(block_tree_->getLastFinalized().block_hash, hash2);
+}
+
+/**
+ * @given block tree with a chain of two blocks and a longer fork from the
+ * root, which has the deepest leaf
+ * @when finalizing the first block of the shorter chain
+ * @then the fork is pruned, and the deepest leaf is the one of the finalized
+ * chain
+ */
+TEST_F(BlockTreeTest, FinalizeShorterChainUpdatesDeepestLeaf) {
+  // GIVEN
+  auto hash1 = addHeaderToRepository(kFinalizedBlockHash, 1);
+  auto hash2 = addHeaderToRepository(hash1, 2);
+  auto fork_hash1 = addBlock(Block{
+      BlockHeader{.parent_hash = kFinalizedBlockHash,
+                  .number = 1,
+                  .state_root = "fork_state_root_________________"_hash256},
+      {}});
+  auto fork_hash2 = addHeaderToRepository(fork_hash1, 2);
+  auto fork_hash3 = addHeaderToRepository(fork_hash2, 3);
+  ASSERT_EQ(block_tree_->deepestLeaf(), (BlockInfo{3, fork_hash3}));
+
+  EXPECT_CALL(*storage_, getJustification(primitives::BlockId(hash1)))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+  EXPECT_CALL(*storage_, putJustification(_, hash1, 1))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*storage_, setLastFinalizedBlockHash(hash1))
+      .WillOnce(Return(outcome::success()));
+  std::vector<BlockInfo> forks{
+      {1, fork_hash1}, {2, fork_hash2}, {3, fork_hash3}};
+  EXPECT_CALL(*storage_, getBlockDataRange(forks))
+      .WillOnce(Return(std::vector<BlockData>{
+          {fork_hash1}, {fork_hash2}, {fork_hash3}}));
+  EXPECT_CALL(*storage_, removeBlocks(forks))
+      .WillOnce(Return(outcome::success()));
+
+  // WHEN
+  ASSERT_TRUE(block_tree_->finalize(hash1, Justification{{0x45, 0xF4}}));
+
+  // THEN
+  ASSERT_EQ(block_tree_->deepestLeaf(), (BlockInfo{2, hash2}));
+  ASSERT_EQ(block_tree_->getLeaves(), std::vector<BlockHash>{hash2});
+}
+
 /**
  * @given block tree with at least three blocks inside
  * @when asking for chain from the lowest block to the closest finalized one
@@ -301,6 +482,41 @@ TEST_F(BlockTreeTest, GetChainByBlockDescending) {
   ASSERT_EQ(chain, expected_chain);
 }
 
+/**
+ * @given a block tree with a long chain and a fork from its middle
+ * @when checking if one block is an ancestor of the other
+ * @then it is for the blocks of the same chain in the right order, and is
+ * not for the blocks of different forks or in the reverse order
+ */
+TEST_F(BlockTreeTest, HasDirectChain) {
+  std::vector<BlockHash> chain{kFinalizedBlockHash};
+  for (BlockNumber number = 1; number < 40; number++) {
+    chain.push_back(addHeaderToRepository(chain.back(), number));
+  }
+  auto fork_hash = addBlock(Block{
+      BlockHeader{.parent_hash = chain[20],
+                  .number = 21,
+                  .state_root = "fork_state_root_________________"_hash256},
+      {}});
+
+  for (size_t i = 0; i < chain.size(); i++) {
+    for (size_t j = 0; j < chain.size(); j++) {
+      ASSERT_EQ(block_tree_->hasDirectChain(chain[i], chain[j]), i <= j)
+          << i << " " << j;
+    }
+    ASSERT_EQ(block_tree_->hasDirectChain(chain[i], fork_hash), i <= 20) << i;
+    ASSERT_FALSE(block_tree_->hasDirectChain(fork_hash, chain[i])) << i;
+  }
+
+  EXPECT_OUTCOME_TRUE(best,
+                      block_tree_->getBestContaining(chain[22], boost::none));
+  ASSERT_EQ(best.block_hash, chain.back());
+  EXPECT_OUTCOME_TRUE(path, block_tree_->getChainByBlocks(chain[5], chain[9]));
+  ASSERT_EQ(path,
+            std::vector<BlockHash>(chain.begin() + 5, chain.begin() + 10));
+  EXPECT_OUTCOME_FALSE_1(block_tree_->getChainByBlocks(chain[25], fork_hash));
+}
+
 /**
  * @given a block tree with one block in it
  * @when trying to obtain the best chain that contais a block, which is
@@ -379,3 +595,103 @@ TEST_F(BlockTreeTest, GetBestChain_TargetPastMax) {
   EXPECT_OUTCOME_FALSE(err, block_tree_->getBestContaining(target_hash, 42));
   ASSERT_EQ(err, BlockTreeImpl::Error::TARGET_IS_PAST_MAX);
 }
+
+/**
+ * @given block tree with a block added after the last finalized one
+ * @when the finality of the block storage is moved to another block and the
+ * tree is reset to it
+ * @then the tree consists of that block only
+ */
+TEST_F(BlockTreeTest, ResetToLastFinalized) {
+  addHeaderToRepository(kLastFinalizedBlockId, 1);
+
+  BlockHash synced_hash;
+  synced_hash.fill(7);
+  BlockHeader synced_header{.number = 1000};
+  EXPECT_CALL(*storage_, getLastFinalizedBlockHash())
+      .WillOnce(Return(synced_hash));
+  EXPECT_CALL(*storage_, getBlockHeader(BlockId{synced_hash}))
+      .WillOnce(Return(synced_header));
+
+  EXPECT_OUTCOME_TRUE_1(block_tree_->resetToLastFinalized());
+
+  ASSERT_EQ(block_tree_->getLastFinalized(), (BlockInfo{1000, synced_hash}));
+  ASSERT_EQ(block_tree_->getLeaves(), std::vector<BlockHash>{synced_hash});
+  ASSERT_EQ(block_tree_->deepestLeaf(), (BlockInfo{1000, synced_hash}));
+}
+
+/**
+ * @given block tree with two forks from the last finalized block, one of
+ * which has two blocks
+ * @when its snapshot is stored, and another tree is created from the same
+ * last finalized block
+ * @then the new tree has all the blocks, the same leaves and the same deepest
+ * leaf, and the blocks are not read from the storage
+ */
+TEST_F(BlockTreeTest, SnapshotRestoresForks) {
+  auto hash1 = addHeaderToRepository(kLastFinalizedBlockId, 1);
+  auto hash2 = addHeaderToRepository(hash1, 2);
+  BlockHeader fork_header{.parent_hash = kFinalizedBlockHash,
+                          .number = 1,
+                          .digest = {PreRuntime{}}};
+  auto fork_hash = addBlock(Block{fork_header, {}});
+
+  Buffer snapshot;
+  EXPECT_CALL(*storage_, setBlockTreeSnapshot(_))
+      .WillOnce(testing::DoAll(testing::SaveArg<0>(&snapshot),
+                               Return(outcome::success())));
+  EXPECT_OUTCOME_TRUE_1(block_tree_->storeSnapshot());
+
+  EXPECT_CALL(*storage_, getBlockHeader(kLastFinalizedBlockId))
+      .WillOnce(Return(finalized_block_header_));
+  EXPECT_CALL(*storage_, getBlockTreeSnapshot())
+      .WillOnce(
+          Return(outcome::result<boost::optional<Buffer>>(snapshot)));
+  auto restored = BlockTreeImpl::create(header_repo_,
+                                        storage_,
+                                        kLastFinalizedBlockId,
+                                        extrinsic_observer_,
+                                        hasher_)
+                      .value();
+
+  auto leaves = restored->getLeaves();
+  std::sort(leaves.begin(), leaves.end());
+  std::vector<BlockHash> expected_leaves{hash2, fork_hash};
+  std::sort(expected_leaves.begin(), expected_leaves.end());
+  ASSERT_EQ(leaves, expected_leaves);
+  ASSERT_EQ(restored->deepestLeaf(), (BlockInfo{2, hash2}));
+  EXPECT_OUTCOME_TRUE(children, restored->getChildren(hash1));
+  ASSERT_EQ(children, std::vector<BlockHash>{hash2});
+}
+
+/**
+ * @given the stored snapshot of a tree grown from another finalized block
+ * @when the tree is created
+ * @then the snapshot is skipped, and the tree has the last finalized block
+ * only
+ */
+TEST_F(BlockTreeTest, SnapshotOfAnotherRootSkipped) {
+  auto hash1 = addHeaderToRepository(kLastFinalizedBlockId, 1);
+  Buffer snapshot;
+  EXPECT_CALL(*storage_, setBlockTreeSnapshot(_))
+      .WillOnce(testing::DoAll(testing::SaveArg<0>(&snapshot),
+                               Return(outcome::success())));
+  EXPECT_OUTCOME_TRUE_1(block_tree_->storeSnapshot());
+
+  BlockHash other_finalized;
+  other_finalized.fill(7);
+  EXPECT_CALL(*storage_, getBlockHeader(BlockId{other_finalized}))
+      .WillOnce(Return(finalized_block_header_));
+  EXPECT_CALL(*storage_, getBlockTreeSnapshot())
+      .WillOnce(
+          Return(outcome::result<boost::optional<Buffer>>(snapshot)));
+  auto restored = BlockTreeImpl::create(header_repo_,
+                                        storage_,
+                                        other_finalized,
+                                        extrinsic_observer_,
+                                        hasher_)
+                      .value();
+
+  ASSERT_EQ(restored->getLeaves(), std::vector<BlockHash>{other_finalized});
+  EXPECT_OUTCOME_FALSE_1(restored->getChildren(hash1));
+}
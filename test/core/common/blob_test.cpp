@@ -125,3 +125,21 @@ TEST(BlobTest, ToStringTest) {
 
   ASSERT_EQ(blob.toString(), std::string(expected.begin(), expected.end()));
 }
+
+/**
+ * @given blobs differing in a single byte only, at the start or at the end
+ * @when their hashes are taken
+ * @then the hashes differ from the one of the original blob
+ */
+TEST(BlobTest, HashTakesAllBytes) {
+  Blob<32> blob;
+  blob.fill(7);
+  auto first = blob;
+  first[0] = 8;
+  auto last = blob;
+  last[31] = 8;
+  std::hash<Blob<32>> hash;
+  EXPECT_EQ(hash(blob), hash(Blob<32>{blob}));
+  EXPECT_NE(hash(blob), hash(first));
+  EXPECT_NE(hash(blob), hash(last));
+}
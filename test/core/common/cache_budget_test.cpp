@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/cache_budget.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::common::BudgetedCache;
+using kagome::common::CacheBudget;
+using kagome::common::MetricsRegistry;
+
+/// cache, which usage is set by the test
+class FakeCache : public BudgetedCache {
+ public:
+  Usage usage() const override {
+    return usage_;
+  }
+
+  void setBudget(size_t bytes) override {
+    budget = bytes;
+    usage_.bytes = std::min(usage_.bytes, bytes);
+  }
+
+  /// fills the budget, and adds the lookups
+  void lookups(uint64_t hits, uint64_t misses, bool full = true) {
+    usage_.hits += hits;
+    usage_.misses += misses;
+    usage_.bytes = full ? budget : budget / 2;
+  }
+
+  size_t budget = 0;
+
+ private:
+  Usage usage_;
+};
+
+class CacheBudgetTest : public testing::Test {
+ public:
+  static constexpr size_t kTotal = 1000;
+
+  void SetUp() override {
+    budget->add("a", a, 300);
+    budget->add("b", b, 100);
+  }
+
+  std::shared_ptr<boost::asio::io_context> io_context =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<CacheBudget> budget =
+      std::make_shared<CacheBudget>(kTotal, io_context);
+  std::shared_ptr<FakeCache> a = std::make_shared<FakeCache>();
+  std::shared_ptr<FakeCache> b = std::make_shared<FakeCache>();
+};
+
+/**
+ * @given caches added to the budget with their configured sizes
+ * @then the total is shared in proportion to the sizes
+ */
+TEST_F(CacheBudgetTest, InitialShares) {
+  ASSERT_EQ(a->budget, 750);
+  ASSERT_EQ(b->budget, 250);
+}
+
+/**
+ * @given a cache, which misses while its budget is full, and a cache, which
+ * does not fill its budget
+ * @when the budget is rebalanced
+ * @then the budget moves to the full cache, and the other one keeps its
+ * usage with a margin
+ */
+TEST_F(CacheBudgetTest, MovesToFullCache) {
+  a->lookups(10, 10, false);
+  b->lookups(50, 50);
+  budget->rebalance();
+  // a keeps 375 + 375 / 4 = 468, b gets the rest and moves half way to it
+  ASSERT_EQ(a->budget, 750 / 2 + 468 / 2);
+  ASSERT_EQ(b->budget, 250 / 2 + (kTotal - 468) / 2);
+  ASSERT_LE(a->budget + b->budget, kTotal);
+}
+
+/**
+ * @given full caches, which only hit or only miss
+ * @when the budget is rebalanced
+ * @then nothing is gained by moving it, and it is left as it is
+ */
+TEST_F(CacheBudgetTest, KeepsWithoutBenefit) {
+  a->lookups(10, 0);
+  b->lookups(0, 10);
+  budget->rebalance();
+  ASSERT_EQ(a->budget, 750);
+  ASSERT_EQ(b->budget, 250);
+}
+
+/**
+ * @given full caches, which both miss, one of them with a higher hit rate
+ * @when the budget is rebalanced repeatedly
+ * @then the cache gaining more hits per byte gets the larger share, while
+ * the other keeps its floor, and the total is never exceeded
+ */
+TEST_F(CacheBudgetTest, SharesByMarginalBenefit) {
+  for (auto i = 0; i < 10; ++i) {
+    a->lookups(10, 90);
+    b->lookups(90, 10);
+    budget->rebalance();
+    ASSERT_LE(a->budget + b->budget, kTotal);
+  }
+  ASSERT_GT(b->budget, a->budget);
+  ASSERT_GE(a->budget, kTotal / (2 * CacheBudget::kFloorDivisor));
+}
+
+/**
+ * @given caches sharing the budget
+ * @when the metrics are collected
+ * @then their budgets and usage are written
+ */
+TEST_F(CacheBudgetTest, Collect) {
+  a->lookups(3, 4);
+  MetricsRegistry::Writer writer;
+  budget->collect(writer);
+  auto &text = writer.text();
+  EXPECT_NE(text.find("kagome_cache_budget_bytes{cache=\"a\"} 750"),
+            std::string::npos);
+  EXPECT_NE(text.find("kagome_cache_hits_total{cache=\"a\"} 3"),
+            std::string::npos);
+  EXPECT_NE(text.find("kagome_cache_misses_total{cache=\"b\"} 0"),
+            std::string::npos);
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/flat_hash_map.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+using kagome::common::FlatHashMap;
+using kagome::common::FlatHashSet;
+
+/**
+ * @given a flat map and a node based one
+ * @when the same random insertions, lookups and erasures are made in both
+ * @then the maps have the same entries all the time
+ */
+TEST(FlatHashMapTest, MatchesUnorderedMap) {
+  FlatHashMap<uint64_t, std::string> map;
+  std::unordered_map<uint64_t, std::string> expected;
+  std::mt19937_64 random{1};
+  for (size_t i = 0; i < 100000; ++i) {
+    auto key = random() % 1000;
+    switch (random() % 4) {
+      case 0:
+        ASSERT_EQ(map.try_emplace(key, std::to_string(key)).second,
+                  expected.try_emplace(key, std::to_string(key)).second);
+        break;
+      case 1:
+        ASSERT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 2:
+        map[key] += "x";
+        expected[key] += "x";
+        break;
+      default:
+        ASSERT_EQ(map.count(key), expected.count(key));
+        if (auto it = map.find(key); it != map.end()) {
+          ASSERT_EQ(it->second, expected.at(key));
+        }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+  size_t iterated = 0;
+  for (auto &[key, value] : map) {
+    ASSERT_EQ(value, expected.at(key));
+    ++iterated;
+  }
+  ASSERT_EQ(iterated, expected.size());
+}
+
+/**
+ * @given a flat map
+ * @when the entries are erased while it is iterated
+ * @then the rest of the entries are visited once each and stay in the map
+ */
+TEST(FlatHashMapTest, EraseWhileIterating) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace(i, i);
+  }
+  size_t visited = 0;
+  for (auto it = map.begin(); it != map.end();) {
+    ++visited;
+    it = it->first % 2 == 0 ? map.erase(it) : std::next(it);
+  }
+  ASSERT_EQ(visited, 100);
+  ASSERT_EQ(map.size(), 50);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(map.count(i), i % 2);
+  }
+}
+
+/**
+ * @given a flat set
+ * @when keys are inserted again, erased and the set is cleared
+ * @then each key is kept once, until it is removed
+ */
+TEST(FlatHashMapTest, Set) {
+  FlatHashSet<std::string> set;
+  set.reserve(100);
+  ASSERT_TRUE(set.insert("a").second);
+  ASSERT_FALSE(set.insert("a").second);
+  ASSERT_TRUE(set.emplace("b").second);
+  ASSERT_EQ(set.size(), 2);
+  ASSERT_EQ(set.erase("a"), 1);
+  ASSERT_EQ(set.erase("a"), 0);
+  ASSERT_TRUE(set.contains("b"));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.begin(), set.end());
+}
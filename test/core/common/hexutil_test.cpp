@@ -60,6 +60,59 @@ TEST(Common, Hexutil_UnhexInvalid) {
       << "unhex did not return an error as expected";
 }
 
+/**
+ * @given byte arrays of the lengths around the ones encoded at once, with
+ * all the values of bytes
+ * @when they are hexed in both cases, in place, and unhexed back
+ * @then each byte is encoded as its two digits, and is decoded back
+ */
+TEST(Common, Hexutil_RoundTrip) {
+  for (size_t size : {0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 256}) {
+    std::vector<uint8_t> bytes(size);
+    std::string expected;
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i] = static_cast<uint8_t>(i * 7 + size);
+      char digits[3];
+      std::snprintf(digits, sizeof(digits), "%02x", bytes[i]);
+      expected += digits;
+    }
+    ASSERT_EQ(hex_lower(bytes), expected);
+    std::string in_place(size * 2, '\x00');
+    hex_lower(bytes, in_place);
+    ASSERT_EQ(in_place, expected);
+
+    auto upper = hex_upper(bytes);
+    EXPECT_OUTCOME_TRUE(from_lower, unhex(expected));
+    EXPECT_OUTCOME_TRUE(from_upper, unhex(upper));
+    ASSERT_EQ(from_lower, bytes);
+    ASSERT_EQ(from_upper, bytes);
+  }
+}
+
+/**
+ * @given hexencoded strings with a non-hex char in a pair or at the end,
+ * and of an odd length
+ * @when unhex
+ * @then the errors tell the non-hex chars from the missing one
+ */
+TEST(Common, Hexutil_UnhexErrors) {
+  EXPECT_OUTCOME_ERROR(r1, unhex("00g0"), UnhexError::NON_HEX_INPUT);
+  EXPECT_OUTCOME_ERROR(r2, unhex("000"), UnhexError::NOT_ENOUGH_INPUT);
+  EXPECT_OUTCOME_ERROR(r3, unhex("00x"), UnhexError::NON_HEX_INPUT);
+  std::vector<uint8_t> out(1);
+  EXPECT_OUTCOME_ERROR(r4, unhex("0z", out), UnhexError::NON_HEX_INPUT);
+
+  // the chars next to the ranges of the digits and the letters, anywhere in
+  // a long string
+  for (char c : {'/', ':', '@', 'G', '`', 'g', ' ', '\x80', '\xff'}) {
+    for (size_t pos : {0, 7, 15, 16, 40}) {
+      std::string hex(48, 'a');
+      hex[pos] = c;
+      EXPECT_OUTCOME_ERROR(r, unhex(hex), UnhexError::NON_HEX_INPUT);
+    }
+  }
+}
+
 struct UnhexNumber32Test
     : public ::testing::TestWithParam<std::pair<std::string, size_t>> {};
 
@@ -0,0 +1,82 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/memory_arena.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using kagome::common::ArenaAllocator;
+using kagome::common::MemoryArena;
+using kagome::common::MemoryArenas;
+using kagome::common::MemoryCharge;
+using kagome::common::MetricsRegistry;
+
+/**
+ * @given the arena of the trie nodes
+ * @when an object is allocated with its allocator and freed
+ * @then the bytes of the object and its control block are counted while it
+ * lives, and the counters go back once it is freed
+ */
+TEST(MemoryArenaTest, CountsSharedObjects) {
+  constexpr auto arena = MemoryArena::TRIE_NODES;
+  auto before = MemoryArenas::stats(arena);
+  auto object = std::allocate_shared<std::array<uint64_t, 8>>(
+      ArenaAllocator<int, arena>{});
+  auto during = MemoryArenas::stats(arena);
+  ASSERT_EQ(during.allocations, before.allocations + 1);
+  ASSERT_GE(during.bytes, before.bytes + sizeof(*object));
+  object.reset();
+  auto after = MemoryArenas::stats(arena);
+  ASSERT_EQ(after.allocations, before.allocations);
+  ASSERT_EQ(after.bytes, before.bytes);
+}
+
+/**
+ * @given the arena of the runtime memory
+ * @when a small block is freed and one of the same size is allocated, and a
+ * large block is allocated
+ * @then the freed block is reused by the thread, and the large one is
+ * counted by its exact size
+ */
+TEST(MemoryArenaTest, ReusesSmallBlocksOfThread) {
+  constexpr auto arena = MemoryArena::RUNTIME_MEMORY;
+  auto block = MemoryArenas::allocate(arena, 100);
+  MemoryArenas::deallocate(arena, block, 100);
+  auto reused = MemoryArenas::allocate(arena, 97);
+  ASSERT_EQ(reused, block);
+  MemoryArenas::deallocate(arena, reused, 97);
+
+  auto before = MemoryArenas::stats(arena);
+  {
+    std::vector<uint8_t, ArenaAllocator<uint8_t, arena>> bytes(
+        MemoryArenas::kMaxCachedSize + 1);
+    ASSERT_EQ(MemoryArenas::stats(arena).bytes,
+              before.bytes + MemoryArenas::kMaxCachedSize + 1);
+  }
+  ASSERT_EQ(MemoryArenas::stats(arena).bytes, before.bytes);
+}
+
+/**
+ * @given the arena of the network buffers
+ * @when a charge lives and the metrics are collected
+ * @then the charged bytes are counted and written as the gauge of the arena
+ */
+TEST(MemoryArenaTest, ChargesAndCollects) {
+  constexpr auto arena = MemoryArena::NETWORK_BUFFERS;
+  auto before = MemoryArenas::stats(arena);
+  {
+    MemoryCharge charge{arena, 1000};
+    ASSERT_EQ(MemoryArenas::stats(arena).bytes, before.bytes + 1000);
+
+    MetricsRegistry::Writer writer;
+    MemoryArenas::collect(writer);
+    auto sample = "kagome_memory_arena_bytes{arena=\"network_buffers\"} "
+                  + std::to_string(before.bytes + 1000) + "\n";
+    ASSERT_NE(writer.text().find(sample), std::string::npos);
+  }
+  ASSERT_EQ(MemoryArenas::stats(arena).bytes, before.bytes);
+}
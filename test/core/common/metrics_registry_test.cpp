@@ -0,0 +1,98 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/metrics_registry.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using kagome::common::MetricsRegistry;
+
+/**
+ * @given a counter and a gauge with the labels, and another counter
+ * @when they are updated and the registry is scraped
+ * @then each family is described once and is followed by its samples
+ */
+TEST(MetricsRegistryTest, CountersAndGauges) {
+  MetricsRegistry registry;
+  registry.counter("requests_total", "Requests", {{"method", "a"}}).inc(2);
+  registry.counter("requests_total", "Requests", {{"method", "b"}}).inc();
+  // the same counter is returned for the same labels
+  registry.counter("requests_total", "Requests", {{"method", "a"}}).inc();
+  auto &gauge = registry.gauge("peers", "Peers\nconnected");
+  gauge.set(5);
+  gauge.dec(7);
+
+  EXPECT_EQ(registry.exposition(),
+            "# HELP peers Peers\\nconnected\n"
+            "# TYPE peers gauge\n"
+            "peers -2\n"
+            "# HELP requests_total Requests\n"
+            "# TYPE requests_total counter\n"
+            "requests_total{method=\"a\"} 3\n"
+            "requests_total{method=\"b\"} 1\n");
+}
+
+/**
+ * @given a histogram
+ * @when the values are observed by several threads at once
+ * @then the buckets are cumulative, and none of the values is lost
+ */
+TEST(MetricsRegistryTest, Histogram) {
+  MetricsRegistry registry;
+  auto &histogram = registry.histogram("sizes", "Sizes", {}, {1, 10});
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (auto j = 0; j < 1000; ++j) {
+        histogram.observe(0.5);
+        histogram.observe(10.0);
+        histogram.observe(100.0);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.buckets, (std::vector<uint64_t>{4000, 8000, 12000}));
+  EXPECT_DOUBLE_EQ(snapshot.sum, 4000 * 110.5);
+  EXPECT_EQ(registry.exposition(),
+            "# HELP sizes Sizes\n"
+            "# TYPE sizes histogram\n"
+            "sizes_bucket{le=\"1\"} 4000\n"
+            "sizes_bucket{le=\"10\"} 8000\n"
+            "sizes_bucket{le=\"+Inf\"} 12000\n"
+            "sizes_sum 442000\n"
+            "sizes_count 12000\n");
+}
+
+/**
+ * @given a collector writing the durations kept by a subsystem
+ * @when the registry is scraped
+ * @then they are written as a summary in seconds, with the escaped labels
+ */
+TEST(MetricsRegistryTest, Collector) {
+  MetricsRegistry registry;
+  registry.addCollector([](MetricsRegistry::Writer &writer) {
+    kagome::common::DurationHistogram::Stats stats;
+    stats.calls = 2;
+    stats.total = std::chrono::milliseconds(1500);
+    stats.p99 = std::chrono::seconds(1);
+    stats.max = std::chrono::seconds(1);
+    writer.family("call_seconds", MetricsRegistry::Type::SUMMARY, "Calls");
+    writer.durations("call_seconds", {{"name", "a\"b"}}, stats);
+  });
+
+  EXPECT_EQ(registry.exposition(),
+            "# HELP call_seconds Calls\n"
+            "# TYPE call_seconds summary\n"
+            "call_seconds{name=\"a\\\"b\",quantile=\"0.99\"} 1\n"
+            "call_seconds{name=\"a\\\"b\",quantile=\"1\"} 1\n"
+            "call_seconds_sum{name=\"a\\\"b\"} 1.5\n"
+            "call_seconds_count{name=\"a\\\"b\"} 2\n");
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/process_profiler.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include "testutil/outcome.hpp"
+
+using kagome::common::MetricsRegistry;
+using kagome::common::ProcessProfiler;
+using namespace std::chrono_literals;
+
+class ProcessProfilerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    directory_ = (boost::filesystem::temp_directory_path()
+                  / boost::filesystem::unique_path())
+                     .string();
+    profiler_ = std::make_shared<ProcessProfiler>(directory_, io_context_);
+  }
+
+  void TearDown() override {
+    profiler_.reset();
+    boost::filesystem::remove_all(directory_);
+  }
+
+ protected:
+  std::string directory_;
+  std::shared_ptr<boost::asio::io_context> io_context_ =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<ProcessProfiler> profiler_;
+};
+
+/**
+ * @given a profiler without the directory of the profiles
+ * @when a profile is started
+ * @then it is refused as the profiles are disabled
+ */
+TEST_F(ProcessProfilerTest, DisabledWithoutDirectory) {
+  auto profiler = std::make_shared<ProcessProfiler>("", io_context_);
+  ASSERT_FALSE(profiler->isEnabled());
+  EXPECT_OUTCOME_ERROR(
+      res, profiler->start(ProcessProfiler::Kind::CPU, 1s),
+      ProcessProfiler::Error::DISABLED);
+}
+
+/**
+ * @given an enabled profiler
+ * @when a profile is started for no time or for longer than the max one
+ * @then it is refused
+ */
+TEST_F(ProcessProfilerTest, InvalidDuration) {
+  EXPECT_OUTCOME_ERROR(
+      res, profiler_->start(ProcessProfiler::Kind::HEAP, 0s),
+      ProcessProfiler::Error::INVALID_DURATION);
+  EXPECT_OUTCOME_ERROR(res2,
+                       profiler_->start(ProcessProfiler::Kind::HEAP,
+                                        ProcessProfiler::kMaxDuration + 1s),
+                       ProcessProfiler::Error::INVALID_DURATION);
+}
+
+/**
+ * @given an enabled profiler
+ * @when a CPU profile is started, again while it runs, and stopped twice
+ * @then it is written to the directory if gperftools is there, the second
+ * start and stop fail, and it is refused as not supported otherwise
+ */
+TEST_F(ProcessProfilerTest, StartsAndStopsCpuProfile) {
+  if (not ProcessProfiler::isSupported(ProcessProfiler::Kind::CPU)) {
+    EXPECT_OUTCOME_ERROR(
+        res, profiler_->start(ProcessProfiler::Kind::CPU, 1s),
+        ProcessProfiler::Error::NOT_SUPPORTED);
+    EXPECT_OUTCOME_ERROR(
+        res2, profiler_->stop(), ProcessProfiler::Error::NOT_RUNNING);
+    return;
+  }
+  EXPECT_OUTCOME_TRUE(path, profiler_->start(ProcessProfiler::Kind::CPU, 1s));
+  EXPECT_OUTCOME_ERROR(
+      res, profiler_->start(ProcessProfiler::Kind::CPU, 1s),
+      ProcessProfiler::Error::ALREADY_RUNNING);
+  EXPECT_OUTCOME_TRUE_1(profiler_->stop());
+  EXPECT_OUTCOME_ERROR(
+      res2, profiler_->stop(), ProcessProfiler::Error::NOT_RUNNING);
+  ASSERT_EQ(boost::filesystem::path{path}.parent_path().string(),
+            directory_);
+  ASSERT_TRUE(boost::filesystem::exists(path));
+}
+
+/**
+ * @given the allocator of the process
+ * @when its statistics are collected
+ * @then the gauges are written if it is jemalloc or tcmalloc, and nothing is
+ * otherwise
+ */
+TEST_F(ProcessProfilerTest, CollectsAllocatorStats) {
+  MetricsRegistry::Writer writer;
+  ProcessProfiler::collect(writer);
+  auto stats = ProcessProfiler::allocatorStats();
+  if (not stats) {
+    ASSERT_TRUE(writer.text().empty());
+    return;
+  }
+  ASSERT_GT(stats->heap, 0);
+  ASSERT_NE(writer.text().find("kagome_allocator_allocated_bytes{allocator=\""
+                               + stats->allocator + "\"}"),
+            std::string::npos);
+}
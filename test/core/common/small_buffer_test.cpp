@@ -0,0 +1,56 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/small_buffer.hpp"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+using kagome::common::Buffer;
+using kagome::common::SmallBuffer;
+
+/**
+ * @given small buffers of the contents shorter and longer than the inline
+ * capacity
+ * @when bytes are put into them
+ * @then they keep the bytes in order and are compared as the buffers of the
+ * same bytes
+ */
+TEST(SmallBuffer, PutAndCompare) {
+  SmallBuffer<4> b{1, 2};
+  b.putUint8(3).put(std::vector<uint8_t>{4, 5, 6});
+  ASSERT_EQ(b.size(), 6);
+  ASSERT_EQ(b.toHex(), "010203040506");
+  ASSERT_EQ(b.subbuffer(1, 2), (SmallBuffer<4>{2, 3}));
+
+  Buffer same{1, 2, 3, 4, 5, 6};
+  ASSERT_TRUE(b == same);
+  ASSERT_TRUE(same == b);
+  ASSERT_FALSE(b != same);
+
+  Buffer longer{1, 2, 3, 4, 5, 6, 0};
+  ASSERT_TRUE(b < longer);
+  ASSERT_FALSE(longer < b);
+  ASSERT_TRUE(SmallBuffer<4>{longer} == longer);
+  ASSERT_TRUE(SmallBuffer<4>{longer} < SmallBuffer<4>{0xff});
+}
+
+/**
+ * @given a map keyed by the small buffers with a transparent comparator
+ * @when it is looked up with the buffers
+ * @then the entries of the same bytes are found
+ */
+TEST(SmallBuffer, HeterogeneousLookup) {
+  std::map<SmallBuffer<8>, int, std::less<>> map;
+  map.emplace(SmallBuffer<8>{1, 2}, 1);
+  map.emplace(SmallBuffer<8>{1, 2, 3}, 2);
+  map.emplace(SmallBuffer<8>{2}, 3);
+
+  ASSERT_EQ(map.find(Buffer{1, 2, 3})->second, 2);
+  ASSERT_EQ(map.find(Buffer{1}), map.end());
+  ASSERT_EQ(map.lower_bound(Buffer{1, 2, 4})->second, 3);
+  ASSERT_EQ(map.upper_bound(Buffer{1, 2})->second, 2);
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/tracer.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using kagome::common::Tracer;
+using namespace std::chrono_literals;
+
+/**
+ * @given a disabled tracer
+ * @when spans are scoped, and the tracer is enabled in the middle of one
+ * @then only the spans started while it is enabled are recorded
+ */
+TEST(TracerTest, DisabledRecordsNothing) {
+  Tracer tracer;
+  { Tracer::Scope scope{&tracer, "block", "disabled"}; }
+  {
+    Tracer::Scope scope{&tracer, "block", "enabled_later"};
+    tracer.setEnabled(true);
+  }
+  { Tracer::Scope scope{nullptr, "block", "no_tracer"}; }
+  ASSERT_TRUE(tracer.spans().empty());
+
+  { Tracer::Scope scope{&tracer, "block", "enabled"}; }
+  auto spans = tracer.spans();
+  ASSERT_EQ(spans.size(), 1);
+  ASSERT_EQ(spans[0].category, "block");
+  ASSERT_EQ(spans[0].name, "enabled");
+}
+
+/**
+ * @given an enabled tracer keeping 3 spans per thread
+ * @when the nested spans are scoped on two threads, more than 3 on one
+ * @then the latest 3 spans of each thread are kept, ordered by their starts,
+ * and the outer spans cover the inner ones
+ */
+TEST(TracerTest, KeepsLatestSpansOfThreads) {
+  Tracer tracer{true, 3};
+  auto scopes = [&](size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      Tracer::Scope outer{&tracer, "block", "outer"};
+      Tracer::Scope inner{&tracer, "block", "inner"};
+      std::this_thread::sleep_for(1ms);
+    }
+  };
+  scopes(3);
+  std::thread{scopes, 1}.join();
+
+  auto spans = tracer.spans();
+  ASSERT_EQ(spans.size(), 5);
+  for (size_t i = 1; i < spans.size(); ++i) {
+    ASSERT_LE(spans[i - 1].start, spans[i].start);
+  }
+  // the inner span of the last iteration and the outer one of it
+  ASSERT_EQ(spans[3].name, "outer");
+  ASSERT_EQ(spans[4].name, "inner");
+  ASSERT_NE(spans[3].thread, spans[0].thread);
+  ASSERT_GE(spans[3].duration, spans[4].duration);
+  ASSERT_GE(spans[3].start + spans[3].duration,
+            spans[4].start + spans[4].duration);
+
+  tracer.reset();
+  ASSERT_TRUE(tracer.spans().empty());
+}
+
+/**
+ * @given a tracer with a span
+ * @when the trace is exported
+ * @then it is a complete event of the Chrome trace format
+ */
+TEST(TracerTest, ChromeTrace) {
+  Tracer tracer{true};
+  auto start = Tracer::Clock::now();
+  tracer.record("runtime", "Core_\"execute\"", start, 1500ns);
+  auto trace = tracer.chromeTrace();
+  ASSERT_EQ(trace.find("{\"traceEvents\":[{\"name\":\"Core_\\\"execute\\\"\","
+                       "\"cat\":\"runtime\",\"ph\":\"X\",\"ts\":"),
+            0);
+  ASSERT_NE(trace.find(",\"dur\":1.500,\"pid\":1,\"tid\":0}],"
+                       "\"displayTimeUnit\":\"ms\"}"),
+            std::string::npos);
+}
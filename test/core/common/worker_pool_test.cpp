@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "common/worker_pool.hpp"
+
+#include <atomic>
+#include <set>
+
+#include <gtest/gtest.h>
+
+using kagome::common::WorkerPool;
+
+/**
+ * @given a pool of several threads
+ * @when more tasks than the threads are run on it
+ * @then the results of all of them are got, and the tasks are run by the
+ * threads of the pool only, which are not the calling one
+ */
+TEST(WorkerPoolTest, RunsTasksOnItsThreads) {
+  constexpr size_t kThreads = 3;
+  WorkerPool pool{kThreads};
+  ASSERT_EQ(pool.threadsNum(), kThreads);
+
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::vector<std::future<size_t>> results;
+  for (size_t i = 0; i < 100; ++i) {
+    results.emplace_back(pool.async([&, i] {
+      std::lock_guard lock{mutex};
+      threads.insert(std::this_thread::get_id());
+      return i * i;
+    }));
+  }
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+  EXPECT_LE(threads.size(), kThreads);
+  EXPECT_EQ(threads.count(std::this_thread::get_id()), 0);
+}
+
+/**
+ * @given a pool with tasks queued
+ * @when the pool is destroyed
+ * @then the queued tasks are run before its threads are joined
+ */
+TEST(WorkerPoolTest, RunsQueuedTasksOnDestruction) {
+  std::atomic_size_t done = 0;
+  {
+    WorkerPool pool{1};
+    for (size_t i = 0; i < 10; ++i) {
+      pool.post([&] { ++done; });
+    }
+  }
+  EXPECT_EQ(done, 10);
+}
+
+/**
+ * @given a pool of several threads
+ * @when indices are run in parallel by a thread outside of the pool and by a
+ * task of the pool, which all of its threads are busy with
+ * @then each index is run once, and the task doesn't wait for the ones
+ * queued behind it
+ */
+TEST(WorkerPoolTest, ParallelForRunsEachIndexOnce) {
+  constexpr size_t kThreads = 2;
+  constexpr size_t kIndices = 1000;
+  WorkerPool pool{kThreads};
+
+  std::vector<std::atomic_size_t> runs(kIndices);
+  pool.parallelFor(kIndices, [&](size_t i) { ++runs[i]; });
+  for (auto &run : runs) {
+    EXPECT_EQ(run, 1);
+  }
+
+  std::vector<std::future<void>> tasks;
+  for (size_t i = 0; i < kThreads; ++i) {
+    tasks.emplace_back(pool.async([&] {
+      EXPECT_TRUE(pool.isOwnThread());
+      pool.parallelFor(kIndices, [&](size_t i) { ++runs[i]; });
+    }));
+  }
+  for (auto &task : tasks) {
+    task.get();
+  }
+  for (auto &run : runs) {
+    EXPECT_EQ(run, 1 + kThreads);
+  }
+  EXPECT_FALSE(pool.isOwnThread());
+}
@@ -0,0 +1,347 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "consensus/babe/impl/babe_synchronizer_impl.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/clock/clock_mock.hpp"
+#include "mock/core/network/sync_protocol_client_mock.hpp"
+#include "network/impl/peer_manager_impl.hpp"
+#include "scale/scale.hpp"
+
+using namespace kagome;
+using namespace consensus;
+using namespace network;
+using namespace primitives;
+
+using testing::_;
+using testing::Invoke;
+
+using ResponseCallback = std::function<void(outcome::result<BlocksResponse>)>;
+
+class BabeSynchronizerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    for (auto &client : clients_) {
+      client = std::make_shared<SyncProtocolClientMock>();
+      sync_clients_->clients.push_back(client);
+    }
+    synchronizer_ = std::make_shared<BabeSynchronizerImpl>(
+        sync_clients_, hasher_, kBatchSize);
+
+    // a chain of blocks, each one with a body of its own
+    BlockHash parent{};
+    for (BlockNumber number = 1; number <= 5; ++number) {
+      Block block;
+      block.header.number = number;
+      block.header.parent_hash = parent;
+      block.body.push_back(Extrinsic{common::Buffer{uint8_t(number)}});
+      parent = hasher_->blake2b_256(scale::encode(block.header).value());
+      chain_.push_back(block);
+      hashes_.push_back(parent);
+    }
+  }
+
+  /**
+   * Answers \arg request with the requested parts of the blocks of the chain
+   */
+  BlocksResponse respond(const BlocksRequest &request) const {
+    BlocksResponse response{request.id};
+    const auto &from = boost::get<BlockHash>(request.from);
+    auto first = std::find(hashes_.begin(), hashes_.end(), from);
+    auto last = std::find(hashes_.begin(), hashes_.end(), *request.to);
+    for (auto it = first; it <= last; ++it) {
+      const auto &block = chain_[it - hashes_.begin()];
+      auto &block_data = response.blocks.emplace_back(BlockData{*it});
+      if (request.attributeIsSet(BlockAttributesBits::HEADER)) {
+        block_data.header = block.header;
+      }
+      if (request.attributeIsSet(BlockAttributesBits::BODY)) {
+        block_data.body = block.body;
+      }
+    }
+    return response;
+  }
+
+  /**
+   * Makes \arg client answer the requests once the responses are delivered,
+   * \arg requests are filled with the requests it receives
+   */
+  void serve(const std::shared_ptr<SyncProtocolClientMock> &client,
+             std::vector<BlocksRequest> &requests) {
+    EXPECT_CALL(*client, requestBlocks(_, _))
+        .WillRepeatedly(Invoke([this, &requests](const BlocksRequest &request,
+                                                 const ResponseCallback &cb) {
+          requests.push_back(request);
+          responses_.emplace_back(
+              [this, request, cb] { cb(respond(request)); });
+        }));
+  }
+
+  /**
+   * Delivers the responses in the order of the requests, until there are
+   * none
+   */
+  void deliver() {
+    while (not responses_.empty()) {
+      auto response = std::move(responses_.front());
+      responses_.pop_front();
+      response();
+    }
+  }
+
+  static constexpr size_t kBatchSize = 2;
+
+  std::shared_ptr<crypto::Hasher> hasher_ =
+      std::make_shared<crypto::HasherImpl>();
+  std::shared_ptr<SyncClientsSet> sync_clients_ =
+      std::make_shared<SyncClientsSet>();
+  std::array<std::shared_ptr<SyncProtocolClientMock>, 2> clients_;
+  std::shared_ptr<BabeSynchronizerImpl> synchronizer_;
+
+  std::vector<Block> chain_;
+  std::vector<BlockHash> hashes_;
+  std::deque<std::function<void()>> responses_;
+};
+
+/**
+ * @given synchronizer requesting the bodies in batches of two blocks from two
+ * peers
+ * @when five blocks are requested
+ * @then the headers are requested from the announcing peer, and the bodies
+ * from both peers, the last batch is taken over by the peer which is done
+ * with its batch while the other peer is not, and all the blocks are received
+ * in order
+ */
+TEST_F(BabeSynchronizerTest, HeadersFirst) {
+  std::vector<BlocksRequest> requests0, requests1;
+  serve(clients_[0], requests0);
+  serve(clients_[1], requests1);
+
+  std::vector<Block> received;
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+
+  ASSERT_EQ(received, chain_);
+  // the headers and the bodies of the 1st and 3rd batches
+  ASSERT_EQ(requests0.size(), 3);
+  ASSERT_TRUE(requests0[0].attributeIsSet(BlockAttributesBits::HEADER));
+  ASSERT_FALSE(requests0[0].attributeIsSet(BlockAttributesBits::BODY));
+  ASSERT_EQ(boost::get<BlockHash>(requests0[2].from), hashes_[4]);
+  // the bodies of the 2nd batch, and of the 3rd one taken over
+  ASSERT_EQ(requests1.size(), 2);
+  ASSERT_TRUE(requests1[0].attributeIsSet(BlockAttributesBits::BODY));
+  ASSERT_FALSE(requests1[0].attributeIsSet(BlockAttributesBits::HEADER));
+  ASSERT_EQ(boost::get<BlockHash>(requests1[0].from), hashes_[2]);
+  ASSERT_EQ(requests1[0].to, hashes_[3]);
+  ASSERT_EQ(boost::get<BlockHash>(requests1[1].from), hashes_[4]);
+}
+
+/**
+ * @given synchronizer requesting the bodies from two peers
+ * @when one of the peers never responds
+ * @then its batch is taken over by the other peer
+ */
+TEST_F(BabeSynchronizerTest, TakesOverBatchOfSlowPeer) {
+  std::vector<BlocksRequest> requests0;
+  serve(clients_[0], requests0);
+  std::vector<ResponseCallback> unanswered;
+  EXPECT_CALL(*clients_[1], requestBlocks(_, _))
+      .WillRepeatedly(
+          Invoke([&](const BlocksRequest &, const ResponseCallback &cb) {
+            unanswered.push_back(cb);
+          }));
+
+  std::vector<Block> received;
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+
+  ASSERT_EQ(received, chain_);
+  ASSERT_EQ(unanswered.size(), 1);
+  ASSERT_EQ(requests0.size(), 4);
+}
+
+/**
+ * @given synchronizer requesting the bodies from two peers
+ * @when one of the peers fails to return the bodies
+ * @then they are requested from the other peer
+ */
+TEST_F(BabeSynchronizerTest, RetriesBodiesFromNextPeer) {
+  std::vector<BlocksRequest> requests0;
+  serve(clients_[0], requests0);
+  EXPECT_CALL(*clients_[1], requestBlocks(_, _))
+      .WillRepeatedly(
+          Invoke([this](const BlocksRequest &request, ResponseCallback cb) {
+            responses_.emplace_back(
+                [request, cb] { cb(BlocksResponse{request.id}); });
+          }));
+
+  std::vector<Block> received;
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+
+  ASSERT_EQ(received, chain_);
+  ASSERT_EQ(requests0.size(), 4);
+}
+
+/**
+ * @given synchronizer requesting the headers first
+ * @when a received header is not the child of the previous one
+ * @then only the blocks before it are downloaded
+ */
+TEST_F(BabeSynchronizerTest, DropsUnchainedHeaders) {
+  chain_[2].header.parent_hash = hashes_[0];
+  hashes_[2] = hasher_->blake2b_256(scale::encode(chain_[2].header).value());
+  std::vector<BlocksRequest> requests0, requests1;
+  serve(clients_[0], requests0);
+  serve(clients_[1], requests1);
+
+  std::vector<Block> received;
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+
+  ASSERT_EQ(received, std::vector<Block>(chain_.begin(), chain_.begin() + 2));
+  ASSERT_EQ(requests0.size(), 2);
+  ASSERT_TRUE(requests1.empty());
+}
+
+/**
+ * @given synchronizer with a peer manager
+ * @when a peer sends the invalid blocks until it is banned
+ * @then neither the blocks it announces nor the bodies of the others are
+ * requested from it
+ */
+TEST_F(BabeSynchronizerTest, SkipsBannedPeer) {
+  auto peer_manager = std::make_shared<PeerManagerImpl>(
+      std::make_shared<testing::NiceMock<clock::SteadyClockMock>>());
+  synchronizer_ = std::make_shared<BabeSynchronizerImpl>(
+      sync_clients_, hasher_, kBatchSize, peer_manager);
+  clients_[1]->peer_id =
+      libp2p::peer::PeerId::fromBase58(
+          "QmWfTgC2DEt9FhPoccnh5vT5xM5wqWy37EnAPZFQgqheZ6")
+          .value();
+  for (size_t i = 0; i < PeerManagerImpl::kBanThreshold; ++i) {
+    synchronizer_->reportInvalidBlock(1);
+  }
+  ASSERT_TRUE(peer_manager->isBanned(*clients_[1]->peer_id));
+  std::vector<BlocksRequest> requests0;
+  serve(clients_[0], requests0);
+  EXPECT_CALL(*clients_[1], requestBlocks(_, _)).Times(0);
+
+  std::vector<Block> received;
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 1, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+  ASSERT_TRUE(received.empty());
+
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  deliver();
+  ASSERT_EQ(received, chain_);
+  ASSERT_EQ(requests0.size(), 4);
+}
+
+/**
+ * @given a peer having a chain of five blocks, the first three of which are
+ * known
+ * @when the common ancestor with the peer is searched for above the genesis
+ * @then the third block is found with a request of a single header per step
+ */
+TEST_F(BabeSynchronizerTest, FindsCommonAncestor) {
+  std::vector<BlocksRequest> requests;
+  EXPECT_CALL(*clients_[0], requestBlocks(_, _))
+      .WillRepeatedly(Invoke([this, &requests](const BlocksRequest &request,
+                                               const ResponseCallback &cb) {
+        requests.push_back(request);
+        auto number = boost::get<BlockNumber>(request.from);
+        BlocksResponse response{request.id};
+        response.blocks.emplace_back(BlockData{hashes_[number - 1]});
+        response.blocks.back().header = chain_[number - 1].header;
+        cb(response);
+      }));
+  auto is_known = [this](const BlockHash &hash) {
+    return std::find(hashes_.begin(), hashes_.begin() + 3, hash)
+           != hashes_.begin() + 3;
+  };
+
+  boost::optional<BlockInfo> ancestor;
+  synchronizer_->findCommonAncestor(
+      {0, BlockHash{}}, 5, 0, is_known, [&](const BlockInfo &found) {
+        ancestor = found;
+      });
+  ASSERT_EQ(ancestor, BlockInfo(3, hashes_[2]));
+  ASSERT_EQ(requests.size(), 2);
+  for (const auto &request : requests) {
+    ASSERT_EQ(request.max, 1);
+    ASSERT_FALSE(request.attributeIsSet(BlockAttributesBits::BODY));
+  }
+}
+
+/**
+ * @given a request of five blocks in flight
+ * @when the blocks up to the same one, and up to one of the received headers
+ * are requested
+ * @then the requests are attached to the one in flight, and receive no blocks
+ * once it receives them, while the next request of the blocks is sent
+ */
+TEST_F(BabeSynchronizerTest, AttachesToRequestInFlight) {
+  std::vector<BlocksRequest> requests0;
+  std::vector<BlocksRequest> requests1;
+  serve(clients_[0], requests0);
+  serve(clients_[1], requests1);
+  auto header_requests = [&] {
+    return std::count_if(requests0.begin(),
+                         requests0.end(),
+                         [](const BlocksRequest &request) {
+                           return request.attributeIsSet(
+                               BlockAttributesBits::HEADER);
+                         });
+  };
+
+  std::vector<Block> received;
+  size_t attached_calls = 0;
+  auto attached = [&](const std::vector<Block> &blocks) {
+    ASSERT_TRUE(blocks.empty());
+    ++attached_calls;
+  };
+  synchronizer_->request(
+      hashes_.front(), hashes_.back(), 0, [&](const auto &blocks) {
+        received = blocks;
+      });
+  synchronizer_->request(hashes_[1], hashes_.back(), 0, attached);
+  ASSERT_EQ(header_requests(), 1);
+
+  // the headers are received
+  auto headers = std::move(responses_.front());
+  responses_.pop_front();
+  headers();
+  synchronizer_->request(hashes_.front(), hashes_[2], 0, attached);
+  ASSERT_EQ(header_requests(), 1);
+  deliver();
+  ASSERT_EQ(received, chain_);
+  ASSERT_EQ(attached_calls, 2);
+
+  synchronizer_->request(hashes_.front(), hashes_.back(), 0, attached);
+  ASSERT_EQ(header_requests(), 2);
+}
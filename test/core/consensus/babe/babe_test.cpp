@@ -24,9 +24,14 @@
 #include "mock/core/crypto/hasher_mock.hpp"
 #include "mock/core/runtime/babe_api_mock.hpp"
 #include "mock/core/runtime/core_mock.hpp"
+#include "mock/core/storage/changes_trie/changes_tracker_mock.hpp"
+#include "mock/core/storage/trie/trie_pruner_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
+#include "mock/core/transaction_pool/pool_revalidator_mock.hpp"
 #include "mock/core/transaction_pool/transaction_pool_mock.hpp"
 #include "primitives/block.hpp"
+#include "storage/deferred_write/deferred_write_storage.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/sr25519_utils.hpp"
 
@@ -105,7 +110,8 @@ class BabeTest : public testing::Test {
                                                           babe_block_validator_,
                                                           epoch_storage_,
                                                           tx_pool_,
-                                                          hasher_);
+                                                          hasher_,
+                                                          storage_);
 
     babe_ = std::make_shared<BabeImpl>(lottery_,
                                        block_executor,
@@ -118,7 +124,12 @@ class BabeTest : public testing::Test {
                                        keypair_,
                                        clock_,
                                        hasher_,
-                                       std::move(timer_mock_));
+                                       std::move(timer_mock_),
+                                       nullptr,
+                                       pool_revalidator_,
+                                       nullptr,
+                                       changes_tracker_,
+                                       state_pruner_);
 
     epoch_.randomness = expected_config->randomness;
     epoch_.epoch_duration = expected_config->epoch_length;
@@ -140,6 +151,15 @@ class BabeTest : public testing::Test {
   SR25519Keypair keypair_{generateSR25519Keypair()};
   std::shared_ptr<SystemClockMock> clock_;
   std::shared_ptr<HasherMock> hasher_;
+  std::shared_ptr<storage::changes_trie::ChangesTrackerMock> changes_tracker_ =
+      std::make_shared<storage::changes_trie::ChangesTrackerMock>();
+  /// the blocks are pre-built only with it
+  std::shared_ptr<transaction_pool::PoolRevalidatorMock> pool_revalidator_;
+  std::shared_ptr<storage::trie::TriePrunerMock> state_pruner_ =
+      std::make_shared<storage::trie::TriePrunerMock>();
+  std::shared_ptr<storage::DeferredWriteStorage> storage_ =
+      std::make_shared<storage::DeferredWriteStorage>(
+          std::make_shared<storage::InMemoryStorage>());
   std::unique_ptr<testutil::TimerMock> timer_mock_;
   testutil::TimerMock *timer_;
 
@@ -170,6 +190,7 @@ class BabeTest : public testing::Test {
   Block created_block_{block_header_, {extrinsic_}};
 
   Hash256 created_block_hash_{createHash(3)};
+  Hash256 extrinsic_hash_{createHash(4)};
 
   SystemClockImpl real_clock_{};
 };
@@ -181,6 +202,10 @@ ACTION_P(CheckBlockHeader, expected_block_header) {
   ASSERT_EQ(header_to_check, expected_block_header);
 }
 
+ACTION_P(CheckExtrinsicHashes, expected_hashes) {
+  ASSERT_EQ(arg0.extrinsic_hashes, expected_hashes);
+}
+
 /**
  * @given BABE production
  * @when running it in epoch with two slots @and out node is a leader in one of
@@ -226,13 +251,131 @@ TEST_F(BabeTest, Success) {
   // processSlotLeadership
   // we are not leader of the first slot, but leader of the second
   EXPECT_CALL(*block_tree_, deepestLeaf()).WillOnce(Return(best_leaf));
-  EXPECT_CALL(*proposer_, propose(BlockId{best_block_hash_}, _, _))
+  EXPECT_CALL(*proposer_, propose(BlockId{best_block_hash_}, _, _, _))
       .WillOnce(Return(created_block_));
-  EXPECT_CALL(*hasher_, blake2b_256(_)).WillOnce(Return(created_block_hash_));
+  EXPECT_CALL(*hasher_, blake2b_256(_))
+      .WillOnce(Return(created_block_hash_))
+      .WillOnce(Return(created_block_hash_))
+      .WillOnce(Return(extrinsic_hash_));
   EXPECT_CALL(*block_tree_, addBlock(_)).WillOnce(Return(outcome::success()));
+  // the changes tracked while the block was built are reported as its own
+  EXPECT_CALL(*changes_tracker_,
+              onBlockImported(created_block_hash_, block_header_.parent_hash));
 
   EXPECT_CALL(*gossiper_, blockAnnounce(_))
-      .WillOnce(CheckBlockHeader(created_block_.header));
+      .WillOnce(testing::DoAll(
+          CheckBlockHeader(created_block_.header),
+          CheckExtrinsicHashes(std::vector<Hash256>{extrinsic_hash_})));
+
+  babe_->runEpoch(epoch_, test_begin + slot_duration_);
+}
+
+/**
+ * BABE which pre-builds the blocks of the led slots at their start, as it has
+ * the pool revalidator
+ */
+class BabePrebuildTest : public BabeTest {
+ public:
+  void SetUp() override {
+    pool_revalidator_ =
+        std::make_shared<transaction_pool::PoolRevalidatorMock>();
+    BabeTest::SetUp();
+
+    prebuilt_block_.header.parent_hash = best_block_hash_;
+  }
+
+  /**
+   * Expects the epoch of the two slots, the second one of which is led, to
+   * run till the start of the third one
+   */
+  void expectSlots(BabeTimePoint test_begin) {
+    EXPECT_CALL(*lottery_, slotsLeadership(_, _, keypair_))
+        .WillRepeatedly(Return(leadership_));
+    EXPECT_CALL(*trie_db_, getRootHash())
+        .WillRepeatedly(Return(common::Buffer{}));
+    // the slots are run in time
+    EXPECT_CALL(*clock_, now()).WillRepeatedly(Return(test_begin));
+
+    EXPECT_CALL(*timer_, expiresAt(_)).Times(3);
+    EXPECT_CALL(*timer_, asyncWait(_))
+        .WillOnce(testing::InvokeArgument<0>(boost::system::error_code{}))
+        .WillOnce(testing::InvokeArgument<0>(boost::system::error_code{}))
+        .WillOnce({});
+  }
+
+  /// Expects \arg block to be sealed, imported and announced
+  void expectSealed(const Block &block) {
+    EXPECT_CALL(*hasher_, blake2b_256(_))
+        .WillOnce(Return(created_block_hash_))
+        .WillOnce(Return(created_block_hash_))
+        .WillOnce(Return(extrinsic_hash_));
+    EXPECT_CALL(*block_tree_, addBlock(_)).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*changes_tracker_,
+                onBlockImported(created_block_hash_, block.header.parent_hash));
+    EXPECT_CALL(*gossiper_, blockAnnounce(_))
+        .WillOnce(CheckBlockHeader(block.header));
+  }
+
+  /// built at the start of the led slot on top of the best block
+  Block prebuilt_block_{created_block_};
+};
+
+/**
+ * @given BABE with the pool revalidator, leading the second slot of the epoch
+ * @when the best block is the same at the end of the slot as at its start
+ * @then the block pre-built at the start of the slot is sealed as it is,
+ * without being built again, and nothing is resubmitted to the pool
+ */
+TEST_F(BabePrebuildTest, SealsPrebuiltBlock) {
+  auto test_begin = real_clock_.now();
+  expectSlots(test_begin);
+
+  EXPECT_CALL(*block_tree_, deepestLeaf()).WillRepeatedly(Return(best_leaf));
+  EXPECT_CALL(*proposer_, propose(BlockId{best_block_hash_}, _, _, _))
+      .WillOnce(Return(prebuilt_block_));
+  EXPECT_CALL(*pool_revalidator_, resubmit(_)).Times(0);
+  EXPECT_CALL(*state_pruner_, pruneState(_)).Times(0);
+  expectSealed(prebuilt_block_);
+  EXPECT_CALL(*pool_revalidator_, onNewBestBlock(best_leaf));
+
+  babe_->runEpoch(epoch_, test_begin + slot_duration_);
+}
+
+/**
+ * @given BABE with the pool revalidator, leading the second slot of the epoch
+ * @when the best block changes after the block is pre-built at the start of
+ * the slot
+ * @then the pre-built block is discarded, its extrinsics are resubmitted to
+ * the pool, its state is pruned, and the block is built again on top of the
+ * new best block
+ */
+TEST_F(BabePrebuildTest, RebuildsOnNewBestBlock) {
+  auto test_begin = real_clock_.now();
+  expectSlots(test_begin);
+
+  primitives::BlockInfo new_best{best_block_number_ + 1, createHash(7)};
+  Block rebuilt_block = created_block_;
+  rebuilt_block.header.parent_hash = new_best.block_hash;
+  rebuilt_block.header.number = new_best.block_number + 1;
+
+  EXPECT_CALL(*block_tree_, deepestLeaf())
+      .WillOnce(Return(best_leaf))
+      .WillRepeatedly(Return(new_best));
+  testing::Sequence rebuild;
+  EXPECT_CALL(*proposer_, propose(BlockId{best_block_hash_}, _, _, _))
+      .InSequence(rebuild)
+      .WillOnce(Return(prebuilt_block_));
+  EXPECT_CALL(*pool_revalidator_, resubmit(prebuilt_block_.body))
+      .InSequence(rebuild);
+  EXPECT_CALL(*state_pruner_,
+              pruneState(common::Buffer{prebuilt_block_.header.state_root}))
+      .InSequence(rebuild)
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*proposer_, propose(BlockId{new_best.block_hash}, _, _, _))
+      .InSequence(rebuild)
+      .WillOnce(Return(rebuilt_block));
+  expectSealed(rebuilt_block);
+  EXPECT_CALL(*pool_revalidator_, onNewBestBlock(new_best));
 
   babe_->runEpoch(epoch_, test_begin + slot_duration_);
 }
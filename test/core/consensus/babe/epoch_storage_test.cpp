@@ -0,0 +1,130 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/epoch_storage_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "consensus/babe/impl/threshold_util.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+
+using namespace kagome;
+using namespace consensus;
+
+using testing::_;
+using testing::Return;
+
+class EpochStorageTest : public testing::Test {
+ public:
+  void SetUp() override {
+    configuration_->leadership_rate = {5, 17};
+    descriptor_.authorities.push_back(primitives::Authority{.weight = 1});
+    descriptor_.authorities.push_back(primitives::Authority{.weight = 3});
+    descriptor_.randomness.fill(1);
+    other_descriptor_ = descriptor_;
+    other_descriptor_.randomness.fill(2);
+
+    fork_a_.fill(0xa);
+    fork_b_.fill(0xb);
+    block_.fill(0xc);
+    ON_CALL(*block_tree_, hasDirectChain(_, _)).WillByDefault(Return(false));
+  }
+
+  std::shared_ptr<primitives::BabeConfiguration> configuration_ =
+      std::make_shared<primitives::BabeConfiguration>();
+  std::shared_ptr<blockchain::BlockTreeMock> block_tree_ =
+      std::make_shared<testing::NiceMock<blockchain::BlockTreeMock>>();
+  EpochStorageImpl epoch_storage_{std::make_shared<storage::InMemoryStorage>(),
+                                  configuration_,
+                                  block_tree_};
+  NextEpochDescriptor descriptor_;
+  NextEpochDescriptor other_descriptor_;
+  primitives::BlockHash fork_a_;
+  primitives::BlockHash fork_b_;
+  primitives::BlockHash block_;
+};
+
+/**
+ * @given epoch storage with an epoch descriptor added without the announcing
+ * block
+ * @when getting the info of the epoch twice
+ * @then the same info is returned, which has the thresholds of the
+ * authorities of the epoch
+ */
+TEST_F(EpochStorageTest, EpochInfoCached) {
+  ASSERT_TRUE(epoch_storage_.addEpochDescriptor(2, descriptor_));
+
+  auto info = epoch_storage_.getEpochInfo(2, block_).value();
+  EXPECT_EQ(info->descriptor, descriptor_);
+  EXPECT_EQ(info->thresholds,
+            calculateThresholds(configuration_->leadership_rate,
+                                descriptor_.authorities));
+  EXPECT_EQ(info->thresholds[1],
+            calculateThreshold(
+                configuration_->leadership_rate, descriptor_.authorities, 1));
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).value(), info);
+}
+
+/**
+ * @given epoch storage with the info of an epoch read
+ * @when a new descriptor is added for the epoch
+ * @then the info of the new descriptor is returned
+ */
+TEST_F(EpochStorageTest, EpochInfoInvalidated) {
+  ASSERT_TRUE(epoch_storage_.addEpochDescriptor(2, descriptor_));
+  ASSERT_TRUE(epoch_storage_.getEpochInfo(2, block_));
+
+  ASSERT_TRUE(epoch_storage_.addEpochDescriptor(2, other_descriptor_));
+
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).value()->descriptor,
+            other_descriptor_);
+}
+
+/**
+ * @given epoch storage with the descriptors of an epoch announced on two
+ * forks
+ * @when getting the info of the epoch for a block of each of the forks
+ * @then the descriptor announced on the fork of the block is returned
+ */
+TEST_F(EpochStorageTest, EpochOfFork) {
+  ASSERT_TRUE(epoch_storage_.addEpochDescriptor(2, fork_a_, descriptor_));
+  ASSERT_TRUE(
+      epoch_storage_.addEpochDescriptor(2, fork_b_, other_descriptor_));
+
+  EXPECT_CALL(*block_tree_, hasDirectChain(fork_a_, block_))
+      .WillRepeatedly(Return(true));
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).value()->descriptor,
+            descriptor_);
+
+  EXPECT_CALL(*block_tree_, hasDirectChain(fork_a_, block_))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*block_tree_, hasDirectChain(fork_b_, block_))
+      .WillRepeatedly(Return(true));
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).value()->descriptor,
+            other_descriptor_);
+}
+
+/**
+ * @given epoch storage with the descriptor of an epoch announced on a fork
+ * @when getting the info of the epoch for a block of another fork
+ * @then an error is returned instead of the descriptor of the other fork
+ */
+TEST_F(EpochStorageTest, EpochNotOnChain) {
+  ASSERT_TRUE(epoch_storage_.addEpochDescriptor(2, fork_a_, descriptor_));
+
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).error(),
+            EpochStorageError::EPOCH_NOT_ON_CHAIN);
+}
+
+/**
+ * @given empty epoch storage
+ * @when getting the info of an epoch
+ * @then an error is returned
+ */
+TEST_F(EpochStorageTest, UnknownEpoch) {
+  EXPECT_EQ(epoch_storage_.getEpochInfo(2, block_).error(),
+            EpochStorageError::EPOCH_DOES_NOT_EXIST);
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/orphan_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::consensus::OrphanPool;
+using kagome::primitives::BlockBody;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+
+class OrphanPoolTest : public testing::Test {
+ public:
+  static OrphanPool::Orphan orphan(const BlockHash &hash,
+                                   const BlockHash &parent_hash,
+                                   boost::optional<BlockBody> body = {}) {
+    BlockHeader header;
+    header.parent_hash = parent_hash;
+    return {hash, header, std::move(body)};
+  }
+
+  OrphanPool pool{4};
+};
+
+/**
+ * @given orphans on a chain above a missing block
+ * @when the missing ancestor of the last one is looked up
+ * @then it is the parent of the first one, which is requested once
+ */
+TEST_F(OrphanPoolTest, FindsMissingAncestor) {
+  ASSERT_TRUE(pool.add(orphan("b2"_hash256, "b1"_hash256)));
+  ASSERT_TRUE(pool.add(orphan("b3"_hash256, "b2"_hash256)));
+  ASSERT_FALSE(pool.add(orphan("b3"_hash256, "b2"_hash256)));
+  ASSERT_EQ(pool.missingAncestor("b3"_hash256), "b1"_hash256);
+  ASSERT_TRUE(pool.shouldRequest("b1"_hash256));
+  ASSERT_FALSE(pool.shouldRequest("b1"_hash256));
+}
+
+/**
+ * @given orphans on two branches above a block
+ * @when the children of the block and a branch are taken
+ * @then the branch ends before the orphan with a body, which is left to be
+ * taken as a child
+ */
+TEST_F(OrphanPoolTest, TakesChildrenAndBranch) {
+  ASSERT_TRUE(pool.add(orphan("b2"_hash256, "b1"_hash256)));
+  ASSERT_TRUE(pool.add(orphan("c2"_hash256, "b1"_hash256)));
+  ASSERT_TRUE(pool.add(orphan("b3"_hash256, "b2"_hash256)));
+  ASSERT_TRUE(pool.add(orphan("b4"_hash256, "b3"_hash256, BlockBody{})));
+
+  auto children = pool.takeChildren("b1"_hash256);
+  ASSERT_EQ(children.size(), 2);
+  ASSERT_FALSE(pool.contains("b2"_hash256));
+  ASSERT_FALSE(pool.contains("c2"_hash256));
+
+  auto last = pool.takeBranch("b2"_hash256);
+  ASSERT_TRUE(last);
+  ASSERT_EQ(last->hash, "b3"_hash256);
+  ASSERT_FALSE(pool.takeBranch("c2"_hash256));
+
+  ASSERT_TRUE(pool.hasChildren("b3"_hash256));
+  auto with_body = pool.takeChildren("b3"_hash256);
+  ASSERT_EQ(with_body.size(), 1);
+  ASSERT_TRUE(with_body[0].body);
+  ASSERT_EQ(pool.size(), 0);
+}
+
+/**
+ * @given a full pool
+ * @when one more orphan is added
+ * @then the others are forgotten
+ */
+TEST_F(OrphanPoolTest, ForgetsOverLimit) {
+  for (auto hash : {"b1"_hash256, "b2"_hash256, "b3"_hash256, "b4"_hash256}) {
+    ASSERT_TRUE(pool.add(orphan(hash, "b0"_hash256)));
+  }
+  ASSERT_TRUE(pool.add(orphan("b5"_hash256, "b0"_hash256)));
+  ASSERT_EQ(pool.size(), 1);
+  ASSERT_TRUE(pool.contains("b5"_hash256));
+}
@@ -0,0 +1,334 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/babe/impl/warp_sync.hpp"
+
+#include <gtest/gtest.h>
+
+#include "consensus/grandpa/completed_round.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/blockchain/block_storage_mock.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/crypto/ed25519_provider_mock.hpp"
+#include "mock/core/network/sync_protocol_client_mock.hpp"
+#include "scale/scale.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/predefined_keys.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace kagome;
+using namespace consensus;
+using namespace network;
+using namespace primitives;
+
+using blockchain::BlockStorageMock;
+using blockchain::BlockTreeMock;
+using common::Buffer;
+using crypto::ED25519ProviderMock;
+using storage::InMemoryStorage;
+using storage::trie::PolkadotCodec;
+using storage::trie::PolkadotTrieFactoryImpl;
+using storage::trie::TrieNodeCache;
+using storage::trie::TrieSerializerImpl;
+using storage::trie::TrieStorageBackendImpl;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+using BlocksCallback = std::function<void(outcome::result<BlocksResponse>)>;
+using StateCallback = std::function<void(outcome::result<StateResponse>)>;
+
+class WarpSyncTest : public testing::Test {
+ public:
+  void SetUp() override {
+    for (auto &client : clients_) {
+      client = std::make_shared<SyncProtocolClientMock>();
+      sync_clients_->clients.push_back(client);
+    }
+
+    grandpa::VoterSet voters{0};
+    for (const auto &voter : voters_) {
+      voters.insert(voter, 1);
+    }
+    ASSERT_TRUE(storage_->put(storage::kAuthoritySetKey,
+                              Buffer{scale::encode(voters).value()}));
+    ON_CALL(*ed_provider_, verify(_, _, _)).WillByDefault(Return(true));
+
+    state_root_ = storeState();
+    BlockHeader genesis;
+    genesis_hash_ = hasher_->blake2b_256(scale::encode(genesis).value());
+    EXPECT_CALL(*block_storage_, getLastFinalizedBlockHash())
+        .WillRepeatedly(Return(genesis_hash_));
+    EXPECT_CALL(*block_storage_, getBlockHeader(BlockId{genesis_hash_}))
+        .WillRepeatedly(Return(genesis));
+    EXPECT_CALL(*block_storage_, putBlockHeader(_))
+        .WillRepeatedly(Return(BlockHash{}));
+
+    // a chain of blocks after the genesis, all of them with the same state
+    BlockHash parent = genesis_hash_;
+    for (BlockNumber number = 1; number <= 4; ++number) {
+      BlockHeader header;
+      header.parent_hash = parent;
+      header.number = number;
+      header.state_root = state_root_;
+      parent = hasher_->blake2b_256(scale::encode(header).value());
+      headers_.push_back(header);
+      hashes_.push_back(parent);
+    }
+
+    warp_sync_ = std::make_shared<WarpSync>(block_tree_,
+                                            block_storage_,
+                                            storage_,
+                                            nodes_,
+                                            codec_,
+                                            hasher_,
+                                            ed_provider_,
+                                            sync_clients_);
+  }
+
+  /**
+   * @return root of a state with the nodes long enough not to be inlined
+   * into their parents, along with a few inlined ones, stored to the nodes
+   * of the peers
+   */
+  common::Hash256 storeState() {
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory_, codec_, peer_nodes_, std::make_shared<TrieNodeCache>(0));
+    auto trie = serializer->retrieveTrie(serializer->getEmptyRootHash())
+                    .value();
+    for (size_t i = 0; i < 100; i++) {
+      auto key = Buffer{}.putUint32(i * 0x01010101);
+      EXPECT_OUTCOME_TRUE_1(trie->put(key, valueOf(key)));
+      EXPECT_OUTCOME_TRUE_1(trie->put(Buffer{key}.putUint8(0), "short"_buf));
+    }
+    auto root = serializer->storeTrie(*trie).value();
+    return common::Hash256::fromSpan(root).value();
+  }
+
+  static Buffer valueOf(const Buffer &key) {
+    return Buffer{key}.put(std::vector<uint8_t>(40, 0xab));
+  }
+
+  /**
+   * @return justification of the block with \arg index, with the precommits
+   * of \arg voters, stored with its round unless \arg legacy is set
+   */
+  Justification justify(size_t index,
+                        size_t voters,
+                        bool legacy = false) const {
+    grandpa::GrandpaJustification justification{kRound, {}};
+    for (size_t i = 0; i < voters; i++) {
+      grandpa::SignedMessage precommit;
+      precommit.message =
+          grandpa::Precommit{headers_[index].number, hashes_[index]};
+      precommit.id = voters_[i];
+      justification.items.push_back(precommit);
+    }
+    if (legacy) {
+      return Justification{Buffer{scale::encode(justification).value()}};
+    }
+    return Justification{Buffer{
+        scale::encode(grandpa::StoredJustification{justification, true})
+            .value()}};
+  }
+
+  /**
+   * Makes \arg client answer the requests for the headers of the chain with
+   * \arg justifications of the blocks by their indices
+   */
+  void serveHeaders(const std::shared_ptr<SyncProtocolClientMock> &client,
+                    std::map<size_t, Justification> justifications) {
+    EXPECT_CALL(*client, requestBlocks(_, _))
+        .WillRepeatedly(Invoke([this, justifications](
+                                   const BlocksRequest &request,
+                                   const BlocksCallback &cb) {
+          EXPECT_TRUE(
+              request.attributeIsSet(BlockAttributesBits::JUSTIFICATION));
+          const auto &from = boost::get<BlockHash>(request.from);
+          BlocksResponse response{request.id};
+          response.blocks.push_back(BlockData{from});
+          auto it = std::find(hashes_.begin(), hashes_.end(), from);
+          size_t next = it == hashes_.end() ? 0 : it - hashes_.begin() + 1;
+          // two blocks at most in a response
+          for (size_t i = next; i < hashes_.size() and i < next + 2; i++) {
+            auto &block_data =
+                response.blocks.emplace_back(BlockData{hashes_[i]});
+            block_data.header = headers_[i];
+            if (auto j = justifications.find(i); j != justifications.end()) {
+              block_data.justification = j->second;
+            }
+          }
+          cb(response);
+        }));
+  }
+
+  /**
+   * Makes \arg client answer the requests for the state nodes from the nodes
+   * of the peers, corrupting them if \arg corrupt
+   */
+  void serveState(const std::shared_ptr<SyncProtocolClientMock> &client,
+                  bool corrupt = false) {
+    EXPECT_CALL(*client, requestState(_, _))
+        .WillRepeatedly(Invoke(
+            [this, corrupt](const StateRequest &request,
+                            const StateCallback &cb) {
+              EXPECT_LE(request.keys.size(), WarpSync::kNodesPerRequest);
+              StateResponse response;
+              for (const auto &key : request.keys) {
+                auto node = peer_nodes_->get(key).value();
+                if (corrupt) {
+                  node.putUint8(0);
+                }
+                response.nodes.push_back(std::move(node));
+              }
+              cb(response);
+            }));
+  }
+
+  /**
+   * Checks that the values of the state are in the nodes synced to
+   */
+  void checkState() {
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory_, codec_, nodes_, std::make_shared<TrieNodeCache>(0));
+    EXPECT_OUTCOME_TRUE(trie, serializer->retrieveTrie(Buffer{state_root_}));
+    for (size_t i = 0; i < 100; i++) {
+      auto key = Buffer{}.putUint32(i * 0x01010101);
+      EXPECT_OUTCOME_TRUE(value, trie->get(key));
+      EXPECT_EQ(value, valueOf(key));
+      EXPECT_OUTCOME_TRUE(short_value, trie->get(Buffer{key}.putUint8(0)));
+      EXPECT_EQ(short_value, "short"_buf);
+    }
+  }
+
+  /**
+   * @return result of a warp sync to the last block of the chain
+   */
+  outcome::result<BlockInfo> sync() {
+    boost::optional<outcome::result<BlockInfo>> result;
+    warp_sync_->sync(hashes_.back(), [&result](auto &&res) { result = res; });
+    EXPECT_TRUE(result);
+    return result.value();
+  }
+
+  static constexpr grandpa::RoundNumber kRound = 5;
+
+  std::shared_ptr<crypto::Hasher> hasher_ =
+      std::make_shared<crypto::HasherImpl>();
+  std::shared_ptr<PolkadotCodec> codec_ = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory_ =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<TrieStorageBackendImpl> peer_nodes_ =
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), Buffer{});
+  std::shared_ptr<TrieStorageBackendImpl> nodes_ =
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), Buffer{});
+  std::shared_ptr<InMemoryStorage> storage_ =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<BlockTreeMock> block_tree_ =
+      std::make_shared<BlockTreeMock>();
+  std::shared_ptr<BlockStorageMock> block_storage_ =
+      std::make_shared<BlockStorageMock>();
+  std::shared_ptr<ED25519ProviderMock> ed_provider_ =
+      std::make_shared<testing::NiceMock<ED25519ProviderMock>>();
+  std::shared_ptr<SyncClientsSet> sync_clients_ =
+      std::make_shared<SyncClientsSet>();
+  std::array<std::shared_ptr<SyncProtocolClientMock>, 2> clients_;
+  std::vector<grandpa::Id> voters_{
+      {"01"_hash256}, {"02"_hash256}, {"03"_hash256}};
+
+  common::Hash256 state_root_;
+  BlockHash genesis_hash_;
+  std::vector<BlockHeader> headers_;
+  std::vector<BlockHash> hashes_;
+  std::shared_ptr<WarpSync> warp_sync_;
+};
+
+/**
+ * @given chain with justifications of the second and the third blocks, the
+ * former not having enough precommits
+ * @when the node warp syncs to the head of the chain
+ * @then the third block becomes the last finalized one with its state
+ * downloaded, and GRANDPA goes on from the round of its justification
+ */
+TEST_F(WarpSyncTest, SyncsToLatestJustifiedBlock) {
+  serveHeaders(clients_[0], {{1, justify(1, 3)}, {2, justify(2, 1)}});
+  serveState(clients_[0]);
+  EXPECT_CALL(*block_storage_, putJustification(_, hashes_[1], 2))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_storage_, setLastFinalizedBlockHash(hashes_[1]))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_tree_, resetToLastFinalized())
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_OUTCOME_TRUE(synced, sync());
+  EXPECT_EQ(synced, (BlockInfo{2, hashes_[1]}));
+  checkState();
+
+  EXPECT_OUTCOME_TRUE(round_encoded, storage_->get(storage::kSetStateKey));
+  EXPECT_OUTCOME_TRUE(round,
+                      scale::decode<grandpa::CompletedRound>(round_encoded));
+  EXPECT_EQ(round.round_number, kRound);
+  ASSERT_TRUE(round.state.finalized);
+  EXPECT_EQ(round.state.finalized.value(), synced);
+}
+
+/**
+ * @given peer sending corrupted state nodes and a peer sending valid ones
+ * @when the node warp syncs
+ * @then the corrupted nodes are not stored, and the state is downloaded from
+ * the other peer
+ */
+TEST_F(WarpSyncTest, SwitchesPeerOnInvalidNode) {
+  serveHeaders(clients_[0], {{3, justify(3, 3)}});
+  serveState(clients_[0], true);
+  serveState(clients_[1]);
+  EXPECT_CALL(*block_storage_, putJustification(_, hashes_[3], 4))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_storage_, setLastFinalizedBlockHash(hashes_[3]))
+      .WillOnce(Return(outcome::success()));
+  EXPECT_CALL(*block_tree_, resetToLastFinalized())
+      .WillOnce(Return(outcome::success()));
+
+  EXPECT_OUTCOME_TRUE(synced, sync());
+  EXPECT_EQ(synced, (BlockInfo{4, hashes_[3]}));
+  checkState();
+}
+
+/**
+ * @given chain without a justification with enough precommits
+ * @when the node warp syncs
+ * @then the sync fails, and the finality is not moved
+ */
+TEST_F(WarpSyncTest, FailsWithoutJustifiedBlock) {
+  serveHeaders(clients_[0], {{2, justify(2, 2)}});
+  EXPECT_CALL(*block_storage_, setLastFinalizedBlockHash(_)).Times(0);
+  EXPECT_CALL(*block_tree_, resetToLastFinalized()).Times(0);
+
+  EXPECT_OUTCOME_FALSE(error, sync());
+  EXPECT_EQ(error, WarpSyncError::NO_JUSTIFIED_BLOCK);
+}
+
+/**
+ * @given chain with a justification with enough precommits, stored by an
+ * older node without its round
+ * @when the node warp syncs
+ * @then the justification is skipped, so the sync fails
+ */
+TEST_F(WarpSyncTest, SkipsJustificationWithoutRound) {
+  serveHeaders(clients_[0], {{2, justify(2, 3, true)}});
+  EXPECT_CALL(*block_storage_, setLastFinalizedBlockHash(_)).Times(0);
+  EXPECT_CALL(*block_tree_, resetToLastFinalized()).Times(0);
+
+  EXPECT_OUTCOME_FALSE(error, sync());
+  EXPECT_EQ(error, WarpSyncError::NO_JUSTIFIED_BLOCK);
+}
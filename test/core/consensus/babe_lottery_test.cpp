@@ -30,7 +30,9 @@ struct BabeLotteryTest : public testing::Test {
       std::make_shared<VRFProviderMock>();
   std::shared_ptr<HasherMock> hasher_ = std::make_shared<HasherMock>();
 
-  BabeLotteryImpl lottery_{vrf_provider_, hasher_};
+  // the slots are computed by the workers
+  BabeLotteryImpl lottery_{
+      vrf_provider_, hasher_, std::make_shared<WorkerPool>(2)};
 
   std::vector<VRFPreOutput> submitted_vrf_values_{uint256_t_to_bytes(28482),
                                                   uint256_t_to_bytes(57302840),
@@ -97,6 +99,38 @@ TEST_F(BabeLotteryTest, SlotsLeadership) {
   ASSERT_FALSE(leadership[2]);
 }
 
+/**
+ * @given BabeLottery
+ * @when computing leadership for a window of the slots of the epoch
+ * @then only the slots of the window are evaluated, in order
+ */
+TEST_F(BabeLotteryTest, SlotsLeadershipWindow) {
+  // GIVEN
+  Buffer vrf_input(vrf_constants::OUTPUT_SIZE + 8, 0);
+  std::copy(current_epoch_.randomness.begin(),
+            current_epoch_.randomness.end(),
+            vrf_input.begin());
+  for (size_t i = 1; i < 3; ++i) {
+    auto slot_bytes = uint64_t_to_bytes(i);
+    std::copy(slot_bytes.begin(),
+              slot_bytes.end(),
+              vrf_input.begin() + vrf_constants::OUTPUT_SIZE);
+    EXPECT_CALL(*vrf_provider_, sign(vrf_input, keypair_, threshold_))
+        .WillOnce(Return(VRFOutput{uint256_t_to_bytes(i), {}}));
+  }
+
+  // WHEN
+  auto leadership =
+      lottery_.slotsLeadership(current_epoch_, threshold_, keypair_, 1, 2);
+
+  // THEN
+  ASSERT_EQ(leadership.size(), 2);
+  ASSERT_TRUE(leadership[0]);
+  EXPECT_EQ(leadership[0]->output, uint256_t_to_bytes(1));
+  ASSERT_TRUE(leadership[1]);
+  EXPECT_EQ(leadership[1]->output, uint256_t_to_bytes(2));
+}
+
 /**
  * @given BabeLottery with a number of VRF values submitted
  * @when computing randomness for the next epoch
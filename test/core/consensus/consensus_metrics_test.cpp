@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/consensus_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace kagome;
+using namespace consensus;
+using namespace std::chrono_literals;
+
+class ConsensusMetricsTest : public testing::Test {
+ public:
+  ConsensusMetrics metrics_;
+};
+
+/**
+ * @given consensus metrics
+ * @when the slots, their timers, the proposals and the announces are recorded
+ * @then they are reported along with the skipped slots, and forgotten after
+ * the reset
+ */
+TEST_F(ConsensusMetricsTest, Slots) {
+  metrics_.recordSkippedSlot();
+  metrics_.recordSlot(2ms);
+  metrics_.recordSlot(5ms);
+  metrics_.recordSlotTimer(1ms);
+  metrics_.recordProposal(100ms);
+  metrics_.recordAnnounce(10ms);
+
+  auto report = metrics_.report();
+  EXPECT_EQ(report.slots.slots, 2);
+  EXPECT_EQ(report.slots.skipped, 1);
+  EXPECT_EQ(report.slots.drift.calls, 2);
+  EXPECT_EQ(report.slots.drift.max, 5ms);
+  EXPECT_EQ(report.slots.timer.total, 1ms);
+  EXPECT_EQ(report.slots.proposal.total, 100ms);
+  EXPECT_EQ(report.slots.announce.total, 10ms);
+
+  metrics_.reset();
+  report = metrics_.report();
+  EXPECT_EQ(report.slots.slots, 0);
+  EXPECT_EQ(report.slots.drift.calls, 0);
+}
+
+/**
+ * @given consensus metrics
+ * @when the rounds, their stages and the votes are recorded
+ * @then the completed and the failed rounds are reported apart, along with
+ * the votes and the equivocations
+ */
+TEST_F(ConsensusMetricsTest, Rounds) {
+  metrics_.recordPrevote();
+  metrics_.recordPrevote();
+  metrics_.recordPrecommit();
+  metrics_.recordEquivocation();
+  metrics_.recordPrevoted(1s);
+  metrics_.recordPrecommitted(2s);
+  metrics_.recordRoundFinalized(500ms);
+  metrics_.recordRound(4s, true);
+  metrics_.recordRound(20s, false);
+
+  auto report = metrics_.report();
+  EXPECT_EQ(report.rounds.completed, 1);
+  EXPECT_EQ(report.rounds.failed, 1);
+  EXPECT_EQ(report.rounds.prevotes, 2);
+  EXPECT_EQ(report.rounds.precommits, 1);
+  EXPECT_EQ(report.rounds.equivocations, 1);
+  EXPECT_EQ(report.rounds.duration.calls, 2);
+  EXPECT_EQ(report.rounds.duration.max, 20s);
+  EXPECT_EQ(report.rounds.prevote.total, 1s);
+  EXPECT_EQ(report.rounds.precommit.total, 2s);
+  EXPECT_EQ(report.rounds.finalize.total, 500ms);
+}
+
+/**
+ * @given blocks imported at different times
+ * @when the blocks up to some number are finalized
+ * @then the lag of each of them is recorded once, the first import of a
+ * number is taken, and the blocks over the number keep waiting
+ */
+TEST_F(ConsensusMetricsTest, FinalityLag) {
+  ConsensusMetrics::Clock::time_point start{};
+  metrics_.recordImported(1, start);
+  metrics_.recordImported(2, start + 1s);
+  metrics_.recordImported(2, start + 2s);
+  metrics_.recordImported(3, start + 3s);
+
+  metrics_.recordFinalized(2, start + 5s);
+  auto report = metrics_.report();
+  EXPECT_EQ(report.imported_blocks, 4);
+  EXPECT_EQ(report.finality_lag.calls, 2);
+  EXPECT_EQ(report.finality_lag.max, 5s);
+  EXPECT_EQ(report.finality_lag.total, 9s);
+
+  metrics_.recordFinalized(2, start + 6s);
+  EXPECT_EQ(metrics_.report().finality_lag.calls, 2);
+
+  metrics_.recordFinalized(3, start + 6s);
+  report = metrics_.report();
+  EXPECT_EQ(report.finality_lag.calls, 3);
+  EXPECT_EQ(report.finality_lag.total, 12s);
+}
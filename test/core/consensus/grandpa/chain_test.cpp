@@ -131,17 +131,17 @@ TEST_F(ChainTest, BestChainContaining) {
  * @given chain api, referring to a block tree with three blocks
  * @when deterimining if a particular block is equal or descendant of another
  * block
- * @then it is true if block hashes are equal or the first one is actually the
- * ancestor of the other, and false otherwise
+ * @then the block tree is asked, without making the chain between the blocks
  */
 TEST_F(ChainTest, IsEqualOrDescendantOf) {
   auto h1 = "010101"_hash256;
   auto h2 = "020202"_hash256;
   auto h3 = "030303"_hash256;
-  EXPECT_CALL(*tree, getChainByBlocks(h3, h2))
-      .WillOnce(Return(outcome::failure(boost::system::error_code())));
-  EXPECT_CALL(*tree, getChainByBlocks(h1, h3))
-      .WillOnce(Return(std::vector<BlockHash>{h1, h2, h3}));
+  EXPECT_CALL(*tree, hasDirectChain("01"_hash256, "01"_hash256))
+      .WillOnce(Return(true));
+  EXPECT_CALL(*tree, hasDirectChain(h3, h2)).WillOnce(Return(false));
+  EXPECT_CALL(*tree, hasDirectChain(h1, h3)).WillOnce(Return(true));
+  EXPECT_CALL(*tree, getChainByBlocks(_, _)).Times(0);
 
   ASSERT_TRUE(chain->isEqualOrDescendOf("01"_hash256, "01"_hash256));
   ASSERT_FALSE(chain->isEqualOrDescendOf(h3, h2));
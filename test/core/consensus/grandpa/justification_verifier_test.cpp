@@ -0,0 +1,198 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/justification_verifier.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/crypto/ed25519_provider_mock.hpp"
+#include "scale/scale.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace kagome::consensus::grandpa;
+using kagome::crypto::ED25519ProviderMock;
+using testing::_;
+using testing::Return;
+
+class JustificationVerifierTest : public testing::Test {
+ public:
+  void SetUp() override {
+    voters_ = std::make_shared<VoterSet>(kSetId);
+    for (const auto &id : ids_) {
+      voters_->insert(id, 1);
+    }
+    ed_provider_ = std::make_shared<testing::NiceMock<ED25519ProviderMock>>();
+    ON_CALL(*ed_provider_, verify(_, _, _)).WillByDefault(Return(true));
+    verifier_ = std::make_shared<JustificationVerifier>(voters_, ed_provider_);
+  }
+
+  SignedMessage precommit(const Id &id, const BlockInfo &target) const {
+    SignedMessage message;
+    message.message = Precommit{target.block_number, target.block_hash};
+    message.id = id;
+    return message;
+  }
+
+  // no block is known to be a descendant of the justified one
+  static bool noDescendants(const BlockInfo &) {
+    return false;
+  }
+
+  static constexpr MembershipCounter kSetId = 3;
+
+  std::vector<Id> ids_{{"01"_hash256}, {"02"_hash256}, {"03"_hash256}};
+  BlockInfo block_{10, "0a"_hash256};
+  BlockInfo descendant_{11, "0b"_hash256};
+
+  std::shared_ptr<VoterSet> voters_;
+  std::shared_ptr<ED25519ProviderMock> ed_provider_;
+  std::shared_ptr<JustificationVerifier> verifier_;
+};
+
+/**
+ * @given justification with the precommits of all voters for the block or
+ * its descendant
+ * @when it is verified
+ * @then it justifies the block
+ */
+TEST_F(JustificationVerifierTest, Supermajority) {
+  GrandpaJustification justification{
+      5,
+      {precommit(ids_[0], block_),
+       precommit(ids_[1], block_),
+       precommit(ids_[2], descendant_)}};
+  EXPECT_CALL(*ed_provider_, verify(_, _, _)).Times(3);
+
+  EXPECT_OUTCOME_TRUE_1(
+      verifier_->verify(justification, block_, [this](const BlockInfo &b) {
+        return b == descendant_;
+      }));
+}
+
+/**
+ * @given justification with the precommits for the block of two voters, one
+ * of which equivocated, out of three
+ * @when it is verified
+ * @then it does not justify the block, as the equivocator is counted once
+ */
+TEST_F(JustificationVerifierTest, NotEnoughWeight) {
+  GrandpaJustification justification{
+      5,
+      {precommit(ids_[0], block_),
+       precommit(ids_[0], block_),
+       precommit(ids_[1], descendant_)}};
+
+  EXPECT_OUTCOME_FALSE(
+      error, verifier_->verify(justification, block_, noDescendants));
+  EXPECT_EQ(error, JustificationError::NOT_ENOUGH_WEIGHT);
+}
+
+/**
+ * @given justification with a precommit with an invalid signature
+ * @when it is verified
+ * @then it is rejected, even though the other precommits are enough
+ */
+TEST_F(JustificationVerifierTest, InvalidSignature) {
+  GrandpaJustification justification{5,
+                                     {precommit(ids_[0], block_),
+                                      precommit(ids_[1], block_),
+                                      precommit(ids_[2], block_)}};
+  EXPECT_CALL(*ed_provider_, verify(_, _, _)).WillRepeatedly(Return(true));
+  EXPECT_CALL(*ed_provider_, verify(_, _, ids_[1])).WillOnce(Return(false));
+
+  EXPECT_OUTCOME_FALSE(
+      error, verifier_->verify(justification, block_, noDescendants));
+  EXPECT_EQ(error, JustificationError::INVALID_SIGNATURE);
+}
+
+/**
+ * @given justification with a precommit of a voter out of the voter set
+ * @when it is verified
+ * @then it is rejected
+ */
+TEST_F(JustificationVerifierTest, UnknownVoter) {
+  GrandpaJustification justification{5,
+                                     {precommit(ids_[0], block_),
+                                      precommit(ids_[1], block_),
+                                      precommit("04"_hash256, block_)}};
+
+  EXPECT_OUTCOME_FALSE(
+      error, verifier_->verify(justification, block_, noDescendants));
+  EXPECT_EQ(error, JustificationError::UNKNOWN_VOTER);
+}
+
+/**
+ * @given justification of a round
+ * @when it is verified
+ * @then the signatures are checked for the payloads of the round
+ */
+TEST_F(JustificationVerifierTest, SignedInRound) {
+  GrandpaJustification justification{7, {precommit(ids_[0], block_)}};
+  auto payload = kagome::scale::encode(
+                     justification.items[0].message, RoundNumber{7}, kSetId)
+                     .value();
+  EXPECT_CALL(*ed_provider_,
+              verify(_,
+                     testing::Truly([&](gsl::span<const uint8_t> message) {
+                       return std::equal(message.begin(),
+                                         message.end(),
+                                         payload.begin(),
+                                         payload.end());
+                     }),
+                     ids_[0]))
+      .WillOnce(Return(true));
+
+  EXPECT_OUTCOME_FALSE(
+      error, verifier_->verify(justification, block_, noDescendants));
+  EXPECT_EQ(error, JustificationError::NOT_ENOUGH_WEIGHT);
+}
+
+/**
+ * @given justification of a round
+ * @when it is encoded, alone and as it is stored
+ * @then the round is encoded only after the stored one, so the decoders of
+ * either encoding read both
+ */
+TEST_F(JustificationVerifierTest, RoundIsStoredAfterJustification) {
+  GrandpaJustification justification{7, {precommit(ids_[0], block_)}};
+  auto encoded = kagome::scale::encode(justification).value();
+  auto stored =
+      kagome::scale::encode(StoredJustification{justification, true}).value();
+  ASSERT_EQ(stored.size(), encoded.size() + sizeof(RoundNumber));
+  ASSERT_TRUE(std::equal(encoded.begin(), encoded.end(), stored.begin()));
+
+  EXPECT_OUTCOME_TRUE(legacy,
+                      kagome::scale::decode<StoredJustification>(encoded));
+  EXPECT_FALSE(legacy.has_round);
+  EXPECT_EQ(legacy.justification.items, justification.items);
+
+  EXPECT_OUTCOME_TRUE(with_round,
+                      kagome::scale::decode<StoredJustification>(stored));
+  EXPECT_TRUE(with_round.has_round);
+  EXPECT_EQ(with_round.justification.round_number, 7);
+
+  EXPECT_OUTCOME_TRUE(plain,
+                      kagome::scale::decode<GrandpaJustification>(stored));
+  EXPECT_EQ(plain.items, justification.items);
+}
+
+/**
+ * @given finalizing message of a round
+ * @when it is encoded and decoded
+ * @then the round is encoded once and given to the justification
+ */
+TEST_F(JustificationVerifierTest, FinGivesRoundToJustification) {
+  Fin fin{.round_number = 7,
+          .vote = block_,
+          .justification = {7, {precommit(ids_[0], block_)}}};
+  auto encoded = kagome::scale::encode(fin).value();
+  ASSERT_EQ(encoded,
+            kagome::scale::encode(RoundNumber{7}, block_, fin.justification)
+                .value());
+
+  EXPECT_OUTCOME_TRUE(decoded, kagome::scale::decode<Fin>(encoded));
+  EXPECT_EQ(decoded.justification.round_number, 7);
+}
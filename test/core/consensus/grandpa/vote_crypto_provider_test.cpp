@@ -0,0 +1,67 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/vote_crypto_provider_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/crypto/ed25519_provider_mock.hpp"
+#include "testutil/literals.hpp"
+
+using namespace kagome;
+using namespace consensus::grandpa;
+
+using testing::_;
+using testing::Return;
+using testing::Truly;
+
+class VoteCryptoProviderTest : public testing::Test {
+ public:
+  static constexpr RoundNumber kRound = 42;
+  static constexpr MembershipCounter kSetId = 3;
+
+  std::shared_ptr<crypto::ED25519ProviderMock> ed_provider =
+      std::make_shared<crypto::ED25519ProviderMock>();
+  std::shared_ptr<VoterSet> voters = std::make_shared<VoterSet>(kSetId);
+  VoteCryptoProviderImpl provider{
+      crypto::ED25519Keypair{}, ed_provider, kRound, voters};
+};
+
+/**
+ * @given vote crypto provider of a round
+ * @when the payload of each type of the votes is made
+ * @then it is the SCALE encoded (vote, round number, set id)
+ */
+TEST_F(VoteCryptoProviderTest, PayloadIsScaleEncoded) {
+  for (Vote vote : {Vote{Prevote{1, "A"_hash256}},
+                    Vote{Precommit{0x1234567890, "B"_hash256}},
+                    Vote{PrimaryPropose{~0ull, "C"_hash256}}}) {
+    auto payload = provider.payload(vote);
+    auto expected = scale::encode(vote, kRound, kSetId).value();
+    EXPECT_EQ(std::vector<uint8_t>(payload.begin(), payload.end()), expected);
+  }
+}
+
+/**
+ * @given vote crypto provider of a round
+ * @when a prevote is verified
+ * @then the signature is checked against the encoded payload
+ */
+TEST_F(VoteCryptoProviderTest, VerifyPrevote) {
+  SignedMessage prevote;
+  prevote.message = Prevote{5, "D"_hash256};
+  auto expected = scale::encode(prevote.message, kRound, kSetId).value();
+  EXPECT_CALL(*ed_provider,
+              verify(_,
+                     Truly([&](gsl::span<const uint8_t> message) {
+                       return std::equal(message.begin(),
+                                         message.end(),
+                                         expected.begin(),
+                                         expected.end());
+                     }),
+                     _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(provider.verifyPrevote(prevote));
+}
@@ -6,6 +6,7 @@
 #include "consensus/grandpa/impl/vote_tracker_impl.hpp"
 
 #include <gtest/gtest.h>
+#include "consensus/grandpa/impl/indexed_vote_tracker_impl.hpp"
 #include "common/visitor.hpp"
 #include "consensus/grandpa/structs.hpp"
 #include "testutil/literals.hpp"
@@ -145,3 +146,68 @@ TEST_F(VoteTrackerTest, Equivocated) {
       PushResult::DUPLICATED);
   ASSERT_EQ(this->tracker.getTotalWeight(), 4);
 }
+
+class IndexedVoteTrackerTest : public VoteTrackerTest {
+ public:
+  static std::shared_ptr<VoterSet> makeVoters(const std::vector<Id> &ids) {
+    auto voters = std::make_shared<VoterSet>(0);
+    for (auto &id : ids) {
+      voters->insert(id, 1);
+    }
+    return voters;
+  }
+
+  std::shared_ptr<VoterSet> voters = makeVoters(ids);
+  IndexedVoteTrackerImpl indexed_tracker{voters};
+};
+
+/**
+ * @given an empty indexed vote tracker of the voter set
+ * @when pushing the votes of the voters to it
+ * @then the results and the total weight are the same as of the tracker
+ * keeping the votes by id
+ */
+TEST_F(IndexedVoteTrackerTest, PushAsTracker) {
+  for (auto &[m, w, r] : test_messages) {
+    ASSERT_EQ(indexed_tracker.push(m, w), r);
+    ASSERT_EQ(tracker.push(m, w), r);
+  }
+  ASSERT_EQ(indexed_tracker.getTotalWeight(), tracker.getTotalWeight());
+}
+
+/**
+ * @given an empty indexed vote tracker
+ * @when pushing the vote of a voter not in the set
+ * @then it is not accepted
+ */
+TEST_F(IndexedVoteTrackerTest, UnknownVoter) {
+  ASSERT_EQ(indexed_tracker.push(createMessage({"04"_hash256}, hashes[0]), 3),
+            PushResult::DUPLICATED);
+  ASSERT_EQ(indexed_tracker.getTotalWeight(), 0);
+  ASSERT_TRUE(indexed_tracker.getMessages().empty());
+}
+
+/**
+ * @given an indexed vote tracker with a vote and an equivote accepted
+ * @when iterating over its messages
+ * @then they are visited in the order the voters voted first
+ */
+TEST_F(IndexedVoteTrackerTest, ForEachMessage) {
+  indexed_tracker.push(createMessage(ids[2], hashes[0]), 1);
+  indexed_tracker.push(createMessage(ids[0], hashes[0]), 1);
+  indexed_tracker.push(createMessage(ids[2], hashes[1]), 1);
+
+  std::vector<VoteTracker::VoteVariant> visited;
+  indexed_tracker.forEachMessage(
+      [&](const auto &message) { visited.push_back(message); });
+
+  ASSERT_EQ(visited.size(), 2);
+  auto equivote =
+      boost::get<VoteTracker::EquivocatoryVotingMessage>(&visited[0]);
+  ASSERT_NE(equivote, nullptr);
+  ASSERT_EQ(equivote->first.block_hash(), hashes[0]);
+  ASSERT_EQ(equivote->second.block_hash(), hashes[1]);
+  auto vote = boost::get<SignedMessage>(&visited[1]);
+  ASSERT_NE(vote, nullptr);
+  ASSERT_EQ(vote->id, ids[0]);
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "consensus/grandpa/impl/vote_verifier.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/consensus/grandpa/vote_crypto_provider_mock.hpp"
+#include "testutil/literals.hpp"
+
+using namespace kagome::consensus::grandpa;
+
+using testing::_;
+using testing::Return;
+
+class VoteVerifierTest : public testing::Test {
+ public:
+  void SetUp() override {
+    voters->insert(ids[0], 1);
+    voters->insert(ids[1], 1);
+    verifier->startRound(kRound, voters, crypto_provider);
+  }
+
+  SignedMessage prevote(const Id &id, const BlockHash &hash) {
+    SignedMessage vote;
+    vote.id = id;
+    vote.message = Prevote{1, hash};
+    return vote;
+  }
+
+  /// @return callback of the verified votes, which sets \arg verified
+  static VoteVerifier::Callback setFlag(bool &verified) {
+    return [&verified](const SignedMessage &) { verified = true; };
+  }
+
+  static constexpr RoundNumber kRound = 7;
+
+  std::vector<Id> ids{{"01"_hash256}, {"02"_hash256}};
+  std::shared_ptr<boost::asio::io_context> io_context =
+      std::make_shared<boost::asio::io_context>();
+  std::shared_ptr<VoterSet> voters = std::make_shared<VoterSet>(0);
+  std::shared_ptr<VoteCryptoProviderMock> crypto_provider =
+      std::make_shared<VoteCryptoProviderMock>();
+  std::shared_ptr<VoteVerifier> verifier =
+      std::make_shared<VoteVerifier>(io_context);
+};
+
+/**
+ * @given vote verifier of a round
+ * @when the vote of a voter with the valid signature is received twice
+ * @then it is passed to the round once
+ */
+TEST_F(VoteVerifierTest, ValidOnce) {
+  EXPECT_CALL(*crypto_provider, verifyPrevote(_)).WillOnce(Return(true));
+
+  auto vote = prevote(ids[0], "A"_hash256);
+  bool verified = false;
+  ASSERT_TRUE(verifier->verify(kRound, vote, setFlag(verified)));
+  // waits for the result of the verification posted back
+  auto work = boost::asio::make_work_guard(*io_context);
+  io_context->run_one();
+  EXPECT_TRUE(verified);
+
+  EXPECT_FALSE(verifier->verify(kRound, vote, setFlag(verified)));
+}
+
+/**
+ * @given vote verifier of a round
+ * @when the votes of another round or of an unknown voter are received
+ * @then they are dropped without verifying the signatures
+ */
+TEST_F(VoteVerifierTest, DroppedEarly) {
+  EXPECT_CALL(*crypto_provider, verifyPrevote(_)).Times(0);
+
+  EXPECT_FALSE(verifier->verify(
+      kRound + 1, prevote(ids[0], "A"_hash256), [](const auto &) {}));
+  EXPECT_FALSE(verifier->verify(
+      kRound, prevote({"03"_hash256}, "A"_hash256), [](const auto &) {}));
+}
+
+/**
+ * @given vote verifier of a round
+ * @when a vote with the invalid signature is received
+ * @then it is not passed to the round, and the same vote is verified again
+ * when received once more
+ */
+TEST_F(VoteVerifierTest, Invalid) {
+  EXPECT_CALL(*crypto_provider, verifyPrevote(_))
+      .WillOnce(Return(false))
+      .WillOnce(Return(true));
+
+  auto vote = prevote(ids[1], "B"_hash256);
+  bool verified = false;
+  auto work = boost::asio::make_work_guard(*io_context);
+  ASSERT_TRUE(verifier->verify(kRound, vote, setFlag(verified)));
+  io_context->run_one();
+  EXPECT_FALSE(verified);
+
+  ASSERT_TRUE(verifier->verify(kRound, vote, setFlag(verified)));
+  io_context->run_one();
+  EXPECT_TRUE(verified);
+}
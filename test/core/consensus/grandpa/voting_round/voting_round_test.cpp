@@ -279,6 +279,8 @@ TEST_F(VotingRoundTest, EstimateIsValid) {
  * "E"_H)
  * 4. After Eve precommits (when 6.) finalized was updated to BlockInfo(7,
  * "EA"_H) (as this will become the highest block with supermajority)
+ * 5. The catch-up of the round has all the prevotes and precommits along with
+ * the state of the round
  */
 TEST_F(VotingRoundTest, Finalization) {
   // given (in fixture)
@@ -329,6 +331,12 @@ TEST_F(VotingRoundTest, Finalization) {
       preparePrecommit(kEve, kEveSignature, {7, "EA"_H}));
   // then 3.
   ASSERT_EQ(voting_round_->getCurrentState().finalized, BlockInfo(7, "EA"_H));
+
+  // then 5.
+  auto catch_up = voting_round_->catchUp();
+  ASSERT_EQ(catch_up.prevotes.size(), 3);
+  ASSERT_EQ(catch_up.precommits.size(), 3);
+  ASSERT_EQ(catch_up.state, voting_round_->getCurrentState());
 }
 
 ACTION_P(onProposed, test_fixture) {
@@ -492,7 +500,8 @@ TEST_F(VotingRoundTest, SunnyDayScenario) {
             bool has_bob_precommit =
                 boost::find(just.items, bob_precommit) != just.items.end();
 
-            return has_alice_precommit and has_bob_precommit;
+            return just.round_number == round_number_ and has_alice_precommit
+                   and has_bob_precommit;
           })))
       .WillOnce(onFinalize(this));
 
@@ -418,6 +418,108 @@ TEST_F(BlockValidatorTest, TwoBlocksByOnePeer) {
   ASSERT_EQ(err, BabeBlockValidator::ValidationError::TWO_BLOCKS_IN_SLOT);
 }
 
+/**
+ * @given block validator
+ * @when validating the seal of the same block twice, and then its producer
+ * twice
+ * @then the seals are valid both times, as only the producer check memorizes
+ * the block, so the second producer check fails
+ */
+TEST_F(BlockValidatorTest, SealDoesNotMemorizeProducer) {
+  // GIVEN
+  auto block_copy = valid_block_;
+  block_copy.header.digest.pop_back();
+  auto encoded_block_copy = scale::encode(block_copy.header).value();
+  Hash256 encoded_block_copy_hash{};
+  std::copy(encoded_block_copy.begin(),
+            encoded_block_copy.begin() + Hash256::size(),
+            encoded_block_copy_hash.begin());
+
+  auto [seal, pubkey] = sealBlock(valid_block_, encoded_block_copy_hash);
+
+  EXPECT_CALL(*hasher_, blake2b_256(_))
+      .Times(2)
+      .WillRepeatedly(Return(encoded_block_copy_hash));
+
+  EXPECT_CALL(*sr25519_provider_, verify(_, _, pubkey))
+      .Times(2)
+      .WillRepeatedly(Return(outcome::result<bool>(true)));
+
+  babe_epoch_.authorities.emplace_back();
+  auto authority = Authority{{pubkey}, 42};
+  babe_epoch_.authorities.emplace_back(authority);
+
+  auto randomness_with_slot =
+      Buffer{}.put(babe_epoch_.randomness).put(uint64_t_to_bytes(slot_number_));
+  EXPECT_CALL(*vrf_provider_, verify(randomness_with_slot, _, pubkey, _))
+      .Times(2)
+      .WillRepeatedly(
+          Return(VRFVerifyOutput{.is_valid = true, .is_less = true}));
+
+  // WHEN
+  EXPECT_OUTCOME_TRUE_1(validator_.validateSeal(
+      valid_block_.header, authority.id, threshold_, randomness_));
+  EXPECT_OUTCOME_TRUE_1(validator_.validateSeal(
+      valid_block_.header, authority.id, threshold_, randomness_));
+
+  // THEN
+  EXPECT_OUTCOME_TRUE_1(validator_.validateProducer(valid_block_.header));
+  EXPECT_OUTCOME_FALSE(err, validator_.validateProducer(valid_block_.header));
+  ASSERT_EQ(err, BabeBlockValidator::ValidationError::TWO_BLOCKS_IN_SLOT);
+}
+
+/**
+ * @given block validator
+ * @when validating the seals of a batch of headers: a valid one, one signed
+ * by another authority and one without the seal
+ * @then only the first seal is valid, and the producers are not memorized
+ */
+TEST_F(BlockValidatorTest, ValidateSeals) {
+  // GIVEN
+  auto unsealed_header = valid_block_.header;
+  auto [seal, pubkey] = sealBlock(valid_block_, {});
+  SR25519PublicKey other_pubkey{};
+  other_pubkey.fill(9);
+
+  EXPECT_CALL(*hasher_, blake2b_256(_))
+      .Times(2)
+      .WillRepeatedly(Return(Hash256{}));
+  EXPECT_CALL(*sr25519_provider_, verify(_, _, pubkey))
+      .WillOnce(Return(outcome::result<bool>(true)));
+  EXPECT_CALL(*sr25519_provider_, verify(_, _, other_pubkey))
+      .WillOnce(Return(outcome::result<bool>(false)));
+  EXPECT_CALL(*vrf_provider_, verify(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(
+          Return(VRFVerifyOutput{.is_valid = true, .is_less = true}));
+
+  std::vector<SealValidation> batch{
+      {valid_block_.header, {pubkey}, threshold_, randomness_},
+      {valid_block_.header, {other_pubkey}, threshold_, randomness_},
+      {unsealed_header, {pubkey}, threshold_, randomness_}};
+
+  // the headers are validated by the workers
+  BabeBlockValidator validator{tree_,
+                               tx_queue_,
+                               hasher_,
+                               vrf_provider_,
+                               sr25519_provider_,
+                               std::make_shared<kagome::common::WorkerPool>(2)};
+
+  // WHEN
+  auto results = validator.validateSeals(batch);
+
+  // THEN
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_OUTCOME_TRUE_1(results[0]);
+  EXPECT_OUTCOME_FALSE(signature_err, results[1]);
+  ASSERT_EQ(signature_err,
+            BabeBlockValidator::ValidationError::INVALID_SIGNATURE);
+  EXPECT_OUTCOME_FALSE(digest_err, results[2]);
+  ASSERT_EQ(digest_err, kagome::consensus::DigestError::INVALID_DIGESTS);
+  EXPECT_OUTCOME_TRUE_1(validator.validateProducer(valid_block_.header));
+}
+
 /**
  * @given block validator
  * @when validating block, which contains an invalid extrinsic
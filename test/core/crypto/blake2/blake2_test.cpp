@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "testutil/literals.hpp"
 #include "crypto/blake2/blake2b.h"
 #include "crypto/blake2/blake2s.h"
@@ -59,6 +62,42 @@ TEST(Blake2b, Correctness) {
   EXPECT_EQ(memcmp(md, blake2b_res.data(), 32), 0) << "hashes are different";
 }
 
+/**
+ * @given blake2b compression kernels supported by the CPU
+ * @when hashing inputs of various lengths, at once and in chunks
+ * @then every kernel gives the hashes of the portable one
+ */
+TEST(Blake2b, KernelsMatchPortable) {
+  uint8_t in[1024];
+  selftest_seq(in, sizeof(in), 42);
+  auto hashes = [&] {
+    std::vector<uint8_t> out;
+    for (size_t len = 0; len <= sizeof(in); len += 37) {
+      uint8_t md[64];
+      blake2b(md, 64, nullptr, 0, in, len);
+      out.insert(out.end(), md, md + 64);
+
+      blake2b_ctx ctx;
+      blake2b_init(&ctx, 32, nullptr, 0);
+      for (size_t offset = 0; offset < len; offset += 100) {
+        blake2b_update(&ctx, in + offset, std::min<size_t>(100, len - offset));
+      }
+      blake2b_final(&ctx, md);
+      out.insert(out.end(), md, md + 32);
+    }
+    return out;
+  };
+
+  ASSERT_EQ(blake2b_use_impl(BLAKE2B_IMPL_PORTABLE), 0);
+  auto expected = hashes();
+  for (auto impl : {BLAKE2B_IMPL_AVX2, BLAKE2B_IMPL_AVX512}) {
+    if (blake2b_use_impl(impl) == 0) {
+      EXPECT_EQ(hashes(), expected) << "kernel " << impl;
+    }
+  }
+  ASSERT_EQ(blake2b_use_impl(BLAKE2B_IMPL_AUTO), 0);
+}
+
 TEST(Blake2s, Correctness) {
   // Grand hash of hash results.
   auto blake2s_res = "6A411F08CE25ADCDFB02ABA641451CEC53C598B24F4FC787FBDC88797F4C1DFE"_unhex;
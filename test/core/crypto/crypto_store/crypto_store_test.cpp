@@ -5,6 +5,8 @@
 
 #include "crypto/crypto_store/crypto_store_impl.hpp"
 
+#include <fstream>
+
 #include "crypto/bip39/impl/bip39_provider_impl.hpp"
 #include "crypto/ed25519/ed25519_provider_impl.hpp"
 #include "crypto/pbkdf2/impl/pbkdf2_provider_impl.hpp"
@@ -48,20 +50,10 @@ struct CryptoStoreTest : public test::BaseFS_Test {
   CryptoStoreTest() : BaseFS_Test(crypto_store_test_directory) {}
 
   void SetUp() override {
-    auto ed25519_provider = std::make_shared<ED25519ProviderImpl>();
-    auto csprng = std::make_shared<BoostRandomGenerator>();
-    auto sr25519_provider = std::make_shared<SR25519ProviderImpl>(csprng);
-    auto secp256k1_provider = std::make_shared<Secp256k1ProviderImpl>();
-
     auto pbkdf2_provider = std::make_shared<Pbkdf2ProviderImpl>();
     bip39_provider =
         std::make_shared<Bip39ProviderImpl>(std::move(pbkdf2_provider));
-    crypto_store =
-        std::make_shared<CryptoStoreImpl>(std::move(ed25519_provider),
-                                          std::move(sr25519_provider),
-                                          std::move(secp256k1_provider),
-                                          bip39_provider,
-                                          std::move(csprng));
+    crypto_store = makeCryptoStore();
 
     mnemonic =
         "ozone drill grab fiber curtain grace pudding thank cruise elder eight "
@@ -100,6 +92,16 @@ struct CryptoStoreTest : public test::BaseFS_Test {
         "initialization failed");
   }
 
+  std::shared_ptr<CryptoStoreImpl> makeCryptoStore() {
+    auto csprng = std::make_shared<BoostRandomGenerator>();
+    return std::make_shared<CryptoStoreImpl>(
+        std::make_shared<ED25519ProviderImpl>(),
+        std::make_shared<SR25519ProviderImpl>(csprng),
+        std::make_shared<Secp256k1ProviderImpl>(),
+        bip39_provider,
+        csprng);
+  }
+
   bool isStoredOnDisk(KeyTypeId kt, const Blob<32> &public_key) {
     auto file_name = kagome::crypto::decodeKeyTypeId(kt) + public_key.toHex();
     auto file_path = crypto_store_test_directory / file_name;
@@ -284,3 +286,85 @@ TEST_F(CryptoStoreTest, getSr25519PublicKeysSuccess) {
   auto &&keys = crypto_store->getSr25519PublicKeys(kBabe);
   ASSERT_EQ(sr_babe_keys, keys);
 }
+
+/**
+ * @given key files stored by a cryptostore instance
+ * @when another instance is initialized with the same directory
+ * @then it finds the keypairs of the files and lists their public keys
+ */
+TEST_F(CryptoStoreTest, keyFilesLoadedAtInitialization) {
+  EXPECT_OUTCOME_TRUE(ed, crypto_store->generateEd25519Keypair(kGran));
+  EXPECT_OUTCOME_TRUE(sr, crypto_store->generateSr25519Keypair(kBabe));
+
+  auto other_store = makeCryptoStore();
+  EXPECT_OUTCOME_TRUE_1(other_store->initialize(crypto_store_test_directory));
+  EXPECT_OUTCOME_TRUE(found_ed,
+                      other_store->findEd25519Keypair(kGran, ed.public_key));
+  ASSERT_EQ(found_ed, ed);
+  EXPECT_OUTCOME_TRUE(found_sr,
+                      other_store->findSr25519Keypair(kBabe, sr.public_key));
+  ASSERT_EQ(found_sr, sr);
+  ASSERT_EQ(other_store->getEd25519PublicKeys(kGran),
+            std::vector<ED25519PublicKey>{ed.public_key});
+  ASSERT_EQ(other_store->getSr25519PublicKeys(kBabe),
+            std::vector<SR25519PublicKey>{sr.public_key});
+  // the kind of the key is told by the seed
+  ASSERT_TRUE(other_store->getSr25519PublicKeys(kGran).empty());
+  ASSERT_TRUE(other_store->getEd25519PublicKeys(kBabe).empty());
+}
+
+/**
+ * @given an initialized cryptostore instance
+ * @when key files are put to the directory and removed from it
+ * @then their keypairs are found after the reload, and are not found after
+ * the reload following the removal, while the keypairs generated in memory
+ * stay
+ */
+TEST_F(CryptoStoreTest, reloadKeyFiles) {
+  auto memory_pair = crypto_store->generateSr25519Keypair(kBabe, seed);
+  EXPECT_OUTCOME_TRUE(unchanged, crypto_store->reloadKeyFiles());
+  ASSERT_FALSE(unchanged);
+
+  auto other_store = makeCryptoStore();
+  EXPECT_OUTCOME_TRUE_1(other_store->initialize(crypto_store_test_directory));
+  EXPECT_OUTCOME_TRUE(pair, other_store->generateSr25519Keypair(kBabe));
+  EXPECT_OUTCOME_FALSE_1(
+      crypto_store->findSr25519Keypair(kBabe, pair.public_key));
+
+  EXPECT_OUTCOME_TRUE(added, crypto_store->reloadKeyFiles());
+  ASSERT_TRUE(added);
+  EXPECT_OUTCOME_TRUE(found,
+                      crypto_store->findSr25519Keypair(kBabe, pair.public_key));
+  ASSERT_EQ(found, pair);
+
+  boost::filesystem::remove(crypto_store_test_directory
+                            / (kagome::crypto::decodeKeyTypeId(kBabe)
+                               + pair.public_key.toHex()));
+  EXPECT_OUTCOME_TRUE(removed, crypto_store->reloadKeyFiles());
+  ASSERT_TRUE(removed);
+  EXPECT_OUTCOME_ERROR(not_found,
+                       crypto_store->findSr25519Keypair(kBabe, pair.public_key),
+                       CryptoStoreError::KEY_NOT_FOUND);
+  ASSERT_EQ(crypto_store->getSr25519PublicKeys(kBabe),
+            std::vector<SR25519PublicKey>{memory_pair.public_key});
+}
+
+/**
+ * @given a key file, which seed derives no keypair of the public key in its
+ * name
+ * @when the key files are loaded
+ * @then the file is skipped
+ */
+TEST_F(CryptoStoreTest, inconsistentKeyFileSkipped) {
+  std::ofstream file{(crypto_store_test_directory
+                      / (kagome::crypto::decodeKeyTypeId(kBabe)
+                         + sr_pair.public_key.toHex()))
+                         .string()};
+  file << seed.toHex() << std::endl;
+  file.close();
+
+  EXPECT_OUTCOME_TRUE(changed, crypto_store->reloadKeyFiles());
+  ASSERT_TRUE(changed);
+  ASSERT_TRUE(crypto_store->getSr25519PublicKeys(kBabe).empty());
+  ASSERT_TRUE(crypto_store->getEd25519PublicKeys(kBabe).empty());
+}
@@ -14,10 +14,13 @@ using kagome::crypto::ED25519Provider;
 using kagome::crypto::ED25519ProviderImpl;
 using kagome::crypto::ED25519PublicKey;
 using kagome::crypto::ED25519Seed;
+using kagome::crypto::ED25519Verification;
 
 struct ED25519ProviderTest : public ::testing::Test {
   void SetUp() override {
-    ed25519_provider = std::make_shared<ED25519ProviderImpl>();
+    // the large batches are verified by the workers
+    ed25519_provider = std::make_shared<ED25519ProviderImpl>(
+        std::make_shared<kagome::common::WorkerPool>(2));
 
     std::string_view m = "i am a message";
     message = std::vector<uint8_t>(m.begin(), m.end());
@@ -136,3 +139,35 @@ TEST_F(ED25519ProviderTest, GenerateBySeedSuccess) {
   ASSERT_EQ(kp.private_key, private_key);
   ASSERT_EQ(kp.public_key, public_key);
 }
+
+/**
+ * @given batches of the signatures of the different messages, smaller and
+ * larger than the one verified in parallel, with one signature of each
+ * signed by another key
+ * @when the batches are verified
+ * @then only that signature is invalid
+ */
+TEST_F(ED25519ProviderTest, VerifyBatch) {
+  EXPECT_OUTCOME_TRUE(kp, ed25519_provider->generateKeypair());
+  EXPECT_OUTCOME_TRUE(other_kp, ed25519_provider->generateKeypair());
+  for (size_t size : {size_t{3}, ED25519ProviderImpl::kMinParallelBatch * 2}) {
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < size; ++i) {
+      messages.push_back({static_cast<uint8_t>(i), 1, 2, 3});
+    }
+    auto invalid = size / 2;
+    std::vector<ED25519Verification> batch;
+    for (size_t i = 0; i < size; ++i) {
+      const auto &signer = i == invalid ? other_kp : kp;
+      EXPECT_OUTCOME_TRUE(signature,
+                          ed25519_provider->sign(signer, messages[i]));
+      batch.push_back({signature, messages[i], kp.public_key});
+    }
+
+    auto valid = ed25519_provider->verifyBatch(batch);
+    ASSERT_EQ(valid.size(), size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(valid[i], i != invalid) << i;
+    }
+  }
+}
@@ -131,3 +131,44 @@ TEST_F(HasherFixture, blake2_128) {
   auto hash = hasher->blake2b_128(buffer);
   ASSERT_EQ(blob2buffer<16>(hash).toVector(), match);
 }
+
+/**
+ * @given small batches and a batch large enough to be hashed on several
+ * threads, and hashers with and without workers
+ * @when Hasher::*_many methods are applied
+ * @then each hash is the one of the corresponding input
+ */
+TEST_F(HasherFixture, HashesMany) {
+  std::vector<std::shared_ptr<kagome::crypto::Hasher>> many_hashers{
+      hasher,
+      std::make_shared<kagome::crypto::HasherImpl>(
+          std::make_shared<kagome::common::WorkerPool>(3))};
+  for (size_t input_size :
+       {size_t{0},
+        size_t{100},
+        kagome::crypto::HasherImpl::kParallelHashingThreshold}) {
+    std::vector<Buffer> buffers;
+    std::vector<gsl::span<const uint8_t>> inputs;
+    for (uint8_t i = 0; i < 10; i++) {
+      buffers.emplace_back(input_size + i, i);
+    }
+    for (auto &buffer : buffers) {
+      inputs.emplace_back(buffer);
+    }
+
+    for (auto &many_hasher : many_hashers) {
+      std::vector<kagome::common::Hash256> blake2b_256(inputs.size());
+      std::vector<kagome::common::Hash128> twox_128(inputs.size());
+      std::vector<kagome::common::Hash256> twox_256(inputs.size());
+      many_hasher->blake2b_256_many(inputs, blake2b_256);
+      many_hasher->twox_128_many(inputs, twox_128);
+      many_hasher->twox_256_many(inputs, twox_256);
+
+      for (size_t i = 0; i < inputs.size(); i++) {
+        EXPECT_EQ(blake2b_256[i], hasher->blake2b_256(buffers[i]));
+        EXPECT_EQ(twox_128[i], hasher->twox_128(buffers[i]));
+        EXPECT_EQ(twox_256[i], hasher->twox_256(buffers[i]));
+      }
+    }
+  }
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto/secp256k1/cached_secp256k1_provider.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "crypto/hasher/hasher_impl.hpp"
+#include "crypto/secp256k1/secp256k1_provider_impl.hpp"
+#include "mock/core/crypto/secp256k1_provider_mock.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::crypto::CachedSecp256k1Provider;
+using kagome::crypto::HasherImpl;
+using kagome::crypto::Secp256k1ProviderError;
+using kagome::crypto::Secp256k1ProviderImpl;
+using kagome::crypto::Secp256k1ProviderMock;
+using kagome::crypto::secp256k1::CompressedPublicKey;
+using kagome::crypto::secp256k1::MessageHash;
+using kagome::crypto::secp256k1::RSVSignature;
+using kagome::crypto::secp256k1::UncompressedPublicKey;
+using testing::_;
+using testing::Return;
+
+class CachedSecp256k1ProviderTest : public testing::Test {
+ public:
+  static constexpr size_t kCapacity = 2;
+
+  RSVSignature signature(uint8_t byte) {
+    RSVSignature signature;
+    signature.fill(byte);
+    return signature;
+  }
+
+  std::shared_ptr<Secp256k1ProviderMock> mock =
+      std::make_shared<Secp256k1ProviderMock>();
+  CachedSecp256k1Provider cached{mock, kCapacity};
+  MessageHash message_hash;
+  UncompressedPublicKey public_key;
+};
+
+/**
+ * @given a signature recovered through the cache
+ * @when it is recovered again, in both forms
+ * @then the underlying provider recovers it once, and the compressed key is
+ * made of the uncompressed one
+ */
+TEST_F(CachedSecp256k1ProviderTest, RecoversOnce) {
+  public_key.fill(0x11);
+  public_key[0] = 0x04;
+  public_key.back() = 0x22;
+  EXPECT_CALL(*mock, recoverPublickeyUncompressed(signature(1), message_hash))
+      .WillOnce(Return(public_key));
+
+  EXPECT_OUTCOME_TRUE(first,
+                      cached.recoverPublickeyUncompressed(signature(1),
+                                                          message_hash));
+  ASSERT_EQ(first, public_key);
+  EXPECT_OUTCOME_TRUE(second,
+                      cached.recoverPublickeyUncompressed(signature(1),
+                                                          message_hash));
+  ASSERT_EQ(second, public_key);
+  EXPECT_OUTCOME_TRUE(compressed,
+                      cached.recoverPublickeyCompressed(signature(1),
+                                                        message_hash));
+  // y is even
+  ASSERT_EQ(compressed[0], 0x02);
+  ASSERT_TRUE(std::all_of(compressed.begin() + 1,
+                          compressed.end(),
+                          [](uint8_t byte) { return byte == 0x11; }));
+  ASSERT_EQ(cached.size(), 1);
+}
+
+/**
+ * @given a signature, which is not recovered
+ * @when it is recovered again
+ * @then the underlying provider is asked again, as the failure is not kept
+ */
+TEST_F(CachedSecp256k1ProviderTest, FailureNotCached) {
+  EXPECT_CALL(*mock, recoverPublickeyUncompressed(signature(1), message_hash))
+      .Times(2)
+      .WillRepeatedly(Return(Secp256k1ProviderError::INVALID_V_VALUE));
+  EXPECT_OUTCOME_FALSE_1(
+      cached.recoverPublickeyUncompressed(signature(1), message_hash));
+  EXPECT_OUTCOME_FALSE_1(
+      cached.recoverPublickeyCompressed(signature(1), message_hash));
+  ASSERT_EQ(cached.size(), 0);
+}
+
+/**
+ * @given a full cache
+ * @when another signature is recovered
+ * @then the least recently used key is evicted and recovered anew
+ */
+TEST_F(CachedSecp256k1ProviderTest, EvictsLeastRecentlyUsed) {
+  EXPECT_CALL(*mock, recoverPublickeyUncompressed(signature(1), _))
+      .Times(2)
+      .WillRepeatedly(Return(public_key));
+  EXPECT_CALL(*mock, recoverPublickeyUncompressed(signature(2), _))
+      .WillOnce(Return(public_key));
+  EXPECT_CALL(*mock, recoverPublickeyUncompressed(signature(3), _))
+      .WillOnce(Return(public_key));
+
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(1), message_hash));
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(2), message_hash));
+  // 2 is used more recently than 1
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(2), message_hash));
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(3), message_hash));
+  ASSERT_EQ(cached.size(), kCapacity);
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(2), message_hash));
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature(1), message_hash));
+}
+
+/**
+ * @given the signature of a message by a known key
+ * @when the compressed key is recovered through the cache over the real
+ * provider
+ * @then it is the one the real provider recovers
+ */
+TEST(CachedSecp256k1ProviderImplTest, CompressedMatchesProvider) {
+  auto provider = std::make_shared<Secp256k1ProviderImpl>();
+  CachedSecp256k1Provider cached{provider, 16};
+  HasherImpl hasher;
+  // message: "this is a message"
+  EXPECT_OUTCOME_TRUE(message,
+                      Buffer::fromHex("746869732069732061206d657373616765"));
+  auto message_hash = hasher.blake2s_256(message);
+  EXPECT_OUTCOME_TRUE(
+      signature_bytes,
+      Buffer::fromHex("ebdedee38bcf530f13c1b5c8717d974a6f8bd25a7e3707ca36c7ee"
+                      "7efd5aa6c557bcc67906975696cbb28a556b649e5fbf5ce5183157"
+                      "2cd54add248c4d023fcf01"));
+  auto signature = RSVSignature::fromSpan(signature_bytes).value();
+
+  EXPECT_OUTCOME_TRUE(expected,
+                      provider->recoverPublickeyCompressed(signature,
+                                                           message_hash));
+  EXPECT_OUTCOME_TRUE_1(
+      cached.recoverPublickeyUncompressed(signature, message_hash));
+  EXPECT_OUTCOME_TRUE(compressed,
+                      cached.recoverPublickeyCompressed(signature,
+                                                        message_hash));
+  ASSERT_EQ(compressed, expected);
+}
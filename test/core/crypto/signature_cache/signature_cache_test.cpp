@@ -0,0 +1,101 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "crypto/signature_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "common/buffer.hpp"
+
+using kagome::common::Buffer;
+using kagome::crypto::SignatureCache;
+using Scheme = kagome::crypto::SignatureCache::Scheme;
+
+class SignatureCacheTest : public ::testing::Test {
+ protected:
+  /**
+   * @return result of verifying \arg signature with the cache, counting the
+   * actual verifications, which return \arg valid
+   */
+  bool verify(const Buffer &signature, bool valid = true) {
+    return cache_.verify(Scheme::kSr25519,
+                         signature,
+                         message_,
+                         public_key_,
+                         [this, valid] {
+                           ++verifications_;
+                           return valid;
+                         });
+  }
+
+  SignatureCache cache_{2};
+  Buffer message_{1, 2, 3};
+  Buffer public_key_ = Buffer(32, 7);
+  size_t verifications_ = 0;
+};
+
+/**
+ * @given signature cache
+ * @when a valid signature is verified twice
+ * @then it is verified only the first time
+ */
+TEST_F(SignatureCacheTest, ValidSignatureIsVerifiedOnce) {
+  Buffer signature(64, 1);
+  ASSERT_TRUE(verify(signature));
+  ASSERT_TRUE(verify(signature));
+  ASSERT_EQ(verifications_, 1);
+  ASSERT_EQ(cache_.size(), 1);
+}
+
+/**
+ * @given signature cache
+ * @when an invalid signature is verified twice
+ * @then it is verified both times @and is not kept
+ */
+TEST_F(SignatureCacheTest, InvalidSignatureIsNotKept) {
+  Buffer signature(64, 1);
+  ASSERT_FALSE(verify(signature, false));
+  ASSERT_FALSE(verify(signature, false));
+  ASSERT_EQ(verifications_, 2);
+  ASSERT_EQ(cache_.size(), 0);
+}
+
+/**
+ * @given signature cache with a valid sr25519 signature
+ * @when the same bytes are verified as an ed25519 signature
+ * @then they are verified
+ */
+TEST_F(SignatureCacheTest, KeysDependOnScheme) {
+  Buffer signature(64, 1);
+  ASSERT_TRUE(verify(signature));
+  ASSERT_TRUE(cache_.verify(
+      Scheme::kEd25519, signature, message_, public_key_, [this] {
+        ++verifications_;
+        return true;
+      }));
+  ASSERT_EQ(verifications_, 2);
+}
+
+/**
+ * @given signature cache of 2 signatures
+ * @when more signatures than that are verified
+ * @then the least recently used one is evicted
+ */
+TEST_F(SignatureCacheTest, LeastRecentlyUsedIsEvicted) {
+  Buffer first(64, 1);
+  Buffer second(64, 2);
+  Buffer third(64, 3);
+  ASSERT_TRUE(verify(first));
+  ASSERT_TRUE(verify(second));
+  ASSERT_TRUE(verify(first));
+  ASSERT_TRUE(verify(third));
+  ASSERT_EQ(verifications_, 3);
+  ASSERT_EQ(cache_.size(), 2);
+
+  ASSERT_TRUE(verify(first));
+  ASSERT_EQ(verifications_, 3);
+  ASSERT_TRUE(verify(second));
+  ASSERT_EQ(verifications_, 4);
+}
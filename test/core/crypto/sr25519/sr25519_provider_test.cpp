@@ -17,11 +17,14 @@ using kagome::crypto::SR25519ProviderImpl;
 using kagome::crypto::SR25519PublicKey;
 using kagome::crypto::SR25519SecretKey;
 using kagome::crypto::SR25519Seed;
+using kagome::crypto::SR25519Verification;
 
 struct SR25519ProviderTest : public ::testing::Test {
   void SetUp() override {
     random_generator = std::make_shared<BoostRandomGenerator>();
-    sr25519_provider = std::make_shared<SR25519ProviderImpl>(random_generator);
+    // the large batches are verified by the workers
+    sr25519_provider = std::make_shared<SR25519ProviderImpl>(
+        random_generator, std::make_shared<kagome::common::WorkerPool>(2));
 
     std::string_view m = "i am a message";
     message.clear();
@@ -148,3 +151,35 @@ TEST_F(SR25519ProviderTest, GenerateBySeedSuccess) {
   ASSERT_EQ(kp.secret_key, secret_key);
   ASSERT_EQ(kp.public_key, public_key);
 }
+
+/**
+ * @given batches of the signatures of the different messages, smaller and
+ * larger than the one verified in parallel, with one signature of each
+ * signed by another key
+ * @when the batches are verified
+ * @then only that signature is invalid
+ */
+TEST_F(SR25519ProviderTest, VerifyBatch) {
+  auto kp = sr25519_provider->generateKeypair();
+  auto other_kp = sr25519_provider->generateKeypair();
+  for (size_t size : {size_t{3}, SR25519ProviderImpl::kMinParallelBatch * 2}) {
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t i = 0; i < size; ++i) {
+      messages.push_back({static_cast<uint8_t>(i), 1, 2, 3});
+    }
+    auto invalid = size / 2;
+    std::vector<SR25519Verification> batch;
+    for (size_t i = 0; i < size; ++i) {
+      const auto &signer = i == invalid ? other_kp : kp;
+      EXPECT_OUTCOME_TRUE(signature,
+                          sr25519_provider->sign(signer, messages[i]));
+      batch.push_back({signature, messages[i], kp.public_key});
+    }
+
+    auto valid = sr25519_provider->verifyBatch(batch);
+    ASSERT_EQ(valid.size(), size);
+    for (size_t i = 0; i < size; ++i) {
+      EXPECT_EQ(valid[i], i != invalid) << i;
+    }
+  }
+}
@@ -5,8 +5,11 @@
 
 #include "crypto/twox/twox.hpp"
 
+#include <cstring>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <xxhash/xxhash.h>
 #include "testutil/literals.hpp"
 
 using kagome::common::Buffer;
@@ -55,3 +58,22 @@ TEST(Twox256, Correctness) {
     ASSERT_THAT(hash, ::testing::ElementsAreArray(reference));
   }
 }
+
+/**
+ * @given inputs of the lengths covering all the paths of XXH64
+ * @when calling make_twox256, which hashes with all the seeds at once
+ * @then each word of the hash is XXH64 of the input with its seed
+ */
+TEST(Twox256, MatchesXxh64PerSeed) {
+  Buffer input;
+  for (size_t len = 0; len < 100; ++len) {
+    auto hash = make_twox256(input);
+    for (uint64_t seed = 0; seed < 4; ++seed) {
+      uint64_t word;
+      std::memcpy(&word, hash.data() + seed * sizeof(word), sizeof(word));
+      ASSERT_EQ(word, XXH64(input.data(), input.size(), seed))
+          << "length " << len << ", seed " << seed;
+    }
+    input.putUint8(len * 7 + 3);
+  }
+}
@@ -429,6 +429,82 @@ TEST_F(CryptoExtensionTest, Sr25519VerifyFailure) {
             5);
 }
 
+/**
+ * @given initialized crypto extension @and sr25519- and ed25519-signed messages
+ * @when a batch verification is started @and the signatures are passed to the
+ * batch verify functions @and the batch is finished
+ * @then the signatures are queued @and the batch succeeds, while a batch with a
+ * wrong signature fails, as well as the verification of it without a batch,
+ * whether the batches are verified by workers or not
+ */
+TEST_F(CryptoExtensionTest, BatchVerify) {
+  WasmPointer input_data = 0;
+  WasmSpan input_span = WasmResult(input_data, input.size()).combine();
+  WasmPointer sr25519_sig_ptr = 42;
+  WasmPointer sr25519_key_ptr = 123;
+  WasmPointer ed25519_sig_ptr = 234;
+  WasmPointer ed25519_key_ptr = 345;
+  WasmPointer false_sig_ptr = 456;
+  auto false_signature = Buffer(sr25519_signature);
+  ++false_signature[0];
+
+  EXPECT_CALL(*memory_, loadN(input_data, input.size()))
+      .WillRepeatedly(Return(input));
+  EXPECT_CALL(*memory_,
+              loadN(sr25519_sig_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillRepeatedly(Return(Buffer(sr25519_signature)));
+  EXPECT_CALL(*memory_,
+              loadN(sr25519_key_ptr, sr25519_constants::PUBLIC_SIZE))
+      .WillRepeatedly(Return(Buffer(sr25519_keypair.public_key)));
+  EXPECT_CALL(*memory_,
+              loadN(ed25519_sig_ptr, ed25519_constants::SIGNATURE_SIZE))
+      .WillRepeatedly(Return(Buffer(ed25519_signature)));
+  EXPECT_CALL(*memory_,
+              loadN(ed25519_key_ptr, ed25519_constants::PUBKEY_SIZE))
+      .WillRepeatedly(Return(Buffer(ed25519_keypair.public_key)));
+  EXPECT_CALL(*memory_,
+              loadN(false_sig_ptr, sr25519_constants::SIGNATURE_SIZE))
+      .WillRepeatedly(Return(false_signature));
+
+  // the same with the signatures of the batches verified by the workers
+  auto crypto_ext_on_workers = std::make_shared<CryptoExtension>(
+      memory_,
+      sr25519_provider_,
+      ed25519_provider_,
+      secp256k1_provider_,
+      hasher_,
+      crypto_store_,
+      bip39_provider_,
+      nullptr,
+      std::make_shared<kagome::common::WorkerPool>(2));
+  for (auto &crypto_ext : {crypto_ext_, crypto_ext_on_workers}) {
+    crypto_ext->ext_start_batch_verify_v1();
+    ASSERT_EQ(crypto_ext->ext_sr25519_batch_verify_v1(
+                  sr25519_sig_ptr, input_span, sr25519_key_ptr),
+              1);
+    ASSERT_EQ(crypto_ext->ext_ed25519_batch_verify_v1(
+                  ed25519_sig_ptr, input_span, ed25519_key_ptr),
+              1);
+    ASSERT_EQ(crypto_ext->ext_finish_batch_verify_v1(), 1);
+
+    crypto_ext->ext_start_batch_verify_v1();
+    ASSERT_EQ(crypto_ext->ext_sr25519_batch_verify_v1(
+                  sr25519_sig_ptr, input_span, sr25519_key_ptr),
+              1);
+    ASSERT_EQ(crypto_ext->ext_sr25519_batch_verify_v1(
+                  false_sig_ptr, input_span, sr25519_key_ptr),
+              1);
+    ASSERT_EQ(crypto_ext->ext_finish_batch_verify_v1(), 0);
+
+    ASSERT_EQ(crypto_ext->ext_sr25519_batch_verify_v1(
+                  false_sig_ptr, input_span, sr25519_key_ptr),
+              0);
+    ASSERT_EQ(crypto_ext->ext_ed25519_batch_verify_v1(
+                  ed25519_sig_ptr, input_span, ed25519_key_ptr),
+              1);
+  }
+}
+
 /**
  * @given initialized crypto extensions @and some bytes
  * @when XX-hashing those bytes to get 16-byte hash
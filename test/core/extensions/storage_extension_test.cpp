@@ -29,6 +29,7 @@ using kagome::runtime::WasmSize;
 using kagome::runtime::WasmSpan;
 using kagome::storage::changes_trie::ChangesTrackerMock;
 using kagome::storage::face::MapCursorMock;
+using kagome::storage::trie::ClearPrefixResult;
 using kagome::storage::trie::EphemeralTrieBatchMock;
 using kagome::storage::trie::PersistentTrieBatchMock;
 
@@ -100,6 +101,34 @@ TEST_F(StorageExtensionTest, ClearPrefixTest) {
   storage_extension_->ext_clear_prefix(prefix_pointer, prefix_size);
 }
 
+/**
+ * @given prefix and limit spans
+ * @when ext_storage_clear_prefix_version_2 is invoked on StorageExtension
+ * @then the limited clearPrefix is invoked on storage @and its result is
+ * returned SCALE-encoded as KillStorageResult
+ */
+TEST_F(StorageExtensionTest, ClearPrefixWithLimitTest) {
+  WasmResult prefix_span(42, 8);
+  WasmResult limit_span(84, 5);
+  Buffer prefix(8, 'p');
+  Buffer limit{kagome::scale::encode(boost::optional<uint32_t>{10}).value()};
+  WasmSpan result_span = WasmResult(126, 5).combine();
+
+  EXPECT_CALL(*memory_, loadN(prefix_span.address, prefix_span.length))
+      .WillOnce(Return(prefix));
+  EXPECT_CALL(*memory_, loadN(limit_span.address, limit_span.length))
+      .WillOnce(Return(limit));
+  EXPECT_CALL(*trie_batch_, clearPrefix(prefix, 10))
+      .WillOnce(Return(ClearPrefixResult{false, 10}));
+  auto expected = kagome::scale::encode(uint8_t{1}, uint32_t{10}).value();
+  EXPECT_CALL(*memory_, storeBuffer(gsl::span<const uint8_t>(expected)))
+      .WillOnce(Return(result_span));
+
+  ASSERT_EQ(storage_extension_->ext_storage_clear_prefix_version_2(
+                prefix_span.combine(), limit_span.combine()),
+            result_span);
+}
+
 /**
  * @given key_pointer and key_size
  * @when ext_clear_storage is invoked on StorageExtension with given key
@@ -291,8 +320,8 @@ TEST_F(StorageExtensionTest, NextKey) {
   EXPECT_CALL(*trie_batch_, cursor())
       .WillOnce(Invoke([&key, &expected_next_key]() {
         auto cursor = std::make_unique<MapCursorMock<Buffer, Buffer>>();
-        EXPECT_CALL(*cursor, seek(key)).WillOnce(Return(outcome::success()));
-        EXPECT_CALL(*cursor, next()).WillOnce(Return(outcome::success()));
+        EXPECT_CALL(*cursor, seekUpperBound(key))
+            .WillOnce(Return(outcome::success()));
         EXPECT_CALL(*cursor, isValid()).WillOnce(Return(true));
         EXPECT_CALL(*cursor, key()).WillOnce(Return(expected_next_key));
         return cursor;
@@ -330,8 +359,8 @@ TEST_F(StorageExtensionTest, NextKeyLastKey) {
 
   EXPECT_CALL(*trie_batch_, cursor()).WillOnce(Invoke([&key]() {
     auto cursor = std::make_unique<MapCursorMock<Buffer, Buffer>>();
-    EXPECT_CALL(*cursor, seek(key)).WillOnce(Return(outcome::success()));
-    EXPECT_CALL(*cursor, next()).WillOnce(Return(outcome::success()));
+    EXPECT_CALL(*cursor, seekUpperBound(key))
+        .WillOnce(Return(outcome::success()));
     EXPECT_CALL(*cursor, isValid()).WillOnce(Return(false));
     return cursor;
   }));
@@ -349,7 +378,8 @@ TEST_F(StorageExtensionTest, NextKeyLastKey) {
 }
 
 /**
- * @given a trie key address in WASM memory, which is not present in the storage
+ * @given a trie key address in WASM memory and a storage cursor failing to
+ * seek the key
  * @when using ext_storage_next_key_version_1 to obtain the next key
  * @then an invalid address is returned
  */
@@ -362,9 +392,9 @@ TEST_F(StorageExtensionTest, NextKeyInvalidKey) {
 
   EXPECT_CALL(*trie_batch_, cursor()).WillOnce(Invoke([&key]() {
     auto cursor = std::make_unique<MapCursorMock<Buffer, Buffer>>();
-    EXPECT_CALL(*cursor, seek(key))
+    EXPECT_CALL(*cursor, seekUpperBound(key))
         .WillOnce(Return(
-            kagome::storage::trie::PolkadotTrieCursor::Error::NOT_FOUND));
+            kagome::storage::trie::PolkadotTrieCursor::Error::NULL_ROOT));
     return cursor;
   }));
 
@@ -373,6 +403,56 @@ TEST_F(StorageExtensionTest, NextKeyInvalidKey) {
   ASSERT_EQ(next_key_span, -1);
 }
 
+/**
+ * @given a key returned by the previous ext_storage_next_key_version_1 call
+ * @when obtaining the key next to it
+ * @then the cursor of the previous call is moved forward instead of seeking a
+ * new one
+ */
+TEST_F(StorageExtensionTest, NextKeyContinuesFromLastKey) {
+  WasmPointer key_pointer = 43;
+  WasmSize key_size = 8;
+  Buffer key(key_size, 'k');
+  WasmPointer next_key_pointer = 44;
+  Buffer next_key(key_size + 1, 'k');
+  Buffer last_key(key_size + 2, 'k');
+
+  EXPECT_CALL(*memory_, loadN(key_pointer, key_size)).WillOnce(Return(key));
+  EXPECT_CALL(*memory_, loadN(next_key_pointer, next_key.size()))
+      .WillOnce(Return(next_key));
+
+  EXPECT_CALL(*trie_batch_, cursor())
+      .WillOnce(Invoke([&key, &next_key, &last_key]() {
+        auto cursor = std::make_unique<MapCursorMock<Buffer, Buffer>>();
+        EXPECT_CALL(*cursor, seekUpperBound(key))
+            .WillOnce(Return(outcome::success()));
+        EXPECT_CALL(*cursor, next()).WillOnce(Return(outcome::success()));
+        EXPECT_CALL(*cursor, isValid()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*cursor, key())
+            .WillOnce(Return(next_key))
+            .WillOnce(Return(last_key));
+        return cursor;
+      }));
+
+  std::vector<boost::optional<Buffer>> stored_keys;
+  EXPECT_CALL(*memory_, storeBuffer(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&stored_keys](auto &&buffer) -> WasmSpan {
+        EXPECT_OUTCOME_TRUE(
+            key_opt, kagome::scale::decode<boost::optional<Buffer>>(buffer));
+        stored_keys.emplace_back(std::move(key_opt));
+        return 0;
+      }));
+
+  storage_extension_->ext_storage_next_key_version_1(
+      WasmResult{key_pointer, key_size}.combine());
+  storage_extension_->ext_storage_next_key_version_1(
+      WasmResult{next_key_pointer, static_cast<WasmSize>(next_key.size())}
+          .combine());
+  ASSERT_EQ(stored_keys,
+            (std::vector<boost::optional<Buffer>>{next_key, last_key}));
+}
+
 /**
  * @given key_pointer, key_size, value_ptr, value_size
  * @when ext_set_storage is invoked on given key and value
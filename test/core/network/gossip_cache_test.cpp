@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/gossip_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/clock/clock_mock.hpp"
+
+using namespace kagome;
+using namespace network;
+using namespace std::chrono_literals;
+
+using common::Hash256;
+using testing::Invoke;
+using Topic = GossipCache::Topic;
+
+class GossipCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ON_CALL(*clock_, now()).WillByDefault(Invoke([this] { return now_; }));
+    cache_ = std::make_unique<GossipCache>(clock_, 3, 10s);
+  }
+
+  static Hash256 hash(uint8_t i) {
+    Hash256 hash;
+    hash.fill(i);
+    return hash;
+  }
+
+  std::shared_ptr<clock::SteadyClockMock> clock_ =
+      std::make_shared<testing::NiceMock<clock::SteadyClockMock>>();
+  clock::SteadyClock::TimePoint now_{};
+  std::unique_ptr<GossipCache> cache_;
+};
+
+/**
+ * @given empty cache
+ * @when a hash is inserted
+ * @then it is known, and another one is not
+ */
+TEST_F(GossipCacheTest, Insert) {
+  EXPECT_FALSE(cache_->isKnown(hash(1)));
+  cache_->insert(hash(1));
+  EXPECT_TRUE(cache_->isKnown(hash(1)));
+  EXPECT_FALSE(cache_->isKnown(hash(2)));
+}
+
+/**
+ * @given cache with a hash inserted
+ * @when the period of time passes
+ * @then the hash is forgotten
+ */
+TEST_F(GossipCacheTest, ExpiresInTime) {
+  cache_->insert(hash(1));
+  now_ += 5s;
+  cache_->insert(hash(2));
+  now_ += 5s;
+  EXPECT_FALSE(cache_->isKnown(hash(1)));
+  EXPECT_TRUE(cache_->isKnown(hash(2)));
+  EXPECT_EQ(cache_->size(), 1);
+}
+
+/**
+ * @given cache of the full capacity
+ * @when another hash is inserted
+ * @then the oldest one is forgotten
+ */
+TEST_F(GossipCacheTest, Capacity) {
+  for (uint8_t i = 1; i <= 4; ++i) {
+    cache_->insert(hash(i));
+  }
+  EXPECT_EQ(cache_->size(), 3);
+  EXPECT_FALSE(cache_->isKnown(hash(1)));
+  for (uint8_t i = 2; i <= 4; ++i) {
+    EXPECT_TRUE(cache_->isKnown(hash(i)));
+  }
+}
+
+/**
+ * @given cache with the hashes tied to the rounds and the blocks
+ * @when the rounds below one are expired
+ * @then the hashes of only those rounds are forgotten, and a hash of an
+ * expired round is not tied to it
+ */
+TEST_F(GossipCacheTest, ExpiresWithTopic) {
+  cache_->insert(hash(1), Topic::GRANDPA_ROUND, 1);
+  cache_->insert(hash(2), Topic::GRANDPA_ROUND, 2);
+  cache_->insert(hash(3), Topic::BLOCK_NUMBER, 1);
+
+  cache_->expireBelow(Topic::GRANDPA_ROUND, 2);
+  EXPECT_FALSE(cache_->isKnown(hash(1)));
+  EXPECT_TRUE(cache_->isKnown(hash(2)));
+  EXPECT_TRUE(cache_->isKnown(hash(3)));
+
+  cache_->insert(hash(4), Topic::GRANDPA_ROUND, 1);
+  cache_->expireBelow(Topic::GRANDPA_ROUND, 3);
+  EXPECT_FALSE(cache_->isKnown(hash(2)));
+  EXPECT_TRUE(cache_->isKnown(hash(4)));
+}
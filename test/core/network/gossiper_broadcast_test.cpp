@@ -0,0 +1,474 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/gossiper_broadcast.hpp"
+
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <libp2p/multi/uvarint.hpp>
+
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/clock/clock_mock.hpp"
+#include "mock/core/clock/timer_mock.hpp"
+#include "mock/libp2p/connection/stream_mock.hpp"
+#include "mock/libp2p/host/host_mock.hpp"
+#include "network/common.hpp"
+
+using namespace kagome;
+using namespace network;
+using namespace std::chrono_literals;
+
+using kagome::primitives::Extrinsic;
+using libp2p::HostMock;
+using libp2p::connection::Stream;
+using libp2p::connection::StreamMock;
+using libp2p::peer::PeerId;
+using libp2p::peer::PeerInfo;
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+using testutil::TimerMock;
+
+class GossiperBroadcastTest : public testing::Test {
+ public:
+  /// write to a stream, which is completed by the test
+  struct Write {
+    std::vector<uint8_t> bytes;
+    /// tells the messages shared by the streams
+    const uint8_t *data;
+    Stream::WriteCallbackFunc cb;
+  };
+
+  /// peer of the gossiper with its stream, which holds the writes
+  struct Peer {
+    PeerId id;
+    std::shared_ptr<StreamMock> stream =
+        std::make_shared<NiceMock<StreamMock>>();
+    std::vector<Write> writes{};
+    size_t resets = 0;
+  };
+
+  void SetUp() override {
+    ON_CALL(host_, getId()).WillByDefault(Return(own_id_));
+    ON_CALL(*clock_, now()).WillByDefault(Invoke([this] { return now_; }));
+    auto timer = std::make_unique<NiceMock<TimerMock>>();
+    timer_ = timer.get();
+    ON_CALL(*timer_, asyncWait(_)).WillByDefault(SaveArg<0>(&timer_handler_));
+    ON_CALL(host_, newStream(_, _, _))
+        .WillByDefault(Invoke([this](const PeerInfo &,
+                                     const libp2p::peer::Protocol &,
+                                     const libp2p::Host::StreamResultHandler
+                                         &handler) {
+          opening_.push_back(handler);
+        }));
+    gossiper_ = std::make_shared<GossiperBroadcast>(
+        host_, std::move(timer), clock_, hasher_);
+  }
+
+  static PeerId makePeerId(uint8_t index) {
+    std::vector<uint8_t> key(32, index);
+    return PeerId::fromPublicKey(libp2p::crypto::ProtobufKey{std::move(key)})
+        .value();
+  }
+
+  /// Makes the peer with the open stream, which records the writes to it
+  std::unique_ptr<Peer> makePeer(PeerId id) {
+    auto peer = std::make_unique<Peer>(Peer{std::move(id)});
+    ON_CALL(*peer->stream, isClosed()).WillByDefault(Return(false));
+    ON_CALL(*peer->stream, remotePeerId()).WillByDefault(Return(peer->id));
+    ON_CALL(*peer->stream, reset()).WillByDefault(Invoke([raw{peer.get()}] {
+      ++raw->resets;
+    }));
+    ON_CALL(*peer->stream, write(_, _, _))
+        .WillByDefault(Invoke([raw{peer.get()}](gsl::span<const uint8_t> bytes,
+                                                size_t,
+                                                Stream::WriteCallbackFunc cb) {
+          raw->writes.push_back(
+              {{bytes.begin(), bytes.end()}, bytes.data(), std::move(cb)});
+        }));
+    return peer;
+  }
+
+  /// Makes the peer, which opened the stream to the gossiper
+  std::unique_ptr<Peer> addPeer(uint8_t index) {
+    auto peer = makePeer(makePeerId(index));
+    gossiper_->addStream(peer->stream);
+    return peer;
+  }
+
+  /// Makes the reserved peer, the stream to which is opened by the gossiper
+  std::unique_ptr<Peer> reservePeer(uint8_t index) {
+    auto peer = makePeer(makePeerId(index));
+    gossiper_->reserveStream({peer->id, {}}, nullptr);
+    return peer;
+  }
+
+  /// Completes the \arg index opening of a stream by the gossiper
+  void opened(size_t index,
+              outcome::result<std::shared_ptr<Stream>> stream_res) {
+    opening_.at(index)(std::move(stream_res));
+  }
+
+  /// Fails the \arg index opening of a stream by the gossiper
+  void failed(size_t index) {
+    opened(index, outcome::failure(boost::system::error_code{}));
+  }
+
+  /// Completes the \arg index write to the stream of \arg peer
+  static void complete(Peer &peer, size_t index) {
+    auto &write = peer.writes.at(index);
+    write.cb(write.bytes.size());
+  }
+
+  /// Fires the timer of the batch of the announced extrinsics
+  void flush() {
+    ASSERT_TRUE(timer_handler_);
+    auto handler = std::move(timer_handler_);
+    timer_handler_ = nullptr;
+    handler({});
+  }
+
+  static Extrinsic makeExtrinsic(uint8_t byte, size_t size = 8) {
+    return Extrinsic{common::Buffer(size, byte)};
+  }
+
+  /// Announces \arg extrinsic and sends it at once
+  void sendTransaction(const Extrinsic &extrinsic) {
+    gossiper_->transactionAnnounce({{extrinsic}});
+    flush();
+  }
+
+  static consensus::grandpa::VoteMessage makeVote(
+      consensus::grandpa::RoundNumber round) {
+    consensus::grandpa::VoteMessage vote;
+    vote.round_number = round;
+    return vote;
+  }
+
+  /// Decodes the message written to a stream, as the router does
+  static GossipMessage decode(const Write &write) {
+    auto length = libp2p::multi::UVarint::create(write.bytes);
+    EXPECT_TRUE(length);
+    return scale::decode<GossipMessage>(
+               gsl::make_span(write.bytes).subspan(length->size()))
+        .value();
+  }
+
+  static std::vector<Extrinsic> extrinsics(const Write &write) {
+    auto msg = decode(write);
+    EXPECT_EQ(msg.type, GossipMessage::Type::TRANSACTIONS);
+    return scale::decode<TransactionAnnounce>(msg.data).value().extrinsics;
+  }
+
+  NiceMock<HostMock> host_;
+  TimerMock *timer_ = nullptr;
+  std::function<void(const std::error_code &)> timer_handler_;
+  std::shared_ptr<clock::SystemClockMock> clock_ =
+      std::make_shared<NiceMock<clock::SystemClockMock>>();
+  clock::SystemClock::TimePoint now_{};
+  std::shared_ptr<crypto::Hasher> hasher_ =
+      std::make_shared<crypto::HasherImpl>();
+  PeerId own_id_ = makePeerId(0);
+  std::vector<libp2p::Host::StreamResultHandler> opening_;
+  std::shared_ptr<GossiperBroadcast> gossiper_;
+};
+
+/**
+ * @given gossiper with two peers
+ * @when extrinsics are announced twice within the batch period
+ * @then nothing is written until the timer, armed once for the period, fires,
+ * and then each peer gets one message with all of them, which is shared by
+ * the peers, as they know none of them
+ */
+TEST_F(GossiperBroadcastTest, TransactionsBatchedPerFlush) {
+  auto a = addPeer(1);
+  auto b = addPeer(2);
+  auto x1 = makeExtrinsic(1);
+  auto x2 = makeExtrinsic(2);
+
+  EXPECT_CALL(*timer_, expiresAt(now_ + 200ms)).Times(1);
+  EXPECT_CALL(*timer_, asyncWait(_)).Times(1);
+  gossiper_->transactionAnnounce({{x1}});
+  gossiper_->transactionAnnounce({{x2}});
+  EXPECT_TRUE(a->writes.empty());
+  EXPECT_TRUE(b->writes.empty());
+
+  flush();
+  ASSERT_EQ(a->writes.size(), 1);
+  ASSERT_EQ(b->writes.size(), 1);
+  EXPECT_EQ(extrinsics(a->writes[0]), (std::vector<Extrinsic>{x1, x2}));
+  EXPECT_EQ(extrinsics(b->writes[0]), (std::vector<Extrinsic>{x1, x2}));
+  EXPECT_EQ(a->writes[0].data, b->writes[0].data);
+}
+
+/**
+ * @given gossiper with a peer, which sent an extrinsic, another peer and the
+ * stream of the own node
+ * @when the extrinsics are announced and then announced again
+ * @then the peers get only the extrinsics they do not know, the own node gets
+ * none, and the ones sent already are not sent again
+ */
+TEST_F(GossiperBroadcastTest, SkipsKnownTransactions) {
+  auto a = addPeer(1);
+  auto b = addPeer(2);
+  auto own = makePeer(own_id_);
+  gossiper_->addStream(own->stream);
+  auto x1 = makeExtrinsic(1);
+  auto x2 = makeExtrinsic(2);
+  gossiper_->transactionsReceived(a->id, {hasher_->blake2b_256(x1.data)});
+
+  gossiper_->transactionAnnounce({{x1, x2}});
+  flush();
+  ASSERT_EQ(a->writes.size(), 1);
+  ASSERT_EQ(b->writes.size(), 1);
+  EXPECT_EQ(extrinsics(a->writes[0]), (std::vector<Extrinsic>{x2}));
+  EXPECT_EQ(extrinsics(b->writes[0]), (std::vector<Extrinsic>{x1, x2}));
+  EXPECT_NE(a->writes[0].data, b->writes[0].data);
+  EXPECT_TRUE(own->writes.empty());
+  complete(*a, 0);
+  complete(*b, 0);
+
+  gossiper_->transactionAnnounce({{x1}});
+  flush();
+  EXPECT_EQ(a->writes.size(), 1);
+  EXPECT_EQ(b->writes.size(), 1);
+  EXPECT_TRUE(own->writes.empty());
+}
+
+/**
+ * @given gossiper with a peer
+ * @when the extrinsics are announced from several threads at once, as the RPC
+ * does
+ * @then the timer is armed once and the peer gets all of them in one message
+ */
+TEST_F(GossiperBroadcastTest, AnnouncedFromManyThreads) {
+  constexpr size_t kThreads = 4;
+  constexpr size_t kPerThread = 25;
+  auto a = addPeer(1);
+
+  EXPECT_CALL(*timer_, asyncWait(_)).Times(1);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < kPerThread; ++i) {
+        gossiper_->transactionAnnounce(
+            {{makeExtrinsic(static_cast<uint8_t>(t * kPerThread + i))}});
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  flush();
+  ASSERT_EQ(a->writes.size(), 1);
+  auto sent = extrinsics(a->writes[0]);
+  EXPECT_EQ(sent.size(), kThreads * kPerThread);
+  std::set<common::Buffer> unique;
+  for (auto &extrinsic : sent) {
+    unique.insert(extrinsic.data);
+  }
+  EXPECT_EQ(unique.size(), kThreads * kPerThread);
+}
+
+/**
+ * @given gossiper with a peer, the stream of which is writing an extrinsic
+ * @when the extrinsics, a block announce and a vote are sent meanwhile
+ * @then they are written one at a time, the vote first, then the block
+ * announce and the extrinsics
+ */
+TEST_F(GossiperBroadcastTest, ConsensusWrittenFirst) {
+  auto a = addPeer(1);
+  sendTransaction(makeExtrinsic(1));
+  ASSERT_EQ(a->writes.size(), 1);
+
+  sendTransaction(makeExtrinsic(2));
+  gossiper_->blockAnnounce(BlockAnnounce{});
+  gossiper_->vote(makeVote(1));
+  ASSERT_EQ(a->writes.size(), 1);
+
+  std::vector<GossipMessage::Type> types;
+  for (size_t i = 0; i < 3; ++i) {
+    complete(*a, i);
+    ASSERT_EQ(a->writes.size(), i + 2);
+    types.push_back(decode(a->writes.back()).type);
+  }
+  complete(*a, 3);
+  EXPECT_EQ(a->writes.size(), 4);
+  EXPECT_EQ(types,
+            (std::vector<GossipMessage::Type>{
+                GossipMessage::Type::CONSENSUS,
+                GossipMessage::Type::BLOCK_ANNOUNCE,
+                GossipMessage::Type::TRANSACTIONS}));
+}
+
+/**
+ * @given gossiper with a peer, the stream of which is writing an extrinsic of
+ * a megabyte, and three more of them queued, up to the limit of 4 MiB
+ * @when one more is sent
+ * @then the oldest queued one is dropped, and the rest are written in order
+ */
+TEST_F(GossiperBroadcastTest, DropsOldestOverLimit) {
+  constexpr size_t kSize = 1000000;
+  auto a = addPeer(1);
+  for (uint8_t i = 0; i < 5; ++i) {
+    sendTransaction(makeExtrinsic(i, kSize));
+  }
+  ASSERT_EQ(a->writes.size(), 1);
+
+  for (size_t i = 0; i < 4; ++i) {
+    complete(*a, i);
+  }
+  ASSERT_EQ(a->writes.size(), 4);
+  std::vector<uint8_t> written;
+  for (auto &write : a->writes) {
+    auto sent = extrinsics(write);
+    ASSERT_EQ(sent.size(), 1);
+    written.push_back(sent[0].data[0]);
+  }
+  EXPECT_EQ(written, (std::vector<uint8_t>{0, 2, 3, 4}));
+  EXPECT_EQ(a->resets, 0);
+}
+
+/**
+ * @given gossiper with a peer, the stream of which is writing a vote
+ * @when the write takes longer than kStalledWriteTimeout and more votes are
+ * sent
+ * @then the stream is reset once, and nothing else is written to it
+ */
+TEST_F(GossiperBroadcastTest, ResetsStalledStream) {
+  auto a = addPeer(1);
+  gossiper_->vote(makeVote(1));
+  ASSERT_EQ(a->writes.size(), 1);
+
+  now_ += GossiperBroadcast::kStalledWriteTimeout;
+  gossiper_->vote(makeVote(2));
+  EXPECT_EQ(a->resets, 0);
+
+  now_ += 1ms;
+  gossiper_->vote(makeVote(3));
+  EXPECT_EQ(a->resets, 1);
+
+  complete(*a, 0);
+  gossiper_->vote(makeVote(4));
+  EXPECT_EQ(a->resets, 1);
+  EXPECT_EQ(a->writes.size(), 1);
+}
+
+/**
+ * @given gossiper with a peer, the stream of which is writing a message of
+ * almost the queue limit
+ * @when a vote is sent, which does not fit, and then another one
+ * @then the first one is queued anyway, and the stream is reset on the
+ * second one, as it does not take the consensus messages
+ */
+TEST_F(GossiperBroadcastTest, ResetsWhenConsensusBacksUp) {
+  auto a = addPeer(1);
+  sendTransaction(
+      makeExtrinsic(1, GossiperBroadcast::kMaxQueuedBytes - 100));
+  ASSERT_EQ(a->writes.size(), 1);
+
+  gossiper_->vote(makeVote(1));
+  EXPECT_EQ(a->resets, 0);
+
+  gossiper_->vote(makeVote(2));
+  EXPECT_EQ(a->resets, 1);
+  EXPECT_EQ(a->writes.size(), 1);
+}
+
+/**
+ * @given gossiper with a reserved peer without a stream
+ * @when a vote, a block announce and an extrinsic are sent before the stream
+ * to the peer is opened
+ * @then the stream is opened once, and the messages are written to it after
+ * it is opened, by their priorities
+ */
+TEST_F(GossiperBroadcastTest, OpensReservedStreamOnce) {
+  auto r = reservePeer(1);
+  EXPECT_CALL(host_, newStream(PeerInfo{r->id, {}}, kGossipProtocol, _))
+      .Times(1);
+
+  gossiper_->vote(makeVote(1));
+  gossiper_->blockAnnounce(BlockAnnounce{});
+  sendTransaction(makeExtrinsic(1));
+  ASSERT_EQ(opening_.size(), 1);
+  EXPECT_TRUE(r->writes.empty());
+
+  opened(0, r->stream);
+  ASSERT_EQ(r->writes.size(), 1);
+  complete(*r, 0);
+  complete(*r, 1);
+  complete(*r, 2);
+  ASSERT_EQ(r->writes.size(), 3);
+  EXPECT_EQ(decode(r->writes[0]).type, GossipMessage::Type::CONSENSUS);
+  EXPECT_EQ(decode(r->writes[1]).type, GossipMessage::Type::BLOCK_ANNOUNCE);
+  EXPECT_EQ(decode(r->writes[2]).type, GossipMessage::Type::TRANSACTIONS);
+
+  gossiper_->vote(makeVote(2));
+  EXPECT_EQ(r->writes.size(), 4);
+  EXPECT_EQ(opening_.size(), 1);
+}
+
+/**
+ * @given gossiper with a reserved peer, the stream to which fails to be opened
+ * @when the messages are sent to it over time
+ * @then the stream is not reopened until the backoff passes, which doubles
+ * from kMinReconnectBackoff on every failure up to kMaxReconnectBackoff
+ */
+TEST_F(GossiperBroadcastTest, ReconnectBackoffDoubles) {
+  auto r = reservePeer(1);
+  gossiper_->vote(makeVote(0));
+  ASSERT_EQ(opening_.size(), 1);
+
+  for (auto backoff : {1s, 2s, 4s, 8s, 16s, 32s, 60s, 60s}) {
+    auto attempts = opening_.size();
+    failed(attempts - 1);
+
+    now_ += backoff - 1ms;
+    gossiper_->vote(makeVote(1));
+    EXPECT_EQ(opening_.size(), attempts);
+
+    now_ += 1ms;
+    gossiper_->vote(makeVote(2));
+    ASSERT_EQ(opening_.size(), attempts + 1);
+  }
+  EXPECT_TRUE(r->writes.empty());
+}
+
+/**
+ * @given gossiper with a reserved peer, the stream to which failed to be
+ * opened twice and then was opened
+ * @when the stream is closed and fails to be reopened
+ * @then the next attempt is after kMinReconnectBackoff again
+ */
+TEST_F(GossiperBroadcastTest, BackoffResetAfterOpen) {
+  auto r = reservePeer(1);
+  gossiper_->vote(makeVote(0));
+  failed(0);
+  now_ += 1s;
+  gossiper_->vote(makeVote(1));
+  failed(1);
+  now_ += 2s;
+  gossiper_->vote(makeVote(2));
+  ASSERT_EQ(opening_.size(), 3);
+  opened(2, r->stream);
+  ASSERT_EQ(r->writes.size(), 1);
+
+  ON_CALL(*r->stream, isClosed()).WillByDefault(Return(true));
+  gossiper_->vote(makeVote(3));
+  ASSERT_EQ(opening_.size(), 4);
+  failed(3);
+
+  now_ += 1s - 1ms;
+  gossiper_->vote(makeVote(4));
+  EXPECT_EQ(opening_.size(), 4);
+  now_ += 1ms;
+  gossiper_->vote(makeVote(5));
+  EXPECT_EQ(opening_.size(), 5);
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/grandpa_neighbors.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace kagome;
+using namespace network;
+
+using consensus::grandpa::NeighborPacket;
+using libp2p::peer::PeerId;
+
+class GrandpaNeighborsTest : public testing::Test {
+ public:
+  GrandpaNeighbors neighbors_;
+
+  PeerId peer_ =
+      PeerId::fromBase58("QmWfTgC2DEt9FhPoccnh5vT5xM5wqWy37EnAPZFQgqheZ6")
+          .value();
+  PeerId unknown_ =
+      PeerId::fromBase58("QmSk9bURVnsYFMN4nmeVxDk6Q1Fse4FEXXp6KLAKBNU3rj")
+          .value();
+};
+
+/**
+ * @given a peer, which has sent its neighbor packet, and a peer, which has
+ * not
+ * @when checking if the votes and the fins are useful to them
+ * @then only the votes of the same set and at most a round apart from the
+ * round of the peer and the fins of the blocks it has not finalized are
+ * useful to it, while everything is useful to the other peer and to the
+ * peer of an incoming stream
+ */
+TEST_F(GrandpaNeighborsTest, FiltersByPeerRound) {
+  neighbors_.update(peer_,
+                    NeighborPacket{
+                        .round_number = 10, .set_id = 1, .last_finalized = 50});
+
+  EXPECT_FALSE(neighbors_.isVoteUseful(peer_, 8, 1));
+  EXPECT_TRUE(neighbors_.isVoteUseful(peer_, 9, 1));
+  EXPECT_TRUE(neighbors_.isVoteUseful(peer_, 10, 1));
+  EXPECT_TRUE(neighbors_.isVoteUseful(peer_, 11, 1));
+  EXPECT_FALSE(neighbors_.isVoteUseful(peer_, 12, 1));
+  EXPECT_FALSE(neighbors_.isVoteUseful(peer_, 10, 2));
+  EXPECT_FALSE(neighbors_.isFinUseful(peer_, 50));
+  EXPECT_TRUE(neighbors_.isFinUseful(peer_, 51));
+
+  EXPECT_TRUE(neighbors_.isVoteUseful(unknown_, 1, 0));
+  EXPECT_TRUE(neighbors_.isFinUseful(unknown_, 1));
+  EXPECT_TRUE(neighbors_.isVoteUseful(boost::none, 1, 0));
+
+  // a packet of an earlier round comes late
+  neighbors_.update(peer_,
+                    NeighborPacket{
+                        .round_number = 5, .set_id = 1, .last_finalized = 40});
+  EXPECT_TRUE(neighbors_.isVoteUseful(peer_, 10, 1));
+
+  // the rounds start over with a new set
+  neighbors_.update(peer_,
+                    NeighborPacket{
+                        .round_number = 1, .set_id = 2, .last_finalized = 60});
+  EXPECT_TRUE(neighbors_.isVoteUseful(peer_, 1, 2));
+}
+
+/**
+ * @given neighbors, which are not told the round of this node
+ * @when it is told
+ * @then the messages of the rounds at most a round apart from it are useful
+ * to this node, while any round is before
+ */
+TEST_F(GrandpaNeighborsTest, FiltersByOwnRound) {
+  EXPECT_TRUE(neighbors_.isRoundUseful(100));
+
+  neighbors_.updateOwn(
+      NeighborPacket{.round_number = 10, .set_id = 1, .last_finalized = 50});
+  EXPECT_FALSE(neighbors_.isRoundUseful(8));
+  EXPECT_TRUE(neighbors_.isRoundUseful(9));
+  EXPECT_TRUE(neighbors_.isRoundUseful(11));
+  EXPECT_FALSE(neighbors_.isRoundUseful(100));
+}
@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/light_protocol_observer_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "blockchain/block_tree_error.hpp"
+#include "crypto/hasher/hasher_impl.hpp"
+#include "mock/core/blockchain/block_header_repository_mock.hpp"
+#include "mock/core/runtime/raw_call_mock.hpp"
+#include "mock/core/storage/trie/trie_storage_mock.hpp"
+#include "runtime/common/storage_wasm_provider.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using namespace kagome;
+using namespace network;
+
+using blockchain::BlockHeaderRepositoryMock;
+using blockchain::BlockTreeError;
+using common::Buffer;
+using primitives::BlockHeader;
+using runtime::RawCallMock;
+using storage::trie::TrieStorageMock;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class LightProtocolObserverTest : public testing::Test {
+ public:
+  void SetUp() override {
+    block_hash_.fill(1);
+    header_.number = 42;
+    header_.state_root.fill(2);
+    ON_CALL(*headers_, getBlockHeader(primitives::BlockId{block_hash_}))
+        .WillByDefault(Return(header_));
+    ON_CALL(*headers_, getBlockHeader(primitives::BlockId{header_.number}))
+        .WillByDefault(Return(header_));
+  }
+
+  std::shared_ptr<BlockHeaderRepositoryMock> headers_ =
+      std::make_shared<BlockHeaderRepositoryMock>();
+  std::shared_ptr<TrieStorageMock> trie_storage_ =
+      std::make_shared<TrieStorageMock>();
+  std::shared_ptr<RawCallMock> raw_call_ = std::make_shared<RawCallMock>();
+  std::shared_ptr<LightProtocolObserverImpl> observer_ =
+      std::make_shared<LightProtocolObserverImpl>(
+          headers_,
+          trie_storage_,
+          raw_call_,
+          std::make_shared<crypto::HasherImpl>());
+
+  primitives::BlockHash block_hash_;
+  BlockHeader header_;
+  std::vector<Buffer> proof_{"node1"_buf, "node2"_buf};
+};
+
+/**
+ * @given a read request
+ * @when it is requested twice under different ids
+ * @then the proof is recorded once, and both responses carry it along with
+ * the ids of their requests
+ */
+TEST_F(LightProtocolObserverTest, ReadProofIsKept) {
+  EXPECT_CALL(*trie_storage_, getProofAt(header_.state_root, _))
+      .WillOnce(Return(proof_));
+  RemoteReadRequest read{block_hash_, {"key"_buf}};
+
+  EXPECT_OUTCOME_TRUE(first, observer_->onLightRequest(LightRequest{1, read}));
+  EXPECT_OUTCOME_TRUE(second, observer_->onLightRequest(LightRequest{2, read}));
+  ASSERT_EQ(first.id, 1);
+  ASSERT_EQ(second.id, 2);
+  ASSERT_EQ(boost::get<RemoteReadResponse>(first.response).proof, proof_);
+  ASSERT_EQ(boost::get<RemoteReadResponse>(second.response).proof, proof_);
+  ASSERT_EQ(observer_->cachedBytes(), 10);
+}
+
+/**
+ * @given a read request of more keys than are proved at once
+ * @when it is requested
+ * @then it is rejected without reading the state
+ */
+TEST_F(LightProtocolObserverTest, TooManyKeys) {
+  EXPECT_CALL(*trie_storage_, getProofAt(_, _)).Times(0);
+  RemoteReadRequest read{
+      block_hash_,
+      std::vector<Buffer>(LightProtocolObserverImpl::kMaxRequestKeys + 1,
+                          "key"_buf)};
+  EXPECT_OUTCOME_ERROR(res,
+                       observer_->onLightRequest(LightRequest{1, read}),
+                       LightProtocolObserverImpl::Error::TOO_MANY_KEYS);
+}
+
+/**
+ * @given a call request
+ * @when it is requested
+ * @then the response carries the result of the call and the proof of the
+ * keys it accessed along with the runtime code
+ */
+TEST_F(LightProtocolObserverTest, CallProvesAccessedKeysAndCode) {
+  EXPECT_CALL(*raw_call_, callAt(header_.state_root, _, _, _))
+      .WillOnce(Invoke([](auto &, auto method, auto args, auto &accessed) {
+        EXPECT_EQ(method, "Core_version");
+        EXPECT_EQ(Buffer{args}, "args"_buf);
+        accessed.push_back("accessed"_buf);
+        return "result"_buf;
+      }));
+  EXPECT_CALL(*trie_storage_, getProofAt(header_.state_root, _))
+      .WillOnce(Invoke([this](auto &, auto keys) {
+        EXPECT_EQ(std::vector<Buffer>(keys.begin(), keys.end()),
+                  (std::vector<Buffer>{"accessed"_buf, runtime::kRuntimeKey}));
+        return proof_;
+      }));
+
+  EXPECT_OUTCOME_TRUE(
+      response,
+      observer_->onLightRequest(LightRequest{
+          7, RemoteCallRequest{block_hash_, "Core_version", "args"_buf}}));
+  ASSERT_EQ(response.id, 7);
+  auto &call = boost::get<RemoteCallResponse>(response.response);
+  ASSERT_EQ(call.result, "result"_buf);
+  ASSERT_EQ(call.proof, proof_);
+}
+
+/**
+ * @given header requests of a known and of an unknown block
+ * @when they are requested
+ * @then the header is answered for the known one and none for the other
+ */
+TEST_F(LightProtocolObserverTest, Header) {
+  EXPECT_CALL(*headers_, getBlockHeader(primitives::BlockId{header_.number}));
+  EXPECT_CALL(*headers_, getBlockHeader(primitives::BlockId{header_.number + 1}))
+      .WillOnce(Return(BlockTreeError::NO_SUCH_BLOCK));
+
+  EXPECT_OUTCOME_TRUE(
+      known,
+      observer_->onLightRequest(
+          LightRequest{1, RemoteHeaderRequest{header_.number}}));
+  ASSERT_EQ(boost::get<RemoteHeaderResponse>(known.response).header, header_);
+
+  EXPECT_OUTCOME_TRUE(
+      unknown,
+      observer_->onLightRequest(
+          LightRequest{2, RemoteHeaderRequest{header_.number + 1}}));
+  ASSERT_FALSE(boost::get<RemoteHeaderResponse>(unknown.response).header);
+  ASSERT_EQ(observer_->cachedBytes(), 0);
+}
@@ -0,0 +1,53 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/loopback_channel.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace kagome;
+using namespace network;
+
+using consensus::grandpa::VoteMessage;
+
+class LoopbackChannelTest : public testing::Test {
+ public:
+  std::shared_ptr<boost::asio::io_context> io_context_ =
+      std::make_shared<boost::asio::io_context>();
+  LoopbackChannel channel_{io_context_};
+};
+
+/**
+ * @given a loopback channel with a handler
+ * @when a vote is sent to it
+ * @then the handler receives the very object sent, once the io context runs
+ */
+TEST_F(LoopbackChannelTest, PassesMessage) {
+  std::vector<std::shared_ptr<const LoopbackChannel::Message>> received;
+  channel_.setHandler([&](const auto &msg) { received.push_back(msg); });
+  ASSERT_TRUE(channel_.isBound());
+
+  auto sent = std::make_shared<const LoopbackChannel::Message>(
+      VoteMessage{.round_number = 3, .counter = 1});
+  channel_.send(sent);
+  ASSERT_TRUE(received.empty());
+
+  io_context_->run();
+  ASSERT_EQ(received.size(), 1);
+  ASSERT_EQ(received[0], sent);
+  ASSERT_EQ(boost::get<VoteMessage>(*received[0]).round_number, 3);
+}
+
+/**
+ * @given a loopback channel without a handler
+ * @when a vote is sent to it
+ * @then it is not bound and nothing is posted to the io context
+ */
+TEST_F(LoopbackChannelTest, DropsWithoutHandler) {
+  ASSERT_FALSE(channel_.isBound());
+  channel_.send(std::make_shared<const LoopbackChannel::Message>(
+      VoteMessage{.round_number = 3, .counter = 1}));
+  ASSERT_EQ(io_context_->run(), 0);
+}
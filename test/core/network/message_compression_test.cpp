@@ -0,0 +1,83 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/helpers/message_compression.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "testutil/outcome.hpp"
+
+using kagome::network::MessageCompression;
+using kagome::network::MessageCompressionError;
+
+/**
+ * @given a large message of repetitive bytes
+ * @when it is compressed
+ * @then the frame is a smaller zstd one, which is decompressed to the message
+ */
+TEST(MessageCompressionTest, CompressesRepetitiveMessage) {
+  std::vector<uint8_t> message;
+  for (auto i = 0; i < 1000; ++i) {
+    message.insert(message.end(), {1, 2, 3, 4, 5, 6, 7, 8});
+  }
+  auto frame = MessageCompression::compress(message);
+  ASSERT_EQ(frame[0], MessageCompression::kZstd);
+  ASSERT_LT(frame.size(), message.size());
+  EXPECT_OUTCOME_TRUE(decompressed, MessageCompression::decompress(frame));
+  ASSERT_EQ(decompressed, message);
+}
+
+/**
+ * @given a small message and a large one of random bytes, which are not
+ * compressed well, like the ones of already compressed data
+ * @when they are compressed
+ * @then the frames keep them as they are
+ */
+TEST(MessageCompressionTest, KeepsSmallAndIncompressibleMessages) {
+  std::mt19937 random;
+  std::vector<uint8_t> noise(MessageCompression::kMinCompressedSize * 4);
+  for (auto &byte : noise) {
+    byte = random();
+  }
+  for (auto &message : {std::vector<uint8_t>(10, 0), noise}) {
+    auto frame = MessageCompression::compress(message);
+    ASSERT_EQ(frame[0], MessageCompression::kRaw);
+    ASSERT_EQ(frame.size(), message.size() + 1);
+    EXPECT_OUTCOME_TRUE(decompressed, MessageCompression::decompress(frame));
+    ASSERT_EQ(decompressed, message);
+  }
+}
+
+/**
+ * @given frames of an unknown kind, of a corrupted zstd frame and of a
+ * message larger than the limit
+ * @when they are decompressed
+ * @then they are rejected
+ */
+TEST(MessageCompressionTest, RejectsInvalidFrames) {
+  EXPECT_OUTCOME_ERROR(empty,
+                       MessageCompression::decompress({}),
+                       MessageCompressionError::INVALID_FRAME);
+  std::vector<uint8_t> unknown{2, 1, 2, 3};
+  EXPECT_OUTCOME_ERROR(unknown_res,
+                       MessageCompression::decompress(unknown),
+                       MessageCompressionError::INVALID_FRAME);
+
+  auto frame = MessageCompression::compress(std::vector<uint8_t>(1000, 7));
+  ASSERT_EQ(frame[0], MessageCompression::kZstd);
+  auto truncated = frame;
+  truncated.resize(truncated.size() - 2);
+  EXPECT_OUTCOME_ERROR(truncated_res,
+                       MessageCompression::decompress(truncated),
+                       MessageCompressionError::DECOMPRESSION_FAILED);
+
+  auto large = MessageCompression::compress(
+      std::vector<uint8_t>(MessageCompression::kMaxMessageSize + 1, 0));
+  EXPECT_OUTCOME_ERROR(large_res,
+                       MessageCompression::decompress(large),
+                       MessageCompressionError::TOO_LARGE);
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/network_metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include "network/types/blocks_request.hpp"
+
+using namespace kagome;
+using namespace network;
+using namespace std::chrono_literals;
+
+class NetworkMetricsTest : public testing::Test {
+ public:
+  NetworkMetrics metrics_;
+};
+
+/**
+ * @given network metrics
+ * @when the messages of the different protocols and types are sent and
+ * received
+ * @then they are reported by the protocols and the types, with the times of
+ * their encoding and decoding
+ */
+TEST_F(NetworkMetricsTest, Traffic) {
+  metrics_.recordReceived("/sync", "BlocksRequest", 10);
+  metrics_.recordReceived("/sync", "BlocksRequest", 20);
+  metrics_.recordDecoding("/sync", "BlocksRequest", 3us);
+  metrics_.recordSent("/sync", "BlocksResponse", 1000);
+  metrics_.recordEncoding("/sync", "BlocksResponse", 5us);
+  metrics_.recordSent("/gossip", "CONSENSUS", 100);
+
+  auto report = metrics_.report();
+  ASSERT_EQ(report.messages.size(), 2);
+  auto &sync = report.messages["/sync"];
+  ASSERT_EQ(sync.size(), 2);
+  auto &request = sync["BlocksRequest"];
+  EXPECT_EQ(request.received.messages, 2);
+  EXPECT_EQ(request.received.bytes, 30);
+  EXPECT_EQ(request.sent.messages, 0);
+  EXPECT_EQ(request.decoding.calls, 1);
+  EXPECT_EQ(request.decoding.max, 3us);
+  auto &response = sync["BlocksResponse"];
+  EXPECT_EQ(response.sent.messages, 1);
+  EXPECT_EQ(response.sent.bytes, 1000);
+  EXPECT_EQ(response.encoding.calls, 1);
+  EXPECT_EQ(report.messages["/gossip"]["CONSENSUS"].sent.bytes, 100);
+
+  metrics_.reset();
+  EXPECT_TRUE(metrics_.report().messages.empty());
+}
+
+/**
+ * @given network metrics
+ * @when the depths of the queues of the peers change
+ * @then the last ones are reported, and the emptied queues are not, even
+ * after the reset
+ */
+TEST_F(NetworkMetricsTest, Queues) {
+  metrics_.recordQueue("peer1", 3, 300);
+  metrics_.recordQueue("peer2", 1, 10);
+  metrics_.recordQueue("peer1", 2, 200);
+  metrics_.recordQueue("peer2", 0, 0);
+  metrics_.reset();
+
+  auto report = metrics_.report();
+  ASSERT_EQ(report.queues.size(), 1);
+  EXPECT_EQ(report.queues["peer1"].messages, 2);
+  EXPECT_EQ(report.queues["peer1"].bytes, 200);
+}
+
+/**
+ * @given network metrics
+ * @when the round trips of the requests are recorded
+ * @then their histograms are reported by the names of the requests
+ */
+TEST_F(NetworkMetricsTest, RoundTrips) {
+  for (auto i = 1; i <= 100; ++i) {
+    metrics_.recordRoundTrip("requestBlocks", i * 1ms);
+  }
+  metrics_.recordRoundTrip("requestState", 1s);
+
+  auto report = metrics_.report();
+  ASSERT_EQ(report.round_trips.size(), 2);
+  auto &blocks = report.round_trips["requestBlocks"];
+  EXPECT_EQ(blocks.calls, 100);
+  EXPECT_EQ(blocks.max, 100ms);
+  EXPECT_LE(blocks.p99, blocks.max);
+  EXPECT_GE(blocks.p99, 99ms);
+  EXPECT_EQ(report.round_trips["requestState"].total, 1s);
+}
+
+/**
+ * @given message type
+ * @then it is recorded under its name without the namespaces
+ */
+TEST_F(NetworkMetricsTest, MessageTypeName) {
+  EXPECT_EQ(messageTypeName<BlocksRequest>(), "BlocksRequest");
+}
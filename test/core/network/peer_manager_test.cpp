@@ -0,0 +1,78 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/peer_manager_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/clock/clock_mock.hpp"
+
+using namespace kagome;
+using namespace network;
+using namespace std::chrono_literals;
+
+using libp2p::peer::PeerId;
+using testing::Invoke;
+
+class PeerManagerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ON_CALL(*clock_, now()).WillByDefault(Invoke([this] { return now_; }));
+  }
+
+  std::shared_ptr<clock::SteadyClockMock> clock_ =
+      std::make_shared<testing::NiceMock<clock::SteadyClockMock>>();
+  clock::SteadyClock::TimePoint now_{};
+  PeerManagerImpl peer_manager_{clock_};
+
+  PeerId fast_ =
+      PeerId::fromBase58("QmWfTgC2DEt9FhPoccnh5vT5xM5wqWy37EnAPZFQgqheZ6")
+          .value();
+  PeerId slow_ =
+      PeerId::fromBase58("QmSk9bURVnsYFMN4nmeVxDk6Q1Fse4FEXXp6KLAKBNU3rj")
+          .value();
+};
+
+/**
+ * @given peer manager
+ * @when two peers return the blocks at the different rates
+ * @then the faster one is scored higher, the failing one lower, and a peer
+ * not measured yet is scored the highest
+ */
+TEST_F(PeerManagerTest, ScoresByThroughput) {
+  peer_manager_.reportResponse(fast_, 10, 100ms);
+  peer_manager_.reportResponse(slow_, 10, 1s);
+  EXPECT_GT(peer_manager_.score(fast_), peer_manager_.score(slow_));
+
+  auto slow_score = peer_manager_.score(slow_);
+  peer_manager_.reportFailure(slow_);
+  EXPECT_LT(peer_manager_.score(slow_), slow_score);
+
+  auto unknown =
+      PeerId::fromBase58("QmRSGJxhSsZfChs3tWDD6qYBdUYxS8hSJpnBBw6LphZzAw")
+          .value();
+  EXPECT_GT(peer_manager_.score(unknown), peer_manager_.score(fast_));
+}
+
+/**
+ * @given peer manager
+ * @when a peer sends the invalid blocks
+ * @then it is banned once they reach the threshold, until the ban expires
+ */
+TEST_F(PeerManagerTest, BansForInvalidBlocks) {
+  peer_manager_.reportResponse(fast_, 10, 100ms);
+  for (size_t i = 1; i < PeerManagerImpl::kBanThreshold; ++i) {
+    peer_manager_.reportInvalidBlock(fast_);
+    EXPECT_FALSE(peer_manager_.isBanned(fast_));
+  }
+  peer_manager_.reportInvalidBlock(fast_);
+  EXPECT_TRUE(peer_manager_.isBanned(fast_));
+  EXPECT_EQ(peer_manager_.score(fast_), 0);
+  EXPECT_FALSE(peer_manager_.isBanned(slow_));
+
+  now_ += PeerManagerImpl::kBanDuration;
+  EXPECT_FALSE(peer_manager_.isBanned(fast_));
+  EXPECT_GT(peer_manager_.score(fast_), 0);
+}
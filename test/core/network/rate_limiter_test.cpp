@@ -0,0 +1,63 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/rate_limiter.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/clock/clock_mock.hpp"
+
+using namespace kagome;
+using namespace network;
+using namespace std::chrono_literals;
+
+using testing::Invoke;
+
+class RateLimiterTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ON_CALL(*clock_, now()).WillByDefault(Invoke([this] { return now_; }));
+  }
+
+  std::shared_ptr<clock::SteadyClockMock> clock_ =
+      std::make_shared<testing::NiceMock<clock::SteadyClockMock>>();
+  clock::SteadyClock::TimePoint now_{};
+  // 2 requests each second, up to 3 at once
+  RateLimiter<int> limiter_{clock_, 2, 3};
+};
+
+/**
+ * @given rate limiter
+ * @when a peer makes more requests at once than the burst
+ * @then the ones over the burst are not allowed, while the requests of
+ * another peer are
+ */
+TEST_F(RateLimiterTest, Burst) {
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(limiter_.allow(1));
+  }
+  EXPECT_FALSE(limiter_.allow(1));
+  EXPECT_TRUE(limiter_.allow(2));
+}
+
+/**
+ * @given rate limiter with the bucket of a peer emptied
+ * @when time passes
+ * @then the requests are allowed at the rate, up to the burst
+ */
+TEST_F(RateLimiterTest, Refill) {
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(limiter_.allow(1));
+  }
+  now_ += 500ms;
+  EXPECT_TRUE(limiter_.allow(1));
+  EXPECT_FALSE(limiter_.allow(1));
+
+  now_ += 10s;
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(limiter_.allow(1));
+  }
+  EXPECT_FALSE(limiter_.allow(1));
+}
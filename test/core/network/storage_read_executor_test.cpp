@@ -0,0 +1,94 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "network/impl/storage_read_executor.hpp"
+
+#include <atomic>
+#include <future>
+
+#include <gtest/gtest.h>
+
+using kagome::network::StorageReadExecutor;
+
+/**
+ * @given executor
+ * @when a task is posted
+ * @then it is run on another thread
+ */
+TEST(StorageReadExecutorTest, RunsTask) {
+  StorageReadExecutor executor{nullptr};
+  std::promise<std::thread::id> ran;
+  ASSERT_TRUE(
+      executor.post([&] { ran.set_value(std::this_thread::get_id()); }));
+  EXPECT_NE(ran.get_future().get(), std::this_thread::get_id());
+}
+
+/**
+ * @given executor, which threads are all busy
+ * @when more tasks are posted than the queue takes
+ * @then the ones over it are rejected, and the queued ones are run once the
+ * threads are free
+ */
+TEST(StorageReadExecutorTest, BoundedQueue) {
+  StorageReadExecutor executor{nullptr};
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic_size_t started = 0;
+  for (size_t i = 0; i < StorageReadExecutor::kThreads; ++i) {
+    ASSERT_TRUE(executor.post([&, released] {
+      ++started;
+      released.wait();
+    }));
+  }
+  // the threads take the blocking tasks first
+  while (started != StorageReadExecutor::kThreads) {
+    std::this_thread::yield();
+  }
+
+  std::atomic_size_t done = 0;
+  for (size_t i = 0; i < StorageReadExecutor::kMaxQueuedTasks; ++i) {
+    ASSERT_TRUE(executor.post([&] { ++done; }));
+  }
+  EXPECT_FALSE(executor.post([&] { ++done; }));
+
+  release.set_value();
+  while (done != StorageReadExecutor::kMaxQueuedTasks) {
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * @given executor with more threads than by default
+ * @when as many blocking tasks as its threads are posted
+ * @then they all run at once
+ */
+TEST(StorageReadExecutorTest, ThreadsNum) {
+  constexpr size_t kThreads = StorageReadExecutor::kThreads + 2;
+  StorageReadExecutor executor{nullptr, kThreads};
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  std::atomic_size_t started = 0;
+  for (size_t i = 0; i < kThreads; ++i) {
+    ASSERT_TRUE(executor.post([&, released] {
+      ++started;
+      released.wait();
+    }));
+  }
+  while (started != kThreads) {
+    std::this_thread::yield();
+  }
+  release.set_value();
+}
+
+/**
+ * @given stopped executor
+ * @when a task is posted
+ * @then it is rejected
+ */
+TEST(StorageReadExecutorTest, Stopped) {
+  StorageReadExecutor executor{nullptr};
+  executor.stop();
+  EXPECT_FALSE(executor.post([] {}));
+}
@@ -7,11 +7,15 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/optional.hpp>
 #include <functional>
 
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
+#include "mock/core/blockchain/block_storage_mock.hpp"
 #include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/storage/trie/trie_storage_backend_mock.hpp"
 #include "mock/libp2p/host/host_mock.hpp"
 #include "primitives/block.hpp"
 #include "testutil/gmock_actions.hpp"
@@ -28,6 +32,7 @@ using namespace libp2p;
 using namespace peer;
 
 using testing::_;
+using testing::Invoke;
 using testing::Ref;
 using testing::Return;
 using testing::ReturnRef;
@@ -110,3 +115,212 @@ TEST_F(SynchronizerTest, ProcessRequest) {
   ASSERT_EQ(received_blocks[1].body, block2_.body);
   ASSERT_FALSE(received_blocks[1].justification);
 }
+
+/**
+ * @given synchronizer with a block storage
+ * @when a request for blocks with their bodies arrives
+ * @then the data of the blocks is read from the storage at once, and the
+ * headers missing in it are taken from the header repository
+ */
+TEST_F(SynchronizerTest, ProcessRequestWithBlockStorage) {
+  auto storage = std::make_shared<BlockStorageMock>();
+  sync_protocol_observer_ =
+      std::make_shared<SyncProtocolObserverImpl>(tree_, headers_, storage);
+  BlocksRequest received_request{1,
+                                 BlocksRequest::kBasicAttributes,
+                                 block1_hash_,
+                                 boost::none,
+                                 Direction::DESCENDING,
+                                 boost::none};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
+  EXPECT_CALL(*headers_, getNumberByHash(block1_hash_))
+      .WillOnce(Return(block1_.header.number));
+  std::vector<BlockData> blocks_data{
+      {block1_hash_, block1_.header, block1_.body},
+      {block2_hash_, boost::none, block2_.body}};
+  EXPECT_CALL(*storage,
+              getBlockDataRange(std::vector<BlockInfo>{
+                  {block1_.header.number, block1_hash_},
+                  {block2_.header.number, block2_hash_}}))
+      .WillOnce(Return(blocks_data));
+  EXPECT_CALL(*headers_, getBlockHeader(BlockId{block2_hash_}))
+      .WillOnce(Return(block2_.header));
+
+  EXPECT_OUTCOME_TRUE(
+      response, sync_protocol_observer_->onBlocksRequest(received_request));
+
+  const auto &received_blocks = response.blocks;
+  ASSERT_EQ(received_blocks.size(), 2);
+  ASSERT_EQ(received_blocks[0].hash, block1_hash_);
+  ASSERT_EQ(received_blocks[0].header, block1_.header);
+  ASSERT_EQ(received_blocks[0].body, block1_.body);
+  ASSERT_FALSE(received_blocks[0].justification);
+  ASSERT_EQ(received_blocks[1].hash, block2_hash_);
+  ASSERT_EQ(received_blocks[1].header, block2_.header);
+  ASSERT_EQ(received_blocks[1].body, block2_.body);
+}
+
+/**
+ * @given synchronizer with a block storage
+ * @when a request for the blocks arrives, which first body is of the size of
+ * a response
+ * @then the response has only the first block
+ */
+TEST_F(SynchronizerTest, ProcessRequestOverResponseSize) {
+  auto storage = std::make_shared<BlockStorageMock>();
+  sync_protocol_observer_ =
+      std::make_shared<SyncProtocolObserverImpl>(tree_, headers_, storage);
+  BlocksRequest received_request{1,
+                                 BlocksRequest::kBasicAttributes,
+                                 block1_hash_,
+                                 boost::none,
+                                 Direction::DESCENDING,
+                                 boost::none};
+  BlockBody large_body{
+      Extrinsic{Buffer(SyncProtocolObserverImpl::maxResponseBytes, 0x11)}};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
+  EXPECT_CALL(*headers_, getNumberByHash(block1_hash_))
+      .WillOnce(Return(block1_.header.number));
+  std::vector<BlockData> blocks_data{
+      {block1_hash_, block1_.header, large_body},
+      {block2_hash_, block2_.header, block2_.body}};
+  EXPECT_CALL(*storage, getBlockDataRange(_)).WillOnce(Return(blocks_data));
+
+  EXPECT_OUTCOME_TRUE(
+      response, sync_protocol_observer_->onBlocksRequest(received_request));
+
+  ASSERT_EQ(response.blocks.size(), 1);
+  ASSERT_EQ(response.blocks[0].hash, block1_hash_);
+  ASSERT_EQ(response.blocks[0].body, large_body);
+}
+
+/**
+ * @given synchronizer with a block storage, which pruned the body of the
+ * second block
+ * @when a request for the blocks with their bodies arrives
+ * @then the response ends before the block without the body
+ */
+TEST_F(SynchronizerTest, ProcessRequestWithPrunedBody) {
+  auto storage = std::make_shared<BlockStorageMock>();
+  sync_protocol_observer_ =
+      std::make_shared<SyncProtocolObserverImpl>(tree_, headers_, storage);
+  BlocksRequest received_request{1,
+                                 BlocksRequest::kBasicAttributes,
+                                 block1_hash_,
+                                 boost::none,
+                                 Direction::DESCENDING,
+                                 boost::none};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_, block2_hash_}));
+  EXPECT_CALL(*headers_, getNumberByHash(block1_hash_))
+      .WillOnce(Return(block1_.header.number));
+  std::vector<BlockData> blocks_data{
+      {block1_hash_, block1_.header, block1_.body},
+      {block2_hash_, block2_.header, boost::none}};
+  EXPECT_CALL(*storage, getBlockDataRange(_)).WillOnce(Return(blocks_data));
+
+  EXPECT_OUTCOME_TRUE(
+      response, sync_protocol_observer_->onBlocksRequest(received_request));
+
+  ASSERT_EQ(response.blocks.size(), 1);
+  ASSERT_EQ(response.blocks[0].hash, block1_hash_);
+  ASSERT_EQ(response.blocks[0].body, block1_.body);
+}
+
+/**
+ * @given synchronizer
+ * @when a request for blocks limited by their number arrives
+ * @then no more than the number of the blocks are requested from the chain
+ */
+TEST_F(SynchronizerTest, ProcessRequestWithMax) {
+  BlocksRequest received_request{
+      1,
+      BlockAttributes{static_cast<uint8_t>(BlockAttributesBits::HEADER)},
+      block1_hash_,
+      boost::none,
+      Direction::DESCENDING,
+      1};
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 1))
+      .WillOnce(Return(std::vector<BlockHash>{block1_hash_}));
+  EXPECT_CALL(*headers_, getBlockHeader(BlockId{block1_hash_}))
+      .WillOnce(Return(block1_.header));
+
+  EXPECT_OUTCOME_TRUE(
+      response, sync_protocol_observer_->onBlocksRequest(received_request));
+
+  ASSERT_EQ(response.blocks.size(), 1);
+  ASSERT_EQ(response.blocks[0].header, block1_.header);
+}
+
+/**
+ * @given synchronizer with an executor reading the storage
+ * @when a request for blocks arrives
+ * @then the chain is found on the thread of the call, the data of the blocks
+ * is read on the executor, and the response is handled on the io context
+ */
+TEST_F(SynchronizerTest, ProcessRequestAsync) {
+  auto executor = std::make_shared<StorageReadExecutor>(nullptr);
+  auto io_context = std::make_shared<boost::asio::io_context>();
+  sync_protocol_observer_ = std::make_shared<SyncProtocolObserverImpl>(
+      tree_, headers_, nullptr, nullptr, executor, io_context);
+  BlocksRequest received_request{
+      1,
+      BlockAttributes{static_cast<uint8_t>(BlockAttributesBits::HEADER)},
+      block1_hash_,
+      boost::none,
+      Direction::DESCENDING,
+      boost::none};
+  auto caller = std::this_thread::get_id();
+
+  EXPECT_CALL(*tree_, getChainByBlock(block1_hash_, false, 128))
+      .WillOnce(Invoke([&](auto &&...) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        return std::vector<BlockHash>{block1_hash_};
+      }));
+  EXPECT_CALL(*headers_, getBlockHeader(BlockId{block1_hash_}))
+      .WillOnce(Invoke([&](auto &&) {
+        EXPECT_NE(std::this_thread::get_id(), caller);
+        return block1_.header;
+      }));
+
+  // keeps the io context waiting for the handler posted from the executor
+  auto work = boost::asio::make_work_guard(*io_context);
+  boost::optional<outcome::result<BlocksResponse>> response_res;
+  sync_protocol_observer_->onBlocksRequest(
+      received_request, [&](auto &&res) { response_res.emplace(res); });
+  io_context->run_one();
+
+  ASSERT_TRUE(response_res);
+  EXPECT_OUTCOME_TRUE(response, *response_res);
+  ASSERT_EQ(response.blocks.size(), 1);
+  ASSERT_EQ(response.blocks[0].header, block1_.header);
+}
+
+/**
+ * @given synchronizer with a storage of state nodes
+ * @when a request for the state nodes arrives
+ * @then the nodes are answered in the order of the keys up to the first one
+ * which is not in the storage
+ */
+TEST_F(SynchronizerTest, ProcessStateRequest) {
+  auto trie_nodes = std::make_shared<storage::trie::TrieStorageBackendMock>();
+  sync_protocol_observer_ = std::make_shared<SyncProtocolObserverImpl>(
+      tree_, headers_, nullptr, trie_nodes);
+  StateRequest request{{Buffer{0x01}, Buffer{0x02}, Buffer{0x03}}};
+
+  EXPECT_CALL(*trie_nodes, get(Buffer{0x01}))
+      .WillOnce(Return(Buffer{0x11, 0x22}));
+  EXPECT_CALL(*trie_nodes, get(Buffer{0x02}))
+      .WillOnce(Return(outcome::failure(boost::system::error_code{})));
+
+  EXPECT_OUTCOME_TRUE(response,
+                      sync_protocol_observer_->onStateRequest(request));
+
+  ASSERT_EQ(response.nodes, (std::vector<Buffer>{Buffer{0x11, 0x22}}));
+}
@@ -58,3 +58,20 @@ TEST_F(BlockAnnounceTest, EncodeSuccess) {
   EXPECT_OUTCOME_TRUE(ba, decode<BlockAnnounce>(buffer));
   ASSERT_EQ(block_announce, ba);
 }
+
+/**
+ * @given compact `block announce` instance with the hashes of the extrinsics
+ * @when scale-encode it and decode back, and decode the header only
+ * @then decoded block announce matches initial one, and the header is the
+ * one of a plain announce
+ */
+TEST_F(BlockAnnounceTest, EncodeCompact) {
+  block_announce.extrinsic_hashes = std::vector<Hash256>{
+      createHash256({5, 5, 5}), createHash256({6, 6, 6})};
+  EXPECT_OUTCOME_TRUE(buffer, encode(block_announce));
+  EXPECT_OUTCOME_TRUE(ba, decode<BlockAnnounce>(buffer));
+  ASSERT_EQ(block_announce, ba);
+
+  EXPECT_OUTCOME_TRUE(header, decode<BlockHeader>(buffer));
+  ASSERT_EQ(header, block_header);
+}
@@ -11,6 +11,7 @@
 #include "common/buffer.hpp"
 #include "common/visitor.hpp"
 #include "primitives/block.hpp"
+#include "primitives/block_header_view.hpp"
 #include "primitives/block_id.hpp"
 #include "primitives/common.hpp"
 #include "primitives/digest.hpp"
@@ -34,9 +35,12 @@ using kagome::primitives::ApiId;
 using kagome::primitives::AuthorityId;
 using kagome::primitives::Block;
 using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockHeaderView;
 using kagome::primitives::BlockId;
 using kagome::primitives::Digest;
+using kagome::primitives::DigestItemView;
 using kagome::primitives::Extrinsic;
+using kagome::primitives::ExtrinsicView;
 using kagome::primitives::InherentData;
 using kagome::primitives::InherentIdentifier;
 using kagome::primitives::InvalidTransaction;
@@ -112,6 +116,49 @@ TEST_F(Primitives, EncodeBlockHeaderSuccess) {
   ASSERT_EQ(block_header_, decoded_header);
 }
 
+/**
+ * @given a header with the digest items of all the types
+ * @when it is encoded and decoded as a view
+ * @then the view refers to the data of the items in the encoded header, and
+ * is converted back to the header
+ */
+TEST_F(Primitives, DecodeBlockHeaderView) {
+  auto header = block_header_;
+  header.digest = {Buffer{1, 2},
+                   uint32_t{7},
+                   createHash256({3}),
+                   std::string{"str"},
+                   kagome::primitives::Consensus{{{}, Buffer{4}}},
+                   kagome::primitives::Seal{{{}, Buffer{5, 6}}},
+                   PreRuntime{}};
+  EXPECT_OUTCOME_TRUE(encoded, encode(header));
+  EXPECT_OUTCOME_TRUE(view, decode<BlockHeaderView>(encoded));
+  ASSERT_EQ(view.parent_hash, header.parent_hash);
+  ASSERT_EQ(view.number, header.number);
+  ASSERT_EQ(view.digest.size(), header.digest.size());
+  auto &seal = view.digest[5];
+  ASSERT_EQ(seal.type, DigestItemView::SEAL);
+  ASSERT_EQ(seal.data.size(), 2);
+  ASSERT_GE(seal.data.data(), encoded.data());
+  ASSERT_LT(seal.data.data(), encoded.data() + encoded.size());
+  ASSERT_EQ(view.toHeader(), header);
+
+  encoded[encoded.size() - 6] = 7;
+  EXPECT_OUTCOME_FALSE_1(decode<BlockHeaderView>(encoded));
+}
+
+/**
+ * @given an encoded extrinsic
+ * @when it is decoded as a view
+ * @then the view refers to its content, and is converted to the extrinsic
+ */
+TEST_F(Primitives, DecodeExtrinsicView) {
+  EXPECT_OUTCOME_TRUE(val, encode(extrinsic_));
+  EXPECT_OUTCOME_TRUE(view, decode<ExtrinsicView>(val));
+  ASSERT_EQ(view.data.data(), val.data() + 1);
+  ASSERT_EQ(view.toExtrinsic(), extrinsic_);
+}
+
 /**
  * @given predefined extrinsic containing sequence {12, 1, 2, 3}
  * @when encodeExtrinsic is applied
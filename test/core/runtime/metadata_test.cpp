@@ -41,3 +41,16 @@ class MetadataTest : public RuntimeTest {
 TEST_F(MetadataTest, metadata) {
   ASSERT_TRUE(api_->metadata());
 }
+
+/**
+ * @given initialized Metadata api
+ * @when metadata() is invoked
+ * @then the size of the memory the call ended with is recorded for the
+ * export, so that the next calls start with memory of that size
+ */
+TEST_F(MetadataTest, RecordsMemoryPeak) {
+  ASSERT_EQ(runtime_manager_->memoryPeak("Metadata_metadata"), 0);
+  ASSERT_TRUE(api_->metadata());
+  ASSERT_GT(runtime_manager_->memoryPeak("Metadata_metadata"), 0);
+  ASSERT_EQ(runtime_manager_->memoryPeak("Core_version"), 0);
+}
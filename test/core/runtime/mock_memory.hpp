@@ -7,6 +7,9 @@
 #define KAGOME_TEST_CORE_RUNTIME_MOCK_MEMORY_HPP_
 
 #include <gmock/gmock.h>
+
+#include <deque>
+
 #include <boost/optional.hpp>
 #include "runtime/wasm_memory.hpp"
 
@@ -14,9 +17,20 @@ namespace kagome::runtime {
 
   class MockMemory : public WasmMemory {
    public:
+    // the views are loaded with loadN by default, so that the tests may
+    // expect the bytes to be either viewed or loaded
+    MockMemory() {
+      ON_CALL(*this, view(testing::_, testing::_))
+          .WillByDefault(testing::Invoke([this](WasmPointer addr, WasmSize n) {
+            return boost::make_optional(
+                gsl::span<const uint8_t>(views_.emplace_back(loadN(addr, n))));
+          }));
+    }
+
     MOCK_CONST_METHOD0(size, WasmSize());
     MOCK_METHOD1(resize, void(WasmSize));
     MOCK_METHOD0(reset, void());
+    MOCK_CONST_METHOD0(allocatorStats, AllocatorStats());
     MOCK_METHOD1(allocate, WasmPointer(WasmSize));
     MOCK_METHOD1(deallocate, boost::optional<WasmSize>(WasmPointer));
 
@@ -31,6 +45,11 @@ namespace kagome::runtime {
     MOCK_CONST_METHOD1(load128, std::array<uint8_t, 16>(WasmPointer));
     MOCK_CONST_METHOD2(loadN, common::Buffer(WasmPointer, WasmSize));
     MOCK_CONST_METHOD2(loadStr, std::string(WasmPointer, WasmSize));
+    MOCK_CONST_METHOD2(view,
+                       boost::optional<gsl::span<const uint8_t>>(WasmPointer,
+                                                                 WasmSize));
+    MOCK_METHOD2(mutableView,
+                 boost::optional<gsl::span<uint8_t>>(WasmPointer, WasmSize));
 
     MOCK_METHOD2(store8, void(WasmPointer, int8_t));
     MOCK_METHOD2(store16, void(WasmPointer, int16_t));
@@ -39,6 +58,10 @@ namespace kagome::runtime {
     MOCK_METHOD2(store128, void(WasmPointer, const std::array<uint8_t, 16> &));
     MOCK_METHOD2(storeBuffer, void(WasmPointer, gsl::span<const uint8_t>));
     MOCK_METHOD1(storeBuffer, WasmSpan(gsl::span<const uint8_t>));
+
+   private:
+    // the bytes of the views returned, which live as long as the mock
+    mutable std::deque<common::Buffer> views_;
   };
 
 }  // namespace kagome::runtime
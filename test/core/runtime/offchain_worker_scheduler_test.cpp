@@ -0,0 +1,103 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/offchain_worker_scheduler.hpp"
+
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include "mock/core/application/app_state_manager_mock.hpp"
+#include "mock/core/runtime/offchain_worker_mock.hpp"
+
+using kagome::application::AppStateManagerMock;
+using kagome::runtime::OffchainWorkerMock;
+using kagome::runtime::OffchainWorkerScheduler;
+using testing::_;
+using testing::InSequence;
+using testing::Invoke;
+
+class OffchainWorkerSchedulerTest : public testing::Test {
+ public:
+  std::shared_ptr<AppStateManagerMock> app_state_manager_ =
+      std::make_shared<AppStateManagerMock>();
+  std::shared_ptr<OffchainWorkerMock> offchain_worker_ =
+      std::make_shared<OffchainWorkerMock>();
+};
+
+/**
+ * @given scheduler with a thread
+ * @when a block is scheduled
+ * @then its offchain worker is run on the thread of the scheduler
+ */
+TEST_F(OffchainWorkerSchedulerTest, RunsScheduledWorker) {
+  EXPECT_CALL(*app_state_manager_, atShutdown(_));
+  std::promise<std::thread::id> worker_thread;
+  EXPECT_CALL(*offchain_worker_, offchain_worker(5))
+      .WillOnce(Invoke([&](auto) {
+        worker_thread.set_value(std::this_thread::get_id());
+        return outcome::success();
+      }));
+  OffchainWorkerScheduler scheduler{app_state_manager_, offchain_worker_, 1};
+
+  scheduler.schedule(5);
+
+  ASSERT_NE(worker_thread.get_future().get(), std::this_thread::get_id());
+}
+
+/**
+ * @given scheduler with a thread, which runs a worker
+ * @when several blocks are scheduled meanwhile
+ * @then only the worker of the latest one is run after it
+ */
+TEST_F(OffchainWorkerSchedulerTest, SkipsOutdatedBlocks) {
+  EXPECT_CALL(*app_state_manager_, atShutdown(_));
+  std::promise<void> first_started;
+  std::promise<void> release_first;
+  std::promise<void> last_done;
+  {
+    InSequence s;
+    EXPECT_CALL(*offchain_worker_, offchain_worker(1))
+        .WillOnce(Invoke([&](auto) {
+          first_started.set_value();
+          release_first.get_future().wait();
+          return outcome::success();
+        }));
+    EXPECT_CALL(*offchain_worker_, offchain_worker(4))
+        .WillOnce(Invoke([&](auto) {
+          last_done.set_value();
+          return outcome::success();
+        }));
+  }
+  OffchainWorkerScheduler scheduler{app_state_manager_, offchain_worker_, 1};
+
+  scheduler.schedule(1);
+  first_started.get_future().wait();
+  scheduler.schedule(2);
+  scheduler.schedule(3);
+  scheduler.schedule(4);
+  release_first.set_value();
+
+  last_done.get_future().wait();
+  scheduler.stop();
+}
+
+/**
+ * @given stopped scheduler and scheduler without threads
+ * @when blocks are scheduled
+ * @then no workers are run
+ */
+TEST_F(OffchainWorkerSchedulerTest, StoppedOrDisabledRunsNothing) {
+  EXPECT_CALL(*app_state_manager_, atShutdown(_)).Times(2);
+  EXPECT_CALL(*offchain_worker_, offchain_worker(_)).Times(0);
+
+  OffchainWorkerScheduler stopped{app_state_manager_, offchain_worker_, 2};
+  stopped.stop();
+  stopped.schedule(1);
+
+  OffchainWorkerScheduler disabled{app_state_manager_, offchain_worker_, 0};
+  disabled.schedule(1);
+  disabled.stop();
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/binaryen/runtime_call_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::runtime::binaryen::RuntimeCallCache;
+
+class RuntimeCallCacheTest : public ::testing::Test {
+ protected:
+  static Buffer key(std::string_view name, Buffer args = {}) {
+    Hash256 code_hash;
+    code_hash.fill('c');
+    return RuntimeCallCache::makeKey(code_hash, Buffer(32, 's'), name, args);
+  }
+
+  static constexpr size_t kCapacity = 2;
+  RuntimeCallCache cache_{kCapacity};
+};
+
+/**
+ * @given keys of calls differing in one part only
+ * @when they are made
+ * @then they all differ
+ */
+TEST_F(RuntimeCallCacheTest, KeysOfDifferentCallsDiffer) {
+  Hash256 other_code_hash;
+  other_code_hash.fill('o');
+  auto other_code = RuntimeCallCache::makeKey(
+      other_code_hash, Buffer(32, 's'), "Core_version", {});
+  Hash256 code_hash;
+  code_hash.fill('c');
+  auto other_state = RuntimeCallCache::makeKey(
+      code_hash, Buffer(32, 't'), "Core_version", {});
+
+  ASSERT_NE(key("Core_version"), other_code);
+  ASSERT_NE(key("Core_version"), other_state);
+  ASSERT_NE(key("Core_version"), key("Core_version", Buffer{1}));
+  // the boundary of the name and the arguments is kept
+  ASSERT_NE(key("Core_versio", Buffer{'n'}), key("Core_version"));
+}
+
+/**
+ * @given cache with a result put
+ * @when it is got by its key and by another one
+ * @then the result is returned for its key only
+ */
+TEST_F(RuntimeCallCacheTest, ReturnsPutResult) {
+  cache_.put(key("Core_version"), Buffer{1, 2, 3});
+
+  ASSERT_EQ(cache_.get(key("Core_version")), Buffer({1, 2, 3}));
+  ASSERT_EQ(cache_.get(key("Metadata_metadata")), boost::none);
+}
+
+/**
+ * @given full cache, the older result of which is used after the newer one
+ * is put
+ * @when another result is put
+ * @then the least recently used result is evicted
+ */
+TEST_F(RuntimeCallCacheTest, EvictsLeastRecentlyUsed) {
+  cache_.put(key("a"), Buffer{1});
+  cache_.put(key("b"), Buffer{2});
+  ASSERT_TRUE(cache_.get(key("a")));
+
+  cache_.put(key("c"), Buffer{3});
+
+  ASSERT_EQ(cache_.size(), kCapacity);
+  ASSERT_EQ(cache_.get(key("a")), Buffer{1});
+  ASSERT_EQ(cache_.get(key("b")), boost::none);
+  ASSERT_EQ(cache_.get(key("c")), Buffer{3});
+}
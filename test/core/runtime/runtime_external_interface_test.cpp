@@ -172,6 +172,7 @@ class REITest : public ::testing::Test {
       "  (import \"env\" \"ext_crypto_sr25519_generate_version_1\" (func $ext_crypto_sr25519_generate_version_1 (type 30)))\n"
       "  (import \"env\" \"ext_crypto_sr25519_sign_version_1\" (func $ext_crypto_sr25519_sign_version_1 (type 31)))\n"
       "  (import \"env\" \"ext_crypto_sr25519_verify_version_2\" (func $ext_crypto_sr25519_verify_version_2 (type 32)))\n"
+      "  (import \"env\" \"ext_crypto_sr25519_batch_verify_version_1\" (func $ext_crypto_sr25519_batch_verify_version_1 (type 32)))\n"
       "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_version_1 (type 31)))\n"
       "  (import \"env\" \"ext_crypto_secp256k1_ecdsa_recover_compressed_version_1\" (func $ext_crypto_secp256k1_ecdsa_recover_compressed_version_1 (type 31)))\n"
 
@@ -784,6 +785,34 @@ TEST_F(REITest, ext_sr25519_verify_v2_Test) {
   executeWasm(execute_code);
 }
 
+TEST_F(REITest, ext_sr25519_batch_verify_v1_Test) {
+  WasmPointer msg_data = 123;
+  WasmSize msg_len = 1233;
+  WasmSpan msg = WasmResult(msg_data, msg_len).combine();
+  WasmPointer sig_data = 42;
+  WasmPointer pubkey_data = 321;
+
+  WasmSize res = 1;
+
+  EXPECT_CALL(*extension_,
+              ext_sr25519_batch_verify_v1(sig_data, msg, pubkey_data))
+      .WillOnce(Return(res));
+
+  auto execute_code =
+      (boost::format("    (call $assert_eq_i32\n"
+                     "      (call $ext_crypto_sr25519_batch_verify_version_1\n"
+                     "        (i32.const %d)\n"
+                     "        (i64.const %d)\n"
+                     "        (i32.const %d)\n"
+                     "      )\n"
+                     "      (i32.const %d)\n"
+                     "    )\n")
+       % sig_data % msg % pubkey_data % res)
+          .str();
+  SCOPED_TRACE("ext_sr25519_batch_verify_v1_Test");
+  executeWasm(execute_code);
+}
+
 TEST_F(REITest, ext_twox_128_Test) {
   WasmPointer data_ptr = 12;
   WasmSize data_size = 12;
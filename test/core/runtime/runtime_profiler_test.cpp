@@ -0,0 +1,132 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/runtime_profiler.hpp"
+
+#include <gtest/gtest.h>
+
+using kagome::runtime::RuntimeProfiler;
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+/**
+ * @given disabled profiler
+ * @when calls are timed and bytes are counted
+ * @then nothing is collected
+ */
+TEST(RuntimeProfilerTest, DisabledCollectsNothing) {
+  RuntimeProfiler profiler;
+  {
+    auto timer = profiler.exportTimer("Core_version");
+  }
+  profiler.recordLoaded(10);
+  profiler.recordStored(10);
+
+  auto report = profiler.report();
+  ASSERT_TRUE(report.exports.empty());
+  ASSERT_EQ(report.bytes_loaded, 0);
+  ASSERT_EQ(report.bytes_stored, 0);
+}
+
+/**
+ * @given enabled profiler
+ * @when exports and host functions are timed
+ * @then their calls are counted by their names separately
+ */
+TEST(RuntimeProfilerTest, CountsCallsByName) {
+  RuntimeProfiler profiler{true};
+  {
+    auto timer = profiler.exportTimer("Core_execute_block");
+  }
+  {
+    auto timer = profiler.hostCallTimer("ext_twox_128");
+  }
+  profiler.recordHostCall("ext_twox_128", microseconds(1));
+  profiler.recordLoaded(10);
+  profiler.recordStored(20);
+
+  auto report = profiler.report();
+  ASSERT_EQ(report.exports.size(), 1);
+  ASSERT_EQ(report.exports.at("Core_execute_block").calls, 1);
+  ASSERT_EQ(report.host_functions.size(), 1);
+  ASSERT_EQ(report.host_functions.at("ext_twox_128").calls, 2);
+  ASSERT_EQ(report.bytes_loaded, 10);
+  ASSERT_EQ(report.bytes_stored, 20);
+}
+
+/**
+ * @given enabled profiler, which recorded 99 fast calls and a slow one
+ * @when its report is made
+ * @then the 99th percentile is bounded by the fast calls, while the total
+ * and the max include the slow one
+ */
+TEST(RuntimeProfilerTest, P99SkipsOutliers) {
+  RuntimeProfiler profiler{true};
+  for (auto i = 0; i < 99; i++) {
+    profiler.recordExport("BlockBuilder_apply_extrinsic", nanoseconds(100));
+  }
+  profiler.recordExport("BlockBuilder_apply_extrinsic", nanoseconds(100000));
+
+  auto stats = profiler.report().exports.at("BlockBuilder_apply_extrinsic");
+  ASSERT_EQ(stats.calls, 100);
+  ASSERT_EQ(stats.total, nanoseconds(99 * 100 + 100000));
+  ASSERT_EQ(stats.max, nanoseconds(100000));
+  ASSERT_GE(stats.p99, nanoseconds(100));
+  ASSERT_LT(stats.p99, nanoseconds(200));
+}
+
+/**
+ * @given profiler, which collected some timings
+ * @when it is reset
+ * @then they are forgotten
+ */
+TEST(RuntimeProfilerTest, ResetForgetsEverything) {
+  RuntimeProfiler profiler{true};
+  profiler.recordExport("Core_version", nanoseconds(1));
+  profiler.recordLoaded(1);
+
+  profiler.reset();
+
+  auto report = profiler.report();
+  ASSERT_TRUE(report.exports.empty());
+  ASSERT_EQ(report.bytes_loaded, 0);
+}
+
+/**
+ * @given enabled profiler
+ * @when allocator stats of two calls of an export are recorded
+ * @then they are summed, but the peak heap is the largest one, and the
+ * fragmentation is the share of the heaps unused at their peaks
+ */
+TEST(RuntimeProfilerTest, AggregatesHeapsByExport) {
+  RuntimeProfiler profiler{true};
+  kagome::runtime::AllocatorStats first;
+  first.allocations = 2;
+  first.bytes_allocated = 100;
+  first.bytes_freed = 50;
+  first.heap_size = 200;
+  first.peak_live = 100;
+  first.grows = 1;
+  auto second = first;
+  second.heap_size = 600;
+  second.peak_live = 500;
+  profiler.recordHeap("Core_execute_block", first);
+  profiler.recordHeap("Core_execute_block", second);
+
+  auto report = profiler.report();
+  ASSERT_EQ(report.heaps.size(), 1);
+  auto &stats = report.heaps.at("Core_execute_block");
+  ASSERT_EQ(stats.calls, 2);
+  ASSERT_EQ(stats.allocations, 4);
+  ASSERT_EQ(stats.bytes_allocated, 200);
+  ASSERT_EQ(stats.bytes_freed, 100);
+  ASSERT_EQ(stats.peak_heap, 600);
+  ASSERT_EQ(stats.grows, 2);
+  ASSERT_DOUBLE_EQ(stats.fragmentation, 0.25);
+
+  profiler.setEnabled(false);
+  profiler.recordHeap("Core_version", first);
+  ASSERT_EQ(profiler.report().heaps.count("Core_version"), 0);
+}
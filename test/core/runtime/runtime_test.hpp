@@ -108,8 +108,7 @@ class RuntimeTest : public ::testing::Test {
             std::move(wasm_provider),
             std::move(extension_factory),
             std::move(module_factory),
-            std::move(storage_provider),
-            std::move(hasher));
+            std::move(storage_provider));
   }
 
   kagome::primitives::BlockHeader createBlockHeader() {
@@ -7,13 +7,14 @@
 
 #include <gtest/gtest.h>
 
-#include "mock/core/storage/trie/trie_batches_mock.hpp"
+#include "mock/core/storage/trie/trie_snapshot_mock.hpp"
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
 
 using namespace kagome;  // NOLINT
 
-using ::testing::Invoke;
+using ::testing::_;
 using ::testing::Return;
+using ::testing::ReturnRef;
 
 class StorageWasmProviderTest : public ::testing::Test {
  public:
@@ -21,6 +22,27 @@ class StorageWasmProviderTest : public ::testing::Test {
     state_code_ = common::Buffer{1, 3, 3, 7};
   }
 
+  /**
+   * @return snapshot with \arg root, containing \arg code in a node with
+   * \arg merkle_value, the code is expected to be read if \arg read_code
+   */
+  static std::shared_ptr<const storage::trie::TrieSnapshot> makeSnapshot(
+      const common::Buffer &root,
+      const common::Buffer &merkle_value,
+      const common::Buffer &code,
+      bool read_code = true) {
+    auto snapshot = std::make_shared<storage::trie::TrieSnapshotMock>();
+    EXPECT_CALL(*snapshot, getMerkleValue(runtime::kRuntimeKey))
+        .WillOnce(Return(boost::make_optional(merkle_value)));
+    if (read_code) {
+      EXPECT_CALL(*snapshot, get(runtime::kRuntimeKey)).WillOnce(Return(code));
+    } else {
+      EXPECT_CALL(*snapshot, get(_)).Times(0);
+    }
+    EXPECT_CALL(*snapshot, getRootHash()).WillOnce(ReturnRef(root));
+    return snapshot;
+  }
+
  protected:
   common::Buffer state_code_;
 };
@@ -36,13 +58,9 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenNoStorageUpdates) {
   common::Buffer first_state_root{1, 1, 1, 1};
 
   // given
-  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
-  EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
-    auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-    EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-        .WillOnce(Return(state_code_));
-    return batch;
-  }));
+  EXPECT_CALL(*trie_db, getSnapshot())
+      .WillOnce(Return(
+          makeSnapshot(first_state_root, common::Buffer(32, 1), state_code_)));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
 
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
@@ -67,24 +85,16 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenStorageUpdates) {
   common::Buffer second_state_root{2, 2, 2, 2};
 
   // given
-  EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(first_state_root));
-  EXPECT_CALL(*trie_db, getEphemeralBatch()).WillOnce(Invoke([this]() {
-    auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-    EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-        .WillOnce(Return(state_code_));
-    return batch;
-  }));
+  EXPECT_CALL(*trie_db, getSnapshot())
+      .WillOnce(Return(
+          makeSnapshot(first_state_root, common::Buffer(32, 1), state_code_)));
   auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
 
   common::Buffer new_state_code{1, 3, 3, 8};
   EXPECT_CALL(*trie_db, getRootHash()).WillOnce(Return(second_state_root));
-  EXPECT_CALL(*trie_db, getEphemeralBatch())
-      .WillOnce(Invoke([&new_state_code]() {
-        auto batch = std::make_unique<storage::trie::EphemeralTrieBatchMock>();
-        EXPECT_CALL(*batch, get(runtime::kRuntimeKey))
-            .WillOnce(Return(new_state_code));
-        return batch;
-      }));
+  EXPECT_CALL(*trie_db, getSnapshot())
+      .WillOnce(Return(makeSnapshot(
+          second_state_root, common::Buffer(32, 2), new_state_code)));
 
   // when
   auto obtained_state_code = wasm_provider->getStateCode();
@@ -92,3 +102,38 @@ TEST_F(StorageWasmProviderTest, GetCodeWhenStorageUpdates) {
   // then
   ASSERT_EQ(obtained_state_code, new_state_code);
 }
+
+/**
+ * @given wasm provider initialized with a storage
+ * @when storage root is updated, but the node of the code stays the same
+ * @and state code and its hash are obtained by wasm provider
+ * @then the code is not read again and its hash is the merkle value of its
+ * node
+ */
+TEST_F(StorageWasmProviderTest, KeepsCodeWhenItsNodeIsUnchanged) {
+  auto trie_db = std::make_shared<storage::trie::TrieStorageMock>();
+  common::Buffer first_state_root{1, 1, 1, 1};
+  common::Buffer second_state_root{2, 2, 2, 2};
+  common::Buffer merkle_value(32, 1);
+
+  // given
+  EXPECT_CALL(*trie_db, getSnapshot())
+      .WillOnce(
+          Return(makeSnapshot(first_state_root, merkle_value, state_code_)));
+  auto wasm_provider = std::make_shared<runtime::StorageWasmProvider>(trie_db);
+
+  EXPECT_CALL(*trie_db, getRootHash())
+      .WillOnce(Return(second_state_root))
+      .WillOnce(Return(second_state_root));
+  EXPECT_CALL(*trie_db, getSnapshot())
+      .WillOnce(Return(makeSnapshot(
+          second_state_root, merkle_value, state_code_, false)));
+
+  // when
+  auto obtained_state_code = wasm_provider->getStateCode();
+  auto obtained_hash = wasm_provider->getStateCodeHash();
+
+  // then
+  ASSERT_EQ(obtained_state_code, state_code_);
+  ASSERT_EQ(obtained_hash, common::Hash256::fromSpan(merkle_value).value());
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "runtime/common/trie_storage_provider_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::runtime::TrieStorageProviderImpl;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class TrieStorageProviderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(
+            std::make_shared<InMemoryStorage>(), "\1"_buf),
+        std::make_shared<TrieNodeCache>(0));
+    auto trie_storage =
+        TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+            .value();
+    provider_ =
+        std::make_unique<TrieStorageProviderImpl>(std::move(trie_storage));
+    ASSERT_TRUE(provider_->setToPersistent());
+  }
+
+  std::unique_ptr<TrieStorageProviderImpl> provider_;
+};
+
+/**
+ * @given persistent batch with a value
+ * @when nested transactions change the storage, the inner one is rolled back
+ * and the outer one is committed
+ * @then only the changes of the outer transaction reach the persistent batch
+ */
+TEST_F(TrieStorageProviderTest, NestedTransactions) {
+  EXPECT_OUTCOME_TRUE_1(provider_->getCurrentBatch()->put("a"_buf, "1"_buf));
+
+  EXPECT_OUTCOME_TRUE_1(provider_->startTransaction());
+  EXPECT_OUTCOME_TRUE_1(provider_->getCurrentBatch()->put("b"_buf, "2"_buf));
+  ASSERT_TRUE(provider_->isCurrentlyPersistent());
+
+  EXPECT_OUTCOME_TRUE_1(provider_->startTransaction());
+  EXPECT_OUTCOME_TRUE_1(provider_->getCurrentBatch()->remove("a"_buf));
+  EXPECT_OUTCOME_TRUE_1(provider_->getCurrentBatch()->put("c"_buf, "3"_buf));
+  ASSERT_FALSE(provider_->getCurrentBatch()->contains("a"_buf));
+  EXPECT_OUTCOME_TRUE_1(provider_->rollbackTransaction());
+
+  ASSERT_TRUE(provider_->getCurrentBatch()->contains("a"_buf));
+  ASSERT_FALSE(provider_->getCurrentBatch()->contains("c"_buf));
+  ASSERT_TRUE(provider_->getCurrentBatch()->contains("b"_buf));
+  EXPECT_OUTCOME_TRUE_1(provider_->commitTransaction());
+
+  auto persistent_batch = provider_->tryGetPersistentBatch().value();
+  ASSERT_EQ(provider_->getCurrentBatch(), persistent_batch);
+  EXPECT_OUTCOME_TRUE(b, persistent_batch->get("b"_buf));
+  ASSERT_EQ(b, "2"_buf);
+  ASSERT_TRUE(persistent_batch->contains("a"_buf));
+  ASSERT_FALSE(persistent_batch->contains("c"_buf));
+}
+
+/**
+ * @given a transaction started over the persistent batch
+ * @when the current batch is switched to an ephemeral one and back
+ * @then the changes go to the transaction again
+ */
+TEST_F(TrieStorageProviderTest, TransactionSurvivesEphemeralCall) {
+  EXPECT_OUTCOME_TRUE_1(provider_->startTransaction());
+  EXPECT_OUTCOME_TRUE_1(provider_->setToEphemeral());
+  ASSERT_FALSE(provider_->isCurrentlyPersistent());
+  EXPECT_OUTCOME_TRUE_1(provider_->setToPersistent());
+  EXPECT_OUTCOME_TRUE_1(provider_->getCurrentBatch()->put("a"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(provider_->rollbackTransaction());
+  ASSERT_FALSE(provider_->getCurrentBatch()->contains("a"_buf));
+}
+
+/**
+ * @given no transaction
+ * @when a transaction is finished
+ * @then an error is returned
+ */
+TEST_F(TrieStorageProviderTest, NoTransaction) {
+  ASSERT_FALSE(provider_->commitTransaction());
+  ASSERT_FALSE(provider_->rollbackTransaction());
+}
@@ -22,6 +22,7 @@
 #include "extensions/impl/extension_factory_impl.hpp"
 #include "mock/core/storage/changes_trie/changes_tracker_mock.hpp"
 #include "runtime/binaryen/module/wasm_module_factory_impl.hpp"
+#include "runtime/binaryen/runtime_api/runtime_api.hpp"
 #include "runtime/binaryen/runtime_manager.hpp"
 #include "runtime/common/trie_storage_provider_impl.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
@@ -29,6 +30,7 @@
 #include "storage/trie/impl/trie_storage_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "testutil/outcome.hpp"
 #include "testutil/runtime/common/basic_wasm_provider.hpp"
@@ -44,25 +46,43 @@ using kagome::crypto::Secp256k1ProviderImpl;
 using kagome::crypto::SR25519ProviderImpl;
 using kagome::runtime::TrieStorageProvider;
 using kagome::runtime::TrieStorageProviderImpl;
+using kagome::runtime::binaryen::RuntimeApi;
 using kagome::runtime::binaryen::RuntimeManager;
 using kagome::runtime::binaryen::WasmExecutor;
+using kagome::runtime::binaryen::WasmModuleFactoryImpl;
 using kagome::storage::changes_trie::ChangesTrackerMock;
 using kagome::storage::trie::PolkadotCodec;
 using kagome::storage::trie::PolkadotTrieFactoryImpl;
 using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieNodeCache;
 using kagome::storage::trie::TrieSerializerImpl;
 using kagome::storage::trie::TrieStorage;
 using kagome::storage::trie::TrieStorageImpl;
 
 namespace fs = boost::filesystem;
 
-class WasmExecutorTest : public ::testing::Test {
+/**
+ * Calls an export the test code lacks, which traps
+ */
+class MissingExportApi : public RuntimeApi {
+ public:
+  using RuntimeApi::RuntimeApi;
+
+  outcome::result<void> callMissing() {
+    return execute<void>("missing", CallPersistency::EPHEMERAL);
+  }
+};
+
+/**
+ * Parametrized with the optimization level of the runtime code
+ */
+class WasmExecutorTest : public ::testing::TestWithParam<uint32_t> {
  public:
   void SetUp() override {
     // path to a file with wasm code in wasm/ subfolder
     auto wasm_path =
         fs::path(__FILE__).parent_path().string() + "/wasm/sumtwo.wasm";
-    auto wasm_provider =
+    wasm_provider_ =
         std::make_shared<kagome::runtime::BasicWasmProvider>(wasm_path);
 
     auto backend =
@@ -72,22 +92,23 @@ class WasmExecutorTest : public ::testing::Test {
 
     auto trie_factory = std::make_shared<PolkadotTrieFactoryImpl>();
     auto codec = std::make_shared<PolkadotCodec>();
-    auto serializer =
-        std::make_shared<TrieSerializerImpl>(trie_factory, codec, backend);
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        trie_factory, codec, backend, std::make_shared<TrieNodeCache>(0));
 
     auto trieDb = kagome::storage::trie::TrieStorageImpl::createEmpty(
                       trie_factory, codec, serializer, boost::none)
                       .value();
 
+    trie_storage_ = std::move(trieDb);
     storage_provider_ =
-        std::make_shared<TrieStorageProviderImpl>(std::move(trieDb));
+        std::make_shared<TrieStorageProviderImpl>(trie_storage_);
 
     auto random_generator = std::make_shared<BoostRandomGenerator>();
     auto sr25519_provider =
         std::make_shared<SR25519ProviderImpl>(random_generator);
     auto ed25519_provider = std::make_shared<ED25519ProviderImpl>();
     auto secp256k1_provider = std::make_shared<Secp256k1ProviderImpl>();
-    auto hasher = std::make_shared<HasherImpl>();
+    hasher_ = std::make_shared<HasherImpl>();
     auto pbkdf2_provider = std::make_shared<Pbkdf2ProviderImpl>();
     auto bip39_provider = std::make_shared<Bip39ProviderImpl>(pbkdf2_provider);
     auto crypto_store = std::make_shared<CryptoStoreImpl>(ed25519_provider,
@@ -96,48 +117,192 @@ class WasmExecutorTest : public ::testing::Test {
                                                           bip39_provider,
                                                           random_generator);
 
-    auto extension_factory =
+    extension_factory_ =
         std::make_shared<kagome::extensions::ExtensionFactoryImpl>(
             std::make_shared<ChangesTrackerMock>(),
             sr25519_provider,
             ed25519_provider,
             secp256k1_provider,
-            hasher,
+            hasher_,
             crypto_store,
             bip39_provider);
 
-    auto module_factory =
-        std::make_shared<kagome::runtime::binaryen::WasmModuleFactoryImpl>();
-
-    runtime_manager_ =
-        std::make_shared<RuntimeManager>(std::move(wasm_provider),
-                                         std::move(extension_factory),
-                                         std::move(module_factory),
-                                         storage_provider_,
-                                         std::move(hasher));
+    runtime_manager_ = makeRuntimeManager(
+        std::make_shared<WasmModuleFactoryImpl>(GetParam()));
 
     executor_ = std::make_shared<WasmExecutor>();
   }
 
+  void TearDown() override {
+    fs::remove_all(kCachePath);
+  }
+
+  std::shared_ptr<RuntimeManager> makeRuntimeManager(
+      std::shared_ptr<WasmModuleFactoryImpl> module_factory) const {
+    return std::make_shared<RuntimeManager>(wasm_provider_,
+                                            extension_factory_,
+                                            std::move(module_factory),
+                                            storage_provider_,
+                                            trie_storage_,
+                                            kInstancesNum);
+  }
+
+  /**
+   * Calls addTwo function of the runtime managed by \arg runtime_manager
+   */
+  void expectAddTwo(RuntimeManager &runtime_manager) const {
+    EXPECT_OUTCOME_TRUE(environment,
+                        runtime_manager.createEphemeralRuntimeEnvironment());
+    auto &&[module,
+            memory,
+            opt_batch,
+            restore_memory,
+            storage_provider,
+            discard] = std::move(environment);
+
+    auto res = executor_->call(
+        *module,
+        "addTwo",
+        wasm::LiteralList{wasm::Literal(1), wasm::Literal(2)});
+
+    ASSERT_TRUE(res) << res.error().message();
+    ASSERT_EQ(res.value().geti32(), 3);
+  }
+
+  static constexpr auto kCachePath = "/tmp/kagome_runtime_cache_test";
+  static constexpr size_t kInstancesNum = 2;
+
  protected:
+  std::shared_ptr<kagome::runtime::WasmProvider> wasm_provider_;
+  std::shared_ptr<kagome::extensions::ExtensionFactory> extension_factory_;
+  std::shared_ptr<HasherImpl> hasher_;
   std::shared_ptr<WasmExecutor> executor_;
   std::shared_ptr<RuntimeManager> runtime_manager_;
+  std::shared_ptr<TrieStorage> trie_storage_;
   std::shared_ptr<TrieStorageProvider> storage_provider_;
 };
 
 /**
  * @given wasm executor
  * @when call is invoked with wasm code with addTwo function
- * @then proper result is returned
+ * @then proper result is returned, whether the code is optimized or not
+ */
+TEST_P(WasmExecutorTest, ExecuteCode) {
+  expectAddTwo(*runtime_manager_);
+}
+
+/**
+ * @given module factories caching the optimized code in the same directory
+ * @when the code is run by a runtime manager with one of them and then by
+ * another one with the other factory, as after a restart
+ * @then the code is cached once it is optimized, and both runs give proper
+ * results
  */
-TEST_F(WasmExecutorTest, ExecuteCode) {
-  EXPECT_OUTCOME_TRUE(environment,
-                      runtime_manager_->createEphemeralRuntimeEnvironment());
-  auto &&[module, memory, opt_batch] = std::move(environment);
+TEST_P(WasmExecutorTest, CachedCodeIsReused) {
+  auto makeFactory = [this] {
+    return std::make_shared<WasmModuleFactoryImpl>(
+        GetParam(), kCachePath, hasher_);
+  };
+  expectAddTwo(*makeRuntimeManager(makeFactory()));
+  // code, which is not optimized, is not cached
+  if (GetParam() == 0) {
+    ASSERT_FALSE(fs::exists(kCachePath));
+  } else {
+    ASSERT_EQ(std::distance(fs::directory_iterator(kCachePath),
+                            fs::directory_iterator()),
+              1);
+  }
+  expectAddTwo(*makeRuntimeManager(makeFactory()));
+}
+
+/**
+ * @given runtime manager with a pool of instances for ephemeral calls
+ * @when ephemeral environments are used at the same time and then released
+ * @then each of them has an instance of its own, the released instances are
+ * reused with their memory restored, and the pool doesn't grow
+ */
+TEST_P(WasmExecutorTest, EphemeralCallsUseOwnInstances) {
+  constexpr kagome::runtime::WasmPointer kAddress = 42;
+  uint8_t initial_byte{};
+  {
+    EXPECT_OUTCOME_TRUE(first,
+                        runtime_manager_->createEphemeralRuntimeEnvironment());
+    EXPECT_OUTCOME_TRUE(second,
+                        runtime_manager_->createEphemeralRuntimeEnvironment());
+    ASSERT_NE(first.module, second.module);
+    ASSERT_NE(first.memory, second.memory);
+    ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), kInstancesNum);
+
+    initial_byte = first.memory->load8u(kAddress);
+    auto changed_byte = static_cast<int8_t>(~initial_byte);
+    first.memory->store8(kAddress, changed_byte);
+    second.memory->store8(kAddress, changed_byte);
+    ASSERT_TRUE(first.memory->allocate(16) != 0);
+  }
 
-  auto res = executor_->call(
-      *module, "addTwo", wasm::LiteralList{wasm::Literal(1), wasm::Literal(2)});
+  for (size_t i = 0; i < kInstancesNum + 1; ++i) {
+    EXPECT_OUTCOME_TRUE(environment,
+                        runtime_manager_->createEphemeralRuntimeEnvironment());
+    ASSERT_EQ(environment.memory->load8u(kAddress), initial_byte);
+    // the allocator is reset along with the memory
+    ASSERT_EQ(
+        environment.memory->allocate(16),
+        kagome::runtime::binaryen::WasmMemoryImpl::kAllocationHeaderSize);
+  }
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), kInstancesNum);
+  expectAddTwo(*runtime_manager_);
+}
 
-  ASSERT_TRUE(res) << res.error().message();
-  ASSERT_EQ(res.value().geti32(), 3);
+/**
+ * @given runtime manager, none of the calls of which is made yet
+ * @when the instances of the state code are prepared, twice
+ * @then a single instance is created ahead of the calls and is the one used
+ * by them
+ */
+TEST_P(WasmExecutorTest, PreparedInstancesAreUsed) {
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 0);
+  for (auto i = 0; i < 2; ++i) {
+    EXPECT_OUTCOME_TRUE_1(runtime_manager_->prepareInstances(
+        wasm_provider_->getStateCodeHash(), wasm_provider_->getStateCode()));
+    ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 1);
+  }
+  expectAddTwo(*runtime_manager_);
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 1);
 }
+
+/**
+ * @given runtime manager with a prepared instance for ephemeral calls
+ * @when a call through the runtime api traps on that instance
+ * @then the instance is dropped rather than reused with its globals dirty,
+ * and the next call gets a new one
+ */
+TEST_P(WasmExecutorTest, TrappedInstanceIsNotReused) {
+  EXPECT_OUTCOME_TRUE_1(runtime_manager_->prepareInstances(
+      wasm_provider_->getStateCodeHash(), wasm_provider_->getStateCode()));
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 1);
+
+  MissingExportApi api{runtime_manager_};
+  ASSERT_FALSE(api.callMissing());
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 0);
+
+  expectAddTwo(*runtime_manager_);
+  ASSERT_EQ(runtime_manager_->ephemeralInstancesNum(), 1);
+}
+
+/**
+ * @given runtime manager
+ * @when the memory peaks of exports are recorded
+ * @then the largest one is kept for each export separately
+ */
+TEST_P(WasmExecutorTest, KeepsLargestMemoryPeak) {
+  runtime_manager_->recordMemoryPeak("a", 100);
+  runtime_manager_->recordMemoryPeak("a", 50);
+  runtime_manager_->recordMemoryPeak("b", 10);
+  ASSERT_EQ(runtime_manager_->memoryPeak("a"), 100);
+  ASSERT_EQ(runtime_manager_->memoryPeak("b"), 10);
+  ASSERT_EQ(runtime_manager_->memoryPeak("c"), 0);
+}
+
+INSTANTIATE_TEST_CASE_P(OptimizationLevels,
+                        WasmExecutorTest,
+                        testing::Values(0u, 2u));
@@ -5,15 +5,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "runtime/binaryen/wasm_memory_impl.hpp"
 
 using kagome::runtime::binaryen::WasmMemoryImpl;
 
 class MemoryHeapTest : public ::testing::Test {
  protected:
-  wasm::ShellExternalInterface interface_;
   const static uint32_t memory_size_ = 4096;  // one page size
-  WasmMemoryImpl memory_{&interface_.memory, memory_size_};
+  WasmMemoryImpl memory_{memory_size_};
 };
 
 /**
@@ -59,21 +60,23 @@ TEST_F(MemoryHeapTest, AllocatedTooBigMemoryFailed) {
 /**
  * @given memory with already allocated memory of size1
  * @when allocate memory with size2
- * @then the pointer pointing to the end of the first memory chunk is returned
+ * @then the pointer pointing past the header after the end of the first
+ * memory chunk, which is rounded up to a power of two, is returned
  */
 TEST_F(MemoryHeapTest, ReturnOffsetWhenAllocated) {
   const size_t size1 = 2049;
   const size_t size2 = 2045;
+  const auto header = WasmMemoryImpl::kAllocationHeaderSize;
 
   // allocate memory of size 1
   auto ptr1 = memory_.allocate(size1);
-  // first memory chunk is always allocated at 1
-  ASSERT_EQ(ptr1, 1);
+  // first memory chunk is always allocated right after its header
+  ASSERT_EQ(ptr1, header);
 
   // allocated second memory chunk
   auto ptr2 = memory_.allocate(size2);
   // second memory chunk is placed right after the first one
-  ASSERT_EQ(ptr2, size1 + ptr1);
+  ASSERT_EQ(ptr2, ptr1 + 4096 + header);
 }
 
 /**
@@ -138,22 +141,21 @@ TEST_F(MemoryHeapTest, AllocateAfterDeallocate) {
  * @then allocate returns memory of size bigger
  */
 TEST_F(MemoryHeapTest, AllocateTooBigMemoryAfterDeallocate) {
-  // two memory sizes totalling to the total memory size
-  const size_t size1 = 2047;
+  // two memory sizes, the first one taking the whole chunk of its size
+  const size_t size1 = 2048;
   const size_t size2 = 2049;
 
-  // allocate two memory chunks with total size equal to the memory size
+  // allocate two memory chunks
   auto ptr1 = memory_.allocate(size1);
   auto ptr2 = memory_.allocate(size2);
 
   // calculate memory offset after two allocations
-  auto mem_offset = ptr2 + size2;
+  auto mem_offset = ptr2 + 4096 + WasmMemoryImpl::kAllocationHeaderSize;
 
   // deallocate first memory chunk
   memory_.deallocate(ptr1);
 
-  // allocate new memory chunk with bigger size than the space left in the
-  // memory
+  // allocate new memory chunk with bigger size than the deallocated one
   auto ptr3 = memory_.allocate(size1 + 1);
 
   // memory is allocated on mem offset
@@ -181,11 +183,114 @@ TEST_F(MemoryHeapTest, LoadNTest) {
 /**
  * @given Some memory is allocated
  * @when Memory is reset
- * @then Allocated memory's offset is 1
+ * @then Allocated memory's offset is the size of a header
  */
 TEST_F(MemoryHeapTest, ResetTest) {
   const size_t N = 42;
-  ASSERT_EQ(memory_.allocate(N), 1);
+  ASSERT_EQ(memory_.allocate(N), WasmMemoryImpl::kAllocationHeaderSize);
+  memory_.reset();
+  ASSERT_EQ(memory_.allocate(N), WasmMemoryImpl::kAllocationHeaderSize);
+}
+
+/**
+ * @given chunks of different sizes allocated and then deallocated
+ * @when chunks of the same sizes are allocated again
+ * @then the freed chunks of the matching sizes are reused, the most recently
+ * freed ones first, and the memory end doesn't move
+ */
+TEST_F(MemoryHeapTest, FreedChunksAreReusedBySizeClass) {
+  auto small1 = memory_.allocate(5);
+  auto small2 = memory_.allocate(8);
+  auto big = memory_.allocate(100);
+  ASSERT_EQ(memory_.deallocate(small1), 5u);
+  ASSERT_EQ(memory_.deallocate(big), 100u);
+  ASSERT_EQ(memory_.deallocate(small2), 8u);
+  // already freed
+  ASSERT_FALSE(memory_.deallocate(small2));
+
+  ASSERT_EQ(memory_.allocate(65), big);
+  ASSERT_EQ(memory_.allocate(1), small2);
+  ASSERT_EQ(memory_.allocate(7), small1);
+  ASSERT_EQ(memory_.allocate(8),
+            big + 128 + WasmMemoryImpl::kAllocationHeaderSize);
+}
+
+/**
+ * @given memory
+ * @when a chunk bigger than the max allocation size is requested
+ * @then nothing is allocated
+ */
+TEST_F(MemoryHeapTest, AllocationOverMaxSizeFails) {
+  ASSERT_EQ(memory_.allocate(WasmMemoryImpl::kMaxAllocationSize + 1), 0);
+}
+
+/**
+ * @given memory with a snapshot taken, which is then written both by the
+ * stores and through a mutable view
+ * @when the memory is restored
+ * @then the written bytes get their contents at the snapshot back, and the
+ * allocator is reset
+ */
+TEST_F(MemoryHeapTest, RestoreTest) {
+  memory_.store32(100, 0x01020304);
+  memory_.snapshot();
+
+  memory_.store32(100, 42);
+  kagome::common::Buffer b(8, 'c');
+  auto ptr = memory_.allocate(b.size());
+  memory_.storeBuffer(ptr, b);
+  auto view = memory_.mutableView(200, sizeof(int64_t));
+  ASSERT_TRUE(view);
+  std::fill(view->begin(), view->end(), 0xff);
+
+  memory_.restore();
+
+  ASSERT_EQ(memory_.load32u(100), 0x01020304u);
+  ASSERT_EQ(memory_.loadN(ptr, b.size()), kagome::common::Buffer(8, 0));
+  ASSERT_EQ(memory_.load64s(200), 0);
+  ASSERT_EQ(memory_.allocate(b.size()), ptr);
+}
+
+/**
+ * @given memory with some bytes stored
+ * @when they are viewed, as well as bytes partially out of the memory
+ * @then the view refers to the stored bytes, and there is no view of the
+ * bytes out of the memory
+ */
+TEST_F(MemoryHeapTest, ViewTest) {
+  kagome::common::Buffer b{1, 2, 3, 4};
+  memory_.storeBuffer(300, b);
+
+  auto view = memory_.view(300, b.size());
+  ASSERT_TRUE(view);
+  ASSERT_EQ(kagome::common::Buffer(*view), b);
+  ASSERT_EQ(view->data(), memory_.view(301, 1)->data() - 1);
+
+  ASSERT_FALSE(memory_.view(memory_size_ - 2, 4));
+  ASSERT_FALSE(memory_.mutableView(memory_size_, 1));
+}
+
+/**
+ * @given memory
+ * @when chunks are allocated and one of them is freed
+ * @then the allocator counts them, the heap and its growth until a reset
+ */
+TEST_F(MemoryHeapTest, CountsAllocations) {
+  auto ptr = memory_.allocate(10);
+  memory_.allocate(memory_size_);
+  memory_.deallocate(ptr);
+
+  auto stats = memory_.allocatorStats();
+  ASSERT_EQ(stats.allocations, 2);
+  ASSERT_EQ(stats.bytes_allocated, 10 + memory_size_);
+  ASSERT_EQ(stats.bytes_freed, 10);
+  ASSERT_EQ(stats.peak_live, 10 + memory_size_);
+  ASSERT_EQ(stats.heap_size,
+            2 * WasmMemoryImpl::kAllocationHeaderSize + 16 + memory_size_);
+  ASSERT_EQ(stats.grows, 1);
+
   memory_.reset();
-  ASSERT_EQ(memory_.allocate(N), 1);
+  stats = memory_.allocatorStats();
+  ASSERT_EQ(stats.allocations, 0);
+  ASSERT_EQ(stats.heap_size, 0);
 }
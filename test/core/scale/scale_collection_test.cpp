@@ -233,3 +233,85 @@ TEST(Scale, DISABLED_encodeVeryLongCollectionUint8) {
 
   ASSERT_EQ(stream.hasMore(1), false);
 }
+
+/**
+ * @given collections of bytes of the lengths at the bounds of the categories
+ * of the compact integers, as a vector, a span, a string and an array
+ * @when they are encoded
+ * @then the length is compact-encoded as a big integer is, and the bytes
+ * follow it as they are
+ */
+TEST(Scale, encodeBytesAtCategoryBounds) {
+  for (size_t length : {0, 63, 64, 16383, 16384, 1 << 20}) {
+    std::vector<uint8_t> bytes(length);
+    for (size_t i = 0; i < length; ++i) {
+      bytes[i] = i % 251;
+    }
+    EXPECT_OUTCOME_TRUE(match, encode(CompactInteger{length}));
+    match.insert(match.end(), bytes.begin(), bytes.end());
+
+    EXPECT_OUTCOME_TRUE(vector, encode(bytes));
+    EXPECT_EQ(vector, match);
+    EXPECT_OUTCOME_TRUE(span, encode(gsl::make_span(bytes)));
+    EXPECT_EQ(span, match);
+    EXPECT_OUTCOME_TRUE(
+        string, encode(std::string_view{
+            reinterpret_cast<const char *>(bytes.data()), length}));
+    EXPECT_EQ(string, match);
+  }
+
+  std::array<uint8_t, 3> array{1, 2, 3};
+  EXPECT_OUTCOME_TRUE(encoded, encode(array));
+  EXPECT_EQ(encoded, (ByteArray{12, 1, 2, 3}));
+}
+
+/**
+ * @given a stream with data encoded
+ * @when the data is taken from it, and then moved out of it
+ * @then both are the data encoded
+ */
+TEST(Scale, encodedDataMovedOut) {
+  ScaleEncoderStream s;
+  s << uint32_t{1} << std::vector<uint8_t>{2, 3};
+  ByteArray match{1, 0, 0, 0, 8, 2, 3};
+  EXPECT_EQ(s.data(), match);
+  EXPECT_EQ(std::move(s).data(), match);
+}
+
+/**
+ * @given collections and arrays of integers wider than a byte, and a blob
+ * @when they are encoded and decoded back
+ * @then the decoded values are the original ones, and the truncated
+ * encodings are refused
+ */
+TEST(Scale, decodeIntegerCollections) {
+  std::vector<uint32_t> numbers = {1, 0x01020304, 0xffffffff};
+  std::vector<int16_t> signed_numbers = {-1, 2, -32768};
+  std::array<uint64_t, 2> array = {0x0102030405060708, 42};
+  kagome::common::Blob<4> blob;
+  blob[1] = 7;
+  EXPECT_OUTCOME_TRUE(
+      encoded, encode(numbers, signed_numbers, array, blob, int64_t{-5}));
+
+  ScaleDecoderStream s{encoded};
+  std::vector<uint32_t> decoded_numbers;
+  std::vector<int16_t> decoded_signed_numbers;
+  std::array<uint64_t, 2> decoded_array{};
+  kagome::common::Blob<4> decoded_blob;
+  int64_t number = 0;
+  s >> decoded_numbers >> decoded_signed_numbers >> decoded_array
+      >> decoded_blob >> number;
+  ASSERT_EQ(decoded_numbers, numbers);
+  ASSERT_EQ(decoded_signed_numbers, signed_numbers);
+  ASSERT_EQ(decoded_array, array);
+  ASSERT_EQ(decoded_blob, blob);
+  ASSERT_EQ(number, -5);
+  ASSERT_FALSE(s.hasMore(1));
+
+  ScaleDecoderStream truncated{gsl::make_span(encoded).first(12)};
+  ASSERT_ANY_THROW(truncated >> decoded_numbers);
+
+  std::array<uint64_t, 1> short_array{};
+  ScaleDecoderStream too_many{encode(array).value()};
+  ASSERT_ANY_THROW(too_many >> short_array);
+}
@@ -8,8 +8,12 @@
 #include <gtest/gtest.h>
 #include <testutil/outcome.hpp>
 
+using kagome::scale::CompactInteger;
 using kagome::scale::decode;
 using kagome::scale::encode;
+using kagome::scale::encodedSize;
+using kagome::scale::EncodeError;
+using kagome::scale::encodeInto;
 
 struct TestStruct {
   std::string a;
@@ -60,3 +64,47 @@ TEST(ScaleConvenienceFuncsTest, EncodeSeveralValidArgTest) {
   ASSERT_EQ(decoded.a, expected_string);
   ASSERT_EQ(decoded.b, expected_int);
 }
+
+/**
+ * @given values of the various types, a struct among them
+ * @when their encoded size is computed
+ * @then it is the size of their encoding
+ */
+TEST(ScaleConvenienceFuncsTest, EncodedSizeTest) {
+  TestStruct s1{"some_string", 42};
+  std::vector<uint16_t> numbers(100, 7);
+  boost::optional<uint32_t> optional = 5;
+  boost::variant<uint8_t, std::string> variant = std::string(70, 'a');
+  auto tuple = std::make_tuple(CompactInteger{1} << 40, true, s1);
+
+  EXPECT_OUTCOME_TRUE(
+      encoded, encode(s1, numbers, optional, variant, tuple, uint64_t{1}));
+  EXPECT_OUTCOME_TRUE(
+      size, encodedSize(s1, numbers, optional, variant, tuple, uint64_t{1}));
+  ASSERT_EQ(size, encoded.size());
+
+  EXPECT_OUTCOME_FALSE(error, encodedSize(CompactInteger{-1}));
+  ASSERT_EQ(error, EncodeError::NEGATIVE_COMPACT_INTEGER);
+}
+
+/**
+ * @given a struct and a buffer of the caller
+ * @when the struct is encoded into the buffer as large as needed, and into a
+ * smaller one
+ * @then the first is its encoding, and the second is refused
+ */
+TEST(ScaleConvenienceFuncsTest, EncodeIntoTest) {
+  TestStruct s1{"some_string", 42};
+  EXPECT_OUTCOME_TRUE(encoded, encode(s1));
+
+  std::vector<uint8_t> out(encoded.size() + 1, 0xff);
+  EXPECT_OUTCOME_TRUE(written, encodeInto(out, s1));
+  ASSERT_EQ(written, encoded.size());
+  ASSERT_TRUE(std::equal(encoded.begin(), encoded.end(), out.begin()));
+  ASSERT_EQ(out.back(), 0xff);
+
+  EXPECT_OUTCOME_FALSE(
+      error,
+      encodeInto(gsl::make_span(out).first(encoded.size() - 1), s1));
+  ASSERT_EQ(error, EncodeError::NOT_ENOUGH_SPACE);
+}
@@ -58,3 +58,36 @@ TEST(ScaleDecoderStreamTest, HasMoreTest) {
 
   ASSERT_ANY_THROW(stream.nextByte());
 }
+
+/**
+ * @given byte array of 4 items: 0, 1, 2, 3
+ * @when taking 3 bytes at once
+ * @then bytes 0, 1, 2 are obtained @and the next 2 bytes are not available,
+ * as well as the number of bytes, which overflows the position
+ */
+TEST(ScaleDecoderStreamTest, NextBytesTest) {
+  auto bytes = ByteArray{0, 1, 2, 3};
+  auto stream = ScaleDecoderStream{bytes};
+
+  gsl::span<const uint8_t> taken;
+  ASSERT_NO_THROW((taken = stream.nextBytes(3)));
+  ASSERT_EQ(ByteArray(taken.begin(), taken.end()), (ByteArray{0, 1, 2}));
+
+  ASSERT_ANY_THROW(stream.nextBytes(2));
+  ASSERT_FALSE(stream.hasMore(std::numeric_limits<uint64_t>::max()));
+  ASSERT_EQ(stream.nextByte(), 3);
+}
+
+/**
+ * @given encoded byte collection, which size is over the encoded bytes
+ * @when decoding it
+ * @then error is returned, without the declared size being allocated
+ */
+TEST(ScaleDecoderStreamTest, BytesOverData) {
+  // compact 2^30, followed by 2 bytes
+  auto bytes = ByteArray{0b11, 0, 0, 0, 0x40, 1, 2};
+  auto stream = ScaleDecoderStream{bytes};
+
+  ByteArray decoded;
+  ASSERT_ANY_THROW((stream >> decoded));
+}
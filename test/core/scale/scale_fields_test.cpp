@@ -0,0 +1,105 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "scale/scale_fields.hpp"
+
+#include <gtest/gtest.h>
+
+#include "common/blob.hpp"
+#include "scale/scale.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Blob;
+using kagome::scale::ByteArray;
+using kagome::scale::CompactInteger;
+using kagome::scale::decode;
+using kagome::scale::DecodeError;
+using kagome::scale::encode;
+using kagome::scale::encodedSize;
+
+namespace {
+  struct Fixed {
+    uint16_t number = 0;
+    bool flag = false;
+    Blob<2> blob;
+
+    bool operator==(const Fixed &other) const {
+      return std::tie(number, flag, blob)
+             == std::tie(other.number, other.flag, other.blob);
+    }
+
+    SCALE_FIELDS(number, flag, blob)
+  };
+
+  struct Mixed {
+    uint32_t first = 0;
+    Fixed fixed;
+    uint64_t compact = 0;
+    std::vector<uint8_t> bytes;
+    int8_t last = 0;
+
+    bool operator==(const Mixed &other) const {
+      return std::tie(first, fixed, compact, bytes, last)
+             == std::tie(other.first,
+                         other.fixed,
+                         other.compact,
+                         other.bytes,
+                         other.last);
+    }
+
+    SCALE_FIELDS(first,
+                 fixed,
+                 kagome::scale::asCompact(compact),
+                 bytes,
+                 last)
+  };
+}  // namespace
+
+/**
+ * @given a struct of the fields of a fixed size, and one which nests it
+ * among the other fields
+ * @when they are encoded
+ * @then the fields are encoded in the declared order as they are one by one,
+ * the size of the first is known at compile time, and they are decoded back
+ */
+TEST(ScaleFields, EncodeDecode) {
+  Fixed fixed{0x0102, true, Blob<2>{{7, 8}}};
+  Mixed mixed{0x0a0b0c0d, fixed, 300, {1, 2, 3}, -2};
+  static_assert(kagome::scale::detail::kFixedSize<Fixed> == 5);
+  static_assert(kagome::scale::detail::kFixedSize<Mixed> == 0);
+
+  EXPECT_OUTCOME_TRUE(encoded_fixed, encode(fixed));
+  ASSERT_EQ(encoded_fixed, (ByteArray{2, 1, 1, 7, 8}));
+  EXPECT_OUTCOME_TRUE(encoded, encode(mixed));
+  EXPECT_OUTCOME_TRUE(
+      expected,
+      encode(mixed.first,
+             fixed.number,
+             fixed.flag,
+             fixed.blob,
+             CompactInteger{mixed.compact},
+             mixed.bytes,
+             mixed.last));
+  ASSERT_EQ(encoded, expected);
+  EXPECT_OUTCOME_TRUE(size, encodedSize(mixed));
+  ASSERT_EQ(size, encoded.size());
+  EXPECT_OUTCOME_TRUE(fixed_size, encodedSize(fixed, fixed));
+  ASSERT_EQ(fixed_size, 10);
+
+  EXPECT_OUTCOME_TRUE(decoded, decode<Mixed>(encoded));
+  ASSERT_EQ(decoded, mixed);
+}
+
+/**
+ * @given the encodings of a struct with a wrong bool, and a truncated one
+ * @when they are decoded
+ * @then they are refused
+ */
+TEST(ScaleFields, DecodeInvalid) {
+  EXPECT_OUTCOME_FALSE(wrong_bool, decode<Fixed>(ByteArray{2, 1, 2, 7, 8}));
+  ASSERT_EQ(wrong_bool, DecodeError::UNEXPECTED_VALUE);
+  EXPECT_OUTCOME_FALSE(truncated, decode<Fixed>(ByteArray{2, 1, 1, 7}));
+  ASSERT_EQ(truncated, DecodeError::NOT_ENOUGH_DATA);
+}
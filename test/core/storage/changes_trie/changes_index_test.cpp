@@ -0,0 +1,128 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/changes_trie/impl/changes_index.hpp"
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/arena_storage.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockInfo;
+using kagome::primitives::BlockNumber;
+using kagome::storage::ArenaStorage;
+using kagome::storage::changes_trie::ChangesIndex;
+using kagome::storage::changes_trie::ChangesTrieConfig;
+
+class ChangesIndexTest : public testing::Test {
+ public:
+  static BlockHash hashOf(BlockNumber number, uint8_t fork = 0) {
+    BlockHash hash;
+    hash[0] = fork;
+    hash[1] = static_cast<uint8_t>(number);
+    return hash;
+  }
+
+  /**
+   * Indexes the blocks up to \arg last on top of the genesis one, \arg key
+   * is changed by the blocks in \arg changing and "b" by all of them
+   */
+  void indexChain(BlockNumber last,
+                  const Buffer &key,
+                  const std::set<BlockNumber> &changing) {
+    for (BlockNumber number = 1; number <= last; ++number) {
+      std::vector<Buffer> keys{"b"_buf};
+      if (changing.count(number) != 0) {
+        keys.push_back(key);
+      }
+      EXPECT_OUTCOME_TRUE_1(index_.addBlock(
+          {number, hashOf(number)}, hashOf(number - 1), keys, config_));
+    }
+  }
+
+  std::vector<BlockNumber> changesOf(const Buffer &key,
+                                     BlockNumber from,
+                                     const BlockInfo &to) const {
+    EXPECT_OUTCOME_TRUE(blocks, index_.keyChanges(key, from, to));
+    std::vector<BlockNumber> numbers;
+    for (auto &block : blocks) {
+      numbers.push_back(block.block_number);
+    }
+    return numbers;
+  }
+
+  // digests of 2 blocks at every 2nd block and of 4 blocks at every 4th one
+  ChangesTrieConfig config_{.digest_interval = 2, .digest_levels = 2};
+  ChangesIndex index_{std::make_shared<ArenaStorage>(), "\1"_buf};
+};
+
+/**
+ * @given an indexed chain with digests
+ * @when the changes of a key over the ranges of the chain are queried
+ * @then the blocks changing the key within each range are found
+ */
+TEST_F(ChangesIndexTest, FindsChangesWithinRange) {
+  indexChain(20, "a"_buf, {3, 9, 16, 17});
+  BlockInfo last{20, hashOf(20)};
+
+  EXPECT_EQ(changesOf("a"_buf, 1, last),
+            (std::vector<BlockNumber>{3, 9, 16, 17}));
+  EXPECT_EQ(changesOf("a"_buf, 4, last), (std::vector<BlockNumber>{9, 16, 17}));
+  EXPECT_EQ(changesOf("a"_buf, 10, {16, hashOf(16)}),
+            (std::vector<BlockNumber>{16}));
+  EXPECT_EQ(changesOf("a"_buf, 3, {3, hashOf(3)}),
+            (std::vector<BlockNumber>{3}));
+  EXPECT_TRUE(changesOf("c"_buf, 1, last).empty());
+  EXPECT_EQ(changesOf("b"_buf, 5, {12, hashOf(12)}).size(), 8);
+}
+
+/**
+ * @given an indexed chain and a fork of it
+ * @when the changes of a key are queried up to the head of the fork
+ * @then the blocks of the fork and of the common part are found
+ */
+TEST_F(ChangesIndexTest, FollowsFork) {
+  indexChain(12, "a"_buf, {3, 10});
+  for (BlockNumber number = 10; number <= 12; ++number) {
+    auto parent = number == 10 ? hashOf(9) : hashOf(number - 1, 1);
+    std::vector<Buffer> keys;
+    if (number == 11) {
+      keys.push_back("a"_buf);
+    }
+    EXPECT_OUTCOME_TRUE_1(
+        index_.addBlock({number, hashOf(number, 1)}, parent, keys, config_));
+  }
+
+  EXPECT_EQ(changesOf("a"_buf, 1, {12, hashOf(12, 1)}),
+            (std::vector<BlockNumber>{3, 11}));
+  EXPECT_OUTCOME_TRUE(blocks,
+                      index_.keyChanges("a"_buf, 11, {12, hashOf(12, 1)}));
+  ASSERT_EQ(blocks.size(), 1);
+  EXPECT_EQ(blocks[0].block_hash, hashOf(11, 1));
+  EXPECT_EQ(changesOf("a"_buf, 1, {12, hashOf(12)}),
+            (std::vector<BlockNumber>{3, 10}));
+}
+
+/**
+ * @given a chain indexed from the middle
+ * @when the changes of a key are queried over the blocks not indexed
+ * @then BLOCK_NOT_INDEXED is returned
+ */
+TEST_F(ChangesIndexTest, MissingBlock) {
+  for (BlockNumber number = 5; number <= 8; ++number) {
+    EXPECT_OUTCOME_TRUE_1(index_.addBlock(
+        {number, hashOf(number)}, hashOf(number - 1), {"a"_buf}, config_));
+  }
+  EXPECT_EQ(changesOf("a"_buf, 5, {8, hashOf(8)}),
+            (std::vector<BlockNumber>{5, 6, 7, 8}));
+  EXPECT_OUTCOME_FALSE(err, index_.keyChanges("a"_buf, 2, {8, hashOf(8)}));
+  ASSERT_EQ(err.value(),
+            static_cast<int>(ChangesIndex::Error::BLOCK_NOT_INDEXED));
+}
@@ -14,6 +14,7 @@
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
@@ -28,6 +29,7 @@ using kagome::storage::trie::PersistentTrieBatch;
 using kagome::storage::trie::PersistentTrieBatchImpl;
 using kagome::storage::trie::PolkadotCodec;
 using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
 using kagome::storage::trie::TrieSerializerImpl;
 using kagome::storage::trie::TrieStorageBackendImpl;
 namespace scale = kagome::scale;
@@ -46,10 +48,10 @@ TEST(ChangesTrieTest, IntegrationWithOverlay) {
   auto codec = std::make_shared<PolkadotCodec>();
   auto backend = std::make_shared<TrieStorageBackendImpl>(
       std::make_shared<InMemoryStorage>(), Buffer{});
-  auto serializer =
-      std::make_shared<TrieSerializerImpl>(factory, codec, backend);
+  auto serializer = std::make_shared<TrieSerializerImpl>(
+      factory, codec, backend, std::make_shared<TrieNodeCache>(0));
   std::shared_ptr<ChangesTracker> changes_tracker =
-      std::make_shared<StorageChangesTrackerImpl>(factory, codec);
+      std::make_shared<StorageChangesTrackerImpl>();
   EXPECT_OUTCOME_TRUE_1(changes_tracker->onBlockChange("aaa"_hash256, 42));
   auto batch = std::make_shared<PersistentTrieBatchImpl>(
       codec,
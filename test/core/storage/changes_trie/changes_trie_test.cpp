@@ -8,12 +8,15 @@
 #include <gtest/gtest.h>
 
 #include "mock/core/storage/trie/trie_storage_mock.hpp"
+#include "storage/changes_trie/impl/changes_trie_builder.hpp"
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
 
 using kagome::common::Buffer;
 using kagome::storage::changes_trie::ChangesTrie;
+using kagome::storage::changes_trie::ChangesTrieBuilder;
 using kagome::storage::changes_trie::ChangesTrieConfig;
 using kagome::storage::trie::PolkadotCodec;
 using kagome::storage::trie::PolkadotTrieFactoryImpl;
@@ -46,3 +49,38 @@ TEST(ChangesTrieTest, SubstrateCompatibility) {
           "bb0c2ef6e1d36d5490f9766cfcc7dfe2a6ca804504c3bb206053890d6dd02376")
           .value());
 }
+
+/**
+ * @given a builder, which records puts and removals of keys, including a
+ * removal of a key, which is new to the storage
+ * @when calculating the root of the changes trie
+ * @then it is the same as the hash of a changes trie built from a map of the
+ * remaining changes
+ */
+TEST(ChangesTrieTest, BuilderMatchesTrie) {
+  auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+  auto codec = std::make_shared<PolkadotCodec>();
+
+  ChangesTrieBuilder builder;
+  std::map<Buffer, std::vector<kagome::primitives::ExtrinsicIndex>> changes;
+  for (uint32_t i = 0; i < 300; i++) {
+    // keys of different lengths, so that their encoded lengths differ too
+    auto key = Buffer(i % 70, 0xcd).putUint32(i % 100);
+    builder.onPut(key, i, false);
+    changes[key].push_back(i);
+  }
+  builder.onPut("temporary"_buf, 1, true);
+  builder.onPut("temporary"_buf, 2, false);
+  builder.onRemove("temporary"_buf, 3);
+  builder.onRemove("removed"_buf, 4);
+  changes["removed"_buf].push_back(4);
+
+  auto changes_trie =
+      ChangesTrie::buildFromChanges(99, factory, codec, changes, {}).value();
+  EXPECT_OUTCOME_TRUE(root, builder.calculateRoot(100));
+  ASSERT_EQ(root, changes_trie->getHash());
+
+  builder.clear();
+  EXPECT_OUTCOME_TRUE(empty_root, builder.calculateRoot(100));
+  ASSERT_EQ(empty_root, codec->hash256({0}));
+}
@@ -0,0 +1,151 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/deferred_write/deferred_write_storage.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::storage::DeferredWriteStorage;
+using kagome::storage::InMemoryStorage;
+
+class DeferredWriteStorageTest : public testing::Test {
+ public:
+  void SetUp() override {
+    EXPECT_OUTCOME_TRUE_1(db->put("removed"_buf, "old"_buf));
+    EXPECT_OUTCOME_TRUE_1(db->put("kept"_buf, "old"_buf));
+  }
+
+  /**
+   * Writes directly and with a batch through the storage
+   */
+  void write() {
+    EXPECT_OUTCOME_TRUE_1(storage.put("direct"_buf, "new"_buf));
+    EXPECT_OUTCOME_TRUE_1(storage.remove("removed"_buf));
+    auto batch = storage.batch();
+    EXPECT_OUTCOME_TRUE_1(batch->put("batched"_buf, "new"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch->put("kept"_buf, "new"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch->commit());
+  }
+
+  std::shared_ptr<InMemoryStorage> db = std::make_shared<InMemoryStorage>();
+  DeferredWriteStorage storage{db};
+};
+
+/**
+ * @given a storage without an open unit of work
+ * @when writing through it
+ * @then the writes reach the underlying storage at once
+ */
+TEST_F(DeferredWriteStorageTest, WritesPassThroughWithoutUnit) {
+  write();
+  EXPECT_OUTCOME_TRUE(direct, db->get("direct"_buf));
+  ASSERT_EQ(direct, "new"_buf);
+  EXPECT_OUTCOME_TRUE(batched, db->get("batched"_buf));
+  ASSERT_EQ(batched, "new"_buf);
+  ASSERT_FALSE(db->contains("removed"_buf));
+}
+
+/**
+ * @given a storage with an open unit of work
+ * @when writing through it and committing the unit
+ * @then the writes are seen through the storage only until the commit, and
+ * reach the underlying storage with the commit
+ */
+TEST_F(DeferredWriteStorageTest, UnitIsWrittenOnCommit) {
+  storage.begin();
+  write();
+
+  EXPECT_OUTCOME_TRUE(direct, storage.get("direct"_buf));
+  ASSERT_EQ(direct, "new"_buf);
+  EXPECT_OUTCOME_TRUE(kept, storage.getPinned("kept"_buf));
+  ASSERT_TRUE("new"_buf == kept.view());
+  ASSERT_FALSE(storage.contains("removed"_buf));
+  ASSERT_FALSE(storage.get("removed"_buf));
+  ASSERT_FALSE(db->contains("direct"_buf));
+  ASSERT_FALSE(db->contains("batched"_buf));
+  ASSERT_TRUE(db->contains("removed"_buf));
+
+  EXPECT_OUTCOME_TRUE_1(storage.commit());
+  ASSERT_FALSE(storage.isOpen());
+  EXPECT_OUTCOME_TRUE(batched, db->get("batched"_buf));
+  ASSERT_EQ(batched, "new"_buf);
+  EXPECT_OUTCOME_TRUE(db_kept, db->get("kept"_buf));
+  ASSERT_EQ(db_kept, "new"_buf);
+  ASSERT_TRUE(db->contains("direct"_buf));
+  ASSERT_FALSE(db->contains("removed"_buf));
+}
+
+/**
+ * @given a storage with an open unit of work
+ * @when writing through it and rolling the unit back
+ * @then neither the storage nor the underlying one have the writes
+ */
+TEST_F(DeferredWriteStorageTest, RollbackDiscardsUnit) {
+  storage.begin();
+  write();
+  storage.rollback();
+
+  ASSERT_FALSE(storage.isOpen());
+  ASSERT_FALSE(storage.contains("direct"_buf));
+  ASSERT_FALSE(storage.contains("batched"_buf));
+  EXPECT_OUTCOME_TRUE(kept, storage.get("kept"_buf));
+  ASSERT_EQ(kept, "old"_buf);
+  ASSERT_TRUE(storage.contains("removed"_buf));
+}
+
+/**
+ * @given a storage with a unit of work open on one thread
+ * @when another thread writes through it, and the unit is rolled back
+ * @then the writes of the other thread reach the underlying storage at once
+ * and are kept, while it doesn't see the writes of the unit
+ */
+TEST_F(DeferredWriteStorageTest, OtherThreadsWriteThrough) {
+  storage.begin();
+  EXPECT_OUTCOME_TRUE_1(storage.put("unit"_buf, "new"_buf));
+
+  std::thread{[&] {
+    ASSERT_FALSE(storage.isOpen());
+    ASSERT_FALSE(storage.contains("unit"_buf));
+    EXPECT_OUTCOME_TRUE_1(storage.put("other"_buf, "new"_buf));
+    auto batch = storage.batch();
+    EXPECT_OUTCOME_TRUE_1(batch->put("other_batched"_buf, "new"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch->commit());
+  }}.join();
+  ASSERT_TRUE(db->contains("other"_buf));
+  ASSERT_TRUE(db->contains("other_batched"_buf));
+
+  storage.rollback();
+  ASSERT_FALSE(storage.contains("unit"_buf));
+  ASSERT_TRUE(storage.contains("other"_buf));
+  ASSERT_TRUE(storage.contains("other_batched"_buf));
+}
+
+/**
+ * @given a storage with a unit of work open on one thread
+ * @when another thread opens a unit of its own and commits it
+ * @then only the writes of that unit are committed
+ */
+TEST_F(DeferredWriteStorageTest, UnitsOfThreadsAreSeparate) {
+  storage.begin();
+  EXPECT_OUTCOME_TRUE_1(storage.put("first"_buf, "new"_buf));
+
+  std::thread{[&] {
+    storage.begin();
+    EXPECT_OUTCOME_TRUE_1(storage.put("second"_buf, "new"_buf));
+    EXPECT_OUTCOME_TRUE_1(storage.commit());
+  }}.join();
+  ASSERT_TRUE(db->contains("second"_buf));
+  ASSERT_FALSE(db->contains("first"_buf));
+  ASSERT_TRUE(storage.isOpen());
+
+  EXPECT_OUTCOME_TRUE_1(storage.commit());
+  ASSERT_TRUE(db->contains("first"_buf));
+}
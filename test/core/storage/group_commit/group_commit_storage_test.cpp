@@ -0,0 +1,91 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/group_commit/group_commit_storage.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/storage/persistent_map_mock.hpp"
+#include "mock/core/storage/write_batch_mock.hpp"
+#include "storage/database_error.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::BufferBatch;
+using kagome::storage::DatabaseError;
+using kagome::storage::GroupCommitStorage;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::face::GenericStorageMock;
+using kagome::storage::face::WriteBatchMock;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+/**
+ * @given a storage, which takes the writes off the calling thread
+ * @when writing directly and with batches through it and flushing it
+ * @then the writes are seen through the storage at once, and reach the
+ * underlying storage by the time the flush is done
+ */
+TEST(GroupCommitStorageTest, WritesReachStorageOnFlush) {
+  auto db = std::make_shared<InMemoryStorage>();
+  EXPECT_OUTCOME_TRUE_1(db->put("removed"_buf, "old"_buf));
+  GroupCommitStorage storage{db};
+
+  EXPECT_OUTCOME_TRUE_1(storage.put("direct"_buf, "new"_buf));
+  EXPECT_OUTCOME_TRUE_1(storage.remove("removed"_buf));
+  for (uint8_t i = 0; i < 10; i++) {
+    auto batch = storage.batch();
+    EXPECT_OUTCOME_TRUE_1(batch->put(Buffer{i}, Buffer{i}));
+    EXPECT_OUTCOME_TRUE_1(batch->put("batched"_buf, Buffer{i}));
+    EXPECT_OUTCOME_TRUE_1(batch->commit());
+  }
+
+  EXPECT_OUTCOME_TRUE(direct, storage.get("direct"_buf));
+  ASSERT_EQ(direct, "new"_buf);
+  EXPECT_OUTCOME_TRUE(batched, storage.getPinned("batched"_buf));
+  ASSERT_TRUE(Buffer{9} == batched.view());
+  ASSERT_FALSE(storage.contains("removed"_buf));
+
+  EXPECT_OUTCOME_TRUE_1(storage.flush().get());
+  EXPECT_OUTCOME_TRUE(db_direct, db->get("direct"_buf));
+  ASSERT_EQ(db_direct, "new"_buf);
+  EXPECT_OUTCOME_TRUE(db_batched, db->get("batched"_buf));
+  ASSERT_EQ(db_batched, Buffer{9});
+  for (uint8_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(db->contains(Buffer{i}));
+  }
+  ASSERT_FALSE(db->contains("removed"_buf));
+}
+
+/**
+ * @given a storage, which underlying storage fails a write
+ * @when writing through it
+ * @then the flush reports the failure, the writes seen before are still
+ * seen, and the following writes fail
+ */
+TEST(GroupCommitStorageTest, FailedWriteStopsWrites) {
+  auto db = std::make_shared<GenericStorageMock<Buffer, Buffer>>();
+  EXPECT_CALL(*db, batch())
+      .WillOnce(Invoke([]() -> std::unique_ptr<BufferBatch> {
+        auto batch = std::make_unique<WriteBatchMock<Buffer, Buffer>>();
+        EXPECT_CALL(*batch, put_rvalue(_, _))
+            .WillRepeatedly(Return(outcome::success()));
+        EXPECT_CALL(*batch, commit())
+            .WillOnce(Return(DatabaseError::IO_ERROR));
+        return batch;
+      }));
+  GroupCommitStorage storage{db};
+
+  EXPECT_OUTCOME_TRUE_1(storage.put("key"_buf, "value"_buf));
+  EXPECT_OUTCOME_ERROR(res, storage.flush().get(), DatabaseError::IO_ERROR);
+
+  EXPECT_OUTCOME_TRUE(value, storage.get("key"_buf));
+  ASSERT_EQ(value, "value"_buf);
+  EXPECT_OUTCOME_ERROR(
+      put_res, storage.put("other"_buf, "value"_buf), DatabaseError::IO_ERROR);
+}
@@ -0,0 +1,146 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/in_memory/arena_storage.hpp"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "storage/database_error.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::ArenaStorage;
+using kagome::storage::DatabaseError;
+
+/**
+ * @return key number \arg i, which are not ordered the same way as numbers
+ */
+static Buffer keyOf(size_t i) {
+  return Buffer{}.putUint32(i * 2654435761u);
+}
+
+/**
+ * @given a storage filled with many entries, some of them overwritten and
+ * removed, which makes it grow the table and compact the chunks
+ * @when reading the entries
+ * @then all the lookups give the same results as with a map
+ */
+TEST(ArenaStorageTest, MatchesMap) {
+  ArenaStorage storage;
+  std::map<Buffer, Buffer> expected;
+  constexpr size_t kKeysNum = 5000;
+  for (size_t round = 0; round < 3; round++) {
+    for (size_t i = 0; i < kKeysNum; i++) {
+      auto key = keyOf(i);
+      if ((i + round) % 3 == 0) {
+        EXPECT_OUTCOME_TRUE_1(storage.remove(key));
+        expected.erase(key);
+        continue;
+      }
+      // values are large enough to fill several chunks in a round
+      auto value = Buffer(1000, round).putUint32(i);
+      EXPECT_OUTCOME_TRUE_1(storage.put(key, value));
+      expected[key] = value;
+    }
+  }
+
+  for (size_t i = 0; i < kKeysNum; i++) {
+    auto key = keyOf(i);
+    auto it = expected.find(key);
+    ASSERT_EQ(storage.contains(key), it != expected.end());
+    if (it != expected.end()) {
+      EXPECT_OUTCOME_TRUE(value, storage.get(key));
+      ASSERT_EQ(value, it->second);
+      EXPECT_OUTCOME_TRUE(pinned, storage.getPinned(key));
+      ASSERT_EQ(Buffer{pinned.view()}, it->second);
+    } else {
+      EXPECT_OUTCOME_ERROR(res, storage.get(key), DatabaseError::NOT_FOUND);
+    }
+  }
+
+  size_t data_size = 0;
+  for (auto &[key, value] : expected) {
+    data_size += key.size() + value.size() + ArenaStorage::kEntryOverhead;
+  }
+  ASSERT_EQ(storage.usedBytes(), data_size);
+}
+
+/**
+ * @given a storage with entries
+ * @when iterating over it with a cursor in both directions
+ * @then the keys are visited in the ascending order
+ */
+TEST(ArenaStorageTest, CursorIsOrdered) {
+  ArenaStorage storage;
+  std::map<Buffer, Buffer> expected;
+  for (size_t i = 0; i < 100; i++) {
+    EXPECT_OUTCOME_TRUE_1(storage.put(keyOf(i), Buffer{}.putUint32(i)));
+    expected.emplace(keyOf(i), Buffer{}.putUint32(i));
+  }
+
+  auto cursor = storage.cursor();
+  EXPECT_OUTCOME_TRUE_1(cursor->seekToFirst());
+  for (auto &[key, value] : expected) {
+    ASSERT_TRUE(cursor->isValid());
+    EXPECT_OUTCOME_TRUE(cursor_key, cursor->key());
+    ASSERT_EQ(cursor_key, key);
+    EXPECT_OUTCOME_TRUE(cursor_value, cursor->value());
+    ASSERT_EQ(cursor_value, value);
+    EXPECT_OUTCOME_TRUE_1(cursor->next());
+  }
+  ASSERT_FALSE(cursor->isValid());
+
+  EXPECT_OUTCOME_TRUE_1(cursor->seekToLast());
+  for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+    ASSERT_TRUE(cursor->isValid());
+    EXPECT_OUTCOME_TRUE(cursor_key, cursor->key());
+    ASSERT_EQ(cursor_key, it->first);
+    EXPECT_OUTCOME_TRUE_1(cursor->prev());
+  }
+  ASSERT_FALSE(cursor->isValid());
+
+  auto middle = std::next(expected.begin(), 50)->first;
+  EXPECT_OUTCOME_TRUE_1(cursor->seekUpperBound(middle));
+  EXPECT_OUTCOME_TRUE(next_key, cursor->key());
+  ASSERT_EQ(next_key, std::next(expected.begin(), 51)->first);
+  EXPECT_OUTCOME_TRUE_1(cursor->seek(middle));
+  EXPECT_OUTCOME_TRUE(same_key, cursor->key());
+  ASSERT_EQ(same_key, middle);
+}
+
+/**
+ * @given a storage with a budget
+ * @when writing more than fits into the budget directly and with a batch
+ * @then the writes fail without changing the storage, while overwriting
+ * with smaller values and removals succeed
+ */
+TEST(ArenaStorageTest, BudgetIsKept) {
+  constexpr size_t kEntrySize = 3 + 10 + ArenaStorage::kEntryOverhead;
+  ArenaStorage storage{2 * kEntrySize};
+  EXPECT_OUTCOME_TRUE_1(storage.put("ab1"_buf, Buffer(10, 1)));
+  EXPECT_OUTCOME_TRUE_1(storage.put("ab2"_buf, Buffer(10, 2)));
+  EXPECT_OUTCOME_ERROR(
+      res, storage.put("ab3"_buf, Buffer(10, 3)), DatabaseError::NO_SPACE);
+
+  auto batch = storage.batch();
+  EXPECT_OUTCOME_TRUE_1(batch->remove("ab1"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->put("ab2"_buf, Buffer(5, 2)));
+  EXPECT_OUTCOME_TRUE_1(batch->put("ab3"_buf, Buffer(20, 3)));
+  EXPECT_OUTCOME_ERROR(batch_res, batch->commit(), DatabaseError::NO_SPACE);
+  ASSERT_TRUE(storage.contains("ab1"_buf));
+  ASSERT_FALSE(storage.contains("ab3"_buf));
+
+  batch->clear();
+  EXPECT_OUTCOME_TRUE_1(batch->remove("ab1"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->put("ab3"_buf, Buffer(10, 3)));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  ASSERT_FALSE(storage.contains("ab1"_buf));
+  EXPECT_OUTCOME_TRUE(value, storage.get("ab3"_buf));
+  ASSERT_EQ(value, Buffer(10, 3));
+  ASSERT_EQ(storage.usedBytes(), 2 * kEntrySize);
+}
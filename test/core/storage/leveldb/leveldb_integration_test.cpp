@@ -37,6 +37,18 @@ TEST_F(LevelDB_Integration_Test, Put_Get) {
   EXPECT_EQ(val, value_);
 }
 
+/**
+ * @given opened database, with {key}
+ * @when read a pinned view of {key}
+ * @then the view has the bytes of {value}
+ */
+TEST_F(LevelDB_Integration_Test, GetPinned) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(key_, value_));
+  EXPECT_OUTCOME_TRUE_2(val, db_->getPinned(key_));
+  EXPECT_EQ(Buffer{val.view()}, value_);
+  EXPECT_FALSE(db_->getPinned(Buffer{0xde, 0xad}));
+}
+
 /**
  * @given empty db
  * @when read {key}
@@ -139,3 +151,53 @@ TEST_F(LevelDB_Integration_Test, Iterator) {
   EXPECT_FALSE(it->isValid());
   EXPECT_EQ(c, index + 1);
 }
+
+/**
+ * @given database with keys with and without a prefix
+ * @when a scan cursor over the prefix is created and the database is
+ * changed afterwards
+ * @then the cursor sees only the keys with the prefix as they were at its
+ * creation, from the first to the last one
+ */
+TEST_F(LevelDB_Integration_Test, ScanCursor) {
+  Buffer prefix{1, 0xff};
+  for (const auto &key : {Buffer{0}, Buffer{1, 0xff, 1}, Buffer{1, 0xff, 2},
+                          Buffer{2}}) {
+    EXPECT_OUTCOME_TRUE_1(db_->put(key, key));
+  }
+
+  auto cursor = db_->scanCursor(prefix);
+  EXPECT_OUTCOME_TRUE_1(db_->put(Buffer{1, 0xff, 3}, Buffer{3}));
+  EXPECT_OUTCOME_TRUE_1(db_->remove(Buffer{1, 0xff, 1}));
+
+  std::vector<Buffer> keys;
+  EXPECT_OUTCOME_TRUE_1(cursor->seekToFirst());
+  for (; cursor->isValid(); cursor->next().assume_value()) {
+    keys.emplace_back(cursor->key().value());
+  }
+  EXPECT_EQ(keys, (std::vector<Buffer>{{1, 0xff, 1}, {1, 0xff, 2}}));
+
+  EXPECT_OUTCOME_TRUE_1(cursor->seekToLast());
+  ASSERT_TRUE(cursor->isValid());
+  EXPECT_EQ(cursor->key().value(), (Buffer{1, 0xff, 2}));
+  EXPECT_OUTCOME_TRUE_1(cursor->seek(Buffer{0}));
+  ASSERT_TRUE(cursor->isValid());
+  EXPECT_EQ(cursor->key().value(), (Buffer{1, 0xff, 1}));
+}
+
+/**
+ * @given database with some data
+ * @when its properties are requested
+ * @then known properties are returned and unknown ones are not
+ */
+TEST_F(LevelDB_Integration_Test, Properties) {
+  EXPECT_OUTCOME_TRUE_1(db_->put(key_, value_));
+
+  auto stats = db_->getProperty("leveldb.stats");
+  ASSERT_TRUE(stats);
+  EXPECT_FALSE(stats->empty());
+  EXPECT_TRUE(db_->getProperty("leveldb.approximate-memory-usage"));
+  EXPECT_FALSE(db_->getProperty("leveldb.no-such-property"));
+  // the data is in the memtable yet, which isn't counted
+  EXPECT_EQ(db_->approximateSize(Buffer{0}, Buffer{0xff}), 0);
+}
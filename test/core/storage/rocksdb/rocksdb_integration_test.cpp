@@ -0,0 +1,175 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/rocksdb/rocksdb.hpp"
+
+#include <list>
+
+#include <gtest/gtest.h>
+
+#include "storage/database_error.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using namespace kagome::storage;
+using Space = RocksDB::Space;
+
+struct RocksDB_Integration_Test : public test::BaseFS_Test {
+  RocksDB_Integration_Test()
+      : test::BaseFS_Test("/tmp/kagome_rocksdb_integration_test") {}
+
+  void SetUp() override {
+    open();
+  }
+
+  void open() {
+    auto r = RocksDB::create(getPathString());
+    if (!r) {
+      throw std::invalid_argument(r.error().message());
+    }
+    db_ = std::move(r.value());
+  }
+
+  std::shared_ptr<RocksDB> db_;
+
+  Buffer key_{1, 3, 3, 7};
+  Buffer value_{1, 2, 3};
+};
+
+/**
+ * @given opened database, with {key} in a column family
+ * @when read {key}
+ * @then {value} is correct
+ */
+TEST_F(RocksDB_Integration_Test, Put_Get) {
+  auto space = db_->getSpace(Space::kTrieNode);
+  EXPECT_OUTCOME_TRUE_1(space->put(key_, value_));
+  EXPECT_TRUE(space->contains(key_));
+  EXPECT_OUTCOME_TRUE_2(val, space->get(key_));
+  EXPECT_EQ(val, value_);
+}
+
+/**
+ * @given opened database, with {key} in a column family
+ * @when read a pinned view of {key}
+ * @then the view has the bytes of {value}, even after the storage of the
+ * column family is released
+ */
+TEST_F(RocksDB_Integration_Test, GetPinned) {
+  auto space = db_->getSpace(Space::kTrieNode);
+  EXPECT_OUTCOME_TRUE_1(space->put(key_, value_));
+  EXPECT_OUTCOME_TRUE_2(val, space->getPinned(key_));
+  space.reset();
+  db_.reset();
+  EXPECT_EQ(Buffer{val.view()}, value_);
+}
+
+/**
+ * @given empty db
+ * @when read {key}
+ * @then get "not found"
+ */
+TEST_F(RocksDB_Integration_Test, Get_NonExistent) {
+  auto space = db_->getSpace(Space::kDefault);
+  EXPECT_TRUE(space->empty());
+  EXPECT_FALSE(space->contains(key_));
+  EXPECT_OUTCOME_TRUE_1(space->remove(key_));
+  auto r = space->get(key_);
+  EXPECT_FALSE(r);
+  EXPECT_EQ(r.error().value(), (int)DatabaseError::NOT_FOUND);
+}
+
+/**
+ * @given database with {key} put to one column family
+ * @when {key} is read from the other column families
+ * @then it is not found there
+ */
+TEST_F(RocksDB_Integration_Test, SpacesAreSeparate) {
+  auto trie_nodes = db_->getSpace(Space::kTrieNode);
+  auto block_data = db_->getSpace(Space::kBlockData);
+  EXPECT_OUTCOME_TRUE_1(trie_nodes->put(key_, value_));
+
+  EXPECT_FALSE(block_data->contains(key_));
+  EXPECT_TRUE(block_data->empty());
+  EXPECT_FALSE(db_->getSpace(Space::kDefault)->contains(key_));
+  auto cursor = block_data->cursor();
+  EXPECT_OUTCOME_TRUE_1(cursor->seekToFirst());
+  EXPECT_FALSE(cursor->isValid());
+}
+
+/**
+ * @given database with {key} in a column family
+ * @when the database is closed and opened again
+ * @then {key} is still in the same column family
+ */
+TEST_F(RocksDB_Integration_Test, Reopen) {
+  EXPECT_OUTCOME_TRUE_1(db_->getSpace(Space::kBlockData)->put(key_, value_));
+  db_.reset();
+
+  open();
+  EXPECT_OUTCOME_TRUE_2(val, db_->getSpace(Space::kBlockData)->get(key_));
+  EXPECT_EQ(val, value_);
+}
+
+/**
+ * @given database with [(i,i) for i in range(6)]
+ * @when create batch and write KVs
+ * @then data is written only after commit
+ */
+TEST_F(RocksDB_Integration_Test, WriteBatch) {
+  auto space = db_->getSpace(Space::kBlockData);
+  std::list<Buffer> keys{{0}, {1}, {2}, {3}, {4}, {5}};
+  Buffer toBeRemoved = {3};
+  std::list<Buffer> expected{{0}, {1}, {2}, {4}, {5}};
+
+  auto batch = space->batch();
+  ASSERT_TRUE(batch);
+
+  for (const auto &item : keys) {
+    EXPECT_OUTCOME_TRUE_1(batch->put(item, item));
+    EXPECT_FALSE(space->contains(item));
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->remove(toBeRemoved));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+
+  for (const auto &item : expected) {
+    EXPECT_TRUE(space->contains(item));
+    EXPECT_OUTCOME_TRUE_2(val, space->get(item));
+    EXPECT_EQ(val, item);
+  }
+
+  EXPECT_FALSE(space->contains(toBeRemoved));
+}
+
+/**
+ * @given database with [(i,i) for i in range(100)]
+ * @when iterate over kv pairs forward and seek an upper bound of a key
+ * @then we iterate over all items, and the upper bound is the next key
+ */
+TEST_F(RocksDB_Integration_Test, Iterator) {
+  auto space = db_->getSpace(Space::kTrieNode);
+  const size_t size = 100;
+  for (size_t i = 0; i < size; i++) {
+    Buffer item(1, i);
+    EXPECT_OUTCOME_TRUE_1(space->put(item, item));
+  }
+
+  size_t count = 0;
+  auto it = space->cursor();
+  EXPECT_OUTCOME_TRUE_1(it->seekToFirst());
+  for (; it->isValid(); it->next().assume_value()) {
+    EXPECT_OUTCOME_TRUE_2(k, it->key());
+    EXPECT_OUTCOME_TRUE_2(v, it->value());
+    EXPECT_EQ(k, v);
+    EXPECT_EQ(k, Buffer(1, count));
+    count++;
+  }
+  EXPECT_EQ(count, size);
+
+  EXPECT_OUTCOME_TRUE_1(it->seekUpperBound(Buffer{0x0f}));
+  ASSERT_TRUE(it->isValid());
+  EXPECT_OUTCOME_TRUE_2(k, it->key());
+  EXPECT_EQ(k, Buffer{0x10});
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::storage::trie::BranchChildren;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+
+/**
+ * @given an empty branch
+ * @when children are set in an arbitrary order
+ * @then they are accessible by their indices, the bitmap and the number of
+ * children are correct and iteration goes in the order of indices
+ */
+TEST(BranchChildrenTest, SetAndGet) {
+  BranchNode branch;
+  auto c3 = std::make_shared<DummyNode>("03"_hex2buf);
+  auto c0 = std::make_shared<DummyNode>("00"_hex2buf);
+  auto c15 = std::make_shared<DummyNode>("0f"_hex2buf);
+  branch.children.set(3, c3);
+  branch.children.set(15, c15);
+  branch.children.set(0, c0);
+
+  ASSERT_EQ(branch.children.at(0), c0);
+  ASSERT_EQ(branch.children.at(3), c3);
+  ASSERT_EQ(branch.children[15], c15);
+  ASSERT_EQ(branch.children.at(1), nullptr);
+  ASSERT_EQ(branch.childrenBitmap(), 0b1000000000001001);
+  ASSERT_EQ(branch.childrenNum(), 3);
+
+  std::vector<std::shared_ptr<kagome::storage::trie::PolkadotNode>> order{
+      branch.children.begin(), branch.children.end()};
+  ASSERT_EQ(order, (decltype(order){c0, c3, c15}));
+}
+
+/**
+ * @given a branch with children
+ * @when a child is replaced and another one is reset to null
+ * @then the replaced child is returned by its index and the removed one is
+ * not accounted anymore
+ */
+TEST(BranchChildrenTest, ReplaceAndRemove) {
+  BranchNode branch;
+  branch.children.set(2, std::make_shared<DummyNode>("02"_hex2buf));
+  branch.children.set(7, std::make_shared<DummyNode>("07"_hex2buf));
+
+  auto other = std::make_shared<DummyNode>("ff"_hex2buf);
+  branch.children.set(7, other);
+  branch.children.set(2, nullptr);
+  // removing an absent child changes nothing
+  branch.children.set(9, nullptr);
+
+  ASSERT_EQ(branch.children.at(2), nullptr);
+  ASSERT_EQ(branch.children.at(7), other);
+  ASSERT_EQ(branch.childrenBitmap(), 1u << 7u);
+  ASSERT_EQ(branch.childrenNum(), 1);
+}
+
+/**
+ * @given a branch
+ * @when a child index beyond the max number of children is accessed
+ * @then an exception is thrown, as with a plain array
+ */
+TEST(BranchChildrenTest, OutOfRange) {
+  BranchNode branch;
+  ASSERT_THROW(branch.children.at(BranchChildren::kMaxChildren),
+               std::out_of_range);
+  ASSERT_THROW(branch.children.set(BranchChildren::kMaxChildren, nullptr),
+               std::out_of_range);
+}
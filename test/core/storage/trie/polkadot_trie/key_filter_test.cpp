@@ -0,0 +1,84 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/key_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::KeyFilter;
+using kagome::storage::trie::PolkadotTrieImpl;
+using kagome::storage::trie::TrieError;
+
+/**
+ * @given a filter with a number of keys added
+ * @when it is checked for the added keys and for other keys
+ * @then all the added keys may be contained, while almost all the other keys
+ * are not
+ */
+TEST(KeyFilterTest, NoFalseNegatives) {
+  constexpr size_t kKeysNum = 1000;
+  // ~16 bits per key
+  KeyFilter filter{2 * kKeysNum};
+  for (size_t i = 0; i < kKeysNum; i++) {
+    filter.add(Buffer{}.putUint64(i));
+  }
+  size_t false_positives = 0;
+  for (size_t i = 0; i < kKeysNum; i++) {
+    ASSERT_TRUE(filter.mayContain(Buffer{}.putUint64(i)));
+    if (filter.mayContain(Buffer{}.putUint64(i + kKeysNum))) {
+      false_positives++;
+    }
+  }
+  ASSERT_LT(false_positives, kKeysNum / 100);
+}
+
+/**
+ * @given a trie using a filter
+ * @when values are put into it and then looked up along with absent keys
+ * @then the values are found, while the absent keys are reported as absent
+ */
+TEST(KeyFilterTest, TrieLookups) {
+  PolkadotTrieImpl trie;
+  trie.setKeyFilter(std::make_shared<KeyFilter>(1024));
+  EXPECT_OUTCOME_TRUE_1(trie.put("123"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(trie.put("345"_buf, "def"_buf));
+
+  EXPECT_OUTCOME_TRUE(value, trie.get("123"_buf));
+  ASSERT_EQ(value, "abc"_buf);
+  ASSERT_TRUE(trie.contains("345"_buf));
+  EXPECT_OUTCOME_ERROR(res, trie.get("678"_buf), TrieError::NO_VALUE);
+  ASSERT_FALSE(trie.contains("678"_buf));
+
+  std::vector<Buffer> keys{"678"_buf, "345"_buf, "9ab"_buf};
+  EXPECT_OUTCOME_TRUE(values, trie.getMany(keys));
+  ASSERT_EQ(values.size(), keys.size());
+  ASSERT_FALSE(values[0]);
+  ASSERT_EQ(values[1], "def"_buf);
+  ASSERT_FALSE(values[2]);
+}
+
+/**
+ * @given a trie using a filter
+ * @when a value is removed from it
+ * @then the key is absent, though the filter still may contain it
+ */
+TEST(KeyFilterTest, RemovedKeyIsAbsent) {
+  auto filter = std::make_shared<KeyFilter>(1024);
+  PolkadotTrieImpl trie;
+  trie.setKeyFilter(filter);
+  EXPECT_OUTCOME_TRUE_1(trie.put("123"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(trie.put("345"_buf, "def"_buf));
+  EXPECT_OUTCOME_TRUE_1(trie.remove("123"_buf));
+
+  ASSERT_TRUE(filter->mayContain("123"_buf));
+  ASSERT_FALSE(trie.contains("123"_buf));
+  ASSERT_TRUE(trie.contains("345"_buf));
+}
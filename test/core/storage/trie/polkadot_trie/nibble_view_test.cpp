@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/polkadot_node.hpp"
+
+#include <gtest/gtest.h>
+
+#include "testutil/literals.hpp"
+
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::NibbleView;
+
+/**
+ * @given the bytes of a key
+ * @when they are viewed as the nibbles
+ * @then the nibbles go high one first, and the parts of the view are the
+ * nibbles of the same positions
+ */
+TEST(NibbleViewTest, Nibbles) {
+  auto key = "12ab3c"_hex2buf;
+  auto view = NibbleView::ofKey(key);
+  ASSERT_EQ(view.size(), 6);
+  ASSERT_EQ(view.toNibbles(), (KeyNibbles{1, 2, 0xa, 0xb, 3, 0xc}));
+  ASSERT_EQ(view.subview(3).toNibbles(), (KeyNibbles{0xb, 3, 0xc}));
+  ASSERT_EQ(view.subview(1, 2).toNibbles(), (KeyNibbles{2, 0xa}));
+  ASSERT_TRUE(view.subview(7).empty());
+
+  KeyNibbles nibbles{1, 2, 0xa, 0xb};
+  ASSERT_TRUE(view.subview(0, 4) == nibbles);
+  ASSERT_TRUE(view.startsWith(nibbles));
+  ASSERT_FALSE(view.subview(1).startsWith(nibbles));
+  ASSERT_EQ(NibbleView{nibbles}.subview(2).toNibbles(),
+            (KeyNibbles{0xa, 0xb}));
+}
+
+/**
+ * @given the views of the keys at the offsets of the same and of the
+ * different parity, and of the nibbles kept one in a byte
+ * @when their common prefixes are computed
+ * @then the lengths are the same whichever way the nibbles are laid out
+ */
+TEST(NibbleViewTest, CommonPrefixLength) {
+  auto a = "0123456789abcdef0123"_hex2buf;
+  auto b = "0123456789abcdef0f23"_hex2buf;
+  auto va = NibbleView::ofKey(a);
+  auto vb = NibbleView::ofKey(b);
+  auto na = va.toNibbles();
+  auto nb = vb.toNibbles();
+
+  for (size_t offset : {0, 1, 2, 5}) {
+    auto expected = 17 - offset;
+    ASSERT_EQ(NibbleView::commonPrefixLength(va.subview(offset),
+                                             vb.subview(offset)),
+              expected);
+    ASSERT_EQ(NibbleView::commonPrefixLength(
+                  va.subview(offset), NibbleView{nb}.subview(offset)),
+              expected);
+    ASSERT_EQ(NibbleView::commonPrefixLength(NibbleView{na}.subview(offset),
+                                             NibbleView{nb}.subview(offset)),
+              expected);
+  }
+  // the nibbles at the offsets of the different parity
+  ASSERT_EQ(NibbleView::commonPrefixLength(va.subview(1), vb.subview(2)), 0);
+  ASSERT_EQ(
+      NibbleView::commonPrefixLength(NibbleView::ofKey("0112"_hex2buf)
+                                         .subview(1),
+                                     NibbleView::ofKey("1122"_hex2buf)),
+      3);
+  ASSERT_EQ(NibbleView::commonPrefixLength(va, va.subview(0, 7)), 7);
+}
@@ -161,3 +161,66 @@ TEST_F(PolkadotTrieCursorTest, Lexicographical) {
     EXPECT_OUTCOME_TRUE_1(c->next());
   } while (c->isValid());
 }
+
+/**
+ * @given a trie
+ * @when seeking the upper bound of keys, both present and absent in the trie
+ * @then the cursor points to the smallest key greater than the sought one
+ */
+TEST_F(PolkadotTrieCursorTest, SeekUpperBound) {
+  std::vector<std::pair<Buffer, Buffer>> vals{
+      {"0102"_hex2buf, "0102"_hex2buf},
+      {"0103"_hex2buf, "0103"_hex2buf},
+      {"010304"_hex2buf, "010304"_hex2buf},
+      {"05"_hex2buf, "05"_hex2buf},
+      {"06"_hex2buf, "06"_hex2buf},
+      {"0607"_hex2buf, "0607"_hex2buf},
+      {"060708"_hex2buf, "060708"_hex2buf},
+      {"06070801"_hex2buf, "06070801"_hex2buf},
+      {"06070802"_hex2buf, "06070802"_hex2buf},
+      {"06070803"_hex2buf, "06070803"_hex2buf}};
+  auto trie = makeTrie(vals);
+  auto c = trie->cursor();
+
+  std::vector<std::pair<Buffer, boost::optional<Buffer>>> cases{
+      {""_buf, "0102"_hex2buf},
+      {"00"_hex2buf, "0102"_hex2buf},
+      {"01"_hex2buf, "0102"_hex2buf},
+      {"0102"_hex2buf, "0103"_hex2buf},
+      {"010300"_hex2buf, "010304"_hex2buf},
+      {"010304"_hex2buf, "05"_hex2buf},
+      {"0400"_hex2buf, "05"_hex2buf},
+      {"060700"_hex2buf, "060708"_hex2buf},
+      {"06070802"_hex2buf, "06070803"_hex2buf},
+      {"06070803"_hex2buf, boost::none},
+      {"07"_hex2buf, boost::none}};
+  for (auto &[key, next_key] : cases) {
+    EXPECT_OUTCOME_TRUE_1(c->seekUpperBound(key));
+    if (next_key.has_value()) {
+      ASSERT_TRUE(c->isValid()) << key.toHex();
+      EXPECT_OUTCOME_TRUE(found_key, c->key());
+      ASSERT_EQ(found_key, next_key.value()) << key.toHex();
+    } else {
+      ASSERT_FALSE(c->isValid()) << key.toHex();
+    }
+  }
+}
+
+/**
+ * @given a generated trie
+ * @when iterating over it by a sequence of upper bound seeks, each starting
+ * from the key found by the previous one
+ * @then all keys are visited in order
+ */
+TEST_F(PolkadotTrieCursorTest, SeekUpperBoundVisitsAllKeys) {
+  auto &&[trie, keys] = generateRandomTrie(100, 8, 32);
+  auto c = trie->cursor();
+  std::vector<Buffer> visited;
+  EXPECT_OUTCOME_TRUE_1(c->seekUpperBound({}));
+  while (c->isValid()) {
+    EXPECT_OUTCOME_TRUE(key, c->key());
+    visited.push_back(key);
+    EXPECT_OUTCOME_TRUE_1(c->seekUpperBound(key));
+  }
+  ASSERT_EQ(visited, std::vector<Buffer>(keys.begin(), keys.end()));
+}
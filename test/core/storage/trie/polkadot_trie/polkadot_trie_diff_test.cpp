@@ -0,0 +1,140 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/polkadot_trie/polkadot_trie_diff.hpp"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::diffTries;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieDiffEntry;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+using Values = std::map<Buffer, Buffer>;
+
+class PolkadotTrieDiffTest : public testing::Test {
+ public:
+  void SetUp() override {
+    serializer_ = std::make_shared<TrieSerializerImpl>(
+        factory_,
+        std::make_shared<PolkadotCodec>(),
+        std::make_shared<TrieStorageBackendImpl>(
+            std::make_shared<InMemoryStorage>(), "\1"_buf),
+        std::make_shared<TrieNodeCache>(0));
+  }
+
+  /**
+   * @return root of the stored trie with \arg values
+   */
+  Buffer store(const Values &values) {
+    auto trie = factory_->createEmpty();
+    for (auto &[key, value] : values) {
+      EXPECT_OUTCOME_TRUE_1(trie->put(key, value));
+    }
+    return serializer_->storeTrie(*trie).value();
+  }
+
+  /**
+   * Checks that the diff of the states with \arg old_values and
+   * \arg new_values is the one calculated by comparing the values
+   */
+  void expectDiff(const Values &old_values, const Values &new_values) {
+    std::vector<TrieDiffEntry> expected;
+    std::map<Buffer, std::pair<boost::optional<Buffer>, boost::optional<Buffer>>>
+        all;
+    for (auto &[key, value] : old_values) {
+      all[key].first = value;
+    }
+    for (auto &[key, value] : new_values) {
+      all[key].second = value;
+    }
+    for (auto &[key, values] : all) {
+      if (values.first != values.second) {
+        expected.push_back({key, values.first, values.second});
+      }
+    }
+
+    EXPECT_OUTCOME_TRUE(old_trie,
+                        serializer_->retrieveImmutableTrie(store(old_values)));
+    EXPECT_OUTCOME_TRUE(new_trie,
+                        serializer_->retrieveImmutableTrie(store(new_values)));
+    std::vector<TrieDiffEntry> diff;
+    EXPECT_OUTCOME_TRUE_1(diffTries(
+        *old_trie, *new_trie, [&](TrieDiffEntry entry) {
+          diff.push_back(std::move(entry));
+        }));
+    ASSERT_EQ(diff.size(), expected.size());
+    for (size_t i = 0; i < diff.size(); ++i) {
+      EXPECT_EQ(diff[i].key, expected[i].key);
+      EXPECT_EQ(diff[i].old_value, expected[i].old_value);
+      EXPECT_EQ(diff[i].new_value, expected[i].new_value);
+    }
+  }
+
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory_ =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<TrieSerializerImpl> serializer_;
+};
+
+/**
+ * @given two equal states
+ * @when they are compared
+ * @then no keys differ
+ */
+TEST_F(PolkadotTrieDiffTest, EqualStates) {
+  Values values{{"abc"_buf, "1"_buf}, {"abd"_buf, "2"_buf}, {"b"_buf, "3"_buf}};
+  expectDiff(values, values);
+  expectDiff({}, {});
+}
+
+/**
+ * @given states with added, removed and changed keys, including the ones
+ * splitting and merging the branches of the trie
+ * @when they are compared
+ * @then the keys are emitted in their order with the old and the new values
+ */
+TEST_F(PolkadotTrieDiffTest, ChangedKeys) {
+  Values base;
+  for (uint8_t i = 0; i < 64; ++i) {
+    base.emplace(Buffer{std::vector<uint8_t>{i, uint8_t(i * 7), 1}},
+                 Buffer(1, i));
+  }
+  base.emplace("abc"_buf, "1"_buf);
+  base.emplace("abd"_buf, "2"_buf);
+  base.emplace("bcd"_buf, Buffer(40, 'x'));
+
+  auto changed = base;
+  changed["abc"_buf] = "3"_buf;
+  changed.erase("bcd"_buf);
+  changed.emplace("ab"_buf, "4"_buf);
+  changed.emplace("b"_buf, "5"_buf);
+  changed.erase(Buffer{std::vector<uint8_t>{3, 21, 1}});
+  changed[Buffer{std::vector<uint8_t>{7, 49, 1}}] = Buffer(40, 7);
+  changed.emplace(Buffer{std::vector<uint8_t>{7, 49}}, "6"_buf);
+  expectDiff(base, changed);
+  expectDiff(changed, base);
+
+  Values merged{{"abc"_buf, "1"_buf}};
+  expectDiff(base, merged);
+  expectDiff(merged, base);
+  expectDiff({}, base);
+  expectDiff(base, {});
+}
@@ -324,6 +324,30 @@ TEST_F(TrieTest, ClearPrefix) {
   ASSERT_TRUE(trie->empty());
 }
 
+/**
+ * @given a trie
+ * @when deleting a limited number of entries that start with a prefix
+ * @then at most the limit of them are deleted, and the next call deletes
+ * the ones left
+ */
+TEST_F(TrieTest, ClearPrefixWithLimit) {
+  for (auto key : {"bar"_buf, "bark"_buf, "barnacle"_buf, "bat"_buf}) {
+    EXPECT_OUTCOME_TRUE_1(trie->put(key, "123"_buf));
+  }
+  EXPECT_OUTCOME_TRUE(first, trie->clearPrefix("bar"_buf, 2));
+  ASSERT_FALSE(first.all_removed);
+  ASSERT_EQ(first.removed, 2);
+  ASSERT_FALSE(trie->contains("bar"_buf));
+  ASSERT_FALSE(trie->contains("bark"_buf));
+  ASSERT_TRUE(trie->contains("barnacle"_buf));
+
+  EXPECT_OUTCOME_TRUE(second, trie->clearPrefix("bar"_buf, 2));
+  ASSERT_TRUE(second.all_removed);
+  ASSERT_EQ(second.removed, 1);
+  ASSERT_FALSE(trie->contains("barnacle"_buf));
+  ASSERT_TRUE(trie->contains("bat"_buf));
+}
+
 /**
  * @given an empty trie
  * @when putting something into the trie
@@ -383,3 +407,54 @@ TEST_F(TrieTest, GetPathToInvalid) {
   EXPECT_OUTCOME_FALSE(
       path, trie->getPath(trie->getRoot(), KeyNibbles{"0a0b0c0d0e0f"_hex2buf}));
 }
+
+/**
+ * @given a trie, which nodes are all clean, as if it was read from the storage
+ * @when a value is put to the trie
+ * @then only the nodes on the path to the value become dirty
+ */
+TEST_F(TrieTest, PutMarksPathDirty) {
+  FillSmallTree(*trie);
+  auto root = trie->getRoot();
+  auto node_1234 = trie->getNode(root, KeyNibbles{1, 2, 3, 4}).value();
+  auto node_0a0b0c =
+      trie->getNode(root, KeyNibbles{0, 10, 0, 11, 0, 12}).value();
+  for (auto &node : {root, node_1234, node_0a0b0c}) {
+    node->merkle_value = "00"_hex2buf;
+  }
+
+  EXPECT_OUTCOME_TRUE_1(trie->put("123457"_hex2buf, "43"_hex2buf));
+
+  ASSERT_TRUE(root->isDirty());
+  ASSERT_TRUE(node_1234->isDirty());
+  ASSERT_FALSE(node_0a0b0c->isDirty());
+}
+
+/**
+ * @given a trie
+ * @when getting values of several keys at once, including absent and repeated
+ * ones, in no particular order
+ * @then the values are the same as the ones obtained by single gets
+ */
+TEST_F(TrieTest, GetMany) {
+  FillSmallTree(*trie);
+  std::vector<Buffer> keys{"0a0b0c"_hex2buf,
+                           "1234"_hex2buf,
+                           "12"_hex2buf,
+                           "123456"_hex2buf,
+                           "1234"_hex2buf,
+                           "010a0b0c"_hex2buf,
+                           "010203"_hex2buf,
+                           "ff"_hex2buf};
+
+  EXPECT_OUTCOME_TRUE(values, trie->getMany(keys));
+
+  ASSERT_EQ(values.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto value = trie->get(keys[i]);
+    ASSERT_EQ(values[i].has_value(), value.has_value()) << keys[i].toHex();
+    if (value) {
+      ASSERT_EQ(values[i].value(), value.value());
+    }
+  }
+}
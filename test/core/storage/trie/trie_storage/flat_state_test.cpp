@@ -0,0 +1,236 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/flat_state.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/arena_storage.hpp"
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::storage::ArenaStorage;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::FlatState;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class FlatStateTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    serializer_ = std::make_shared<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(
+            std::make_shared<InMemoryStorage>(), "\1"_buf),
+        std::make_shared<TrieNodeCache>(0));
+    trie_ = TrieStorageImpl::createEmpty(factory, codec, serializer_, boost::none)
+                .value();
+    flat_state_ = FlatState::create(storage_, "\2"_buf, serializer_).value();
+    trie_->setFlatState(flat_state_);
+  }
+
+  /**
+   * Commits a state made of the state with \arg root by \arg change
+   * @return root of the committed state
+   */
+  template <typename F>
+  Buffer commitOn(const Buffer &root, F &&change) {
+    auto batch = trie_->getPersistentBatchAt(Hash256::fromSpan(root).value())
+                     .value();
+    change(*batch);
+    return batch->commit().value();
+  }
+
+  /**
+   * Checks that \arg keys have the same values in the state with \arg root
+   * in the flat state and in the trie
+   */
+  void expectSameValues(const Buffer &root,
+                        const std::vector<Buffer> &keys) const {
+    EXPECT_OUTCOME_TRUE(trie, serializer_->retrieveTrie(root));
+    for (auto &key : keys) {
+      EXPECT_OUTCOME_TRUE(value, flat_state_->get(root, key));
+      auto expected = trie->get(key);
+      if (expected) {
+        ASSERT_EQ(value, expected.value()) << key.toHex();
+      } else {
+        ASSERT_EQ(value, boost::none) << key.toHex();
+      }
+    }
+  }
+
+  const std::vector<Buffer> keys_{
+      "abc"_buf, "abd"_buf, "ac"_buf, "b"_buf, "bcd"_buf, "c"_buf};
+
+  std::shared_ptr<ArenaStorage> storage_ = std::make_shared<ArenaStorage>();
+  std::shared_ptr<TrieSerializerImpl> serializer_;
+  std::unique_ptr<TrieStorageImpl> trie_;
+  std::shared_ptr<FlatState> flat_state_;
+};
+
+/**
+ * @given a state committed before the flat state has any entries
+ * @when the state is finalized
+ * @then the entries are rebuilt from its trie and the state is read from them
+ */
+TEST_F(FlatStateTest, FinalizationRebuildsEntries) {
+  auto root = commitOn(serializer_->getEmptyRootHash(), [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "1"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("b"_buf, "2"_buf));
+  });
+  ASSERT_FALSE(flat_state_->hasState(root));
+
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(root));
+  flat_state_->waitForRebuild();
+  ASSERT_TRUE(flat_state_->hasState(root));
+  expectSameValues(root, keys_);
+}
+
+/**
+ * @given a finalized state and two forks committed on top of it, one of them
+ * clearing a prefix
+ * @when the states are read and then the fork clearing the prefix is
+ * finalized
+ * @then the values of each state are the ones of its trie, and the other
+ * fork is dropped from the flat state
+ */
+TEST_F(FlatStateTest, ForksAreReadAndDropped) {
+  auto base = commitOn(serializer_->getEmptyRootHash(), [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "1"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("abd"_buf, "2"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("bcd"_buf, "3"_buf));
+  });
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(base));
+  flat_state_->waitForRebuild();
+
+  auto cleared = commitOn(base, [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abe"_buf, "4"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.clearPrefix("ab"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "5"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.remove("bcd"_buf));
+    // the batch reads its own changes on top of the flat state
+    EXPECT_OUTCOME_TRUE(value, batch.get("abc"_buf));
+    EXPECT_EQ(value, "5"_buf);
+    EXPECT_FALSE(batch.contains("abd"_buf));
+  });
+  auto next = commitOn(cleared, [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("c"_buf, "6"_buf));
+  });
+  auto fork = commitOn(base, [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("ac"_buf, "7"_buf));
+  });
+  for (auto &root : {cleared, next, fork}) {
+    ASSERT_TRUE(flat_state_->hasState(root));
+    expectSameValues(root, keys_);
+  }
+
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(cleared));
+  ASSERT_FALSE(flat_state_->hasState(fork));
+  ASSERT_FALSE(flat_state_->hasState(base));
+  EXPECT_OUTCOME_FALSE_1(flat_state_->get(fork, "ac"_buf));
+  for (auto &root : {cleared, next}) {
+    ASSERT_TRUE(flat_state_->hasState(root));
+    expectSameValues(root, keys_);
+  }
+}
+
+/**
+ * @given a finalized state and an unfinalized one on top of it
+ * @when the flat state is loaded from its storage once again
+ * @then both states are read from it
+ */
+TEST_F(FlatStateTest, StatesSurviveRestart) {
+  auto base = commitOn(serializer_->getEmptyRootHash(), [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "1"_buf));
+  });
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(base));
+  flat_state_->waitForRebuild();
+  auto next = commitOn(base, [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.remove("abc"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("b"_buf, "2"_buf));
+  });
+
+  flat_state_ = FlatState::create(storage_, "\2"_buf, serializer_).value();
+  for (auto &root : {base, next}) {
+    ASSERT_TRUE(flat_state_->hasState(root));
+    expectSameValues(root, keys_);
+  }
+}
+
+/**
+ * @given a state, the entries of which are rebuilt, and a state committed on
+ * top of it
+ * @when the latter is finalized before the rebuild is waited for
+ * @then it is applied once the entries are rebuilt, and is read from them
+ */
+TEST_F(FlatStateTest, FinalizedDuringRebuildIsApplied) {
+  auto base = commitOn(serializer_->getEmptyRootHash(), [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "1"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("b"_buf, "2"_buf));
+  });
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(base));
+  auto next = commitOn(base, [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.remove("abc"_buf));
+    EXPECT_OUTCOME_TRUE_1(batch.put("c"_buf, "3"_buf));
+  });
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(next));
+
+  flat_state_->waitForRebuild();
+  ASSERT_TRUE(flat_state_->hasState(next));
+  ASSERT_FALSE(flat_state_->hasState(base));
+  expectSameValues(next, keys_);
+}
+
+/**
+ * @given a finalized state and more states on top of it than the diffs kept
+ * in the memory
+ * @when the last of them is finalized
+ * @then the states past the limit are read from the trie until then, and
+ * their diffs are applied from the storage rather than rebuilt
+ */
+TEST_F(FlatStateTest, DiffsPastLimitAreApplied) {
+  auto root = commitOn(serializer_->getEmptyRootHash(), [](auto &batch) {
+    EXPECT_OUTCOME_TRUE_1(batch.put("abc"_buf, "0"_buf));
+  });
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(root));
+  flat_state_->waitForRebuild();
+
+  std::vector<Buffer> roots;
+  for (size_t i = 0; i < FlatState::kMaxDiffsNum + 2; ++i) {
+    root = commitOn(root, [i](auto &batch) {
+      EXPECT_OUTCOME_TRUE_1(batch.put("b"_buf, Buffer{}.putUint64(i)));
+      if (i % 2 == 0) {
+        EXPECT_OUTCOME_TRUE_1(batch.clearPrefix("ab"_buf));
+      } else {
+        EXPECT_OUTCOME_TRUE_1(batch.put("abd"_buf, Buffer{}.putUint64(i)));
+      }
+    });
+    roots.push_back(root);
+  }
+  ASSERT_TRUE(flat_state_->hasState(roots[FlatState::kMaxDiffsNum - 1]));
+  ASSERT_FALSE(flat_state_->hasState(roots[FlatState::kMaxDiffsNum]));
+  EXPECT_OUTCOME_FALSE_1(flat_state_->get(root, "b"_buf));
+
+  EXPECT_OUTCOME_TRUE_1(flat_state_->finalize(root));
+  // applied right away, there is no rebuild to wait for
+  ASSERT_TRUE(flat_state_->hasState(root));
+  expectSameValues(root, keys_);
+}
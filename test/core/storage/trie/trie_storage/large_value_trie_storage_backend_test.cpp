@@ -0,0 +1,120 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/large_value_trie_storage_backend.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LargeValueTrieStorageBackend;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::NibbleView;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotNode;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+class LargeValueTrieStorageBackendTest : public testing::Test {
+ public:
+  static constexpr size_t kThreshold = 64;
+
+  std::shared_ptr<InMemoryStorage> storage =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<LargeValueTrieStorageBackend> backend =
+      std::make_shared<LargeValueTrieStorageBackend>(
+          std::make_shared<TrieStorageBackendImpl>(storage, Buffer{1}),
+          kThreshold);
+  PolkadotCodec codec;
+};
+
+/**
+ * @given nodes with a small and with a large value
+ * @when they are put to the backend
+ * @then the large value is stored apart from its node and is not read with
+ * it, while both nodes are read whole as they were put
+ */
+TEST_F(LargeValueTrieStorageBackendTest, SplitsLargeValue) {
+  LeafNode small{KeyNibbles{1, 2}, Buffer(kThreshold / 2, 1)};
+  LeafNode large{KeyNibbles{3, 4, 5}, Buffer(kThreshold * 2, 2)};
+  EXPECT_OUTCOME_TRUE(small_enc, codec.encodeNode(small));
+  EXPECT_OUTCOME_TRUE(large_enc, codec.encodeNode(large));
+  EXPECT_OUTCOME_TRUE_1(backend->put("small"_buf, small_enc));
+  EXPECT_OUTCOME_TRUE_1(backend->put("large"_buf, large_enc));
+
+  EXPECT_OUTCOME_TRUE(small_node, backend->getNodeWithoutValue("small"_buf));
+  ASSERT_FALSE(small_node.second);
+  ASSERT_EQ(Buffer{small_node.first.view()}, small_enc);
+
+  EXPECT_OUTCOME_TRUE(large_node, backend->getNodeWithoutValue("large"_buf));
+  ASSERT_TRUE(large_node.second);
+  EXPECT_OUTCOME_TRUE(decoded, codec.decodeNode(large_node.first.view()));
+  auto &leaf = dynamic_cast<const PolkadotNode &>(*decoded);
+  ASSERT_EQ(leaf.key_nibbles, large.key_nibbles);
+  ASSERT_TRUE(leaf.value.get().empty());
+  EXPECT_OUTCOME_TRUE(value, backend->getNodeValue("large"_buf));
+  ASSERT_EQ(value, large.value.get());
+
+  EXPECT_OUTCOME_TRUE(whole, backend->get("large"_buf));
+  ASSERT_EQ(whole, large_enc);
+
+  EXPECT_OUTCOME_TRUE_1(backend->remove("large"_buf));
+  ASSERT_FALSE(backend->contains("large"_buf));
+  ASSERT_FALSE(
+      backend->contains(LargeValueTrieStorageBackend::valueKey("large"_buf)));
+}
+
+/**
+ * @given a trie with a large value stored through the backend
+ * @when the trie is retrieved and modified
+ * @then the large value is read only once it is looked up or its node is
+ * encoded again, and the modified trie has the root it would have without
+ * the backend
+ */
+TEST_F(LargeValueTrieStorageBackendTest, ReadsValueOnDemand) {
+  TrieSerializerImpl serializer{std::make_shared<PolkadotTrieFactoryImpl>(),
+                                std::make_shared<PolkadotCodec>(),
+                                backend,
+                                std::make_shared<TrieNodeCache>(16)};
+  auto large_value = Buffer(kThreshold * 2, 2);
+  EXPECT_OUTCOME_TRUE(trie,
+                      serializer.retrieveTrie(serializer.getEmptyRootHash()));
+  EXPECT_OUTCOME_TRUE_1(trie->put("large"_buf, large_value));
+  EXPECT_OUTCOME_TRUE_1(trie->put("small"_buf, "value"_buf));
+  EXPECT_OUTCOME_TRUE(root, serializer.storeTrie(*trie));
+
+  EXPECT_OUTCOME_TRUE(retrieved, serializer.retrieveTrie(root));
+  EXPECT_OUTCOME_TRUE(
+      large_node,
+      retrieved->getNode(retrieved->getRoot(), NibbleView::ofKey("large"_buf)));
+  ASSERT_TRUE(large_node->value.has_value());
+  ASSERT_FALSE(large_node->value.isLoaded());
+  EXPECT_OUTCOME_TRUE(large, retrieved->get("large"_buf));
+  ASSERT_EQ(large, large_value);
+  ASSERT_TRUE(large_node->value.isLoaded());
+
+  EXPECT_OUTCOME_TRUE(modified, serializer.retrieveTrie(root));
+  // the leaf with the large value gets a shorter partial key
+  EXPECT_OUTCOME_TRUE_1(modified->put("large2"_buf, "value"_buf));
+  EXPECT_OUTCOME_TRUE(modified_root, serializer.storeTrie(*modified));
+
+  EXPECT_OUTCOME_TRUE(expected,
+                      serializer.retrieveTrie(serializer.getEmptyRootHash()));
+  EXPECT_OUTCOME_TRUE_1(expected->put("large"_buf, large_value));
+  EXPECT_OUTCOME_TRUE_1(expected->put("small"_buf, "value"_buf));
+  EXPECT_OUTCOME_TRUE_1(expected->put("large2"_buf, "value"_buf));
+  EXPECT_OUTCOME_TRUE(expected_root, serializer.calculateRoot(*expected));
+  ASSERT_EQ(modified_root, expected_root);
+}
@@ -6,6 +6,9 @@
 #include "storage/trie/serialization/ordered_trie_hash.hpp"
 
 #include <gtest/gtest.h>
+#include "scale/scale.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
 #include "testutil/literals.hpp"
 #include "testutil/outcome.hpp"
 
@@ -64,3 +67,36 @@ TEST(OrderedTrieHash, TwoValueVectorErr2) {
   ASSERT_EQ(kagome::common::hex_lower(val),
             "5147323d593b7bb01fe8ea3e9d5a4bba0497c7f47b5daa121f4a6d791164d60b");
 }
+
+/**
+ * @given sets of values of different sizes, including the ones which keys
+ * take several bytes in compact encoding
+ * @when calculating their ordered trie hash
+ * @then it is the same as the root hash of a trie built with the values by
+ * compact-encoded indices
+ */
+TEST(OrderedTrieHash, SameAsTrieRoot) {
+  using kagome::common::Buffer;
+  using kagome::storage::trie::PolkadotCodec;
+  using kagome::storage::trie::PolkadotTrieImpl;
+  for (size_t size : {1, 2, 15, 16, 17, 64, 65, 255, 256, 1000, 16400}) {
+    std::vector<Buffer> vals;
+    PolkadotTrieImpl trie;
+    for (size_t i = 0; i < size; i++) {
+      // both short values, which are inlined into their parents, and long
+      // ones, which are hashed
+      vals.emplace_back(Buffer{}.putUint32(i).put(std::vector<uint8_t>(
+          i % 3 == 0 ? 40 : i % 3, 0xab)));
+      EXPECT_OUTCOME_TRUE(
+          key, kagome::scale::encode(kagome::scale::CompactInteger{i}));
+      EXPECT_OUTCOME_TRUE_1(trie.put(Buffer{key}, vals.back()));
+    }
+    PolkadotCodec codec;
+    EXPECT_OUTCOME_TRUE(enc, codec.encodeNode(*trie.getRoot()));
+
+    EXPECT_OUTCOME_TRUE(val,
+                        kagome::storage::trie::calculateOrderedTrieHash(
+                            vals.begin(), vals.end()));
+    ASSERT_EQ(val, Buffer{codec.hash256(enc)}) << "size " << size;
+  }
+}
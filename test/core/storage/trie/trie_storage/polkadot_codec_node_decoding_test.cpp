@@ -33,6 +33,34 @@ TEST_P(NodeDecodingTest, GetHeader) {
   EXPECT_EQ(decoded_node->value, node->value);
 }
 
+/**
+ * @given a branch with children, which encodings are shorter than a hash
+ * @when the encoding of the branch is decoded
+ * @then the children are decoded from it, as they are not stored apart
+ */
+TEST(NodeDecodingInlineTest, ShortChildrenAreDecodedInline) {
+  auto codec = std::make_unique<PolkadotCodec>();
+  auto node =
+      std::make_shared<BranchNode>(KeyNibbles{"010203"_hex2buf}, "0a"_hex2buf);
+  node->children.set(
+      0, std::make_shared<LeafNode>(KeyNibbles{"01"_hex2buf}, "0b"_hex2buf));
+  node->children.set(
+      5, std::make_shared<LeafNode>(KeyNibbles{"02"_hex2buf}, "0c"_hex2buf));
+
+  EXPECT_OUTCOME_TRUE(encoded, codec->encodeNode(*node));
+  EXPECT_OUTCOME_TRUE(decoded, codec->decodeNode(encoded));
+  auto &children = std::dynamic_pointer_cast<BranchNode>(decoded)->children;
+  for (auto [idx, value] : {std::make_pair(0, "0b"_hex2buf),
+                            std::make_pair(5, "0c"_hex2buf)}) {
+    auto &child = children.at(idx);
+    ASSERT_FALSE(child->isDummy());
+    ASSERT_FALSE(child->isDirty());
+    EXPECT_EQ(child->value, value);
+    EXPECT_OUTCOME_TRUE(child_encoded, codec->encodeNode(*child));
+    EXPECT_EQ(child->merkle_value, child_encoded);
+  }
+}
+
 template <typename T>
 std::shared_ptr<PolkadotNode> make(const common::Buffer &key_nibbles,
                                    const common::Buffer &value) {
@@ -49,8 +77,8 @@ std::shared_ptr<PolkadotNode> branch_with_2_children = []() {
       std::make_shared<LeafNode>(KeyNibbles{"01"_hex2buf}, "0b"_hex2buf);
   auto child2 =
       std::make_shared<LeafNode>(KeyNibbles{"02"_hex2buf}, "0c"_hex2buf);
-  node->children[0] = child1;
-  node->children[1] = child2;
+  node->children.set(0, child1);
+  node->children.set(1, child2);
   return node;
 }();
 
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include <gtest/gtest.h>
+#include "scale/scale.hpp"
 #include "storage/trie/polkadot_trie/polkadot_node.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
 #include "testutil/outcome.hpp"
@@ -86,3 +87,42 @@ static const std::vector<Case> CASES = {
 };
 
 INSTANTIATE_TEST_CASE_P(PolkadotCodec, NodeEncodingTest, ValuesIn(CASES));
+
+/**
+ * @given a branch with a long value, a stored child, and modified children
+ * with short and long encodings
+ * @when the branch is encoded to the end of a non-empty buffer
+ * @then the bytes before are kept and the encoding appended is the one of
+ * the specification, with the modified children replaced by their merkle
+ * values
+ */
+TEST(NodeEncodingToTest, AppendsSpecificationEncoding) {
+  PolkadotCodec codec;
+  auto node = std::make_shared<BranchNode>(KeyNibbles{Buffer{1, 2, 3}},
+                                           Buffer(100, 0xab));
+  auto stored = Buffer(32, 0xcd);
+  node->children.set(0, std::make_shared<DummyNode>(stored));
+  auto short_child =
+      std::make_shared<LeafNode>(KeyNibbles{Buffer{4}}, Buffer{0x05});
+  node->children.set(3, short_child);
+  auto long_child =
+      std::make_shared<LeafNode>(KeyNibbles{Buffer{6}}, Buffer(70, 0x07));
+  node->children.set(15, long_child);
+
+  EXPECT_OUTCOME_TRUE(short_enc, codec.encodeNode(*short_child));
+  EXPECT_OUTCOME_TRUE(long_enc, codec.encodeNode(*long_child));
+  ASSERT_LT(short_enc.size(), Hash256::size());
+  ASSERT_GE(long_enc.size(), Hash256::size());
+  auto expected = Buffer{BRANCH_VAL | 3u, 0x01, 0x23, 0x09, 0x80};
+  expected.put(scale::encode(Buffer(100, 0xab)).value())
+      .put(scale::encode(stored).value())
+      .put(scale::encode(short_enc).value())
+      .put(scale::encode(Buffer{codec.hash256(long_enc)}).value());
+
+  Buffer out{0xff, 0xee};
+  EXPECT_OUTCOME_TRUE_1(codec.encodeNodeTo(*node, out));
+  EXPECT_EQ(out.subbuffer(0, 2), (Buffer{0xff, 0xee}));
+  EXPECT_EQ(out.subbuffer(2).toHex(), expected.toHex());
+  EXPECT_OUTCOME_TRUE(encoded, codec.encodeNode(*node));
+  EXPECT_EQ(encoded, expected);
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/sorted_trie_builder.hpp"
+
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactory;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::SortedTrieBuilder;
+using kagome::storage::trie::SortedTrieBuilderError;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TriePrunerImpl;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+class SortedTrieBuilderTest : public testing::Test {
+ public:
+  using Entries = std::map<Buffer, Buffer>;
+
+  /**
+   * @return the entries of the keys of random lengths up to \arg key_size,
+   * many of which are the prefixes of the others, and of the values both
+   * shorter and longer than a hash, so that some of the nodes are inlined
+   */
+  static Entries makeEntries(size_t size, size_t key_size) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<size_t> length(0, key_size);
+    std::uniform_int_distribution<int> byte(0, 3);
+    Entries entries;
+    while (entries.size() < size) {
+      Buffer key(length(rng), 0);
+      for (auto &b : key) {
+        b = byte(rng) * 0x31;
+      }
+      entries[key] = Buffer(key.size() % 2 == 0 ? 2 : 40, key.size());
+    }
+    return entries;
+  }
+
+  /**
+   * @return the root of \arg entries stored by the serializer of a trie
+   */
+  Buffer referenceRoot(const Entries &entries) {
+    auto trie = factory_->createEmpty();
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE_1(trie->put(key, value));
+    }
+    TrieSerializerImpl serializer{
+        factory_,
+        codec_,
+        std::make_shared<TrieStorageBackendImpl>(
+            std::make_shared<InMemoryStorage>(), "\1"_buf),
+        std::make_shared<TrieNodeCache>(0)};
+    EXPECT_OUTCOME_TRUE(root, serializer.storeTrie(*trie));
+    return root;
+  }
+
+  Buffer build(SortedTrieBuilder &builder, const Entries &entries) {
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE_1(builder.add(key, value));
+    }
+    EXPECT_OUTCOME_TRUE(root, builder.finish());
+    return root;
+  }
+
+  /**
+   * Checks that the state with \arg root read from the storage has just
+   * \arg entries
+   */
+  void expectState(const Buffer &root, const Entries &entries) {
+    EXPECT_OUTCOME_TRUE(trie, serializer_->retrieveTrie(root));
+    for (auto &[key, value] : entries) {
+      EXPECT_OUTCOME_TRUE(stored, trie->get(key));
+      ASSERT_EQ(stored, value);
+    }
+    auto cursor = trie->cursor();
+    EXPECT_OUTCOME_TRUE_1(cursor->next());
+    size_t count = 0;
+    while (cursor->isValid()) {
+      ++count;
+      EXPECT_OUTCOME_TRUE_1(cursor->next());
+    }
+    ASSERT_EQ(count, entries.size());
+  }
+
+  std::shared_ptr<PolkadotCodec> codec_ = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<PolkadotTrieFactory> factory_ =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<InMemoryStorage> storage_ =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieStorageBackendImpl> backend_ =
+      std::make_shared<TrieStorageBackendImpl>(storage_, "\1"_buf);
+  // the node cache is disabled, so that the nodes are read from the storage
+  std::shared_ptr<TrieSerializerImpl> serializer_ =
+      std::make_shared<TrieSerializerImpl>(
+          factory_, codec_, backend_, std::make_shared<TrieNodeCache>(0));
+};
+
+/**
+ * @given the sorted entries of the keys, which are prefixes of each other,
+ * including the empty one, more of them than are written in a batch
+ * @when the trie of them is built
+ * @then its root is the one the serializer stores the trie of them with,
+ * and the state is read from the storage with all the entries
+ */
+TEST_F(SortedTrieBuilderTest, BuildsTrieOfSerializer) {
+  for (auto [size, key_size] : {std::pair<size_t, size_t>{1, 4},
+                                {2, 1},
+                                {100, 4},
+                                {SortedTrieBuilder::kNodesPerBatch * 2, 8}}) {
+    auto entries = makeEntries(size, key_size);
+    SortedTrieBuilder builder{codec_, backend_};
+    auto root = build(builder, entries);
+    ASSERT_EQ(root, referenceRoot(entries));
+    expectState(root, entries);
+  }
+}
+
+/**
+ * @given no entries
+ * @when the trie is built
+ * @then it is the empty one, and nothing is stored
+ */
+TEST_F(SortedTrieBuilderTest, Empty) {
+  SortedTrieBuilder builder{codec_, backend_};
+  EXPECT_OUTCOME_TRUE(root, builder.finish());
+  ASSERT_EQ(root, serializer_->getEmptyRootHash());
+  ASSERT_TRUE(storage_->empty());
+}
+
+/**
+ * @given a builder with some entries
+ * @when a key less than the last one, or the same one, is added
+ * @then it is refused, and the trie of the entries before is built
+ */
+TEST_F(SortedTrieBuilderTest, UnsortedKeys) {
+  SortedTrieBuilder builder{codec_, backend_};
+  EXPECT_OUTCOME_TRUE_1(builder.add("ab"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(builder.add("abc"_buf, "2"_buf));
+  EXPECT_OUTCOME_ERROR(same,
+                       builder.add("abc"_buf, "3"_buf),
+                       SortedTrieBuilderError::UNSORTED_KEYS);
+  EXPECT_OUTCOME_ERROR(prefix,
+                       builder.add("a"_buf, "3"_buf),
+                       SortedTrieBuilderError::UNSORTED_KEYS);
+  EXPECT_OUTCOME_ERROR(less,
+                       builder.add("aa"_buf, "3"_buf),
+                       SortedTrieBuilderError::UNSORTED_KEYS);
+  EXPECT_OUTCOME_TRUE(root, builder.finish());
+  Entries entries{{"ab"_buf, "1"_buf}, {"abc"_buf, "2"_buf}};
+  ASSERT_EQ(root, referenceRoot(entries));
+}
+
+/**
+ * @given a builder with a pruner
+ * @when a trie is built and its state is pruned afterwards
+ * @then the nodes are written by the pruner, and are all removed with the
+ * state, as their references are counted
+ */
+TEST_F(SortedTrieBuilderTest, Pruner) {
+  auto ref_counts = std::make_shared<InMemoryStorage>();
+  auto pruner = std::make_shared<TriePrunerImpl>(
+      backend_,
+      std::make_shared<TrieStorageBackendImpl>(ref_counts, "\2"_buf),
+      codec_);
+  auto entries = makeEntries(200, 6);
+  SortedTrieBuilder builder{codec_, backend_, pruner};
+  auto root = build(builder, entries);
+  ASSERT_EQ(root, referenceRoot(entries));
+  expectState(root, entries);
+
+  EXPECT_OUTCOME_TRUE_1(pruner->pruneState(root));
+  ASSERT_TRUE(storage_->empty());
+  ASSERT_TRUE(ref_counts->empty());
+}
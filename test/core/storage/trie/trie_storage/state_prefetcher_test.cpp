@@ -0,0 +1,96 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_prefetcher.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::primitives::Extrinsic;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::StatePrefetcher;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class StatePrefetcherTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto serializer = makeSerializer(std::make_shared<TrieNodeCache>(0));
+    auto trie = TrieStorageImpl::createEmpty(
+                    factory_, codec_, serializer, boost::none)
+                    .value();
+    auto batch = trie->getPersistentBatch().value();
+    for (uint8_t i = 0; i < 64; i++) {
+      EXPECT_OUTCOME_TRUE_1(batch->put(Buffer{i, i}, Buffer(40, i)));
+    }
+    root_ = Hash256::fromSpan(batch->commit().value()).value();
+
+    // the nodes are read by the prefetcher from the storage, not the cache
+    prefetcher_ = std::make_unique<StatePrefetcher>(
+        makeSerializer(cache_), 2);
+  }
+
+  std::shared_ptr<TrieSerializerImpl> makeSerializer(
+      std::shared_ptr<TrieNodeCache> cache) const {
+    return std::make_shared<TrieSerializerImpl>(
+        factory_,
+        codec_,
+        std::make_shared<TrieStorageBackendImpl>(storage_, "\1"_buf),
+        std::move(cache));
+  }
+
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory_ =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<PolkadotCodec> codec_ = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<InMemoryStorage> storage_ =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieNodeCache> cache_ = std::make_shared<TrieNodeCache>(1024);
+  Hash256 root_;
+  std::unique_ptr<StatePrefetcher> prefetcher_;
+};
+
+/**
+ * @given keys recorded for an extrinsic and for the previous block
+ * @when a block with the extrinsic and an unknown one is prefetched
+ * @then the recorded keys are looked up once each, leaving the nodes on
+ * their paths in the cache
+ */
+TEST_F(StatePrefetcherTest, RecordedKeysAreLookedUp) {
+  Extrinsic known{"0102"_hex2buf};
+  Extrinsic unknown{"0304"_hex2buf};
+  prefetcher_->recordExtrinsic(known, {Buffer{1, 1}, Buffer{2, 2}});
+  prefetcher_->recordBlock({Buffer{2, 2}, Buffer{3, 3}});
+
+  ASSERT_EQ(prefetcher_->prefetch(root_, {known, unknown}), 3);
+  prefetcher_->waitIdle();
+  // the root and a leaf per key at least
+  ASSERT_GE(cache_->size(), 4);
+}
+
+/**
+ * @given no recorded keys
+ * @when a block is prefetched
+ * @then nothing is looked up
+ */
+TEST_F(StatePrefetcherTest, NothingRecorded) {
+  ASSERT_EQ(prefetcher_->prefetch(root_, {Extrinsic{"01"_hex2buf}}), 0);
+  prefetcher_->waitIdle();
+  ASSERT_EQ(cache_->size(), 0);
+}
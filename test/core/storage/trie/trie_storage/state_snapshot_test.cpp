@@ -0,0 +1,161 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_snapshot_file.hpp"
+
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/snapshot_trie_storage_backend.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+#include "testutil/storage/base_fs_test.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrie;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::SnapshotTrieStorageBackend;
+using kagome::storage::trie::StateSnapshotError;
+using kagome::storage::trie::StateSnapshotFile;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+class StateSnapshotTest : public test::BaseFS_Test {
+ public:
+  StateSnapshotTest() : test::BaseFS_Test("/tmp/kagome_state_snapshot") {}
+
+  void SetUp() override {
+    BaseFS_Test::SetUp();
+    serializer = makeSerializer(backend);
+  }
+
+  std::shared_ptr<TrieSerializerImpl> makeSerializer(
+      std::shared_ptr<kagome::storage::trie::TrieStorageBackend> nodes) {
+    // the node cache is disabled, so that the nodes are read from the
+    // storage
+    return std::make_shared<TrieSerializerImpl>(
+        factory, codec, std::move(nodes), std::make_shared<TrieNodeCache>(0));
+  }
+
+  /**
+   * Fills \arg trie with values long enough for the nodes not to be inlined
+   * into their parents, along with a few inlined ones
+   */
+  static void fillTrie(PolkadotTrie &trie, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      auto key = Buffer{}.putUint32(i * 0x01010101);
+      EXPECT_OUTCOME_TRUE_1(trie.put(key, valueOf(key)));
+      EXPECT_OUTCOME_TRUE_1(trie.put(Buffer{key}.putUint8(0), "short"_buf));
+    }
+  }
+
+  static Buffer valueOf(const Buffer &key) {
+    return Buffer{key}.put(std::vector<uint8_t>(40, 0xab));
+  }
+
+  /**
+   * @return root of a state filled by fillTrie and stored to the backend
+   */
+  Hash256 storeState() {
+    EXPECT_OUTCOME_TRUE(
+        trie, serializer->retrieveTrie(serializer->getEmptyRootHash()));
+    fillTrie(*trie, kSize);
+    EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(*trie));
+    return Hash256::fromSpan(root).value();
+  }
+
+  std::string snapshotPath() const {
+    return (base_path / "state.snapshot").string();
+  }
+
+  static constexpr size_t kSize = 64;
+
+  std::shared_ptr<PolkadotCodec> codec = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<InMemoryStorage> storage =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TrieStorageBackendImpl> backend =
+      std::make_shared<TrieStorageBackendImpl>(storage, "\1"_buf);
+  std::shared_ptr<TrieSerializerImpl> serializer;
+};
+
+/**
+ * @given a state stored to the database
+ * @when exporting a snapshot of it and reading the state through the
+ * snapshot on top of an empty database
+ * @then all the values of the state are read from the snapshot
+ */
+TEST_F(StateSnapshotTest, ExportedStateIsReadFromSnapshot) {
+  auto root = storeState();
+  EXPECT_OUTCOME_TRUE_1(
+      StateSnapshotFile::exportState(snapshotPath(), root, *backend, *codec));
+
+  EXPECT_OUTCOME_TRUE(file, StateSnapshotFile::open(snapshotPath()));
+  ASSERT_EQ(file->getRootHash(), root);
+  ASSERT_GT(file->size(), kSize);
+
+  auto fresh_backend = std::make_shared<TrieStorageBackendImpl>(
+      std::make_shared<InMemoryStorage>(), "\1"_buf);
+  auto snapshot_backend =
+      std::make_shared<SnapshotTrieStorageBackend>(file, fresh_backend);
+  auto snapshot_serializer = makeSerializer(snapshot_backend);
+  EXPECT_OUTCOME_TRUE(trie, snapshot_serializer->retrieveTrie(Buffer{root}));
+  for (size_t i = 0; i < kSize; i++) {
+    auto key = Buffer{}.putUint32(i * 0x01010101);
+    EXPECT_OUTCOME_TRUE(value, trie->get(key));
+    ASSERT_EQ(value, valueOf(key));
+    EXPECT_OUTCOME_TRUE(short_value, trie->get(Buffer{key}.putUint8(0)));
+    ASSERT_EQ(short_value, "short"_buf);
+  }
+
+  // the state derived from the snapshot goes to the database
+  EXPECT_OUTCOME_TRUE_1(trie->put("new_key"_buf, valueOf("new_key"_buf)));
+  EXPECT_OUTCOME_TRUE(new_root, snapshot_serializer->storeTrie(*trie));
+  ASSERT_TRUE(fresh_backend->contains(new_root));
+  ASSERT_FALSE(fresh_backend->contains(Buffer{root}));
+  ASSERT_TRUE(snapshot_backend->contains(Buffer{root}));
+}
+
+/**
+ * @given a snapshot file
+ * @when looking up a key which is not in it
+ * @then nothing is found
+ */
+TEST_F(StateSnapshotTest, AbsentNodeIsNotFound) {
+  auto root = storeState();
+  EXPECT_OUTCOME_TRUE_1(
+      StateSnapshotFile::exportState(snapshotPath(), root, *backend, *codec));
+  EXPECT_OUTCOME_TRUE(file, StateSnapshotFile::open(snapshotPath()));
+
+  ASSERT_FALSE(file->find(Hash256{}));
+  ASSERT_FALSE(file->find("short"_buf));
+  ASSERT_TRUE(file->find(root));
+}
+
+/**
+ * @given a file, which is not a snapshot
+ * @when opening it as a snapshot
+ * @then an error is returned
+ */
+TEST_F(StateSnapshotTest, MalformedFileIsRejected) {
+  std::ofstream{snapshotPath()} << std::string(128, 'x');
+  EXPECT_OUTCOME_ERROR(res,
+                       StateSnapshotFile::open(snapshotPath()),
+                       StateSnapshotError::INVALID_FORMAT);
+  EXPECT_OUTCOME_ERROR(missing,
+                       StateSnapshotFile::open(snapshotPath() + ".missing"),
+                       StateSnapshotError::CANNOT_OPEN_FILE);
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/state_walker.hpp"
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::common::WorkerPool;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotNode;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::StateWalker;
+using kagome::storage::trie::TrieError;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class StateWalkerTest : public testing::Test {
+ public:
+  /// threads of the pool, the calling one is a worker as well
+  static constexpr size_t kThreads = 2;
+
+  void SetUp() override {
+    auto trie = TrieStorageImpl::createEmpty(
+                    factory_, codec_, serializer_, boost::none)
+                    .value();
+    auto batch = trie->getPersistentBatch().value();
+    for (size_t i = 0; i < 512; i++) {
+      Buffer key{static_cast<uint8_t>(i * 7), static_cast<uint8_t>(i / 3)};
+      EXPECT_OUTCOME_TRUE_1(
+          batch->put(key, Buffer(40, static_cast<uint8_t>(i))));
+      keys_.insert(key);
+    }
+    root_ = batch->commit().value();
+  }
+
+  std::shared_ptr<PolkadotTrieFactoryImpl> factory_ =
+      std::make_shared<PolkadotTrieFactoryImpl>();
+  std::shared_ptr<PolkadotCodec> codec_ = std::make_shared<PolkadotCodec>();
+  std::shared_ptr<TrieSerializerImpl> serializer_ =
+      std::make_shared<TrieSerializerImpl>(
+          factory_,
+          codec_,
+          std::make_shared<TrieStorageBackendImpl>(
+              std::make_shared<InMemoryStorage>(), "\1"_buf),
+          std::make_shared<TrieNodeCache>(0));
+  StateWalker walker_{serializer_, std::make_shared<WorkerPool>(kThreads)};
+  std::set<Buffer> keys_;
+  Buffer root_;
+};
+
+/**
+ * @given a state
+ * @when it is walked by several workers
+ * @then every key with a value is visited once, and the nodes are spread
+ * over the workers
+ */
+TEST_F(StateWalkerTest, VisitsEveryNode) {
+  // each worker collects its keys apart, so the visitor is not locked
+  std::vector<std::vector<Buffer>> visited(walker_.workersNum());
+  EXPECT_OUTCOME_TRUE_1(walker_.walk(
+      root_,
+      [&](size_t worker, const KeyNibbles &key, const PolkadotNode &node)
+          -> outcome::result<void> {
+        if (node.value) {
+          visited.at(worker).push_back(PolkadotCodec::nibblesToKey(key));
+        }
+        return outcome::success();
+      }));
+
+  std::multiset<Buffer> all;
+  size_t busy = 0;
+  for (auto &keys : visited) {
+    all.insert(keys.begin(), keys.end());
+    busy += keys.empty() ? 0 : 1;
+  }
+  ASSERT_EQ(all, std::multiset<Buffer>(keys_.begin(), keys_.end()));
+  ASSERT_GT(busy, 1);
+}
+
+/**
+ * @given a state
+ * @when the visitor fails on a node
+ * @then the walk fails with its error
+ */
+TEST_F(StateWalkerTest, StopsOnError) {
+  auto failing = *std::next(keys_.begin(), keys_.size() / 2);
+  auto res = walker_.walk(
+      root_,
+      [&](size_t, const KeyNibbles &key, const PolkadotNode &node)
+          -> outcome::result<void> {
+        if (node.value and PolkadotCodec::nibblesToKey(key) == failing) {
+          return TrieError::NO_VALUE;
+        }
+        return outcome::success();
+      });
+  ASSERT_FALSE(res);
+  ASSERT_EQ(res.error(), TrieError::NO_VALUE);
+}
+
+/**
+ * @given an empty state
+ * @when it is walked
+ * @then nothing is visited
+ */
+TEST_F(StateWalkerTest, EmptyState) {
+  size_t visited = 0;
+  EXPECT_OUTCOME_TRUE_1(walker_.walk(
+      serializer_->getEmptyRootHash(),
+      [&](size_t, const KeyNibbles &, const PolkadotNode &)
+          -> outcome::result<void> {
+        ++visited;
+        return outcome::success();
+      }));
+  ASSERT_EQ(visited, 0);
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/topper_trie_batch_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/impl/trie_storage_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PersistentTrieBatch;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TopperTrieBatch;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+using kagome::storage::trie::TrieStorageImpl;
+
+class TopperTrieBatchTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto serializer = std::make_shared<TrieSerializerImpl>(
+        factory,
+        codec,
+        std::make_shared<TrieStorageBackendImpl>(
+            std::make_shared<InMemoryStorage>(), "\1"_buf),
+        std::make_shared<TrieNodeCache>(0));
+    trie_ =
+        TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+            .value();
+    parent_ = trie_->getPersistentBatch().value();
+  }
+
+  /**
+   * @return all the entries of \arg batch in the order of its cursor
+   */
+  static std::vector<std::pair<Buffer, Buffer>> entries(
+      TopperTrieBatch &batch) {
+    std::vector<std::pair<Buffer, Buffer>> result;
+    auto cursor = batch.cursor();
+    EXPECT_OUTCOME_TRUE_1(cursor->seekToFirst());
+    while (cursor->isValid()) {
+      EXPECT_OUTCOME_TRUE(key, cursor->key());
+      EXPECT_OUTCOME_TRUE(value, cursor->value());
+      result.emplace_back(key, value);
+      EXPECT_OUTCOME_TRUE_1(cursor->next());
+    }
+    return result;
+  }
+
+  std::unique_ptr<TrieStorageImpl> trie_;
+  std::shared_ptr<PersistentTrieBatch> parent_;
+};
+
+/**
+ * @given a topper batch with puts, removals and a cleared prefix on top of a
+ * batch with entries
+ * @when iterating over the topper batch
+ * @then entries of both batches are visited in order, the ones of the topper
+ * batch take precedence, and removed and cleared entries are skipped
+ */
+TEST_F(TopperTrieBatchTest, CursorMergesChanges) {
+  EXPECT_OUTCOME_TRUE_1(parent_->put("a"_buf, "1"_buf));
+  EXPECT_OUTCOME_TRUE_1(parent_->put("b"_buf, "2"_buf));
+  EXPECT_OUTCOME_TRUE_1(parent_->put("c1"_buf, "3"_buf));
+  EXPECT_OUTCOME_TRUE_1(parent_->put("c2"_buf, "4"_buf));
+  EXPECT_OUTCOME_TRUE_1(parent_->put("d"_buf, "5"_buf));
+
+  auto topper = parent_->batchOnTop();
+  EXPECT_OUTCOME_TRUE_1(topper->put("b"_buf, "new"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("bb"_buf, "6"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->remove("a"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("c"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->put("c3"_buf, "7"_buf));
+
+  std::vector<std::pair<Buffer, Buffer>> expected{{"b"_buf, "new"_buf},
+                                                  {"bb"_buf, "6"_buf},
+                                                  {"c3"_buf, "7"_buf},
+                                                  {"d"_buf, "5"_buf}};
+  ASSERT_EQ(entries(*topper), expected);
+
+  auto cursor = topper->cursor();
+  EXPECT_OUTCOME_TRUE_1(cursor->seekUpperBound("bb"_buf));
+  EXPECT_OUTCOME_TRUE(next_key, cursor->key());
+  ASSERT_EQ(next_key, "c3"_buf);
+  EXPECT_OUTCOME_TRUE_1(cursor->seek("d"_buf));
+  EXPECT_OUTCOME_TRUE(value, cursor->value());
+  ASSERT_EQ(value, "5"_buf);
+  ASSERT_FALSE(cursor->seek("c1"_buf));
+}
+
+/**
+ * @given a batch with entries
+ * @when prefixes are cleared in a topper batch on top of it, a longer one
+ * after a shorter one covering it and vice versa
+ * @then only the entries under the prefixes are absent in the topper batch,
+ * also after the changes are written back
+ */
+TEST_F(TopperTrieBatchTest, ClearPrefix) {
+  for (auto key : {"ab"_buf, "abc"_buf, "abd"_buf, "b"_buf, "x"_buf,
+                   "xy"_buf, "xyz"_buf, "y"_buf}) {
+    EXPECT_OUTCOME_TRUE_1(parent_->put(key, key));
+  }
+
+  auto topper = parent_->batchOnTop();
+  EXPECT_OUTCOME_TRUE_1(topper->put("abe"_buf, "abe"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("ab"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("xyz"_buf));
+  EXPECT_OUTCOME_TRUE_1(topper->clearPrefix("xy"_buf));
+
+  for (auto key : {"ab"_buf, "abc"_buf, "abd"_buf, "abe"_buf, "xy"_buf,
+                   "xyz"_buf}) {
+    ASSERT_FALSE(topper->contains(key)) << key.toHex();
+  }
+  for (auto key : {"b"_buf, "x"_buf, "y"_buf}) {
+    ASSERT_TRUE(topper->contains(key)) << key.toHex();
+  }
+  // a key shorter than a cleared prefix isn't cleared by it
+  ASSERT_TRUE(topper->contains("x"_buf));
+
+  std::vector<std::pair<Buffer, Buffer>> expected{
+      {"b"_buf, "b"_buf}, {"x"_buf, "x"_buf}, {"y"_buf, "y"_buf}};
+  ASSERT_EQ(entries(*topper), expected);
+
+  EXPECT_OUTCOME_TRUE_1(topper->writeBack());
+  ASSERT_FALSE(parent_->contains("abd"_buf));
+  ASSERT_FALSE(parent_->contains("xyz"_buf));
+  ASSERT_TRUE(parent_->contains("x"_buf));
+}
@@ -6,12 +6,18 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "storage/changes_trie/impl/storage_changes_tracker_impl.hpp"
 #include "storage/in_memory/in_memory_storage.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/impl/trie_storage_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_impl.hpp"
 #include "storage/trie/polkadot_trie/trie_error.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "storage/trie/trie_batches.hpp"
 #include "storage/trie/impl/persistent_trie_batch_impl.hpp"
@@ -22,6 +28,7 @@
 using namespace kagome::storage::trie;
 using kagome::common::Buffer;
 using kagome::common::Hash256;
+using kagome::common::WorkerPool;
 using kagome::storage::face::WriteBatch;
 using testing::_;
 using testing::Invoke;
@@ -38,7 +45,11 @@ class TrieBatchTest : public test::BaseLevelDB_Test {
     auto serializer = std::make_shared<TrieSerializerImpl>(
         factory,
         codec,
-        std::make_shared<TrieStorageBackendImpl>(std::move(db_), kNodePrefix));
+        std::make_shared<TrieStorageBackendImpl>(std::move(db_), kNodePrefix),
+        std::make_shared<TrieNodeCache>(kNodeCacheSize),
+        nullptr,
+        nullptr,
+        std::make_shared<WorkerPool>(kWorkers));
 
     trie = TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
                .value();
@@ -49,6 +60,8 @@ class TrieBatchTest : public test::BaseLevelDB_Test {
   std::unique_ptr<TrieStorage> trie;
 
   static const Buffer kNodePrefix;
+  static constexpr size_t kNodeCacheSize = 1024;
+  static constexpr size_t kWorkers = 4;
 };
 
 const Buffer TrieBatchTest::kNodePrefix{1};
@@ -153,6 +166,35 @@ TEST_F(TrieBatchTest, Replace) {
   ASSERT_EQ(res, data[3].second);
 }
 
+/**
+ * @given a batch with changes
+ * @when the root is calculated, the batch is changed again and its root is
+ * calculated once more
+ * @then the changes are not written until the batch is commited, and each root
+ * is the one the batch would be commited with
+ */
+TEST_F(TrieBatchTest, CalculateRootDoesNotWrite) {
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE(root, batch->calculateRoot());
+  EXPECT_OUTCOME_FALSE_1(
+      trie->getEphemeralBatchAt(Hash256::fromSpan(root).value()));
+
+  EXPECT_OUTCOME_TRUE_1(batch->put(data[0].first, data[4].second));
+  EXPECT_OUTCOME_TRUE(new_root, batch->calculateRoot());
+  ASSERT_NE(new_root, root);
+  EXPECT_OUTCOME_FALSE_1(
+      trie->getEphemeralBatchAt(Hash256::fromSpan(new_root).value()));
+
+  EXPECT_OUTCOME_TRUE(commited_root, batch->commit());
+  ASSERT_EQ(commited_root, new_root);
+  EXPECT_OUTCOME_TRUE(read_batch,
+                      trie->getEphemeralBatchAt(
+                          Hash256::fromSpan(commited_root).value()));
+  EXPECT_OUTCOME_TRUE(res, read_batch->get(data[0].first));
+  ASSERT_EQ(res, data[4].second);
+}
+
 /**
  * @given a trie and its batch
  * @when commiting a batch during which an error occurs
@@ -178,7 +220,8 @@ TEST_F(TrieBatchTest, ConsistentOnFailure) {
   auto serializer = std::make_shared<TrieSerializerImpl>(
       factory,
       codec,
-      std::make_shared<TrieStorageBackendImpl>(std::move(db), kNodePrefix));
+      std::make_shared<TrieStorageBackendImpl>(std::move(db), kNodePrefix),
+      std::make_shared<TrieNodeCache>(kNodeCacheSize));
   auto trie =
       TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
            .value();
@@ -199,6 +242,63 @@ TEST_F(TrieBatchTest, ConsistentOnFailure) {
   ASSERT_EQ(trie->getRootHash(), old_root);
 }
 
+/**
+ * @given a batch with enough entries for its subtrees to be stored in parallel
+ * @when the batch is committed
+ * @then the root hash is the same as the one of the trie built in memory and
+ * all the entries are accessible after the commit
+ */
+TEST_F(TrieBatchTest, ParallelStore) {
+  auto batch = trie->getPersistentBatch().value();
+  PolkadotTrieImpl in_memory_trie;
+  for (uint32_t i = 0; i < TrieSerializerImpl::kParallelStoreThreshold; i++) {
+    auto key = Buffer{}.putUint32(i * 2654435761u);
+    auto value = Buffer{}.putUint32(i);
+    EXPECT_OUTCOME_TRUE_1(batch->put(key, value));
+    EXPECT_OUTCOME_TRUE_1(in_memory_trie.put(key, value));
+  }
+  EXPECT_OUTCOME_TRUE(root, batch->commit());
+
+  PolkadotCodec codec;
+  EXPECT_OUTCOME_TRUE(enc, codec.encodeNode(*in_memory_trie.getRoot()));
+  ASSERT_EQ(root, Buffer{codec.hash256(enc)});
+
+  auto read_batch = trie->getEphemeralBatch().value();
+  for (uint32_t i = 0; i < TrieSerializerImpl::kParallelStoreThreshold; i++) {
+    EXPECT_OUTCOME_TRUE(value,
+                        read_batch->get(Buffer{}.putUint32(i * 2654435761u)));
+    ASSERT_EQ(value, Buffer{}.putUint32(i));
+  }
+}
+
+/**
+ * @given a topper batch with changes on top of a persistent one
+ * @when getting several values at once from the topper batch
+ * @then its own changes take precedence over the values of the parent
+ */
+TEST_F(TrieBatchTest, TopperBatchGetMany) {
+  std::shared_ptr<PersistentTrieBatch> p_batch =
+      trie->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("123"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("678"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(p_batch->put("679"_buf, "abc"_buf));
+
+  auto t_batch = p_batch->batchOnTop();
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("345"_buf, "cde"_buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch->remove("123"_buf));
+  EXPECT_OUTCOME_TRUE_1(t_batch->put("678"_buf, "fgh"_buf));
+
+  std::vector<Buffer> keys{
+      "123"_buf, "345"_buf, "678"_buf, "679"_buf, "000"_buf};
+  EXPECT_OUTCOME_TRUE(values, t_batch->getMany(keys));
+  ASSERT_EQ(values.size(), keys.size());
+  ASSERT_FALSE(values[0]);
+  ASSERT_EQ(values[1].value(), "cde"_buf);
+  ASSERT_EQ(values[2].value(), "fgh"_buf);
+  ASSERT_EQ(values[3].value(), "abc"_buf);
+  ASSERT_FALSE(values[4]);
+}
+
 TEST_F(TrieBatchTest, TopperBatchAtomic) {
   std::shared_ptr<PersistentTrieBatch> p_batch = trie->getPersistentBatch().value();
   EXPECT_OUTCOME_TRUE_1(p_batch->put("123"_buf, "abc"_buf));
@@ -224,3 +324,169 @@ TEST_F(TrieBatchTest, TopperBatchAtomic) {
   ASSERT_TRUE(p_batch->contains("678"_buf));
   ASSERT_FALSE(p_batch->contains("123"_buf));
 }
+
+/**
+ * @given a snapshot of a committed state
+ * @when a new state is committed and the snapshot is read by several threads
+ * at once
+ * @then every thread reads the values of the state the snapshot was taken
+ * at, and the same snapshot is handed out for the same root
+ */
+TEST_F(TrieBatchTest, SnapshotIsolatedFromCommits) {
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE(old_root, batch->commit());
+  EXPECT_OUTCOME_TRUE(snapshot, trie->getSnapshot());
+  ASSERT_EQ(snapshot->getRootHash(), old_root);
+
+  EXPECT_OUTCOME_TRUE_1(batch->put("123456"_hex2buf, "43"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(batch->remove("1234"_hex2buf));
+  EXPECT_OUTCOME_TRUE(new_root, batch->commit());
+  ASSERT_NE(new_root, old_root);
+
+  std::vector<std::thread> readers;
+  std::atomic_size_t mismatches = 0;
+  for (size_t i = 0; i < 4; i++) {
+    readers.emplace_back([&] {
+      for (auto &[key, value] : data) {
+        auto res = snapshot->get(key);
+        if (not res or res.value() != value) {
+          mismatches++;
+        }
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(mismatches, 0);
+
+  EXPECT_OUTCOME_TRUE(
+      same_snapshot, trie->getSnapshotAt(Hash256::fromSpan(old_root).value()));
+  ASSERT_EQ(same_snapshot, snapshot);
+  EXPECT_OUTCOME_TRUE(new_snapshot, trie->getSnapshot());
+  ASSERT_EQ(new_snapshot->getRootHash(), new_root);
+  EXPECT_OUTCOME_TRUE(value, new_snapshot->get("123456"_hex2buf));
+  ASSERT_EQ(value, "43"_hex2buf);
+  ASSERT_FALSE(new_snapshot->contains("1234"_hex2buf));
+}
+
+/**
+ * @given snapshots of a state and of its successor, where a value is changed
+ * @when merkle values of the changed, an untouched and an absent key are got
+ * @then only the one of the changed key differs, and the absent key has none
+ */
+TEST_F(TrieBatchTest, SnapshotMerkleValueTracksValue) {
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE(old_snapshot, trie->getSnapshot());
+
+  EXPECT_OUTCOME_TRUE_1(batch->put("0a0b0c"_hex2buf, "cafebabe"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE(new_snapshot, trie->getSnapshot());
+
+  EXPECT_OUTCOME_TRUE(old_changed,
+                      old_snapshot->getMerkleValue("0a0b0c"_hex2buf));
+  EXPECT_OUTCOME_TRUE(new_changed,
+                      new_snapshot->getMerkleValue("0a0b0c"_hex2buf));
+  ASSERT_TRUE(old_changed and new_changed);
+  ASSERT_NE(old_changed, new_changed);
+
+  EXPECT_OUTCOME_TRUE(old_untouched,
+                      old_snapshot->getMerkleValue("010a0b"_hex2buf));
+  EXPECT_OUTCOME_TRUE(new_untouched,
+                      new_snapshot->getMerkleValue("010a0b"_hex2buf));
+  ASSERT_TRUE(old_untouched);
+  ASSERT_EQ(old_untouched, new_untouched);
+
+  EXPECT_OUTCOME_TRUE(absent, new_snapshot->getMerkleValue("0a0b"_hex2buf));
+  ASSERT_FALSE(absent);
+}
+
+/**
+ * @given a snapshot of a committed state
+ * @when a new state is committed and the snapshot is walked by several
+ * cursors in several threads at once
+ * @then every cursor walks the entries of the state the snapshot was taken
+ * at, in the order of the keys
+ */
+TEST_F(TrieBatchTest, SnapshotCursor) {
+  auto batch = trie->getPersistentBatch().value();
+  FillSmallTrieWithBatch(*batch);
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE(snapshot, trie->getSnapshot());
+
+  EXPECT_OUTCOME_TRUE_1(batch->put("0a"_hex2buf, "01"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(batch->remove("1234"_hex2buf));
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+
+  auto expected = data;
+  std::sort(expected.begin(), expected.end());
+  std::vector<std::thread> readers;
+  std::atomic_size_t mismatches = 0;
+  for (size_t i = 0; i < 4; i++) {
+    readers.emplace_back([&] {
+      std::vector<std::pair<Buffer, Buffer>> entries;
+      auto cursor = snapshot->cursor();
+      if (not cursor->seekToFirst()) {
+        mismatches++;
+        return;
+      }
+      while (cursor->isValid()) {
+        entries.emplace_back(cursor->key().value(), cursor->value().value());
+        if (not cursor->next()) {
+          break;
+        }
+      }
+      if (entries != expected) {
+        mismatches++;
+      }
+    });
+  }
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(mismatches, 0);
+}
+
+/**
+ * @given a committed state with the values long enough for every node to be
+ * stored by its hash
+ * @when a proof of the present keys and of the absent ones is built
+ * @then it contains every node once, and a trie made of the nodes of the
+ * proof only gives the same values for the keys
+ */
+TEST_F(TrieBatchTest, ReadProof) {
+  auto batch = trie->getPersistentBatch().value();
+  for (auto &entry : data) {
+    EXPECT_OUTCOME_TRUE_1(batch->put(entry.first, Buffer(40, entry.second[0])));
+  }
+  EXPECT_OUTCOME_TRUE_1(batch->commit());
+  EXPECT_OUTCOME_TRUE(root, Hash256::fromSpan(trie->getRootHash()));
+
+  std::vector<Buffer> keys{
+      "123456"_hex2buf, "010a0b"_hex2buf, "0a0b0d"_hex2buf, "010203"_hex2buf};
+  EXPECT_OUTCOME_TRUE(proof, trie->getProofAt(root, keys));
+  auto unique = proof;
+  std::sort(unique.begin(), unique.end());
+  ASSERT_EQ(std::unique(unique.begin(), unique.end()), unique.end());
+
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto proof_db = std::make_shared<kagome::storage::InMemoryStorage>();
+  for (auto &node : proof) {
+    auto key = Buffer{kNodePrefix}.put(codec->hash256(node));
+    EXPECT_OUTCOME_TRUE_1(proof_db->put(key, node));
+  }
+  TrieSerializerImpl proof_serializer{
+      std::make_shared<PolkadotTrieFactoryImpl>(),
+      codec,
+      std::make_shared<TrieStorageBackendImpl>(proof_db, kNodePrefix),
+      std::make_shared<TrieNodeCache>(kNodeCacheSize)};
+  EXPECT_OUTCOME_TRUE(proof_trie, proof_serializer.retrieveTrie(Buffer{root}));
+  EXPECT_OUTCOME_TRUE(snapshot, trie->getSnapshotAt(root));
+  EXPECT_OUTCOME_TRUE(proved, proof_trie->getMany(keys));
+  EXPECT_OUTCOME_TRUE(expected, snapshot->getMany(keys));
+  ASSERT_EQ(proved, expected);
+  ASSERT_FALSE(proved[2]);
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/serialization/trie_node_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include "mock/core/storage/trie/trie_storage_backend_mock.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::trie::BranchNode;
+using kagome::storage::trie::DummyNode;
+using kagome::storage::trie::KeyNibbles;
+using kagome::storage::trie::LeafNode;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendMock;
+using testing::Return;
+
+/**
+ * @given a node cache with a leaf in it
+ * @when the leaf is obtained from the cache and modified
+ * @then the cached node stays intact
+ */
+TEST(TrieNodeCacheTest, ReturnsDetachedCopy) {
+  TrieNodeCache cache{2};
+  cache.put("key"_buf, LeafNode{KeyNibbles{1, 2, 3}, "abc"_buf});
+
+  auto node = cache.get("key"_buf);
+  ASSERT_TRUE(node);
+  ASSERT_EQ(node.value()->value.value(), "abc"_buf);
+  node.value()->value = "def"_buf;
+  node.value()->key_nibbles = KeyNibbles{4};
+
+  auto same_node = cache.get("key"_buf);
+  ASSERT_TRUE(same_node);
+  ASSERT_EQ(same_node.value()->value.value(), "abc"_buf);
+  ASSERT_EQ(same_node.value()->key_nibbles, (KeyNibbles{1, 2, 3}));
+}
+
+/**
+ * @given a node cache with a leaf in it
+ * @when the leaf is obtained from the cache twice
+ * @then the copies share the bytes of the value instead of copying them
+ */
+TEST(TrieNodeCacheTest, CopiesShareValue) {
+  TrieNodeCache cache{1};
+  cache.put("key"_buf, LeafNode{KeyNibbles{1}, "abc"_buf});
+
+  auto node = cache.get("key"_buf);
+  auto same_node = cache.get("key"_buf);
+  ASSERT_TRUE(node and same_node);
+  ASSERT_NE(node.value(), same_node.value());
+  ASSERT_EQ(&node.value()->value.get(), &same_node.value()->value.get());
+}
+
+/**
+ * @given a branch with dummy children in a node cache
+ * @when the branch is obtained from the cache and its child is replaced
+ * @then the cached branch keeps the original child
+ */
+TEST(TrieNodeCacheTest, BranchChildrenAreNotShared) {
+  TrieNodeCache cache{1};
+  BranchNode branch{KeyNibbles{1}, "abc"_buf};
+  branch.children.set(3, std::make_shared<DummyNode>("child"_buf));
+  cache.put("key"_buf, branch);
+
+  auto node = cache.get("key"_buf);
+  ASSERT_TRUE(node);
+  auto copy = std::dynamic_pointer_cast<BranchNode>(node.value());
+  ASSERT_NE(copy, nullptr);
+  ASSERT_TRUE(copy->children.at(3)->isDummy());
+  copy->children.set(3, std::make_shared<LeafNode>(KeyNibbles{}, "x"_buf));
+
+  auto same_node = std::dynamic_pointer_cast<BranchNode>(
+      cache.get("key"_buf).value());
+  ASSERT_TRUE(same_node->children.at(3)->isDummy());
+}
+
+/**
+ * @given a full node cache
+ * @when a new node is put into it
+ * @then the least recently used node is evicted
+ */
+TEST(TrieNodeCacheTest, EvictsLeastRecentlyUsed) {
+  TrieNodeCache cache{2};
+  cache.put("a"_buf, LeafNode{KeyNibbles{1}, "a"_buf});
+  cache.put("b"_buf, LeafNode{KeyNibbles{2}, "b"_buf});
+  // make "a" the most recently used one
+  ASSERT_TRUE(cache.get("a"_buf));
+
+  cache.put("c"_buf, LeafNode{KeyNibbles{3}, "c"_buf});
+
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_TRUE(cache.get("a"_buf));
+  ASSERT_FALSE(cache.get("b"_buf));
+  ASSERT_TRUE(cache.get("c"_buf));
+}
+
+/**
+ * @given a node cache with zero capacity
+ * @when a node is put into it
+ * @then nothing is cached
+ */
+TEST(TrieNodeCacheTest, ZeroCapacityDisablesCache) {
+  TrieNodeCache cache{0};
+  cache.put("a"_buf, LeafNode{KeyNibbles{1}, "a"_buf});
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_FALSE(cache.get("a"_buf));
+}
+
+/**
+ * @given a trie serializer with a node cache
+ * @when the same trie is retrieved twice
+ * @then the storage is accessed only the first time
+ */
+TEST(TrieNodeCacheTest, SerializerReadsStorageOnce) {
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto backend = std::make_shared<TrieStorageBackendMock>();
+  TrieSerializerImpl serializer{std::make_shared<PolkadotTrieFactoryImpl>(),
+                                codec,
+                                backend,
+                                std::make_shared<TrieNodeCache>(16)};
+
+  LeafNode root{KeyNibbles{1, 2}, "value"_buf};
+  EXPECT_OUTCOME_TRUE(enc, codec->encodeNode(root));
+  auto root_hash = Buffer{codec->hash256(enc)};
+  EXPECT_CALL(*backend, get(root_hash)).Times(1).WillOnce(Return(enc));
+
+  EXPECT_OUTCOME_TRUE(trie, serializer.retrieveTrie(root_hash));
+  EXPECT_OUTCOME_TRUE(same_trie, serializer.retrieveTrie(root_hash));
+  ASSERT_EQ(trie->getRoot()->value.value(), "value"_buf);
+  ASSERT_EQ(same_trie->getRoot()->value.value(), "value"_buf);
+  ASSERT_NE(trie->getRoot(), same_trie->getRoot());
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "storage/trie/impl/trie_pruner_impl.hpp"
+
+#include <gtest/gtest.h>
+
+#include "storage/in_memory/in_memory_storage.hpp"
+#include "storage/trie/impl/trie_storage_backend_impl.hpp"
+#include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
+#include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_serializer_impl.hpp"
+#include "testutil/literals.hpp"
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::PolkadotTrie;
+using kagome::storage::trie::PolkadotTrieFactoryImpl;
+using kagome::storage::trie::TrieNodeCache;
+using kagome::storage::trie::TriePrunerImpl;
+using kagome::storage::trie::TrieSerializerImpl;
+using kagome::storage::trie::TrieStorageBackendImpl;
+
+class TriePrunerTest : public testing::Test {
+ public:
+  void SetUp() override {
+    auto codec = std::make_shared<PolkadotCodec>();
+    auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+    auto backend =
+        std::make_shared<TrieStorageBackendImpl>(node_storage, "\1"_buf);
+    auto pruner = std::make_shared<TriePrunerImpl>(
+        backend,
+        std::make_shared<TrieStorageBackendImpl>(ref_count_storage, "\2"_buf),
+        codec);
+    pruner_ = pruner;
+    // the node cache is disabled, so that removed nodes aren't served from it
+    serializer = std::make_shared<TrieSerializerImpl>(
+        factory, codec, backend, std::make_shared<TrieNodeCache>(0), pruner);
+    archive_serializer = std::make_shared<TrieSerializerImpl>(
+        factory, codec, backend, std::make_shared<TrieNodeCache>(0));
+  }
+
+  /**
+   * Fills \arg trie with values long enough for the nodes not to be inlined
+   * into their parents
+   */
+  static void fillTrie(PolkadotTrie &trie, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      auto key = Buffer{}.putUint32(i * 0x01010101);
+      EXPECT_OUTCOME_TRUE_1(trie.put(key, valueOf(key)));
+    }
+  }
+
+  /**
+   * @return true if all values put by fillTrie can be read from the state
+   * with \arg root
+   */
+  bool isStateComplete(const Buffer &root, size_t size) const {
+    auto trie = serializer->retrieveTrie(root);
+    if (not trie) {
+      return false;
+    }
+    for (size_t i = 0; i < size; i++) {
+      auto key = Buffer{}.putUint32(i * 0x01010101);
+      auto value = trie.value()->get(key);
+      if (not value or value.value() != valueOf(key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static Buffer valueOf(const Buffer &key) {
+    return Buffer{key}.put(std::vector<uint8_t>(40, 0xab));
+  }
+
+  static constexpr size_t kSize = 64;
+
+  std::shared_ptr<InMemoryStorage> node_storage =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<InMemoryStorage> ref_count_storage =
+      std::make_shared<InMemoryStorage>();
+  std::shared_ptr<TriePrunerImpl> pruner_;
+  std::shared_ptr<TrieSerializerImpl> serializer;
+  std::shared_ptr<TrieSerializerImpl> archive_serializer;
+};
+
+/**
+ * @given two states, the second one is the first one with a single value
+ * added
+ * @when the first state is pruned
+ * @then it can't be retrieved anymore, while the second one is complete, and
+ * pruning the second state removes all the nodes from the storage
+ */
+TEST_F(TriePrunerTest, PruneOldStateKeepsNewOne) {
+  EXPECT_OUTCOME_TRUE(
+      trie, serializer->retrieveTrie(serializer->getEmptyRootHash()));
+  fillTrie(*trie, kSize);
+  EXPECT_OUTCOME_TRUE(old_root, serializer->storeTrie(*trie));
+  EXPECT_OUTCOME_TRUE_1(trie->put("new_key"_buf, valueOf("new_key"_buf)));
+  EXPECT_OUTCOME_TRUE(new_root, serializer->storeTrie(*trie));
+  ASSERT_NE(old_root, new_root);
+
+  EXPECT_OUTCOME_TRUE_1(pruner_->pruneState(old_root));
+  ASSERT_FALSE(serializer->retrieveTrie(old_root));
+  ASSERT_TRUE(isStateComplete(new_root, kSize));
+
+  EXPECT_OUTCOME_TRUE_1(pruner_->pruneState(new_root));
+  ASSERT_TRUE(node_storage->empty());
+  ASSERT_TRUE(ref_count_storage->empty());
+}
+
+/**
+ * @given a state committed twice
+ * @when it is pruned once
+ * @then it is still complete, and is removed only when pruned once again
+ */
+TEST_F(TriePrunerTest, StateAddedTwiceIsKept) {
+  EXPECT_OUTCOME_TRUE(
+      trie, serializer->retrieveTrie(serializer->getEmptyRootHash()));
+  fillTrie(*trie, kSize);
+  EXPECT_OUTCOME_TRUE(root, serializer->storeTrie(*trie));
+  EXPECT_OUTCOME_TRUE(same_root, serializer->storeTrie(*trie));
+  ASSERT_EQ(root, same_root);
+
+  EXPECT_OUTCOME_TRUE_1(pruner_->pruneState(root));
+  ASSERT_TRUE(isStateComplete(root, kSize));
+
+  EXPECT_OUTCOME_TRUE_1(pruner_->pruneState(root));
+  ASSERT_TRUE(node_storage->empty());
+}
+
+/**
+ * @given a state stored before pruning was enabled and a state derived from
+ * it stored with pruning
+ * @when the derived state is pruned
+ * @then the nodes of the former state are kept
+ */
+TEST_F(TriePrunerTest, UntrackedNodesAreKept) {
+  EXPECT_OUTCOME_TRUE(trie,
+                      archive_serializer->retrieveTrie(
+                          archive_serializer->getEmptyRootHash()));
+  fillTrie(*trie, kSize);
+  EXPECT_OUTCOME_TRUE(archive_root, archive_serializer->storeTrie(*trie));
+
+  EXPECT_OUTCOME_TRUE(pruned_trie, serializer->retrieveTrie(archive_root));
+  EXPECT_OUTCOME_TRUE_1(
+      pruned_trie->put("new_key"_buf, valueOf("new_key"_buf)));
+  EXPECT_OUTCOME_TRUE(new_root, serializer->storeTrie(*pruned_trie));
+
+  EXPECT_OUTCOME_TRUE_1(pruner_->pruneState(new_root));
+  ASSERT_FALSE(serializer->retrieveTrie(new_root));
+  ASSERT_TRUE(isStateComplete(archive_root, kSize));
+  ASSERT_TRUE(ref_count_storage->empty());
+}
@@ -54,6 +54,23 @@ TEST_F(TrieDbBackendTest, Get) {
   EXPECT_OUTCOME_TRUE_1(backend.get("abc"_buf));
 }
 
+/**
+ * @given trie backend
+ * @when get a pinned value from it several times
+ * @then it takes a prefixed value from the storage each time, and the view
+ * has the bytes of the value
+ */
+TEST_F(TrieDbBackendTest, GetPinned) {
+  EXPECT_CALL(*storage, get(Buffer{kNodePrefix}.put("abc"_buf)))
+      .WillOnce(Return("123"_buf));
+  EXPECT_CALL(*storage, get(Buffer{kNodePrefix}.put("de"_buf)))
+      .WillOnce(Return("45"_buf));
+  EXPECT_OUTCOME_TRUE(abc, backend.getPinned("abc"_buf));
+  EXPECT_OUTCOME_TRUE(de, backend.getPinned("de"_buf));
+  ASSERT_EQ(Buffer{abc.view()}, "123"_buf);
+  ASSERT_EQ(Buffer{de.view()}, "45"_buf);
+}
+
 /**
  * @given trie backend batch
  * @when perform operations on it
@@ -8,9 +8,11 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 
+#include "storage/in_memory/in_memory_storage.hpp"
 #include "storage/trie/impl/trie_storage_backend_impl.hpp"
 #include "storage/trie/polkadot_trie/polkadot_trie_factory_impl.hpp"
 #include "storage/trie/serialization/polkadot_codec.hpp"
+#include "storage/trie/serialization/trie_node_cache.hpp"
 #include "storage/trie/serialization/trie_serializer_impl.hpp"
 #include "storage/leveldb/leveldb.hpp"
 #include "outcome/outcome.hpp"
@@ -18,8 +20,11 @@
 #include "testutil/literals.hpp"
 
 using kagome::common::Buffer;
+using kagome::storage::InMemoryStorage;
+using kagome::storage::trie::KeyFilter;
 using kagome::storage::trie::PolkadotTrieFactoryImpl;
 using kagome::storage::trie::PolkadotCodec;
+using kagome::storage::trie::TrieNodeCache;
 using kagome::storage::trie::TrieSerializerImpl;
 using kagome::storage::trie::TrieStorageBackendImpl;
 using kagome::storage::trie::TrieStorageImpl;
@@ -47,7 +52,8 @@ TEST(TriePersistencyTest, CreateDestroyCreate) {
         factory,
         codec,
         std::make_shared<TrieStorageBackendImpl>(std::move(level_db),
-                                                 kNodePrefix));
+                                                 kNodePrefix),
+        std::make_shared<TrieNodeCache>(0));
     auto storage =
         TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
             .value();
@@ -65,7 +71,8 @@ TEST(TriePersistencyTest, CreateDestroyCreate) {
       factory,
       codec,
       std::make_shared<TrieStorageBackendImpl>(std::move(new_level_db),
-                                               kNodePrefix));
+                                               kNodePrefix),
+      std::make_shared<TrieNodeCache>(0));
   auto storage =
       TrieStorageImpl::createFromStorage(root, codec, serializer, boost::none)
           .value();
@@ -79,3 +86,52 @@ TEST(TriePersistencyTest, CreateDestroyCreate) {
 
   boost::filesystem::remove_all("/tmp/kagome_leveldb_persistency_test");
 }
+
+/**
+ * @given a state committed without a key filter
+ * @when a storage with a filter opens a persistent batch at it, commits a
+ * new state, and the new state is read through a batch and a snapshot
+ * @then the keys of both states are found and absent keys are not
+ */
+TEST(TriePersistencyTest, KeyFilterCoversExistingState) {
+  auto factory = std::make_shared<PolkadotTrieFactoryImpl>();
+  auto codec = std::make_shared<PolkadotCodec>();
+  auto serializer = std::make_shared<TrieSerializerImpl>(
+      factory,
+      codec,
+      std::make_shared<TrieStorageBackendImpl>(
+          std::make_shared<InMemoryStorage>(), kNodePrefix),
+      std::make_shared<TrieNodeCache>(0));
+
+  auto storage =
+      TrieStorageImpl::createEmpty(factory, codec, serializer, boost::none)
+          .value();
+  auto batch = storage->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(batch->put("123"_buf, "abc"_buf));
+  EXPECT_OUTCOME_TRUE_1(batch->put("345"_buf, "def"_buf));
+  EXPECT_OUTCOME_TRUE(root, batch->commit());
+
+  auto filtered_storage =
+      TrieStorageImpl::createFromStorage(root, codec, serializer, boost::none)
+          .value();
+  filtered_storage->setKeyFilter(std::make_shared<KeyFilter>(1024));
+  auto filtered_batch = filtered_storage->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE_1(filtered_batch->put("678"_buf, "xyz"_buf));
+  EXPECT_OUTCOME_TRUE_1(filtered_batch->commit());
+
+  auto new_batch = filtered_storage->getPersistentBatch().value();
+  EXPECT_OUTCOME_TRUE(v1, new_batch->get("123"_buf));
+  ASSERT_EQ(v1, "abc"_buf);
+  EXPECT_OUTCOME_TRUE(v3, new_batch->get("678"_buf));
+  ASSERT_EQ(v3, "xyz"_buf);
+  ASSERT_FALSE(new_batch->contains("9ab"_buf));
+
+  EXPECT_OUTCOME_TRUE(snapshot, filtered_storage->getSnapshot());
+  EXPECT_OUTCOME_TRUE(v2, snapshot->get("345"_buf));
+  ASSERT_EQ(v2, "def"_buf);
+  ASSERT_FALSE(snapshot->contains("9ab"_buf));
+  std::vector<Buffer> keys{"9ab"_buf, "678"_buf};
+  EXPECT_OUTCOME_TRUE(values, snapshot->getMany(keys));
+  ASSERT_FALSE(values[0]);
+  ASSERT_EQ(values[1], "xyz"_buf);
+}
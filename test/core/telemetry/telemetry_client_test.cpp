@@ -0,0 +1,111 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "telemetry/telemetry_client.hpp"
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+using kagome::telemetry::TelemetryClient;
+using namespace std::chrono_literals;
+
+/**
+ * @given the urls of the aggregators
+ * @when they are parsed
+ * @then the host, the port, 80 by default, and the target, / by default,
+ * are taken from the websocket ones, the others are refused
+ */
+TEST(TelemetryClientTest, ParseUrl) {
+  auto url = TelemetryClient::parseUrl("ws://telemetry.local:8000/submit");
+  ASSERT_TRUE(url);
+  EXPECT_EQ(url->host, "telemetry.local");
+  EXPECT_EQ(url->port, "8000");
+  EXPECT_EQ(url->target, "/submit");
+
+  url = TelemetryClient::parseUrl("ws://127.0.0.1");
+  ASSERT_TRUE(url);
+  EXPECT_EQ(url->host, "127.0.0.1");
+  EXPECT_EQ(url->port, "80");
+  EXPECT_EQ(url->target, "/");
+
+  url = TelemetryClient::parseUrl("ws://[::1]:9000/");
+  ASSERT_TRUE(url);
+  EXPECT_EQ(url->host, "::1");
+  EXPECT_EQ(url->port, "9000");
+
+  EXPECT_FALSE(TelemetryClient::parseUrl("wss://telemetry.local/submit"));
+  EXPECT_FALSE(TelemetryClient::parseUrl("ws://telemetry.local:port/"));
+  EXPECT_FALSE(TelemetryClient::parseUrl("ws:///submit"));
+}
+
+/**
+ * @given an exposition of the metrics
+ * @when its samples are parsed
+ * @then the comments are skipped and the samples are kept by their names
+ * with the labels, the spaces of which are kept
+ */
+TEST(TelemetryClientTest, ParseSamples) {
+  auto samples = TelemetryClient::parseSamples(
+      "# HELP kagome_peers Connected peers\n"
+      "# TYPE kagome_peers gauge\n"
+      "kagome_peers 12\n"
+      "kagome_queue{peer=\"a b\"} 3.5\n"
+      "kagome_lag{quantile=\"1\"} +Inf\n");
+  ASSERT_EQ(samples.size(), 3);
+  EXPECT_EQ(samples.at("kagome_peers"), 12);
+  EXPECT_EQ(samples.at("kagome_queue{peer=\"a b\"}"), 3.5);
+  EXPECT_TRUE(std::isinf(samples.at("kagome_lag{quantile=\"1\"}")));
+}
+
+/**
+ * @given the samples of the registry and the ones taken before
+ * @when the message is made of them
+ * @then it has the heights, the peers and the transactions of the latest
+ * samples, the rates of the counters summed up over their labels, and the
+ * latencies
+ */
+TEST(TelemetryClientTest, MakeMessage) {
+  TelemetryClient::Samples previous{
+      {"kagome_imported_blocks_total", 10},
+      {"kagome_network_sent_bytes_total{protocol=\"a\"}", 1000},
+      {"kagome_network_sent_bytes_total{protocol=\"b\"}", 1000}};
+  TelemetryClient::Samples samples{
+      {"kagome_block_height{status=\"best\"}", 120},
+      {"kagome_block_height{status=\"finalized\"}", 118},
+      {"kagome_peers", 25},
+      {"kagome_peers_banned", 3},
+      {"kagome_transaction_pool_transactions{state=\"ready\"}", 4},
+      {"kagome_transaction_pool_transactions{state=\"waiting\"}", 2},
+      {"kagome_imported_blocks_total", 20},
+      {"kagome_network_sent_bytes_total{protocol=\"a\"}", 3000},
+      {"kagome_network_sent_bytes_total{protocol=\"b\"}", 4000},
+      {"kagome_finality_lag_seconds{quantile=\"0.99\"}", 2.5}};
+
+  auto message = TelemetryClient::makeMessage(
+      samples, previous, 5s, std::chrono::system_clock::time_point{1500ms});
+  rapidjson::Document json;
+  json.Parse(message.c_str());
+  ASSERT_FALSE(json.HasParseError()) << message;
+  EXPECT_STREQ(json["msg"].GetString(), "system.interval");
+  EXPECT_STREQ(json["ts"].GetString(), "1970-01-01T00:00:01.500Z");
+  EXPECT_EQ(json["height"].GetUint64(), 120);
+  EXPECT_EQ(json["finalized_height"].GetUint64(), 118);
+  EXPECT_EQ(json["peers"].GetUint64(), 25);
+  EXPECT_EQ(json["txcount"].GetUint64(), 6);
+  EXPECT_DOUBLE_EQ(json["import_rate"].GetDouble(), 2);
+  EXPECT_DOUBLE_EQ(json["bandwidth_upload"].GetDouble(), 1000);
+  EXPECT_DOUBLE_EQ(json["bandwidth_download"].GetDouble(), 0);
+  EXPECT_DOUBLE_EQ(json["latency"]["block_finality"].GetDouble(), 2.5);
+  EXPECT_DOUBLE_EQ(json["latency"]["tx_submission"].GetDouble(), 0);
+
+  // no rates are known of the first samples
+  message = TelemetryClient::makeMessage(
+      samples, {}, 5s, std::chrono::system_clock::time_point{});
+  json.Parse(message.c_str());
+  ASSERT_FALSE(json.HasParseError()) << message;
+  EXPECT_FALSE(json.HasMember("import_rate"));
+}
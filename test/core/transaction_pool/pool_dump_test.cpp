@@ -0,0 +1,72 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "transaction_pool/impl/pool_dump.hpp"
+
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "testutil/outcome.hpp"
+
+using kagome::common::Buffer;
+using kagome::primitives::Extrinsic;
+using kagome::primitives::Transaction;
+using kagome::transaction_pool::PoolDumpError;
+using kagome::transaction_pool::readPoolDump;
+using kagome::transaction_pool::writePoolDump;
+
+class PoolDumpTest : public testing::Test {
+ public:
+  void TearDown() override {
+    boost::filesystem::remove(path);
+  }
+
+  std::string path =
+      (boost::filesystem::temp_directory_path()
+       / boost::filesystem::unique_path("kagome_pool_dump_%%%%%%%%"))
+          .string();
+};
+
+/**
+ * @given transactions with their validities and tags
+ * @when they are written to a dump and read back
+ * @then the same transactions are read in the same order
+ */
+TEST_F(PoolDumpTest, ReadsWrittenTransactions) {
+  auto first = std::make_shared<Transaction>();
+  first->ext = Extrinsic{Buffer{1, 2, 3}};
+  first->bytes = 3;
+  first->hash[0] = 1;
+  first->priority = 10;
+  first->valid_till = 100;
+  first->provides = {{1}, {2, 3}};
+  first->should_propagate = true;
+  auto second = std::make_shared<Transaction>();
+  second->ext = Extrinsic{Buffer{4}};
+  second->bytes = 1;
+  second->hash[0] = 2;
+  second->requires = {{2, 3}};
+
+  EXPECT_OUTCOME_TRUE_1(writePoolDump(path, {first, second}));
+
+  EXPECT_OUTCOME_TRUE(txs, readPoolDump(path));
+  ASSERT_EQ(txs, (std::vector{*first, *second}));
+}
+
+/**
+ * @given a file, which is not a dump of the pool, and a missing one
+ * @when they are read as dumps
+ * @then errors are returned
+ */
+TEST_F(PoolDumpTest, RejectsInvalidFile) {
+  EXPECT_OUTCOME_ERROR(
+      missing, readPoolDump(path), PoolDumpError::CANNOT_OPEN_FILE);
+
+  std::ofstream{path} << "not a dump";
+  EXPECT_OUTCOME_ERROR(
+      invalid, readPoolDump(path), PoolDumpError::INVALID_FORMAT);
+}
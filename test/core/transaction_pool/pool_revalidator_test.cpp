@@ -0,0 +1,194 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "transaction_pool/impl/pool_revalidator_impl.hpp"
+
+#include <future>
+#include <limits>
+
+#include <boost/filesystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include "mock/core/application/app_state_manager_mock.hpp"
+#include "mock/core/blockchain/block_tree_mock.hpp"
+#include "mock/core/network/extrinsic_observer_mock.hpp"
+#include "mock/core/runtime/tagged_transaction_queue_mock.hpp"
+#include "mock/core/transaction_pool/transaction_pool_mock.hpp"
+#include "testutil/outcome.hpp"
+#include "transaction_pool/impl/pool_dump.hpp"
+
+using kagome::application::AppStateManagerMock;
+using kagome::blockchain::BlockTreeMock;
+using kagome::common::Buffer;
+using kagome::common::Hash256;
+using kagome::network::ExtrinsicObserverMock;
+using kagome::primitives::BlockBody;
+using kagome::primitives::BlockHash;
+using kagome::primitives::BlockHeader;
+using kagome::primitives::BlockId;
+using kagome::primitives::BlockInfo;
+using kagome::primitives::Extrinsic;
+using kagome::primitives::InvalidTransaction;
+using kagome::primitives::Transaction;
+using kagome::primitives::TransactionValidity;
+using kagome::primitives::ValidTransaction;
+using kagome::runtime::TaggedTransactionQueueMock;
+using kagome::transaction_pool::PoolRevalidatorImpl;
+using kagome::transaction_pool::readPoolDump;
+using kagome::transaction_pool::TransactionPoolMock;
+using kagome::transaction_pool::writePoolDump;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+using testing::SaveArg;
+
+class PoolRevalidatorTest : public testing::Test {
+ public:
+  void SetUp() override {
+    EXPECT_CALL(*app_state_manager_, atShutdown(_))
+        .WillOnce(SaveArg<0>(&shutdown_));
+  }
+
+  static std::shared_ptr<const Transaction> makeTx(uint8_t id) {
+    auto tx = std::make_shared<Transaction>();
+    tx->ext = Extrinsic{Buffer{id}};
+    tx->hash = Hash256{};
+    tx->hash[0] = id;
+    return tx;
+  }
+
+  std::shared_ptr<AppStateManagerMock> app_state_manager_ =
+      std::make_shared<AppStateManagerMock>();
+  std::shared_ptr<BlockTreeMock> block_tree_ =
+      std::make_shared<BlockTreeMock>();
+  std::shared_ptr<TransactionPoolMock> pool_ =
+      std::make_shared<TransactionPoolMock>();
+  std::shared_ptr<TaggedTransactionQueueMock> tx_queue_ =
+      std::make_shared<TaggedTransactionQueueMock>();
+  std::shared_ptr<ExtrinsicObserverMock> extrinsic_observer_ =
+      std::make_shared<ExtrinsicObserverMock>();
+  AppStateManagerMock::Callback shutdown_;
+};
+
+/**
+ * @given revalidator and the pool with a valid and an invalid transaction
+ * @when a new best block is reported
+ * @then the invalid transaction is dropped from the pool on the thread of
+ * the revalidator
+ */
+TEST_F(PoolRevalidatorTest, DropsInvalidTransactions) {
+  auto valid = makeTx(1);
+  auto invalid = makeTx(2);
+  EXPECT_CALL(*pool_, getForRevalidation(PoolRevalidatorImpl::kBatchSize))
+      .WillOnce(Return(std::vector{valid, invalid}));
+  EXPECT_CALL(*tx_queue_, validate_transaction(valid->ext))
+      .WillOnce(Return(TransactionValidity{ValidTransaction{}}));
+  EXPECT_CALL(*tx_queue_, validate_transaction(invalid->ext))
+      .WillOnce(Return(TransactionValidity{InvalidTransaction::Payment}));
+  std::promise<std::thread::id> dropped;
+  EXPECT_CALL(*pool_, remove(std::vector{invalid->hash}))
+      .WillOnce(Invoke([&](auto &) {
+        dropped.set_value(std::this_thread::get_id());
+        return outcome::success();
+      }));
+  PoolRevalidatorImpl revalidator{
+      app_state_manager_, block_tree_, pool_, tx_queue_, extrinsic_observer_};
+
+  revalidator.onNewBestBlock({1, BlockHash{}});
+
+  ASSERT_NE(dropped.get_future().get(), std::this_thread::get_id());
+}
+
+/**
+ * @given revalidator which got a best block on top of the finalized one
+ * @when a best block of another fork is reported
+ * @then the extrinsics of the retracted block are submitted again
+ */
+TEST_F(PoolRevalidatorTest, ResubmitsRetractedExtrinsics) {
+  BlockInfo finalized{1, BlockHash{}};
+  finalized.block_hash[0] = 1;
+  BlockInfo retracted{2, BlockHash{}};
+  retracted.block_hash[0] = 2;
+  BlockInfo best{2, BlockHash{}};
+  best.block_hash[0] = 3;
+  Extrinsic xt{Buffer{42}};
+
+  EXPECT_CALL(*pool_, getForRevalidation(_))
+      .WillRepeatedly(
+          Return(std::vector<std::shared_ptr<const Transaction>>{}));
+  EXPECT_CALL(*block_tree_,
+              hasDirectChain(retracted.block_hash, best.block_hash))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*block_tree_, getLastFinalized()).WillOnce(Return(finalized));
+  BlockHeader header;
+  header.parent_hash = finalized.block_hash;
+  EXPECT_CALL(*block_tree_, getBlockHeader(BlockId{retracted.block_hash}))
+      .WillOnce(Return(header));
+  EXPECT_CALL(*block_tree_, getBlockBody(BlockId{retracted.block_hash}))
+      .WillOnce(Return(BlockBody{xt}));
+  std::promise<void> resubmitted;
+  EXPECT_CALL(*extrinsic_observer_, onTxMessages(std::vector{xt}))
+      .WillOnce(Invoke([&](auto &) {
+        resubmitted.set_value();
+        return std::vector<outcome::result<Hash256>>{Hash256{}};
+      }));
+  PoolRevalidatorImpl revalidator{
+      app_state_manager_, block_tree_, pool_, tx_queue_, extrinsic_observer_};
+
+  revalidator.onNewBestBlock(retracted);
+  revalidator.onNewBestBlock(best);
+
+  resubmitted.get_future().wait();
+}
+
+/**
+ * @given a dump of the pool with transactions of different priorities
+ * @when the node is launched and then shut down
+ * @then the dumped extrinsics are submitted again at the launch, the higher
+ * priority first, the dump is removed, and the pool is written to the dump
+ * again at the shutdown
+ */
+TEST_F(PoolRevalidatorTest, KeepsPoolBetweenRuns) {
+  auto path = (boost::filesystem::temp_directory_path()
+               / boost::filesystem::unique_path("kagome_pool_%%%%%%%%"))
+                  .string();
+  auto low = std::make_shared<Transaction>(*makeTx(1));
+  low->priority = 1;
+  auto high = std::make_shared<Transaction>(*makeTx(2));
+  high->priority = 2;
+  EXPECT_OUTCOME_TRUE_1(writePoolDump(path, {low, high}));
+
+  AppStateManagerMock::Callback launch;
+  EXPECT_CALL(*app_state_manager_, atLaunch(_))
+      .WillOnce(SaveArg<0>(&launch));
+  EXPECT_CALL(*pool_, getForRevalidation(PoolRevalidatorImpl::kBatchSize))
+      .WillRepeatedly(
+          Return(std::vector<std::shared_ptr<const Transaction>>{}));
+  std::promise<void> resubmitted;
+  EXPECT_CALL(*extrinsic_observer_,
+              onTxMessages(std::vector{high->ext, low->ext}))
+      .WillOnce(Invoke([&](auto &) {
+        resubmitted.set_value();
+        return std::vector<outcome::result<Hash256>>{Hash256{}, Hash256{}};
+      }));
+  PoolRevalidatorImpl revalidator{app_state_manager_,
+                                  block_tree_,
+                                  pool_,
+                                  tx_queue_,
+                                  extrinsic_observer_,
+                                  path};
+
+  launch();
+  resubmitted.get_future().wait();
+  ASSERT_FALSE(boost::filesystem::exists(path));
+
+  EXPECT_CALL(*pool_, getForRevalidation(std::numeric_limits<size_t>::max()))
+      .WillOnce(Return(std::vector<std::shared_ptr<const Transaction>>{high}));
+  shutdown_();
+  EXPECT_OUTCOME_TRUE(dumped, readPoolDump(path));
+  ASSERT_EQ(dumped, std::vector{*high});
+  boost::filesystem::remove(path);
+}
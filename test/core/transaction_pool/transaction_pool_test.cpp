@@ -5,6 +5,9 @@
 
 #include "transaction_pool/impl/transaction_pool_impl.hpp"
 
+#include <atomic>
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "mock/core/blockchain/block_header_repository_mock.hpp"
@@ -134,3 +137,256 @@ TEST_F(TransactionPoolTest, CorrectRemoveTx) {
     EXPECT_EQ(outcome.error(), TransactionPoolError::TX_NOT_FOUND);
   }
 }
+
+/**
+ * @given transaction pool with ready transactions of different priorities,
+ * one of the highest priority depending on one of the lowest
+ * @when iterating over the ready transactions
+ * @then they come by their priority, the ones of the same priority in the
+ * order they got ready, and the dependent one comes right after the one it
+ * depends on
+ */
+TEST_F(TransactionPoolTest, ReadyTransactionsByPriority) {
+  auto makePrioritized = [](Transaction::Hash hash,
+                            Transaction::Priority priority,
+                            std::initializer_list<Transaction::Tag> provides,
+                            std::initializer_list<Transaction::Tag> requires) {
+    auto tx = makeTx(std::move(hash), provides, requires);
+    tx.priority = priority;
+    return tx;
+  };
+  EXPECT_OUTCOME_TRUE_1(
+      pool_->submit({makePrioritized("01"_hash256, 1, {{1}}, {}),
+                     makePrioritized("02"_hash256, 5, {{2}}, {}),
+                     makePrioritized("03"_hash256, 9, {{3}}, {{1}})}));
+  ASSERT_EQ(pool_->getStatus().ready_num, 3);
+
+  std::vector<Transaction::Hash> order;
+  auto ready = pool_->getReadyTransactions();
+  while (auto tx = ready->next()) {
+    order.push_back(tx->hash);
+  }
+  EXPECT_EQ(order,
+            (std::vector<Transaction::Hash>{
+                "02"_hash256, "01"_hash256, "03"_hash256}));
+}
+
+/**
+ * @given transaction pool with as many ready transactions as its limit
+ * allows, and one more postponed
+ * @when a ready transaction is removed
+ * @then the postponed one gets ready in its place
+ */
+TEST_F(TransactionPoolTest, PostponedGetReadyOnRemove) {
+  EXPECT_OUTCOME_TRUE_1(pool_->submit({makeTx("01"_hash256, {{1}}, {}),
+                                       makeTx("02"_hash256, {{2}}, {}),
+                                       makeTx("03"_hash256, {{3}}, {}),
+                                       makeTx("04"_hash256, {{4}}, {})}));
+  EXPECT_EQ(pool_->getStatus().waiting_num, 1);
+  ASSERT_EQ(pool_->getStatus().ready_num, 3);
+
+  EXPECT_OUTCOME_TRUE_1(pool_->removeOne("01"_hash256));
+  EXPECT_EQ(pool_->getStatus().waiting_num, 0);
+  ASSERT_EQ(pool_->getStatus().ready_num, 3);
+}
+
+/**
+ * @given transaction pool with a transaction requiring a tag provided by two
+ * others
+ * @when the providers are removed one by one
+ * @then the transaction stays ready until the last of them is removed
+ */
+TEST_F(TransactionPoolTest, TagProvidedUntilLastProviderRemoved) {
+  EXPECT_OUTCOME_TRUE_1(pool_->submit({makeTx("01"_hash256, {{1}}, {}),
+                                       makeTx("02"_hash256, {{1}}, {}),
+                                       makeTx("03"_hash256, {{3}}, {{1}})}));
+  ASSERT_EQ(pool_->getStatus().ready_num, 3);
+
+  EXPECT_OUTCOME_TRUE_1(pool_->removeOne("01"_hash256));
+  EXPECT_EQ(pool_->getStatus().waiting_num, 0);
+  ASSERT_EQ(pool_->getStatus().ready_num, 2);
+
+  EXPECT_OUTCOME_TRUE_1(pool_->removeOne("02"_hash256));
+  EXPECT_EQ(pool_->getStatus().waiting_num, 1);
+  ASSERT_EQ(pool_->getStatus().ready_num, 0);
+
+  // the tag is provided again
+  EXPECT_OUTCOME_TRUE_1(pool_->submitOne(makeTx("02"_hash256, {{1}}, {})));
+  EXPECT_EQ(pool_->getStatus().waiting_num, 0);
+  ASSERT_EQ(pool_->getStatus().ready_num, 2);
+}
+
+/**
+ * @given ready transactions got from the pool
+ * @when one of them is removed from the pool
+ * @then the ready transactions got before still include it
+ */
+TEST_F(TransactionPoolTest, ReadyTransactionsSurviveRemoval) {
+  EXPECT_OUTCOME_TRUE_1(pool_->submit(
+      {makeTx("01"_hash256, {{1}}, {}), makeTx("02"_hash256, {{2}}, {{1}})}));
+  auto ready = pool_->getReadyTransactions();
+
+  EXPECT_OUTCOME_TRUE_1(pool_->removeOne("01"_hash256));
+  ASSERT_EQ(pool_->getStatus().ready_num, 0);
+
+  std::vector<Transaction::Hash> order;
+  while (auto tx = ready->next()) {
+    order.push_back(tx->hash);
+  }
+  EXPECT_EQ(order,
+            (std::vector<Transaction::Hash>{"01"_hash256, "02"_hash256}));
+}
+
+/**
+ * @given transaction pool with three transactions
+ * @when they are taken for the revalidation in batches of two
+ * @then the ones revalidated the longest ago are taken first
+ */
+TEST_F(TransactionPoolTest, GetForRevalidation) {
+  EXPECT_OUTCOME_TRUE_1(pool_->submit({makeTx("01"_hash256, {{1}}, {}),
+                                       makeTx("02"_hash256, {{2}}, {}),
+                                       makeTx("03"_hash256, {{3}}, {})}));
+  auto hashes = [](const auto &txs) {
+    std::vector<Transaction::Hash> hashes;
+    for (auto &tx : txs) {
+      hashes.push_back(tx->hash);
+    }
+    return hashes;
+  };
+
+  ASSERT_EQ(hashes(pool_->getForRevalidation(2)),
+            (std::vector{"01"_hash256, "02"_hash256}));
+  ASSERT_EQ(hashes(pool_->getForRevalidation(2)),
+            (std::vector{"03"_hash256, "01"_hash256}));
+
+  EXPECT_OUTCOME_TRUE_1(pool_->removeOne("02"_hash256));
+  ASSERT_EQ(hashes(pool_->getForRevalidation(2)),
+            (std::vector{"03"_hash256, "01"_hash256}));
+}
+
+/**
+ * @given transaction pool with two transactions
+ * @when they are looked up by their hashes along with an unknown one
+ * @then they are returned in the order of the hashes, nullptr for the unknown
+ * one
+ */
+TEST_F(TransactionPoolTest, GetTransactions) {
+  EXPECT_OUTCOME_TRUE_1(pool_->submit({makeTx("01"_hash256, {{1}}, {}),
+                                       makeTx("02"_hash256, {{2}}, {})}));
+
+  auto txs = pool_->getTransactions({"02"_hash256, "03"_hash256, "01"_hash256});
+  ASSERT_EQ(txs.size(), 3);
+  ASSERT_TRUE(txs[0] and txs[2]);
+  ASSERT_EQ(txs[0]->hash, "02"_hash256);
+  ASSERT_EQ(txs[1], nullptr);
+  ASSERT_EQ(txs[2]->hash, "01"_hash256);
+}
+
+/**
+ * @given full transaction pool
+ * @when transactions of a higher and of a lower priority are submitted
+ * @then the better one evicts the one of the lowest priority, the worse one
+ * is rejected
+ */
+TEST_F(TransactionPoolTest, EvictsLowestPriorityWhenFull) {
+  auto makeSized = [](Transaction::Hash hash,
+                      Transaction::Priority priority,
+                      size_t bytes) {
+    auto tx = makeTx(std::move(hash), {}, {});
+    tx.priority = priority;
+    tx.bytes = bytes;
+    return tx;
+  };
+  TransactionPoolImpl pool{std::make_unique<NiceMock<PoolModeratorMock>>(),
+                           std::make_shared<BlockHeaderRepositoryMock>(),
+                           TransactionPoolImpl::Limits{4, 4, 10}};
+  EXPECT_OUTCOME_TRUE_1(pool.submit({makeSized("01"_hash256, 1, 4),
+                                     makeSized("02"_hash256, 2, 4)}));
+  ASSERT_EQ(pool.getStatus().bytes, 8);
+
+  // does not fit by the size
+  EXPECT_OUTCOME_TRUE_1(pool.submitOne(makeSized("03"_hash256, 3, 4)));
+  EXPECT_FALSE(pool.contains("01"_hash256));
+  EXPECT_TRUE(pool.contains("02"_hash256));
+  EXPECT_TRUE(pool.contains("03"_hash256));
+  ASSERT_EQ(pool.getStatus().bytes, 8);
+
+  auto outcome = pool.submitOne(makeSized("04"_hash256, 2, 4));
+  ASSERT_TRUE(outcome.has_error());
+  EXPECT_EQ(outcome.error(), TransactionPoolError::POOL_IS_FULL);
+  EXPECT_FALSE(pool.contains("04"_hash256));
+  ASSERT_EQ(pool.getStatus().ready_num, 2);
+}
+
+/**
+ * @given transaction pool
+ * @when the same transactions are submitted from several threads, while the
+ * ready ones are iterated over
+ * @then each of them is imported once
+ */
+TEST_F(TransactionPoolTest, ConcurrentSubmit) {
+  constexpr size_t kThreads = 4;
+  constexpr uint8_t kTxs = 200;
+  TransactionPoolImpl pool{std::make_unique<NiceMock<PoolModeratorMock>>(),
+                           std::make_shared<BlockHeaderRepositoryMock>(),
+                           TransactionPoolImpl::Limits{kTxs, kTxs}};
+
+  std::atomic_size_t imported = 0;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (uint8_t i = 0; i < kTxs; ++i) {
+        Hash256 hash;
+        hash[0] = i;
+        if (pool.submitOne(makeTx(hash, {{i}}, {}))) {
+          ++imported;
+        }
+        auto ready = pool.getReadyTransactions();
+        while (ready->next()) {
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(imported, kTxs);
+  EXPECT_EQ(pool.getStatus().ready_num, kTxs);
+}
+
+/**
+ * @given transaction pool with a transaction imported and one banned
+ * @when the transactions received together are checked and imported at once
+ * @then the imported and the banned ones are told apart from the unknown
+ * ones, and each of the imported ones gets its own result, in the order of
+ * the transactions
+ */
+TEST_F(TransactionPoolTest, CheckAndSubmitBatch) {
+  auto moderator = std::make_unique<NiceMock<PoolModeratorMock>>();
+  ON_CALL(*moderator, isBanned("03"_hash256)).WillByDefault(Return(true));
+  TransactionPoolImpl pool{std::move(moderator),
+                           std::make_shared<BlockHeaderRepositoryMock>(),
+                           TransactionPoolImpl::Limits{3, 3}};
+  EXPECT_OUTCOME_TRUE_1(pool.submitOne(makeTx("01"_hash256, {{1}}, {})));
+
+  auto checks = pool.checkUnknown({"01"_hash256, "02"_hash256, "03"_hash256});
+  ASSERT_EQ(checks.size(), 3);
+  EXPECT_OUTCOME_ERROR(
+      imported, checks[0], TransactionPoolError::TX_ALREADY_IMPORTED);
+  EXPECT_OUTCOME_TRUE_1(checks[1]);
+  EXPECT_OUTCOME_ERROR(banned, checks[2], TransactionPoolError::TX_BANNED);
+
+  auto results = pool.submitEach({makeTx("02"_hash256, {{2}}, {{1}}),
+                                  makeTx("01"_hash256, {{1}}, {}),
+                                  makeTx("04"_hash256, {{4}}, {{2}}),
+                                  makeTx("05"_hash256, {{5}}, {})});
+  ASSERT_EQ(results.size(), 4);
+  EXPECT_OUTCOME_TRUE_1(results[0]);
+  EXPECT_OUTCOME_ERROR(
+      duplicate, results[1], TransactionPoolError::TX_ALREADY_IMPORTED);
+  EXPECT_OUTCOME_TRUE_1(results[2]);
+  EXPECT_OUTCOME_ERROR(full, results[3], TransactionPoolError::POOL_IS_FULL);
+  EXPECT_FALSE(pool.contains("05"_hash256));
+  EXPECT_EQ(pool.getStatus().ready_num, 3);
+}
@@ -19,6 +19,7 @@ namespace kagome::api {
     MOCK_METHOD2(registerHandler, void(const std::string &name, Method method));
     MOCK_METHOD2(processData,
                  void(std::string_view request, const ResponseHandler &cb));
+    MOCK_METHOD1(encode, std::string(const jsonrpc::Value &value));
   };
 
 }  // namespace kagome::api
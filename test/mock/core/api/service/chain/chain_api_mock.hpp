@@ -17,12 +17,19 @@ namespace kagome::api {
     ~ChainApiMock() override = default;
 
     MOCK_CONST_METHOD0(getBlockHash, outcome::result<BlockHash>());
-    MOCK_CONST_METHOD1(getBlockHash, outcome::result<BlockHash>(uint32_t));
+    MOCK_CONST_METHOD1(getBlockHash, outcome::result<BlockHash>(BlockNumber));
     MOCK_CONST_METHOD1(getBlockHash,
                        outcome::result<BlockHash>(std::string_view));
     MOCK_CONST_METHOD1(
         getBlockHash,
         outcome::result<std::vector<BlockHash>>(gsl::span<const ValueType>));
+    MOCK_CONST_METHOD1(getHeader,
+                       outcome::result<primitives::BlockHeader>(
+                           const BlockHash &));
+    MOCK_CONST_METHOD1(getBlock,
+                       outcome::result<primitives::Block>(const BlockHash &));
+    MOCK_CONST_METHOD0(getBestBlockHash, BlockHash());
+    MOCK_CONST_METHOD1(isFinalized, bool(const primitives::BlockInfo &));
   };
 
 }  // namespace kagome::api
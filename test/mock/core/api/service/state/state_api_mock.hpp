@@ -24,9 +24,33 @@ namespace kagome::api {
         getStorage,
         outcome::result<common::Buffer>(const common::Buffer &key,
                                         const primitives::BlockHash &at));
+    MOCK_CONST_METHOD2(queryStorageAt,
+                       outcome::result<std::vector<primitives::StorageChangeSet>>(
+                           const std::vector<common::Buffer> &keys,
+                           const boost::optional<primitives::BlockHash> &at));
+    MOCK_CONST_METHOD3(queryStorage,
+                       outcome::result<std::vector<primitives::StorageChangeSet>>(
+                           const std::vector<common::Buffer> &keys,
+                           const primitives::BlockHash &from,
+                           const boost::optional<primitives::BlockHash> &to));
+    MOCK_CONST_METHOD4(getKeysPaged,
+                       outcome::result<std::vector<common::Buffer>>(
+                           const boost::optional<common::Buffer> &prefix,
+                           uint32_t keys_amount,
+                           const boost::optional<common::Buffer> &prev_key,
+                           const boost::optional<primitives::BlockHash> &at));
+    MOCK_CONST_METHOD2(
+        getPairs,
+        outcome::result<std::vector<std::pair<common::Buffer, common::Buffer>>>(
+            const common::Buffer &prefix,
+            const boost::optional<primitives::BlockHash> &at));
     MOCK_CONST_METHOD1(getRuntimeVersion,
                        outcome::result<primitives::Version>(
                            boost::optional<primitives::BlockHash> const &at));
+    MOCK_CONST_METHOD2(getReadProof,
+                       outcome::result<primitives::ReadProof>(
+                           const std::vector<common::Buffer> &keys,
+                           const boost::optional<primitives::BlockHash> &at));
   };
 }  // namespace kagome::api
 
@@ -12,9 +12,9 @@ namespace kagome::api {
   class SessionMock : public Session {
    public:
     ~SessionMock() override = default;
-    MOCK_METHOD0(socket, Socket &());
     MOCK_METHOD0(start, void());
-    MOCK_METHOD1(respond, void(std::string_view));
+    MOCK_METHOD1(respond, void(std::string));
+    MOCK_CONST_METHOD0(type, Type());
   };
 }  // namespace kagome::api
 
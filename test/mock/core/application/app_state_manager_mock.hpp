@@ -19,6 +19,11 @@ namespace kagome::application {
     }
     MOCK_METHOD1(atPrepare, void(Callback));
 
+    PrepareId atPrepare(Callback &&cb, std::vector<PrepareId> dependencies) {
+      return atPrepare(cb, dependencies);
+    }
+    MOCK_METHOD2(atPrepare, PrepareId(Callback, std::vector<PrepareId>));
+
     void atLaunch(Callback &&cb) {
       atLaunch(cb);
     }
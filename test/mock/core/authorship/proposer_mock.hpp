@@ -13,11 +13,12 @@
 namespace kagome::authorship {
   class ProposerMock : public Proposer {
    public:
-    MOCK_METHOD3(
+    MOCK_METHOD4(
         propose,
         outcome::result<primitives::Block>(const primitives::BlockId &,
                                            const primitives::InherentData &,
-                                           const primitives::Digest &));
+                                           const primitives::Digest &,
+                                           clock::SystemClock::TimePoint));
   };
 }  // namespace kagome::authorship
 
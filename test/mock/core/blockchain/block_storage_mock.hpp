@@ -19,6 +19,12 @@ namespace kagome::blockchain {
     MOCK_METHOD1(setLastFinalizedBlockHash,
                  outcome::result<void>(const primitives::BlockHash &));
 
+    MOCK_CONST_METHOD0(getBlockTreeSnapshot,
+                       outcome::result<boost::optional<common::Buffer>>());
+
+    MOCK_METHOD1(setBlockTreeSnapshot,
+                 outcome::result<void>(const common::Buffer &));
+
     MOCK_CONST_METHOD1(
         getBlockHeader,
         outcome::result<primitives::BlockHeader>(const primitives::BlockId &));
@@ -35,6 +41,10 @@ namespace kagome::blockchain {
                        outcome::result<primitives::Justification>(
                            const primitives::BlockId &));
 
+    MOCK_CONST_METHOD1(getBlockDataRange,
+                       outcome::result<std::vector<primitives::BlockData>>(
+                           const std::vector<primitives::BlockInfo> &));
+
     MOCK_METHOD1(putBlockHeader,
                  outcome::result<primitives::BlockHash>(
                      const primitives::BlockHeader &header));
@@ -56,6 +66,16 @@ namespace kagome::blockchain {
     MOCK_METHOD2(removeBlock,
                  outcome::result<void>(const primitives::BlockHash &,
                                        const primitives::BlockNumber &));
+
+    MOCK_METHOD1(removeBlocks,
+                 outcome::result<void>(
+                     const std::vector<primitives::BlockInfo> &));
+
+    MOCK_METHOD1(pruneBodies, outcome::result<void>(primitives::BlockNumber));
+
+    MOCK_METHOD2(pruneJustifications,
+                 outcome::result<void>(primitives::BlockNumber,
+                                       primitives::BlockNumber));
   };
 
 }  // namespace kagome::blockchain
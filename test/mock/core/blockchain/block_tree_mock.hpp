@@ -24,6 +24,12 @@ namespace kagome::blockchain {
                        outcome::result<primitives::Justification>(
                            const primitives::BlockId &));
 
+    MOCK_CONST_METHOD1(
+        getFinalityProof,
+        outcome::result<
+            std::pair<primitives::BlockInfo, primitives::Justification>>(
+            const primitives::BlockId &));
+
     MOCK_METHOD1(addBlockHeader,
                  outcome::result<void>(const primitives::BlockHeader &));
 
@@ -51,6 +57,10 @@ namespace kagome::blockchain {
                  BlockHashVecRes(const primitives::BlockHash &,
                                  const primitives::BlockHash &));
 
+    MOCK_CONST_METHOD2(hasDirectChain,
+                       bool(const primitives::BlockHash &,
+                            const primitives::BlockHash &));
+
     MOCK_CONST_METHOD2(getBestContaining,
                        outcome::result<primitives::BlockInfo>(
                            const primitives::BlockHash &,
@@ -66,6 +76,8 @@ namespace kagome::blockchain {
 
     MOCK_CONST_METHOD0(getLastFinalized, primitives::BlockInfo());
 
+    MOCK_METHOD0(resetToLastFinalized, outcome::result<void>());
+
     MOCK_METHOD0(prune, outcome::result<void>());
   };
 }  // namespace kagome::blockchain
@@ -19,6 +19,13 @@ namespace kagome::consensus {
                       const primitives::BlockHash &,
                       primitives::AuthorityIndex,
                       const BlocksHandler &));
+    MOCK_METHOD5(findCommonAncestor,
+                 void(const primitives::BlockInfo &,
+                      primitives::BlockNumber,
+                      primitives::AuthorityIndex,
+                      IsKnown,
+                      const AncestorHandler &));
+    MOCK_METHOD1(reportInvalidBlock, void(primitives::AuthorityIndex));
   };
 
 }  // namespace kagome::consensus
@@ -17,9 +17,17 @@ namespace kagome::consensus {
     MOCK_METHOD2(addEpochDescriptor,
                  outcome::result<void>(EpochIndex,
                                        const NextEpochDescriptor &));
+    MOCK_METHOD3(addEpochDescriptor,
+                 outcome::result<void>(EpochIndex,
+                                       const primitives::BlockHash &,
+                                       const NextEpochDescriptor &));
     MOCK_CONST_METHOD1(
         getEpochDescriptor,
         outcome::result<NextEpochDescriptor>(EpochIndex epoch_number));
+    MOCK_CONST_METHOD2(getEpochInfo,
+                       outcome::result<std::shared_ptr<const EpochInfo>>(
+                           EpochIndex epoch_number,
+                           const primitives::BlockHash &block_hash));
   };
 
 }  // namespace kagome::consensus
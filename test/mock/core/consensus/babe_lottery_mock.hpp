@@ -16,6 +16,12 @@ namespace kagome::consensus {
                        SlotsLeadership(const Epoch &,
                                        const Threshold &,
                                        const crypto::SR25519Keypair &));
+    MOCK_CONST_METHOD5(slotsLeadership,
+                       SlotsLeadership(const Epoch &,
+                                       const Threshold &,
+                                       const crypto::SR25519Keypair &,
+                                       EpochLength,
+                                       EpochLength));
 
     MOCK_METHOD2(computeRandomness, Randomness(const Randomness &, EpochIndex));
 
@@ -40,6 +40,8 @@ namespace kagome::consensus::grandpa {
                               const BlockInfo &vote,
                               const GrandpaJustification &justification));
 
+    MOCK_METHOD1(onCatchUpMessage, void(const CatchUpMessage &message));
+
     MOCK_METHOD1(doOnCompleted, void(const CompleteHandler &));
 
     MOCK_METHOD1(onCompleted, void(outcome::result<CompletedRound> round));
@@ -16,6 +16,7 @@ namespace kagome::consensus::grandpa {
    public:
     MOCK_METHOD1(vote, void(const VoteMessage &msg));
     MOCK_METHOD1(finalize, void(const Fin &fin));
+    MOCK_METHOD1(catchUp, void(const CatchUpMessage &message));
   };
 
 }  // namespace kagome::consensus::grandpa
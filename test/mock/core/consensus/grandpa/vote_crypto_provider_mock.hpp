@@ -18,6 +18,8 @@ namespace kagome::consensus::grandpa {
                        bool(const SignedMessage &primary_propose));
     MOCK_CONST_METHOD1(verifyPrevote, bool(const SignedMessage &prevote));
     MOCK_CONST_METHOD1(verifyPrecommit, bool(const SignedMessage &precommit));
+    MOCK_CONST_METHOD1(verifyVotes,
+                       std::vector<bool>(gsl::span<const SignedMessage>));
 
     MOCK_CONST_METHOD1(signPrimaryPropose,
                        SignedMessage(const PrimaryPropose &primary_propose));
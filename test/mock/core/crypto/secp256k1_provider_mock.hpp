@@ -0,0 +1,29 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_CRYPTO_SECP256K1_PROVIDER_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_CRYPTO_SECP256K1_PROVIDER_MOCK_HPP
+
+#include "crypto/secp256k1_provider.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::crypto {
+
+  class Secp256k1ProviderMock : public Secp256k1Provider {
+   public:
+    MOCK_CONST_METHOD2(recoverPublickeyUncompressed,
+                       outcome::result<secp256k1::UncompressedPublicKey>(
+                           const secp256k1::RSVSignature &,
+                           const secp256k1::MessageHash &));
+    MOCK_CONST_METHOD2(recoverPublickeyCompressed,
+                       outcome::result<secp256k1::CompressedPublicKey>(
+                           const secp256k1::RSVSignature &,
+                           const secp256k1::MessageHash &));
+  };
+
+}  // namespace kagome::crypto
+
+#endif  // KAGOME_TEST_MOCK_CORE_CRYPTO_SECP256K1_PROVIDER_MOCK_HPP
@@ -18,6 +18,9 @@ namespace kagome::extensions {
     MOCK_METHOD2(ext_clear_prefix,
                  void(runtime::WasmPointer prefix_data,
                       runtime::WasmSize prefix_length));
+    MOCK_METHOD2(ext_storage_clear_prefix_version_2,
+                 runtime::WasmSpan(runtime::WasmSpan prefix,
+                                   runtime::WasmSpan limit));
     MOCK_METHOD2(ext_clear_storage,
                  void(runtime::WasmPointer key_data,
                       runtime::WasmSize key_length));
@@ -171,6 +174,20 @@ namespace kagome::extensions {
                                    runtime::WasmSpan msg,
                                    runtime::WasmPointer pubkey_data));
 
+    MOCK_METHOD0(ext_start_batch_verify_v1, void());
+
+    MOCK_METHOD0(ext_finish_batch_verify_v1, runtime::WasmSize());
+
+    MOCK_METHOD3(ext_ed25519_batch_verify_v1,
+                 runtime::WasmSize(runtime::WasmPointer sig_data,
+                                   runtime::WasmSpan msg,
+                                   runtime::WasmPointer pubkey_data));
+
+    MOCK_METHOD3(ext_sr25519_batch_verify_v1,
+                 runtime::WasmSize(runtime::WasmPointer sig_data,
+                                   runtime::WasmSpan msg,
+                                   runtime::WasmPointer pubkey_data));
+
     MOCK_METHOD2(ext_crypto_secp256k1_ecdsa_recover_v1,
                  runtime::WasmSpan(runtime::WasmPointer sig,
                                    runtime::WasmPointer msg));
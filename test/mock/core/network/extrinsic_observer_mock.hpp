@@ -0,0 +1,30 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_CORE_NETWORK_EXTRINSIC_OBSERVER_MOCK_HPP
+#define KAGOME_TEST_CORE_NETWORK_EXTRINSIC_OBSERVER_MOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "network/extrinsic_observer.hpp"
+
+namespace kagome::network {
+
+  class ExtrinsicObserverMock : public ExtrinsicObserver {
+   public:
+    ~ExtrinsicObserverMock() override = default;
+
+    MOCK_METHOD1(onTxMessage,
+                 outcome::result<common::Hash256>(
+                     const primitives::Extrinsic &));
+
+    MOCK_METHOD1(onTxMessages,
+                 std::vector<outcome::result<common::Hash256>>(
+                     const std::vector<primitives::Extrinsic> &));
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_TEST_CORE_NETWORK_EXTRINSIC_OBSERVER_MOCK_HPP
@@ -0,0 +1,36 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_NETWORK_SYNC_PROTOCOL_CLIENT_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_NETWORK_SYNC_PROTOCOL_CLIENT_MOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "network/sync_protocol_client.hpp"
+
+namespace kagome::network {
+
+  class SyncProtocolClientMock : public SyncProtocolClient {
+   public:
+    MOCK_METHOD2(
+        requestBlocks,
+        void(const BlocksRequest &request,
+             std::function<void(outcome::result<BlocksResponse>)> cb));
+    MOCK_METHOD2(
+        requestState,
+        void(const StateRequest &request,
+             std::function<void(outcome::result<StateResponse>)> cb));
+
+    // not mocked, as gmock can not print the optional it would return
+    boost::optional<libp2p::peer::PeerId> peerId() const override {
+      return peer_id;
+    }
+
+    boost::optional<libp2p::peer::PeerId> peer_id;
+  };
+
+}  // namespace kagome::network
+
+#endif  // KAGOME_TEST_MOCK_CORE_NETWORK_SYNC_PROTOCOL_CLIENT_MOCK_HPP
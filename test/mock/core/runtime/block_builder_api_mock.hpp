@@ -25,6 +25,8 @@ namespace kagome::runtime {
                      const primitives::Block &,
                      const primitives::InherentData &));
     MOCK_METHOD0(random_seed, outcome::result<common::Hash256>());
+    MOCK_METHOD0(holdEnvironment, outcome::result<void>());
+    MOCK_METHOD0(releaseEnvironment, void());
   };
 
 }  // namespace kagome::runtime
@@ -0,0 +1,20 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_RUNTIME_OFFCHAIN_WORKER_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_RUNTIME_OFFCHAIN_WORKER_MOCK_HPP
+
+#include "runtime/offchain_worker.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::runtime {
+  class OffchainWorkerMock : public OffchainWorker {
+   public:
+    MOCK_METHOD1(offchain_worker, outcome::result<void>(BlockNumber));
+  };
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_TEST_MOCK_CORE_RUNTIME_OFFCHAIN_WORKER_MOCK_HPP
@@ -0,0 +1,25 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_RUNTIME_RAW_CALL_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_RUNTIME_RAW_CALL_MOCK_HPP
+
+#include "runtime/raw_call.hpp"
+
+#include <gmock/gmock.h>
+
+namespace kagome::runtime {
+  class RawCallMock : public RawCall {
+   public:
+    MOCK_METHOD4(callAt,
+                 outcome::result<common::Buffer>(
+                     const common::Hash256 &,
+                     std::string_view,
+                     gsl::span<const uint8_t>,
+                     std::vector<common::Buffer> &));
+  };
+}  // namespace kagome::runtime
+
+#endif  // KAGOME_TEST_MOCK_CORE_RUNTIME_RAW_CALL_MOCK_HPP
@@ -22,6 +22,13 @@ namespace kagome::runtime {
     MOCK_CONST_METHOD0(tryGetPersistentBatch, boost::optional<std::shared_ptr<PersistentBatch>>());
     MOCK_CONST_METHOD0(isCurrentlyPersistent, bool());
     MOCK_METHOD0(forceCommit, outcome::result<common::Buffer>());
+    MOCK_CONST_METHOD0(calculateRoot, outcome::result<common::Buffer>());
+    MOCK_METHOD0(startTransaction, outcome::result<void>());
+    MOCK_METHOD0(rollbackTransaction, outcome::result<void>());
+    MOCK_METHOD0(commitTransaction, outcome::result<void>());
+    MOCK_METHOD0(startAccessRecording, void());
+    MOCK_METHOD1(recordAccess, void(const common::Buffer &));
+    MOCK_METHOD0(finishAccessRecording, std::vector<common::Buffer>());
   };
 
 }
@@ -15,6 +15,8 @@ namespace kagome::runtime {
   class WasmProviderMock: public WasmProvider {
    public:
     MOCK_CONST_METHOD0(getStateCode, const common::Buffer &());
+
+    MOCK_CONST_METHOD0(getStateCodeHash, common::Hash256());
   };
 
 }
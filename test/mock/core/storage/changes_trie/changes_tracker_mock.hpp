@@ -34,6 +34,10 @@ namespace kagome::storage::changes_trie {
         constructChangesTrie,
         outcome::result<common::Hash256>(const primitives::BlockHash &parent,
                                          const ChangesTrieConfig &conf));
+
+    MOCK_METHOD2(onBlockImported,
+                 void(const primitives::BlockHash &block,
+                      const primitives::BlockHash &parent));
   };
 
 }  // namespace kagome::storage::changes_trie
@@ -19,6 +19,8 @@ namespace kagome::storage::face {
 
     MOCK_METHOD1_T(seek, outcome::result<void> (const K &key));
 
+    MOCK_METHOD1_T(seekUpperBound, outcome::result<void> (const K &key));
+
     MOCK_METHOD0(seekToLast, outcome::result<void> ());
 
     MOCK_CONST_METHOD0(isValid, bool());
@@ -17,6 +17,10 @@ namespace kagome::storage::trie {
     MOCK_CONST_METHOD1(get,
                        outcome::result<common::Buffer>(const common::Buffer &));
 
+    MOCK_CONST_METHOD1(getMany,
+                       outcome::result<std::vector<boost::optional<Buffer>>>(
+                           gsl::span<const Buffer>));
+
     MOCK_METHOD0(cursor, std::unique_ptr<BufferMapCursor>());
 
     MOCK_CONST_METHOD1(contains, bool(const common::Buffer &));
@@ -36,6 +40,9 @@ namespace kagome::storage::trie {
     MOCK_CONST_METHOD0(calculateRoot, outcome::result<common::Buffer>());
 
     MOCK_METHOD1(clearPrefix, outcome::result<void>(const common::Buffer &buf));
+    MOCK_METHOD2(clearPrefix,
+                 outcome::result<ClearPrefixResult>(const common::Buffer &,
+                                                    uint32_t));
 
     MOCK_CONST_METHOD0(empty, bool());
 
@@ -49,6 +56,10 @@ namespace kagome::storage::trie {
     MOCK_CONST_METHOD1(get,
                        outcome::result<common::Buffer>(const common::Buffer &));
 
+    MOCK_CONST_METHOD1(getMany,
+                       outcome::result<std::vector<boost::optional<Buffer>>>(
+                           gsl::span<const Buffer>));
+
     MOCK_METHOD0(cursor, std::unique_ptr<BufferMapCursor>());
 
     MOCK_CONST_METHOD1(contains, bool(const common::Buffer &));
@@ -66,6 +77,9 @@ namespace kagome::storage::trie {
     MOCK_METHOD1(remove, outcome::result<void>(const common::Buffer &));
 
     MOCK_METHOD1(clearPrefix, outcome::result<void>(const common::Buffer &buf));
+    MOCK_METHOD2(clearPrefix,
+                 outcome::result<ClearPrefixResult>(const common::Buffer &,
+                                                    uint32_t));
 
     MOCK_CONST_METHOD0(empty, bool());
   };
@@ -0,0 +1,29 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TRIE_PRUNER_MOCK_HPP
+#define KAGOME_TRIE_PRUNER_MOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "storage/trie/trie_pruner.hpp"
+
+namespace kagome::storage::trie {
+
+  class TriePrunerMock : public TriePruner {
+   public:
+    MOCK_METHOD2(
+        addState,
+        outcome::result<void>(
+            const common::Buffer &root_key,
+            const std::vector<std::pair<common::Buffer, common::Buffer>>
+                &new_nodes));
+    MOCK_METHOD1(pruneState,
+                 outcome::result<void>(const common::Buffer &root_key));
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_TRIE_PRUNER_MOCK_HPP
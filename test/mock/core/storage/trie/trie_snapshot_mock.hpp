@@ -0,0 +1,39 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_SNAPSHOT_MOCK
+#define KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_SNAPSHOT_MOCK
+
+#include <gmock/gmock.h>
+
+#include "storage/trie/trie_snapshot.hpp"
+
+namespace kagome::storage::trie {
+
+  class TrieSnapshotMock : public TrieSnapshot {
+   public:
+    MOCK_CONST_METHOD1(get,
+                       outcome::result<common::Buffer>(const common::Buffer &));
+
+    MOCK_CONST_METHOD1(getMany,
+                       outcome::result<std::vector<boost::optional<Buffer>>>(
+                           gsl::span<const Buffer>));
+
+    MOCK_CONST_METHOD1(getMerkleValue,
+                       outcome::result<boost::optional<Buffer>>(
+                           const common::Buffer &));
+
+    MOCK_CONST_METHOD1(contains, bool(const common::Buffer &));
+
+    MOCK_CONST_METHOD0(empty, bool());
+
+    MOCK_CONST_METHOD0(cursor, std::unique_ptr<BufferMapCursor>());
+
+    MOCK_CONST_METHOD0(getRootHash, const Buffer &());
+  };
+
+}  // namespace kagome::storage::trie
+
+#endif  // KAGOME_TEST_MOCK_CORE_STORAGE_TRIE_TRIE_SNAPSHOT_MOCK
@@ -18,6 +18,7 @@ namespace kagome::storage::trie {
     MOCK_METHOD0(cursor, std::unique_ptr<face::MapCursor<Buffer, Buffer>>());
     MOCK_CONST_METHOD1(get, outcome::result<Buffer>(const Buffer &key));
     MOCK_CONST_METHOD1(contains, bool (const Buffer &key));
+    MOCK_CONST_METHOD0(empty, bool ());
     MOCK_METHOD2(put, outcome::result<void> (const Buffer &key, const Buffer &value));
     outcome::result<void> put(const common::Buffer &k, common::Buffer &&v) {
       return put_rvalueHack(k, std::move(v));
@@ -26,6 +26,16 @@ namespace kagome::storage::trie {
                        outcome::result<std::unique_ptr<EphemeralTrieBatch>>(
                            const common::Hash256 &root));
 
+    MOCK_CONST_METHOD0(
+        getSnapshot, outcome::result<std::shared_ptr<const TrieSnapshot>>());
+    MOCK_CONST_METHOD1(getSnapshotAt,
+                       outcome::result<std::shared_ptr<const TrieSnapshot>>(
+                           const common::Hash256 &root));
+    MOCK_CONST_METHOD2(getProofAt,
+                       outcome::result<std::vector<common::Buffer>>(
+                           const common::Hash256 &root,
+                           gsl::span<const common::Buffer> keys));
+
     MOCK_CONST_METHOD0(getRootHash, common::Buffer());
   };
 
@@ -0,0 +1,23 @@
+/**
+ * Copyright Soramitsu Co., Ltd. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef KAGOME_TEST_MOCK_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_MOCK_HPP
+#define KAGOME_TEST_MOCK_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_MOCK_HPP
+
+#include <gmock/gmock.h>
+
+#include "transaction_pool/pool_revalidator.hpp"
+
+namespace kagome::transaction_pool {
+
+  class PoolRevalidatorMock : public PoolRevalidator {
+   public:
+    MOCK_METHOD1(onNewBestBlock, void(const primitives::BlockInfo &best));
+    MOCK_METHOD1(resubmit, void(std::vector<primitives::Extrinsic>));
+  };
+
+}  // namespace kagome::transaction_pool
+
+#endif  // KAGOME_TEST_MOCK_CORE_TRANSACTION_POOL_POOL_REVALIDATOR_MOCK_HPP
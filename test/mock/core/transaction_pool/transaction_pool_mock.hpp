@@ -12,6 +12,11 @@
 
 namespace kagome::transaction_pool {
 
+  class ReadyTransactionsMock : public ReadyTransactions {
+   public:
+    MOCK_METHOD0(next, std::shared_ptr<const Transaction>());
+  };
+
   class TransactionPoolMock : public TransactionPool {
    public:
     outcome::result<void> submitOne(Transaction &&tx) {
@@ -19,19 +24,33 @@ namespace kagome::transaction_pool {
     }
     MOCK_METHOD1(submitOne, outcome::result<void>(Transaction));
     MOCK_METHOD1(submit, outcome::result<void>(std::vector<Transaction>));
+    MOCK_METHOD1(submitEach,
+                 std::vector<outcome::result<void>>(std::vector<Transaction>));
 
     MOCK_METHOD1(removeOne, outcome::result<void>(const Transaction::Hash &));
     MOCK_METHOD1(remove,
                  outcome::result<void>(const std::vector<Transaction::Hash> &));
 
-    MOCK_CONST_METHOD0(
-        getReadyTransactions,
-        std::map<Transaction::Hash, std::shared_ptr<Transaction>>());
+    MOCK_CONST_METHOD0(getReadyTransactions,
+                       std::unique_ptr<ReadyTransactions>());
 
     MOCK_METHOD1(
         removeStale,
         outcome::result<std::vector<Transaction>>(const primitives::BlockId &));
 
+    MOCK_CONST_METHOD1(contains, bool(const Transaction::Hash &));
+
+    MOCK_CONST_METHOD1(checkUnknown,
+                       std::vector<outcome::result<void>>(
+                           const std::vector<Transaction::Hash> &));
+
+    MOCK_CONST_METHOD1(getTransactions,
+                       std::vector<std::shared_ptr<const Transaction>>(
+                           const std::vector<Transaction::Hash> &));
+
+    MOCK_METHOD1(getForRevalidation,
+                 std::vector<std::shared_ptr<const Transaction>>(size_t));
+
     MOCK_CONST_METHOD0(getStatus, Status());
   };
 
@@ -7,6 +7,8 @@
 
 #include <fstream>
 
+#include "crypto/hasher/hasher_impl.hpp"
+
 namespace kagome::runtime {
   using kagome::common::Buffer;
 
@@ -18,6 +20,10 @@ namespace kagome::runtime {
     return buffer_;
   }
 
+  common::Hash256 BasicWasmProvider::getStateCodeHash() const {
+    return hash_;
+  }
+
   void BasicWasmProvider::initialize(std::string_view path) {
     // std::ios::ate seeks to the end of file
     std::ifstream ifd(std::string(path), std::ios::binary | std::ios::ate);
@@ -29,5 +35,6 @@ namespace kagome::runtime {
     // read whole file to the buffer
     ifd.read((char *)buffer.data(), size);  // NOLINT
     buffer_ = std::move(buffer);
+    hash_ = crypto::HasherImpl{}.twox_256(buffer_);
   }
 }  // namespace kagome::runtime
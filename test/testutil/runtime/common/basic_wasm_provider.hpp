@@ -18,10 +18,13 @@ namespace kagome::runtime {
 
     const kagome::common::Buffer &getStateCode() const override;
 
+    kagome::common::Hash256 getStateCodeHash() const override;
+
    private:
     void initialize(std::string_view path);
 
     kagome::common::Buffer buffer_;
+    kagome::common::Hash256 hash_;
   };
 
 }  // namespace kagome::runtime